@@ -11,6 +11,7 @@
 #include "archival/archival_policy.h"
 
 #include "archival/logger.h"
+#include "config/configuration.h"
 #include "storage/disk_log_impl.h"
 #include "storage/fs_utils.h"
 #include "storage/offset_translator_state.h"
@@ -20,6 +21,7 @@
 #include "storage/version.h"
 #include "vlog.h"
 
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/io_priority_class.hh>
 #include <seastar/core/iostream.hh>
 #include <seastar/core/lowres_clock.hh>
@@ -40,24 +42,119 @@ std::ostream& operator<<(std::ostream& s, const upload_candidate& c) {
       s,
       "{{source segment offsets: {}, exposed_name: {}, starting_offset: {}, "
       "file_offset: {}, content_length: {}, final_offset: {}, "
-      "final_file_offset: {}}}",
+      "final_file_offset: {}, merged segments: {}}}",
       c.source->offsets(),
       c.exposed_name,
       c.starting_offset,
       c.file_offset,
       c.content_length,
       c.final_offset,
-      c.final_file_offset);
+      c.final_file_offset,
+      c.merged.size());
     return s;
 }
 
+namespace {
+
+/// Data source that reads file ranges of several segments one by one
+class concatenated_segments_source final : public ss::data_source_impl {
+public:
+    struct file_range {
+        ss::lw_shared_ptr<storage::segment> segment;
+        size_t begin;
+        size_t end;
+    };
+
+    concatenated_segments_source(
+      std::vector<file_range> ranges, ss::io_priority_class io_priority)
+      : _ranges(std::move(ranges))
+      , _io_priority(io_priority) {}
+
+    ss::future<ss::temporary_buffer<char>> get() override {
+        while (true) {
+            if (!_current) {
+                if (_next == _ranges.size()) {
+                    co_return ss::temporary_buffer<char>{};
+                }
+                const auto& r = _ranges[_next++];
+                _current.emplace(co_await r.segment->reader().data_stream(
+                  r.begin, r.end, _io_priority));
+            }
+            auto buf = co_await _current->stream().read();
+            if (!buf.empty()) {
+                co_return buf;
+            }
+            co_await _current->close();
+            _current.reset();
+        }
+    }
+
+    ss::future<> close() override {
+        if (_current) {
+            co_await _current->close();
+            _current.reset();
+        }
+    }
+
+private:
+    std::vector<file_range> _ranges;
+    size_t _next{0};
+    std::optional<storage::segment_reader_handle> _current;
+    ss::io_priority_class _io_priority;
+};
+
+} // namespace
+
+ss::future<storage::segment_reader_handle> make_upload_candidate_stream(
+  const upload_candidate& candidate,
+  uint64_t offset,
+  uint64_t length,
+  ss::io_priority_class io_priority) {
+    if (candidate.merged.empty()) {
+        auto begin = candidate.file_offset + offset;
+        co_return co_await candidate.source->reader().data_stream(
+          begin, begin + length, io_priority);
+    }
+    // Clip the file range of every segment to the requested range of the
+    // upload
+    std::vector<concatenated_segments_source::file_range> ranges;
+    uint64_t pos = 0;
+    auto add_range = [&](
+                       const ss::lw_shared_ptr<storage::segment>& segment,
+                       size_t begin,
+                       size_t end) {
+        auto size = end - begin;
+        auto lo = std::max(pos, offset);
+        auto hi = std::min(pos + size, offset + length);
+        if (lo < hi) {
+            ranges.push_back(
+              {.segment = segment,
+               .begin = begin + (lo - pos),
+               .end = begin + (hi - pos)});
+        }
+        pos += size;
+    };
+    add_range(
+      candidate.source, candidate.file_offset, candidate.final_file_offset);
+    for (const auto& s : candidate.merged) {
+        add_range(s, 0, s->reader().file_size());
+    }
+    co_return storage::segment_reader_handle(ss::input_stream<char>(
+      ss::data_source(std::make_unique<concatenated_segments_source>(
+        std::move(ranges), io_priority))));
+}
+
 archival_policy::archival_policy(
   model::ntp ntp,
   std::optional<segment_time_limit> limit,
   ss::io_priority_class io_priority)
   : _ntp(std::move(ntp))
   , _upload_limit(limit)
-  , _io_priority(io_priority) {}
+  , _io_priority(io_priority)
+  , _merge_target_size(
+      config::shard_local_cfg().cloud_storage_segment_merge_target_size.bind())
+  , _merge_max_delay(config::shard_local_cfg()
+                       .cloud_storage_segment_merge_max_delay_ms.bind()) {}
 
 bool archival_policy::upload_deadline_reached() {
     if (!_upload_limit.has_value()) {
@@ -75,6 +172,47 @@ bool archival_policy::upload_deadline_reached() {
     return _upload_deadline < now;
 }
 
+archival_policy::cursor_lookup
+archival_policy::lookup_cursor(model::offset start_offset) {
+    if (!_cursor || _cursor->offset != start_offset) {
+        return cursor_lookup::miss;
+    }
+    const auto& segment = _cursor->segment;
+    if (
+      segment->is_tombstone() || segment->is_closed()
+      || segment->is_compacted_segment()
+      || segment->offsets().dirty_offset + model::offset(1) < start_offset
+      || segment->reader().file_size() < _cursor->file_pos) {
+        // The segment was removed, rewritten or truncated since
+        _cursor = std::nullopt;
+        return cursor_lookup::miss;
+    }
+    if (segment->offsets().dirty_offset < start_offset) {
+        if (segment->has_appender()) {
+            return cursor_lookup::no_new_data;
+        }
+        // The segment was rolled, the next upload starts in the next one
+        _cursor = std::nullopt;
+        return cursor_lookup::miss;
+    }
+    return cursor_lookup::found;
+}
+
+void archival_policy::advance_cursor(const upload_candidate& upload) {
+    if (upload.merged.empty()) {
+        _cursor = upload_cursor{
+          .segment = upload.source,
+          .offset = upload.final_offset + model::offset(1),
+          .file_pos = upload.final_file_offset};
+    } else {
+        const auto& last = upload.merged.back();
+        _cursor = upload_cursor{
+          .segment = last,
+          .offset = upload.final_offset + model::offset(1),
+          .file_pos = last->reader().file_size()};
+    }
+}
+
 archival_policy::lookup_result archival_policy::find_segment(
   model::offset start_offset,
   model::offset adjusted_lso,
@@ -97,43 +235,60 @@ archival_policy::lookup_result archival_policy::find_segment(
           _ntp);
         return {};
     }
-    const auto& set = plog->segments();
-
     const auto& ntp_conf = plog->config();
-    auto it = set.lower_bound(start_offset);
-    if (it == set.end() || (*it)->is_compacted_segment()) {
-        // Skip forward if we hit a gap or compacted segment
-        for (auto i = set.begin(); i != set.end(); i++) {
-            const auto& sg = *i;
-            if (start_offset < sg->offsets().base_offset) {
-                // Move last offset forward
-                it = i;
-                start_offset = sg->offsets().base_offset;
-                break;
-            }
-        }
-    }
-    if (it == set.end()) {
+
+    ss::lw_shared_ptr<storage::segment> segment;
+    std::optional<size_t> file_pos;
+    switch (lookup_cursor(start_offset)) {
+    case cursor_lookup::no_new_data:
         vlog(
           archival_log.debug,
-          "Upload policy for {}: can't find candidate, all segment offsets are "
-          "less than start_offset: {}",
+          "Upload policy for {}: can't find candidate, nothing was appended "
+          "after start_offset: {}",
           _ntp,
           start_offset);
         return {};
+    case cursor_lookup::found:
+        segment = _cursor->segment;
+        if (start_offset != segment->offsets().base_offset) {
+            file_pos = _cursor->file_pos;
+        }
+        break;
+    case cursor_lookup::miss: {
+        const auto& set = plog->segments();
+        auto it = set.lower_bound(start_offset);
+        if (it == set.end() || (*it)->is_compacted_segment()) {
+            // Skip forward if we hit a gap or compacted segment
+            for (auto i = set.begin(); i != set.end(); i++) {
+                const auto& sg = *i;
+                if (start_offset < sg->offsets().base_offset) {
+                    // Move last offset forward
+                    it = i;
+                    start_offset = sg->offsets().base_offset;
+                    break;
+                }
+            }
+        }
+        if (it == set.end()) {
+            vlog(
+              archival_log.debug,
+              "Upload policy for {}: can't find candidate, all segment "
+              "offsets are less than start_offset: {}",
+              _ntp,
+              start_offset);
+            return {};
+        }
+        segment = *it;
+        break;
     }
-    // Invariant: it != set.end()
-    bool closed = !(*it)->has_appender();
+    }
+    bool closed = !segment->has_appender();
     bool force_upload = upload_deadline_reached();
     if (!closed && !force_upload) {
         std::string_view reason = _upload_limit.has_value()
                                     ? "upload deadline not reached"
                                     : "candidate is not closed";
-        // Fast path, next upload candidate is not yet ready. We may want to
-        // optimize this case because it's expected to happen pretty often. This
-        // can be done by saving weak_ptr to the segment inside the policy
-        // object. The segment must be changed to derive from
-        // ss::weakly_referencable.
+        // Fast path, next upload candidate is not yet ready.
         vlog(
           archival_log.debug,
           "Upload policy for {}: can't find candidate, {}",
@@ -164,7 +319,7 @@ archival_policy::lookup_result archival_policy::find_segment(
         }
     }
 
-    auto dirty_offset = (*it)->offsets().dirty_offset;
+    auto dirty_offset = segment->offsets().dirty_offset;
     if (dirty_offset > adjusted_lso && !force_upload) {
         vlog(
           archival_log.debug,
@@ -178,7 +333,52 @@ archival_policy::lookup_result archival_policy::find_segment(
     if (_upload_limit) {
         _upload_deadline = ss::lowres_clock::now() + _upload_limit.value()();
     }
-    return {.segment = *it, .ntp_conf = &ntp_conf, .forced = force_upload};
+    return {
+      .segment = segment,
+      .ntp_conf = &ntp_conf,
+      .forced = force_upload,
+      .file_pos = file_pos};
+}
+
+bool archival_policy::merge_small_segments(
+  upload_candidate& upload, storage::log log, model::offset adjusted_lso) {
+    auto plog = dynamic_cast<storage::disk_log_impl*>(log.get_impl());
+    if (plog == nullptr) {
+        return false;
+    }
+    const auto target_size = _merge_target_size().value_or(0);
+    const auto& set = plog->segments();
+    auto term = upload.source->offsets().term;
+    for (auto it = set.lower_bound(upload.final_offset + model::offset(1));
+         it != set.end();
+         ++it) {
+        const auto& segment = *it;
+        if (
+          segment->offsets().base_offset
+          != upload.final_offset + model::offset(1)) {
+            break;
+        }
+        if (
+          segment->has_appender()
+          || segment->offsets().dirty_offset > adjusted_lso) {
+            // The next segment is not ready yet
+            return true;
+        }
+        // The object gets the name of the first segment, all segments in
+        // it should have the same term
+        auto size = segment->reader().file_size();
+        if (
+          segment->is_compacted_segment() || segment->offsets().term != term
+          || upload.content_length + size > target_size) {
+            break;
+        }
+        upload.merged.push_back(segment);
+        upload.content_length += size;
+        upload.final_offset = segment->offsets().dirty_offset;
+        upload.max_timestamp = std::max(
+          upload.max_timestamp, segment->index().max_timestamp());
+    }
+    return false;
 }
 
 // Data sink for noop output_stream instance
@@ -208,10 +408,12 @@ static ss::output_stream<char> make_null_output_stream() {
 /// This function computes offsets for the upload (inc. file offets)
 /// If the full segment is uploaded the segment is not scanned.
 /// If the upload is partial, the partial scan will be performed if
-/// the segment has the index and full scan otherwise.
+/// the segment has the index and full scan otherwise. The scan is skipped
+/// if the file position of 'begin_inclusive' is already known.
 static ss::future<> get_file_range(
   model::offset begin_inclusive,
   std::optional<model::offset> end_inclusive,
+  std::optional<size_t> begin_file_pos,
   const ss::lw_shared_ptr<storage::segment>& segment,
   upload_candidate& upl,
   ss::io_priority_class io_priority) {
@@ -248,10 +450,21 @@ static ss::future<> get_file_range(
         // as well as file offset.
         // Lookup the index, if the index is available and some value is found
         // use it as a starting point otherwise, start from the begining.
-        auto ix_begin = segment->index().find_nearest(begin_inclusive);
-        size_t scan_from = ix_begin ? ix_begin->filepos : 0;
-        model::offset sto = ix_begin ? ix_begin->offset
-                                     : segment->offsets().base_offset;
+        size_t scan_from = 0;
+        model::offset sto = segment->offsets().base_offset;
+        if (begin_file_pos) {
+            // The previous upload ended right before 'begin_inclusive', only
+            // the header of the first batch is read
+            scan_from = *begin_file_pos;
+            sto = begin_inclusive;
+        } else {
+            auto ix_begin = co_await segment->index().find_nearest_async(
+              begin_inclusive);
+            if (ix_begin) {
+                scan_from = ix_begin->filepos;
+                sto = ix_begin->offset;
+            }
+        }
         auto reader_handle = co_await segment->reader().data_stream(
           scan_from, io_priority);
         auto ostr = make_null_output_stream();
@@ -305,7 +518,8 @@ static ss::future<> get_file_range(
         // of the segment.
         // Lookup the index, if the index is available and some value is found
         // use it as a starting point otherwise, start from the begining.
-        auto ix_end = segment->index().find_nearest(end_inclusive.value());
+        auto ix_end = co_await segment->index().find_nearest_async(
+          end_inclusive.value());
 
         // NOTE: Index lookup might return an offset which isn't committed yet.
         // Subsequent call to segment_reader::data_stream will fail in this
@@ -314,7 +528,8 @@ static ss::future<> get_file_range(
         while (ix_end && ix_end->filepos > fsize) {
             vlog(archival_log.debug, "The position is not flushed {}", *ix_end);
             auto lookup_offset = ix_end->offset - model::offset(1);
-            ix_end = segment->index().find_nearest(lookup_offset);
+            ix_end = co_await segment->index().find_nearest_async(
+              lookup_offset);
             vlog(archival_log.debug, "Re-adjusted position {}", *ix_end);
         }
 
@@ -395,6 +610,7 @@ static ss::future<> get_file_range(
 ///
 /// \param begin_inclusive is a last_offset from manifest
 /// \param end_inclusive is a last offset to upload
+/// \param begin_file_pos is the file position of 'begin_inclusive', if known
 /// \param segment is a segment that has this offset
 /// \param ntp_conf is a ntp_config of the partition
 ///
@@ -416,6 +632,7 @@ static ss::future<> get_file_range(
 static ss::future<upload_candidate> create_upload_candidate(
   model::offset begin_inclusive,
   std::optional<model::offset> end_inclusive,
+  std::optional<size_t> begin_file_pos,
   const ss::lw_shared_ptr<storage::segment>& segment,
   const storage::ntp_config* ntp_conf,
   ss::io_priority_class io_priority) {
@@ -429,7 +646,12 @@ static ss::future<upload_candidate> create_upload_candidate(
 
     upload_candidate result{.source = segment};
     co_await get_file_range(
-      begin_inclusive, end_inclusive, segment, result, io_priority);
+      begin_inclusive,
+      end_inclusive,
+      begin_file_pos,
+      segment,
+      result,
+      io_priority);
     if (result.starting_offset != segment->offsets().base_offset) {
         // We need to generate new name for the segment
         auto path = storage::segment_path::make_segment_path(
@@ -458,8 +680,8 @@ ss::future<upload_candidate> archival_policy::get_next_candidate(
     // NOTE: end_exclusive (which is initialized with LSO) points to the first
     // unstable recordbatch we need to look at the previous batch if needed.
     auto adjusted_lso = end_exclusive - model::offset(1);
-    auto [segment, ntp_conf, forced] = find_segment(
-      begin_inclusive, adjusted_lso, std::move(log), ot_state);
+    auto [segment, ntp_conf, forced, file_pos] = find_segment(
+      begin_inclusive, adjusted_lso, log, ot_state);
     if (segment.get() == nullptr || ntp_conf == nullptr) {
         co_return upload_candidate{};
     }
@@ -475,10 +697,37 @@ ss::future<upload_candidate> archival_policy::get_next_candidate(
       segment->offsets(),
       adjusted_lso);
     auto upload = co_await create_upload_candidate(
-      begin_inclusive, last, segment, ntp_conf, _io_priority);
+      begin_inclusive, last, file_pos, segment, ntp_conf, _io_priority);
     if (upload.content_length == 0) {
         co_return upload_candidate{};
     }
+    // A small closed segment is merged with the segments that follow it,
+    // if they're not closed yet it waits for them up to the max delay.
+    auto target_size = _merge_target_size();
+    if (
+      target_size && !forced && !segment->has_appender()
+      && !segment->is_compacted_segment()
+      && upload.starting_offset == segment->offsets().base_offset
+      && upload.content_length < *target_size) {
+        bool wait = merge_small_segments(upload, std::move(log), adjusted_lso);
+        if (wait && upload.content_length < *target_size) {
+            auto now = ss::lowres_clock::now();
+            if (!_merge_deadline) {
+                _merge_deadline = now + _merge_max_delay();
+            }
+            if (now < *_merge_deadline) {
+                vlog(
+                  archival_log.debug,
+                  "Upload policy for {}: candidate {} waits for the next "
+                  "segment to be merged",
+                  _ntp,
+                  upload);
+                co_return upload_candidate{};
+            }
+        }
+    }
+    _merge_deadline = std::nullopt;
+    advance_cursor(upload);
     co_return upload;
 }
 
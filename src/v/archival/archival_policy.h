@@ -12,10 +12,12 @@
 
 #include "archival/probe.h"
 #include "archival/types.h"
+#include "config/property.h"
 #include "model/fundamental.h"
 #include "storage/fwd.h"
 #include "storage/log_manager.h"
 #include "storage/ntp_config.h"
+#include "storage/segment_reader.h"
 #include "storage/segment_set.h"
 
 #include <seastar/core/io_priority_class.hh>
@@ -32,10 +34,25 @@ struct upload_candidate {
     size_t final_file_offset;
     model::timestamp base_timestamp;
     model::timestamp max_timestamp;
+    /// Closed segments that directly follow 'source' and are uploaded as a
+    /// part of the same object. The merged segments are uploaded whole,
+    /// 'file_offset' and 'final_file_offset' refer to 'source' while
+    /// 'content_length', 'final_offset' and 'max_timestamp' cover all
+    /// segments.
+    std::vector<ss::lw_shared_ptr<storage::segment>> merged;
 
     friend std::ostream& operator<<(std::ostream& s, const upload_candidate& c);
 };
 
+/// Make a stream that returns 'length' bytes of the upload starting from
+/// 'offset', the data of the merged segments follows the data of the source
+/// segment.
+ss::future<storage::segment_reader_handle> make_upload_candidate_stream(
+  const upload_candidate& candidate,
+  uint64_t offset,
+  uint64_t length,
+  ss::io_priority_class io_priority);
+
 /// Archival policy is responsible for extracting segments from
 /// log_manager in right order.
 ///
@@ -72,18 +89,49 @@ private:
         ss::lw_shared_ptr<storage::segment> segment;
         const storage::ntp_config* ntp_conf;
         bool forced;
+        /// Position of the start offset in the segment file, if known
+        std::optional<size_t> file_pos;
+    };
+
+    /// Where the upload that follows the last candidate starts. The archiver
+    /// asks for that offset next, the cursor lets it be found without a
+    /// search of the segment set or a lookup of the segment index.
+    struct upload_cursor {
+        ss::lw_shared_ptr<storage::segment> segment;
+        model::offset offset;
+        size_t file_pos;
     };
 
+    enum class cursor_lookup { found, no_new_data, miss };
+
+    /// Check that the cursor still points at 'start_offset' in a segment of
+    /// the log, the cursor is dropped if it doesn't.
+    cursor_lookup lookup_cursor(model::offset start_offset);
+
+    void advance_cursor(const upload_candidate&);
+
     lookup_result find_segment(
       model::offset last_offset,
       model::offset adjusted_lso,
       storage::log,
       const storage::offset_translator_state&);
 
+    /// Add closed segments that follow the candidate to it while the
+    /// upload is smaller than the merge target size. Returns true if the
+    /// candidate should wait for the next segment to be closed.
+    bool merge_small_segments(
+      upload_candidate& upload, storage::log, model::offset adjusted_lso);
+
     model::ntp _ntp;
     std::optional<segment_time_limit> _upload_limit;
     std::optional<ss::lowres_clock::time_point> _upload_deadline;
     ss::io_priority_class _io_priority;
+    config::binding<std::optional<size_t>> _merge_target_size;
+    config::binding<std::chrono::milliseconds> _merge_max_delay;
+    /// Time when the small segment that waits for merging is uploaded
+    /// anyway
+    std::optional<ss::lowres_clock::time_point> _merge_deadline;
+    std::optional<upload_cursor> _cursor;
 };
 
 } // namespace archival
@@ -14,6 +14,8 @@
 #include "archival/logger.h"
 #include "cloud_storage/partition_manifest.h"
 #include "cloud_storage/remote.h"
+#include "cloud_storage/remote_segment.h"
+#include "cloud_storage/remote_segment_index.h"
 #include "cloud_storage/tx_range_manifest.h"
 #include "cloud_storage/types.h"
 #include "cluster/partition_manager.h"
@@ -24,7 +26,9 @@
 #include "storage/disk_log_impl.h"
 #include "storage/fs_utils.h"
 #include "storage/parser.h"
+#include "units.h"
 #include "utils/gate_guard.h"
+#include "utils/stream_utils.h"
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/coroutine.hh>
@@ -45,12 +49,33 @@
 
 namespace archival {
 
+// Part size of the compressed segment upload if the multipart upload part
+// size is not configured
+static constexpr size_t compressed_upload_part_size = 16_MiB;
+
+// Max interval between read-replica manifest syncs as a multiple of
+// cloud_storage_readreplica_manifest_sync_timeout_ms, reached if the
+// manifest doesn't change
+static constexpr int sync_manifest_max_backoff_factor = 8;
+
+// Segments replaced by a merge are deleted after this delay, readers that
+// looked them up in the manifest before the merge can still download them
+static constexpr auto replaced_segment_deletion_delay = 5min;
+
+// A merge holds the merged segment in memory, the merges of the shard run
+// one at a time
+static ssx::semaphore& merge_semaphore() {
+    static thread_local ssx::semaphore sem{1, "archive/merge"};
+    return sem;
+}
+
 ntp_archiver::ntp_archiver(
   const storage::ntp_config& ntp,
   cluster::partition_manager& partition_manager,
   const configuration& conf,
   cloud_storage::remote& remote,
-  ss::lw_shared_ptr<cluster::partition> part)
+  ss::lw_shared_ptr<cluster::partition> part,
+  ss::lw_shared_ptr<upload_scheduler> scheduler)
   : _probe(conf.ntp_metrics_disabled, ntp.ntp())
   , _ntp(ntp.ntp())
   , _rev(ntp.get_initial_revision())
@@ -71,6 +96,24 @@ ntp_archiver::ntp_archiver(
   , _sync_manifest_timeout(
       config::shard_local_cfg()
         .cloud_storage_readreplica_manifest_sync_timeout_ms.bind())
+  , _multipart_part_size(
+      config::shard_local_cfg().cloud_storage_multipart_upload_part_size.bind())
+  , _multipart_concurrency(
+      config::shard_local_cfg()
+        .cloud_storage_multipart_upload_concurrency.bind())
+  , _segment_compression(
+      config::shard_local_cfg().cloud_storage_segment_compression.bind())
+  , _compression_frame_size(
+      config::shard_local_cfg().cloud_storage_compression_frame_size.bind())
+  , _metadata_replication_interval(
+      config::shard_local_cfg()
+        .cloud_storage_metadata_replication_interval_ms.bind())
+  , _remote_segment_merging(
+      config::shard_local_cfg()
+        .cloud_storage_enable_remote_segment_merging.bind())
+  , _segment_merge_target_size(
+      config::shard_local_cfg().cloud_storage_segment_merge_target_size.bind())
+  , _upload_scheduler(std::move(scheduler))
   , _upload_sg(conf.upload_scheduling_group)
   , _io_priority(conf.upload_io_priority) {
     vassert(
@@ -176,7 +219,8 @@ ss::future<> ntp_archiver::upload_loop() {
             co_await _partition->archival_meta_stm()->sync(sync_timeout);
         }
 
-        auto result = co_await upload_next_candidates();
+        auto result = co_await do_upload_next_candidates(
+          std::nullopt, coalesce_metadata::yes);
         if (result.num_failed != 0) {
             // The logic in class `remote` already does retries: if we get here,
             // it means the upload failed after several retries, indicating
@@ -204,7 +248,15 @@ ss::future<> ntp_archiver::upload_loop() {
             break;
         }
 
+        co_await delete_replaced_segments();
+
         if (result.num_succeded == 0) {
+            // Nothing new to upload, use the time to merge small segments
+            co_await maybe_merge_segments();
+            if (!upload_loop_can_continue()) {
+                break;
+            }
+
             // The backoff algorithm here is used to prevent high CPU
             // utilization when redpanda is not receiving any data and there
             // is nothing to update. Also, we want to limit amount of
@@ -226,8 +278,9 @@ ss::future<> ntp_archiver::upload_loop() {
 }
 
 ss::future<> ntp_archiver::sync_manifest_loop() {
+    auto interval = _sync_manifest_timeout();
     while (sync_manifest_loop_can_continue()) {
-        cloud_storage::download_result result = co_await sync_manifest();
+        auto [result, modified] = co_await sync_manifest();
 
         if (result != cloud_storage::download_result::success) {
             // The logic in class `remote` already does retries: if we get here,
@@ -243,13 +296,36 @@ ss::future<> ntp_archiver::sync_manifest_loop() {
               "Successfuly downloaded manifest {}",
               _manifest.get_manifest_path());
         }
-        co_await ss::sleep_abortable(_sync_manifest_timeout(), _as);
+        // Poll unchanged manifests less often, the interval is reset as soon
+        // as the source cluster uploads a new version
+        if (modified || result != cloud_storage::download_result::success) {
+            interval = _sync_manifest_timeout();
+        } else {
+            interval = std::min<std::chrono::milliseconds>(
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                interval * 2),
+              _sync_manifest_timeout() * sync_manifest_max_backoff_factor);
+        }
+        co_await ss::sleep_abortable(interval, _as);
     }
 }
 
-ss::future<cloud_storage::download_result> ntp_archiver::sync_manifest() {
-    cloud_storage::download_result r = co_await download_manifest();
-    if (r == cloud_storage::download_result::success) {
+ss::future<cloud_storage::remote::conditional_download_result>
+ntp_archiver::sync_manifest() {
+    gate_guard guard{_gate};
+    retry_chain_node fib(
+      _manifest_upload_timeout, _cloud_storage_initial_backoff, &_rtcnode);
+    auto res = co_await _remote.download_manifest_if_modified(
+      _bucket,
+      cloud_storage::remote_manifest_path(
+        std::filesystem::path(_manifest.get_manifest_path())),
+      _manifest,
+      _manifest_etag,
+      fib);
+    auto r = res.result;
+    if (r == cloud_storage::download_result::success && !res.modified) {
+        vlog(_rtclog.trace, "Manifest is not modified in read-replica mode");
+    } else if (r == cloud_storage::download_result::success) {
         vlog(_rtclog.debug, "Downloading manifest in read-replica mode");
         if (_partition->archival_meta_stm()) {
             vlog(
@@ -268,6 +344,9 @@ ss::future<cloud_storage::download_result> ntp_archiver::sync_manifest() {
                   _rtclog.warn,
                   "archival metadata STM update failed: {}",
                   error);
+                // download the manifest again with the next sync, it is not
+                // modified otherwise
+                _manifest_etag = {};
             }
             auto last_offset
               = _partition->archival_meta_stm()->manifest().get_last_offset();
@@ -278,7 +357,7 @@ ss::future<cloud_storage::download_result> ntp_archiver::sync_manifest() {
           _rtclog.error,
           "Failed to download partition manifest in read-replica mode");
     }
-    co_return r;
+    co_return res;
 }
 
 bool ntp_archiver::upload_loop_can_continue() const {
@@ -296,7 +375,11 @@ bool ntp_archiver::sync_manifest_loop_can_continue() const {
 
 ss::future<> ntp_archiver::stop() {
     _as.request_abort();
-    return _gate.close();
+    return _gate.close().finally([this] {
+        if (_upload_scheduler) {
+            _upload_scheduler->remove(_ntp);
+        }
+    });
 }
 
 const model::ntp& ntp_archiver::get_ntp() const { return _ntp; }
@@ -357,8 +440,11 @@ ss::future<cloud_storage::upload_result> ntp_archiver::upload_manifest() {
 }
 
 // from offset to offset (by record batch boundary)
-ss::future<cloud_storage::upload_result>
-ntp_archiver::upload_segment(upload_candidate candidate) {
+ss::future<cloud_storage::upload_result> ntp_archiver::upload_segment(
+  upload_candidate candidate,
+  std::optional<size_t> compression_frame_size,
+  model::offset delta,
+  ss::lw_shared_ptr<bool> index_uploaded) {
     gate_guard guard{_gate};
     retry_chain_node fib(
       _segment_upload_timeout, _cloud_storage_initial_backoff, &_rtcnode);
@@ -369,13 +455,109 @@ ntp_archiver::upload_segment(upload_candidate candidate) {
 
     vlog(ctxlog.debug, "Uploading segment {} to {}", candidate, path);
 
-    auto reset_func = [this, candidate] {
-        return candidate.source->reader().data_stream(
-          candidate.file_offset, candidate.final_file_offset, _io_priority);
+    cloud_storage::offset_index index(
+      candidate.starting_offset,
+      candidate.starting_offset - delta,
+      0,
+      cloud_storage::remote_segment_sampling_step_bytes);
+    // Set when the segment is first read, the index is built by the first
+    // upload attempt, retries don't index the segment again.
+    std::optional<ss::future<bool>> indexed;
+    auto reset_func = [this, candidate, delta, &index, &indexed] {
+        return make_upload_candidate_stream(
+                 candidate, 0, candidate.content_length, _io_priority)
+          .then(
+            [this, delta, &index, &indexed](
+              storage::segment_reader_handle handle)
+              -> storage::segment_reader_handle {
+                if (indexed) {
+                    return handle;
+                }
+                auto [upload, parse] = input_stream_fanout<2>(
+                  handle.take_stream(), 1);
+                indexed = build_index(
+                  std::move(parse), std::move(handle), delta, index);
+                return storage::segment_reader_handle(std::move(upload));
+            });
     };
 
+    auto lazy_abort_source = make_upload_abort_source();
+    auto part_size = _multipart_part_size();
+    auto result = cloud_storage::upload_result::failed;
+    std::exception_ptr eptr = nullptr;
+    try {
+        if (compression_frame_size) {
+            // The compressed size is not known until the segment is read, so
+            // the compressed segment is always uploaded in parts.
+            result = co_await _remote.upload_segment_compressed(
+              _bucket,
+              path,
+              *compression_frame_size,
+              part_size.value_or(compressed_upload_part_size),
+              reset_func,
+              fib,
+              lazy_abort_source);
+        } else if (part_size && candidate.content_length > *part_size) {
+            // The parts are read separately, the index is built with another
+            // read of the segment that runs alongside the upload
+            auto handle = co_await make_upload_candidate_stream(
+              candidate, 0, candidate.content_length, _io_priority);
+            auto stream = handle.take_stream();
+            indexed = build_index(
+              std::move(stream), std::move(handle), delta, index);
+            auto reset_part = [this, candidate](
+                                uint64_t offset, uint64_t length) {
+                return make_upload_candidate_stream(
+                  candidate, offset, length, _io_priority);
+            };
+            result = co_await _remote.upload_segment_multipart(
+              _bucket,
+              path,
+              candidate.content_length,
+              *part_size,
+              _multipart_concurrency(),
+              reset_part,
+              fib,
+              lazy_abort_source);
+        } else {
+            result = co_await _remote.upload_segment(
+              _bucket,
+              path,
+              candidate.content_length,
+              reset_func,
+              fib,
+              lazy_abort_source);
+        }
+    } catch (...) {
+        eptr = std::current_exception();
+    }
+    // The index refers to the locals of this frame, it has to be built
+    // before returning even if the upload failed
+    bool index_built = indexed && co_await std::move(*indexed);
+    if (eptr) {
+        std::rethrow_exception(eptr);
+    }
+    if (result != cloud_storage::upload_result::success || !index_built) {
+        co_return result;
+    }
+
+    retry_chain_node index_fib(
+      _segment_upload_timeout, _cloud_storage_initial_backoff, &_rtcnode);
+    auto res = co_await _remote.upload_segment_index(
+      _bucket, path, index.to_iobuf(), index_fib);
+    if (res == cloud_storage::upload_result::success) {
+        *index_uploaded = true;
+    } else {
+        // the segment is indexed on download instead
+        vlog(
+          ctxlog.warn, "Failed to upload index of segment {}: {}", path, res);
+    }
+    co_return result;
+}
+
+cloud_storage::lazy_abort_source ntp_archiver::make_upload_abort_source() {
     auto original_term = _partition->term();
-    auto lazy_abort_source = cloud_storage::lazy_abort_source{
+    return cloud_storage::lazy_abort_source{
       "lost leadership or term changed during upload, "
       "current leadership status: {}, "
       "current term: {}, "
@@ -394,13 +576,296 @@ ntp_archiver::upload_segment(upload_candidate candidate) {
           return lost_leadership;
       },
     };
-    co_return co_await _remote.upload_segment(
+}
+
+ss::future<bool> ntp_archiver::build_index(
+  ss::input_stream<char> stream,
+  std::optional<storage::segment_reader_handle> source,
+  model::offset delta,
+  cloud_storage::offset_index& index) {
+    auto parser = cloud_storage::make_remote_segment_index_builder(
+      std::move(stream),
+      index,
+      delta,
+      cloud_storage::remote_segment_sampling_step_bytes);
+    bool built = false;
+    try {
+        auto res = co_await parser->consume();
+        built = res.has_value();
+    } catch (...) {
+        vlog(
+          _rtclog.warn,
+          "Failed to index segment, the index is not uploaded: {}",
+          std::current_exception());
+    }
+    try {
+        co_await parser->close();
+        if (source) {
+            co_await source->close();
+        }
+    } catch (...) {
+        vlog(
+          _rtclog.warn,
+          "Failed to close segment after indexing: {}",
+          std::current_exception());
+    }
+    co_return built;
+}
+
+ntp_archiver::merge_candidates
+ntp_archiver::find_merge_candidates(size_t target_size) const {
+    auto replicated_offset
+      = _partition->archival_meta_stm()->manifest().get_last_offset();
+    merge_candidates run;
+    size_t run_size = 0;
+    for (const auto& [key, meta] : _manifest) {
+        if (meta.committed_offset > replicated_offset) {
+            break;
+        }
+        bool small = !meta.is_compressed && meta.size_bytes < target_size / 2;
+        bool extends_run = small && !run.empty()
+                           && key.term == run.back().first.term
+                           && meta.base_offset
+                                == model::next_offset(
+                                  run.back().second.committed_offset)
+                           && run_size + meta.size_bytes <= target_size;
+        if (!extends_run) {
+            if (run.size() > 1) {
+                return run;
+            }
+            run.clear();
+            run_size = 0;
+            if (!small) {
+                continue;
+            }
+        }
+        run.emplace_back(key, meta);
+        run_size += meta.size_bytes;
+    }
+    if (run.size() < 2) {
+        run.clear();
+    }
+    return run;
+}
+
+ss::future<> ntp_archiver::maybe_merge_segments() {
+    auto target_size = _segment_merge_target_size();
+    if (
+      !_remote_segment_merging() || !target_size
+      || !_partition->archival_meta_stm()
+      || !_partition->is_feature_active(
+        cluster::feature::cloud_storage_segment_merging)) {
+        co_return;
+    }
+    auto merge_units = ss::try_get_units(merge_semaphore(), 1);
+    if (!merge_units) {
+        co_return;
+    }
+    auto run = find_merge_candidates(*target_size);
+    if (run.empty()) {
+        co_return;
+    }
+
+    gate_guard guard{_gate};
+    retry_chain_node fib(
+      _segment_upload_timeout, _cloud_storage_initial_backoff, &_rtcnode);
+    retry_chain_logger ctxlog(archival_log, fib, _ntp.path());
+
+    const auto first_key = run.front().first;
+    const auto& first = run.front().second;
+    cloud_storage::partition_manifest::segment_meta merged{
+      .is_compacted = false,
+      .size_bytes = 0,
+      .base_offset = first.base_offset,
+      .committed_offset = run.back().second.committed_offset,
+      .base_timestamp = first.base_timestamp,
+      .max_timestamp = first.max_timestamp,
+      .delta_offset = first.delta_offset,
+      .ntp_revision = _rev,
+      .archiver_term = _start_term,
+      .is_merged = true,
+    };
+    vlog(
+      ctxlog.debug,
+      "Merging {} segments, offsets {}-{}",
+      run.size(),
+      merged.base_offset,
+      merged.committed_offset);
+
+    iobuf data;
+    std::vector<cluster::rm_stm::tx_range> tx_ranges;
+    for (const auto& [key, meta] : run) {
+        auto path = _manifest.generate_segment_path(key, meta);
+        iobuf segment;
+        auto res = co_await _remote.download_segment(
+          _bucket,
+          path,
+          [&segment](uint64_t size, ss::input_stream<char> stream) {
+              return ss::do_with(
+                std::move(stream),
+                [&segment, size](ss::input_stream<char>& stream) {
+                    return read_iobuf_exactly(stream, size)
+                      .then([&segment, size](iobuf buf) {
+                          segment = std::move(buf);
+                          return size;
+                      })
+                      .finally([&stream] { return stream.close(); });
+                });
+          },
+          fib);
+        if (
+          res != cloud_storage::download_result::success
+          || segment.size_bytes() != meta.size_bytes) {
+            vlog(
+              ctxlog.warn,
+              "Failed to download segment {} for merging: {}",
+              path,
+              res);
+            co_return;
+        }
+        data.append(std::move(segment));
+
+        cloud_storage::tx_range_manifest tx(path);
+        auto tx_res = co_await _remote.download_manifest(
+          _bucket, tx.get_manifest_path(), tx, fib);
+        if (tx_res == cloud_storage::download_result::success) {
+            for (const auto& range : std::move(tx).get_tx_range()) {
+                tx_ranges.push_back(range);
+            }
+        } else if (tx_res != cloud_storage::download_result::notfound) {
+            vlog(
+              ctxlog.warn,
+              "Failed to download tx manifest of segment {} for merging: {}",
+              path,
+              tx_res);
+            co_return;
+        }
+
+        merged.size_bytes += meta.size_bytes;
+        merged.max_timestamp = std::max(
+          merged.max_timestamp, meta.max_timestamp);
+        merged.is_compacted = merged.is_compacted || meta.is_compacted;
+    }
+
+    cloud_storage::offset_index index(
+      merged.base_offset,
+      merged.base_offset - merged.delta_offset,
+      0,
+      cloud_storage::remote_segment_sampling_step_bytes);
+    bool index_built = co_await build_index(
+      make_iobuf_input_stream(data.share(0, data.size_bytes())),
+      std::nullopt,
+      merged.delta_offset,
+      index);
+
+    auto path = _manifest.generate_segment_path(first_key, merged);
+    auto lazy_abort_source = make_upload_abort_source();
+    auto res = co_await _remote.upload_segment(
       _bucket,
       path,
-      candidate.content_length,
-      reset_func,
+      merged.size_bytes,
+      [&data] {
+          return ss::make_ready_future<storage::segment_reader_handle>(
+            storage::segment_reader_handle(
+              make_iobuf_input_stream(data.share(0, data.size_bytes()))));
+      },
       fib,
       lazy_abort_source);
+    if (res == cloud_storage::upload_result::success && !tx_ranges.empty()) {
+        cloud_storage::tx_range_manifest tx(path, tx_ranges);
+        res = co_await _remote.upload_manifest(_bucket, tx, fib);
+    }
+    if (res != cloud_storage::upload_result::success) {
+        vlog(ctxlog.warn, "Failed to upload merged segment {}: {}", path, res);
+        co_return;
+    }
+    if (index_built) {
+        auto index_res = co_await _remote.upload_segment_index(
+          _bucket, path, index.to_iobuf(), fib);
+        merged.has_index = index_res == cloud_storage::upload_result::success;
+    }
+
+    auto units = co_await ss::get_units(_mutex, 1);
+    // The manifest may have been truncated while the merged segment was
+    // uploaded
+    for (const auto& [key, meta] : run) {
+        const auto* current = _manifest.get(key);
+        if (current == nullptr || *current != meta) {
+            vlog(
+              ctxlog.info,
+              "Segment {} changed during the merge, dropping merged segment {}",
+              key.base_offset,
+              path);
+            _replaced_segments.push_back(replaced_segment{
+              .path = path,
+              .has_index = merged.has_index,
+              .delete_after = ss::lowres_clock::now()});
+            co_return;
+        }
+    }
+    if (!upload_loop_can_continue()) {
+        co_return;
+    }
+    auto error = co_await _partition->archival_meta_stm()->replace_segments(
+      first_key,
+      merged,
+      ss::lowres_clock::now() + _manifest_upload_timeout,
+      _as);
+    if (error != cluster::errc::success) {
+        vlog(ctxlog.warn, "archival metadata STM update failed: {}", error);
+        if (error == cluster::errc::invalid_request) {
+            // The command was applied without replacing the segments, the
+            // merged segment is not referenced
+            _replaced_segments.push_back(replaced_segment{
+              .path = path,
+              .has_index = merged.has_index,
+              .delete_after = ss::lowres_clock::now()});
+        }
+        co_return;
+    }
+    _manifest.replace(first_key, merged);
+    auto delete_after = ss::lowres_clock::now()
+                        + replaced_segment_deletion_delay;
+    for (const auto& [key, meta] : run) {
+        _replaced_segments.push_back(replaced_segment{
+          .path = _manifest.generate_segment_path(key, meta),
+          .has_index = meta.has_index,
+          .delete_after = delete_after});
+    }
+    co_await upload_manifest();
+}
+
+ss::future<> ntp_archiver::delete_replaced_segments() {
+    gate_guard guard{_gate};
+    while (!_replaced_segments.empty() && upload_loop_can_continue()) {
+        const auto& segment = _replaced_segments.front();
+        if (segment.delete_after > ss::lowres_clock::now()) {
+            break;
+        }
+        std::vector<s3::object_key> keys{
+          s3::object_key(segment.path()),
+          s3::object_key(
+            cloud_storage::generate_remote_tx_path(segment.path)()),
+        };
+        if (segment.has_index) {
+            keys.emplace_back(
+              cloud_storage::generate_remote_index_path(segment.path)());
+        }
+        for (const auto& key : keys) {
+            retry_chain_node fib(
+              _manifest_upload_timeout,
+              _cloud_storage_initial_backoff,
+              &_rtcnode);
+            auto res = co_await _remote.delete_object(_bucket, key, fib);
+            if (res != cloud_storage::upload_result::success) {
+                // retried in the next iteration of the upload loop
+                vlog(_rtclog.warn, "Failed to delete {}: {}", key, res);
+                co_return;
+            }
+        }
+        vlog(_rtclog.debug, "Deleted replaced segment {}", segment.path);
+        _replaced_segments.pop_front();
+    }
 }
 
 ss::future<cloud_storage::upload_result>
@@ -460,7 +925,7 @@ ss::future<ntp_archiver::scheduled_upload> ntp_archiver::schedule_single_upload(
           .name = std::nullopt,
           .delta = std::nullopt,
           .stop = ss::stop_iteration::yes,
-          .segment_read_lock = std::nullopt,
+          .segment_read_locks = {},
         };
     }
     if (_manifest.contains(upload.exposed_name)) {
@@ -487,7 +952,10 @@ ss::future<ntp_archiver::scheduled_upload> ntp_archiver::schedule_single_upload(
         //   - Same as previoius. We need to log error and continue with the
         //   largest offset.
         const auto& meta = _manifest.get(upload.exposed_name);
-        auto dirty_offset = upload.source->offsets().dirty_offset;
+        const auto& last_segment = upload.merged.empty()
+                                     ? upload.source
+                                     : upload.merged.back();
+        auto dirty_offset = last_segment->offsets().dirty_offset;
         if (meta->committed_offset < dirty_offset) {
             vlog(
               _rtclog.info,
@@ -512,7 +980,7 @@ ss::future<ntp_archiver::scheduled_upload> ntp_archiver::schedule_single_upload(
               .name = std::nullopt,
               .delta = std::nullopt,
               .stop = ss::stop_iteration::no,
-              .segment_read_lock = std::nullopt,
+              .segment_read_locks = {},
             };
         }
     }
@@ -522,11 +990,37 @@ ss::future<ntp_archiver::scheduled_upload> ntp_archiver::schedule_single_upload(
     auto delta
       = base - _partition->get_offset_translator_state()->from_log_offset(base);
 
+    // The decision is made once, so the metadata matches the uploaded object
+    // even if the configuration changes during the upload.
+    std::optional<size_t> compression_frame_size;
+    if (_segment_compression()) {
+        compression_frame_size = _compression_frame_size();
+    }
+
+    // Wait for a slot before the segments are locked, the lock blocks
+    // retention and compaction of the segments
+    std::optional<upload_scheduler::permit> permit;
+    if (_upload_scheduler) {
+        permit = co_await _upload_scheduler->acquire(
+          _ntp, upload.content_length, _backlog_bytes, _as);
+    }
+
     auto segment_lock_deadline = std::chrono::steady_clock::now()
                                  + _segment_upload_timeout;
+    // The merged segments are locked as well as the source segment
+    std::vector<ss::rwlock::holder> read_locks;
+    read_locks.push_back(
+      co_await upload.source->read_lock(segment_lock_deadline));
+    for (const auto& s : upload.merged) {
+        read_locks.push_back(co_await s->read_lock(segment_lock_deadline));
+    }
     // The upload is successful only if both segment and tx_range are uploaded.
+    auto index_uploaded = ss::make_lw_shared<bool>(false);
     auto upl_fut
-      = ss::when_all(upload_segment(upload), upload_tx(upload))
+      = ss::when_all(
+            upload_segment(
+              upload, compression_frame_size, delta, index_uploaded),
+            upload_tx(upload))
           .then([](auto tup) {
               auto [fs, ftx] = std::move(tup);
               auto rs = fs.get();
@@ -539,7 +1033,8 @@ ss::future<ntp_archiver::scheduled_upload> ntp_archiver::schedule_single_upload(
                   return rs;
               }
               return rtx;
-          });
+          })
+          .finally([permit = std::move(permit)] {});
     co_return scheduled_upload{
       .result = std::move(upl_fut),
       .inclusive_last_offset = offset,
@@ -553,10 +1048,12 @@ ss::future<ntp_archiver::scheduled_upload> ntp_archiver::schedule_single_upload(
         .delta_offset = delta,
         .ntp_revision = _rev,
         .archiver_term = _start_term,
+        .is_compressed = compression_frame_size.has_value(),
       },
       .name = upload.exposed_name, .delta = offset - base,
       .stop = ss::stop_iteration::no,
-      .segment_read_lock = co_await upload.source->read_lock(segment_lock_deadline),
+      .segment_read_locks = std::move(read_locks),
+      .index_uploaded = std::move(index_uploaded),
     };
 }
 
@@ -577,6 +1074,10 @@ ntp_archiver::schedule_uploads(model::offset last_stable_offset) {
       start_upload_offset,
       last_stable_offset);
     _probe.upload_lag(last_stable_offset - start_upload_offset);
+    if (_upload_scheduler) {
+        _backlog_bytes = estimate_backlog_size();
+        _upload_scheduler->report_backlog(_ntp, _backlog_bytes);
+    }
 
     return ss::do_with(
       std::vector<scheduled_upload>(),
@@ -676,7 +1177,9 @@ ss::future<ntp_archiver::batch_result> ntp_archiver::wait_all_scheduled_uploads(
               upload.meta->base_offset - expected_base_offset);
         }
 
-        _manifest.add(segment_name(*upload.name), *upload.meta);
+        auto meta = *upload.meta;
+        meta.has_index = *upload.index_uploaded;
+        _manifest.add(segment_name(*upload.name), meta);
     }
     if (total.num_succeded != 0) {
         vlog(
@@ -694,39 +1197,62 @@ ss::future<ntp_archiver::batch_result> ntp_archiver::wait_all_scheduled_uploads(
               _manifest.get_manifest_path());
         }
 
-        if (_partition->archival_meta_stm()) {
-            auto deadline = ss::lowres_clock::now() + _manifest_upload_timeout;
-            auto error = co_await _partition->archival_meta_stm()->add_segments(
-              _manifest, deadline, _as);
-            if (
-              error != cluster::errc::success
-              && error != cluster::errc::not_leader) {
-                vlog(
-                  _rtclog.warn,
-                  "archival metadata STM update failed: {}",
-                  error);
-            }
-        }
-
+        _archival_metadata_pending = true;
         _last_upload_time = ss::lowres_clock::now();
     }
     co_return total;
 }
 
+ss::future<>
+ntp_archiver::update_archival_metadata(coalesce_metadata coalesce) {
+    auto stm = _partition->archival_meta_stm();
+    if (!stm || !_archival_metadata_pending) {
+        co_return;
+    }
+    auto now = ss::lowres_clock::now();
+    if (
+      coalesce
+      && now < _last_archival_metadata_update
+                 + _metadata_replication_interval()) {
+        vlog(_rtclog.trace, "Deferring archival metadata STM update");
+        co_return;
+    }
+
+    auto deadline = now + _manifest_upload_timeout;
+    auto error = co_await stm->add_segments(_manifest, deadline, _as);
+    if (error != cluster::errc::success && error != cluster::errc::not_leader) {
+        // still pending, retried with the next upload cycle
+        vlog(_rtclog.warn, "archival metadata STM update failed: {}", error);
+        co_return;
+    }
+    _archival_metadata_pending = false;
+    _last_archival_metadata_update = now;
+}
+
 ss::future<ntp_archiver::batch_result> ntp_archiver::upload_next_candidates(
   std::optional<model::offset> lso_override) {
+    return do_upload_next_candidates(lso_override, coalesce_metadata::no);
+}
+
+ss::future<ntp_archiver::batch_result>
+ntp_archiver::do_upload_next_candidates(
+  std::optional<model::offset> lso_override, coalesce_metadata coalesce) {
     vlog(_rtclog.debug, "Uploading next candidates called for {}", _ntp);
     auto last_stable_offset = lso_override ? *lso_override
                                            : _partition->last_stable_offset();
     return ss::with_gate(
              _gate,
-             [this, last_stable_offset] {
+             [this, last_stable_offset, coalesce] {
                  return ss::with_semaphore(
-                   _mutex, 1, [this, last_stable_offset] {
+                   _mutex, 1, [this, last_stable_offset, coalesce] {
                        return schedule_uploads(last_stable_offset)
                          .then([this](std::vector<scheduled_upload> scheduled) {
                              return wait_all_scheduled_uploads(
                                std::move(scheduled));
+                         })
+                         .then([this, coalesce](batch_result result) {
+                             return update_archival_metadata(coalesce).then(
+                               [result] { return result; });
                          });
                    });
              })
@@ -772,10 +1298,7 @@ ntp_archiver::maybe_truncate_manifest(retry_chain_node& rtc) {
     for (const auto& [key, meta] : _manifest) {
         retry_chain_node fib(
           _manifest_upload_timeout, _upload_loop_initial_backoff, &rtc);
-        auto sname = cloud_storage::generate_segment_name(
-          key.base_offset, key.term);
-        auto spath = cloud_storage::generate_remote_segment_path(
-          _ntp, _rev, sname, meta.archiver_term);
+        auto spath = _manifest.generate_segment_path(key, meta);
         auto result = co_await _remote.segment_exists(_bucket, spath, fib);
         if (result == cloud_storage::download_result::notfound) {
             vlog(
@@ -12,7 +12,9 @@
 #include "archival/archival_policy.h"
 #include "archival/probe.h"
 #include "archival/types.h"
+#include "archival/upload_scheduler.h"
 #include "cloud_storage/remote.h"
+#include "cloud_storage/remote_segment_index.h"
 #include "cloud_storage/types.h"
 #include "cluster/fwd.h"
 #include "cluster/partition.h"
@@ -27,7 +29,9 @@
 #include <seastar/core/io_priority_class.hh>
 #include <seastar/core/lowres_clock.hh>
 #include <seastar/core/shared_ptr.hh>
+#include <seastar/util/bool_class.hh>
 
+#include <deque>
 #include <functional>
 #include <map>
 
@@ -67,12 +71,15 @@ public:
     /// \param conf is an S3 client configuration
     /// \param remote is an object used to send/recv data
     /// \param svc_probe is a service level probe (optional)
+    /// \param scheduler dispatches the uploads of all archivers of the shard
+    ///        (optional)
     ntp_archiver(
       const storage::ntp_config& ntp,
       cluster::partition_manager&,
       const configuration& conf,
       cloud_storage::remote& remote,
-      ss::lw_shared_ptr<cluster::partition> part);
+      ss::lw_shared_ptr<cluster::partition> part,
+      ss::lw_shared_ptr<upload_scheduler> scheduler = nullptr);
 
     /// Start the fiber that will upload the partition data to the cloud
     /// storage. Can be started only once.
@@ -127,14 +134,19 @@ public:
     /// \brief Upload next set of segments to S3 (if any)
     /// The semaphore is used to track number of parallel uploads. The method
     /// will pick not more than '_concurrency' candidates and start
-    /// uploading them.
+    /// uploading them. The uploaded segments are added to the archival
+    /// metadata STM before the method returns.
     ///
     /// \param lso_override last stable offset override
     /// \return future that returns number of uploaded/failed segments
     ss::future<batch_result> upload_next_candidates(
       std::optional<model::offset> last_stable_offset_override = std::nullopt);
 
-    ss::future<cloud_storage::download_result> sync_manifest();
+    /// Download the manifest in read-replica mode and replicate the new
+    /// segments to the archival metadata STM. The manifest is only
+    /// downloaded if it changed since the last sync.
+    ss::future<cloud_storage::remote::conditional_download_result>
+    sync_manifest();
 
     uint64_t estimate_backlog_size();
 
@@ -143,6 +155,17 @@ public:
     maybe_truncate_manifest(retry_chain_node& rtc);
 
 private:
+    using coalesce_metadata = ss::bool_class<struct coalesce_metadata_tag>;
+
+    ss::future<batch_result> do_upload_next_candidates(
+      std::optional<model::offset>, coalesce_metadata);
+
+    /// Replicates the segments uploaded since the last update to the archival
+    /// metadata STM. When coalescing, the update is deferred until the
+    /// replication interval has passed since the last one, so that the
+    /// uploads of several cycles are replicated in a single batch.
+    ss::future<> update_archival_metadata(coalesce_metadata);
+
     /// Information about started upload
     struct scheduled_upload {
         /// The future that will be ready when the segment will be fully
@@ -162,9 +185,11 @@ private:
         /// case the upload is not started but the method might be called
         /// again anyway.
         ss::stop_iteration stop;
-        /// Protects the underlying segment from being deleted while the upload
-        /// is in flight.
-        std::optional<ss::rwlock::holder> segment_read_lock;
+        /// Protect the underlying segments from being deleted while the
+        /// upload is in flight.
+        std::vector<ss::rwlock::holder> segment_read_locks;
+        /// Set if the offset index was uploaded along with the segment
+        ss::lw_shared_ptr<bool> index_uploaded;
     };
 
     /// Start upload without waiting for it to complete
@@ -183,9 +208,56 @@ private:
 
     /// Upload individual segment to S3.
     ///
+    /// The offset index of the segment is built from the data read for the
+    /// upload and uploaded next to the segment, so that hydration doesn't
+    /// have to scan the segment. The index is best effort, the result only
+    /// reflects the upload of the segment.
+    ///
+    /// \param compression_frame_size is set if the segment should be
+    ///        compressed
+    /// \param delta is the offset delta at the base of the segment
+    /// \param index_uploaded is set if the index is uploaded
     /// \return error code
-    ss::future<cloud_storage::upload_result>
-    upload_segment(upload_candidate candidate);
+    ss::future<cloud_storage::upload_result> upload_segment(
+      upload_candidate candidate,
+      std::optional<size_t> compression_frame_size,
+      model::offset delta,
+      ss::lw_shared_ptr<bool> index_uploaded);
+
+    /// Index the segment read from 'stream' and close 'source' afterwards.
+    /// Returns false if the segment couldn't be indexed.
+    ss::future<bool> build_index(
+      ss::input_stream<char> stream,
+      std::optional<storage::segment_reader_handle> source,
+      model::offset delta,
+      cloud_storage::offset_index& index);
+
+    /// Abort source of the uploads which aborts them if the leadership is
+    /// lost or the term changes.
+    cloud_storage::lazy_abort_source make_upload_abort_source();
+
+    /// Run of adjacent archived segments in the same term that can be merged
+    using merge_candidates = std::vector<std::pair<
+      cloud_storage::partition_manifest::key,
+      cloud_storage::partition_manifest::segment_meta>>;
+
+    /// Find the first run of at least two adjacent segments smaller than half
+    /// of the target size which add up to at most the target size. Only the
+    /// segments which are already replicated to the archival metadata STM
+    /// are considered.
+    merge_candidates find_merge_candidates(size_t target_size) const;
+
+    /// Merge a run of small archived segments into a single object.
+    ///
+    /// The segments are downloaded and uploaded again as one object with the
+    /// union of their transactions metadata and a new offset index. The
+    /// manifest entries are replaced through the archival metadata STM and
+    /// the merged segments are scheduled for deletion.
+    ss::future<> maybe_merge_segments();
+
+    /// Delete the segments replaced by a merge once the readers which
+    /// could have started before the merge are done.
+    ss::future<> delete_replaced_segments();
 
     /// Upload segment's transactions metadata to S3.
     ///
@@ -217,6 +289,8 @@ private:
     /// Remote manifest contains representation of the data stored in S3 (it
     /// gets uploaded to the remote location)
     cloud_storage::partition_manifest _manifest;
+    /// ETag of the manifest downloaded by the last sync in read-replica mode
+    ss::sstring _manifest_etag;
     ss::gate _gate;
     ss::abort_source _as;
     retry_chain_node _rtcnode;
@@ -228,9 +302,33 @@ private:
     ss::lowres_clock::duration _upload_loop_initial_backoff;
     ss::lowres_clock::duration _upload_loop_max_backoff;
     config::binding<std::chrono::milliseconds> _sync_manifest_timeout;
+    config::binding<std::optional<size_t>> _multipart_part_size;
+    config::binding<size_t> _multipart_concurrency;
+    config::binding<bool> _segment_compression;
+    config::binding<size_t> _compression_frame_size;
     simple_time_jitter<ss::lowres_clock> _backoff_jitter{100ms};
     size_t _concurrency{4};
     ss::lowres_clock::time_point _last_upload_time;
+    config::binding<std::chrono::milliseconds> _metadata_replication_interval;
+    // the manifest has segments the archival metadata STM may not have, set
+    // initially to reconcile the STM with the manifest downloaded on start
+    bool _archival_metadata_pending{true};
+    ss::lowres_clock::time_point _last_archival_metadata_update;
+    config::binding<bool> _remote_segment_merging;
+    config::binding<std::optional<size_t>> _segment_merge_target_size;
+    struct replaced_segment {
+        cloud_storage::remote_segment_path path;
+        bool has_index;
+        ss::lowres_clock::time_point delete_after;
+    };
+    // only tracked in memory, the segments replaced before a leadership
+    // change are left in the bucket
+    std::deque<replaced_segment> _replaced_segments;
+    /// Shared by the archivers of the shard, not set if the uploads are
+    /// only limited by the concurrency of the archiver
+    ss::lw_shared_ptr<upload_scheduler> _upload_scheduler;
+    /// Upload backlog estimated when the uploads are scheduled
+    uint64_t _backlog_bytes{0};
     ss::scheduling_group _upload_sg;
     ss::io_priority_class _io_priority;
 
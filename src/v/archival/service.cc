@@ -161,6 +161,18 @@ void scheduler_service_impl::rearm_timer() {
     });
 }
 ss::future<> scheduler_service_impl::start() {
+    // The node wide budget is split evenly between the shards
+    const auto& cfg = config::shard_local_cfg();
+    size_t max_uploads = _remote.local().concurrency();
+    if (auto node_uploads = cfg.cloud_storage_max_concurrent_uploads()) {
+        max_uploads = std::max<size_t>(1, *node_uploads / ss::smp::count);
+    }
+    auto max_bytes = cfg.cloud_storage_max_upload_bytes_in_flight();
+    if (max_bytes) {
+        *max_bytes /= ss::smp::count;
+    }
+    _upload_scheduler = ss::make_lw_shared<upload_scheduler>(
+      max_uploads, max_bytes, _conf.svc_metrics_disabled);
     _timer.set_callback([this] { rearm_timer(); });
     _timer.rearm(_jitter());
     return ss::now();
@@ -310,7 +322,8 @@ scheduler_service_impl::create_archivers(std::vector<model::ntp> to_create) {
                 _partition_manager.local(),
                 _conf,
                 _remote.local(),
-                part);
+                part,
+                _upload_scheduler);
               return add_ntp_archiver(archiver);
           } else {
               return ss::now();
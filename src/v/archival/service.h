@@ -10,6 +10,7 @@
 
 #pragma once
 #include "archival/ntp_archiver_service.h"
+#include "archival/upload_scheduler.h"
 #include "cluster/fwd.h"
 #include "model/fundamental.h"
 #include "s3/client.h"
@@ -133,6 +134,8 @@ private:
     retry_chain_logger _rtclog;
     service_probe _probe;
     ss::sharded<cloud_storage::remote>& _remote;
+    /// Shared by the archivers of the shard, created on start
+    ss::lw_shared_ptr<upload_scheduler> _upload_scheduler;
     ss::lowres_clock::duration _topic_manifest_upload_timeout;
     ss::lowres_clock::duration _initial_backoff;
     ss::scheduling_group _upload_sg;
@@ -14,6 +14,7 @@
 #include "bytes/iobuf.h"
 #include "cloud_storage/remote.h"
 #include "cloud_storage/types.h"
+#include "config/configuration.h"
 #include "model/metadata.h"
 #include "net/unresolved_address.h"
 #include "raft/offset_translator.h"
@@ -22,10 +23,12 @@
 #include "storage/parser.h"
 #include "storage/tests/utils/disk_log_builder.h"
 #include "test_utils/fixture.h"
+#include "units.h"
 #include "utils/retry_chain_node.h"
 
 #include <seastar/core/future-util.hh>
 #include <seastar/core/sstring.hh>
+#include <seastar/util/defer.hh>
 
 #include <boost/test/tools/old/interface.hpp>
 
@@ -123,7 +126,8 @@ FIXTURE_TEST(test_upload_segments, archiver_fixture) {
     for (auto [url, req] : get_targets()) {
         vlog(test_log.info, "{} {}", req._method, req._url);
     }
-    BOOST_REQUIRE_EQUAL(get_requests().size(), 3);
+    // manifest, segments and their indices
+    BOOST_REQUIRE_EQUAL(get_requests().size(), 5);
 
     cloud_storage::partition_manifest manifest;
     {
@@ -143,6 +147,12 @@ FIXTURE_TEST(test_upload_segments, archiver_fixture) {
         const auto& [url, req] = *it;
         BOOST_REQUIRE_EQUAL(req._method, "PUT"); // NOLINT
         verify_segment(manifest_ntp, segment1_name, req.content);
+
+        // the index is uploaded next to the segment
+        auto index_url = cloud_storage::generate_remote_index_path(
+          segment1_url);
+        BOOST_REQUIRE(get_targets().count("/" + index_url().string()));
+        BOOST_REQUIRE(manifest.get(segment1_name)->has_index);
     }
 
     {
@@ -231,6 +241,99 @@ FIXTURE_TEST(test_archiver_policy, archiver_fixture) {
     BOOST_REQUIRE(upload5.source.get() == nullptr);
 }
 
+// NOLINTNEXTLINE
+SEASTAR_THREAD_TEST_CASE(test_archival_policy_merges_small_segments) {
+    storage::disk_log_builder b;
+    b | storage::start(manifest_ntp);
+    // three closed segments and the active one
+    for (int i = 0; i < 4; i++) {
+        auto base = model::offset(i * 10);
+        if (i == 0) {
+            b | storage::add_segment(base);
+        } else {
+            b.get_disk_log_impl()
+              .force_roll(ss::default_priority_class())
+              .get();
+        }
+        b | storage::add_random_batch(base, 10);
+    }
+
+    auto& cfg = config::shard_local_cfg();
+    cfg.get("cloud_storage_segment_merge_target_size")
+      .set_value(std::make_optional<size_t>(1_GiB));
+    cfg.get("cloud_storage_segment_merge_max_delay_ms")
+      .set_value(std::chrono::milliseconds(1h));
+    auto reset = ss::defer([&cfg] {
+        cfg.get("cloud_storage_segment_merge_target_size")
+          .set_value(std::optional<size_t>{});
+        cfg.get("cloud_storage_segment_merge_max_delay_ms")
+          .set_value(std::chrono::milliseconds(10min));
+    });
+    archival::archival_policy policy(manifest_ntp);
+
+    auto log = b.get_log();
+    raft::offset_translator tr(
+      {model::record_batch_type::raft_configuration,
+       model::record_batch_type::archival_metadata},
+      raft::group_id{0},
+      manifest_ntp,
+      b.storage());
+    tr.start(raft::offset_translator::must_reset::yes, {}).get();
+    tr.sync_with_log(log, std::nullopt).get();
+    const auto& tr_state = *tr.state();
+    auto last_stable_offset = log.offsets().dirty_offset + model::offset{1};
+
+    // The last segment is not closed, the merged upload waits for it
+    auto upload1 = policy
+                     .get_next_candidate(
+                       model::offset(0), last_stable_offset, log, tr_state)
+                     .get();
+    BOOST_REQUIRE(!upload1.source);
+
+    // The delay has elapsed, all closed segments are uploaded as one object
+    cfg.get("cloud_storage_segment_merge_max_delay_ms")
+      .set_value(std::chrono::milliseconds(0));
+    auto upload2 = policy
+                     .get_next_candidate(
+                       model::offset(0), last_stable_offset, log, tr_state)
+                     .get();
+    BOOST_REQUIRE(upload2.source);
+    BOOST_REQUIRE_EQUAL(upload2.exposed_name, "0-0-v1.log");
+    BOOST_REQUIRE_EQUAL(upload2.merged.size(), 2);
+    BOOST_REQUIRE_EQUAL(upload2.final_offset, model::offset(29));
+
+    size_t expected_size = upload2.source->reader().file_size();
+    for (const auto& s : upload2.merged) {
+        expected_size += s->reader().file_size();
+    }
+    BOOST_REQUIRE_EQUAL(upload2.content_length, expected_size);
+
+    // The object is a concatenation of the segments
+    auto handle = make_upload_candidate_stream(
+                    upload2,
+                    0,
+                    upload2.content_length,
+                    ss::default_priority_class())
+                    .get();
+    auto data = read_iobuf_exactly(handle.stream(), expected_size + 1).get();
+    handle.close().get();
+    BOOST_REQUIRE_EQUAL(data.size_bytes(), expected_size);
+
+    // A part of the object that spans the segments boundary
+    auto first_size = upload2.source->reader().file_size();
+    auto part_handle = make_upload_candidate_stream(
+                         upload2,
+                         first_size - 10,
+                         20,
+                         ss::default_priority_class())
+                         .get();
+    auto part = read_iobuf_exactly(part_handle.stream(), 21).get();
+    part_handle.close().get();
+    BOOST_REQUIRE(part == data.share(first_size - 10, 20));
+
+    b.stop().get();
+}
+
 // NOLINTNEXTLINE
 SEASTAR_THREAD_TEST_CASE(test_archival_policy_timeboxed_uploads) {
     storage::disk_log_builder b;
@@ -292,6 +395,72 @@ SEASTAR_THREAD_TEST_CASE(test_archival_policy_timeboxed_uploads) {
     b.stop().get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_archival_policy_upload_cursor) {
+    storage::disk_log_builder b;
+    b | storage::start(manifest_ntp) | storage::add_segment(model::offset{0})
+      | storage::add_random_batch(model::offset{0}, 10)
+      | storage::add_random_batch(model::offset{10}, 10);
+
+    archival::archival_policy policy(manifest_ntp, segment_time_limit{0s});
+
+    auto log = b.get_log();
+
+    raft::offset_translator tr(
+      {model::record_batch_type::raft_configuration,
+       model::record_batch_type::archival_metadata},
+      raft::group_id{0},
+      manifest_ntp,
+      b.storage());
+    tr.start(raft::offset_translator::must_reset::yes, {}).get();
+    tr.sync_with_log(log, std::nullopt).get();
+    const auto& tr_state = *tr.state();
+
+    auto start_offset = model::offset{0};
+    auto last_stable_offset = log.offsets().dirty_offset + model::offset{1};
+    auto upload1 = policy
+                     .get_next_candidate(
+                       start_offset, last_stable_offset, log, tr_state)
+                     .get();
+    BOOST_REQUIRE(upload1.source);
+    BOOST_REQUIRE_EQUAL(upload1.final_offset, model::offset{19});
+
+    // Nothing was appended since the first upload
+    start_offset = upload1.final_offset + model::offset{1};
+    auto upload2 = policy
+                     .get_next_candidate(
+                       start_offset, last_stable_offset, log, tr_state)
+                     .get();
+    BOOST_REQUIRE(!upload2.source);
+
+    b | storage::add_random_batch(model::offset{20}, 10);
+    tr.sync_with_log(log, std::nullopt).get();
+    last_stable_offset = log.offsets().dirty_offset + model::offset{1};
+
+    // The upload that starts where the previous one ended has to match the
+    // one found without the cursor
+    auto upload3 = policy
+                     .get_next_candidate(
+                       start_offset, last_stable_offset, log, tr_state)
+                     .get();
+    archival::archival_policy fresh_policy(
+      manifest_ntp, segment_time_limit{0s});
+    auto expected = fresh_policy
+                      .get_next_candidate(
+                        start_offset, last_stable_offset, log, tr_state)
+                      .get();
+    BOOST_REQUIRE(upload3.source);
+    BOOST_REQUIRE(expected.source);
+    BOOST_REQUIRE_EQUAL(upload3.starting_offset, start_offset);
+    BOOST_REQUIRE_EQUAL(upload3.starting_offset, expected.starting_offset);
+    BOOST_REQUIRE_EQUAL(upload3.file_offset, upload1.final_file_offset);
+    BOOST_REQUIRE_EQUAL(upload3.file_offset, expected.file_offset);
+    BOOST_REQUIRE_EQUAL(upload3.final_offset, expected.final_offset);
+    BOOST_REQUIRE_EQUAL(upload3.content_length, expected.content_length);
+    BOOST_REQUIRE_EQUAL(upload3.exposed_name, expected.exposed_name);
+
+    b.stop().get();
+}
+
 // NOLINTNEXTLINE
 FIXTURE_TEST(test_upload_segments_leadership_transfer, archiver_fixture) {
     // This test simulates leadership transfer. In this situation the
@@ -365,7 +534,7 @@ FIXTURE_TEST(test_upload_segments_leadership_transfer, archiver_fixture) {
     for (auto req : get_requests()) {
         vlog(test_log.info, "{} {}", req._method, req._url);
     }
-    BOOST_REQUIRE_EQUAL(get_requests().size(), 4);
+    BOOST_REQUIRE_EQUAL(get_requests().size(), 6);
 
     cloud_storage::partition_manifest manifest;
     {
@@ -584,7 +753,7 @@ static void test_partial_upload_impl(
     for (auto req : test.get_requests()) {
         vlog(test_log.info, "{} {}", req._method, req._url);
     }
-    BOOST_REQUIRE_EQUAL(test.get_requests().size(), 3);
+    BOOST_REQUIRE_EQUAL(test.get_requests().size(), 4);
 
     {
         auto [begin, end] = test.get_targets().equal_range(manifest_url);
@@ -625,7 +794,7 @@ static void test_partial_upload_impl(
     BOOST_REQUIRE_EQUAL(res.num_succeded, 1);
     BOOST_REQUIRE_EQUAL(res.num_failed, 0);
 
-    BOOST_REQUIRE_EQUAL(test.get_requests().size(), 5);
+    BOOST_REQUIRE_EQUAL(test.get_requests().size(), 7);
     {
         auto [begin, end] = test.get_targets().equal_range(manifest_url);
         size_t len = std::distance(begin, end);
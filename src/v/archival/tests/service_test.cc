@@ -200,8 +200,8 @@ FIXTURE_TEST(test_segment_upload, archiver_fixture) {
     service.reconcile_archivers().get();
     BOOST_REQUIRE(service.contains(ntp));
 
-    // 2 partition manifests, 1 topic manifest, 2 segments
-    const size_t num_requests_expected = 5;
+    // 2 partition manifests, 1 topic manifest, 2 segments and their indices
+    const size_t num_requests_expected = 7;
     tests::cooperative_spin_wait_with_timeout(10s, [this] {
         return get_requests().size() == num_requests_expected;
     }).get();
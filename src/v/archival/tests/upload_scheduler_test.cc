@@ -0,0 +1,84 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/redpanda-data/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "archival/upload_scheduler.h"
+#include "model/fundamental.h"
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <boost/test/tools/old/interface.hpp>
+
+using namespace archival;
+
+static model::ntp make_ntp(int partition) {
+    return model::ntp(
+      model::ns("kafka"),
+      model::topic("test-topic"),
+      model::partition_id(partition));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_upload_scheduler_concurrency) {
+    upload_scheduler scheduler(2, std::nullopt, service_metrics_disabled::yes);
+    ss::abort_source as;
+    auto p1 = scheduler.acquire(make_ntp(0), 100, 0, as).get();
+    auto p2 = scheduler.acquire(make_ntp(1), 100, 0, as).get();
+    BOOST_REQUIRE_EQUAL(scheduler.in_flight(), 2);
+
+    auto f3 = scheduler.acquire(make_ntp(2), 100, 0, as);
+    BOOST_REQUIRE(!f3.available());
+    BOOST_REQUIRE_EQUAL(scheduler.waiters(), 1);
+
+    p1 = upload_scheduler::permit{};
+    auto p3 = f3.get();
+    BOOST_REQUIRE_EQUAL(scheduler.in_flight(), 2);
+    BOOST_REQUIRE_EQUAL(scheduler.waiters(), 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_upload_scheduler_bytes_budget) {
+    upload_scheduler scheduler(10, 1000, service_metrics_disabled::yes);
+    ss::abort_source as;
+    // larger than the budget, admitted when nothing else is in flight
+    auto large = scheduler.acquire(make_ntp(0), 5000, 0, as).get();
+    auto f = scheduler.acquire(make_ntp(1), 100, 0, as);
+    BOOST_REQUIRE(!f.available());
+    large = upload_scheduler::permit{};
+    auto small = f.get();
+    BOOST_REQUIRE_EQUAL(scheduler.bytes_in_flight(), 100);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_upload_scheduler_backlog_priority) {
+    upload_scheduler scheduler(1, std::nullopt, service_metrics_disabled::yes);
+    ss::abort_source as;
+    auto p = scheduler.acquire(make_ntp(0), 100, 0, as).get();
+
+    // the partition with the largest backlog goes first
+    auto quiet = scheduler.acquire(make_ntp(1), 100, 1000, as);
+    auto busy = scheduler.acquire(make_ntp(2), 100, 1000000, as);
+    p = upload_scheduler::permit{};
+    auto busy_permit = busy.get();
+    BOOST_REQUIRE(!quiet.available());
+    BOOST_REQUIRE_EQUAL(scheduler.waiters(), 1);
+    busy_permit = upload_scheduler::permit{};
+    quiet.get();
+}
+
+SEASTAR_THREAD_TEST_CASE(test_upload_scheduler_abort) {
+    upload_scheduler scheduler(1, std::nullopt, service_metrics_disabled::yes);
+    ss::abort_source as;
+    ss::abort_source waiter_as;
+    auto p = scheduler.acquire(make_ntp(0), 100, 0, as).get();
+    auto f = scheduler.acquire(make_ntp(1), 100, 0, waiter_as);
+    waiter_as.request_abort();
+    BOOST_REQUIRE_THROW(f.get(), ss::abort_requested_exception);
+    BOOST_REQUIRE_EQUAL(scheduler.waiters(), 0);
+    p = upload_scheduler::permit{};
+    BOOST_REQUIRE_EQUAL(scheduler.in_flight(), 0);
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/redpanda-data/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "archival/upload_scheduler.h"
+
+#include "archival/logger.h"
+#include "prometheus/prometheus_sanitize.h"
+#include "units.h"
+#include "vassert.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/metrics.hh>
+
+#include <algorithm>
+#include <chrono>
+
+namespace archival {
+
+// A waiter gains this much priority per second in the queue, as if its
+// backlog grew by that amount
+static constexpr uint64_t aging_bytes_per_second = 16_MiB;
+
+upload_scheduler::upload_scheduler(
+  size_t max_concurrency,
+  std::optional<size_t> max_bytes_in_flight,
+  service_metrics_disabled disable_metrics)
+  : _max_concurrency(std::max<size_t>(max_concurrency, 1))
+  , _max_bytes_in_flight(max_bytes_in_flight)
+  , _disable_metrics(disable_metrics) {}
+
+upload_scheduler::~upload_scheduler() {
+    vassert(
+      _in_flight == 0 && _waiters.empty(),
+      "upload scheduler destroyed with {} uploads in flight and {} waiters",
+      _in_flight,
+      _waiters.size());
+}
+
+uint64_t upload_scheduler::topic_stats::total_backlog_bytes() const {
+    uint64_t total = 0;
+    for (const auto& [_, bytes] : backlog_bytes) {
+        total += bytes;
+    }
+    return total;
+}
+
+bool upload_scheduler::fits(size_t bytes) const {
+    if (_in_flight >= _max_concurrency) {
+        return false;
+    }
+    return !_max_bytes_in_flight || _in_flight == 0
+           || _bytes_in_flight + bytes <= *_max_bytes_in_flight;
+}
+
+ss::future<upload_scheduler::permit> upload_scheduler::acquire(
+  const model::ntp& ntp,
+  size_t size_bytes,
+  uint64_t backlog_bytes,
+  ss::abort_source& as) {
+    as.check();
+    model::topic_namespace tn(ntp.ns, ntp.tp.topic);
+    get_topic(tn).backlog_bytes[ntp.tp.partition] = backlog_bytes;
+    if (_waiters.empty() && fits(size_bytes)) {
+        ++_in_flight;
+        _bytes_in_flight += size_bytes;
+        co_return permit(*this, size_bytes);
+    }
+
+    auto w = ss::make_lw_shared<waiter>(waiter{
+      .topic = tn,
+      .size_bytes = size_bytes,
+      .backlog_bytes = backlog_bytes,
+      .enqueued = ss::lowres_clock::now(),
+    });
+    _waiters.push_back(w);
+    ++get_topic(tn).queued_uploads;
+    auto sub = as.subscribe([this, w]() noexcept {
+        if (w->dispatched) {
+            return;
+        }
+        _waiters.remove(w);
+        --get_topic(w->topic).queued_uploads;
+        w->ready.set_exception(ss::abort_requested_exception{});
+    });
+    if (!sub) {
+        _waiters.remove(w);
+        --get_topic(tn).queued_uploads;
+        throw ss::abort_requested_exception{};
+    }
+    co_await w->ready.get_future();
+    co_return permit(*this, size_bytes);
+}
+
+void upload_scheduler::release(size_t bytes) {
+    --_in_flight;
+    _bytes_in_flight -= bytes;
+    dispatch();
+}
+
+upload_scheduler::waiter_list::iterator upload_scheduler::next_waiter() {
+    auto now = ss::lowres_clock::now();
+    auto priority = [now](const waiter& w) {
+        auto waited = std::chrono::duration_cast<std::chrono::seconds>(
+                        now - w.enqueued)
+                        .count();
+        return w.backlog_bytes
+               + static_cast<uint64_t>(waited) * aging_bytes_per_second;
+    };
+    return std::max_element(
+      _waiters.begin(),
+      _waiters.end(),
+      [&priority](
+        const ss::lw_shared_ptr<waiter>& a,
+        const ss::lw_shared_ptr<waiter>& b) {
+          return priority(*a) < priority(*b);
+      });
+}
+
+void upload_scheduler::dispatch() {
+    while (!_waiters.empty()) {
+        auto it = next_waiter();
+        auto w = *it;
+        // the head of the queue waits for room even if smaller uploads fit,
+        // large uploads are not starved by small ones
+        if (!fits(w->size_bytes)) {
+            return;
+        }
+        _waiters.erase(it);
+        --get_topic(w->topic).queued_uploads;
+        ++_in_flight;
+        _bytes_in_flight += w->size_bytes;
+        w->dispatched = true;
+        w->ready.set_value();
+    }
+}
+
+void upload_scheduler::report_backlog(
+  const model::ntp& ntp, uint64_t backlog_bytes) {
+    get_topic(model::topic_namespace(ntp.ns, ntp.tp.topic))
+      .backlog_bytes[ntp.tp.partition]
+      = backlog_bytes;
+}
+
+void upload_scheduler::remove(const model::ntp& ntp) {
+    model::topic_namespace tn(ntp.ns, ntp.tp.topic);
+    auto it = _topics.find(tn);
+    if (it == _topics.end()) {
+        return;
+    }
+    it->second.backlog_bytes.erase(ntp.tp.partition);
+    maybe_remove_topic(tn);
+}
+
+upload_scheduler::topic_stats&
+upload_scheduler::get_topic(const model::topic_namespace& tn) {
+    auto [it, inserted] = _topics.try_emplace(tn);
+    if (!inserted || _disable_metrics) {
+        return it->second;
+    }
+    namespace sm = ss::metrics;
+    auto& stats = it->second;
+    const std::vector<sm::label_instance> labels = {
+      sm::label("namespace")(tn.ns()),
+      sm::label("topic")(tn.tp()),
+    };
+    stats.metrics.add_group(
+      prometheus_sanitize::metrics_name("archival_upload_scheduler"),
+      {
+        sm::make_gauge(
+          "backlog_bytes",
+          [&stats] { return stats.total_backlog_bytes(); },
+          sm::description(
+            "Size of the data of the topic that is not uploaded yet"),
+          labels),
+        sm::make_gauge(
+          "queued_uploads",
+          [&stats] { return stats.queued_uploads; },
+          sm::description("Number of uploads of the topic waiting for a slot"),
+          labels),
+      });
+    return stats;
+}
+
+void upload_scheduler::maybe_remove_topic(const model::topic_namespace& tn) {
+    auto it = _topics.find(tn);
+    if (
+      it != _topics.end() && it->second.backlog_bytes.empty()
+      && it->second.queued_uploads == 0) {
+        _topics.erase(it);
+    }
+}
+
+} // namespace archival
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/redpanda-data/redpanda/blob/master/licenses/rcl.md
+ */
+
+#pragma once
+
+#include "archival/types.h"
+#include "model/fundamental.h"
+#include "seastarx.h"
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/shared_ptr.hh>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/node_hash_map.h>
+
+#include <list>
+#include <optional>
+
+namespace archival {
+
+/// Dispatches the segment uploads of all archivers of the shard under a
+/// shared budget of concurrent uploads and bytes in flight.
+///
+/// Archivers queue every upload with the size of their upload backlog, the
+/// data that is only stored on the local disk. A free slot goes to the
+/// waiter with the largest backlog, so the partitions that put the most
+/// pressure on the disk and lag behind the most are uploaded first. The
+/// priority of a waiter grows with the time it spends in the queue, so that
+/// partitions with a small backlog are not starved by busy ones.
+///
+/// The upload backlog of the partitions is exported per topic.
+class upload_scheduler {
+public:
+    /// Slot of an upload, released on destruction
+    class permit {
+    public:
+        permit() = default;
+        permit(upload_scheduler& s, size_t bytes)
+          : _scheduler(&s)
+          , _bytes(bytes) {}
+        permit(const permit&) = delete;
+        permit& operator=(const permit&) = delete;
+        permit(permit&& o) noexcept
+          : _scheduler(std::exchange(o._scheduler, nullptr))
+          , _bytes(o._bytes) {}
+        permit& operator=(permit&& o) noexcept {
+            if (this != &o) {
+                release();
+                _scheduler = std::exchange(o._scheduler, nullptr);
+                _bytes = o._bytes;
+            }
+            return *this;
+        }
+        ~permit() { release(); }
+
+    private:
+        void release() {
+            if (_scheduler) {
+                std::exchange(_scheduler, nullptr)->release(_bytes);
+            }
+        }
+
+        upload_scheduler* _scheduler{nullptr};
+        size_t _bytes{0};
+    };
+
+    /// \param max_concurrency is a max number of uploads in flight
+    /// \param max_bytes_in_flight is a max total size of the uploads in
+    ///        flight, not limited if not set
+    upload_scheduler(
+      size_t max_concurrency,
+      std::optional<size_t> max_bytes_in_flight,
+      service_metrics_disabled disable_metrics);
+
+    upload_scheduler(const upload_scheduler&) = delete;
+    upload_scheduler& operator=(const upload_scheduler&) = delete;
+    ~upload_scheduler();
+
+    /// Wait for a slot for an upload of 'size_bytes'. An upload larger than
+    /// the bytes budget is started once nothing else is in flight.
+    ///
+    /// \param backlog_bytes is the size of the upload backlog of the
+    ///        partition, it sets the priority of the upload
+    /// \throws ss::abort_requested_exception if 'as' is aborted while waiting
+    ss::future<permit> acquire(
+      const model::ntp& ntp,
+      size_t size_bytes,
+      uint64_t backlog_bytes,
+      ss::abort_source& as);
+
+    /// Update the upload backlog of the partition exported with the metrics
+    /// of its topic
+    void report_backlog(const model::ntp& ntp, uint64_t backlog_bytes);
+
+    /// Remove the partition from the metrics, called when its archiver stops
+    void remove(const model::ntp& ntp);
+
+    size_t in_flight() const { return _in_flight; }
+    size_t bytes_in_flight() const { return _bytes_in_flight; }
+    size_t waiters() const { return _waiters.size(); }
+
+private:
+    struct waiter {
+        model::topic_namespace topic;
+        size_t size_bytes;
+        uint64_t backlog_bytes;
+        ss::lowres_clock::time_point enqueued;
+        ss::promise<> ready;
+        bool dispatched{false};
+    };
+    using waiter_list = std::list<ss::lw_shared_ptr<waiter>>;
+
+    struct topic_stats {
+        absl::flat_hash_map<model::partition_id, uint64_t> backlog_bytes;
+        size_t queued_uploads{0};
+        ss::metrics::metric_groups metrics;
+
+        uint64_t total_backlog_bytes() const;
+    };
+
+    void release(size_t bytes);
+    bool fits(size_t bytes) const;
+    /// Start the uploads with the highest priority while there is room
+    void dispatch();
+    waiter_list::iterator next_waiter();
+    topic_stats& get_topic(const model::topic_namespace& tn);
+    void maybe_remove_topic(const model::topic_namespace& tn);
+
+    size_t _max_concurrency;
+    std::optional<size_t> _max_bytes_in_flight;
+    service_metrics_disabled _disable_metrics;
+    size_t _in_flight{0};
+    size_t _bytes_in_flight{0};
+    waiter_list _waiters;
+    // node map, the metrics refer to the stats
+    absl::node_hash_map<model::topic_namespace, topic_stats> _topics;
+};
+
+} // namespace archival
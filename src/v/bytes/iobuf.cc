@@ -157,6 +157,63 @@ iobuf iobuf_copy(iobuf::iterator_consumer& in, size_t len) {
     return ret;
 }
 
+iobuf iobuf_adopt_foreign(iobuf buf, ss::shard_id owner) {
+    if (owner == ss::this_shard_id()) {
+        return buf;
+    }
+    if (buf.empty()) {
+        return iobuf{};
+    }
+    auto foreign = std::make_unique<iobuf>(std::move(buf));
+    auto* src = foreign.get();
+    // a single deleter for all the fragments, dropping the last reference
+    // ships the original buffer back to its owner to be destroyed there
+    auto d = ss::make_deleter(
+      [owner, foreign = std::move(foreign)]() mutable {
+          (void)ss::smp::submit_to(owner, [foreign = std::move(foreign)] {});
+      });
+    iobuf ret;
+    for (auto& f : *src) {
+        ret.append_take_ownership(new iobuf::fragment(
+          ss::temporary_buffer<char>(f.get_write(), f.size(), d.share()),
+          iobuf::fragment::full{}));
+    }
+    return ret;
+}
+
+iobuf iobuf_compact(iobuf buf, size_t min_fragment_size) {
+    iobuf ret;
+    auto run_begin = buf.begin();
+    size_t run_bytes = 0;
+    size_t run_fragments = 0;
+    auto flush_run = [&](iobuf::iterator run_end) {
+        if (run_fragments == 1 && run_begin->available_bytes() == 0) {
+            // a lone fragment is already right-sized
+            ret.append_take_ownership(
+              new iobuf::fragment(run_begin->share(), iobuf::fragment::full{}));
+        } else if (run_bytes > 0) {
+            auto in = iobuf::iterator_consumer(run_begin, run_end);
+            ret.append_fragments(iobuf_copy(in, run_bytes));
+        }
+        run_begin = run_end;
+        run_bytes = 0;
+        run_fragments = 0;
+    };
+    for (auto it = buf.begin(); it != buf.end(); ++it) {
+        if (it->size() >= min_fragment_size && it->available_bytes() == 0) {
+            flush_run(it);
+            ret.append_take_ownership(
+              new iobuf::fragment(it->share(), iobuf::fragment::full{}));
+            run_begin = std::next(it);
+        } else {
+            run_bytes += it->size();
+            ++run_fragments;
+        }
+    }
+    flush_run(buf.end());
+    return ret;
+}
+
 iobuf iobuf::share(size_t pos, size_t len) {
     iobuf ret;
     size_t left = len;
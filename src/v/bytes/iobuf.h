@@ -408,6 +408,25 @@ ss::scattered_message<char> iobuf_as_scattered(iobuf b);
 ss::future<> write_iobuf_to_output_stream(iobuf, ss::output_stream<char>&);
 
 iobuf iobuf_copy(iobuf::iterator_consumer& in, size_t len);
+
+/// \brief coalesces runs of small or partially used fragments into
+/// right-sized fragments. full fragments of at least min_fragment_size are
+/// kept as they are. Meant for buffers that are about to be retained for a
+/// long time (e.g. caches) where many tiny fragments waste memory and
+/// fragment the allocator. Use copy() instead when the buffer may share
+/// memory that must not be retained, such as network read buffers.
+iobuf iobuf_compact(
+  iobuf,
+  size_t min_fragment_size
+  = details::io_allocation_size::ss_max_small_allocation);
+
+/// \brief takes an iobuf whose fragments belong to the owner shard without
+/// copying them. The returned fragments reference the original memory and
+/// the original buffer is destroyed back on the owner shard once all of them
+/// are released, so the reference counts of the original fragments are only
+/// ever touched by the owner. The caller must hold the only reference to the
+/// passed iobuf object, though its fragments may be shared on the owner.
+iobuf iobuf_adopt_foreign(iobuf, ss::shard_id owner);
 namespace std {
 template<>
 struct hash<::iobuf> {
@@ -46,12 +46,21 @@ public:
     size_t bytes_consumed() const { return _in.bytes_consumed(); }
 
     std::pair<int64_t, uint8_t> read_varlong() {
+        if (auto [val, length_size] = read_contiguous_varint(vint::max_length);
+            length_size > 0) {
+            return {vint::decode_zigzag(val), length_size};
+        }
         auto [val, length_size] = vint::deserialize(_in);
         _in.skip(length_size);
         return {val, length_size};
     }
 
     std::pair<uint32_t, uint8_t> read_unsigned_varint() {
+        if (auto [val, length_size] = read_contiguous_varint(
+              unsigned_vint::max_length);
+            length_size > 0) {
+            return {static_cast<uint32_t>(val), length_size};
+        }
         auto [val, length_size] = unsigned_vint::deserialize(_in);
         _in.skip(length_size);
         return {val, length_size};
@@ -108,6 +117,20 @@ protected:
     iobuf& ref() { return *std::get<owned_buf>(_buf); }
 
 private:
+    /// fast path for varints that do not straddle a fragment boundary.
+    /// returns zero bytes read when the byte-wise decoder must be used.
+    std::pair<uint64_t, uint8_t> read_contiguous_varint(size_t max_length) {
+        if (_in.segment_bytes_left() < sizeof(uint64_t)) {
+            return {0, 0};
+        }
+        auto [val, length_size] = unsigned_vint::detail::deserialize_word(
+          _in.segment_data(), max_length);
+        if (length_size > 0) {
+            _in.skip(length_size);
+        }
+        return {val, length_size};
+    }
+
     using const_ref = const iobuf*;
     using owned_buf = std::unique_ptr<iobuf>;
 
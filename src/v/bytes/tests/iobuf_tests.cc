@@ -672,3 +672,71 @@ SEASTAR_THREAD_TEST_CASE(iobuf_is_zero_test) {
     zero.append(zeros.data(), zeros.size());
     BOOST_REQUIRE_EQUAL(is_zero(zero), true);
 }
+
+SEASTAR_THREAD_TEST_CASE(iobuf_compact_test) {
+    constexpr size_t min_fragment_size
+      = details::io_allocation_size::ss_max_small_allocation;
+    iobuf buf;
+    // many tiny fragments, as left behind by small appends
+    for (int i = 0; i < 100; ++i) {
+        buf.append_fragments(bytes_to_iobuf(random_generators::get_bytes(10)));
+    }
+    // a large full fragment which is kept as is
+    ss::temporary_buffer<char> large(min_fragment_size * 2);
+    std::fill_n(large.get_write(), large.size(), 'x');
+    const char* large_data = large.get();
+    buf.append(std::move(large));
+    // a partly used fragment
+    buf.reserve_memory(min_fragment_size);
+    buf.append(random_generators::get_bytes(100).data(), 100);
+
+    auto expected = buf.copy();
+    auto compacted = iobuf_compact(std::move(buf));
+    BOOST_REQUIRE_EQUAL(compacted, expected);
+    BOOST_REQUIRE_EQUAL(std::distance(compacted.begin(), compacted.end()), 3);
+
+    auto it = compacted.begin();
+    BOOST_REQUIRE_EQUAL(it->size(), 1000);
+    BOOST_REQUIRE_EQUAL(it->available_bytes(), 0);
+    ++it;
+    BOOST_REQUIRE_EQUAL(it->get(), large_data);
+    ++it;
+    BOOST_REQUIRE_EQUAL(it->size(), 100);
+    BOOST_REQUIRE_EQUAL(it->available_bytes(), 0);
+
+    BOOST_REQUIRE(iobuf_compact(iobuf{}).empty());
+}
+
+SEASTAR_THREAD_TEST_CASE(iobuf_adopt_foreign_test) {
+    if (ss::smp::count < 2) {
+        return;
+    }
+    const ss::shard_id owner = 1;
+    auto foreign = ss::smp::submit_to(owner, [] {
+                       auto buf = std::make_unique<iobuf>();
+                       append_sequence(*buf, 10);
+                       return ss::make_foreign(std::move(buf));
+                   }).get0();
+    auto expected = foreign->copy();
+    std::vector<const char*> fragments;
+    for (auto& f : *foreign) {
+        fragments.push_back(f.get());
+    }
+
+    auto adopted = iobuf_adopt_foreign(std::move(*foreign), owner);
+    BOOST_REQUIRE(foreign->empty());
+    BOOST_REQUIRE_EQUAL(adopted, expected);
+    // the memory is referenced, not copied
+    size_t i = 0;
+    for (auto& f : adopted) {
+        BOOST_REQUIRE_EQUAL(f.get(), fragments[i++]);
+    }
+    BOOST_REQUIRE_EQUAL(i, fragments.size());
+
+    // shares keep the foreign memory alive after the adopted buffer is gone
+    auto share = adopted.share(0, adopted.size_bytes());
+    adopted.clear();
+    BOOST_REQUIRE_EQUAL(share, expected);
+    share.clear();
+    ss::smp::submit_to(owner, [] {}).get();
+}
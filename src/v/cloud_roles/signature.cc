@@ -346,14 +346,28 @@ ss::sstring signature_v4::sha256_hexdigest(std::string_view payload) {
     return sha_256(payload);
 }
 
+const signature_v4::signing_key&
+signature_v4::get_signing_key(const ss::sstring& date_str) const {
+    if (_signing_key.date != date_str) {
+        static constexpr std::string_view service = "s3";
+        _signing_key = signing_key{
+          .date = date_str,
+          .key = gen_sig_key(_private_key(), date_str, _region(), service),
+          .scope = ssx::sformat(
+            "{}/{}/{}/aws4_request", date_str, _region(), service),
+        };
+        vlog(
+          clrl_log.trace,
+          "Credentials updated:\n[scope]\n{}\n",
+          _signing_key.scope);
+    }
+    return _signing_key;
+}
+
 std::error_code signature_v4::sign_header(
   http::client::request_header& header, std::string_view sha256) const {
     ss::sstring date_str = _sig_time.format_date();
-    ss::sstring service = "s3";
-    auto sign_key = gen_sig_key(_private_key(), date_str, _region(), service);
-    auto cred_scope = ssx::sformat(
-      "{}/{}/{}/aws4_request", date_str, _region(), service);
-    vlog(clrl_log.trace, "Credentials updated:\n[scope]\n{}\n", cred_scope);
+    const auto& signing = get_signing_key(date_str);
     auto amz_date = _sig_time.format_datetime();
     header.set("x-amz-date", {amz_date.data(), amz_date.size()});
     header.set("x-amz-content-sha256", {sha256.data(), sha256.size()});
@@ -368,13 +382,13 @@ std::error_code signature_v4::sign_header(
     }
     vlog(clrl_log.trace, "\n[canonical-request]\n{}\n", canonical_req.value());
     auto str_to_sign = get_string_to_sign(
-      amz_date, cred_scope, canonical_req.value());
-    auto digest = hmac(sign_key, str_to_sign);
+      amz_date, signing.scope, canonical_req.value());
+    auto digest = hmac(signing.key, str_to_sign);
     auto auth_header = fmt::format(
       "{} Credential={}/{},SignedHeaders={},Signature={}",
       algorithm,
       _access_key(),
-      cred_scope,
+      signing.scope,
       canonical_headers.value().signed_headers,
       hexdigest(digest));
     header.set(boost::beast::http::field::authorization, auth_header);
@@ -113,6 +113,17 @@ private:
     /// requirements)
     static ss::sstring sha256_hexdigest(std::string_view payload);
 
+    /// Signing key and credential scope of a date
+    struct signing_key {
+        ss::sstring date;
+        ss::sstring key;
+        ss::sstring scope;
+    };
+
+    /// \brief Return the signing key of the date, the key only changes
+    /// daily so it is derived once per date rather than for every request
+    const signing_key& get_signing_key(const ss::sstring& date_str) const;
+
     /// Time of the signing key
     time_source _sig_time;
     /// AWS region
@@ -121,6 +132,8 @@ private:
     public_key_str _access_key;
     /// Secret key
     private_key_str _private_key;
+    /// Signing key of the last signed date
+    mutable signing_key _signing_key;
 };
 
 template<class Fn>
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/redpanda-data/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "cloud_storage/cache_index.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace cloud_storage {
+
+void cache_index::update_order(const std::string& path, entry& e) {
+    if (e.hits < std::numeric_limits<uint32_t>::max()) {
+        e.hits++;
+    }
+    _order.erase(e.key);
+    e.key = {_age + e.hits, ++_seq};
+    _order.emplace(e.key, path);
+}
+
+uint64_t cache_index::put(std::string_view path, uint64_t size) {
+    auto [it, inserted] = _entries.try_emplace(
+      path, entry{.size = size, .hits = 0, .key = {0, 0}});
+    uint64_t prev_size = inserted ? 0 : it->second.size;
+    _size_bytes = _size_bytes - prev_size + size;
+    it->second.size = size;
+    update_order(it->first, it->second);
+    return prev_size;
+}
+
+void cache_index::touch(std::string_view path) {
+    if (auto it = _entries.find(path); it != _entries.end()) {
+        update_order(it->first, it->second);
+    }
+}
+
+std::optional<uint64_t> cache_index::remove(std::string_view path) {
+    auto it = _entries.find(path);
+    if (it == _entries.end()) {
+        return std::nullopt;
+    }
+    auto size = it->second.size;
+    _order.erase(it->second.key);
+    _size_bytes -= size;
+    _entries.erase(it);
+    return size;
+}
+
+std::optional<uint64_t> cache_index::evict(std::string_view path) {
+    auto it = _entries.find(path);
+    if (it == _entries.end()) {
+        return std::nullopt;
+    }
+    // Priority of the evicted file is the lowest one in the index, files
+    // accessed from now on start from it and outrank the old ones.
+    _age = std::max(_age, it->second.key.first);
+    return remove(path);
+}
+
+std::vector<cache_index::candidate> cache_index::eviction_candidates(
+  uint64_t bytes, const std::function<bool(std::string_view)>& skip) const {
+    std::vector<candidate> result;
+    uint64_t total = 0;
+    for (auto it = _order.begin(); it != _order.end() && total < bytes; ++it) {
+        if (skip(it->second)) {
+            continue;
+        }
+        auto size = _entries.find(it->second)->second.size;
+        result.push_back(candidate{
+          .path = ss::sstring(it->second.data(), it->second.size()),
+          .size = size});
+        total += size;
+    }
+    return result;
+}
+
+void cache_index::clear() {
+    _entries.clear();
+    _order.clear();
+    _size_bytes = 0;
+}
+
+uint32_t cache_index::hits(std::string_view path) const {
+    auto it = _entries.find(path);
+    return it == _entries.end() ? 0 : it->second.hits;
+}
+
+} // namespace cloud_storage
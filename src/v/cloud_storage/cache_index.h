@@ -0,0 +1,95 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/redpanda-data/redpanda/blob/master/licenses/rcl.md
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/sstring.hh>
+
+#include <absl/container/btree_map.h>
+#include <absl/container/flat_hash_map.h>
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cloud_storage {
+
+/// In-memory index of the files stored in the cache directory
+///
+/// The index tracks the size and the access frequency of every cached
+/// file, so the eviction can pick its victims without walking the cache
+/// directory. The eviction order is LFU with dynamic aging (LFU-DA): on
+/// every access the priority of the file is set to 'age + hits', where
+/// 'age' is the priority of the last evicted file. Frequently read files
+/// survive a scan of one-off reads, and files that were popular a long
+/// time ago age out once newer files reach their priority. Files with
+/// equal priority are evicted in LRU order.
+class cache_index {
+public:
+    struct candidate {
+        ss::sstring path;
+        uint64_t size;
+    };
+
+    /// Add the file to the index or update its size, counts as an access.
+    /// Returns the previous size of the file or 0 if the file is new.
+    uint64_t put(std::string_view path, uint64_t size);
+
+    /// Register access to the file, ignored if the file is not indexed
+    void touch(std::string_view path);
+
+    /// Remove the file from the index without aging.
+    /// Returns the size of the file if it was indexed.
+    std::optional<uint64_t> remove(std::string_view path);
+
+    /// Remove the evicted file from the index and advance the age.
+    /// Returns the size of the file if it was indexed.
+    std::optional<uint64_t> evict(std::string_view path);
+
+    /// Return files with the lowest priority with total size of at least
+    /// 'bytes' (or all files if the index is smaller), lowest priority
+    /// first. Files for which 'skip' returns true are not returned. The
+    /// files stay in the index until they're evicted.
+    std::vector<candidate> eviction_candidates(
+      uint64_t bytes, const std::function<bool(std::string_view)>& skip) const;
+
+    void clear();
+
+    size_t size() const { return _entries.size(); }
+
+    /// Total size of all indexed files
+    uint64_t size_bytes() const { return _size_bytes; }
+
+    uint32_t hits(std::string_view path) const;
+
+private:
+    /// Eviction order: priority first, access sequence number second
+    using order_key = std::pair<uint64_t, uint64_t>;
+
+    struct entry {
+        uint64_t size;
+        uint32_t hits;
+        order_key key;
+    };
+
+    void update_order(const std::string& path, entry& e);
+
+    absl::flat_hash_map<std::string, entry> _entries;
+    absl::btree_map<order_key, std::string> _order;
+    uint64_t _age{0};
+    uint64_t _seq{0};
+    uint64_t _size_bytes{0};
+};
+
+} // namespace cloud_storage
@@ -12,11 +12,13 @@
 #include "cloud_storage/logger.h"
 #include "ssx/future-util.h"
 #include "storage/segment.h"
+#include "utils/file_io.h"
 #include "utils/gate_guard.h"
 #include "vassert.h"
 #include "vlog.h"
 
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/file.hh>
 #include <seastar/core/fstream.hh>
 #include <seastar/core/io_priority_class.hh>
 #include <seastar/core/seastar.hh>
@@ -24,6 +26,7 @@
 #include <seastar/core/sstring.hh>
 #include <seastar/util/defer.hh>
 
+#include <boost/lexical_cast.hpp>
 #include <cloud_storage/cache_service.h>
 
 #include <algorithm>
@@ -37,6 +40,9 @@ using namespace std::chrono_literals;
 namespace cloud_storage {
 
 static constexpr auto access_timer_period = 60s;
+// Period of the background sync of the files written in the relaxed
+// durability mode
+static constexpr auto sync_timer_period = 10s;
 
 std::ostream& operator<<(std::ostream& o, cache_element_status s) {
     switch (s) {
@@ -55,11 +61,97 @@ std::ostream& operator<<(std::ostream& o, cache_element_status s) {
 
 static constexpr std::string_view tmp_extension{".part"};
 
+namespace {
+
+/// File that ignores flush requests. The data reaches the disk when the
+/// kernel writes back the page cache or when the file is synced through
+/// another handle.
+class unsynced_file final : public ss::file_impl {
+public:
+    explicit unsynced_file(ss::file f)
+      : _file(std::move(f)) {}
+
+    ss::future<size_t> write_dma(
+      uint64_t pos,
+      const void* buffer,
+      size_t len,
+      const ss::io_priority_class& pc) final {
+        return get_file_impl(_file)->write_dma(pos, buffer, len, pc);
+    }
+
+    ss::future<size_t> write_dma(
+      uint64_t pos,
+      std::vector<iovec> iov,
+      const ss::io_priority_class& pc) final {
+        return get_file_impl(_file)->write_dma(pos, std::move(iov), pc);
+    }
+
+    ss::future<size_t> read_dma(
+      uint64_t pos,
+      void* buffer,
+      size_t len,
+      const ss::io_priority_class& pc) final {
+        return get_file_impl(_file)->read_dma(pos, buffer, len, pc);
+    }
+
+    ss::future<size_t> read_dma(
+      uint64_t pos,
+      std::vector<iovec> iov,
+      const ss::io_priority_class& pc) final {
+        return get_file_impl(_file)->read_dma(pos, std::move(iov), pc);
+    }
+
+    ss::future<> flush() final { return ss::now(); }
+
+    ss::future<struct stat> stat() final {
+        return get_file_impl(_file)->stat();
+    }
+
+    ss::future<> truncate(uint64_t length) final {
+        return get_file_impl(_file)->truncate(length);
+    }
+
+    ss::future<> discard(uint64_t offset, uint64_t length) final {
+        return get_file_impl(_file)->discard(offset, length);
+    }
+
+    ss::future<> allocate(uint64_t position, uint64_t length) final {
+        return get_file_impl(_file)->allocate(position, length);
+    }
+
+    ss::future<uint64_t> size() final { return get_file_impl(_file)->size(); }
+
+    ss::future<> close() final { return get_file_impl(_file)->close(); }
+
+    std::unique_ptr<ss::file_handle_impl> dup() final {
+        return get_file_impl(_file)->dup();
+    }
+
+    ss::subscription<ss::directory_entry> list_directory(
+      std::function<ss::future<>(ss::directory_entry de)> next) final {
+        return get_file_impl(_file)->list_directory(std::move(next));
+    }
+
+    ss::future<ss::temporary_buffer<uint8_t>> dma_read_bulk(
+      uint64_t offset,
+      size_t range_size,
+      const ss::io_priority_class& pc) final {
+        return get_file_impl(_file)->dma_read_bulk(offset, range_size, pc);
+    }
+
+private:
+    ss::file _file;
+};
+
+} // namespace
+
 cache::cache(std::filesystem::path cache_dir, size_t max_cache_size) noexcept
   : _cache_dir(std::move(cache_dir))
   , _max_cache_size(max_cache_size)
   , _cnt(0)
-  , _total_cleaned(0) {}
+  , _total_cleaned(0)
+  , _relaxed_durability(
+      config::shard_local_cfg().cloud_storage_cache_relaxed_durability()) {}
 
 ss::future<>
 cache::recursive_delete_empty_directory(const std::string_view& key) {
@@ -102,9 +194,29 @@ cache::recursive_delete_empty_directory(const std::string_view& key) {
 
 uint64_t cache::get_total_cleaned() { return _total_cleaned; }
 
-ss::future<> cache::consume_cache_space(size_t sz) {
+bool cache::is_access_time_tracker(std::string_view path) const {
+    return path
+           == (_cache_dir / access_time_tracker_file_name)
+                .lexically_normal()
+                .native();
+}
+
+bool cache::is_sync_checkpoint(std::string_view path) const {
+    return path
+           == (_cache_dir / sync_checkpoint_file_name)
+                .lexically_normal()
+                .native();
+}
+
+ss::future<> cache::consume_cache_space(ss::sstring path, size_t sz) {
     vassert(ss::this_shard_id() == 0, "This method can only run on shard 0");
+    // The file could be overwritten, in this case only the difference
+    // between the new and the old size is consumed.
+    auto prev_size = _index.put(path, sz);
+    _current_cache_size -= std::min<uint64_t>(prev_size, _current_cache_size);
     _current_cache_size += sz;
+    probe.set_size(_current_cache_size);
+    probe.set_num_files(_index.size());
     if (_current_cache_size > _max_cache_size) {
         auto units = ss::try_get_units(_cleanup_sm, 1);
         if (units) {
@@ -114,32 +226,81 @@ ss::future<> cache::consume_cache_space(size_t sz) {
     }
 }
 
-ss::future<> cache::clean_up_at_start() {
-    gate_guard guard{_gate};
-    auto [cache_size, candidates_for_deletion] = co_await _walker.walk(
+void cache::release_cache_space(const ss::sstring& path) {
+    vassert(ss::this_shard_id() == 0, "This method can only run on shard 0");
+    _access_time_tracker.remove_timestamp(path);
+    if (auto size = _index.remove(path); size.has_value()) {
+        _current_cache_size -= std::min(*size, _current_cache_size);
+        probe.set_size(_current_cache_size);
+        probe.set_num_files(_index.size());
+    }
+}
+
+ss::future<std::vector<file_list_item>> cache::rebuild_index() {
+    vassert(ss::this_shard_id() == 0, "Method can only be invoked on shard 0");
+    auto [cache_size, files] = co_await _walker.walk(
       _cache_dir.native(), _access_time_tracker);
+    _current_cache_size = cache_size;
     probe.set_size(cache_size);
-    probe.set_num_files(candidates_for_deletion.size());
+    probe.set_num_files(files.size());
 
     // The state of the _access_time_tracker and the actual content of the
     // cache directory might diverge over time (if the user removes segment
     // files manually). We need to take this into account.
     access_time_tracker tmp;
-    for (const auto& it : candidates_for_deletion) {
+    for (const auto& it : files) {
         tmp.add_timestamp(
           it.path, std::chrono::system_clock::time_point::min());
     }
     _access_time_tracker.remove_others(tmp);
-    _current_cache_size = cache_size;
 
+    // Files are sorted by access time, so the index starts in LRU order.
+    // The access counts are not persisted and start from scratch.
+    _index.clear();
+    for (const auto& it : files) {
+        if (!std::string_view(it.path).ends_with(tmp_extension)) {
+            _index.put(
+              std::filesystem::path(it.path).lexically_normal().native(),
+              it.size);
+        }
+    }
+    co_return std::move(files);
+}
+
+ss::future<> cache::clean_up_at_start() {
+    gate_guard guard{_gate};
+    auto sync_checkpoint = co_await load_sync_checkpoint();
+    auto candidates_for_deletion = co_await rebuild_index();
+
+    uint64_t deleted_size = 0;
     for (auto& file_item : candidates_for_deletion) {
         auto filepath_to_remove = file_item.path;
 
-        // delete only tmp files that are left from previous RedPanda run
-        if (std::string_view(filepath_to_remove).ends_with(tmp_extension)) {
+        // delete tmp files that are left from previous RedPanda run, and
+        // the files written in the relaxed durability mode after the last
+        // sync checkpoint, they might be incomplete if the node crashed. The
+        // access time tracker is validated when it's loaded.
+        bool is_tmp = std::string_view(filepath_to_remove)
+                        .ends_with(tmp_extension);
+        bool is_unsynced = sync_checkpoint.has_value()
+                           && file_item.modification_time >= *sync_checkpoint
+                           && !is_sync_checkpoint(filepath_to_remove)
+                           && !is_access_time_tracker(filepath_to_remove);
+        if (is_tmp || is_unsynced) {
             try {
                 co_await recursive_delete_empty_directory(filepath_to_remove);
-                _total_cleaned += file_item.size;
+                deleted_size += file_item.size;
+                if (is_unsynced) {
+                    vlog(
+                      cst_log.info,
+                      "Deleted {} written after the last sync checkpoint",
+                      filepath_to_remove);
+                    _index.remove(
+                      std::filesystem::path(filepath_to_remove)
+                        .lexically_normal()
+                        .native());
+                    _access_time_tracker.remove_timestamp(filepath_to_remove);
+                }
             } catch (std::exception& e) {
                 vlog(
                   cst_log.error,
@@ -149,70 +310,96 @@ ss::future<> cache::clean_up_at_start() {
             }
         }
     }
+    _total_cleaned += deleted_size;
+    _current_cache_size -= std::min(deleted_size, _current_cache_size);
+    probe.set_size(_current_cache_size);
     vlog(
       cst_log.debug,
       "Clean up at start deleted files of total size {}.",
       _total_cleaned);
 }
 
+ss::future<uint64_t> cache::evict_indexed(uint64_t size_to_delete) {
+    auto candidates = _index.eviction_candidates(
+      size_to_delete,
+      [this](std::string_view path) {
+          return is_access_time_tracker(path) || is_sync_checkpoint(path);
+      });
+
+    uint64_t deleted_size = 0;
+    for (const auto& candidate : candidates) {
+        try {
+            co_await recursive_delete_empty_directory(candidate.path);
+        } catch (std::filesystem::filesystem_error& e) {
+            // The file could be removed by the user, in this case only the
+            // index entry has to be evicted.
+            if (e.code() != std::errc::no_such_file_or_directory) {
+                vlog(
+                  cst_log.error,
+                  "Cache eviction couldn't delete {}: {}.",
+                  candidate.path,
+                  e.what());
+                continue;
+            }
+        } catch (std::exception& e) {
+            vlog(
+              cst_log.error,
+              "Cache eviction couldn't delete {}: {}.",
+              candidate.path,
+              e.what());
+            continue;
+        }
+        deleted_size += _index.evict(candidate.path).value_or(0);
+        // Remove key if possible to make sure there is no resource leak
+        _access_time_tracker.remove_timestamp(candidate.path);
+    }
+    vlog(
+      cst_log.debug,
+      "Cache eviction deleted {} files of total size {}.",
+      candidates.size(),
+      deleted_size);
+    co_return deleted_size;
+}
+
 ss::future<> cache::clean_up_cache() {
     vassert(ss::this_shard_id() == 0, "Method can only be invoked on shard 0");
     gate_guard guard{_gate};
-    auto [current_cache_size, candidates_for_deletion] = co_await _walker.walk(
-      _cache_dir.native(), _access_time_tracker);
-    _current_cache_size = current_cache_size;
-    probe.set_size(_current_cache_size);
-    probe.set_num_files(candidates_for_deletion.size());
 
-    // Updating the access time tracker in case if some files were removed
-    // from cache directory by the user manually.
-    access_time_tracker tmp;
-    for (const auto& it : candidates_for_deletion) {
-        tmp.add_timestamp(
-          it.path, std::chrono::system_clock::time_point::min());
-    }
-    _access_time_tracker.remove_others(tmp);
+    auto size_to_delete = [this]() -> uint64_t {
+        auto low_watermark = static_cast<uint64_t>(
+          _max_cache_size * (long double)_cache_size_low_watermark);
+        return _current_cache_size >= _max_cache_size
+                 ? _current_cache_size - low_watermark
+                 : 0;
+    };
 
     uint64_t deleted_size = 0;
-    if (_current_cache_size >= _max_cache_size) {
-        auto size_to_delete
-          = _current_cache_size
-            - (_max_cache_size * (long double)_cache_size_low_watermark);
-
-        size_t i_to_delete = 0;
-        while (i_to_delete < candidates_for_deletion.size()
-               && deleted_size < size_to_delete) {
-            auto filename_to_remove = candidates_for_deletion[i_to_delete].path;
-
-            // skip tmp files since someone may be writing to it
-            if (!std::string_view(filename_to_remove)
-                   .ends_with(tmp_extension)) {
-                try {
-                    co_await recursive_delete_empty_directory(
-                      filename_to_remove);
-                    deleted_size += candidates_for_deletion[i_to_delete].size;
-                    // Remove key if possible to make sure there is no resource
-                    // leak
-                    _access_time_tracker.remove_timestamp(
-                      std::string_view(filename_to_remove));
-                } catch (std::exception& e) {
-                    vlog(
-                      cst_log.error,
-                      "Cache eviction couldn't delete {}: {}.",
-                      filename_to_remove,
-                      e.what());
-                }
+    if (auto to_delete = size_to_delete(); to_delete > 0) {
+        deleted_size = co_await evict_indexed(to_delete);
+        _current_cache_size -= std::min(deleted_size, _current_cache_size);
+        if (deleted_size < to_delete) {
+            // The index doesn't have enough files to free the space, which
+            // means that the content of the cache directory has diverged
+            // from it (e.g. the user has added or removed files manually).
+            // Rebuild the index from the directory and try again.
+            vlog(
+              cst_log.info,
+              "Cache index freed only {} of {} bytes, rebuilding the index "
+              "from the cache directory",
+              deleted_size,
+              to_delete);
+            co_await rebuild_index();
+            if (auto rest = size_to_delete(); rest > 0) {
+                auto deleted_after_rebuild = co_await evict_indexed(rest);
+                _current_cache_size -= std::min(
+                  deleted_after_rebuild, _current_cache_size);
+                deleted_size += deleted_after_rebuild;
             }
-            i_to_delete++;
         }
-        _total_cleaned += deleted_size;
-        _current_cache_size -= deleted_size;
-        vlog(
-          cst_log.debug,
-          "Cache eviction deleted {} files of total size {}.",
-          i_to_delete,
-          deleted_size);
     }
+    _total_cleaned += deleted_size;
+    probe.set_size(_current_cache_size);
+    probe.set_num_files(_index.size());
 }
 
 ss::future<> cache::load_access_time_tracker() {
@@ -283,6 +470,8 @@ ss::future<> cache::start() {
       "Starting archival cache service, data directory: {}",
       _cache_dir);
 
+    // files written before the start are synced or removed by the cleanup
+    auto start_time = std::chrono::system_clock::now();
     if (ss::this_shard_id() == 0) {
         // access time tracker has to be initialized before
         // cleanup
@@ -294,12 +483,131 @@ ss::future<> cache::start() {
               _gate, [this] { return maybe_save_access_time_tracker(); });
         });
         _tracker_timer.arm_periodic(access_timer_period);
+
+        if (_relaxed_durability) {
+            _sync_points.assign(ss::smp::count, start_time);
+            co_await save_sync_checkpoint(start_time);
+        } else {
+            // the files of the previous run are either synced or removed,
+            // every file written from now on is synced
+            try {
+                co_await ss::remove_file(
+                  (_cache_dir / sync_checkpoint_file_name).native());
+            } catch (std::filesystem::filesystem_error& e) {
+                if (e.code() != std::errc::no_such_file_or_directory) {
+                    throw;
+                }
+            }
+        }
+    }
+
+    if (_relaxed_durability) {
+        _sync_timer.set_callback([this] {
+            ssx::spawn_with_gate(
+              _gate, [this] { return sync_written_files(); });
+        });
+        _sync_timer.arm_periodic(sync_timer_period);
     }
 }
 
+ss::future<> cache::sync_written_files() {
+    auto units = ss::try_get_units(_sync_sm, 1);
+    if (!units) {
+        co_return;
+    }
+    // all files of the shard that were written before the sync point are
+    // in the list, the puts in progress may have written data before it
+    auto sync_point = std::chrono::system_clock::now();
+    if (!_unsynced_puts.empty()) {
+        sync_point = std::min(sync_point, *_unsynced_puts.begin());
+    }
+    auto files = std::exchange(_unsynced_files, {});
+    size_t synced = 0;
+    try {
+        for (; synced < files.size(); ++synced) {
+            ss::file f;
+            try {
+                f = co_await ss::open_file_dma(
+                  files[synced], ss::open_flags::ro);
+            } catch (std::filesystem::filesystem_error& e) {
+                // the file was evicted or invalidated
+                if (e.code() == std::errc::no_such_file_or_directory) {
+                    continue;
+                }
+                throw;
+            }
+            co_await f.flush().finally([&f] { return f.close(); });
+        }
+        co_await container().invoke_on(
+          0, [shard = ss::this_shard_id(), sync_point](cache& c) {
+              return c.advance_sync_checkpoint(shard, sync_point);
+          });
+    } catch (...) {
+        vlog(
+          cst_log.warn,
+          "Failed to sync cache files: {}",
+          std::current_exception());
+        // retry on the next tick
+        _unsynced_files.insert(
+          _unsynced_files.end(),
+          std::make_move_iterator(files.begin() + synced),
+          std::make_move_iterator(files.end()));
+    }
+}
+
+ss::future<> cache::advance_sync_checkpoint(
+  ss::shard_id shard, std::chrono::system_clock::time_point tp) {
+    vassert(ss::this_shard_id() == 0, "Method can only be invoked on shard 0");
+    gate_guard guard{_gate};
+    auto units = co_await ss::get_units(_checkpoint_sm, 1);
+    _sync_points[shard] = std::max(_sync_points[shard], tp);
+    auto checkpoint = *std::min_element(
+      _sync_points.begin(), _sync_points.end());
+    if (checkpoint > _sync_checkpoint) {
+        co_await save_sync_checkpoint(checkpoint);
+    }
+}
+
+ss::future<std::optional<std::chrono::system_clock::time_point>>
+cache::load_sync_checkpoint() {
+    auto path = _cache_dir / sync_checkpoint_file_name;
+    if (!co_await ss::file_exists(path.native())) {
+        co_return std::nullopt;
+    }
+    auto str = co_await read_fully_to_string(path);
+    try {
+        auto millis = std::chrono::milliseconds(
+          boost::lexical_cast<int64_t>(str));
+        co_return std::chrono::system_clock::time_point(millis);
+    } catch (const boost::bad_lexical_cast&) {
+        // the checkpoint is written atomically, this is not expected, but
+        // the files that could be incomplete are not known in this case
+        vlog(cst_log.error, "Invalid cache sync checkpoint '{}'", str);
+        co_return std::chrono::system_clock::time_point::min();
+    }
+}
+
+ss::future<>
+cache::save_sync_checkpoint(std::chrono::system_clock::time_point tp) {
+    auto path = _cache_dir / sync_checkpoint_file_name;
+    auto tmp_path = path;
+    tmp_path += tmp_extension;
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    tp.time_since_epoch())
+                    .count();
+    iobuf buf;
+    buf.append(ssx::sformat("{}", millis));
+    co_await ss::recursive_touch_directory(_cache_dir.native());
+    co_await write_fully(tmp_path, std::move(buf));
+    co_await ss::rename_file(tmp_path.native(), path.native());
+    co_await ss::sync_directory(_cache_dir.native());
+    _sync_checkpoint = tp;
+}
+
 ss::future<> cache::stop() {
     vlog(cst_log.debug, "Stopping archival cache service");
     _tracker_timer.cancel();
+    _sync_timer.cancel();
     if (ss::this_shard_id() == 0) {
         co_await save_access_time_tracker();
     }
@@ -316,16 +624,22 @@ ss::future<std::optional<cache_item>> cache::get(std::filesystem::path key) {
         auto source = (_cache_dir / key).native();
         cache_file = co_await ss::open_file_dma(source, ss::open_flags::ro);
 
-        // Bump access time of the file
+        // Bump access time and access count of the file
+        auto normal_source = std::filesystem::path(source)
+                               .lexically_normal()
+                               .native();
         if (ss::this_shard_id() == 0) {
             _access_time_tracker.add_timestamp(
               source, std::chrono::system_clock::now());
+            _index.touch(normal_source);
         } else {
-            ssx::spawn_with_gate(_gate, [this, source] {
-                return container().invoke_on(0, [source](cache& c) {
-                    c._access_time_tracker.add_timestamp(
-                      source, std::chrono::system_clock::now());
-                });
+            ssx::spawn_with_gate(_gate, [this, source, normal_source] {
+                return container().invoke_on(
+                  0, [source, normal_source](cache& c) {
+                      c._access_time_tracker.add_timestamp(
+                        source, std::chrono::system_clock::now());
+                      c._index.touch(normal_source);
+                  });
             });
         }
     } catch (std::filesystem::filesystem_error& e) {
@@ -382,6 +696,18 @@ ss::future<> cache::put(
     }
     auto dir_path = normal_key_path.remove_filename();
 
+    // The start time of the put bounds the modification time of the file,
+    // the sync checkpoint can't advance past it until the file is synced
+    std::optional<decltype(_unsynced_puts)::iterator> unsynced_put;
+    if (_relaxed_durability) {
+        unsynced_put = _unsynced_puts.insert(std::chrono::system_clock::now());
+    }
+    auto deferred_unsynced = ss::defer([this, &unsynced_put] {
+        if (unsynced_put) {
+            _unsynced_puts.erase(*unsynced_put);
+        }
+    });
+
     // tmp file is used to protect against concurrent writes to the same
     // file. One tmp file is written only once by one thread. tmp file
     // should not be read directly. _cnt is an atomic counter that
@@ -419,6 +745,12 @@ ss::future<> cache::put(
         }
     }
 
+    if (_relaxed_durability) {
+        // the file is synced in the background by sync_written_files
+        tmp_cache_file = ss::file(
+          ss::make_shared<unsynced_file>(std::move(tmp_cache_file)));
+    }
+
     ss::file_output_stream_options options{};
     options.buffer_size = write_buffer_size;
     options.write_behind = write_behind;
@@ -434,20 +766,23 @@ ss::future<> cache::put(
     co_await ss::rename_file((dir_path / tmp_filename).native(), dest);
 
     auto put_size = co_await ss::file_size(dest);
+    if (_relaxed_durability) {
+        _unsynced_files.push_back(dest);
+    }
 
     // Bump access time of the file
     if (ss::this_shard_id() == 0) {
         _access_time_tracker.add_timestamp(
           dest, std::chrono::system_clock::now());
         ssx::spawn_with_gate(_gate, [this, dest, put_size] {
-            return consume_cache_space(put_size);
+            return consume_cache_space(dest, put_size);
         });
     } else {
         ssx::spawn_with_gate(_gate, [this, dest, put_size] {
             return container().invoke_on(0, [dest, put_size](cache& c) {
                 c._access_time_tracker.add_timestamp(
                   dest, std::chrono::system_clock::now());
-                return c.consume_cache_space(put_size);
+                return c.consume_cache_space(dest, put_size);
             });
         });
     }
@@ -475,9 +810,9 @@ ss::future<> cache::invalidate(const std::filesystem::path& key) {
       cst_log.debug,
       "Trying to invalidate {} from archival cache.",
       key.native());
+    auto path = (_cache_dir / key).lexically_normal().native();
     try {
-        _access_time_tracker.remove_timestamp(key.native());
-        co_await recursive_delete_empty_directory((_cache_dir / key).native());
+        co_await recursive_delete_empty_directory(path);
     } catch (std::filesystem::filesystem_error& e) {
         if (e.code() == std::errc::no_such_file_or_directory) {
             vlog(
@@ -485,11 +820,12 @@ ss::future<> cache::invalidate(const std::filesystem::path& key) {
               "Could not invalidate {} from archival cache: {}",
               key.native(),
               e.what());
-            co_return;
         } else {
             throw;
         }
     }
+    co_await container().invoke_on(
+      0, [path](cache& c) { c.release_cache_space(path); });
 };
 
 } // namespace cloud_storage
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "cloud_storage/access_time_tracker.h"
+#include "cloud_storage/cache_index.h"
 #include "cloud_storage/cache_probe.h"
 #include "cloud_storage/recursive_directory_walker.h"
 #include "resource_mgmt/io_priority.h"
@@ -23,7 +24,9 @@
 #include <seastar/core/io_priority_class.hh>
 #include <seastar/core/iostream.hh>
 
+#include <chrono>
 #include <filesystem>
+#include <optional>
 #include <set>
 #include <string_view>
 
@@ -32,6 +35,7 @@ namespace cloud_storage {
 static constexpr size_t default_write_buffer_size = 128_KiB;
 static constexpr unsigned default_writebehind = 10;
 static constexpr const char* access_time_tracker_file_name = "accesstime";
+static constexpr const char* sync_checkpoint_file_name = "sync_checkpoint";
 
 struct cache_item {
     ss::file body;
@@ -97,10 +101,20 @@ private:
     /// Save access time tracker state to the file if needed
     ss::future<> maybe_save_access_time_tracker();
 
-    /// Triggers directory walker, creates a list of files to delete and deletes
-    /// them until cache size <= _cache_size_low_watermark * max_cache_size
+    /// Deletes files in the eviction order of the cache index until cache
+    /// size <= _cache_size_low_watermark * max_cache_size. Falls back to the
+    /// directory walk if the index can't free enough space.
     ss::future<> clean_up_cache();
 
+    /// Deletes up to 'size_to_delete' bytes of files picked by the cache
+    /// index, returns number of deleted bytes.
+    ss::future<uint64_t> evict_indexed(uint64_t size_to_delete);
+
+    /// Triggers directory walker and rebuilds the cache index and the
+    /// current cache size from the content of the cache directory.
+    /// Returns the list of files found in the directory.
+    ss::future<std::vector<file_list_item>> rebuild_index();
+
     /// Triggers directory walker, creates a list of files to delete and deletes
     /// only tmp files that are left from previous Red Panda run
     ss::future<> clean_up_at_start();
@@ -112,8 +126,31 @@ private:
     ss::future<> recursive_delete_empty_directory(const std::string_view& key);
 
     /// This method is called on shard 0 by other shards to report disk
-    /// space changes.
-    ss::future<> consume_cache_space(size_t);
+    /// space changes. 'path' is a full path of the file that was put.
+    ss::future<> consume_cache_space(ss::sstring path, size_t);
+
+    /// This method is called on shard 0 by other shards when the file
+    /// is invalidated.
+    void release_cache_space(const ss::sstring& path);
+
+    bool is_access_time_tracker(std::string_view path) const;
+    bool is_sync_checkpoint(std::string_view path) const;
+
+    /// Sync the files written by this shard in the relaxed durability mode
+    /// and report the new sync point to shard 0.
+    ss::future<> sync_written_files();
+
+    /// Called on shard 0 by other shards when all the files they wrote
+    /// before 'tp' are synced. Persists the sync checkpoint, the time before
+    /// which all files of the cache are synced on all shards.
+    ss::future<> advance_sync_checkpoint(
+      ss::shard_id shard, std::chrono::system_clock::time_point tp);
+
+    /// Read the sync checkpoint left by the previous run, if any
+    ss::future<std::optional<std::chrono::system_clock::time_point>>
+    load_sync_checkpoint();
+
+    ss::future<> save_sync_checkpoint(std::chrono::system_clock::time_point);
 
     std::filesystem::path _cache_dir;
     size_t _max_cache_size;
@@ -129,7 +166,22 @@ private:
     std::set<std::filesystem::path> _files_in_progress;
     cache_probe probe;
     access_time_tracker _access_time_tracker;
+    /// Index of the cached files (only used on shard 0)
+    cache_index _index;
     ss::timer<ss::lowres_clock> _tracker_timer;
+
+    /// Files are not synced to disk before they become readable
+    bool _relaxed_durability;
+    /// Files written by this shard that are not synced yet
+    std::vector<ss::sstring> _unsynced_files;
+    /// Start times of the relaxed puts of this shard that are in progress
+    std::multiset<std::chrono::system_clock::time_point> _unsynced_puts;
+    ss::timer<ss::lowres_clock> _sync_timer;
+    ssx::semaphore _sync_sm{1, "cloud/cache-sync"};
+    /// Sync points of all shards (only used on shard 0)
+    std::vector<std::chrono::system_clock::time_point> _sync_points;
+    std::chrono::system_clock::time_point _sync_checkpoint;
+    ssx::semaphore _checkpoint_sm{1, "cloud/cache-checkpoint"};
 };
 
 } // namespace cloud_storage
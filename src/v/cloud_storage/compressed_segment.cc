@@ -0,0 +1,152 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/redpanda-data/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "cloud_storage/compressed_segment.h"
+
+#include "serde/serde.h"
+#include "vassert.h"
+
+#include <seastar/core/coroutine.hh>
+
+#include <fmt/format.h>
+
+namespace cloud_storage {
+
+segment_frame_index::frame_range
+segment_frame_index::find(uint64_t first, uint64_t last) const {
+    vassert(
+      first <= last && last < size_bytes && frame_size > 0,
+      "Invalid range [{}, {}] of the compressed segment of size {}",
+      first,
+      last,
+      size_bytes);
+    size_t first_frame = first / frame_size;
+    size_t last_frame = last / frame_size;
+    return frame_range{
+      .first_frame = first_frame,
+      .last_frame = last_frame,
+      .bytes = {offsets.at(first_frame), offsets.at(last_frame + 1) - 1},
+      .skip = first - first_frame * frame_size,
+    };
+}
+
+std::vector<uint64_t>
+segment_frame_index::frame_sizes(size_t first, size_t last) const {
+    std::vector<uint64_t> res;
+    res.reserve(last - first + 1);
+    for (size_t i = first; i <= last; i++) {
+        res.push_back(offsets.at(i + 1) - offsets.at(i));
+    }
+    return res;
+}
+
+iobuf segment_frame_index::to_iobuf() const {
+    return serde::to_iobuf(segment_frame_index(*this));
+}
+
+segment_frame_index segment_frame_index::from_iobuf(iobuf in) {
+    return serde::from_iobuf<segment_frame_index>(std::move(in));
+}
+
+remote_segment_path
+generate_remote_frame_index_path(const remote_segment_path& p) {
+    return remote_segment_path(fmt::format("{}.zidx", p().native()));
+}
+
+segment_compressor::segment_compressor(
+  ss::input_stream<char>& src, uint64_t frame_size)
+  : _src(src) {
+    _index.frame_size = frame_size;
+    _index.offsets.push_back(0);
+}
+
+ss::future<iobuf> segment_compressor::next_frame() {
+    auto frame = co_await read_iobuf_exactly(_src, _index.frame_size);
+    if (frame.empty()) {
+        co_return iobuf{};
+    }
+    _index.size_bytes += frame.size_bytes();
+    auto compressed = _zstd.compress(std::move(frame));
+    _index.offsets.push_back(_index.offsets.back() + compressed.size_bytes());
+    co_return compressed;
+}
+
+namespace {
+
+class frame_decompression_source final : public ss::data_source_impl {
+public:
+    frame_decompression_source(
+      ss::input_stream<char> src,
+      std::vector<uint64_t> frame_sizes,
+      uint64_t skip,
+      uint64_t length)
+      : _src(std::move(src))
+      , _frame_sizes(std::move(frame_sizes))
+      , _skip(skip)
+      , _remaining(length) {}
+
+    ss::future<ss::temporary_buffer<char>> get() override {
+        while (true) {
+            while (!_pending.empty()) {
+                // an empty buffer would be an end of stream
+                auto buf = _pending.begin()->share();
+                _pending.pop_front();
+                if (!buf.empty()) {
+                    co_return buf;
+                }
+            }
+            if (_remaining == 0 || _next_frame == _frame_sizes.size()) {
+                co_return ss::temporary_buffer<char>{};
+            }
+            auto expected = _frame_sizes[_next_frame++];
+            auto frame = co_await read_iobuf_exactly(_src, expected);
+            if (frame.size_bytes() != expected) {
+                throw std::runtime_error(fmt::format(
+                  "Compressed frame is truncated, expected {} bytes, got {}",
+                  expected,
+                  frame.size_bytes()));
+            }
+            auto data = _zstd.uncompress(std::move(frame));
+            auto skip = std::min(_skip, data.size_bytes());
+            data.trim_front(skip);
+            _skip -= skip;
+            if (data.size_bytes() > _remaining) {
+                data.trim_back(data.size_bytes() - _remaining);
+            }
+            _remaining -= data.size_bytes();
+            _pending = std::move(data);
+        }
+    }
+
+    ss::future<> close() override { return _src.close(); }
+
+private:
+    ss::input_stream<char> _src;
+    std::vector<uint64_t> _frame_sizes;
+    size_t _next_frame{0};
+    uint64_t _skip;
+    uint64_t _remaining;
+    compression::stream_zstd _zstd;
+    iobuf _pending;
+};
+
+} // namespace
+
+ss::input_stream<char> make_frame_decompression_stream(
+  ss::input_stream<char> src,
+  std::vector<uint64_t> frame_sizes,
+  uint64_t skip,
+  uint64_t length) {
+    auto ds = std::make_unique<frame_decompression_source>(
+      std::move(src), std::move(frame_sizes), skip, length);
+    return ss::input_stream<char>(ss::data_source(std::move(ds)));
+}
+
+} // namespace cloud_storage
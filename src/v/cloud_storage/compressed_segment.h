@@ -0,0 +1,111 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/redpanda-data/redpanda/blob/master/licenses/rcl.md
+ */
+
+#pragma once
+
+#include "bytes/iobuf.h"
+#include "cloud_storage/types.h"
+#include "compression/stream_zstd.h"
+#include "s3/client.h"
+#include "seastarx.h"
+#include "serde/envelope.h"
+
+#include <seastar/core/iostream.hh>
+
+#include <vector>
+
+namespace cloud_storage {
+
+/// Frame index of a compressed segment
+///
+/// A compressed segment is stored as a sequence of independent zstd frames,
+/// every frame holds 'frame_size' bytes of the segment (the last one can be
+/// smaller). The index maps the frames to their positions in the object, so
+/// any byte range of the segment can be read by downloading and
+/// decompressing only the frames that overlap it. The index is stored next
+/// to the segment as a separate object.
+struct segment_frame_index
+  : serde::envelope<
+      segment_frame_index,
+      serde::version<0>,
+      serde::compat_version<0>> {
+    /// Uncompressed size of every frame except the last one
+    uint64_t frame_size{0};
+    /// Uncompressed size of the segment
+    uint64_t size_bytes{0};
+    /// Position of every frame in the object followed by the object size
+    std::vector<uint64_t> offsets;
+
+    /// Frames that overlap a byte range of the segment
+    struct frame_range {
+        size_t first_frame;
+        /// Inclusive
+        size_t last_frame;
+        /// Range of the frames in the object
+        s3::byte_range bytes;
+        /// Number of decompressed bytes before the start of the range
+        uint64_t skip;
+    };
+
+    size_t num_frames() const {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+
+    uint64_t compressed_size() const {
+        return offsets.empty() ? 0 : offsets.back();
+    }
+
+    /// Find frames that overlap the segment bytes [first, last]
+    frame_range find(uint64_t first, uint64_t last) const;
+
+    /// Compressed sizes of the frames [first, last]
+    std::vector<uint64_t> frame_sizes(size_t first, size_t last) const;
+
+    iobuf to_iobuf() const;
+    static segment_frame_index from_iobuf(iobuf in);
+
+    auto operator<=>(const segment_frame_index&) const = default;
+};
+
+/// Path of the frame index of the compressed segment
+remote_segment_path
+generate_remote_frame_index_path(const remote_segment_path& p);
+
+/// Reads the segment from the stream and compresses it frame by frame
+class segment_compressor {
+public:
+    segment_compressor(ss::input_stream<char>& src, uint64_t frame_size);
+
+    /// Compress the next frame, returns an empty buffer at the end of the
+    /// stream.
+    ss::future<iobuf> next_frame();
+
+    /// Index of the frames produced so far
+    const segment_frame_index& index() const { return _index; }
+
+private:
+    ss::input_stream<char>& _src;
+    compression::stream_zstd _zstd;
+    segment_frame_index _index;
+};
+
+/// Make a stream that decompresses consecutive frames read from 'src'
+///
+/// \param src is a stream that starts at the first frame
+/// \param frame_sizes are compressed sizes of the frames
+/// \param skip is a number of decompressed bytes to skip
+/// \param length is a number of decompressed bytes to return after skip
+ss::input_stream<char> make_frame_decompression_stream(
+  ss::input_stream<char> src,
+  std::vector<uint64_t> frame_sizes,
+  uint64_t skip,
+  uint64_t length);
+
+} // namespace cloud_storage
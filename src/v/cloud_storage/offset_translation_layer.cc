@@ -18,6 +18,7 @@
 
 #include <seastar/util/log.hh>
 
+#include <algorithm>
 #include <exception>
 
 namespace cloud_storage {
@@ -98,4 +99,105 @@ segment_name offset_translator::get_adjusted_segment_name(
     return new_name;
 }
 
+static model::offset to_kafka_offset(model::offset o, model::offset delta) {
+    // Manifests created with the old version of redpanda don't have the
+    // delta_offset field
+    return delta == model::offset::min() ? o : o - delta;
+}
+
+offset_translation_table::offset_translation_table(const partition_manifest& m)
+  : _manifest_last_offset(m.get_last_offset())
+  , _manifest_start_offset(m.get_start_offset())
+  , _manifest_size(m.size())
+  , _manifest_removed_segments(m.removed_segments()) {
+    std::array<encoder_t, num_columns> encoders{encoder_t(0), encoder_t(0)};
+    std::array<row_t, num_columns> rows{};
+    size_t row_size = 0;
+    auto flush = [&] {
+        row_header h{
+          .first_kafka_base_offset = model::offset(rows[kafka_base_offset][0]),
+          .first_term = model::term_id(rows[term][0]),
+        };
+        for (size_t c = 0; c < num_columns; ++c) {
+            // the last row is padded with its last value
+            std::fill(
+              rows[c].begin() + row_size, rows[c].end(), rows[c][row_size - 1]);
+            h.pos[c] = static_cast<uint32_t>(encoders[c].size_bytes());
+            h.initial[c] = encoders[c].get_last_value();
+            encoders[c].add(rows[c]);
+        }
+        _rows.push_back(h);
+        row_size = 0;
+    };
+    for (const auto& [key, meta] : m) {
+        rows[kafka_base_offset][row_size]
+          = to_kafka_offset(meta.base_offset, meta.delta_offset)();
+        rows[term][row_size] = key.term();
+        _last_kafka_offset = to_kafka_offset(
+          meta.committed_offset, meta.delta_offset);
+        _last_term = key.term;
+        ++_size;
+        if (++row_size == row_width) {
+            flush();
+        }
+    }
+    if (row_size > 0) {
+        flush();
+    }
+    for (size_t c = 0; c < num_columns; ++c) {
+        _columns[c] = encoders[c].share();
+    }
+}
+
+bool offset_translation_table::is_stale(const partition_manifest& m) const {
+    return _manifest_size != m.size()
+           || _manifest_last_offset != m.get_last_offset()
+           || _manifest_start_offset != m.get_start_offset()
+           || _manifest_removed_segments != m.removed_segments();
+}
+
+offset_translation_table::row_t
+offset_translation_table::decode(size_t row, column c) {
+    const auto& h = _rows[row];
+    size_t end = row + 1 < _rows.size() ? _rows[row + 1].pos[c]
+                                        : _columns[c].size_bytes();
+    decoder_t decoder(
+      h.initial[c], 1, _columns[c].share(h.pos[c], end - h.pos[c]));
+    row_t values{};
+    decoder.read(values);
+    return values;
+}
+
+std::optional<model::offset>
+offset_translation_table::get_term_last_offset(model::term_id t) {
+    // the term ends right before the first segment of a later term, find
+    // the first row that starts with a later term, the segment is either
+    // the first one of this row or one of the previous row
+    auto it = std::upper_bound(
+      _rows.begin(),
+      _rows.end(),
+      t,
+      [](model::term_id lhs, const row_header& h) {
+          return lhs < h.first_term;
+      });
+    if (it != _rows.begin()) {
+        size_t row = std::distance(_rows.begin(), it) - 1;
+        size_t row_size = std::min(row_width, _size - row * row_width);
+        auto terms = decode(row, term);
+        for (size_t i = 1; i < row_size; ++i) {
+            if (model::term_id(terms[i]) > t) {
+                auto offsets = decode(row, kafka_base_offset);
+                return model::offset(offsets[i]) - model::offset(1);
+            }
+        }
+    }
+    if (it != _rows.end()) {
+        return it->first_kafka_base_offset - model::offset(1);
+    }
+    if (_size > 0 && _last_term == t) {
+        return _last_kafka_offset;
+    }
+    return std::nullopt;
+}
+
 } // namespace cloud_storage
@@ -13,12 +13,16 @@
 #include "cloud_storage/partition_manifest.h"
 #include "cloud_storage/types.h"
 #include "storage/types.h"
+#include "utils/delta_for.h"
 #include "utils/retry_chain_node.h"
 
 #include <seastar/core/iostream.hh>
 
 #include <absl/container/btree_map.h>
 
+#include <array>
+#include <vector>
+
 namespace cloud_storage {
 
 /// This instance of this class is supposed to be used to
@@ -59,4 +63,61 @@ private:
     storage::opt_abort_source_t _as;
 };
 
+/// Compact copy of the kafka offsets and terms of the segments of the
+/// manifest, shared by all the lookups of a remote_partition.
+///
+/// The kafka base offsets and the terms of the segments are stored in
+/// delta-FOR encoded columns. Every encoded row keeps its position in the
+/// column and the first values of the row, so a lookup is a binary search
+/// over the rows followed by decoding of a single row instead of a scan of
+/// the manifest.
+///
+/// The table is a snapshot, it has to be rebuilt when is_stale returns true.
+class offset_translation_table {
+public:
+    offset_translation_table() = default;
+    explicit offset_translation_table(const partition_manifest& m);
+
+    /// Return true if the manifest has changed since the table was built
+    bool is_stale(const partition_manifest& m) const;
+
+    size_t size() const { return _size; }
+
+    /// Return the last kafka offset of the term, or nullopt if the term
+    /// is not the last one and no segment of a later term is found
+    std::optional<model::offset> get_term_last_offset(model::term_id term);
+
+private:
+    static constexpr size_t row_width = details::FOR_buffer_depth;
+    using encoder_t = deltafor_encoder<int64_t>;
+    using decoder_t = deltafor_decoder<int64_t>;
+    using row_t = std::array<int64_t, row_width>;
+
+    enum column : size_t { kafka_base_offset = 0, term, num_columns };
+
+    struct row_header {
+        /// Values of the first segment of the row
+        model::offset first_kafka_base_offset;
+        model::term_id first_term;
+        /// Position of the row in every column
+        std::array<uint32_t, num_columns> pos;
+        /// Last value of the previous row, the decoder starts from it
+        std::array<int64_t, num_columns> initial;
+    };
+
+    row_t decode(size_t row, column c);
+
+    std::vector<row_header> _rows;
+    std::array<iobuf, num_columns> _columns;
+    size_t _size{0};
+    model::offset _last_kafka_offset;
+    model::term_id _last_term;
+
+    // state of the manifest the table was built from
+    model::offset _manifest_last_offset;
+    std::optional<model::offset> _manifest_start_offset;
+    size_t _manifest_size{0};
+    size_t _manifest_removed_segments{0};
+};
+
 } // namespace cloud_storage
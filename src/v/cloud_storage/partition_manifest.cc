@@ -13,19 +13,23 @@
 #include "bytes/iobuf_istreambuf.h"
 #include "bytes/iobuf_ostreambuf.h"
 #include "cloud_storage/types.h"
+#include "config/configuration.h"
 #include "hashing/xx.h"
 #include "json/istreamwrapper.h"
 #include "json/ostreamwrapper.h"
 #include "json/writer.h"
 #include "model/timestamp.h"
+#include "serde/envelope.h"
 #include "ssx/sformat.h"
 #include "storage/fs_utils.h"
+#include "utils/delta_for.h"
 
 #include <seastar/core/coroutine.hh>
 
 #include <fmt/ostream.h>
 #include <rapidjson/error/en.h>
 
+#include <cctype>
 #include <charconv>
 #include <memory>
 #include <optional>
@@ -145,6 +149,12 @@ segment_name generate_segment_name(model::offset o, model::term_id t) {
     return segment_name(ssx::sformat("{}-{}-v1.log", o(), t()));
 }
 
+segment_name generate_merged_segment_name(
+  model::offset base, model::offset committed, model::term_id t) {
+    return segment_name(
+      ssx::sformat("{}-{}-{}-v1.log", base(), committed(), t()));
+}
+
 partition_manifest::partition_manifest()
   : _ntp()
   , _rev()
@@ -204,7 +214,10 @@ model::initial_revision_id partition_manifest::get_revision_id() const {
 
 remote_segment_path partition_manifest::generate_segment_path(
   const partition_manifest::key& key, const segment_meta& meta) const {
-    auto name = generate_segment_name(key.base_offset, key.term);
+    auto name = meta.is_merged
+                  ? generate_merged_segment_name(
+                    key.base_offset, meta.committed_offset, key.term)
+                  : generate_segment_name(key.base_offset, key.term);
     return generate_remote_segment_path(
       _ntp, meta.ntp_revision, name, meta.archiver_term);
 }
@@ -273,9 +286,44 @@ partition_manifest::truncate(model::offset starting_rp_offset) {
     for (auto s : removed._segments) {
         _segments.erase(s.first);
     }
+    _removed_segments += removed.size();
+    return removed;
+}
+
+partition_manifest partition_manifest::replace(
+  const partition_manifest::key& key, const segment_meta& meta) {
+    partition_manifest removed(_ntp, _rev);
+    auto first = _segments.find(key);
+    if (first == _segments.end()) {
+        return removed;
+    }
+    auto last = first;
+    while (last != _segments.end()
+           && last->second.committed_offset < meta.committed_offset) {
+        ++last;
+    }
+    if (
+      last == _segments.end()
+      || last->second.committed_offset != meta.committed_offset
+      || first->second.base_offset != meta.base_offset) {
+        return removed;
+    }
+    ++last;
+    for (auto it = first; it != last; ++it) {
+        removed.add(it->first, it->second);
+    }
+    _segments.erase(first, last);
+    _segments.emplace(key, meta);
+    _removed_segments += removed.size();
     return removed;
 }
 
+bool partition_manifest::operator==(const partition_manifest& other) const {
+    return _ntp == other._ntp && _rev == other._rev
+           && _segments == other._segments
+           && _last_offset == other._last_offset;
+}
+
 const partition_manifest::segment_meta*
 partition_manifest::get(const partition_manifest::key& key) const {
     auto it = _segments.find(key);
@@ -528,7 +576,10 @@ struct partition_manifest_handler
               .delta_offset = _delta_offset.value_or(model::offset::min()),
               .ntp_revision = _ntp_revision.value_or(
                 _revision_id.value_or(model::initial_revision_id())),
-              .archiver_term = _archiver_term.value_or(model::term_id{})};
+              .archiver_term = _archiver_term.value_or(model::term_id{}),
+              .is_compressed = _is_compressed.value_or(false),
+              .has_index = _has_index.value_or(false),
+              .is_merged = _is_merged.value_or(false)};
             if (!_segments) {
                 _segments = std::make_unique<segment_map>();
             }
@@ -553,6 +604,18 @@ struct partition_manifest_handler
                 _is_compacted = b;
                 _state = state::expect_segment_meta_key;
                 return true;
+            } else if ("is_compressed" == _segment_meta_key) {
+                _is_compressed = b;
+                _state = state::expect_segment_meta_key;
+                return true;
+            } else if ("has_index" == _segment_meta_key) {
+                _has_index = b;
+                _state = state::expect_segment_meta_key;
+                return true;
+            } else if ("is_merged" == _segment_meta_key) {
+                _is_merged = b;
+                _state = state::expect_segment_meta_key;
+                return true;
             }
             return false;
         case state::expect_manifest_start:
@@ -630,6 +693,9 @@ struct partition_manifest_handler
     std::optional<model::offset> _delta_offset;
     std::optional<model::initial_revision_id> _ntp_revision;
     std::optional<model::term_id> _archiver_term;
+    std::optional<bool> _is_compressed;
+    std::optional<bool> _has_index;
+    std::optional<bool> _is_merged;
 
     void check_that_required_meta_fields_are_present() {
         if (!_is_compacted) {
@@ -671,6 +737,9 @@ struct partition_manifest_handler
         _delta_offset = std::nullopt;
         _ntp_revision = std::nullopt;
         _archiver_term = std::nullopt;
+        _is_compressed = std::nullopt;
+        _has_index = std::nullopt;
+        _is_merged = std::nullopt;
     }
 
     void check_manifest_fields_are_present() {
@@ -701,10 +770,27 @@ struct partition_manifest_handler
     }
 };
 
+/// Returns true if the serialized manifest is a json document, the binary
+/// format starts with the serde envelope version which is never '{'.
+static bool is_json_manifest(const iobuf& buf) {
+    for (const auto& frag : buf) {
+        for (auto c : std::string_view(frag.get(), frag.size())) {
+            if (!std::isspace(static_cast<unsigned char>(c))) {
+                return c == '{';
+            }
+        }
+    }
+    return true;
+}
+
 ss::future<> partition_manifest::update(ss::input_stream<char> is) {
     iobuf result;
     auto os = make_iobuf_ref_output_stream(result);
     co_await ss::copy(is, os);
+    if (!is_json_manifest(result)) {
+        from_iobuf(std::move(result));
+        co_return;
+    }
     iobuf_istreambuf ibuf(result);
     std::istream stream(&ibuf);
     json::IStreamWrapper wrapper(stream);
@@ -747,9 +833,13 @@ void partition_manifest::update(const partition_manifest_handler& handler) {
 
 serialized_json_stream partition_manifest::serialize() const {
     iobuf serialized;
-    iobuf_ostreambuf obuf(serialized);
-    std::ostream os(&obuf);
-    serialize(os);
+    if (config::shard_local_cfg().cloud_storage_manifest_binary_format()) {
+        serialized = to_iobuf();
+    } else {
+        iobuf_ostreambuf obuf(serialized);
+        std::ostream os(&obuf);
+        serialize(os);
+    }
     size_t size_bytes = serialized.size_bytes();
     return {
       .stream = make_iobuf_input_stream(std::move(serialized)),
@@ -812,6 +902,18 @@ void partition_manifest::serialize(std::ostream& out) const {
                 w.Key("archiver_term");
                 w.Int64(meta.archiver_term());
             }
+            if (meta.is_compressed) {
+                w.Key("is_compressed");
+                w.Bool(true);
+            }
+            if (meta.has_index) {
+                w.Key("has_index");
+                w.Bool(true);
+            }
+            if (meta.is_merged) {
+                w.Key("is_merged");
+                w.Bool(true);
+            }
             w.EndObject();
         }
         w.EndObject();
@@ -819,11 +921,229 @@ void partition_manifest::serialize(std::ostream& out) const {
     w.EndObject();
 }
 
+namespace {
+
+/// Single delta-FOR encoded column of the binary manifest
+struct manifest_column
+  : serde::envelope<
+      manifest_column,
+      serde::version<0>,
+      serde::compat_version<0>> {
+    int64_t initial{0};
+    uint32_t rows{0};
+    iobuf data;
+};
+
+/// Segment metadata of the binary manifest, every field of the segment key
+/// and segment_meta is stored in a separate column
+struct manifest_segment_columns
+  : serde::envelope<
+      manifest_segment_columns,
+      serde::version<3>,
+      serde::compat_version<0>> {
+    manifest_column key_base_offset;
+    manifest_column key_term;
+    manifest_column is_compacted;
+    manifest_column size_bytes;
+    manifest_column base_offset;
+    manifest_column committed_offset;
+    manifest_column base_timestamp;
+    manifest_column max_timestamp;
+    manifest_column delta_offset;
+    manifest_column ntp_revision;
+    manifest_column archiver_term;
+    // added in version 1, empty in older manifests
+    manifest_column is_compressed;
+    // added in version 2
+    manifest_column has_index;
+    // added in version 3
+    manifest_column is_merged;
+};
+
+struct partition_manifest_binary
+  : serde::envelope<
+      partition_manifest_binary,
+      serde::version<0>,
+      serde::compat_version<0>> {
+    model::ns ns;
+    model::topic topic;
+    model::partition_id partition;
+    model::initial_revision_id revision;
+    model::offset last_offset;
+    uint64_t num_segments{0};
+    manifest_segment_columns segments;
+};
+
+using delta_delta_t = details::delta_delta<int64_t>;
+constexpr uint32_t column_depth = details::FOR_buffer_depth;
+
+template<class DeltaStep = details::delta_xor>
+manifest_column
+encode_column(const std::vector<int64_t>& values, DeltaStep delta = {}) {
+    auto initial = values.empty() ? 0 : values.front();
+    deltafor_encoder<int64_t, DeltaStep> enc(initial, delta);
+    std::array<int64_t, column_depth> row{};
+    for (size_t i = 0; i < values.size(); i += column_depth) {
+        for (size_t j = 0; j < column_depth; j++) {
+            // the last row is padded with the last value, this keeps
+            // non-decreasing columns non-decreasing
+            row.at(j) = values[std::min(i + j, values.size() - 1)];
+        }
+        enc.add(row);
+    }
+    return manifest_column{
+      .initial = initial, .rows = enc.get_row_count(), .data = enc.copy()};
+}
+
+template<class DeltaStep = details::delta_xor>
+std::vector<int64_t>
+decode_column(manifest_column col, size_t size, DeltaStep delta = {}) {
+    deltafor_decoder<int64_t, DeltaStep> dec(
+      col.initial, col.rows, std::move(col.data), delta);
+    std::vector<int64_t> values;
+    values.reserve(col.rows * column_depth);
+    std::array<int64_t, column_depth> row{};
+    while (dec.read(row)) {
+        values.insert(values.end(), row.begin(), row.end());
+        row = {};
+    }
+    if (values.size() < size) {
+        throw std::runtime_error(fmt_with_ctx(
+          fmt::format,
+          "manifest column has {} values, {} expected",
+          values.size(),
+          size));
+    }
+    values.resize(size);
+    return values;
+}
+
+} // namespace
+
+iobuf partition_manifest::to_iobuf() const {
+    std::vector<int64_t> key_base_offset, key_term, is_compacted, size_bytes,
+      base_offset, committed_offset, base_timestamp, max_timestamp,
+      delta_offset, ntp_revision, archiver_term, is_compressed, has_index,
+      is_merged;
+    for (auto* col :
+         {&key_base_offset,
+          &key_term,
+          &is_compacted,
+          &size_bytes,
+          &base_offset,
+          &committed_offset,
+          &base_timestamp,
+          &max_timestamp,
+          &delta_offset,
+          &ntp_revision,
+          &archiver_term,
+          &is_compressed,
+          &has_index,
+          &is_merged}) {
+        col->reserve(_segments.size());
+    }
+    for (const auto& [key, meta] : _segments) {
+        key_base_offset.push_back(key.base_offset());
+        key_term.push_back(key.term());
+        is_compacted.push_back(meta.is_compacted ? 1 : 0);
+        size_bytes.push_back(static_cast<int64_t>(meta.size_bytes));
+        base_offset.push_back(meta.base_offset());
+        committed_offset.push_back(meta.committed_offset());
+        base_timestamp.push_back(meta.base_timestamp.value());
+        max_timestamp.push_back(meta.max_timestamp.value());
+        delta_offset.push_back(meta.delta_offset());
+        ntp_revision.push_back(meta.ntp_revision());
+        archiver_term.push_back(meta.archiver_term());
+        is_compressed.push_back(meta.is_compressed ? 1 : 0);
+        has_index.push_back(meta.has_index ? 1 : 0);
+        is_merged.push_back(meta.is_merged ? 1 : 0);
+    }
+    partition_manifest_binary bin{
+      .ns = _ntp.ns,
+      .topic = _ntp.tp.topic,
+      .partition = _ntp.tp.partition,
+      .revision = _rev,
+      .last_offset = _last_offset,
+      .num_segments = _segments.size(),
+      .segments = {
+        // the segment map is ordered by the base offset
+        .key_base_offset = encode_column(key_base_offset, delta_delta_t(0)),
+        .key_term = encode_column(key_term),
+        .is_compacted = encode_column(is_compacted),
+        .size_bytes = encode_column(size_bytes),
+        .base_offset = encode_column(base_offset),
+        .committed_offset = encode_column(committed_offset),
+        .base_timestamp = encode_column(base_timestamp),
+        .max_timestamp = encode_column(max_timestamp),
+        .delta_offset = encode_column(delta_offset),
+        .ntp_revision = encode_column(ntp_revision),
+        .archiver_term = encode_column(archiver_term),
+        .is_compressed = encode_column(is_compressed),
+        .has_index = encode_column(has_index),
+        .is_merged = encode_column(is_merged),
+      }};
+    return serde::to_iobuf(std::move(bin));
+}
+
+void partition_manifest::from_iobuf(iobuf in) {
+    auto bin = serde::from_iobuf<partition_manifest_binary>(std::move(in));
+    auto n = bin.num_segments;
+    auto& cols = bin.segments;
+    auto key_base_offset = decode_column(
+      std::move(cols.key_base_offset), n, delta_delta_t(0));
+    auto key_term = decode_column(std::move(cols.key_term), n);
+    auto is_compacted = decode_column(std::move(cols.is_compacted), n);
+    auto size_bytes = decode_column(std::move(cols.size_bytes), n);
+    auto base_offset = decode_column(std::move(cols.base_offset), n);
+    auto committed_offset = decode_column(std::move(cols.committed_offset), n);
+    auto base_timestamp = decode_column(std::move(cols.base_timestamp), n);
+    auto max_timestamp = decode_column(std::move(cols.max_timestamp), n);
+    auto delta_offset = decode_column(std::move(cols.delta_offset), n);
+    auto ntp_revision = decode_column(std::move(cols.ntp_revision), n);
+    auto archiver_term = decode_column(std::move(cols.archiver_term), n);
+    auto is_compressed = cols.is_compressed.rows == 0
+                           ? std::vector<int64_t>(n, 0)
+                           : decode_column(std::move(cols.is_compressed), n);
+    auto has_index = cols.has_index.rows == 0
+                       ? std::vector<int64_t>(n, 0)
+                       : decode_column(std::move(cols.has_index), n);
+    auto is_merged = cols.is_merged.rows == 0
+                       ? std::vector<int64_t>(n, 0)
+                       : decode_column(std::move(cols.is_merged), n);
+
+    segment_map segments;
+    for (size_t i = 0; i < n; i++) {
+        segments.emplace(
+          key{
+            .base_offset = model::offset(key_base_offset[i]),
+            .term = model::term_id(key_term[i])},
+          segment_meta{
+            .is_compacted = is_compacted[i] != 0,
+            .size_bytes = static_cast<size_t>(size_bytes[i]),
+            .base_offset = model::offset(base_offset[i]),
+            .committed_offset = model::offset(committed_offset[i]),
+            .base_timestamp = model::timestamp(base_timestamp[i]),
+            .max_timestamp = model::timestamp(max_timestamp[i]),
+            .delta_offset = model::offset(delta_offset[i]),
+            .ntp_revision = model::initial_revision_id(ntp_revision[i]),
+            .archiver_term = model::term_id(archiver_term[i]),
+            .is_compressed = is_compressed[i] != 0,
+            .has_index = has_index[i] != 0,
+            .is_merged = is_merged[i] != 0,
+          });
+    }
+    _ntp = model::ntp(std::move(bin.ns), std::move(bin.topic), bin.partition);
+    _rev = bin.revision;
+    _last_offset = bin.last_offset;
+    _segments = std::move(segments);
+}
+
 bool partition_manifest::delete_permanently(
   const partition_manifest::key& key) {
     auto it = _segments.find(key);
     if (it != _segments.end()) {
         _segments.erase(it);
+        ++_removed_segments;
         return true;
     }
     return false;
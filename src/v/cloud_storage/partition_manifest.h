@@ -57,6 +57,12 @@ remote_segment_path generate_remote_segment_path(
 /// Generate correct S3 segment name based on term and base offset
 segment_name generate_segment_name(model::offset o, model::term_id t);
 
+/// Name of a segment produced by merging adjacent segments. It includes the
+/// committed offset, so it doesn't collide with the name of the first merged
+/// segment.
+segment_name generate_merged_segment_name(
+  model::offset base, model::offset committed, model::term_id t);
+
 remote_manifest_path
 generate_partition_manifest_path(const model::ntp&, model::initial_revision_id);
 
@@ -65,7 +71,7 @@ class partition_manifest final : public base_manifest {
 public:
     struct segment_meta {
         using value_t = segment_meta;
-        static constexpr serde::version_t redpanda_serde_version = 1;
+        static constexpr serde::version_t redpanda_serde_version = 4;
         static constexpr serde::version_t redpanda_serde_compat_version = 0;
 
         bool is_compacted;
@@ -78,6 +84,15 @@ public:
 
         model::initial_revision_id ntp_revision;
         model::term_id archiver_term;
+        /// The object is a sequence of zstd frames described by the frame
+        /// index stored next to it (see compressed_segment.h)
+        bool is_compressed{false};
+        /// The offset index of the segment is stored next to it (see
+        /// generate_remote_index_path)
+        bool has_index{false};
+        /// The segment replaced adjacent segments, it's stored under the name
+        /// generated by generate_merged_segment_name
+        bool is_merged{false};
 
         auto operator<=>(const segment_meta&) const = default;
     };
@@ -133,6 +148,25 @@ public:
     /// \return manifest that contains only removed segments
     partition_manifest truncate(model::offset starting_rp_offset);
 
+    /// \brief Replace adjacent segments with a segment that covers them
+    ///
+    /// The offset range of 'meta' has to start at the base offset of a
+    /// segment and end at the committed offset of a segment, otherwise the
+    /// manifest is not changed.
+    /// \return manifest that contains only replaced segments
+    partition_manifest replace(const key& key, const segment_meta& meta);
+
+    /// Number of segments removed from the manifest by truncate or replace.
+    /// Lets the users of the manifest notice that segments they know about
+    /// may be gone. Not serialized.
+    size_t removed_segments() const { return _removed_segments; }
+
+    /// Memory held by the segment metadata, the bookkeeping of the map is
+    /// not included
+    size_t memory_size() const {
+        return _segments.size() * sizeof(segment_map::value_type);
+    }
+
     /// Get segment if available or nullopt
     const segment_meta* get(const key& key) const;
     const segment_meta* get(const segment_name& name) const;
@@ -162,8 +196,19 @@ public:
     /// \param out output stream that should be used to output the json
     void serialize(std::ostream& out) const;
 
+    /// Serialize manifest object using the compact binary format
+    ///
+    /// Segment metadata is stored column by column, every column is delta-FOR
+    /// encoded. The binary format is used by 'serialize' if
+    /// cloud_storage_manifest_binary_format is enabled, 'update' accepts
+    /// both formats.
+    iobuf to_iobuf() const;
+
+    /// Update manifest from the compact binary format
+    void from_iobuf(iobuf in);
+
     /// Compare two manifests for equality
-    bool operator==(const partition_manifest& other) const = default;
+    bool operator==(const partition_manifest& other) const;
 
     /// Remove segment record from manifest
     ///
@@ -184,6 +229,7 @@ private:
     model::initial_revision_id _rev;
     segment_map _segments;
     model::offset _last_offset;
+    size_t _removed_segments{0};
 };
 
 } // namespace cloud_storage
@@ -53,6 +53,12 @@ partition_probe::partition_probe(const model::ntp& ntp) {
           [this] { return _cur_materialized_segments; },
           sm::description("Current number of materialized remote segments"),
           labels),
+        sm::make_counter(
+          "prefetched_segments",
+          [this] { return _segments_prefetched; },
+          sm::description(
+            "Total number of remote segments hydrated ahead of readers"),
+          labels),
 
         sm::make_gauge(
           "readers",
@@ -24,8 +24,10 @@ public:
     void add_records_read(uint64_t read) { _records_read += read; }
 
     void segment_added() { ++_cur_segments; }
+    void segment_removed() { --_cur_segments; }
     void segment_materialized() { ++_cur_materialized_segments; }
     void segment_offloaded() { --_cur_materialized_segments; }
+    void segment_prefetched() { ++_segments_prefetched; }
 
     void reader_created() { ++_cur_readers; }
     void reader_destroyed() { --_cur_readers; }
@@ -35,6 +37,7 @@ public:
 private:
     uint64_t _bytes_read = 0;
     uint64_t _records_read = 0;
+    uint64_t _segments_prefetched = 0;
 
     int32_t _cur_segments = 0;
     int32_t _cur_materialized_segments = 0;
@@ -11,6 +11,7 @@
 #include "cloud_storage/partition_recovery_manager.h"
 
 #include "bytes/iobuf_istreambuf.h"
+#include "cloud_storage/compressed_segment.h"
 #include "cloud_storage/logger.h"
 #include "cloud_storage/types.h"
 #include "config/configuration.h"
@@ -77,7 +78,10 @@ private:
 partition_recovery_manager::partition_recovery_manager(
   s3::bucket_name bucket, ss::sharded<remote>& remote)
   : _bucket(std::move(bucket))
-  , _remote(remote) {}
+  , _remote(remote)
+  , _download_units(
+      config::shard_local_cfg().cloud_storage_recovery_max_concurrency(),
+      "cst/recovery") {}
 
 partition_recovery_manager::~partition_recovery_manager() {
     vassert(_gate.is_closed(), "S3 downloader is not stopped properly");
@@ -86,6 +90,7 @@ partition_recovery_manager::~partition_recovery_manager() {
 ss::future<> partition_recovery_manager::stop() {
     vlog(cst_log.debug, "Stopping partition_recovery_manager");
     _as.request_abort();
+    _download_units.broken();
     return _gate.close();
 }
 
@@ -105,7 +110,14 @@ ss::future<log_recovery_result> partition_recovery_manager::download_log(
         co_return log_recovery_result{};
     }
     partition_downloader downloader(
-      ntp_cfg, &_remote.local(), rtp, _bucket, _gate, _root, _as);
+      ntp_cfg,
+      &_remote.local(),
+      rtp,
+      _bucket,
+      _gate,
+      _root,
+      _as,
+      _download_units);
     co_return co_await downloader.download_log();
 }
 
@@ -116,7 +128,8 @@ partition_downloader::partition_downloader(
   s3::bucket_name bucket,
   ss::gate& gate_root,
   retry_chain_node& parent,
-  storage::opt_abort_source_t as)
+  storage::opt_abort_source_t as,
+  ssx::semaphore& download_units)
   : _ntpc(ntpc)
   , _bucket(std::move(bucket))
   , _remote(remote)
@@ -127,7 +140,8 @@ partition_downloader::partition_downloader(
       cst_log,
       _rtcnode,
       ssx::sformat("[{}, rev: {}]", ntpc.ntp().path(), ntpc.get_revision()))
-  , _as(as) {}
+  , _as(as)
+  , _download_units(download_units) {}
 
 ss::future<log_recovery_result> partition_downloader::download_log() {
     vlog(_ctxlog.debug, "Check conditions for S3 recovery for {}", _ntpc);
@@ -374,7 +388,6 @@ partition_downloader::download_log_with_capped_size(
       start_offset,
       start_delta);
 
-    std::vector<offset_range> dloffsets;
     download_part dlpart{
       .part_prefix = std::filesystem::path(prefix.string() + "_part"),
       .dest_prefix = prefix,
@@ -384,30 +397,7 @@ partition_downloader::download_log_with_capped_size(
         .max_offset = model::offset::min(),
       }};
 
-    co_await ss::max_concurrent_for_each(
-      staged_downloads,
-      max_concurrency,
-      [this, _dlpart{&dlpart}, _dloffsets{&dloffsets}](
-        const segment& s) -> ss::future<> {
-          auto& dloffsets{*_dloffsets};
-          auto& dlpart{*_dlpart};
-          retry_chain_node fib(&_rtcnode);
-          retry_chain_logger dllog(cst_log, fib);
-          vlog(
-            dllog.debug,
-            "Starting download, base-offset: {}, term: {}, size: {}, fs "
-            "prefix: {}, "
-            "destination: {}",
-            s.manifest_key.base_offset,
-            s.manifest_key.term,
-            s.meta.size_bytes,
-            dlpart.part_prefix,
-            dlpart.dest_prefix);
-          auto offsets = co_await download_segment_file(s, dlpart);
-          if (offsets) {
-              dloffsets.push_back(offsets.value());
-          }
-      });
+    auto dloffsets = co_await download_segments(staged_downloads, dlpart);
     update_downloaded_offsets(std::move(dloffsets), dlpart);
     if (dlpart.num_files == 0) {
         // The segments didn't have data batches
@@ -468,7 +458,6 @@ partition_downloader::download_log_with_capped_time(
       "start_delta: {}",
       start_offset,
       start_delta);
-    std::vector<offset_range> dloffsets;
     download_part dlpart = {
       .part_prefix = std::filesystem::path(prefix.string() + "_part"),
       .dest_prefix = prefix,
@@ -478,6 +467,24 @@ partition_downloader::download_log_with_capped_time(
         .max_offset = model::offset::min(),
       }};
 
+    auto dloffsets = co_await download_segments(staged_downloads, dlpart);
+    update_downloaded_offsets(std::move(dloffsets), dlpart);
+    if (dlpart.num_files == 0) {
+        // The segments didn't have data batches
+        vlog(_ctxlog.debug, "Log segments didn't have data batches");
+        dlpart.range.min_offset = model::offset{0};
+        dlpart.range.max_offset = model::offset{0};
+    }
+    co_return dlpart;
+}
+
+ss::future<std::vector<partition_downloader::offset_range>>
+partition_downloader::download_segments(
+  const std::deque<segment>& staged_downloads, const download_part& dlpart) {
+    // A partition can use all the units when nothing else is being recovered
+    auto max_concurrency
+      = config::shard_local_cfg().cloud_storage_recovery_max_concurrency();
+    std::vector<offset_range> dloffsets;
     co_await ss::max_concurrent_for_each(
       staged_downloads,
       max_concurrency,
@@ -485,14 +492,16 @@ partition_downloader::download_log_with_capped_time(
         const segment& s) -> ss::future<> {
           auto& dlpart{*_dlpart};
           auto& dloffsets{*_dloffsets};
+          auto units = co_await ss::get_units(_download_units, 1);
           retry_chain_node fib(&_rtcnode);
           retry_chain_logger dllog(cst_log, fib);
           vlog(
             dllog.debug,
-            "Starting download, base_offset: {}, term: {}, fs prefix: {}, "
-            "dest: {}",
+            "Starting download, base_offset: {}, term: {}, size: {}, fs "
+            "prefix: {}, dest: {}",
             s.manifest_key.base_offset,
             s.manifest_key.term,
+            s.meta.size_bytes,
             dlpart.part_prefix,
             dlpart.dest_prefix);
           auto offsets = co_await download_segment_file(s, dlpart);
@@ -500,14 +509,7 @@ partition_downloader::download_log_with_capped_time(
               dloffsets.push_back(offsets.value());
           }
       });
-    update_downloaded_offsets(std::move(dloffsets), dlpart);
-    if (dlpart.num_files == 0) {
-        // The segments didn't have data batches
-        vlog(_ctxlog.debug, "Log segments didn't have data batches");
-        dlpart.range.min_offset = model::offset{0};
-        dlpart.range.max_offset = model::offset{0};
-    }
-    co_return dlpart;
+    co_return dloffsets;
 }
 
 ss::future<partition_manifest>
@@ -548,8 +550,13 @@ open_output_file_stream(const std::filesystem::path& path) {
 ss::future<std::optional<partition_downloader::offset_range>>
 partition_downloader::download_segment_file(
   const segment& segm, const download_part& part) {
-    auto name = generate_segment_name(
-      segm.manifest_key.base_offset, segm.manifest_key.term);
+    auto name = segm.meta.is_merged
+                  ? generate_merged_segment_name(
+                    segm.manifest_key.base_offset,
+                    segm.meta.committed_offset,
+                    segm.manifest_key.term)
+                  : generate_segment_name(
+                    segm.manifest_key.base_offset, segm.manifest_key.term);
     auto remote_path = generate_remote_segment_path(
       _ntpc.ntp(), segm.meta.ntp_revision, name, segm.meta.archiver_term);
 
@@ -577,9 +584,28 @@ partition_downloader::download_segment_file(
         co_await ss::remove_file(localpath.string());
     }
 
+    // Compressed segment is decompressed before the offset translation
+    std::vector<uint64_t> frame_sizes;
+    if (segm.meta.is_compressed) {
+        segment_frame_index index;
+        auto res = co_await _remote->download_frame_index(
+          _bucket, remote_path, index, _rtcnode);
+        if (res != download_result::success || index.num_frames() == 0) {
+            vlog(
+              _ctxlog.error,
+              "Failed frame index download for {}, {}",
+              remote_path,
+              res);
+            co_return std::nullopt;
+        }
+        frame_sizes = index.frame_sizes(0, index.num_frames() - 1);
+    }
+
     model::offset min_offset;
     model::offset max_offset;
     auto stream = [this,
+                   &frame_sizes,
+                   _size_bytes{segm.meta.size_bytes},
                    _part{part},
                    _remote_path{remote_path},
                    _localpath{localpath},
@@ -599,6 +625,10 @@ partition_downloader::download_segment_file(
           "Copying s3 path {} to local location {}",
           remote_path,
           localpath.string());
+        if (!frame_sizes.empty()) {
+            in = make_frame_decompression_stream(
+              std::move(in), frame_sizes, 0, _size_bytes);
+        }
         co_await ss::recursive_touch_directory(part.part_prefix.string());
         auto fs = co_await open_output_file_stream(localpath);
         auto stream_stats = co_await otl.copy_stream(
@@ -17,6 +17,7 @@
 #include "cluster/types.h"
 #include "model/record.h"
 #include "s3/client.h"
+#include "ssx/semaphore.h"
 #include "storage/ntp_config.h"
 #include "utils/named_type.h"
 #include "utils/retry_chain_node.h"
@@ -27,6 +28,7 @@
 #include <seastar/core/sharded.hh>
 
 #include <compare>
+#include <deque>
 #include <iterator>
 #include <vector>
 
@@ -46,6 +48,11 @@ struct log_recovery_result {
 
 /// Data recovery provider is used to download topic segments from S3 (or
 /// compatible storage) during topic re-creation process
+///
+/// Partitions are recovered concurrently, segment downloads of all partitions
+/// on the shard share a single concurrency limit so restoring a topic with
+/// many partitions doesn't degrade into a serial loop or exhaust the
+/// connection pool.
 class partition_recovery_manager {
 public:
     partition_recovery_manager(
@@ -80,14 +87,15 @@ private:
     ss::gate _gate;
     retry_chain_node _root;
     ss::abort_source _as;
+    ssx::semaphore _download_units;
 };
 
 /// Topic downloader is used to download topic segments from S3 (or compatible
 /// storage) during topic re-creation
 class partition_downloader {
-    static constexpr size_t max_concurrency = 1;
-
 public:
+    /// \param download_units limits the number of segment downloads in
+    ///        progress, shared by all partitions recovered on the shard
     partition_downloader(
       const storage::ntp_config& ntpc,
       remote* remote,
@@ -95,7 +103,8 @@ public:
       s3::bucket_name bucket,
       ss::gate& gate_root,
       retry_chain_node& parent,
-      storage::opt_abort_source_t as);
+      storage::opt_abort_source_t as,
+      ssx::semaphore& download_units);
 
     partition_downloader(const partition_downloader&) = delete;
     partition_downloader(partition_downloader&&) = delete;
@@ -172,6 +181,12 @@ private:
 
     ss::future<offset_map_t> build_offset_map(const recovery_material& mat);
 
+    /// Download staged segments concurrently, the number of downloads is
+    /// bounded by the shared download units
+    ss::future<std::vector<offset_range>> download_segments(
+      const std::deque<segment>& staged_downloads,
+      const download_part& dlpart);
+
     ss::future<download_part> download_log_with_capped_size(
       const offset_map_t& offset_map,
       const partition_manifest& manifest,
@@ -198,6 +213,7 @@ private:
     retry_chain_node _rtcnode;
     retry_chain_logger _ctxlog;
     storage::opt_abort_source_t _as;
+    ssx::semaphore& _download_units;
 };
 
 } // namespace cloud_storage
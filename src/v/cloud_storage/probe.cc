@@ -43,6 +43,11 @@ remote_probe::remote_probe(
               "partition_manifest_downloads",
               [this] { return get_partition_manifest_downloads(); },
               sm::description("Number of partition manifest downloads")),
+            sm::make_counter(
+              "manifest_not_modified",
+              [this] { return get_manifest_not_modified(); },
+              sm::description("Number of conditional manifest downloads "
+                              "which found the manifest unchanged")),
             sm::make_counter(
               "manifest_upload_backoff",
               [this] { return get_manifest_upload_backoffs(); },
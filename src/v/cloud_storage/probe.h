@@ -59,6 +59,14 @@ public:
         return _cnt_partition_manifest_downloads;
     }
 
+    /// Register conditional manifest download of an unchanged manifest
+    void manifest_not_modified() { _cnt_manifest_not_modified++; }
+
+    /// Get conditional manifest downloads of unchanged manifests
+    uint64_t get_manifest_not_modified() const {
+        return _cnt_manifest_not_modified;
+    }
+
     /// Register manifest (re)upload
     void txrange_manifest_upload() { _cnt_tx_manifest_uploads++; }
 
@@ -158,6 +166,9 @@ private:
     uint64_t _cnt_topic_manifest_downloads{0};
     /// Number of manifest downloads
     uint64_t _cnt_partition_manifest_downloads{0};
+    /// Number of conditional manifest downloads skipped because the
+    /// manifest didn't change
+    uint64_t _cnt_manifest_not_modified{0};
     /// Number of times backoff was applied during manifest upload
     uint64_t _cnt_manifest_upload_backoff{0};
     /// Number of times backoff was applied during manifest download
@@ -80,7 +80,8 @@ recursive_directory_walker::walk(
                         {last_access_timepoint,
                          (std::filesystem::path(target) / entry.name.data())
                            .native(),
-                         static_cast<uint64_t>(file_stats.size)});
+                         static_cast<uint64_t>(file_stats.size),
+                         file_stats.time_modified});
                   } else if (
                     entry.type
                     && entry.type == ss::directory_entry_type::directory) {
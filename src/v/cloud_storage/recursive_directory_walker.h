@@ -23,6 +23,7 @@ struct file_list_item {
     std::chrono::system_clock::time_point access_time;
     ss::sstring path;
     uint64_t size;
+    std::chrono::system_clock::time_point modification_time;
 };
 class recursive_directory_walker {
 public:
@@ -10,14 +10,18 @@
 
 #include "cloud_storage/remote.h"
 
+#include "cloud_storage/compressed_segment.h"
 #include "cloud_storage/logger.h"
+#include "cloud_storage/remote_segment_index.h"
 #include "cloud_storage/types.h"
+#include "config/configuration.h"
 #include "s3/client.h"
 #include "ssx/sformat.h"
 #include "utils/intrusive_list_helpers.h"
 #include "utils/retry_chain_node.h"
 #include "utils/string_switch.h"
 
+#include <seastar/core/condition-variable.hh>
 #include <seastar/core/loop.hh>
 #include <seastar/core/lowres_clock.hh>
 #include <seastar/core/sleep.hh>
@@ -26,8 +30,10 @@
 
 #include <boost/beast/http/error.hpp>
 #include <boost/beast/http/field.hpp>
+#include <boost/range/irange.hpp>
 #include <fmt/chrono.h>
 
+#include <array>
 #include <exception>
 #include <utility>
 #include <variant>
@@ -147,11 +153,30 @@ remote::remote(
   s3_connection_limit limit,
   const s3::configuration& conf,
   model::cloud_credentials_source cloud_credentials_source)
-  : _pool(limit(), conf)
+  : _pool(
+    limit(),
+    conf,
+    s3::client_pool_overdraft_policy::wait_if_empty,
+    s3::client_pool_autoscale{
+      .max_overdraft
+      = config::shard_local_cfg().cloud_storage_max_connections_overdraft(),
+      .wait_threshold = config::shard_local_cfg()
+                          .cloud_storage_connection_pool_scale_up_wait_ms()})
+  , _s3_probe(conf._probe)
+  , _hedge_get_requests(
+      config::shard_local_cfg().cloud_storage_hedge_get_requests.bind())
   , _probe(
       remote_metrics_disabled(static_cast<bool>(conf.disable_metrics)),
       remote_metrics_disabled(static_cast<bool>(conf.disable_public_metrics)))
-  , _auth_refresh_bg_op{_gate, _as, conf, cloud_credentials_source} {
+  , _auth_refresh_bg_op{_gate, _as, conf, cloud_credentials_source}
+  , _prefetch_downloads(
+      config::shard_local_cfg().cloud_storage_prefetch_max_concurrency(),
+      "cst/prefetch-downloads")
+  , _prefetch_bytes(
+      config::shard_local_cfg().cloud_storage_prefetch_max_inflight_bytes(),
+      "cst/prefetch-bytes")
+  , _prefetch_max_bytes(
+      config::shard_local_cfg().cloud_storage_prefetch_max_inflight_bytes()) {
     // If the credentials source is from config file, bypass the background op
     // to refresh credentials periodically, and load pool with static
     // credentials right now.
@@ -188,10 +213,48 @@ ss::future<> remote::stop() {
 
 size_t remote::concurrency() const { return _pool.max_size(); }
 
+std::optional<remote::prefetch_units>
+remote::try_reserve_prefetch(size_t size_bytes) {
+    auto downloads = ss::try_get_units(_prefetch_downloads, 1);
+    if (!downloads) {
+        return std::nullopt;
+    }
+    // a segment larger than the whole budget is prefetched on its own
+    auto bytes = ss::try_get_units(
+      _prefetch_bytes, std::min(size_bytes, _prefetch_max_bytes));
+    if (!bytes) {
+        return std::nullopt;
+    }
+    return prefetch_units{
+      .downloads = std::move(*downloads), .bytes = std::move(*bytes)};
+}
+
 ss::future<download_result> remote::download_manifest(
   const s3::bucket_name& bucket,
   const remote_manifest_path& key,
   base_manifest& manifest,
+  retry_chain_node& parent) {
+    auto res = co_await do_download_manifest(
+      bucket, key, manifest, nullptr, parent);
+    co_return res.result;
+}
+
+ss::future<remote::conditional_download_result>
+remote::download_manifest_if_modified(
+  const s3::bucket_name& bucket,
+  const remote_manifest_path& key,
+  base_manifest& manifest,
+  ss::sstring& etag,
+  retry_chain_node& parent) {
+    return do_download_manifest(bucket, key, manifest, &etag, parent);
+}
+
+ss::future<remote::conditional_download_result>
+remote::do_download_manifest(
+  const s3::bucket_name& bucket,
+  const remote_manifest_path& key,
+  base_manifest& manifest,
+  ss::sstring* etag,
   retry_chain_node& parent) {
     gate_guard guard{_gate};
     retry_chain_node fib(&parent);
@@ -205,10 +268,29 @@ ss::future<download_result> remote::download_manifest(
            && !result.has_value()) {
         std::exception_ptr eptr = nullptr;
         try {
+            std::optional<ss::sstring> if_none_match;
+            if (etag && !etag->empty()) {
+                if_none_match = *etag;
+            }
             auto resp = co_await client->get_object(
-              bucket, path, fib.get_timeout());
+              bucket, path, fib.get_timeout(), std::nullopt, if_none_match);
+            const auto& headers = resp->get_headers();
+            if (headers.result() == boost::beast::http::status::not_modified) {
+                vlog(ctxlog.debug, "Manifest {} not modified", path);
+                _probe.manifest_not_modified();
+                co_return conditional_download_result{
+                  .result = download_result::success, .modified = false};
+            }
             vlog(ctxlog.debug, "Receive OK response from {}", path);
+            ss::sstring new_etag;
+            if (auto it = headers.find(boost::beast::http::field::etag);
+                it != headers.end()) {
+                new_etag = ss::sstring(it->value().data(), it->value().size());
+            }
             co_await manifest.update(resp->as_input_stream());
+            if (etag) {
+                *etag = std::move(new_etag);
+            }
             switch (manifest.get_manifest_type()) {
             case manifest_type::partition:
                 _probe.partition_manifest_download();
@@ -220,7 +302,8 @@ ss::future<download_result> remote::download_manifest(
                 _probe.txrange_manifest_download();
                 break;
             }
-            co_return download_result::success;
+            co_return conditional_download_result{
+              .result = download_result::success, .modified = true};
         } catch (...) {
             eptr = std::current_exception();
         }
@@ -270,7 +353,7 @@ ss::future<download_result> remote::download_manifest(
           path);
         result = download_result::timedout;
     }
-    co_return *result;
+    co_return conditional_download_result{.result = *result};
 }
 
 ss::future<upload_result> remote::upload_manifest(
@@ -458,11 +541,394 @@ ss::future<upload_result> remote::upload_segment(
     co_return upload_result::timedout;
 }
 
+template<class T, class Func>
+ss::future<std::optional<T>> remote::retry_request(
+  const s3::bucket_name& bucket,
+  const s3::object_key& path,
+  retry_chain_node& parent,
+  Func request) {
+    retry_chain_node fib(&parent);
+    retry_chain_logger ctxlog(cst_log, fib);
+    auto permit = fib.retry();
+    while (!_gate.is_closed() && permit.is_allowed) {
+        auto [client, deleter] = co_await _pool.acquire();
+        std::exception_ptr eptr = nullptr;
+        try {
+            co_return co_await request(*client, fib);
+        } catch (...) {
+            eptr = std::current_exception();
+        }
+        co_await client->shutdown();
+        auto outcome = categorize_error(eptr, fib, bucket, path);
+        switch (outcome) {
+        case error_outcome::retry_slowdown:
+            [[fallthrough]];
+        case error_outcome::retry:
+            vlog(
+              ctxlog.debug,
+              "Request to {} in {} failed, {} backoff required",
+              path,
+              bucket,
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                permit.delay));
+            _probe.upload_backoff();
+            co_await ss::sleep_abortable(permit.delay, _as);
+            permit = fib.retry();
+            break;
+        case error_outcome::notfound:
+            // not expected during upload
+        case error_outcome::fail:
+            co_return std::nullopt;
+        }
+    }
+    co_return std::nullopt;
+}
+
+ss::future<upload_result> remote::upload_segment_multipart(
+  const s3::bucket_name& bucket,
+  const remote_segment_path& segment_path,
+  uint64_t content_length,
+  uint64_t part_size,
+  size_t concurrency,
+  const reset_part_stream& reset_str,
+  retry_chain_node& parent,
+  lazy_abort_source& lazy_abort_source) {
+    gate_guard guard{_gate};
+    retry_chain_node fib(&parent);
+    retry_chain_logger ctxlog(cst_log, fib);
+    std::vector<s3::object_tag> tags = {{"rp-type", "segment"}};
+    auto path = s3::object_key(segment_path());
+    auto num_parts = (content_length + part_size - 1) / part_size;
+    vlog(
+      ctxlog.debug,
+      "Uploading segment to path {}, length {}, {} parts",
+      segment_path,
+      content_length,
+      num_parts);
+
+    auto upload_id = co_await retry_request<ss::sstring>(
+      bucket, path, fib, [&](s3::client& client, retry_chain_node& rtc) {
+          return client.create_multipart_upload(
+            bucket, path, tags, rtc.get_timeout());
+      });
+    if (!upload_id) {
+        vlog(
+          ctxlog.warn,
+          "Uploading segment {} to {}, failed to create multipart upload",
+          segment_path,
+          bucket);
+        _probe.failed_upload();
+        co_return upload_result::failed;
+    }
+
+    std::vector<s3::client::completed_part> parts(num_parts);
+    std::optional<upload_result> result;
+    co_await ss::max_concurrent_for_each(
+      boost::irange<uint64_t>(0, num_parts),
+      concurrency,
+      [&](uint64_t ix) -> ss::future<> {
+          if (result) {
+              co_return;
+          }
+          if (lazy_abort_source.abort_requested()) {
+              vlog(
+                ctxlog.warn,
+                "{}: cancelled uploading {} to {}",
+                lazy_abort_source.abort_reason(),
+                segment_path,
+                bucket);
+              result = upload_result::cancelled;
+              co_return;
+          }
+          auto offset = ix * part_size;
+          auto length = std::min(part_size, content_length - offset);
+          auto part_number = static_cast<int>(ix + 1);
+          auto etag = co_await retry_request<ss::sstring>(
+            bucket,
+            path,
+            fib,
+            [&](
+              s3::client& client,
+              retry_chain_node& rtc) -> ss::future<ss::sstring> {
+                auto reader_handle = co_await reset_str(offset, length);
+                std::exception_ptr eptr = nullptr;
+                ss::sstring etag;
+                try {
+                    etag = co_await client.upload_part(
+                      bucket,
+                      path,
+                      *upload_id,
+                      part_number,
+                      length,
+                      reader_handle.take_stream(),
+                      rtc.get_timeout());
+                } catch (...) {
+                    eptr = std::current_exception();
+                }
+                // `upload_part` closed the encapsulated input_stream, but we
+                // must call close() on the segment_reader_handle to release
+                // the FD.
+                co_await reader_handle.close();
+                if (eptr) {
+                    std::rethrow_exception(eptr);
+                }
+                co_return etag;
+            });
+          if (!etag) {
+              vlog(
+                ctxlog.warn,
+                "Uploading segment {} to {}, part {} not uploaded",
+                segment_path,
+                bucket,
+                part_number);
+              result = upload_result::failed;
+              co_return;
+          }
+          parts[ix] = {.part_number = part_number, .etag = std::move(*etag)};
+      });
+
+    if (!result) {
+        auto completed = co_await retry_request<bool>(
+          bucket, path, fib, [&](s3::client& client, retry_chain_node& rtc) {
+              return client
+                .complete_multipart_upload(
+                  bucket, path, *upload_id, parts, rtc.get_timeout())
+                .then([] { return true; });
+          });
+        if (completed) {
+            _probe.successful_upload();
+            _probe.register_upload_size(content_length);
+            co_return upload_result::success;
+        }
+        result = upload_result::failed;
+    }
+
+    // Parts of the incomplete upload are stored (and billed) until the upload
+    // is aborted.
+    vlog(
+      ctxlog.warn,
+      "Uploading segment {} to {}, {}, aborting multipart upload {}",
+      segment_path,
+      bucket,
+      *result,
+      *upload_id);
+    co_await retry_request<bool>(
+      bucket, path, fib, [&](s3::client& client, retry_chain_node& rtc) {
+          return client
+            .abort_multipart_upload(bucket, path, *upload_id, rtc.get_timeout())
+            .then([] { return true; });
+      });
+    _probe.failed_upload();
+    co_return *result;
+}
+
+ss::future<upload_result> remote::upload_segment_compressed(
+  const s3::bucket_name& bucket,
+  const remote_segment_path& segment_path,
+  uint64_t frame_size,
+  uint64_t part_size,
+  const reset_input_stream& reset_str,
+  retry_chain_node& parent,
+  lazy_abort_source& lazy_abort_source) {
+    gate_guard guard{_gate};
+    retry_chain_node fib(&parent);
+    retry_chain_logger ctxlog(cst_log, fib);
+    std::vector<s3::object_tag> tags = {{"rp-type", "segment"}};
+    std::vector<s3::object_tag> index_tags = {{"rp-type", "segment-index"}};
+    auto path = s3::object_key(segment_path());
+    auto index_path = s3::object_key(
+      generate_remote_frame_index_path(segment_path)());
+    vlog(
+      ctxlog.debug,
+      "Uploading compressed segment to path {}, frame size {}",
+      segment_path,
+      frame_size);
+
+    auto put_object = [&](
+                        const s3::object_key& key,
+                        const iobuf& body,
+                        const std::vector<s3::object_tag>& object_tags) {
+        return retry_request<bool>(
+          bucket, key, fib, [&](s3::client& client, retry_chain_node& rtc) {
+              return client
+                .put_object(
+                  bucket,
+                  key,
+                  body.size_bytes(),
+                  make_iobuf_input_stream(body.copy()),
+                  object_tags,
+                  rtc.get_timeout())
+                .then([] { return true; });
+          });
+    };
+
+    // Only one part is kept in memory, it's uploaded as soon as it's
+    // filled. The multipart upload is created when the first part is full.
+    auto reader_handle = co_await reset_str();
+    segment_compressor compressor(reader_handle.stream(), frame_size);
+    std::optional<ss::sstring> upload_id;
+    std::vector<s3::client::completed_part> parts;
+    std::optional<upload_result> result;
+    iobuf part;
+    std::exception_ptr eptr = nullptr;
+    try {
+        bool eof = false;
+        while (!eof && !result) {
+            if (lazy_abort_source.abort_requested()) {
+                vlog(
+                  ctxlog.warn,
+                  "{}: cancelled uploading {} to {}",
+                  lazy_abort_source.abort_reason(),
+                  segment_path,
+                  bucket);
+                result = upload_result::cancelled;
+                break;
+            }
+            auto frame = co_await compressor.next_frame();
+            eof = frame.empty();
+            part.append(std::move(frame));
+            if (!eof && part.size_bytes() < part_size) {
+                continue;
+            }
+            if (part.empty() || (eof && !upload_id)) {
+                break;
+            }
+            if (!upload_id) {
+                upload_id = co_await retry_request<ss::sstring>(
+                  bucket,
+                  path,
+                  fib,
+                  [&](s3::client& client, retry_chain_node& rtc) {
+                      return client.create_multipart_upload(
+                        bucket, path, tags, rtc.get_timeout());
+                  });
+                if (!upload_id) {
+                    result = upload_result::failed;
+                    break;
+                }
+            }
+            auto part_number = static_cast<int>(parts.size() + 1);
+            auto etag = co_await retry_request<ss::sstring>(
+              bucket,
+              path,
+              fib,
+              [&](s3::client& client, retry_chain_node& rtc) {
+                  return client.upload_part(
+                    bucket,
+                    path,
+                    *upload_id,
+                    part_number,
+                    part.size_bytes(),
+                    make_iobuf_input_stream(part.copy()),
+                    rtc.get_timeout());
+              });
+            if (!etag) {
+                vlog(
+                  ctxlog.warn,
+                  "Uploading compressed segment {} to {}, part {} not "
+                  "uploaded",
+                  segment_path,
+                  bucket,
+                  part_number);
+                result = upload_result::failed;
+                break;
+            }
+            parts.push_back(
+              {.part_number = part_number, .etag = std::move(*etag)});
+            part.clear();
+        }
+    } catch (...) {
+        eptr = std::current_exception();
+    }
+    co_await reader_handle.close();
+    if (eptr) {
+        vlog(
+          ctxlog.warn,
+          "Uploading compressed segment {} to {}, failed to read the segment: "
+          "{}",
+          segment_path,
+          bucket,
+          eptr);
+        result = upload_result::failed;
+    }
+
+    if (!result) {
+        std::optional<bool> uploaded;
+        if (upload_id) {
+            uploaded = co_await retry_request<bool>(
+              bucket,
+              path,
+              fib,
+              [&](s3::client& client, retry_chain_node& rtc) {
+                  return client
+                    .complete_multipart_upload(
+                      bucket, path, *upload_id, parts, rtc.get_timeout())
+                    .then([] { return true; });
+              });
+        } else {
+            uploaded = co_await put_object(path, part, tags);
+        }
+        if (!uploaded) {
+            result = upload_result::failed;
+        }
+    }
+
+    if (result) {
+        if (upload_id) {
+            vlog(
+              ctxlog.warn,
+              "Uploading compressed segment {} to {}, {}, aborting multipart "
+              "upload {}",
+              segment_path,
+              bucket,
+              *result,
+              *upload_id);
+            co_await retry_request<bool>(
+              bucket,
+              path,
+              fib,
+              [&](s3::client& client, retry_chain_node& rtc) {
+                  return client
+                    .abort_multipart_upload(
+                      bucket, path, *upload_id, rtc.get_timeout())
+                    .then([] { return true; });
+              });
+        }
+        _probe.failed_upload();
+        co_return *result;
+    }
+
+    // The segment can't be read without its index, the upload is successful
+    // only if both objects are uploaded.
+    auto index = compressor.index().to_iobuf();
+    if (!co_await put_object(index_path, index, index_tags)) {
+        vlog(
+          ctxlog.warn,
+          "Uploading compressed segment {} to {}, failed to upload the frame "
+          "index",
+          segment_path,
+          bucket);
+        _probe.failed_upload();
+        co_return upload_result::failed;
+    }
+    vlog(
+      ctxlog.debug,
+      "Uploaded compressed segment {}, size {}, compressed size {}",
+      segment_path,
+      compressor.index().size_bytes,
+      compressor.index().compressed_size());
+    _probe.successful_upload();
+    _probe.register_upload_size(
+      compressor.index().compressed_size() + index.size_bytes());
+    co_return upload_result::success;
+}
+
 ss::future<download_result> remote::download_segment(
   const s3::bucket_name& bucket,
   const remote_segment_path& segment_path,
   const try_consume_stream& cons_str,
-  retry_chain_node& parent) {
+  retry_chain_node& parent,
+  std::optional<s3::byte_range> range) {
     gate_guard guard{_gate};
     retry_chain_node fib(&parent);
     retry_chain_logger ctxlog(cst_log, fib);
@@ -473,9 +939,10 @@ ss::future<download_result> remote::download_segment(
     std::optional<download_result> result;
     while (!_gate.is_closed() && permit.is_allowed && !result) {
         std::exception_ptr eptr = nullptr;
+        std::optional<s3::client_pool::client_lease> hedge;
         try {
-            auto resp = co_await client->get_object(
-              bucket, path, fib.get_timeout());
+            auto resp = co_await hedged_get_object(
+              *client, hedge, bucket, path, fib.get_timeout(), range);
             vlog(ctxlog.debug, "Receive OK response from {}", path);
             auto length = boost::lexical_cast<uint64_t>(resp->get_headers().at(
               boost::beast::http::field::content_length));
@@ -488,6 +955,10 @@ ss::future<download_result> remote::download_segment(
             eptr = std::current_exception();
         }
         co_await client->shutdown();
+        if (hedge) {
+            co_await hedge->client->shutdown();
+            hedge.reset();
+        }
         auto outcome = categorize_error(eptr, fib, bucket, path);
         switch (outcome) {
         case error_outcome::retry_slowdown:
@@ -530,6 +1001,192 @@ ss::future<download_result> remote::download_segment(
     }
     co_return *result;
 }
+std::optional<std::chrono::microseconds> remote::hedge_threshold() const {
+    // Hedge the slowest 1% of the requests, the estimate of the percentile
+    // is not reliable until the histogram has enough samples.
+    static constexpr double hedge_percentile = 99.0;
+    static constexpr uint64_t min_samples = 100;
+    if (
+      !_hedge_get_requests() || !_s3_probe
+      || _s3_probe->get_latency_samples() < min_samples) {
+        return std::nullopt;
+    }
+    return _s3_probe->get_latency_at(hedge_percentile);
+}
+
+ss::future<http::client::response_stream_ref> remote::hedged_get_object(
+  s3::client& client,
+  std::optional<s3::client_pool::client_lease>& hedge,
+  const s3::bucket_name& bucket,
+  const s3::object_key& path,
+  const ss::lowres_clock::duration& timeout,
+  std::optional<s3::byte_range> range) {
+    auto threshold = hedge_threshold();
+    if (!threshold) {
+        co_return co_await client.get_object(bucket, path, timeout, range);
+    }
+
+    struct attempt {
+        s3::client* client{nullptr};
+        std::optional<http::client::response_stream_ref> response;
+        std::exception_ptr error;
+        bool done{false};
+    };
+    std::array<attempt, 2> attempts;
+    size_t num_attempts = 1;
+    ss::condition_variable cvar;
+    auto run = [&](attempt& a) -> ss::future<> {
+        try {
+            a.response = co_await a.client->get_object(
+              bucket, path, timeout, range);
+        } catch (...) {
+            a.error = std::current_exception();
+        }
+        a.done = true;
+        cvar.signal();
+    };
+    auto finished = [&] {
+        bool all_done = true;
+        for (size_t i = 0; i < num_attempts; i++) {
+            if (attempts[i].response) {
+                return true;
+            }
+            all_done = all_done && attempts[i].done;
+        }
+        return all_done;
+    };
+
+    attempts[0].client = &client;
+    auto primary = run(attempts[0]);
+    auto secondary = ss::now();
+    bool timed_out = false;
+    try {
+        co_await cvar.wait(*threshold, finished);
+    } catch (const ss::condition_variable_timed_out&) {
+        timed_out = true;
+    }
+    // Only hedge if a connection is available right away, otherwise the
+    // pool is saturated and the duplicate would only add to the load.
+    if (timed_out && _pool.size() > 0 && !_gate.is_closed()) {
+        try {
+            hedge = co_await _pool.acquire();
+        } catch (...) {
+            vlog(
+              cst_log.debug,
+              "Can't hedge GET request for {}: {}",
+              path,
+              std::current_exception());
+        }
+        if (hedge) {
+            attempts[1].client = hedge->client.get();
+            num_attempts = 2;
+            _s3_probe->register_hedged_get();
+            secondary = run(attempts[1]);
+        }
+    }
+    co_await cvar.wait(finished);
+
+    attempt* winner = nullptr;
+    for (size_t i = 0; i < num_attempts; i++) {
+        if (attempts[i].response) {
+            winner = &attempts[i];
+            break;
+        }
+    }
+    // The other request is either still in flight or its response body
+    // won't be read, in both cases the connection can't be reused as is.
+    for (size_t i = 0; i < num_attempts; i++) {
+        auto& a = attempts[i];
+        if (&a != winner && (!a.done || a.response)) {
+            co_await a.client->shutdown();
+        }
+    }
+    co_await std::move(primary);
+    co_await std::move(secondary);
+
+    if (winner == nullptr) {
+        std::rethrow_exception(attempts[0].error);
+    }
+    if (winner == &attempts[1]) {
+        _s3_probe->register_hedged_get_win();
+    } else {
+        hedge.reset();
+    }
+    co_return std::move(*winner->response);
+}
+
+ss::future<download_result> remote::download_frame_index(
+  const s3::bucket_name& bucket,
+  const remote_segment_path& segment_path,
+  segment_frame_index& index,
+  retry_chain_node& parent) {
+    iobuf buf;
+    auto callback = [&buf](
+                      uint64_t size_bytes,
+                      ss::input_stream<char> s) -> ss::future<uint64_t> {
+        buf = co_await read_iobuf_exactly(s, size_bytes).finally([&s] {
+            return s.close();
+        });
+        co_return size_bytes;
+    };
+    auto res = co_await download_segment(
+      bucket, generate_remote_frame_index_path(segment_path), callback, parent);
+    if (res == download_result::success) {
+        index = segment_frame_index::from_iobuf(std::move(buf));
+    }
+    co_return res;
+}
+
+ss::future<upload_result> remote::upload_segment_index(
+  const s3::bucket_name& bucket,
+  const remote_segment_path& segment_path,
+  iobuf index,
+  retry_chain_node& parent) {
+    gate_guard guard{_gate};
+    retry_chain_node fib(&parent);
+    retry_chain_logger ctxlog(cst_log, fib);
+    std::vector<s3::object_tag> tags = {{"rp-type", "segment-index"}};
+    auto path = s3::object_key(generate_remote_index_path(segment_path)());
+    vlog(ctxlog.debug, "Uploading segment index to path {}", path);
+    auto uploaded = co_await retry_request<bool>(
+      bucket, path, fib, [&](s3::client& client, retry_chain_node& rtc) {
+          return client
+            .put_object(
+              bucket,
+              path,
+              index.size_bytes(),
+              make_iobuf_input_stream(index.copy()),
+              tags,
+              rtc.get_timeout())
+            .then([] { return true; });
+      });
+    if (!uploaded) {
+        vlog(ctxlog.warn, "Failed to upload segment index {}", path);
+        _probe.failed_upload();
+        co_return upload_result::failed;
+    }
+    _probe.successful_upload();
+    _probe.register_upload_size(index.size_bytes());
+    co_return upload_result::success;
+}
+
+ss::future<download_result> remote::download_segment_index(
+  const s3::bucket_name& bucket,
+  const remote_segment_path& segment_path,
+  iobuf& index,
+  retry_chain_node& parent) {
+    auto callback = [&index](
+                      uint64_t size_bytes,
+                      ss::input_stream<char> s) -> ss::future<uint64_t> {
+        index = co_await read_iobuf_exactly(s, size_bytes).finally([&s] {
+            return s.close();
+        });
+        co_return size_bytes;
+    };
+    co_return co_await download_segment(
+      bucket, generate_remote_index_path(segment_path), callback, parent);
+}
+
 ss::future<download_result> remote::segment_exists(
   const s3::bucket_name& bucket,
   const remote_segment_path& segment_path,
@@ -600,6 +1257,66 @@ ss::future<download_result> remote::segment_exists(
     co_return *result;
 }
 
+ss::future<upload_result> remote::delete_object(
+  const s3::bucket_name& bucket,
+  const s3::object_key& path,
+  retry_chain_node& parent) {
+    ss::gate::holder gh{_gate};
+    retry_chain_node fib(&parent);
+    retry_chain_logger ctxlog(cst_log, fib);
+    auto [client, deleter] = co_await _pool.acquire();
+    auto permit = fib.retry();
+    vlog(ctxlog.debug, "Delete object {}", path);
+    std::optional<upload_result> result;
+    while (!_gate.is_closed() && permit.is_allowed && !result) {
+        std::exception_ptr eptr = nullptr;
+        try {
+            co_await client->delete_object(bucket, path, fib.get_timeout());
+            co_return upload_result::success;
+        } catch (...) {
+            eptr = std::current_exception();
+        }
+        co_await client->shutdown();
+        auto outcome = categorize_error(eptr, fib, bucket, path);
+        switch (outcome) {
+        case error_outcome::retry_slowdown:
+            [[fallthrough]];
+        case error_outcome::retry:
+            vlog(
+              ctxlog.debug,
+              "DeleteObject {}, {} backoff required",
+              bucket,
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                permit.delay));
+            co_await ss::sleep_abortable(permit.delay, _as);
+            permit = fib.retry();
+            break;
+        case error_outcome::fail:
+            result = upload_result::failed;
+            break;
+        case error_outcome::notfound:
+            // already deleted
+            co_return upload_result::success;
+        }
+    }
+    if (!result) {
+        vlog(
+          ctxlog.warn,
+          "DeleteObject {}, backoff quota exceded, object {} not deleted",
+          bucket,
+          path);
+        result = upload_result::timedout;
+    } else {
+        vlog(
+          ctxlog.warn,
+          "DeleteObject {}, {}, object {} not deleted",
+          bucket,
+          *result,
+          path);
+    }
+    co_return *result;
+}
+
 ss::sstring lazy_abort_source::abort_reason() const { return _abort_reason; }
 
 bool lazy_abort_source::abort_requested() { return _predicate(*this); }
@@ -14,8 +14,10 @@
 #include "cloud_storage/base_manifest.h"
 #include "cloud_storage/probe.h"
 #include "cloud_storage/types.h"
+#include "config/property.h"
 #include "random/simple_time_jitter.h"
 #include "s3/client.h"
+#include "ssx/semaphore.h"
 #include "storage/segment_reader.h"
 #include "utils/retry_chain_node.h"
 
@@ -23,10 +25,13 @@
 #include <seastar/core/gate.hh>
 #include <seastar/core/loop.hh>
 
+#include <optional>
 #include <utility>
 
 namespace cloud_storage {
 
+struct segment_frame_index;
+
 /// \brief Predicate required to continue operation
 ///
 /// Describes a predicate to be evaluated before starting an expensive
@@ -107,6 +112,12 @@ public:
     using reset_input_stream
       = ss::noncopyable_function<ss::future<storage::segment_reader_handle>()>;
 
+    /// Functor that returns fresh input_stream object that returns `length`
+    /// bytes of the data starting from `offset`. Used to re-upload individual
+    /// parts of a multipart upload.
+    using reset_part_stream = ss::noncopyable_function<
+      ss::future<storage::segment_reader_handle>(uint64_t, uint64_t)>;
+
     /// Functor that attempts to consume the input stream. If the connection
     /// is broken during the download the functor is responsible for he cleanup.
     /// The functor should be reenterable since it can be called many times.
@@ -161,6 +172,28 @@ public:
       base_manifest& manifest,
       retry_chain_node& parent);
 
+    struct conditional_download_result {
+        download_result result;
+        /// Set if a new version of the manifest was downloaded
+        bool modified{false};
+    };
+
+    /// \brief Download manifest if it changed
+    ///
+    /// The request carries the ETag of the version of the manifest that the
+    /// caller has, the manifest is only transferred and parsed if the object
+    /// changed since.
+    /// \param etag is the ETag of the manifest the caller has, empty if it
+    ///        has none. Set to the ETag of the downloaded version.
+    /// \return future that returns success code, 'modified' is not set if
+    ///         the manifest didn't change
+    ss::future<conditional_download_result> download_manifest_if_modified(
+      const s3::bucket_name& bucket,
+      const remote_manifest_path& key,
+      base_manifest& manifest,
+      ss::sstring& etag,
+      retry_chain_node& parent);
+
     /// \brief Upload manifest to the pre-defined S3 location
     ///
     /// \param bucket is a bucket name
@@ -187,6 +220,48 @@ public:
       retry_chain_node& parent,
       lazy_abort_source& lazy_abort_source);
 
+    /// \brief Upload segment to S3 using multipart upload
+    ///
+    /// The segment is split into parts of `part_size` bytes (the last part can
+    /// be smaller) which are uploaded concurrently. Every part is retried
+    /// individually, so a transient error doesn't restart the whole upload.
+    /// If the upload can't be completed it is aborted to let S3 clean up the
+    /// parts that were already uploaded.
+    /// \param part_size is a size of the individual part
+    /// \param concurrency is a max number of parts uploaded at the same time
+    /// \param reset_str is a functor that returns an input_stream that returns
+    ///                  the data of the individual part
+    ss::future<upload_result> upload_segment_multipart(
+      const s3::bucket_name& bucket,
+      const remote_segment_path& segment_path,
+      uint64_t content_length,
+      uint64_t part_size,
+      size_t concurrency,
+      const reset_part_stream& reset_str,
+      retry_chain_node& parent,
+      lazy_abort_source& lazy_abort_source);
+
+    /// \brief Compress segment and upload it to S3
+    ///
+    /// The segment is compressed into independent zstd frames while it's
+    /// read (see compressed_segment.h). The compressed size is not known in
+    /// advance, so the object is uploaded using multipart upload with parts
+    /// of `part_size` bytes, or a single request if it fits into one part.
+    /// Every part is retried individually. The frame index is uploaded next
+    /// to the segment after the segment itself.
+    /// \param frame_size is an uncompressed size of the individual frame
+    /// \param part_size is a min size of the individual part
+    /// \param reset_str is a functor that returns an input_stream that returns
+    ///                  segment's data
+    ss::future<upload_result> upload_segment_compressed(
+      const s3::bucket_name& bucket,
+      const remote_segment_path& segment_path,
+      uint64_t frame_size,
+      uint64_t part_size,
+      const reset_input_stream& reset_str,
+      retry_chain_node& parent,
+      lazy_abort_source& lazy_abort_source);
+
     /// \brief Download segment from S3
     ///
     /// The method downloads the segment while tolerating some errors. It can
@@ -195,10 +270,44 @@ public:
     /// segment's data
     /// \param name is a segment's name in S3
     /// \param manifest is a manifest that should have the segment metadata
+    /// \param range is a range of bytes to download, the whole segment if not
+    ///        set
     ss::future<download_result> download_segment(
       const s3::bucket_name& bucket,
       const remote_segment_path& path,
       const try_consume_stream& cons_str,
+      retry_chain_node& parent,
+      std::optional<s3::byte_range> range = std::nullopt);
+
+    /// \brief Download the frame index of the compressed segment
+    ///
+    /// \param segment_path is a path of the compressed segment
+    /// \param index is an index to download
+    ss::future<download_result> download_frame_index(
+      const s3::bucket_name& bucket,
+      const remote_segment_path& segment_path,
+      segment_frame_index& index,
+      retry_chain_node& parent);
+
+    /// \brief Upload the offset index of the segment
+    ///
+    /// The index is uploaded next to the segment, see
+    /// generate_remote_index_path. It lets readers start at the chunk that
+    /// contains an offset instead of reading the segment from the start.
+    /// \param index is a serialized offset_index
+    ss::future<upload_result> upload_segment_index(
+      const s3::bucket_name& bucket,
+      const remote_segment_path& segment_path,
+      iobuf index,
+      retry_chain_node& parent);
+
+    /// \brief Download the offset index of the segment
+    ///
+    /// \param index is a serialized offset_index
+    ss::future<download_result> download_segment_index(
+      const s3::bucket_name& bucket,
+      const remote_segment_path& segment_path,
+      iobuf& index,
       retry_chain_node& parent);
 
     /// Checks if the segment exists in the bucket
@@ -207,13 +316,74 @@ public:
       const remote_segment_path& path,
       retry_chain_node& parent);
 
+    /// \brief Delete the object from the bucket
+    ///
+    /// Deleting an object that doesn't exist succeeds.
+    ss::future<upload_result> delete_object(
+      const s3::bucket_name& bucket,
+      const s3::object_key& path,
+      retry_chain_node& parent);
+
+    /// Units of the per shard budget of speculative segment downloads
+    struct prefetch_units {
+        ssx::semaphore_units downloads;
+        ssx::semaphore_units bytes;
+    };
+
+    /// \brief Reserve the prefetch budget for a download of `size_bytes`
+    ///
+    /// Prefetching is best effort, so instead of waiting for the budget the
+    /// method returns std::nullopt when it is exhausted. The download should
+    /// hold the units until it completes.
+    std::optional<prefetch_units> try_reserve_prefetch(size_t size_bytes);
+
 private:
     ss::future<> propagate_credentials(cloud_roles::credentials credentials);
+
+    /// Download the manifest, conditionally if 'etag' is set and not empty
+    ss::future<conditional_download_result> do_download_manifest(
+      const s3::bucket_name& bucket,
+      const remote_manifest_path& key,
+      base_manifest& manifest,
+      ss::sstring* etag,
+      retry_chain_node& parent);
+
+    /// Run a single request with retries. Returns nullopt if the request
+    /// can't be completed.
+    template<class T, class Func>
+    ss::future<std::optional<T>> retry_request(
+      const s3::bucket_name& bucket,
+      const s3::object_key& path,
+      retry_chain_node& parent,
+      Func request);
+    /// Send GET request using 'client'. If hedging is enabled and the
+    /// response headers are not received within the p99 GET latency, the
+    /// same request is sent using another connection and the first
+    /// successful response is used. The lease of the other connection is
+    /// stored in 'hedge' if its response is returned, it should be held
+    /// until the response body is consumed.
+    ss::future<http::client::response_stream_ref> hedged_get_object(
+      s3::client& client,
+      std::optional<s3::client_pool::client_lease>& hedge,
+      const s3::bucket_name& bucket,
+      const s3::object_key& path,
+      const ss::lowres_clock::duration& timeout,
+      std::optional<s3::byte_range> range);
+
+    /// Time after which a GET request is hedged, nullopt if the request
+    /// shouldn't be hedged
+    std::optional<std::chrono::microseconds> hedge_threshold() const;
+
     s3::client_pool _pool;
+    ss::shared_ptr<s3::client_probe> _s3_probe;
+    config::binding<bool> _hedge_get_requests;
     ss::gate _gate;
     ss::abort_source _as;
     remote_probe _probe;
     auth_refresh_bg_op _auth_refresh_bg_op;
+    ssx::semaphore _prefetch_downloads;
+    ssx::semaphore _prefetch_bytes;
+    size_t _prefetch_max_bytes;
 };
 
 } // namespace cloud_storage
@@ -14,6 +14,8 @@
 #include "cloud_storage/offset_translation_layer.h"
 #include "cloud_storage/remote_segment.h"
 #include "cloud_storage/types.h"
+#include "config/configuration.h"
+#include "ssx/future-util.h"
 #include "storage/parser_errc.h"
 #include "storage/types.h"
 #include "utils/gate_guard.h"
@@ -51,17 +53,6 @@ get_kafka_base_offset(const partition_manifest::segment_meta& m) {
                                                         : m.delta_offset;
     return m.base_offset - delta;
 }
-/// This function returns segment max offset as kafka offset
-static model::offset
-get_kafka_max_offset(const partition_manifest::segment_meta& m) {
-    // Manifests created with the old version of redpanda won't have the
-    // delta_offset field. In this case the value will be initialized to
-    // model::offset::min(). In this case offset translation couldn't be
-    // performed.
-    auto delta = m.delta_offset == model::offset::min() ? model::offset(0)
-                                                        : m.delta_offset;
-    return m.committed_offset - delta;
-}
 
 class partition_record_batch_reader_impl final
   : public model::record_batch_reader::impl {
@@ -111,7 +102,7 @@ public:
               "destruction");
 
             try {
-                _partition->return_reader(std::move(_reader), _it->second);
+                release_reader();
             } catch (...) {
                 // Failure to return the reader causes the reader destructor
                 // to execute synchronously inside this function.  That might
@@ -154,7 +145,7 @@ public:
                 // it on next itertaion
 
                 // The existing state have to be rebuilt
-                _partition->return_reader(std::move(_reader), _it->second);
+                release_reader();
                 _it = _end;
                 co_return storage_t{};
             }
@@ -204,6 +195,16 @@ public:
     }
 
 private:
+    /// Return the reader to the state of its segment, or evict it if the
+    /// segment was removed while the reader was in use
+    void release_reader() {
+        if (_it.is_dangling()) {
+            _partition->evict_reader(std::move(_reader));
+        } else {
+            _partition->return_reader(std::move(_reader), _it->second);
+        }
+    }
+
     // Initialize object using remote_partition as a source
     void initialize_reader_state(const storage::log_reader_config& config) {
         vlog(
@@ -240,6 +241,7 @@ private:
             it = std::prev(it);
         }
         auto reader = _partition->borrow_reader(config, it->first, it->second);
+        _partition->maybe_prefetch(it->first);
         // Here we know the exact type of the reader_state because of
         // the invariant of the borrow_reader
         const auto& segment
@@ -306,6 +308,7 @@ private:
                 vlog(_ctxlog.debug, "initializing new segment reader");
                 _reader = _partition->borrow_reader(
                   config, _it->first, _it->second);
+                _partition->maybe_prefetch(_it->first);
             }
         }
         vlog(
@@ -350,7 +353,9 @@ remote_partition::remote_partition(
   , _manifest(m)
   , _bucket(std::move(bucket))
   , _stm_jitter(stm_jitter_duration)
-  , _probe(m.get_ntp()) {}
+  , _probe(m.get_ntp())
+  , _prefetch_segments(
+      config::shard_local_cfg().cloud_storage_prefetch_segments.bind()) {}
 
 ss::future<> remote_partition::start() {
     update_segments_incrementally();
@@ -441,6 +446,60 @@ void remote_partition::gc_stale_materialized_segments(bool force_collection) {
     }
 }
 
+void remote_partition::maybe_prefetch(model::offset offset_key) {
+    const auto depth = _prefetch_segments();
+    if (depth == 0 || _gate.is_closed()) {
+        return;
+    }
+    auto it = _segments.upper_bound(offset_key);
+    for (size_t i = 0; i < depth && it != _segments.end(); ++i, ++it) {
+        if (!std::holds_alternative<offloaded_segment_state>(it->second)) {
+            // the segment is being read or was already prefetched
+            continue;
+        }
+        auto& off_state = std::get<offloaded_segment_state>(it->second);
+        auto meta = _manifest.find(off_state.base_rp_offset);
+        vassert(
+          meta != _manifest.end(),
+          "Can't find base offset {} in the manifest for ntp {}",
+          off_state.base_rp_offset,
+          _manifest.get_ntp());
+        auto size_bytes = meta->second.size_bytes;
+        if (auto chunk = config::shard_local_cfg()
+                           .cloud_storage_segment_chunk_size();
+            chunk && *chunk > 0) {
+            // chunked segments only get their first chunk prefetched
+            size_bytes = std::min(size_bytes, *chunk);
+        }
+        auto units = _api.try_reserve_prefetch(size_bytes);
+        if (!units) {
+            vlog(
+              _ctxlog.debug,
+              "prefetch budget exhausted, not prefetching segment {}",
+              it->first);
+            return;
+        }
+        vlog(_ctxlog.debug, "prefetching segment {}", it->first);
+        auto st = off_state.materialize(*this, it->first);
+        auto segment = st->segment;
+        it->second = std::move(st);
+        _probe.segment_prefetched();
+        // The segment is only offloaded once the download completes and the
+        // reference held here is released, the hydrated file stays in the
+        // cache until the reader reaches it.
+        ssx::spawn_with_gate(
+          _gate, [this, segment, units = std::move(*units)]() mutable {
+              auto f = segment->is_chunked() ? segment->hydrate_chunk(0)
+                                             : segment->hydrate();
+              return std::move(f)
+                .handle_exception([this](const std::exception_ptr& e) {
+                    vlog(_ctxlog.debug, "segment prefetch failed: {}", e);
+                })
+                .finally([segment, units = std::move(units)] {});
+          });
+    }
+}
+
 model::offset remote_partition::first_uploaded_offset() {
     vassert(
       _manifest.size() > 0,
@@ -485,19 +544,10 @@ remote_partition::get_term_last_offset(model::term_id term) const {
       "The manifest for {} is not expected to be empty",
       _manifest.get_ntp());
 
-    // look for first segment in next term, segments are sorted by base_offset
-    // and term
-    for (auto const& p : _manifest) {
-        if (p.first.term > term) {
-            return get_kafka_base_offset(p.second) - model::offset(1);
-        }
+    if (_offsets.is_stale(_manifest)) {
+        _offsets = offset_translation_table(_manifest);
     }
-    // if last segment term is equal to the one we look for return it
-    if (_manifest.rbegin()->first.term == term) {
-        return get_kafka_max_offset(_manifest.rbegin()->second);
-    }
-
-    return std::nullopt;
+    return _offsets.get_term_last_offset(term);
 }
 
 ss::future<std::vector<cluster::rm_stm::tx_range>>
@@ -624,6 +674,37 @@ void remote_partition::update_segments_incrementally() {
     }
 }
 
+void remote_partition::remove_stale_segments() {
+    _removed_segments = _manifest.removed_segments();
+    std::vector<model::offset> removed;
+    for (auto& [offset_key, st] : _segments) {
+        auto base = std::visit([](auto&& p) { return p->base_rp_offset; }, st);
+        auto it = _manifest.find(base);
+        if (it == _manifest.end()) {
+            removed.push_back(offset_key);
+            continue;
+        }
+        if (auto m = std::get_if<materialized_segment_ptr>(&st); m) {
+            if (
+              (*m)->segment->get_max_rp_offset()
+              != it->second.committed_offset) {
+                // replaced by a segment that starts at the same offset
+                st = (*m)->offload(this);
+            }
+        }
+    }
+    for (auto offset_key : removed) {
+        vlog(
+          _ctxlog.debug,
+          "Segment with kafka-offset {} was removed from the manifest",
+          offset_key);
+        auto it = _segments.find(offset_key);
+        std::visit([this](auto&& p) { p->offload(this); }, it->second);
+        _segments.erase(it);
+        _probe.segment_removed();
+    }
+}
+
 /// Materialize segment if needed and create a reader
 std::unique_ptr<remote_segment_batch_reader> remote_partition::borrow_reader(
   storage::log_reader_config config, model::offset key, segment_state& st) {
@@ -666,6 +747,9 @@ ss::future<storage::translating_reader> remote_partition::make_reader(
       "remote partition make_reader invoked, config: {}, num segments {}",
       config,
       _segments.size());
+    if (_removed_segments != _manifest.removed_segments()) {
+        remove_stale_segments();
+    }
     if (_segments.size() < static_cast<ssize_t>(_manifest.size())) {
         update_segments_incrementally();
     }
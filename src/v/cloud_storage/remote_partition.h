@@ -15,6 +15,7 @@
 #include "cloud_storage/remote.h"
 #include "cloud_storage/remote_segment.h"
 #include "cloud_storage/types.h"
+#include "config/property.h"
 #include "model/fundamental.h"
 #include "model/metadata.h"
 #include "s3/client.h"
@@ -48,7 +49,8 @@ namespace details {
 /// iterator stability guarantee by caching the key and
 /// doing a lookup on every increment.
 /// This turns iterator increment into O(logN) operation
-/// Deleting from underlying btree_map is not supported.
+/// If the element is deleted from the underlying btree_map the iterator
+/// can't be dereferenced but can still be incremented.
 template<class TKey, class TVal>
 class btree_map_stable_iterator
   : public boost::iterator_facade<
@@ -83,6 +85,11 @@ public:
         }
     }
 
+    /// True if the element the iterator points to was deleted
+    bool is_dangling() const {
+        return _key.has_value() && !_map.get().contains(*_key);
+    }
+
 private:
     friend class boost::iterator_core_access;
 
@@ -91,12 +98,8 @@ private:
     void increment() {
         vassert(
           _key.has_value(), "btree_map_stable_iterator can't be incremented");
-        auto it = _map.get().find(*_key);
-        // _key should be present since deletions are not supported
-        vassert(
-          it != _map.get().end(),
-          "btree_map_stable_iterator can't be incremented");
-        ++it;
+        // the element itself might have been deleted
+        auto it = _map.get().upper_bound(*_key);
         if (it == _map.get().end()) {
             set_end();
         } else {
@@ -107,7 +110,7 @@ private:
     // Decrement iterator if possible.
     // The _key will be set to prev element key.
     void decrement() {
-        auto it = _key ? _map.get().find(*_key) : _map.get().end();
+        auto it = _key ? _map.get().lower_bound(*_key) : _map.get().end();
         vassert(
           it != _map.get().begin(),
           "btree_map_stable_iterator can't be decremented");
@@ -123,6 +126,9 @@ private:
           "btree_map_stable_iterator doesn't point to an element and can't be "
           "dereferenced");
         auto it = _map.get().find(*_key);
+        vassert(
+          it != _map.get().end(),
+          "btree_map_stable_iterator points to a deleted element");
         return *it;
     }
 
@@ -210,11 +216,20 @@ private:
     /// Create new remote_segment instances for all new
     /// items in the manifest.
     void update_segments_incrementally();
+    /// Remove the segments that are no longer in the manifest and offload
+    /// the materialized segments that were replaced by another segment with
+    /// the same base offset.
+    void remove_stale_segments();
 
     ss::future<> run_eviction_loop();
 
     void gc_stale_materialized_segments(bool force_collection);
 
+    /// Hydrate the segments that follow the one at offset_key into the cache
+    /// in the background. Only offloaded segments are prefetched, and only
+    /// as long as the per shard prefetch budget of 'remote' allows.
+    void maybe_prefetch(model::offset offset_key);
+
     friend struct offloaded_segment_state;
 
     struct materialized_segment_state;
@@ -330,10 +345,15 @@ private:
     const partition_manifest& _manifest;
     s3::bucket_name _bucket;
 
-    // Deleting from _segments is not supported.
     // absl::btree_map doesn't provide a pointer stabilty. We are
     // using remote_partition::btree_map_stable_iterator to work around this.
+    // Segments are deleted when they are removed from the manifest.
     segment_map_t _segments;
+    // partition_manifest::removed_segments() when _segments was last updated
+    size_t _removed_segments{0};
+    // Lookup table of the kafka offsets of the manifest, rebuilt lazily
+    // when the manifest changes
+    mutable offset_translation_table _offsets;
     eviction_list_t _eviction_list;
     intrusive_list<
       materialized_segment_state,
@@ -344,6 +364,7 @@ private:
     ss::timer<ss::lowres_clock> _stm_timer;
     simple_time_jitter<ss::lowres_clock> _stm_jitter;
     partition_probe _probe;
+    config::binding<size_t> _prefetch_segments;
 };
 
 } // namespace cloud_storage
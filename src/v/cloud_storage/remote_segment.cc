@@ -32,6 +32,7 @@
 #include <seastar/core/circular_buffer.hh>
 #include <seastar/core/fstream.hh>
 #include <seastar/core/io_priority_class.hh>
+#include <seastar/core/iostream.hh>
 #include <seastar/core/loop.hh>
 #include <seastar/core/lowres_clock.hh>
 #include <seastar/core/queue.hh>
@@ -122,6 +123,16 @@ remote_segment::remote_segment(
     _max_rp_offset = meta->committed_offset;
     _base_offset_delta = std::clamp(
       meta->delta_offset, model::offset(0), model::offset::max());
+    _size_bytes = meta->size_bytes;
+    _is_compressed = meta->is_compressed;
+    _has_index = meta->has_index;
+
+    // Segments that fit into a single chunk are downloaded as a whole
+    auto chunk_size
+      = config::shard_local_cfg().cloud_storage_segment_chunk_size();
+    if (chunk_size && *chunk_size > 0 && _size_bytes > *chunk_size) {
+        _chunk_size = chunk_size;
+    }
 
     // run hydration loop in the background
     ssx::background = run_hydrate_bg();
@@ -187,6 +198,10 @@ ss::future<storage::segment_reader_handle>
 remote_segment::data_stream(size_t pos, ss::io_priority_class io_priority) {
     vlog(_ctxlog.debug, "remote segment file input stream at {}", pos);
     ss::gate::holder g(_gate);
+    if (is_chunked()) {
+        co_return storage::segment_reader_handle(
+          make_chunked_stream(pos, io_priority));
+    }
     co_await hydrate();
     ss::file_input_stream_options options{};
     options.buffer_size = config::shard_local_cfg().storage_read_buffer_size();
@@ -206,13 +221,34 @@ remote_segment::offset_data_stream(
       "remote segment file input stream at offset {}",
       kafka_offset);
     ss::gate::holder g(_gate);
-    co_await hydrate();
+    if (is_chunked()) {
+        // The index is cached if it was built by an earlier hydration of
+        // the whole segment, otherwise it's downloaded if it was uploaded
+        // with the segment. Without it the chunks are read from the start of
+        // the segment.
+        if (!_index_loaded) {
+            _index_loaded = true;
+            co_await maybe_materialize_index();
+            if (!_index) {
+                co_await maybe_download_index();
+            }
+        }
+    } else {
+        co_await hydrate();
+    }
     auto pos = maybe_get_offsets(kafka_offset)
                  .value_or(offset_index::find_result{
                    .rp_offset = _base_rp_offset,
                    .kaf_offset = _base_rp_offset - _base_offset_delta,
                    .file_pos = 0,
                  });
+    if (is_chunked()) {
+        co_return input_stream_with_offsets{
+          .stream = make_chunked_stream(pos.file_pos, io_priority),
+          .rp_offset = pos.rp_offset,
+          .kafka_offset = pos.kaf_offset,
+        };
+    }
     ss::file_input_stream_options options{};
     options.buffer_size = config::shard_local_cfg().storage_read_buffer_size();
     options.read_ahead
@@ -247,10 +283,60 @@ remote_segment::maybe_get_offsets(model::offset kafka_offset) {
     return pos;
 }
 
+ss::future<> remote_segment::load_frame_index() {
+    auto units = co_await ss::get_units(_frame_index_lock, 1);
+    if (_frame_index) {
+        co_return;
+    }
+    retry_chain_node local_rtc(
+      cache_hydration_timeout, cache_hydration_backoff, &_rtc);
+    segment_frame_index index;
+    auto res = co_await _api.download_frame_index(
+      _bucket, _path, index, local_rtc);
+    const auto path = generate_remote_frame_index_path(_path);
+    if (res != download_result::success) {
+        vlog(
+          _ctxlog.debug,
+          "Failed to download frame index {} of a compressed segment, {}",
+          path,
+          res);
+        throw download_exception(res, path);
+    }
+    if (index.size_bytes != _size_bytes || index.num_frames() == 0) {
+        throw remote_segment_exception(fmt::format(
+          "Frame index {} doesn't match the segment, segment size: {}, "
+          "indexed size: {}, frames: {}",
+          path,
+          _size_bytes,
+          index.size_bytes,
+          index.num_frames()));
+    }
+    _frame_index = std::move(index);
+}
+
 ss::future<> remote_segment::do_hydrate_segment() {
-    auto callback = [this](
+    std::vector<uint64_t> frame_sizes;
+    if (_is_compressed) {
+        co_await load_frame_index();
+        frame_sizes = _frame_index->frame_sizes(
+          0, _frame_index->num_frames() - 1);
+    }
+    if (_has_index && !_index) {
+        co_await maybe_download_index();
+    }
+    auto callback = [this, &frame_sizes](
                       uint64_t size_bytes,
                       ss::input_stream<char> s) -> ss::future<uint64_t> {
+        if (_is_compressed) {
+            s = make_frame_decompression_stream(
+              std::move(s), frame_sizes, 0, _size_bytes);
+        }
+        if (_index) {
+            // the index was uploaded with the segment, no need to scan it
+            co_await _cache.put(_path, s).finally(
+              [&s] { return s.close(); });
+            co_return size_bytes;
+        }
         offset_index tmpidx(
           get_base_rp_offset(),
           get_base_kafka_offset(),
@@ -288,7 +374,8 @@ ss::future<> remote_segment::do_hydrate_segment() {
         }
         if (index_prepared) {
             auto index_stream = make_iobuf_input_stream(tmpidx.to_iobuf());
-            co_await _cache.put(_path().native() + ".index", index_stream);
+            co_await _cache.put(
+              generate_remote_index_path(_path)(), index_stream);
             _index = std::move(tmpidx);
         }
         co_return size_bytes;
@@ -420,9 +507,52 @@ ss::future<bool> remote_segment::do_materialize_txrange() {
     co_return true;
 }
 
+ss::future<> remote_segment::maybe_download_index() {
+    ss::gate::holder guard(_gate);
+    retry_chain_node local_rtc(
+      cache_hydration_timeout, cache_hydration_backoff, &_rtc);
+    iobuf buf;
+    auto res = co_await _api.download_segment_index(
+      _bucket, _path, buf, local_rtc);
+    if (res != download_result::success) {
+        vlog(
+          _ctxlog.debug, "Index of segment {} not downloaded: {}", _path, res);
+        co_return;
+    }
+    offset_index ix(
+      _base_rp_offset,
+      _base_rp_offset - _base_offset_delta,
+      0,
+      remote_segment_sampling_step_bytes);
+    try {
+        ix.from_iobuf(buf.copy());
+    } catch (...) {
+        vlog(
+          _ctxlog.warn,
+          "Failed to parse index of segment {}. Error: {}",
+          _path,
+          std::current_exception());
+        co_return;
+    }
+    _index = std::move(ix);
+
+    // Cached for the next materialization of the segment
+    auto index_stream = make_iobuf_input_stream(std::move(buf));
+    try {
+        co_await _cache.put(generate_remote_index_path(_path)(), index_stream);
+    } catch (...) {
+        vlog(
+          _ctxlog.warn,
+          "Failed to cache index of segment {}. Error: {}",
+          _path,
+          std::current_exception());
+    }
+    co_await index_stream.close();
+}
+
 ss::future<> remote_segment::maybe_materialize_index() {
     ss::gate::holder guard(_gate);
-    auto path = _path().native() + ".index";
+    auto path = generate_remote_index_path(_path)();
     offset_index ix(
       _base_rp_offset,
       _base_rp_offset - _base_offset_delta,
@@ -638,7 +768,11 @@ ss::future<> remote_segment::hydrate() {
 
 ss::future<std::vector<cluster::rm_stm::tx_range>>
 remote_segment::aborted_transactions(model::offset from, model::offset to) {
-    co_await hydrate();
+    if (is_chunked()) {
+        co_await hydrate_txrange();
+    } else {
+        co_await hydrate();
+    }
     std::vector<cluster::rm_stm::tx_range> result;
     if (!_tx_range) {
         // We got NoSuchKey when we tried to download the
@@ -665,6 +799,207 @@ remote_segment::aborted_transactions(model::offset from, model::offset to) {
     co_return result;
 }
 
+std::filesystem::path remote_segment::chunk_path(size_t chunk_start) const {
+    return std::filesystem::path(
+      ssx::sformat("{}.chunks/{}", _path().native(), chunk_start));
+}
+
+ss::future<> remote_segment::do_hydrate_chunk(size_t chunk_start) {
+    ss::gate::holder guard(_gate);
+    const auto chunk_end = std::min(chunk_start + *_chunk_size, _size_bytes);
+    const auto path = chunk_path(chunk_start);
+    // Compressed chunk is assembled from the frames that overlap it
+    auto range = s3::byte_range{.first = chunk_start, .last = chunk_end - 1};
+    std::vector<uint64_t> frame_sizes;
+    uint64_t skip = 0;
+    if (_is_compressed) {
+        co_await load_frame_index();
+        auto frames = _frame_index->find(range.first, range.last);
+        range = frames.bytes;
+        frame_sizes = _frame_index->frame_sizes(
+          frames.first_frame, frames.last_frame);
+        skip = frames.skip;
+    }
+    auto callback = [this, &path, &frame_sizes, skip, chunk_start, chunk_end](
+                      uint64_t size_bytes,
+                      ss::input_stream<char> s) -> ss::future<uint64_t> {
+        if (_is_compressed) {
+            s = make_frame_decompression_stream(
+              std::move(s), frame_sizes, skip, chunk_end - chunk_start);
+        }
+        co_await _cache.put(path, s).finally([&s] { return s.close(); });
+        co_return size_bytes;
+    };
+
+    retry_chain_node local_rtc(
+      cache_hydration_timeout, cache_hydration_backoff, &_rtc);
+
+    vlog(
+      _ctxlog.debug,
+      "Hydrating chunk {}-{} of segment {}",
+      chunk_start,
+      chunk_end,
+      _path);
+    auto res = co_await _api.download_segment(
+      _bucket, _path, callback, local_rtc, range);
+
+    if (res != download_result::success) {
+        vlog(
+          _ctxlog.debug,
+          "Failed to hydrate chunk {} of segment {}, {}",
+          chunk_start,
+          _path,
+          res);
+        throw download_exception(res, path);
+    }
+}
+
+ss::future<> remote_segment::hydrate_chunk(size_t pos) {
+    vassert(is_chunked(), "Segment {} is not chunked", _path);
+    ss::gate::holder guard(_gate);
+    const auto chunk_start = pos - pos % *_chunk_size;
+    if (
+      co_await _cache.is_cached(chunk_path(chunk_start))
+      == cache_element_status::available) {
+        co_return;
+    }
+    // The first fiber that needs the chunk downloads it, the others wait for
+    // the result.
+    auto [it, inserted] = _chunk_downloads.try_emplace(chunk_start);
+    if (!inserted) {
+        co_await it->second.get_shared_future();
+        co_return;
+    }
+    std::exception_ptr err;
+    try {
+        co_await do_hydrate_chunk(chunk_start);
+    } catch (...) {
+        err = std::current_exception();
+    }
+    auto node = _chunk_downloads.extract(chunk_start);
+    if (err) {
+        node.mapped().set_exception(err);
+        std::rethrow_exception(err);
+    }
+    node.mapped().set_value();
+}
+
+ss::future<ss::input_stream<char>>
+remote_segment::chunk_stream(size_t pos, ss::io_priority_class io_priority) {
+    ss::gate::holder guard(_gate);
+    const auto chunk_start = pos - pos % *_chunk_size;
+    const auto path = chunk_path(chunk_start);
+    auto item = co_await _cache.get(path);
+    if (!item) {
+        co_await hydrate_chunk(pos);
+        item = co_await _cache.get(path);
+    }
+    if (!item) {
+        // Same as for the whole segment, the chunk could be evicted right
+        // after the hydration. The reader will retry.
+        throw remote_segment_exception(fmt::format(
+          "Chunk {} of segment {} was evicted from cache", chunk_start, _path));
+    }
+    ss::file_input_stream_options options{};
+    options.buffer_size = config::shard_local_cfg().storage_read_buffer_size();
+    options.read_ahead
+      = config::shard_local_cfg().storage_read_readahead_count();
+    options.io_priority_class = io_priority;
+    co_return ss::make_file_input_stream(
+      item->body, pos - chunk_start, std::move(options));
+}
+
+/// Data source that reads a chunked segment from a file position till the
+/// end of the segment. Every chunk is hydrated when the source reaches it,
+/// so a reader that stops early doesn't download the rest of the segment.
+class chunked_segment_data_source final : public ss::data_source_impl {
+public:
+    chunked_segment_data_source(
+      remote_segment& segment, size_t pos, ss::io_priority_class io_priority)
+      : _segment(segment)
+      , _pos(pos)
+      , _io_priority(io_priority) {}
+
+    ss::future<ss::temporary_buffer<char>> get() override {
+        while (_pos < _segment._size_bytes) {
+            bool opened = false;
+            if (!_stream) {
+                _stream = co_await _segment.chunk_stream(_pos, _io_priority);
+                opened = true;
+            }
+            auto buf = co_await _stream->read();
+            if (!buf.empty()) {
+                _pos += buf.size();
+                co_return buf;
+            }
+            if (opened) {
+                throw remote_segment_exception(fmt::format(
+                  "Chunk of segment {} at position {} is empty",
+                  _segment._path,
+                  _pos));
+            }
+            // end of chunk, continue with the next one
+            co_await close_stream();
+        }
+        co_return ss::temporary_buffer<char>();
+    }
+
+    ss::future<> close() override { return close_stream(); }
+
+private:
+    ss::future<> close_stream() {
+        if (!_stream) {
+            return ss::now();
+        }
+        return _stream->close().finally([this] { _stream = std::nullopt; });
+    }
+
+    remote_segment& _segment;
+    size_t _pos;
+    ss::io_priority_class _io_priority;
+    std::optional<ss::input_stream<char>> _stream;
+};
+
+ss::input_stream<char> remote_segment::make_chunked_stream(
+  size_t pos, ss::io_priority_class io_priority) {
+    return ss::input_stream<char>(ss::data_source(
+      std::make_unique<chunked_segment_data_source>(*this, pos, io_priority)));
+}
+
+ss::future<> remote_segment::do_load_txrange() {
+    auto status = co_await _cache.is_cached(generate_remote_tx_path(_path));
+    if (
+      status == cache_element_status::available
+      && co_await do_materialize_txrange()) {
+        co_return;
+    }
+    co_await do_hydrate_txrange();
+}
+
+ss::future<> remote_segment::hydrate_txrange() {
+    ss::gate::holder guard(_gate);
+    if (_tx_range) {
+        co_return;
+    }
+    if (_txrange_hydration) {
+        co_await _txrange_hydration->get_shared_future();
+        co_return;
+    }
+    _txrange_hydration.emplace();
+    std::exception_ptr err;
+    try {
+        co_await do_load_txrange();
+    } catch (...) {
+        err = std::current_exception();
+    }
+    auto done = std::exchange(_txrange_hydration, std::nullopt);
+    if (err) {
+        done->set_exception(err);
+        std::rethrow_exception(err);
+    }
+    done->set_value();
+}
+
 /// Batch consumer that connects to remote_segment_batch_reader.
 /// It also does offset translation based on incomplete data in
 /// manifests.
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "cloud_storage/cache_service.h"
+#include "cloud_storage/compressed_segment.h"
 #include "cloud_storage/logger.h"
 #include "cloud_storage/partition_manifest.h"
 #include "cloud_storage/partition_probe.h"
@@ -21,6 +22,7 @@
 #include "model/fundamental.h"
 #include "model/record.h"
 #include "s3/client.h"
+#include "ssx/semaphore.h"
 #include "storage/parser.h"
 #include "storage/segment_reader.h"
 #include "storage/translating_reader.h"
@@ -31,9 +33,12 @@
 #include <seastar/core/condition-variable.hh>
 #include <seastar/core/expiring_fifo.hh>
 #include <seastar/core/io_priority_class.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/temporary_buffer.hh>
 
+#include <absl/container/flat_hash_map.h>
+
 namespace cloud_storage {
 
 static constexpr size_t remote_segment_sampling_step_bytes = 64_KiB;
@@ -54,7 +59,11 @@ public:
       : std::runtime_error(m) {}
 };
 
+class chunked_segment_data_source;
+
 class remote_segment final {
+    friend class chunked_segment_data_source;
+
 public:
     remote_segment(
       remote& r,
@@ -115,9 +124,19 @@ public:
     /// Hydrate the segment
     ss::future<> hydrate();
 
+    /// True if the segment is hydrated in chunks using range reads instead
+    /// of being downloaded as a whole
+    bool is_chunked() const noexcept { return _chunk_size.has_value(); }
+
+    /// Hydrate the chunk that contains file position 'pos', the segment has
+    /// to be chunked
+    ss::future<> hydrate_chunk(size_t pos);
+
     retry_chain_node* get_retry_chain_node() { return &_rtc; }
 
-    bool download_in_progress() const noexcept { return !_wait_list.empty(); }
+    bool download_in_progress() const noexcept {
+        return !_wait_list.empty() || !_chunk_downloads.empty();
+    }
 
     /// Return aborted transactions metadata associated with the segment
     ///
@@ -140,7 +159,9 @@ private:
     ss::future<> run_hydrate_bg();
 
     /// Actually hydrate the segment. The method downloads the segment file
-    /// to the cache dir and updates the segment index.
+    /// to the cache dir and updates the segment index. The index uploaded
+    /// with the segment is downloaded first, the segment is only scanned to
+    /// build the index if there is none.
     ss::future<> do_hydrate_segment();
     /// Hydrate tx manifest. Method downloads the manifest file to the cache
     /// dir.
@@ -153,6 +174,31 @@ private:
 
     /// Load segment index from file (if available)
     ss::future<> maybe_materialize_index();
+    /// Download the segment index uploaded with the segment (if available)
+    /// and cache it
+    ss::future<> maybe_download_index();
+
+    /// Cache key of the chunk that starts at file position 'chunk_start'
+    std::filesystem::path chunk_path(size_t chunk_start) const;
+    /// Download the chunk that starts at file position 'chunk_start' to the
+    /// cache dir using a range read.
+    ss::future<> do_hydrate_chunk(size_t chunk_start);
+    /// Hydrate the chunk that contains file position 'pos' if needed and
+    /// return a stream that reads the segment from 'pos' till the end of the
+    /// chunk.
+    ss::future<ss::input_stream<char>>
+    chunk_stream(size_t pos, ss::io_priority_class);
+    /// Create a stream reading the chunked segment from file position 'pos'.
+    /// The chunks are hydrated as the stream reaches them.
+    ss::input_stream<char>
+    make_chunked_stream(size_t pos, ss::io_priority_class);
+    /// Hydrate and materialize only the tx manifest, used instead of the
+    /// segment hydration loop when the segment is chunked.
+    ss::future<> hydrate_txrange();
+    ss::future<> do_load_txrange();
+    /// Download the frame index of the compressed segment if it's not
+    /// loaded yet.
+    ss::future<> load_frame_index();
 
     ss::gate _gate;
     remote& _api;
@@ -181,6 +227,18 @@ private:
 
     using tx_range_vec = fragmented_vector<cluster::rm_stm::tx_range>;
     std::optional<tx_range_vec> _tx_range;
+
+    size_t _size_bytes{0};
+    std::optional<size_t> _chunk_size;
+    /// Chunk hydrations in progress, keyed by chunk start position
+    absl::flat_hash_map<size_t, ss::shared_promise<>> _chunk_downloads;
+    std::optional<ss::shared_promise<>> _txrange_hydration;
+    bool _index_loaded{false};
+    bool _is_compressed{false};
+    /// The offset index was uploaded with the segment
+    bool _has_index{false};
+    std::optional<segment_frame_index> _frame_index;
+    ssx::semaphore _frame_index_lock{1, "cst/frame_index"};
 };
 
 class remote_segment_batch_consumer;
@@ -312,4 +312,8 @@ void remote_segment_index_builder::print(std::ostream& o) const {
     o << "remote_segment_index_builder";
 }
 
+remote_segment_path generate_remote_index_path(const remote_segment_path& p) {
+    return remote_segment_path(fmt::format("{}.index", p().native()));
+}
+
 } // namespace cloud_storage
@@ -12,6 +12,7 @@
 
 #include "bytes/iobuf.h"
 #include "bytes/iobuf_parser.h"
+#include "cloud_storage/types.h"
 #include "model/fundamental.h"
 #include "seastarx.h"
 #include "storage/parser.h"
@@ -180,6 +181,10 @@ private:
     size_t _sampling_step;
 };
 
+/// Path of the offset index uploaded next to the segment, the same path is
+/// used as the cache key of the index
+remote_segment_path generate_remote_index_path(const remote_segment_path& p);
+
 inline ss::lw_shared_ptr<storage::continuous_batch_parser>
 make_remote_segment_index_builder(
   ss::input_stream<char> stream,
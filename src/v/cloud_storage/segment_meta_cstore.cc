@@ -0,0 +1,141 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/redpanda-data/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "cloud_storage/segment_meta_cstore.h"
+
+#include "vassert.h"
+
+namespace cloud_storage {
+
+/// Same as get_kafka_base_offset in remote_partition, manifests created by
+/// the old version of redpanda don't have the delta offset
+static int64_t kafka_offset(int64_t rp_offset, int64_t delta) {
+    return delta == model::offset::min()() ? rp_offset : rp_offset - delta;
+}
+
+segment_meta_cstore::segment_meta_cstore()
+  : _base_offset(delta_delta_t(0))
+  , _committed_offset(delta_xor_t{})
+  , _delta_offset(delta_xor_t{})
+  , _term(delta_xor_t{})
+  , _base_timestamp(delta_xor_t{})
+  , _max_timestamp(delta_xor_t{})
+  , _size_bytes(delta_xor_t{})
+  , _is_compacted(delta_xor_t{})
+  , _ntp_revision(delta_xor_t{})
+  , _archiver_term(delta_xor_t{})
+  , _is_compressed(delta_xor_t{})
+  , _has_index(delta_xor_t{})
+  , _is_merged(delta_xor_t{}) {}
+
+void segment_meta_cstore::append(const key& k, const segment_meta& meta) {
+    vassert(
+      _size == 0 || meta.base_offset >= _last_base_offset,
+      "Segment base offset {} is smaller than the previous one {}",
+      meta.base_offset,
+      _last_base_offset);
+    _base_offset.append(meta.base_offset(), _size);
+    _committed_offset.append(meta.committed_offset(), _size);
+    _delta_offset.append(meta.delta_offset(), _size);
+    _term.append(k.term(), _size);
+    _base_timestamp.append(meta.base_timestamp.value(), _size);
+    _max_timestamp.append(meta.max_timestamp.value(), _size);
+    _size_bytes.append(static_cast<int64_t>(meta.size_bytes), _size);
+    _is_compacted.append(meta.is_compacted ? 1 : 0, _size);
+    _ntp_revision.append(meta.ntp_revision(), _size);
+    _archiver_term.append(meta.archiver_term(), _size);
+    _is_compressed.append(meta.is_compressed ? 1 : 0, _size);
+    _has_index.append(meta.has_index ? 1 : 0, _size);
+    _is_merged.append(meta.is_merged ? 1 : 0, _size);
+    _last_base_offset = meta.base_offset;
+    _size++;
+}
+
+segment_meta_cstore
+segment_meta_cstore::from_manifest(const partition_manifest& m) {
+    segment_meta_cstore store;
+    for (const auto& [k, meta] : m) {
+        store.append(k, meta);
+    }
+    return store;
+}
+
+std::pair<segment_meta_cstore::key, segment_meta_cstore::segment_meta>
+segment_meta_cstore::at(size_t ix) {
+    vassert(ix < _size, "Index {} is out of range, size: {}", ix, _size);
+    auto base_offset = model::offset(_base_offset.at(ix, _size));
+    return {
+      key{
+        .base_offset = base_offset,
+        .term = model::term_id(_term.at(ix, _size)),
+      },
+      segment_meta{
+        .is_compacted = _is_compacted.at(ix, _size) != 0,
+        .size_bytes = static_cast<size_t>(_size_bytes.at(ix, _size)),
+        .base_offset = base_offset,
+        .committed_offset = model::offset(_committed_offset.at(ix, _size)),
+        .base_timestamp = model::timestamp(_base_timestamp.at(ix, _size)),
+        .max_timestamp = model::timestamp(_max_timestamp.at(ix, _size)),
+        .delta_offset = model::offset(_delta_offset.at(ix, _size)),
+        .ntp_revision = model::initial_revision_id(
+          _ntp_revision.at(ix, _size)),
+        .archiver_term = model::term_id(_archiver_term.at(ix, _size)),
+        .is_compressed = _is_compressed.at(ix, _size) != 0,
+        .has_index = _has_index.at(ix, _size) != 0,
+        .is_merged = _is_merged.at(ix, _size) != 0,
+      }};
+}
+
+std::optional<size_t>
+segment_meta_cstore::lower_bound_kafka_offset(model::offset o) {
+    auto committed = _committed_offset.make_cursor(_size);
+    auto delta = _delta_offset.make_cursor(_size);
+    std::array<int64_t, buffer_depth> committed_row{};
+    std::array<int64_t, buffer_depth> delta_row{};
+    size_t base = 0;
+    while (auto n = committed.next(committed_row)) {
+        delta.next(delta_row);
+        for (size_t i = 0; i < n; i++) {
+            if (kafka_offset(committed_row.at(i), delta_row.at(i)) >= o()) {
+                return base + i;
+            }
+        }
+        base += n;
+    }
+    return std::nullopt;
+}
+
+std::optional<size_t>
+segment_meta_cstore::lower_bound_timestamp(model::timestamp t) {
+    auto max_ts = _max_timestamp.make_cursor(_size);
+    std::array<int64_t, buffer_depth> row{};
+    size_t base = 0;
+    while (auto n = max_ts.next(row)) {
+        for (size_t i = 0; i < n; i++) {
+            if (row.at(i) >= t.value()) {
+                return base + i;
+            }
+        }
+        base += n;
+    }
+    return std::nullopt;
+}
+
+size_t segment_meta_cstore::memory_usage() {
+    return _base_offset.memory_usage() + _committed_offset.memory_usage()
+           + _delta_offset.memory_usage() + _term.memory_usage()
+           + _base_timestamp.memory_usage() + _max_timestamp.memory_usage()
+           + _size_bytes.memory_usage() + _is_compacted.memory_usage()
+           + _ntp_revision.memory_usage() + _archiver_term.memory_usage()
+           + _is_compressed.memory_usage() + _has_index.memory_usage()
+           + _is_merged.memory_usage();
+}
+
+} // namespace cloud_storage
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/redpanda-data/redpanda/blob/master/licenses/rcl.md
+ */
+
+#pragma once
+
+#include "cloud_storage/partition_manifest.h"
+#include "model/fundamental.h"
+#include "model/timestamp.h"
+#include "seastarx.h"
+#include "utils/delta_for.h"
+
+#include <array>
+#include <optional>
+
+namespace cloud_storage {
+
+/// Columnar storage of the segment metadata
+///
+/// Every field of the partition_manifest::segment_meta (and the term of
+/// the segment key) is stored in a separate delta-FOR encoded column.
+/// Segments are appended in base offset order, which is the order in
+/// which the archiver uploads them, so the offset columns are non-decreasing
+/// and compress to a few bits per segment.
+///
+/// Like the offset_index, the most recent values are kept in a write buffer
+/// until a full row can be encoded, and the search is linear. The scan
+/// decodes only the columns needed by the query, row by row.
+class segment_meta_cstore {
+    static constexpr uint32_t buffer_depth = details::FOR_buffer_depth;
+
+public:
+    using key = partition_manifest::key;
+    using segment_meta = partition_manifest::segment_meta;
+
+    segment_meta_cstore();
+
+    /// Add segment to the store. The base offset of the segment can't be
+    /// smaller than the base offset of the previously added segment.
+    void append(const key& k, const segment_meta& meta);
+
+    /// Create a store that contains all segments of the manifest
+    static segment_meta_cstore from_manifest(const partition_manifest& m);
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    /// Get segment by index
+    std::pair<key, segment_meta> at(size_t ix);
+
+    /// Find first segment that contains the kafka offset or any larger
+    /// offset, i.e. the first segment whose last kafka offset is not less
+    /// than 'o'. Returns index of the segment or nullopt if all segments
+    /// are below 'o'.
+    std::optional<size_t> lower_bound_kafka_offset(model::offset o);
+
+    /// Find first segment whose max timestamp is not less than 't'.
+    /// Returns index of the segment or nullopt if all segments are
+    /// older than 't'.
+    std::optional<size_t> lower_bound_timestamp(model::timestamp t);
+
+    /// Memory used by the encoded columns
+    size_t memory_usage();
+
+private:
+    template<class DeltaStep>
+    class column {
+    public:
+        using row_t = std::array<int64_t, buffer_depth>;
+
+        explicit column(DeltaStep delta)
+          : _encoder(0, delta)
+          , _delta(delta) {}
+
+        void append(int64_t value, size_t pos) {
+            _buffer.at(pos % buffer_depth) = value;
+            if ((pos + 1) % buffer_depth == 0) {
+                _encoder.add(_buffer);
+            }
+        }
+
+        size_t memory_usage() {
+            return _encoder.share().size_bytes() + sizeof(*this);
+        }
+
+        /// Sequential reader of the column, returns encoded rows followed by
+        /// the partially filled write buffer
+        class cursor {
+        public:
+            cursor(column& c, size_t size)
+              : _decoder(
+                0, c._encoder.get_row_count(), c._encoder.share(), c._delta)
+              , _tail(c._buffer)
+              , _tail_size(size % buffer_depth) {}
+
+            /// Read next row, return number of valid values in the row,
+            /// zero if there are no more values.
+            size_t next(row_t& row) {
+                row = {};
+                if (_decoder.read(row)) {
+                    return buffer_depth;
+                }
+                if (_tail_read) {
+                    return 0;
+                }
+                _tail_read = true;
+                row = _tail;
+                return _tail_size;
+            }
+
+        private:
+            deltafor_decoder<int64_t, DeltaStep> _decoder;
+            row_t _tail;
+            size_t _tail_size;
+            bool _tail_read{false};
+        };
+
+        cursor make_cursor(size_t size) { return cursor(*this, size); }
+
+        /// Get value by index
+        int64_t at(size_t ix, size_t size) {
+            auto c = make_cursor(size);
+            row_t row{};
+            for (size_t n = ix / buffer_depth; n > 0; n--) {
+                c.next(row);
+            }
+            c.next(row);
+            return row.at(ix % buffer_depth);
+        }
+
+    private:
+        deltafor_encoder<int64_t, DeltaStep> _encoder;
+        row_t _buffer{};
+        DeltaStep _delta;
+    };
+
+    using delta_xor_t = details::delta_xor;
+    using delta_delta_t = details::delta_delta<int64_t>;
+
+    size_t _size{0};
+    model::offset _last_base_offset;
+    column<delta_delta_t> _base_offset;
+    column<delta_xor_t> _committed_offset;
+    column<delta_xor_t> _delta_offset;
+    column<delta_xor_t> _term;
+    column<delta_xor_t> _base_timestamp;
+    column<delta_xor_t> _max_timestamp;
+    column<delta_xor_t> _size_bytes;
+    column<delta_xor_t> _is_compacted;
+    column<delta_xor_t> _ntp_revision;
+    column<delta_xor_t> _archiver_term;
+    column<delta_xor_t> _is_compressed;
+    column<delta_xor_t> _has_index;
+    column<delta_xor_t> _is_merged;
+};
+
+} // namespace cloud_storage
@@ -11,7 +11,9 @@
 #include "bytes/iobuf.h"
 #include "cache_test_fixture.h"
 #include "cloud_storage/access_time_tracker.h"
+#include "cloud_storage/cache_index.h"
 #include "cloud_storage/cache_service.h"
+#include "config/configuration.h"
 #include "test_utils/fixture.h"
 #include "units.h"
 
@@ -151,6 +153,40 @@ FIXTURE_TEST(
     BOOST_REQUIRE(ss::file_exists((CACHE_DIR / KEY2).native()).get());
 }
 
+FIXTURE_TEST(frequently_read_file_not_deleted, cache_test_fixture) {
+    auto data_string1 = create_data_string('a', 1_MiB + 1_KiB);
+    put_into_cache(data_string1, KEY);
+    for (int i = 0; i < 3; i++) {
+        auto item = sharded_cache.local().get(KEY).get();
+        BOOST_REQUIRE(item.has_value());
+        item->body.close().get();
+    }
+    auto data_string2 = create_data_string('b', 1_MiB + 1_KiB);
+    put_into_cache(data_string2, KEY2);
+
+    ss::sleep(ss::lowres_clock::duration(2s)).get();
+
+    // KEY2 is newer but KEY was read more often
+    BOOST_CHECK_EQUAL(1_MiB + 1_KiB, sharded_cache.local().get_total_cleaned());
+    BOOST_REQUIRE(ss::file_exists((CACHE_DIR / KEY).native()).get());
+    BOOST_REQUIRE(!ss::file_exists((CACHE_DIR / KEY2).native()).get());
+}
+
+FIXTURE_TEST(invalidated_file_not_counted, cache_test_fixture) {
+    auto data_string1 = create_data_string('a', 1_MiB + 1_KiB);
+    put_into_cache(data_string1, KEY);
+    ss::sleep(ss::lowres_clock::duration(1s)).get();
+    sharded_cache.local().invalidate(KEY).get();
+
+    auto data_string2 = create_data_string('b', 1_MiB + 1_KiB);
+    put_into_cache(data_string2, KEY2);
+
+    ss::sleep(ss::lowres_clock::duration(2s)).get();
+
+    BOOST_CHECK_EQUAL(0, sharded_cache.local().get_total_cleaned());
+    BOOST_REQUIRE(ss::file_exists((CACHE_DIR / KEY2).native()).get());
+}
+
 FIXTURE_TEST(cannot_put_tmp_file, cache_test_fixture) {
     auto data_string1 = create_data_string('a', 1_KiB);
     BOOST_CHECK_THROW(
@@ -369,3 +405,111 @@ SEASTAR_THREAD_TEST_CASE(test_access_time_tracker_serializer) {
         BOOST_REQUIRE(ts.value() >= timestamps[i]);
     }
 }
+
+SEASTAR_THREAD_TEST_CASE(test_cache_index_eviction_order) {
+    cache_index index;
+    auto no_skip = [](std::string_view) { return false; };
+
+    index.put("a", 100);
+    index.put("b", 100);
+    index.put("c", 100);
+    BOOST_REQUIRE_EQUAL(index.size_bytes(), 300);
+
+    // equal access counts are evicted in LRU order
+    auto candidates = index.eviction_candidates(150, no_skip);
+    BOOST_REQUIRE_EQUAL(candidates.size(), 2);
+    BOOST_REQUIRE_EQUAL(candidates[0].path, "a");
+    BOOST_REQUIRE_EQUAL(candidates[1].path, "b");
+
+    // frequently used file outranks more recent ones
+    index.touch("a");
+    index.touch("a");
+    BOOST_REQUIRE_EQUAL(index.hits("a"), 3);
+    candidates = index.eviction_candidates(200, no_skip);
+    BOOST_REQUIRE_EQUAL(candidates.size(), 2);
+    BOOST_REQUIRE_EQUAL(candidates[0].path, "b");
+    BOOST_REQUIRE_EQUAL(candidates[1].path, "c");
+
+    candidates = index.eviction_candidates(
+      100, [](std::string_view p) { return p == "b"; });
+    BOOST_REQUIRE_EQUAL(candidates.size(), 1);
+    BOOST_REQUIRE_EQUAL(candidates[0].path, "c");
+
+    // overwrite updates the size
+    BOOST_REQUIRE_EQUAL(index.put("c", 50), 100);
+    BOOST_REQUIRE_EQUAL(index.size_bytes(), 250);
+
+    BOOST_REQUIRE_EQUAL(index.remove("c").value(), 50);
+    BOOST_REQUIRE(!index.remove("c").has_value());
+    BOOST_REQUIRE_EQUAL(index.size(), 2);
+    BOOST_REQUIRE_EQUAL(index.size_bytes(), 200);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_cache_index_aging) {
+    cache_index index;
+    auto no_skip = [](std::string_view) { return false; };
+
+    // 'old' was popular in the past
+    index.put("old", 100);
+    for (int i = 0; i < 4; i++) {
+        index.touch("old");
+    }
+
+    // every eviction ages the index, new files accessed twice reach the
+    // priority of 'old' after a few evictions
+    for (int i = 0; i < 4; i++) {
+        auto name = fmt::format("scan-{}", i);
+        index.put(name, 100);
+        auto candidates = index.eviction_candidates(100, no_skip);
+        BOOST_REQUIRE_EQUAL(candidates.size(), 1);
+        BOOST_REQUIRE_EQUAL(candidates[0].path, name);
+        BOOST_REQUIRE_EQUAL(index.evict(name).value(), 100);
+    }
+    index.put("new", 100);
+    index.touch("new");
+
+    auto candidates = index.eviction_candidates(100, no_skip);
+    BOOST_REQUIRE_EQUAL(candidates.size(), 1);
+    BOOST_REQUIRE_EQUAL(candidates[0].path, "old");
+}
+
+SEASTAR_THREAD_TEST_CASE(test_relaxed_durability_cleanup_after_crash) {
+    auto set_relaxed = [](bool v) {
+        return ss::smp::invoke_on_all([v] {
+            config::shard_local_cfg()
+              .cloud_storage_cache_relaxed_durability.set_value(v);
+        });
+    };
+    set_relaxed(true).get();
+
+    temporary_dir test_dir("test_cache_dir");
+    auto cache_dir = get_cache_dir(test_dir.get_path());
+    const std::filesystem::path key{"abc001/test_topic/test_cache_file.txt"};
+    {
+        ss::sharded<cache> c;
+        c.start(cache_dir, 1_MiB).get();
+        c.invoke_on_all([](cache& svc) { return svc.start(); }).get();
+        iobuf buf;
+        buf.append("data", 4);
+        auto input = make_iobuf_input_stream(std::move(buf));
+        c.local().put(key, input).get();
+        // readable without waiting for the sync
+        auto item = c.local().get(key).get();
+        BOOST_REQUIRE(item.has_value());
+        BOOST_REQUIRE_EQUAL(item->size, 4);
+        item->body.close().get();
+        // stopped before the background sync, as after a crash
+        c.stop().get();
+    }
+    {
+        ss::sharded<cache> c;
+        c.start(cache_dir, 1_MiB).get();
+        c.invoke_on_all([](cache& svc) { return svc.start(); }).get();
+        // the file written after the last sync checkpoint is removed
+        BOOST_REQUIRE_EQUAL(
+          c.local().is_cached(key).get(), cache_element_status::not_available);
+        c.stop().get();
+    }
+    test_dir.remove().get();
+    set_relaxed(false).get();
+}
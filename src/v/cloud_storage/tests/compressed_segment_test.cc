@@ -0,0 +1,121 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/redpanda-data/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "bytes/iobuf.h"
+#include "cloud_storage/compressed_segment.h"
+#include "random/generators.h"
+#include "seastarx.h"
+
+#include <seastar/core/iostream.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace cloud_storage;
+
+static constexpr uint64_t frame_size = 4096;
+
+// compressible payload: random words from a small dictionary
+static iobuf make_payload(size_t size) {
+    static const std::array<std::string_view, 4> words = {
+      "alpha ", "beta ", "gamma ", "delta "};
+    iobuf buf;
+    while (buf.size_bytes() < size) {
+        auto w = words.at(random_generators::get_int<size_t>(0, 3));
+        buf.append(w.data(), std::min(w.size(), size - buf.size_bytes()));
+    }
+    return buf;
+}
+
+static std::pair<iobuf, segment_frame_index> compress(const iobuf& payload) {
+    auto src = make_iobuf_input_stream(payload.copy());
+    segment_compressor compressor(src, frame_size);
+    iobuf out;
+    while (true) {
+        auto frame = compressor.next_frame().get0();
+        if (frame.empty()) {
+            break;
+        }
+        out.append(std::move(frame));
+    }
+    src.close().get();
+    return {std::move(out), compressor.index()};
+}
+
+static iobuf read_all(ss::input_stream<char> in) {
+    iobuf out;
+    auto os = make_iobuf_ref_output_stream(out);
+    ss::copy(in, os).get();
+    in.close().get();
+    return out;
+}
+
+SEASTAR_THREAD_TEST_CASE(test_compressed_segment_roundtrip) {
+    auto payload = make_payload(frame_size * 10 + 123);
+    auto [compressed, index] = compress(payload);
+
+    BOOST_REQUIRE_EQUAL(index.num_frames(), 11);
+    BOOST_REQUIRE_EQUAL(index.size_bytes, payload.size_bytes());
+    BOOST_REQUIRE_EQUAL(index.compressed_size(), compressed.size_bytes());
+    BOOST_REQUIRE_LT(compressed.size_bytes(), payload.size_bytes());
+
+    auto restored = read_all(make_frame_decompression_stream(
+      make_iobuf_input_stream(std::move(compressed)),
+      index.frame_sizes(0, index.num_frames() - 1),
+      0,
+      payload.size_bytes()));
+    BOOST_REQUIRE(restored == payload);
+
+    auto restored_index = segment_frame_index::from_iobuf(index.to_iobuf());
+    BOOST_REQUIRE(restored_index == index);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_compressed_segment_range_read) {
+    auto payload = make_payload(frame_size * 8 + 1000);
+    auto [compressed, index] = compress(payload);
+
+    for (int i = 0; i < 100; i++) {
+        auto first = random_generators::get_int<uint64_t>(
+          0, payload.size_bytes() - 1);
+        auto last = random_generators::get_int<uint64_t>(
+          first, payload.size_bytes() - 1);
+        auto frames = index.find(first, last);
+        BOOST_REQUIRE_EQUAL(frames.first_frame, first / frame_size);
+        BOOST_REQUIRE_EQUAL(frames.last_frame, last / frame_size);
+
+        // only the frames that overlap the range are read
+        auto object_part = compressed.share(
+          frames.bytes.first, frames.bytes.last - frames.bytes.first + 1);
+        auto length = last - first + 1;
+        auto restored = read_all(make_frame_decompression_stream(
+          make_iobuf_input_stream(std::move(object_part)),
+          index.frame_sizes(frames.first_frame, frames.last_frame),
+          frames.skip,
+          length));
+        BOOST_REQUIRE(restored == payload.share(first, length));
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_compressed_segment_truncated_frame) {
+    auto payload = make_payload(frame_size * 2);
+    auto [compressed, index] = compress(payload);
+    compressed.trim_back(10);
+
+    auto in = make_frame_decompression_stream(
+      make_iobuf_input_stream(std::move(compressed)),
+      index.frame_sizes(0, index.num_frames() - 1),
+      0,
+      payload.size_bytes());
+    iobuf out;
+    auto os = make_iobuf_ref_output_stream(out);
+    BOOST_REQUIRE_THROW(ss::copy(in, os).get(), std::runtime_error);
+    in.close().get();
+}
@@ -96,3 +96,58 @@ SEASTAR_THREAD_TEST_CASE(test_name_translation) {
         BOOST_REQUIRE_EQUAL(otl.get_adjusted_segment_name(key, fib), expected);
     }
 }
+
+SEASTAR_THREAD_TEST_CASE(test_offset_translation_table_term_last_offset) {
+    partition_manifest m(
+      model::ntp(
+        model::ns("test-ns"),
+        model::topic("test-topic"),
+        model::partition_id(0)),
+      model::initial_revision_id(0));
+    // 40 segments of 10 offsets, the term changes every 7 segments and every
+    // segment removes one offset
+    for (int64_t i = 0; i < 40; ++i) {
+        auto term = model::term_id(1 + i / 7);
+        m.add(
+          partition_manifest::key{
+            .base_offset = model::offset(i * 10), .term = term},
+          partition_manifest::segment_meta{
+            .is_compacted = false,
+            .size_bytes = 100,
+            .base_offset = model::offset(i * 10),
+            .committed_offset = model::offset(i * 10 + 9),
+            .delta_offset = model::offset(i),
+            .ntp_revision = model::initial_revision_id(0),
+            .archiver_term = term,
+          });
+    }
+    offset_translation_table table(m);
+    BOOST_REQUIRE_EQUAL(table.size(), 40);
+    BOOST_REQUIRE(!table.is_stale(m));
+    for (int64_t t = 1; t <= 5; ++t) {
+        // the first segment of the next term has index t * 7
+        auto expected = model::offset(t * 7 * 10 - t * 7 - 1);
+        BOOST_REQUIRE_EQUAL(
+          table.get_term_last_offset(model::term_id(t)), expected);
+    }
+    // the last term ends with the last segment
+    BOOST_REQUIRE_EQUAL(
+      table.get_term_last_offset(model::term_id(6)), model::offset(399 - 39));
+    BOOST_REQUIRE(!table.get_term_last_offset(model::term_id(7)).has_value());
+    BOOST_REQUIRE_EQUAL(
+      table.get_term_last_offset(model::term_id(0)), model::offset(-1));
+
+    m.add(
+      partition_manifest::key{
+        .base_offset = model::offset(400), .term = model::term_id(7)},
+      partition_manifest::segment_meta{
+        .is_compacted = false,
+        .size_bytes = 100,
+        .base_offset = model::offset(400),
+        .committed_offset = model::offset(409),
+        .delta_offset = model::offset(40),
+        .ntp_revision = model::initial_revision_id(0),
+        .archiver_term = model::term_id(7),
+      });
+    BOOST_REQUIRE(table.is_stale(m));
+}
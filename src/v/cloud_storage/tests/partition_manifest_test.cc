@@ -12,12 +12,14 @@
 #include "bytes/iobuf_parser.h"
 #include "cloud_storage/partition_manifest.h"
 #include "cloud_storage/types.h"
+#include "config/configuration.h"
 #include "model/metadata.h"
 #include "model/timestamp.h"
 #include "seastarx.h"
 
 #include <seastar/testing/test_case.hh>
 #include <seastar/testing/thread_test_case.hh>
+#include <seastar/util/defer.hh>
 
 #include <boost/test/tools/old/interface.hpp>
 #include <boost/test/unit_test.hpp>
@@ -501,6 +503,72 @@ SEASTAR_THREAD_TEST_CASE(test_manifest_serialization) {
     BOOST_REQUIRE(m == restored);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_manifest_binary_serialization) {
+    partition_manifest m(manifest_ntp, model::initial_revision_id(0));
+    // not a multiple of the delta-FOR row width
+    model::offset base{0};
+    for (int i = 0; i < 100; i++) {
+        auto committed = base + model::offset(10 + i % 7);
+        m.add(
+          partition_manifest::key{
+            .base_offset = base, .term = model::term_id(1 + i / 30)},
+          {
+            .is_compacted = i % 3 == 0,
+            .size_bytes = 1024 + static_cast<size_t>(i) * 10,
+            .base_offset = base,
+            .committed_offset = committed,
+            .base_timestamp = i % 5 == 0 ? model::timestamp::missing()
+                                         : model::timestamp(1000 + i),
+            .max_timestamp = model::timestamp(2000 + i),
+            .delta_offset = i == 0 ? model::offset::min() : model::offset(i),
+            .ntp_revision = model::initial_revision_id(i < 50 ? 0 : 3),
+            .archiver_term = model::term_id(5),
+            .is_compressed = i >= 70,
+            .has_index = i % 3 == 0,
+            .is_merged = i % 4 == 1,
+          });
+        base = committed + model::offset(1);
+    }
+
+    partition_manifest restored;
+    restored.from_iobuf(m.to_iobuf());
+    BOOST_REQUIRE(m == restored);
+
+    // empty manifest
+    partition_manifest empty(manifest_ntp, model::initial_revision_id(1));
+    partition_manifest restored_empty;
+    restored_empty.from_iobuf(empty.to_iobuf());
+    BOOST_REQUIRE(empty == restored_empty);
+
+    // 'serialize' produces the binary format if enabled, 'update' detects
+    // the format
+    config::shard_local_cfg()
+      .get("cloud_storage_manifest_binary_format")
+      .set_value(true);
+    auto reset = ss::defer([] {
+        config::shard_local_cfg()
+          .get("cloud_storage_manifest_binary_format")
+          .set_value(false);
+    });
+    auto [is, size] = m.serialize();
+    iobuf buf;
+    auto os = make_iobuf_ref_output_stream(buf);
+    ss::copy(is, os).get();
+    std::stringstream json;
+    m.serialize(json);
+    BOOST_REQUIRE_LT(buf.size_bytes(), json.str().size());
+
+    auto rstr = make_iobuf_input_stream(std::move(buf));
+    partition_manifest restored_stream;
+    restored_stream.update(std::move(rstr)).get0();
+    BOOST_REQUIRE(m == restored_stream);
+
+    // JSON keeps the compression, index and merge flags as well
+    partition_manifest restored_json;
+    restored_json.update(make_manifest_stream(json.str())).get0();
+    BOOST_REQUIRE(m == restored_json);
+}
+
 SEASTAR_THREAD_TEST_CASE(test_manifest_difference) {
     partition_manifest a(manifest_ntp, model::initial_revision_id(0));
     a.add(segment_name("1-1-v1.log"), {});
@@ -526,6 +594,57 @@ SEASTAR_THREAD_TEST_CASE(test_manifest_difference) {
     }
 }
 
+SEASTAR_THREAD_TEST_CASE(test_manifest_replace) {
+    partition_manifest m(manifest_ntp, model::initial_revision_id(0));
+    auto make_meta = [](int64_t base, int64_t committed) {
+        return partition_manifest::segment_meta{
+          .is_compacted = false,
+          .size_bytes = 100,
+          .base_offset = model::offset(base),
+          .committed_offset = model::offset(committed),
+          .ntp_revision = model::initial_revision_id(0),
+          .archiver_term = model::term_id(1),
+        };
+    };
+    auto make_key = [](int64_t base) {
+        return partition_manifest::key{
+          .base_offset = model::offset(base), .term = model::term_id(1)};
+    };
+    m.add(make_key(0), make_meta(0, 9));
+    m.add(make_key(10), make_meta(10, 19));
+    m.add(make_key(20), make_meta(20, 29));
+    m.add(make_key(30), make_meta(30, 39));
+
+    // the range has to match the segment boundaries
+    BOOST_REQUIRE_EQUAL(m.replace(make_key(10), make_meta(10, 25)).size(), 0);
+    BOOST_REQUIRE_EQUAL(m.replace(make_key(15), make_meta(15, 29)).size(), 0);
+    BOOST_REQUIRE_EQUAL(m.replace(make_key(10), make_meta(10, 49)).size(), 0);
+    BOOST_REQUIRE_EQUAL(m.size(), 4);
+    BOOST_REQUIRE_EQUAL(m.removed_segments(), 0);
+
+    auto merged = make_meta(10, 29);
+    merged.size_bytes = 200;
+    merged.is_merged = true;
+    auto removed = m.replace(make_key(10), merged);
+    BOOST_REQUIRE_EQUAL(removed.size(), 2);
+    BOOST_REQUIRE(*removed.get(make_key(10)) == make_meta(10, 19));
+    BOOST_REQUIRE(*removed.get(make_key(20)) == make_meta(20, 29));
+    BOOST_REQUIRE_EQUAL(m.size(), 3);
+    BOOST_REQUIRE_EQUAL(m.removed_segments(), 2);
+    BOOST_REQUIRE(*m.get(make_key(10)) == merged);
+    BOOST_REQUIRE(m.get(make_key(20)) == nullptr);
+    BOOST_REQUIRE_EQUAL(m.get_last_offset(), model::offset(39));
+
+    // the merged segment has its own object name
+    BOOST_REQUIRE_EQUAL(
+      m.generate_segment_path(make_key(10), merged),
+      generate_remote_segment_path(
+        manifest_ntp,
+        model::initial_revision_id(0),
+        segment_name("10-29-1-v1.log"),
+        model::term_id(1)));
+}
+
 // modeled after cluster::archival_metadata_stm::segment
 struct metadata_stm_segment
   : public serde::envelope<
@@ -0,0 +1,299 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/redpanda-data/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "cloud_storage/cache_service.h"
+#include "cloud_storage/partition_manifest.h"
+#include "cloud_storage/remote.h"
+#include "cloud_storage/remote_partition.h"
+#include "cloud_storage/tests/common_def.h"
+#include "cloud_storage/tests/s3_imposter.h"
+#include "cloud_storage/types.h"
+#include "model/metadata.h"
+#include "model/record.h"
+#include "random/generators.h"
+#include "units.h"
+#include "utils/hdr_hist.h"
+#include "vassert.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/testing/perf_tests.hh>
+#include <seastar/util/tmp_file.hh>
+
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace std::chrono_literals;
+using namespace cloud_storage;
+
+/**
+ * Benchmarks of the tiered storage read path.
+ *
+ * A remote_partition reads from an s3_imposter that emulates the latency,
+ * the bandwidth and the errors of a real object store. The sequential tests
+ * scan the whole partition, the seek tests read single batches at random
+ * offsets. The cold variants start every iteration with an empty cache, so
+ * that every segment has to be hydrated, the warm ones read from the cache
+ * filled by the previous iterations.
+ *
+ * On top of the perf_tests per-iteration figures each test reports the read
+ * throughput and the p50/p99 latencies of the first batch of a reader once
+ * it completes.
+ */
+struct read_bench_params {
+    // scan the whole partition or read single batches at random offsets
+    bool sequential;
+    // every iteration starts with an empty cache
+    bool cold_cache;
+};
+
+namespace {
+
+class first_byte_consumer {
+public:
+    first_byte_consumer(hdr_hist& first_byte, size_t& bytes)
+      : _start(std::chrono::steady_clock::now())
+      , _first_byte(first_byte)
+      , _bytes(bytes) {}
+
+    ss::future<ss::stop_iteration> operator()(model::record_batch b) {
+        if (!_first_batch_seen) {
+            _first_batch_seen = true;
+            _first_byte.get().record(
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - _start)
+                .count());
+        }
+        _bytes.get() += b.size_bytes();
+        co_return ss::stop_iteration::no;
+    }
+
+    bool end_of_stream() { return _first_batch_seen; }
+
+private:
+    std::chrono::steady_clock::time_point _start;
+    std::reference_wrapper<hdr_hist> _first_byte;
+    std::reference_wrapper<size_t> _bytes;
+    bool _first_batch_seen{false};
+};
+
+} // namespace
+
+class remote_read_bench_fixture : public s3_imposter_fixture {
+public:
+    static constexpr int num_segments = 16;
+    static constexpr int batches_per_segment = 64;
+    static constexpr int records_per_batch = 16;
+    static constexpr size_t record_size = 1_KiB;
+    static constexpr int seeks_per_iteration = 16;
+
+    explicit remote_read_bench_fixture(network_model model)
+      : _manifest(manifest_ntp, manifest_revision)
+      , _api(
+          s3_connection_limit(20),
+          get_configuration(),
+          model::cloud_credentials_source::config_file) {
+        set_network_model(model);
+        set_expectations_and_listen(make_expectations());
+        _cache_root.create().get();
+    }
+
+    remote_read_bench_fixture(const remote_read_bench_fixture&) = delete;
+    remote_read_bench_fixture& operator=(const remote_read_bench_fixture&)
+      = delete;
+    remote_read_bench_fixture(remote_read_bench_fixture&&) = delete;
+    remote_read_bench_fixture& operator=(remote_read_bench_fixture&&)
+      = delete;
+
+    ~remote_read_bench_fixture() {
+        report();
+        stop_cache().get();
+        _api.stop().get();
+        _cache_root.remove().get();
+    }
+
+    ss::future<size_t> run(read_bench_params p) {
+        _params = p;
+        if (p.cold_cache || !_cache) {
+            co_await stop_cache();
+            co_await start_cache();
+        }
+        auto partition = ss::make_lw_shared<remote_partition>(
+          _manifest, _api, _cache->local(), _bucket);
+        co_await partition->start();
+
+        perf_tests::start_measuring_time();
+        auto start = std::chrono::steady_clock::now();
+        size_t n = 0;
+        if (p.sequential) {
+            co_await read(
+              *partition, model::offset(0), _manifest.get_last_offset());
+            n = 1;
+        } else {
+            auto last = _manifest.get_last_offset()();
+            for (int i = 0; i < seeks_per_iteration; ++i) {
+                auto o = model::offset(random_generators::get_int(last));
+                co_await read(*partition, o, o);
+            }
+            n = seeks_per_iteration;
+        }
+        _elapsed += std::chrono::steady_clock::now() - start;
+        perf_tests::stop_measuring_time();
+
+        co_await partition->stop();
+        co_return n;
+    }
+
+private:
+    std::vector<expectation> make_expectations() {
+        std::vector<expectation> results;
+        std::vector<batch_t> batches(
+          batches_per_segment,
+          batch_t{
+            .num_records = records_per_batch,
+            .type = model::record_batch_type::raft_data,
+            .record_sizes = std::vector<size_t>(
+              records_per_batch, record_size),
+          });
+        model::offset base{0};
+        for (int i = 0; i < num_segments; ++i) {
+            auto body = generate_segment(base, batches);
+            auto committed = base
+                             + model::offset(
+                               batches_per_segment * records_per_batch - 1);
+            partition_manifest::segment_meta meta{
+              .is_compacted = false,
+              .size_bytes = body.size_bytes(),
+              .base_offset = base,
+              .committed_offset = committed,
+              .delta_offset = model::offset(0),
+              .ntp_revision = manifest_revision,
+            };
+            auto key = partition_manifest::key{
+              .base_offset = base, .term = model::term_id(1)};
+            _manifest.add(key, meta);
+            ss::sstring str;
+            for (const auto& f : body) {
+                str.append(f.get(), f.size());
+            }
+            auto path = _manifest.generate_segment_path(key, meta);
+            results.push_back(expectation{
+              .url = "/" + path().string(), .body = std::move(str)});
+            base = committed + model::offset(1);
+        }
+        return results;
+    }
+
+    ss::future<> read(
+      remote_partition& partition, model::offset first, model::offset last) {
+        storage::log_reader_config config(
+          first, last, ss::default_priority_class());
+        auto reader = (co_await partition.make_reader(config)).reader;
+        auto found = co_await reader.consume(
+          first_byte_consumer(_first_byte, _bytes), model::no_timeout);
+        vassert(found, "no batches read in {}-{}", first, last);
+    }
+
+    ss::future<> start_cache() {
+        auto dir = _cache_root.get_path() / fmt::format("{}", _caches++);
+        _cache = std::make_unique<ss::sharded<cache>>();
+        co_await _cache->start(dir, 1_GiB);
+        co_await _cache->invoke_on_all([](cache& c) { return c.start(); });
+    }
+
+    ss::future<> stop_cache() {
+        if (_cache) {
+            co_await _cache->stop();
+            _cache.reset();
+        }
+    }
+
+    void report() {
+        if (!_params) {
+            return;
+        }
+        auto seconds = std::chrono::duration<double>(_elapsed).count();
+        fmt::print(
+          std::cout,
+          "{} read, {} cache - {:.2f} MiB/s, first batch latency p50: {}us, "
+          "p99: {}us\n",
+          _params->sequential ? "sequential" : "random",
+          _params->cold_cache ? "cold" : "warm",
+          _bytes / seconds / (1024 * 1024),
+          _first_byte.get_value_at(50.0),
+          _first_byte.get_value_at(99.0));
+    }
+
+    partition_manifest _manifest;
+    remote _api;
+    s3::bucket_name _bucket{"bucket"};
+    ss::tmp_dir _cache_root;
+    std::unique_ptr<ss::sharded<cache>> _cache;
+    size_t _caches{0};
+
+    std::optional<read_bench_params> _params;
+    hdr_hist _first_byte{hdr_hist::us_per_hour, 1, 3};
+    size_t _bytes{0};
+    std::chrono::steady_clock::duration _elapsed{0};
+};
+
+// no latency, the read path itself is the bottleneck
+struct local_store : remote_read_bench_fixture {
+    local_store()
+      : remote_read_bench_fixture({}) {}
+};
+
+// an object store in the same region
+struct regional_store : remote_read_bench_fixture {
+    regional_store()
+      : remote_read_bench_fixture({
+        .latency = 10ms,
+        .bytes_per_second = 100_MiB,
+      }) {}
+};
+
+// an object store in another region
+struct remote_store : remote_read_bench_fixture {
+    remote_store()
+      : remote_read_bench_fixture({
+        .latency = 80ms,
+        .bytes_per_second = 25_MiB,
+      }) {}
+};
+
+// an object store throttling a share of the requests
+struct throttling_store : remote_read_bench_fixture {
+    throttling_store()
+      : remote_read_bench_fixture({
+        .latency = 10ms,
+        .bytes_per_second = 100_MiB,
+        .get_failure_rate = 0.05,
+      }) {}
+};
+
+#define REMOTE_READ_BENCH(store, name, ...)                                    \
+    PERF_TEST_F(store, name) { return run(read_bench_params{__VA_ARGS__}); }
+
+REMOTE_READ_BENCH(local_store, sequential_cold, true, true)
+REMOTE_READ_BENCH(local_store, sequential_warm, true, false)
+REMOTE_READ_BENCH(local_store, seek_cold, false, true)
+REMOTE_READ_BENCH(local_store, seek_warm, false, false)
+
+REMOTE_READ_BENCH(regional_store, sequential_cold, true, true)
+REMOTE_READ_BENCH(regional_store, seek_cold, false, true)
+
+REMOTE_READ_BENCH(remote_store, sequential_cold, true, true)
+REMOTE_READ_BENCH(remote_store, seek_cold, false, true)
+
+REMOTE_READ_BENCH(throttling_store, sequential_cold, true, true)
+REMOTE_READ_BENCH(throttling_store, seek_cold, false, true)
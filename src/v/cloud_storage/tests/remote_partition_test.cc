@@ -19,6 +19,7 @@
 #include "cloud_storage/tests/common_def.h"
 #include "cloud_storage/tests/s3_imposter.h"
 #include "cloud_storage/types.h"
+#include "config/configuration.h"
 #include "model/metadata.h"
 #include "model/record.h"
 #include "model/record_batch_types.h"
@@ -1053,3 +1054,52 @@ FIXTURE_TEST(test_remote_partition_read_cached_index, cloud_storage_fixture) {
         BOOST_REQUIRE(!headers_read.empty());
     }
 }
+
+FIXTURE_TEST(test_remote_partition_prefetch, cloud_storage_fixture) {
+    constexpr int num_segments = 4;
+    auto segments = setup_s3_imposter(*this, num_segments, 10);
+    auto base = segments[0].base_offset;
+    auto max = segments[0].max_offset;
+
+    config::shard_local_cfg()
+      .get("cloud_storage_prefetch_segments")
+      .set_value(size_t(2));
+    auto reset_cfg = ss::defer([] {
+        config::shard_local_cfg()
+          .get("cloud_storage_prefetch_segments")
+          .set_value(size_t(0));
+    });
+
+    auto conf = get_configuration();
+    auto bucket = s3::bucket_name("bucket");
+    remote api(s3_connection_limit(10), conf, config_file);
+    auto action = ss::defer([&api] { api.stop().get(); });
+    auto manifest = hydrate_manifest(api, bucket);
+
+    auto partition = ss::make_lw_shared<remote_partition>(
+      manifest, api, cache.local(), bucket);
+    auto partition_stop = ss::defer([&partition] { partition->stop().get(); });
+    partition->start().get();
+
+    // read only the first segment, the next two should be hydrated in the
+    // background and the last one should not be touched
+    storage::log_reader_config reader_config(
+      base, max, ss::default_priority_class());
+    auto reader = partition->make_reader(reader_config).get().reader;
+    auto headers_read
+      = reader.consume(test_consumer(), model::no_timeout).get();
+    std::move(reader).release();
+    BOOST_REQUIRE_EQUAL(headers_read.size(), 10);
+
+    std::vector<ss::sstring> urls;
+    for (const auto& [key, meta] : manifest) {
+        auto path = manifest.generate_segment_path(key, meta);
+        urls.push_back("/" + path().string());
+    }
+    tests::cooperative_spin_wait_with_timeout(10s, [this, &urls] {
+        return get_targets().count(urls[1]) > 0
+               && get_targets().count(urls[2]) > 0;
+    }).get();
+    BOOST_REQUIRE_EQUAL(get_targets().count(urls[0]), 1);
+    BOOST_REQUIRE_EQUAL(get_targets().count(urls[3]), 0);
+}
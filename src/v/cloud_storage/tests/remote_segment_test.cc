@@ -17,6 +17,7 @@
 #include "cloud_storage/tests/cloud_storage_fixture.h"
 #include "cloud_storage/tests/common_def.h"
 #include "cloud_storage/types.h"
+#include "config/configuration.h"
 #include "model/metadata.h"
 #include "model/timeout_clock.h"
 #include "s3/client.h"
@@ -121,6 +122,85 @@ FIXTURE_TEST(
     BOOST_REQUIRE(downloaded == segment_bytes);
 }
 
+FIXTURE_TEST(
+  test_remote_segment_chunked_download, cloud_storage_fixture) { // NOLINT
+    set_expectations_and_listen({});
+    auto conf = get_configuration();
+    auto bucket = s3::bucket_name("bucket");
+    remote remote(s3_connection_limit(10), conf, config_file);
+    partition_manifest m(manifest_ntp, manifest_revision);
+    auto key = partition_manifest::key{
+      .base_offset = model::offset(1), .term = model::term_id(2)};
+    model::initial_revision_id segment_ntp_revision{777};
+    iobuf segment_bytes = generate_segment(model::offset(1), 20);
+    uint64_t clen = segment_bytes.size_bytes();
+    auto action = ss::defer([&remote] { remote.stop().get(); });
+    auto reset_stream = make_reset_fn(segment_bytes);
+    retry_chain_node fib(1000ms, 200ms);
+    partition_manifest::segment_meta meta{
+      .is_compacted = false,
+      .size_bytes = segment_bytes.size_bytes(),
+      .base_offset = model::offset(1),
+      .committed_offset = model::offset(20),
+      .base_timestamp = {},
+      .max_timestamp = {},
+      .delta_offset = model::offset(0),
+      .ntp_revision = segment_ntp_revision};
+    auto path = m.generate_segment_path(key, meta);
+    auto upl_res = remote
+                     .upload_segment(
+                       bucket, path, clen, reset_stream, fib, always_continue)
+                     .get();
+    BOOST_REQUIRE(upl_res == upload_result::success);
+    m.add(key, meta);
+
+    // three chunks, the last one is shorter
+    const size_t chunk_size = clen / 3 + 1;
+    config::shard_local_cfg()
+      .get("cloud_storage_segment_chunk_size")
+      .set_value(std::make_optional(chunk_size));
+    auto reset_cfg = ss::defer([] {
+        config::shard_local_cfg()
+          .get("cloud_storage_segment_chunk_size")
+          .set_value(std::optional<size_t>{});
+    });
+
+    auto num_gets = [this, url = "/" + path().string()] {
+        auto [begin, end] = get_targets().equal_range(url);
+        return std::count_if(begin, end, [](const auto& t) {
+            return t.second._method == "GET";
+        });
+    };
+
+    remote_segment segment(remote, cache.local(), bucket, m, key, fib);
+    BOOST_REQUIRE(segment.is_chunked());
+
+    // reading the tail of the segment only downloads the last chunk
+    const size_t tail_pos = 2 * chunk_size + 1;
+    auto tail_handle
+      = segment.data_stream(tail_pos, ss::default_priority_class()).get();
+    iobuf tail;
+    auto tail_out = make_iobuf_ref_output_stream(tail);
+    ss::copy(tail_handle.stream(), tail_out).get();
+    tail_handle.close().get();
+    BOOST_REQUIRE_EQUAL(tail.size_bytes(), clen - tail_pos);
+    BOOST_REQUIRE_EQUAL(num_gets(), 1);
+
+    // reading the whole segment downloads the two remaining chunks
+    auto reader_handle
+      = segment.data_stream(0, ss::default_priority_class()).get();
+    iobuf downloaded;
+    auto rds = make_iobuf_ref_output_stream(downloaded);
+    ss::copy(reader_handle.stream(), rds).get();
+    reader_handle.close().get();
+
+    segment.stop().get();
+
+    BOOST_REQUIRE_EQUAL(num_gets(), 3);
+    BOOST_REQUIRE_EQUAL(downloaded.size_bytes(), segment_bytes.size_bytes());
+    BOOST_REQUIRE(downloaded == segment_bytes);
+}
+
 FIXTURE_TEST(test_remote_segment_timeout, cloud_storage_fixture) { // NOLINT
     auto conf = get_configuration();
     auto bucket = s3::bucket_name("bucket");
@@ -96,6 +96,58 @@ FIXTURE_TEST(test_download_manifest, s3_imposter_fixture) { // NOLINT
     BOOST_REQUIRE(expected == actual); // NOLINT
 }
 
+FIXTURE_TEST(test_download_manifest_if_modified, s3_imposter_fixture) {
+    set_expectations_and_listen({expectation{
+      .url = "/" + manifest_url, .body = ss::sstring(manifest_payload)}});
+    auto conf = get_configuration();
+    remote remote(s3_connection_limit(10), conf, config_file);
+    auto action = ss::defer([&remote] { remote.stop().get(); });
+    auto download = [&remote](partition_manifest& m, ss::sstring& etag) {
+        retry_chain_node fib(100ms, 20ms);
+        return remote
+          .download_manifest_if_modified(
+            s3::bucket_name("bucket"),
+            remote_manifest_path(std::filesystem::path(manifest_url)),
+            m,
+            etag,
+            fib)
+          .get();
+    };
+    ss::sstring etag;
+    partition_manifest actual(manifest_ntp, manifest_revision);
+    auto res = download(actual, etag);
+    BOOST_REQUIRE(res.result == download_result::success);
+    BOOST_REQUIRE(res.modified);
+    BOOST_REQUIRE(!etag.empty());
+    BOOST_REQUIRE(load_manifest_from_str(manifest_payload) == actual);
+
+    // unchanged manifest is not transferred
+    partition_manifest unchanged(manifest_ntp, manifest_revision);
+    auto first_etag = etag;
+    res = download(unchanged, etag);
+    BOOST_REQUIRE(res.result == download_result::success);
+    BOOST_REQUIRE(!res.modified);
+    BOOST_REQUIRE_EQUAL(etag, first_etag);
+    BOOST_REQUIRE_EQUAL(unchanged.size(), 0);
+
+    // a new version of the manifest is downloaded
+    actual.add(
+      segment_name("3-2-v1.log"),
+      {.size_bytes = 100,
+       .base_offset = model::offset(3),
+       .committed_offset = model::offset(4)});
+    retry_chain_node fib(100ms, 20ms);
+    BOOST_REQUIRE(
+      remote.upload_manifest(s3::bucket_name("bucket"), actual, fib).get()
+      == upload_result::success);
+    partition_manifest updated(manifest_ntp, manifest_revision);
+    res = download(updated, etag);
+    BOOST_REQUIRE(res.result == download_result::success);
+    BOOST_REQUIRE(res.modified);
+    BOOST_REQUIRE_NE(etag, first_etag);
+    BOOST_REQUIRE_EQUAL(updated.size(), 2);
+}
+
 FIXTURE_TEST(test_download_manifest_timeout, s3_imposter_fixture) { // NOLINT
     auto conf = get_configuration();
     remote remote(s3_connection_limit(10), conf, config_file);
@@ -175,6 +227,67 @@ FIXTURE_TEST(
     BOOST_REQUIRE(get_requests().empty());
 }
 
+FIXTURE_TEST(test_upload_segment_multipart, s3_imposter_fixture) { // NOLINT
+    set_expectations_and_listen({});
+    auto conf = get_configuration();
+    remote remote(s3_connection_limit(10), conf, config_file);
+    auto name = segment_name("1-2-v1.log");
+    auto path = generate_remote_segment_path(
+      manifest_ntp, manifest_revision, name, model::term_id{123});
+    uint64_t clen = manifest_payload.size();
+    uint64_t part_size = 100;
+    auto action = ss::defer([&remote] { remote.stop().get(); });
+    auto reset_part = [](uint64_t offset, uint64_t length)
+      -> ss::future<storage::segment_reader_handle> {
+        iobuf out;
+        out.append(manifest_payload.data() + offset, length);
+        co_return storage::segment_reader_handle(
+          make_iobuf_input_stream(std::move(out)));
+    };
+    retry_chain_node fib(100ms, 20ms);
+    auto res = remote
+                 .upload_segment_multipart(
+                   s3::bucket_name("bucket"),
+                   path,
+                   clen,
+                   part_size,
+                   2,
+                   reset_part,
+                   fib,
+                   always_continue)
+                 .get();
+    BOOST_REQUIRE(res == upload_result::success);
+
+    // create, every part, complete
+    auto num_parts = (clen + part_size - 1) / part_size;
+    BOOST_REQUIRE_EQUAL(get_requests().size(), num_parts + 2);
+    size_t part_bytes = 0;
+    for (const auto& req : get_requests()) {
+        if (req._method == "PUT") {
+            part_bytes += req.content_length;
+        }
+    }
+    BOOST_REQUIRE_EQUAL(part_bytes, clen);
+
+    // the assembled object can be downloaded
+    iobuf downloaded;
+    auto try_consume = [&downloaded](
+                         uint64_t len,
+                         ss::input_stream<char> is) -> ss::future<uint64_t> {
+        downloaded.clear();
+        auto rds = make_iobuf_ref_output_stream(downloaded);
+        co_await ss::copy(is, rds);
+        co_return downloaded.size_bytes();
+    };
+    auto dnl_res = remote
+                     .download_segment(
+                       s3::bucket_name("bucket"), path, try_consume, fib)
+                     .get();
+    BOOST_REQUIRE(dnl_res == download_result::success);
+    iobuf_parser p(std::move(downloaded));
+    BOOST_REQUIRE(p.read_string(p.bytes_left()) == manifest_payload);
+}
+
 FIXTURE_TEST(test_upload_segment_timeout, s3_imposter_fixture) { // NOLINT
     auto conf = get_configuration();
     remote remote(s3_connection_limit(10), conf, config_file);
@@ -13,11 +13,13 @@
 #include "bytes/iobuf.h"
 #include "bytes/iobuf_parser.h"
 #include "cloud_storage/types.h"
+#include "random/generators.h"
 #include "seastarx.h"
 #include "test_utils/async.h"
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/iostream.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/core/temporary_buffer.hh>
 #include <seastar/http/function_handlers.hh>
 #include <seastar/net/socket_defs.hh>
@@ -28,6 +30,8 @@
 #include <boost/test/tools/old/interface.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <cstdio>
+
 using namespace std::chrono_literals;
 
 inline ss::logger fixt_log("fixture"); // NOLINT
@@ -114,7 +118,65 @@ void s3_imposter_fixture::set_routes(
                     repl.set_status(reply::status_type::not_found);
                     return error_payload;
                 }
+                auto etag = ssx::sformat(
+                  "\"{}\"",
+                  std::hash<std::string_view>{}(*it->second.body));
+                repl.add_header("ETag", etag);
+                if (request.get_header("If-None-Match") == etag) {
+                    repl.set_status(reply::status_type::not_modified);
+                    return "";
+                }
+                if (auto range = request.get_header("Range"); !range.empty()) {
+                    // Range: bytes={first}-{last}
+                    size_t first = 0;
+                    size_t last = 0;
+                    auto n = std::sscanf(
+                      range.c_str(), "bytes=%zu-%zu", &first, &last);
+                    BOOST_REQUIRE_EQUAL(n, 2);
+                    repl.set_status(reply::status_type::partial_content);
+                    return it->second.body->substr(first, last - first + 1);
+                }
                 return *it->second.body;
+            } else if (request._method == "POST") {
+                if (request.query_parameters.contains("uploads")) {
+                    // CreateMultipartUpload, the url is used as an upload id
+                    multipart_uploads[request._url].clear();
+                    return ssx::sformat(
+                      "<InitiateMultipartUploadResult><UploadId>{}</UploadId>"
+                      "</InitiateMultipartUploadResult>",
+                      request._url);
+                }
+                // CompleteMultipartUpload
+                auto it = multipart_uploads.find(
+                  request.get_query_param("uploadId"));
+                BOOST_REQUIRE(it != multipart_uploads.end());
+                ss::sstring body;
+                for (const auto& [_, part] : it->second) {
+                    body += part;
+                }
+                expectations[request._url] = {
+                  .url = request._url, .body = std::move(body)};
+                multipart_uploads.erase(it);
+                return "<CompleteMultipartUploadResult>"
+                       "</CompleteMultipartUploadResult>";
+            } else if (
+              request._method == "PUT"
+              && request.query_parameters.contains("partNumber")) {
+                // UploadPart
+                auto it = multipart_uploads.find(
+                  request.get_query_param("uploadId"));
+                BOOST_REQUIRE(it != multipart_uploads.end());
+                auto part = std::stoi(request.get_query_param("partNumber"));
+                it->second[part] = request.content;
+                repl.add_header("ETag", ssx::sformat("\"etag-{}\"", part));
+                return "";
+            } else if (
+              request._method == "DELETE"
+              && request.query_parameters.contains("uploadId")) {
+                // AbortMultipartUpload
+                multipart_uploads.erase(request.get_query_param("uploadId"));
+                repl.set_status(reply::status_type::no_content);
+                return "";
             } else if (request._method == "PUT") {
                 expectations[request._url] = {
                   .url = request._url, .body = request.content};
@@ -152,11 +214,46 @@ void s3_imposter_fixture::set_routes(
             return "";
         }
         std::map<ss::sstring, expectation> expectations;
+        // parts of the multipart uploads in progress by upload id
+        std::map<ss::sstring, std::map<int, ss::sstring>> multipart_uploads;
         s3_imposter_fixture& fixture;
     };
     auto hd = ss::make_shared<content_handler>(expectations, *this);
     _handler = std::make_unique<function_handler>(
-      [hd](const_req req, reply& repl) { return hd->handle(req, repl); },
+      [this, hd](std::unique_ptr<request> req, std::unique_ptr<reply> repl)
+        -> ss::future<std::unique_ptr<reply>> {
+          static const ss::sstring slow_down_payload
+            = R"xml(<?xml version="1.0" encoding="UTF-8"?>
+                        <Error>
+                            <Code>SlowDown</Code>
+                            <Message>Please reduce your request rate.</Message>
+                            <Resource>resource</Resource>
+                            <RequestId>requestid</RequestId>
+                        </Error>)xml";
+          constexpr int failure_rate_scale = 10000;
+          const auto& model = _network_model;
+          if (
+            req->_method == "GET"
+            && random_generators::get_int(failure_rate_scale - 1)
+                 < model.get_failure_rate * failure_rate_scale) {
+              repl->set_status(reply::status_type::service_unavailable);
+              repl->_content = slow_down_payload;
+          } else {
+              repl->_content += hd->handle(*req, *repl);
+          }
+          auto delay = std::chrono::duration_cast<std::chrono::microseconds>(
+            model.latency);
+          if (model.bytes_per_second) {
+              delay += std::chrono::microseconds(
+                repl->_content.size() * 1000000 / *model.bytes_per_second);
+          }
+          if (delay == 0us) {
+              return ss::make_ready_future<std::unique_ptr<reply>>(
+                std::move(repl));
+          }
+          return ss::sleep(delay).then(
+            [repl = std::move(repl)]() mutable { return std::move(repl); });
+      },
       "txt");
     r.add_default_handler(_handler.get());
 }
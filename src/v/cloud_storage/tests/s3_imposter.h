@@ -20,6 +20,7 @@
 #include <chrono>
 #include <exception>
 #include <map>
+#include <optional>
 #include <vector>
 
 /// Emulates S3 REST API for testing purposes.
@@ -46,6 +47,20 @@ public:
         std::optional<ss::sstring> body;
     };
 
+    /// Latency, bandwidth and failures of the emulated object store
+    struct network_model {
+        /// Delay before every response
+        std::chrono::milliseconds latency{0};
+        /// Rate at which a response body is sent, unlimited if not set
+        std::optional<size_t> bytes_per_second;
+        /// Share of GET requests that fail with a retryable SlowDown error
+        double get_failure_rate{0};
+    };
+
+    /// Emulate a remote object store instead of replying immediately. Has
+    /// to be called before set_expectations_and_listen.
+    void set_network_model(network_model m) { _network_model = m; }
+
     /// Set expectaitions on REST API calls that supposed to be made
     /// Only the requests that described in this call will be possible
     /// to make. This method can only be called once per test run.
@@ -75,6 +90,7 @@ private:
     ss::shared_ptr<ss::httpd::http_server_control> _server;
 
     std::unique_ptr<ss::httpd::handler_base> _handler;
+    network_model _network_model;
     /// Contains saved requests
     std::vector<ss::httpd::request> _requests;
     /// Contains all accessed target urls
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/redpanda-data/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "cloud_storage/partition_manifest.h"
+#include "cloud_storage/segment_meta_cstore.h"
+#include "model/fundamental.h"
+#include "model/timestamp.h"
+#include "random/generators.h"
+
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace cloud_storage;
+
+static partition_manifest make_manifest(size_t num_segments) {
+    partition_manifest m(
+      model::ntp(model::ns("test-ns"), model::topic("test-topic"), 42),
+      model::initial_revision_id(1));
+    model::offset base{0};
+    model::offset delta{0};
+    model::timestamp ts{1000};
+    for (size_t i = 0; i < num_segments; i++) {
+        auto committed = base
+                         + model::offset(random_generators::get_int(1, 1000));
+        auto max_ts = model::timestamp(
+          ts.value() + random_generators::get_int(0, 100));
+        m.add(
+          partition_manifest::key{
+            .base_offset = base, .term = model::term_id(1 + i / 100)},
+          {
+            .is_compacted = i % 7 == 0,
+            .size_bytes = static_cast<size_t>(
+              random_generators::get_int(1000, 100000)),
+            .base_offset = base,
+            .committed_offset = committed,
+            .base_timestamp = ts,
+            .max_timestamp = max_ts,
+            // first segment was uploaded by the old version
+            .delta_offset = i == 0 ? model::offset::min() : delta,
+            .ntp_revision = model::initial_revision_id(1),
+            .archiver_term = model::term_id(1 + i / 100),
+          });
+        delta += model::offset(random_generators::get_int(0, 2));
+        base = committed + model::offset(1);
+        ts = max_ts;
+    }
+    return m;
+}
+
+static model::offset
+kafka_max_offset(const partition_manifest::segment_meta& m) {
+    auto delta = m.delta_offset == model::offset::min() ? model::offset(0)
+                                                        : m.delta_offset;
+    return m.committed_offset - delta;
+}
+
+BOOST_AUTO_TEST_CASE(segment_meta_cstore_at_test) {
+    // not a multiple of the row width, the last values are read from the
+    // write buffer
+    auto manifest = make_manifest(1023);
+    auto store = segment_meta_cstore::from_manifest(manifest);
+    BOOST_REQUIRE_EQUAL(store.size(), manifest.size());
+    size_t ix = 0;
+    for (const auto& [key, meta] : manifest) {
+        auto [actual_key, actual_meta] = store.at(ix++);
+        BOOST_REQUIRE(actual_key == key);
+        BOOST_REQUIRE(actual_meta == meta);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(segment_meta_cstore_lower_bound_test) {
+    auto manifest = make_manifest(1000);
+    auto store = segment_meta_cstore::from_manifest(manifest);
+    size_t ix = 0;
+    for (const auto& [key, meta] : manifest) {
+        auto kafka_max = kafka_max_offset(meta);
+        BOOST_REQUIRE_EQUAL(store.lower_bound_kafka_offset(kafka_max), ix);
+        // timestamps of adjacent segments can be the same
+        auto ts_ix = store.lower_bound_timestamp(meta.max_timestamp);
+        BOOST_REQUIRE(ts_ix.has_value() && ts_ix.value() <= ix);
+        BOOST_REQUIRE(
+          store.at(ts_ix.value()).second.max_timestamp >= meta.max_timestamp);
+        ix++;
+    }
+    auto last = kafka_max_offset(manifest.rbegin()->second);
+    BOOST_REQUIRE(
+      !store.lower_bound_kafka_offset(last + model::offset(1)).has_value());
+    BOOST_REQUIRE(!store
+                     .lower_bound_timestamp(model::timestamp(
+                       manifest.rbegin()->second.max_timestamp.value() + 1))
+                     .has_value());
+}
+
+BOOST_AUTO_TEST_CASE(segment_meta_cstore_memory_usage_test) {
+    auto store = segment_meta_cstore::from_manifest(make_manifest(10000));
+    // the btree of the manifest uses more than sizeof(segment_meta) per
+    // segment
+    BOOST_REQUIRE_LT(
+      store.memory_usage(),
+      10000 * sizeof(partition_manifest::segment_meta) / 2);
+}
@@ -65,6 +65,12 @@ struct archival_metadata_stm::truncate_cmd {
     using value = start_offset;
 };
 
+struct archival_metadata_stm::replace_segments_cmd {
+    static constexpr cmd_key key{2};
+
+    using value = segment;
+};
+
 struct archival_metadata_stm::snapshot
   : public serde::
       envelope<snapshot, serde::version<0>, serde::compat_version<0>> {
@@ -227,6 +233,67 @@ ss::future<std::error_code> archival_metadata_stm::do_truncate(
     co_return errc::success;
 }
 
+ss::future<std::error_code> archival_metadata_stm::replace_segments(
+  const cloud_storage::partition_manifest::key& key,
+  const cloud_storage::partition_manifest::segment_meta& meta,
+  ss::lowres_clock::time_point deadline,
+  std::optional<std::reference_wrapper<ss::abort_source>> as) {
+    auto now = ss::lowres_clock::now();
+    auto timeout = now < deadline ? deadline - now : 0ms;
+    return _lock.with(timeout, [this, &key, &meta, deadline, as] {
+        return do_replace_segments(key, meta, deadline, as);
+    });
+}
+
+ss::future<std::error_code> archival_metadata_stm::do_replace_segments(
+  const cloud_storage::partition_manifest::key& key,
+  const cloud_storage::partition_manifest::segment_meta& meta,
+  ss::lowres_clock::time_point deadline,
+  std::optional<std::reference_wrapper<ss::abort_source>> as) {
+    {
+        auto now = ss::lowres_clock::now();
+        auto timeout = now < deadline ? deadline - now : 0ms;
+        if (!co_await sync(timeout)) {
+            co_return errc::timeout;
+        }
+    }
+
+    if (as) {
+        as->get().check();
+    }
+
+    storage::record_batch_builder b(
+      model::record_batch_type::archival_metadata, model::offset(0));
+    iobuf key_buf = serde::to_iobuf(replace_segments_cmd::key);
+    auto record_val = replace_segments_cmd::value{
+      .ntp_revision_deprecated = meta.ntp_revision,
+      .name = cloud_storage::generate_segment_name(key.base_offset, key.term),
+      .meta = meta};
+    iobuf val_buf = serde::to_iobuf(std::move(record_val));
+    b.add_raw_kv(std::move(key_buf), std::move(val_buf));
+
+    auto batch = std::move(b).build();
+    auto ec = co_await do_replicate_commands(std::move(batch), deadline, as);
+    if (ec) {
+        co_return ec;
+    }
+
+    auto applied = _manifest.get(key);
+    if (!applied || *applied != meta) {
+        // the range didn't match the segments of the manifest
+        co_return errc::invalid_request;
+    }
+
+    vlog(
+      _logger.info,
+      "remote segments replaced by {} (base_offset: {}, last_offset: {})",
+      key,
+      meta.base_offset,
+      meta.committed_offset);
+
+    co_return errc::success;
+}
+
 ss::future<std::error_code> archival_metadata_stm::add_segments(
   const cloud_storage::partition_manifest& manifest,
   ss::lowres_clock::time_point deadline,
@@ -307,10 +374,15 @@ ss::future<> archival_metadata_stm::apply(model::record_batch b) {
             auto value = serde::from_iobuf<truncate_cmd::value>(
               r.release_value());
             apply_truncate(value);
+        } else if (key == replace_segments_cmd::key) {
+            auto value = serde::from_iobuf<replace_segments_cmd::value>(
+              r.release_value());
+            apply_replace_segments(value);
         }
     });
 
     _insync_offset = b.last_offset();
+    _tracked.update(_manifest.memory_size());
 }
 
 ss::future<> archival_metadata_stm::handle_eviction() {
@@ -346,6 +418,7 @@ ss::future<> archival_metadata_stm::handle_eviction() {
     }
 
     _manifest = std::move(manifest);
+    _tracked.update(_manifest.memory_size());
     for (const auto& segment : _manifest) {
         if (
           _start_offset == model::offset{}
@@ -391,6 +464,7 @@ ss::future<> archival_metadata_stm::apply_snapshot(
 
     _last_snapshot_offset = header.offset;
     _insync_offset = header.offset;
+    _tracked.update(_manifest.memory_size());
     co_return;
 }
 
@@ -468,6 +542,31 @@ void archival_metadata_stm::apply_truncate(const start_offset& so) {
     }
 }
 
+void archival_metadata_stm::apply_replace_segments(const segment& segment) {
+    auto key = cloud_storage::parse_segment_name(segment.name);
+    if (!key) {
+        vlog(_logger.error, "can't parse segment name {}", segment.name);
+        return;
+    }
+    auto replaced = _manifest.replace(*key, segment.meta);
+    if (replaced.size() == 0) {
+        // The range has to match segment boundaries. The command is applied
+        // the same way on all replicas, so skipping it keeps them in sync.
+        vlog(
+          _logger.warn,
+          "segments between {} and {} can't be replaced by {}",
+          segment.meta.base_offset,
+          segment.meta.committed_offset,
+          segment.name);
+        return;
+    }
+    vlog(
+      _logger.debug,
+      "Replace command applied, {} segments replaced by {}",
+      replaced.size(),
+      segment.name);
+}
+
 ss::future<> archival_metadata_stm::stop() {
     _download_as.request_abort();
     co_await raft::state_machine::stop();
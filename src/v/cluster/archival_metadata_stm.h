@@ -16,6 +16,7 @@
 #include "cluster/persisted_stm.h"
 #include "model/metadata.h"
 #include "model/record.h"
+#include "utils/memory_accounting.h"
 #include "utils/mutex.h"
 #include "utils/prefix_logger.h"
 
@@ -46,6 +47,15 @@ public:
       ss::lowres_clock::time_point deadline,
       std::optional<std::reference_wrapper<ss::abort_source>> = std::nullopt);
 
+    /// Replace the adjacent segments covered by the offset range of 'meta'
+    /// with a single segment, see partition_manifest::replace. Requires the
+    /// cloud_storage_segment_merging feature.
+    ss::future<std::error_code> replace_segments(
+      const cloud_storage::partition_manifest::key&,
+      const cloud_storage::partition_manifest::segment_meta&,
+      ss::lowres_clock::time_point deadline,
+      std::optional<std::reference_wrapper<ss::abort_source>> = std::nullopt);
+
     /// A set of archived segments. NOTE: manifest can be out-of-date if this
     /// node is not leader; or if the STM hasn't yet performed sync; or if the
     /// node has lost leadership. But it will contain segments successfully
@@ -74,6 +84,12 @@ private:
       ss::lowres_clock::time_point,
       std::optional<std::reference_wrapper<ss::abort_source>>);
 
+    ss::future<std::error_code> do_replace_segments(
+      const cloud_storage::partition_manifest::key&,
+      const cloud_storage::partition_manifest::segment_meta&,
+      ss::lowres_clock::time_point,
+      std::optional<std::reference_wrapper<ss::abort_source>>);
+
     ss::future<std::error_code> do_replicate_commands(
       model::record_batch,
       ss::lowres_clock::time_point,
@@ -90,6 +106,7 @@ private:
     struct start_offset;
     struct add_segment_cmd;
     struct truncate_cmd;
+    struct replace_segments_cmd;
     struct snapshot;
 
     static std::vector<segment>
@@ -97,6 +114,7 @@ private:
 
     void apply_add_segment(const segment& segment);
     void apply_truncate(const start_offset& so);
+    void apply_replace_segments(const segment& segment);
 
 private:
     prefix_logger _logger;
@@ -104,6 +122,7 @@ private:
     mutex _lock;
 
     cloud_storage::partition_manifest _manifest;
+    tracked_memory _tracked{memory_subsystem::manifests};
     model::offset _start_offset;
     model::offset _last_offset;
 
@@ -235,6 +235,22 @@ ss::future<std::error_code> replicate_and_wait(
       });
 }
 
+/// Replicates the commands as a single batch, see serde_serialize_cmds. The
+/// caller checks that the controller_batch_commands feature is active.
+template<typename Cmd>
+ss::future<std::error_code> replicate_batch_and_wait(
+  ss::sharded<controller_stm>& stm,
+  ss::sharded<ss::abort_source>& as,
+  std::vector<Cmd> cmds,
+  model::timeout_clock::time_point timeout) {
+    return stm.invoke_on(
+      controller_stm_shard,
+      [cmds = std::move(cmds), &as = as, timeout](controller_stm& stm) mutable {
+          auto b = serde_serialize_cmds(std::move(cmds));
+          return stm.replicate_and_wait(std::move(b), timeout, as.local());
+      });
+}
+
 std::vector<custom_assignable_topic_configuration>
   without_custom_assignments(std::vector<topic_configuration>);
 
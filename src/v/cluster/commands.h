@@ -289,9 +289,10 @@ serialize_cmd(Cmd cmd) {
 // flag indicating tha the command was serialized using serde serialization
 static constexpr int8_t serde_serialized_cmd_flag = -1;
 
+namespace internal {
 template<typename Cmd>
-requires ControllerCommand<Cmd> model::record_batch
-serde_serialize_cmd(Cmd cmd) {
+requires ControllerCommand<Cmd>
+void serde_add_cmd(simple_batch_builder& builder, Cmd cmd) {
     iobuf key_buf;
     iobuf value_buf;
     /**
@@ -306,8 +307,28 @@ serde_serialize_cmd(Cmd cmd) {
     write(value_buf, std::move(cmd.value));
     write(key_buf, std::move(cmd.key));
 
-    simple_batch_builder builder(Cmd::batch_type, model::offset(0));
     builder.add_raw_kv(std::move(key_buf), std::move(value_buf));
+}
+} // namespace internal
+
+template<typename Cmd>
+requires ControllerCommand<Cmd> model::record_batch
+serde_serialize_cmd(Cmd cmd) {
+    simple_batch_builder builder(Cmd::batch_type, model::offset(0));
+    internal::serde_add_cmd(builder, std::move(cmd));
+    return std::move(builder).build();
+}
+
+/// Serializes commands of the same type as a single batch with a record per
+/// command. Each command is applied at the offset of its record. Nodes that
+/// predate the controller_batch_commands feature can not apply such a batch.
+template<typename Cmd>
+requires ControllerCommand<Cmd> model::record_batch
+serde_serialize_cmds(std::vector<Cmd> cmds) {
+    simple_batch_builder builder(Cmd::batch_type, model::offset(0));
+    for (auto& cmd : cmds) {
+        internal::serde_add_cmd(builder, std::move(cmd));
+    }
     return std::move(builder).build();
 }
 
@@ -354,13 +375,9 @@ make_deserializer(command_type tp) {
 
 template<typename... Commands>
 ss::future<std::variant<Commands...>>
-deserialize(model::record_batch b, commands_type_list<Commands...>) {
-    vassert(
-      b.record_count() == 1,
-      "Currently we expect single command in single batch");
-    auto records = b.copy_records();
-    iobuf_parser v_parser(records.begin()->release_value());
-    iobuf_parser k_parser(records.begin()->release_key());
+deserialize(model::record r, commands_type_list<Commands...>) {
+    iobuf_parser v_parser(r.release_value());
+    iobuf_parser k_parser(r.release_key());
     const bool use_serde_serialization = reflection::adl<int8_t>{}.from(
                                            v_parser.peek(1))
                                          == serde_serialized_cmd_flag;
@@ -387,4 +404,15 @@ deserialize(model::record_batch b, commands_type_list<Commands...>) {
       },
       *ret);
 }
+
+template<typename... Commands>
+ss::future<std::variant<Commands...>>
+deserialize(model::record_batch b, commands_type_list<Commands...> cmds) {
+    vassert(
+      b.record_count() == 1,
+      "Expected a single command in the batch, batches of several commands "
+      "are deserialized record by record");
+    auto records = b.copy_records();
+    return deserialize(std::move(records.front()), cmds);
+}
 } // namespace cluster
@@ -13,6 +13,7 @@
 
 #include "cluster/config_frontend.h"
 #include "cluster/controller_service.h"
+#include "cluster/controller_snapshot.h"
 #include "cluster/errc.h"
 #include "cluster/feature_table.h"
 #include "cluster/logger.h"
@@ -21,6 +22,7 @@
 #include "config/node_config.h"
 #include "resource_mgmt/io_priority.h"
 #include "rpc/connection_cache.h"
+#include "serde/serde.h"
 #include "utils/file_io.h"
 #include "vlog.h"
 
@@ -788,7 +790,12 @@ config_manager::apply_delta(cluster_config_delta_cmd&& cmd_in) {
     // Explicitly move onto stack, because the input argument
     // may be invalidated after first coroutine sleep
     auto cmd = std::move(cmd_in);
+    auto units = co_await _apply_lock.get_units();
+    co_return co_await do_apply_delta(std::move(cmd));
+}
 
+ss::future<std::error_code>
+config_manager::do_apply_delta(cluster_config_delta_cmd cmd) {
     const config_version delta_version = cmd.key;
     if (delta_version <= _seen_version) {
         vlog(
@@ -862,6 +869,54 @@ config_manager::apply_update(model::record_batch b) {
       });
 }
 
+std::vector<cluster_property_kv> config_manager::get_raw_values() const {
+    std::vector<cluster_property_kv> values;
+    values.reserve(_raw_values.size());
+    for (const auto& [key, value] : _raw_values) {
+        values.emplace_back(key, value);
+    }
+    return values;
+}
+
+ss::future<> config_manager::apply_full_config(
+  config_version version, std::vector<cluster_property_kv> values) {
+    // The configuration is applied as a single delta replacing all the
+    // values, it is ignored if the local cache is already ahead of it.
+    auto units = co_await _apply_lock.get_units();
+    cluster_config_delta_cmd_data data;
+    data.upsert = std::move(values);
+    for (const auto& [key, value] : _raw_values) {
+        auto found = std::any_of(
+          data.upsert.begin(), data.upsert.end(), [&key](const auto& kv) {
+              return kv.key == key;
+          });
+        if (!found) {
+            data.remove.push_back(key);
+        }
+    }
+    co_await do_apply_delta(
+      cluster_config_delta_cmd(version, std::move(data)));
+}
+
+ss::future<iobuf> config_manager::take_snapshot(model::offset) {
+    controller_snapshot_parts::config snap{
+      .version = _seen_version, .values = get_raw_values()};
+    snap.status.reserve(status.size());
+    for (const auto& [node, s] : status) {
+        snap.status.push_back(s);
+    }
+    co_return serde::to_iobuf(std::move(snap));
+}
+
+ss::future<> config_manager::apply_snapshot(model::offset, iobuf buf) {
+    auto snap = serde::from_iobuf<controller_snapshot_parts::config>(
+      std::move(buf));
+    for (auto& s : snap.status) {
+        status[s.node] = std::move(s);
+    }
+    co_await apply_full_config(snap.version, std::move(snap.values));
+}
+
 config_manager::status_map config_manager::get_projected_status() const {
     status_map r = status;
 
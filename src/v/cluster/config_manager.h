@@ -14,6 +14,7 @@
 #include "cluster/commands.h"
 #include "model/record.h"
 #include "rpc/fwd.h"
+#include "utils/mutex.h"
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/future.hh>
@@ -57,8 +58,11 @@ public:
     ss::future<> stop();
 
     // mux_state_machine interface
+    static constexpr bool independent_apply = true;
     bool is_batch_applicable(const model::record_batch& b);
     ss::future<std::error_code> apply_update(model::record_batch);
+    ss::future<iobuf> take_snapshot(model::offset);
+    ss::future<> apply_snapshot(model::offset, iobuf);
 
     // Result of trying to apply a delta to a configuration
     struct apply_result {
@@ -73,6 +77,16 @@ public:
 
     config_version get_version() const noexcept { return _seen_version; }
 
+    /// Raw values of the last applied configuration version
+    std::vector<cluster_property_kv> get_raw_values() const;
+
+    /// Replaces the whole configuration with the given version of it, unless
+    /// a more recent version was already applied.  Used to install the
+    /// configuration received when joining the cluster and from controller
+    /// snapshots.
+    ss::future<>
+      apply_full_config(config_version, std::vector<cluster_property_kv>);
+
     bool needs_update(const config_status& new_status) {
         if (auto s = status.find(new_status.node); s != status.end()) {
             return s->second != new_status;
@@ -90,6 +104,7 @@ private:
     bool should_send_status();
     ss::future<> reconcile_status();
     ss::future<std::error_code> apply_delta(cluster_config_delta_cmd&&);
+    ss::future<std::error_code> do_apply_delta(cluster_config_delta_cmd);
     ss::future<> store_delta(
       config_version const& version, cluster_config_delta_cmd_data const& data);
 
@@ -112,6 +127,8 @@ private:
     model::node_id _self;
     config_version _seen_version{config_version_unset};
     std::map<ss::sstring, ss::sstring> _raw_values;
+    // deltas are applied from the controller log and from the join reply
+    mutex _apply_lock;
 
     ss::sharded<config_frontend>& _frontend;
     ss::sharded<rpc::connection_cache>& _connection_cache;
@@ -113,6 +113,45 @@ ss::future<> controller::start() {
               });
         });
     });
+    ssx::spawn_with_gate(_gate, [this] {
+        return _raft_manager.invoke_on_all([this](raft::group_manager& mgr) {
+            return _feature_table.local()
+              .await_feature(
+                feature::raft_append_entries_batching, _as.local())
+              .then([&mgr] {
+                  mgr.set_feature_active(
+                    raft::raft_feature::append_entries_batching);
+              });
+        });
+    });
+    ssx::spawn_with_gate(_gate, [this] {
+        return _raft_manager.invoke_on_all([this](raft::group_manager& mgr) {
+            return _feature_table.local()
+              .await_feature(feature::raft_node_lease, _as.local())
+              .then([&mgr] {
+                  mgr.set_feature_active(raft::raft_feature::node_lease);
+              });
+        });
+    });
+    ssx::spawn_with_gate(_gate, [this] {
+        return _raft_manager.invoke_on_all([this](raft::group_manager& mgr) {
+            return _feature_table.local()
+              .await_feature(feature::raft_vote_batching, _as.local())
+              .then([&mgr] {
+                  mgr.set_feature_active(raft::raft_feature::vote_batching);
+              });
+        });
+    });
+    ssx::spawn_with_gate(_gate, [this] {
+        return _raft_manager.invoke_on_all([this](raft::group_manager& mgr) {
+            return _feature_table.local()
+              .await_feature(feature::raft_timeout_now_batching, _as.local())
+              .then([&mgr] {
+                  mgr.set_feature_active(
+                    raft::raft_feature::timeout_now_batching);
+              });
+        });
+    });
 
     std::vector<model::broker> initial_raft0_brokers;
     if (config::node().seed_servers().empty()) {
@@ -126,8 +165,10 @@ ss::future<> controller::start() {
              std::move(initial_raft0_brokers))
       .then([this](consensus_ptr c) { _raft0 = c; })
       .then([this] { return _partition_leaders.start(std::ref(_tp_state)); })
-      .then(
-        [this] { return _drain_manager.start(std::ref(_partition_manager)); })
+      .then([this] {
+          return _drain_manager.start(
+            std::ref(_partition_manager), std::ref(_partition_leaders));
+      })
       .then([this] {
           return _members_manager.start_single(
             _raft0,
@@ -136,6 +177,7 @@ ss::future<> controller::start() {
             std::ref(_partition_allocator),
             std::ref(_storage),
             std::ref(_drain_manager),
+            std::ref(_config_manager),
             std::ref(_as));
       })
       .then([this] {
@@ -218,6 +260,7 @@ ss::future<> controller::start() {
             std::ref(_api),
             std::ref(_members_manager),
             std::ref(_members_frontend),
+            std::ref(_hm_frontend),
             _raft0,
             std::ref(_as));
       })
@@ -292,6 +335,7 @@ ss::future<> controller::start() {
             _raft_manager.local().raft_client(),
             std::ref(_shard_table),
             std::ref(_partition_manager),
+            std::ref(_hm_frontend),
             std::ref(_as),
             config::shard_local_cfg().enable_leader_balancer.bind(),
             config::shard_local_cfg().leader_balancer_idle_timeout.bind(),
@@ -299,6 +343,7 @@ ss::future<> controller::start() {
             config::shard_local_cfg().leader_balancer_node_mute_timeout.bind(),
             config::shard_local_cfg()
               .leader_balancer_transfer_limit_per_shard.bind(),
+            config::shard_local_cfg().leader_balancer_load_aware.bind(),
             _raft0);
           return _leader_balancer->start();
       })
@@ -375,15 +420,65 @@ ss::future<> controller::start() {
             config::shard_local_cfg()
               .partition_autobalancing_tick_interval_ms.bind(),
             config::shard_local_cfg()
-              .partition_autobalancing_movement_batch_size_bytes.bind());
+              .partition_autobalancing_movement_batch_size_bytes.bind(),
+            config::shard_local_cfg()
+              .partition_autobalancing_max_load_imbalance_percent.bind());
       })
       .then([this] {
           return _partition_balancer.invoke_on(
             partition_balancer_backend::shard,
             &partition_balancer_backend::start);
+      })
+      .then([this] {
+          _snapshot_timer.set_callback([this] {
+              ssx::spawn_with_gate(_snapshot_gate, [this] {
+                  return write_snapshot()
+                    .handle_exception([](const std::exception_ptr& e) {
+                        vlog(
+                          clusterlog.warn,
+                          "Failed to write controller snapshot: {}",
+                          e);
+                    })
+                    .finally([this] { schedule_snapshot(); });
+              });
+          });
+          schedule_snapshot();
       });
 }
 
+void controller::schedule_snapshot() {
+    if (!_snapshot_gate.is_closed()) {
+        _snapshot_timer.arm(
+          config::shard_local_cfg().controller_snapshot_interval_sec());
+    }
+}
+
+/**
+ * The snapshot is only taken when every controller backend reconciled the
+ * topic table deltas. Deltas are recreated from the topic table state when the
+ * snapshot is loaded, deltas of deleted topics are not.
+ */
+ss::future<> controller::write_snapshot() {
+    co_await _stm.invoke_on(controller_stm_shard, [this](controller_stm& stm) {
+        return stm.write_snapshot([this] {
+            return _backend.map_reduce0(
+              [](const controller_backend& b) {
+                  return !b.has_pending_deltas();
+              },
+              true,
+              std::logical_and<>{});
+        });
+    });
+}
+
+ss::future<> controller::wait_for_catch_up(ss::abort_source& as) {
+    vassert(
+      ss::this_shard_id() == controller_stm_shard,
+      "Controller catch up can only be awaited on the controller_stm_shard");
+    return _stm.local().wait(
+      _raft0->committed_offset(), model::no_timeout, std::ref(as));
+}
+
 ss::future<> controller::shutdown_input() {
     _raft0->shutdown_input();
     return _as.invoke_on_all(&ss::abort_source::request_abort);
@@ -400,7 +495,8 @@ ss::future<> controller::stop() {
     }
 
     _probe.stop();
-    return f.then([this] {
+    _snapshot_timer.cancel();
+    return f.then([this] { return _snapshot_gate.close(); }).then([this] {
         auto stop_leader_balancer = _leader_balancer ? _leader_balancer->stop()
                                                      : ss::now();
         return stop_leader_balancer
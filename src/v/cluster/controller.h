@@ -23,7 +23,9 @@
 #include "storage/fwd.h"
 
 #include <seastar/core/abort_source.hh>
+#include <seastar/core/gate.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/timer.hh>
 
 #include <vector>
 
@@ -112,6 +114,13 @@ public:
         return _raft0->is_elected_leader();
     }
 
+    /**
+     * Waits until the controller state machine applied everything that was
+     * committed to the controller log when called. Must be called on the
+     * controller_stm_shard.
+     */
+    ss::future<> wait_for_catch_up(ss::abort_source&);
+
     ss::future<> wire_up();
 
     ss::future<> start();
@@ -123,6 +132,8 @@ private:
     friend controller_probe;
 
     ss::future<> cluster_creation_hook();
+    void schedule_snapshot();
+    ss::future<> write_snapshot();
     config_manager::preload_result _config_preload;
 
     ss::sharded<ss::abort_source> _as;                     // instance per core
@@ -164,6 +175,8 @@ private:
     std::unique_ptr<leader_balancer> _leader_balancer;
     ss::sharded<partition_balancer_backend> _partition_balancer;
     ss::gate _gate;
+    ss::timer<> _snapshot_timer;
+    ss::gate _snapshot_gate;
     consensus_ptr _raft0;
     ss::sharded<cloud_storage::remote>& _cloud_storage_api;
     controller_probe _probe;
@@ -25,6 +25,7 @@
 #include "config/node_config.h"
 #include "model/fundamental.h"
 #include "model/metadata.h"
+#include "model/namespace.h"
 #include "outcome.h"
 #include "raft/group_configuration.h"
 #include "raft/types.h"
@@ -291,7 +292,16 @@ ss::future<> controller_backend::start() {
     return bootstrap_controller_backend().then([this] {
         start_topics_reconciliation_loop();
         _housekeeping_timer.set_callback([this] { housekeeping(); });
-        _housekeeping_timer.arm(_housekeeping_timer_interval);
+        if (_deferred_bootstrap > 0) {
+            vlog(
+              clusterlog.info,
+              "Creating {} deferred follower replicas in the background",
+              _deferred_bootstrap);
+            // reconcile the deferred replicas right away
+            _housekeeping_timer.arm(std::chrono::milliseconds(0));
+        } else {
+            _housekeeping_timer.arm(_housekeeping_timer_interval);
+        }
     });
 }
 
@@ -307,12 +317,22 @@ ss::future<> controller_backend::bootstrap_controller_backend() {
     });
 }
 
+size_t controller_backend::reconciliation_concurrency() const {
+    return std::max<size_t>(
+      1,
+      config::shard_local_cfg()
+        .controller_backend_reconciliation_concurrency());
+}
+
 ss::future<> controller_backend::do_bootstrap() {
-    return ss::parallel_for_each(
+    const bool defer
+      = config::shard_local_cfg().controller_backend_defer_follower_startup();
+    return ss::max_concurrent_for_each(
       _topic_deltas.begin(),
       _topic_deltas.end(),
-      [this](underlying_t::value_type& ntp_deltas) {
-          return bootstrap_ntp(ntp_deltas.first, ntp_deltas.second);
+      reconciliation_concurrency(),
+      [this, defer](underlying_t::value_type& ntp_deltas) {
+          return bootstrap_ntp(ntp_deltas.first, ntp_deltas.second, defer);
       });
 }
 
@@ -364,8 +384,29 @@ std::vector<topic_table::delta> calculate_bootstrap_deltas(
     return result_delta;
 }
 
-ss::future<>
-controller_backend::bootstrap_ntp(const model::ntp& ntp, deltas_t& deltas) {
+bool is_eager_bootstrap(
+  model::node_id self,
+  const model::ntp& ntp,
+  const std::vector<topic_table::delta>& bootstrap_deltas) {
+    if (
+      ntp.ns != model::kafka_namespace
+      || ntp.tp.topic == model::kafka_consumer_offsets_topic) {
+        return true;
+    }
+    if (bootstrap_deltas.empty()) {
+        return true;
+    }
+    const auto& last = bootstrap_deltas.back();
+    // removing a replica is cheap
+    if (last.type == topic_table::delta::op_type::del) {
+        return true;
+    }
+    const auto& replicas = last.new_assignment.replicas;
+    return replicas.empty() || replicas.front().node_id == self;
+}
+
+ss::future<> controller_backend::bootstrap_ntp(
+  const model::ntp& ntp, deltas_t& deltas, bool defer) {
     // find last delta that has to be applied
     auto bootstrap_deltas = calculate_bootstrap_deltas(_self, deltas);
     vlog(
@@ -451,6 +492,11 @@ controller_backend::bootstrap_ntp(const model::ntp& ntp, deltas_t& deltas) {
     }
     // apply all deltas following the one found previously
     deltas = std::move(bootstrap_deltas);
+    if (defer && !is_eager_bootstrap(_self, ntp, deltas)) {
+        // the reconciliation loop creates the replica once the node started
+        ++_deferred_bootstrap;
+        return ss::now();
+    }
     return reconcile_ntp(deltas);
 }
 
@@ -713,10 +759,12 @@ ss::future<> controller_backend::reconcile_topics() {
         if (_topic_deltas.empty()) {
             return ss::now();
         }
-        // reconcile NTPs in parallel
-        return ss::parallel_for_each(
+        // reconcile NTPs in parallel, bounded so that creating a topic with
+        // many partitions doesn't start all of them at once
+        return ss::max_concurrent_for_each(
                  _topic_deltas.begin(),
                  _topic_deltas.end(),
+                 reconciliation_concurrency(),
                  [this](underlying_t::value_type& ntp_deltas) {
                      return reconcile_ntp(ntp_deltas.second);
                  })
@@ -754,6 +802,14 @@ controller_backend::execute_partition_op(const topic_table::delta& delta) {
         if (!has_local_replicas(_self, delta.new_assignment.replicas)) {
             return ss::make_ready_future<std::error_code>(errc::success);
         }
+        // deltas restored from a controller snapshot carry the revision of
+        // every replica, a replica added by a move has the revision of the move
+        if (delta.replica_revisions) {
+            if (auto it = delta.replica_revisions->find(_self);
+                it != delta.replica_revisions->end()) {
+                rev = it->second;
+            }
+        }
         return create_partition(
           delta.ntp,
           delta.new_assignment.group,
@@ -1405,11 +1461,37 @@ ss::future<> controller_backend::add_to_shard_table(
       ntp,
       shard,
       revision);
-    return _shard_table.invoke_on_all(
-      [ntp = std::move(ntp), raft_group, shard, revision](
-        shard_table& s) mutable {
-          s.update(ntp, raft_group, shard, revision);
-      });
+    _pending_shard_table_updates.push_back(shard_table_update{
+      .ntp = std::move(ntp),
+      .group = raft_group,
+      .shard = shard,
+      .revision = revision,
+    });
+    // the first waiter to get the lock broadcasts all the pending updates,
+    // the update is applied once the lock is acquired
+    return _shard_table_updates_lock.with(
+      [this] { return flush_shard_table_updates(); });
+}
+
+ss::future<> controller_backend::flush_shard_table_updates() {
+    if (_pending_shard_table_updates.empty()) {
+        co_return;
+    }
+    auto updates = std::exchange(_pending_shard_table_updates, {});
+    try {
+        co_await _shard_table.invoke_on_all([&updates](shard_table& s) {
+            for (const auto& u : updates) {
+                s.update(u.ntp, u.group, u.shard, u.revision);
+            }
+        });
+    } catch (...) {
+        // give the updates back, the following waiters retry them
+        std::move(
+          updates.begin(),
+          updates.end(),
+          std::back_inserter(_pending_shard_table_updates));
+        throw;
+    }
 }
 
 ss::future<> controller_backend::remove_from_shard_table(
@@ -1453,6 +1535,12 @@ ss::future<std::error_code> controller_backend::create_partition(
             read_replica_bucket = s3::bucket_name(
               cfg->properties.read_replica_bucket.value());
         }
+        // the first replica is the preferred leader, recover it first so that
+        // leadership can be established without waiting for the whole node
+        const auto recovery_prio = !members.empty()
+                                       && members.front().id() == _self
+                                     ? storage::recovery_priority::high
+                                     : storage::recovery_priority::normal;
         // we use offset as an rev as it is always increasing and it
         // increases while ntp is being created again
         f = _partition_manager.local()
@@ -1462,7 +1550,8 @@ ss::future<std::error_code> controller_backend::create_partition(
                 group_id,
                 std::move(members),
                 cfg->properties.remote_topic_properties,
-                read_replica_bucket)
+                read_replica_bucket,
+                recovery_prio)
               .discard_result();
     } else {
         // old partition still exists, wait for it to be removed
@@ -19,6 +19,7 @@
 #include "outcome.h"
 #include "raft/group_configuration.h"
 #include "storage/api.h"
+#include "utils/mutex.h"
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/gate.hh>
@@ -233,6 +234,11 @@ public:
 
     std::vector<topic_table::delta> list_ntp_deltas(const model::ntp&) const;
 
+    /// True if there are topic table deltas that are not yet reconciled
+    bool has_pending_deltas() const {
+        return !_topic_deltas.empty() || _topics.local().has_pending_changes();
+    }
+
 private:
     struct cross_shard_move_request {
         cross_shard_move_request(model::revision_id, raft::group_configuration);
@@ -292,6 +298,7 @@ private:
       std::vector<model::broker>);
     ss::future<> add_to_shard_table(
       model::ntp, raft::group_id, ss::shard_id, model::revision_id);
+    ss::future<> flush_shard_table_updates();
     ss::future<>
       remove_from_shard_table(model::ntp, raft::group_id, model::revision_id);
     ss::future<> delete_partition(model::ntp, model::revision_id);
@@ -322,7 +329,7 @@ private:
       dispatch_update_finished(model::ntp, partition_assignment);
 
     ss::future<> do_bootstrap();
-    ss::future<> bootstrap_ntp(const model::ntp&, deltas_t&);
+    ss::future<> bootstrap_ntp(const model::ntp&, deltas_t&, bool defer);
 
     ss::future<std::error_code>
       shutdown_on_current_shard(model::ntp, model::revision_id);
@@ -343,6 +350,15 @@ private:
 
     void housekeeping();
     void setup_metrics();
+    size_t reconciliation_concurrency() const;
+
+    struct shard_table_update {
+        model::ntp ntp;
+        raft::group_id group;
+        ss::shard_id shard;
+        model::revision_id revision;
+    };
+
     ss::sharded<topic_table>& _topics;
     ss::sharded<shard_table>& _shard_table;
     ss::sharded<partition_manager>& _partition_manager;
@@ -356,6 +372,8 @@ private:
     ss::sharded<ss::abort_source>& _as;
     underlying_t _topic_deltas;
     ss::timer<> _housekeeping_timer;
+    // replicas left to the reconciliation loop by the bootstrap
+    size_t _deferred_bootstrap{0};
     ssx::semaphore _topics_sem{1, "c/controller-be"};
     ss::gate _gate;
     /**
@@ -373,9 +391,27 @@ private:
      * first created on current node before cross core move series
      */
     absl::node_hash_map<model::ntp, model::revision_id> _bootstrap_revisions;
+    /**
+     * Shard table additions are broadcast to all the cores in batches. When
+     * many partitions are created at once the additions queued while a
+     * broadcast is in flight are all sent with the next one.
+     */
+    std::vector<shard_table_update> _pending_shard_table_updates;
+    mutex _shard_table_updates_lock;
     ss::metrics::metric_groups _metrics;
 };
 
 std::vector<topic_table::delta> calculate_bootstrap_deltas(
   model::node_id self, const std::vector<topic_table::delta>&);
+
+/**
+ * True if the replica has to be reconciled when the backend bootstraps when
+ * follower startup is deferred. The replicas the node is the preferred leader
+ * of are needed to take leadership and the ones of internal topics to serve
+ * consumer groups and transactions.
+ */
+bool is_eager_bootstrap(
+  model::node_id self,
+  const model::ntp&,
+  const std::vector<topic_table::delta>& bootstrap_deltas);
 } // namespace cluster
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "bytes/iobuf.h"
+#include "cluster/feature_table.h"
+#include "cluster/topic_table.h"
+#include "cluster/types.h"
+#include "model/fundamental.h"
+#include "model/metadata.h"
+#include "security/acl.h"
+#include "security/credential_store.h"
+#include "security/license.h"
+#include "security/scram_credential.h"
+#include "serde/envelope.h"
+#include "v8_engine/data_policy.h"
+
+#include <optional>
+#include <vector>
+
+/**
+ * Snapshots of the controller states.
+ *
+ * Every state of the controller_stm writes its part of the snapshot, the
+ * controller_stm restores the parts on startup instead of applying the whole
+ * controller log. A part holds the state of the shard local tables, the
+ * pending work derived from the state (i.e. partitions to reconcile) is
+ * recreated when the part is restored.
+ */
+namespace cluster::controller_snapshot_parts {
+
+struct features
+  : serde::envelope<features, serde::version<0>, serde::compat_version<0>> {
+    struct feature
+      : serde::envelope<feature, serde::version<0>, serde::compat_version<0>> {
+        ss::sstring name;
+        feature_state::state state{feature_state::state::unavailable};
+
+        auto serde_fields() { return std::tie(name, state); }
+    };
+
+    cluster_version active_version{invalid_version};
+    std::vector<feature> states;
+    std::optional<security::license> license;
+
+    auto serde_fields() { return std::tie(active_version, states, license); }
+};
+
+struct config
+  : serde::envelope<config, serde::version<0>, serde::compat_version<0>> {
+    config_version version{config_version_unset};
+    std::vector<cluster_property_kv> values;
+    std::vector<config_status> status;
+
+    auto serde_fields() { return std::tie(version, values, status); }
+};
+
+struct members
+  : serde::envelope<members, serde::version<0>, serde::compat_version<0>> {
+    struct node
+      : serde::envelope<node, serde::version<0>, serde::compat_version<0>> {
+        model::node_id id;
+        model::membership_state membership{model::membership_state::active};
+        model::maintenance_state maintenance{
+          model::maintenance_state::inactive};
+
+        auto serde_fields() { return std::tie(id, membership, maintenance); }
+    };
+
+    // last applied raft0 configuration, serialized with adl
+    std::optional<iobuf> configuration;
+    model::offset configuration_offset;
+    std::vector<node> nodes;
+
+    auto serde_fields() {
+        return std::tie(configuration, configuration_offset, nodes);
+    }
+};
+
+struct topics
+  : serde::envelope<topics, serde::version<0>, serde::compat_version<0>> {
+    struct partition
+      : serde::
+          envelope<partition, serde::version<0>, serde::compat_version<0>> {
+        partition_assignment assignment;
+        topic_table::replicas_revision_map replica_revisions;
+
+        auto serde_fields() { return std::tie(assignment, replica_revisions); }
+    };
+
+    struct topic
+      : serde::envelope<topic, serde::version<0>, serde::compat_version<0>> {
+        topic_configuration configuration;
+        std::vector<partition> partitions;
+        model::revision_id revision;
+        std::optional<model::initial_revision_id> remote_revision;
+        // set for non replicable topics
+        std::optional<model::topic> source_topic;
+
+        auto serde_fields() {
+            return std::tie(
+              configuration,
+              partitions,
+              revision,
+              remote_revision,
+              source_topic);
+        }
+    };
+
+    struct update
+      : serde::envelope<update, serde::version<0>, serde::compat_version<0>> {
+        model::ntp ntp;
+        std::vector<model::broker_shard> previous_replicas;
+        topic_table::in_progress_state state{
+          topic_table::in_progress_state::update_requested};
+        model::revision_id update_revision;
+        topic_table::replicas_revision_map replicas_revisions;
+
+        auto serde_fields() {
+            return std::tie(
+              ntp, previous_replicas, state, update_revision, replicas_revisions);
+        }
+    };
+
+    std::vector<topic> topics;
+    std::vector<update> updates;
+
+    auto serde_fields() { return std::tie(topics, updates); }
+};
+
+struct security
+  : serde::envelope<security, serde::version<0>, serde::compat_version<0>> {
+    struct user
+      : serde::envelope<user, serde::version<0>, serde::compat_version<0>> {
+        ::security::credential_user name;
+        ::security::scram_credential credential;
+
+        auto serde_fields() { return std::tie(name, credential); }
+    };
+
+    std::vector<user> users;
+    std::vector<::security::acl_binding> acls;
+
+    auto serde_fields() { return std::tie(users, acls); }
+};
+
+struct data_policies
+  : serde::
+      envelope<data_policies, serde::version<0>, serde::compat_version<0>> {
+    struct policy
+      : serde::envelope<policy, serde::version<0>, serde::compat_version<0>> {
+        model::topic_namespace topic;
+        v8_engine::data_policy data_policy;
+
+        auto serde_fields() { return std::tie(topic, data_policy); }
+    };
+
+    std::vector<policy> policies;
+
+    auto serde_fields() { return std::tie(policies); }
+};
+
+} // namespace cluster::controller_snapshot_parts
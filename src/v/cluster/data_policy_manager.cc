@@ -12,7 +12,9 @@
 #include "cluster/data_policy_manager.h"
 
 #include "cluster/cluster_utils.h"
+#include "cluster/controller_snapshot.h"
 #include "cluster/errc.h"
+#include "serde/serde.h"
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/future.hh>
@@ -73,4 +75,24 @@ data_policy_manager::apply_update(model::record_batch batch) {
     });
 }
 
+ss::future<iobuf> data_policy_manager::take_snapshot(model::offset) {
+    controller_snapshot_parts::data_policies snap;
+    snap.policies.reserve(_dps.local().size());
+    for (const auto& [topic, dp] : _dps.local()) {
+        snap.policies.push_back(controller_snapshot_parts::data_policies::policy{
+          .topic = topic, .data_policy = dp});
+    }
+    co_return serde::to_iobuf(std::move(snap));
+}
+
+ss::future<> data_policy_manager::apply_snapshot(model::offset, iobuf buf) {
+    auto snap = serde::from_iobuf<controller_snapshot_parts::data_policies>(
+      std::move(buf));
+    co_await _dps.invoke_on_all([&snap](v8_engine::data_policy_table& db) {
+        for (const auto& p : snap.policies) {
+            db.insert(p.topic, p.data_policy);
+        }
+    });
+}
+
 } // namespace cluster
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "bytes/iobuf.h"
 #include "cluster/commands.h"
 #include "v8_engine/data_policy_table.h"
 
@@ -30,6 +31,9 @@ public:
 
     ss::future<std::error_code> apply_update(model::record_batch);
 
+    ss::future<iobuf> take_snapshot(model::offset);
+    ss::future<> apply_snapshot(model::offset, iobuf);
+
     bool is_batch_applicable(const model::record_batch& batch) const {
         return batch.header().type
                == model::record_batch_type::data_policy_management_cmd;
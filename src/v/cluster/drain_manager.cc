@@ -1,19 +1,25 @@
 #include "cluster/drain_manager.h"
 
 #include "cluster/logger.h"
+#include "cluster/partition_leaders_table.h"
 #include "cluster/partition_manager.h"
 #include "random/generators.h"
 #include "vlog.h"
 
+#include <seastar/core/loop.hh>
 #include <seastar/core/lowres_clock.hh>
 #include <seastar/core/smp.hh>
 #include <seastar/core/when_all.hh>
 
+#include <algorithm>
+
 namespace cluster {
 
 drain_manager::drain_manager(
-  ss::sharded<cluster::partition_manager>& partition_manager)
-  : _partition_manager(partition_manager) {}
+  ss::sharded<cluster::partition_manager>& partition_manager,
+  ss::sharded<cluster::partition_leaders_table>& leaders)
+  : _partition_manager(partition_manager)
+  , _leaders(leaders) {}
 
 ss::future<> drain_manager::start() {
     vassert(!_drain.has_value(), "service cannot be restarted");
@@ -49,6 +55,7 @@ ss::future<> drain_manager::drain() {
     vlog(clusterlog.info, "Node draining is starting");
     _draining = true;
     _status = drain_status{};
+    _transferred = 0;
     _sem.signal();
 }
 
@@ -111,6 +118,52 @@ ss::future<std::optional<drain_manager::drain_status>> drain_manager::status() {
       });
 }
 
+ss::future<size_t> drain_manager::transferred() {
+    return container().map_reduce0(
+      [](drain_manager& dm) { return dm._transferred; },
+      size_t(0),
+      std::plus<>());
+}
+
+std::optional<model::node_id> drain_manager::choose_transfer_target(
+  const std::vector<raft::follower_metrics>& followers,
+  leader_counts& leaders) {
+    const raft::follower_metrics* best = nullptr;
+    auto rank = [&leaders](const raft::follower_metrics& f) {
+        auto it = leaders.find(f.id);
+        return std::make_pair(
+          f.under_replicated, it == leaders.end() ? 0 : it->second);
+    };
+    for (const auto& f : followers) {
+        if (f.is_learner || !f.is_live) {
+            continue;
+        }
+        if (best == nullptr || rank(f) < rank(*best)) {
+            best = &f;
+        }
+    }
+    if (best == nullptr) {
+        return std::nullopt;
+    }
+    ++leaders[best->id];
+    return best->id;
+}
+
+drain_manager::leader_counts drain_manager::count_leaders() const {
+    leader_counts ret;
+    _leaders.local().for_each_leader(
+      [&ret](
+        model::topic_namespace_view,
+        model::partition_id,
+        std::optional<model::node_id> leader,
+        model::term_id) {
+          if (leader) {
+              ++ret[*leader];
+          }
+      });
+    return ret;
+}
+
 ss::future<> drain_manager::task() {
     while (true) {
         co_await _sem.wait();
@@ -174,69 +227,78 @@ ss::future<> drain_manager::do_drain() {
         }
 
         /*
-         * choose a random sample from the set of eligible partitions. this is
-         * useful when we have a draining policy in which we want to drain as
-         * much as possible even if some groups continue to have leadership
-         * transfer errors. an alternative approach would be to fence off groups
-         * experiencing errors, but then we would have to create some type of
-         * retry policy to deal with those partitions.
+         * shuffle the eligible partitions. this is useful when we have a
+         * draining policy in which we want to drain as much as possible even
+         * if some groups continue to have leadership transfer errors. an
+         * alternative approach would be to fence off groups experiencing
+         * errors, but then we would have to create some type of retry policy
+         * to deal with those partitions.
          */
-        std::vector<ss::lw_shared_ptr<cluster::partition>> selected;
-        selected.reserve(max_parallel_transfers);
-        std::sample(
-          eligible.begin(),
-          eligible.end(),
-          std::back_inserter(selected),
-          max_parallel_transfers,
-          random_generators::internal::gen);
-        eligible.clear();
+        std::shuffle(
+          eligible.begin(), eligible.end(), random_generators::internal::gen);
 
         /*
-         * start a group of transfers
+         * transfer leadership with a bounded number of transfers in flight. a
+         * new transfer starts as soon as any of them completes.
          */
-        std::vector<ss::future<std::error_code>> transfers;
-        transfers.reserve(selected.size());
-        for (auto& p : selected) {
-            transfers.push_back(p->transfer_leadership(std::nullopt));
-        }
-        _status.transferring = transfers.size();
+        auto leaders = count_leaders();
+        size_t attempted = 0;
+        size_t failed = 0;
+        _status.transferring = 0;
 
         vlog(
           clusterlog.info,
           "Draining leadership from {} groups",
-          transfers.size());
+          eligible.size());
 
         auto started = ss::lowres_clock::now();
 
-        auto results = co_await ss::when_all(
-          transfers.begin(), transfers.end());
-
-        size_t failed = 0;
-        for (auto& f : results) {
-            try {
-                auto err = f.get();
-                if (err) {
-                    vlog(
-                      clusterlog.debug,
-                      "Draining leadership failed for group: {}",
-                      err);
-                    failed++;
-                }
-            } catch (...) {
-                vlog(
-                  clusterlog.debug,
-                  "Draining leadership failed for group: {}",
-                  std::current_exception());
-                failed++;
-            }
-        }
+        co_await ss::max_concurrent_for_each(
+          eligible,
+          max_parallel_transfers,
+          [this, &leaders, &attempted, &failed](
+            ss::lw_shared_ptr<cluster::partition> p) -> ss::future<> {
+              if (!_draining || _abort.abort_requested()) {
+                  co_return;
+              }
+              if (!p->is_elected_leader()) {
+                  // lost leadership since the set was built
+                  co_return;
+              }
+              auto target = choose_transfer_target(
+                p->raft()->get_follower_metrics(), leaders);
+              ++attempted;
+              ++*_status.transferring;
+              std::error_code err;
+              try {
+                  err = co_await p->transfer_leadership(target);
+              } catch (...) {
+                  vlog(
+                    clusterlog.debug,
+                    "Draining leadership failed for group: {}",
+                    std::current_exception());
+                  err = make_error_code(raft::errc::timeout);
+              }
+              --*_status.transferring;
+              if (err) {
+                  vlog(
+                    clusterlog.debug,
+                    "Draining leadership of {} to {} failed: {}",
+                    p->ntp(),
+                    target,
+                    err);
+                  ++failed;
+              } else {
+                  ++_transferred;
+              }
+          });
         _status.failed = failed;
 
         vlog(
           clusterlog.info,
           "Draining leadership from {} groups {} succeeded",
-          transfers.size(),
-          transfers.size() - failed);
+          attempted,
+          attempted - failed);
 
         /*
          * to avoid spinning, cool off if we failed fast
@@ -10,6 +10,8 @@
  */
 #pragma once
 #include "cluster/fwd.h"
+#include "model/metadata.h"
+#include "raft/types.h"
 #include "reflection/adl.h"
 #include "seastarx.h"
 #include "serde/serde.h"
@@ -20,6 +22,8 @@
 #include <seastar/core/sharded.hh>
 #include <seastar/util/log.hh>
 
+#include <absl/container/flat_hash_map.h>
+
 #include <chrono>
 
 namespace cluster {
@@ -27,6 +31,12 @@ namespace cluster {
 /*
  * The drain manager is responsible for managing the draining of leadership from
  * a node. It is a core building block for implementing node maintenance mode.
+ *
+ * Transfers run in a sliding window rather than in rounds, so a slow group
+ * does not hold back the others. Every group is handed over to the follower
+ * leading the fewest groups in the cluster wide leadership view, so that
+ * draining a node does not pile its leadership up on a single peer. Transfers
+ * started together towards the same node share their timeout_now rpcs.
  */
 class drain_manager : public ss::peering_sharded_service<drain_manager> {
     static constexpr size_t max_parallel_transfers = 25;
@@ -63,7 +73,12 @@ public:
         }
     };
 
-    explicit drain_manager(ss::sharded<cluster::partition_manager>&);
+    // number of groups led by every node
+    using leader_counts = absl::flat_hash_map<model::node_id, size_t>;
+
+    drain_manager(
+      ss::sharded<cluster::partition_manager>&,
+      ss::sharded<cluster::partition_leaders_table>&);
 
     ss::future<> start();
     ss::future<> stop();
@@ -89,16 +104,35 @@ public:
      */
     ss::future<std::optional<drain_status>> status();
 
+    /*
+     * Number of leaderships moved away since draining started.
+     *
+     * This performs a global reduction across cores.
+     */
+    ss::future<size_t> transferred();
+
+    /*
+     * Choose the follower to move leadership to: a live voter, preferring
+     * the ones that need no recovery, then the one leading the fewest
+     * groups. The counts are updated with the choice so that the following
+     * choices take it into account.
+     */
+    static std::optional<model::node_id> choose_transfer_target(
+      const std::vector<raft::follower_metrics>&, leader_counts&);
+
 private:
     ss::future<> task();
     ss::future<> do_drain();
     ss::future<> do_restore();
+    leader_counts count_leaders() const;
 
     ss::sharded<cluster::partition_manager>& _partition_manager;
+    ss::sharded<cluster::partition_leaders_table>& _leaders;
     std::optional<ss::future<>> _drain;
     bool _draining{false};
     ssx::semaphore _sem{0, "c/drain-mgr"};
     drain_status _status;
+    size_t _transferred{0};
     ss::abort_source _abort;
 };
 
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "bytes/iobuf.h"
 #include "cluster/commands.h"
 #include "cluster/feature_table.h"
 #include "cluster/fwd.h"
@@ -31,6 +32,9 @@ public:
 
     ss::future<std::error_code> apply_update(model::record_batch);
 
+    ss::future<iobuf> take_snapshot(model::offset);
+    ss::future<> apply_snapshot(model::offset, iobuf);
+
     bool is_batch_applicable(const model::record_batch& b) {
         return b.header().type == model::record_batch_type::feature_update;
     }
@@ -11,6 +11,7 @@
 
 #include "feature_table.h"
 
+#include "cluster/controller_snapshot.h"
 #include "cluster/logger.h"
 #include "cluster/types.h"
 
@@ -34,6 +35,20 @@ std::string_view to_string_view(feature f) {
         return "license";
     case feature::raft_improved_configuration:
         return "raft_improved_configuration";
+    case feature::raft_append_entries_batching:
+        return "raft_append_entries_batching";
+    case feature::raft_node_lease:
+        return "raft_node_lease";
+    case feature::id_allocator_ranges:
+        return "id_allocator_ranges";
+    case feature::controller_batch_commands:
+        return "controller_batch_commands";
+    case feature::cloud_storage_segment_merging:
+        return "cloud_storage_segment_merging";
+    case feature::raft_vote_batching:
+        return "raft_vote_batching";
+    case feature::raft_timeout_now_batching:
+        return "raft_timeout_now_batching";
     case feature::test_alpha:
         return "__test_alpha";
     }
@@ -62,7 +77,7 @@ std::string_view to_string_view(feature_state::state s) {
 
 // The version that this redpanda node will report: increment this
 // on protocol changes to raft0 structures, like adding new services.
-static constexpr cluster_version latest_version = cluster_version{5};
+static constexpr cluster_version latest_version = cluster_version{11};
 
 feature_table::feature_table() {
     // Intentionally undocumented environment variable, only for use
@@ -310,4 +325,36 @@ const std::optional<security::license>& feature_table::get_license() const {
     return _license;
 }
 
+controller_snapshot_parts::features feature_table::fill_snapshot() const {
+    controller_snapshot_parts::features snap{
+      .active_version = _active_version,
+      .license = _license,
+    };
+    snap.states.reserve(_feature_state.size());
+    for (const auto& fs : _feature_state) {
+        snap.states.push_back(controller_snapshot_parts::features::feature{
+          .name = ss::sstring(fs.spec.name), .state = fs.get_state()});
+    }
+    return snap;
+}
+
+void feature_table::apply_snapshot(
+  const controller_snapshot_parts::features& snap) {
+    _active_version = snap.active_version;
+    for (auto& fs : _feature_state) {
+        auto it = std::find_if(
+          snap.states.begin(), snap.states.end(), [&fs](const auto& f) {
+              return f.name == fs.spec.name;
+          });
+        if (it != snap.states.end()) {
+            fs._state = it->state;
+        } else {
+            fs.notify_version(_active_version);
+        }
+    }
+    _license = snap.license;
+
+    on_update();
+}
+
 } // namespace cluster
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "cluster/fwd.h"
 #include "cluster/types.h"
 #include "security/license.h"
 #include "utils/waiter_queue.h"
@@ -29,6 +30,13 @@ enum class feature : std::uint64_t {
     serde_raft_0 = 0x20,
     license = 0x40,
     raft_improved_configuration = 0x80,
+    raft_append_entries_batching = 0x100,
+    raft_node_lease = 0x200,
+    id_allocator_ranges = 0x400,
+    controller_batch_commands = 0x800,
+    cloud_storage_segment_merging = 0x1000,
+    raft_vote_batching = 0x2000,
+    raft_timeout_now_batching = 0x4000,
 
     // Dummy features for testing only
     test_alpha = uint64_t(1) << 63,
@@ -129,6 +137,48 @@ constexpr static std::array feature_schema{
     feature::raft_improved_configuration,
     feature_spec::available_policy::always,
     feature_spec::prepare_policy::always},
+  feature_spec{
+    cluster_version{6},
+    "raft_append_entries_batching",
+    feature::raft_append_entries_batching,
+    feature_spec::available_policy::always,
+    feature_spec::prepare_policy::always},
+  feature_spec{
+    cluster_version{7},
+    "raft_node_lease",
+    feature::raft_node_lease,
+    feature_spec::available_policy::always,
+    feature_spec::prepare_policy::always},
+  feature_spec{
+    cluster_version{8},
+    "id_allocator_ranges",
+    feature::id_allocator_ranges,
+    feature_spec::available_policy::always,
+    feature_spec::prepare_policy::always},
+  feature_spec{
+    cluster_version{9},
+    "controller_batch_commands",
+    feature::controller_batch_commands,
+    feature_spec::available_policy::always,
+    feature_spec::prepare_policy::always},
+  feature_spec{
+    cluster_version{10},
+    "cloud_storage_segment_merging",
+    feature::cloud_storage_segment_merging,
+    feature_spec::available_policy::always,
+    feature_spec::prepare_policy::always},
+  feature_spec{
+    cluster_version{11},
+    "raft_vote_batching",
+    feature::raft_vote_batching,
+    feature_spec::available_policy::always,
+    feature_spec::prepare_policy::always},
+  feature_spec{
+    cluster_version{11},
+    "raft_timeout_now_batching",
+    feature::raft_timeout_now_batching,
+    feature_spec::available_policy::always,
+    feature_spec::prepare_policy::always},
   feature_spec{
     cluster_version{2001},
     "__test_alpha",
@@ -244,6 +294,9 @@ public:
 
 private:
     state _state{state::unavailable};
+
+    // restores the state from a controller snapshot
+    friend class feature_table;
 };
 
 std::string_view to_string_view(feature);
@@ -311,6 +364,13 @@ public:
 
     const std::optional<security::license>& get_license() const;
 
+    controller_snapshot_parts::features fill_snapshot() const;
+
+    /// Restores the active version, feature states and license of a
+    /// controller snapshot. Features unknown to the snapshot are moved
+    /// forward as if the active version was just set.
+    void apply_snapshot(const controller_snapshot_parts::features&);
+
 private:
     // Only for use by our friends feature backend & manager
     void set_active_version(cluster_version);
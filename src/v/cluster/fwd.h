@@ -50,4 +50,13 @@ class feature_table;
 class drain_manager;
 class partition_balancer_backend;
 
+namespace controller_snapshot_parts {
+struct features;
+struct config;
+struct members;
+struct topics;
+struct security;
+struct data_policies;
+} // namespace controller_snapshot_parts
+
 } // namespace cluster
@@ -29,6 +29,7 @@
 #include "random/generators.h"
 #include "rpc/connection_cache.h"
 #include "storage/types.h"
+#include "utils/stall_tracker.h"
 #include "version.h"
 
 #include <seastar/core/coroutine.hh>
@@ -485,7 +486,8 @@ health_monitor_backend::maybe_refresh_cluster_health(
 }
 
 ss::future<result<node_health_report>>
-health_monitor_backend::collect_remote_node_health(model::node_id id) {
+health_monitor_backend::collect_remote_node_health(
+  model::node_id id, std::optional<int64_t> base_report_version) {
     const auto timeout = model::timeout_clock::now() + max_metadata_age();
     return _connections.local()
       .with_node_client<controller_client_protocol>(
@@ -493,9 +495,12 @@ health_monitor_backend::collect_remote_node_health(model::node_id id) {
         ss::this_shard_id(),
         id,
         max_metadata_age(),
-        [timeout](controller_client_protocol client) mutable {
+        [timeout, base_report_version](
+          controller_client_protocol client) mutable {
             return client.collect_node_health_report(
-              get_node_health_request{.filter = node_report_filter{}},
+              get_node_health_request{
+                .filter = node_report_filter{},
+                .base_report_version = base_report_version},
               rpc::client_opts(timeout));
         })
       .then(&rpc::get_ctx_data<get_node_health_reply>)
@@ -567,16 +572,53 @@ ss::future<std::error_code> health_monitor_backend::collect_cluster_health() {
     vlog(clusterlog.debug, "collecting cluster health statistics");
     // collect all reports
     auto ids = _members.local().all_broker_ids();
+    // nodes reply with the partitions that changed since the report we hold,
+    // once in a while full reports are requested instead
+    const bool full_reports = _collections++ % full_report_interval == 0;
     auto reports = co_await ssx::async_transform(
-      ids.begin(), ids.end(), [this](model::node_id id) {
+      ids.begin(), ids.end(), [this, full_reports](model::node_id id) {
           if (id == _raft0->self().id()) {
               return collect_current_node_health(node_report_filter{});
           }
-          return collect_remote_node_health(id);
+          // version 0 is never reported, asking for it results in a full
+          // report that starts a new sequence of deltas
+          int64_t base_version = 0;
+          if (auto it = _reports.find(id);
+              !full_reports && it != _reports.end()) {
+              base_version = it->second.report_version;
+          }
+          return collect_remote_node_health(id, base_version);
       });
 
     auto old_reports = std::exchange(_reports, {});
 
+    // merge incremental reports into the reports they are based on
+    for (auto& r : reports) {
+        if (!r || !r.value().is_delta()) {
+            continue;
+        }
+        const auto id = r.value().id;
+        auto old_i = old_reports.find(id);
+        if (
+          old_i != old_reports.end()
+          && old_i->second.report_version == r.value().delta_base_version) {
+            r = result<node_health_report>(apply_node_health_report_delta(
+              old_i->second, std::move(r.value())));
+            continue;
+        }
+        vlog(
+          clusterlog.info,
+          "node {} health report delta is based on version {} that is not "
+          "available, requesting full report",
+          id,
+          r.value().delta_base_version);
+        r = co_await collect_remote_node_health(id, 0);
+        if (r && r.value().is_delta()) {
+            r = result<node_health_report>(
+              errc::error_collecting_health_report);
+        }
+    }
+
     // update nodes reports and cache cluster-level disk health
     storage::disk_space_alert cluster_disk_health
       = storage::disk_space_alert::ok;
@@ -616,8 +658,13 @@ ss::future<std::error_code> health_monitor_backend::collect_cluster_health() {
 }
 
 ss::future<result<node_health_report>>
-health_monitor_backend::collect_current_node_health(node_report_filter filter) {
+health_monitor_backend::collect_current_node_health(
+  node_report_filter filter, std::optional<int64_t> base_report_version) {
     vlog(clusterlog.debug, "collecting health report with filter: {}", filter);
+    // only reports of all the partitions can be versioned
+    const bool versioned = base_report_version.has_value()
+                           && filter.include_partitions
+                           && filter.ntp_filters.namespaces.empty();
     node_health_report ret;
     ret.id = _raft0->self().id();
 
@@ -635,6 +682,24 @@ health_monitor_backend::collect_current_node_health(node_report_filter filter) {
           std::move(filter.ntp_filters));
     }
 
+    if (versioned) {
+        const auto previous = _reported_version;
+        ret.report_version = ++_reported_version;
+        if (previous > 0 && *base_report_version == previous) {
+            make_node_health_report_delta(
+              ret, _reported_partitions, previous);
+        } else {
+            // full report, the requester doesn't hold the previous one
+            _reported_partitions.clear();
+            for (const auto& t : ret.topics) {
+                for (const auto& p : t.partitions) {
+                    _reported_partitions.emplace(
+                      model::ntp(t.tp_ns.ns, t.tp_ns.tp, p.id), p);
+                }
+            }
+        }
+    }
+
     co_return ret;
 }
 namespace {
@@ -649,8 +714,24 @@ struct ntp_report {
     model::ntp ntp;
     ntp_leader leader;
     size_t size_bytes;
+    uint64_t bytes_rate{0};
+    uint64_t requests_rate{0};
 };
 
+ntp_report make_ntp_report(const model::ntp& ntp, partition& p) {
+    return ntp_report{
+      .ntp = ntp,
+      .leader = ntp_leader{
+        .term = p.term(),
+        .leader_id = p.get_leader_id(),
+        .revision_id = p.get_revision_id(),
+      },
+      .size_bytes = p.size_bytes(),
+      .bytes_rate = p.probe().load().bytes_rate(),
+      .requests_rate = p.probe().load().requests_rate(),
+    };
+}
+
 partition_status to_partition_status(const ntp_report& ntpr) {
     return partition_status{
       .id = ntpr.ntp.tp.partition,
@@ -658,11 +739,14 @@ partition_status to_partition_status(const ntp_report& ntpr) {
       .leader_id = ntpr.leader.leader_id,
       .revision_id = ntpr.leader.revision_id,
       .size_bytes = ntpr.size_bytes,
+      .bytes_rate = ntpr.bytes_rate,
+      .requests_rate = ntpr.requests_rate,
     };
 }
 
 std::vector<ntp_report> collect_shard_local_reports(
   partition_manager& pm, const partitions_filter& filters) {
+    stall_tracker_section("health_report");
     std::vector<ntp_report> reports;
     // empty filter, collect all
     if (filters.namespaces.empty()) {
@@ -671,29 +755,11 @@ std::vector<ntp_report> collect_shard_local_reports(
           pm.partitions().begin(),
           pm.partitions().end(),
           std::back_inserter(reports),
-          [](auto& p) {
-              return ntp_report{
-                .ntp = p.first,
-                .leader = ntp_leader{
-                  .term = p.second->term(),
-                  .leader_id = p.second->get_leader_id(),
-                  .revision_id = p.second->get_revision_id(),
-                },
-                .size_bytes = p.second->size_bytes(),
-              };
-          });
+          [](auto& p) { return make_ntp_report(p.first, *p.second); });
     } else {
         for (const auto& [ntp, partition] : pm.partitions()) {
             if (filters.matches(ntp)) {
-                reports.push_back(ntp_report{
-                .ntp = ntp,
-                .leader = ntp_leader{
-                  .term = partition->term(),
-                  .leader_id = partition->get_leader_id(),
-                  .revision_id = partition->get_revision_id(),
-                },
-                .size_bytes = partition->size_bytes(),
-                });
+                reports.push_back(make_ntp_report(ntp, *partition));
             }
         }
     }
@@ -68,8 +68,15 @@ public:
     ss::future<storage::disk_space_alert> get_cluster_disk_health(
       force_refresh refresh, model::timeout_clock::time_point deadline);
 
-    ss::future<result<node_health_report>>
-      collect_current_node_health(node_report_filter);
+    /**
+     * Collects the report of this node. A versioned request (one with
+     * base_report_version set and no partition filtering) bumps the version
+     * of the reported state and returns a delta when base_report_version is
+     * the version that was last reported.
+     */
+    ss::future<result<node_health_report>> collect_current_node_health(
+      node_report_filter,
+      std::optional<int64_t> base_report_version = std::nullopt);
 
     cluster::notification_id_type register_node_callback(health_node_cb_t cb);
     void unregister_node_callback(cluster::notification_id_type id);
@@ -106,6 +113,11 @@ private:
         alive is_alive = alive::no;
     };
 
+    // every that many collections the controller asks for full reports, it
+    // bounds the lifetime of any divergence between a node and its cached
+    // report
+    static constexpr size_t full_report_interval = 10;
+
     using status_cache_t = absl::node_hash_map<model::node_id, node_state>;
     using report_cache_t
       = absl::node_hash_map<model::node_id, node_health_report>;
@@ -116,7 +128,7 @@ private:
     void tick();
     ss::future<std::error_code> collect_cluster_health();
     ss::future<result<node_health_report>>
-      collect_remote_node_health(model::node_id);
+      collect_remote_node_health(model::node_id, std::optional<int64_t>);
     ss::future<std::error_code> maybe_refresh_cluster_health(
       force_refresh, model::timeout_clock::time_point);
     ss::future<std::error_code> refresh_cluster_health_cache(force_refresh);
@@ -157,6 +169,7 @@ private:
 
     status_cache_t _status;
     report_cache_t _reports;
+    size_t _collections{0};
     storage::disk_space_alert _reports_disk_health
       = storage::disk_space_alert::ok;
     last_reply_cache_t _last_replies;
@@ -168,5 +181,9 @@ private:
     std::vector<std::pair<cluster::notification_id_type, health_node_cb_t>>
       _node_callbacks;
     cluster::notification_id_type _next_callback_id{0};
+
+    // state of the last versioned report this node sent
+    int64_t _reported_version{0};
+    reported_partitions_t _reported_partitions;
 };
 } // namespace cluster
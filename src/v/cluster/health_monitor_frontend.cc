@@ -11,6 +11,7 @@
 #include "cluster/health_monitor_frontend.h"
 
 #include "cluster/logger.h"
+#include "config/configuration.h"
 #include "model/timeout_clock.h"
 
 #include <seastar/util/later.hh>
@@ -23,8 +24,8 @@ health_monitor_frontend::health_monitor_frontend(
 
 ss::future<> health_monitor_frontend::start() {
     if (ss::this_shard_id() == refresher_shard) {
-        _refresh_timer.set_callback([this] { disk_health_tick(); });
-        _refresh_timer.arm(disk_health_refresh_interval);
+        _refresh_timer.set_callback([this] { cache_refresh_tick(); });
+        _refresh_timer.arm(cache_refresh_interval);
     }
     co_return;
 }
@@ -57,10 +58,13 @@ storage::disk_space_alert health_monitor_frontend::get_cluster_disk_health() {
 // Collcts and returns current node health report according to provided
 // filters list
 ss::future<result<node_health_report>>
-health_monitor_frontend::collect_node_health(node_report_filter f) {
+health_monitor_frontend::collect_node_health(
+  node_report_filter f, std::optional<int64_t> base_report_version) {
     return dispatch_to_backend(
-      [f = std::move(f)](health_monitor_backend& be) mutable {
-          return be.collect_current_node_health(std::move(f));
+      [f = std::move(f), base_report_version](
+        health_monitor_backend& be) mutable {
+          return be.collect_current_node_health(
+            std::move(f), base_report_version);
       });
 }
 
@@ -125,15 +129,30 @@ ss::future<> health_monitor_frontend::update_disk_health_cache() {
     }
 }
 
+ss::future<> health_monitor_frontend::update_nodes_status_cache() {
+    auto res = co_await get_nodes_status(model::time_from_now(
+      config::shard_local_cfg().metadata_status_wait_timeout_ms()));
+    std::optional<std::vector<node_state>> status;
+    if (res) {
+        status = std::move(res.value());
+    }
+    if (status == _nodes_status) {
+        co_return;
+    }
+    co_await container().invoke_on_all(
+      [&status](health_monitor_frontend& fe) { fe._nodes_status = status; });
+}
+
 // Handler for refresh_shard's update timer
-void health_monitor_frontend::disk_health_tick() {
+void health_monitor_frontend::cache_refresh_tick() {
     if (_refresh_gate.is_closed()) {
         return;
     }
     ssx::spawn_with_gate(_refresh_gate, [this]() {
         // Ensure that this node's cluster health data is not too stale.
-        return update_disk_health_cache().finally(
-          [this] { _refresh_timer.arm(disk_health_refresh_interval); });
+        return update_disk_health_cache()
+          .finally([this] { return update_nodes_status_cache(); })
+          .finally([this] { _refresh_timer.arm(cache_refresh_interval); });
     });
 }
 
@@ -30,13 +30,14 @@ namespace cluster {
  * Health monitor frontend is available on every node and dispatches requests to
  * health monitor backend which lives on single shard.
  * Most requests are forwarded to the backend shard, except cluster-level disk
- * health, which is kept cached on each core for fast access.
+ * health and the status of the nodes, which are kept cached on each core for
+ * fast access.
  */
 class health_monitor_frontend
   : public seastar::peering_sharded_service<health_monitor_frontend> {
 public:
     static constexpr auto default_timeout = std::chrono::seconds(5);
-    static constexpr std::chrono::seconds disk_health_refresh_interval{5};
+    static constexpr std::chrono::seconds cache_refresh_interval{5};
     static constexpr ss::shard_id refresher_shard
       = cluster::controller_stm_shard;
 
@@ -54,14 +55,23 @@ public:
     storage::disk_space_alert get_cluster_disk_health();
 
     // Collcts and returns current node health report according to provided
-    // filters list
-    ss::future<result<node_health_report>>
-      collect_node_health(node_report_filter);
+    // filters list. When base_report_version is set the report may be an
+    // incremental one based on that version.
+    ss::future<result<node_health_report>> collect_node_health(
+      node_report_filter,
+      std::optional<int64_t> base_report_version = std::nullopt);
 
     // Return status of all nodes
     ss::future<result<std::vector<node_state>>>
       get_nodes_status(model::timeout_clock::time_point);
 
+    // Status of all nodes as of the last refresh of the shard local cache,
+    // std::nullopt if it could not be refreshed
+    const std::optional<std::vector<node_state>>&
+    get_cached_nodes_status() const {
+        return _nodes_status;
+    }
+
     /**
      * Return drain status for a given node.
      */
@@ -94,11 +104,15 @@ private:
     // Currently the worst / max of all nodes' disk space state
     storage::disk_space_alert _cluster_disk_health{
       storage::disk_space_alert::ok};
+    // refreshed together with the disk health, so that serving it, e.g. to
+    // every kafka metadata request, does not reach the backend shard
+    std::optional<std::vector<node_state>> _nodes_status;
     ss::timer<ss::lowres_clock> _refresh_timer;
     ss::gate _refresh_gate;
 
-    void disk_health_tick();
+    void cache_refresh_tick();
     ss::future<> update_other_shards(const storage::disk_space_alert);
     ss::future<> update_disk_health_cache();
+    ss::future<> update_nodes_status_cache();
 };
 } // namespace cluster
@@ -16,6 +16,7 @@
 #include "model/adl_serde.h"
 #include "utils/to_string.h"
 
+#include <absl/container/flat_hash_map.h>
 #include <fmt/ostream.h>
 
 #include <chrono>
@@ -49,6 +50,123 @@ bool partitions_filter::matches(
     return false;
 }
 
+void make_node_health_report_delta(
+  node_health_report& report,
+  reported_partitions_t& reported,
+  int64_t base_version) {
+    reported_partitions_t current;
+    current.reserve(reported.size());
+    std::vector<topic_status> changed;
+    for (auto& t : report.topics) {
+        topic_status changed_topic{.tp_ns = t.tp_ns};
+        for (auto& p : t.partitions) {
+            model::ntp ntp(t.tp_ns.ns, t.tp_ns.tp, p.id);
+            auto it = reported.find(ntp);
+            if (it == reported.end() || it->second != p) {
+                changed_topic.partitions.push_back(p);
+            }
+            if (it != reported.end()) {
+                reported.erase(it);
+            }
+            current.emplace(std::move(ntp), p);
+        }
+        if (!changed_topic.partitions.empty()) {
+            changed.push_back(std::move(changed_topic));
+        }
+    }
+    // whatever is left was reported before but is not there anymore
+    report.removed_partitions.reserve(reported.size());
+    for (auto& [ntp, _] : reported) {
+        report.removed_partitions.push_back(ntp);
+    }
+    report.topics = std::move(changed);
+    report.delta_base_version = base_version;
+    reported = std::move(current);
+}
+
+node_health_report apply_node_health_report_delta(
+  node_health_report base, node_health_report delta) {
+    using partition_idx_t = absl::flat_hash_map<model::partition_id, size_t>;
+    struct topic_idx {
+        size_t topic;
+        // built lazily, only touched topics are indexed
+        std::optional<partition_idx_t> partitions;
+    };
+    absl::flat_hash_map<
+      model::topic_namespace,
+      topic_idx,
+      model::topic_namespace_hash,
+      model::topic_namespace_eq>
+      topics;
+    topics.reserve(base.topics.size());
+    for (size_t i = 0; i < base.topics.size(); ++i) {
+        topics.emplace(base.topics[i].tp_ns, topic_idx{.topic = i});
+    }
+
+    auto partitions_of = [&base](topic_idx& idx) -> partition_idx_t& {
+        if (!idx.partitions) {
+            auto& ps = base.topics[idx.topic].partitions;
+            idx.partitions.emplace();
+            idx.partitions->reserve(ps.size());
+            for (size_t i = 0; i < ps.size(); ++i) {
+                idx.partitions->emplace(ps[i].id, i);
+            }
+        }
+        return *idx.partitions;
+    };
+
+    for (auto& ntp : delta.removed_partitions) {
+        auto it = topics.find(model::topic_namespace_view(ntp));
+        if (it == topics.end()) {
+            continue;
+        }
+        auto& p_idx = partitions_of(it->second);
+        auto p_it = p_idx.find(ntp.tp.partition);
+        if (p_it == p_idx.end()) {
+            continue;
+        }
+        // swap with the last partition to keep removal constant time
+        auto& ps = base.topics[it->second.topic].partitions;
+        auto pos = p_it->second;
+        p_idx.erase(p_it);
+        if (pos != ps.size() - 1) {
+            ps[pos] = std::move(ps.back());
+            p_idx[ps[pos].id] = pos;
+        }
+        ps.pop_back();
+    }
+
+    for (auto& t : delta.topics) {
+        auto it = topics.find(t.tp_ns);
+        if (it == topics.end()) {
+            topics.emplace(t.tp_ns, topic_idx{.topic = base.topics.size()});
+            base.topics.push_back(std::move(t));
+            continue;
+        }
+        auto& p_idx = partitions_of(it->second);
+        auto& ps = base.topics[it->second.topic].partitions;
+        for (auto& p : t.partitions) {
+            if (auto p_it = p_idx.find(p.id); p_it != p_idx.end()) {
+                ps[p_it->second] = p;
+            } else {
+                p_idx.emplace(p.id, ps.size());
+                ps.push_back(p);
+            }
+        }
+    }
+
+    std::erase_if(
+      base.topics, [](const topic_status& t) { return t.partitions.empty(); });
+
+    base.local_state = std::move(delta.local_state);
+    base.drain_status = std::move(delta.drain_status);
+    base.include_drain_status = delta.include_drain_status;
+    base.report_version = delta.report_version;
+    base.delta_base_version = std::nullopt;
+    base.removed_partitions.clear();
+    return base;
+}
+
 std::ostream& operator<<(std::ostream& o, const node_state& s) {
     fmt::print(
       o,
@@ -62,14 +180,18 @@ std::ostream& operator<<(std::ostream& o, const node_health_report& r) {
     fmt::print(
       o,
       "{{id: {}, disks: {}, topics: {}, redpanda_version: {}, uptime: "
-      "{}, logical_version: {}, drain_status: {}}}",
+      "{}, logical_version: {}, drain_status: {}, report_version: {}, "
+      "delta_base_version: {}, removed_partitions: {}}}",
       r.id,
       r.local_state.disks,
       r.topics,
       r.local_state.redpanda_version,
       r.local_state.uptime,
       r.local_state.logical_version,
-      r.drain_status);
+      r.drain_status,
+      r.report_version,
+      r.delta_base_version,
+      r.removed_partitions);
     return o;
 }
 
@@ -86,12 +208,15 @@ std::ostream& operator<<(std::ostream& o, const cluster_health_report& r) {
 std::ostream& operator<<(std::ostream& o, const partition_status& ps) {
     fmt::print(
       o,
-      "{{id: {}, term: {}, leader_id: {}, revision_id: {}, size_bytes: {}}}",
+      "{{id: {}, term: {}, leader_id: {}, revision_id: {}, size_bytes: {}, "
+      "bytes_rate: {}, requests_rate: {}}}",
       ps.id,
       ps.term,
       ps.leader_id,
       ps.revision_id,
-      ps.size_bytes);
+      ps.size_bytes,
+      ps.bytes_rate,
+      ps.requests_rate);
     return o;
 }
 
@@ -140,7 +265,11 @@ std::ostream& operator<<(std::ostream& o, const partitions_filter& filter) {
 
 std::ostream& operator<<(std::ostream& o, const get_node_health_request& r) {
     fmt::print(
-      o, "{{filter: {}, current_version: {}}}", r.filter, r.current_version);
+      o,
+      "{{filter: {}, current_version: {}, base_report_version: {}}}",
+      r.filter,
+      r.current_version,
+      r.base_report_version);
     return o;
 }
 
@@ -52,7 +52,11 @@ struct node_state : serde::envelope<node_state, serde::version<0>> {
     auto serde_fields() { return std::tie(id, membership_state, is_alive); }
 };
 
-struct partition_status : serde::envelope<partition_status, serde::version<0>> {
+struct partition_status
+  : serde::envelope<
+      partition_status,
+      serde::version<1>,
+      serde::compat_version<0>> {
     /**
      * We increase a version here 'backward' since incorrect assertion would
      * cause older redpanda versions to crash.
@@ -76,9 +80,20 @@ struct partition_status : serde::envelope<partition_status, serde::version<0>> {
     std::optional<model::node_id> leader_id;
     model::revision_id revision_id;
     size_t size_bytes;
+    // produce and fetch load handled by the replica, see
+    // partition_load_meter. serde only, version 1.
+    uint64_t bytes_rate{0};
+    uint64_t requests_rate{0};
 
     auto serde_fields() {
-        return std::tie(id, term, leader_id, revision_id, size_bytes);
+        return std::tie(
+          id,
+          term,
+          leader_id,
+          revision_id,
+          size_bytes,
+          bytes_rate,
+          requests_rate);
     }
 
     friend std::ostream& operator<<(std::ostream&, const partition_status&);
@@ -102,7 +117,10 @@ struct topic_status : serde::envelope<topic_status, serde::version<0>> {
  * instance of time
  */
 struct node_health_report
-  : serde::envelope<node_health_report, serde::version<0>> {
+  : serde::envelope<
+      node_health_report,
+      serde::version<1>,
+      serde::compat_version<0>> {
     static constexpr int8_t current_version = 2;
 
     model::node_id id;
@@ -138,8 +156,32 @@ struct node_health_report
     bool include_drain_status{false}; // not serialized
     std::optional<drain_manager::drain_status> drain_status;
 
+    /*
+     * Incremental reports (serde only, version 1)
+     *
+     * A node versions the reports it sends to the controller. When the
+     * controller asks for a report relative to the version it holds, and that
+     * version is the last one the node sent, the node replies with a delta:
+     * `topics` only contains the partitions that changed since then and
+     * `removed_partitions` the ones that are gone. `delta_base_version` is set
+     * to the version the delta applies to. A report without
+     * `delta_base_version` is a full report.
+     */
+    int64_t report_version{0};
+    std::optional<int64_t> delta_base_version;
+    std::vector<model::ntp> removed_partitions;
+
+    bool is_delta() const { return delta_base_version.has_value(); }
+
     auto serde_fields() {
-        return std::tie(id, local_state, topics, drain_status);
+        return std::tie(
+          id,
+          local_state,
+          topics,
+          drain_status,
+          report_version,
+          delta_base_version,
+          removed_partitions);
     }
 
     friend std::ostream& operator<<(std::ostream&, const node_health_report&);
@@ -150,10 +192,36 @@ struct node_health_report
         // encoding. once adl is fully deprecated, the field can be removed and
         // this changed to defaulted operator==.
         return a.id == b.id && a.local_state == b.local_state
-               && a.topics == b.topics && a.drain_status == b.drain_status;
+               && a.topics == b.topics && a.drain_status == b.drain_status
+               && a.report_version == b.report_version
+               && a.delta_base_version == b.delta_base_version
+               && a.removed_partitions == b.removed_partitions;
     }
 };
 
+/**
+ * Partition state of the last report a node sent to the controller, used to
+ * build the next incremental report.
+ */
+using reported_partitions_t
+  = absl::node_hash_map<model::ntp, partition_status>;
+
+/**
+ * Turns the full report into a delta against the previously reported
+ * partitions and replaces `reported` with the partitions of the full report.
+ */
+void make_node_health_report_delta(
+  node_health_report& report,
+  reported_partitions_t& reported,
+  int64_t base_version);
+
+/**
+ * Applies an incremental report on top of the full report it is based on.
+ * The result is a full report with the version of the delta.
+ */
+node_health_report
+apply_node_health_report_delta(node_health_report base, node_health_report);
+
 struct cluster_health_report
   : serde::envelope<cluster_health_report, serde::version<0>> {
     static constexpr int8_t current_version = 0;
@@ -257,7 +325,10 @@ using force_refresh = ss::bool_class<struct hm_force_refresh_tag>;
  */
 
 struct get_node_health_request
-  : serde::envelope<get_node_health_request, serde::version<0>> {
+  : serde::envelope<
+      get_node_health_request,
+      serde::version<1>,
+      serde::compat_version<0>> {
     static constexpr int8_t initial_version = 0;
     // version -1: included revision id in partition status
     static constexpr int8_t revision_id_version = -1;
@@ -269,6 +340,9 @@ struct get_node_health_request
     node_report_filter filter;
     // this field is not serialized
     int8_t decoded_version = current_version;
+    // version of the report the requester holds, when set the node may reply
+    // with an incremental report based on it. serde only, version 1.
+    std::optional<int64_t> base_report_version;
 
     friend bool
     operator==(const get_node_health_request&, const get_node_health_request&)
@@ -277,7 +351,7 @@ struct get_node_health_request
     friend std::ostream&
     operator<<(std::ostream&, const get_node_health_request&);
 
-    auto serde_fields() { return std::tie(filter); }
+    auto serde_fields() { return std::tie(filter, base_report_version); }
 };
 
 struct get_node_health_reply
@@ -31,4 +31,10 @@ id_allocator::allocate_id(allocate_id_request&& req, rpc::streaming_context&) {
     return _id_allocator_frontend.local().do_allocate_id(req.timeout);
 }
 
+ss::future<allocate_id_range_reply> id_allocator::allocate_id_range(
+  allocate_id_range_request&& req, rpc::streaming_context&) {
+    return _id_allocator_frontend.local().do_allocate_id_range(
+      req.count, req.timeout);
+}
+
 } // namespace cluster
@@ -10,6 +10,7 @@
 #include "cluster/id_allocator_frontend.h"
 
 #include "cluster/controller.h"
+#include "cluster/feature_table.h"
 #include "cluster/id_allocator_service.h"
 #include "cluster/logger.h"
 #include "cluster/metadata_cache.h"
@@ -23,6 +24,7 @@
 #include "model/namespace.h"
 #include "model/record_batch_reader.h"
 #include "rpc/connection_cache.h"
+#include "ssx/future-util.h"
 #include "vformat.h"
 
 #include <seastar/core/coroutine.hh>
@@ -57,6 +59,85 @@ id_allocator_frontend::id_allocator_frontend(
 
 ss::future<allocate_id_reply>
 id_allocator_frontend::allocate_id(model::timeout_clock::duration timeout) {
+    if (use_local_ids()) {
+        if (_local_ids_available == 0) {
+            co_await refill_local_ids(timeout);
+        }
+        if (auto id = take_local_id(); id) {
+            maybe_refill_local_ids(timeout);
+            co_return allocate_id_reply{*id, errc::success};
+        }
+    }
+    co_return co_await allocate_id_from_leader(timeout);
+}
+
+bool id_allocator_frontend::use_local_ids() const {
+    return config::shard_local_cfg().id_allocator_local_range_size() > 0
+           && _controller->get_feature_table().local().is_active(
+             feature::id_allocator_ranges);
+}
+
+std::optional<int64_t> id_allocator_frontend::take_local_id() {
+    if (_local_ids.empty()) {
+        return std::nullopt;
+    }
+    auto& range = _local_ids.front();
+    auto id = range.next++;
+    if (range.next == range.end) {
+        _local_ids.pop_front();
+    }
+    --_local_ids_available;
+    return id;
+}
+
+void id_allocator_frontend::maybe_refill_local_ids(
+  model::timeout_clock::duration timeout) {
+    auto range_size = config::shard_local_cfg().id_allocator_local_range_size();
+    if (_refill_pending || _local_ids_available > range_size / 4) {
+        return;
+    }
+    _refill_pending = true;
+    ssx::spawn_with_gate(_gate, [this, timeout] {
+        return refill_local_ids(timeout).finally(
+          [this] { _refill_pending = false; });
+    });
+}
+
+ss::future<> id_allocator_frontend::refill_local_ids(
+  model::timeout_clock::duration timeout) {
+    if (_gate.is_closed()) {
+        co_return;
+    }
+    auto holder = _gate.hold();
+    auto units = co_await _refill_lock.get_units();
+
+    // a concurrent refill may have leased a range while we were waiting
+    int64_t range_size
+      = config::shard_local_cfg().id_allocator_local_range_size();
+    if (_local_ids_available > range_size / 4) {
+        co_return;
+    }
+
+    allocate_id_range_reply r;
+    try {
+        r = co_await allocate_id_range(range_size, timeout);
+    } catch (...) {
+        vlog(
+          clusterlog.debug,
+          "leasing an id range failed: {}",
+          std::current_exception());
+        co_return;
+    }
+    if (r.ec != errc::success || r.count <= 0) {
+        vlog(clusterlog.debug, "leasing an id range failed with {}", r.ec);
+        co_return;
+    }
+    _local_ids.push_back(id_range{.next = r.id, .end = r.id + r.count});
+    _local_ids_available += r.count;
+}
+
+ss::future<allocate_id_reply> id_allocator_frontend::allocate_id_from_leader(
+  model::timeout_clock::duration timeout) {
     auto nt = model::topic_namespace(
       model::kafka_internal_namespace, model::id_allocator_topic);
 
@@ -216,6 +297,82 @@ ss::future<allocate_id_reply> id_allocator_frontend::do_allocate_id(
       });
 }
 
+ss::future<allocate_id_range_reply> id_allocator_frontend::allocate_id_range(
+  int64_t count, model::timeout_clock::duration timeout) {
+    auto leader = _leaders.local().get_leader(model::id_allocator_ntp);
+    if (!leader) {
+        co_return allocate_id_range_reply{.ec = errc::no_leader_controller};
+    }
+    if (*leader == _controller->self()) {
+        co_return co_await do_allocate_id_range(count, timeout);
+    }
+    co_return co_await dispatch_allocate_id_range_to_leader(
+      *leader, count, timeout);
+}
+
+ss::future<allocate_id_range_reply>
+id_allocator_frontend::dispatch_allocate_id_range_to_leader(
+  model::node_id leader,
+  int64_t count,
+  model::timeout_clock::duration timeout) {
+    return _connection_cache.local()
+      .with_node_client<cluster::id_allocator_client_protocol>(
+        _controller->self(),
+        ss::this_shard_id(),
+        leader,
+        timeout,
+        [count, timeout](id_allocator_client_protocol cp) {
+            return cp.allocate_id_range(
+              allocate_id_range_request{.count = count, .timeout = timeout},
+              rpc::client_opts(model::timeout_clock::now() + timeout));
+        })
+      .then(&rpc::get_ctx_data<allocate_id_range_reply>)
+      .then([](result<allocate_id_range_reply> r) {
+          if (r.has_error()) {
+              vlog(
+                clusterlog.debug,
+                "got error {} on remote allocate_id_range",
+                r.error());
+              return allocate_id_range_reply{.ec = errc::timeout};
+          }
+          return r.value();
+      });
+}
+
+ss::future<allocate_id_range_reply>
+id_allocator_frontend::do_allocate_id_range(
+  int64_t count, model::timeout_clock::duration timeout) {
+    auto shard = _shard_table.local().shard_for(model::id_allocator_ntp);
+    if (!shard) {
+        return ss::make_ready_future<allocate_id_range_reply>(
+          allocate_id_range_reply{.ec = errc::no_leader_controller});
+    }
+    return do_allocate_id_range(*shard, count, timeout);
+}
+
+ss::future<allocate_id_range_reply>
+id_allocator_frontend::do_allocate_id_range(
+  ss::shard_id shard, int64_t count, model::timeout_clock::duration timeout) {
+    return _partition_manager.invoke_on(
+      shard, _ssg, [count, timeout](cluster::partition_manager& mgr) {
+          auto partition = mgr.get(model::id_allocator_ntp);
+          if (!partition || !partition->id_allocator_stm()) {
+              return ss::make_ready_future<allocate_id_range_reply>(
+                allocate_id_range_reply{.ec = errc::topic_not_exists});
+          }
+          return partition->id_allocator_stm()
+            ->allocate_id_range(count, timeout)
+            .then([](id_allocator_stm::stm_allocation_result r) {
+                if (r.raft_status != raft::errc::success) {
+                    return allocate_id_range_reply{
+                      .ec = errc::replication_error};
+                }
+                return allocate_id_range_reply{
+                  .id = r.id, .count = r.count, .ec = errc::success};
+            });
+      });
+}
+
 ss::future<bool> id_allocator_frontend::try_create_id_allocator_topic() {
     cluster::topic_configuration topic{
       model::kafka_internal_namespace,
@@ -12,10 +12,13 @@
 #pragma once
 #include "cluster/types.h"
 #include "rpc/fwd.h"
+#include "utils/mutex.h"
 
 #include <seastar/core/abort_source.hh>
+#include <seastar/core/gate.hh>
 #include <seastar/core/sharded.hh>
 
+#include <deque>
 #include <vector>
 
 namespace cluster {
@@ -35,6 +38,14 @@ class id_allocator;
 //
 // when the service recieves a call it triggers id_allocator_frontend
 // which in its own turn pass the request to the id_allocator_stm
+//
+// once the id_allocator_ranges feature is active each shard leases ranges
+// of `id_allocator_local_range_size` ids and serves allocate_id from them
+// without leaving the shard. the next range is leased in the background
+// when the ids left drop to a quarter of a range. leased ranges stay valid
+// across leadership changes because the stm persists a batch before it
+// hands out any of its ids. when a lease fails the frontend falls back to
+// allocating a single id from the leader.
 class id_allocator_frontend {
 public:
     id_allocator_frontend(
@@ -51,11 +62,17 @@ public:
 
     ss::future<> stop() {
         _as.request_abort();
-        return ss::make_ready_future<>();
+        return _gate.close();
     }
 
 private:
+    struct id_range {
+        int64_t next;
+        int64_t end;
+    };
+
     ss::abort_source _as;
+    ss::gate _gate;
     ss::smp_service_group _ssg;
     ss::sharded<cluster::partition_manager>& _partition_manager;
     ss::sharded<cluster::shard_table>& _shard_table;
@@ -66,6 +83,19 @@ private:
     int16_t _metadata_dissemination_retries{1};
     std::chrono::milliseconds _metadata_dissemination_retry_delay_ms;
 
+    std::deque<id_range> _local_ids;
+    int64_t _local_ids_available{0};
+    bool _refill_pending{false};
+    mutex _refill_lock;
+
+    bool use_local_ids() const;
+    std::optional<int64_t> take_local_id();
+    void maybe_refill_local_ids(model::timeout_clock::duration);
+    ss::future<> refill_local_ids(model::timeout_clock::duration);
+
+    ss::future<allocate_id_reply>
+      allocate_id_from_leader(model::timeout_clock::duration);
+
     ss::future<allocate_id_reply> dispatch_allocate_id_to_leader(
       model::node_id, model::timeout_clock::duration);
 
@@ -75,6 +105,18 @@ private:
     ss::future<allocate_id_reply>
       do_allocate_id(ss::shard_id, model::timeout_clock::duration);
 
+    ss::future<allocate_id_range_reply>
+      allocate_id_range(int64_t, model::timeout_clock::duration);
+
+    ss::future<allocate_id_range_reply> dispatch_allocate_id_range_to_leader(
+      model::node_id, int64_t, model::timeout_clock::duration);
+
+    ss::future<allocate_id_range_reply>
+      do_allocate_id_range(int64_t, model::timeout_clock::duration);
+
+    ss::future<allocate_id_range_reply> do_allocate_id_range(
+      ss::shard_id, int64_t, model::timeout_clock::duration);
+
     ss::future<bool> try_create_id_allocator_topic();
 
     friend id_allocator;
@@ -88,33 +88,45 @@ ss::future<bool> id_allocator_stm::set_state(
 
 ss::future<id_allocator_stm::stm_allocation_result>
 id_allocator_stm::allocate_id(model::timeout_clock::duration timeout) {
+    return allocate_id_range(1, timeout);
+}
+
+ss::future<id_allocator_stm::stm_allocation_result>
+id_allocator_stm::allocate_id_range(
+  int64_t count, model::timeout_clock::duration timeout) {
     return _lock
-      .with(timeout, [this, timeout]() { return do_allocate_id(timeout); })
+      .with(
+        timeout,
+        [this, count, timeout]() { return do_allocate_id(count, timeout); })
       .handle_exception_type([](const ss::semaphore_timed_out&) {
           return stm_allocation_result{-1, raft::errc::timeout};
       });
 }
 
 ss::future<id_allocator_stm::stm_allocation_result>
-id_allocator_stm::do_allocate_id(model::timeout_clock::duration timeout) {
+id_allocator_stm::do_allocate_id(
+  int64_t count, model::timeout_clock::duration timeout) {
     if (!co_await sync(timeout)) {
         co_return stm_allocation_result{-1, raft::errc::timeout};
     }
 
     if (_curr_batch == 0) {
+        // a range larger than the batch gets a batch of its own
+        auto batch_size = std::max<int64_t>(_batch_size, count);
         _curr_id = _state;
-        if (!co_await set_state(_curr_id + _batch_size, timeout)) {
+        if (!co_await set_state(_curr_id + batch_size, timeout)) {
             co_return stm_allocation_result{-1, raft::errc::timeout};
         }
-        _curr_batch = _batch_size;
+        _curr_batch = batch_size;
     }
 
     auto id = _curr_id;
+    auto allocated = std::min(std::max<int64_t>(count, 1), _curr_batch);
 
-    _curr_id += 1;
-    _curr_batch -= 1;
+    _curr_id += allocated;
+    _curr_batch -= allocated;
 
-    co_return stm_allocation_result{id, raft::errc::success};
+    co_return stm_allocation_result{id, raft::errc::success, allocated};
 }
 
 ss::future<> id_allocator_stm::apply(model::record_batch b) {
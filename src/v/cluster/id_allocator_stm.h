@@ -36,6 +36,8 @@ public:
     struct stm_allocation_result {
         int64_t id;
         raft::errc raft_status{raft::errc::success};
+        // number of consecutive ids allocated starting at `id`
+        int64_t count{1};
     };
 
     explicit id_allocator_stm(ss::logger&, raft::consensus*);
@@ -46,6 +48,11 @@ public:
     ss::future<stm_allocation_result>
     allocate_id(model::timeout_clock::duration timeout);
 
+    // allocates up to `count` consecutive ids, the range is cut short when
+    // the current batch can't fit it
+    ss::future<stm_allocation_result>
+    allocate_id_range(int64_t count, model::timeout_clock::duration timeout);
+
 private:
     // legacy structs left for backward compatibility with the "old"
     // on-disk log format
@@ -92,7 +99,7 @@ private:
     };
 
     ss::future<stm_allocation_result>
-      do_allocate_id(model::timeout_clock::duration);
+      do_allocate_id(int64_t, model::timeout_clock::duration);
     ss::future<bool> set_state(int64_t, model::timeout_clock::duration);
 
     ss::future<> apply(model::record_batch) override;
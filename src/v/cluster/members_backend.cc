@@ -2,6 +2,8 @@
 
 #include "cluster/controller_api.h"
 #include "cluster/fwd.h"
+#include "cluster/health_monitor_frontend.h"
+#include "cluster/health_monitor_types.h"
 #include "cluster/logger.h"
 #include "cluster/members_frontend.h"
 #include "cluster/members_manager.h"
@@ -42,6 +44,7 @@ members_backend::members_backend(
   ss::sharded<controller_api>& api,
   ss::sharded<members_manager>& members_manager,
   ss::sharded<members_frontend>& members_frontend,
+  ss::sharded<health_monitor_frontend>& health_monitor,
   consensus_ptr raft0,
   ss::sharded<ss::abort_source>& as)
   : _topics_frontend(topics_frontend)
@@ -51,6 +54,7 @@ members_backend::members_backend(
   , _api(api)
   , _members_manager(members_manager)
   , _members_frontend(members_frontend)
+  , _health_monitor(health_monitor)
   , _raft0(raft0)
   , _as(as)
   , _retry_timeout(config::shard_local_cfg().members_backend_retry_ms()) {
@@ -76,6 +80,37 @@ void members_backend::setup_metrics() {
           "queued_node_operations",
           [this] { return _updates.size(); },
           sm::description("Number of queued node operations")),
+        sm::make_gauge(
+          "partition_moves_in_progress",
+          [this] { return _movement_scheduler.in_progress(); },
+          sm::description(
+            "Number of partition moves of the current node operation in "
+            "progress")),
+        sm::make_gauge(
+          "partition_moves_pending",
+          [this] { return _movement_stats.pending; },
+          sm::description(
+            "Number of partition moves of the current node operation waiting "
+            "to start")),
+        sm::make_gauge(
+          "partition_movement_bytes_left",
+          [this] { return _movement_stats.bytes_left; },
+          sm::description(
+            "Bytes left to move to finish the current node operation")),
+        sm::make_gauge(
+          "partition_movement_throughput",
+          [this] { return _movement_scheduler.throughput().value_or(0); },
+          sm::description(
+            "Bytes per second moved by the current node operation")),
+        sm::make_gauge(
+          "partition_movement_eta_seconds",
+          [this] {
+              return _movement_scheduler.eta(_movement_stats.bytes_left)
+                .value_or(std::chrono::seconds(0))
+                .count();
+          },
+          sm::description("Estimated time left to finish the partition moves "
+                          "of the current node operation")),
       });
 }
 void members_backend::start() {
@@ -412,8 +447,12 @@ ss::future<> members_backend::reconcile() {
         }
     }
     // remove finished updates
-    std::erase_if(
+    auto removed = std::erase_if(
       _updates, [](const update_meta& meta) { return meta.finished; });
+    if (removed > 0) {
+        _movement_scheduler.reset_progress();
+        _movement_stats = {};
+    }
 
     if (!_raft0->is_elected_leader() || _updates.empty()) {
         co_return;
@@ -494,12 +533,8 @@ ss::future<> members_backend::reconcile() {
         }
     }
 
-    // execute reallocations
-    co_await ss::parallel_for_each(
-      meta.partition_reallocations,
-      [this](partition_reallocation& reallocation) {
-          return reallocate_replica_set(reallocation);
-      });
+    co_await update_reallocation_stats(meta);
+    co_await execute_reallocations(meta);
 
     // remove those decommissioned nodes which doesn't have any pending
     // reallocations
@@ -604,6 +639,175 @@ members_backend::try_to_finish_update(members_backend::update_meta& meta) {
     }
 }
 
+partition_movement_scheduler::limits members_backend::movement_limits() const {
+    return {
+      .max_concurrent_per_node
+      = config::shard_local_cfg().partition_movement_max_concurrent_per_node(),
+      .bandwidth
+      = config::shard_local_cfg().partition_movement_bandwidth_limit(),
+    };
+}
+
+/**
+ * Updates the sizes of the partitions waiting to be moved, and how many of
+ * their replicas are on nodes that are down, from the cached cluster health
+ * report. If the report is not available the previous values are kept.
+ */
+ss::future<> members_backend::update_reallocation_stats(update_meta& meta) {
+    auto report = co_await _health_monitor.local().get_cluster_health(
+      cluster_report_filter{},
+      force_refresh::no,
+      model::timeout_clock::now() + _retry_timeout);
+    if (!report) {
+        vlog(
+          clusterlog.debug,
+          "[update: {}] unable to get cluster health report - {}",
+          meta.update,
+          report.error().message());
+        co_return;
+    }
+
+    absl::flat_hash_set<model::node_id> unavailable_nodes;
+    for (const auto& state : report.value().node_states) {
+        if (!state.is_alive) {
+            unavailable_nodes.insert(state.id);
+        }
+    }
+    absl::flat_hash_map<model::ntp, size_t> sizes;
+    for (const auto& node_report : report.value().node_reports) {
+        for (const auto& topic : node_report.topics) {
+            for (const auto& p : topic.partitions) {
+                auto& size = sizes[model::ntp(
+                  topic.tp_ns.ns, topic.tp_ns.tp, p.id)];
+                size = std::max(size, p.size_bytes);
+            }
+        }
+    }
+
+    for (auto& reallocation : meta.partition_reallocations) {
+        if (reallocation.state != reallocation_state::initial) {
+            continue;
+        }
+        if (auto it = sizes.find(reallocation.ntp); it != sizes.end()) {
+            reallocation.size_bytes = it->second;
+        }
+        auto assignment = _topics.local().get_partition_assignment(
+          reallocation.ntp);
+        if (assignment) {
+            reallocation.unavailable_replicas = std::count_if(
+              assignment->replicas.begin(),
+              assignment->replicas.end(),
+              [&unavailable_nodes](const model::broker_shard& bs) {
+                  return unavailable_nodes.contains(bs.node_id);
+              });
+        }
+    }
+}
+
+/**
+ * Moves in progress and cancellations are always driven forward, new moves
+ * are started within the limits of the movement scheduler. Partitions with
+ * replicas on nodes that are down are moved first since they are the least
+ * durable, then smaller partitions first for the most progress with the
+ * bandwidth budget.
+ */
+ss::future<> members_backend::execute_reallocations(update_meta& meta) {
+    _movement_scheduler.start_round(movement_limits(), ss::lowres_clock::now());
+
+    std::vector<partition_reallocation*> to_execute;
+    std::vector<partition_reallocation*> pending;
+    for (auto& reallocation : meta.partition_reallocations) {
+        switch (reallocation.state) {
+        case reallocation_state::initial:
+            pending.push_back(&reallocation);
+            break;
+        case reallocation_state::reassigned:
+        case reallocation_state::requested:
+            _movement_scheduler.add_in_progress(reallocation.target_nodes());
+            to_execute.push_back(&reallocation);
+            break;
+        case reallocation_state::request_cancel:
+        case reallocation_state::cancelled:
+            to_execute.push_back(&reallocation);
+            break;
+        case reallocation_state::finished:
+            break;
+        }
+    }
+
+    std::stable_sort(
+      pending.begin(),
+      pending.end(),
+      [](const partition_reallocation* a, const partition_reallocation* b) {
+          if (a->unavailable_replicas != b->unavailable_replicas) {
+              return a->unavailable_replicas > b->unavailable_replicas;
+          }
+          return a->size_bytes < b->size_bytes;
+      });
+
+    const auto nodes_count = _allocator.local().state().available_nodes();
+    _movement_stats = {};
+    for (auto* reallocation : pending) {
+        if (!_movement_scheduler.saturated(nodes_count)) {
+            auto current_assignment
+              = _topics.local().get_partition_assignment(reallocation->ntp);
+            // topic was deleted, we are done with reallocation
+            if (!current_assignment) {
+                reallocation->state = reallocation_state::finished;
+                continue;
+            }
+            reallocation->current_replica_set = current_assignment->replicas;
+            reassign_replicas(*current_assignment, *reallocation);
+            if (!reallocation->new_replica_set.empty()) {
+                if (_movement_scheduler.try_start(
+                      reallocation->target_nodes(),
+                      reallocation->size_bytes)) {
+                    reallocation->state = reallocation_state::reassigned;
+                    vlog(
+                      clusterlog.info,
+                      "[ntp: {}, {} -> {}] new partition assignment "
+                      "calculated successfully",
+                      reallocation->ntp,
+                      reallocation->current_replica_set,
+                      reallocation->new_replica_set);
+                    to_execute.push_back(reallocation);
+                    continue;
+                }
+                // throttled, allocate again when it is admitted
+                reallocation->release_assignment_units();
+                reallocation->new_replica_set.clear();
+            }
+        }
+        ++_movement_stats.pending;
+        _movement_stats.bytes_left += reallocation->size_bytes;
+    }
+
+    co_await ss::parallel_for_each(
+      to_execute, [this](partition_reallocation* reallocation) {
+          return reallocate_replica_set(*reallocation);
+      });
+
+    for (auto* reallocation : to_execute) {
+        if (
+          reallocation->state == reallocation_state::reassigned
+          || reallocation->state == reallocation_state::requested) {
+            _movement_stats.bytes_left += reallocation->size_bytes;
+        }
+    }
+
+    auto eta = _movement_scheduler.eta(_movement_stats.bytes_left);
+    vlog(
+      clusterlog.info,
+      "[update: {}] partition moves in progress: {}, pending: {}, bytes left: "
+      "{}, throughput: {} B/s, eta: {}",
+      meta.update,
+      _movement_scheduler.in_progress(),
+      _movement_stats.pending,
+      _movement_stats.bytes_left,
+      _movement_scheduler.throughput().value_or(0),
+      eta ? fmt::format("{}s", eta->count()) : std::string("unknown"));
+}
+
 void members_backend::reassign_replicas(
   partition_assignment& current_assignment,
   partition_reallocation& reallocation) {
@@ -707,6 +911,7 @@ ss::future<> members_backend::reallocate_replica_set(
             co_return;
         }
         meta.state = reallocation_state::finished;
+        _movement_scheduler.move_finished(meta.size_bytes);
         [[fallthrough]];
     }
     case reallocation_state::finished:
@@ -789,6 +994,17 @@ void members_backend::handle_reallocation_finished(model::node_id id) {
     });
 }
 
+std::vector<model::node_id>
+members_backend::partition_reallocation::target_nodes() const {
+    std::vector<model::node_id> ret;
+    for (const auto& bs : new_replica_set) {
+        if (!is_in_replica_set(current_replica_set, bs.node_id)) {
+            ret.push_back(bs.node_id);
+        }
+    }
+    return ret;
+}
+
 std::ostream&
 operator<<(std::ostream& o, const members_backend::partition_reallocation& r) {
     fmt::print(
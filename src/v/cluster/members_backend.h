@@ -2,6 +2,7 @@
 
 #include "cluster/fwd.h"
 #include "cluster/members_manager.h"
+#include "cluster/partition_movement_scheduler.h"
 #include "cluster/scheduling/types.h"
 #include "cluster/types.h"
 #include "model/fundamental.h"
@@ -46,6 +47,9 @@ public:
 
         void release_assignment_units() { allocation_units.reset(); }
 
+        // nodes the partition is recovered on
+        std::vector<model::node_id> target_nodes() const;
+
         model::ntp ntp;
         std::optional<partition_constraints> constraints;
         absl::node_hash_set<model::node_id> replicas_to_remove;
@@ -53,6 +57,9 @@ public:
         std::vector<model::broker_shard> new_replica_set;
         std::vector<model::broker_shard> current_replica_set;
         reallocation_state state = reallocation_state::initial;
+        // from the health report, used to prioritize the reallocations
+        size_t size_bytes{0};
+        size_t unavailable_replicas{0};
         friend std::ostream&
         operator<<(std::ostream&, const partition_reallocation&);
     };
@@ -76,6 +83,7 @@ public:
       ss::sharded<controller_api>&,
       ss::sharded<members_manager>&,
       ss::sharded<members_frontend>&,
+      ss::sharded<health_monitor_frontend>&,
       consensus_ptr,
       ss::sharded<ss::abort_source>&);
 
@@ -86,6 +94,9 @@ private:
     void start_reconciliation_loop();
     ss::future<> reconcile();
     ss::future<> reallocate_replica_set(partition_reallocation&);
+    ss::future<> update_reallocation_stats(update_meta&);
+    ss::future<> execute_reallocations(update_meta&);
+    partition_movement_scheduler::limits movement_limits() const;
 
     ss::future<> try_to_finish_update(update_meta&);
     void calculate_reallocations(update_meta&);
@@ -110,6 +121,7 @@ private:
     ss::sharded<controller_api>& _api;
     ss::sharded<members_manager>& _members_manager;
     ss::sharded<members_frontend>& _members_frontend;
+    ss::sharded<health_monitor_frontend>& _health_monitor;
     consensus_ptr _raft0;
     ss::sharded<ss::abort_source>& _as;
     ss::gate _bg;
@@ -122,6 +134,17 @@ private:
     ss::timer<> _retry_timer;
     ss::condition_variable _new_updates;
     ss::metrics::metric_groups _metrics;
+
+    /**
+     * throttles and orders the partition moves of the update being
+     * processed, the stats describe its remaining moves for the metrics.
+     */
+    partition_movement_scheduler _movement_scheduler;
+    struct movement_stats {
+        size_t pending{0};
+        size_t bytes_left{0};
+    };
+    movement_stats _movement_stats;
     /**
      * store revision of node decommissioning update, decommissioning command
      * revision is stored when node is being decommissioned, it is used to
@@ -11,7 +11,9 @@
 
 #include "cluster/cluster_utils.h"
 #include "cluster/commands.h"
+#include "cluster/config_manager.h"
 #include "cluster/controller_service.h"
+#include "cluster/controller_snapshot.h"
 #include "cluster/drain_manager.h"
 #include "cluster/fwd.h"
 #include "cluster/logger.h"
@@ -25,6 +27,7 @@
 #include "random/generators.h"
 #include "redpanda/application.h"
 #include "reflection/adl.h"
+#include "serde/serde.h"
 #include "storage/api.h"
 
 #include <seastar/core/coroutine.hh>
@@ -47,6 +50,7 @@ members_manager::members_manager(
   ss::sharded<partition_allocator>& allocator,
   ss::sharded<storage::api>& storage,
   ss::sharded<drain_manager>& drain_manager,
+  ss::sharded<config_manager>& config_manager,
   ss::sharded<ss::abort_source>& as)
   : _seed_servers(config::node().seed_servers())
   , _self(make_self_broker(config::node()))
@@ -58,6 +62,7 @@ members_manager::members_manager(
   , _allocator(allocator)
   , _storage(storage)
   , _drain_manager(drain_manager)
+  , _config_manager(config_manager)
   , _as(as)
   , _rpc_tls_config(config::node().rpc_server_tls())
   , _update_queue(max_updates_queue_size) {
@@ -221,7 +226,12 @@ members_manager::apply_update(model::record_batch b) {
     // handle node managements command
     auto cmd = co_await cluster::deserialize(std::move(b), accepted_commands);
 
-    co_return co_await ss::visit(
+    co_return co_await apply_command(update_offset, std::move(cmd));
+}
+
+ss::future<std::error_code>
+members_manager::apply_command(model::offset update_offset, node_command cmd) {
+    return ss::visit(
       cmd,
       [this, update_offset](decommission_node_cmd cmd) mutable {
           auto id = cmd.key;
@@ -294,11 +304,57 @@ members_manager::apply_raft_configuration_batch(model::record_batch b) {
     auto cfg = reflection::from_iobuf<raft::group_configuration>(
       b.copy_records().front().release_value());
 
+    _last_configuration = cfg;
+    _last_configuration_offset = b.base_offset();
     co_await handle_raft0_cfg_update(std::move(cfg), b.base_offset());
 
     co_return make_error_code(errc::success);
 }
 
+ss::future<iobuf> members_manager::take_snapshot(model::offset) {
+    controller_snapshot_parts::members snap;
+    if (_last_configuration) {
+        snap.configuration = reflection::to_iobuf(
+          raft::group_configuration(*_last_configuration));
+        snap.configuration_offset = _last_configuration_offset;
+    }
+    for (const auto& broker : _members_table.local().all_brokers()) {
+        snap.nodes.push_back(controller_snapshot_parts::members::node{
+          .id = broker->id(),
+          .membership = broker->get_membership_state(),
+          .maintenance = broker->get_maintenance_state(),
+        });
+    }
+    co_return serde::to_iobuf(std::move(snap));
+}
+
+ss::future<> members_manager::apply_snapshot(model::offset offset, iobuf buf) {
+    auto snap = serde::from_iobuf<controller_snapshot_parts::members>(
+      std::move(buf));
+    if (!snap.configuration) {
+        co_return;
+    }
+    auto cfg = reflection::from_iobuf<raft::group_configuration>(
+      std::move(*snap.configuration));
+    _last_configuration = cfg;
+    _last_configuration_offset = snap.configuration_offset;
+    co_await handle_raft0_cfg_update(
+      std::move(cfg), snap.configuration_offset);
+
+    // node states are restored with the commands that led to them, brokers
+    // removed from the cluster are not part of the snapshot
+    for (const auto& node : snap.nodes) {
+        if (node.membership == model::membership_state::draining) {
+            co_await apply_command(
+              offset, decommission_node_cmd(node.id, 0));
+        }
+        if (node.maintenance == model::maintenance_state::active) {
+            co_await apply_command(
+              offset, maintenance_mode_cmd(node.id, true));
+        }
+    }
+}
+
 ss::future<std::vector<members_manager::node_update>>
 members_manager::get_node_updates() {
     if (_update_queue.empty()) {
@@ -408,10 +464,12 @@ void members_manager::join_raft0() {
                               _self}))
                      .then([this](result<join_node_reply> r) {
                          bool success = r && r.value().success;
-                         // stop on success or closed gate
-                         if (
-                           success || _gate.is_closed()
-                           || is_already_member()) {
+                         if (success) {
+                             return apply_join_reply(std::move(r.value()))
+                               .then([] { return ss::stop_iteration::yes; });
+                         }
+                         // stop on closed gate
+                         if (_gate.is_closed() || is_already_member()) {
                              return ss::make_ready_future<ss::stop_iteration>(
                                ss::stop_iteration::yes);
                          }
@@ -433,6 +491,29 @@ void members_manager::join_raft0() {
     });
 }
 
+/**
+ * The joining node applies the cluster configuration of the reply as soon as
+ * it joined, while its controller log is still catching up with the leader.
+ * Replaying the configuration deltas of the log later on is a no-op as their
+ * versions are not newer than the one applied here.
+ */
+ss::future<> members_manager::apply_join_reply(join_node_reply reply) {
+    if (reply.cluster_config_version == config_version_unset) {
+        co_return;
+    }
+    vlog(
+      clusterlog.info,
+      "Joined the cluster, applying cluster configuration version {}",
+      reply.cluster_config_version);
+    co_await _config_manager.invoke_on(
+      config_manager::shard,
+      [version = reply.cluster_config_version,
+       values = std::move(reply.cluster_config)](
+        config_manager& mgr) mutable {
+          return mgr.apply_full_config(version, std::move(values));
+      });
+}
+
 ss::future<result<join_node_reply>>
 members_manager::dispatch_join_to_seed_server(
   seed_iterator it, join_node_request const& req) {
@@ -558,9 +639,13 @@ members_manager::handle_join_request(join_node_request const req) {
         // protocol.
         co_return co_await _raft0
           ->add_group_members({req.node}, model::revision_id(0))
-          .then([broker = req.node](std::error_code ec) {
+          .then([this, broker = req.node](std::error_code ec) {
               if (!ec) {
-                  return ret_t(join_node_reply{true, broker.id()});
+                  join_node_reply reply{true, broker.id()};
+                  const auto& cfg = _config_manager.local();
+                  reply.cluster_config_version = cfg.get_version();
+                  reply.cluster_config = cfg.get_raw_values();
+                  return ret_t(std::move(reply));
               }
               vlog(
                 clusterlog.warn,
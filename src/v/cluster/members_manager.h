@@ -69,6 +69,7 @@ public:
       ss::sharded<partition_allocator>&,
       ss::sharded<storage::api>&,
       ss::sharded<drain_manager>&,
+      ss::sharded<config_manager>&,
       ss::sharded<ss::abort_source>&);
 
     ss::future<> start();
@@ -78,6 +79,9 @@ public:
     handle_join_request(join_node_request const r);
     ss::future<std::error_code> apply_update(model::record_batch);
 
+    ss::future<iobuf> take_snapshot(model::offset);
+    ss::future<> apply_snapshot(model::offset, iobuf);
+
     ss::future<result<configuration_update_reply>>
       handle_configuration_update_request(configuration_update_request);
 
@@ -98,6 +102,7 @@ private:
     using seed_iterator = std::vector<config::seed_server>::const_iterator;
     // Cluster join
     void join_raft0();
+    ss::future<> apply_join_reply(join_node_reply);
     bool is_already_member() const;
 
     ss::future<> initialize_broker_connection(const model::broker&);
@@ -127,6 +132,13 @@ private:
     ss::future<std::error_code>
       apply_raft_configuration_batch(model::record_batch);
 
+    using node_command = std::variant<
+      decommission_node_cmd,
+      recommission_node_cmd,
+      finish_reallocations_cmd,
+      maintenance_mode_cmd>;
+    ss::future<std::error_code> apply_command(model::offset, node_command);
+
     std::vector<config::seed_server> _seed_servers;
     model::broker _self;
     simple_time_jitter<model::timeout_clock> _join_retry_jitter;
@@ -137,12 +149,16 @@ private:
     ss::sharded<partition_allocator>& _allocator;
     ss::sharded<storage::api>& _storage;
     ss::sharded<drain_manager>& _drain_manager;
+    ss::sharded<config_manager>& _config_manager;
     ss::sharded<ss::abort_source>& _as;
     config::tls_config _rpc_tls_config;
     ss::gate _gate;
     ss::queue<node_update> _update_queue;
     ss::abort_source::subscription _queue_abort_subscription;
     model::offset _last_connection_update_offset;
+    // last applied raft0 configuration, part of the controller snapshot
+    std::optional<raft::group_configuration> _last_configuration;
+    model::offset _last_configuration_offset;
 };
 
 std::ostream&
@@ -103,10 +103,19 @@ metadata_cache::get_topic_timestamp_type(model::topic_namespace_view tp) const {
     return _topics_state.local().get_topic_timestamp_type(tp);
 }
 
+std::optional<model::compression>
+metadata_cache::get_topic_compression(model::topic_namespace_view tp) const {
+    return _topics_state.local().get_topic_compression(tp);
+}
+
 const topic_table::underlying_t& metadata_cache::all_topics_metadata() const {
     return _topics_state.local().all_topics_metadata();
 }
 
+uint64_t metadata_cache::get_topics_version() const {
+    return _topics_state.local().topics_version();
+}
+
 std::optional<broker_ptr> metadata_cache::get_broker(model::node_id nid) const {
     return _members_table.local().get_broker(nid);
 }
@@ -115,19 +124,17 @@ std::vector<broker_ptr> metadata_cache::all_brokers() const {
     return _members_table.local().all_brokers();
 }
 
-ss::future<std::vector<broker_ptr>> metadata_cache::all_alive_brokers() const {
+std::vector<broker_ptr> metadata_cache::all_alive_brokers() const {
     std::vector<broker_ptr> brokers;
-    auto res = co_await _health_monitor.local().get_nodes_status(
-      config::shard_local_cfg().metadata_status_wait_timeout_ms()
-      + model::timeout_clock::now());
-    if (!res) {
+    const auto& status = _health_monitor.local().get_cached_nodes_status();
+    if (!status) {
         // if we were not able to refresh the cache, return all brokers
         // (controller may be unreachable)
-        co_return _members_table.local().all_brokers();
+        return _members_table.local().all_brokers();
     }
 
     std::set<model::node_id> brokers_with_health;
-    for (auto& st : res.value()) {
+    for (const auto& st : *status) {
         brokers_with_health.insert(st.id);
         if (st.is_alive) {
             auto broker = _members_table.local().get_broker(st.id);
@@ -148,7 +155,7 @@ ss::future<std::vector<broker_ptr>> metadata_cache::all_alive_brokers() const {
         }
     }
 
-    co_return !brokers.empty() ? brokers : _members_table.local().all_brokers();
+    return !brokers.empty() ? brokers : _members_table.local().all_brokers();
 }
 
 std::vector<model::node_id> metadata_cache::all_broker_ids() const {
@@ -195,6 +202,11 @@ std::optional<model::node_id> metadata_cache::get_previous_leader_id(
     return _leaders.local().get_previous_leader(tp_ns, p_id);
 }
 
+uint64_t
+metadata_cache::get_leadership_version(model::topic_namespace_view tp_ns) const {
+    return _leaders.local().leadership_version(tp_ns);
+}
+
 /// If present returns a leader of raft0 group
 std::optional<model::node_id> metadata_cache::get_controller_leader_id() {
     return _leaders.local().get_leader(model::controller_ntp);
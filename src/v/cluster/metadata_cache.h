@@ -102,13 +102,21 @@ public:
     std::optional<model::timestamp_type>
       get_topic_timestamp_type(model::topic_namespace_view) const;
 
+    /// Returns topic compression type if it was set for the topic
+    std::optional<model::compression>
+      get_topic_compression(model::topic_namespace_view) const;
+
     const topic_table::underlying_t& all_topics_metadata() const;
 
+    /// Returns the topic table version, see topic_table::topics_version
+    uint64_t get_topics_version() const;
+
     /// Returns all brokers, returns copy as the content of broker can change
     std::vector<broker_ptr> all_brokers() const;
 
-    /// Returns all brokers, returns copy as the content of broker can change
-    ss::future<std::vector<broker_ptr>> all_alive_brokers() const;
+    /// Returns the brokers that are alive according to the shard local cache
+    /// of the health monitor, all brokers if their status is unknown
+    std::vector<broker_ptr> all_alive_brokers() const;
 
     /// Returns all broker ids
     std::vector<model::node_id> all_broker_ids() const;
@@ -135,6 +143,10 @@ public:
 
     std::optional<model::node_id> get_previous_leader_id(
       model::topic_namespace_view, model::partition_id) const;
+
+    /// Returns a version of the topic partitions leadership, see
+    /// partition_leaders_table::leadership_version
+    uint64_t get_leadership_version(model::topic_namespace_view) const;
     /// Returns metadata of all topics in cache internal format
     // const cache_t& all_metadata() const { return _cache; }
 
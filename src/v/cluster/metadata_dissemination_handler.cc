@@ -12,6 +12,7 @@
 #include "cluster/cluster_utils.h"
 #include "cluster/logger.h"
 #include "cluster/metadata_cache.h"
+#include "cluster/metadata_dissemination_service.h"
 #include "cluster/metadata_dissemination_types.h"
 #include "cluster/partition_leaders_table.h"
 #include "likely.h"
@@ -46,9 +47,11 @@ namespace cluster {
 metadata_dissemination_handler::metadata_dissemination_handler(
   ss::scheduling_group sg,
   ss::smp_service_group ssg,
-  ss::sharded<partition_leaders_table>& leaders)
+  ss::sharded<partition_leaders_table>& leaders,
+  ss::sharded<metadata_dissemination_service>& dissemination_service)
   : metadata_dissemination_rpc_service(sg, ssg)
-  , _leaders(leaders) {}
+  , _leaders(leaders)
+  , _dissemination_service(dissemination_service) {}
 
 ss::future<update_leadership_reply>
 metadata_dissemination_handler::update_leadership(
@@ -64,7 +67,16 @@ metadata_dissemination_handler::update_leadership_v2(
   update_leadership_request_v2&& req, rpc::streaming_context&) {
     return ss::with_scheduling_group(
       get_scheduling_group(), [this, req = std::move(req)]() mutable {
-          return do_update_leadership(std::move(req.leaders));
+          return do_update_leadership(std::move(req.leaders))
+            .then([this, stream = req.stream](update_leadership_reply reply) {
+                return _dissemination_service
+                  .invoke_on(
+                    0,
+                    [stream](metadata_dissemination_service& s) {
+                        s.handle_update_stream(stream);
+                    })
+                  .then([reply] { return reply; });
+            });
       });
 }
 
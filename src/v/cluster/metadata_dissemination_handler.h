@@ -24,7 +24,9 @@ namespace cluster {
 ///
 /// 1. update_leadership - send by newly elected leader to all nodes
 ///                        that does not contain the instance of raft group
-///                        that the new leader belongs to
+///                        that the new leader belongs to, updates sent with
+///                        the v2 method carry their position in the stream of
+///                        updates of the sender
 ///
 /// 2. get_leadership - send to any node that already belong to cluster
 ///                     after controller recovery to get the up to date
@@ -36,7 +38,8 @@ public:
     metadata_dissemination_handler(
       ss::scheduling_group,
       ss::smp_service_group,
-      ss::sharded<partition_leaders_table>&);
+      ss::sharded<partition_leaders_table>&,
+      ss::sharded<metadata_dissemination_service>&);
 
     ss::future<update_leadership_reply> update_leadership(
       update_leadership_request&&, rpc::streaming_context&) final;
@@ -52,6 +55,7 @@ private:
       do_update_leadership(std::vector<ntp_leader_revision>);
 
     ss::sharded<partition_leaders_table>& _leaders;
+    ss::sharded<metadata_dissemination_service>& _dissemination_service;
 }; // namespace cluster
 
 } // namespace cluster
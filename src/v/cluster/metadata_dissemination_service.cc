@@ -28,6 +28,7 @@
 #include "model/namespace.h"
 #include "model/timeout_clock.h"
 #include "net/unresolved_address.h"
+#include "random/generators.h"
 #include "rpc/connection_cache.h"
 #include "rpc/types.h"
 #include "utils/retry.h"
@@ -44,6 +45,7 @@
 
 #include <chrono>
 #include <exception>
+#include <limits>
 #include <optional>
 
 namespace cluster {
@@ -65,7 +67,9 @@ metadata_dissemination_service::metadata_dissemination_service(
   , _self(make_self_broker(config::node()))
   , _dissemination_interval(
       config::shard_local_cfg().metadata_dissemination_interval_ms)
-  , _rpc_tls_config(config::node().rpc_server_tls()) {
+  , _rpc_tls_config(config::node().rpc_server_tls())
+  , _session(random_generators::get_int<uint64_t>(
+      1, std::numeric_limits<uint64_t>::max())) {
     _dispatch_timer.set_callback([this] {
         ssx::spawn_with_gate(
           _bg, [this] { return dispatch_disseminate_leadership(); });
@@ -252,14 +256,88 @@ ss::future<> metadata_dissemination_service::process_get_update_reply(
         return ss::make_ready_future<>();
     }
     // Update all NTP leaders
-    return _leaders
-      .invoke_on_all([reply = std::move(reply_result.value())](
-                       partition_leaders_table& leaders) mutable {
+    return update_leaders_with_snapshot(std::move(reply_result.value()))
+      .then([&meta] { meta.success = true; });
+}
+
+ss::future<> metadata_dissemination_service::update_leaders_with_snapshot(
+  get_leadership_reply reply) {
+    return _leaders.invoke_on_all(
+      [reply = std::move(reply)](partition_leaders_table& leaders) mutable {
           for (auto& l : reply.leaders) {
               leaders.update_partition_leader(l.ntp, l.term, l.leader_id);
           }
-      })
-      .then([&meta] { meta.success = true; });
+      });
+}
+
+void metadata_dissemination_service::handle_update_stream(
+  const leadership_update_stream& stream) {
+    vassert(
+      ss::this_shard_id() == 0,
+      "leadership update streams are tracked on shard 0");
+    if (stream.session == 0) {
+        // sender does not sequence its updates
+        return;
+    }
+    auto& last = _peer_streams[stream.sender];
+    bool gap = false;
+    if (last.session != stream.session) {
+        // updates of a previous session are superseded by the updates of the
+        // new leaders, only the updates of the current session can be missing
+        gap = stream.sequence > 1;
+        last = peer_stream{.session = stream.session};
+    } else {
+        gap = stream.sequence > last.sequence + 1;
+    }
+    // a retried update may be received more than once
+    last.sequence = std::max(last.sequence, stream.sequence);
+    if (!gap || _resyncs_in_progress.contains(stream.sender)) {
+        return;
+    }
+    vlog(
+      clusterlog.info,
+      "Missing leadership updates from node {} (received {}), requesting "
+      "leadership metadata",
+      stream.sender,
+      stream);
+    _resyncs_in_progress.insert(stream.sender);
+    ssx::spawn_with_gate(_bg, [this, id = stream.sender] {
+        return resync_leadership(id).finally(
+          [this, id] { _resyncs_in_progress.erase(id); });
+    });
+}
+
+ss::future<>
+metadata_dissemination_service::resync_leadership(model::node_id id) {
+    auto broker = _members_table.local().get_broker(id);
+    if (!broker) {
+        co_return;
+    }
+    std::exception_ptr ep;
+    try {
+        auto reply = co_await dispatch_get_metadata_update(
+          (*broker)->rpc_address());
+        if (reply) {
+            co_await update_leaders_with_snapshot(std::move(reply.value()));
+            co_return;
+        }
+        vlog(
+          clusterlog.debug,
+          "Unable to request leadership metadata from node {} - {}",
+          id,
+          reply.error().message());
+    } catch (...) {
+        ep = std::current_exception();
+    }
+    if (ep) {
+        vlog(
+          clusterlog.debug,
+          "Unable to request leadership metadata from node {} - {}",
+          id,
+          ep);
+    }
+    // forget the stream position so that the next update triggers a retry
+    _peer_streams.erase(id);
 }
 
 ss::future<result<get_leadership_reply>>
@@ -305,7 +383,10 @@ void metadata_dissemination_service::collect_pending_updates() {
         for (auto& id : non_overlapping) {
             if (!_pending_updates.contains(id)) {
                 _pending_updates.emplace(
-                  id, update_retry_meta{std::vector<ntp_leader_revision>{}});
+                  id,
+                  update_retry_meta{
+                    .sequence = ++_last_sequence[id],
+                  });
             }
             vlog(
               clusterlog.trace,
@@ -412,6 +493,9 @@ std::vector<cluster::ntp_leader> from_ntp_leader_revision_vector(
 }
 } // namespace
 
+// leadership updates are lists of ntps, which compress very well
+static constexpr size_t update_min_compression_bytes = 512;
+
 ss::future<> metadata_dissemination_service::dispatch_one_update(
   model::node_id target_id, update_retry_meta& meta) {
     return _clients.local()
@@ -420,18 +504,27 @@ ss::future<> metadata_dissemination_service::dispatch_one_update(
         ss::this_shard_id(),
         target_id,
         _dissemination_interval,
-        [this, updates = meta.updates, target_id](
+        [this, updates = meta.updates, target_id, sequence = meta.sequence](
           metadata_dissemination_rpc_client_protocol proto) mutable {
             vlog(
               clusterlog.trace,
-              "Sending {} metadata updates to {}",
+              "Sending {} metadata updates to {} with sequence {}",
               updates,
-              target_id);
+              target_id,
+              sequence);
             return proto
               .update_leadership_v2(
-                update_leadership_request_v2(std::move(updates)),
+                update_leadership_request_v2(
+                  std::move(updates),
+                  leadership_update_stream{
+                    .sender = _self.id(),
+                    .session = _session,
+                    .sequence = sequence,
+                  }),
                 rpc::client_opts(
-                  _dissemination_interval + rpc::clock_type::now()))
+                  _dissemination_interval + rpc::clock_type::now(),
+                  rpc::compression_type::zstd,
+                  update_min_compression_bytes))
               .then(&rpc::get_ctx_data<update_leadership_reply>);
         })
       .then([this, target_id, &meta](result<update_leadership_reply> r) {
@@ -456,7 +549,9 @@ ss::future<> metadata_dissemination_service::dispatch_one_update(
                         update_leadership_request(
                           from_ntp_leader_revision_vector(std::move(updates))),
                         rpc::client_opts(
-                          _dissemination_interval + rpc::clock_type::now()));
+                          _dissemination_interval + rpc::clock_type::now(),
+                          rpc::compression_type::zstd,
+                          update_min_compression_bytes));
                   })
                 .then(&rpc::get_ctx_data<update_leadership_reply>);
           }
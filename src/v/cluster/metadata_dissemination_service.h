@@ -28,6 +28,7 @@
 #include <seastar/core/sharded.hh>
 
 #include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
 
 namespace cluster {
 
@@ -41,6 +42,11 @@ namespace cluster {
 /// responsible for querying one of the cluster nodes for current leadership
 /// metadata when node has started.
 ///
+/// Updates sent to every peer form a stream of consecutive sequence numbers.
+/// The peer applies updates as they come and only when it observes a gap in
+/// the stream, i.e. an update was lost, it requests the full leadership
+/// metadata from the sender.
+///
 /// Used acronymes:
 /// RG<num> - raft group with <num> id
 ///
@@ -89,6 +95,11 @@ public:
 
     void initialize_leadership_metadata();
 
+    /// Tracks the position of leadership updates received from a peer,
+    /// requests full leadership metadata from the peer if updates are
+    /// missing. Must be called on shard 0.
+    void handle_update_stream(const leadership_update_stream&);
+
     ss::future<> start();
     ss::future<> stop();
 
@@ -98,8 +109,16 @@ private:
     // and object is removed from pending updates map
     struct update_retry_meta {
         std::vector<ntp_leader_revision> updates;
+        // sequence number of the update in the peer stream, a retried update
+        // keeps its sequence number
+        uint64_t sequence{0};
         bool finished = false;
     };
+    // Last update received from a peer
+    struct peer_stream {
+        uint64_t session{0};
+        uint64_t sequence{0};
+    };
     // Used to track the process of requesting update when redpanda starts
     // when update using a node from ids will fail we will try the next one
     struct request_retry_meta {
@@ -134,6 +153,8 @@ private:
     ss::future<> do_request_metadata_update(request_retry_meta&);
     ss::future<>
     process_get_update_reply(result<get_leadership_reply>, request_retry_meta&);
+    ss::future<> update_leaders_with_snapshot(get_leadership_reply);
+    ss::future<> resync_leadership(model::node_id);
 
     ss::future<>
       update_metadata_with_retries(std::vector<net::unresolved_address>);
@@ -153,6 +174,11 @@ private:
     std::vector<ntp_leader_revision> _requests;
     std::vector<net::unresolved_address> _seed_servers;
     broker_updates_t _pending_updates;
+    // identifies the streams of updates sent by this instance
+    uint64_t _session;
+    absl::flat_hash_map<model::node_id, uint64_t> _last_sequence;
+    absl::flat_hash_map<model::node_id, peer_stream> _peer_streams;
+    absl::flat_hash_set<model::node_id> _resyncs_in_progress;
     mutex _lock;
     ss::timer<> _dispatch_timer;
     ss::abort_source _as;
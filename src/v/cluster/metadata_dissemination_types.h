@@ -113,10 +113,43 @@ struct update_leadership_request
     }
 };
 
+/// Position of an update in the stream of leadership updates sent by a node
+/// to one of its peers. Sequence numbers of a session are consecutive, a
+/// receiver that observes a gap requests the full leadership metadata from the
+/// sender. A node starts a new session every time it starts.
+struct leadership_update_stream
+  : serde::envelope<leadership_update_stream, serde::version<0>> {
+    model::node_id sender;
+    // zero when the sender does not sequence its updates
+    uint64_t session{0};
+    uint64_t sequence{0};
+
+    friend bool
+    operator==(const leadership_update_stream&, const leadership_update_stream&)
+      = default;
+
+    friend std::ostream&
+    operator<<(std::ostream& o, const leadership_update_stream& s) {
+        fmt::print(
+          o,
+          "{{sender: {}, session: {}, sequence: {}}}",
+          s.sender,
+          s.session,
+          s.sequence);
+        return o;
+    }
+
+    auto serde_fields() { return std::tie(sender, session, sequence); }
+};
+
 struct update_leadership_request_v2
-  : serde::envelope<update_leadership_request_v2, serde::version<0>> {
-    static constexpr int8_t version = 0;
+  : serde::envelope<
+      update_leadership_request_v2,
+      serde::version<1>,
+      serde::compat_version<0>> {
+    static constexpr int8_t version = 1;
     std::vector<ntp_leader_revision> leaders;
+    leadership_update_stream stream;
 
     update_leadership_request_v2() noexcept = default;
 
@@ -126,15 +159,17 @@ struct update_leadership_request_v2
 
     friend std::ostream&
     operator<<(std::ostream& o, const update_leadership_request_v2& r) {
-        fmt::print(o, "leaders {}", r.leaders);
+        fmt::print(o, "leaders {}, stream {}", r.leaders, r.stream);
         return o;
     }
 
     explicit update_leadership_request_v2(
-      std::vector<ntp_leader_revision> leaders)
-      : leaders(std::move(leaders)) {}
+      std::vector<ntp_leader_revision> leaders,
+      leadership_update_stream stream = {})
+      : leaders(std::move(leaders))
+      , stream(stream) {}
 
-    auto serde_fields() { return std::tie(leaders); }
+    auto serde_fields() { return std::tie(leaders, stream); }
 };
 
 struct update_leadership_reply
@@ -252,14 +287,27 @@ struct adl<cluster::ntp_leader> {
 template<>
 struct adl<cluster::update_leadership_request_v2> {
     void to(iobuf& out, cluster::update_leadership_request_v2&& req) {
-        serialize(out, req.version, req.leaders);
+        serialize(
+          out,
+          req.version,
+          req.leaders,
+          req.stream.sender,
+          req.stream.session,
+          req.stream.sequence);
     }
     cluster::update_leadership_request_v2 from(iobuf_parser& in) {
-        // decode version
-        adl<int8_t>{}.from(in);
+        auto version = adl<int8_t>{}.from(in);
         auto leaders = adl<std::vector<cluster::ntp_leader_revision>>{}.from(
           in);
-        return cluster::update_leadership_request_v2(std::move(leaders));
+        cluster::leadership_update_stream stream;
+        // stream position was added in version 1
+        if (version >= 1) {
+            stream.sender = adl<model::node_id>{}.from(in);
+            stream.session = adl<uint64_t>{}.from(in);
+            stream.sequence = adl<uint64_t>{}.from(in);
+        }
+        return cluster::update_leadership_request_v2(
+          std::move(leaders), stream);
     }
 };
 } // namespace reflection
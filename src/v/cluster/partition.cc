@@ -34,9 +34,11 @@ partition::partition(
   ss::sharded<cloud_storage::remote>& cloud_storage_api,
   ss::sharded<cloud_storage::cache>& cloud_storage_cache,
   ss::sharded<feature_table>& feature_table,
+  ss::lw_shared_ptr<partition_metrics_aggregator> metrics_aggregator,
   std::optional<s3::bucket_name> read_replica_bucket)
   : _raft(r)
-  , _probe(std::make_unique<replicated_partition_probe>(*this))
+  , _probe(std::make_unique<replicated_partition_probe>(
+      *this, std::move(metrics_aggregator)))
   , _tx_gateway_frontend(tx_gateway_frontend)
   , _feature_table(feature_table)
   , _is_tx_enabled(config::shard_local_cfg().enable_transactions.value())
@@ -111,6 +113,19 @@ partition::partition(
                     cloud_storage_api.local(),
                     cloud_storage_cache.local(),
                     s3::bucket_name{*bucket});
+
+                // followers can skip the uploaded prefix of the log during
+                // recovery only if it can be read back from cloud storage
+                _raft->set_archived_offset_provider(
+                  [raft = _raft.get(), stm = _archival_meta_stm] {
+                      if (
+                        !raft->log_config().is_remote_fetch_enabled()
+                        && !config::shard_local_cfg()
+                              .cloud_storage_enable_remote_read.value()) {
+                          return model::offset{};
+                      }
+                      return stm->manifest().get_last_offset();
+                  });
             }
         }
     }
@@ -279,6 +294,20 @@ partition::timequery(storage::timequery_config cfg) {
     return _raft->timequery(cfg);
 }
 
+ss::future<std::optional<storage::key_lookup_result>>
+partition::key_lookup(bytes key, ss::io_priority_class prio) {
+    storage::key_lookup_config cfg{
+      .key = std::move(key),
+      .max_offset = model::prev_offset(last_stable_offset()),
+      .prio = prio};
+    auto res = co_await _raft->log().key_lookup(std::move(cfg));
+    if (res) {
+        res->offset = get_offset_translator_state()->from_log_offset(
+          res->offset);
+    }
+    co_return res;
+}
+
 ss::future<> partition::update_configuration(topic_properties properties) {
     return _raft->log().update_configuration(
       properties.get_ntp_cfg_overrides());
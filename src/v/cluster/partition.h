@@ -47,6 +47,7 @@ public:
       ss::sharded<cloud_storage::remote>&,
       ss::sharded<cloud_storage::cache>&,
       ss::sharded<feature_table>&,
+      ss::lw_shared_ptr<partition_metrics_aggregator>,
       std::optional<s3::bucket_name> read_replica_bucket = std::nullopt);
 
     raft::group_id group() const { return _raft->group(); }
@@ -72,6 +73,11 @@ public:
         return _raft->make_reader(std::move(config), deadline);
     }
 
+    ss::future<std::optional<storage::extent_read_result>>
+    read_extent(storage::extent_read_config config) {
+        return _raft->read_extent(config);
+    }
+
     model::offset start_offset() const { return _raft->start_offset(); }
 
     /**
@@ -129,6 +135,11 @@ public:
     ss::future<std::optional<storage::timequery_result>>
       timequery(storage::timequery_config);
 
+    /// Latest record of a key that is visible to consumers, the offset of
+    /// the result is a kafka offset
+    ss::future<std::optional<storage::key_lookup_result>>
+      key_lookup(bytes, ss::io_priority_class);
+
     bool is_elected_leader() const { return _raft->is_elected_leader(); }
     bool is_leader() const { return _raft->is_leader(); }
     bool has_followers() const { return _raft->has_followers(); }
@@ -218,6 +229,10 @@ public:
         return _archival_meta_stm;
     }
 
+    bool is_feature_active(feature f) const {
+        return _feature_table.local().is_active(f);
+    }
+
     bool is_read_replica_mode_enabled() const {
         const auto& cfg = _raft->log_config();
         return cfg.is_read_replica_mode_enabled();
@@ -43,7 +43,8 @@ partition_balancer_backend::partition_balancer_backend(
   config::binding<unsigned>&& max_disk_usage_percent,
   config::binding<unsigned>&& storage_space_alert_free_threshold_percent,
   config::binding<std::chrono::milliseconds>&& tick_interval,
-  config::binding<size_t>&& movement_batch_size_bytes)
+  config::binding<size_t>&& movement_batch_size_bytes,
+  config::binding<unsigned>&& max_load_imbalance_percent)
   : _raft0(std::move(raft0))
   , _controller_stm(controller_stm.local())
   , _topic_table(topic_table.local())
@@ -58,6 +59,7 @@ partition_balancer_backend::partition_balancer_backend(
       std::move(storage_space_alert_free_threshold_percent))
   , _tick_interval(std::move(tick_interval))
   , _movement_batch_size_bytes(std::move(movement_batch_size_bytes))
+  , _max_load_imbalance_percent(std::move(max_load_imbalance_percent))
   , _timer([this] { tick(); }) {}
 
 void partition_balancer_backend::start() {
@@ -159,6 +161,7 @@ ss::future<> partition_balancer_backend::do_tick() {
             .hard_max_disk_usage_ratio = hard_max_disk_usage_ratio,
             .movement_disk_size_batch = _movement_batch_size_bytes(),
             .node_availability_timeout_sec = _availability_timeout(),
+            .max_load_imbalance_ratio = _max_load_imbalance_percent() / 100.0,
           },
           _topic_table,
           _members_table,
@@ -39,7 +39,8 @@ public:
       config::binding<unsigned>&& max_disk_usage_percent,
       config::binding<unsigned>&& storage_space_alert_free_threshold_percent,
       config::binding<std::chrono::milliseconds>&& tick_interval,
-      config::binding<size_t>&& movement_batch_size_bytes);
+      config::binding<size_t>&& movement_batch_size_bytes,
+      config::binding<unsigned>&& max_load_imbalance_percent);
 
     void start();
     ss::future<> stop();
@@ -82,6 +83,7 @@ private:
     config::binding<unsigned> _storage_space_alert_free_threshold_percent;
     config::binding<std::chrono::milliseconds> _tick_interval;
     config::binding<size_t> _movement_batch_size_bytes;
+    config::binding<unsigned> _max_load_imbalance_percent;
 
     model::term_id _last_leader_term;
     ss::lowres_clock::time_point _last_tick_time;
@@ -46,6 +46,90 @@ distinct_from(const absl::flat_hash_set<model::node_id>& nodes) {
     return hard_constraint_evaluator(std::make_unique<impl>(nodes));
 }
 
+/*
+ * Node must stay under the load limit with the partition added
+ */
+hard_constraint_evaluator load_not_exceeded_by_partition(
+  uint64_t max_node_load,
+  uint64_t partition_load,
+  const absl::flat_hash_map<model::node_id, uint64_t>& node_loads) {
+    class impl : public hard_constraint_evaluator::impl {
+    public:
+        impl(
+          uint64_t max_node_load,
+          uint64_t partition_load,
+          const absl::flat_hash_map<model::node_id, uint64_t>& node_loads)
+          : _max_node_load(max_node_load)
+          , _partition_load(partition_load)
+          , _node_loads(node_loads) {}
+
+        bool evaluate(const allocation_node& node) const final {
+            uint64_t load = 0;
+            if (auto it = _node_loads.find(node.id());
+                it != _node_loads.end()) {
+                load = it->second;
+            }
+            return load + _partition_load <= _max_node_load;
+        }
+
+        void print(std::ostream& o) const final {
+            fmt::print(
+              o,
+              "partition with load {} B/s doesn't overload node",
+              _partition_load);
+        }
+
+    private:
+        uint64_t _max_node_load;
+        uint64_t _partition_load;
+        const absl::flat_hash_map<model::node_id, uint64_t>& _node_loads;
+    };
+
+    return hard_constraint_evaluator(
+      std::make_unique<impl>(max_node_load, partition_load, node_loads));
+}
+
+/*
+ * Scores nodes on how far under the load limit they are
+ */
+soft_constraint_evaluator least_loaded(
+  uint64_t max_node_load,
+  const absl::flat_hash_map<model::node_id, uint64_t>& node_loads) {
+    class impl : public soft_constraint_evaluator::impl {
+    public:
+        impl(
+          uint64_t max_node_load,
+          const absl::flat_hash_map<model::node_id, uint64_t>& node_loads)
+          : _max_node_load(max_node_load)
+          , _node_loads(node_loads) {}
+
+        uint64_t score(const allocation_node& node) const final {
+            uint64_t load = 0;
+            if (auto it = _node_loads.find(node.id());
+                it != _node_loads.end()) {
+                load = it->second;
+            }
+            if (load >= _max_node_load) {
+                return 0;
+            }
+            return uint64_t(
+              soft_constraint_evaluator::max_score
+              * (double(_max_node_load - load) / double(_max_node_load)));
+        }
+
+        void print(std::ostream& o) const final {
+            fmt::print(o, "least loaded node");
+        }
+
+    private:
+        uint64_t _max_node_load;
+        const absl::flat_hash_map<model::node_id, uint64_t>& _node_loads;
+    };
+
+    return soft_constraint_evaluator(
+      std::make_unique<impl>(max_node_load, node_loads));
+}
+
 } // namespace
 
 partition_balancer_planner::partition_balancer_planner(
@@ -147,9 +231,15 @@ void partition_balancer_planner::init_ntp_sizes_from_health_report(
     for (const auto& node_report : health_report.node_reports) {
         for (const auto& tp_ns : node_report.topics) {
             for (const auto& partition : tp_ns.partitions) {
-                rrs.ntp_sizes[model::ntp(
-                  tp_ns.tp_ns.ns, tp_ns.tp_ns.tp, partition.id)]
-                  = partition.size_bytes;
+                model::ntp ntp(tp_ns.tp_ns.ns, tp_ns.tp_ns.tp, partition.id);
+                rrs.ntp_sizes[ntp] = partition.size_bytes;
+                // the leader serves most of the requests, every replica takes
+                // the produced bytes so the partition load is the highest one
+                // reported
+                if (partition.bytes_rate > 0) {
+                    auto& load = rrs.ntp_loads[ntp];
+                    load = std::max(load, partition.bytes_rate);
+                }
             }
         }
     }
@@ -524,6 +614,171 @@ void partition_balancer_planner::get_full_node_reassignments(
     }
 }
 
+/*
+ * Function is trying to move partitions away from nodes whose produce and fetch
+ * load is above the cluster average by more than max_load_imbalance_ratio. A
+ * node load is the sum of the loads of the partitions it hosts. Nodes are taken
+ * in descending load order and for each node partitions are moved in the order
+ * of load removed per byte moved, until the node is back under the limit.
+ * Target nodes have to stay under the limit too.
+ */
+void partition_balancer_planner::get_load_reassignments(
+  plan_data& result, reallocation_request_state& rrs) {
+    if (_config.max_load_imbalance_ratio <= 0 || rrs.ntp_loads.empty()) {
+        return;
+    }
+
+    absl::flat_hash_map<model::node_id, std::vector<model::ntp>> ntp_on_nodes;
+    for (const auto& t : _topic_table.topics_map()) {
+        for (const auto& a : t.second.get_assignments()) {
+            model::ntp ntp(t.first.ns, t.first.tp, a.id);
+            auto load_it = rrs.ntp_loads.find(ntp);
+            if (load_it == rrs.ntp_loads.end()) {
+                continue;
+            }
+            for (const auto& r : a.replicas) {
+                rrs.node_loads[r.node_id] += load_it->second;
+                ntp_on_nodes[r.node_id].push_back(ntp);
+            }
+        }
+    }
+
+    // nodes that can take load
+    uint64_t total_load = 0;
+    size_t nodes_count = 0;
+    for (auto id : rrs.all_nodes) {
+        if (
+          rrs.all_unavailable_nodes.contains(id)
+          || rrs.decommissioning_nodes.contains(id)) {
+            continue;
+        }
+        total_load += rrs.node_loads[id];
+        ++nodes_count;
+    }
+    if (nodes_count < 2 || total_load < min_balanced_load * nodes_count) {
+        return;
+    }
+    const auto max_node_load = uint64_t(
+      double(total_load) / nodes_count
+      * (1.0 + _config.max_load_imbalance_ratio));
+
+    std::vector<std::pair<model::node_id, uint64_t>> hot_nodes;
+    for (auto id : rrs.all_nodes) {
+        if (rrs.all_unavailable_nodes.contains(id)) {
+            continue;
+        }
+        if (auto load = rrs.node_loads[id]; load > max_node_load) {
+            hot_nodes.emplace_back(id, load);
+        }
+    }
+    std::sort(
+      hot_nodes.begin(), hot_nodes.end(), [](const auto& l, const auto& r) {
+          return l.second > r.second;
+      });
+
+    for (const auto& [node_id, _] : hot_nodes) {
+        vlog(
+          clusterlog.debug,
+          "node {}: load {} B/s over the limit of {} B/s",
+          node_id,
+          rrs.node_loads[node_id],
+          max_node_load);
+
+        struct candidate {
+            model::ntp ntp;
+            size_t size;
+            uint64_t load;
+        };
+        std::vector<candidate> candidates;
+        for (const auto& ntp : ntp_on_nodes[node_id]) {
+            if (rrs.moving_partitions.contains(ntp)) {
+                continue;
+            }
+            auto size = get_partition_size(ntp, rrs);
+            if (!size) {
+                continue;
+            }
+            candidates.push_back(candidate{
+              .ntp = ntp, .size = *size, .load = rrs.ntp_loads[ntp]});
+        }
+        // load removed per byte moved
+        std::sort(
+          candidates.begin(),
+          candidates.end(),
+          [](const candidate& l, const candidate& r) {
+              return double(l.load) / double(l.size + 1)
+                     > double(r.load) / double(r.size + 1);
+          });
+
+        for (const auto& c : candidates) {
+            if (rrs.planned_moves_size >= _config.movement_disk_size_batch) {
+                return;
+            }
+            if (rrs.node_loads[node_id] <= max_node_load) {
+                break;
+            }
+
+            const auto& topic_metadata = _topic_table.topics_map().at(
+              model::topic_namespace_view(c.ntp));
+            const auto& current_assignments
+              = topic_metadata.get_assignments().find(c.ntp.tp.partition);
+            if (!is_partition_movement_possible(
+                  current_assignments->replicas, rrs)) {
+                continue;
+            }
+
+            std::vector<model::broker_shard> stable_replicas;
+            for (const auto& r : current_assignments->replicas) {
+                if (r.node_id != node_id) {
+                    stable_replicas.push_back(r);
+                }
+            }
+
+            auto constraints = get_partition_constraints(
+              *current_assignments,
+              topic_metadata.metadata,
+              c.size,
+              _config.soft_max_disk_usage_ratio,
+              rrs);
+            constraints.constraints.hard_constraints.push_back(
+              ss::make_lw_shared<hard_constraint_evaluator>(
+                load_not_exceeded_by_partition(
+                  max_node_load, c.load, rrs.node_loads)));
+            constraints.constraints.soft_constraints.push_back(
+              ss::make_lw_shared<soft_constraint_evaluator>(
+                least_loaded(max_node_load, rrs.node_loads)));
+
+            auto new_allocation_units = get_reallocation(
+              c.ntp,
+              *current_assignments,
+              c.size,
+              std::move(constraints),
+              stable_replicas,
+              rrs);
+            if (!new_allocation_units) {
+                result.failed_reassignments_count += 1;
+                continue;
+            }
+
+            rrs.node_loads[node_id] -= c.load;
+            for (const auto& r : new_allocation_units.value()
+                                   .get_assignments()
+                                   .front()
+                                   .replicas) {
+                if (
+                  std::find(
+                    stable_replicas.begin(), stable_replicas.end(), r)
+                  == stable_replicas.end()) {
+                    rrs.node_loads[r.node_id] += c.load;
+                }
+            }
+            result.reassignments.emplace_back(ntp_reassignments{
+              .ntp = c.ntp,
+              .allocation_units = std::move(new_allocation_units.value())});
+        }
+    }
+}
+
 /*
  * Cancel movement if new assignments contains unavailble node
  * and previous replica set doesn't contain this node
@@ -608,6 +863,14 @@ partition_balancer_planner::plan_reassignments(
         return result;
     }
 
+    if (!_topic_table.has_updates_in_progress()) {
+        init_ntp_sizes_from_health_report(health_report, rrs);
+        get_load_reassignments(result, rrs);
+        if (!result.reassignments.empty()) {
+            result.status = status::movement_planned;
+        }
+    }
+
     return result;
 }
 
@@ -34,10 +34,17 @@ struct planner_config {
     // Size of partitions that can be planned to move in one request
     size_t movement_disk_size_batch;
     std::chrono::seconds node_availability_timeout_sec;
+    // If the produce and fetch load of a node is over the cluster average by
+    // more than this ratio planner moves partitions away from the node, 0
+    // disables load balancing.
+    double max_load_imbalance_ratio = 0;
 };
 
 class partition_balancer_planner {
 public:
+    // nodes are not balanced below this average load in bytes per second
+    static constexpr uint64_t min_balanced_load = 1024 * 1024;
+
     partition_balancer_planner(
       planner_config config,
       topic_table& topic_table,
@@ -73,6 +80,9 @@ private:
         absl::flat_hash_map<model::node_id, node_disk_space> node_disk_reports;
 
         absl::flat_hash_map<model::ntp, size_t> ntp_sizes;
+        // produce and fetch bytes per second of partitions and nodes
+        absl::flat_hash_map<model::ntp, uint64_t> ntp_loads;
+        absl::flat_hash_map<model::node_id, uint64_t> node_loads;
 
         // Partitions that are planned to move in current planner request
         absl::flat_hash_set<model::ntp> moving_partitions;
@@ -99,6 +109,8 @@ private:
 
     void get_full_node_reassignments(plan_data&, reallocation_request_state&);
 
+    void get_load_reassignments(plan_data&, reallocation_request_state&);
+
     void init_per_node_state(
       const cluster_health_report&,
       const std::vector<raft::follower_metrics>&,
@@ -18,13 +18,15 @@
 
 #include <seastar/core/future-util.hh>
 
+#include <algorithm>
 #include <optional>
 
 namespace cluster {
 
 partition_leaders_table::partition_leaders_table(
   ss::sharded<topic_table>& topic_table)
-  : _topic_table(topic_table) {}
+  : _topic_table(topic_table)
+  , _notify_timer([this] { notify_leadership_changes(); }) {}
 
 ss::future<> partition_leaders_table::stop() {
     vlog(clusterlog.info, "Stopping Partition Leaders Table...");
@@ -37,6 +39,9 @@ ss::future<> partition_leaders_table::stop() {
         }
         _leader_promises.erase(it);
     }
+    _notify_timer.cancel();
+    _pending_changes.clear();
+    _pending_index.clear();
     return ss::now();
 }
 
@@ -158,6 +163,7 @@ void partition_leaders_table::update_partition_leader(
       it->second.current_leader,
       it->second.previous_leader,
       it->second.partition_revision);
+    bump_leadership_version(key.tp_ns);
     // notify waiters if update is setting the leader
     if (!leader_id) {
         return;
@@ -176,6 +182,66 @@ void partition_leaders_table::update_partition_leader(
       !it->second.previous_leader
       || leader_id.value() != it->second.previous_leader.value()) {
         _watchers.notify(ntp, ntp, term, leader_id);
+        queue_leadership_change(ntp, term, leader_id);
+    }
+}
+
+void partition_leaders_table::queue_leadership_change(
+  const model::ntp& ntp,
+  model::term_id term,
+  std::optional<model::node_id> leader_id) {
+    if (_changes_watchers.empty()) {
+        return;
+    }
+    auto [it, inserted] = _pending_index.try_emplace(
+      ntp, _pending_changes.size());
+    if (inserted) {
+        _pending_changes.push_back(
+          leadership_change{.ntp = ntp, .term = term, .leader = leader_id});
+    } else {
+        auto& change = _pending_changes[it->second];
+        change.term = term;
+        change.leader = leader_id;
+    }
+    if (!_notify_timer.armed()) {
+        _notify_timer.arm(ss::lowres_clock::now());
+    }
+}
+
+void partition_leaders_table::notify_leadership_changes() {
+    auto changes = std::exchange(_pending_changes, {});
+    _pending_index.clear();
+    if (changes.empty()) {
+        return;
+    }
+    vlog(
+      clusterlog.trace,
+      "notifying {} leadership changes to {} subscribers",
+      changes.size(),
+      _changes_watchers.size());
+
+    std::vector<notification_id_type> ids;
+    ids.reserve(_changes_watchers.size());
+    for (const auto& [id, _] : _changes_watchers) {
+        ids.push_back(id);
+    }
+    _notifying = true;
+    for (auto id : ids) {
+        auto it = _changes_watchers.find(id);
+        if (
+          it == _changes_watchers.end()
+          || std::find(
+               _unregistered_while_notifying.begin(),
+               _unregistered_while_notifying.end(),
+               id)
+               != _unregistered_while_notifying.end()) {
+            continue;
+        }
+        it->second(changes);
+    }
+    _notifying = false;
+    for (auto id : std::exchange(_unregistered_while_notifying, {})) {
+        _changes_watchers.erase(id);
     }
 }
 
@@ -227,9 +293,21 @@ partition_leaders_table::get_leaders() const {
 }
 
 notification_id_type
-partition_leaders_table::register_leadership_change_notification(
-  leader_change_cb_t cb) {
-    return _watchers.register_notify(std::move(cb));
+partition_leaders_table::register_leadership_changes_notification(
+  leadership_changes_cb_t cb) {
+    auto id = _changes_watcher_id++;
+    _changes_watchers.emplace(id, std::move(cb));
+    return id;
+}
+
+void partition_leaders_table::unregister_leadership_changes_notification(
+  notification_id_type id) {
+    if (_notifying) {
+        // the callback being invoked may be the one unregistered
+        _unregistered_while_notifying.push_back(id);
+        return;
+    }
+    _changes_watchers.erase(id);
 }
 
 notification_id_type
@@ -238,11 +316,6 @@ partition_leaders_table::register_leadership_change_notification(
     return _watchers.register_notify(ntp, std::move(cb));
 }
 
-void partition_leaders_table::unregister_leadership_change_notification(
-  notification_id_type id) {
-    return _watchers.unregister_notify(id);
-}
-
 void partition_leaders_table::unregister_leadership_change_notification(
   const model::ntp& ntp, notification_id_type id) {
     return _watchers.unregister_notify(ntp, id);
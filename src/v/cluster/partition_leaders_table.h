@@ -18,12 +18,15 @@
 #include "model/metadata.h"
 #include "utils/expiring_promise.h"
 
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/timer.hh>
 
 #include <absl/container/flat_hash_map.h>
 #include <absl/container/node_hash_map.h>
 
 #include <optional>
+#include <vector>
 
 namespace cluster {
 
@@ -82,6 +85,7 @@ public:
         // ignore updates with old revision
         if (it != _leaders.end() && it->second.partition_revision <= revision) {
             _leaders.erase(it);
+            forget_leadership_version(model::topic_namespace_view(ntp));
         }
     }
 
@@ -94,7 +98,22 @@ public:
       model::term_id,
       std::optional<model::node_id>);
 
-    void reset() { _leaders.clear(); }
+    void reset() {
+        _leaders.clear();
+        _topic_versions.clear();
+        _untracked_version = ++_version;
+    }
+
+    /**
+     * Returns a version that changes whenever leadership of any partition of
+     * the topic changes (including changes of term with the same leader).
+     * Versions are only meaningful for equality checks, they allow callers to
+     * cache values derived from the topic leadership.
+     */
+    uint64_t leadership_version(model::topic_namespace_view tp_ns) const {
+        auto it = _topic_versions.find(tp_ns);
+        return it != _topic_versions.end() ? it->second : _untracked_version;
+    }
 
     struct leader_info_t {
         model::topic_namespace tp_ns;
@@ -114,16 +133,32 @@ public:
     using leader_change_cb_t = ss::noncopyable_function<void(
       model::ntp, model::term_id, std::optional<model::node_id>)>;
 
-    // Register a callback for all leadership changes
+    struct leadership_change {
+        model::ntp ntp;
+        model::term_id term;
+        std::optional<model::node_id> leader;
+    };
+
+    using leadership_changes_t = std::vector<leadership_change>;
+    using leadership_changes_cb_t
+      = ss::noncopyable_function<void(const leadership_changes_t&)>;
+
+    /**
+     * Register a callback for all leadership changes. Changes are coalesced
+     * and delivered in batches once per lowres clock tick rather than one by
+     * one: a leadership storm updates thousands of partitions on every shard
+     * at once, and subscribers called per partition stall the reactor. Only
+     * the last change of a partition within a batch is delivered.
+     */
     notification_id_type
-      register_leadership_change_notification(leader_change_cb_t);
+      register_leadership_changes_notification(leadership_changes_cb_t);
+
+    void unregister_leadership_changes_notification(notification_id_type);
 
     // Register a callback for a change in leadership for a specific ntp.
     notification_id_type register_leadership_change_notification(
       const model::ntp&, leader_change_cb_t);
 
-    void unregister_leadership_change_notification(notification_id_type);
-
     void unregister_leadership_change_notification(
       const model::ntp&, notification_id_type);
 
@@ -204,9 +239,37 @@ private:
     std::optional<leader_meta>
       find_leader_meta(model::topic_namespace_view, model::partition_id) const;
 
+    void bump_leadership_version(model::topic_namespace_view tp_ns) {
+        auto it = _topic_versions.find(tp_ns);
+        if (it == _topic_versions.end()) {
+            _topic_versions.emplace(model::topic_namespace(tp_ns), ++_version);
+        } else {
+            it->second = ++_version;
+        }
+    }
+
+    // topic entry may still be referenced by other partitions, dropping it
+    // moves the topic to the untracked version which is bumped as well so
+    // that no previously returned version can be observed again
+    void forget_leadership_version(model::topic_namespace_view tp_ns) {
+        _topic_versions.erase(tp_ns);
+        _untracked_version = ++_version;
+    }
+
     absl::flat_hash_map<leader_key, leader_meta, leader_key_hash, leader_key_eq>
       _leaders;
 
+    // per topic leadership versions, all versions are drawn from a single
+    // counter so that they are never reused
+    absl::flat_hash_map<
+      model::topic_namespace,
+      uint64_t,
+      model::topic_namespace_hash,
+      model::topic_namespace_eq>
+      _topic_versions;
+    uint64_t _version{0};
+    uint64_t _untracked_version{0};
+
     // per-ntp notifications for leadership election. note that the
     // namespace is currently ignored pending an update to the metadata
     // cache that attaches a namespace to all topics partition references.
@@ -219,9 +282,25 @@ private:
 
     promises_t _leader_promises;
 
+    void queue_leadership_change(
+      const model::ntp&, model::term_id, std::optional<model::node_id>);
+    void notify_leadership_changes();
+
     ss::sharded<topic_table>& _topic_table;
 
     ntp_callbacks<leader_change_cb_t> _watchers;
+
+    // batched notifications, node map so that callbacks may register or
+    // unregister subscribers while they are invoked
+    absl::node_hash_map<notification_id_type, leadership_changes_cb_t>
+      _changes_watchers;
+    notification_id_type _changes_watcher_id{0};
+    std::vector<notification_id_type> _unregistered_while_notifying;
+    bool _notifying{false};
+    // changes not yet delivered, indexed by ntp to keep only the last one
+    leadership_changes_t _pending_changes;
+    absl::node_hash_map<model::ntp, size_t> _pending_index;
+    ss::timer<ss::lowres_clock> _notify_timer;
 };
 
 } // namespace cluster
@@ -57,7 +57,9 @@ partition_manager::partition_manager(
   , _partition_recovery_mgr(recovery_mgr)
   , _cloud_storage_api(cloud_storage_api)
   , _cloud_storage_cache(cloud_storage_cache)
-  , _feature_table(feature_table) {}
+  , _feature_table(feature_table)
+  , _metrics_aggregator(ss::make_lw_shared<partition_metrics_aggregator>(
+      config::shard_local_cfg().partition_metrics_aggregation())) {}
 
 partition_manager::ntp_table_container
 partition_manager::get_topic_partition_table(
@@ -76,7 +78,8 @@ ss::future<consensus_ptr> partition_manager::manage(
   raft::group_id group,
   std::vector<model::broker> initial_nodes,
   std::optional<remote_topic_properties> rtp,
-  std::optional<s3::bucket_name> read_replica_bucket) {
+  std::optional<s3::bucket_name> read_replica_bucket,
+  storage::recovery_priority recovery_prio) {
     gate_guard guard(_gate);
     auto dl_result = co_await maybe_download_log(ntp_cfg, rtp);
     auto [logs_recovered, min_kafka_offset, max_kafka_offset, manifest]
@@ -133,7 +136,8 @@ ss::future<consensus_ptr> partition_manager::manage(
               ntp_cfg, manifest, max_kafka_offset);
         }
     }
-    storage::log log = co_await _storage.log_mgr().manage(std::move(ntp_cfg));
+    storage::log log = co_await _storage.log_mgr().manage(
+      std::move(ntp_cfg), recovery_prio);
     vlog(
       clusterlog.debug,
       "Log created manage completed, ntp: {}, rev: {}, {} "
@@ -153,6 +157,7 @@ ss::future<consensus_ptr> partition_manager::manage(
       _cloud_storage_api,
       _cloud_storage_cache,
       _feature_table,
+      _metrics_aggregator,
       read_replica_bucket);
 
     _ntp_table.emplace(log.config().ntp(), p);
@@ -81,7 +81,8 @@ public:
       raft::group_id,
       std::vector<model::broker>,
       std::optional<remote_topic_properties> = std::nullopt,
-      std::optional<s3::bucket_name> = std::nullopt);
+      std::optional<s3::bucket_name> = std::nullopt,
+      storage::recovery_priority = storage::recovery_priority::normal);
 
     ss::future<> shutdown(const model::ntp& ntp);
     ss::future<> remove(const model::ntp& ntp);
@@ -199,6 +200,8 @@ private:
     ss::sharded<cloud_storage::remote>& _cloud_storage_api;
     ss::sharded<cloud_storage::cache>& _cloud_storage_cache;
     ss::sharded<feature_table>& _feature_table;
+    // shared with the probes of the partitions, which may outlive the manager
+    ss::lw_shared_ptr<partition_metrics_aggregator> _metrics_aggregator;
     ss::gate _gate;
     bool _block_new_leadership{false};
 
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#include "cluster/partition_movement_scheduler.h"
+
+#include <algorithm>
+
+namespace cluster {
+
+void partition_movement_scheduler::start_round(
+  const limits& l, clock_type::time_point now) {
+    _limits = l;
+    _node_moves.clear();
+    _in_progress = 0;
+
+    if (!_limits.bandwidth) {
+        _last_refill.reset();
+        return;
+    }
+    const auto rate = static_cast<double>(*_limits.bandwidth);
+    const auto max_budget = rate * max_burst_seconds;
+    if (!_last_refill) {
+        _budget = max_budget;
+    } else {
+        auto elapsed = std::chrono::duration<double>(now - *_last_refill);
+        _budget = std::min(max_budget, _budget + rate * elapsed.count());
+    }
+    _last_refill = now;
+}
+
+void partition_movement_scheduler::add_in_progress(
+  const std::vector<model::node_id>& targets) {
+    ++_in_progress;
+    for (auto id : targets) {
+        ++_node_moves[id];
+    }
+}
+
+bool partition_movement_scheduler::try_start(
+  const std::vector<model::node_id>& targets, size_t size) {
+    if (_limits.bandwidth && _budget <= 0) {
+        return false;
+    }
+    for (auto id : targets) {
+        if (auto it = _node_moves.find(id);
+            it != _node_moves.end()
+            && it->second >= _limits.max_concurrent_per_node) {
+            return false;
+        }
+    }
+
+    add_in_progress(targets);
+    if (_limits.bandwidth) {
+        _budget -= static_cast<double>(size);
+    }
+    if (!_progress_start) {
+        _progress_start = clock_type::now();
+    }
+    return true;
+}
+
+bool partition_movement_scheduler::saturated(size_t nodes_count) const {
+    if (_limits.bandwidth && _budget <= 0) {
+        return true;
+    }
+    return _in_progress >= _limits.max_concurrent_per_node * nodes_count;
+}
+
+void partition_movement_scheduler::move_finished(size_t size) {
+    _finished_bytes += size;
+}
+
+void partition_movement_scheduler::reset_progress() {
+    _progress_start.reset();
+    _finished_bytes = 0;
+}
+
+std::optional<double>
+partition_movement_scheduler::throughput(clock_type::time_point now) const {
+    if (!_progress_start || _finished_bytes == 0) {
+        return std::nullopt;
+    }
+    auto elapsed = std::chrono::duration<double>(now - *_progress_start);
+    if (elapsed.count() <= 0) {
+        return std::nullopt;
+    }
+    return static_cast<double>(_finished_bytes) / elapsed.count();
+}
+
+std::optional<std::chrono::seconds> partition_movement_scheduler::eta(
+  size_t bytes_left, clock_type::time_point now) const {
+    auto rate = throughput(now);
+    if (!rate) {
+        return std::nullopt;
+    }
+    return std::chrono::seconds(
+      static_cast<int64_t>(static_cast<double>(bytes_left) / *rate));
+}
+
+} // namespace cluster
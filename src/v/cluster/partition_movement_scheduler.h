@@ -0,0 +1,104 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#pragma once
+
+#include "model/fundamental.h"
+#include "model/metadata.h"
+#include "seastarx.h"
+
+#include <seastar/core/lowres_clock.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace cluster {
+
+/**
+ * Admission control for partition moves driven by node operations.
+ *
+ * Every move recovers the partition on the nodes that are added to its
+ * replica set, so the number of moves recovering on a node at the same time is
+ * limited to keep its disk and network usable for the clients. Independently
+ * of the nodes involved, the bytes of the moves started are limited with a
+ * token bucket refilled at the cluster wide bandwidth budget: a move can start
+ * as long as the bucket is not empty and its size is taken from the bucket,
+ * possibly making it negative, so that large partitions are not starved.
+ *
+ * The scheduler also keeps track of the bytes moved to report the throughput
+ * of the movement and the time left to move the remaining bytes.
+ */
+class partition_movement_scheduler {
+public:
+    using clock_type = ss::lowres_clock;
+
+    struct limits {
+        // moves recovering on a single node at the same time
+        size_t max_concurrent_per_node;
+        // bytes per second, cluster wide. unlimited when not set
+        std::optional<size_t> bandwidth;
+    };
+
+    /**
+     * Starts a scheduling round: drops the accounting of the moves in
+     * progress, which is rebuilt with add_in_progress(), and refills the
+     * bandwidth budget.
+     */
+    void start_round(const limits&, clock_type::time_point now);
+
+    /// Accounts a move that is already in progress
+    void add_in_progress(const std::vector<model::node_id>& targets);
+
+    /**
+     * Returns true and accounts the move if it can start without exceeding
+     * the limits.
+     */
+    bool try_start(const std::vector<model::node_id>& targets, size_t size);
+
+    /// True when no more moves can start in this round
+    bool saturated(size_t nodes_count) const;
+
+    size_t in_progress() const { return _in_progress; }
+
+    /**
+     * Progress tracking, the throughput is measured from the first move
+     * started after reset_progress().
+     */
+    void move_finished(size_t size);
+    void reset_progress();
+
+    /// Bytes per second moved, nullopt until a move has finished
+    std::optional<double>
+    throughput(clock_type::time_point now = clock_type::now()) const;
+
+    /// Estimated time to move the given number of bytes
+    std::optional<std::chrono::seconds> eta(
+      size_t bytes_left, clock_type::time_point now = clock_type::now()) const;
+
+private:
+    // the bucket holds at most this many seconds of the budget
+    static constexpr double max_burst_seconds = 10;
+
+    limits _limits{.max_concurrent_per_node = 1};
+    absl::flat_hash_map<model::node_id, size_t> _node_moves;
+    size_t _in_progress{0};
+
+    // bandwidth token bucket, in bytes
+    double _budget{0};
+    std::optional<clock_type::time_point> _last_refill;
+
+    std::optional<clock_type::time_point> _progress_start;
+    size_t _finished_bytes{0};
+};
+
+} // namespace cluster
@@ -17,11 +17,174 @@
 
 #include <seastar/core/metrics.hh>
 
+#include <algorithm>
+#include <utility>
+
 namespace cluster {
 
+namespace {
+size_t under_replicated_replicas(const partition& p) {
+    auto metrics = p.raft()->get_follower_metrics();
+    return std::count_if(
+      metrics.cbegin(), metrics.cend(), [](const raft::follower_metrics& fm) {
+          return fm.under_replicated;
+      });
+}
+} // namespace
+
+partition_metrics_aggregator::handle::handle(
+  partition_metrics_aggregator* aggregator,
+  model::topic_namespace key,
+  group* g,
+  const partition* p)
+  : _aggregator(aggregator)
+  , _key(std::move(key))
+  , _group(g)
+  , _partition(p) {}
+
+partition_metrics_aggregator::handle::handle(handle&& other) noexcept
+  : _aggregator(std::exchange(other._aggregator, nullptr))
+  , _key(std::move(other._key))
+  , _group(std::exchange(other._group, nullptr))
+  , _partition(std::exchange(other._partition, nullptr)) {}
+
+partition_metrics_aggregator::handle&
+partition_metrics_aggregator::handle::operator=(handle&& other) noexcept {
+    if (this != &other) {
+        reset();
+        _aggregator = std::exchange(other._aggregator, nullptr);
+        _key = std::move(other._key);
+        _group = std::exchange(other._group, nullptr);
+        _partition = std::exchange(other._partition, nullptr);
+    }
+    return *this;
+}
+
+partition_metrics_aggregator::handle::~handle() noexcept { reset(); }
+
+void partition_metrics_aggregator::handle::reset() noexcept {
+    if (_aggregator) {
+        _aggregator->remove(_key, _partition);
+        _aggregator = nullptr;
+        _group = nullptr;
+    }
+}
+
+partition_metrics_aggregator::counters&
+partition_metrics_aggregator::handle::totals() {
+    return _group->totals;
+}
+
+partition_metrics_aggregator::partition_metrics_aggregator(
+  model::partition_metrics_aggregation mode)
+  : _mode(mode) {}
+
+partition_metrics_aggregator::handle
+partition_metrics_aggregator::add(const model::ntp& ntp, const partition& p) {
+    model::topic_namespace key;
+    if (_mode == model::partition_metrics_aggregation::topic) {
+        key = model::topic_namespace(ntp.ns, ntp.tp.topic);
+    }
+    auto [it, inserted] = _groups.try_emplace(key);
+    if (inserted) {
+        setup_metrics(key, it->second);
+    }
+    it->second.partitions.insert(&p);
+    return handle(this, std::move(key), &it->second, &p);
+}
+
+void partition_metrics_aggregator::remove(
+  const model::topic_namespace& key, const partition* p) {
+    auto it = _groups.find(key);
+    if (it == _groups.end()) {
+        return;
+    }
+    it->second.partitions.erase(p);
+    if (it->second.partitions.empty()) {
+        // the series of a topic go away with its last partition on the shard
+        _groups.erase(it);
+    }
+}
+
+void partition_metrics_aggregator::setup_metrics(
+  const model::topic_namespace& key, group& g) {
+    namespace sm = ss::metrics;
+
+    std::vector<sm::label_instance> labels;
+    if (_mode == model::partition_metrics_aggregation::topic) {
+        labels = {
+          sm::label("namespace")(key.ns()),
+          sm::label("topic")(key.tp()),
+        };
+    }
+    auto aggregate_labels = config::shard_local_cfg().aggregate_metrics()
+                              ? std::vector<sm::label>{sm::shard_label}
+                              : std::vector<sm::label>{};
+
+    g.metrics.add_group(
+      prometheus_sanitize::metrics_name("cluster:partition"),
+      {
+        sm::make_gauge(
+          "partitions",
+          [&g] { return g.partitions.size(); },
+          sm::description("Number of partition replicas"),
+          labels)
+          .aggregate(aggregate_labels),
+        sm::make_gauge(
+          "leader",
+          [&g] {
+              return std::count_if(
+                g.partitions.begin(), g.partitions.end(), [](const auto* p) {
+                    return p->is_elected_leader();
+                });
+          },
+          sm::description("Number of partition replicas that are leaders"),
+          labels)
+          .aggregate(aggregate_labels),
+        sm::make_gauge(
+          "under_replicated_replicas",
+          [&g] {
+              size_t total = 0;
+              for (const auto* p : g.partitions) {
+                  total += under_replicated_replicas(*p);
+              }
+              return total;
+          },
+          sm::description("Number of under replicated replicas"),
+          labels)
+          .aggregate(aggregate_labels),
+        sm::make_counter(
+          "records_produced",
+          [&g] { return g.totals.records_produced; },
+          sm::description("Total number of records produced"),
+          labels)
+          .aggregate(aggregate_labels),
+        sm::make_counter(
+          "records_fetched",
+          [&g] { return g.totals.records_fetched; },
+          sm::description("Total number of records fetched"),
+          labels)
+          .aggregate(aggregate_labels),
+        sm::make_total_bytes(
+          "bytes_produced_total",
+          [&g] { return g.totals.bytes_produced; },
+          sm::description("Total number of bytes produced"),
+          labels)
+          .aggregate(aggregate_labels),
+        sm::make_total_bytes(
+          "bytes_fetched_total",
+          [&g] { return g.totals.bytes_fetched; },
+          sm::description("Total number of bytes fetched"),
+          labels)
+          .aggregate(aggregate_labels),
+      });
+}
+
 replicated_partition_probe::replicated_partition_probe(
-  const partition& p) noexcept
+  const partition& p,
+  ss::lw_shared_ptr<partition_metrics_aggregator> aggregator) noexcept
   : _partition(p)
+  , _aggregator(std::move(aggregator))
   , _public_metrics(ssx::metrics::public_metrics_handle) {}
 
 void replicated_partition_probe::setup_metrics(const model::ntp& ntp) {
@@ -36,6 +199,11 @@ void replicated_partition_probe::setup_internal_metrics(const model::ntp& ntp) {
         return;
     }
 
+    if (_aggregator->enabled()) {
+        _aggregated = _aggregator->add(ntp, _partition);
+        return;
+    }
+
     auto ns_label = sm::label("namespace");
     auto topic_label = sm::label("topic");
     auto partition_label = sm::label("partition");
@@ -97,15 +265,7 @@ void replicated_partition_probe::setup_internal_metrics(const model::ntp& ntp) {
           .aggregate(aggregate_labels),
         sm::make_gauge(
           "under_replicated_replicas",
-          [this] {
-              auto metrics = _partition.raft()->get_follower_metrics();
-              return std::count_if(
-                metrics.cbegin(),
-                metrics.cend(),
-                [](const raft::follower_metrics& fm) {
-                    return fm.under_replicated;
-                });
-          },
+          [this] { return under_replicated_replicas(_partition); },
           sm::description("Number of under replicated replicas"),
           labels)
           .aggregate(aggregate_labels),
@@ -180,15 +340,7 @@ void replicated_partition_probe::setup_public_metrics(const model::ntp& ntp) {
           .aggregate({sm::shard_label}),
         sm::make_gauge(
           "under_replicated_replicas",
-          [this] {
-              auto metrics = _partition.raft()->get_follower_metrics();
-              return std::count_if(
-                metrics.cbegin(),
-                metrics.cend(),
-                [](const raft::follower_metrics& fm) {
-                    return fm.under_replicated;
-                });
-          },
+          [this] { return under_replicated_replicas(_partition); },
           sm::description("Number of under replicated replicas (i.e. replicas "
                           "that are live, but not at the latest offest)"),
           labels)
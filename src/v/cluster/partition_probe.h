@@ -11,16 +11,175 @@
 
 #pragma once
 #include "model/fundamental.h"
+#include "model/metadata.h"
 
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/core/metrics_registration.hh>
 #include <seastar/core/shared_ptr.hh>
 
+#include <absl/container/flat_hash_set.h>
+#include <absl/container/node_hash_map.h>
+
+#include <bit>
+#include <chrono>
 #include <cstdint>
 
 namespace cluster {
 
 class partition;
 
+/**
+ * Metrics of the partitions of a shard folded into a series per topic or a
+ * single series for the node when the partitions are created, rather than
+ * every partition registering its own series that are aggregated, if at all,
+ * when they are scraped. The number of series, and so the cost of a scrape,
+ * grows with the number of topics rather than with the number of partitions.
+ *
+ * Only metrics that can be summed are aggregated: the number of partitions,
+ * leaders and under replicated replicas and the traffic counters. The
+ * counters of a group keep the traffic of its partitions that were removed
+ * from the shard so that they never go backwards.
+ */
+class partition_metrics_aggregator {
+    struct group;
+
+public:
+    struct counters {
+        uint64_t records_produced{0};
+        uint64_t records_fetched{0};
+        uint64_t bytes_produced{0};
+        uint64_t bytes_fetched{0};
+    };
+
+    /// Membership of a partition in its group, removes it when destroyed
+    class handle {
+    public:
+        handle() = default;
+        handle(const handle&) = delete;
+        handle& operator=(const handle&) = delete;
+        handle(handle&&) noexcept;
+        handle& operator=(handle&&) noexcept;
+        ~handle() noexcept;
+
+        explicit operator bool() const { return _aggregator != nullptr; }
+        counters& totals();
+
+    private:
+        friend partition_metrics_aggregator;
+        handle(
+          partition_metrics_aggregator*,
+          model::topic_namespace,
+          group*,
+          const partition*);
+
+        void reset() noexcept;
+
+        partition_metrics_aggregator* _aggregator{nullptr};
+        model::topic_namespace _key;
+        group* _group{nullptr};
+        const partition* _partition{nullptr};
+    };
+
+    explicit partition_metrics_aggregator(
+      model::partition_metrics_aggregation);
+
+    partition_metrics_aggregator(const partition_metrics_aggregator&) = delete;
+    partition_metrics_aggregator& operator=(const partition_metrics_aggregator&)
+      = delete;
+    partition_metrics_aggregator(partition_metrics_aggregator&&) = delete;
+    partition_metrics_aggregator& operator=(partition_metrics_aggregator&&)
+      = delete;
+    ~partition_metrics_aggregator() = default;
+
+    /// False when every partition registers its own series
+    bool enabled() const {
+        return _mode != model::partition_metrics_aggregation::partition;
+    }
+
+    handle add(const model::ntp&, const partition&);
+
+    size_t groups() const { return _groups.size(); }
+
+private:
+    struct group {
+        absl::flat_hash_set<const partition*> partitions;
+        counters totals;
+        ss::metrics::metric_groups metrics;
+    };
+
+    void remove(const model::topic_namespace&, const partition*);
+    void setup_metrics(const model::topic_namespace&, group&);
+
+    model::partition_metrics_aggregation _mode;
+    // groups are referenced by their metric callbacks, their addresses must
+    // be stable
+    absl::node_hash_map<model::topic_namespace, group> _groups;
+};
+
+/**
+ * Produce and fetch load of a partition, reported to the controller in the
+ * health reports and used by the partition balancer.
+ *
+ * Rates are averaged over windows of at least `window` that are rolled lazily
+ * when traffic is recorded or the rates are read, idle partitions cost
+ * nothing. Reported rates are rounded down to their 3 most significant bits
+ * so that steady traffic doesn't change every report.
+ */
+class partition_load_meter {
+public:
+    using clock_type = ss::lowres_clock;
+    static constexpr clock_type::duration window = std::chrono::seconds(30);
+
+    void
+    record(uint64_t bytes, clock_type::time_point now = clock_type::now()) {
+        roll(now);
+        _bytes += bytes;
+        ++_requests;
+    }
+
+    /// bytes produced and fetched per second
+    uint64_t bytes_rate(clock_type::time_point now = clock_type::now()) {
+        roll(now);
+        return _bytes_rate;
+    }
+
+    /// produce and fetch requests per second
+    uint64_t requests_rate(clock_type::time_point now = clock_type::now()) {
+        roll(now);
+        return _requests_rate;
+    }
+
+    static uint64_t quantize(uint64_t rate) {
+        constexpr int significant_bits = 3;
+        const int width = std::bit_width(rate);
+        if (width <= significant_bits) {
+            return rate;
+        }
+        const int shift = width - significant_bits;
+        return (rate >> shift) << shift;
+    }
+
+private:
+    void roll(clock_type::time_point now) {
+        const auto elapsed = now - _window_start;
+        if (elapsed < window) {
+            return;
+        }
+        const auto seconds = std::chrono::duration<double>(elapsed).count();
+        _bytes_rate = quantize(static_cast<uint64_t>(_bytes / seconds));
+        _requests_rate = quantize(static_cast<uint64_t>(_requests / seconds));
+        _bytes = 0;
+        _requests = 0;
+        _window_start = now;
+    }
+
+    clock_type::time_point _window_start = clock_type::now();
+    uint64_t _bytes{0};
+    uint64_t _requests{0};
+    uint64_t _bytes_rate{0};
+    uint64_t _requests_rate{0};
+};
+
 class partition_probe {
 public:
     struct impl {
@@ -47,26 +206,53 @@ public:
         return _impl->add_records_fetched(num_records);
     }
     void add_bytes_produced(uint64_t bytes) {
+        _load.record(bytes);
         return _impl->add_bytes_produced(bytes);
     }
 
     void add_bytes_fetched(uint64_t bytes) {
+        _load.record(bytes);
         return _impl->add_bytes_fetched(bytes);
     }
 
+    partition_load_meter& load() { return _load; }
+
 private:
     std::unique_ptr<impl> _impl;
+    partition_load_meter _load;
 };
 class replicated_partition_probe : public partition_probe::impl {
 public:
-    explicit replicated_partition_probe(const partition&) noexcept;
+    replicated_partition_probe(
+      const partition&,
+      ss::lw_shared_ptr<partition_metrics_aggregator>) noexcept;
 
     void setup_metrics(const model::ntp&) final;
 
-    void add_records_fetched(uint64_t cnt) final { _records_fetched += cnt; }
-    void add_records_produced(uint64_t cnt) final { _records_produced += cnt; }
-    void add_bytes_fetched(uint64_t cnt) final { _bytes_fetched += cnt; }
-    void add_bytes_produced(uint64_t cnt) final { _bytes_produced += cnt; }
+    void add_records_fetched(uint64_t cnt) final {
+        _records_fetched += cnt;
+        if (_aggregated) {
+            _aggregated.totals().records_fetched += cnt;
+        }
+    }
+    void add_records_produced(uint64_t cnt) final {
+        _records_produced += cnt;
+        if (_aggregated) {
+            _aggregated.totals().records_produced += cnt;
+        }
+    }
+    void add_bytes_fetched(uint64_t cnt) final {
+        _bytes_fetched += cnt;
+        if (_aggregated) {
+            _aggregated.totals().bytes_fetched += cnt;
+        }
+    }
+    void add_bytes_produced(uint64_t cnt) final {
+        _bytes_produced += cnt;
+        if (_aggregated) {
+            _aggregated.totals().bytes_produced += cnt;
+        }
+    }
 
 private:
     void setup_public_metrics(const model::ntp&);
@@ -74,6 +260,8 @@ private:
 
 private:
     const partition& _partition;
+    ss::lw_shared_ptr<partition_metrics_aggregator> _aggregator;
+    partition_metrics_aggregator::handle _aggregated;
     uint64_t _records_produced{0};
     uint64_t _records_fetched{0};
     uint64_t _bytes_produced{0};
@@ -14,14 +14,17 @@
 #include "kafka/protocol/request_reader.h"
 #include "kafka/protocol/response_writer.h"
 #include "model/record.h"
+#include "prometheus/prometheus_sanitize.h"
 #include "raft/consensus_utils.h"
 #include "raft/errc.h"
 #include "raft/types.h"
 #include "storage/parser_utils.h"
 #include "storage/record_batch_builder.h"
+#include "utils/request_tracer.h"
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/metrics.hh>
 
 #include <filesystem>
 #include <optional>
@@ -222,13 +225,14 @@ rm_stm::rm_stm(
   ss::sharded<cluster::tx_gateway_frontend>& tx_gateway_frontend,
   ss::sharded<feature_table>& feature_table)
   : persisted_stm("tx.snapshot", logger, c)
-  , _oldest_session(model::timestamp::now())
   , _sync_timeout(config::shard_local_cfg().rm_sync_timeout_ms.value())
   , _tx_timeout_delay(config::shard_local_cfg().tx_timeout_delay_ms.value())
   , _abort_interval_ms(config::shard_local_cfg()
                          .abort_timed_out_transactions_interval_ms.value())
   , _abort_index_segment_size(
       config::shard_local_cfg().abort_index_segment_size.value())
+  , _abort_index_cache_size(
+      config::shard_local_cfg().abort_index_cache_size.value())
   , _seq_table_min_size(config::shard_local_cfg().seq_table_min_size.value())
   , _recovery_policy(
       config::shard_local_cfg().rm_violation_recovery_policy.value())
@@ -248,6 +252,125 @@ rm_stm::rm_stm(
         vassert(false, "Unknown recovery policy: {}", _recovery_policy);
     }
     auto_abort_timer.set_callback([this] { abort_old_txes(); });
+    setup_metrics();
+}
+
+void rm_stm::setup_metrics() {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+
+    namespace sm = ss::metrics;
+    auto ns_label = sm::label("namespace");
+    auto topic_label = sm::label("topic");
+    auto partition_label = sm::label("partition");
+    auto aggregate_labels = config::shard_local_cfg().aggregate_metrics()
+                              ? std::vector<sm::label>{sm::shard_label}
+                              : std::vector<sm::label>{};
+    const auto& ntp = _c->ntp();
+    const std::vector<sm::label_instance> labels = {
+      ns_label(ntp.ns()),
+      topic_label(ntp.tp.topic()),
+      partition_label(ntp.tp.partition()),
+    };
+
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("cluster:partition:aborted_tx"),
+      {sm::make_counter(
+         "lookups",
+         [this] { return _aborted_tx_probe.lookups; },
+         sm::description("Number of aborted transactions lookups"),
+         labels)
+         .aggregate(aggregate_labels),
+       sm::make_counter(
+         "index_cache_hits",
+         [this] { return _aborted_tx_probe.cache_hits; },
+         sm::description("Number of abort index lookups served from memory"),
+         labels)
+         .aggregate(aggregate_labels),
+       sm::make_counter(
+         "index_loads",
+         [this] { return _aborted_tx_probe.snapshot_loads; },
+         sm::description("Number of abort index segments read from disk"),
+         labels)
+         .aggregate(aggregate_labels),
+       sm::make_counter(
+         "ranges_scanned",
+         [this] { return _aborted_tx_probe.ranges_scanned; },
+         sm::description(
+           "Number of aborted transaction ranges examined by lookups"),
+         labels)
+         .aggregate(aggregate_labels)});
+}
+
+rm_stm::indexed_abort_snapshot::indexed_abort_snapshot(abort_snapshot snapshot)
+  : index{.first = snapshot.first, .last = snapshot.last}
+  , aborted(std::move(snapshot.aborted)) {
+    std::sort(
+      aborted.begin(), aborted.end(), [](const tx_range& a, const tx_range& b) {
+          return a.first < b.first;
+      });
+    max_last.reserve(aborted.size());
+    auto last = model::offset::min();
+    for (const auto& range : aborted) {
+        last = std::max(last, range.last);
+        max_last.push_back(last);
+    }
+}
+
+size_t rm_stm::indexed_abort_snapshot::intersecting(
+  std::vector<tx_range>& target, model::offset from, model::offset to) const {
+    auto end = std::upper_bound(
+      aborted.begin(),
+      aborted.end(),
+      to,
+      [](model::offset o, const tx_range& range) { return o < range.first; });
+    auto begin = aborted.begin()
+                 + (std::lower_bound(max_last.begin(), max_last.end(), from)
+                    - max_last.begin());
+    size_t scanned = 0;
+    for (auto it = begin; it < end; ++it) {
+        ++scanned;
+        if (it->last >= from) {
+            target.push_back(*it);
+        }
+    }
+    return scanned;
+}
+
+ss::lw_shared_ptr<const rm_stm::indexed_abort_snapshot>
+rm_stm::cached_abort_snapshot(abort_index idx) {
+    for (const auto& pending : _log_state.pending_abort_snapshots) {
+        if (
+          pending->index.first == idx.first
+          && pending->index.last == idx.last) {
+            return pending;
+        }
+    }
+    auto& cache = _log_state.abort_snapshot_cache;
+    auto it = std::find_if(cache.begin(), cache.end(), [idx](const auto& s) {
+        return s->index.first == idx.first && s->index.last == idx.last;
+    });
+    if (it == cache.end()) {
+        return nullptr;
+    }
+    auto snapshot = *it;
+    cache.erase(it);
+    cache.push_front(snapshot);
+    return snapshot;
+}
+
+void rm_stm::cache_abort_snapshot(
+  ss::lw_shared_ptr<const indexed_abort_snapshot> snapshot) {
+    if (cached_abort_snapshot(snapshot->index)) {
+        // loaded concurrently by another lookup
+        return;
+    }
+    auto& cache = _log_state.abort_snapshot_cache;
+    cache.push_front(std::move(snapshot));
+    while (cache.size() > _abort_index_cache_size) {
+        cache.pop_back();
+    }
 }
 
 bool rm_stm::check_tx_permitted() {
@@ -838,6 +961,8 @@ ss::future<result<kafka_result>> rm_stm::do_replicate(
     return _state_lock.hold_read_lock().then(
       [this, enqueued, bid, opts, b = std::move(b)](
         ss::basic_rwlock<>::holder unit) mutable {
+          request_tracer::local().record(
+            opts.trace, trace_stage::rm_stm_replicate);
           if (bid.is_transactional) {
               auto pid = bid.pid.get_id();
               return get_tx_lock(pid)
@@ -951,20 +1076,18 @@ rm_stm::do_mark_expired(model::producer_identity pid) {
 }
 
 bool rm_stm::check_seq(model::batch_identity bid) {
-    auto& seq = _log_state.seq_table[bid.pid];
-    auto last_write_timestamp = model::timestamp::now().value();
+    auto pid_seq = _log_state.seq_table.find(bid.pid);
+    auto last_seq = pid_seq == _log_state.seq_table.end()
+                      ? -1
+                      : pid_seq->second.seq;
 
-    if (!is_sequence(seq.seq, bid.first_seq)) {
+    if (!is_sequence(last_seq, bid.first_seq)) {
         return false;
     }
 
+    auto& seq = _log_state.touch_seqs(bid.pid, model::timestamp::now().value());
     seq.update(bid.last_seq, kafka::offset{-1});
 
-    seq.pid = bid.pid;
-    seq.last_write_timestamp = last_write_timestamp;
-    _oldest_session = std::min(
-      _oldest_session, model::timestamp(seq.last_write_timestamp));
-
     return true;
 }
 
@@ -977,7 +1100,7 @@ rm_stm::known_seq(model::batch_identity bid) const {
     if (pid_seq->second.seq == bid.last_seq) {
         return pid_seq->second.last_offset;
     }
-    for (auto& entry : pid_seq->second.seq_cache) {
+    for (const auto& entry : pid_seq->second.cached()) {
         if (entry.seq == bid.last_seq) {
             return entry.offset;
         }
@@ -1004,13 +1127,9 @@ void rm_stm::set_seq(model::batch_identity bid, kafka::offset last_offset) {
 
 void rm_stm::reset_seq(model::batch_identity bid) {
     _log_state.seq_table.erase(bid.pid);
-    auto& seq = _log_state.seq_table[bid.pid];
+    auto& seq = _log_state.touch_seqs(bid.pid, model::timestamp::now().value());
     seq.seq = bid.last_seq;
     seq.last_offset = kafka::offset{-1};
-    seq.pid = bid.pid;
-    seq.last_write_timestamp = model::timestamp::now().value();
-    _oldest_session = std::min(
-      _oldest_session, model::timestamp(seq.last_write_timestamp));
 }
 
 ss::future<result<kafka_result>>
@@ -1326,11 +1445,12 @@ ss::future<result<kafka_result>> rm_stm::replicate_seq(
             // apply will do it for us
             break;
         }
-        auto [seq_it, inserted] = _log_state.seq_table.try_emplace(bid.pid);
-        if (inserted) {
-            seq_it->second.pid = bid.pid;
-            seq_it->second.seq = front->last_seq;
-            seq_it->second.last_offset = front->r.value().last_offset;
+        auto seq_it = _log_state.seq_table.find(bid.pid);
+        if (seq_it == _log_state.seq_table.end()) {
+            auto& seq = _log_state.touch_seqs(
+              bid.pid, model::timestamp::now().value());
+            seq.seq = front->last_seq;
+            seq.last_offset = front->r.value().last_offset;
         } else {
             seq_it->second.update(
               front->last_seq, front->r.value().last_offset);
@@ -1419,12 +1539,25 @@ rm_stm::aborted_transactions(model::offset from, model::offset to) {
       });
 }
 
+ss::future<std::vector<storage::aborted_tx_range>>
+rm_stm::aborted_tx_ranges(model::offset from, model::offset to) {
+    auto ranges = co_await aborted_transactions(from, to);
+    std::vector<storage::aborted_tx_range> result;
+    result.reserve(ranges.size());
+    for (const auto& r : ranges) {
+        result.push_back(storage::aborted_tx_range{
+          .pid = r.pid, .first = r.first, .last = r.last});
+    }
+    co_return result;
+}
+
 ss::future<std::vector<rm_stm::tx_range>>
 rm_stm::do_aborted_transactions(model::offset from, model::offset to) {
     std::vector<rm_stm::tx_range> result;
     if (!_is_tx_enabled) {
         co_return result;
     }
+    ++_aborted_tx_probe.lookups;
     std::vector<abort_index> intersecting_idxes;
     for (const auto& idx : _log_state.abort_indexes) {
         if (idx.last < from) {
@@ -1433,71 +1566,47 @@ rm_stm::do_aborted_transactions(model::offset from, model::offset to) {
         if (idx.first > to) {
             continue;
         }
-        if (_log_state.last_abort_snapshot.match(idx)) {
-            auto opt = _log_state.last_abort_snapshot;
-            filter_intersecting(result, opt.aborted, from, to);
+        if (auto snapshot = cached_abort_snapshot(idx); snapshot) {
+            ++_aborted_tx_probe.cache_hits;
+            _aborted_tx_probe.ranges_scanned += snapshot->intersecting(
+              result, from, to);
         } else {
             intersecting_idxes.push_back(idx);
         }
     }
 
     filter_intersecting(result, _log_state.aborted, from, to);
+    _aborted_tx_probe.ranges_scanned += _log_state.aborted.size();
 
     for (const auto& idx : intersecting_idxes) {
         auto opt = co_await load_abort_snapshot(idx);
+        ++_aborted_tx_probe.snapshot_loads;
         if (opt) {
-            filter_intersecting(result, opt->aborted, from, to);
+            auto snapshot = ss::make_lw_shared<const indexed_abort_snapshot>(
+              std::move(*opt));
+            _aborted_tx_probe.ranges_scanned += snapshot->intersecting(
+              result, from, to);
+            cache_abort_snapshot(std::move(snapshot));
         }
     }
     co_return result;
 }
 
 void rm_stm::compact_snapshot() {
+    // the producers are expired in the order of their last write, an entry
+    // that was written out of timestamp order may outlive its expiration
+    // until the entries written before it expire
     auto cutoff_timestamp = model::timestamp::now().value()
                             - _transactional_id_expiration.count();
-    if (cutoff_timestamp <= _oldest_session.value()) {
-        return;
-    }
-
-    if (_log_state.seq_table.size() <= _seq_table_min_size) {
-        return;
-    }
-
-    if (_log_state.seq_table.size() == 0) {
-        return;
-    }
-
-    std::vector<model::timestamp::type> lw_tss;
-    lw_tss.reserve(_log_state.seq_table.size());
-    for (auto it = _log_state.seq_table.cbegin();
-         it != _log_state.seq_table.cend();
-         it++) {
-        lw_tss.push_back(it->second.last_write_timestamp);
-    }
-    std::sort(lw_tss.begin(), lw_tss.end());
-    auto pivot = lw_tss[lw_tss.size() - 1 - _seq_table_min_size];
-
-    if (pivot < cutoff_timestamp) {
-        cutoff_timestamp = pivot;
-    }
-
-    auto next_oldest_session = model::timestamp::now();
     auto size = _log_state.seq_table.size();
-    for (auto it = _log_state.seq_table.cbegin();
-         it != _log_state.seq_table.cend();) {
-        if (
-          size > _seq_table_min_size
-          && it->second.last_write_timestamp <= cutoff_timestamp) {
-            size--;
-            _log_state.seq_table.erase(it++);
-        } else {
-            next_oldest_session = std::min(
-              next_oldest_session,
-              model::timestamp(it->second.last_write_timestamp));
-            ++it;
+    while (size > _seq_table_min_size && !_log_state.seq_lru.empty()) {
+        auto& oldest = _log_state.seq_lru.front();
+        if (oldest.last_write_timestamp > cutoff_timestamp) {
+            break;
         }
+        size--;
+        _log_state.seq_table.erase(oldest.pid);
     }
-    _oldest_session = next_oldest_session;
 }
 
 ss::future<bool> rm_stm::sync(model::timeout_clock::duration timeout) {
@@ -1775,6 +1884,7 @@ ss::future<> rm_stm::apply(model::record_batch b) {
     _insync_offset = last_offset;
 
     compact_snapshot();
+    _tracked.update(_log_state.memory_size());
     if (_is_autoabort_enabled && !_is_autoabort_active) {
         abort_old_txes();
     }
@@ -1839,17 +1949,15 @@ ss::future<> rm_stm::reduce_aborted_list() {
 
 void rm_stm::apply_data(model::batch_identity bid, model::offset last_offset) {
     if (bid.has_idempotent()) {
-        auto [seq_it, inserted] = _log_state.seq_table.try_emplace(bid.pid);
+        auto inserted = !_log_state.seq_table.contains(bid.pid);
+        auto& seq = _log_state.touch_seqs(bid.pid, bid.first_timestamp.value());
         auto translated = from_log_offset(last_offset);
         if (inserted) {
-            seq_it->second.pid = bid.pid;
-            seq_it->second.seq = bid.last_seq;
-            seq_it->second.last_offset = translated;
+            seq.seq = bid.last_seq;
+            seq.last_offset = translated;
         } else {
-            seq_it->second.update(bid.last_seq, translated);
+            seq.update(bid.last_seq, translated);
         }
-        seq_it->second.last_write_timestamp = bid.first_timestamp.value();
-        _oldest_session = std::min(_oldest_session, bid.first_timestamp);
     }
 
     if (bid.is_transactional) {
@@ -1963,15 +2071,20 @@ rm_stm::apply_snapshot(stm_snapshot_header hdr, iobuf&& tx_ss_buf) {
       _log_state.abort_indexes.end(),
       std::make_move_iterator(data.abort_indexes.begin()),
       std::make_move_iterator(data.abort_indexes.end()));
+    // oldest first so that the LRU order follows the last writes
+    std::sort(
+      data.seqs.begin(), data.seqs.end(), [](const auto& a, const auto& b) {
+          return a.last_write_timestamp < b.last_write_timestamp;
+      });
     for (auto& entry : data.seqs) {
-        auto [seq_it, inserted] = _log_state.seq_table.try_emplace(
-          entry.pid, std::move(entry));
-        // try_emplace does not move from r-value reference if the insertion
-        // didn't take place so the clang-tidy warning is a false positive
-        // NOLINTNEXTLINE(hicpp-invalid-access-moved)
-        if (!inserted && seq_it->second.seq < entry.seq) {
-            seq_it->second = std::move(entry);
+        auto seq_it = _log_state.seq_table.find(entry.pid);
+        if (
+          seq_it != _log_state.seq_table.end()
+          && seq_it->second.seq >= entry.seq) {
+            continue;
         }
+        _log_state.touch_seqs(entry.pid, entry.last_write_timestamp)
+          .assign(entry);
     }
 
     abort_index last{.last = model::offset(-1)};
@@ -1983,12 +2096,15 @@ rm_stm::apply_snapshot(stm_snapshot_header hdr, iobuf&& tx_ss_buf) {
     if (last.last > model::offset(0)) {
         auto snapshot_opt = co_await load_abort_snapshot(last);
         if (snapshot_opt) {
-            _log_state.last_abort_snapshot = snapshot_opt.value();
+            cache_abort_snapshot(
+              ss::make_lw_shared<const indexed_abort_snapshot>(
+                std::move(*snapshot_opt)));
         }
     }
 
     _last_snapshot_offset = data.offset;
     _insync_offset = data.offset;
+    _tracked.update(_log_state.memory_size());
 }
 
 uint8_t rm_stm::active_snapshot_version() {
@@ -2017,23 +2133,17 @@ void rm_stm::fill_snapshot_wo_seqs(T& snapshot) {
     }
 }
 
-ss::future<> rm_stm::offload_aborted_txns() {
-    // This method iterates through _log_state.aborted collection
-    // and the loop's body contains sync points (co_await) so w/o
-    // further assumptions it's impossible to guarantee that the
-    // collection isn't updated by another coroutine while the
-    // current coroutine waits.
-
-    // We should prevent it because an update invalidates the ite-
-    // rator and may lead to undefined behavior. In order to avoid
-    // this situation, offload_aborted_txns should be invoked only
-    // under _state_lock's write lock because all the other updators
-    // use the read lock.
+std::vector<rm_stm::abort_snapshot> rm_stm::offload_aborted_txns() {
+    // Splits _log_state.aborted into the abort snapshots to offload. It
+    // doesn't yield so the state is captured at a single point and the
+    // apply path isn't paused, the snapshots stay pinned in memory until
+    // save_abort_snapshots writes them so the lookups never miss them.
     std::sort(
       std::begin(_log_state.aborted),
       std::end(_log_state.aborted),
       [](tx_range a, tx_range b) { return a.first < b.first; });
 
+    std::vector<abort_snapshot> offloaded;
     abort_snapshot snapshot{
       .first = model::offset::max(), .last = model::offset::min()};
     for (auto const& entry : _log_state.aborted) {
@@ -2044,12 +2154,28 @@ ss::future<> rm_stm::offload_aborted_txns() {
             auto idx = abort_index{
               .first = snapshot.first, .last = snapshot.last};
             _log_state.abort_indexes.push_back(idx);
-            co_await save_abort_snapshot(snapshot);
+            _log_state.pending_abort_snapshots.push_back(
+              ss::make_lw_shared<const indexed_abort_snapshot>(snapshot));
+            offloaded.push_back(std::move(snapshot));
             snapshot = abort_snapshot{
               .first = model::offset::max(), .last = model::offset::min()};
         }
     }
     _log_state.aborted = snapshot.aborted;
+    return offloaded;
+}
+
+ss::future<>
+rm_stm::save_abort_snapshots(std::vector<abort_snapshot> snapshots) {
+    for (auto& snapshot : snapshots) {
+        auto idx = abort_index{.first = snapshot.first, .last = snapshot.last};
+        co_await save_abort_snapshot(std::move(snapshot));
+        std::erase_if(
+          _log_state.pending_abort_snapshots, [idx](const auto& pending) {
+              return pending->index.first == idx.first
+                     && pending->index.last == idx.last;
+          });
+    }
 }
 
 ss::future<stm_snapshot> rm_stm::take_snapshot() {
@@ -2085,27 +2211,30 @@ ss::future<stm_snapshot> rm_stm::take_snapshot() {
       [start_offset](tx_range range) { return range.last >= start_offset; });
     _log_state.aborted = std::move(aborted);
 
+    // the state is captured without yielding, the abort snapshots are
+    // written and the captured state is serialized afterwards so the
+    // produce path and the apply fiber keep running meanwhile. the read
+    // lock only holds off the eviction and the removal of the persistent
+    // state until the offloaded abort snapshots are written.
+    std::optional<ss::basic_rwlock<>::holder> unit;
+    std::vector<abort_snapshot> offloaded;
     if (_log_state.aborted.size() > _abort_index_segment_size) {
-        co_await _state_lock.hold_write_lock().then(
-          [this](ss::basic_rwlock<>::holder unit) {
-              // software engineer be careful and do not cause a deadlock.
-              // take_snapshot is invoked under the persisted_stm::_op_lock
-              // and here here we take write lock (_state_lock). most rm_stm
-              // operations require its read lock. however they don't depend
-              // of _op_lock so things are safe now
-              return offload_aborted_txns().finally([u = std::move(unit)] {});
-          });
+        unit = co_await _state_lock.hold_read_lock();
+        offloaded = offload_aborted_txns();
     }
 
     iobuf tx_ss_buf;
     auto version = active_snapshot_version();
+    auto offset = _insync_offset;
     if (version == tx_snapshot::version) {
         tx_snapshot tx_ss;
         fill_snapshot_wo_seqs(tx_ss);
+        tx_ss.seqs.reserve(_log_state.seq_table.size());
         for (const auto& entry : _log_state.seq_table) {
-            tx_ss.seqs.push_back(entry.second.copy());
+            tx_ss.seqs.push_back(entry.second.to_seq_entry());
         }
         tx_ss.offset = _insync_offset;
+        co_await save_abort_snapshots(std::move(offloaded));
         reflection::adl<tx_snapshot>{}.to(tx_ss_buf, std::move(tx_ss));
     } else if (version == tx_snapshot_v1::version) {
         tx_snapshot_v1 tx_ss;
@@ -2122,8 +2251,8 @@ ss::future<stm_snapshot> rm_stm::take_snapshot() {
                 continue;
             }
             seqs.last_write_timestamp = entry.last_write_timestamp;
-            seqs.seq_cache.reserve(seqs.seq_cache.size());
-            for (auto& item : entry.seq_cache) {
+            seqs.seq_cache.reserve(entry.seq_cache_count);
+            for (const auto& item : entry.cached()) {
                 try {
                     seqs.seq_cache.push_back(seq_cache_entry_v1{
                       .seq = item.seq, .offset = to_log_offset(item.offset)});
@@ -2135,13 +2264,13 @@ ss::future<stm_snapshot> rm_stm::take_snapshot() {
             tx_ss.seqs.push_back(std::move(seqs));
         }
         tx_ss.offset = _insync_offset;
+        co_await save_abort_snapshots(std::move(offloaded));
         reflection::adl<tx_snapshot_v1>{}.to(tx_ss_buf, std::move(tx_ss));
     } else {
         vassert(false, "unsupported tx_snapshot version {}", version);
     }
 
-    co_return stm_snapshot::create(
-      version, _insync_offset, std::move(tx_ss_buf));
+    co_return stm_snapshot::create(version, offset, std::move(tx_ss_buf));
 }
 
 ss::future<> rm_stm::save_abort_snapshot(abort_snapshot snapshot) {
@@ -26,12 +26,20 @@
 #include "storage/snapshot.h"
 #include "utils/available_promise.h"
 #include "utils/expiring_promise.h"
+#include "utils/intrusive_list_helpers.h"
+#include "utils/memory_accounting.h"
 #include "utils/mutex.h"
 
+#include <seastar/core/metrics_registration.hh>
+
 #include <absl/container/btree_map.h>
 #include <absl/container/btree_set.h>
 #include <absl/container/flat_hash_map.h>
+#include <absl/container/node_hash_map.h>
 
+#include <array>
+#include <deque>
+#include <span>
 #include <system_error>
 
 namespace cluster {
@@ -81,6 +89,8 @@ public:
         kafka::offset offset;
     };
 
+    // on-disk (snapshot) representation of the sequences of a producer, see
+    // producer_seqs for the in-memory one
     struct seq_entry {
         static const int seq_cache_size = 5;
         model::producer_identity pid;
@@ -88,19 +98,35 @@ public:
         kafka::offset last_offset{-1};
         ss::circular_buffer<seq_cache_entry> seq_cache;
         model::timestamp::type last_write_timestamp;
+    };
 
-        seq_entry copy() const {
-            seq_entry ret;
-            ret.pid = pid;
-            ret.seq = seq;
-            ret.last_offset = last_offset;
-            ret.seq_cache.reserve(seq_cache.size());
-            std::copy(
-              seq_cache.cbegin(),
-              seq_cache.cend(),
-              std::back_inserter(ret.seq_cache));
-            ret.last_write_timestamp = last_write_timestamp;
-            return ret;
+    // the sequences of a producer. the cache of the recent sequences is
+    // kept inline so an entry is a single allocation, and the entry is
+    // linked in log_state::seq_lru to expire the idle producers in LRU order
+    struct producer_seqs {
+        static constexpr size_t seq_cache_capacity = seq_entry::seq_cache_size
+                                                     - 1;
+
+        model::producer_identity pid;
+        int32_t seq{-1};
+        kafka::offset last_offset{-1};
+        // oldest first
+        std::array<seq_cache_entry, seq_cache_capacity> seq_cache;
+        uint8_t seq_cache_count{0};
+        model::timestamp::type last_write_timestamp{0};
+        intrusive_list_hook lru_hook;
+
+        std::span<const seq_cache_entry> cached() const {
+            return {seq_cache.data(), seq_cache_count};
+        }
+
+        void cache(seq_cache_entry entry) {
+            if (seq_cache_count == seq_cache_capacity) {
+                std::move(
+                  seq_cache.begin() + 1, seq_cache.end(), seq_cache.begin());
+                --seq_cache_count;
+            }
+            seq_cache[seq_cache_count++] = entry;
         }
 
         void update(int32_t new_seq, kafka::offset new_offset) {
@@ -114,16 +140,36 @@ public:
             }
 
             if (seq >= 0 && last_offset >= kafka::offset{0}) {
-                auto entry = seq_cache_entry{.seq = seq, .offset = last_offset};
-                seq_cache.push_back(entry);
-                while (seq_cache.size() >= seq_entry::seq_cache_size) {
-                    seq_cache.pop_front();
-                }
+                cache(seq_cache_entry{.seq = seq, .offset = last_offset});
             }
 
             seq = new_seq;
             last_offset = new_offset;
         }
+
+        void assign(const seq_entry& entry) {
+            pid = entry.pid;
+            seq = entry.seq;
+            last_offset = entry.last_offset;
+            seq_cache_count = 0;
+            for (const auto& cached : entry.seq_cache) {
+                cache(cached);
+            }
+            last_write_timestamp = entry.last_write_timestamp;
+        }
+
+        seq_entry to_seq_entry() const {
+            seq_entry ret;
+            ret.pid = pid;
+            ret.seq = seq;
+            ret.last_offset = last_offset;
+            ret.seq_cache.reserve(seq_cache_count);
+            for (const auto& cached : cached()) {
+                ret.seq_cache.push_back(cached);
+            }
+            ret.last_write_timestamp = last_write_timestamp;
+            return ret;
+        }
     };
 
     struct tx_snapshot {
@@ -148,6 +194,23 @@ public:
         }
     };
 
+    // an abort snapshot indexed for interval lookups. the ranges are sorted
+    // by their first offset and max_last[i] is the highest last offset of
+    // the ranges [0, i] so the ranges intersecting [from, to] are located
+    // between the first max_last >= from and the last first <= to
+    struct indexed_abort_snapshot {
+        abort_index index;
+        std::vector<tx_range> aborted;
+        std::vector<model::offset> max_last;
+
+        explicit indexed_abort_snapshot(abort_snapshot);
+
+        // appends the ranges intersecting [from, to] to the target, returns
+        // the number of ranges examined
+        size_t intersecting(
+          std::vector<tx_range>&, model::offset from, model::offset to) const;
+    };
+
     static constexpr int8_t prepare_control_record_version{0};
     static constexpr int8_t fence_control_record_version{0};
 
@@ -173,6 +236,8 @@ public:
     model::offset last_stable_offset();
     ss::future<std::vector<rm_stm::tx_range>>
       aborted_transactions(model::offset, model::offset);
+    ss::future<std::vector<storage::aborted_tx_range>>
+      aborted_tx_ranges(model::offset, model::offset) override;
 
     kafka_stages replicate_in_stages(
       model::batch_identity,
@@ -283,6 +348,11 @@ private:
     ss::future<stm_snapshot> take_snapshot() override;
     ss::future<std::optional<abort_snapshot>> load_abort_snapshot(abort_index);
     ss::future<> save_abort_snapshot(abort_snapshot);
+    ss::future<> save_abort_snapshots(std::vector<abort_snapshot>);
+    ss::lw_shared_ptr<const indexed_abort_snapshot>
+      cached_abort_snapshot(abort_index);
+    void cache_abort_snapshot(ss::lw_shared_ptr<const indexed_abort_snapshot>);
+    void setup_metrics();
 
     bool check_seq(model::batch_identity);
     std::optional<kafka::offset> known_seq(model::batch_identity) const;
@@ -343,7 +413,7 @@ private:
     void apply_data(model::batch_identity, model::offset);
 
     ss::future<> reduce_aborted_list();
-    ss::future<> offload_aborted_txns();
+    std::vector<abort_snapshot> offload_aborted_txns();
 
     // The state of this state machine maybe change via two paths
     //
@@ -373,13 +443,50 @@ private:
         absl::flat_hash_map<model::producer_identity, prepare_marker> prepared;
         std::vector<tx_range> aborted;
         std::vector<abort_index> abort_indexes;
-        abort_snapshot last_abort_snapshot{.last = model::offset(-1)};
+        // recently used abort snapshots, the most recently used first
+        std::deque<ss::lw_shared_ptr<const indexed_abort_snapshot>>
+          abort_snapshot_cache;
+        // abort snapshots offloaded by take_snapshot but not written yet
+        std::vector<ss::lw_shared_ptr<const indexed_abort_snapshot>>
+          pending_abort_snapshots;
         // the only piece of data which we update on replay and before
         // replicating the command. we use the highest seq number to resolve
         // conflicts. if the replication fails we reject a command but clients
         // by spec should be ready for thier commands being rejected so it's
         // ok by design to have false rejects
-        absl::flat_hash_map<model::producer_identity, seq_entry> seq_table;
+        absl::node_hash_map<model::producer_identity, producer_seqs> seq_table;
+        // producers of seq_table in the order of their last write, the least
+        // recently written first
+        intrusive_list<producer_seqs, &producer_seqs::lru_hook> seq_lru;
+
+        // creates the producer's entry if needed and marks it as the most
+        // recently written one
+        producer_seqs&
+        touch_seqs(model::producer_identity pid, model::timestamp::type ts) {
+            auto [it, inserted] = seq_table.try_emplace(pid);
+            auto& seqs = it->second;
+            if (inserted) {
+                seqs.pid = pid;
+            }
+            seqs.last_write_timestamp = ts;
+            seqs.lru_hook.unlink();
+            seq_lru.push_back(seqs);
+            return seqs;
+        }
+
+        // memory held by the entries of the containers, an estimate that
+        // leaves out their bookkeeping overhead
+        size_t memory_size() const {
+            auto entries = [](const auto& c) {
+                using value_type =
+                  typename std::remove_cvref_t<decltype(c)>::value_type;
+                return c.size() * sizeof(value_type);
+            };
+            return entries(fence_pid_epoch) + entries(ongoing_map)
+                   + entries(ongoing_set) + entries(prepared)
+                   + entries(aborted) + entries(abort_indexes)
+                   + entries(seq_table);
+        }
     };
 
     struct mem_state {
@@ -520,13 +627,14 @@ private:
       ss::lw_shared_ptr<inflight_requests>>
       _inflight_requests;
     log_state _log_state;
+    tracked_memory _tracked{memory_subsystem::stm_state};
     mem_state _mem_state;
     ss::timer<clock_type> auto_abort_timer;
-    model::timestamp _oldest_session;
     std::chrono::milliseconds _sync_timeout;
     std::chrono::milliseconds _tx_timeout_delay;
     std::chrono::milliseconds _abort_interval_ms;
     uint32_t _abort_index_segment_size;
+    size_t _abort_index_cache_size;
     uint32_t _seq_table_min_size;
     model::violation_recovery_policy _recovery_policy;
     std::chrono::milliseconds _transactional_id_expiration;
@@ -537,6 +645,16 @@ private:
     storage::snapshot_manager _abort_snapshot_mgr;
     ss::lw_shared_ptr<const storage::offset_translator_state> _translator;
     ss::sharded<feature_table>& _feature_table;
+
+    // cost of the aborted transactions lookups of read_committed fetches
+    struct aborted_tx_probe {
+        uint64_t lookups{0};
+        uint64_t cache_hits{0};
+        uint64_t snapshot_loads{0};
+        uint64_t ranges_scanned{0};
+    };
+    aborted_tx_probe _aborted_tx_probe;
+    ss::metrics::metric_groups _metrics;
 };
 
 } // namespace cluster
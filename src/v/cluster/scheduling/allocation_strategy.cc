@@ -37,120 +37,96 @@ inline bool contains_node_already(
     return it != current_allocations.end();
 }
 
-std::vector<model::node_id> solve_hard_constraints(
-  const std::vector<allocation_constraints::hard_constraint_ev_ptr>&
-    constraints,
-  const allocation_state::underlying_t& nodes) {
-    // empty hard constraints, all nodes are eligible
-    std::vector<model::node_id> possible_nodes;
-    if (unlikely(constraints.empty())) {
-        possible_nodes.reserve(nodes.size());
-        std::transform(
-          nodes.begin(),
-          nodes.end(),
-          std::back_inserter(possible_nodes),
-          [](const allocation_state::underlying_t::value_type& v) {
-              return v.first;
-          });
-        return possible_nodes;
-    }
-    for (auto& p : nodes) {
-        auto& node = p.second;
-        auto result = std::all_of(
-          constraints.begin(),
-          constraints.end(),
-          [&node](const allocation_constraints::hard_constraint_ev_ptr& ev) {
-              return ev->evaluate(*node);
-          });
-
-        if (result) {
-            possible_nodes.push_back(p.first);
+/**
+ * Nodes are evaluated a constraint at a time: every hard constraint filters
+ * the whole candidate list and every soft constraint scores all the remaining
+ * candidates into a score array. This keeps the per node work to tight loops
+ * instead of a chain of virtual calls for every node. The buffers are kept by
+ * the strategy and reused for every replica.
+ */
+class batch_allocation_strategy final : public allocation_strategy::impl {
+public:
+    result<model::broker_shard> allocate_replica(
+      const allocation_constraints& request, allocation_state& state) final {
+        const auto& nodes = state.allocation_nodes();
+        /**
+         * evaluate hard constraints
+         */
+        _candidates.clear();
+        _candidates.reserve(nodes.size());
+        for (const auto& [_, node] : nodes) {
+            _candidates.push_back(node.get());
+        }
+        for (const auto& ev : request.hard_constraints) {
+            if (_candidates.empty()) {
+                break;
+            }
+            ev->filter(_candidates);
         }
-    }
-    return possible_nodes;
-}
 
-model::node_id find_best_fit(
-  const std::vector<allocation_constraints::soft_constraint_ev_ptr>&
-    constraints,
-  const std::vector<model::node_id>& possible_nodes,
-  const allocation_state::underlying_t& nodes) {
-    if (possible_nodes.size() == 1) {
-        return possible_nodes.front();
-    }
+        if (_candidates.empty()) {
+            return errc::no_eligible_allocation_nodes;
+        }
 
-    uint32_t best_score = 0;
-    std::vector<model::node_id> best_fits;
+        /**
+         * soft constraints
+         */
+        auto id = find_best_fit(request.soft_constraints);
 
-    for (const auto& id : possible_nodes) {
         auto it = nodes.find(id);
-        if (it == nodes.end()) {
-            continue;
+        vassert(
+          it != nodes.end(),
+          "allocated node with id {} have to be present",
+          id);
+        auto core = (it->second)->allocate();
+        return model::broker_shard{
+          .node_id = it->first,
+          .shard = core,
+        };
+    }
+
+private:
+    model::node_id find_best_fit(
+      const std::vector<allocation_constraints::soft_constraint_ev_ptr>&
+        constraints) {
+        if (_candidates.size() == 1) {
+            return _candidates.front()->id();
         }
 
-        uint32_t score = std::accumulate(
-          constraints.begin(),
-          constraints.end(),
-          0,
-          [&node = it->second](
-            uint32_t score,
-            const allocation_constraints::soft_constraint_ev_ptr& ev) {
-              return score + ev->score(*node);
-          });
-
-        if (score >= best_score) {
-            if (score > best_score) {
-                // untied, winner clear out existing winners
-                best_score = score;
-                best_fits.clear();
+        _scores.assign(_candidates.size(), 0);
+        for (const auto& ev : constraints) {
+            ev->add_scores(_candidates, _scratch, _scores);
+        }
+
+        uint64_t best_score = 0;
+        _best_fits.clear();
+        for (size_t i = 0; i < _candidates.size(); ++i) {
+            if (_scores[i] >= best_score) {
+                if (_scores[i] > best_score) {
+                    // untied, winner clear out existing winners
+                    best_score = _scores[i];
+                    _best_fits.clear();
+                }
+                _best_fits.push_back(_candidates[i]->id());
             }
-            best_fits.push_back(it->first);
         }
-    }
 
-    vassert(!best_fits.empty(), "best_fits empty");
+        vassert(!_best_fits.empty(), "best_fits empty");
 
-    // we break ties randomly, by selecting a random node out of those
-    // with the highest score
-    return best_fits.at(random_generators::get_int(best_fits.size() - 1));
-}
+        // we break ties randomly, by selecting a random node out of those
+        // with the highest score
+        return _best_fits.at(
+          random_generators::get_int(_best_fits.size() - 1));
+    }
 
-allocation_strategy simple_allocation_strategy() {
-    class impl : public allocation_strategy::impl {
-    public:
-        result<model::broker_shard> allocate_replica(
-          const allocation_constraints& request,
-          allocation_state& state) final {
-            const auto& nodes = state.allocation_nodes();
-            /**
-             * evaluate hard constraints
-             */
-            std::vector<model::node_id> possible_nodes = solve_hard_constraints(
-              request.hard_constraints, state.allocation_nodes());
-
-            if (possible_nodes.empty()) {
-                return errc::no_eligible_allocation_nodes;
-            }
+    std::vector<const allocation_node*> _candidates;
+    std::vector<uint64_t> _scores;
+    std::vector<uint64_t> _scratch;
+    std::vector<model::node_id> _best_fits;
+};
 
-            /**
-             * soft constraints
-             */
-            auto best_fit = find_best_fit(
-              request.soft_constraints, possible_nodes, nodes);
-
-            auto it = nodes.find(best_fit);
-            vassert(
-              it != nodes.end(),
-              "allocated node with id {} have to be present",
-              best_fit);
-            auto core = (it->second)->allocate();
-            return model::broker_shard{
-              .node_id = it->first,
-              .shard = core,
-            };
-        }
-    };
-    return make_allocation_strategy<impl>();
+allocation_strategy simple_allocation_strategy() {
+    return make_allocation_strategy<batch_allocation_strategy>();
 };
 
 } // namespace cluster
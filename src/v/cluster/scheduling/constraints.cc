@@ -226,6 +226,31 @@ soft_constraint_evaluator distinct_rack(
                    / _state.available_nodes();
         }
 
+        void score_all(
+          const std::vector<const allocation_node*>& nodes,
+          std::vector<uint64_t>& scores) const final {
+            const uint64_t distinct = soft_constraint_evaluator::max_score
+                                      / _state.available_nodes();
+            // look up the racks of the replicas once for all the nodes, the
+            // racks following a replica without one are not relevant
+            std::vector<model::rack_id> racks;
+            racks.reserve(_replicas.size());
+            for (auto [node_id, shard] : _replicas) {
+                auto rack = _state.get_rack_id(node_id);
+                if (!rack.has_value()) {
+                    break;
+                }
+                racks.push_back(std::move(*rack));
+            }
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                const auto& rack = nodes[i]->rack();
+                scores[i] = std::find(racks.begin(), racks.end(), rack)
+                                == racks.end()
+                              ? distinct
+                              : 0;
+            }
+        }
+
         void print(std::ostream& o) const final {
             fmt::print(o, "distinct rack");
         }
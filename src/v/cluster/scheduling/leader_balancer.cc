@@ -10,6 +10,7 @@
  */
 #include "cluster/scheduling/leader_balancer.h"
 
+#include "cluster/health_monitor_frontend.h"
 #include "cluster/logger.h"
 #include "cluster/members_table.h"
 #include "cluster/partition_leaders_table.h"
@@ -43,24 +44,28 @@ leader_balancer::leader_balancer(
   raft::consensus_client_protocol client,
   ss::sharded<shard_table>& shard_table,
   ss::sharded<partition_manager>& partition_manager,
+  ss::sharded<health_monitor_frontend>& health_monitor,
   ss::sharded<ss::abort_source>& as,
   config::binding<bool>&& enabled,
   config::binding<std::chrono::milliseconds>&& idle_timeout,
   config::binding<std::chrono::milliseconds>&& mute_timeout,
   config::binding<std::chrono::milliseconds>&& node_mute_timeout,
   config::binding<size_t>&& transfer_limit_per_shard,
+  config::binding<bool>&& load_aware,
   consensus_ptr raft0)
   : _enabled(std::move(enabled))
   , _idle_timeout(std::move(idle_timeout))
   , _mute_timeout(std::move(mute_timeout))
   , _node_mute_timeout(std::move(node_mute_timeout))
   , _transfer_limit_per_shard(std::move(transfer_limit_per_shard))
+  , _load_aware(std::move(load_aware))
   , _topics(topics)
   , _leaders(leaders)
   , _members(members)
   , _client(std::move(client))
   , _shard_table(shard_table)
   , _partition_manager(partition_manager)
+  , _health_monitor(health_monitor)
   , _as(as)
   , _raft0(std::move(raft0))
   , _timer([this] { trigger_balance(); }) {
@@ -98,8 +103,8 @@ void leader_balancer::check_if_controller_leader(
     }
 }
 
-void leader_balancer::on_leadership_change(
-  model::ntp ntp, model::term_id, std::optional<model::node_id>) {
+void leader_balancer::on_leadership_changes(
+  const partition_leaders_table::leadership_changes_t& changes) {
     if (!_enabled()) {
         return;
     }
@@ -108,25 +113,27 @@ void leader_balancer::on_leadership_change(
         return;
     }
 
-    const auto assignment = _topics.get_partition_assignment(ntp);
+    bool completed = false;
+    for (const auto& change : changes) {
+        const auto assignment = _topics.get_partition_assignment(change.ntp);
 
-    if (!assignment.has_value()) {
+        if (!assignment.has_value()) {
+            continue;
+        }
+
+        // Update in flight state
+        completed |= _in_flight_changes.erase(assignment->group) > 0;
+    }
+    if (!completed) {
         return;
     }
 
-    const auto& group = assignment->group;
-
-    // Update in flight state
-    if (auto it = _in_flight_changes.find(group);
-        it != _in_flight_changes.end()) {
-        _in_flight_changes.erase(it);
-        check_unregister_leadership_change_notification();
+    check_unregister_leadership_change_notification();
 
-        if (_throttled) {
-            _throttled = false;
-            _timer.cancel();
-            _timer.arm(throttle_reactivation_delay);
-        }
+    if (_throttled) {
+        _throttled = false;
+        _timer.cancel();
+        _timer.arm(throttle_reactivation_delay);
     }
 }
 
@@ -151,14 +158,15 @@ void leader_balancer::on_maintenance_change(
 void leader_balancer::check_register_leadership_change_notification() {
     if (!_leadership_change_notify_handle && _in_flight_changes.size() > 0) {
         _leadership_change_notify_handle
-          = _leaders.register_leadership_change_notification(std::bind_front(
-            std::mem_fn(&leader_balancer::on_leadership_change), this));
+          = _leaders.register_leadership_changes_notification(
+            std::bind_front(
+              std::mem_fn(&leader_balancer::on_leadership_changes), this));
     }
 }
 
 void leader_balancer::check_unregister_leadership_change_notification() {
     if (_leadership_change_notify_handle && _in_flight_changes.size() == 0) {
-        _leaders.unregister_leadership_change_notification(
+        _leaders.unregister_leadership_changes_notification(
           *_leadership_change_notify_handle);
         _leadership_change_notify_handle.reset();
     }
@@ -362,8 +370,20 @@ ss::future<ss::stop_iteration> leader_balancer::balance() {
      * (e.g. on average little should change between ticks) and bounding the
      * search for leader moves.
      */
-    greedy_balanced_shards strategy(build_index(), muted_nodes());
-    auto cores = strategy.stats();
+    co_await refresh_loads();
+    if (_as.local().abort_requested()) {
+        co_return ss::stop_iteration::yes;
+    }
+
+    std::unique_ptr<leader_balancer_strategy> strategy;
+    if (_load_aware()) {
+        strategy = std::make_unique<load_balanced_shards>(
+          build_index(), muted_nodes(), group_loads());
+    } else {
+        strategy = std::make_unique<greedy_balanced_shards>(
+          build_index(), muted_nodes());
+    }
+    auto cores = strategy->stats();
 
     if (clusterlog.is_enabled(ss::log_level::trace)) {
         for (const auto& core : cores) {
@@ -420,8 +440,8 @@ ss::future<ss::stop_iteration> leader_balancer::balance() {
         co_return ss::stop_iteration::yes;
     }
 
-    auto error = strategy.error();
-    auto transfer = strategy.find_movement(muted_groups());
+    auto error = strategy->error();
+    auto transfer = strategy->find_movement(muted_groups());
     if (!transfer) {
         vlog(
           clusterlog.debug,
@@ -677,6 +697,66 @@ leader_balancer::index_type leader_balancer::build_index() {
     return index;
 }
 
+/*
+ * maps the groups to the traffic rates of their partitions from the last
+ * refreshed health report.
+ */
+load_balanced_shards::group_loads leader_balancer::group_loads() const {
+    load_balanced_shards::group_loads loads;
+    if (_ntp_loads.empty()) {
+        return loads;
+    }
+    for (const auto& topic : _topics.topics_map()) {
+        for (const auto& partition : topic.second.get_assignments()) {
+            auto it = _ntp_loads.find(
+              model::ntp(topic.first.ns, topic.first.tp, partition.id));
+            if (it != _ntp_loads.end() && it->second > 0) {
+                loads.emplace(partition.group, it->second);
+            }
+        }
+    }
+    return loads;
+}
+
+ss::future<> leader_balancer::refresh_loads() {
+    if (!_load_aware()) {
+        _ntp_loads.clear();
+        co_return;
+    }
+    if (clock_type::now() < _loads_refresh_deadline) {
+        co_return;
+    }
+
+    auto report = co_await _health_monitor.local().get_cluster_health(
+      cluster_report_filter{},
+      force_refresh::no,
+      model::timeout_clock::now() + leader_transfer_rpc_timeout);
+    if (!report) {
+        // keep balancing with the previous rates, or leader counts
+        vlog(
+          clusterlog.debug,
+          "Leadership balancer: unable to get partition loads - {}",
+          report.error().message());
+        co_return;
+    }
+
+    _ntp_loads.clear();
+    for (const auto& node_report : report.value().node_reports) {
+        for (const auto& topic : node_report.topics) {
+            for (const auto& p : topic.partitions) {
+                if (p.bytes_rate == 0) {
+                    continue;
+                }
+                // only the leader replica handles produce and fetch requests
+                auto& load = _ntp_loads[model::ntp(
+                  topic.tp_ns.ns, topic.tp_ns.tp, p.id)];
+                load = std::max(load, p.bytes_rate);
+            }
+        }
+    }
+    _loads_refresh_deadline = clock_type::now() + load_refresh_interval;
+}
+
 ss::future<bool> leader_balancer::do_transfer(reassignment transfer) {
     vlog(
       clusterlog.debug,
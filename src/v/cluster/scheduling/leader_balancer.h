@@ -11,6 +11,8 @@
 #pragma once
 #include "absl/container/flat_hash_map.h"
 #include "cluster/partition_manager.h"
+#include "cluster/fwd.h"
+#include "cluster/scheduling/leader_balancer_load.h"
 #include "cluster/scheduling/leader_balancer_probe.h"
 #include "cluster/scheduling/leader_balancer_strategy.h"
 #include "cluster/types.h"
@@ -69,6 +71,12 @@ class leader_balancer {
      */
     static constexpr clock_type::duration throttle_reactivation_delay = 5s;
 
+    /*
+     * partition load rates are averaged over tens of seconds, refreshing them
+     * more often than this only makes the balancer chase noise.
+     */
+    static constexpr clock_type::duration load_refresh_interval = 30s;
+
 public:
     leader_balancer(
       topic_table&,
@@ -77,12 +85,14 @@ public:
       raft::consensus_client_protocol,
       ss::sharded<shard_table>&,
       ss::sharded<partition_manager>&,
+      ss::sharded<health_monitor_frontend>&,
       ss::sharded<ss::abort_source>&,
       config::binding<bool>&&,
       config::binding<std::chrono::milliseconds>&&,
       config::binding<std::chrono::milliseconds>&&,
       config::binding<std::chrono::milliseconds>&&,
       config::binding<size_t>&&,
+      config::binding<bool>&&,
       consensus_ptr);
 
     ss::future<> start();
@@ -93,6 +103,8 @@ private:
     using reassignment = leader_balancer_strategy::reassignment;
 
     index_type build_index();
+    load_balanced_shards::group_loads group_loads() const;
+    ss::future<> refresh_loads();
     absl::flat_hash_set<raft::group_id> muted_groups() const;
     absl::flat_hash_set<model::node_id> muted_nodes() const;
 
@@ -105,8 +117,8 @@ private:
     void check_if_controller_leader(
       model::ntp, model::term_id, std::optional<model::node_id>);
 
-    void on_leadership_change(
-      model::ntp, model::term_id, std::optional<model::node_id>);
+    void on_leadership_changes(
+      const partition_leaders_table::leadership_changes_t&);
 
     void on_maintenance_change(model::node_id, model::maintenance_state);
 
@@ -162,6 +174,14 @@ private:
      */
     config::binding<size_t> _transfer_limit_per_shard;
 
+    /*
+     * weight leaders by the traffic of their partitions. the rates come from
+     * the cluster health report and are cached for load_refresh_interval.
+     */
+    config::binding<bool> _load_aware;
+    absl::flat_hash_map<model::ntp, uint64_t> _ntp_loads;
+    clock_type::time_point _loads_refresh_deadline;
+
     struct last_known_leader {
         model::broker_shard shard;
         clock_type::time_point expires;
@@ -182,6 +202,7 @@ private:
     raft::consensus_client_protocol _client;
     ss::sharded<shard_table>& _shard_table;
     ss::sharded<partition_manager>& _partition_manager;
+    ss::sharded<health_monitor_frontend>& _health_monitor;
     ss::sharded<ss::abort_source>& _as;
     consensus_ptr _raft0;
     ss::gate _gate;
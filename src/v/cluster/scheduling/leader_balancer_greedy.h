@@ -25,7 +25,7 @@
  */
 namespace cluster {
 
-class greedy_balanced_shards final : private leader_balancer_strategy {
+class greedy_balanced_shards final : public leader_balancer_strategy {
     /*
      * avoid rounding errors when determining if a move improves balance by
      * adding a small amount of jitter. effectively a move needs to improve by
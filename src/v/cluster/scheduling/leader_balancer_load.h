@@ -0,0 +1,238 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#pragma once
+
+#include "cluster/scheduling/leader_balancer_strategy.h"
+#include "model/metadata.h"
+
+#include <absl/container/flat_hash_map.h>
+#include <boost/range/adaptor/reversed.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+/*
+ * Load weighted shard balancer strategy. Like the greedy strategy it moves
+ * leaders from the most loaded core to the least loaded core, but the load of
+ * a core is the sum of the costs of the leaders it hosts rather than their
+ * number.
+ *
+ * Every leader has a fixed cost of one (heartbeats, replication fan-out) plus
+ * the produce and fetch byte rate of its partition relative to the average
+ * rate of all the balanced partitions. Without any traffic all leaders cost
+ * the same and the strategy makes the same moves as the greedy one.
+ */
+namespace cluster {
+
+class load_balanced_shards final : public leader_balancer_strategy {
+    /*
+     * avoid rounding errors when determining if a move improves balance.
+     */
+    static constexpr double error_jitter = 0.000001;
+
+public:
+    /*
+     * produce and fetch byte rate of groups, groups missing from the map
+     * have no traffic.
+     */
+    using group_loads = absl::flat_hash_map<raft::group_id, uint64_t>;
+
+    /*
+     * With traffic, a move is only made when the source core stays more
+     * loaded than the target core by this fraction of the target load after
+     * the move. Load rates are noisy and without some margin two cores with
+     * similar loads would keep exchanging leaders.
+     */
+    static constexpr double default_hysteresis = 0.1;
+
+    load_balanced_shards(
+      index_type cores,
+      absl::flat_hash_set<model::node_id> muted_nodes,
+      const group_loads& loads,
+      double hysteresis = default_hysteresis)
+      : _cores(std::move(cores))
+      , _muted_nodes(std::move(muted_nodes))
+      , _hysteresis(hysteresis) {
+        init_costs(loads);
+        rebuild_load_index();
+    }
+
+    double calc_target_load() const {
+        if (_num_cores == 0) {
+            return 0;
+        }
+        return _total_cost / static_cast<double>(_num_cores);
+    }
+
+    double error() const final {
+        const auto target_load = calc_target_load();
+        return std::accumulate(
+          _load_map.cbegin(),
+          _load_map.cend(),
+          double{0},
+          [target_load](auto acc, const auto& e) {
+              return acc + pow(e.second - target_load, 2);
+          });
+    }
+
+    /*
+     * Find a group reassignment that improves overall error by more than the
+     * hysteresis margin. Cores are visited from the most loaded one and for
+     * each the move of one of its groups with the largest error reduction is
+     * considered.
+     *
+     * Moving a group of cost c from a core with load f to a core with load t
+     * changes the error by 2c(t + c - f), so the best move for a group is to
+     * the least loaded of its replicas and across groups it is the one
+     * maximizing c(f - t - c).
+     */
+    std::optional<reassignment>
+    find_movement(const absl::flat_hash_set<raft::group_id>& skip) const final {
+        const auto margin = _has_load ? _hysteresis * calc_target_load()
+                                      : 0.0;
+
+        for (const auto& from : boost::adaptors::reverse(_load)) {
+            if (_muted_nodes.contains(from->first.node_id)) {
+                continue;
+            }
+            const auto from_load = _load_map.at(from->first);
+
+            double best_gain = 0;
+            std::optional<reassignment> best;
+            for (const auto& group : from->second) {
+                if (skip.contains(group.first)) {
+                    continue;
+                }
+                const auto cost = group_cost(group.first);
+                for (const auto& to_shard : group.second) {
+                    if (
+                      to_shard == from->first
+                      || _muted_nodes.contains(to_shard.node_id)) {
+                        continue;
+                    }
+                    const auto to_load = _load_map.at(to_shard);
+                    const auto spread = from_load - to_load - cost;
+                    if (spread <= margin + error_jitter) {
+                        continue;
+                    }
+                    if (auto gain = cost * spread; gain > best_gain) {
+                        best_gain = gain;
+                        best = reassignment{group.first, from->first, to_shard};
+                    }
+                }
+            }
+
+            if (best) {
+                return best;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    std::vector<shard_load> stats() const final {
+        std::vector<shard_load> ret;
+        ret.reserve(_load.size());
+        std::transform(
+          _load.cbegin(),
+          _load.cend(),
+          std::back_inserter(ret),
+          [](const auto& e) {
+              return shard_load{
+                e->first, static_cast<size_t>(e->second.size())};
+          });
+        return ret;
+    }
+
+    /*
+     * Total cost of the leaders of the core.
+     */
+    double shard_cost(const model::broker_shard& shard) const {
+        return _load_map.at(shard);
+    }
+
+private:
+    double group_cost(raft::group_id group) const {
+        if (auto it = _costs.find(group); it != _costs.end()) {
+            return it->second;
+        }
+        return 1;
+    }
+
+    void init_costs(const group_loads& loads) {
+        // only groups with leaders on non-muted nodes are balanced
+        uint64_t total_rate = 0;
+        size_t num_groups = 0;
+        for (const auto& [shard, groups] : _cores) {
+            if (_muted_nodes.contains(shard.node_id)) {
+                continue;
+            }
+            ++_num_cores;
+            for (const auto& group : groups) {
+                ++num_groups;
+                if (auto it = loads.find(group.first); it != loads.end()) {
+                    total_rate += it->second;
+                }
+            }
+        }
+
+        _has_load = total_rate > 0;
+        if (_has_load) {
+            const auto mean_rate = static_cast<double>(total_rate)
+                                   / static_cast<double>(num_groups);
+            for (const auto& [group, rate] : loads) {
+                _costs.emplace(
+                  group, 1 + static_cast<double>(rate) / mean_rate);
+            }
+        }
+
+        _total_cost = 0;
+        for (const auto& [shard, groups] : _cores) {
+            double cost = 0;
+            for (const auto& group : groups) {
+                cost += group_cost(group.first);
+            }
+            _load_map.emplace(shard, cost);
+            if (!_muted_nodes.contains(shard.node_id)) {
+                _total_cost += cost;
+            }
+        }
+    }
+
+    /*
+     * build the load index, which is a vector of iterators to each element in
+     * the core index sorted by the total cost of the leaders on the core.
+     */
+    void rebuild_load_index() {
+        _load.clear();
+        _load.reserve(_cores.size());
+        for (auto it = _cores.cbegin(); it != _cores.cend(); ++it) {
+            _load.push_back(it);
+        }
+        std::sort(
+          _load.begin(), _load.end(), [this](const auto& a, const auto& b) {
+              return _load_map.at(a->first) < _load_map.at(b->first);
+          });
+    }
+
+    index_type _cores;
+    absl::flat_hash_set<model::node_id> _muted_nodes;
+    double _hysteresis;
+    bool _has_load{false};
+    size_t _num_cores{0};
+    double _total_cost{0};
+    absl::flat_hash_map<raft::group_id, double> _costs;
+    std::vector<index_type::const_iterator> _load;
+    absl::flat_hash_map<model::broker_shard, double> _load_map;
+};
+
+} // namespace cluster
@@ -33,6 +33,16 @@ class hard_constraint_evaluator final {
 public:
     struct impl {
         virtual bool evaluate(const allocation_node&) const = 0;
+        /**
+         * Removes the nodes that do not satisfy the constraint. All the
+         * candidate nodes are evaluated in a single call so that an
+         * implementation can do its setup once rather than once per node.
+         */
+        virtual void filter(std::vector<const allocation_node*>& nodes) const {
+            std::erase_if(nodes, [this](const allocation_node* n) {
+                return !evaluate(*n);
+            });
+        }
         virtual void print(std::ostream&) const = 0;
         virtual ~impl() = default;
     };
@@ -54,6 +64,10 @@ public:
         return _impl->evaluate(node);
     }
 
+    void filter(std::vector<const allocation_node*>& nodes) const {
+        _impl->filter(nodes);
+    }
+
 private:
     friend std::ostream&
     operator<<(std::ostream& o, const hard_constraint_evaluator& e) {
@@ -69,6 +83,17 @@ public:
     static constexpr uint64_t max_score = 10'000'000;
     struct impl {
         virtual uint64_t score(const allocation_node&) const = 0;
+        /**
+         * Scores all the candidate nodes at once, `scores` has the size of
+         * `nodes`.
+         */
+        virtual void score_all(
+          const std::vector<const allocation_node*>& nodes,
+          std::vector<uint64_t>& scores) const {
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                scores[i] = score(*nodes[i]);
+            }
+        }
         virtual void print(std::ostream&) const = 0;
         virtual ~impl() = default;
     };
@@ -96,6 +121,26 @@ public:
         return ret;
     };
 
+    /**
+     * Adds the score of every node to `totals`, `scratch` is a buffer reused
+     * across calls.
+     */
+    void add_scores(
+      const std::vector<const allocation_node*>& nodes,
+      std::vector<uint64_t>& scratch,
+      std::vector<uint64_t>& totals) const {
+        scratch.resize(nodes.size());
+        _impl->score_all(nodes, scratch);
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            vassert(
+              scratch[i] <= max_score,
+              "Score returned from soft constraint evaluator must be in range "
+              "of [0, 10'000'000]. Returned score: {}",
+              scratch[i]);
+            totals[i] += scratch[i];
+        }
+    }
+
 private:
     friend std::ostream&
     operator<<(std::ostream& o, const soft_constraint_evaluator& e) {
@@ -11,8 +11,10 @@
 #include "cluster/security_manager.h"
 
 #include "cluster/commands.h"
+#include "cluster/controller_snapshot.h"
 #include "model/metadata.h"
 #include "raft/types.h"
+#include "serde/serde.h"
 
 #include <seastar/core/coroutine.hh>
 
@@ -51,6 +53,33 @@ security_manager::apply_update(model::record_batch batch) {
     });
 }
 
+ss::future<iobuf> security_manager::take_snapshot(model::offset) {
+    controller_snapshot_parts::security snap;
+    for (const auto& [name, credential] : _credentials.local()) {
+        snap.users.push_back(controller_snapshot_parts::security::user{
+          .name = name,
+          .credential = std::get<security::scram_credential>(credential),
+        });
+    }
+    snap.acls = _authorizer.local().acls(security::acl_binding_filter::any());
+    co_return serde::to_iobuf(std::move(snap));
+}
+
+ss::future<> security_manager::apply_snapshot(model::offset, iobuf buf) {
+    auto snap = serde::from_iobuf<controller_snapshot_parts::security>(
+      std::move(buf));
+    co_await _credentials.invoke_on_all(
+      [&snap](security::credential_store& store) {
+          for (const auto& u : snap.users) {
+              store.put(u.name, u.credential);
+          }
+      });
+    co_await _authorizer.invoke_on_all(
+      [&snap](security::authorizer& authorizer) {
+          authorizer.add_bindings(snap.acls);
+      });
+}
+
 /*
  * handle: delete acls command
  */
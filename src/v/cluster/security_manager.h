@@ -10,6 +10,7 @@
  */
 
 #pragma once
+#include "bytes/iobuf.h"
 #include "cluster/commands.h"
 #include "model/record.h"
 #include "security/authorizer.h"
@@ -25,6 +26,9 @@ public:
       ss::sharded<security::credential_store>&,
       ss::sharded<security::authorizer>&);
 
+    // users and acls are not referenced by other controller states
+    static constexpr bool independent_apply = true;
+
     static constexpr auto commands = make_commands_list<
       create_user_cmd,
       delete_user_cmd,
@@ -34,6 +38,9 @@ public:
 
     ss::future<std::error_code> apply_update(model::record_batch);
 
+    ss::future<iobuf> take_snapshot(model::offset);
+    ss::future<> apply_snapshot(model::offset, iobuf);
+
     bool is_batch_applicable(const model::record_batch& batch) const {
         return batch.header().type
                  == model::record_batch_type::user_management_cmd
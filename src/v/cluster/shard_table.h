@@ -12,12 +12,17 @@
 #pragma once
 
 #include "model/fundamental.h"
+#include "model/metadata.h"
 #include "raft/types.h"
+#include "vassert.h"
 #include "seastarx.h"
 
 #include <seastar/core/reactor.hh> // shard_id
 
-#include <absl/container/node_hash_map.h>
+#include <absl/container/flat_hash_map.h>
+
+#include <optional>
+#include <vector>
 
 namespace cluster {
 /// \brief this is populated by consensus::controller
@@ -30,6 +35,14 @@ class shard_table final {
         bool non_replicable;
     };
 
+    /**
+     * Entries of the partitions of a topic indexed by partition id. Partition
+     * ids are dense so a lookup on the produce and fetch path is one topic
+     * hash and an array index, and the topic name is stored once per topic
+     * rather than in the key of every partition.
+     */
+    using partitions_t = std::vector<std::optional<shard_revision>>;
+
 public:
     bool contains(const raft::group_id& group) {
         return _group_idx.find(group) != _group_idx.end();
@@ -39,8 +52,8 @@ public:
     }
 
     std::optional<model::revision_id> revision_for(const model::ntp& ntp) {
-        if (auto it = _ntp_idx.find(ntp); it != _ntp_idx.end()) {
-            return it->second.revision;
+        if (auto e = find(ntp); e) {
+            return e->revision;
         }
         return std::nullopt;
     }
@@ -49,24 +62,24 @@ public:
      * \brief Lookup the owning shard for an ntp.
      */
     std::optional<ss::shard_id> shard_for(const model::ntp& ntp) {
-        if (auto it = _ntp_idx.find(ntp); it != _ntp_idx.end()) {
-            return it->second.shard;
+        if (auto e = find(ntp); e) {
+            return e->shard;
         }
         return std::nullopt;
     }
 
     bool update_shard(
       const model::ntp& ntp, ss::shard_id i, model::revision_id rev) {
-        if (auto it = _ntp_idx.find(ntp); it != _ntp_idx.end()) {
-            if (it->second.revision > rev) {
+        if (auto e = find(ntp); e) {
+            if (e->revision > rev) {
                 return false;
             }
             vassert(
-              it->second.non_replicable,
+              e->non_replicable,
               "Attempting to update replicable entry from non_replicable "
               "interface");
         }
-        _ntp_idx.insert_or_assign(ntp, shard_revision{i, rev, true});
+        entry_for(ntp) = shard_revision{i, rev, true};
         return true;
     }
 
@@ -75,12 +88,12 @@ public:
       raft::group_id g,
       ss::shard_id shard,
       model::revision_id rev) {
-        if (auto it = _ntp_idx.find(ntp); it != _ntp_idx.end()) {
-            if (it->second.revision > rev) {
+        if (auto e = find(ntp); e) {
+            if (e->revision > rev) {
                 return;
             }
             vassert(
-              !it->second.non_replicable,
+              !e->non_replicable,
               "Attempting to update non_replicable entry from replicable "
               "interface");
         }
@@ -94,18 +107,18 @@ public:
               "interface");
         }
 
-        _ntp_idx.insert_or_assign(ntp, shard_revision{shard, rev, false});
+        entry_for(ntp) = shard_revision{shard, rev, false};
         _group_idx.insert_or_assign(g, shard_revision{shard, rev, false});
     }
 
     void
     erase(const model::ntp& ntp, raft::group_id g, model::revision_id rev) {
-        if (auto it = _ntp_idx.find(ntp); it != _ntp_idx.end()) {
-            if (it->second.revision > rev) {
+        if (auto e = find(ntp); e) {
+            if (e->revision > rev) {
                 return;
             }
             vassert(
-              !it->second.non_replicable,
+              !e->non_replicable,
               "erasing non_replicable entry from replicable erase interface");
         }
         if (auto it = _group_idx.find(g); it != _group_idx.end()) {
@@ -117,23 +130,70 @@ public:
               "erasing non_replicable entry from replicable erase interface");
         }
 
-        _ntp_idx.erase(ntp);
+        erase_entry(ntp);
         _group_idx.erase(g);
     }
 
     void erase(const model::ntp& ntp, model::revision_id rev) {
-        if (auto it = _ntp_idx.find(ntp); it != _ntp_idx.end()) {
-            if (it->second.revision > rev) {
+        if (auto e = find(ntp); e) {
+            if (e->revision > rev) {
                 return;
             }
             vassert(
-              it->second.non_replicable,
+              e->non_replicable,
               "erassing replicable entry from non_replicable erase interface");
-            _ntp_idx.erase(it);
+            erase_entry(ntp);
         }
     }
 
 private:
+    const shard_revision* find(const model::ntp& ntp) const {
+        auto it = _ntp_idx.find(model::topic_namespace_view(ntp));
+        if (it == _ntp_idx.end()) {
+            return nullptr;
+        }
+        const auto p = static_cast<size_t>(ntp.tp.partition());
+        if (p >= it->second.size() || !it->second[p]) {
+            return nullptr;
+        }
+        return &*it->second[p];
+    }
+
+    std::optional<shard_revision>& entry_for(const model::ntp& ntp) {
+        auto it = _ntp_idx.find(model::topic_namespace_view(ntp));
+        if (it == _ntp_idx.end()) {
+            it = _ntp_idx
+                   .emplace(
+                     model::topic_namespace(ntp.ns, ntp.tp.topic),
+                     partitions_t{})
+                   .first;
+        }
+        const auto p = static_cast<size_t>(ntp.tp.partition());
+        if (p >= it->second.size()) {
+            it->second.resize(p + 1);
+        }
+        return it->second[p];
+    }
+
+    void erase_entry(const model::ntp& ntp) {
+        auto it = _ntp_idx.find(model::topic_namespace_view(ntp));
+        if (it == _ntp_idx.end()) {
+            return;
+        }
+        auto& partitions = it->second;
+        const auto p = static_cast<size_t>(ntp.tp.partition());
+        if (p < partitions.size()) {
+            partitions[p].reset();
+        }
+        // trim the trailing empty entries, drop the topic once it is empty
+        while (!partitions.empty() && !partitions.back()) {
+            partitions.pop_back();
+        }
+        if (partitions.empty()) {
+            _ntp_idx.erase(it);
+        }
+    }
+
     /**
      * Controller backend executes per NTP reconciliation loop on every core of
      * every node in the cluster. Depending on requested replica set update and
@@ -150,8 +210,13 @@ private:
      */
 
     // kafka index
-    absl::node_hash_map<model::ntp, shard_revision> _ntp_idx;
+    absl::flat_hash_map<
+      model::topic_namespace,
+      partitions_t,
+      model::topic_namespace_hash,
+      model::topic_namespace_eq>
+      _ntp_idx;
     // raft index
-    absl::node_hash_map<raft::group_id, shard_revision> _group_idx;
+    absl::flat_hash_map<raft::group_id, shard_revision> _group_idx;
 };
 } // namespace cluster
@@ -15,6 +15,8 @@
 #include <seastar/core/sharded.hh>
 #include <seastar/testing/perf_tests.hh>
 
+#include <fmt/format.h>
+
 #include <vector>
 
 PERF_TEST_F(partition_allocator_fixture, allocation_3) {
@@ -65,3 +67,39 @@ PERF_TEST_F(partition_allocator_fixture, recovery) {
       replicas, raft::group_id(replicas.size() / 3));
     perf_tests::stop_measuring_time();
 }
+
+namespace {
+constexpr int large_cluster_nodes = 128;
+constexpr int large_cluster_cores = 16;
+constexpr int large_cluster_racks = 8;
+constexpr int large_topic_partitions = 10'000;
+} // namespace
+
+// a large topic created on a large cluster, all nodes are evaluated against
+// every constraint for every replica
+PERF_TEST_F(partition_allocator_fixture, large_cluster_allocation) {
+    for (int i = 0; i < large_cluster_nodes; ++i) {
+        register_node(i, large_cluster_cores);
+    }
+    auto req = make_allocation_request(large_topic_partitions, 3);
+
+    perf_tests::start_measuring_time();
+    auto vals = allocator.allocate(std::move(req));
+    perf_tests::do_not_optimize(vals);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST_F(partition_allocator_fixture, large_cluster_allocation_racks) {
+    for (int i = 0; i < large_cluster_nodes; ++i) {
+        register_node(
+          i,
+          large_cluster_cores,
+          model::rack_id(fmt::format("rack-{}", i % large_cluster_racks)));
+    }
+    auto req = make_allocation_request(large_topic_partitions, 3);
+
+    perf_tests::start_measuring_time();
+    auto vals = allocator.allocate(std::move(req));
+    perf_tests::do_not_optimize(vals);
+    perf_tests::stop_measuring_time();
+}
@@ -3,6 +3,7 @@
 #include "cluster/types.h"
 #include "model/fundamental.h"
 #include "model/metadata.h"
+#include "model/namespace.h"
 #include "raft/types.h"
 
 #include <seastar/testing/thread_test_case.hh>
@@ -207,3 +208,51 @@ SEASTAR_THREAD_TEST_CASE(move_back_to_current_node_not_finished) {
     BOOST_REQUIRE_EQUAL(deltas.size(), 1);
     BOOST_REQUIRE_EQUAL(deltas[0].offset, update_with_current_2.offset);
 }
+
+SEASTAR_THREAD_TEST_CASE(eager_bootstrap_of_preferred_leaders) {
+    const model::ntp kafka_ntp(
+      model::kafka_namespace,
+      model::topic_partition(model::topic("test"), model::partition_id(1)));
+    auto make_kafka_delta = [&kafka_ntp](
+                              std::vector<model::broker_shard> replicas,
+                              op_t type) {
+        return delta_t(
+          kafka_ntp,
+          make_assignment(std::move(replicas)),
+          model::offset(1),
+          type);
+    };
+
+    // preferred leader
+    BOOST_REQUIRE(cluster::is_eager_bootstrap(
+      current_node,
+      kafka_ntp,
+      {make_kafka_delta({make_bs(0, 0), make_bs(1, 0)}, op_t::add)}));
+    // follower
+    BOOST_REQUIRE(!cluster::is_eager_bootstrap(
+      current_node,
+      kafka_ntp,
+      {make_kafka_delta({make_bs(1, 0), make_bs(0, 0)}, op_t::add)}));
+    // deletion of a follower replica
+    BOOST_REQUIRE(cluster::is_eager_bootstrap(
+      current_node,
+      kafka_ntp,
+      {make_kafka_delta({make_bs(1, 0), make_bs(0, 0)}, op_t::del)}));
+    // followers of non kafka topics
+    BOOST_REQUIRE(cluster::is_eager_bootstrap(
+      current_node,
+      test_ntp,
+      {make_delta({make_bs(1, 0), make_bs(0, 0)}, 1, op_t::add)}));
+    const model::ntp offsets_ntp(
+      model::kafka_namespace,
+      model::topic_partition(
+        model::kafka_consumer_offsets_topic, model::partition_id(0)));
+    BOOST_REQUIRE(cluster::is_eager_bootstrap(
+      current_node,
+      offsets_ntp,
+      {delta_t(
+        offsets_ntp,
+        make_assignment({make_bs(1, 0), make_bs(0, 0)}),
+        model::offset(1),
+        op_t::add)}));
+}
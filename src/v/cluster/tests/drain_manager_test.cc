@@ -0,0 +1,66 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE drain_manager
+
+#include "cluster/drain_manager.h"
+#include "model/metadata.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+
+static raft::follower_metrics
+make_follower(int id, bool under_replicated = false) {
+    return raft::follower_metrics{
+      .id = model::node_id(id),
+      .is_learner = false,
+      .is_live = true,
+      .under_replicated = under_replicated,
+    };
+}
+
+BOOST_AUTO_TEST_CASE(drain_target_spreads_leadership) {
+    cluster::drain_manager::leader_counts leaders{
+      {model::node_id(1), 10}, {model::node_id(2), 12}};
+    std::vector<raft::follower_metrics> followers{
+      make_follower(1), make_follower(2), make_follower(3)};
+
+    // node 3 leads nothing yet, it is chosen until it catches up with the
+    // others
+    std::map<model::node_id, int> chosen;
+    for (int i = 0; i < 16; ++i) {
+        auto target = cluster::drain_manager::choose_transfer_target(
+          followers, leaders);
+        BOOST_REQUIRE(target.has_value());
+        ++chosen[*target];
+    }
+    BOOST_REQUIRE_EQUAL(chosen[model::node_id(3)], 12);
+    BOOST_REQUIRE_EQUAL(chosen[model::node_id(1)], 3);
+    BOOST_REQUIRE_EQUAL(chosen[model::node_id(2)], 1);
+}
+
+BOOST_AUTO_TEST_CASE(drain_target_prefers_caught_up_voters) {
+    cluster::drain_manager::leader_counts leaders{{model::node_id(1), 100}};
+    auto learner = make_follower(3);
+    learner.is_learner = true;
+    auto dead = make_follower(4);
+    dead.is_live = false;
+    std::vector<raft::follower_metrics> followers{
+      make_follower(1), make_follower(2, true), learner, dead};
+
+    auto target = cluster::drain_manager::choose_transfer_target(
+      followers, leaders);
+    BOOST_REQUIRE(target == model::node_id(1));
+
+    followers = {learner, dead};
+    BOOST_REQUIRE(!cluster::drain_manager::choose_transfer_target(
+                     followers, leaders)
+                     .has_value());
+}
@@ -9,7 +9,9 @@
  * by the Apache License, Version 2.0
  */
 
+#include "cluster/controller_snapshot.h"
 #include "cluster/feature_table.h"
+#include "serde/serde.h"
 #include "test_utils/fixture.h"
 #include "vlog.h"
 
@@ -224,3 +226,30 @@ FIXTURE_TEST(feature_table_preparing, feature_table_fixture) {
     BOOST_REQUIRE(f_active.available());
     f_active.get();
 }
+
+/**
+ * Feature states restored from a controller snapshot match the states
+ * of the table the snapshot was taken from
+ */
+FIXTURE_TEST(feature_table_snapshot, feature_table_fixture) {
+    set_active_version(cluster_version{2001});
+    execute_action(mock_feature, action_t::activate);
+    execute_action("consumer_offsets", action_t::activate);
+    BOOST_REQUIRE(ft.is_active(feature::test_alpha));
+    BOOST_REQUIRE(ft.is_preparing(feature::consumer_offsets));
+
+    auto snap = serde::from_iobuf<controller_snapshot_parts::features>(
+      serde::to_iobuf(ft.fill_snapshot()));
+
+    feature_table restored;
+    auto f_active = restored.await_feature(feature::test_alpha, as);
+    restored.apply_snapshot(snap);
+    BOOST_REQUIRE_EQUAL(restored.get_active_version(), cluster_version{2001});
+    BOOST_REQUIRE(restored.is_active(feature::test_alpha));
+    BOOST_REQUIRE(restored.is_preparing(feature::consumer_offsets));
+    BOOST_REQUIRE(!restored.get_license().has_value());
+
+    ss::sleep(10ms).get();
+    BOOST_REQUIRE(f_active.available());
+    f_active.get();
+}
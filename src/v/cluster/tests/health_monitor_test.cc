@@ -26,6 +26,7 @@
 #include "test_utils/fixture.h"
 
 #include <seastar/core/sstring.hh>
+#include <seastar/testing/thread_test_case.hh>
 
 #include <boost/test/tools/interface.hpp>
 #include <boost/test/tools/old/interface.hpp>
@@ -354,3 +355,135 @@ FIXTURE_TEST(test_alive_status, cluster_test_fixture) {
           });
     }).get();
 }
+
+namespace {
+cluster::partition_status
+make_partition_status(int32_t id, int64_t term, size_t size) {
+    return cluster::partition_status{
+      .id = model::partition_id(id),
+      .term = model::term_id(term),
+      .leader_id = model::node_id(0),
+      .revision_id = model::revision_id(1),
+      .size_bytes = size,
+    };
+}
+
+cluster::topic_status make_topic_status(
+  ss::sstring topic, std::vector<cluster::partition_status> partitions) {
+    return cluster::topic_status{
+      .tp_ns = model::topic_namespace(
+        model::kafka_namespace, model::topic(std::move(topic))),
+      .partitions = std::move(partitions),
+    };
+}
+
+// order of topics and partitions is not significant
+std::vector<cluster::topic_status>
+normalized(std::vector<cluster::topic_status> topics) {
+    for (auto& t : topics) {
+        std::sort(
+          t.partitions.begin(), t.partitions.end(), [](auto& a, auto& b) {
+              return a.id < b.id;
+          });
+    }
+    std::sort(topics.begin(), topics.end(), [](auto& a, auto& b) {
+        return a.tp_ns.tp < b.tp_ns.tp;
+    });
+    return topics;
+}
+} // namespace
+
+SEASTAR_THREAD_TEST_CASE(test_incremental_node_report) {
+    cluster::reported_partitions_t reported;
+
+    cluster::node_health_report first;
+    first.id = model::node_id(1);
+    first.report_version = 1;
+    first.topics = {
+      make_topic_status(
+        "tp-1",
+        {make_partition_status(0, 1, 100), make_partition_status(1, 1, 100)}),
+      make_topic_status("tp-2", {make_partition_status(0, 1, 100)}),
+    };
+    // the first report has nothing to be compared with
+    auto first_delta = first;
+    cluster::make_node_health_report_delta(first_delta, reported, 0);
+    BOOST_REQUIRE(first_delta.is_delta());
+    BOOST_REQUIRE(first_delta.topics == first.topics);
+    BOOST_REQUIRE(first_delta.removed_partitions.empty());
+    BOOST_REQUIRE_EQUAL(reported.size(), 3);
+
+    // tp-1/1 grows, tp-2 is deleted and tp-3 is created
+    cluster::node_health_report second;
+    second.id = model::node_id(1);
+    second.report_version = 2;
+    second.topics = {
+      make_topic_status(
+        "tp-1",
+        {make_partition_status(0, 1, 100), make_partition_status(1, 1, 200)}),
+      make_topic_status("tp-3", {make_partition_status(0, 1, 0)}),
+    };
+    auto delta = second;
+    cluster::make_node_health_report_delta(delta, reported, 1);
+    BOOST_REQUIRE(delta.is_delta());
+    BOOST_REQUIRE_EQUAL(*delta.delta_base_version, 1);
+    BOOST_REQUIRE(
+      delta.topics
+      == std::vector<cluster::topic_status>(
+        {make_topic_status("tp-1", {make_partition_status(1, 1, 200)}),
+         make_topic_status("tp-3", {make_partition_status(0, 1, 0)})}));
+    BOOST_REQUIRE(
+      delta.removed_partitions
+      == std::vector<model::ntp>(
+        {ntp(model::kafka_namespace, "tp-2", 0)}));
+    BOOST_REQUIRE_EQUAL(reported.size(), 3);
+
+    // the merged report is the full report of the new version
+    auto merged = cluster::apply_node_health_report_delta(first, delta);
+    BOOST_REQUIRE(!merged.is_delta());
+    BOOST_REQUIRE(merged.removed_partitions.empty());
+    BOOST_REQUIRE_EQUAL(merged.report_version, 2);
+    BOOST_REQUIRE(normalized(merged.topics) == normalized(second.topics));
+
+    // nothing changed
+    auto empty_delta = second;
+    empty_delta.report_version = 3;
+    cluster::make_node_health_report_delta(empty_delta, reported, 2);
+    BOOST_REQUIRE(empty_delta.topics.empty());
+    BOOST_REQUIRE(empty_delta.removed_partitions.empty());
+    merged = cluster::apply_node_health_report_delta(merged, empty_delta);
+    BOOST_REQUIRE_EQUAL(merged.report_version, 3);
+    BOOST_REQUIRE(normalized(merged.topics) == normalized(second.topics));
+}
+
+FIXTURE_TEST(test_versioned_node_report, cluster_test_fixture) {
+    auto n1 = create_node_application(model::node_id{0});
+    wait_for_controller_leadership(n1->controller->self()).get();
+
+    auto& hm = n1->controller->get_health_monitor().local();
+    cluster::node_report_filter all{};
+
+    // base version 0 is never reported, it results in a full report
+    auto full = hm.collect_node_health(all, 0).get();
+    BOOST_REQUIRE(full.has_value());
+    BOOST_REQUIRE(!full.value().is_delta());
+    BOOST_REQUIRE_GT(full.value().report_version, 0);
+    BOOST_REQUIRE(!full.value().topics.empty());
+
+    // a delta based on the last reported version
+    auto delta
+      = hm.collect_node_health(all, full.value().report_version).get();
+    BOOST_REQUIRE(delta.has_value());
+    BOOST_REQUIRE(delta.value().is_delta());
+    BOOST_REQUIRE_EQUAL(
+      *delta.value().delta_base_version, full.value().report_version);
+    BOOST_REQUIRE_GT(
+      delta.value().report_version, full.value().report_version);
+
+    // a stale base version results in a full report
+    auto resync
+      = hm.collect_node_health(all, full.value().report_version).get();
+    BOOST_REQUIRE(resync.has_value());
+    BOOST_REQUIRE(!resync.value().is_delta());
+    BOOST_REQUIRE(!resync.value().topics.empty());
+}
@@ -98,3 +98,42 @@ FIXTURE_TEST(stm_restart_test, mux_state_machine_fixture) {
     }
     stm2.stop().get0();
 }
+
+FIXTURE_TEST(stm_range_test, mux_state_machine_fixture) {
+    start_raft();
+
+    config::configuration cfg;
+    cfg.id_allocator_batch_size.set_value(int16_t(10));
+    cfg.id_allocator_log_capacity.set_value(int16_t(2));
+
+    cluster::id_allocator_stm stm(idstmlog, _raft.get(), cfg);
+
+    stm.start().get0();
+    auto stop = ss::defer([&stm] { stm.stop().get0(); });
+
+    wait_for_confirmed_leader();
+
+    // a range is cut short by the end of the current batch
+    auto r = stm.allocate_id_range(4, 1s).get0();
+    BOOST_REQUIRE_EQUAL(raft::errc::success, r.raft_status);
+    BOOST_REQUIRE_EQUAL(r.count, 4);
+    int64_t next_id = r.id + r.count;
+
+    r = stm.allocate_id_range(8, 1s).get0();
+    BOOST_REQUIRE_EQUAL(raft::errc::success, r.raft_status);
+    BOOST_REQUIRE_EQUAL(r.id, next_id);
+    BOOST_REQUIRE_EQUAL(r.count, 6);
+    next_id = r.id + r.count;
+
+    // a range larger than a batch gets a batch of its own
+    r = stm.allocate_id_range(25, 1s).get0();
+    BOOST_REQUIRE_EQUAL(raft::errc::success, r.raft_status);
+    BOOST_REQUIRE_LE(next_id, r.id);
+    BOOST_REQUIRE_EQUAL(r.count, 25);
+    next_id = r.id + r.count;
+
+    auto single = stm.allocate_id(1s).get0();
+    BOOST_REQUIRE_EQUAL(raft::errc::success, single.raft_status);
+    BOOST_REQUIRE_LE(next_id, single.id);
+    BOOST_REQUIRE_EQUAL(single.count, 1);
+}
@@ -9,7 +9,9 @@
  * by the Apache License, Version 2.0
  */
 #include "cluster/scheduling/leader_balancer_greedy.h"
+#include "cluster/scheduling/leader_balancer_load.h"
 #include "leader_balancer_test_utils.h"
+#include "units.h"
 
 #include <seastar/testing/perf_tests.hh>
 
@@ -45,8 +47,53 @@ void balancer_bench(bool measure_all) {
     perf_tests::stop_measuring_time();
 }
 
+/*
+ * Leader counts are balanced but a few cores lead the hottest partitions, byte
+ * rates follow a zipf like distribution. Measures finding a single movement,
+ * or the whole balancing until no movement improves the balance.
+ */
+void skewed_load_bench(bool until_balanced) {
+    constexpr int node_count = 24;
+    constexpr int shards_per_node = 16;
+    constexpr int groups_per_shard = 40;
+    constexpr int replicas = 3;
+    constexpr int hot_shards = 4;
+    constexpr size_t max_moves = 10000;
+
+    auto [index, loads] = leader_balancer_test_utils::make_skewed_cluster_index(
+      node_count,
+      shards_per_node,
+      groups_per_shard,
+      replicas,
+      hot_shards,
+      50_MiB);
+
+    perf_tests::start_measuring_time();
+    size_t moves = 0;
+    for (; moves < max_moves; ++moves) {
+        auto balancer = cluster::load_balanced_shards(index, {}, loads);
+        auto movement = balancer.find_movement({});
+        if (!movement) {
+            break;
+        }
+        perf_tests::do_not_optimize(movement);
+        if (!until_balanced) {
+            break;
+        }
+        leader_balancer_test_utils::apply_reassignment(index, *movement);
+    }
+    perf_tests::stop_measuring_time();
+    vassert(moves < max_moves, "balancing did not converge");
+}
+
 } // namespace
 
 PERF_TEST(leader_balancing, bench_movement) { balancer_bench(false); }
 
 PERF_TEST(leader_balancing, bench_all) { balancer_bench(true); }
+
+PERF_TEST(leader_balancing, bench_skewed_movement) { skewed_load_bench(false); }
+
+PERF_TEST(leader_balancing, bench_skewed_until_balanced) {
+    skewed_load_bench(true);
+}
@@ -12,8 +12,10 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "cluster/scheduling/leader_balancer_greedy.h"
+#include "cluster/scheduling/leader_balancer_load.h"
 #include "leader_balancer_test_utils.h"
 #include "model/metadata.h"
+#include "units.h"
 
 #include <absl/container/flat_hash_set.h>
 #include <boost/test/unit_test.hpp>
@@ -25,6 +27,7 @@
 
 using index_type = cluster::leader_balancer_strategy::index_type;
 using gbs = cluster::greedy_balanced_shards;
+using lbs = cluster::load_balanced_shards;
 using reassignment = cluster::leader_balancer_strategy::reassignment;
 
 /**
@@ -361,3 +364,100 @@ BOOST_AUTO_TEST_CASE(greedy_skip) {
       raft::group_id(5), raft::group_id(6)};
     BOOST_REQUIRE(no_movement(spec, {0}, skip));
 }
+
+/**
+ * @brief Create a load aware balancer from a cluster_spec and the byte rates
+ * of its groups.
+ */
+static lbs load_from_spec(
+  const cluster_spec& spec,
+  const absl::flat_hash_map<int, uint64_t>& rates,
+  double hysteresis = lbs::default_hysteresis) {
+    auto [index, _] = from_spec(spec);
+    lbs::group_loads loads;
+    for (auto [group, rate] : rates) {
+        loads.emplace(raft::group_id(group), rate);
+    }
+    return {index, {}, loads, hysteresis};
+}
+
+BOOST_AUTO_TEST_CASE(load_aware_without_traffic) {
+    auto index = leader_balancer_test_utils::make_cluster_index(10, 2, 10, 3);
+    auto shard20 = model::broker_shard{model::node_id{2}, 0};
+    index[shard20][raft::group_id(20)] = index[shard20][raft::group_id(3)];
+    index[shard20][raft::group_id(21)] = index[shard20][raft::group_id(3)];
+
+    // leader counts are balanced like with the greedy strategy
+    auto balancer = lbs(index, {}, {});
+    BOOST_REQUIRE_GT(balancer.error(), 0);
+    auto movement = balancer.find_movement({});
+    BOOST_REQUIRE(movement);
+    check_valid(index, *movement);
+    BOOST_REQUIRE_EQUAL(movement->from, shard20);
+
+    auto [balanced, _] = from_spec({{{1}, {2}}, {{2}, {1}}});
+    BOOST_REQUIRE(!lbs(balanced, {}, {}).find_movement({}));
+}
+
+BOOST_AUTO_TEST_CASE(load_aware_moves_traffic) {
+    // leader counts are balanced but node 0 leads the hot group, one of its
+    // other groups goes to node 1
+    auto spec = cluster_spec{
+      // clang-format off
+      {{1, 2}, {-1}},
+      {{3, 4}, {-1}},
+      // clang-format on
+    };
+    absl::flat_hash_map<int, uint64_t> rates{
+      {1, 1000}, {2, 10}, {3, 10}, {4, 10}};
+
+    BOOST_REQUIRE(no_movement(spec));
+    auto balancer = load_from_spec(spec, rates);
+    auto movement = balancer.find_movement({});
+    BOOST_REQUIRE(movement);
+    BOOST_REQUIRE(*movement == re(2, 0, 1));
+
+    // moving the hot group itself would only swap the imbalance
+    BOOST_REQUIRE(!balancer.find_movement({raft::group_id(2)}));
+}
+
+BOOST_AUTO_TEST_CASE(load_aware_hysteresis) {
+    auto spec = cluster_spec{
+      // clang-format off
+      {{1, 2}, {-1}},
+      {{3, 4}, {-1}},
+      // clang-format on
+    };
+    absl::flat_hash_map<int, uint64_t> rates{
+      {1, 1000}, {2, 10}, {3, 10}, {4, 10}};
+
+    // the move improves balance by less than the margin
+    BOOST_REQUIRE(!load_from_spec(spec, rates, 1.0).find_movement({}));
+
+    // nearly equal loads are left alone
+    rates = {{1, 100}, {2, 100}, {3, 95}, {4, 95}};
+    BOOST_REQUIRE(!load_from_spec(spec, rates).find_movement({}));
+}
+
+BOOST_AUTO_TEST_CASE(load_aware_converges) {
+    // 6 nodes, 2 cores per node, 10 groups per core, 3 replicas, the hottest
+    // groups led by 2 cores
+    auto [index, loads] = leader_balancer_test_utils::make_skewed_cluster_index(
+      6, 2, 10, 3, 2, 1_MiB);
+
+    auto initial_error = lbs(index, {}, loads).error();
+    size_t moves = 0;
+    for (; moves < 1000; ++moves) {
+        auto balancer = lbs(index, {}, loads);
+        auto movement = balancer.find_movement({});
+        if (!movement) {
+            break;
+        }
+        check_valid(index, *movement);
+        leader_balancer_test_utils::apply_reassignment(index, *movement);
+        BOOST_REQUIRE_LT(lbs(index, {}, loads).error(), balancer.error());
+    }
+    BOOST_REQUIRE_GT(moves, 0);
+    BOOST_REQUIRE_LT(moves, 1000);
+    BOOST_REQUIRE_LT(lbs(index, {}, loads).error(), initial_error);
+}
@@ -10,6 +10,12 @@
  */
 
 #include "cluster/scheduling/leader_balancer_greedy.h"
+#include "cluster/scheduling/leader_balancer_load.h"
+#include "random/generators.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
 
 namespace leader_balancer_test_utils {
 
@@ -51,4 +57,76 @@ static cluster::leader_balancer_strategy::index_type make_cluster_index(
     return index;
 }
 
+/**
+ * @brief Create a cluster index with a skewed leader load: every group gets
+ * a distinct id and its byte rate follows a zipf like distribution. The
+ * hottest groups are led by the first hot_shards shards, the way a few busy
+ * topics end up concentrated after a restart or a topic creation, while
+ * leader counts are equal on all the shards.
+ */
+static std::pair<
+  cluster::leader_balancer_strategy::index_type,
+  cluster::load_balanced_shards::group_loads>
+make_skewed_cluster_index(
+  int node_count,
+  int shards_per_node,
+  int groups_per_shard,
+  int replica_count,
+  int hot_shards,
+  uint64_t max_rate) {
+    cluster::leader_balancer_strategy::index_type index;
+    cluster::load_balanced_shards::group_loads loads;
+
+    std::vector<model::broker_shard> shards;
+    for (auto n = 0; n < node_count; n++) {
+        for (auto s = 0U; s < shards_per_node; s++) {
+            shards.push_back(model::broker_shard{model::node_id(n), s});
+        }
+    }
+
+    const auto num_groups = shards.size() * groups_per_shard;
+    // ranks of the groups by load, the hottest ones come first
+    std::vector<size_t> ranks(num_groups);
+    std::iota(ranks.begin(), ranks.end(), 0);
+    const auto hot_groups = std::min<size_t>(
+      hot_shards * groups_per_shard, num_groups);
+    std::shuffle(
+      ranks.begin() + hot_groups,
+      ranks.end(),
+      random_generators::internal::gen);
+
+    size_t replica = 0;
+    size_t group_idx = 0;
+    for (auto shard : shards) {
+        for (auto g = 0; g < groups_per_shard; g++, group_idx++) {
+            raft::group_id group(group_idx);
+            std::vector<model::broker_shard> replicas;
+            replicas.push_back(shard); // the "leader"
+            while (replicas.size() != replica_count) {
+                auto& candidate = shards[replica % shards.size()];
+                if (candidate.node_id != shard.node_id) {
+                    replicas.push_back(candidate);
+                }
+                ++replica;
+            }
+            index[shard][group] = std::move(replicas);
+            loads[group] = max_rate / (ranks[group_idx] + 1);
+        }
+    }
+
+    return {std::move(index), std::move(loads)};
+}
+
+/**
+ * @brief Apply a leadership transfer to the index.
+ */
+static void apply_reassignment(
+  cluster::leader_balancer_strategy::index_type& index,
+  const cluster::leader_balancer_strategy::reassignment& r) {
+    auto& from = index.at(r.from);
+    auto it = from.find(r.group);
+    index[r.to][r.group] = std::move(it->second);
+    from.erase(it);
+}
+
 } // namespace leader_balancer_test_utils
@@ -8,6 +8,7 @@
 // by the Apache License, Version 2.0
 
 #include "cluster/cluster_utils.h"
+#include "cluster/scheduling/constraints.h"
 #include "cluster/scheduling/types.h"
 #include "cluster/tests/partition_allocator_fixture.h"
 #include "model/metadata.h"
@@ -613,3 +614,45 @@ FIXTURE_TEST(rack_aware_assignment_2, partition_allocator_fixture) {
     BOOST_REQUIRE(racks.contains("rack-a"));
     BOOST_REQUIRE(racks.contains("rack-b"));
 }
+
+FIXTURE_TEST(batch_scoring_matches_node_scoring, partition_allocator_fixture) {
+    register_node(0, 2, model::rack_id("rack-a"));
+    register_node(1, 2, model::rack_id("rack-b"));
+    register_node(2, 4, model::rack_id("rack-a"));
+    register_node(3, 1, model::rack_id("rack-c"));
+    register_node(4, 2);
+    // make the nodes differently allocated
+    auto units = allocator.allocate(make_allocation_request(5, 1)).value();
+    for (auto& pas : units.get_assignments()) {
+        allocator.state().apply_update(pas.replicas, pas.group);
+    }
+
+    std::vector<model::broker_shard> replicas{
+      model::broker_shard{.node_id = model::node_id(0), .shard = 0},
+      model::broker_shard{.node_id = model::node_id(3), .shard = 0},
+    };
+    std::vector<cluster::soft_constraint_evaluator> constraints;
+    constraints.push_back(cluster::least_allocated());
+    constraints.push_back(cluster::distinct_rack(replicas, allocator.state()));
+
+    std::vector<const cluster::allocation_node*> nodes;
+    for (const auto& [_, n] : allocator.state().allocation_nodes()) {
+        nodes.push_back(n.get());
+    }
+    for (const auto& c : constraints) {
+        std::vector<uint64_t> scratch;
+        std::vector<uint64_t> totals(nodes.size(), 0);
+        c.add_scores(nodes, scratch, totals);
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            BOOST_REQUIRE_EQUAL(totals[i], c.score(*nodes[i]));
+        }
+    }
+
+    auto hard = cluster::distinct_from(replicas);
+    auto filtered = nodes;
+    hard.filter(filtered);
+    BOOST_REQUIRE_EQUAL(filtered.size(), 3);
+    for (auto* n : filtered) {
+        BOOST_REQUIRE(hard.evaluate(*n));
+    }
+}
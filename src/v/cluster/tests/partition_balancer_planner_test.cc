@@ -823,3 +823,64 @@ FIXTURE_TEST(
     BOOST_REQUIRE_EQUAL(plan_data.cancellations.size(), 0);
     BOOST_REQUIRE_EQUAL(plan_data.failed_reassignments_count, 1);
 }
+
+/*
+ * 5 nodes; 1 topic; node_0 handles most of the traffic
+ * Actual
+ *   node_0: partitions: 2; load: 3 MiB/s
+ *   node_1: partitions: 2; load: 1 MiB/s
+ *   node_2: partitions: 2; load: 1 MiB/s
+ *   node_3: partitions: 2; load: 1 MiB/s
+ *   node_4: partitions: 2; load: 1 MiB/s
+ * Expected
+ *   one of node_0 partitions is moved, no node goes over twice the average
+ */
+FIXTURE_TEST(test_load_imbalance, partition_balancer_planner_fixture) {
+    allocator_register_nodes(5);
+    create_topic("topic-1", 10, 1);
+
+    auto load_planner = cluster::partition_balancer_planner(
+      cluster::planner_config{
+        .soft_max_disk_usage_ratio = 0.8,
+        .hard_max_disk_usage_ratio = 0.95,
+        .movement_disk_size_batch = reallocation_batch_size,
+        .node_availability_timeout_sec = std::chrono::minutes(1),
+        .max_load_imbalance_ratio = 1.0},
+      workers.table.local(),
+      workers.members.local(),
+      workers.allocator.local());
+
+    auto hr = create_health_report();
+    auto fm = create_follower_metrics();
+
+    // without traffic there is nothing to balance
+    auto plan_data = load_planner.plan_reassignments(hr, fm);
+    BOOST_REQUIRE_EQUAL(plan_data.reassignments.size(), 0);
+
+    absl::flat_hash_set<model::partition_id> on_node_0;
+    for (const auto& a : workers.table.local()
+                           .topics_map()
+                           .at(make_tp_ns("topic-1"))
+                           .get_assignments()) {
+        if (a.replicas.front().node_id == model::node_id(0)) {
+            on_node_0.insert(a.id);
+        }
+    }
+    BOOST_REQUIRE_EQUAL(on_node_0.size(), 2);
+    for (auto& ps : hr.node_reports[0].topics.front().partitions) {
+        ps.bytes_rate = on_node_0.contains(ps.id) ? 1536_KiB : 512_KiB;
+    }
+
+    plan_data = load_planner.plan_reassignments(hr, fm);
+    check_violations(plan_data, {}, {});
+    BOOST_REQUIRE(
+      plan_data.status
+      == cluster::partition_balancer_planner::status::movement_planned);
+    BOOST_REQUIRE_EQUAL(plan_data.reassignments.size(), 1);
+    auto& reassignment = plan_data.reassignments.front();
+    BOOST_REQUIRE(on_node_0.contains(reassignment.ntp.tp.partition));
+    auto& new_replicas
+      = reassignment.allocation_units.get_assignments().front().replicas;
+    BOOST_REQUIRE_EQUAL(new_replicas.size(), 1);
+    BOOST_REQUIRE_NE(new_replicas.front().node_id, model::node_id(0));
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "cluster/partition_leaders_table.h"
+#include "cluster/topic_table.h"
+#include "model/fundamental.h"
+#include "model/namespace.h"
+#include "test_utils/async.h"
+
+#include <seastar/core/sleep.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+using namespace std::chrono_literals;
+using changes_t = cluster::partition_leaders_table::leadership_changes_t;
+
+namespace {
+model::ntp make_ntp(int32_t p) {
+    return model::ntp(
+      model::kafka_namespace, model::topic("tapioca"), model::partition_id(p));
+}
+
+struct leaders_table_fixture {
+    leaders_table_fixture()
+      : leaders(topics) {
+        topics.start().get();
+    }
+    ~leaders_table_fixture() {
+        leaders.stop().get();
+        topics.stop().get();
+    }
+
+    ss::sharded<cluster::topic_table> topics;
+    cluster::partition_leaders_table leaders;
+};
+} // namespace
+
+SEASTAR_THREAD_TEST_CASE(leadership_changes_are_batched) {
+    leaders_table_fixture f;
+    std::vector<changes_t> batches;
+    auto id = f.leaders.register_leadership_changes_notification(
+      [&batches](const changes_t& changes) { batches.push_back(changes); });
+
+    for (int32_t p = 0; p < 100; ++p) {
+        f.leaders.update_partition_leader(
+          make_ntp(p), model::term_id(1), model::node_id(1));
+    }
+    // a later change of the same partition replaces the pending one
+    f.leaders.update_partition_leader(
+      make_ntp(0), model::term_id(2), model::node_id(2));
+    BOOST_REQUIRE(batches.empty());
+
+    tests::cooperative_spin_wait_with_timeout(1s, [&batches] {
+        return !batches.empty();
+    }).get();
+    BOOST_REQUIRE_EQUAL(batches.size(), 1);
+    BOOST_REQUIRE_EQUAL(batches[0].size(), 100);
+    BOOST_REQUIRE_EQUAL(batches[0][0].ntp, make_ntp(0));
+    BOOST_REQUIRE_EQUAL(batches[0][0].term, model::term_id(2));
+    BOOST_REQUIRE(batches[0][0].leader == model::node_id(2));
+
+    // updates that do not change the leader are not delivered
+    f.leaders.update_partition_leader(
+      make_ntp(1), model::term_id(1), model::node_id(1));
+    ss::sleep(50ms).get();
+    BOOST_REQUIRE_EQUAL(batches.size(), 1);
+
+    f.leaders.unregister_leadership_changes_notification(id);
+    f.leaders.update_partition_leader(
+      make_ntp(1), model::term_id(3), model::node_id(3));
+    ss::sleep(50ms).get();
+    BOOST_REQUIRE_EQUAL(batches.size(), 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(leadership_changes_unregister_while_notified) {
+    leaders_table_fixture f;
+    size_t first_calls = 0;
+    size_t second_calls = 0;
+    cluster::notification_id_type first;
+    cluster::notification_id_type second;
+    // each subscriber unregisters both, only the one called first runs
+    auto unregister_all = [&f, &first, &second] {
+        f.leaders.unregister_leadership_changes_notification(first);
+        f.leaders.unregister_leadership_changes_notification(second);
+    };
+    first = f.leaders.register_leadership_changes_notification(
+      [&first_calls, &unregister_all](const changes_t&) {
+          ++first_calls;
+          unregister_all();
+      });
+    second = f.leaders.register_leadership_changes_notification(
+      [&second_calls, &unregister_all](const changes_t&) {
+          ++second_calls;
+          unregister_all();
+      });
+
+    f.leaders.update_partition_leader(
+      make_ntp(0), model::term_id(1), model::node_id(1));
+    tests::cooperative_spin_wait_with_timeout(1s, [&] {
+        return first_calls + second_calls > 0;
+    }).get();
+    f.leaders.update_partition_leader(
+      make_ntp(0), model::term_id(2), model::node_id(2));
+    ss::sleep(50ms).get();
+    BOOST_REQUIRE_EQUAL(first_calls + second_calls, 1);
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#define BOOST_TEST_MODULE partition_movement_scheduler
+
+#include "cluster/partition_movement_scheduler.h"
+#include "units.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+using scheduler = cluster::partition_movement_scheduler;
+
+static std::vector<model::node_id> nodes(std::initializer_list<int> ids) {
+    std::vector<model::node_id> ret;
+    for (auto id : ids) {
+        ret.emplace_back(id);
+    }
+    return ret;
+}
+
+BOOST_AUTO_TEST_CASE(per_node_concurrency) {
+    scheduler s;
+    s.start_round({.max_concurrent_per_node = 2}, scheduler::clock_type::now());
+
+    BOOST_REQUIRE(s.try_start(nodes({1, 2}), 1_MiB));
+    BOOST_REQUIRE(s.try_start(nodes({1, 3}), 1_MiB));
+    // node 1 recovers two replicas already
+    BOOST_REQUIRE(!s.try_start(nodes({1}), 1_MiB));
+    BOOST_REQUIRE(!s.try_start(nodes({3, 1}), 1_MiB));
+    BOOST_REQUIRE(s.try_start(nodes({2, 3}), 1_MiB));
+    BOOST_REQUIRE_EQUAL(s.in_progress(), 3);
+    BOOST_REQUIRE(!s.saturated(3));
+    BOOST_REQUIRE(s.saturated(1));
+
+    // moves in progress are accounted again in every round
+    s.start_round({.max_concurrent_per_node = 2}, scheduler::clock_type::now());
+    BOOST_REQUIRE_EQUAL(s.in_progress(), 0);
+    s.add_in_progress(nodes({1}));
+    s.add_in_progress(nodes({1}));
+    BOOST_REQUIRE(!s.try_start(nodes({1}), 1_MiB));
+    BOOST_REQUIRE(s.try_start(nodes({2}), 1_MiB));
+}
+
+BOOST_AUTO_TEST_CASE(bandwidth_budget) {
+    const scheduler::limits limits{
+      .max_concurrent_per_node = 100, .bandwidth = 10_MiB};
+    auto now = scheduler::clock_type::now();
+
+    scheduler s;
+    // the bucket starts full, 10 seconds of the budget
+    s.start_round(limits, now);
+    BOOST_REQUIRE(s.try_start(nodes({1}), 60_MiB));
+    // the bucket may go negative so that large partitions are not starved
+    BOOST_REQUIRE(s.try_start(nodes({2}), 60_MiB));
+    BOOST_REQUIRE(!s.try_start(nodes({3}), 1_MiB));
+    BOOST_REQUIRE(s.saturated(100));
+
+    // 20MiB in debt, refilled after 2 seconds
+    now += 1s;
+    s.start_round(limits, now);
+    BOOST_REQUIRE(!s.try_start(nodes({3}), 1_MiB));
+    now += 2s;
+    s.start_round(limits, now);
+    BOOST_REQUIRE(s.try_start(nodes({3}), 1_MiB));
+
+    // unlimited
+    s.start_round({.max_concurrent_per_node = 100}, now);
+    for (int i = 0; i < 50; ++i) {
+        BOOST_REQUIRE(s.try_start(nodes({i}), 1_GiB));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(progress) {
+    scheduler s;
+    s.start_round({.max_concurrent_per_node = 1}, scheduler::clock_type::now());
+    BOOST_REQUIRE(!s.throughput());
+    BOOST_REQUIRE(!s.eta(1_GiB));
+
+    auto start = scheduler::clock_type::now();
+    BOOST_REQUIRE(s.try_start(nodes({1}), 100_MiB));
+    s.move_finished(100_MiB);
+
+    auto rate = s.throughput(start + 10s);
+    BOOST_REQUIRE(rate);
+    BOOST_REQUIRE_CLOSE(*rate, double(10_MiB), 5);
+    auto eta = s.eta(100_MiB, start + 10s);
+    BOOST_REQUIRE(eta);
+    BOOST_REQUIRE_GE(eta->count(), 9);
+    BOOST_REQUIRE_LE(eta->count(), 11);
+
+    s.reset_progress();
+    BOOST_REQUIRE(!s.throughput());
+}
@@ -25,6 +25,7 @@
 #include "storage/tests/utils/disk_log_builder.h"
 #include "test_utils/async.h"
 
+#include <seastar/testing/thread_test_case.hh>
 #include <seastar/util/defer.hh>
 
 #include <system_error>
@@ -464,3 +465,71 @@ FIXTURE_TEST(test_tx_post_aborted_produce, mux_state_machine_fixture) {
     BOOST_REQUIRE(offset_r == invalid_producer_epoch);
     feature_table.stop().get0();
 }
+
+SEASTAR_THREAD_TEST_CASE(test_producer_seqs_cache) {
+    cluster::rm_stm::producer_seqs seqs;
+    seqs.pid = model::producer_identity{1, 0};
+
+    for (int32_t seq = 0; seq < 10; ++seq) {
+        seqs.update(seq, kafka::offset(seq * 10));
+    }
+    BOOST_REQUIRE_EQUAL(seqs.seq, 9);
+    BOOST_REQUIRE_EQUAL(seqs.last_offset, kafka::offset(90));
+
+    // only the most recent sequences are cached, oldest first
+    auto cached = seqs.cached();
+    BOOST_REQUIRE_EQUAL(
+      cached.size(), cluster::rm_stm::producer_seqs::seq_cache_capacity);
+    int32_t expected = 9 - int32_t(cached.size());
+    for (const auto& entry : cached) {
+        BOOST_REQUIRE_EQUAL(entry.seq, expected);
+        BOOST_REQUIRE_EQUAL(entry.offset, kafka::offset(expected * 10));
+        ++expected;
+    }
+
+    // the snapshot representation roundtrips
+    cluster::rm_stm::producer_seqs restored;
+    restored.assign(seqs.to_seq_entry());
+    BOOST_REQUIRE_EQUAL(restored.pid, seqs.pid);
+    BOOST_REQUIRE_EQUAL(restored.seq, seqs.seq);
+    BOOST_REQUIRE_EQUAL(restored.last_offset, seqs.last_offset);
+    BOOST_REQUIRE_EQUAL(restored.seq_cache_count, seqs.seq_cache_count);
+    for (size_t i = 0; i < seqs.seq_cache_count; ++i) {
+        BOOST_REQUIRE_EQUAL(restored.seq_cache[i].seq, seqs.seq_cache[i].seq);
+        BOOST_REQUIRE_EQUAL(
+          restored.seq_cache[i].offset, seqs.seq_cache[i].offset);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_indexed_abort_snapshot_intersecting) {
+    using tx_range = cluster::rm_stm::tx_range;
+    auto range = [](int64_t first, int64_t last) {
+        return tx_range{
+          .pid = model::producer_identity{first, 0},
+          .first = model::offset(first),
+          .last = model::offset(last)};
+    };
+
+    cluster::rm_stm::abort_snapshot snapshot{
+      .first = model::offset(0),
+      .last = model::offset(100),
+      .aborted = {range(50, 60), range(0, 90), range(10, 20), range(30, 40)}};
+    cluster::rm_stm::indexed_abort_snapshot indexed(std::move(snapshot));
+
+    auto lookup = [&indexed](int64_t from, int64_t to) {
+        std::vector<tx_range> result;
+        indexed.intersecting(result, model::offset(from), model::offset(to));
+        std::vector<int64_t> firsts;
+        for (const auto& r : result) {
+            firsts.push_back(r.first());
+        }
+        return firsts;
+    };
+
+    // the long range keeps overlapping everything up to its last offset
+    BOOST_REQUIRE(lookup(25, 35) == std::vector<int64_t>({0, 30}));
+    BOOST_REQUIRE(lookup(61, 89) == std::vector<int64_t>({0}));
+    BOOST_REQUIRE(lookup(91, 100).empty());
+    BOOST_REQUIRE(lookup(0, 5) == std::vector<int64_t>({0}));
+    BOOST_REQUIRE(lookup(0, 100) == std::vector<int64_t>({0, 10, 30, 50}));
+}
@@ -606,6 +606,8 @@ cluster::topic_properties random_topic_properties() {
     });
     properties.remote_topic_properties = tests::random_optional(
       [] { return random_remote_topic_properties(); });
+    properties.write_caching = tests::random_optional(
+      [] { return tests::random_bool(); });
 
     return properties;
 }
@@ -882,6 +884,20 @@ SEASTAR_THREAD_TEST_CASE(serde_reflection_roundtrip) {
         tests::random_named_int<model::revision_id>()),
     }));
 
+    roundtrip_test(cluster::update_leadership_request_v2(
+      {
+        cluster::ntp_leader_revision(
+          model::random_ntp(),
+          tests::random_named_int<model::term_id>(),
+          tests::random_named_int<model::node_id>(),
+          tests::random_named_int<model::revision_id>()),
+      },
+      cluster::leadership_update_stream{
+        .sender = tests::random_named_int<model::node_id>(),
+        .session = random_generators::get_int<uint64_t>(),
+        .sequence = random_generators::get_int<uint64_t>(),
+      }));
+
     roundtrip_test(cluster::update_leadership_reply());
 
     roundtrip_test(cluster::get_leadership_request());
@@ -898,6 +914,10 @@ SEASTAR_THREAD_TEST_CASE(serde_reflection_roundtrip) {
 
     roundtrip_test(
       cluster::allocate_id_reply(23433, cluster::errc::invalid_node_operation));
+    serde_roundtrip_test(cluster::allocate_id_range_request{
+      .count = 100, .timeout = random_timeout_clock_duration()});
+    serde_roundtrip_test(cluster::allocate_id_range_reply{
+      .id = 23433, .count = 100, .ec = cluster::errc::success});
     {
         cluster::partition_assignment p_as;
         p_as.group = tests::random_named_int<raft::group_id>();
@@ -942,6 +962,11 @@ SEASTAR_THREAD_TEST_CASE(serde_reflection_roundtrip) {
             [] { return model::random_shadow_indexing_mode(); })),
         };
         roundtrip_test(updates);
+
+        // write_caching is only carried by the serde encoding
+        updates.write_caching = random_property_update(
+          tests::random_optional([] { return tests::random_bool(); }));
+        serde_roundtrip_test(updates);
     }
     { roundtrip_test(old_random_topic_configuration()); }
     { serde_roundtrip_test(random_topic_configuration()); }
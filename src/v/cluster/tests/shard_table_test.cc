@@ -0,0 +1,71 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE shard_table
+
+#include "cluster/shard_table.h"
+#include "model/fundamental.h"
+#include "model/namespace.h"
+
+#include <boost/test/unit_test.hpp>
+
+static model::ntp make_ntp(ss::sstring topic, int32_t partition) {
+    return model::ntp(
+      model::kafka_namespace,
+      model::topic(std::move(topic)),
+      model::partition_id(partition));
+}
+
+BOOST_AUTO_TEST_CASE(shard_table_lookup) {
+    cluster::shard_table st;
+    st.update(make_ntp("a", 0), raft::group_id(1), 1, model::revision_id(10));
+    st.update(make_ntp("a", 3), raft::group_id(2), 2, model::revision_id(10));
+    st.update(make_ntp("b", 0), raft::group_id(3), 3, model::revision_id(11));
+
+    BOOST_REQUIRE_EQUAL(st.shard_for(make_ntp("a", 0)).value(), 1);
+    BOOST_REQUIRE_EQUAL(st.shard_for(make_ntp("a", 3)).value(), 2);
+    BOOST_REQUIRE_EQUAL(st.shard_for(make_ntp("b", 0)).value(), 3);
+    BOOST_REQUIRE_EQUAL(
+      st.revision_for(make_ntp("b", 0)).value(), model::revision_id(11));
+    BOOST_REQUIRE_EQUAL(st.shard_for(raft::group_id(2)), 2);
+
+    // gaps, out of range and unknown partitions
+    BOOST_REQUIRE(!st.shard_for(make_ntp("a", 1)));
+    BOOST_REQUIRE(!st.shard_for(make_ntp("a", 4)));
+    BOOST_REQUIRE(!st.shard_for(make_ntp("a", -1)));
+    BOOST_REQUIRE(!st.shard_for(make_ntp("c", 0)));
+    BOOST_REQUIRE(!st.contains(raft::group_id(4)));
+}
+
+BOOST_AUTO_TEST_CASE(shard_table_revisions) {
+    cluster::shard_table st;
+    auto ntp = make_ntp("a", 2);
+    st.update(ntp, raft::group_id(1), 1, model::revision_id(10));
+
+    // stale updates are ignored
+    st.update(ntp, raft::group_id(1), 2, model::revision_id(9));
+    BOOST_REQUIRE_EQUAL(st.shard_for(ntp).value(), 1);
+    st.erase(ntp, raft::group_id(1), model::revision_id(9));
+    BOOST_REQUIRE_EQUAL(st.shard_for(ntp).value(), 1);
+
+    st.update(ntp, raft::group_id(1), 2, model::revision_id(12));
+    BOOST_REQUIRE_EQUAL(st.shard_for(ntp).value(), 2);
+
+    st.erase(ntp, raft::group_id(1), model::revision_id(12));
+    BOOST_REQUIRE(!st.shard_for(ntp));
+    BOOST_REQUIRE(!st.contains(raft::group_id(1)));
+
+    // non replicable entries
+    auto nr_ntp = make_ntp("nr", 0);
+    BOOST_REQUIRE(st.update_shard(nr_ntp, 3, model::revision_id(5)));
+    BOOST_REQUIRE(!st.update_shard(nr_ntp, 4, model::revision_id(4)));
+    BOOST_REQUIRE_EQUAL(st.shard_for(nr_ntp).value(), 3);
+    st.erase(nr_ntp, model::revision_id(5));
+    BOOST_REQUIRE(!st.shard_for(nr_ntp));
+}
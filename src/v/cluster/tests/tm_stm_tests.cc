@@ -191,3 +191,47 @@ FIXTURE_TEST(test_tm_stm_re_tx, mux_state_machine_fixture) {
     BOOST_REQUIRE_EQUAL(tx7.status, tx_status::ready);
     BOOST_REQUIRE_EQUAL(tx7.partitions.size(), 0);
 }
+
+FIXTURE_TEST(test_tm_stm_concurrent_updates, mux_state_machine_fixture) {
+    start_raft();
+
+    cluster::tm_stm stm(tm_logger, _raft.get());
+    auto c = _raft.get();
+
+    stm.start().get0();
+    auto stop = ss::defer([&stm] { stm.stop().get0(); });
+
+    wait_for_confirmed_leader();
+    wait_for_meta_initialized();
+
+    // updates of concurrent transactions share appends, each of them must
+    // still observe its own state once replicated
+    constexpr int64_t txs = 16;
+    std::vector<ss::future<op_status>> fs;
+    fs.reserve(txs);
+    for (int64_t i = 0; i < txs; ++i) {
+        fs.push_back(stm.register_new_producer(
+          c->term(),
+          kafka::transactional_id(fmt::format("app-id-{}", i)),
+          std::chrono::milliseconds(0),
+          model::producer_identity{i, 0}));
+    }
+    for (auto& op_code : ss::when_all_succeed(fs.begin(), fs.end()).get0()) {
+        BOOST_REQUIRE_EQUAL(op_code, op_status::success);
+    }
+
+    std::vector<ss::future<checked<tm_transaction, op_status>>> rfs;
+    rfs.reserve(txs);
+    for (int64_t i = 0; i < txs; ++i) {
+        rfs.push_back(stm.reset_tx_ready(
+          c->term(), kafka::transactional_id(fmt::format("app-id-{}", i))));
+    }
+    auto results = ss::when_all_succeed(rfs.begin(), rfs.end()).get0();
+    for (int64_t i = 0; i < txs; ++i) {
+        auto tx = expect_tx(results[i]);
+        BOOST_REQUIRE_EQUAL(
+          tx.id, kafka::transactional_id(fmt::format("app-id-{}", i)));
+        BOOST_REQUIRE_EQUAL(tx.pid, (model::producer_identity{i, 0}));
+        BOOST_REQUIRE_EQUAL(tx.status, tx_status::ready);
+    }
+}
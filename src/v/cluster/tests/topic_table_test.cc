@@ -396,3 +396,35 @@ FIXTURE_TEST(test_tracking_broker_revisions, topic_table_fixture) {
         {n_4, model::revision_id(13)},
         {n_3, model::revision_id(11)}});
 }
+
+SEASTAR_THREAD_TEST_CASE(test_assignments_set) {
+    auto make_assignment = [](int32_t id) {
+        return cluster::partition_assignment(
+          raft::group_id(id), model::partition_id(id), {});
+    };
+
+    cluster::assignments_set assignments;
+    for (int32_t i = 0; i < 4; ++i) {
+        BOOST_REQUIRE(assignments.emplace(make_assignment(i)).second);
+    }
+    BOOST_REQUIRE(!assignments.emplace(make_assignment(2)).second);
+    // out of order insertions keep the set sorted
+    BOOST_REQUIRE(assignments.emplace(make_assignment(7)).second);
+    BOOST_REQUIRE(assignments.emplace(make_assignment(5)).second);
+    BOOST_REQUIRE_EQUAL(assignments.size(), 6);
+
+    std::vector<int32_t> ids;
+    for (const auto& p_as : assignments) {
+        ids.push_back(p_as.id());
+    }
+    BOOST_REQUIRE(ids == std::vector<int32_t>({0, 1, 2, 3, 5, 7}));
+
+    for (auto id : ids) {
+        auto it = assignments.find(model::partition_id(id));
+        BOOST_REQUIRE(it != assignments.end());
+        BOOST_REQUIRE_EQUAL(it->group, raft::group_id(id));
+    }
+    BOOST_REQUIRE(!assignments.contains(model::partition_id(4)));
+    BOOST_REQUIRE(!assignments.contains(model::partition_id(8)));
+    BOOST_REQUIRE(!assignments.contains(model::partition_id(-1)));
+}
@@ -165,3 +165,61 @@ FIXTURE_TEST(
       current_cluster_capacity(allocator.local().state().allocation_nodes()),
       max_cluster_capacity() - (1 * 3 + 12 * 3 + 8 * 1));
 }
+
+FIXTURE_TEST(
+  test_dispatching_batched_create, topic_table_updates_dispatcher_fixture) {
+    std::vector<cluster::create_topic_cmd> cmds;
+    cmds.push_back(make_create_topic_cmd("test_tp_1", 1, 3));
+    cmds.push_back(make_create_topic_cmd("test_tp_2", 12, 3));
+    cmds.push_back(make_create_topic_cmd("test_tp_3", 8, 1));
+
+    auto batch = cluster::serde_serialize_cmds(std::move(cmds));
+    batch.header().base_offset = model::offset(10);
+    auto res = dispatcher.apply_update(std::move(batch)).get0();
+    BOOST_REQUIRE_EQUAL(res, cluster::errc::success);
+
+    auto md = table.local().all_topics_metadata();
+    BOOST_REQUIRE_EQUAL(md.size(), 3);
+    // every command is applied at the offset of its record
+    BOOST_REQUIRE_EQUAL(
+      table.local().get_initial_revision(make_tp_ns("test_tp_1")).value(),
+      model::initial_revision_id(10));
+    BOOST_REQUIRE_EQUAL(
+      table.local().get_initial_revision(make_tp_ns("test_tp_3")).value(),
+      model::initial_revision_id(12));
+    BOOST_REQUIRE_EQUAL(
+      current_cluster_capacity(allocator.local().state().allocation_nodes()),
+      max_cluster_capacity() - (1 * 3 + 12 * 3 + 8 * 1));
+}
+
+FIXTURE_TEST(
+  test_dispatching_batch_is_all_or_nothing,
+  topic_table_updates_dispatcher_fixture) {
+    create_topics();
+
+    std::vector<cluster::create_topic_cmd> creates;
+    creates.push_back(make_create_topic_cmd("test_tp_4", 1, 3));
+    creates.push_back(make_create_topic_cmd("test_tp_2", 1, 3));
+    auto res = dispatcher
+                 .apply_update(
+                   cluster::serde_serialize_cmds(std::move(creates)))
+                 .get0();
+    BOOST_REQUIRE_EQUAL(res, cluster::errc::topic_already_exists);
+    BOOST_REQUIRE(!table.local().contains(make_tp_ns("test_tp_4")));
+
+    std::vector<cluster::delete_topic_cmd> deletes;
+    for (auto name : {"test_tp_2", "test_tp_3"}) {
+        deletes.emplace_back(make_tp_ns(name), make_tp_ns(name));
+    }
+    res = dispatcher
+            .apply_update(cluster::serde_serialize_cmds(std::move(deletes)))
+            .get0();
+    BOOST_REQUIRE_EQUAL(res, cluster::errc::success);
+
+    auto md = table.local().all_topics_metadata();
+    BOOST_REQUIRE_EQUAL(md.size(), 1);
+    BOOST_REQUIRE_EQUAL(md.contains(make_tp_ns("test_tp_1")), true);
+    BOOST_REQUIRE_EQUAL(
+      current_cluster_capacity(allocator.local().state().allocation_nodes()),
+      max_cluster_capacity() - 3);
+}
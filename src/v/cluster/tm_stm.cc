@@ -13,11 +13,13 @@
 #include "cluster/types.h"
 #include "raft/errc.h"
 #include "raft/types.h"
+#include "ssx/future-util.h"
 #include "storage/record_batch_builder.h"
 #include "units.h"
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/later.hh>
 
 #include <filesystem>
 #include <optional>
@@ -120,6 +122,94 @@ tm_stm::sync(model::timeout_clock::duration timeout) {
     co_return _insync_term;
 }
 
+ss::future<result<raft::replicate_result>>
+tm_stm::replicate_quorum_ack(model::term_id term, model::record_batch&& batch) {
+    // batches are replicated with the term of the caller, never mix terms
+    // in a single append
+    if (!_pending_writes.empty() && _pending_writes_term != term) {
+        flush_pending_writes();
+    }
+    _pending_writes_term = term;
+
+    auto& w = _pending_writes.emplace_back(
+      pending_write{.batch = std::move(batch)});
+    auto f = w.done.get_future();
+
+    if (!_flush_scheduled) {
+        _flush_scheduled = true;
+        // let the transactions that are ready to run in this turn add their
+        // updates before replicating
+        ssx::spawn_with_gate(_gate, [this] {
+            return ss::later().then([this] { flush_pending_writes(); });
+        });
+    }
+    return f;
+}
+
+void tm_stm::flush_pending_writes() {
+    _flush_scheduled = false;
+    if (_pending_writes.empty()) {
+        return;
+    }
+    std::vector<pending_write> writes;
+    writes.swap(_pending_writes);
+
+    /*
+     * batches of a single append are assigned contiguous offsets, the last
+     * offset of each batch is the last offset of the append minus the number
+     * of records appended after it.
+     */
+    std::vector<int64_t> following(writes.size());
+    int64_t records = 0;
+    for (size_t idx = writes.size(); idx-- > 0;) {
+        following[idx] = records;
+        records += writes[idx].batch.record_count();
+    }
+
+    model::record_batch_reader::data_t batches;
+    batches.reserve(writes.size());
+    for (auto& w : writes) {
+        batches.push_back(std::move(w.batch));
+    }
+
+    auto f = _c->replicate(
+      _pending_writes_term,
+      model::make_memory_record_batch_reader(std::move(batches)),
+      raft::replicate_options{raft::consistency_level::quorum_ack});
+
+    ssx::spawn_with_gate(
+      _gate,
+      [f = std::move(f),
+       writes = std::move(writes),
+       following = std::move(following)]() mutable {
+          return complete_pending_writes(
+            std::move(f), std::move(writes), std::move(following));
+      });
+}
+
+ss::future<> tm_stm::complete_pending_writes(
+  ss::future<result<raft::replicate_result>> f,
+  std::vector<pending_write> writes,
+  std::vector<int64_t> following) {
+    try {
+        auto r = co_await std::move(f);
+        for (size_t idx = 0; idx < writes.size(); ++idx) {
+            if (!r) {
+                writes[idx].done.set_value(r.error());
+                continue;
+            }
+            writes[idx].done.set_value(raft::replicate_result{
+              .last_offset = r.value().last_offset
+                             - model::offset(following[idx])});
+        }
+    } catch (...) {
+        auto e = std::current_exception();
+        for (auto& w : writes) {
+            w.done.set_exception(e);
+        }
+    }
+}
+
 ss::future<checked<tm_transaction, tm_stm::op_status>>
 tm_stm::update_tx(tm_transaction tx, model::term_id term) {
     auto batch = serialize_tx(tx);
@@ -244,13 +244,25 @@ private:
 
     ss::future<checked<tm_transaction, tm_stm::op_status>>
       update_tx(tm_transaction, model::term_id);
+
+    // transaction state updates issued in the same reactor turn are
+    // replicated by a single append, see replicate_quorum_ack
+    struct pending_write {
+        model::record_batch batch;
+        ss::promise<result<raft::replicate_result>> done;
+    };
+
+    model::term_id _pending_writes_term;
+    std::vector<pending_write> _pending_writes;
+    bool _flush_scheduled{false};
+
     ss::future<result<raft::replicate_result>>
-    replicate_quorum_ack(model::term_id term, model::record_batch&& batch) {
-        return _c->replicate(
-          term,
-          model::make_memory_record_batch_reader(std::move(batch)),
-          raft::replicate_options{raft::consistency_level::quorum_ack});
-    }
+    replicate_quorum_ack(model::term_id term, model::record_batch&& batch);
+    void flush_pending_writes();
+    static ss::future<> complete_pending_writes(
+      ss::future<result<raft::replicate_result>>,
+      std::vector<pending_write>,
+      std::vector<int64_t>);
 };
 
 struct tm_transaction_v0 {
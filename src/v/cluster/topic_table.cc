@@ -11,6 +11,7 @@
 
 #include "cluster/cluster_utils.h"
 #include "cluster/commands.h"
+#include "cluster/controller_snapshot.h"
 #include "cluster/errc.h"
 #include "cluster/fwd.h"
 #include "cluster/logger.h"
@@ -20,6 +21,7 @@
 
 #include <seastar/core/coroutine.hh>
 
+#include <algorithm>
 #include <optional>
 
 namespace cluster {
@@ -56,7 +58,7 @@ topic_table::apply(create_topic_cmd cmd, model::offset offset) {
       .metadata = topic_metadata(
         std::move(cmd.value), model::revision_id(offset()), remote_revision)};
     // calculate delta
-    md.replica_revisions.reserve(cmd.value.assignments.size());
+    md.replica_revisions.reserve(md.get_assignments().size());
     for (auto& pas : md.get_assignments()) {
         auto ntp = model::ntp(cmd.key.ns, cmd.key.tp, pas.id);
         for (auto& r : pas.replicas) {
@@ -535,6 +537,36 @@ void incremental_update(
     }
 }
 
+std::error_code topic_table::check(const create_topic_cmd& cmd) const {
+    if (_topics.contains(cmd.key)) {
+        return errc::topic_already_exists;
+    }
+    return errc::success;
+}
+
+std::error_code topic_table::check(const delete_topic_cmd& cmd) const {
+    auto tp = _topics.find(cmd.value);
+    if (tp == _topics.end()) {
+        return errc::topic_not_exists;
+    }
+    if (tp->second.is_topic_replicable()) {
+        auto found = _topics_hierarchy.find(cmd.value);
+        if (found != _topics_hierarchy.end() && !found->second.empty()) {
+            return errc::source_topic_still_in_use;
+        }
+    }
+    return errc::success;
+}
+
+std::error_code
+topic_table::check(const update_topic_properties_cmd& cmd) const {
+    auto tp = _topics.find(cmd.key);
+    if (tp == _topics.end() || !tp->second.is_topic_replicable()) {
+        return errc::topic_not_exists;
+    }
+    return errc::success;
+}
+
 ss::future<std::error_code>
 topic_table::apply(update_topic_properties_cmd cmd, model::offset o) {
     auto tp = _topics.find(cmd.key);
@@ -558,6 +590,7 @@ topic_table::apply(update_topic_properties_cmd cmd, model::offset o) {
     incremental_update(properties.timestamp_type, overrides.timestamp_type);
 
     incremental_update(properties.shadow_indexing, overrides.shadow_indexing);
+    incremental_update(properties.write_caching, overrides.write_caching);
 
     // generate deltas for controller backend
     std::vector<topic_table_delta> deltas;
@@ -627,7 +660,165 @@ topic_table::apply(create_non_replicable_topic_cmd cmd, model::offset o) {
     co_return make_error_code(errc::success);
 }
 
+controller_snapshot_parts::topics topic_table::fill_snapshot() const {
+    controller_snapshot_parts::topics snap;
+    snap.topics.reserve(_topics.size());
+    for (const auto& [tp_ns, md] : _topics) {
+        controller_snapshot_parts::topics::topic t{
+          .configuration = md.get_configuration(),
+          .revision = md.get_revision(),
+          .remote_revision = md.get_remote_revision(),
+        };
+        if (!md.is_topic_replicable()) {
+            t.source_topic = md.get_source_topic();
+        }
+        t.partitions.reserve(md.get_assignments().size());
+        for (const auto& p_as : md.get_assignments()) {
+            controller_snapshot_parts::topics::partition p{.assignment = p_as};
+            if (auto it = md.replica_revisions.find(p_as.id);
+                it != md.replica_revisions.end()) {
+                p.replica_revisions = it->second;
+            }
+            t.partitions.push_back(std::move(p));
+        }
+        snap.topics.push_back(std::move(t));
+    }
+    snap.updates.reserve(_updates_in_progress.size());
+    for (const auto& [ntp, update] : _updates_in_progress) {
+        snap.updates.push_back(controller_snapshot_parts::topics::update{
+          .ntp = ntp,
+          .previous_replicas = update.previous_replicas,
+          .state = update.state,
+          .update_revision = update.update_revision,
+          .replicas_revisions = update.replicas_revisions,
+        });
+    }
+    return snap;
+}
+
+void topic_table::apply_snapshot(
+  model::offset offset, controller_snapshot_parts::topics snap) {
+    vassert(
+      _topics.empty() && _updates_in_progress.empty(),
+      "controller snapshot can only be applied to an empty topic table");
+
+    for (auto& u : snap.updates) {
+        _updates_in_progress.emplace(
+          std::move(u.ntp),
+          in_progress_update{
+            .previous_replicas = std::move(u.previous_replicas),
+            .state = u.state,
+            .update_revision = u.update_revision,
+            .replicas_revisions = std::move(u.replicas_revisions),
+          });
+    }
+
+    auto min_revision = [](const replicas_revision_map& revisions) {
+        auto it = std::min_element(
+          revisions.begin(), revisions.end(), [](const auto& a, const auto& b) {
+              return a.second < b.second;
+          });
+        return it == revisions.end() ? model::offset{}
+                                     : model::offset(it->second());
+    };
+
+    std::vector<delta> deltas;
+    for (auto& t : snap.topics) {
+        auto tp_ns = t.configuration.tp_ns;
+        if (t.source_topic) {
+            model::topic_namespace source(tp_ns.ns, *t.source_topic);
+            _topics_hierarchy[source].emplace(tp_ns);
+            assignments_set assignments;
+            for (auto& p : t.partitions) {
+                deltas.emplace_back(
+                  model::ntp(tp_ns.ns, tp_ns.tp, p.assignment.id),
+                  p.assignment,
+                  model::offset(t.revision()),
+                  delta::op_type::add_non_replicable);
+                assignments.emplace(std::move(p.assignment));
+            }
+            _topics.emplace(
+              tp_ns,
+              topic_metadata_item{
+                .metadata = topic_metadata(
+                  std::move(t.configuration),
+                  std::move(assignments),
+                  t.revision,
+                  *t.source_topic,
+                  t.remote_revision)});
+            continue;
+        }
+
+        std::vector<partition_assignment> assignments;
+        assignments.reserve(t.partitions.size());
+        for (auto& p : t.partitions) {
+            assignments.push_back(p.assignment);
+        }
+
+        topic_metadata_item md{
+          .metadata = topic_metadata(
+            topic_configuration_assignment(
+              std::move(t.configuration), std::move(assignments)),
+            t.revision,
+            t.remote_revision)};
+        for (auto& p : t.partitions) {
+            auto ntp = model::ntp(tp_ns.ns, tp_ns.tp, p.assignment.id);
+            auto update = _updates_in_progress.find(ntp);
+            if (
+              update == _updates_in_progress.end()
+              || update->second.state != in_progress_state::update_requested) {
+                deltas.emplace_back(
+                  std::move(ntp),
+                  p.assignment,
+                  min_revision(p.replica_revisions),
+                  delta::op_type::add,
+                  std::nullopt,
+                  p.replica_revisions);
+            } else {
+                // the partition is created with its previous replica set and
+                // moved, as the move command would do
+                auto previous = p.assignment;
+                previous.replicas = update->second.previous_replicas;
+                deltas.emplace_back(
+                  ntp,
+                  previous,
+                  min_revision(update->second.replicas_revisions),
+                  delta::op_type::add,
+                  std::nullopt,
+                  update->second.replicas_revisions);
+                deltas.emplace_back(
+                  std::move(ntp),
+                  p.assignment,
+                  model::offset(update->second.update_revision()),
+                  delta::op_type::update,
+                  update->second.previous_replicas,
+                  p.replica_revisions);
+            }
+            md.replica_revisions.emplace(
+              p.assignment.id, std::move(p.replica_revisions));
+        }
+        _topics.emplace(tp_ns, std::move(md));
+        _probe.handle_topic_creation(std::move(tp_ns));
+    }
+
+    // deltas are consumed in the order of the commands they derive from
+    std::stable_sort(
+      deltas.begin(), deltas.end(), [](const delta& a, const delta& b) {
+          return a.offset < b.offset;
+      });
+    std::move(deltas.begin(), deltas.end(), std::back_inserter(_pending_deltas));
+    vlog(
+      clusterlog.info,
+      "Restored {} topics and {} partition updates from controller snapshot "
+      "at offset {}",
+      _topics.size(),
+      _updates_in_progress.size(),
+      offset);
+    notify_waiters();
+}
+
 void topic_table::notify_waiters() {
+    ++_topics_version;
     /// If by invocation of this method there are no waiters, notify
     /// function_ptrs stored in \ref notifications, without consuming all
     /// pending_deltas for when a subsequent waiter does arrive
@@ -736,6 +927,14 @@ topic_table::get_topic_timestamp_type(model::topic_namespace_view tp) const {
     return {};
 }
 
+std::optional<model::compression>
+topic_table::get_topic_compression(model::topic_namespace_view tp) const {
+    if (auto it = _topics.find(tp); it != _topics.end()) {
+        return it->second.get_configuration().properties.compression;
+    }
+    return {};
+}
+
 const topic_table::underlying_t& topic_table::all_topics_metadata() const {
     return _topics;
 }
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "cluster/commands.h"
+#include "cluster/fwd.h"
 #include "cluster/non_replicable_topics_frontend.h"
 #include "cluster/topic_table_probe.h"
 #include "cluster/types.h"
@@ -59,7 +60,7 @@ public:
     struct topic_metadata_item {
         topic_metadata metadata;
         // replicas revisions for each partition
-        absl::node_hash_map<model::partition_id, replicas_revision_map>
+        absl::flat_hash_map<model::partition_id, replicas_revision_map>
           replica_revisions;
 
         bool is_topic_replicable() const {
@@ -158,6 +159,12 @@ public:
       apply(cancel_moving_partition_replicas_cmd, model::offset);
     ss::future<> stop();
 
+    /// Returns the error the command would be applied with, without applying
+    /// it. Allows applying a batch of commands all or nothing.
+    std::error_code check(const create_topic_cmd&) const;
+    std::error_code check(const delete_topic_cmd&) const;
+    std::error_code check(const update_topic_properties_cmd&) const;
+
     /// Delta API
     /// NOTE: This API should only be consumed by a single entity, unless
     /// careful consideration is taken. This is because once notifications are
@@ -169,6 +176,20 @@ public:
 
     bool has_pending_changes() const { return !_pending_deltas.empty(); }
 
+    /// Version of the table contents, it changes with every applied command.
+    /// Allows callers to cache values derived from the topics metadata.
+    uint64_t topics_version() const { return _topics_version; }
+
+    /// Snapshot API
+
+    controller_snapshot_parts::topics fill_snapshot() const;
+
+    /// Restores topics of a controller snapshot into an empty table. Deltas
+    /// are calculated as if the commands were applied, i.e. an add delta with
+    /// the replica revisions for every partition and an update delta for
+    /// every partition being moved.
+    void apply_snapshot(model::offset, controller_snapshot_parts::topics);
+
     /// Query API
 
     /// Returns list of all topics that exists in the cluster.
@@ -212,6 +233,10 @@ public:
     std::optional<model::timestamp_type>
       get_topic_timestamp_type(model::topic_namespace_view) const;
 
+    /// Returns topic compression type if set
+    std::optional<model::compression>
+      get_topic_compression(model::topic_namespace_view) const;
+
     /// Returns metadata of all topics.
     const underlying_t& all_topics_metadata() const;
 
@@ -300,6 +325,7 @@ private:
 
     std::vector<delta> _pending_deltas;
     std::vector<std::unique_ptr<waiter>> _waiters;
+    uint64_t _topics_version{0};
     cluster::notification_id_type _notification_id{0};
     std::vector<std::pair<cluster::notification_id_type, delta_cb_t>>
       _notifications;
@@ -11,12 +11,17 @@
 
 #include "cluster/cluster_utils.h"
 #include "cluster/commands.h"
+#include "cluster/controller_snapshot.h"
 #include "cluster/partition_leaders_table.h"
 #include "cluster/topic_table.h"
 #include "model/fundamental.h"
 #include "model/metadata.h"
 #include "raft/types.h"
+#include "serde/serde.h"
 
+#include <seastar/core/coroutine.hh>
+
+#include <absl/container/flat_hash_set.h>
 #include <absl/container/node_hash_map.h>
 
 #include <iterator>
@@ -35,6 +40,9 @@ topic_updates_dispatcher::topic_updates_dispatcher(
 
 ss::future<std::error_code>
 topic_updates_dispatcher::apply_update(model::record_batch b) {
+    if (b.record_count() > 1) {
+        return apply_batch_update(std::move(b));
+    }
     auto base_offset = b.base_offset();
     return deserialize(std::move(b), commands)
       .then([this, base_offset](auto cmd) {
@@ -201,6 +209,140 @@ topic_updates_dispatcher::apply_update(model::record_batch b) {
             });
       });
 }
+ss::future<std::error_code>
+topic_updates_dispatcher::apply_batch_update(model::record_batch b) {
+    auto base_offset = b.base_offset();
+    auto records = b.copy_records();
+    // the first command determines the type of the batch
+    auto first = co_await deserialize(std::move(records.front()), commands);
+    co_return co_await ss::visit(
+      std::move(first), [this, &records, base_offset](auto cmd) {
+          return apply_batch(std::move(cmd), std::move(records), base_offset);
+      });
+}
+
+template<typename Cmd>
+ss::future<std::error_code> topic_updates_dispatcher::apply_batch(
+  Cmd first, std::vector<model::record> records, model::offset base_offset) {
+    if constexpr (!BatchableTopicCommand<Cmd>) {
+        vlog(
+          clusterlog.error,
+          "Command type {} can not be applied in a batch, batch offset: {}",
+          static_cast<int>(Cmd::type()),
+          base_offset);
+        co_return errc::invalid_request;
+    } else {
+        std::vector<Cmd> cmds;
+        cmds.reserve(records.size());
+        cmds.push_back(std::move(first));
+        for (size_t i = 1; i < records.size(); ++i) {
+            auto cmd = co_await deserialize(std::move(records[i]), commands);
+            if (!std::holds_alternative<Cmd>(cmd)) {
+                vlog(
+                  clusterlog.error,
+                  "Batch at offset {} mixes command types",
+                  base_offset);
+                co_return errc::invalid_request;
+            }
+            cmds.push_back(std::get<Cmd>(std::move(cmd)));
+        }
+
+        // every node checks against the same state, so they all reject the
+        // same batches
+        absl::flat_hash_set<model::topic_namespace> keys;
+        keys.reserve(cmds.size());
+        for (const auto& cmd : cmds) {
+            auto ec = _topic_table.local().check(cmd);
+            if (ec != errc::success) {
+                co_return ec;
+            }
+            if (!keys.insert(cmd.key).second) {
+                co_return errc::invalid_request;
+            }
+        }
+
+        std::vector<std::pair<assignments_set, in_progress_map>> deleted;
+        if constexpr (std::is_same_v<Cmd, delete_topic_cmd>) {
+            deleted.reserve(cmds.size());
+            for (const auto& cmd : cmds) {
+                auto assignments = _topic_table.local().get_topic_assignments(
+                  cmd.value);
+                auto in_progress = collect_in_progress(cmd.key, *assignments);
+                deleted.emplace_back(
+                  std::move(*assignments), std::move(in_progress));
+            }
+        }
+
+        auto results = co_await dispatch_batch_to_cores(cmds, base_offset);
+
+        std::vector<ntp_leader> leaders;
+        for (size_t i = 0; i < cmds.size(); ++i) {
+            if (results[i] != errc::success) {
+                continue;
+            }
+            if constexpr (std::is_same_v<Cmd, create_topic_cmd>) {
+                const auto& tp_ns = cmds[i].value.cfg.tp_ns;
+                for (const auto& p_as : cmds[i].value.assignments) {
+                    leaders.emplace_back(
+                      model::ntp(tp_ns.ns, tp_ns.tp, p_as.id),
+                      p_as.replicas.begin()->node_id);
+                }
+                update_allocations(std::move(cmds[i].value.assignments));
+            } else if constexpr (std::is_same_v<Cmd, delete_topic_cmd>) {
+                deallocate_topic(deleted[i].first, deleted[i].second);
+            }
+        }
+        if (!leaders.empty()) {
+            co_await update_leaders_with_estimates(std::move(leaders));
+        }
+
+        auto failed = std::find_if(
+          results.begin(), results.end(), [](std::error_code ec) {
+              return ec != errc::success;
+          });
+        co_return failed == results.end() ? errc::success : *failed;
+    }
+}
+
+ss::future<iobuf> topic_updates_dispatcher::take_snapshot(model::offset) {
+    co_return serde::to_iobuf(_topic_table.local().fill_snapshot());
+}
+
+ss::future<>
+topic_updates_dispatcher::apply_snapshot(model::offset offset, iobuf buf) {
+    auto snap = serde::from_iobuf<controller_snapshot_parts::topics>(
+      std::move(buf));
+    co_await _topic_table.invoke_on_all([offset, &snap](topic_table& t) {
+        t.apply_snapshot(offset, snap);
+    });
+
+    std::vector<ntp_leader> leaders;
+    for (const auto& t : snap.topics) {
+        const auto& tp_ns = t.configuration.tp_ns;
+        std::vector<partition_assignment> assignments;
+        assignments.reserve(t.partitions.size());
+        for (const auto& p : t.partitions) {
+            assignments.push_back(p.assignment);
+            if (!t.source_topic && !p.assignment.replicas.empty()) {
+                leaders.emplace_back(
+                  model::ntp(tp_ns.ns, tp_ns.tp, p.assignment.id),
+                  p.assignment.replicas.begin()->node_id);
+            }
+        }
+        update_allocations(std::move(assignments));
+    }
+    // replicas of the previous replica sets are allocated until the partition
+    // update finishes
+    for (const auto& u : snap.updates) {
+        auto current = _topic_table.local().get_partition_assignment(u.ntp);
+        if (current) {
+            _partition_allocator.local().add_allocations(
+              subtract_replica_sets(u.previous_replicas, current->replicas));
+        }
+    }
+    co_await update_leaders_with_estimates(std::move(leaders));
+}
+
 topic_updates_dispatcher::in_progress_map
 topic_updates_dispatcher::collect_in_progress(
   const model::topic_namespace& tp_ns,
@@ -280,6 +422,38 @@ topic_updates_dispatcher::dispatch_updates_to_cores(Cmd cmd, model::offset o) {
       });
 }
 
+template<typename Cmd>
+static ss::future<std::vector<std::error_code>> apply_in_order(
+  topic_table& table, const std::vector<Cmd>& cmds, model::offset base_offset) {
+    std::vector<std::error_code> ret;
+    ret.reserve(cmds.size());
+    for (size_t i = 0; i < cmds.size(); ++i) {
+        // every command of the batch is applied at the offset of its record
+        ret.push_back(co_await table.apply(
+          cmds[i], base_offset + model::offset(static_cast<int64_t>(i))));
+    }
+    co_return ret;
+}
+
+template<typename Cmd>
+ss::future<std::vector<std::error_code>>
+topic_updates_dispatcher::dispatch_batch_to_cores(
+  const std::vector<Cmd>& cmds, model::offset base_offset) {
+    // a single round trip per core for the whole batch
+    auto results = co_await _topic_table.map(
+      [&cmds, base_offset](topic_table& table) {
+          return apply_in_order(table, cmds, base_offset);
+      });
+    for (const auto& r : results) {
+        vassert(
+          r == results.front(),
+          "State inconsistency across shards detected applying batch at "
+          "offset {}",
+          base_offset);
+    }
+    co_return std::move(results.front());
+}
+
 void topic_updates_dispatcher::deallocate_topic(
   const assignments_set& topic_assignments,
   const in_progress_map& in_progress) {
@@ -10,6 +10,7 @@
  */
 
 #pragma once
+#include "bytes/iobuf.h"
 #include "cluster/commands.h"
 #include "cluster/scheduling/partition_allocator.h"
 #include "cluster/topic_table.h"
@@ -21,6 +22,15 @@
 
 namespace cluster {
 
+/// Topic commands that can be replicated several in a single batch, see
+/// serde_serialize_cmds. A batch is applied all or nothing: if any of its
+/// commands would fail, none is applied and the batch fails with its error.
+template<typename Cmd>
+concept BatchableTopicCommand
+  = std::is_same_v<Cmd, create_topic_cmd>
+    || std::is_same_v<Cmd, delete_topic_cmd>
+    || std::is_same_v<Cmd, update_topic_properties_cmd>;
+
 // The topic updates dispatcher is responsible for receiving update_apply
 // upcalls from controller state machine and propagating updates to topic state
 // core local copies. The dispatcher handles partition_allocator updates. The
@@ -57,6 +67,9 @@ public:
 
     ss::future<std::error_code> apply_update(model::record_batch);
 
+    ss::future<iobuf> take_snapshot(model::offset);
+    ss::future<> apply_snapshot(model::offset, iobuf);
+
     static constexpr auto commands = make_commands_list<
       create_topic_cmd,
       delete_topic_cmd,
@@ -78,6 +91,14 @@ private:
     template<typename Cmd>
     ss::future<std::error_code> dispatch_updates_to_cores(Cmd, model::offset);
 
+    ss::future<std::error_code> apply_batch_update(model::record_batch);
+    template<typename Cmd>
+    ss::future<std::error_code>
+      apply_batch(Cmd, std::vector<model::record>, model::offset);
+    template<typename Cmd>
+    ss::future<std::vector<std::error_code>>
+    dispatch_batch_to_cores(const std::vector<Cmd>&, model::offset);
+
     using ntp_leader = std::pair<model::ntp, model::node_id>;
 
     ss::future<> update_leaders_with_estimates(std::vector<ntp_leader> leaders);
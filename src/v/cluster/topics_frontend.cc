@@ -38,6 +38,8 @@
 #include <seastar/core/future.hh>
 #include <seastar/core/loop.hh>
 
+#include <absl/container/flat_hash_set.h>
+
 #include <algorithm>
 #include <iterator>
 #include <regex>
@@ -94,6 +96,9 @@ ss::future<std::vector<topic_result>> topics_frontend::create_topics(
               return ss::make_ready_future<std::vector<topic_result>>(
                 create_topic_results(topics, errc::not_leader_controller));
           }
+          if (batch_commands_enabled(topics.size())) {
+              return create_topics_batched(std::move(topics), timeout);
+          }
           std::vector<ss::future<topic_result>> futures;
           futures.reserve(topics.size());
 
@@ -173,10 +178,17 @@ ss::future<std::vector<topic_result>> topics_frontend::update_topic_properties(
             co_return create_topic_results(updates, map_errc(result.error()));
         }
 
-        auto results = co_await ssx::parallel_transform(
-          std::move(updates), [this, timeout](topic_properties_update update) {
-              return do_update_topic_properties(std::move(update), timeout);
-          });
+        std::vector<topic_result> results;
+        if (batch_commands_enabled(updates.size())) {
+            results = co_await update_topic_properties_batched(
+              std::move(updates), timeout);
+        } else {
+            results = co_await ssx::parallel_transform(
+              std::move(updates),
+              [this, timeout](topic_properties_update update) {
+                  return do_update_topic_properties(std::move(update), timeout);
+              });
+        }
 
         // we are not really interested in the result coming from the
         // linearizable barrier, results coming from the previous steps will be
@@ -513,13 +525,11 @@ ss::future<topic_result> topics_frontend::do_create_topic(
       std::move(assignable_config.cfg), std::move(units.value()), timeout);
 }
 
-ss::future<topic_result> topics_frontend::replicate_create_topic(
-  topic_configuration cfg,
-  allocation_units units,
-  model::timeout_clock::time_point timeout) {
+static create_topic_cmd
+make_create_topic_cmd(topic_configuration cfg, const allocation_units& units) {
     auto tp_ns = cfg.tp_ns;
     create_topic_cmd cmd(
-      tp_ns,
+      std::move(tp_ns),
       topic_configuration_assignment(std::move(cfg), units.get_assignments()));
 
     for (auto& p_as : cmd.value.assignments) {
@@ -528,6 +538,15 @@ ss::future<topic_result> topics_frontend::replicate_create_topic(
           p_as.replicas.end(),
           random_generators::internal::gen);
     }
+    return cmd;
+}
+
+ss::future<topic_result> topics_frontend::replicate_create_topic(
+  topic_configuration cfg,
+  allocation_units units,
+  model::timeout_clock::time_point timeout) {
+    auto tp_ns = cfg.tp_ns;
+    auto cmd = make_create_topic_cmd(std::move(cfg), units);
 
     return replicate_and_wait(_stm, _features, _as, std::move(cmd), timeout)
       .then_wrapped([tp_ns = std::move(tp_ns), units = std::move(units)](
@@ -556,19 +575,25 @@ ss::future<std::vector<topic_result>> topics_frontend::delete_topics(
   model::timeout_clock::time_point timeout) {
     vlog(clusterlog.info, "Delete topics {}", topics);
 
-    std::vector<ss::future<topic_result>> futures;
-    futures.reserve(topics.size());
+    ss::future<std::vector<topic_result>> deleted = ss::make_ready_future<
+      std::vector<topic_result>>();
+    if (batch_commands_enabled(topics.size())) {
+        deleted = delete_topics_batched(std::move(topics), timeout);
+    } else {
+        std::vector<ss::future<topic_result>> futures;
+        futures.reserve(topics.size());
 
-    std::transform(
-      std::begin(topics),
-      std::end(topics),
-      std::back_inserter(futures),
-      [this, timeout](model::topic_namespace& tp_ns) {
-          return do_delete_topic(std::move(tp_ns), timeout);
-      });
+        std::transform(
+          std::begin(topics),
+          std::end(topics),
+          std::back_inserter(futures),
+          [this, timeout](model::topic_namespace& tp_ns) {
+              return do_delete_topic(std::move(tp_ns), timeout);
+          });
+        deleted = ss::when_all_succeed(futures.begin(), futures.end());
+    }
 
-    return ss::when_all_succeed(futures.begin(), futures.end())
-      .then([this, timeout](std::vector<topic_result> results) {
+    return deleted.then([this, timeout](std::vector<topic_result> results) {
           if (needs_linearizable_barrier(results)) {
               return stm_linearizable_barrier(timeout).then(
                 [results = std::move(results)](result<model::offset>) mutable {
@@ -603,6 +628,219 @@ ss::future<topic_result> topics_frontend::do_delete_topic(
         });
 }
 
+bool topics_frontend::batch_commands_enabled(size_t commands) const {
+    return commands > 1
+           && _features.local().is_active(feature::controller_batch_commands);
+}
+
+// errors a batch is rejected with, before any of its commands is applied
+static bool is_batch_rejection(std::error_code ec) {
+    if (ec.category() != cluster::error_category()) {
+        return false;
+    }
+    switch (static_cast<errc>(ec.value())) {
+    case errc::topic_already_exists:
+    case errc::topic_not_exists:
+    case errc::source_topic_still_in_use:
+    case errc::invalid_request:
+        return true;
+    default:
+        return false;
+    }
+}
+
+template<typename Cmd>
+ss::future<std::vector<std::error_code>> topics_frontend::replicate_batch(
+  std::vector<Cmd> cmds, model::timeout_clock::time_point timeout) {
+    std::error_code ec = errc::success;
+    try {
+        ec = co_await replicate_batch_and_wait(_stm, _as, cmds, timeout);
+    } catch (...) {
+        vlog(
+          clusterlog.warn,
+          "Unable to replicate batch of {} topic commands - {}",
+          cmds.size(),
+          std::current_exception());
+        ec = errc::replication_error;
+    }
+    if (!is_batch_rejection(ec)) {
+        co_return std::vector<std::error_code>(cmds.size(), ec);
+    }
+    // one of the commands fails, find out which
+    co_return co_await ssx::parallel_transform(
+      std::move(cmds), [this, timeout](Cmd cmd) {
+          return replicate_and_wait(
+                   _stm, _features, _as, std::move(cmd), timeout)
+            .handle_exception([](const std::exception_ptr& e) {
+                vlog(clusterlog.warn, "Unable to replicate command - {}", e);
+                return std::error_code(errc::replication_error);
+            });
+      });
+}
+
+template<typename Cmd>
+ss::future<std::vector<std::error_code>> topics_frontend::replicate_batched(
+  std::vector<Cmd> cmds, model::timeout_clock::time_point timeout) {
+    std::vector<ss::future<std::vector<std::error_code>>> batches;
+    batches.reserve(cmds.size() / max_batched_commands + 1);
+    for (size_t i = 0; i < cmds.size(); i += max_batched_commands) {
+        auto end = std::min(cmds.size(), i + max_batched_commands);
+        std::vector<Cmd> batch(
+          std::make_move_iterator(cmds.begin() + i),
+          std::make_move_iterator(cmds.begin() + end));
+        batches.push_back(replicate_batch(std::move(batch), timeout));
+    }
+    auto results = co_await ss::when_all_succeed(
+      batches.begin(), batches.end());
+
+    std::vector<std::error_code> ret;
+    ret.reserve(cmds.size());
+    for (auto& r : results) {
+        std::move(r.begin(), r.end(), std::back_inserter(ret));
+    }
+    co_return ret;
+}
+
+ss::future<std::vector<topic_result>> topics_frontend::create_topics_batched(
+  std::vector<custom_assignable_topic_configuration> topics,
+  model::timeout_clock::time_point timeout) {
+    std::vector<std::optional<topic_result>> results(topics.size());
+    // topics that download their configuration from the cloud storage first
+    std::vector<size_t> singles;
+    std::vector<ss::future<topic_result>> single_results;
+    std::vector<size_t> batched;
+    std::vector<const custom_assignable_topic_configuration*> to_allocate;
+
+    absl::flat_hash_set<model::topic_namespace> names;
+    for (size_t i = 0; i < topics.size(); ++i) {
+        auto& t = topics[i];
+        if (
+          t.is_read_replica() || t.is_recovery_enabled()
+          || !names.insert(t.cfg.tp_ns).second) {
+            singles.push_back(i);
+            single_results.push_back(do_create_topic(std::move(t), timeout));
+            continue;
+        }
+        auto ec = validate_topic_configuration(t);
+        if (ec != errc::success) {
+            results[i] = topic_result(t.cfg.tp_ns, ec);
+            continue;
+        }
+        batched.push_back(i);
+        to_allocate.push_back(&t);
+    }
+
+    // a single round trip to the allocator for all the topics, requests are
+    // made on the allocator shard as they hold shard local constraints
+    auto allocated = co_await _allocator.invoke_on(
+      partition_allocator::shard, [&to_allocate](partition_allocator& al) {
+          std::vector<result<allocation_units>> ret;
+          ret.reserve(to_allocate.size());
+          for (const auto* t : to_allocate) {
+              ret.push_back(al.allocate(make_allocation_request(*t)));
+          }
+          return ret;
+      });
+
+    std::vector<size_t> replicated;
+    std::vector<create_topic_cmd> cmds;
+    std::vector<allocation_units> units;
+    for (size_t j = 0; j < batched.size(); ++j) {
+        auto i = batched[j];
+        auto& cfg = topics[i].cfg;
+        if (!allocated[j]) {
+            results[i] = make_error_result(cfg.tp_ns, allocated[j].error());
+            continue;
+        }
+        replicated.push_back(i);
+        results[i] = topic_result(cfg.tp_ns);
+        cmds.push_back(
+          make_create_topic_cmd(std::move(cfg), allocated[j].value()));
+        units.push_back(std::move(allocated[j].value()));
+    }
+
+    // units are released once the commands are applied
+    auto ecs = co_await replicate_batched(std::move(cmds), timeout);
+    for (size_t j = 0; j < replicated.size(); ++j) {
+        results[replicated[j]]->ec = map_errc(ecs[j]);
+    }
+
+    auto others = co_await ss::when_all_succeed(
+      single_results.begin(), single_results.end());
+    for (size_t j = 0; j < singles.size(); ++j) {
+        results[singles[j]] = std::move(others[j]);
+    }
+
+    std::vector<topic_result> ret;
+    ret.reserve(results.size());
+    for (auto& r : results) {
+        ret.push_back(std::move(*r));
+    }
+    co_return ret;
+}
+
+ss::future<std::vector<topic_result>> topics_frontend::delete_topics_batched(
+  std::vector<model::topic_namespace> topics,
+  model::timeout_clock::time_point timeout) {
+    std::vector<delete_topic_cmd> cmds;
+    cmds.reserve(topics.size());
+    for (const auto& tp_ns : topics) {
+        cmds.emplace_back(tp_ns, tp_ns);
+    }
+    auto ecs = co_await replicate_batched(std::move(cmds), timeout);
+
+    std::vector<topic_result> results;
+    results.reserve(topics.size());
+    for (size_t i = 0; i < topics.size(); ++i) {
+        results.emplace_back(std::move(topics[i]), map_errc(ecs[i]));
+    }
+    co_return results;
+}
+
+ss::future<std::vector<topic_result>>
+topics_frontend::update_topic_properties_batched(
+  std::vector<topic_properties_update> updates,
+  model::timeout_clock::time_point timeout) {
+    std::vector<std::optional<topic_result>> results(updates.size());
+    // data policy updates go through their own frontend first
+    std::vector<size_t> singles;
+    std::vector<ss::future<topic_result>> single_results;
+    std::vector<size_t> batched;
+    std::vector<update_topic_properties_cmd> cmds;
+    for (size_t i = 0; i < updates.size(); ++i) {
+        auto& u = updates[i];
+        if (
+          u.custom_properties.data_policy.op
+          != incremental_update_operation::none) {
+            singles.push_back(i);
+            single_results.push_back(
+              do_update_topic_properties(std::move(u), timeout));
+            continue;
+        }
+        batched.push_back(i);
+        results[i] = topic_result(u.tp_ns);
+        cmds.emplace_back(u.tp_ns, std::move(u.properties));
+    }
+
+    auto ecs = co_await replicate_batched(std::move(cmds), timeout);
+    for (size_t j = 0; j < batched.size(); ++j) {
+        results[batched[j]]->ec = map_errc(ecs[j]);
+    }
+
+    auto others = co_await ss::when_all_succeed(
+      single_results.begin(), single_results.end());
+    for (size_t j = 0; j < singles.size(); ++j) {
+        results[singles[j]] = std::move(others[j]);
+    }
+
+    std::vector<topic_result> ret;
+    ret.reserve(results.size());
+    for (auto& r : results) {
+        ret.push_back(std::move(*r));
+    }
+    co_return ret;
+}
+
 ss::future<std::vector<topic_result>> topics_frontend::autocreate_topics(
   std::vector<topic_configuration> topics,
   model::timeout_clock::duration timeout) {
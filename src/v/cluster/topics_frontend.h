@@ -120,6 +120,29 @@ public:
 private:
     using ntp_leader = std::pair<model::ntp, model::node_id>;
 
+    // upper bound of the commands replicated in a single controller batch
+    static constexpr size_t max_batched_commands = 128;
+
+    bool batch_commands_enabled(size_t) const;
+
+    /// Replicates the commands in controller batches and returns the result
+    /// of every command. The commands of a batch that is rejected as a whole
+    /// are retried one by one, so that each gets its own result.
+    template<typename Cmd>
+    ss::future<std::vector<std::error_code>>
+      replicate_batched(std::vector<Cmd>, model::timeout_clock::time_point);
+    template<typename Cmd>
+    ss::future<std::vector<std::error_code>>
+      replicate_batch(std::vector<Cmd>, model::timeout_clock::time_point);
+
+    ss::future<std::vector<topic_result>> create_topics_batched(
+      std::vector<custom_assignable_topic_configuration>,
+      model::timeout_clock::time_point);
+    ss::future<std::vector<topic_result>> delete_topics_batched(
+      std::vector<model::topic_namespace>, model::timeout_clock::time_point);
+    ss::future<std::vector<topic_result>> update_topic_properties_batched(
+      std::vector<topic_properties_update>, model::timeout_clock::time_point);
+
     ss::future<topic_result> do_create_topic(
       custom_assignable_topic_configuration, model::timeout_clock::time_point);
 
@@ -28,6 +28,9 @@
 #include "types.h"
 
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
+
+#include <boost/range/irange.hpp>
 
 #include <algorithm>
 
@@ -69,6 +72,23 @@ static auto with(
       });
 }
 
+// sends a commit or abort marker to each of the partitions of a transaction
+// keeping at most tm_marker_fanout_concurrency requests in flight
+template<typename Reply, typename Func>
+static ss::future<std::vector<Reply>> fan_out_markers(
+  const std::vector<tm_transaction::tx_partition>& partitions, Func func) {
+    std::vector<Reply> replies(partitions.size());
+    co_await ss::max_concurrent_for_each(
+      boost::irange<size_t>(0, partitions.size()),
+      config::shard_local_cfg().tm_marker_fanout_concurrency(),
+      [&partitions, &replies, &func](size_t idx) {
+          return func(partitions[idx]).then([&replies, idx](Reply r) {
+              replies[idx] = std::move(r);
+          });
+      });
+    co_return replies;
+}
+
 static add_paritions_tx_reply make_add_partitions_error_response(
   add_paritions_tx_request request, tx_errc ec) {
     add_paritions_tx_reply response;
@@ -1461,17 +1481,16 @@ tx_gateway_frontend::do_abort_tm_tx(
         tx = changed_tx.value();
     }
 
-    std::vector<ss::future<abort_tx_reply>> pfs;
-    for (auto rm : tx.partitions) {
-        pfs.push_back(_rm_partition_frontend.local().abort_tx(
-          rm.ntp, tx.pid, tx.tx_seq, timeout));
-    }
     std::vector<ss::future<abort_group_tx_reply>> gfs;
     for (auto group : tx.groups) {
         gfs.push_back(_rm_group_proxy->abort_group_tx(
           group.group_id, tx.pid, tx.tx_seq, timeout));
     }
-    auto prs = co_await when_all_succeed(pfs.begin(), pfs.end());
+    auto prs = co_await fan_out_markers<abort_tx_reply>(
+      tx.partitions, [this, &tx, timeout](const auto& rm) {
+          return _rm_partition_frontend.local().abort_tx(
+            rm.ntp, tx.pid, tx.tx_seq, timeout);
+      });
     auto grs = co_await when_all_succeed(gfs.begin(), gfs.end());
     bool ok = true;
     for (const auto& r : prs) {
@@ -1594,18 +1613,18 @@ tx_gateway_frontend::do_commit_tm_tx(
         gfs.push_back(_rm_group_proxy->commit_group_tx(
           group.group_id, tx.pid, tx.tx_seq, timeout));
     }
-    std::vector<ss::future<commit_tx_reply>> cfs;
-    for (auto rm : tx.partitions) {
-        cfs.push_back(_rm_partition_frontend.local().commit_tx(
-          rm.ntp, tx.pid, tx.tx_seq, timeout));
-    }
     auto ok = true;
-    auto grs = co_await when_all_succeed(gfs.begin(), gfs.end());
-    for (const auto& r : grs) {
+    // the group markers are in flight while the partition markers fan out
+    auto crs = co_await fan_out_markers<commit_tx_reply>(
+      tx.partitions, [this, &tx, timeout](const auto& rm) {
+          return _rm_partition_frontend.local().commit_tx(
+            rm.ntp, tx.pid, tx.tx_seq, timeout);
+      });
+    for (const auto& r : crs) {
         ok = ok && (r.ec == tx_errc::none);
     }
-    auto crs = co_await when_all_succeed(cfs.begin(), cfs.end());
-    for (const auto& r : crs) {
+    auto grs = co_await when_all_succeed(gfs.begin(), gfs.end());
+    for (const auto& r : grs) {
         ok = ok && (r.ec == tx_errc::none);
     }
     if (!ok) {
@@ -1621,19 +1640,18 @@ ss::future<tx_errc> tx_gateway_frontend::recommit_tm_tx(
         gfs.push_back(_rm_group_proxy->commit_group_tx(
           group.group_id, tx.pid, tx.tx_seq, timeout));
     }
-    std::vector<ss::future<commit_tx_reply>> cfs;
-    for (auto rm : tx.partitions) {
-        cfs.push_back(_rm_partition_frontend.local().commit_tx(
-          rm.ntp, tx.pid, tx.tx_seq, timeout));
-    }
 
     auto ok = true;
-    auto grs = co_await when_all_succeed(gfs.begin(), gfs.end());
-    for (const auto& r : grs) {
+    auto crs = co_await fan_out_markers<commit_tx_reply>(
+      tx.partitions, [this, &tx, timeout](const auto& rm) {
+          return _rm_partition_frontend.local().commit_tx(
+            rm.ntp, tx.pid, tx.tx_seq, timeout);
+      });
+    for (const auto& r : crs) {
         ok = ok && (r.ec == tx_errc::none);
     }
-    auto crs = co_await when_all_succeed(cfs.begin(), cfs.end());
-    for (const auto& r : crs) {
+    auto grs = co_await when_all_succeed(gfs.begin(), gfs.end());
+    for (const auto& r : grs) {
         ok = ok && (r.ec == tx_errc::none);
     }
     if (!ok) {
@@ -1644,17 +1662,16 @@ ss::future<tx_errc> tx_gateway_frontend::recommit_tm_tx(
 
 ss::future<tx_errc> tx_gateway_frontend::reabort_tm_tx(
   tm_transaction tx, model::timeout_clock::duration timeout) {
-    std::vector<ss::future<abort_tx_reply>> pfs;
-    for (auto rm : tx.partitions) {
-        pfs.push_back(_rm_partition_frontend.local().abort_tx(
-          rm.ntp, tx.pid, tx.tx_seq, timeout));
-    }
     std::vector<ss::future<abort_group_tx_reply>> gfs;
     for (auto group : tx.groups) {
         gfs.push_back(_rm_group_proxy->abort_group_tx(
           group.group_id, tx.pid, tx.tx_seq, timeout));
     }
-    auto prs = co_await when_all_succeed(pfs.begin(), pfs.end());
+    auto prs = co_await fan_out_markers<abort_tx_reply>(
+      tx.partitions, [this, &tx, timeout](const auto& rm) {
+          return _rm_partition_frontend.local().abort_tx(
+            rm.ntp, tx.pid, tx.tx_seq, timeout);
+      });
     auto grs = co_await when_all_succeed(gfs.begin(), gfs.end());
     auto ok = true;
     for (const auto& r : prs) {
@@ -56,7 +56,7 @@ bool topic_properties::has_overrides() const {
            || retention_bytes.has_value() || retention_bytes.is_disabled()
            || retention_duration.has_value() || retention_duration.is_disabled()
            || recovery.has_value() || shadow_indexing.has_value()
-           || read_replica.has_value();
+           || read_replica.has_value() || write_caching.has_value();
 }
 
 storage::ntp_config::default_overrides
@@ -71,6 +71,7 @@ topic_properties::get_ntp_cfg_overrides() const {
                                  ? *shadow_indexing
                                  : model::shadow_indexing_mode::disabled;
     ret.read_replica = read_replica;
+    ret.write_caching = write_caching;
     return ret;
 }
 
@@ -98,7 +99,8 @@ storage::ntp_config topic_configuration::make_ntp_config(
             .shadow_indexing_mode = properties.shadow_indexing
                                       ? *properties.shadow_indexing
                                       : model::shadow_indexing_mode::disabled,
-            .read_replica = properties.read_replica});
+            .read_replica = properties.read_replica,
+            .write_caching = properties.write_caching});
     }
     return {
       model::ntp(tp_ns.ns, tp_ns.tp, p_id),
@@ -207,7 +209,8 @@ std::ostream& operator<<(std::ostream& o, const topic_properties& properties) {
       "{}, retention_bytes: {}, retention_duration_ms: {}, segment_size: "
       "{}, "
       "timestamp_type: {}, recovery_enabled: {}, shadow_indexing: {}, "
-      "read_replica: {}, read_replica_bucket: {} remote_topic_properties: {}}}",
+      "read_replica: {}, read_replica_bucket: {} remote_topic_properties: {}, "
+      "write_caching: {}}}",
       properties.compression,
       properties.cleanup_policy_bitflags,
       properties.compaction_strategy,
@@ -219,7 +222,8 @@ std::ostream& operator<<(std::ostream& o, const topic_properties& properties) {
       properties.shadow_indexing,
       properties.read_replica,
       properties.read_replica_bucket,
-      properties.remote_topic_properties);
+      properties.remote_topic_properties,
+      properties.write_caching);
 
     return o;
 }
@@ -463,7 +467,7 @@ std::ostream& operator<<(std::ostream& o, const incremental_topic_updates& i) {
       "{{incremental_topic_custom_updates: compression: {} "
       "cleanup_policy_bitflags: {} compaction_strategy: {} timestamp_type: {} "
       "segment_size: {} retention_bytes: {} retention_duration: {} "
-      "shadow_indexing: {}}}",
+      "shadow_indexing: {} write_caching: {}}}",
       i.compression,
       i.cleanup_policy_bitflags,
       i.compaction_strategy,
@@ -471,7 +475,8 @@ std::ostream& operator<<(std::ostream& o, const incremental_topic_updates& i) {
       i.segment_size,
       i.retention_bytes,
       i.retention_duration,
-      i.shadow_indexing);
+      i.shadow_indexing,
+      i.write_caching);
     return o;
 }
 
@@ -35,8 +35,10 @@
 #include <absl/container/btree_set.h>
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <optional>
+#include <vector>
 
 namespace cluster {
 using consensus_ptr = ss::lw_shared_ptr<raft::consensus>;
@@ -94,6 +96,50 @@ struct allocate_id_reply
     auto serde_fields() { return std::tie(id, ec); }
 };
 
+/// \brief requests a range of up to `count` consecutive ids, the leader may
+/// return a shorter range
+struct allocate_id_range_request
+  : serde::envelope<allocate_id_range_request, serde::version<0>> {
+    using rpc_adl_exempt = std::true_type;
+
+    int64_t count{0};
+    model::timeout_clock::duration timeout{};
+
+    friend bool operator==(
+      const allocate_id_range_request&, const allocate_id_range_request&)
+      = default;
+
+    friend std::ostream&
+    operator<<(std::ostream& o, const allocate_id_range_request& req) {
+        fmt::print(o, "count: {}, timeout: {}", req.count, req.timeout.count());
+        return o;
+    }
+
+    auto serde_fields() { return std::tie(count, timeout); }
+};
+
+/// \brief the allocated ids are [id, id + count)
+struct allocate_id_range_reply
+  : serde::envelope<allocate_id_range_reply, serde::version<0>> {
+    using rpc_adl_exempt = std::true_type;
+
+    int64_t id{0};
+    int64_t count{0};
+    errc ec{errc::success};
+
+    friend bool
+    operator==(const allocate_id_range_reply&, const allocate_id_range_reply&)
+      = default;
+
+    friend std::ostream&
+    operator<<(std::ostream& o, const allocate_id_range_reply& rep) {
+        fmt::print(o, "id: {}, count: {}, ec: {}", rep.id, rep.count, rep.ec);
+        return o;
+    }
+
+    auto serde_fields() { return std::tie(id, count, ec); }
+};
+
 enum class tx_errc {
     none = 0,
     leader_not_found,
@@ -886,27 +932,6 @@ struct join_node_request
     auto serde_fields() { return std::tie(logical_version, node_uuid, node); }
 };
 
-struct join_node_reply : serde::envelope<join_node_reply, serde::version<0>> {
-    bool success{false};
-    model::node_id id{-1};
-
-    join_node_reply() noexcept = default;
-
-    join_node_reply(bool success, model::node_id id)
-      : success(success)
-      , id(id) {}
-
-    friend bool operator==(const join_node_reply&, const join_node_reply&)
-      = default;
-
-    friend std::ostream& operator<<(std::ostream& o, const join_node_reply& r) {
-        fmt::print(o, "success {} id {}", r.success, r.id);
-        return o;
-    }
-
-    auto serde_fields() { return std::tie(success, id); }
-};
-
 struct configuration_update_request
   : serde::envelope<configuration_update_request, serde::version<0>> {
     configuration_update_request() noexcept = default;
@@ -1009,7 +1034,7 @@ struct remote_topic_properties
  */
 struct topic_properties
   : serde::
-      envelope<topic_properties, serde::version<1>, serde::compat_version<0>> {
+      envelope<topic_properties, serde::version<2>, serde::compat_version<0>> {
     topic_properties() noexcept = default;
     topic_properties(
       std::optional<model::compression> compression,
@@ -1049,6 +1074,8 @@ struct topic_properties
     std::optional<bool> read_replica;
     std::optional<ss::sstring> read_replica_bucket;
     std::optional<remote_topic_properties> remote_topic_properties;
+    // introduced in version 2, not part of the frozen adl encoding
+    std::optional<bool> write_caching;
 
     bool is_compacted() const;
     bool has_overrides() const;
@@ -1069,7 +1096,8 @@ struct topic_properties
           shadow_indexing,
           read_replica,
           read_replica_bucket,
-          remote_topic_properties);
+          remote_topic_properties,
+          write_caching);
     }
 
     friend bool operator==(const topic_properties&, const topic_properties&)
@@ -1149,7 +1177,7 @@ struct property_update<tristate<T>>
 };
 
 struct incremental_topic_updates
-  : serde::envelope<incremental_topic_updates, serde::version<0>> {
+  : serde::envelope<incremental_topic_updates, serde::version<1>> {
     static constexpr int8_t version_with_data_policy = -1;
     static constexpr int8_t version_with_shadow_indexing = -3;
     // negative version indicating different format:
@@ -1167,6 +1195,8 @@ struct incremental_topic_updates
     property_update<tristate<size_t>> retention_bytes;
     property_update<tristate<std::chrono::milliseconds>> retention_duration;
     property_update<std::optional<model::shadow_indexing_mode>> shadow_indexing;
+    // serde only, introduced in version 1
+    property_update<std::optional<bool>> write_caching;
 
     auto serde_fields() {
         return std::tie(
@@ -1177,7 +1207,8 @@ struct incremental_topic_updates
           segment_size,
           retention_bytes,
           retention_duration,
-          shadow_indexing);
+          shadow_indexing,
+          write_caching);
     }
 
     friend std::ostream&
@@ -1820,6 +1851,42 @@ struct cluster_property_kv
     friend std::ostream& operator<<(std::ostream&, const cluster_property_kv&);
 };
 
+struct join_node_reply
+  : serde::
+      envelope<join_node_reply, serde::version<1>, serde::compat_version<0>> {
+    bool success{false};
+    model::node_id id{-1};
+
+    // Cluster configuration of the controller leader when the node joined.
+    // The joining node applies it right away instead of waiting for its
+    // controller log to catch up to the configuration deltas.
+    config_version cluster_config_version{config_version_unset};
+    std::vector<cluster_property_kv> cluster_config;
+
+    join_node_reply() noexcept = default;
+
+    join_node_reply(bool success, model::node_id id)
+      : success(success)
+      , id(id) {}
+
+    friend bool operator==(const join_node_reply&, const join_node_reply&)
+      = default;
+
+    friend std::ostream& operator<<(std::ostream& o, const join_node_reply& r) {
+        fmt::print(
+          o,
+          "success {} id {} cluster_config_version {}",
+          r.success,
+          r.id,
+          r.cluster_config_version);
+        return o;
+    }
+
+    auto serde_fields() {
+        return std::tie(success, id, cluster_config_version, cluster_config);
+    }
+};
+
 struct cluster_config_delta_cmd_data
   : serde::envelope<cluster_config_delta_cmd_data, serde::version<0>> {
     static constexpr int8_t current_version = 0;
@@ -2358,8 +2425,79 @@ struct partition_assignment_cmp {
     }
 };
 
-using assignments_set
-  = absl::btree_set<partition_assignment, partition_assignment_cmp>;
+/**
+ * Assignments of the partitions of a topic ordered by partition id.
+ *
+ * Partition ids of a topic are dense, partitions can only be added at the end,
+ * so the assignments are stored in a vector and a partition is normally found
+ * at the index of its id without any search. The binary search is only a
+ * fallback for sets that are not dense, e.g. a subset of the partitions.
+ */
+class assignments_set {
+public:
+    using value_type = partition_assignment;
+    using container_t = std::vector<partition_assignment>;
+    using iterator = container_t::iterator;
+    using const_iterator = container_t::const_iterator;
+
+    iterator begin() { return _assignments.begin(); }
+    iterator end() { return _assignments.end(); }
+    const_iterator begin() const { return _assignments.begin(); }
+    const_iterator end() const { return _assignments.end(); }
+    const_iterator cbegin() const { return _assignments.cbegin(); }
+    const_iterator cend() const { return _assignments.cend(); }
+
+    size_t size() const { return _assignments.size(); }
+    bool empty() const { return _assignments.empty(); }
+    void reserve(size_t n) { _assignments.reserve(n); }
+
+    iterator find(model::partition_id id) {
+        return begin() + index_of(id);
+    }
+    const_iterator find(model::partition_id id) const {
+        return begin() + index_of(id);
+    }
+    bool contains(model::partition_id id) const {
+        return index_of(id) != _assignments.size();
+    }
+
+    /// Inserts the assignment unless the partition is already present
+    std::pair<iterator, bool> emplace(partition_assignment p_as) {
+        if (_assignments.empty() || _assignments.back().id < p_as.id) {
+            _assignments.push_back(std::move(p_as));
+            return {std::prev(end()), true};
+        }
+        auto it = std::lower_bound(
+          begin(), end(), p_as.id, partition_assignment_cmp{});
+        if (it != end() && it->id == p_as.id) {
+            return {it, false};
+        }
+        return {_assignments.insert(it, std::move(p_as)), true};
+    }
+
+    friend bool operator==(const assignments_set&, const assignments_set&)
+      = default;
+
+private:
+    size_t index_of(model::partition_id id) const {
+        if (
+          id() >= 0 && static_cast<size_t>(id()) < _assignments.size()
+          && _assignments[id()].id == id) {
+            return id();
+        }
+        auto it = std::lower_bound(
+          _assignments.begin(),
+          _assignments.end(),
+          id,
+          partition_assignment_cmp{});
+        if (it != _assignments.end() && it->id == id) {
+            return std::distance(_assignments.begin(), it);
+        }
+        return _assignments.size();
+    }
+
+    container_t _assignments;
+};
 
 class topic_metadata {
 public:
@@ -160,10 +160,14 @@ GEN_COMPAT_CHECK(
   {
       json_write(success);
       json_write(id);
+      json_write(cluster_config_version);
+      json_write(cluster_config);
   },
   {
       json_read(success);
       json_read(id);
+      json_read(cluster_config_version);
+      json_read(cluster_config);
   })
 
 GEN_COMPAT_CHECK(
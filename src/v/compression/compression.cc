@@ -53,4 +53,29 @@ iobuf compressor::uncompress(const iobuf& io, type t) {
     }
 }
 
+void compressor::uncompress_chunked(
+  const iobuf& io, type t, const chunk_consumer& consumer) {
+    if (io.empty()) {
+        throw std::runtime_error(
+          fmt::format("Asked to decomrpess:{} an empty buffer:{}", (int)t, io));
+    }
+    switch (t) {
+    case type::none:
+        throw std::runtime_error(
+          "compressor: nothing to uncompress for 'none'");
+    case type::gzip:
+        return internal::gzip_compressor::uncompress_chunked(io, consumer);
+    case type::snappy:
+        return internal::snappy_java_compressor::uncompress_chunked(
+          io, consumer);
+    case type::lz4:
+        return internal::lz4_frame_compressor::uncompress_chunked(
+          io, consumer);
+    case type::zstd:
+        return internal::zstd_compressor::uncompress_chunked(io, consumer);
+    default:
+        vassert(false, "Cannot uncompress type {}", t);
+    }
+}
+
 } // namespace compression
@@ -12,15 +12,24 @@
 #pragma once
 #include "bytes/iobuf.h"
 #include "model/compression.h"
+
+#include <seastar/util/noncopyable_function.hh>
+
 namespace compression {
 
 using type = model::compression;
+/// Receives consecutive pieces of an uncompressed payload, the memory is only
+/// valid for the duration of the call
+using chunk_consumer = ss::noncopyable_function<void(const char*, size_t)>;
 // a very simple compressor. Exposes virtually no knobs and uses
 // the defaults for all compressors. In the future, we can make these
 // a virtual interface so we can instantiate them
 struct compressor {
     static iobuf compress(const iobuf&, type);
     static iobuf uncompress(const iobuf&, type);
+    /// Uncompresses into a bounded buffer that is handed to the consumer each
+    /// time it fills up, the payload is never uncompressed as a whole.
+    static void uncompress_chunked(const iobuf&, type, const chunk_consumer&);
 };
 
 } // namespace compression
@@ -10,12 +10,15 @@
 #include "compression/internal/gzip_compressor.h"
 
 #include "bytes/bytes.h"
+#include "compression/internal/output_buffer.h"
+#include "units.h"
 #include "vassert.h"
 
 #include <seastar/core/temporary_buffer.hh>
 
 #include <fmt/core.h>
 
+#include <array>
 #include <zlib.h>
 
 namespace compression::internal {
@@ -76,9 +79,7 @@ private:
 };
 class gzip_decompression_codec {
 public:
-    gzip_decompression_codec(const char* src, size_t src_size) noexcept
-      : _input(src)
-      , _input_size(src_size) {}
+    gzip_decompression_codec() noexcept = default;
     gzip_decompression_codec(const gzip_decompression_codec&) = delete;
     gzip_decompression_codec& operator=(const gzip_decompression_codec&)
       = delete;
@@ -89,21 +90,15 @@ public:
     void reset() {
         vassert(!_init, "Double initialized gzip decompression codec");
         _stream = default_zstream();
-        // zlib is not const-correct
-        // NOLINTNEXTLINE
-        _stream.next_in = (unsigned char*)_input;
-        _stream.avail_in = _input_size;
+        // 32: detect the gzip header
         throw_if_zstream_error(
           "gzip error with inflateInit2:{}", inflateInit2(&_stream, 15 + 32));
-        // marking init must happen before gzip header
         _init = true;
-
-        // last
-        throw_if_zstream_error(
-          "gzip inflateGetHeader error:{}", inflateGetHeader(&_stream, &_hdr));
     }
 
-    void inflate_to(char* output, size_t out_size);
+    /// Inflates the whole input into the output in a single pass
+    template<typename Output>
+    void inflate_to(const iobuf& input, Output& out);
 
     ~gzip_decompression_codec() {
         if (_init) {
@@ -112,14 +107,11 @@ public:
         }
     }
 
-    z_stream& stream() { return _stream; }
-    gz_header& header() { return _hdr; }
-
 private:
+    template<typename Output>
+    int inflate_step(Output& out);
+
     bool _init{false};
-    const char* _input;
-    size_t _input_size;
-    gz_header _hdr; // needed for gzip
     z_stream _stream;
 };
 
@@ -160,63 +152,117 @@ iobuf gzip_compressor::compress(const iobuf& b) {
     return ret;
 }
 
-void gzip_decompression_codec::inflate_to(char* output, size_t out_size) {
-    size_t consumed_bytes = 0;
-    int code = 0;
+template<typename Output>
+int gzip_decompression_codec::inflate_step(Output& out) {
+    char* dst = out.write_position();
+    const size_t available = out.available();
     // NOLINTNEXTLINE
-    auto out = reinterpret_cast<unsigned char*>(output);
-    do {
+    _stream.next_out = reinterpret_cast<unsigned char*>(dst);
+    _stream.avail_out = available;
+    const int code = inflate(&_stream, Z_NO_FLUSH);
+    switch (code) {
+    case Z_STREAM_ERROR:
+    case Z_NEED_DICT:
+    case Z_DATA_ERROR:
+    case Z_MEM_ERROR:
+        throw_zstream_error("gzip uncmpress error:{}", code);
+    default: /*do nothing*/;
+    }
+    out.commit(available - _stream.avail_out);
+    return code;
+}
+
+template<typename Output>
+void gzip_decompression_codec::inflate_to(const iobuf& input, Output& out) {
+    int code = Z_OK;
+    for (auto& frag : input) {
+        // zlib is not const correct
         // NOLINTNEXTLINE
-        _stream.next_out = out + consumed_bytes;
-        _stream.avail_out = out_size - consumed_bytes;
-        code = inflate(&_stream, Z_NO_FLUSH);
-        switch (code) {
-        case Z_STREAM_ERROR:
-        case Z_NEED_DICT:
-        case Z_DATA_ERROR:
-        case Z_MEM_ERROR:
-            throw_zstream_error("gzip uncmpress error:{}", code);
-        default: /*do nothing*/;
+        _stream.next_in = (unsigned char*)frag.get();
+        _stream.avail_in = frag.size();
+        while (_stream.avail_in > 0 && code != Z_STREAM_END) {
+            code = inflate_step(out);
         }
-        /* Advance output pointer (in pass 2). */
-        consumed_bytes = out_size - _stream.avail_out - consumed_bytes;
-    } while (_stream.avail_out == 0 && code != Z_STREAM_END);
+        if (code == Z_STREAM_END) {
+            return;
+        }
+    }
+    // all the input is consumed, drain the output held by the stream
+    while (code != Z_STREAM_END) {
+        code = inflate_step(out);
+        if (code == Z_BUF_ERROR) {
+            throw std::runtime_error(fmt::format(
+              "gzip error: truncated input of {} bytes", input.size_bytes()));
+        }
+    }
 }
 
-static ss::temporary_buffer<char>
-buffer_for_input(const char* src, size_t src_size) {
-    auto codec = gzip_decompression_codec(src, src_size);
+/// The trailer of a gzip member records its uncompressed size modulo 2^32, a
+/// hint of the size of single member payloads
+static size_t uncompressed_size_hint(const iobuf& b) {
+    // header and trailer of an empty member
+    static constexpr size_t min_member_size = 18;
+    static constexpr size_t isize_bytes = 4;
+    if (b.size_bytes() < min_member_size) {
+        return 0;
+    }
+    std::array<uint8_t, isize_bytes> isize{};
+    auto in = iobuf::iterator_consumer(b.cbegin(), b.cend());
+    in.skip(b.size_bytes() - isize_bytes);
+    in.consume_to(isize_bytes, isize.data());
+    return static_cast<size_t>(isize[0]) | static_cast<size_t>(isize[1]) << 8U
+           | static_cast<size_t>(isize[2]) << 16U
+           | static_cast<size_t>(isize[3]) << 24U;
+}
+
+iobuf gzip_compressor::uncompress(const iobuf& b) {
+    output_buffer out(uncompressed_size_hint(b));
+    gzip_decompression_codec codec;
     codec.reset();
-    std::array<char, 512> dummy_buf{};
-    // find gzip header
-    codec.inflate_to(dummy_buf.data(), dummy_buf.size());
-    return ss::temporary_buffer<char>(codec.stream().total_out);
+    codec.inflate_to(b, out);
+    return std::move(out).release();
 }
 
-static iobuf do_uncompress(const char* src, size_t src_size) {
-    ss::temporary_buffer<char> buf;
-    {
-        auto codec = gzip_decompression_codec(src, src_size);
-        codec.reset();
-        buf = buffer_for_input(src, src_size);
-        // main data decompression
-        codec.inflate_to(buf.get_write(), buf.size());
+namespace {
+/// Hands a bounded buffer to the consumer every time it fills up
+class chunk_output {
+public:
+    static constexpr size_t chunk_size = 64_KiB;
+
+    explicit chunk_output(const chunk_consumer& consumer)
+      : _buf(chunk_size)
+      , _consumer(consumer) {}
+
+    char* write_position() {
+        if (_filled == _buf.size()) {
+            flush();
+        }
+        // NOLINTNEXTLINE
+        return _buf.get_write() + _filled;
     }
-    iobuf ret;
-    ret.append(std::move(buf));
-    return ret;
-}
+    size_t available() const { return _buf.size() - _filled; }
+    void commit(size_t n) { _filled += n; }
 
-iobuf gzip_compressor::uncompress(const iobuf& b) {
-    if (std::distance(b.begin(), b.end()) == 1) {
-        return do_uncompress(b.begin()->get(), b.size_bytes());
+    void flush() {
+        if (_filled > 0) {
+            _consumer(_buf.get(), _filled);
+            _filled = 0;
+        }
     }
-    // linearize buffer
-    // TODO: use streaming interface instead
-    auto linearized = iobuf_to_bytes(b);
-    return do_uncompress(
-      // NOLINTNEXTLINE
-      reinterpret_cast<const char*>(linearized.data()),
-      linearized.size());
+
+private:
+    ss::temporary_buffer<char> _buf;
+    size_t _filled{0};
+    const chunk_consumer& _consumer;
+};
+} // namespace
+
+void gzip_compressor::uncompress_chunked(
+  const iobuf& b, const chunk_consumer& consumer) {
+    chunk_output out(consumer);
+    gzip_decompression_codec codec;
+    codec.reset();
+    codec.inflate_to(b, out);
+    out.flush();
 }
 } // namespace compression::internal
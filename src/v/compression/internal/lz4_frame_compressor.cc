@@ -10,6 +10,7 @@
 #include "compression/internal/lz4_frame_compressor.h"
 
 #include "bytes/bytes.h"
+#include "compression/internal/output_buffer.h"
 #include "compression/logger.h"
 #include "static_deleter_fn.h"
 #include "units.h"
@@ -18,6 +19,7 @@
 
 #include <seastar/core/temporary_buffer.hh>
 
+#include <array>
 #include <lz4.h>
 #include <lz4frame.h>
 
@@ -67,9 +69,25 @@ static lz4_decompression_ctx make_decompression_context() {
     return lz4_decompression_ctx(c);
 }
 
+/*
+ * The contexts are created once per shard. A compression context is
+ * reinitialized by LZ4F_compressBegin, a decompression context is reset
+ * before every use since a failed decompression leaves it mid-frame.
+ */
+static LZ4F_cctx* compression_context() {
+    static thread_local lz4_compression_ctx ctx = make_compression_context();
+    return ctx.get();
+}
+
+static LZ4F_dctx* decompression_context() {
+    static thread_local lz4_decompression_ctx ctx
+      = make_decompression_context();
+    LZ4F_resetDecompressionContext(ctx.get());
+    return ctx.get();
+}
+
 iobuf lz4_frame_compressor::compress(const iobuf& b) {
-    auto ctx_ptr = make_compression_context();
-    LZ4F_compressionContext_t ctx = ctx_ptr.get();
+    LZ4F_compressionContext_t ctx = compression_context();
     /* Required by Kafka */
     LZ4F_preferences_t prefs;
     std::memset(&prefs, 0, sizeof(prefs));
@@ -121,96 +139,110 @@ compute_frame_uncompressed_size(size_t frame_size, size_t original) {
     return frame_size;
 }
 
-static iobuf do_uncompressed(const char* src, const size_t src_size) {
-    auto ctx_ptr = make_decompression_context();
-    LZ4F_decompressionContext_t ctx = ctx_ptr.get();
+iobuf lz4_frame_compressor::uncompress(const iobuf& b) {
+    LZ4F_decompressionContext_t ctx = decompression_context();
+    // the frame header is at most lz4f_header_size bytes and may span
+    // fragments
+    std::array<char, lz4f_header_size> header{};
+    const size_t header_bytes = std::min(header.size(), b.size_bytes());
+    iobuf::iterator_consumer(b.cbegin(), b.cend())
+      .consume_to(header_bytes, header.data());
     LZ4F_frameInfo_t fi;
-    size_t in_sz = src_size;
-    LZ4F_errorCode_t code = LZ4F_getFrameInfo(ctx, &fi, src, &in_sz);
-    check_lz4_error("lz4f_getframeinfo error: {}", code);
-    size_t estimated_output_size = compute_frame_uncompressed_size(
-      fi.contentSize, src_size);
-    ss::temporary_buffer<char> obuf(estimated_output_size);
-    char* out = obuf.get_write();
-    /* Decompress input buffer t o output buffer until input is exhausted. */
-
-    size_t bytes_remaining = in_sz;
-    size_t consumed_bytes = 0;
-    while (bytes_remaining < src_size) {
-        size_t step_output_bytes = estimated_output_size - consumed_bytes;
-        size_t step_remaining_bytes = src_size - bytes_remaining;
-        code = LZ4F_decompress(
-          ctx,
-          // NOLINTNEXTLINE
-          out + consumed_bytes,
-          &step_output_bytes,
-          // NOLINTNEXTLINE
-          src + bytes_remaining,
-          &step_remaining_bytes,
-          nullptr);
-        check_lz4_error("lz4f_decompress error: {}", code);
-        vassert(
-          consumed_bytes + step_output_bytes <= estimated_output_size,
-          "Appended more bytes that allowed. Max:{}, consumed:{}",
-          estimated_output_size,
-          consumed_bytes + step_output_bytes);
-        vassert(
-          bytes_remaining <= src_size,
-          "Consumed more bytes than input. Max:{}, consumed:{}",
-          src_size,
-          bytes_remaining);
-        consumed_bytes += step_output_bytes;
-        bytes_remaining += step_remaining_bytes;
-        if (code == 0) {
-            break;
+    size_t skip = header_bytes;
+    LZ4F_errorCode_t hint = LZ4F_getFrameInfo(ctx, &fi, header.data(), &skip);
+    check_lz4_error("lz4f_getframeinfo error: {}", hint);
+
+    // frames that record their content size are uncompressed in place into
+    // fragments adding up to exactly that size
+    output_buffer obuf(
+      compute_frame_uncompressed_size(fi.contentSize, b.size_bytes()));
+    for (auto& frag : b) {
+        const char* src = frag.get();
+        size_t remaining = frag.size();
+        // the header was consumed by LZ4F_getFrameInfo
+        const auto header_part = std::min(skip, remaining);
+        // NOLINTNEXTLINE
+        src += header_part;
+        remaining -= header_part;
+        skip -= header_part;
+        while (remaining > 0 && hint != 0) {
+            char* dst = obuf.write_position();
+            size_t out_size = obuf.available();
+            size_t in_size = remaining;
+            hint = LZ4F_decompress(ctx, dst, &out_size, src, &in_size, nullptr);
+            check_lz4_error("lz4f_decompress error: {}", hint);
+            obuf.commit(out_size);
+            // NOLINTNEXTLINE
+            src += in_size;
+            remaining -= in_size;
         }
-        /* Need to grow output buffer, this shouldn't happen if
-         * contentSize was properly set. Happens all of the time with the
-         * console producer 2.3.1 and below*/
-        if (consumed_bytes == estimated_output_size) {
-            // TODO: add probes for re-growth
-            const size_t next_size = 1_KiB /*slack*/
-                                     + ((estimated_output_size * 3) + 1) / 2;
-            vlog(
-              complog.trace,
-              "Consumed bytes:{} has reached preallocated size. Growing to "
-              "size:{}",
-              consumed_bytes,
-              next_size);
-            ss::temporary_buffer<char> tmpo(next_size);
-            std::copy_n(obuf.get(), consumed_bytes, tmpo.get_write());
-            obuf = std::move(tmpo);
-            // update the pointer back to the original position
-            out = obuf.get_write();
-            estimated_output_size = next_size;
+        if (unlikely(remaining > 0)) {
+            throw std::runtime_error(fmt::format(
+              "lz4 error. could not consume all input bytes in "
+              "decompression. Input:{}",
+              b.size_bytes()));
         }
     }
-
-    if (unlikely(bytes_remaining < src_size)) {
+    // flush output buffered in the context when the last step filled obuf
+    while (hint != 0) {
+        char* dst = obuf.write_position();
+        size_t out_size = obuf.available();
+        size_t in_size = 0;
+        hint = LZ4F_decompress(ctx, dst, &out_size, nullptr, &in_size, nullptr);
+        check_lz4_error("lz4f_decompress error: {}", hint);
+        if (out_size == 0) {
+            break;
+        }
+        obuf.commit(out_size);
+    }
+    if (unlikely(hint != 0)) {
         throw std::runtime_error(fmt::format(
-          "lz4 error. could not consume all input bytes in decompression. "
-          "Input:{}, consumed:{}",
-          src_size,
-          bytes_remaining));
+          "lz4 error. truncated frame of {} bytes", b.size_bytes()));
     }
-
-    obuf.trim(consumed_bytes);
-    iobuf ret;
-    ret.append(std::move(obuf));
-    return ret;
+    return std::move(obuf).release();
 }
 
-iobuf lz4_frame_compressor::uncompress(const iobuf& b) {
-    if (std::distance(b.begin(), b.end()) == 1) {
-        return do_uncompressed(b.begin()->get(), b.size_bytes());
+void lz4_frame_compressor::uncompress_chunked(
+  const iobuf& b, const chunk_consumer& consumer) {
+    static constexpr size_t chunk_size = 64_KiB;
+    LZ4F_decompressionContext_t ctx = decompression_context();
+    ss::temporary_buffer<char> obuf(chunk_size);
+    // hint of the number of input bytes still expected, 0 once the frame is
+    // fully decoded
+    size_t hint = 1;
+    for (auto& frag : b) {
+        const char* src = frag.get();
+        size_t remaining = frag.size();
+        while (remaining > 0) {
+            size_t out_size = obuf.size();
+            size_t in_size = remaining;
+            hint = LZ4F_decompress(
+              ctx, obuf.get_write(), &out_size, src, &in_size, nullptr);
+            check_lz4_error("lz4f_decompress error: {}", hint);
+            // NOLINTNEXTLINE
+            src += in_size;
+            remaining -= in_size;
+            if (out_size > 0) {
+                consumer(obuf.get(), out_size);
+            }
+        }
+    }
+    // flush output buffered in the context when the last step filled obuf
+    while (hint != 0) {
+        size_t out_size = obuf.size();
+        size_t in_size = 0;
+        hint = LZ4F_decompress(
+          ctx, obuf.get_write(), &out_size, nullptr, &in_size, nullptr);
+        check_lz4_error("lz4f_decompress error: {}", hint);
+        if (out_size == 0) {
+            break;
+        }
+        consumer(obuf.get(), out_size);
+    }
+    if (unlikely(hint != 0)) {
+        throw std::runtime_error(fmt::format(
+          "lz4 error. truncated frame of {} bytes", b.size_bytes()));
     }
-    // linearize buffer
-    // TODO: optimize iobuf
-    auto linearized = iobuf_to_bytes(b);
-    return do_uncompressed(
-      // NOLINTNEXTLINE
-      reinterpret_cast<const char*>(linearized.data()),
-      linearized.size());
 }
 
 } // namespace compression::internal
@@ -11,11 +11,13 @@
 
 #pragma once
 #include "bytes/iobuf.h"
+#include "compression/compression.h"
 namespace compression::internal {
 
 struct lz4_frame_compressor {
     static iobuf compress(const iobuf&);
     static iobuf uncompress(const iobuf&);
+    static void uncompress_chunked(const iobuf&, const chunk_consumer&);
 };
 
 } // namespace compression::internal
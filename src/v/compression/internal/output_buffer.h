@@ -0,0 +1,86 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "bytes/details/io_allocation_size.h"
+#include "bytes/iobuf.h"
+#include "units.h"
+
+#include <seastar/core/temporary_buffer.hh>
+
+#include <algorithm>
+
+namespace compression::internal {
+
+/**
+ * Destination of a decompression. Codecs write straight into its fragments,
+ * so the uncompressed data is never copied.
+ *
+ * When the codec knows the uncompressed size, e.g. from the frame header,
+ * fragments are reserved to add up to exactly that size. Fragments are
+ * capped to the iobuf chunk size to avoid large contiguous allocations.
+ * Past the expected size, fragments grow with the output.
+ */
+class output_buffer {
+public:
+    explicit output_buffer(size_t expected_size) noexcept
+      : _expected(expected_size) {}
+
+    /// Writable space of the current fragment, a new one is reserved when it
+    /// is full
+    char* write_position() {
+        if (_filled == _current.size()) {
+            next_fragment();
+        }
+        // NOLINTNEXTLINE
+        return _current.get_write() + _filled;
+    }
+    size_t available() const { return _current.size() - _filled; }
+
+    void commit(size_t n) {
+        _filled += n;
+        _total += n;
+    }
+
+    size_t size_bytes() const { return _total; }
+
+    iobuf release() && {
+        if (_filled > 0) {
+            _current.trim(_filled);
+            _out.append(std::move(_current));
+        }
+        return std::move(_out);
+    }
+
+private:
+    void next_fragment() {
+        if (_filled > 0) {
+            _out.append(std::move(_current));
+        }
+        size_t size = 0;
+        if (_total < _expected) {
+            size = _expected - _total;
+        } else {
+            size = std::max<size_t>(_total / 2, 4_KiB);
+        }
+        size = std::min(size, details::io_allocation_size::max_chunk_size);
+        _current = ss::temporary_buffer<char>(size);
+        _filled = 0;
+    }
+
+    size_t _expected;
+    size_t _total{0};
+    iobuf _out;
+    ss::temporary_buffer<char> _current;
+    size_t _filled{0};
+};
+
+} // namespace compression::internal
@@ -109,4 +109,45 @@ iobuf snappy_java_compressor::uncompress(const iobuf& x) {
     return ret;
 }
 
+void snappy_java_compressor::uncompress_chunked(
+  const iobuf& x, const chunk_consumer& consumer) {
+    auto iter = details::io_iterator_consumer(x.cbegin(), x.cend());
+    std::array<uint8_t, snappy_magic::java_magic.size()> magic_compare{};
+    if (x.size_bytes() >= snappy_magic::header_len) {
+        iter.consume_to(magic_compare.size(), magic_compare.data());
+    }
+    if (unlikely(snappy_magic::java_magic != magic_compare)) {
+        // a single unframed block
+        auto uncompressed = snappy_standard_compressor::uncompress(x);
+        for (const auto& frag : uncompressed) {
+            consumer(frag.get(), frag.size());
+        }
+        return;
+    }
+    const auto version = iter.consume_type<int32_t>();
+    const auto min_version = iter.consume_type<int32_t>();
+    if (unlikely(min_version < snappy_magic::min_compatible_version)) {
+        throw std::runtime_error(fmt_with_ctx(
+          fmt::format,
+          "version missmatch. iobuf: {} - version:{}, min_version:{}",
+          x,
+          version,
+          min_version));
+    }
+    // every block is uncompressed on its own, only one is held at a time
+    const size_t input_bytes = x.size_bytes();
+    while (iter.bytes_consumed() != input_bytes) {
+        auto compressed_length = iter.consume_be_type<int32_t>();
+        auto chunk = iobuf_copy(iter, compressed_length);
+        auto output_size = snappy_standard_compressor::get_uncompressed_length(
+          chunk);
+        iobuf uncompressed;
+        snappy_standard_compressor::uncompress_append(
+          chunk, uncompressed, output_size);
+        for (const auto& frag : uncompressed) {
+            consumer(frag.get(), frag.size());
+        }
+    }
+}
+
 } // namespace compression::internal
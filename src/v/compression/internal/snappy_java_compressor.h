@@ -12,11 +12,13 @@
 #pragma once
 
 #include "bytes/iobuf.h"
+#include "compression/compression.h"
 
 namespace compression::internal {
 struct snappy_java_compressor {
     static iobuf compress(const iobuf&);
     static iobuf uncompress(const iobuf&);
+    static void uncompress_chunked(const iobuf&, const chunk_consumer&);
 };
 
 } // namespace compression::internal
@@ -11,17 +11,24 @@
 
 #pragma once
 #include "bytes/iobuf.h"
+#include "compression/compression.h"
 #include "compression/stream_zstd.h"
 namespace compression::internal {
 
+// the shard keeps one codec, its compression context is created once and
+// reused across calls
 struct zstd_compressor {
-    static iobuf compress(const iobuf& b) {
-        stream_zstd fn;
-        return fn.compress(b);
+    static iobuf compress(const iobuf& b) { return codec().compress(b); }
+    static iobuf uncompress(const iobuf& b) { return codec().uncompress(b); }
+    static void
+    uncompress_chunked(const iobuf& b, const chunk_consumer& consumer) {
+        codec().uncompress_chunked(b, consumer);
     }
-    static iobuf uncompress(const iobuf& b) {
-        stream_zstd fn;
-        return fn.uncompress(b);
+
+private:
+    static stream_zstd& codec() {
+        static thread_local stream_zstd fn;
+        return fn;
     }
 };
 
@@ -11,6 +11,7 @@
 
 #include "bytes/bytes.h"
 #include "bytes/details/io_allocation_size.h"
+#include "compression/internal/output_buffer.h"
 #include "compression/logger.h"
 #include "likely.h"
 #include "units.h"
@@ -86,8 +87,11 @@ ZSTD_DCtx* stream_zstd::decompressor() {
 }
 
 iobuf stream_zstd::do_compress(const iobuf& x) {
-    reset_compressor();
     ZSTD_CCtx* ctx = compressor().get();
+    // reuse the context across calls, creating one allocates and initializes
+    // several hundreds of KiB of tables. only the state of the previous frame
+    // is dropped, the parameters are kept.
+    throw_if_error(ZSTD_CCtx_reset(ctx, ZSTD_reset_session_only));
     // NOTE: always enable content size. **decompression** depends on this
     throw_if_error(ZSTD_CCtx_setPledgedSrcSize(ctx, x.size_bytes()));
     // zstd requires linearized memory
@@ -159,25 +163,83 @@ iobuf stream_zstd::do_uncompress(const iobuf& x) {
           "Asked to stream_zstd::uncompress empty buffer");
     }
     ZSTD_DCtx* dctx = decompressor();
-    iobuf ret;
+    // frames that record their content size are uncompressed in place into
+    // fragments adding up to exactly that size
+    internal::output_buffer obuf(find_zstd_size(x));
+    size_t rc = 0;
+    for (auto& ibuf : x) {
+        ZSTD_inBuffer in = {.src = ibuf.get(), .size = ibuf.size(), .pos = 0};
+        while (in.pos != in.size) {
+            char* dst = obuf.write_position();
+            ZSTD_outBuffer out = {
+              .dst = dst, .size = obuf.available(), .pos = 0};
+            rc = ZSTD_decompressStream(dctx, &out, &in);
+            throw_if_error(rc);
+            obuf.commit(out.pos);
+        }
+    }
+    // the context may still hold output if the last step filled the buffer
+    ZSTD_inBuffer none = {.src = nullptr, .size = 0, .pos = 0};
+    while (rc != 0) {
+        char* dst = obuf.write_position();
+        ZSTD_outBuffer out = {.dst = dst, .size = obuf.available(), .pos = 0};
+        rc = ZSTD_decompressStream(dctx, &out, &none);
+        throw_if_error(rc);
+        if (out.pos == 0) {
+            break;
+        }
+        obuf.commit(out.pos);
+    }
+    if (rc != 0) {
+        throw std::runtime_error(fmt::format(
+          "ZSTD error: truncated input of {} bytes", x.size_bytes()));
+    }
+    return std::move(obuf).release();
+}
+
+void stream_zstd::uncompress_chunked(
+  const iobuf& x, const chunk_consumer& consumer) {
+    if (unlikely(x.empty())) {
+        throw std::runtime_error(
+          "Asked to stream_zstd::uncompress empty buffer");
+    }
+    ZSTD_DCtx* dctx = decompressor();
     ss::temporary_buffer<char>& obuf = d_buffer;
     ZSTD_outBuffer out = {
       .dst = obuf.get_write(), .size = obuf.size(), .pos = 0};
+    size_t rc = 0;
     for (auto& ibuf : x) {
         ZSTD_inBuffer in = {.src = ibuf.get(), .size = ibuf.size(), .pos = 0};
         while (in.pos != in.size) {
-            auto err = ZSTD_decompressStream(dctx, &out, &in);
-            if (in.pos != in.size && out.pos == out.size) {
-                ret.append(obuf.get(), obuf.size());
-                out.size = obuf.size();
+            rc = ZSTD_decompressStream(dctx, &out, &in);
+            throw_if_error(rc);
+            if (out.pos == out.size) {
+                consumer(obuf.get(), out.pos);
                 out.pos = 0;
-            } else {
-                throw_if_error(err);
             }
         }
     }
-    ret.append(obuf.get(), out.pos);
-    return ret;
+    // the context may still hold output if the last step filled the buffer
+    ZSTD_inBuffer none = {.src = nullptr, .size = 0, .pos = 0};
+    while (rc != 0) {
+        const auto before = out.pos;
+        rc = ZSTD_decompressStream(dctx, &out, &none);
+        throw_if_error(rc);
+        if (out.pos == before) {
+            break;
+        }
+        if (out.pos == out.size) {
+            consumer(obuf.get(), out.pos);
+            out.pos = 0;
+        }
+    }
+    if (rc != 0) {
+        throw std::runtime_error(fmt::format(
+          "ZSTD error: truncated input of {} bytes", x.size_bytes()));
+    }
+    if (out.pos > 0) {
+        consumer(obuf.get(), out.pos);
+    }
 }
 
 } // namespace compression
@@ -11,6 +11,7 @@
 
 #pragma once
 #include "bytes/iobuf.h"
+#include "compression/compression.h"
 #include "static_deleter_fn.h"
 
 #include <memory>
@@ -28,6 +29,9 @@ public:
     iobuf uncompress(const iobuf& b) { return do_uncompress(b); }
     iobuf compress(iobuf&& b) { return do_compress(b); }
     iobuf uncompress(iobuf&& b) { return do_uncompress(b); }
+    /// Uncompresses through the fixed size decompression buffer, handing it
+    /// to the consumer every time it fills up
+    void uncompress_chunked(const iobuf&, const chunk_consumer&);
 
     static void init_workspace(size_t);
 
@@ -7,6 +7,7 @@
 // the Business Source License, use of this software will be governed
 // by the Apache License, Version 2.0
 
+#include "compression/compression.h"
 #include "compression/stream_zstd.h"
 #include "random/generators.h"
 #include "vassert.h"
@@ -48,7 +49,73 @@ inline void uncompress_test(size_t data_size) {
     perf_tests::stop_measuring_time();
 }
 
+// all codecs through the compressor interface, i.e. with the per-shard
+// contexts
+inline void compress_test(compression::type t, size_t data_size) {
+    auto o = gen(data_size);
+    perf_tests::start_measuring_time();
+    perf_tests::do_not_optimize(compression::compressor::compress(o, t));
+    perf_tests::stop_measuring_time();
+}
+
+inline void uncompress_test(compression::type t, size_t data_size) {
+    auto o = compression::compressor::compress(gen(data_size), t);
+    perf_tests::start_measuring_time();
+    perf_tests::do_not_optimize(compression::compressor::uncompress(o, t));
+    perf_tests::stop_measuring_time();
+}
+
+inline void uncompress_chunked_test(compression::type t, size_t data_size) {
+    auto o = compression::compressor::compress(gen(data_size), t);
+    size_t bytes = 0;
+    perf_tests::start_measuring_time();
+    compression::compressor::uncompress_chunked(
+      o, t, [&bytes](const char*, size_t n) { bytes += n; });
+    perf_tests::do_not_optimize(bytes);
+    perf_tests::stop_measuring_time();
+}
+
 PERF_TEST(streaming_zstd_1mb, compress) { compress_test(1 << 20); }
 PERF_TEST(streaming_zstd_1mb, uncompress) { return uncompress_test(1 << 20); }
 PERF_TEST(streaming_zstd_10mb, compress) { compress_test(10 << 20); }
 PERF_TEST(streaming_zstd_10mb, uncompress) { return uncompress_test(10 << 20); }
+
+// a typical produce batch
+static constexpr size_t batch_size = 64 << 10;
+
+PERF_TEST(codec_gzip_64kb, compress) {
+    compress_test(compression::type::gzip, batch_size);
+}
+PERF_TEST(codec_gzip_64kb, uncompress) {
+    uncompress_test(compression::type::gzip, batch_size);
+}
+PERF_TEST(codec_gzip_64kb, uncompress_chunked) {
+    uncompress_chunked_test(compression::type::gzip, batch_size);
+}
+PERF_TEST(codec_snappy_64kb, compress) {
+    compress_test(compression::type::snappy, batch_size);
+}
+PERF_TEST(codec_snappy_64kb, uncompress) {
+    uncompress_test(compression::type::snappy, batch_size);
+}
+PERF_TEST(codec_snappy_64kb, uncompress_chunked) {
+    uncompress_chunked_test(compression::type::snappy, batch_size);
+}
+PERF_TEST(codec_lz4_64kb, compress) {
+    compress_test(compression::type::lz4, batch_size);
+}
+PERF_TEST(codec_lz4_64kb, uncompress) {
+    uncompress_test(compression::type::lz4, batch_size);
+}
+PERF_TEST(codec_lz4_64kb, uncompress_chunked) {
+    uncompress_chunked_test(compression::type::lz4, batch_size);
+}
+PERF_TEST(codec_zstd_64kb, compress) {
+    compress_test(compression::type::zstd, batch_size);
+}
+PERF_TEST(codec_zstd_64kb, uncompress) {
+    uncompress_test(compression::type::zstd, batch_size);
+}
+PERF_TEST(codec_zstd_64kb, uncompress_chunked) {
+    uncompress_chunked_test(compression::type::zstd, batch_size);
+}
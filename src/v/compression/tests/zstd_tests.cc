@@ -7,18 +7,22 @@
 // the Business Source License, use of this software will be governed
 // by the Apache License, Version 2.0
 
+#include "compression/compression.h"
 #include "compression/internal/gzip_compressor.h"
 #include "compression/internal/lz4_frame_compressor.h"
 #include "compression/internal/snappy_java_compressor.h"
 #include "compression/internal/zstd_compressor.h"
 #include "compression/snappy_standard_compressor.h"
 #include "compression/stream_zstd.h"
+#include "compression/zstd_dictionary.h"
 #include "random/generators.h"
 #include "units.h"
 #include "vassert.h"
 
 #include <seastar/testing/thread_test_case.hh>
 
+#include <fmt/format.h>
+
 static inline constexpr std::array<size_t, 16> sizes{{
   0,
   1,
@@ -85,6 +89,18 @@ SEASTAR_THREAD_TEST_CASE(stream_zstd_test) {
     }
 }
 
+SEASTAR_THREAD_TEST_CASE(stream_zstd_reused_context_test) {
+    // a reused context produces the same frames as a fresh one
+    compression::stream_zstd reused;
+    for (size_t i : get_test_sizes()) {
+        iobuf buf = gen(i);
+        compression::stream_zstd fresh;
+        auto cbuf = reused.compress(buf.share(0, i));
+        BOOST_CHECK_EQUAL(cbuf, fresh.compress(buf.share(0, i)));
+        BOOST_CHECK_EQUAL(reused.uncompress(std::move(cbuf)), buf);
+    }
+}
+
 SEASTAR_THREAD_TEST_CASE(lz4_block_tests) {
     using fn = compression::internal::lz4_frame_compressor;
     roundtrip_compression(fn::compress, fn::uncompress);
@@ -105,3 +121,139 @@ SEASTAR_THREAD_TEST_CASE(gzip_test) {
     using fn = compression::internal::gzip_compressor;
     roundtrip_compression(fn::compress, fn::uncompress);
 }
+
+template<typename CompressFunc, typename DecompressFunc>
+inline void
+chunked_roundtrip(CompressFunc&& comp_fn, DecompressFunc&& decomp_fn) {
+    auto test_sizes = get_test_sizes();
+    // larger than the chunked decoders buffers
+    test_sizes.push_back(300_KiB);
+    for (size_t i : test_sizes) {
+        if (i == 0) {
+            continue;
+        }
+        iobuf buf = gen(i);
+        auto cbuf = comp_fn(buf.share(0, i));
+        iobuf dbuf;
+        size_t largest_chunk = 0;
+        decomp_fn(cbuf, [&dbuf, &largest_chunk](const char* data, size_t sz) {
+            largest_chunk = std::max(largest_chunk, sz);
+            dbuf.append(data, sz);
+        });
+        BOOST_CHECK_EQUAL(dbuf, buf);
+        BOOST_CHECK_LE(
+          largest_chunk, details::io_allocation_size::max_chunk_size);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(zstd_chunked_test) {
+    using fn = compression::internal::zstd_compressor;
+    chunked_roundtrip(fn::compress, fn::uncompress_chunked);
+}
+SEASTAR_THREAD_TEST_CASE(lz4_chunked_test) {
+    using fn = compression::internal::lz4_frame_compressor;
+    chunked_roundtrip(fn::compress, fn::uncompress_chunked);
+}
+SEASTAR_THREAD_TEST_CASE(snappy_java_chunked_test) {
+    using fn = compression::internal::snappy_java_compressor;
+    chunked_roundtrip(fn::compress, fn::uncompress_chunked);
+}
+SEASTAR_THREAD_TEST_CASE(lz4_chunked_truncated_test) {
+    using fn = compression::internal::lz4_frame_compressor;
+    auto cbuf = fn::compress(gen(100_KiB));
+    cbuf.trim_back(10);
+    BOOST_CHECK_THROW(
+      fn::uncompress_chunked(cbuf, [](const char*, size_t) {}),
+      std::runtime_error);
+}
+SEASTAR_THREAD_TEST_CASE(gzip_chunked_test) {
+    using fn = compression::internal::gzip_compressor;
+    chunked_roundtrip(fn::compress, fn::uncompress_chunked);
+}
+
+// splits the buffer into fragments of a few bytes, frame headers and
+// trailers end up spanning fragments
+static iobuf fragmented(const iobuf& b) {
+    static constexpr size_t fragment_size = 7;
+    iobuf ret;
+    auto in = iobuf::iterator_consumer(b.cbegin(), b.cend());
+    size_t remaining = b.size_bytes();
+    while (remaining > 0) {
+        const auto n = std::min(fragment_size, remaining);
+        ss::temporary_buffer<char> frag(n);
+        in.consume_to(n, frag.get_write());
+        ret.append(std::move(frag));
+        remaining -= n;
+    }
+    return ret;
+}
+
+SEASTAR_THREAD_TEST_CASE(fragmented_input_test) {
+    using compression::type;
+    for (auto t : {type::gzip, type::lz4, type::zstd, type::snappy}) {
+        roundtrip_compression(
+          [t](const iobuf& b) {
+              return compression::compressor::compress(b, t);
+          },
+          [t](const iobuf& b) {
+              return compression::compressor::uncompress(fragmented(b), t);
+          });
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(truncated_input_test) {
+    using compression::type;
+    for (auto t : {type::gzip, type::lz4, type::zstd}) {
+        auto cbuf = compression::compressor::compress(gen(100_KiB), t);
+        cbuf.trim_back(10);
+        BOOST_CHECK_THROW(
+          compression::compressor::uncompress(cbuf, t), std::runtime_error);
+    }
+}
+
+// small json documents alike to each other, as produced to event topics
+static iobuf gen_event(size_t i) {
+    auto doc = fmt::format(
+      R"({{"event_id":{},"type":"page_view","user":"{}","session":"{}",)"
+      R"("path":"/products/{}","referrer":"https://example.com/","ok":true}})",
+      i,
+      random_generators::gen_alphanum_string(8),
+      random_generators::gen_alphanum_string(16),
+      i % 97);
+    iobuf ret;
+    ret.append(doc.data(), doc.size());
+    return ret;
+}
+
+SEASTAR_THREAD_TEST_CASE(zstd_dictionary_test) {
+    std::vector<iobuf> samples;
+    for (size_t i = 0; i < 1000; ++i) {
+        samples.push_back(gen_event(i));
+    }
+    auto dict = compression::zstd_dictionary::train(samples);
+    BOOST_REQUIRE(dict);
+    BOOST_REQUIRE_LE(
+      dict->data().size(), compression::zstd_dictionary::default_max_size);
+
+    // a dictionary loaded from the trained bytes is the same
+    compression::zstd_dictionary loaded(dict->data());
+    BOOST_REQUIRE_EQUAL(loaded.id(), dict->id());
+
+    size_t plain = 0;
+    size_t with_dict = 0;
+    for (size_t i = 1000; i < 1100; ++i) {
+        auto event = gen_event(i);
+        auto cbuf = dict->compress(event);
+        BOOST_REQUIRE_EQUAL(loaded.uncompress(fragmented(cbuf)), event);
+        with_dict += cbuf.size_bytes();
+        plain += compression::internal::zstd_compressor::compress(event)
+                   .size_bytes();
+    }
+    BOOST_REQUIRE_LT(with_dict, plain);
+}
+
+SEASTAR_THREAD_TEST_CASE(zstd_dictionary_too_few_samples_test) {
+    std::vector<iobuf> samples;
+    samples.push_back(gen_event(0));
+    BOOST_REQUIRE(!compression::zstd_dictionary::train(samples));
+}
@@ -0,0 +1,157 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "compression/zstd_dictionary.h"
+
+#include "compression/logger.h"
+#include "likely.h"
+#include "vlog.h"
+
+#include <seastar/core/temporary_buffer.hh>
+
+#include <fmt/format.h>
+
+#include <numeric>
+#include <zdict.h>
+#include <zstd_errors.h>
+
+namespace compression {
+
+namespace {
+void throw_if_error(size_t rc) {
+    if (unlikely(ZSTD_isError(rc))) {
+        if (ZSTD_getErrorCode(rc) == ZSTD_error_memory_allocation) {
+            ss::throw_with_backtrace<std::bad_alloc>();
+        }
+        ss::throw_with_backtrace<std::runtime_error>(
+          fmt::format("ZSTD error:{}", ZSTD_getErrorName(rc)));
+    }
+}
+
+// dictionaries are only used off the produce and fetch paths, one context of
+// each kind per shard is enough
+ZSTD_CCtx* compress_ctx() {
+    static thread_local std::unique_ptr<
+      ZSTD_CCtx,
+      static_sized_deleter_fn<ZSTD_CCtx, &ZSTD_freeCCtx>>
+      ctx{ZSTD_createCCtx()};
+    if (!ctx) {
+        throw std::bad_alloc{};
+    }
+    return ctx.get();
+}
+
+ZSTD_DCtx* uncompress_ctx() {
+    static thread_local std::unique_ptr<
+      ZSTD_DCtx,
+      static_sized_deleter_fn<ZSTD_DCtx, &ZSTD_freeDCtx>>
+      ctx{ZSTD_createDCtx()};
+    if (!ctx) {
+        throw std::bad_alloc{};
+    }
+    return ctx.get();
+}
+} // namespace
+
+std::optional<zstd_dictionary>
+zstd_dictionary::train(const std::vector<iobuf>& samples, size_t max_size) {
+    // zdict takes the samples concatenated, with their sizes
+    std::vector<size_t> sizes;
+    sizes.reserve(samples.size());
+    const auto total = std::accumulate(
+      samples.begin(),
+      samples.end(),
+      size_t(0),
+      [](size_t acc, const iobuf& s) { return acc + s.size_bytes(); });
+    auto buffer = ss::uninitialized_string<bytes>(total);
+    auto out = buffer.begin();
+    for (const auto& s : samples) {
+        sizes.push_back(s.size_bytes());
+        for (const auto& frag : s) {
+            out = std::copy_n(frag.get(), frag.size(), out);
+        }
+    }
+
+    bytes dict(bytes::initialized_later{}, max_size);
+    auto rc = ZDICT_trainFromBuffer(
+      dict.data(),
+      dict.size(),
+      buffer.data(),
+      sizes.data(),
+      static_cast<unsigned>(sizes.size()));
+    if (ZDICT_isError(rc)) {
+        vlog(
+          complog.debug,
+          "Cannot train a zstd dictionary from {} samples of {} bytes: {}",
+          samples.size(),
+          total,
+          ZDICT_getErrorName(rc));
+        return std::nullopt;
+    }
+    dict.resize(rc);
+    return zstd_dictionary(std::move(dict));
+}
+
+zstd_dictionary::zstd_dictionary(bytes data)
+  : _data(std::move(data))
+  , _cdict(ZSTD_createCDict(_data.data(), _data.size(), ZSTD_CLEVEL_DEFAULT))
+  , _ddict(ZSTD_createDDict(_data.data(), _data.size())) {
+    if (!_cdict || !_ddict) {
+        throw std::bad_alloc{};
+    }
+}
+
+uint32_t zstd_dictionary::id() const {
+    return ZSTD_getDictID_fromDDict(_ddict.get());
+}
+
+iobuf zstd_dictionary::compress(const iobuf& b) const {
+    auto src = iobuf_to_bytes(b);
+    ss::temporary_buffer<char> obuf(ZSTD_compressBound(src.size()));
+    auto rc = ZSTD_compress_usingCDict(
+      compress_ctx(),
+      obuf.get_write(),
+      obuf.size(),
+      src.data(),
+      src.size(),
+      _cdict.get());
+    throw_if_error(rc);
+    obuf.trim(rc);
+    iobuf ret;
+    ret.append(std::move(obuf));
+    return ret;
+}
+
+iobuf zstd_dictionary::uncompress(const iobuf& b) const {
+    auto src = iobuf_to_bytes(b);
+    // the frames written by compress() always record their content size
+    const auto size = ZSTD_getFrameContentSize(src.data(), src.size());
+    if (size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN) {
+        throw std::runtime_error(fmt::format(
+          "Cannot uncompress {} bytes with zstd dictionary {}, unknown "
+          "content size",
+          src.size(),
+          id()));
+    }
+    ss::temporary_buffer<char> obuf(size);
+    auto rc = ZSTD_decompress_usingDDict(
+      uncompress_ctx(),
+      obuf.get_write(),
+      obuf.size(),
+      src.data(),
+      src.size(),
+      _ddict.get());
+    throw_if_error(rc);
+    obuf.trim(rc);
+    iobuf ret;
+    ret.append(std::move(obuf));
+    return ret;
+}
+
+} // namespace compression
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "bytes/bytes.h"
+#include "bytes/iobuf.h"
+#include "static_deleter_fn.h"
+#include "units.h"
+
+#include <memory>
+#include <optional>
+#include <vector>
+#include <zstd.h>
+
+namespace compression {
+
+/**
+ * A zstd dictionary trained from sample payloads.
+ *
+ * Small payloads compress poorly on their own because every frame starts from
+ * an empty context. A dictionary primes the context with the content common
+ * to the samples, so payloads alike to them compress much better. Frames
+ * compressed with a dictionary can only be uncompressed with the same one.
+ */
+class zstd_dictionary {
+public:
+    static constexpr size_t default_max_size = 16_KiB;
+
+    /// Trains a dictionary of at most max_size bytes, std::nullopt if the
+    /// samples are too few or too small for zstd to train one
+    static std::optional<zstd_dictionary> train(
+      const std::vector<iobuf>& samples, size_t max_size = default_max_size);
+
+    /// Loads a dictionary previously returned by data()
+    explicit zstd_dictionary(bytes);
+
+    /// Id of the dictionary, recorded in the frames compressed with it
+    uint32_t id() const;
+    const bytes& data() const { return _data; }
+
+    iobuf compress(const iobuf&) const;
+    iobuf uncompress(const iobuf&) const;
+
+private:
+    using cdict_ptr = std::unique_ptr<
+      ZSTD_CDict,
+      static_sized_deleter_fn<ZSTD_CDict, &ZSTD_freeCDict>>;
+    using ddict_ptr = std::unique_ptr<
+      ZSTD_DDict,
+      static_sized_deleter_fn<ZSTD_DDict, &ZSTD_freeDDict>>;
+
+    bytes _data;
+    cdict_ptr _cdict;
+    ddict_ptr _ddict;
+};
+
+} // namespace compression
@@ -200,6 +200,53 @@ configuration::configuration()
       {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
       512_KiB,
       {.min = 128, .max = 5_MiB})
+  , raft_recovery_max_inflight_requests(
+      *this,
+      "raft_recovery_max_inflight_requests",
+      "Maximum number of append entries requests in flight to a recovering "
+      "follower. The number of requests in flight adapts to the round trip "
+      "time of the follower up to this limit",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      1,
+      {.min = 1, .max = 64})
+  , raft_recovery_skip_archived_prefix(
+      *this,
+      "raft_recovery_skip_archived_prefix",
+      "When a follower is missing a part of the log that is already uploaded "
+      "to cloud storage and the topic has remote read enabled, install a "
+      "snapshot at the last uploaded offset instead of replicating that part "
+      "from the leader's disk. The follower reads the archived part from "
+      "cloud storage",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      false)
+  , raft_quiescence_timeout_ms(
+      *this,
+      "raft_quiescence_timeout_ms",
+      "Time after which a leader stops sending heartbeats to an idle raft "
+      "group whose followers are up to date, one lease request per node "
+      "keeps all such groups alive instead. Must be longer than the raft "
+      "RPC timeouts. If not set every group is sent heartbeats.",
+      {.needs_restart = needs_restart::no,
+       .example = "10000",
+       .visibility = visibility::tunable},
+      std::nullopt)
+  , raft_enable_lease_reads(
+      *this,
+      "raft_enable_lease_reads",
+      "Let a raft leader answer linearizable barriers, used by consumer group "
+      "and offset reads, from its commit index while a majority acknowledged "
+      "its requests within the election timeout, instead of sending a round "
+      "of heartbeats first. Relies on the clock drift between nodes staying "
+      "below raft_lease_max_clock_drift_ms",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      false)
+  , raft_lease_max_clock_drift_ms(
+      *this,
+      "raft_lease_max_clock_drift_ms",
+      "Bound on the clock drift between nodes over an election timeout, the "
+      "leader lease is shortened by that much",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      100ms)
   , use_scheduling_groups(*this, "use_scheduling_groups")
   , enable_admin_api(*this, "enable_admin_api")
   , default_num_windows(
@@ -231,6 +278,22 @@ configuration::configuration()
        .visibility = visibility::user},
       2_GiB,
       {.min = 1_MiB})
+  , target_quota_request_rate(
+      *this,
+      "target_quota_request_rate",
+      "Target quota request rate (requests per second) per client id. No "
+      "request rate quota when not set",
+      {.needs_restart = needs_restart::no,
+       .example = "1000",
+       .visibility = visibility::user},
+      std::nullopt)
+  , quota_manager_balancer_interval_ms(
+      *this,
+      "quota_manager_balancer_interval_ms",
+      "Interval at which the quotas of the clients are split across cores "
+      "in proportion to their usage on each core",
+      {.visibility = visibility::tunable},
+      1000ms)
   , cluster_id(
       *this,
       "cluster_id",
@@ -262,6 +325,23 @@ configuration::configuration()
       "partition labels.",
       {.needs_restart = needs_restart::yes},
       false)
+  , partition_metrics_aggregation(
+      *this,
+      "partition_metrics_aggregation",
+      "Granularity of the partition metrics returned by the prometheus "
+      "'/metrics' endpoint: 'partition' registers series for every partition, "
+      "'topic' and 'node' fold the partitions of a shard into a series per "
+      "topic or a single series when the partitions are created, so that the "
+      "cost of a scrape does not grow with the number of partitions",
+      {.needs_restart = needs_restart::yes,
+       .example = "topic",
+       .visibility = visibility::tunable},
+      model::partition_metrics_aggregation::partition,
+      {
+        model::partition_metrics_aggregation::partition,
+        model::partition_metrics_aggregation::topic,
+        model::partition_metrics_aggregation::node,
+      })
   , group_min_session_timeout_ms(
       *this,
       "group_min_session_timeout_ms",
@@ -291,6 +371,31 @@ configuration::configuration()
       "Timeout for new member joins",
       {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
       30'000ms)
+  , group_offset_commit_batch_window_ms(
+      *this,
+      "group_offset_commit_batch_window_ms",
+      "Time window (ms) during which offset commits of all the groups "
+      "coordinated by the same partition are coalesced into a single "
+      "replicated batch, 0 disables batching",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      2ms)
+  , group_metadata_snapshot_interval_ms(
+      *this,
+      "group_metadata_snapshot_interval_ms",
+      "Interval (ms) at which every replica of a group metadata partition "
+      "snapshots the coordinator state, so that a new coordinator only replays "
+      "the log written after the snapshot. 0 disables snapshots",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      30'000ms)
+  , group_standby_catchup_interval_ms(
+      *this,
+      "group_standby_catchup_interval_ms",
+      "Interval (ms) at which followers of a group metadata partition apply "
+      "the newly committed log to an in-memory copy of the coordinator state, "
+      "which a new coordinator takes over instead of recovering from the "
+      "snapshot. 0 disables the standby state",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      1'000ms)
   , metadata_dissemination_interval_ms(
       *this,
       "metadata_dissemination_interval_ms",
@@ -325,6 +430,14 @@ configuration::configuration()
       model::violation_recovery_policy::crash,
       {model::violation_recovery_policy::crash,
        model::violation_recovery_policy::best_effort})
+  , tm_marker_fanout_concurrency(
+      *this,
+      "tm_marker_fanout_concurrency",
+      "Maximum number of commit or abort markers a transaction coordinator "
+      "sends in parallel for a single transaction",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      32,
+      {.min = 1})
   , rm_sync_timeout_ms(
       *this,
       "rm_sync_timeout_ms",
@@ -406,8 +519,8 @@ configuration::configuration()
   , metadata_status_wait_timeout_ms(
       *this,
       "metadata_status_wait_timeout_ms",
-      "Maximum time to wait in metadata request for cluster health to be "
-      "refreshed",
+      "Maximum time to wait for cluster health to be refreshed when updating "
+      "the status of the nodes served in metadata responses",
       {.visibility = visibility::tunable},
       2s)
   , kafka_connection_rate_limit(
@@ -447,12 +560,28 @@ configuration::configuration()
       "Enable transactions",
       {.visibility = visibility::user},
       false)
+  , enable_follower_fetching(
+      *this,
+      "enable_follower_fetching",
+      "Let consumers fetch from followers (KIP-392). The leader points a "
+      "consumer that sets client.rack at an in sync replica in that rack, "
+      "followers serve reads up to the high watermark they learned from the "
+      "leader. Only read_uncommitted fetches are served by followers",
+      {.needs_restart = needs_restart::no, .visibility = visibility::user},
+      false)
   , abort_index_segment_size(
       *this,
       "abort_index_segment_size",
       "Capacity (in number of txns) of an abort index segment",
       {.visibility = visibility::tunable},
       50000)
+  , abort_index_cache_size(
+      *this,
+      "abort_index_cache_size",
+      "Number of abort index segments per partition kept in memory to serve "
+      "read_committed fetches",
+      {.visibility = visibility::tunable},
+      4)
   , delete_retention_ms(
       *this,
       "delete_retention_ms",
@@ -471,6 +600,22 @@ configuration::configuration()
       "Default max bytes per partition on disk before triggering a compaction",
       {.needs_restart = needs_restart::no, .visibility = visibility::user},
       std::nullopt)
+  , retention_local_target_bytes(
+      *this,
+      "retention_local_target_bytes",
+      "Max bytes per partition kept on disk for topics uploaded to cloud "
+      "storage. Segments are only removed once uploaded, older data is read "
+      "from cloud storage. If not set the topic retention applies",
+      {.needs_restart = needs_restart::no, .visibility = visibility::user},
+      std::nullopt)
+  , retention_local_target_ms(
+      *this,
+      "retention_local_target_ms",
+      "Max age of the data kept on disk for topics uploaded to cloud "
+      "storage. Segments are only removed once uploaded, older data is read "
+      "from cloud storage. If not set the topic retention applies",
+      {.needs_restart = needs_restart::no, .visibility = visibility::user},
+      std::nullopt)
   , group_topic_partitions(
       *this,
       "group_topic_partitions",
@@ -545,6 +690,24 @@ configuration::configuration()
       "Disable batch cache in log manager",
       {.visibility = visibility::tunable},
       false)
+  , batch_cache_segmented_lru(
+      *this,
+      "batch_cache_segmented_lru",
+      "Use a segmented LRU in the batch cache: batches are promoted to a "
+      "protected segment on their first cache hit and batches read only once "
+      "are evicted first",
+      {.visibility = visibility::tunable},
+      false)
+  , batch_cache_max_read_lag_bytes(
+      *this,
+      "batch_cache_max_read_lag_bytes",
+      "Reads starting more than this many bytes behind the end of a "
+      "partition do not insert batches into, nor promote batches in, the "
+      "batch cache. Unset to cache all reads",
+      {.needs_restart = needs_restart::no,
+       .example = "1073741824",
+       .visibility = visibility::tunable},
+      std::nullopt)
   , raft_election_timeout_ms(
       *this,
       "election_timeout_ms",
@@ -576,6 +739,29 @@ configuration::configuration()
       "Max size of requests cached for replication",
       {.visibility = visibility::tunable},
       1_MiB)
+  , raft_replicate_batcher_policy(
+      *this,
+      "raft_replicate_batcher_policy",
+      "When to cut cached replicate requests into an append: 'fixed' cuts "
+      "immediately, 'latency_first' and 'throughput_first' may wait for a "
+      "fraction of the observed append latency (respectively a quarter and "
+      "all of it) when the arrival rate suggests the batch will fill up",
+      {.needs_restart = needs_restart::no,
+       .example = "throughput_first",
+       .visibility = visibility::tunable},
+      model::replicate_batcher_policy::fixed,
+      {
+        model::replicate_batcher_policy::fixed,
+        model::replicate_batcher_policy::latency_first,
+        model::replicate_batcher_policy::throughput_first,
+      })
+  , raft_replicate_batcher_max_linger_ms(
+      *this,
+      "raft_replicate_batcher_max_linger_ms",
+      "Upper bound of the time adaptive replicate batcher policies may hold "
+      "cached requests waiting for more data",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      2ms)
   , raft_learner_recovery_rate(
       *this,
       "raft_learner_recovery_rate",
@@ -592,10 +778,43 @@ configuration::configuration()
   , raft_max_concurrent_append_requests_per_follower(
       *this,
       "raft_max_concurrent_append_requests_per_follower",
-      "Maximum number of concurrent append entries requests sent by leader to "
-      "one follower",
+      "Initial number of concurrent append entries requests sent by leader to "
+      "one follower. The number adapts to the follower latency, between one "
+      "and four times this value",
       {.visibility = visibility::tunable},
       16)
+  , raft_multi_append_max_requests(
+      *this,
+      "raft_multi_append_max_requests",
+      "Maximum number of append entries requests for different raft groups "
+      "that a leader sends to one node in a single rpc. 0 disables "
+      "coalescing",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      128)
+  , raft_multi_vote_max_requests(
+      *this,
+      "raft_multi_vote_max_requests",
+      "Maximum number of vote or timeout_now requests for different raft "
+      "groups that a node sends to one node in a single rpc. 0 disables "
+      "coalescing",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      512)
+  , write_caching_max_unflushed_bytes(
+      *this,
+      "write_caching_max_unflushed_bytes",
+      "Maximum number of acknowledged but not yet flushed bytes of a partition "
+      "of a topic with redpanda.write.caching enabled, reaching it triggers a "
+      "background flush",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      32_MiB)
+  , write_caching_flush_interval_ms(
+      *this,
+      "write_caching_flush_interval_ms",
+      "Maximum time acknowledged writes of a partition of a topic with "
+      "redpanda.write.caching enabled stay unflushed",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      100ms,
+      {.min = 1ms})
   , reclaim_min_size(
       *this,
       "reclaim_min_size",
@@ -656,6 +875,16 @@ configuration::configuration()
       "Fail-safe maximum throttle delay on kafka requests",
       {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
       60'000ms)
+  , kafka_request_memory_reserve_percent(
+      *this,
+      "kafka_request_memory_reserve_percent",
+      "Percentage of the kafka request memory of a core reserved for produce, "
+      "fetch, heartbeat and offset commit requests. Other requests are "
+      "delayed for up to 5 seconds while less memory is available. 0 "
+      "disables the reserve",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      10,
+      {.min = 0, .max = 90})
   , kafka_max_bytes_per_fetch(
       *this,
       "kafka_max_bytes_per_fetch",
@@ -663,6 +892,21 @@ configuration::configuration()
       "bytes limits is higher",
       {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
       64_MiB)
+  , kafka_fetch_extent_reads_enabled(
+      *this,
+      "kafka_fetch_extent_reads_enabled",
+      "Serve read_uncommitted fetches from non-compacted topics straight from "
+      "flushed segment file extents, bypassing the batch cache",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      false)
+  , kafka_connection_max_in_flight_requests(
+      *this,
+      "kafka_connection_max_in_flight_requests",
+      "Maximum number of requests a single client connection may have in "
+      "flight, further requests are not read until a response is sent. Takes "
+      "effect for new connections",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      32)
   , raft_io_timeout_ms(
       *this,
       "raft_io_timeout_ms",
@@ -693,6 +937,13 @@ configuration::configuration()
       "Free cache when segments roll",
       {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
       false)
+  , release_index_on_segment_roll(
+      *this,
+      "release_index_on_segment_roll",
+      "Drop the in-memory offset index of segments that are no longer written "
+      "to. Lookups in those segments binary search the index file instead",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      false)
   , segment_appender_flush_timeout_ms(
       *this,
       "segment_appender_flush_timeout_ms",
@@ -727,6 +978,16 @@ configuration::configuration()
       "How many additional reads to issue ahead of current read location",
       {.example = "1", .visibility = visibility::tunable},
       10)
+  , storage_idle_open_segment_files(
+      *this,
+      "storage_idle_open_segment_files",
+      "Number of segment files kept open per core after their last reader is "
+      "closed, to avoid reopening recently read segments. 0 closes files as "
+      "soon as they are not read",
+      {.needs_restart = needs_restart::no,
+       .example = "4096",
+       .visibility = visibility::tunable},
+      1024)
   , segment_fallocation_step(
       *this,
       "segment_fallocation_step",
@@ -736,6 +997,25 @@ configuration::configuration()
        .visibility = visibility::tunable},
       32_MiB,
       storage::segment_appender::validate_fallocation_step)
+  , segment_recycle_pool_size(
+      *this,
+      "segment_recycle_pool_size",
+      "Number of data files of removed segments kept pre-allocated per shard "
+      "and reused by new segments. Zero disables recycling",
+      {.needs_restart = needs_restart::yes,
+       .example = "4",
+       .visibility = visibility::tunable},
+      0)
+  , segment_recovery_checkpoint_bytes(
+      *this,
+      "segment_recovery_checkpoint_bytes",
+      "Bytes appended to the active segment between two checkpoints of its "
+      "index. After an unclean shutdown only the data written after the last "
+      "checkpoint is validated. Zero disables checkpoints",
+      {.needs_restart = needs_restart::no,
+       .example = "67108864",
+       .visibility = visibility::tunable},
+      64_MiB)
   , storage_target_replay_bytes(
       *this,
       "storage_target_replay_bytes",
@@ -766,6 +1046,35 @@ configuration::configuration()
        .visibility = visibility::tunable},
       128_MiB,
       {.min = 16_MiB, .max = 100_GiB})
+  , storage_compaction_key_map_memory(
+      *this,
+      "storage_compaction_key_map_memory",
+      "Maximum number of bytes used by the key map of a compaction that "
+      "deduplicates keys across a window of segments. The window is limited "
+      "to the segments whose keys fit into the map. Set to 0 to compact only "
+      "adjacent segments.",
+      {.needs_restart = needs_restart::no,
+       .example = "134217728",
+       .visibility = visibility::tunable},
+      128_MiB)
+  , storage_compaction_tombstone_retention_ms(
+      *this,
+      "storage_compaction_tombstone_retention_ms",
+      "Time after which compaction removes tombstones, records without a "
+      "value, from compacted topics. Tombstones are removed only when a "
+      "compaction pass covers the whole log. If not set tombstones are kept.",
+      {.needs_restart = needs_restart::no,
+       .example = "86400000",
+       .visibility = visibility::tunable},
+      std::nullopt)
+  , storage_flush_coalescing(
+      *this,
+      "storage_flush_coalescing",
+      "Coalesce segment flushes issued by all partitions on a shard into "
+      "rounds. Flush requests arriving while a round is in progress are "
+      "merged and issued together in the next round",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      false)
   , max_compacted_log_segment_size(
       *this,
       "max_compacted_log_segment_size",
@@ -789,6 +1098,15 @@ configuration::configuration()
       "touching the log until the batch is exhausted.",
       {.visibility = visibility::tunable},
       1000)
+  , id_allocator_local_range_size(
+      *this,
+      "id_allocator_local_range_size",
+      "Number of ids each shard leases from the id allocator at once. "
+      "Producer ids are then served from the leased range without a round "
+      "trip to the id allocator leader, and the next range is leased in the "
+      "background once the current one runs low. Zero disables leasing.",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      100)
   , enable_sasl(
       *this,
       "enable_sasl",
@@ -819,6 +1137,30 @@ configuration::configuration()
       "Interval between iterations of controller backend housekeeping loop",
       {.visibility = visibility::tunable},
       1s)
+  , controller_backend_reconciliation_concurrency(
+      *this,
+      "controller_backend_reconciliation_concurrency",
+      "Maximum number of partitions a core reconciles concurrently, e.g. "
+      "when creating the partitions of a large topic",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      256)
+  , controller_backend_defer_follower_startup(
+      *this,
+      "controller_backend_defer_follower_startup",
+      "On startup, only create the partition replicas this node is the "
+      "preferred leader of and the replicas of internal topics before the node "
+      "starts serving, the remaining follower replicas are created in the "
+      "background",
+      {.needs_restart = needs_restart::yes, .visibility = visibility::tunable},
+      false)
+  , controller_snapshot_interval_sec(
+      *this,
+      "controller_snapshot_interval_sec",
+      "Interval between local snapshots of the controller state, a node loads "
+      "the snapshot on startup and only replays the controller log following "
+      "it",
+      {.visibility = visibility::tunable},
+      60s)
   , node_management_operation_timeout_ms(
       *this,
       "node_management_operation_timeout_ms",
@@ -870,12 +1212,85 @@ configuration::configuration()
       "target compaction backlog would be equal to ",
       {.visibility = visibility::tunable},
       std::nullopt)
+  , compaction_ctrl_io_bandwidth(
+      *this,
+      "compaction_ctrl_io_bandwidth",
+      "Bandwidth of the data disk in bytes per second, compaction I/O of a "
+      "node never exceeds it. If not set the write bandwidth of the iotune "
+      "profile is used, compaction I/O is not throttled if neither is known.",
+      {.needs_restart = needs_restart::no,
+       .example = "1073741824",
+       .visibility = visibility::tunable},
+      std::nullopt)
+  , compaction_ctrl_flush_latency_target_ms(
+      *this,
+      "compaction_ctrl_flush_latency_target_ms",
+      "Compaction I/O rate is reduced when p99 latency of log flushes exceeds "
+      "this target. Takes effect only when compaction I/O is throttled, see "
+      "compaction_ctrl_io_bandwidth.",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      50ms)
+  , io_share_ctrl_enabled(
+      *this,
+      "io_share_ctrl_enabled",
+      "Adapt the I/O shares of partition recovery to the latency of produce "
+      "and fetch requests: recovery yields when either exceeds its target.",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      false)
+  , io_share_ctrl_produce_latency_target_ms(
+      *this,
+      "io_share_ctrl_produce_latency_target_ms",
+      "Target p99 latency of log flushes, see io_share_ctrl_enabled.",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      20ms)
+  , io_share_ctrl_fetch_latency_target_ms(
+      *this,
+      "io_share_ctrl_fetch_latency_target_ms",
+      "Target p99 latency of disk reads of fetch requests, see "
+      "io_share_ctrl_enabled.",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      50ms)
+  , io_share_ctrl_update_interval_ms(
+      *this,
+      "io_share_ctrl_update_interval_ms",
+      "Interval between updates of the I/O shares, see io_share_ctrl_enabled.",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      1s)
+  , request_trace_sample_rate(
+      *this,
+      "request_trace_sample_rate",
+      "Trace one in this many produce requests across the kafka, raft and "
+      "storage layers, 0 disables tracing.",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      0)
+  , request_trace_slow_threshold_ms(
+      *this,
+      "request_trace_slow_threshold_ms",
+      "Traced requests taking longer than this are kept for the "
+      "/v1/debug/request_traces admin endpoint.",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      100ms)
   , members_backend_retry_ms(
       *this,
       "members_backend_retry_ms",
       "Time between members backend reconciliation loop retries ",
       {.visibility = visibility::tunable},
       5s)
+  , partition_movement_max_concurrent_per_node(
+      *this,
+      "partition_movement_max_concurrent_per_node",
+      "Maximum number of partition replicas recovering on a node at the same "
+      "time when partitions are moved to decommission or add a node",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      16,
+      {.min = 1, .max = 4096})
+  , partition_movement_bandwidth_limit(
+      *this,
+      "partition_movement_bandwidth_limit",
+      "Cluster wide budget in bytes per second for the partitions moved to "
+      "decommission or add a node. Unlimited if not set",
+      {.needs_restart = needs_restart::no, .visibility = visibility::user},
+      std::nullopt)
   , kafka_connections_max(
       *this,
       "kafka_connections_max",
@@ -923,6 +1338,25 @@ configuration::configuration()
       // permit setting a max below the min).  The maximum is set to forbid
       // contiguous allocations beyond that size.
       {.min = 512, .max = 512_KiB, .align = 4_KiB})
+  , kafka_connection_port_placement(
+      *this,
+      "kafka_connection_port_placement",
+      "Assign kafka connections to shards by client source port (port modulo "
+      "core count) instead of balancing them across shards. Clients that pick "
+      "their source port from the partition core reported by the admin API "
+      "are served without cross-core hops",
+      {.needs_restart = needs_restart::yes, .visibility = visibility::tunable},
+      false)
+  , kafka_connection_rebalance_interval_ms(
+      *this,
+      "kafka_connection_rebalance_interval_ms",
+      "Interval at which cores compare their kafka request load. A core "
+      "serving noticeably more than the average closes some of its "
+      "connections so that the clients reconnect to less loaded cores. "
+      "Disabled when not set or when kafka_connection_port_placement is "
+      "enabled",
+      {.needs_restart = needs_restart::yes, .visibility = visibility::tunable},
+      std::nullopt)
   , cloud_storage_enabled(
       *this,
       "cloud_storage_enabled",
@@ -1073,6 +1507,14 @@ configuration::configuration()
       "Timeout for SI metadata synchronization",
       {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
       10s)
+  , cloud_storage_metadata_replication_interval_ms(
+      *this,
+      "cloud_storage_metadata_replication_interval_ms",
+      "Minimum interval between updates of the archival metadata of a "
+      "partition. Segments uploaded in between are replicated together in the "
+      "next update. 0 replicates the metadata after every upload",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      10s)
   , cloud_storage_upload_ctrl_update_interval_ms(
       *this,
       "cloud_storage_upload_ctrl_update_interval_ms",
@@ -1115,6 +1557,161 @@ configuration::configuration()
       "Timeout to check if cache eviction should be triggered",
       {.visibility = visibility::tunable},
       30s)
+  , cloud_storage_cache_relaxed_durability(
+      *this,
+      "cloud_storage_cache_relaxed_durability",
+      "Write the files of the archival cache without waiting for them to be "
+      "synced to disk. The files are synced in the background, the ones that "
+      "might be incomplete after a crash are removed on startup",
+      {.needs_restart = needs_restart::yes, .visibility = visibility::tunable},
+      false)
+  , cloud_storage_prefetch_segments(
+      *this,
+      "cloud_storage_prefetch_segments",
+      "Number of remote segments following the one being read that are "
+      "hydrated into the cache in the background. Zero disables prefetching",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      0)
+  , cloud_storage_prefetch_max_concurrency(
+      *this,
+      "cloud_storage_prefetch_max_concurrency",
+      "Max number of concurrent segment prefetches per shard",
+      {.needs_restart = needs_restart::yes, .visibility = visibility::tunable},
+      2)
+  , cloud_storage_prefetch_max_inflight_bytes(
+      *this,
+      "cloud_storage_prefetch_max_inflight_bytes",
+      "Max number of bytes of segment prefetches in progress per shard. "
+      "Bounds the share of the object storage bandwidth used by prefetching",
+      {.needs_restart = needs_restart::yes, .visibility = visibility::tunable},
+      256_MiB)
+  , cloud_storage_segment_chunk_size(
+      *this,
+      "cloud_storage_segment_chunk_size",
+      "Hydrate remote segments in chunks of this size using range reads, "
+      "only the chunks that are read are downloaded. If not set segments are "
+      "downloaded as a whole",
+      {.needs_restart = needs_restart::no,
+       .example = "16777216",
+       .visibility = visibility::tunable},
+      std::nullopt)
+  , cloud_storage_multipart_upload_part_size(
+      *this,
+      "cloud_storage_multipart_upload_part_size",
+      "Upload segments larger than this using multipart upload with parts of "
+      "this size, the parts are uploaded concurrently and retried "
+      "individually. If not set segments are uploaded with a single request",
+      {.needs_restart = needs_restart::no,
+       .example = "67108864",
+       .visibility = visibility::tunable},
+      std::nullopt,
+      {.min = 5_MiB}) // S3 minimum part size
+  , cloud_storage_multipart_upload_concurrency(
+      *this,
+      "cloud_storage_multipart_upload_concurrency",
+      "Max number of parts of a single multipart segment upload that are "
+      "uploaded concurrently",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      4,
+      {.min = 1})
+  , cloud_storage_recovery_max_concurrency(
+      *this,
+      "cloud_storage_recovery_max_concurrency",
+      "Max number of concurrent segment downloads per shard during topic "
+      "recovery, shared by all partitions being recovered",
+      {.needs_restart = needs_restart::yes, .visibility = visibility::tunable},
+      8)
+  , cloud_storage_manifest_binary_format(
+      *this,
+      "cloud_storage_manifest_binary_format",
+      "Upload partition manifests using the compact binary format instead of "
+      "json. Both formats can be read regardless of this setting, enable it "
+      "only when all nodes in the cluster support the binary format",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      false)
+  , cloud_storage_max_connections_overdraft(
+      *this,
+      "cloud_storage_max_connections_overdraft",
+      "Max number of S3 connections per shard that can be opened on top of "
+      "cloud_storage_max_connections when requests wait for a connection for "
+      "longer than cloud_storage_connection_pool_scale_up_wait_ms, zero "
+      "disables the connection pool scaling",
+      {.needs_restart = needs_restart::yes, .visibility = visibility::tunable},
+      0)
+  , cloud_storage_connection_pool_scale_up_wait_ms(
+      *this,
+      "cloud_storage_connection_pool_scale_up_wait_ms",
+      "Time a request waits for an S3 connection before the connection pool "
+      "opens an extra one",
+      {.needs_restart = needs_restart::yes, .visibility = visibility::tunable},
+      100ms)
+  , cloud_storage_hedge_get_requests(
+      *this,
+      "cloud_storage_hedge_get_requests",
+      "Send a duplicate GET request for a segment using another connection "
+      "when the original request doesn't receive a response within the p99 "
+      "GET latency, and use the response that arrives first",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      false)
+  , cloud_storage_segment_compression(
+      *this,
+      "cloud_storage_segment_compression",
+      "Compress segments with zstd before uploading them to the cloud "
+      "storage. Segments are compressed in independent frames, so a range of "
+      "the segment can be read without downloading the whole object",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      false)
+  , cloud_storage_compression_frame_size(
+      *this,
+      "cloud_storage_compression_frame_size",
+      "Uncompressed size of the individual frame of the compressed segment, "
+      "the smallest unit of data that can be read from the compressed segment",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      1_MiB,
+      {.min = 64_KiB})
+  , cloud_storage_segment_merge_target_size(
+      *this,
+      "cloud_storage_segment_merge_target_size",
+      "Upload adjacent closed segments smaller than this as a single object "
+      "of up to this size. Small segments wait for the following segments to "
+      "be closed for up to cloud_storage_segment_merge_max_delay_ms. If not "
+      "set every segment is uploaded as a separate object",
+      {.needs_restart = needs_restart::no,
+       .example = "67108864",
+       .visibility = visibility::tunable},
+      std::nullopt)
+  , cloud_storage_segment_merge_max_delay_ms(
+      *this,
+      "cloud_storage_segment_merge_max_delay_ms",
+      "Max time a small segment waits for the following segments to be "
+      "merged into the same object before it is uploaded",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      10min)
+  , cloud_storage_max_concurrent_uploads(
+      *this,
+      "cloud_storage_max_concurrent_uploads",
+      "Max number of segment uploads in flight on the node, shared by all "
+      "partitions and split evenly between the shards. If not set every shard "
+      "runs up to cloud_storage_max_connections uploads",
+      {.needs_restart = needs_restart::yes, .visibility = visibility::tunable},
+      std::nullopt)
+  , cloud_storage_max_upload_bytes_in_flight(
+      *this,
+      "cloud_storage_max_upload_bytes_in_flight",
+      "Max total size of the segment uploads in flight on the node, split "
+      "evenly between the shards. Not limited if not set",
+      {.needs_restart = needs_restart::yes,
+       .example = "1073741824",
+       .visibility = visibility::tunable},
+      std::nullopt)
+  , cloud_storage_enable_remote_segment_merging(
+      *this,
+      "cloud_storage_enable_remote_segment_merging",
+      "Merge adjacent archived segments smaller than half of "
+      "cloud_storage_segment_merge_target_size into objects of up to that "
+      "size. The merged segments are deleted from the bucket afterwards",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      false)
   , superusers(
       *this,
       "superusers",
@@ -1241,6 +1838,15 @@ configuration::configuration()
       "batch",
       {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
       5_GiB)
+  , partition_autobalancing_max_load_imbalance_percent(
+      *this,
+      "partition_autobalancing_max_load_imbalance_percent",
+      "How much above the cluster average the produce and fetch load of a "
+      "node can be before autobalancer moves partitions away from it, 0 "
+      "disables load balancing",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      25,
+      {.min = 0, .max = 1000})
 
   , enable_leader_balancer(
       *this,
@@ -1273,6 +1879,14 @@ configuration::configuration()
       {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
       512,
       {.min = 1, .max = 2048})
+  , leader_balancer_load_aware(
+      *this,
+      "leader_balancer_load_aware",
+      "Weight leaders by the produce and fetch traffic of their partitions "
+      "when balancing leadership across shards, instead of balancing leader "
+      "counts",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      true)
   , internal_topic_replication_factor(
       *this,
       "internal_topic_replication_factor",
@@ -1321,6 +1935,14 @@ configuration::configuration()
       {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
       5_GiB,
       {.min = 10_MiB})
+  , storage_space_reclaim_enabled(
+      *this,
+      "storage_space_reclaim_enabled",
+      "Remove the oldest segments of topics with the delete cleanup policy, "
+      "beyond their retention settings, when the free disk space falls under "
+      "the storage space alert threshold",
+      {.needs_restart = needs_restart::no, .visibility = visibility::tunable},
+      false)
   , enable_metrics_reporter(
       *this,
       "enable_metrics_reporter",
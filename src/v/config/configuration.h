@@ -73,6 +73,12 @@ struct configuration final : public config_store {
     deprecated_property max_version;
     bounded_property<std::optional<size_t>> raft_max_recovery_memory;
     bounded_property<size_t> raft_recovery_default_read_size;
+    bounded_property<size_t> raft_recovery_max_inflight_requests;
+    property<bool> raft_recovery_skip_archived_prefix;
+    property<std::optional<std::chrono::milliseconds>>
+      raft_quiescence_timeout_ms;
+    property<bool> raft_enable_lease_reads;
+    property<std::chrono::milliseconds> raft_lease_max_clock_drift_ms;
     // Kafka
     deprecated_property use_scheduling_groups;
     deprecated_property enable_admin_api;
@@ -80,20 +86,28 @@ struct configuration final : public config_store {
     bounded_property<std::chrono::milliseconds> default_window_sec;
     property<std::chrono::milliseconds> quota_manager_gc_sec;
     bounded_property<uint32_t> target_quota_byte_rate;
+    property<std::optional<uint32_t>> target_quota_request_rate;
+    property<std::chrono::milliseconds> quota_manager_balancer_interval_ms;
     property<std::optional<ss::sstring>> cluster_id;
     property<bool> disable_metrics;
     property<bool> disable_public_metrics;
     property<bool> aggregate_metrics;
+    enum_property<model::partition_metrics_aggregation>
+      partition_metrics_aggregation;
     property<std::chrono::milliseconds> group_min_session_timeout_ms;
     property<std::chrono::milliseconds> group_max_session_timeout_ms;
     property<std::chrono::milliseconds> group_initial_rebalance_delay;
     property<std::chrono::milliseconds> group_new_member_join_timeout;
+    property<std::chrono::milliseconds> group_offset_commit_batch_window_ms;
+    property<std::chrono::milliseconds> group_metadata_snapshot_interval_ms;
+    property<std::chrono::milliseconds> group_standby_catchup_interval_ms;
     property<std::chrono::milliseconds> metadata_dissemination_interval_ms;
     property<std::chrono::milliseconds> metadata_dissemination_retry_delay_ms;
     property<int16_t> metadata_dissemination_retries;
     property<std::chrono::milliseconds> tm_sync_timeout_ms;
     enum_property<model::violation_recovery_policy>
       tm_violation_recovery_policy;
+    bounded_property<uint32_t> tm_marker_fanout_concurrency;
     property<std::chrono::milliseconds> rm_sync_timeout_ms;
     property<uint32_t> seq_table_min_size;
     property<std::chrono::milliseconds> tx_timeout_delay_ms;
@@ -112,12 +126,18 @@ struct configuration final : public config_store {
     property<std::chrono::milliseconds> transactional_id_expiration_ms;
     property<bool> enable_idempotence;
     property<bool> enable_transactions;
+    property<bool> enable_follower_fetching;
     property<uint32_t> abort_index_segment_size;
+    property<size_t> abort_index_cache_size;
     // same as log.retention.ms in kafka
     retention_duration_property delete_retention_ms;
     property<std::chrono::milliseconds> log_compaction_interval_ms;
     // same as retention.size in kafka - TODO: size not implemented
     property<std::optional<size_t>> retention_bytes;
+    // local retention of partitions uploaded to cloud storage
+    property<std::optional<size_t>> retention_local_target_bytes;
+    property<std::optional<std::chrono::milliseconds>>
+      retention_local_target_ms;
     property<int32_t> group_topic_partitions;
     property<int16_t> default_topic_replication;
     property<int16_t> transaction_coordinator_replication;
@@ -133,14 +153,22 @@ struct configuration final : public config_store {
     property<std::chrono::milliseconds> wait_for_leader_timeout_ms;
     property<int32_t> default_topic_partitions;
     property<bool> disable_batch_cache;
+    property<bool> batch_cache_segmented_lru;
+    property<std::optional<size_t>> batch_cache_max_read_lag_bytes;
     property<std::chrono::milliseconds> raft_election_timeout_ms;
     property<std::chrono::milliseconds> kafka_group_recovery_timeout_ms;
     property<std::chrono::milliseconds> replicate_append_timeout_ms;
     property<std::chrono::milliseconds> recovery_append_timeout_ms;
     property<size_t> raft_replicate_batch_window_size;
+    enum_property<model::replicate_batcher_policy> raft_replicate_batcher_policy;
+    property<std::chrono::milliseconds> raft_replicate_batcher_max_linger_ms;
     property<size_t> raft_learner_recovery_rate;
     property<std::optional<uint32_t>> raft_smp_max_non_local_requests;
     property<uint32_t> raft_max_concurrent_append_requests_per_follower;
+    property<size_t> raft_multi_append_max_requests;
+    property<size_t> raft_multi_vote_max_requests;
+    property<size_t> write_caching_max_unflushed_bytes;
+    bounded_property<std::chrono::milliseconds> write_caching_flush_interval_ms;
 
     property<size_t> reclaim_min_size;
     property<size_t> reclaim_max_size;
@@ -152,31 +180,46 @@ struct configuration final : public config_store {
     property<std::chrono::milliseconds> kvstore_flush_interval;
     property<size_t> kvstore_max_segment_size;
     property<std::chrono::milliseconds> max_kafka_throttle_delay_ms;
+    bounded_property<uint32_t> kafka_request_memory_reserve_percent;
     property<size_t> kafka_max_bytes_per_fetch;
+    property<bool> kafka_fetch_extent_reads_enabled;
+    property<uint32_t> kafka_connection_max_in_flight_requests;
     property<std::chrono::milliseconds> raft_io_timeout_ms;
     property<std::chrono::milliseconds> join_retry_timeout_ms;
     property<std::chrono::milliseconds> raft_timeout_now_timeout_ms;
     property<std::chrono::milliseconds>
       raft_transfer_leader_recovery_timeout_ms;
     property<bool> release_cache_on_segment_roll;
+    property<bool> release_index_on_segment_roll;
     property<std::chrono::milliseconds> segment_appender_flush_timeout_ms;
     property<std::chrono::milliseconds> fetch_session_eviction_timeout_ms;
     bounded_property<size_t> append_chunk_size;
     property<size_t> storage_read_buffer_size;
     property<int16_t> storage_read_readahead_count;
+    property<size_t> storage_idle_open_segment_files;
     property<size_t> segment_fallocation_step;
+    property<size_t> segment_recycle_pool_size;
+    property<size_t> segment_recovery_checkpoint_bytes;
     bounded_property<uint64_t> storage_target_replay_bytes;
     bounded_property<uint64_t> storage_max_concurrent_replay;
     bounded_property<uint64_t> storage_compaction_index_memory;
+    property<size_t> storage_compaction_key_map_memory;
+    property<std::optional<std::chrono::milliseconds>>
+      storage_compaction_tombstone_retention_ms;
+    property<bool> storage_flush_coalescing;
     property<size_t> max_compacted_log_segment_size;
     property<int16_t> id_allocator_log_capacity;
     property<int16_t> id_allocator_batch_size;
+    property<int16_t> id_allocator_local_range_size;
     property<bool> enable_sasl;
     property<std::optional<bool>> kafka_enable_authorization;
     property<std::optional<std::vector<ss::sstring>>>
       kafka_mtls_principal_mapping_rules;
     property<std::chrono::milliseconds>
       controller_backend_housekeeping_interval_ms;
+    property<size_t> controller_backend_reconciliation_concurrency;
+    property<bool> controller_backend_defer_follower_startup;
+    property<std::chrono::seconds> controller_snapshot_interval_sec;
     property<std::chrono::milliseconds> node_management_operation_timeout_ms;
     // Compaction controller
     property<std::chrono::milliseconds> compaction_ctrl_update_interval_ms;
@@ -186,13 +229,26 @@ struct configuration final : public config_store {
     property<int16_t> compaction_ctrl_min_shares;
     property<int16_t> compaction_ctrl_max_shares;
     property<std::optional<size_t>> compaction_ctrl_backlog_size;
+    property<std::optional<size_t>> compaction_ctrl_io_bandwidth;
+    property<std::chrono::milliseconds> compaction_ctrl_flush_latency_target_ms;
+    property<bool> io_share_ctrl_enabled;
+    property<std::chrono::milliseconds> io_share_ctrl_produce_latency_target_ms;
+    property<std::chrono::milliseconds> io_share_ctrl_fetch_latency_target_ms;
+    property<std::chrono::milliseconds> io_share_ctrl_update_interval_ms;
+    property<uint32_t> request_trace_sample_rate;
+    property<std::chrono::milliseconds> request_trace_slow_threshold_ms;
     property<std::chrono::milliseconds> members_backend_retry_ms;
+    bounded_property<size_t> partition_movement_max_concurrent_per_node;
+    property<std::optional<size_t>> partition_movement_bandwidth_limit;
     property<std::optional<uint32_t>> kafka_connections_max;
     property<std::optional<uint32_t>> kafka_connections_max_per_ip;
     property<std::vector<ss::sstring>> kafka_connections_max_overrides;
     bounded_property<std::optional<int>> kafka_rpc_server_tcp_recv_buf;
     bounded_property<std::optional<int>> kafka_rpc_server_tcp_send_buf;
     bounded_property<std::optional<size_t>> kafka_rpc_server_stream_recv_buf;
+    property<bool> kafka_connection_port_placement;
+    property<std::optional<std::chrono::milliseconds>>
+      kafka_connection_rebalance_interval_ms;
 
     // Archival storage
     property<bool> cloud_storage_enabled;
@@ -225,6 +281,8 @@ struct configuration final : public config_store {
     property<std::chrono::milliseconds>
       cloud_storage_readreplica_manifest_sync_timeout_ms;
     property<std::chrono::milliseconds> cloud_storage_metadata_sync_timeout_ms;
+    property<std::chrono::milliseconds>
+      cloud_storage_metadata_replication_interval_ms;
 
     // Archival upload controller
     property<std::chrono::milliseconds>
@@ -237,6 +295,29 @@ struct configuration final : public config_store {
     // Archival cache
     property<size_t> cloud_storage_cache_size;
     property<std::chrono::milliseconds> cloud_storage_cache_check_interval_ms;
+    property<bool> cloud_storage_cache_relaxed_durability;
+
+    // Tiered storage read-ahead
+    property<size_t> cloud_storage_prefetch_segments;
+    property<size_t> cloud_storage_prefetch_max_concurrency;
+    property<size_t> cloud_storage_prefetch_max_inflight_bytes;
+    property<std::optional<size_t>> cloud_storage_segment_chunk_size;
+    bounded_property<std::optional<size_t>>
+      cloud_storage_multipart_upload_part_size;
+    bounded_property<size_t> cloud_storage_multipart_upload_concurrency;
+    property<size_t> cloud_storage_recovery_max_concurrency;
+    property<bool> cloud_storage_manifest_binary_format;
+    property<size_t> cloud_storage_max_connections_overdraft;
+    property<std::chrono::milliseconds>
+      cloud_storage_connection_pool_scale_up_wait_ms;
+    property<bool> cloud_storage_hedge_get_requests;
+    property<bool> cloud_storage_segment_compression;
+    bounded_property<size_t> cloud_storage_compression_frame_size;
+    property<std::optional<size_t>> cloud_storage_segment_merge_target_size;
+    property<std::chrono::milliseconds> cloud_storage_segment_merge_max_delay_ms;
+    property<std::optional<size_t>> cloud_storage_max_concurrent_uploads;
+    property<std::optional<size_t>> cloud_storage_max_upload_bytes_in_flight;
+    property<bool> cloud_storage_enable_remote_segment_merging;
 
     one_or_many_property<ss::sstring> superusers;
 
@@ -265,12 +346,15 @@ struct configuration final : public config_store {
     property<std::chrono::milliseconds>
       partition_autobalancing_tick_interval_ms;
     property<size_t> partition_autobalancing_movement_batch_size_bytes;
+    bounded_property<unsigned>
+      partition_autobalancing_max_load_imbalance_percent;
 
     property<bool> enable_leader_balancer;
     property<std::chrono::milliseconds> leader_balancer_idle_timeout;
     property<std::chrono::milliseconds> leader_balancer_mute_timeout;
     property<std::chrono::milliseconds> leader_balancer_node_mute_timeout;
     bounded_property<size_t> leader_balancer_transfer_limit_per_shard;
+    property<bool> leader_balancer_load_aware;
     property<int> internal_topic_replication_factor;
     property<std::chrono::milliseconds> health_manager_tick_interval;
 
@@ -280,6 +364,7 @@ struct configuration final : public config_store {
     bounded_property<unsigned> storage_space_alert_free_threshold_percent;
     bounded_property<size_t> storage_space_alert_free_threshold_bytes;
     bounded_property<size_t> storage_min_free_bytes;
+    property<bool> storage_space_reclaim_enabled;
     // metrics reporter
     property<bool> enable_metrics_reporter;
     property<std::chrono::milliseconds> metrics_reporter_tick_interval;
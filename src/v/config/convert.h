@@ -314,4 +314,46 @@ struct convert<model::partition_autobalancing_mode> {
     }
 };
 
+template<>
+struct convert<model::replicate_batcher_policy> {
+    using type = model::replicate_batcher_policy;
+    static Node encode(const type& rhs) { return Node(fmt::format("{}", rhs)); }
+    static bool decode(const Node& node, type& rhs) {
+        auto value = node.as<std::string>();
+
+        if (value == "fixed") {
+            rhs = model::replicate_batcher_policy::fixed;
+        } else if (value == "latency_first") {
+            rhs = model::replicate_batcher_policy::latency_first;
+        } else if (value == "throughput_first") {
+            rhs = model::replicate_batcher_policy::throughput_first;
+        } else {
+            return false;
+        }
+
+        return true;
+    }
+};
+
+template<>
+struct convert<model::partition_metrics_aggregation> {
+    using type = model::partition_metrics_aggregation;
+    static Node encode(const type& rhs) { return Node(fmt::format("{}", rhs)); }
+    static bool decode(const Node& node, type& rhs) {
+        auto value = node.as<std::string>();
+
+        if (value == "partition") {
+            rhs = model::partition_metrics_aggregation::partition;
+        } else if (value == "topic") {
+            rhs = model::partition_metrics_aggregation::topic;
+        } else if (value == "node") {
+            rhs = model::partition_metrics_aggregation::node;
+        } else {
+            return false;
+        }
+
+        return true;
+    }
+};
+
 } // namespace YAML
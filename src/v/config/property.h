@@ -421,6 +421,12 @@ consteval std::string_view property_type_name() {
                            type,
                            model::partition_autobalancing_mode>) {
         return "partition_autobalancing_mode";
+    } else if constexpr (std::is_same_v<type, model::replicate_batcher_policy>) {
+        return "string";
+    } else if constexpr (std::is_same_v<
+                           type,
+                           model::partition_metrics_aggregation>) {
+        return "string";
     } else if constexpr (std::is_floating_point_v<type>) {
         return "number";
     } else if constexpr (std::is_integral_v<type>) {
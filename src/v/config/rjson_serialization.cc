@@ -60,6 +60,11 @@ void rjson_serialize_impl(
         w.Key("truststore_file");
         w.String((*(v.get_truststore_file())).c_str());
     }
+
+    if (v.get_cipher_priority()) {
+        w.Key("cipher_priority");
+        w.String((*(v.get_cipher_priority())).c_str());
+    }
 }
 
 void rjson_serialize(
@@ -156,4 +161,15 @@ void rjson_serialize(
     stringize(w, v);
 }
 
+void rjson_serialize(
+  json::Writer<json::StringBuffer>& w, const model::replicate_batcher_policy& v) {
+    stringize(w, v);
+}
+
+void rjson_serialize(
+  json::Writer<json::StringBuffer>& w,
+  const model::partition_metrics_aggregation& v) {
+    stringize(w, v);
+}
+
 } // namespace json
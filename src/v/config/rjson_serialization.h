@@ -72,4 +72,11 @@ void rjson_serialize(
   json::Writer<json::StringBuffer>& w,
   const model::partition_autobalancing_mode& v);
 
+void rjson_serialize(
+  json::Writer<json::StringBuffer>& w, const model::replicate_batcher_policy& v);
+
+void rjson_serialize(
+  json::Writer<json::StringBuffer>& w,
+  const model::partition_metrics_aggregation& v);
+
 } // namespace json
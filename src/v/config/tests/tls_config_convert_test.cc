@@ -47,6 +47,26 @@ SEASTAR_THREAD_TEST_CASE(test_decode_full_abs_path) {
     BOOST_TEST(full_cfg.get_require_client_auth());
 }
 
+SEASTAR_THREAD_TEST_CASE(test_decode_cipher_priority) {
+    auto with_values = "tls_config:\n"
+                       "  enabled: true\n"
+                       "  cert_file: /fake/cret_file.crt\n"
+                       "  key_file: /fake/key_file.key\n"
+                       "  cipher_priority: "
+                       "\"NORMAL:-CIPHER-ALL:+AES-128-GCM\"\n";
+    auto cfg = read_from_yaml(with_values);
+    BOOST_TEST(cfg.is_enabled());
+    BOOST_TEST(*cfg.get_cipher_priority() == "NORMAL:-CIPHER-ALL:+AES-128-GCM");
+
+    auto node = YAML::convert<config::tls_config>::encode(cfg);
+    BOOST_TEST(
+      node["cipher_priority"].as<ss::sstring>()
+      == "NORMAL:-CIPHER-ALL:+AES-128-GCM");
+
+    auto defaults = read_from_yaml("tls_config:\n  enabled: true\n");
+    BOOST_TEST(!defaults.get_cipher_priority());
+}
+
 SEASTAR_THREAD_TEST_CASE(test_decode_full_rel_path) {
     auto with_values = "tls_config:\n"
                        "  enabled: true\n"
@@ -56,11 +56,13 @@ public:
       bool enabled,
       std::optional<key_cert> key_cert,
       std::optional<ss::sstring> truststore,
-      bool require_client_auth)
+      bool require_client_auth,
+      std::optional<ss::sstring> cipher_priority = std::nullopt)
       : _enabled(enabled)
       , _key_cert(std::move(key_cert))
       , _truststore_file(std::move(truststore))
-      , _require_client_auth(require_client_auth) {}
+      , _require_client_auth(require_client_auth)
+      , _cipher_priority(std::move(cipher_priority)) {}
 
     bool is_enabled() const { return _enabled; }
 
@@ -74,6 +76,13 @@ public:
 
     bool get_require_client_auth() const { return _require_client_auth; }
 
+    /// GnuTLS priority string restricting the negotiated protocol versions
+    /// and cipher suites, e.g. to prefer a cheaper AEAD cipher. When not set
+    /// the GnuTLS defaults apply.
+    const std::optional<ss::sstring>& get_cipher_priority() const {
+        return _cipher_priority;
+    }
+
     ss::future<std::optional<ss::tls::credentials_builder>>
     get_credentials_builder() const& {
         if (_enabled) {
@@ -81,6 +90,9 @@ public:
               ss::tls::credentials_builder{},
               [this](ss::tls::credentials_builder& builder) {
                   builder.set_dh_level(ss::tls::dh_params::level::MEDIUM);
+                  if (_cipher_priority) {
+                      builder.set_priority_string(*_cipher_priority);
+                  }
                   if (_require_client_auth) {
                       builder.set_client_auth(ss::tls::client_auth::REQUIRE);
                   }
@@ -130,8 +142,8 @@ public:
           << "enabled: " << c.is_enabled() << " "
           << "key/cert files: " << c.get_key_cert_files() << " "
           << "ca file: " << c.get_truststore_file() << " "
-          << "client_auth_required: " << c.get_require_client_auth() << ""
-          << " }";
+          << "client_auth_required: " << c.get_require_client_auth() << " "
+          << "cipher_priority: " << c.get_cipher_priority() << " }";
         return o;
     }
 
@@ -140,6 +152,7 @@ private:
     std::optional<key_cert> _key_cert;
     std::optional<ss::sstring> _truststore_file;
     bool _require_client_auth{false};
+    std::optional<ss::sstring> _cipher_priority;
 };
 
 } // namespace config
@@ -179,6 +192,10 @@ struct convert<config::tls_config> {
             node["truststore_file"] = *rhs.get_truststore_file();
         }
 
+        if (rhs.get_cipher_priority()) {
+            node["cipher_priority"] = *rhs.get_cipher_priority();
+        }
+
         return node;
     }
 
@@ -212,7 +229,8 @@ struct convert<config::tls_config> {
               key_cert,
               to_absolute(read_optional(node, "truststore_file")),
               node["require_client_auth"]
-                && node["require_client_auth"].as<bool>());
+                && node["require_client_auth"].as<bool>(),
+              read_optional(node, "cipher_priority"));
         }
         return true;
     }
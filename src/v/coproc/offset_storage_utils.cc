@@ -50,10 +50,20 @@ ss::future<all_routes> recover_offsets(storage::simple_snapshot_manager& snap) {
 
 ss::future<>
 save_offsets(storage::simple_snapshot_manager& snap, all_routes routes) {
-    /// Create the metadata, and data iobuffers
-    iobuf metadata = reflection::to_iobuf(static_cast<int8_t>(1));
+    return serialize_offsets(std::move(routes)).then([&snap](iobuf data) {
+        return save_offsets(snap, std::move(data));
+    });
+}
+
+ss::future<iobuf> serialize_offsets(all_routes routes) {
     iobuf data;
     co_await reflection::async_adl<all_routes>{}.to(data, std::move(routes));
+    co_return data;
+}
+
+ss::future<> save_offsets(storage::simple_snapshot_manager& snap, iobuf data) {
+    /// Create the metadata, and data iobuffers
+    iobuf metadata = reflection::to_iobuf(static_cast<int8_t>(1));
 
     /// Serialize this to disk via the simple_snapshot_manager
     storage::snapshot_writer writer = co_await snap.start_snapshot();
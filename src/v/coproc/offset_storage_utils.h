@@ -32,4 +32,10 @@ ss::future<all_routes> recover_offsets(storage::simple_snapshot_manager&);
 /// Writes all offsets to disk using the snapshot manager
 ss::future<> save_offsets(storage::simple_snapshot_manager&, all_routes);
 
+/// Serialized form of the offsets, as written to disk by 'save_offsets'
+ss::future<iobuf> serialize_offsets(all_routes);
+
+/// Writes offsets serialized with 'serialize_offsets' to disk
+ss::future<> save_offsets(storage::simple_snapshot_manager&, iobuf);
+
 } // namespace coproc
@@ -55,11 +55,24 @@ void pacemaker::save_routes() {
         for (auto& [id, script] : _scripts) {
             routes.emplace(id, script->get_routes());
         }
-        return save_offsets(_offs.snap, std::move(routes)).then([this] {
-            if (!_offs.timer.armed()) {
-                _offs.timer.arm(_offs.duration);
-            }
-        });
+        return serialize_offsets(std::move(routes))
+          .then([this](iobuf data) {
+              /// Idle scripts don't move their offsets, skip rewriting the
+              /// same snapshot every interval
+              if (data == _offs.last_saved) {
+                  return ss::now();
+              }
+              auto saved = data.copy();
+              return save_offsets(_offs.snap, std::move(data))
+                .then([this, saved = std::move(saved)]() mutable {
+                    _offs.last_saved = std::move(saved);
+                });
+          })
+          .then([this] {
+              if (!_offs.timer.armed()) {
+                  _offs.timer.arm(_offs.duration);
+              }
+          });
     });
 }
 
@@ -190,6 +190,8 @@ private:
         ss::timer<ss::lowres_clock> timer;
         model::timeout_clock::duration duration;
         storage::simple_snapshot_manager snap;
+        /// Offsets of the last snapshot written
+        iobuf last_saved;
 
         static ss::sstring snapshot_filename() {
             return fmt::format(
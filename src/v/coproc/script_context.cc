@@ -26,6 +26,7 @@
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/sleep.hh>
+#include <seastar/core/when_all.hh>
 
 #include <chrono>
 #include <exception>
@@ -123,6 +124,8 @@ ss::future<> script_context::do_execute() {
 void script_context::notify_waiters() {
     auto updates = std::exchange(_updates, {});
     for (auto& [ntp, update] : updates) {
+        /// Data read ahead may belong to the input being replaced
+        _read_ahead.erase(ntp);
         errc e = update->handle(ntp, _routes);
         for (auto& p : update->ps) {
             p.set_value(e);
@@ -140,17 +143,21 @@ ss::future<errc> script_context::remove_output(
     return entry->ps.back().get_future();
 }
 
-ss::future<ss::stop_iteration>
-script_context::process_send_write(rpc::transport* t) {
-    /// Read batch of data
-    input_read_args args{
+input_read_args script_context::make_input_read_args() {
+    return input_read_args{
       .id = _id,
       .read_sem = _resources.read_sem,
       .abort_src = _abort_source,
-      .inputs = _routes};
+      .inputs = _routes,
+      .read_ahead = _read_ahead};
+}
+
+ss::future<ss::stop_iteration>
+script_context::process_send_write(rpc::transport* t) {
+    /// Read batch of data
     input_read_results requests;
     try {
-        requests = co_await read_from_inputs(args);
+        requests = co_await read_from_inputs(make_input_read_args());
     } catch (const partition_shutdown_exception& ex) {
         _routes.erase(ex.ntp());
         vlog(
@@ -159,6 +166,15 @@ script_context::process_send_write(rpc::transport* t) {
     if (requests.empty()) {
         co_return ss::stop_iteration::yes;
     }
+    /// Read the next batch of data while this one is processed
+    auto [sent, _] = co_await ss::when_all(
+      send_write(t, std::move(requests)),
+      read_ahead_inputs(make_input_read_args()));
+    co_return sent.get0();
+}
+
+ss::future<ss::stop_iteration>
+script_context::send_write(rpc::transport* t, input_read_results requests) {
     /// Send request to wasm engine
     process_batch_request req{.reqs = std::move(requests)};
     supervisor_client_protocol client(*t);
@@ -213,6 +229,7 @@ ss::future<errc> script_context::stop_processing_ntp(const model::ntp& ntp) {
 ss::future<> script_context::shutdown() {
     _abort_source.request_abort();
     co_await _gate.close();
+    _read_ahead.clear();
     auto updates = std::exchange(_updates, {});
     for (auto& [ntp, update] : updates) {
         for (auto& p : update->ps) {
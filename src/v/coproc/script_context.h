@@ -13,6 +13,7 @@
 
 #include "coproc/errc.h"
 #include "coproc/exception.h"
+#include "coproc/script_context_frontend.h"
 #include "coproc/script_context_router.h"
 #include "coproc/shared_script_resources.h"
 #include "coproc/supervisor.h"
@@ -41,6 +42,10 @@ class wait_future_stranded final : public exception {
  * performed in sync, meaning that for each read -> send -> write that occurs
  * within the run loop, those actions will occur in order.
  *
+ * To keep the fiber from idling while the wasm engine processes a request,
+ * the next window of the inputs is read ahead during the round trip, within
+ * the bounds of the shared read semaphore.
+ *
  * Since each script_context has one of these fibers of its own, no one context
  * will wait for work to be finished by another in order to continue making
  * progress. They all operate independently of eachother.
@@ -115,6 +120,9 @@ private:
     void notify_waiters();
 
     ss::future<ss::stop_iteration> process_send_write(rpc::transport*);
+    ss::future<ss::stop_iteration>
+    send_write(rpc::transport*, input_read_results);
+    input_read_args make_input_read_args();
 
 private:
     /// State to track in-progress ntp modifications
@@ -162,6 +170,9 @@ private:
     /// when all outputs are up to date.
     routes_t _routes;
 
+    /// Inputs read while the previous read was being processed
+    read_ahead_t _read_ahead;
+
     /// Uniquely identifying script id. Generated by coproc engine
     script_id _id;
 };
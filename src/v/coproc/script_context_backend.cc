@@ -22,6 +22,8 @@
 #include "storage/log.h"
 #include "storage/log_manager.h"
 #include "storage/parser_utils.h"
+#include "units.h"
+#include "utils/vint.h"
 #include "vlog.h"
 
 #include <seastar/core/coroutine.hh>
@@ -86,6 +88,97 @@ private:
     bool _is_consistent{true};
 };
 
+/// Merges consecutive small batches into batches of up to max_bytes.
+///
+/// Wasm engines may reply with many tiny batches, e.g. for filtering
+/// transforms, and every batch costs a header, a compression frame and an
+/// append to the materialized log. Record timestamps are kept, only batches
+/// that are plain uncompressed data are merged.
+class coalesce_batches {
+public:
+    static constexpr size_t max_bytes = 128_KiB;
+
+    ss::future<ss::stop_iteration> operator()(model::record_batch& b) {
+        if (!can_merge(b)) {
+            flush();
+            _batches.push_back(std::move(b));
+            co_return ss::stop_iteration::no;
+        }
+        if (
+          _record_count > 0
+          && _records.size_bytes() + b.data().size_bytes() > max_bytes) {
+            flush();
+        }
+        append(b);
+        co_return ss::stop_iteration::no;
+    }
+
+    model::record_batch_reader end_of_stream() {
+        flush();
+        return model::make_memory_record_batch_reader(std::move(_batches));
+    }
+
+private:
+    static bool can_merge(const model::record_batch& b) {
+        const auto& hdr = b.header();
+        return !b.compressed()
+               && hdr.type == model::record_batch_type::raft_data
+               && !hdr.attrs.is_control() && !hdr.attrs.is_transactional()
+               && hdr.producer_id < 0;
+    }
+
+    void append(const model::record_batch& b) {
+        if (_record_count == 0) {
+            _header = b.header();
+        }
+        const auto base_ts = b.header().first_timestamp.value();
+        b.for_each_record([this, base_ts](model::record r) {
+            const int64_t ts_delta = base_ts + r.timestamp_delta()
+                                     - _header.first_timestamp.value();
+            const int32_t offset_delta = _record_count++;
+            /// Only the encoding of the deltas changes size
+            const auto size = r.size_bytes()
+                              - vint::vint_size(r.timestamp_delta())
+                              - vint::vint_size(r.offset_delta())
+                              + vint::vint_size(ts_delta)
+                              + vint::vint_size(offset_delta);
+            model::append_record_to_buffer(
+              _records,
+              model::record(
+                static_cast<int32_t>(size),
+                r.attributes(),
+                ts_delta,
+                offset_delta,
+                r.key_size(),
+                r.release_key(),
+                r.value_size(),
+                r.release_value(),
+                std::move(r.headers())));
+        });
+        _header.max_timestamp = std::max(
+          _header.max_timestamp, b.header().max_timestamp);
+    }
+
+    void flush() {
+        if (_record_count == 0) {
+            return;
+        }
+        _header.record_count = _record_count;
+        _header.last_offset_delta = _record_count - 1;
+        storage::internal::reset_size_checksum_metadata(_header, _records);
+        _batches.emplace_back(
+          _header,
+          std::exchange(_records, iobuf{}),
+          model::record_batch::tag_ctor_ng{});
+        _record_count = 0;
+    }
+
+    model::record_batch_header _header{};
+    iobuf _records;
+    int32_t _record_count{0};
+    model::record_batch_reader::data_t _batches;
+};
+
 static ss::future<> do_write_materialized_partition(
   ss::lw_shared_ptr<partition> p, model::record_batch_reader reader) {
     /// Re-write all batch term_ids to 1, otherwise they will carry the
@@ -107,8 +200,10 @@ static ss::future<> do_write_materialized_partition(
           "Wasm engine returned malformatted batch/header");
     }
 
-    /// Compress the data before writing...
-    auto compressed = co_await std::move(batch_w_correct_terms)
+    /// Coalesce small batches and compress the data before writing...
+    auto coalesced = co_await std::move(batch_w_correct_terms)
+                       .for_each_ref(coalesce_batches(), model::no_timeout);
+    auto compressed = co_await std::move(coalesced)
                         .for_each_ref(
                           storage::internal::compress_batch_consumer(
                             model::compression::zstd, 512),
@@ -93,41 +93,89 @@ storage::log_reader_config get_reader(
       abort_src);
 }
 
+/// Last offset read and the data read
+using window_t = std::pair<model::offset, model::record_batch_reader>;
+
+/// Reads the given window, returns nullopt if there was nothing to read
+static ss::future<std::optional<window_t>>
+read_window(cluster::partition& input, storage::log_reader_config cfg) {
+    auto rbr = co_await input.make_reader(cfg);
+    auto read_result = co_await std::move(rbr).for_each_ref(
+      coproc::reference_window_consumer(
+        high_offset_tracker(), storage::internal::decompress_batch_consumer()),
+      model::no_timeout);
+    auto& [info, nrbr] = read_result;
+    if (info.size == 0) {
+        co_return std::nullopt;
+    }
+    co_return std::make_pair(info.last, std::move(nrbr));
+}
+
 ss::future<std::optional<process_batch_request::data>>
 read_ntp(input_read_args args, ss::lw_shared_ptr<source> ctx) {
     storage::log_reader_config cfg = get_reader(
       args.abort_src, ctx->rctx, ctx->wctx);
+    auto ntp = ctx->rctx.input->ntp();
     try {
-        auto rbr = co_await ctx->rctx.input->make_reader(cfg);
-        auto read_result = co_await std::move(rbr).for_each_ref(
-          coproc::reference_window_consumer(
-            high_offset_tracker(),
-            storage::internal::decompress_batch_consumer()),
-          model::no_timeout);
-        auto& [info, nrbr] = read_result;
-        if (info.size > 0) {
-            ctx->rctx.last_read = info.last + model::offset{1};
+        auto read = co_await read_window(*ctx->rctx.input, cfg);
+        if (read) {
+            ctx->rctx.last_read = read->first + model::offset{1};
             co_return process_batch_request::data{
               .ids = std::vector<script_id>{args.id},
-              .ntp = ctx->rctx.input->ntp(),
-              .reader = std::move(nrbr)};
+              .ntp = std::move(ntp),
+              .reader = std::move(read->second)};
         }
     } catch (const ss::gate_closed_exception&) {
         throw partition_shutdown_exception(
-          ctx->rctx.input->ntp(),
+          ntp,
           fmt::format(
             "Partition {} shutdown while script {} was attempting to read",
-            ctx->rctx.input->ntp(),
+            ntp,
             args.id));
     }
     co_return std::nullopt;
 }
 
+/// Takes the read ahead of the input, if it is what would have been read now,
+/// i.e. the previous read was processed successfully and it doesn't go beyond
+/// the window of a retry. Otherwise it is dropped.
+static std::optional<process_batch_request::data>
+take_read_ahead(const input_read_args& args, source& ctx) {
+    auto found = args.read_ahead.find(ctx.rctx.input->ntp());
+    if (found == args.read_ahead.end()) {
+        return std::nullopt;
+    }
+    auto ra = std::move(found->second);
+    args.read_ahead.erase(found);
+    auto cfg = get_reader(args.abort_src, ctx.rctx, ctx.wctx);
+    if (ra.start != cfg.start_offset || ra.last > cfg.max_offset) {
+        return std::nullopt;
+    }
+    ctx.rctx.last_read = ra.last + model::offset{1};
+    return process_batch_request::data{
+      .ids = std::vector<script_id>{args.id},
+      .ntp = ctx.rctx.input->ntp(),
+      .reader = std::move(ra.reader)};
+}
+
+/// Releases the reads ahead of inputs that are no longer routed
+static void drop_removed_inputs(const input_read_args& args) {
+    absl::erase_if(args.read_ahead, [&args](const read_ahead_t::value_type& p) {
+        return !args.inputs.contains(p.first);
+    });
+}
+
 ss::future<std::vector<process_batch_request::data>>
 read_from_inputs(input_read_args args) {
+    drop_removed_inputs(args);
     std::vector<process_batch_request::data> requests;
     requests.reserve(args.inputs.size());
     auto read_all = [args, &requests](const routes_t::value_type& p) {
+        /// Read ahead data already holds its semaphore units
+        if (auto request = take_read_ahead(args, *p.second)) {
+            requests.push_back(std::move(*request));
+            return ss::now();
+        }
         return ss::with_semaphore(
                  args.read_sem,
                  max_batch_size(),
@@ -142,4 +190,60 @@ read_from_inputs(input_read_args args) {
     co_return requests;
 }
 
+ss::future<> read_ahead_inputs(input_read_args args) {
+    drop_removed_inputs(args);
+    auto read_one = [_args{args}](
+                      const routes_t::value_type& p) -> ss::future<> {
+        auto args{_args};
+        auto ctx = p.second;
+        /// Only inputs with a read in progress, the next read of the others
+        /// doesn't start from their last read offset
+        if (
+          args.read_ahead.contains(p.first)
+          || ctx->rctx.last_read <= ctx->rctx.last_acked) {
+            co_return;
+        }
+        auto start = ctx->rctx.last_read;
+        auto end = ctx->rctx.input->last_stable_offset();
+        if (start > end) {
+            co_return;
+        }
+        auto units = ss::try_get_units(args.read_sem, max_batch_size());
+        if (!units) {
+            co_return;
+        }
+        try {
+            auto read = co_await read_window(
+              *ctx->rctx.input,
+              storage::log_reader_config(
+                start,
+                end,
+                1,
+                max_batch_size(),
+                ss::default_priority_class(),
+                model::record_batch_type::raft_data,
+                std::nullopt,
+                args.abort_src));
+            if (read) {
+                args.read_ahead.emplace(
+                  ctx->rctx.input->ntp(),
+                  read_ahead{
+                    .start = start,
+                    .last = read->first,
+                    .reader = std::move(read->second),
+                    .units = std::move(*units)});
+            }
+        } catch (...) {
+            /// The regular read will hit the error again if it persists
+            vlog(
+              coproclog.debug,
+              "Failed to read ahead {} for script {}: {}",
+              ctx->rctx.input->ntp(),
+              args.id,
+              std::current_exception());
+        }
+    };
+    co_await ss::parallel_for_each(args.inputs, std::move(read_one));
+}
+
 } // namespace coproc
@@ -13,24 +13,41 @@
 
 #include "coproc/script_context_router.h"
 #include "coproc/types.h"
+#include "ssx/semaphore.h"
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/shared_ptr.hh>
 
 #include <absl/container/flat_hash_map.h>
+#include <absl/container/node_hash_map.h>
 
 namespace coproc {
 /// Type of result to expect from 'read_from_inputs', to be immeadiately
 /// dispatched to a wasm engine
 using input_read_results = std::vector<process_batch_request::data>;
 
+/// Data read from an input before its previous read was processed
+struct read_ahead {
+    /// Offset the read started from
+    model::offset start;
+    /// Last offset read
+    model::offset last;
+    model::record_batch_reader reader;
+    /// Held from \ref input_read_args::read_sem while the data is in memory
+    ssx::semaphore_units units;
+};
+
+/// Reads ahead per input ntp, consumed by the next 'read_from_inputs'
+using read_ahead_t = absl::node_hash_map<model::ntp, read_ahead>;
+
 /// Arugments to pass to 'read_from_inputs', trivially copyable
 struct input_read_args {
     script_id id;
     ssx::semaphore& read_sem;
     ss::abort_source& abort_src;
     routes_t& inputs;
+    read_ahead_t& read_ahead;
 };
 
 /**
@@ -43,4 +60,17 @@ struct input_read_args {
  * @return list of process_batch_requests to be sent to the wasm engine
  */
 ss::future<input_read_results> read_from_inputs(input_read_args);
+
+/**
+ * Reads the next window of the inputs that have a read in progress, i.e. from
+ * their last read offset, so that the data is ready once the in progress read
+ * has been processed. Meant to run while the wasm engine processes the
+ * current read.
+ *
+ * Doesn't modify the routes, reads are kept in \ref input_read_args::read_ahead
+ * and only used by 'read_from_inputs' if they start where it would have read
+ * from. Inputs are skipped when \ref input_read_args::read_sem has no units
+ * left, so that reading ahead never delays reads. Never throws.
+ */
+ss::future<> read_ahead_inputs(input_read_args);
 } // namespace coproc
@@ -12,11 +12,13 @@
 #include "coproc/tests/utils/coprocessor.h"
 #include "coproc/types.h"
 #include "model/fundamental.h"
+#include "units.h"
 
 #include <seastar/core/when_all.hh>
 
 #include <boost/test/tools/old/interface.hpp>
 #include <boost/test/unit_test_log.hpp>
+#include <fmt/format.h>
 
 using copro_typeid = coproc::registry::type_identifier;
 
@@ -139,3 +141,46 @@ FIXTURE_TEST(test_coproc_router_giant_one_to_many, coproc_bench_fixture) {
       total_records_across_partitions(consume_results),
       expected_record_batches);
 }
+
+/// End to end transform benchmarks, through the script contexts, the
+/// supervisor RPC and the materialized writes. Results are reported as test
+/// messages, run with --log_level=message to see them.
+static void run_transform_bench(
+  coproc_bench_fixture& fixture,
+  coproc_bench_fixture::transform_bench_params p) {
+    auto r = fixture.run_transform_bench(p).get();
+    BOOST_TEST_MESSAGE(fmt::format(
+      "scripts: {}, partitions: {}, batches: {}, records per batch: {}, "
+      "record size: {}b - {:.0f} records/s, {:.2f} MiB/s, batch latency "
+      "p50: {}us, p99: {}us",
+      p.n_scripts,
+      p.n_partitions,
+      p.batches_per_partition,
+      p.records_per_batch,
+      p.record_size,
+      r.records_per_second(),
+      r.mib_per_second(),
+      r.batch_latency.get_value_at(50.0),
+      r.batch_latency.get_value_at(99.0)));
+    BOOST_CHECK_EQUAL(
+      r.records,
+      p.n_scripts * p.n_partitions * p.batches_per_partition
+        * p.records_per_batch);
+}
+
+FIXTURE_TEST(test_transform_bench_small_records, coproc_bench_fixture) {
+    run_transform_bench(*this, {.records_per_batch = 100, .record_size = 64});
+}
+
+FIXTURE_TEST(test_transform_bench_large_records, coproc_bench_fixture) {
+    run_transform_bench(*this, {.records_per_batch = 4, .record_size = 64_KiB});
+}
+
+FIXTURE_TEST(test_transform_bench_large_batches, coproc_bench_fixture) {
+    run_transform_bench(*this, {.records_per_batch = 1000, .record_size = 128});
+}
+
+FIXTURE_TEST(test_transform_bench_many_scripts, coproc_bench_fixture) {
+    run_transform_bench(
+      *this, {.n_scripts = 10, .n_partitions = 4, .records_per_batch = 10});
+}
@@ -12,6 +12,12 @@
 #include "coproc/tests/fixtures/coproc_bench_fixture.h"
 
 #include "coproc/tests/utils/batch_utils.h"
+#include "coproc/tests/utils/coprocessor.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
+
+#include <boost/range/irange.hpp>
 
 #include <chrono>
 
@@ -52,3 +58,96 @@ coproc_bench_fixture::consume_all(router_test_plan::plan_t outputs) {
     }
     co_return results;
 }
+
+double
+coproc_bench_fixture::transform_bench_results::records_per_second() const {
+    auto seconds = std::chrono::duration<double>(elapsed).count();
+    return seconds > 0 ? records / seconds : 0;
+}
+
+double coproc_bench_fixture::transform_bench_results::mib_per_second() const {
+    auto seconds = std::chrono::duration<double>(elapsed).count();
+    return seconds > 0 ? bytes / seconds / (1024 * 1024) : 0;
+}
+
+ss::future<std::pair<std::size_t, std::size_t>>
+coproc_bench_fixture::consume_outputs(
+  absl::flat_hash_map<model::ntp, model::offset>& next, std::size_t records) {
+    std::size_t n_records = 0;
+    std::size_t n_bytes = 0;
+    for (auto& [ntp, offset] : next) {
+        auto timeout = model::timeout_clock::now() + std::chrono::minutes(1);
+        auto data = co_await consume(ntp, records, offset, timeout);
+        vassert(
+          num_records(data) >= records,
+          "Timed out consuming {} records from {}",
+          records,
+          ntp);
+        for (const auto& b : data) {
+            n_bytes += b.size_bytes();
+        }
+        n_records += num_records(data);
+        offset = data.back().last_offset() + model::offset{1};
+    }
+    co_return std::make_pair(n_records, n_bytes);
+}
+
+ss::future<coproc_bench_fixture::transform_bench_results>
+coproc_bench_fixture::run_transform_bench(transform_bench_params p) {
+    using copro_typeid = coproc::registry::type_identifier;
+    const model::topic input("bench_input");
+    co_await setup({{input, p.n_partitions}});
+
+    std::vector<coproc_test_fixture::deploy> deploys;
+    absl::flat_hash_map<model::ntp, model::offset> next;
+    for (uint64_t id = 0; id < p.n_scripts; ++id) {
+        deploys.push_back(
+          {.id = id,
+           .data{
+             .tid = copro_typeid::unique_identity_coprocessor,
+             .topics = {std::make_pair<>(
+               input, coproc::topic_ingestion_policy::earliest)}}});
+        auto output = to_materialized_topic(
+          input, model::topic(ssx::sformat("identity_topic_{}", id)));
+        for (auto i : boost::irange<std::size_t>(0, p.n_partitions)) {
+            model::ntp ntp(
+              model::kafka_namespace, output, model::partition_id(i));
+            next.emplace(std::move(ntp), model::offset{0});
+        }
+    }
+    co_await enable_coprocessors(std::move(deploys));
+
+    transform_bench_results results;
+
+    /// One batch at a time, on every partition
+    for (std::size_t i = 0; i < p.latency_samples; ++i) {
+        auto m = results.batch_latency.auto_measure();
+        co_await ss::parallel_for_each(
+          boost::irange<std::size_t>(0, p.n_partitions),
+          [this, &input, &p](std::size_t pid) {
+              return produce(
+                model::ntp(
+                  model::kafka_namespace, input, model::partition_id(pid)),
+                make_sized_batches(1, p.records_per_batch, p.record_size));
+          });
+        co_await consume_outputs(next, p.records_per_batch);
+    }
+
+    /// All the batches at once
+    auto start = std::chrono::steady_clock::now();
+    co_await ss::parallel_for_each(
+      boost::irange<std::size_t>(0, p.n_partitions),
+      [this, &input, &p](std::size_t pid) {
+          return produce(
+            model::ntp(model::kafka_namespace, input, model::partition_id(pid)),
+            make_sized_batches(
+              p.batches_per_partition, p.records_per_batch, p.record_size));
+      });
+    auto [records, bytes] = co_await consume_outputs(
+      next, p.batches_per_partition * p.records_per_batch);
+    results.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+    results.records = records;
+    results.bytes = bytes;
+    co_return results;
+}
@@ -13,6 +13,9 @@
 
 #include "coproc/tests/fixtures/coproc_test_fixture.h"
 #include "coproc/types.h"
+#include "utils/hdr_hist.h"
+
+#include <chrono>
 
 /// This harness brings up an entire redpanda fixture + the c++ implementation
 /// of the wasm engine. Use this fixture for when a complete end-to-end
@@ -27,6 +30,37 @@ public:
 
     using result_t = router_test_plan::plan_t;
 
+    /// Shape of an end to end transform benchmark: identity scripts all
+    /// reading the same input topic, each writing its own materialized topic
+    struct transform_bench_params {
+        std::size_t n_scripts{1};
+        std::size_t n_partitions{1};
+        std::size_t batches_per_partition{100};
+        std::size_t records_per_batch{10};
+        std::size_t record_size{128};
+        /// Batches sent one at a time to measure their latency
+        std::size_t latency_samples{20};
+    };
+
+    struct transform_bench_results {
+        /// Records and bytes written to the materialized topics
+        std::size_t records{0};
+        std::size_t bytes{0};
+        std::chrono::milliseconds elapsed{0};
+        /// From the produce of a single batch on the input until all the
+        /// materialized topics contain its transform
+        hdr_hist batch_latency;
+
+        double records_per_second() const;
+        double mib_per_second() const;
+    };
+
+    /// \brief Deploys the scripts, measures the latency of single batches
+    /// and then the throughput of all the batches produced at once. Call
+    /// instead of setup()
+    ss::future<transform_bench_results>
+      run_transform_bench(transform_bench_params);
+
     /// \brief Start the actual test, ensure that startup() has been called,
     /// it initializes the storage layer and registers the coprocessors
     ss::future<result_t> start_benchmark(router_test_plan);
@@ -36,6 +70,12 @@ public:
       build_simple_opts(log_layout_map, std::size_t);
 
 private:
+    /// Consumes 'records' records from every materialized ntp, starting at
+    /// its offset in 'next', which is moved past them
+    ss::future<std::pair<std::size_t, std::size_t>> consume_outputs(
+      absl::flat_hash_map<model::ntp, model::offset>& next,
+      std::size_t records);
+
     ss::future<> push_all(router_test_plan::plan_t);
     ss::future<result_t> consume_all(router_test_plan::plan_t);
 };
@@ -16,6 +16,7 @@
 #include "coproc/tests/utils/batch_utils.h"
 
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/when_all.hh>
 
 enable_coproc::enable_coproc() {
     ss::smp::invoke_on_all([]() {
@@ -109,13 +110,18 @@ ss::future<> fiber_mock_fixture::do_run(
             continue;
         }
 
-        /// Push data through coprocessor
-        auto transforms = co_await transform(
-          _id, std::move(read_results), s.copro);
-
-        /// Write to materialized topics
-        co_await coproc::write_materialized(
-          std::move(transforms), make_output_write_args(s));
+        /// Push data through coprocessor and write to materialized topics,
+        /// while reading ahead like a script_context does
+        co_await ss::when_all_succeed(
+          transform(_id, std::move(read_results), s.copro)
+            .then([this, &s](coproc::output_write_inputs transforms) {
+                return coproc::write_materialized(
+                  std::move(transforms), make_output_write_args(s));
+            }),
+          coproc::read_ahead_inputs(make_input_read_args(s)));
+            throw;
+        }
+        co_await std::move(read_ahead);
     }
 }
 
@@ -155,7 +161,8 @@ coproc::input_read_args fiber_mock_fixture::make_input_read_args(state& s) {
       .id = _id,
       .read_sem = shared_res.read_sem,
       .abort_src = s.as,
-      .inputs = s.routes};
+      .inputs = s.routes,
+      .read_ahead = s.read_ahead};
 }
 
 coproc::output_write_args fiber_mock_fixture::make_output_write_args(state& s) {
@@ -47,6 +47,7 @@ private:
     struct state {
         ss::abort_source as;
         coproc::routes_t routes;
+        coproc::read_ahead_t read_ahead;
         std::unique_ptr<basic_copro_base> copro;
         absl::flat_hash_map<model::ntp, model::offset> high_input;
     };
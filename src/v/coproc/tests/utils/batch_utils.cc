@@ -41,6 +41,23 @@ model::record_batch_reader make_random_batch(std::size_t n_records) {
       1);
 }
 
+model::record_batch_reader make_sized_batches(
+  std::size_t n_batches,
+  std::size_t records_per_batch,
+  std::size_t record_size) {
+    model::record_batch_reader::data_t batches;
+    batches.reserve(n_batches);
+    for (std::size_t i = 0; i < n_batches; ++i) {
+        batches.push_back(model::test::make_random_batch(
+          model::offset{0},
+          static_cast<int>(records_per_batch),
+          false,
+          model::record_batch_type::raft_data,
+          std::vector<size_t>(records_per_batch, record_size)));
+    }
+    return model::make_memory_record_batch_reader(std::move(batches));
+}
+
 model::record_batch_reader::data_t
 copy_batch(const model::record_batch_reader::data_t& data) {
     model::record_batch_reader::data_t new_batch;
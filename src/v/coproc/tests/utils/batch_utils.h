@@ -21,5 +21,12 @@ std::size_t num_records(const model::record_batch_reader::data_t&);
 /// random number of record_batches
 model::record_batch_reader make_random_batch(std::size_t n_records);
 
+/// \brief Makes uncompressed batches of the exact shape specified, with
+/// records of about 'record_size' bytes
+model::record_batch_reader make_sized_batches(
+  std::size_t n_batches,
+  std::size_t records_per_batch,
+  std::size_t record_size);
+
 model::record_batch_reader::data_t
 copy_batch(const model::record_batch_reader::data_t&);
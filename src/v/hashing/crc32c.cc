@@ -0,0 +1,86 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "hashing/crc32c.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+namespace crc {
+
+#if defined(__x86_64__)
+static bool has_sse42() noexcept {
+    static const bool supported = __builtin_cpu_supports("sse4.2");
+    return supported;
+}
+
+static inline uint64_t load_u64(const uint8_t* p) noexcept {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/// interleaves three lanes over their common 8-byte aligned length
+[[gnu::target("sse4.2")]] static void
+extend3_sse42(crc32c_lane& a, crc32c_lane& b, crc32c_lane& c) noexcept {
+    const size_t words = std::min({a.size, b.size, c.size}) / sizeof(uint64_t);
+    if (words == 0) {
+        return;
+    }
+    // crc32c::Extend operates on finalized values, the crc32 instruction on
+    // the raw (inverted) register state
+    uint64_t ca = ~a.crc->value();
+    uint64_t cb = ~b.crc->value();
+    uint64_t cc = ~c.crc->value();
+    const uint8_t* pa = a.data;
+    const uint8_t* pb = b.data;
+    const uint8_t* pc = c.data;
+    for (size_t i = 0; i < words; ++i) {
+        ca = _mm_crc32_u64(ca, load_u64(pa));
+        cb = _mm_crc32_u64(cb, load_u64(pb));
+        cc = _mm_crc32_u64(cc, load_u64(pc));
+        pa += sizeof(uint64_t);
+        pb += sizeof(uint64_t);
+        pc += sizeof(uint64_t);
+    }
+    const size_t consumed = words * sizeof(uint64_t);
+    a.crc->reset(~static_cast<uint32_t>(ca));
+    b.crc->reset(~static_cast<uint32_t>(cb));
+    c.crc->reset(~static_cast<uint32_t>(cc));
+    a.data = pa;
+    b.data = pb;
+    c.data = pc;
+    a.size -= consumed;
+    b.size -= consumed;
+    c.size -= consumed;
+}
+#endif
+
+void crc32c_extend_multi(std::span<crc32c_lane> lanes) noexcept {
+#if defined(__x86_64__)
+    if (has_sse42()) {
+        for (size_t i = 0; i + 3 <= lanes.size(); i += 3) {
+            extend3_sse42(lanes[i], lanes[i + 1], lanes[i + 2]);
+        }
+    }
+#endif
+    for (auto& lane : lanes) {
+        if (lane.size > 0) {
+            lane.crc->extend(lane.data, lane.size);
+            lane.data += lane.size;
+            lane.size = 0;
+        }
+    }
+}
+
+} // namespace crc
@@ -14,7 +14,9 @@
 
 #include <crc32c/crc32c.h>
 
+#include <span>
 #include <type_traits>
+#include <vector>
 
 namespace crc {
 
@@ -37,10 +39,30 @@ public:
 
     uint32_t value() const { return _crc; }
 
+    /// resumes a computation from a previously finalized value
+    void reset(uint32_t value) noexcept { _crc = value; }
+
 private:
     uint32_t _crc = 0;
 };
 
+/// A single independent checksum computation for crc32c_extend_multi
+struct crc32c_lane {
+    crc32c* crc;
+    const uint8_t* data;
+    size_t size;
+};
+
+/**
+ * Extends several independent crc32c states at once. On x86-64 machines with
+ * SSE4.2 the lanes are processed three at a time, interleaving the crc32
+ * instructions of different lanes to hide their latency, which is where most
+ * of the time goes when checksumming many small buffers one after another.
+ * The remainder of every lane is handled by the scalar (table or hardware
+ * accelerated) crc32c implementation.
+ */
+void crc32c_extend_multi(std::span<crc32c_lane>) noexcept;
+
 } // namespace crc
 
 inline void crc_extend_iobuf(crc::crc32c& crc, const iobuf& buf) {
@@ -51,3 +73,37 @@ inline void crc_extend_iobuf(crc::crc32c& crc, const iobuf& buf) {
         return ss::stop_iteration::no;
     });
 }
+
+/**
+ * Extends crcs[i] with the content of *bufs[i] for every i. Buffers are
+ * consumed one fragment per lane at a time with crc::crc32c_extend_multi.
+ */
+inline void crc_extend_iobufs(
+  std::span<crc::crc32c> crcs, std::span<const iobuf* const> bufs) {
+    const auto n = std::min(crcs.size(), bufs.size());
+    std::vector<iobuf::const_iterator> its;
+    its.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        its.push_back(bufs[i]->cbegin());
+    }
+    std::vector<crc::crc32c_lane> lanes;
+    lanes.reserve(n);
+    while (true) {
+        lanes.clear();
+        for (size_t i = 0; i < n; ++i) {
+            if (its[i] == bufs[i]->cend()) {
+                continue;
+            }
+            lanes.push_back(crc::crc32c_lane{
+              .crc = &crcs[i],
+              // NOLINTNEXTLINE
+              .data = reinterpret_cast<const uint8_t*>(its[i]->get()),
+              .size = its[i]->size()});
+            ++its[i];
+        }
+        if (lanes.empty()) {
+            return;
+        }
+        crc::crc32c_extend_multi(lanes);
+    }
+}
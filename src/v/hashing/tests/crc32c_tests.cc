@@ -0,0 +1,90 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE crc32c
+#include "bytes/iobuf.h"
+#include "hashing/crc32c.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <string>
+
+static std::string random_string(std::mt19937& gen, size_t size) {
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::string s(size, '\0');
+    for (auto& c : s) {
+        c = static_cast<char>(dist(gen));
+    }
+    return s;
+}
+
+static uint32_t scalar_crc(const std::string& s, uint32_t init = 0) {
+    crc::crc32c crc;
+    crc.reset(init);
+    crc.extend(s.data(), s.size());
+    return crc.value();
+}
+
+BOOST_AUTO_TEST_CASE(extend_multi_matches_scalar) {
+    std::mt19937 gen(42);
+    // cover lane counts that are and aren't multiples of the interleave width
+    for (size_t lanes_count = 0; lanes_count < 10; ++lanes_count) {
+        std::vector<std::string> data;
+        std::vector<crc::crc32c> crcs(lanes_count);
+        std::vector<crc::crc32c_lane> lanes;
+        std::vector<uint32_t> expected;
+        for (size_t i = 0; i < lanes_count; ++i) {
+            data.push_back(random_string(gen, (i * 37) % 300));
+            // start from a non-trivial state
+            crcs[i].extend(uint32_t(i));
+            expected.push_back(scalar_crc(data.back(), crcs[i].value()));
+        }
+        for (size_t i = 0; i < lanes_count; ++i) {
+            lanes.push_back(crc::crc32c_lane{
+              .crc = &crcs[i],
+              .data = reinterpret_cast<const uint8_t*>(data[i].data()),
+              .size = data[i].size()});
+        }
+        crc::crc32c_extend_multi(lanes);
+        for (size_t i = 0; i < lanes_count; ++i) {
+            BOOST_REQUIRE_EQUAL(crcs[i].value(), expected[i]);
+            BOOST_REQUIRE_EQUAL(lanes[i].size, 0);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(extend_iobufs_matches_single) {
+    std::mt19937 gen(7);
+    std::vector<iobuf> bufs;
+    for (size_t i = 0; i < 7; ++i) {
+        iobuf buf;
+        // several fragments of different sizes
+        for (size_t f = 0; f < i + 1; ++f) {
+            auto s = random_string(gen, 64 + f * 129 + i);
+            iobuf fragment;
+            fragment.append(s.data(), s.size());
+            buf.append_fragments(std::move(fragment));
+        }
+        bufs.push_back(std::move(buf));
+    }
+
+    std::vector<crc::crc32c> crcs(bufs.size());
+    std::vector<const iobuf*> ptrs;
+    for (auto& b : bufs) {
+        ptrs.push_back(&b);
+    }
+    crc_extend_iobufs(crcs, ptrs);
+
+    for (size_t i = 0; i < bufs.size(); ++i) {
+        crc::crc32c expected;
+        crc_extend_iobuf(expected, bufs[i]);
+        BOOST_REQUIRE_EQUAL(crcs[i].value(), expected.value());
+    }
+}
@@ -425,28 +425,24 @@ ss::future<> client::request_stream::send_some(iobuf&& seq) {
         boost::system::system_error except(error_code);
         return ss::make_exception_future<>(except);
     }
-    auto scattered = iobuf_as_scattered(std::move(outbuf));
-    return ss::with_gate(
-      _gate,
-      [this, seq = std::move(seq), scattered = std::move(scattered)]() mutable {
-          return _client->send(std::move(scattered))
-            .then([this, seq = std::move(seq)]() mutable {
-                return forward(_client, _chunk_encode(std::move(seq)));
+    // the header and the first part of the body go out in a single send
+    outbuf.append(_chunk_encode(std::move(seq)));
+    return ss::with_gate(_gate, [this, outbuf = std::move(outbuf)]() mutable {
+        return forward(_client, std::move(outbuf))
+          .handle_exception_type(
+            [this](const ss::tls::verification_error& err) {
+                return _client->stop().then(
+                  [err] { return ss::make_exception_future<>(err); });
             })
-            .handle_exception_type(
-              [this](const ss::tls::verification_error& err) {
-                  return _client->stop().then(
-                    [err] { return ss::make_exception_future<>(err); });
-              })
-            .handle_exception_type([this](const std::system_error& ec) {
-                // Things like EPIPE, ERESET.  This happens routinely
-                // when talking to AWS S3, even if we are not doing
-                // anything wrong.
-                vlog(_ctxlog.warn, "send error {}", ec);
-                _client->shutdown();
-                return ss::make_exception_future<>(ec);
-            });
-      });
+          .handle_exception_type([this](const std::system_error& ec) {
+              // Things like EPIPE, ERESET.  This happens routinely
+              // when talking to AWS S3, even if we are not doing
+              // anything wrong.
+              vlog(_ctxlog.warn, "send error {}", ec);
+              _client->shutdown();
+              return ss::make_exception_future<>(ec);
+          });
+    });
 }
 
 bool client::request_stream::is_done() { return _serializer.is_done(); }
@@ -540,6 +536,29 @@ struct request_data_sink final : ss::data_sink_impl {
     client::request_stream_ref _io;
 };
 
+/// Send the input stream as the request body. The buffers of the stream are
+/// shared into the request without being copied, small buffers are gathered
+/// to be sent together.
+static ss::future<>
+send_body(client::request_stream_ref request, ss::input_stream<char>& input) {
+    static constexpr size_t send_size = 128_KiB;
+    iobuf pending;
+    while (true) {
+        auto buf = co_await input.read();
+        if (buf.empty()) {
+            break;
+        }
+        pending.append(std::move(buf));
+        if (pending.size_bytes() >= send_size) {
+            co_await request->send_some(std::exchange(pending, iobuf{}));
+        }
+    }
+    if (!pending.empty()) {
+        co_await request->send_some(std::move(pending));
+    }
+    co_await request->send_eof();
+}
+
 ss::future<client::response_stream_ref> client::request(
   client::request_header&& header,
   ss::input_stream<char>& input,
@@ -559,15 +578,7 @@ ss::future<client::response_stream_ref> client::request(
               fsend = request->send_some(iobuf()).then(
                 [request = request]() { return request->send_eof(); });
           } else {
-              // since the input stream has some data we can use
-              // output_stream interace of the request
-              fsend = ss::do_with(
-                request->as_output_stream(),
-                [&input](ss::output_stream<char>& output) {
-                    return ss::copy(input, output).then([&output] {
-                        return output.close();
-                    });
-                });
+              fsend = send_body(request, input);
           }
           return fsend.then([response = response]() {
               return ss::make_ready_future<response_stream_ref>(response);
@@ -0,0 +1,57 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#pragma once
+
+#include "bytes/iobuf.h"
+
+#include <array>
+#include <utility>
+
+namespace json {
+
+/**
+ * Output stream for json::Writer that builds the document in iobuf fragments
+ * rather than a single contiguous buffer, so large documents don't need large
+ * allocations. The bytes written so far can be taken out with consume() at
+ * any point, e.g. to send them while the rest of the document is written.
+ */
+class chunked_buffer {
+public:
+    using Ch = char;
+
+    void Put(Ch c) {
+        if (_pos == _staging.size()) {
+            Flush();
+        }
+        _staging[_pos++] = c;
+    }
+
+    void Flush() {
+        _buf.append(_staging.data(), _pos);
+        _pos = 0;
+    }
+
+    /// Number of bytes written and not consumed yet
+    size_t size() const { return _buf.size_bytes() + _pos; }
+
+    /// Takes out the bytes written so far
+    iobuf consume() {
+        Flush();
+        return std::exchange(_buf, iobuf{});
+    }
+
+private:
+    // single characters are staged to avoid appending them one by one
+    std::array<Ch, 512> _staging{};
+    size_t _pos{0};
+    iobuf _buf;
+};
+
+} // namespace json
@@ -0,0 +1,84 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#pragma once
+
+#include "bytes/iobuf.h"
+#include "vassert.h"
+
+#include <cstddef>
+
+namespace json {
+
+/**
+ * Input stream for json::Reader over the fragments of an iobuf, the
+ * counterpart of chunked_buffer: a document received in fragments is parsed
+ * in place rather than linearized first. The stream owns the buffer, so the
+ * fragments live as long as the parse.
+ */
+class chunked_input_stream {
+public:
+    using Ch = char;
+
+    explicit chunked_input_stream(iobuf buf)
+      : _buf(std::move(buf))
+      , _it(_buf.cbegin()) {
+        skip_empty();
+    }
+    chunked_input_stream(const chunked_input_stream&) = delete;
+    chunked_input_stream& operator=(const chunked_input_stream&) = delete;
+    chunked_input_stream(chunked_input_stream&&) = delete;
+    chunked_input_stream& operator=(chunked_input_stream&&) = delete;
+    ~chunked_input_stream() = default;
+
+    /// The current character, or '\0' past the end like json::StringStream
+    Ch Peek() const { return _it == _buf.cend() ? '\0' : _it->get()[_pos]; }
+
+    Ch Take() {
+        if (_it == _buf.cend()) {
+            return '\0';
+        }
+        auto c = _it->get()[_pos];
+        ++_consumed;
+        if (++_pos == _it->size()) {
+            ++_it;
+            _pos = 0;
+            skip_empty();
+        }
+        return c;
+    }
+
+    size_t Tell() const { return _consumed; }
+
+    // read only stream, see json::Reader
+    Ch* PutBegin() {
+        vassert(false, "chunked_input_stream is read only");
+        return nullptr;
+    }
+    void Put(Ch) { vassert(false, "chunked_input_stream is read only"); }
+    void Flush() { vassert(false, "chunked_input_stream is read only"); }
+    size_t PutEnd(Ch*) {
+        vassert(false, "chunked_input_stream is read only");
+        return 0;
+    }
+
+private:
+    void skip_empty() {
+        while (_it != _buf.cend() && _it->size() == 0) {
+            ++_it;
+        }
+    }
+
+    iobuf _buf;
+    iobuf::const_iterator _it;
+    size_t _pos{0};
+    size_t _consumed{0};
+};
+
+} // namespace json
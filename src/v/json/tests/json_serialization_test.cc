@@ -7,6 +7,8 @@
 // the Business Source License, use of this software will be governed
 // by the Apache License, Version 2.0
 
+#include "bytes/iobuf_parser.h"
+#include "json/chunked_buffer.h"
 #include "json/document.h"
 #include "json/json.h"
 #include "json/stringbuffer.h"
@@ -133,3 +135,25 @@ SEASTAR_THREAD_TEST_CASE(json_serialization_test) {
 
     BOOST_TEST(res_doc["obj"].IsObject());
 }
+
+SEASTAR_THREAD_TEST_CASE(json_chunked_buffer_test) {
+    json::chunked_buffer buf;
+    json::Writer<json::chunked_buffer> w(buf);
+
+    // larger than the staging area of the buffer
+    ss::sstring value(ss::sstring::initialized_later{}, 2000);
+    std::fill(value.begin(), value.end(), 'x');
+
+    w.StartArray();
+    w.String(value.data(), value.size());
+    auto first = buf.consume();
+    BOOST_REQUIRE_EQUAL(buf.size(), 0);
+    w.Int(42);
+    w.EndArray();
+    BOOST_REQUIRE_EQUAL(buf.size(), 4);
+
+    first.append(buf.consume());
+    iobuf_parser p{std::move(first)};
+    auto result = p.read_string(p.bytes_left());
+    BOOST_REQUIRE_EQUAL(result, "[\"" + value + "\",42]");
+}
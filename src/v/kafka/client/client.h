@@ -155,6 +155,14 @@ public:
 
     ss::future<> update_metadata() { return _wait_or_start_update_metadata(); }
 
+    /// \brief Apply a leadership change learned outside of the metadata
+    /// responses, e.g. from the broker the client runs in, so that requests
+    /// go to the new leader without failing first.
+    void update_leader(
+      const model::topic_partition& tp, std::optional<model::node_id> leader) {
+        _topic_cache.update_leader(tp, leader.value_or(unknown_node_id));
+    }
+
     ss::future<bool> is_connected() const {
         return _brokers.empty().then(std::logical_not<>());
     }
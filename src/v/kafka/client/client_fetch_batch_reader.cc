@@ -15,26 +15,66 @@
 #include "kafka/client/logger.h"
 #include "kafka/protocol/exceptions.h"
 #include "kafka/protocol/kafka_batch_adapter.h"
+#include "ssx/future-util.h"
 
+#include <seastar/core/abort_source.hh>
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/queue.hh>
+#include <seastar/core/shared_ptr.hh>
 #include <seastar/core/std-coroutine.hh>
 
+#include <algorithm>
+
 namespace kafka::client {
 
+/*
+ * Fetches the partition ahead of the consumer: as soon as a response arrives,
+ * the offset of the next fetch is known from its last batch and the next
+ * fetch is issued while the response is being consumed. Responses are
+ * buffered up to the prefetch depth, so the consumer does not wait for a
+ * round trip per response.
+ */
 class client_fetcher final : public model::record_batch_reader::impl {
     using storage_t = model::record_batch_reader::storage_t;
 
+    // shared with the background fetch, which may outlive the reader
+    struct prefetch_state {
+        explicit prefetch_state(size_t depth)
+          : fetched(std::max<size_t>(depth, 1)) {}
+
+        // failed fetches are queued in order with the successful ones
+        ss::queue<ss::future<kafka::batch_reader>> fetched;
+        bool stopped{false};
+    };
+
 public:
     client_fetcher(
       kafka::client::client& client,
       model::topic_partition tp,
       model::offset first,
       model::offset last)
-      : _client{client}
-      , _tp{std::move(tp)}
-      , _next_offset{first}
+      : _next_offset{first}
       , _last_offset{last}
-      , _batch_reader{} {}
+      , _prefetch{ss::make_lw_shared<prefetch_state>(
+          client.config().consumer_fetch_prefetch_depth())} {
+        ssx::background
+          = prefetch(client, std::move(tp), first, last, _prefetch)
+              .handle_exception([state = _prefetch](std::exception_ptr e) {
+                  state->fetched.abort(std::move(e));
+              });
+    }
+    client_fetcher(const client_fetcher&) = delete;
+    client_fetcher& operator=(const client_fetcher&) = delete;
+    client_fetcher(client_fetcher&&) = delete;
+    client_fetcher& operator=(client_fetcher&&) = delete;
+    ~client_fetcher() final {
+        _prefetch->stopped = true;
+        while (!_prefetch->fetched.empty()) {
+            _prefetch->fetched.pop().ignore_ready_future();
+        }
+        _prefetch->fetched.abort(
+          std::make_exception_ptr(ss::abort_requested_exception()));
+    }
 
     // Implements model::record_batch_reader::impl
     bool is_end_of_stream() const final { return _next_offset >= _last_offset; }
@@ -43,25 +83,8 @@ public:
     ss::future<storage_t>
     do_load_slice(model::timeout_clock::time_point t) final {
         if (!_batch_reader || _batch_reader->is_end_of_stream()) {
-            vlog(
-              kclog.debug,
-              "fetch_batch_reader: fetch offset: {}",
-              _next_offset);
-            auto res = co_await _client.fetch_partition(
-              _tp,
-              _next_offset,
-              1_MiB,
-              std::chrono::duration_cast<std::chrono::milliseconds>(
-                t - model::timeout_clock::now()));
-            vlog(kclog.debug, "fetch_batch_reader: fetch result: {}", res);
-            vassert(
-              res.begin() != res.end() && ++res.begin() == res.end(),
-              "Expected exactly one response from client::fetch_partition");
-            if (res.data.error_code != kafka::error_code::none) {
-                throw kafka::exception(
-                  res.data.error_code, "Fetch returned with error");
-            }
-            _batch_reader = std::move(res.begin()->partition_response->records);
+            auto fetched = co_await _prefetch->fetched.pop_eventually();
+            _batch_reader = co_await std::move(fetched);
         }
         auto ret = co_await _batch_reader->do_load_slice(t);
         using data_t = model::record_batch_reader::data_t;
@@ -85,10 +108,50 @@ public:
     }
 
 private:
-    kafka::client::client& _client;
-    model::topic_partition _tp;
+    static ss::future<> prefetch(
+      kafka::client::client& client,
+      model::topic_partition tp,
+      model::offset next,
+      model::offset last,
+      ss::lw_shared_ptr<prefetch_state> state) {
+        while (next < last && !state->stopped) {
+            vlog(kclog.debug, "fetch_batch_reader: fetch offset: {}", next);
+            auto res = co_await client.fetch_partition(
+              tp,
+              next,
+              client.config().consumer_request_max_bytes(),
+              client.config().consumer_request_timeout());
+            vlog(kclog.debug, "fetch_batch_reader: fetch result: {}", res);
+            if (state->stopped) {
+                co_return;
+            }
+            vassert(
+              res.begin() != res.end() && ++res.begin() == res.end(),
+              "Expected exactly one response from client::fetch_partition");
+            if (res.data.error_code != kafka::error_code::none) {
+                co_await state->fetched.push_eventually(
+                  ss::make_exception_future<kafka::batch_reader>(
+                    kafka::exception(
+                      res.data.error_code, "Fetch returned with error")));
+                co_return;
+            }
+            auto& records = res.begin()->partition_response->records;
+            if (!records || records->empty()) {
+                // the reader fails on the empty response, no offset to
+                // continue from
+                co_await state->fetched.push_eventually(
+                  ss::make_ready_future<kafka::batch_reader>());
+                co_return;
+            }
+            next = ++records->last_offset();
+            co_await state->fetched.push_eventually(
+              ss::make_ready_future<kafka::batch_reader>(std::move(*records)));
+        }
+    }
+
     model::offset _next_offset;
     model::offset _last_offset;
+    ss::lw_shared_ptr<prefetch_state> _prefetch;
     std::optional<kafka::batch_reader> _batch_reader;
 };
 
@@ -72,6 +72,13 @@ configuration::configuration()
       "Max bytes to fetch per request",
       {},
       1_MiB)
+  , consumer_fetch_prefetch_depth(
+      *this,
+      "consumer_fetch_prefetch_depth",
+      "Number of fetch responses a partition reader buffers ahead of its "
+      "consumer",
+      {},
+      2)
   , consumer_session_timeout(
       *this,
       "consumer_session_timeout_ms",
@@ -35,6 +35,7 @@ struct configuration final : public config::config_store {
     config::property<std::chrono::milliseconds> produce_batch_delay;
     config::property<std::chrono::milliseconds> consumer_request_timeout;
     config::property<int32_t> consumer_request_max_bytes;
+    config::property<size_t> consumer_fetch_prefetch_depth;
     config::property<std::chrono::milliseconds> consumer_session_timeout;
     config::property<std::chrono::milliseconds> consumer_rebalance_timeout;
     config::property<std::chrono::milliseconds> consumer_heartbeat_interval;
@@ -25,8 +25,13 @@
 namespace kafka::client {
 
 /// \brief Batch multiple client requests, flush them based on size or time.
+///
+/// Requests are batched while the previous batch is in flight, and for at
+/// most produce_batch_delay since the first request of the batch: later
+/// requests don't extend the delay of the batch they join.
 class produce_partition {
 public:
+    using clock_type = ss::timer<>::clock;
     using response = produce_batcher::partition_response;
     using consumer = ss::noncopyable_function<void(model::record_batch&&)>;
 
@@ -37,6 +42,9 @@ public:
       , _consumer{std::move(c)} {}
 
     ss::future<response> produce(model::record_batch&& batch) {
+        if (_record_count == 0) {
+            _batch_start = clock_type::now();
+        }
         _record_count += batch.record_count();
         _size_bytes += batch.size_bytes();
         auto fut = _batcher.produce(std::move(batch));
@@ -78,12 +86,16 @@ private:
         auto threshold_met = _record_count >= batch_record_count
                              || _size_bytes >= batch_size_bytes;
 
-        if (!timed_out && !threshold_met) {
-            _timer.cancel();
-            _timer.arm(_config.produce_batch_delay());
+        auto linger_until = _batch_start + _config.produce_batch_delay();
+        if (
+          !timed_out && !threshold_met && clock_type::now() < linger_until) {
+            if (!_timer.armed()) {
+                _timer.arm(linger_until);
+            }
             return false;
         }
 
+        _timer.cancel();
         _consumer(do_consume());
         return true;
     }
@@ -94,6 +106,7 @@ private:
     consumer _consumer;
     int32_t _record_count{};
     int32_t _size_bytes{};
+    clock_type::time_point _batch_start{};
     bool _in_flight{};
 };
 
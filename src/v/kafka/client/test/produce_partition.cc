@@ -17,15 +17,19 @@
 #include "model/fundamental.h"
 #include "model/record.h"
 
+#include <seastar/core/sleep.hh>
 #include <seastar/testing/thread_test_case.hh>
 
 #include <boost/test/tools/old/interface.hpp>
 
+#include <chrono>
 #include <exception>
 #include <system_error>
 
 namespace kc = kafka::client;
 
+using namespace std::chrono_literals;
+
 SEASTAR_THREAD_TEST_CASE(test_produce_partition_record_count) {
     std::vector<model::record_batch> consumed_batches;
     auto consumer = [&consumed_batches](model::record_batch&& batch) {
@@ -65,3 +69,37 @@ SEASTAR_THREAD_TEST_CASE(test_produce_partition_record_count) {
     auto c_res2 = c_res2_fut.get0();
     BOOST_REQUIRE_EQUAL(c_res2.base_offset, model::offset{3});
 }
+
+SEASTAR_THREAD_TEST_CASE(test_produce_partition_linger) {
+    std::vector<model::record_batch> consumed_batches;
+    auto consumer = [&consumed_batches](model::record_batch&& batch) {
+        consumed_batches.push_back(std::move(batch));
+    };
+
+    auto cfg = kc::configuration{};
+    // large
+    cfg.produce_batch_size_bytes.set_value(1024);
+    cfg.produce_batch_record_count.set_value(1000);
+    // configuration under test
+    cfg.produce_batch_delay.set_value(100ms);
+
+    kc::produce_partition producer(cfg, consumer);
+
+    auto c_res0_fut = producer.produce(make_batch(model::offset(0), 1));
+    ss::sleep(60ms).get();
+    auto c_res1_fut = producer.produce(make_batch(model::offset(1), 1));
+    BOOST_REQUIRE(consumed_batches.empty());
+
+    // The second request doesn't extend the delay of the batch
+    ss::sleep(60ms).get();
+    BOOST_REQUIRE_EQUAL(consumed_batches.size(), 1);
+    BOOST_REQUIRE_EQUAL(consumed_batches[0].record_count(), 2);
+
+    producer.handle_response(kafka::produce_response::partition{
+      .partition_index{model::partition_id{42}},
+      .error_code = kafka::error_code::none,
+      .base_offset{model::offset{0}}});
+    BOOST_REQUIRE_EQUAL(c_res0_fut.get0().base_offset, model::offset{0});
+    BOOST_REQUIRE_EQUAL(c_res1_fut.get0().base_offset, model::offset{1});
+    producer.stop().get();
+}
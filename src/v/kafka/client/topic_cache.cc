@@ -43,6 +43,17 @@ topic_cache::apply(std::vector<metadata_response::topic>&& topics) {
     return ss::now();
 }
 
+void topic_cache::update_leader(
+  const model::topic_partition& tp, model::node_id leader) {
+    // unknown topics are learned from the next metadata response
+    if (auto topic_it = _topics.find(tp.topic); topic_it != _topics.end()) {
+        auto& parts = topic_it->second.partitions;
+        if (auto part_it = parts.find(tp.partition); part_it != parts.end()) {
+            part_it->second.leader = leader;
+        }
+    }
+}
+
 ss::future<model::node_id>
 topic_cache::leader(model::topic_partition tp) const {
     if (auto topic_it = _topics.find(tp.topic); topic_it != _topics.end()) {
@@ -48,6 +48,9 @@ public:
     /// \brief Apply the given metadata response.
     ss::future<> apply(std::vector<metadata_response::topic>&& topics);
 
+    /// \brief Update the leader of a known topic-partition.
+    void update_leader(const model::topic_partition& tp, model::node_id leader);
+
     /// \brief Obtain the leader for the given topic-partition
     ss::future<model::node_id> leader(model::topic_partition tp) const;
 
@@ -12,12 +12,15 @@
 #pragma once
 
 #include "config/configuration.h"
+#include "kafka/types.h"
 #include "prometheus/prometheus_sanitize.h"
 #include "ssx/metrics.h"
-#include "utils/hdr_hist.h"
+#include "utils/buffered_hist.h"
 
 #include <seastar/core/metrics.hh>
 
+#include <absl/container/node_hash_map.h>
+
 namespace kafka {
 class latency_probe {
 public:
@@ -46,8 +49,77 @@ public:
              labels,
              [this] { return _produce_latency.seastar_histogram_logform(); })
              .aggregate(aggregate_labels)});
+        _metrics.add_group(
+          prometheus_sanitize::metrics_name("kafka:fetch"),
+          {sm::make_counter(
+             "local_partitions",
+             [this] { return _fetch_local_partitions; },
+             sm::description(
+               "Fetched partitions owned by the shard handling the request"))
+             .aggregate(aggregate_labels),
+           sm::make_counter(
+             "cross_shard_partitions",
+             [this] { return _fetch_remote_partitions; },
+             sm::description("Fetched partitions owned by another shard"))
+             .aggregate(aggregate_labels)});
+        _metrics.add_group(
+          prometheus_sanitize::metrics_name("kafka:admission"),
+          {sm::make_counter(
+            "delayed_low_memory",
+            [this] { return _admission_delayed; },
+            sm::description(
+              "Requests delayed for admission while the shard is low on "
+              "memory"))
+             .aggregate(aggregate_labels)});
     }
 
+    /*
+     * Register the queueing delay metrics of an API. The delay is the time
+     * a request waits for admission (in-flight window, memory units, queue
+     * depth and low memory backoff) between being read and being dispatched.
+     */
+    void setup_queue_metrics(api_key key, std::string_view name) {
+        namespace sm = ss::metrics;
+
+        if (config::shard_local_cfg().disable_metrics()) {
+            return;
+        }
+        auto aggregate_labels = config::shard_local_cfg().aggregate_metrics()
+                                  ? std::vector<sm::label>{sm::shard_label}
+                                  : std::vector<sm::label>{};
+        std::vector<sm::label_instance> labels{
+          sm::label("request")(ss::sstring(name))};
+        auto& stats = _queue_stats[key];
+        _metrics.add_group(
+          prometheus_sanitize::metrics_name("kafka:request_queue"),
+          {sm::make_counter(
+             "requests",
+             [&stats] { return stats.requests; },
+             sm::description("Requests admitted"),
+             labels)
+             .aggregate(aggregate_labels),
+           sm::make_counter(
+             "delay_us",
+             [&stats] { return stats.delay_us; },
+             sm::description(
+               "Total time requests waited for admission in microseconds"),
+             labels)
+             .aggregate(aggregate_labels)});
+    }
+
+    void request_admitted(api_key key, ss::lowres_clock::duration delay) {
+        auto it = _queue_stats.find(key);
+        if (it == _queue_stats.end()) {
+            return;
+        }
+        ++it->second.requests;
+        it->second.delay_us
+          += std::chrono::duration_cast<std::chrono::microseconds>(delay)
+               .count();
+    }
+
+    void admission_delayed() { ++_admission_delayed; }
+
     void setup_public_metrics() {
         namespace sm = ss::metrics;
 
@@ -63,7 +135,7 @@ public:
               {ssx::metrics::make_namespaced_label("request")("produce")},
               [this] {
                   return ssx::metrics::report_default_histogram(
-                    _produce_latency);
+                    _produce_latency.hist());
               })
               .aggregate({sm::shard_label}),
             sm::make_histogram(
@@ -71,22 +143,39 @@ public:
               sm::description("Internal latency of kafka consume requests"),
               {ssx::metrics::make_namespaced_label("request")("consume")},
               [this] {
-                  return ssx::metrics::report_default_histogram(_fetch_latency);
+                  return ssx::metrics::report_default_histogram(
+                    _fetch_latency.hist());
               })
               .aggregate({sm::shard_label}),
           });
     }
 
-    std::unique_ptr<hdr_hist::measurement> auto_produce_measurement() {
+    buffered_hist::measurement auto_produce_measurement() {
         return _produce_latency.auto_measure();
     }
-    std::unique_ptr<hdr_hist::measurement> auto_fetch_measurement() {
+    buffered_hist::measurement auto_fetch_measurement() {
         return _fetch_latency.auto_measure();
     }
 
+    void fetch_plan_executed(size_t local, size_t remote) {
+        _fetch_local_partitions += local;
+        _fetch_remote_partitions += remote;
+    }
+
 private:
-    hdr_hist _produce_latency;
-    hdr_hist _fetch_latency;
+    struct queue_stats {
+        uint64_t requests{0};
+        uint64_t delay_us{0};
+    };
+
+    // node based so the metric callbacks can hold on to the stats
+    absl::node_hash_map<api_key, queue_stats> _queue_stats;
+    uint64_t _admission_delayed{0};
+    uint64_t _fetch_local_partitions{0};
+    uint64_t _fetch_remote_partitions{0};
+    // recorded for every produced and fetched partition
+    buffered_hist _produce_latency;
+    buffered_hist _fetch_latency;
     ss::metrics::metric_groups _metrics;
     ss::metrics::metric_groups _public_metrics{
       ssx::metrics::public_metrics_handle};
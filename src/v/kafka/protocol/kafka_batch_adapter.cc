@@ -17,18 +17,128 @@
 #include "likely.h"
 #include "model/fundamental.h"
 #include "model/record.h"
+#include "model/record_utils.h"
 #include "raft/types.h"
 #include "storage/parser_utils.h"
+#include "utils/vint.h"
 #include "vassert.h"
 
 #include <seastar/core/smp.hh>
 
 #include <fmt/ostream.h>
 
+#include <array>
 #include <stdexcept>
 
 namespace kafka {
 
+/**
+ * Checks the record framing of a compressed batch while it is uncompressed in
+ * chunks. Only the bytes of the record being parsed are kept, the uncompressed
+ * payload is never materialized as a whole.
+ */
+class chunked_records_validator {
+public:
+    explicit chunked_records_validator(int32_t record_count)
+      : _record_count(record_count) {}
+
+    void operator()(const char* data, size_t size) {
+        _pending.append(data, size);
+        consume_records();
+    }
+
+    void finish() const {
+        if (unlikely(!_pending.empty() || _parsed != _record_count)) {
+            throw std::out_of_range(fmt::format(
+              "Record batch header declares {} records, parsed {} with {} "
+              "trailing bytes",
+              _record_count,
+              _parsed,
+              _pending.size_bytes()));
+        }
+    }
+
+private:
+    /// Size of the next record including its length prefix, or nullopt if
+    /// the length prefix itself is not complete yet
+    std::optional<size_t> next_record_size() const {
+        std::array<uint8_t, vint::max_length> prefix{};
+        const auto n = std::min(prefix.size(), _pending.size_bytes());
+        iobuf::iterator_consumer(_pending.cbegin(), _pending.cend())
+          .consume_to(n, prefix.data());
+        for (size_t i = 0; i < n; ++i) {
+            if ((prefix[i] & 0x80) == 0) {
+                auto [len, len_size] = vint::deserialize(
+                  bytes_view(prefix.data(), i + 1));
+                if (unlikely(len < 0)) {
+                    throw std::out_of_range(
+                      fmt::format("Negative record size: {}", len));
+                }
+                return len_size + static_cast<size_t>(len);
+            }
+        }
+        if (unlikely(n == prefix.size())) {
+            throw std::out_of_range("Malformed record size");
+        }
+        return std::nullopt;
+    }
+
+    void consume_records() {
+        while (!_pending.empty()) {
+            auto size = next_record_size();
+            if (!size || _pending.size_bytes() < *size) {
+                return;
+            }
+            if (unlikely(_parsed == _record_count)) {
+                throw std::out_of_range(fmt::format(
+                  "Record batch has more than the {} declared records",
+                  _record_count));
+            }
+            iobuf_parser parser(_pending.share(0, *size));
+            (void)model::parse_one_record_from_buffer(parser);
+            if (unlikely(parser.bytes_left() != 0)) {
+                throw std::out_of_range(fmt::format(
+                  "Record {} has {} bytes past its fields",
+                  _parsed,
+                  parser.bytes_left()));
+            }
+            _pending.trim_front(*size);
+            ++_parsed;
+        }
+    }
+
+    int32_t _record_count;
+    int32_t _parsed{0};
+    iobuf _pending;
+};
+
+static void validate_compressed_records(const model::record_batch& batch) {
+    chunked_records_validator validator(batch.record_count());
+    compression::compressor::uncompress_chunked(
+      batch.data(),
+      batch.header().attrs.compression(),
+      [&validator](const char* data, size_t size) { validator(data, size); });
+    validator.finish();
+}
+
+/**
+ * Checks the record framing of an uncompressed batch. The fields of the
+ * records are shared out of the batch payload, unlike for_each_record which
+ * copies every key, value and header just to drop them.
+ */
+static void validate_uncompressed_records(iobuf records, int32_t record_count) {
+    iobuf_parser parser(std::move(records));
+    for (int32_t i = 0; i < record_count; ++i) {
+        (void)model::parse_one_record_from_buffer(parser);
+    }
+    if (unlikely(parser.bytes_left() != 0)) {
+        throw std::out_of_range(fmt::format(
+          "Record batch has {} bytes past its {} declared records",
+          parser.bytes_left(),
+          record_count));
+    }
+}
+
 model::record_batch_header kafka_batch_adapter::read_header(iobuf_parser& in) {
     const size_t initial_bytes_consumed = in.bytes_consumed();
 
@@ -175,22 +285,31 @@ iobuf kafka_batch_adapter::adapt(iobuf&& kbatch) {
     auto records_size = header.size_bytes
                         - model::packed_record_batch_header_size;
     auto records = parser.share(records_size);
+    auto records_view = records.share(0, records.size_bytes());
 
     auto new_batch = model::record_batch(
       header, std::move(records), model::record_batch::tag_ctor_ng{});
 
     /**
      * Perform some type of validation on the uncompressed input. In this case
-     * we make sure that the records can be materialized but we avoid
-     * re-encoding them using the lazy-record optimization.
+     * we make sure that the records can be parsed but we avoid re-encoding
+     * them using the lazy-record optimization.
      */
     if (!new_batch.compressed()) {
         try {
-            new_batch.for_each_record([](model::record r) { (void)r; });
+            validate_uncompressed_records(
+              std::move(records_view), new_batch.record_count());
         } catch (const std::exception& e) {
             vlog(klog.error, "Parsing uncompressed records: {}", e.what());
             return remainder;
         }
+    } else {
+        try {
+            validate_compressed_records(new_batch);
+        } catch (const std::exception& e) {
+            vlog(klog.error, "Parsing compressed records: {}", e.what());
+            return remainder;
+        }
     }
 
     batch = std::move(new_batch);
@@ -12,13 +12,17 @@
 #pragma once
 
 #include "kafka/protocol/schemata/metadata_request.h"
+#include "kafka/protocol/response_writer.h"
 #include "kafka/protocol/schemata/metadata_response.h"
+#include "vassert.h"
 #include "model/metadata.h"
 #include "seastarx.h"
 
 #include <seastar/core/future.hh>
 
 #include <chrono>
+#include <optional>
+#include <vector>
 
 namespace kafka {
 
@@ -62,8 +66,82 @@ struct metadata_response {
 
     metadata_response_data data;
 
+    /**
+     * Topics already encoded with encode_topic(). When set, these are written
+     * in place of data.topics. Pre-encoded topics are only supported by the
+     * non-flexible versions that have no fields following the topics array.
+     */
+    std::optional<std::vector<iobuf>> encoded_topics;
+
+    static constexpr api_version max_encoded_topics_version{7};
+
     void encode(response_writer& writer, api_version version) {
-        data.encode(writer, version);
+        if (!encoded_topics) {
+            data.encode(writer, version);
+            return;
+        }
+        vassert(
+          version <= max_encoded_topics_version,
+          "pre-encoded metadata topics are not supported in version {}",
+          version);
+        if (version >= api_version(3)) {
+            writer.write(int32_t(data.throttle_time_ms.count()));
+        }
+        writer.write_array(
+          data.brokers, [version](const broker& b, response_writer& writer) {
+              writer.write(b.node_id);
+              writer.write(b.host);
+              writer.write(b.port);
+              if (version >= api_version(1)) {
+                  writer.write(b.rack);
+              }
+          });
+        if (version >= api_version(2)) {
+            writer.write(data.cluster_id);
+        }
+        if (version >= api_version(1)) {
+            writer.write(data.controller_id);
+        }
+        writer.write(int32_t(encoded_topics->size()));
+        for (auto& t : *encoded_topics) {
+            writer.write_direct(std::move(t));
+        }
+    }
+
+    /// Encodes a single element of the topics array
+    static void
+    encode_topic(response_writer& writer, const topic& t, api_version version) {
+        vassert(
+          version <= max_encoded_topics_version,
+          "pre-encoded metadata topics are not supported in version {}",
+          version);
+        auto write_nodes = [](const std::vector<model::node_id>& nodes,
+                              response_writer& writer) {
+            writer.write_array(
+              nodes, [](model::node_id n, response_writer& writer) {
+                  writer.write(n);
+              });
+        };
+        writer.write(t.error_code);
+        writer.write(t.name);
+        if (version >= api_version(1)) {
+            writer.write(t.is_internal);
+        }
+        writer.write_array(
+          t.partitions,
+          [version, &write_nodes](const partition& p, response_writer& writer) {
+              writer.write(p.error_code);
+              writer.write(p.partition_index);
+              writer.write(p.leader_id);
+              if (version >= api_version(7)) {
+                  writer.write(p.leader_epoch);
+              }
+              write_nodes(p.replica_nodes, writer);
+              write_nodes(p.isr_nodes, writer);
+              if (version >= api_version(5)) {
+                  write_nodes(p.offline_replicas, writer);
+              }
+          });
     }
 
     void decode(iobuf buf, api_version version) {
@@ -72,7 +150,11 @@ struct metadata_response {
 
     friend std::ostream&
     operator<<(std::ostream& os, const metadata_response& r) {
-        return os << r.data;
+        os << r.data;
+        if (r.encoded_topics) {
+            os << " encoded_topics: " << r.encoded_topics->size();
+        }
+        return os;
     }
 };
 
@@ -25,6 +25,8 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <concepts>
 #include <optional>
 #include <type_traits>
 
@@ -178,6 +180,58 @@ public:
         return do_read_array(len - 1, std::forward<ElementParser>(parser));
     }
 
+    /*
+     * The variants below decode elements directly into the vector storage of
+     * the destination field. This avoids constructing and moving a temporary
+     * for every element of arrays of structs.
+     */
+    template<typename T, typename ElementParser>
+    requires std::invocable<ElementParser, request_reader&, T&>
+    void read_array(std::vector<T>& out, ElementParser&& parser) {
+        auto len = read_int32();
+        if (len < 0) {
+            throw std::out_of_range(
+              "Attempt to read array with negative length");
+        }
+        do_read_array(len, out, std::forward<ElementParser>(parser));
+    }
+
+    template<typename T, typename ElementParser>
+    requires std::invocable<ElementParser, request_reader&, T&>
+    void read_flex_array(std::vector<T>& out, ElementParser&& parser) {
+        auto len = read_unsigned_varint();
+        if (len == 0) {
+            throw std::out_of_range(
+              "Attempt to read non-null flex array with 0 length");
+        }
+        do_read_array(len - 1, out, std::forward<ElementParser>(parser));
+    }
+
+    template<typename T, typename ElementParser>
+    requires std::invocable<ElementParser, request_reader&, T&>
+    void read_nullable_array(
+      std::optional<std::vector<T>>& out, ElementParser&& parser) {
+        auto len = read_int32();
+        if (len < 0) {
+            out = std::nullopt;
+            return;
+        }
+        do_read_array(len, out.emplace(), std::forward<ElementParser>(parser));
+    }
+
+    template<typename T, typename ElementParser>
+    requires std::invocable<ElementParser, request_reader&, T&>
+    void read_nullable_flex_array(
+      std::optional<std::vector<T>>& out, ElementParser&& parser) {
+        auto len = read_unsigned_varint();
+        if (len == 0) {
+            out = std::nullopt;
+            return;
+        }
+        do_read_array(
+          len - 1, out.emplace(), std::forward<ElementParser>(parser));
+    }
+
     // Only relevent when reading flex requests
     tagged_fields read_tags() {
         tagged_fields::type tags;
@@ -237,13 +291,32 @@ private:
             throw std::out_of_range("Attempt to parse array w/ negative len");
         }
         std::vector<T> res;
-        res.reserve(len);
+        res.reserve(reserve_size(len));
         while (len-- > 0) {
             res.push_back(parser(*this));
         }
         return res;
     }
 
+    template<typename T, typename ElementParser>
+    void
+    do_read_array(int64_t len, std::vector<T>& out, ElementParser&& parser) {
+        if (len < 0) {
+            throw std::out_of_range("Attempt to parse array w/ negative len");
+        }
+        out.clear();
+        out.reserve(reserve_size(len));
+        while (len-- > 0) {
+            parser(*this, out.emplace_back());
+        }
+    }
+
+    /// Every encoded element takes at least a byte, the array length is
+    /// client provided and must not size the allocation on its own
+    size_t reserve_size(int64_t len) const {
+        return std::min<size_t>(len, _parser.bytes_left());
+    }
+
     iobuf_parser _parser;
 };
 
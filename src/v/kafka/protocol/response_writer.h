@@ -363,8 +363,13 @@ private:
     iobuf* _out;
 };
 
-inline void
-writer_serialize_batch(response_writer& w, model::record_batch&& batch) {
+/**
+ * Writes the kafka batch header equivalent of the redpanda header. Both
+ * headers have the same size so the batch length can be derived directly from
+ * the redpanda batch size.
+ */
+inline void writer_serialize_batch_header(
+  response_writer& w, const model::record_batch_header& hdr) {
     /*
      * calculate batch size expected by kafka client.
      *
@@ -381,24 +386,29 @@ writer_serialize_batch(response_writer& w, model::record_batch&& batch) {
      * header does not include the offset preceeding the length field nor
      * the size of the length field itself.
      */
-    auto size = batch.size_bytes() - model::packed_record_batch_header_size
+    auto size = hdr.size_bytes - model::packed_record_batch_header_size
                 + internal::kafka_header_size - sizeof(int64_t)
                 - sizeof(int32_t);
 
-    w.write(int64_t(batch.base_offset()));
+    w.write(int64_t(hdr.base_offset()));
     w.write(int32_t(size)); // batch length
     w.write(
-      int32_t(leader_epoch_from_term(batch.term()))); // partition leader epoch
+      int32_t(leader_epoch_from_term(hdr.ctx.term))); // partition leader epoch
     w.write(int8_t(2));                               // magic
-    w.write(batch.header().crc);
-    w.write(int16_t(batch.header().attrs.value()));
-    w.write(int32_t(batch.header().last_offset_delta));
-    w.write(int64_t(batch.header().first_timestamp.value()));
-    w.write(int64_t(batch.header().max_timestamp.value()));
-    w.write(int64_t(batch.header().producer_id));
-    w.write(int16_t(batch.header().producer_epoch));
-    w.write(int32_t(batch.header().base_sequence));
-    w.write(int32_t(batch.record_count()));
+    w.write(hdr.crc);
+    w.write(int16_t(hdr.attrs.value()));
+    w.write(int32_t(hdr.last_offset_delta));
+    w.write(int64_t(hdr.first_timestamp.value()));
+    w.write(int64_t(hdr.max_timestamp.value()));
+    w.write(int64_t(hdr.producer_id));
+    w.write(int16_t(hdr.producer_epoch));
+    w.write(int32_t(hdr.base_sequence));
+    w.write(int32_t(hdr.record_count));
+}
+
+inline void
+writer_serialize_batch(response_writer& w, model::record_batch&& batch) {
+    writer_serialize_batch_header(w, batch.header());
     w.write_direct(std::move(batch).release_data());
 }
 
@@ -1062,7 +1062,25 @@ if ({{ cond }}) {
 {%- else %}
 {%- set fname = field.name %}
 {%- endif %}
-{%- if field.is_array %}
+{%- if field.is_array and field.type().value_type().is_struct %}
+{#- struct elements are decoded in place, see request_reader::read_array #}
+{%- if field.nullable() %}
+{%- if flex %}
+reader.read_nullable_flex_array({{ fname }}, [version](request_reader& reader, {{ field.value_type }}& v) {
+{%- else %}
+reader.read_nullable_array({{ fname }}, [version](request_reader& reader, {{ field.value_type }}& v) {
+{%- endif %}
+{%- else %}
+{%- if flex %}
+reader.read_flex_array({{ fname }}, [version](request_reader& reader, {{ field.value_type }}& v) {
+{%- else %}
+reader.read_array({{ fname }}, [version](request_reader& reader, {{ field.value_type }}& v) {
+{%- endif %}
+{%- endif %}
+    (void)version;
+{{- struct_serde(field.type().value_type(), methods, "v") | indent }}
+});
+{%- elif field.is_array %}
 {%- if field.nullable() %}
 {%- if flex %}
 {{ fname }} = reader.read_nullable_flex_array([version](request_reader& reader) {
@@ -1077,11 +1095,6 @@ if ({{ cond }}) {
 {%- endif %}
 {%- endif %}
     (void)version;
-{%- if field.type().value_type().is_struct %}
-    {{ field.type().value_type().name }} v;
-{{- struct_serde(field.type().value_type(), methods, "v") | indent }}
-    return v;
-{%- else %}
 {%- set decoder, named_type = field.decoder(flex) %}
 {%- if named_type == None %}
     return reader.{{ decoder }};
@@ -1096,7 +1109,6 @@ if ({{ cond }}) {
 {%- else %}
     return {{ named_type }}(reader.{{ decoder }});
 {%- endif %}
-{%- endif %}
 });
 {%- else %}
 {%- set decoder, named_type = field.decoder(flex) %}
@@ -16,6 +16,8 @@
 #include "model/fundamental.h"
 #include "model/tests/random_batch.h"
 #include "redpanda/tests/fixture.h"
+#include "storage/parser_utils.h"
+#include "storage/record_batch_builder.h"
 
 #include <seastar/core/circular_buffer.hh>
 #include <seastar/core/sstring.hh>
@@ -219,3 +221,76 @@ SEASTAR_THREAD_TEST_CASE(batch_reader_record_batch_reader_impl_fail_magic) {
           return e.error == kafka::error_code::corrupt_message;
       });
 }
+
+SEASTAR_THREAD_TEST_CASE(kafka_batch_adapter_compressed_record_count) {
+    storage::record_batch_builder builder(
+      model::record_batch_type::raft_data, model::offset(0));
+    builder.set_compression(model::compression::zstd);
+    for (int i = 0; i < 10; ++i) {
+        iobuf v;
+        v.append("value", 5);
+        builder.add_raw_kv(iobuf{}, std::move(v));
+    }
+    auto batch = std::move(builder).build();
+    BOOST_REQUIRE(batch.compressed());
+
+    auto serialize = [](model::record_batch b) {
+        return model::make_memory_record_batch_reader(std::move(b))
+          .consume(kafka::kafka_batch_serializer{}, model::no_timeout)
+          .get()
+          .data;
+    };
+
+    kafka::kafka_batch_adapter valid;
+    valid.adapt(serialize(batch.copy()));
+    BOOST_REQUIRE(valid.valid_crc);
+    BOOST_REQUIRE(valid.batch);
+
+    // the header declares one record less than the compressed payload holds
+    auto hdr = batch.header();
+    hdr.record_count = 9;
+    storage::internal::reset_size_checksum_metadata(hdr, batch.data());
+    kafka::kafka_batch_adapter invalid;
+    invalid.adapt(serialize(model::record_batch(
+      hdr, batch.data().copy(), model::record_batch::tag_ctor_ng{})));
+    BOOST_REQUIRE(invalid.valid_crc);
+    BOOST_REQUIRE(!invalid.batch);
+}
+
+SEASTAR_THREAD_TEST_CASE(kafka_batch_adapter_uncompressed_record_count) {
+    storage::record_batch_builder builder(
+      model::record_batch_type::raft_data, model::offset(0));
+    for (int i = 0; i < 10; ++i) {
+        iobuf k;
+        k.append("key", 3);
+        iobuf v;
+        v.append("value", 5);
+        builder.add_raw_kv(std::move(k), std::move(v));
+    }
+    auto batch = std::move(builder).build();
+    BOOST_REQUIRE(!batch.compressed());
+
+    auto serialize = [](model::record_batch b) {
+        return model::make_memory_record_batch_reader(std::move(b))
+          .consume(kafka::kafka_batch_serializer{}, model::no_timeout)
+          .get()
+          .data;
+    };
+
+    kafka::kafka_batch_adapter valid;
+    valid.adapt(serialize(batch.copy()));
+    BOOST_REQUIRE(valid.valid_crc);
+    BOOST_REQUIRE(valid.batch);
+    BOOST_REQUIRE_EQUAL(valid.batch->record_count(), 10);
+    BOOST_REQUIRE_EQUAL(valid.batch->copy_records().size(), 10);
+
+    // the header declares one record less than the payload holds
+    auto hdr = batch.header();
+    hdr.record_count = 9;
+    storage::internal::reset_size_checksum_metadata(hdr, batch.data());
+    kafka::kafka_batch_adapter invalid;
+    invalid.adapt(serialize(model::record_batch(
+      hdr, batch.data().copy(), model::record_batch::tag_ctor_ng{})));
+    BOOST_REQUIRE(invalid.valid_crc);
+    BOOST_REQUIRE(!invalid.batch);
+}
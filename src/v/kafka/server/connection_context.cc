@@ -12,6 +12,7 @@
 
 #include "bytes/iobuf.h"
 #include "config/configuration.h"
+#include "kafka/protocol/produce.h"
 #include "kafka/protocol/sasl_authenticate.h"
 #include "kafka/server/handlers/handler_interface.h"
 #include "kafka/server/protocol.h"
@@ -21,6 +22,7 @@
 #include "kafka/server/response.h"
 #include "security/exceptions.h"
 #include "units.h"
+#include "utils/request_tracer.h"
 #include "vlog.h"
 
 #include <seastar/core/coroutine.hh>
@@ -192,27 +194,55 @@ ss::future<session_resources> connection_context::throttle_request(
       hdr.client_id, request_size);
     auto tracker = std::make_unique<request_tracker>(_rs.probe());
     auto fut = ss::now();
+    // the quota delay is deliberate and isn't accounted as queueing delay
+    auto queued_at = ss::lowres_clock::now();
     if (!delay.first_violation) {
         fut = ss::sleep_abortable(delay.duration, _rs.abort_source());
+        queued_at += delay.duration;
     }
     auto track = track_latency(hdr.key);
-    return fut
-      .then([this, key = hdr.key, request_size] {
-          return reserve_request_units(key, request_size);
+    /*
+     * the in-flight window is taken first so that a connection with a full
+     * window doesn't hold on to memory units it can't use yet.
+     */
+    return fut.then([this, key = hdr.key] { return wait_for_memory(key); })
+      .then([this] { return ss::get_units(_in_flight, 1); })
+      .then([this, key = hdr.key, request_size](
+              ssx::semaphore_units in_flight_units) {
+          return reserve_request_units(key, request_size)
+            .then([in_flight_units = std::move(in_flight_units)](
+                    ssx::semaphore_units mem_units) mutable {
+                return std::make_pair(
+                  std::move(in_flight_units), std::move(mem_units));
+            });
       })
-      .then([this, delay, track, tracker = std::move(tracker)](
-              ssx::semaphore_units units) mutable {
+      .then([this,
+             key = hdr.key,
+             queued_at,
+             delay,
+             track,
+             tracker = std::move(tracker)](
+              std::pair<ssx::semaphore_units, ssx::semaphore_units>
+                units) mutable {
           return server().get_request_unit().then(
             [this,
+             key,
+             queued_at,
              delay,
-             mem_units = std::move(units),
+             units = std::move(units),
              track,
              tracker = std::move(tracker)](
               ssx::semaphore_units qd_units) mutable {
+                _proto.probe().request_admitted(
+                  key,
+                  std::max(
+                    ss::lowres_clock::now() - queued_at,
+                    ss::lowres_clock::duration(0)));
                 session_resources r{
                   .backpressure_delay = delay.duration,
-                  .memlocks = std::move(mem_units),
+                  .memlocks = std::move(units.second),
                   .queue_units = std::move(qd_units),
+                  .in_flight_units = std::move(units.first),
                   .tracker = std::move(tracker),
                 };
                 if (track) {
@@ -223,6 +253,33 @@ ss::future<session_resources> connection_context::throttle_request(
       });
 }
 
+ss::future<> connection_context::wait_for_memory(api_key key) {
+    static constexpr std::chrono::milliseconds min_backoff{10};
+    static constexpr std::chrono::milliseconds max_backoff{500};
+    static constexpr std::chrono::milliseconds max_wait{5000};
+
+    const auto reserve_percent
+      = config::shard_local_cfg().kafka_request_memory_reserve_percent();
+    if (reserve_percent == 0 || is_priority_request(key)) {
+        co_return;
+    }
+    const auto reserve = _rs.max_memory() * reserve_percent / 100;
+    const auto max_delay = std::min(
+      max_wait, config::shard_local_cfg().max_kafka_throttle_delay_ms());
+
+    auto backoff = min_backoff;
+    std::chrono::milliseconds waited{0};
+    while (static_cast<int64_t>(_rs.memory().available_units()) < reserve
+           && waited < max_delay && !_rs.abort_requested()) {
+        if (waited.count() == 0) {
+            _proto.probe().admission_delayed();
+        }
+        co_await ss::sleep_abortable(backoff, _rs.abort_source());
+        waited += backoff;
+        backoff = std::min(backoff * 2, max_backoff);
+    }
+}
+
 ss::future<ssx::semaphore_units>
 connection_context::reserve_request_units(api_key key, size_t size) {
     // Defer to the handler for the request type for the memory estimate, but
@@ -269,8 +326,20 @@ connection_context::dispatch_method_once(request_header hdr, size_t size) {
                   return ss::now();
               }
               auto self = shared_from_this();
+              auto& tracer = request_tracer::local();
+              const auto trace = hdr.key == produce_api::key
+                                   ? tracer.maybe_start(
+                                     config::shard_local_cfg()
+                                       .request_trace_sample_rate())
+                                   : trace_id{};
+              tracer.record(trace, trace_stage::kafka_request_received);
+              const auto trace_start = request_tracer::clock_type::now();
               auto rctx = request_context(
-                self, std::move(hdr), std::move(buf), sres->backpressure_delay);
+                self,
+                std::move(hdr),
+                std::move(buf),
+                sres->backpressure_delay,
+                trace);
               /*
                * we process requests in order since all subsequent requests
                * are dependent on authentication having completed.
@@ -304,6 +373,8 @@ connection_context::dispatch_method_once(request_header hdr, size_t size) {
                                f = std::move(res.response),
                                seq,
                                correlation,
+                               trace,
+                               trace_start,
                                self,
                                sres = std::move(sres)](ss::future<> d) mutable {
                     /*
@@ -338,12 +409,26 @@ connection_context::dispatch_method_once(request_header hdr, size_t size) {
                            f = std::move(f),
                            sres = std::move(sres),
                            seq,
-                           correlation]() mutable {
+                           correlation,
+                           trace,
+                           trace_start]() mutable {
                               return f.then(
                                 [this,
                                  sres = std::move(sres),
                                  seq,
-                                 correlation](response_ptr r) mutable {
+                                 correlation,
+                                 trace,
+                                 trace_start](response_ptr r) mutable {
+                                    auto& tracer = request_tracer::local();
+                                    tracer.record(
+                                      trace,
+                                      trace_stage::kafka_response_ready);
+                                    tracer.finish(
+                                      trace,
+                                      request_tracer::clock_type::now()
+                                        - trace_start,
+                                      config::shard_local_cfg()
+                                        .request_trace_slow_threshold_ms());
                                     r->set_correlation(correlation);
                                     response_and_resources randr{
                                       std::move(r), std::move(sres)};
@@ -390,6 +475,33 @@ connection_context::dispatch_method_once(request_header hdr, size_t size) {
     });
 }
 
+ss::future<> connection_context::sequence_partition_dispatch(
+  model::ntp ntp, ss::shared_future<> dispatched) {
+    const auto id = ++_partition_dispatch_id;
+    auto previous = ss::now();
+    if (auto it = _partition_dispatches.find(ntp);
+        it != _partition_dispatches.end()) {
+        previous = it->second.dispatched.get_future().handle_exception(
+          [](const std::exception_ptr&) {
+              // the dispatch failure is reported by its own request
+          });
+        it->second = partition_dispatch{.dispatched = dispatched, .id = id};
+    } else {
+        _partition_dispatches.emplace(
+          ntp, partition_dispatch{.dispatched = dispatched, .id = id});
+    }
+    // forget the partition once its last dispatch completed
+    ssx::background = dispatched.get_future().then_wrapped(
+      [self = shared_from_this(), ntp = std::move(ntp), id](ss::future<> f) {
+          f.ignore_ready_future();
+          auto it = self->_partition_dispatches.find(ntp);
+          if (it != self->_partition_dispatches.end() && it->second.id == id) {
+              self->_partition_dispatches.erase(it);
+          }
+      });
+    return previous;
+}
+
 /**
  * This method processes as many responses as possible, in request order. Since
  * we proces the second stage asynchronously within a given connection, reponses
@@ -9,9 +9,11 @@
  * by the Apache License, Version 2.0
  */
 #pragma once
+#include "config/configuration.h"
 #include "kafka/server/protocol.h"
 #include "kafka/server/response.h"
 #include "kafka/types.h"
+#include "model/fundamental.h"
 #include "net/server.h"
 #include "seastarx.h"
 #include "security/acl.h"
@@ -23,6 +25,7 @@
 
 #include <seastar/core/future.hh>
 #include <seastar/core/lowres_clock.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/shared_ptr.hh>
 
 #include <absl/container/flat_hash_map.h>
@@ -76,6 +79,8 @@ struct session_resources {
     ss::lowres_clock::duration backpressure_delay;
     ssx::semaphore_units memlocks;
     ssx::semaphore_units queue_units;
+    // slot in the connection in-flight requests window
+    ssx::semaphore_units in_flight_units;
     std::unique_ptr<hdr_hist::measurement> method_latency;
     std::unique_ptr<request_tracker> tracker;
 };
@@ -96,7 +101,10 @@ public:
       , _client_addr(_rs.conn ? _rs.conn->addr.addr() : ss::net::inet_address{})
       , _enable_authorizer(enable_authorizer)
       , _authlog(_client_addr, client_port())
-      , _mtls_state(std::move(mtls_state)) {}
+      , _mtls_state(std::move(mtls_state))
+      , _in_flight(
+          config::shard_local_cfg().kafka_connection_max_in_flight_requests(),
+          "kafka/conn-in-flight") {}
 
     ~connection_context() noexcept = default;
     connection_context(const connection_context&) = delete;
@@ -188,6 +196,17 @@ public:
 
     ss::future<> process_one_request();
     bool is_finished_parsing() const;
+
+    /**
+     * Orders the dispatch of a produce to a partition after the previous
+     * dispatch to the same partition from this connection, so that requests
+     * to different partitions are dispatched concurrently while the append
+     * order within a partition follows the request order. Returns a future
+     * which resolves once the previous dispatch completed, either way.
+     */
+    ss::future<>
+    sequence_partition_dispatch(model::ntp, ss::shared_future<> dispatched);
+
     ss::net::inet_address client_host() const { return _client_addr; }
     uint16_t client_port() const {
         return _rs.conn ? _rs.conn->addr.port() : 0;
@@ -210,6 +229,12 @@ private:
     ss::future<session_resources>
     throttle_request(const request_header&, size_t sz);
 
+    // Delay requests off the data path while the request memory of the shard
+    // is nearly exhausted, leaving the remaining memory to produce and fetch.
+    // The delay is bounded by the maximum throttle delay after which the
+    // request competes for memory as usual.
+    ss::future<> wait_for_memory(api_key);
+
     ss::future<> dispatch_method_once(request_header, size_t sz);
 
     /**
@@ -241,6 +266,13 @@ private:
     using sequence_id = named_type<uint64_t, struct kafka_protocol_sequence>;
     using map_t = absl::flat_hash_map<sequence_id, response_and_resources>;
 
+    // last dispatch to a partition, tagged to tell whether a later one
+    // replaced it
+    struct partition_dispatch {
+        ss::shared_future<> dispatched;
+        uint64_t id;
+    };
+
     class ctx_log {
     public:
         ctx_log(const ss::net::inet_address& addr, uint16_t port)
@@ -301,6 +333,9 @@ private:
     const bool _enable_authorizer;
     ctx_log _authlog;
     std::optional<security::tls::mtls_state> _mtls_state;
+    ssx::semaphore _in_flight;
+    absl::flat_hash_map<model::ntp, partition_dispatch> _partition_dispatches;
+    uint64_t _partition_dispatch_id{0};
 };
 
 } // namespace kafka
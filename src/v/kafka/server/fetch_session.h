@@ -30,6 +30,13 @@ struct fetch_session_partition {
     model::offset high_watermark;
     model::offset last_stable_offset;
     kafka::leader_epoch current_leader_epoch = invalid_leader_epoch;
+    // set when the last read of the partition returned nothing and the fetch
+    // offset reached the high watermark. Idle partitions are not read in
+    // incremental fetches until they change, see
+    // fetch_session_cache::watch_idle_partition
+    bool idle = false;
+    // leadership term the partition went idle in
+    model::term_id idle_term;
 };
 /**
  * Map of partitions that is kept by fetch session. This map is using intrusive
@@ -100,7 +107,9 @@ private:
 
     static auto make_partition_iterator(io_list_t::const_iterator it) {
         return boost::iterators::make_transform_iterator(
-          it, [](const entry& e) { return e.partition; });
+          it, [](const entry& e) -> const kafka::fetch_session_partition& {
+              return e.partition;
+          });
     }
 
 public:
@@ -7,6 +7,7 @@
 #include "model/fundamental.h"
 #include "model/timeout_clock.h"
 #include "prometheus/prometheus_sanitize.h"
+#include "ssx/future-util.h"
 
 #include <seastar/core/metrics.hh>
 
@@ -35,8 +36,12 @@ void update_fetch_session(fetch_session& session, const fetch_request& req) {
 
         if (auto s_it = session.partitions().find(tp);
             s_it != session.partitions().end()) {
-            s_it->second->partition.max_bytes = partition.max_bytes;
-            s_it->second->partition.fetch_offset = partition.fetch_offset;
+            auto& fp = s_it->second->partition;
+            fp.max_bytes = partition.max_bytes;
+            if (fp.fetch_offset != partition.fetch_offset) {
+                fp.fetch_offset = partition.fetch_offset;
+                fp.idle = false;
+            }
         } else {
             session.partitions().emplace(
               make_fetch_partition(topic.name, partition));
@@ -69,6 +74,12 @@ fetch_session_cache::fetch_session_cache(
     _session_eviction_timer.arm(_session_eviction_duration);
 }
 
+ss::future<> fetch_session_cache::stop() {
+    _session_eviction_timer.cancel();
+    _as.request_abort();
+    return _gate.close();
+}
+
 fetch_session_ctx
 fetch_session_cache::maybe_get_session(const fetch_request& req) {
     fetch_session_id session_id{req.data.session_id};
@@ -145,6 +156,52 @@ fetch_session_cache::maybe_get_session(const fetch_request& req) {
     return fetch_session_ctx(session, false);
 }
 
+void fetch_session_cache::watch_idle_partition(
+  fetch_session_id session_id,
+  model::topic_partition tp,
+  ss::shard_id shard,
+  partition_watch_fn watch) {
+    ssx::spawn_with_gate(
+      _gate,
+      [this,
+       session_id,
+       tp = std::move(tp),
+       shard,
+       watch = std::move(watch)]() mutable {
+          auto deadline = model::timeout_clock::now()
+                          + _session_eviction_duration;
+          return container()
+            .invoke_on(
+              shard,
+              [watch = std::move(watch),
+               deadline](fetch_session_cache& remote) mutable {
+                  return ss::with_gate(
+                    remote._gate, [&remote, &watch, deadline] {
+                        return watch(remote._as, deadline);
+                    });
+              })
+            .handle_exception([](const std::exception_ptr&) {
+                // timeouts, aborts and errors all make the partition
+                // eligible for reading again
+            })
+            .then([this, session_id, tp = std::move(tp)] {
+                mark_partition_changed(session_id, tp);
+            });
+      });
+}
+
+void fetch_session_cache::mark_partition_changed(
+  fetch_session_id session_id, model::topic_partition_view tp) {
+    auto it = _sessions.find(session_id);
+    if (it == _sessions.end()) {
+        return;
+    }
+    auto& partitions = it->second->partitions();
+    if (auto p_it = partitions.find(tp); p_it != partitions.end()) {
+        p_it->second->partition.idle = false;
+    }
+}
+
 // we split whole range from 1 to max int32_t betewen all shards
 std::optional<fetch_session_id> fetch_session_cache::new_session_id() {
     if (unlikely(
@@ -14,7 +14,11 @@
 #include "kafka/types.h"
 #include "units.h"
 
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/gate.hh>
 #include <seastar/core/metrics_registration.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/util/noncopyable_function.hh>
 
 #include <absl/container/flat_hash_map.h>
 
@@ -32,12 +36,32 @@ struct fetch_request;
  * Fetch session cache will stop adding new sessions after its max memory usage
  * is reached.
  **/
-class fetch_session_cache {
+class fetch_session_cache
+  : public ss::peering_sharded_service<fetch_session_cache> {
 public:
+    /// Waits for a change of a partition, executed on the partition shard.
+    using partition_watch_fn = ss::noncopyable_function<ss::future<>(
+      ss::abort_source&, model::timeout_clock::time_point)>;
+
     explicit fetch_session_cache(std::chrono::milliseconds);
+    ss::future<> stop();
+
     fetch_session_ctx maybe_get_session(const fetch_request& req);
     size_t size() const { return _sessions.size(); }
 
+    /**
+     * Watches a partition that went idle in a session. The watch runs on the
+     * shard owning the partition and, once it resolves, the partition is
+     * marked as changed so that the next fetch in the session reads it
+     * again. Watches are bounded by the session eviction timeout so that
+     * partitions are eventually re-read even without a notification.
+     */
+    void watch_idle_partition(
+      fetch_session_id, model::topic_partition, ss::shard_id, partition_watch_fn);
+
+    /// Clears the idle state of a session partition
+    void mark_partition_changed(fetch_session_id, model::topic_partition_view);
+
 private:
     using underlying_t
       = absl::flat_hash_map<fetch_session_id, fetch_session_ptr>;
@@ -75,6 +99,9 @@ private:
 
     size_t _sessions_mem_usage = 0;
 
+    ss::abort_source _as;
+    ss::gate _gate;
+
     ss::metrics::metric_groups _metrics;
 };
 
@@ -52,15 +52,20 @@ group::group(
   config::configuration& conf,
   ss::lw_shared_ptr<cluster::partition> partition,
   group_metadata_serializer serializer,
-  enable_group_metrics group_metrics)
+  enable_group_metrics group_metrics,
+  ss::lw_shared_ptr<offset_commit_batcher> commit_batcher)
   : _id(std::move(id))
   , _state(s)
   , _state_timestamp(model::timestamp::now())
   , _generation(0)
   , _num_members_joining(0)
+  , _expiry([this](member_ptr member, clock_type::time_point deadline) {
+      heartbeat_expire(member->id(), deadline);
+  })
   , _new_member_added(false)
   , _conf(conf)
   , _partition(std::move(partition))
+  , _commit_batcher(std::move(commit_batcher))
   , _probe(_members, _static_members, _offsets)
   , _recovery_policy(
       config::shard_local_cfg().rm_violation_recovery_policy.value())
@@ -79,12 +84,17 @@ group::group(
   config::configuration& conf,
   ss::lw_shared_ptr<cluster::partition> partition,
   group_metadata_serializer serializer,
-  enable_group_metrics group_metrics)
+  enable_group_metrics group_metrics,
+  ss::lw_shared_ptr<offset_commit_batcher> commit_batcher)
   : _id(std::move(id))
   , _num_members_joining(0)
+  , _expiry([this](member_ptr member, clock_type::time_point deadline) {
+      heartbeat_expire(member->id(), deadline);
+  })
   , _new_member_added(false)
   , _conf(conf)
   , _partition(std::move(partition))
+  , _commit_batcher(std::move(commit_batcher))
   , _probe(_members, _static_members, _offsets)
   , _recovery_policy(
       config::shard_local_cfg().rm_violation_recovery_policy.value())
@@ -338,6 +348,10 @@ void group::add_missing_assignments(assignments_type& assignments) const {
 }
 
 void group::set_assignments(assignments_type assignments) const {
+    set_assignments(share_assignments(std::move(assignments)));
+}
+
+void group::set_assignments(shared_assignments_type assignments) const {
     std::for_each(
       std::cbegin(_members),
       std::cend(_members),
@@ -346,6 +360,23 @@ void group::set_assignments(assignments_type assignments) const {
       });
 }
 
+group::shared_assignments_type
+group::share_assignments(assignments_type assignments) {
+    iobuf buffer;
+    for (const auto& [_, assignment] : assignments) {
+        buffer.append(assignment.data(), assignment.size());
+    }
+
+    shared_assignments_type shared;
+    shared.reserve(assignments.size());
+    size_t pos = 0;
+    for (auto& [id, assignment] : assignments) {
+        shared.emplace(id, buffer.share(pos, assignment.size()));
+        pos += assignment.size();
+    }
+    return shared;
+}
+
 void group::clear_assignments() const {
     std::for_each(
       std::cbegin(_members),
@@ -894,15 +925,10 @@ group::join_group_stages group::add_member_and_rebalance(
     // to a lot of defunct members in the rebalance. To prevent this going on
     // indefinitely, we timeout JoinGroup requests for new members. If the new
     // member is still there, we expect it to retry.</kafka>
-    member->expire_timer().cancel();
     auto now = clock_type::now();
     member->set_latest_heartbeat(now);
     auto deadline = now + _conf.group_new_member_join_timeout();
-    member->expire_timer().set_callback(
-      [this, deadline, member_id = member->id()]() {
-          heartbeat_expire(member_id, deadline);
-      });
-    member->expire_timer().arm(deadline);
+    _expiry.schedule(member, deadline);
 
     vlog(
       _ctxlog.trace,
@@ -1011,8 +1037,8 @@ void group::complete_join() {
         if (!it->second->is_joining() && !it->second->is_static()) {
             vlog(_ctxlog.trace, "Removing unjoined member {}", it->first);
 
-            // cancel the heartbeat timer
-            it->second->expire_timer().cancel();
+            // cancel the heartbeat expiration
+            _expiry.cancel(*it->second);
 
             // update supported protocols count
             for (auto& p : it->second->protocols()) {
@@ -1075,7 +1101,7 @@ void group::complete_join() {
         if (in_state(group_state::empty)) {
             vlog(_ctxlog.trace, "Checkpointing empty group {}", *this);
             ssx::background
-              = store_group(checkpoint(assignments_type{}))
+              = store_group(checkpoint(shared_assignments_type{}))
                   .then(
                     []([[maybe_unused]] result<raft::replicate_result> r) {})
                   .finally([this_group = shared_from_this()] {});
@@ -1166,20 +1192,15 @@ void group::try_finish_joining_member(
 }
 
 void group::schedule_next_heartbeat_expiration(member_ptr member) {
-    member->expire_timer().cancel();
     auto now = clock_type::now();
     member->set_latest_heartbeat(now);
     auto deadline = now + member->session_timeout();
-    member->expire_timer().set_callback(
-      [this, deadline, member_id = member->id()]() {
-          heartbeat_expire(member_id, deadline);
-      });
     vlog(
       _ctxlog.trace,
       "Scheduling heartbeat expiration {} ms for {}",
       member->session_timeout(),
       member->id());
-    member->expire_timer().arm(deadline);
+    _expiry.schedule(member, deadline);
 }
 
 void group::remove_pending_member(kafka::member_id member_id) {
@@ -1201,8 +1222,10 @@ void group::shutdown() {
         timer.cancel();
     }
 
+    // cancel members heartbeat expirations
+    _expiry.clear();
+
     for (auto& [member_id, member] : _members) {
-        member->expire_timer().cancel();
         if (member->is_syncing()) {
             member->set_sync_response(sync_group_response(
               error_code::not_coordinator, member->assignment()));
@@ -1368,9 +1391,12 @@ group::sync_group_stages group::handle_sync_group(sync_group_request&& r) {
     __builtin_unreachable();
 }
 
-model::record_batch group::checkpoint(const assignments_type& assignments) {
-    return do_checkpoint(
-      [&assignments](const member_id& id) { return assignments.at(id); });
+model::record_batch
+group::checkpoint(const shared_assignments_type& assignments) {
+    return do_checkpoint([&assignments](const member_id& id) {
+        const auto& assignment = assignments.at(id);
+        return assignment.share(0, assignment.size_bytes());
+    });
 }
 
 model::record_batch group::checkpoint() {
@@ -1381,7 +1407,7 @@ model::record_batch group::checkpoint() {
           "Checkpointed member {} must be part of the group {}",
           id,
           *this);
-        return it->second->assignment();
+        return it->second->shared_assignment();
     });
 }
 
@@ -1408,8 +1434,9 @@ group::sync_group_stages group::sync_group_completing_rebalance(
     // underlying metadata topic for group recovery. the mapping is the
     // assignments in the request plus any missing assignments for group
     // members.
-    auto assignments = std::move(r).member_assignments();
-    add_missing_assignments(assignments);
+    auto request_assignments = std::move(r).member_assignments();
+    add_missing_assignments(request_assignments);
+    auto assignments = share_assignments(std::move(request_assignments));
 
     auto f = store_group(checkpoint(assignments))
                .then([this,
@@ -1580,7 +1607,7 @@ kafka::error_code group::member_leave_group(
         return ec;
     } else {
         auto member = get_member(member_id);
-        member->expire_timer().cancel();
+        _expiry.cancel(*member);
         remove_member(member);
         return error_code::none;
     }
@@ -2150,12 +2177,16 @@ group::offset_commit_stages group::store_offsets(offset_commit_request&& r) {
     }
 
     auto batch = std::move(builder).build();
-    auto reader = model::make_memory_record_batch_reader(std::move(batch));
 
-    auto replicate_stages = _partition->raft()->replicate_in_stages(
-      _term,
-      std::move(reader),
-      raft::replicate_options(raft::consistency_level::quorum_ack));
+    // commits of all the groups coordinated by the same partition are
+    // coalesced into a single append by the partition batcher
+    auto replicate_stages
+      = _commit_batcher
+          ? _commit_batcher->replicate(_term, std::move(batch))
+          : _partition->raft()->replicate_in_stages(
+            _term,
+            model::make_memory_record_batch_reader(std::move(batch)),
+            raft::replicate_options(raft::consistency_level::quorum_ack));
 
     auto f = replicate_stages.replicate_finished.then(
       [this, req = std::move(r), commits = std::move(offset_commits)](
@@ -2378,46 +2409,65 @@ group::handle_offset_commit(offset_commit_request&& r) {
     }
 }
 
-ss::future<offset_fetch_response>
-group::handle_offset_fetch(offset_fetch_request&& r) {
-    if (in_state(group_state::dead)) {
-        return ss::make_ready_future<offset_fetch_response>(
-          offset_fetch_response(r.data.topics));
-    }
-
-    offset_fetch_response resp;
-    resp.data.error_code = error_code::none;
-
-    // retrieve all topics available
-    if (!r.data.topics) {
+const group::offsets_snapshot& group::all_offsets() {
+    if (!_offsets_snapshot) {
         absl::flat_hash_map<
           model::topic,
           std::vector<offset_fetch_response_partition>>
           tmp;
         for (const auto& e : _offsets) {
-            offset_fetch_response_partition p = {
+            tmp[e.first.topic].push_back(offset_fetch_response_partition{
               .partition_index = e.first.partition,
-              .committed_offset = model::offset(-1),
-              .metadata = "",
+              .committed_offset = e.second->metadata.offset,
+              .committed_leader_epoch
+              = e.second->metadata.committed_leader_epoch,
+              .metadata = e.second->metadata.metadata,
               .error_code = error_code::none,
-            };
+            });
+        }
+        offsets_snapshot snapshot;
+        snapshot.reserve(tmp.size());
+        for (auto& e : tmp) {
+            snapshot.push_back(
+              {.name = e.first, .partitions = std::move(e.second)});
+        }
+        _offsets_snapshot = std::move(snapshot);
+    }
+    return *_offsets_snapshot;
+}
 
-            if (r.data.require_stable && has_pending_transaction(e.first)) {
+group::offsets_snapshot group::all_offsets_with_pending_transactions() {
+    auto topics = all_offsets();
+    for (auto& t : topics) {
+        for (auto& p : t.partitions) {
+            if (has_pending_transaction({t.name, p.partition_index})) {
+                p.committed_offset = model::offset(-1);
+                p.committed_leader_epoch = kafka::invalid_leader_epoch;
+                p.metadata = "";
                 p.error_code = error_code::unstable_offset_commit;
-            } else {
-                p.committed_offset = e.second->metadata.offset;
-                p.committed_leader_epoch
-                  = e.second->metadata.committed_leader_epoch;
-                p.metadata = e.second->metadata.metadata;
             }
-            tmp[e.first.topic].push_back(std::move(p));
         }
+    }
+    return topics;
+}
 
-        for (auto& e : tmp) {
-            resp.data.topics.push_back(
-              {.name = e.first, .partitions = std::move(e.second)});
-        }
+ss::future<offset_fetch_response>
+group::handle_offset_fetch(offset_fetch_request&& r) {
+    if (in_state(group_state::dead)) {
+        return ss::make_ready_future<offset_fetch_response>(
+          offset_fetch_response(r.data.topics));
+    }
 
+    offset_fetch_response resp;
+    resp.data.error_code = error_code::none;
+
+    // retrieve all topics available
+    if (!r.data.topics) {
+        if (r.data.require_stable && has_pending_transactions()) {
+            resp.data.topics = all_offsets_with_pending_transactions();
+        } else {
+            resp.data.topics = all_offsets();
+        }
         return ss::make_ready_future<offset_fetch_response>(std::move(resp));
     }
 
@@ -2578,6 +2628,7 @@ group::remove_topic_partitions(const std::vector<model::topic_partition>& tps) {
     for (const auto& tp : tps) {
         _pending_offset_commits.erase(tp);
         if (auto offset = _offsets.extract(tp); offset) {
+            _offsets_snapshot.reset();
             removed.emplace_back(
               std::move(offset.key()), std::move(offset.mapped()->metadata));
         }
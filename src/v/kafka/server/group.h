@@ -18,9 +18,12 @@
 #include "kafka/group_probe.h"
 #include "kafka/protocol/fwd.h"
 #include "kafka/protocol/offset_commit.h"
+#include "kafka/protocol/offset_fetch.h"
 #include "kafka/server/group_metadata.h"
 #include "kafka/server/logger.h"
 #include "kafka/server/member.h"
+#include "kafka/server/member_expiry_wheel.h"
+#include "kafka/server/offset_commit_batcher.h"
 #include "kafka/types.h"
 #include "model/fundamental.h"
 #include "model/namespace.h"
@@ -35,6 +38,7 @@
 #include <seastar/util/bool_class.hh>
 #include <seastar/util/log.hh>
 
+#include <absl/container/flat_hash_map.h>
 #include <absl/container/node_hash_map.h>
 #include <absl/container/node_hash_set.h>
 
@@ -118,6 +122,8 @@ class group final : public ss::enable_lw_shared_from_this<group> {
 public:
     using clock_type = ss::lowres_clock;
     using duration_type = clock_type::duration;
+    // member assignments viewing a single buffer, see share_assignments
+    using shared_assignments_type = absl::flat_hash_map<member_id, iobuf>;
 
     static constexpr int8_t fence_control_record_version{0};
     static constexpr int8_t prepared_tx_record_version{0};
@@ -186,7 +192,8 @@ public:
       config::configuration& conf,
       ss::lw_shared_ptr<cluster::partition> partition,
       group_metadata_serializer,
-      enable_group_metrics);
+      enable_group_metrics,
+      ss::lw_shared_ptr<offset_commit_batcher> = nullptr);
 
     // constructor used when loading state from log
     group(
@@ -195,7 +202,8 @@ public:
       config::configuration& conf,
       ss::lw_shared_ptr<cluster::partition> partition,
       group_metadata_serializer,
-      enable_group_metrics);
+      enable_group_metrics,
+      ss::lw_shared_ptr<offset_commit_batcher> = nullptr);
 
     /// Get the group id.
     const kafka::group_id& id() const { return _id; }
@@ -359,6 +367,16 @@ public:
      * belong to the group.
      */
     void set_assignments(assignments_type assignments) const;
+    void set_assignments(shared_assignments_type assignments) const;
+
+    /**
+     * \brief Copy the assignments into a single buffer.
+     *
+     * Each member's assignment is a view of the shared buffer so that large
+     * groups don't allocate and copy one buffer per member when assignments
+     * are checkpointed and installed.
+     */
+    static shared_assignments_type share_assignments(assignments_type);
 
     /// Clears all member assignments.
     void clear_assignments() const;
@@ -531,6 +549,7 @@ public:
     handle_offset_fetch(offset_fetch_request&& r);
 
     void insert_offset(model::topic_partition tp, offset_metadata md) {
+        _offsets_snapshot.reset();
         if (auto o_it = _offsets.find(tp); o_it != _offsets.end()) {
             o_it->second->metadata = std::move(md);
         } else {
@@ -545,10 +564,12 @@ public:
         if (auto o_it = _offsets.find(tp); o_it != _offsets.end()) {
             if (o_it->second->metadata.log_offset < md.log_offset) {
                 o_it->second->metadata = std::move(md);
+                _offsets_snapshot.reset();
                 return true;
             }
             return false;
         } else {
+            _offsets_snapshot.reset();
             _offsets.emplace(
               std::move(tp),
               std::make_unique<offset_metadata_with_probe>(
@@ -676,7 +697,7 @@ private:
           });
     }
 
-    model::record_batch checkpoint(const assignments_type& assignments);
+    model::record_batch checkpoint(const shared_assignments_type& assignments);
     model::record_batch checkpoint();
 
     template<typename Func>
@@ -692,15 +713,24 @@ private:
         metadata.leader = leader();
         metadata.state_timestamp = _state_timestamp;
 
+        metadata.members.reserve(_members.size());
         for (const auto& [id, member] : _members) {
-            auto state = member->state().copy();
-            // this is not coming from the member itself because the checkpoint
-            // occurs right before the members go live and get their
-            // assignments.
-            state.assignment = bytes_to_iobuf(assignments_provider(id));
-            state.subscription = bytes_to_iobuf(
-              member->get_protocol_metadata(_protocol.value()));
-            metadata.members.push_back(std::move(state));
+            // copy everything but the member buffers which are replaced below
+            const auto& ms = member->state();
+            metadata.members.push_back(member_state{
+              .id = ms.id,
+              .instance_id = ms.instance_id,
+              .client_id = ms.client_id,
+              .client_host = ms.client_host,
+              .rebalance_timeout = ms.rebalance_timeout,
+              .session_timeout = ms.session_timeout,
+              .subscription = bytes_to_iobuf(
+                member->get_protocol_metadata(_protocol.value())),
+              // this is not coming from the member itself because the
+              // checkpoint occurs right before the members go live and get
+              // their assignments.
+              .assignment = assignments_provider(id),
+            });
         }
 
         cluster::simple_batch_builder builder(
@@ -748,6 +778,19 @@ private:
         return false;
     }
 
+    bool has_pending_transactions() const {
+        return !_pending_offset_commits.empty() || !_volatile_txs.empty()
+               || !_prepared_txs.empty();
+    }
+
+    using offsets_snapshot = std::vector<offset_fetch_response_topic>;
+    /// Committed offsets of all partitions, built when first needed after
+    /// the offsets change
+    const offsets_snapshot& all_offsets();
+    /// Same with the offsets of partitions with pending transactions
+    /// replaced by the unstable_offset_commit error
+    offsets_snapshot all_offsets_with_pending_transactions();
+
     void update_store_offset_builder(
       cluster::simple_batch_builder& builder,
       const model::topic& name,
@@ -771,9 +814,11 @@ private:
     std::optional<kafka::protocol_name> _protocol;
     std::optional<kafka::member_id> _leader;
     ss::timer<clock_type> _join_timer;
+    member_expiry_wheel _expiry;
     bool _new_member_added;
     config::configuration& _conf;
     ss::lw_shared_ptr<cluster::partition> _partition;
+    ss::lw_shared_ptr<offset_commit_batcher> _commit_batcher;
     absl::node_hash_map<
       model::topic_partition,
       std::unique_ptr<offset_metadata_with_probe>>
@@ -800,6 +845,10 @@ private:
       _fence_pid_epoch;
     absl::node_hash_map<model::topic_partition, offset_metadata>
       _pending_offset_commits;
+    // offset fetch responses for all partitions of the group, e.g. to lag
+    // exporters polling every group, are copied from this snapshot. Reset
+    // whenever _offsets changes.
+    std::optional<offsets_snapshot> _offsets_snapshot;
     enable_group_metrics _enable_group_metrics;
     struct volatile_offset {
         model::offset offset;
@@ -25,10 +25,13 @@
 #include "model/fundamental.h"
 #include "model/namespace.h"
 #include "model/record.h"
+#include "model/timeout_clock.h"
 #include "resource_mgmt/io_priority.h"
 #include "ssx/future-util.h"
+#include "utils/stall_tracker.h"
 
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
 
 namespace kafka {
 
@@ -92,6 +95,22 @@ ss::future<> group_manager::start() {
             handle_topic_delta(deltas);
         });
 
+    _snapshot_timer.set_callback([this] {
+        ssx::spawn_with_gate(_gate, [this] {
+            return snapshot_partitions().finally(
+              [this] { arm_snapshot_timer(); });
+        });
+    });
+    arm_snapshot_timer();
+
+    _standby_timer.set_callback([this] {
+        ssx::spawn_with_gate(_gate, [this] {
+            return catchup_standby_partitions().finally(
+              [this] { arm_standby_timer(); });
+        });
+    });
+    arm_standby_timer();
+
     return ss::make_ready_future<>();
 }
 
@@ -113,6 +132,8 @@ ss::future<> group_manager::stop() {
     _gm.local().unregister_leadership_notification(_leader_notify_handle);
     _topic_table.local().unregister_delta_notification(
       _topic_table_notify_handle);
+    _snapshot_timer.cancel();
+    _standby_timer.cancel();
 
     for (auto& e : _partitions) {
         e.second->as.request_abort();
@@ -125,7 +146,10 @@ ss::future<> group_manager::stop() {
         for (auto& [_, group] : _groups) {
             group->shutdown();
         }
-        _partitions.clear();
+        return ss::parallel_for_each(_partitions, [](auto& e) {
+                   return e.second->commit_batcher->stop();
+               })
+          .then([this] { _partitions.clear(); });
     });
 }
 
@@ -148,6 +172,7 @@ void group_manager::detach_partition(const model::ntp& ntp) {
             }
             ++g_it;
         }
+        co_await p->commit_batcher->stop();
         _partitions.erase(ntp);
         _partitions.rehash(0);
     });
@@ -155,7 +180,8 @@ void group_manager::detach_partition(const model::ntp& ntp) {
 
 void group_manager::attach_partition(ss::lw_shared_ptr<cluster::partition> p) {
     klog.debug("attaching group metadata partition {}", p->ntp());
-    auto attached = ss::make_lw_shared<attached_partition>(p);
+    auto attached = ss::make_lw_shared<attached_partition>(
+      p, _conf.group_offset_commit_batch_window_ms.bind());
     auto res = _partitions.try_emplace(p->ntp(), attached);
     // TODO: this is not a forever assertion. this should just generally never
     // happen _now_ because we don't support partition migration / removal.
@@ -341,15 +367,42 @@ ss::future<> group_manager::handle_partition_leader_change(
     return p->catchup_lock.hold_write_lock()
       .then([this, term, timeout, p](ss::basic_rwlock<>::holder unit) {
           return inject_noop(p->partition, timeout)
-            .then([this, term, timeout, p] {
+            .then([this, p] {
+                // the standby state kept as a follower is more recent than
+                // any snapshot, only the log that follows it is replayed
+                if (p->standby) {
+                    auto standby = std::exchange(p->standby, std::nullopt);
+                    vlog(
+                      klog.info,
+                      "Recovering {} from standby state at offset {}",
+                      p->partition->ntp(),
+                      standby->offset);
+                    return ss::make_ready_future<
+                      std::optional<group_metadata_snapshot>>(
+                      group_metadata_snapshot{
+                        .offset = standby->offset,
+                        .state = std::move(standby->state)});
+                }
+                return load_snapshot(p);
+            })
+            .then([this, term, timeout, p](
+                    std::optional<group_metadata_snapshot> snapshot) {
                 /*
-                 * the full log is read and deduplicated. the dedupe
+                 * the log following the snapshot (or the full log when
+                 * there is no snapshot) is read and deduplicated. the dedupe
                  * processing is based on the record keys, so this code
                  * should be ready to transparently take advantage of
                  * key-based compaction in the future.
                  */
+                auto start = p->partition->start_offset();
+                group_recovery_consumer_state state;
+                if (snapshot) {
+                    start = std::max(
+                      start, model::next_offset(snapshot->offset));
+                    state = std::move(snapshot->state);
+                }
                 storage::log_reader_config reader_config(
-                  p->partition->start_offset(),
+                  start,
                   model::model_limits<model::offset>::max(),
                   0,
                   std::numeric_limits<size_t>::max(),
@@ -359,11 +412,12 @@ ss::future<> group_manager::handle_partition_leader_change(
                   std::nullopt);
 
                 return p->partition->make_reader(reader_config)
-                  .then([this, term, p, timeout](
-                          model::record_batch_reader reader) {
+                  .then([this, term, p, timeout, state = std::move(state)](
+                          model::record_batch_reader reader) mutable {
                       return std::move(reader)
                         .consume(
-                          group_recovery_consumer(_serializer_factory(), p->as),
+                          group_recovery_consumer(
+                            _serializer_factory(), p->as, std::move(state)),
                           timeout)
                         .then([this, term, p](
                                 group_recovery_consumer_state state) {
@@ -382,6 +436,226 @@ ss::future<> group_manager::handle_partition_leader_change(
       .finally([p] {});
 }
 
+ss::future<std::optional<group_metadata_snapshot>>
+group_manager::load_snapshot(ss::lw_shared_ptr<attached_partition> p) {
+    std::optional<group_metadata_snapshot> snapshot;
+    try {
+        snapshot = co_await load_group_metadata_snapshot(p->snapshot_mgr);
+    } catch (...) {
+        vlog(
+          klog.warn,
+          "Unable to load group metadata snapshot of {}, replaying the full "
+          "log - {}",
+          p->partition->ntp(),
+          std::current_exception());
+        co_return std::nullopt;
+    }
+    if (snapshot && snapshot->offset > p->partition->dirty_offset()) {
+        // the snapshot doesn't belong to this log
+        vlog(
+          klog.warn,
+          "Ignoring group metadata snapshot of {} at offset {} past the log "
+          "end {}",
+          p->partition->ntp(),
+          snapshot->offset,
+          p->partition->dirty_offset());
+        co_return std::nullopt;
+    }
+    if (snapshot) {
+        vlog(
+          klog.info,
+          "Recovering {} from group metadata snapshot at offset {}",
+          p->partition->ntp(),
+          snapshot->offset);
+    }
+    co_return snapshot;
+}
+
+void group_manager::arm_snapshot_timer() {
+    auto interval = _conf.group_metadata_snapshot_interval_ms();
+    if (_gate.is_closed() || interval == std::chrono::milliseconds(0)) {
+        return;
+    }
+    _snapshot_timer.arm(interval);
+}
+
+ss::future<> group_manager::snapshot_partitions() {
+    // operate on a copy, partitions may be attached or detached concurrently
+    std::vector<ss::lw_shared_ptr<attached_partition>> partitions;
+    partitions.reserve(_partitions.size());
+    for (auto& [_, p] : _partitions) {
+        partitions.push_back(p);
+    }
+    for (auto& p : partitions) {
+        if (_gate.is_closed()) {
+            break;
+        }
+        try {
+            co_await snapshot_partition(p);
+        } catch (...) {
+            vlog(
+              klog.warn,
+              "Unable to snapshot group metadata of {} - {}",
+              p->partition->ntp(),
+              std::current_exception());
+        }
+    }
+}
+
+/*
+ * Folds the committed log that follows the previous snapshot into a new
+ * snapshot. This runs on every replica so that any of them can take over
+ * coordination with a short log tail to replay.
+ */
+ss::future<>
+group_manager::snapshot_partition(ss::lw_shared_ptr<attached_partition> p) {
+    auto committed = p->partition->committed_offset();
+    if (committed <= p->snapshot_offset || p->as.abort_requested()) {
+        co_return;
+    }
+
+    // followers already hold the folded state in memory
+    if (p->standby) {
+        auto units = co_await p->catchup_lock.hold_read_lock();
+        if (p->standby) {
+            if (p->standby->offset > p->snapshot_offset) {
+                co_await persist_group_metadata_snapshot(
+                  p->snapshot_mgr, p->standby->offset, p->standby->state);
+                p->snapshot_offset = p->standby->offset;
+            }
+            co_return;
+        }
+    }
+
+    auto start = p->partition->start_offset();
+    group_recovery_consumer_state state;
+    auto snapshot = co_await load_group_metadata_snapshot(p->snapshot_mgr);
+    if (snapshot) {
+        if (snapshot->offset >= committed) {
+            p->snapshot_offset = snapshot->offset;
+            co_return;
+        }
+        start = std::max(start, model::next_offset(snapshot->offset));
+        state = std::move(snapshot->state);
+    }
+    if (start > committed) {
+        co_return;
+    }
+
+    storage::log_reader_config reader_config(
+      start,
+      committed,
+      0,
+      std::numeric_limits<size_t>::max(),
+      kafka_read_priority(),
+      std::nullopt,
+      std::nullopt,
+      std::nullopt);
+    auto reader = co_await p->partition->make_reader(reader_config);
+    state = co_await std::move(reader).consume(
+      group_recovery_consumer(_serializer_factory(), p->as, std::move(state)),
+      model::no_timeout);
+    if (p->as.abort_requested()) {
+        co_return;
+    }
+
+    co_await persist_group_metadata_snapshot(p->snapshot_mgr, committed, state);
+    p->snapshot_offset = committed;
+    vlog(
+      klog.debug,
+      "Snapshotted group metadata of {} at offset {} ({} groups)",
+      p->partition->ntp(),
+      committed,
+      state.groups.size());
+}
+
+void group_manager::arm_standby_timer() {
+    auto interval = _conf.group_standby_catchup_interval_ms();
+    if (_gate.is_closed() || interval == std::chrono::milliseconds(0)) {
+        return;
+    }
+    _standby_timer.arm(interval);
+}
+
+ss::future<> group_manager::catchup_standby_partitions() {
+    // operate on a copy, partitions may be attached or detached concurrently
+    std::vector<ss::lw_shared_ptr<attached_partition>> partitions;
+    partitions.reserve(_partitions.size());
+    for (auto& [_, p] : _partitions) {
+        partitions.push_back(p);
+    }
+    for (auto& p : partitions) {
+        if (_gate.is_closed()) {
+            break;
+        }
+        try {
+            co_await catchup_standby(p);
+        } catch (...) {
+            // rebuilt from the snapshot on the next round
+            p->standby.reset();
+            vlog(
+              klog.warn,
+              "Unable to apply group metadata of {} to the standby state - {}",
+              p->partition->ntp(),
+              std::current_exception());
+        }
+    }
+}
+
+/*
+ * Applies the log committed since the last round to the coordinator state a
+ * follower keeps in memory, so that becoming coordinator only replays the few
+ * batches committed since then instead of loading a snapshot and replaying
+ * the log that follows it. The leader keeps its state in the groups instead.
+ */
+ss::future<>
+group_manager::catchup_standby(ss::lw_shared_ptr<attached_partition> p) {
+    // leadership changes take the write lock, they wait for the catch up
+    auto units = co_await p->catchup_lock.hold_read_lock();
+    if (p->partition->is_elected_leader() || p->as.abort_requested()) {
+        co_return;
+    }
+    auto committed = p->partition->committed_offset();
+    if (p->standby && p->standby->offset >= committed) {
+        co_return;
+    }
+
+    auto start = p->partition->start_offset();
+    group_recovery_consumer_state state;
+    if (p->standby) {
+        start = std::max(start, model::next_offset(p->standby->offset));
+        state = std::move(p->standby->state);
+        p->standby.reset();
+    } else if (auto snapshot = co_await load_snapshot(p); snapshot) {
+        start = std::max(start, model::next_offset(snapshot->offset));
+        state = std::move(snapshot->state);
+    }
+
+    if (start <= committed) {
+        storage::log_reader_config reader_config(
+          start,
+          committed,
+          0,
+          std::numeric_limits<size_t>::max(),
+          kafka_read_priority(),
+          std::nullopt,
+          std::nullopt,
+          std::nullopt);
+        auto reader = co_await p->partition->make_reader(reader_config);
+        state = co_await std::move(reader).consume(
+          group_recovery_consumer(
+            _serializer_factory(), p->as, std::move(state)),
+          model::no_timeout);
+        if (p->as.abort_requested()) {
+            co_return;
+        }
+    }
+    // a snapshot may cover more than what is committed yet after a restart
+    p->standby = attached_partition::standby_state{
+      .offset = std::max(committed, model::prev_offset(start)),
+      .state = std::move(state)};
+}
+
 /*
  * TODO: this routine can be improved from a copy vs move perspective, but is
  * rather complicated at the moment to start having to also analyze all the data
@@ -391,6 +665,7 @@ ss::future<> group_manager::recover_partition(
   model::term_id term,
   ss::lw_shared_ptr<attached_partition> p,
   group_recovery_consumer_state ctx) {
+    stall_tracker_section("group_recovery");
     for (auto& [_, group] : _groups) {
         if (group->partition()->ntp() == p->partition->ntp()) {
             group->reset_tx_state(term);
@@ -420,7 +695,8 @@ ss::future<> group_manager::recover_partition(
                   _conf,
                   p->partition,
                   _serializer_factory(),
-                  _enable_group_metrics);
+                  _enable_group_metrics,
+                  p->commit_batcher);
                 group->reset_tx_state(term);
                 _groups.emplace(group_id, group);
                 group->reschedule_all_member_heartbeats();
@@ -454,7 +730,8 @@ ss::future<> group_manager::recover_partition(
               _conf,
               p->partition,
               _serializer_factory(),
-              _enable_group_metrics);
+              _enable_group_metrics,
+              p->commit_batcher);
             group->reset_tx_state(term);
             _groups.emplace(group_id, group);
         }
@@ -552,7 +829,8 @@ group::join_group_stages group_manager::join_group(join_group_request&& r) {
           _conf,
           p,
           _serializer_factory(),
-          _enable_group_metrics);
+          _enable_group_metrics,
+          it->second->commit_batcher);
         group->reset_tx_state(it->second->term);
         _groups.emplace(r.data.group_id, group);
         _groups.rehash(0);
@@ -698,7 +976,8 @@ group_manager::txn_offset_commit(txn_offset_commit_request&& r) {
                 _conf,
                 p->partition,
                 _serializer_factory(),
-                _enable_group_metrics);
+                _enable_group_metrics,
+                p->commit_batcher);
               group->reset_tx_state(p->term);
               _groups.emplace(r.data.group_id, group);
               _groups.rehash(0);
@@ -782,7 +1061,8 @@ group_manager::begin_tx(cluster::begin_group_tx_request&& r) {
                 _conf,
                 p->partition,
                 _serializer_factory(),
-                _enable_group_metrics);
+                _enable_group_metrics,
+                p->commit_batcher);
               group->reset_tx_state(p->term);
               _groups.emplace(r.group_id, group);
               _groups.rehash(0);
@@ -888,7 +1168,8 @@ group_manager::offset_commit(offset_commit_request&& r) {
               _conf,
               p->partition,
               _serializer_factory(),
-              _enable_group_metrics);
+              _enable_group_metrics,
+              p->commit_batcher);
             group->reset_tx_state(p->term);
             _groups.emplace(r.data.group_id, group);
             _groups.rehash(0);
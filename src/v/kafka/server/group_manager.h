@@ -23,19 +23,23 @@
 #include "kafka/protocol/sync_group.h"
 #include "kafka/protocol/txn_offset_commit.h"
 #include "kafka/server/group.h"
+#include "kafka/server/group_metadata_snapshot.h"
 #include "kafka/server/group_recovery_consumer.h"
 #include "kafka/server/group_stm.h"
 #include "kafka/server/member.h"
+#include "kafka/server/offset_commit_batcher.h"
 #include "model/metadata.h"
 #include "model/namespace.h"
 #include "raft/group_manager.h"
 #include "seastarx.h"
 #include "ssx/semaphore.h"
+#include "storage/snapshot.h"
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/timer.hh>
 
 #include <absl/container/node_hash_map.h>
 #include <cluster/partition_manager.h>
@@ -99,6 +103,15 @@ namespace kafka {
  * After the log is read the deduplicated state is used to re-populate the
  * in-memory cache of groups/commits through.
  *
+ * Snapshots (background)
+ * ======================
+ *
+ * Every replica periodically folds the committed log into a local snapshot of
+ * the deduplicated state (see `group_metadata_snapshot`). When a snapshot is
+ * available recovery starts from it and only reads the log that follows the
+ * snapshot offset, which bounds the coordinator failover time by the snapshot
+ * interval rather than by the length of the partition history.
+ *
  * Unload (background)
  * ===================
  *
@@ -201,10 +214,32 @@ private:
         ss::lw_shared_ptr<cluster::partition> partition;
         ss::basic_rwlock<> catchup_lock;
         model::term_id term{-1};
-
-        explicit attached_partition(ss::lw_shared_ptr<cluster::partition> p)
+        ss::lw_shared_ptr<offset_commit_batcher> commit_batcher;
+        storage::simple_snapshot_manager snapshot_mgr;
+        // log offset covered by the last snapshot taken by this replica
+        model::offset snapshot_offset;
+        /*
+         * coordinator state kept up to date by a follower, taken over when
+         * it becomes leader. it covers the log up to and including offset.
+         */
+        struct standby_state {
+            model::offset offset;
+            group_recovery_consumer_state state;
+        };
+        std::optional<standby_state> standby;
+
+        attached_partition(
+          ss::lw_shared_ptr<cluster::partition> p,
+          config::binding<std::chrono::milliseconds> commit_window)
           : loading(true)
-          , partition(std::move(p)) {}
+          , partition(std::move(p))
+          , commit_batcher(ss::make_lw_shared<offset_commit_batcher>(
+              partition, std::move(commit_window)))
+          , snapshot_mgr(
+              std::filesystem::path(
+                partition->raft()->log_config().work_directory()),
+              group_metadata_snapshot::filename,
+              ss::default_priority_class()) {}
     };
 
     cluster::notification_id_type _leader_notify_handle;
@@ -232,6 +267,15 @@ private:
 
     ss::future<> gc_partition_state(ss::lw_shared_ptr<attached_partition>);
 
+    ss::future<std::optional<group_metadata_snapshot>>
+      load_snapshot(ss::lw_shared_ptr<attached_partition>);
+    void arm_snapshot_timer();
+    ss::future<> snapshot_partitions();
+    ss::future<> snapshot_partition(ss::lw_shared_ptr<attached_partition>);
+    void arm_standby_timer();
+    ss::future<> catchup_standby_partitions();
+    ss::future<> catchup_standby(ss::lw_shared_ptr<attached_partition>);
+
     ss::future<> inject_noop(
       ss::lw_shared_ptr<cluster::partition> p,
       ss::lowres_clock::time_point timeout);
@@ -257,6 +301,8 @@ private:
 
     model::broker _self;
     enable_group_metrics _enable_group_metrics;
+    ss::timer<> _snapshot_timer;
+    ss::timer<> _standby_timer;
 };
 
 } // namespace kafka
@@ -0,0 +1,223 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#include "kafka/server/group_metadata_snapshot.h"
+
+#include "kafka/protocol/request_reader.h"
+#include "kafka/protocol/response_writer.h"
+#include "kafka/server/logger.h"
+#include "reflection/adl.h"
+
+#include <seastar/core/coroutine.hh>
+
+#include <stdexcept>
+
+namespace kafka {
+
+namespace {
+
+void encode_tp(response_writer& w, const model::topic_partition& tp) {
+    w.write(tp.topic);
+    w.write(tp.partition);
+}
+
+model::topic_partition decode_tp(request_reader& r) {
+    auto topic = model::topic(r.read_string());
+    auto partition = model::partition_id(r.read_int32());
+    return {std::move(topic), partition};
+}
+
+void encode_group(
+  response_writer& w, const kafka::group_id& id, const group_stm& stm) {
+    w.write(id);
+    w.write(stm.is_loaded());
+    w.write(stm.is_removed());
+    if (stm.is_loaded()) {
+        group_metadata_value::encode(w, stm.get_metadata());
+    }
+
+    w.write(int32_t(stm.offsets().size()));
+    for (const auto& [tp, md] : stm.offsets()) {
+        encode_tp(w, tp);
+        w.write(md.log_offset);
+        offset_metadata_value::encode(w, md.metadata);
+    }
+
+    w.write(int32_t(stm.prepared_txs().size()));
+    for (const auto& [_, tx] : stm.prepared_txs()) {
+        w.write(tx.pid.id);
+        w.write(tx.pid.epoch);
+        w.write(tx.tx_seq);
+        w.write(int32_t(tx.offsets.size()));
+        for (const auto& [tp, md] : tx.offsets) {
+            encode_tp(w, tp);
+            w.write(md.log_offset);
+            w.write(md.offset);
+            w.write(md.metadata);
+            w.write(md.committed_leader_epoch);
+        }
+    }
+
+    w.write(int32_t(stm.fences().size()));
+    for (const auto& [id, epoch] : stm.fences()) {
+        w.write(id);
+        w.write(epoch);
+    }
+}
+
+void decode_group(request_reader& r, group_recovery_consumer_state& state) {
+    auto id = kafka::group_id(r.read_string());
+    auto [it, _] = state.groups.try_emplace(std::move(id));
+    auto& stm = it->second;
+
+    auto is_loaded = r.read_bool();
+    auto is_removed = r.read_bool();
+    if (is_loaded) {
+        stm.overwrite_metadata(group_metadata_value::decode(r));
+    }
+
+    auto offsets = r.read_int32();
+    for (int32_t i = 0; i < offsets; ++i) {
+        auto tp = decode_tp(r);
+        auto log_offset = model::offset(r.read_int64());
+        stm.update_offset(tp, log_offset, offset_metadata_value::decode(r));
+    }
+
+    auto prepared = r.read_int32();
+    for (int32_t i = 0; i < prepared; ++i) {
+        group::prepared_tx tx;
+        tx.pid.id = r.read_int64();
+        tx.pid.epoch = r.read_int16();
+        tx.tx_seq = model::tx_seq(r.read_int64());
+        auto tx_offsets = r.read_int32();
+        for (int32_t j = 0; j < tx_offsets; ++j) {
+            auto tp = decode_tp(r);
+            group::offset_metadata md;
+            md.log_offset = model::offset(r.read_int64());
+            md.offset = model::offset(r.read_int64());
+            md.metadata = r.read_string();
+            md.committed_leader_epoch = kafka::leader_epoch(r.read_int32());
+            tx.offsets.emplace(std::move(tp), std::move(md));
+        }
+        stm.restore_prepared(std::move(tx));
+    }
+
+    auto fences = r.read_int32();
+    for (int32_t i = 0; i < fences; ++i) {
+        auto id = model::producer_id(r.read_int64());
+        auto epoch = model::producer_epoch(r.read_int16());
+        stm.try_set_fence(id, epoch);
+    }
+
+    if (is_removed) {
+        stm.remove();
+    }
+}
+
+} // namespace
+
+iobuf encode_group_metadata_snapshot_state(
+  const group_recovery_consumer_state& state) {
+    iobuf buf;
+    response_writer w(buf);
+    w.write(int32_t(state.groups.size()));
+    for (const auto& [id, stm] : state.groups) {
+        encode_group(w, id, stm);
+    }
+    return buf;
+}
+
+group_recovery_consumer_state decode_group_metadata_snapshot_state(iobuf buf) {
+    group_recovery_consumer_state state;
+    request_reader r(std::move(buf));
+    auto groups = r.read_int32();
+    for (int32_t i = 0; i < groups; ++i) {
+        decode_group(r, state);
+    }
+    return state;
+}
+
+ss::future<> persist_group_metadata_snapshot(
+  storage::simple_snapshot_manager& snapshot_mgr,
+  model::offset offset,
+  const group_recovery_consumer_state& state) {
+    auto data = encode_group_metadata_snapshot_state(state);
+
+    iobuf metadata;
+    reflection::serialize(
+      metadata,
+      group_metadata_snapshot::version,
+      offset(),
+      int64_t(data.size_bytes()));
+
+    auto writer = co_await snapshot_mgr.start_snapshot();
+    std::exception_ptr ex;
+    try {
+        co_await writer.write_metadata(std::move(metadata));
+        co_await write_iobuf_to_output_stream(std::move(data), writer.output());
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await writer.close();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_await snapshot_mgr.finish_snapshot(writer);
+}
+
+ss::future<std::optional<group_metadata_snapshot>>
+load_group_metadata_snapshot(storage::simple_snapshot_manager& snapshot_mgr) {
+    auto maybe_reader = co_await snapshot_mgr.open_snapshot();
+    if (!maybe_reader) {
+        co_return std::nullopt;
+    }
+    auto& reader = *maybe_reader;
+
+    std::optional<group_metadata_snapshot> snapshot;
+    std::exception_ptr ex;
+    try {
+        iobuf_parser metadata(co_await reader.read_metadata());
+        auto version = reflection::adl<int8_t>{}.from(metadata);
+        if (version != group_metadata_snapshot::version) {
+            vlog(
+              klog.warn,
+              "Ignoring group metadata snapshot {} with unsupported version "
+              "{}",
+              snapshot_mgr.snapshot_path(),
+              version);
+        } else {
+            auto offset = model::offset(
+              reflection::adl<int64_t>{}.from(metadata));
+            auto size = reflection::adl<int64_t>{}.from(metadata);
+            auto data = co_await read_iobuf_exactly(reader.input(), size);
+            if (data.size_bytes() != size_t(size)) {
+                throw std::runtime_error(fmt::format(
+                  "Truncated group metadata snapshot {}, expected {} bytes "
+                  "got {}",
+                  snapshot_mgr.snapshot_path(),
+                  size,
+                  data.size_bytes()));
+            }
+            snapshot = group_metadata_snapshot{
+              .offset = offset,
+              .state = decode_group_metadata_snapshot_state(std::move(data)),
+            };
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await reader.close();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_return snapshot;
+}
+
+} // namespace kafka
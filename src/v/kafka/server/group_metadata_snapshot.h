@@ -0,0 +1,59 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#pragma once
+
+#include "bytes/iobuf.h"
+#include "kafka/server/group_recovery_consumer.h"
+#include "model/fundamental.h"
+#include "seastarx.h"
+#include "storage/snapshot.h"
+
+#include <seastar/core/future.hh>
+
+#include <optional>
+
+namespace kafka {
+
+/**
+ * Compacted snapshot of the group metadata partition state.
+ *
+ * The snapshot holds the recovered state of every group coordinated by the
+ * partition, i.e. the result of replaying the partition log up to and
+ * including `offset`. Recovery restores the snapshot and only replays the log
+ * tail that follows it.
+ *
+ * The state is encoded with the same group and offset metadata encodings that
+ * are used for the log records, followed by the in-memory bits that are only
+ * known after replaying the log (record log offsets, prepared transactions and
+ * producer fences).
+ */
+struct group_metadata_snapshot {
+    static constexpr int8_t version = 0;
+    static constexpr const char* filename = "group_metadata.snapshot";
+
+    model::offset offset;
+    group_recovery_consumer_state state;
+};
+
+iobuf encode_group_metadata_snapshot_state(
+  const group_recovery_consumer_state&);
+
+group_recovery_consumer_state decode_group_metadata_snapshot_state(iobuf);
+
+ss::future<> persist_group_metadata_snapshot(
+  storage::simple_snapshot_manager&,
+  model::offset,
+  const group_recovery_consumer_state&);
+
+ss::future<std::optional<group_metadata_snapshot>>
+  load_group_metadata_snapshot(storage::simple_snapshot_manager&);
+
+} // namespace kafka
@@ -37,6 +37,18 @@ public:
       : _serializer(std::move(serializer))
       , _as(as) {}
 
+    /*
+     * Continues the recovery from a previously recovered state, e.g. the state
+     * restored from a group metadata snapshot.
+     */
+    group_recovery_consumer(
+      group_metadata_serializer serializer,
+      ss::abort_source& as,
+      group_recovery_consumer_state state)
+      : _state(std::move(state))
+      , _serializer(std::move(serializer))
+      , _as(as) {}
+
     ss::future<ss::stop_iteration> operator()(model::record_batch batch);
 
     group_recovery_consumer_state end_of_stream() { return std::move(_state); }
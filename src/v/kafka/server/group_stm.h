@@ -70,6 +70,11 @@ public:
       const model::topic_partition&, model::offset, offset_metadata_value&&);
     void remove_offset(const model::topic_partition&);
     void update_prepared(model::offset, group_log_prepared_tx);
+    // restores a prepared tx taken from a group metadata snapshot
+    void restore_prepared(group::prepared_tx tx) {
+        auto id = tx.pid.get_id();
+        _prepared_txs[id] = std::move(tx);
+    }
     void commit(model::producer_identity);
     void abort(model::producer_identity, model::tx_seq);
     void try_set_fence(model::producer_id id, model::producer_epoch epoch) {
@@ -81,6 +86,7 @@ public:
     bool has_data() const {
         return !_is_removed && (_is_loaded || _offsets.size() > 0);
     }
+    bool is_loaded() const { return _is_loaded; }
     bool is_removed() const { return _is_removed; }
 
     const absl::node_hash_map<model::producer_id, group::prepared_tx>&
@@ -79,6 +79,23 @@ static void parse_and_set_shadow_indexing_mode(
           .default_match(model::shadow_indexing_mode::disabled);
 }
 
+static void parse_and_set_bool(
+  cluster::property_update<std::optional<bool>>& property_update,
+  const std::optional<ss::sstring>& value) {
+    if (!value) {
+        property_update.value = std::nullopt;
+        return;
+    }
+    auto parsed = string_switch<std::optional<bool>>(*value)
+                    .match("false", false)
+                    .match("true", true)
+                    .default_match(std::nullopt);
+    if (!parsed) {
+        throw boost::bad_lexical_cast();
+    }
+    property_update.value = parsed;
+}
+
 void check_data_policy(std::string_view property_name) {
     if (
       property_name == topic_property_data_policy_function_name
@@ -116,6 +133,8 @@ create_topic_properties_update(alter_configs_resource& resource) {
       = cluster::incremental_update_operation::set;
     update.properties.shadow_indexing.op
       = cluster::incremental_update_operation::set;
+    update.properties.write_caching.op
+      = cluster::incremental_update_operation::set;
     update.custom_properties.data_policy.op
       = cluster::incremental_update_operation::none;
 
@@ -176,6 +195,10 @@ create_topic_properties_update(alter_configs_resource& resource) {
                   update.properties.retention_duration, cfg.value);
                 continue;
             }
+            if (cfg.name == topic_property_write_caching) {
+                parse_and_set_bool(update.properties.write_caching, cfg.value);
+                continue;
+            }
             if (
               std::find(
                 std::begin(allowlist_topic_noop_confs),
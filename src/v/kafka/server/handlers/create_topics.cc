@@ -33,7 +33,7 @@
 
 namespace kafka {
 
-static constexpr std::array<std::string_view, 11> supported_configs{
+static constexpr std::array<std::string_view, 12> supported_configs{
   topic_property_compression,
   topic_property_cleanup_policy,
   topic_property_timestamp_type,
@@ -44,7 +44,8 @@ static constexpr std::array<std::string_view, 11> supported_configs{
   topic_property_recovery,
   topic_property_remote_write,
   topic_property_remote_read,
-  topic_property_read_replica};
+  topic_property_read_replica,
+  topic_property_write_caching};
 
 bool is_supported(std::string_view name) {
     return std::any_of(
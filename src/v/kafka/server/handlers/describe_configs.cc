@@ -554,6 +554,16 @@ ss::future<response_ptr> describe_configs_handler::handle(
               request.data.include_synonyms,
               &describe_as_string<bool>);
 
+            add_topic_config_if_requested(
+              resource,
+              result,
+              topic_property_write_caching,
+              false,
+              topic_property_write_caching,
+              topic_config->properties.write_caching,
+              request.data.include_synonyms,
+              &describe_as_string<bool>);
+
             // Data-policy property
             ss::sstring property_name = "redpanda.datapolicy";
             add_topic_config_if_requested(
@@ -9,6 +9,7 @@
 
 #include "kafka/server/handlers/fetch.h"
 
+#include "bytes/iobuf_parser.h"
 #include "cluster/metadata_cache.h"
 #include "cluster/partition_manager.h"
 #include "cluster/shard_table.h"
@@ -17,6 +18,7 @@
 #include "kafka/protocol/errors.h"
 #include "kafka/protocol/fetch.h"
 #include "kafka/server/fetch_session.h"
+#include "kafka/server/fetch_session_cache.h"
 #include "kafka/server/handlers/details/leader_epoch.h"
 #include "kafka/server/handlers/fetch/fetch_plan_executor.h"
 #include "kafka/server/handlers/fetch/fetch_planner.h"
@@ -30,11 +32,14 @@
 #include "model/timeout_clock.h"
 #include "random/generators.h"
 #include "resource_mgmt/io_priority.h"
+#include "resource_mgmt/smp_groups_probe.h"
+#include "storage/parser.h"
 #include "storage/parser_utils.h"
 #include "utils/to_string.h"
 
 #include <seastar/core/do_with.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/sleep.hh>
 #include <seastar/core/thread.hh>
 #include <seastar/util/log.hh>
@@ -61,6 +66,77 @@ make_partition_response_error(model::partition_id p_id, error_code error) {
     };
 }
 
+iobuf extent_to_kafka_wire(storage::extent_read_result extent) {
+    iobuf out;
+    response_writer wr(out);
+    iobuf_parser parser(std::move(extent.data));
+    // the extent contains data batches only, so the delta between log and
+    // kafka offsets is the same for every batch
+    std::optional<model::offset> delta;
+    for (auto& hdr : extent.headers) {
+        if (!delta) {
+            delta = hdr.base_offset - extent.base_offset;
+        }
+        hdr.base_offset = hdr.base_offset - *delta;
+        hdr.ctx.term = extent.term;
+        writer_serialize_batch_header(wr, hdr);
+        // the on-disk header is replaced by the kafka one
+        parser.skip(model::packed_record_batch_header_size);
+        wr.write_direct(parser.share(
+          hdr.size_bytes - model::packed_record_batch_header_size));
+    }
+    return out;
+}
+
+static read_result make_read_result(
+  std::unique_ptr<iobuf> data,
+  model::offset start_o,
+  model::offset hw,
+  model::offset lso,
+  std::vector<cluster::rm_stm::tx_range> aborted_transactions,
+  bool foreign_read) {
+    if (foreign_read) {
+        return read_result(
+          ss::make_foreign<read_result::data_t>(std::move(data)),
+          start_o,
+          hw,
+          lso,
+          std::move(aborted_transactions));
+    }
+
+    return read_result(
+      std::move(data), start_o, hw, lso, std::move(aborted_transactions));
+}
+
+/**
+ * Reads uncommitted data straight from a segment file extent, bypassing the
+ * batch cache and record batch materialization. Returns std::nullopt if the
+ * read can not be served this way, in which case the regular reader is used.
+ */
+static ss::future<std::optional<std::unique_ptr<iobuf>>>
+try_read_extent(kafka::partition_proxy& part, const fetch_config& config) {
+    if (
+      config.isolation_level != model::isolation_level::read_uncommitted
+      || !config::shard_local_cfg().kafka_fetch_extent_reads_enabled()) {
+        co_return std::nullopt;
+    }
+    auto extent = co_await part.read_extent(storage::extent_read_config{
+      .start_offset = config.start_offset,
+      .max_offset = config.max_offset,
+      .max_bytes = config.max_bytes,
+      .strict_max_bytes = config.strict_max_bytes,
+      .prio = kafka_read_priority(),
+    });
+    if (!extent) {
+        co_return std::nullopt;
+    }
+    part.probe().add_records_fetched(extent->record_count);
+    auto data = std::make_unique<iobuf>(
+      extent_to_kafka_wire(std::move(*extent)));
+    part.probe().add_bytes_fetched(data->size_bytes());
+    co_return data;
+}
+
 /**
  * Low-level handler for reading from an ntp. Runs on ntp's home core.
  */
@@ -79,6 +155,12 @@ static ss::future<read_result> read_from_partition(
         co_return read_result(start_o, hw, lso);
     }
 
+    if (auto extent = co_await try_read_extent(part, config); extent) {
+        // aborted transactions are not reported to read_uncommitted fetches
+        co_return make_read_result(
+          std::move(*extent), start_o, hw, lso, {}, foreign_read);
+    }
+
     storage::log_reader_config reader_config(
       config.start_offset,
       config.max_offset,
@@ -117,17 +199,13 @@ static ss::future<read_result> read_from_partition(
         std::rethrow_exception(e);
     }
 
-    if (foreign_read) {
-        co_return read_result(
-          ss::make_foreign<read_result::data_t>(std::move(data)),
-          start_o,
-          hw,
-          lso,
-          std::move(aborted_transactions));
-    }
-
-    co_return read_result(
-      std::move(data), start_o, hw, lso, std::move(aborted_transactions));
+    co_return make_read_result(
+      std::move(data),
+      start_o,
+      hw,
+      lso,
+      std::move(aborted_transactions),
+      foreign_read);
 }
 
 /**
@@ -148,8 +226,18 @@ static ss::future<read_result> do_read_from_ntp(
     if (unlikely(!kafka_partition)) {
         co_return read_result(error_code::unknown_topic_or_partition);
     }
+    /**
+     * followers serve reads up to the high watermark they learned from the
+     * leader if the client can read from them, see KIP-392
+     */
+    bool follower_read = false;
     if (unlikely(!kafka_partition->is_leader())) {
-        co_return read_result(error_code::not_leader_for_partition);
+        if (
+          !ntp_config.cfg.read_from_follower
+          || kafka_partition->is_elected_leader()) {
+            co_return read_result(error_code::not_leader_for_partition);
+        }
+        follower_read = true;
     }
 
     /**
@@ -160,9 +248,39 @@ static ss::future<read_result> do_read_from_ntp(
     if (leader_epoch_err != error_code::none) {
         co_return read_result(leader_epoch_err);
     }
-    auto offset_ec = co_await kafka_partition->validate_fetch_offset(
-      ntp_config.cfg.start_offset,
-      default_fetch_timeout + model::timeout_clock::now());
+
+    /**
+     * redirect the client to an in sync replica in its rack, it gets no data
+     * from the leader
+     */
+    if (!follower_read) {
+        for (auto id : ntp_config.cfg.rack_replicas) {
+            if (kafka_partition->is_follower_in_sync(id)) {
+                read_result res(
+                  kafka_partition->start_offset(),
+                  kafka_partition->high_watermark(),
+                  kafka_partition->last_stable_offset());
+                res.preferred_replica = id;
+                co_return res;
+            }
+        }
+    }
+
+    error_code offset_ec = error_code::none;
+    if (follower_read) {
+        // a follower doesn't know if an offset past its high watermark
+        // exists, the client retries until the follower catches up
+        if (ntp_config.cfg.start_offset < kafka_partition->start_offset()) {
+            offset_ec = error_code::offset_out_of_range;
+        } else if (
+          ntp_config.cfg.start_offset > kafka_partition->high_watermark()) {
+            offset_ec = error_code::offset_not_available;
+        }
+    } else {
+        offset_ec = co_await kafka_partition->validate_fetch_offset(
+          ntp_config.cfg.start_offset,
+          default_fetch_timeout + model::timeout_clock::now());
+    }
 
     if (config::shard_local_cfg().enable_transactions.value()) {
         if (
@@ -216,7 +334,7 @@ static void fill_fetch_responses(
   op_context& octx,
   std::vector<read_result> results,
   std::vector<op_context::response_placeholder_ptr> responses,
-  std::vector<std::unique_ptr<hdr_hist::measurement>> metrics) {
+  std::vector<buffered_hist::measurement> metrics) {
     auto range = boost::irange<size_t>(0, results.size());
     for (auto idx : range) {
         auto& res = results[idx];
@@ -227,7 +345,7 @@ static void fill_fetch_responses(
         if (unlikely(res.error != error_code::none)) {
             resp_it->set(
               make_partition_response_error(res.partition, res.error));
-            metric->set_trace(false);
+            metric.set_trace(false);
             continue;
         }
 
@@ -251,6 +369,9 @@ static void fill_fetch_responses(
         resp.log_start_offset = res.start_offset;
         resp.high_watermark = res.high_watermark;
         resp.last_stable_offset = res.last_stable_offset;
+        if (res.preferred_replica) {
+            resp.preferred_read_replica = (*res.preferred_replica)();
+        }
 
         /**
          * According to KIP-74 we have to return first batch even if it would
@@ -283,7 +404,10 @@ static void fill_fetch_responses(
         }
 
         resp_it->set(std::move(resp));
-        metric = nullptr;
+        {
+            // the partition latency is recorded as the measurement ends
+            auto done = std::move(metric);
+        }
     }
 }
 
@@ -357,35 +481,57 @@ handle_shard_fetch(ss::shard_id shard, op_context& octx, shard_fetch fetch) {
         return ss::now();
     }
 
-    bool foreign_read = shard != ss::this_shard_id();
+    auto fill = [responses = std::move(fetch.responses),
+                 metrics = std::move(fetch.metrics),
+                 &octx](std::vector<read_result> results) mutable {
+        fill_fetch_responses(
+          octx, std::move(results), std::move(responses), std::move(metrics));
+    };
+
+    // shard local fetch, read inline without the smp hop and without wrapping
+    // the results in foreign pointers
+    if (shard == ss::this_shard_id()) {
+        return fetch_ntps_in_parallel(
+                 octx.rctx.partition_manager().local(),
+                 octx.rctx.coproc_partition_manager().local(),
+                 std::move(fetch.requests),
+                 false,
+                 octx.deadline)
+          .then(std::move(fill));
+    }
 
     // dispatch to remote core
-    return octx.rctx.partition_manager()
-      .invoke_on(
-        shard,
-        octx.ssg,
-        [foreign_read,
-         &octx,
-         deadline = octx.deadline,
-         configs = std::move(fetch.requests)](
-          cluster::partition_manager& mgr) mutable {
-            return fetch_ntps_in_parallel(
-              mgr,
-              octx.rctx.coproc_partition_manager().local(),
-              std::move(configs),
-              foreign_read,
-              deadline);
-        })
-      .then([responses = std::move(fetch.responses),
-             metrics = std::move(fetch.metrics),
-             &octx](std::vector<read_result> results) mutable {
-          fill_fetch_responses(
-            octx, std::move(results), std::move(responses), std::move(metrics));
-      });
+    return measured_invoke_on(
+             octx.rctx.partition_manager(),
+             shard,
+             octx.ssg,
+             smp_group_kind::kafka,
+             [&octx,
+              deadline = octx.deadline,
+              configs = std::move(fetch.requests)](
+               cluster::partition_manager& mgr) mutable {
+                 return fetch_ntps_in_parallel(
+                   mgr,
+                   octx.rctx.coproc_partition_manager().local(),
+                   std::move(configs),
+                   true,
+                   deadline);
+             })
+      .then(std::move(fill));
 }
 
 class parallel_fetch_plan_executor final : public fetch_plan_executor::impl {
     ss::future<> execute_plan(op_context& octx, fetch_plan plan) final {
+        octx.rctx.probe().fetch_plan_executed(
+          plan.local_partitions, plan.remote_partitions);
+        // all the requested partitions are owned by the connection shard,
+        // nothing to spread across cores
+        if (plan.remote_partitions == 0) {
+            const auto shard = ss::this_shard_id();
+            return handle_shard_fetch(
+              shard, octx, std::move(plan.fetches_per_shard[shard]));
+        }
+
         std::vector<ss::future<>> fetches;
         fetches.reserve(ss::smp::count);
 
@@ -404,6 +550,70 @@ class parallel_fetch_plan_executor final : public fetch_plan_executor::impl {
     }
 };
 
+/**
+ * KIP-392: consumers may read uncommitted data from followers. The leader
+ * points a consumer that sets its rack at an in sync replica in that rack,
+ * the consumer fetches from it until the follower fails the fetch.
+ */
+static bool can_read_from_follower(const op_context& octx) {
+    return config::shard_local_cfg().enable_follower_fetching()
+           && octx.request.data.replica_id < 0
+           && octx.request.data.isolation_level
+                == model::isolation_level::read_uncommitted;
+}
+
+/// Replicas of a partition led by this node that are in the client rack
+static std::vector<model::node_id>
+rack_replicas(const op_context& octx, const model::ntp& ntp) {
+    const model::rack_id rack(octx.request.data.rack_id);
+    const auto self = config::node().node_id();
+    const auto& md_cache = octx.rctx.metadata_cache();
+    if (
+      rack().empty() || config::node().rack() == rack
+      || md_cache.get_leader_id(ntp) != self) {
+        return {};
+    }
+    auto md = md_cache.get_topic_metadata_ref(
+      model::topic_namespace_view(ntp));
+    if (!md) {
+        return {};
+    }
+    const auto& assignments = md->get().get_assignments();
+    auto it = assignments.find(ntp.tp.partition);
+    if (it == assignments.end()) {
+        return {};
+    }
+    std::vector<model::node_id> ret;
+    for (const auto& bs : it->replicas) {
+        if (bs.node_id == self) {
+            continue;
+        }
+        auto broker = md_cache.get_broker(bs.node_id);
+        if (broker && (*broker)->rack() == rack) {
+            ret.push_back(bs.node_id);
+        }
+    }
+    return ret;
+}
+
+/**
+ * Idle session partitions are skipped by incremental fetches for as long as
+ * their leadership does not change, the session is notified when they get
+ * new data.
+ */
+static bool can_skip_idle_partition(
+  const op_context& octx, const fetch_session_partition& fp) {
+    if (
+      !fp.idle || octx.session_ctx.is_sessionless()
+      || octx.session_ctx.is_full_fetch()) {
+        return false;
+    }
+    auto lt = octx.rctx.metadata_cache().get_leader_term(
+      model::topic_namespace_view(model::kafka_namespace, fp.topic),
+      fp.partition);
+    return lt && lt->term == fp.idle_term;
+}
+
 class simple_fetch_planner final : public fetch_planner::impl {
     fetch_plan create_plan(op_context& octx) final {
         fetch_plan plan(ss::smp::count);
@@ -440,6 +650,18 @@ class simple_fetch_planner final : public fetch_planner::impl {
               auto ntp = model::ntp(
                 model::kafka_namespace, fp.topic, fp.partition);
 
+              if (can_skip_idle_partition(octx, fp)) {
+                  if (auto shard = octx.rctx.shards().shard_for(ntp); shard) {
+                      plan.data_waits_per_shard[*shard].push_back(
+                        partition_data_wait{
+                          .ntp = std::move(ntp),
+                          .fetch_offset = fp.fetch_offset});
+                  }
+                  resp_it->set_unchanged();
+                  ++resp_it;
+                  return;
+              }
+
               // there is given partition in topic metadata, return
               // unknown_topic_or_partition error
               if (unlikely(!octx.rctx.metadata_cache().contains(ntp))) {
@@ -483,7 +705,18 @@ class simple_fetch_planner final : public fetch_planner::impl {
                 .skip_read = bytes_left_in_plan == 0 && max_bytes == 0,
                 .current_leader_epoch = fp.current_leader_epoch,
               };
+              if (can_read_from_follower(octx)) {
+                  config.read_from_follower = true;
+                  config.rack_replicas = rack_replicas(octx, ntp);
+              }
 
+              if (*shard == ss::this_shard_id()) {
+                  ++plan.local_partitions;
+              } else {
+                  ++plan.remote_partitions;
+              }
+              plan.data_waits_per_shard[*shard].push_back(
+                partition_data_wait{.ntp = ntp, .fetch_offset = fp.fetch_offset});
               plan.fetches_per_shard[*shard].push_back(
                 make_ntp_fetch_config(ntp, config),
                 &(*resp_it),
@@ -495,6 +728,187 @@ class simple_fetch_planner final : public fetch_planner::impl {
     }
 };
 
+static void notify(ss::shared_promise<>& p) {
+    if (!p.available()) {
+        p.set_value();
+    }
+}
+
+/**
+ * Waits for any of the partitions of a single shard to have data past its
+ * fetch offset. All partitions of the shard share a single wake, the remaining
+ * partition waits are aborted as soon as the first one resolves.
+ */
+class shard_data_waiter {
+public:
+    shard_data_waiter(
+      cluster::partition_manager& cluster_pm,
+      coproc::partition_manager& coproc_pm,
+      std::vector<partition_data_wait> waits,
+      model::isolation_level isolation_level,
+      model::timeout_clock::time_point deadline)
+      : _cluster_pm(cluster_pm)
+      , _coproc_pm(coproc_pm)
+      , _waits(std::move(waits))
+      , _isolation_level(isolation_level)
+      , _deadline(deadline) {}
+
+    /**
+     * Resolves when data arrives, the deadline is reached or the wait is
+     * aborted. Partitions that can not be watched, i.e. the ones that moved
+     * away or are not backed by raft, resolve the wait right away so that the
+     * caller reads them again.
+     */
+    ss::future<> wait() {
+        std::vector<ss::lw_shared_ptr<cluster::partition>> partitions;
+        std::vector<ss::future<>> waits;
+        partitions.reserve(_waits.size());
+        waits.reserve(_waits.size());
+        for (const auto& w : _waits) {
+            if (_as.abort_requested()) {
+                break;
+            }
+            auto partition = _cluster_pm.get(w.ntp);
+            auto kafka_partition = make_partition_proxy(
+              w.ntp, _cluster_pm, _coproc_pm);
+            if (!partition || !kafka_partition || has_data(*kafka_partition, w)) {
+                notify(_woken);
+                break;
+            }
+            auto raft = partition->raft();
+            waits.push_back(
+              raft->visible_offset_monitor()
+                .wait(
+                  model::next_offset(raft->last_visible_index()),
+                  _deadline,
+                  _as)
+                .handle_exception([](const std::exception_ptr&) {
+                    // deadline and abort both end the wait
+                })
+                .finally([this] { notify(_woken); }));
+            partitions.push_back(std::move(partition));
+        }
+        if (waits.empty()) {
+            notify(_woken);
+        }
+        co_await _woken.get_shared_future();
+        abort();
+        co_await ss::when_all_succeed(waits.begin(), waits.end());
+    }
+
+    void abort() {
+        if (!_as.abort_requested()) {
+            _as.request_abort();
+        }
+    }
+
+private:
+    bool has_data(
+      const partition_proxy& partition, const partition_data_wait& w) const {
+        auto last = _isolation_level == model::isolation_level::read_committed
+                      ? partition.last_stable_offset()
+                      : partition.high_watermark();
+        return last > w.fetch_offset;
+    }
+
+    cluster::partition_manager& _cluster_pm;
+    coproc::partition_manager& _coproc_pm;
+    std::vector<partition_data_wait> _waits;
+    model::isolation_level _isolation_level;
+    model::timeout_clock::time_point _deadline;
+    ss::abort_source _as;
+    ss::shared_promise<> _woken;
+};
+
+/**
+ * Runs the data wait of a single shard, the waiter is created and waited on
+ * the partitions shard. Once any of the shards woke the request the other
+ * shards waits are aborted.
+ */
+static ss::future<> wait_for_shard_data(
+  op_context& octx,
+  ss::shard_id shard,
+  std::vector<partition_data_wait> waits,
+  model::timeout_clock::time_point deadline,
+  ss::lw_shared_ptr<ss::shared_promise<>> woken) {
+    auto isolation_level = octx.request.data.isolation_level;
+    if (shard == ss::this_shard_id()) {
+        shard_data_waiter waiter(
+          octx.rctx.partition_manager().local(),
+          octx.rctx.coproc_partition_manager().local(),
+          std::move(waits),
+          isolation_level,
+          deadline);
+        auto done = waiter.wait().finally([woken] { notify(*woken); });
+        co_await woken->get_shared_future();
+        waiter.abort();
+        co_await std::move(done);
+        co_return;
+    }
+
+    auto& cluster_pm = octx.rctx.partition_manager();
+    auto waiter = co_await cluster_pm.invoke_on(
+      shard,
+      octx.ssg,
+      [&coproc_pm = octx.rctx.coproc_partition_manager(),
+       waits = std::move(waits),
+       isolation_level,
+       deadline](cluster::partition_manager& mgr) mutable {
+          return ss::make_foreign(std::make_unique<shard_data_waiter>(
+            mgr,
+            coproc_pm.local(),
+            std::move(waits),
+            isolation_level,
+            deadline));
+      });
+    bool finished = false;
+    auto done = cluster_pm
+                  .invoke_on(
+                    shard,
+                    octx.ssg,
+                    [w = waiter.get()](cluster::partition_manager&) {
+                        return w->wait();
+                    })
+                  .finally([woken, &finished] {
+                      finished = true;
+                      notify(*woken);
+                  });
+    co_await woken->get_shared_future();
+    if (!finished) {
+        co_await cluster_pm.invoke_on(
+          shard,
+          octx.ssg,
+          [w = waiter.get()](cluster::partition_manager&) { w->abort(); });
+    }
+    co_await std::move(done);
+}
+
+/**
+ * Long polls the planned partitions instead of reading them again after a
+ * fixed delay. Waiters are registered on the visible offset monitor of every
+ * partition with a single round trip per shard and the request is woken as
+ * soon as any of the partitions has new data.
+ */
+static ss::future<>
+wait_for_data(op_context& octx, fetch_plan::data_waits_t waits_per_shard) {
+    auto deadline = octx.deadline.value_or(model::no_timeout);
+    auto woken = ss::make_lw_shared<ss::shared_promise<>>();
+    std::vector<ss::future<>> waits;
+    for (size_t shard = 0; shard < waits_per_shard.size(); ++shard) {
+        if (waits_per_shard[shard].empty()) {
+            continue;
+        }
+        waits.push_back(
+          wait_for_shard_data(
+            octx, shard, std::move(waits_per_shard[shard]), deadline, woken)
+            .handle_exception([woken](const std::exception_ptr& e) {
+                vlog(klog.debug, "error waiting for fetch data - {}", e);
+                notify(*woken);
+            }));
+    }
+    return ss::when_all_succeed(waits.begin(), waits.end());
+}
+
 /**
  * Process partition fetch requests.
  *
@@ -523,6 +937,7 @@ static ss::future<> fetch_topic_partitions(op_context& octx) {
     auto planner = make_fetch_planner<simple_fetch_planner>();
 
     auto fetch_plan = planner.create_plan(octx);
+    auto data_waits = std::move(fetch_plan.data_waits_per_shard);
 
     fetch_plan_executor executor
       = make_fetch_plan_executor<parallel_fetch_plan_executor>();
@@ -533,10 +948,16 @@ static ss::future<> fetch_topic_partitions(op_context& octx) {
     }
 
     octx.reset_context();
-    // debounce next read retry
-    co_await ss::sleep(std::min(
-      config::shard_local_cfg().fetch_reads_debounce_timeout(),
-      octx.request.data.max_wait_ms));
+    if (std::all_of(data_waits.begin(), data_waits.end(), [](const auto& w) {
+            return w.empty();
+        })) {
+        // nothing to wait on, debounce next read retry
+        co_await ss::sleep(std::min(
+          config::shard_local_cfg().fetch_reads_debounce_timeout(),
+          octx.request.data.max_wait_ms));
+        co_return;
+    }
+    co_await wait_for_data(octx, std::move(data_waits));
 }
 
 template<>
@@ -721,6 +1142,68 @@ ss::future<response_ptr> op_context::send_response() && {
     return rctx.respond(std::move(final_response));
 }
 
+/**
+ * Resolves once the partition may have data past the given high watermark,
+ * i.e. when a new offset becomes visible. Executed on the partition shard.
+ */
+static ss::future<> wait_for_partition_change(
+  cluster::partition_manager& cluster_pm,
+  coproc::partition_manager& coproc_pm,
+  model::ntp ntp,
+  model::offset high_watermark,
+  ss::abort_source& as,
+  model::timeout_clock::time_point deadline) {
+    auto partition = cluster_pm.get(ntp);
+    auto kafka_partition = make_partition_proxy(ntp, cluster_pm, coproc_pm);
+    if (
+      !partition || !kafka_partition
+      || kafka_partition->high_watermark() != high_watermark) {
+        co_return;
+    }
+    auto raft = partition->raft();
+    co_await raft->visible_offset_monitor().wait(
+      model::next_offset(raft->last_visible_index()), deadline, as);
+}
+
+/**
+ * A session partition becomes idle when a read returned nothing because the
+ * fetch offset reached the high watermark. From then on the partition is
+ * skipped until the watch started here reports a change.
+ */
+static void maybe_mark_idle(
+  op_context& octx,
+  fetch_session_partition& fp,
+  const fetch_response::partition_response& resp) {
+    if (
+      fp.idle || resp.error_code != error_code::none
+      || (resp.records && !resp.records->empty())
+      || fp.high_watermark < model::offset(0)
+      || fp.fetch_offset < fp.high_watermark) {
+        return;
+    }
+    model::ntp ntp(model::kafka_namespace, fp.topic, fp.partition);
+    auto lt = octx.rctx.metadata_cache().get_leader_term(
+      model::topic_namespace_view(ntp), ntp.tp.partition);
+    auto shard = octx.rctx.shards().shard_for(ntp);
+    if (!lt || !shard) {
+        return;
+    }
+    fp.idle = true;
+    fp.idle_term = lt->term;
+    octx.rctx.fetch_sessions().watch_idle_partition(
+      octx.session_ctx.session()->id(),
+      ntp.tp,
+      *shard,
+      [&cluster_pm = octx.rctx.partition_manager(),
+       &coproc_pm = octx.rctx.coproc_partition_manager(),
+       ntp,
+       hw = fp.high_watermark](
+        ss::abort_source& as, model::timeout_clock::time_point deadline) {
+          return wait_for_partition_change(
+            cluster_pm.local(), coproc_pm.local(), ntp, hw, as, deadline);
+      });
+}
+
 op_context::response_placeholder::response_placeholder(
   fetch_response::iterator it, op_context* ctx)
   : _it(it)
@@ -783,6 +1266,8 @@ void op_context::response_placeholder::set(
                 move_to_end();
             }
             _it->partition_response->has_to_be_included = has_to_be_included;
+            maybe_mark_idle(
+              *_ctx, it->second->partition, *_it->partition_response);
         }
     }
 }
@@ -13,10 +13,17 @@
 #include "kafka/protocol/fetch.h"
 #include "kafka/server/handlers/handler.h"
 #include "kafka/types.h"
+#include "utils/buffered_hist.h"
 #include "utils/intrusive_list_helpers.h"
 
 namespace kafka {
 
+/*
+ * Fetch v4 is the first version that carries v2 record batches, which is the
+ * only format the log stores. Older versions would require the batches to be
+ * down-converted to magic v0/v1 message sets on every read, they are not
+ * advertised so the read path always serves the stored batches as they are.
+ */
 using fetch_handler = single_stage_handler<fetch_api, 4, 11>;
 
 /*
@@ -38,6 +45,10 @@ struct op_context {
         bool has_error() {
             return _it->partition_response->error_code != error_code::none;
         }
+        // leaves the partition out of an incremental fetch response
+        void set_unchanged() {
+            _it->partition_response->has_to_be_included = false;
+        }
         void move_to_end() {
             _ctx->iteration_order.erase(
               _ctx->iteration_order.iterator_to(*this));
@@ -169,6 +180,11 @@ struct fetch_config {
     bool strict_max_bytes{false};
     bool skip_read{false};
     kafka::leader_epoch current_leader_epoch;
+    // the client accepts reads from a follower (KIP-392)
+    bool read_from_follower{false};
+    // replicas in the client rack, the leader redirects the client to one of
+    // them if it is in sync
+    std::vector<model::node_id> rack_replicas;
 
     friend std::ostream& operator<<(std::ostream& o, const fetch_config& cfg) {
         fmt::print(
@@ -271,6 +287,8 @@ struct read_result {
     error_code error;
     model::partition_id partition;
     std::vector<cluster::rm_stm::tx_range> aborted_transactions;
+    // replica the client should fetch from next (KIP-392)
+    std::optional<model::node_id> preferred_replica;
 };
 // struct aggregating fetch requests and corresponding response iterators for
 // the same shard
@@ -278,7 +296,7 @@ struct shard_fetch {
     void push_back(
       ntp_fetch_config config,
       op_context::response_placeholder_ptr r_ph,
-      std::unique_ptr<hdr_hist::measurement> m) {
+      buffered_hist::measurement m) {
         requests.push_back(std::move(config));
         responses.push_back(r_ph);
         metrics.push_back(std::move(m));
@@ -297,7 +315,7 @@ struct shard_fetch {
     ss::shard_id shard;
     std::vector<ntp_fetch_config> requests;
     std::vector<op_context::response_placeholder_ptr> responses;
-    std::vector<std::unique_ptr<hdr_hist::measurement>> metrics;
+    std::vector<buffered_hist::measurement> metrics;
 
     friend std::ostream& operator<<(std::ostream& o, const shard_fetch& sf) {
         fmt::print(o, "{}", sf.requests);
@@ -305,11 +323,29 @@ struct shard_fetch {
     }
 };
 
+/**
+ * Partition the fetch request waits on when the response is not complete yet,
+ * the wait is over as soon as the partition has data past the fetch offset.
+ */
+struct partition_data_wait {
+    model::ntp ntp;
+    model::offset fetch_offset;
+};
+
 struct fetch_plan {
     explicit fetch_plan(size_t shards)
-      : fetches_per_shard(shards) {}
+      : fetches_per_shard(shards)
+      , data_waits_per_shard(shards) {}
 
     std::vector<shard_fetch> fetches_per_shard;
+    // partitions to wait on for new data if the plan does not fill the
+    // response, includes the partitions skipped as idle
+    using data_waits_t = std::vector<std::vector<partition_data_wait>>;
+    data_waits_t data_waits_per_shard;
+    // number of planned partitions owned by the shard handling the request
+    // and by other shards
+    size_t local_partitions{0};
+    size_t remote_partitions{0};
 
     friend std::ostream& operator<<(std::ostream& o, const fetch_plan& plan) {
         fmt::print(o, "{{[");
@@ -331,6 +367,12 @@ struct fetch_plan {
     }
 };
 
+/**
+ * Translates an on-disk extent into kafka wire format. Only batch headers are
+ * re-encoded, records are shared with the extent without copying.
+ */
+iobuf extent_to_kafka_wire(storage::extent_read_result);
+
 ss::future<read_result> read_from_ntp(
   cluster::partition_manager&,
   coproc::partition_manager&,
@@ -110,6 +110,32 @@ static void parse_and_set_shadow_indexing_mode(
     }
 }
 
+static void parse_and_set_bool(
+  cluster::property_update<std::optional<bool>>& property,
+  const std::optional<ss::sstring>& value,
+  config_resource_operation op) {
+    switch (op) {
+    case config_resource_operation::remove:
+        property.op = cluster::incremental_update_operation::remove;
+        break;
+    case config_resource_operation::set: {
+        auto parsed = string_switch<std::optional<bool>>(*value)
+                        .match("false", false)
+                        .match("true", true)
+                        .default_match(std::nullopt);
+        if (!parsed) {
+            throw boost::bad_lexical_cast();
+        }
+        property.value = parsed;
+        property.op = cluster::incremental_update_operation::set;
+        break;
+    }
+    case config_resource_operation::append:
+    case config_resource_operation::subtract:
+        break;
+    }
+}
+
 /**
  * valides the optional config
  */
@@ -244,6 +270,11 @@ create_topic_properties_update(incremental_alter_configs_resource& resource) {
                   model::shadow_indexing_mode::fetch);
                 continue;
             }
+            if (cfg.name == topic_property_write_caching) {
+                parse_and_set_bool(
+                  update.properties.write_caching, cfg.value, op);
+                continue;
+            }
             if (
               std::find(
                 std::begin(allowlist_topic_noop_confs),
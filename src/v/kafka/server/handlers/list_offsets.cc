@@ -22,6 +22,10 @@
 #include "model/namespace.h"
 #include "resource_mgmt/io_priority.h"
 
+#include <seastar/core/coroutine.hh>
+
+#include <boost/range/irange.hpp>
+
 namespace kafka {
 
 void list_offsets_request::compute_duplicate_topics() {
@@ -133,90 +137,132 @@ static ss::future<list_offset_partition_response> list_offsets_partition(
     co_return list_offsets_response::make_partition(id, error_code::none);
 }
 
-static ss::future<list_offset_partition_response> list_offsets_partition(
-  list_offsets_ctx& octx,
-  model::timestamp timestamp,
-  list_offset_topic& topic,
-  list_offset_partition& part) {
-    model::ntp ntp(model::kafka_namespace, topic.name, part.partition_index);
-
-    auto shard = octx.rctx.shards().shard_for(ntp);
-    if (!shard) {
-        return ss::make_ready_future<list_offset_partition_response>(
-          list_offsets_response::make_partition(
-            ntp.tp.partition, error_code::unknown_topic_or_partition));
-    }
+/*
+ * A partition of the request that is served by the shard owning it. Its
+ * position in the request is kept so that the response of the partition can
+ * be put back in the request order.
+ */
+struct list_offsets_partition_op {
+    model::ntp ntp;
+    model::timestamp timestamp;
+    kafka::leader_epoch current_leader_epoch;
+    size_t topic_idx;
+    size_t partition_idx;
+};
+
+using list_offsets_plan = std::vector<std::vector<list_offsets_partition_op>>;
 
-    return octx.rctx.partition_manager().invoke_on(
-      *shard,
-      octx.ssg,
-      [timestamp,
-       &octx,
-       ntp = std::move(ntp),
-       isolation_lvl = model::isolation_level(
-         octx.request.data.isolation_level),
-       current_leader_epoch = part.current_leader_epoch](
-        cluster::partition_manager& mgr) mutable {
+/*
+ * Runs on the shard owning the partitions of the ops, the responses are
+ * returned in the order of the ops.
+ */
+static ss::future<std::vector<list_offset_partition_response>>
+list_offsets_shard(
+  list_offsets_ctx& octx,
+  const std::vector<list_offsets_partition_op>& ops,
+  cluster::partition_manager& mgr) {
+    std::vector<list_offset_partition_response> responses(ops.size());
+    const auto isolation_lvl = model::isolation_level(
+      octx.request.data.isolation_level);
+    co_await ss::parallel_for_each(
+      boost::irange<size_t>(0, ops.size()),
+      [&octx, &ops, &mgr, &responses, isolation_lvl](size_t i) {
           return list_offsets_partition(
-            octx,
-            timestamp,
-            std::move(ntp),
-            isolation_lvl,
-            current_leader_epoch,
-            mgr);
+                   octx,
+                   ops[i].timestamp,
+                   ops[i].ntp,
+                   isolation_lvl,
+                   ops[i].current_leader_epoch,
+                   mgr)
+            .then([&responses, i](list_offset_partition_response r) {
+                responses[i] = std::move(r);
+            });
       });
+    co_return responses;
 }
 
-static ss::future<list_offset_topic_response>
-list_offsets_topic(list_offsets_ctx& octx, list_offset_topic& topic) {
-    std::vector<ss::future<list_offset_partition_response>> partitions;
-    partitions.reserve(topic.partitions.size());
-
-    for (auto& part : topic.partitions) {
-        if (octx.request.duplicate_tp(topic.name, part.partition_index)) {
-            partitions.push_back(
-              ss::make_ready_future<list_offset_partition_response>(
-                list_offsets_response::make_partition(
-                  part.partition_index, error_code::invalid_request)));
-            continue;
-        }
+/*
+ * Fills in the responses of the partitions that are known to fail and groups
+ * the other partitions by the shard owning them, so that every shard is
+ * visited once regardless of the number of partitions in the request.
+ */
+static list_offsets_plan create_plan(list_offsets_ctx& octx) {
+    list_offsets_plan plan(ss::smp::count);
+    auto& topics = octx.request.data.topics;
+    octx.response.data.topics.reserve(topics.size());
 
-        if (!octx.rctx.metadata_cache().contains(
-              model::topic_namespace_view(model::kafka_namespace, topic.name),
-              part.partition_index)) {
-            partitions.push_back(
-              ss::make_ready_future<list_offset_partition_response>(
-                list_offsets_response::make_partition(
-                  part.partition_index,
-                  error_code::unknown_topic_or_partition)));
-            continue;
-        }
+    for (size_t t = 0; t < topics.size(); ++t) {
+        auto& topic = topics[t];
+        auto& topic_response = octx.response.data.topics.emplace_back(
+          list_offset_topic_response{.name = topic.name});
+        topic_response.partitions.resize(topic.partitions.size());
 
-        auto pr = list_offsets_partition(octx, part.timestamp, topic, part);
-        partitions.push_back(std::move(pr));
-    }
+        for (size_t p = 0; p < topic.partitions.size(); ++p) {
+            auto& part = topic.partitions[p];
+            auto& part_response = topic_response.partitions[p];
+            if (octx.request.duplicate_tp(topic.name, part.partition_index)) {
+                part_response = list_offsets_response::make_partition(
+                  part.partition_index, error_code::invalid_request);
+                continue;
+            }
 
-    return when_all_succeed(partitions.begin(), partitions.end())
-      .then([name = std::move(topic.name)](
-              std::vector<list_offset_partition_response> parts) mutable {
-          return list_offset_topic_response{
-            .name = std::move(name),
-            .partitions = std::move(parts),
-          };
-      });
-}
+            if (!octx.rctx.metadata_cache().contains(
+                  model::topic_namespace_view(
+                    model::kafka_namespace, topic.name),
+                  part.partition_index)) {
+                part_response = list_offsets_response::make_partition(
+                  part.partition_index,
+                  error_code::unknown_topic_or_partition);
+                continue;
+            }
 
-static std::vector<ss::future<list_offset_topic_response>>
-list_offsets_topics(list_offsets_ctx& octx) {
-    std::vector<ss::future<list_offset_topic_response>> topics;
-    topics.reserve(octx.request.data.topics.size());
+            model::ntp ntp(
+              model::kafka_namespace, topic.name, part.partition_index);
+            auto shard = octx.rctx.shards().shard_for(ntp);
+            if (!shard) {
+                part_response = list_offsets_response::make_partition(
+                  part.partition_index,
+                  error_code::unknown_topic_or_partition);
+                continue;
+            }
 
-    for (auto& topic : octx.request.data.topics) {
-        auto tr = list_offsets_topic(octx, topic);
-        topics.push_back(std::move(tr));
+            plan[*shard].push_back(list_offsets_partition_op{
+              .ntp = std::move(ntp),
+              .timestamp = part.timestamp,
+              .current_leader_epoch = part.current_leader_epoch,
+              .topic_idx = t,
+              .partition_idx = p,
+            });
+        }
     }
+    return plan;
+}
 
-    return topics;
+static ss::future<> list_offsets_topics(list_offsets_ctx& octx) {
+    auto plan = create_plan(octx);
+    co_await ss::parallel_for_each(
+      boost::irange<ss::shard_id>(0, ss::smp::count),
+      [&octx, &plan](ss::shard_id shard) {
+          const auto& ops = plan[shard];
+          if (ops.empty()) {
+              return ss::now();
+          }
+          return octx.rctx.partition_manager()
+            .invoke_on(
+              shard,
+              octx.ssg,
+              [&octx, &ops](cluster::partition_manager& mgr) {
+                  return list_offsets_shard(octx, ops, mgr);
+              })
+            .then([&octx, &ops](
+                    std::vector<list_offset_partition_response> responses) {
+                for (size_t i = 0; i < ops.size(); ++i) {
+                    octx.response.data.topics[ops[i].topic_idx]
+                      .partitions[ops[i].partition_idx]
+                      = std::move(responses[i]);
+                }
+            });
+      });
 }
 
 /*
@@ -266,13 +312,10 @@ list_offsets_handler::handle(request_context ctx, ss::smp_service_group ssg) {
       std::move(ctx), std::move(request), ssg, std::move(unauthorized_topics));
 
     return ss::do_with(std::move(octx), [](list_offsets_ctx& octx) {
-        auto topics = list_offsets_topics(octx);
-        return when_all_succeed(topics.begin(), topics.end())
-          .then([&octx](std::vector<list_offset_topic_response> topics) {
-              octx.response.data.topics = std::move(topics);
-              handle_unauthorized(octx);
-              return octx.rctx.respond(std::move(octx.response));
-          });
+        return list_offsets_topics(octx).then([&octx] {
+            handle_unauthorized(octx);
+            return octx.rctx.respond(std::move(octx.response));
+        });
     });
 }
 
@@ -18,14 +18,15 @@
 #include "kafka/server/errors.h"
 #include "kafka/server/fwd.h"
 #include "kafka/server/handlers/details/leader_epoch.h"
-#include "kafka/server/handlers/details/security.h"
 #include "kafka/server/handlers/topics/topic_utils.h"
+#include "kafka/server/metadata_response_cache.h"
 #include "kafka/server/response.h"
 #include "kafka/types.h"
 #include "likely.h"
 #include "model/metadata.h"
 #include "model/namespace.h"
 #include "model/timeout_clock.h"
+#include "utils/stall_tracker.h"
 #include "utils/to_string.h"
 
 #include <seastar/core/coroutine.hh>
@@ -74,7 +75,8 @@ std::optional<cluster::leader_term> get_leader_term(
   model::topic_namespace_view tp_ns,
   model::partition_id p_id,
   const cluster::metadata_cache& md_cache,
-  const std::vector<model::node_id>& replicas) {
+  const std::vector<model::node_id>& replicas,
+  bool& randomized) {
     auto leader_term = md_cache.get_leader_term(tp_ns, p_id);
     if (!leader_term) {
         return std::nullopt;
@@ -86,6 +88,7 @@ std::optional<cluster::leader_term> get_leader_term(
         if (previous == config::node().node_id()) {
             auto idx = fast_prng_source() % replicas.size();
             leader_term->leader = replicas[idx];
+            randomized = true;
         }
     }
 
@@ -99,20 +102,27 @@ bool is_internal(const model::topic_namespace& tp_ns) {
 
 } // namespace
 
+/**
+ * Builds the topic response, \p randomized is set if the leader of any of the
+ * partitions was selected with the isolation heuristic described above.
+ */
 metadata_response::topic make_topic_response_from_topic_metadata(
-  const cluster::metadata_cache& md_cache, cluster::topic_metadata&& tp_md) {
+  const cluster::metadata_cache& md_cache,
+  const cluster::topic_metadata& tp_md,
+  bool& randomized) {
     metadata_response::topic tp;
     tp.error_code = error_code::none;
-    auto tp_ns = tp_md.get_configuration().tp_ns;
-    tp.name = std::move(tp_md.get_configuration().tp_ns.tp);
+    const auto& tp_ns = tp_md.get_configuration().tp_ns;
+    tp.name = tp_ns.tp;
 
     tp.is_internal = is_internal(tp_ns);
+    tp.partitions.reserve(tp_md.get_assignments().size());
     std::transform(
       tp_md.get_assignments().begin(),
       tp_md.get_assignments().end(),
       std::back_inserter(tp.partitions),
-      [tp_ns = std::move(tp_ns),
-       &md_cache](cluster::partition_assignment& p_md) {
+      [&tp_ns, &md_cache, &randomized](
+        const cluster::partition_assignment& p_md) {
           std::vector<model::node_id> replicas{};
           replicas.reserve(p_md.replicas.size());
           std::transform(
@@ -124,7 +134,8 @@ metadata_response::topic make_topic_response_from_topic_metadata(
           p.error_code = error_code::none;
           p.partition_index = p_md.id;
           p.leader_id = no_leader;
-          auto lt = get_leader_term(tp_ns, p_md.id, md_cache, replicas);
+          auto lt = get_leader_term(
+            tp_ns, p_md.id, md_cache, replicas, randomized);
           if (lt) {
               p.leader_id = lt->leader.value_or(no_leader);
               p.leader_epoch = leader_epoch_from_term(lt->term);
@@ -137,6 +148,13 @@ metadata_response::topic make_topic_response_from_topic_metadata(
     return tp;
 }
 
+metadata_response::topic make_topic_response_from_topic_metadata(
+  const cluster::metadata_cache& md_cache,
+  const cluster::topic_metadata& tp_md) {
+    bool randomized = false;
+    return make_topic_response_from_topic_metadata(md_cache, tp_md, randomized);
+}
+
 static ss::future<metadata_response::topic>
 create_topic(request_context& ctx, model::topic&& topic) {
     // default topic configuration
@@ -175,7 +193,7 @@ create_topic(request_context& ctx, model::topic&& topic) {
                    tout + model::timeout_clock::now())
             .then([&ctx, tp_md = std::move(tp_md)]() mutable {
                 return make_topic_response_from_topic_metadata(
-                  ctx.metadata_cache(), std::move(tp_md.value()));
+                  ctx.metadata_cache(), tp_md.value());
             });
       })
       .handle_exception([topic = std::move(topic)](
@@ -192,30 +210,64 @@ make_error_topic_response(model::topic tp, error_code ec) {
     return metadata_response::topic{.error_code = ec, .name = std::move(tp)};
 }
 
-static metadata_response::topic make_topic_response(
-  request_context& ctx, metadata_request& rq, cluster::topic_metadata md) {
-    int32_t auth_operations = 0;
-    /**
-     * if requested include topic authorized operations
-     */
-    if (rq.data.include_topic_authorized_operations) {
-        auth_operations = details::to_bit_field(
-          details::authorized_operations(ctx, md.get_configuration().tp_ns.tp));
+static iobuf
+encode_topic_response(const metadata_response::topic& t, api_version version) {
+    iobuf buf;
+    response_writer writer(buf);
+    metadata_response::encode_topic(writer, t, version);
+    return buf;
+}
+
+/**
+ * Returns the encoded topic response, served from the shard local cache of
+ * encoded topics when neither the topic nor its leadership changed since it
+ * was last encoded.
+ */
+static iobuf make_encoded_topic_response(
+  request_context& ctx, const cluster::topic_metadata& md) {
+    const auto& tp_ns = md.get_configuration().tp_ns;
+    const auto version = ctx.header().version;
+    auto& md_cache = ctx.metadata_cache();
+    // leadership of non replicable topics follows the source topic which is
+    // not tracked by the topic leadership version
+    const bool cacheable = md.is_topic_replicable();
+    const metadata_response_cache::key key{
+      .topics_version = md_cache.get_topics_version(),
+      .leadership_version = md_cache.get_leadership_version(tp_ns),
+      .version = version,
+    };
+    auto& cache = ctx.get_metadata_response_cache();
+    if (cacheable) {
+        if (auto cached = cache.get(tp_ns, key); cached) {
+            return std::move(*cached);
+        }
     }
 
-    auto res = make_topic_response_from_topic_metadata(
-      ctx.metadata_cache(), std::move(md));
-    res.topic_authorized_operations = auth_operations;
-    return res;
+    bool randomized = false;
+    auto buf = encode_topic_response(
+      make_topic_response_from_topic_metadata(md_cache, md, randomized),
+      version);
+    // randomly selected leaders must not be served to all clients
+    if (cacheable && !randomized) {
+        cache.put(tp_ns, key, buf);
+    }
+    return buf;
 }
 
-static ss::future<std::vector<metadata_response::topic>>
+static ss::future<std::vector<iobuf>>
 get_topic_metadata(request_context& ctx, metadata_request& request) {
-    std::vector<metadata_response::topic> res;
+    std::vector<iobuf> res;
+    const auto version = ctx.header().version;
+    auto encode_error = [version](model::topic tp, error_code ec) {
+        return encode_topic_response(
+          make_error_topic_response(std::move(tp), ec), version);
+    };
 
     // request can be served from whatever happens to be in the cache
     if (request.list_all_topics) {
+        stall_tracker_section("kafka_metadata");
         auto& topics_md = ctx.metadata_cache().all_topics_metadata();
+        res.reserve(topics_md.size());
 
         for (const auto& [tp_ns, md] : topics_md) {
             // only serve topics from the kafka namespace
@@ -232,11 +284,10 @@ get_topic_metadata(request_context& ctx, metadata_request& request) {
                   authz_quiet{true})) {
                 continue;
             }
-            res.push_back(make_topic_response(ctx, request, md.metadata));
+            res.push_back(make_encoded_topic_response(ctx, md.metadata));
         }
 
-        return ss::make_ready_future<std::vector<metadata_response::topic>>(
-          std::move(res));
+        return ss::make_ready_future<std::vector<iobuf>>(std::move(res));
     }
 
     std::vector<ss::future<metadata_response::topic>> new_topics;
@@ -247,24 +298,21 @@ get_topic_metadata(request_context& ctx, metadata_request& request) {
          */
         if (!ctx.authorized(security::acl_operation::describe, topic.name)) {
             // not authorized, return authorization error
-            res.push_back(make_error_topic_response(
+            res.push_back(encode_error(
               std::move(topic.name), error_code::topic_authorization_failed));
             continue;
         }
-        if (auto md = ctx.metadata_cache().get_topic_metadata(
+        if (auto md = ctx.metadata_cache().get_topic_metadata_ref(
               model::topic_namespace_view(model::kafka_namespace, topic.name));
             md) {
-            auto src_topic_response = make_topic_response(
-              ctx, request, std::move(*md));
-            src_topic_response.name = std::move(topic.name);
-            res.push_back(std::move(src_topic_response));
+            res.push_back(make_encoded_topic_response(ctx, md->get()));
             continue;
         }
 
         if (
           !config::shard_local_cfg().auto_create_topics_enabled
           || !request.data.allow_auto_topic_creation) {
-            res.push_back(make_error_topic_response(
+            res.push_back(encode_error(
               std::move(topic.name), error_code::unknown_topic_or_partition));
             continue;
         }
@@ -272,7 +320,7 @@ get_topic_metadata(request_context& ctx, metadata_request& request) {
          * check if authorized to create
          */
         if (!ctx.authorized(security::acl_operation::create, topic.name)) {
-            res.push_back(make_error_topic_response(
+            res.push_back(encode_error(
               std::move(topic.name), error_code::topic_authorization_failed));
             continue;
         }
@@ -280,10 +328,12 @@ get_topic_metadata(request_context& ctx, metadata_request& request) {
     }
 
     return ss::when_all_succeed(new_topics.begin(), new_topics.end())
-      .then([res = std::move(res)](
+      .then([res = std::move(res), version](
               std::vector<metadata_response::topic> topics) mutable {
-          res.insert(res.end(), topics.begin(), topics.end());
-          return res;
+          for (const auto& t : topics) {
+              res.push_back(encode_topic_response(t, version));
+          }
+          return std::move(res);
       });
 }
 
@@ -372,7 +422,7 @@ template<>
 ss::future<response_ptr> metadata_handler::handle(
   request_context ctx, [[maybe_unused]] ss::smp_service_group g) {
     metadata_response reply;
-    auto alive_brokers = co_await ctx.metadata_cache().all_alive_brokers();
+    auto alive_brokers = ctx.metadata_cache().all_alive_brokers();
     for (const auto& broker : alive_brokers) {
         std::optional<model::broker_endpoint> peer_listener;
         for (const auto& listener : broker->kafka_advertised_listeners()) {
@@ -412,15 +462,12 @@ ss::future<response_ptr> metadata_handler::handle(
     metadata_request request;
     request.decode(ctx.reader(), ctx.header().version);
 
-    reply.data.topics = co_await get_topic_metadata(ctx, request);
-
-    if (
-      request.data.include_cluster_authorized_operations
-      && ctx.authorized(
-        security::acl_operation::describe, security::default_cluster_name)) {
-        reply.data.cluster_authorized_operations = details::to_bit_field(
-          details::authorized_operations(ctx, security::default_cluster_name));
-    }
+    // topics are spliced into the response already encoded, authorized
+    // operations fields only exist in versions which are not supported here
+    static_assert(
+      metadata_handler::max_supported
+      <= metadata_response::max_encoded_topics_version);
+    reply.encoded_topics = co_await get_topic_metadata(ctx, request);
 
     co_return co_await ctx.respond(std::move(reply));
 }
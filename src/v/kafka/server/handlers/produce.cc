@@ -25,15 +25,20 @@
 #include "model/timestamp.h"
 #include "raft/errc.h"
 #include "raft/types.h"
+#include "resource_mgmt/smp_groups_probe.h"
+#include "storage/parser_utils.h"
 #include "ssx/future-util.h"
 #include "utils/remote.h"
+#include "utils/request_tracer.h"
 #include "utils/to_string.h"
 #include "vlog.h"
 
 #include <seastar/core/execution_stage.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/smp.hh>
+#include <seastar/core/with_scheduling_group.hh>
 #include <seastar/util/log.hh>
 
 #include <boost/container_hash/extensions.hpp>
@@ -180,9 +185,12 @@ static partition_produce_stages partition_append(
   model::record_batch_reader reader,
   int16_t acks,
   int32_t num_records,
-  int64_t num_bytes) {
-    auto stages = partition->replicate(
-      bid, std::move(reader), acks_to_replicate_options(acks));
+  int64_t num_bytes,
+  trace_id trace) {
+    auto opts = acks_to_replicate_options(acks);
+    opts.trace = trace;
+    request_tracer::local().record(trace, trace_stage::produce_replicate);
+    auto stages = partition->replicate(bid, std::move(reader), opts);
     return partition_produce_stages{
       .dispatched = std::move(stages.request_enqueued),
       .produced = stages.replicate_finished.then_wrapped(
@@ -226,6 +234,128 @@ ss::future<produce_response::partition> finalize_request_with_error_code(
         .partition_index = ntp.tp.partition, .error_code = ec});
 }
 
+/**
+ * Appends the batch to the partition on its shard. The dispatch promise is
+ * resolved on the source shard once the batch is enqueued for replication.
+ */
+static ss::future<produce_response::partition> append_on_shard(
+  produce_ctx& octx,
+  ss::shard_id shard,
+  model::ntp ntp,
+  model::record_batch_reader reader,
+  std::unique_ptr<ss::promise<>> dispatch,
+  int32_t num_records,
+  int64_t batch_size,
+  model::batch_identity bid) {
+    return measured_invoke_on(
+      octx.rctx.partition_manager(),
+      shard,
+      octx.ssg,
+      smp_group_kind::kafka,
+      [reader = std::move(reader),
+       ntp = std::move(ntp),
+       dispatch = std::move(dispatch),
+       num_records,
+       batch_size,
+       bid,
+       acks = octx.request.data.acks,
+       trace = octx.rctx.trace(),
+       source_shard = ss::this_shard_id()](
+        cluster::partition_manager& mgr) mutable {
+          auto partition = mgr.get(ntp);
+          if (!partition) {
+              return finalize_request_with_error_code(
+                error_code::unknown_topic_or_partition,
+                std::move(dispatch),
+                ntp,
+                source_shard);
+          }
+          if (unlikely(!partition->is_leader())) {
+              return finalize_request_with_error_code(
+                error_code::not_leader_for_partition,
+                std::move(dispatch),
+                ntp,
+                source_shard);
+          }
+          if (partition->is_read_replica_mode_enabled()) {
+              return finalize_request_with_error_code(
+                error_code::invalid_topic_exception,
+                std::move(dispatch),
+                ntp,
+                source_shard);
+          }
+          auto stages = partition_append(
+            ntp.tp.partition,
+            ss::make_lw_shared<replicated_partition>(std::move(partition)),
+            bid,
+            std::move(reader),
+            acks,
+            num_records,
+            batch_size,
+            trace);
+          return stages.dispatched
+            .then_wrapped([source_shard, dispatch = std::move(dispatch)](
+                            ss::future<> f) mutable {
+                if (f.failed()) {
+                    (void)ss::smp::submit_to(
+                      source_shard,
+                      [dispatch = std::move(dispatch),
+                       e = f.get_exception()]() mutable {
+                          dispatch->set_exception(e);
+                          dispatch.reset();
+                      });
+                    return;
+                }
+                (void)ss::smp::submit_to(
+                  source_shard,
+                  [dispatch = std::move(dispatch)]() mutable {
+                      dispatch->set_value();
+                      dispatch.reset();
+                  });
+            })
+            .then([f = std::move(stages.produced)]() mutable {
+                return std::move(f);
+            });
+      });
+}
+
+/**
+ * Codec the batches produced to the topic are stored with. The producer
+ * choice is kept unless the topic, or the cluster default, names a codec.
+ */
+static std::optional<model::compression>
+recompression_target(produce_ctx& octx, const model::topic& topic) {
+    auto& md = octx.rctx.metadata_cache();
+    auto c = md.get_topic_compression(
+                 model::topic_namespace_view(model::kafka_namespace, topic))
+               .value_or(md.get_default_compression());
+    if (c == model::compression::producer) {
+        return std::nullopt;
+    }
+    return c;
+}
+
+/**
+ * Recompresses the batch to the target codec. It runs in the recompression
+ * scheduling group so that it is accounted separately from the produce path.
+ */
+static ss::future<model::record_batch> recompress_batch(
+  model::record_batch batch,
+  model::compression target,
+  ss::scheduling_group sg) {
+    return ss::with_scheduling_group(
+      sg, [batch = std::move(batch), target]() mutable {
+          return storage::internal::decompress_batch(std::move(batch))
+            .then([target](model::record_batch b) {
+                if (target == model::compression::none) {
+                    return ss::make_ready_future<model::record_batch>(
+                      std::move(b));
+                }
+                return storage::internal::compress_batch(target, std::move(b));
+            });
+      });
+}
+
 /**
  * \brief handle writing to a single topic partition.
  */
@@ -271,93 +401,87 @@ static partition_produce_stages produce_topic_partition(
     auto bid = model::batch_identity::from(hdr);
     auto batch_size = batch.size_bytes();
     auto num_records = batch.record_count();
-    auto reader = reader_from_lcore_batch(std::move(batch));
     auto start = std::chrono::steady_clock::now();
 
+    // batches already in the target codec are stored as they are
+    auto target = recompression_target(octx, topic.name);
+    auto batch_f
+      = target && hdr.attrs.compression() != *target
+          ? recompress_batch(
+            std::move(batch), *target, octx.rctx.recompression_sg())
+          : ss::make_ready_future<model::record_batch>(std::move(batch));
+
     auto dispatch = std::make_unique<ss::promise<>>();
-    auto dispatch_f = dispatch->get_future();
+    ss::shared_future<> dispatch_f(dispatch->get_future());
     auto m = octx.rctx.probe().auto_produce_measurement();
-    auto f
-      = octx.rctx.partition_manager()
-          .invoke_on(
-            *shard,
-            octx.ssg,
-            [reader = std::move(reader),
-             ntp = std::move(ntp),
-             dispatch = std::move(dispatch),
-             num_records,
-             batch_size,
-             bid,
-             acks = octx.request.data.acks,
-             source_shard = ss::this_shard_id()](
-              cluster::partition_manager& mgr) mutable {
-                auto partition = mgr.get(ntp);
-                if (!partition) {
-                    return finalize_request_with_error_code(
-                      error_code::unknown_topic_or_partition,
-                      std::move(dispatch),
-                      ntp,
-                      source_shard);
-                }
-                if (unlikely(!partition->is_leader())) {
-                    return finalize_request_with_error_code(
-                      error_code::not_leader_for_partition,
-                      std::move(dispatch),
-                      ntp,
-                      source_shard);
-                }
-                if (partition->is_read_replica_mode_enabled()) {
-                    return finalize_request_with_error_code(
-                      error_code::invalid_topic_exception,
-                      std::move(dispatch),
-                      ntp,
-                      source_shard);
-                }
-                auto stages = partition_append(
-                  ntp.tp.partition,
-                  ss::make_lw_shared<replicated_partition>(
-                    std::move(partition)),
-                  bid,
-                  std::move(reader),
-                  acks,
-                  num_records,
-                  batch_size);
-                return stages.dispatched
-                  .then_wrapped([source_shard, dispatch = std::move(dispatch)](
-                                  ss::future<> f) mutable {
-                      if (f.failed()) {
-                          (void)ss::smp::submit_to(
-                            source_shard,
-                            [dispatch = std::move(dispatch),
-                             e = f.get_exception()]() mutable {
-                                dispatch->set_exception(e);
-                                dispatch.reset();
-                            });
-                          return;
-                      }
-                      (void)ss::smp::submit_to(
-                        source_shard,
-                        [dispatch = std::move(dispatch)]() mutable {
-                            dispatch->set_value();
-                            dispatch.reset();
-                        });
-                  })
-                  .then([f = std::move(stages.produced)]() mutable {
-                      return std::move(f);
-                  });
-            })
-          .then([&octx, start, m = std::move(m)](
-                  produce_response::partition p) {
-              if (p.error_code == error_code::none) {
-                  auto dur = std::chrono::steady_clock::now() - start;
-                  octx.rctx.connection()->server().update_produce_latency(dur);
-              } else {
-                  m->set_trace(false);
-              }
-              return p;
-          });
+    /*
+     * the append to the partition waits only for the previous dispatch to
+     * the same partition from this connection, appends to other partitions
+     * of the following requests proceed concurrently.
+     */
+    auto previous = octx.rctx.connection()->sequence_partition_dispatch(
+      ntp, dispatch_f);
+    auto f = std::move(batch_f)
+               .then_wrapped([&octx,
+                              previous = std::move(previous),
+                              shard = *shard,
+                              ntp = std::move(ntp),
+                              dispatch = std::move(dispatch),
+                              num_records,
+                              batch_size,
+                              bid](ss::future<model::record_batch> bf) mutable {
+                   if (bf.failed()) {
+                       vlog(
+                         klog.warn,
+                         "Unable to recompress batch produced to {} - {}",
+                         ntp,
+                         bf.get_exception());
+                       return std::move(previous).then(
+                         [dispatch = std::move(dispatch),
+                          id = ntp.tp.partition]() mutable {
+                             dispatch->set_value();
+                             return produce_response::partition{
+                               .partition_index = id,
+                               .error_code = error_code::corrupt_message};
+                         });
+                   }
+                   return std::move(previous).then(
+                     [&octx,
+                      shard,
+                      batch = bf.get0(),
+                      ntp = std::move(ntp),
+                      dispatch = std::move(dispatch),
+                      num_records,
+                      batch_size,
+                      bid]() mutable {
+                         return append_on_shard(
+                           octx,
+                           shard,
+                           std::move(ntp),
+                           reader_from_lcore_batch(std::move(batch)),
+                           std::move(dispatch),
+                           num_records,
+                           batch_size,
+                           bid);
+                     });
+               })
+               .then([&octx, start, m = std::move(m)](
+                       produce_response::partition p) {
+                   if (p.error_code == error_code::none) {
+                       auto dur = std::chrono::steady_clock::now() - start;
+                       octx.rctx.connection()->server().update_produce_latency(
+                         dur);
+                   } else {
+                       m.set_trace(false);
+                   }
+                   return p;
+               });
+    /*
+     * the request counts as dispatched once its appends are ordered, the
+     * connection may go on reading the next request right away.
+     */
     return partition_produce_stages{
-      .dispatched = std::move(dispatch_f),
+      .dispatched = ss::now(),
       .produced = std::move(f),
     };
 }
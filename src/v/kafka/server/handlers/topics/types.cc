@@ -157,6 +157,8 @@ to_cluster_type(const creatable_topic& t) {
     if (cfg.properties.read_replica_bucket.has_value()) {
         cfg.properties.read_replica = true;
     }
+    cfg.properties.write_caching = get_bool_value(
+      config_entries, topic_property_write_caching);
     /// Final topic_property not decoded here is \ref remote_topic_properties,
     /// is more of an implementation detail no need to ever show user
 
@@ -251,6 +253,10 @@ config_map_t from_cluster_type(const cluster::topic_properties& properties) {
         config_entries[topic_property_read_replica] = from_config_type(
           *properties.read_replica_bucket);
     }
+    if (properties.write_caching) {
+        config_entries[topic_property_write_caching] = from_config_type(
+          *properties.write_caching);
+    }
     /// Final topic_property not encoded here is \ref remote_topic_properties,
     /// is more of an implementation detail no need to ever show user
     return config_entries;
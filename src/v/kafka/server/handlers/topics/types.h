@@ -53,6 +53,8 @@ static constexpr std::string_view topic_property_remote_read
   = "redpanda.remote.read";
 static constexpr std::string_view topic_property_read_replica
   = "redpanda.remote.readreplica";
+static constexpr std::string_view topic_property_write_caching
+  = "redpanda.write.caching";
 
 // Data-policy property
 static constexpr std::string_view topic_property_data_policy_function_name
@@ -76,10 +76,10 @@ bool group_member::should_keep_alive(
 }
 
 std::ostream& operator<<(std::ostream& o, const group_member& m) {
-    auto timer_expires =
-      [](const auto& timer) -> std::optional<group_member::duration_type> {
-        if (timer.armed()) {
-            return timer.get_timeout() - group_member::clock_type::now();
+    auto expires = [](const auto& deadline)
+      -> std::optional<group_member::duration_type> {
+        if (deadline) {
+            return *deadline - group_member::clock_type::now();
         }
         return std::nullopt;
     };
@@ -93,7 +93,7 @@ std::ostream& operator<<(std::ostream& o, const group_member& m) {
       m.group_id(),
       m.group_instance_id(),
       m.protocol_type(),
-      m.assignment().size(),
+      m._state.assignment.size_bytes(),
       m.session_timeout(),
       m.rebalance_timeout(),
       m._protocols,
@@ -101,7 +101,7 @@ std::ostream& operator<<(std::ostream& o, const group_member& m) {
       m.is_joining(),
       m.is_syncing(),
       m._latest_heartbeat.time_since_epoch(),
-      timer_expires(m._expire_timer));
+      expires(m._expire_deadline));
     return o;
 }
 
@@ -107,11 +107,24 @@ public:
     /// Get the member's assignment.
     const bytes assignment() const { return iobuf_to_bytes(_state.assignment); }
 
+    /// Get a shared view of the member's assignment.
+    iobuf shared_assignment() const {
+        return _state.assignment.share(0, _state.assignment.size_bytes());
+    }
+
     /// Set the member's assignment.
     void set_assignment(bytes assignment) {
         _state.assignment = bytes_to_iobuf(assignment);
     }
 
+    /**
+     * Set the member's assignment to a view of a buffer shared by the group
+     * members, see group::share_assignments.
+     */
+    void set_assignment(iobuf assignment) {
+        _state.assignment = std::move(assignment);
+    }
+
     /// Clear the member's assignment.
     void clear_assignment() { _state.assignment.clear(); }
 
@@ -196,7 +209,16 @@ public:
         _latest_heartbeat = t;
     }
 
-    ss::timer<clock_type>& expire_timer() { return _expire_timer; }
+    /// Deadline of the scheduled heartbeat expiration, if any.
+    std::optional<clock_type::time_point> expire_deadline() const {
+        return _expire_deadline;
+    }
+
+    void set_expire_deadline(clock_type::time_point deadline) {
+        _expire_deadline = deadline;
+    }
+
+    void clear_expire_deadline() { _expire_deadline = std::nullopt; }
 
     // helper for kafka api: describe groups
     described_group_member describe(const kafka::protocol_name&) const;
@@ -213,7 +235,7 @@ private:
 
     bool _is_new;
     clock_type::time_point _latest_heartbeat;
-    ss::timer<clock_type> _expire_timer;
+    std::optional<clock_type::time_point> _expire_deadline;
     kafka::protocol_type _protocol_type;
     std::vector<member_protocol> _protocols;
 
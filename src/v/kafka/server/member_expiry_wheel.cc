@@ -0,0 +1,82 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#include "kafka/server/member_expiry_wheel.h"
+
+namespace kafka {
+
+member_expiry_wheel::member_expiry_wheel(expire_cb cb)
+  : _expire(std::move(cb)) {
+    _timer.set_callback([this] { on_tick(); });
+}
+
+int64_t member_expiry_wheel::tick_of(clock_type::time_point deadline) {
+    // round up, a bucket fires once all of its deadlines have passed
+    return (deadline.time_since_epoch() + tick - clock_type::duration(1))
+           / tick;
+}
+
+void member_expiry_wheel::schedule(
+  const member_ptr& member, clock_type::time_point deadline) {
+    member->set_expire_deadline(deadline);
+    auto t = tick_of(deadline);
+    _buckets[t].push_back(entry{.member = member, .deadline = deadline});
+    ++_size;
+
+    auto fire_at = clock_type::time_point(t * tick);
+    if (!_timer.armed() || _timer.get_timeout() > fire_at) {
+        _timer.rearm(fire_at);
+    }
+}
+
+void member_expiry_wheel::cancel(group_member& member) {
+    // the bucket entry becomes stale and is dropped when the bucket fires
+    member.clear_expire_deadline();
+}
+
+void member_expiry_wheel::clear() {
+    _timer.cancel();
+    for (auto& [_, entries] : _buckets) {
+        for (auto& e : entries) {
+            e.member->clear_expire_deadline();
+        }
+    }
+    _buckets.clear();
+    _size = 0;
+}
+
+void member_expiry_wheel::on_tick() {
+    const auto now = clock_type::now().time_since_epoch() / tick;
+    while (!_buckets.empty() && _buckets.begin()->first <= now) {
+        // detach the bucket first, expiring a member may reschedule others
+        auto entries = std::move(_buckets.begin()->second);
+        _buckets.erase(_buckets.begin());
+        _size -= entries.size();
+        for (auto& e : entries) {
+            if (e.member->expire_deadline() != e.deadline) {
+                // rescheduled or cancelled since this entry was added
+                continue;
+            }
+            e.member->clear_expire_deadline();
+            _expire(std::move(e.member), e.deadline);
+        }
+    }
+    rearm();
+}
+
+void member_expiry_wheel::rearm() {
+    if (_buckets.empty()) {
+        _timer.cancel();
+        return;
+    }
+    _timer.rearm(clock_type::time_point(_buckets.begin()->first * tick));
+}
+
+} // namespace kafka
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#pragma once
+
+#include "kafka/server/member.h"
+#include "seastarx.h"
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <map>
+#include <vector>
+
+namespace kafka {
+
+/**
+ * Tracks the heartbeat expiration of all the members of a group with a single
+ * timer.
+ *
+ * Deadlines are rounded up to a coarse tick and members expiring in the same
+ * tick share a bucket. Rescheduling a member only records the new deadline in
+ * the member and appends it to the bucket of that deadline, the stale entries
+ * left in earlier buckets are dropped when their bucket fires. This keeps the
+ * heartbeat path allocation free (no per member timer or callback) and makes
+ * the expiration work proportional to the number of buckets that fire rather
+ * than to the number of members.
+ */
+class member_expiry_wheel {
+public:
+    using clock_type = group_member::clock_type;
+    using expire_cb
+      = ss::noncopyable_function<void(member_ptr, clock_type::time_point)>;
+
+    static constexpr clock_type::duration tick = std::chrono::milliseconds(100);
+
+    explicit member_expiry_wheel(expire_cb);
+
+    member_expiry_wheel(const member_expiry_wheel&) = delete;
+    member_expiry_wheel(member_expiry_wheel&&) = delete;
+    member_expiry_wheel& operator=(const member_expiry_wheel&) = delete;
+    member_expiry_wheel& operator=(member_expiry_wheel&&) = delete;
+    ~member_expiry_wheel() = default;
+
+    /// (Re)schedule the expiration of the member at the given deadline
+    void schedule(const member_ptr&, clock_type::time_point deadline);
+
+    /// Cancel the expiration of the member
+    void cancel(group_member&);
+
+    /// Cancel all expirations
+    void clear();
+
+    /// Number of entries, including the stale ones, for testing
+    size_t size() const { return _size; }
+
+private:
+    struct entry {
+        member_ptr member;
+        clock_type::time_point deadline;
+    };
+
+    static int64_t tick_of(clock_type::time_point);
+    void on_tick();
+    void rearm();
+
+    std::map<int64_t, std::vector<entry>> _buckets;
+    size_t _size{0};
+    expire_cb _expire;
+    ss::timer<clock_type> _timer;
+};
+
+} // namespace kafka
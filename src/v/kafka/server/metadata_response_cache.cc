@@ -0,0 +1,80 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#include "kafka/server/metadata_response_cache.h"
+
+#include "vassert.h"
+
+namespace kafka {
+
+metadata_response_cache::metadata_response_cache() {
+    _eviction_timer.set_callback([this] {
+        evict();
+        _eviction_timer.arm(eviction_timeout);
+    });
+    _eviction_timer.arm(eviction_timeout);
+}
+
+metadata_response_cache::~metadata_response_cache() {
+    _eviction_timer.cancel();
+}
+
+std::optional<iobuf> metadata_response_cache::get(
+  model::topic_namespace_view tp_ns, const key& k) {
+    auto it = _cache.find(tp_ns);
+    if (it == _cache.end()) {
+        return std::nullopt;
+    }
+    auto& e = it->second;
+    if (
+      e.topics_version != k.topics_version
+      || e.leadership_version != k.leadership_version) {
+        // stale, the topics or the topic leadership changed
+        _cache.erase(it);
+        return std::nullopt;
+    }
+    auto& encoded = e.encoded[k.version()];
+    if (!encoded) {
+        return std::nullopt;
+    }
+    e.last_used = ss::lowres_clock::now();
+    return encoded->share(0, encoded->size_bytes());
+}
+
+void metadata_response_cache::put(
+  model::topic_namespace_view tp_ns, const key& k, const iobuf& encoded) {
+    vassert(
+      k.version <= metadata_response::max_encoded_topics_version,
+      "unexpected metadata response version {}",
+      k.version);
+    auto it = _cache.find(tp_ns);
+    if (it == _cache.end()) {
+        it = _cache.emplace(model::topic_namespace(tp_ns), entry{}).first;
+    }
+    auto& e = it->second;
+    if (
+      e.topics_version != k.topics_version
+      || e.leadership_version != k.leadership_version) {
+        e = entry{
+          .topics_version = k.topics_version,
+          .leadership_version = k.leadership_version};
+    }
+    e.encoded[k.version()] = encoded.copy();
+    e.last_used = ss::lowres_clock::now();
+}
+
+void metadata_response_cache::evict() {
+    auto now = ss::lowres_clock::now();
+    absl::erase_if(_cache, [now](const auto& p) {
+        return p.second.last_used + eviction_timeout < now;
+    });
+}
+
+} // namespace kafka
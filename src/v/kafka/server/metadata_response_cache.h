@@ -0,0 +1,84 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#pragma once
+
+#include "bytes/iobuf.h"
+#include "kafka/protocol/metadata.h"
+#include "kafka/types.h"
+#include "model/metadata.h"
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/timer.hh>
+
+#include <absl/container/node_hash_map.h>
+
+#include <array>
+#include <optional>
+
+namespace kafka {
+
+/**
+ * Shard local cache of encoded metadata response topics.
+ *
+ * The encoded form of a topic only depends on the topic assignments, the
+ * partitions leadership and the request version, it is the same for every
+ * listener. Entries are validated against the topic table version and the
+ * topic leadership version on every lookup so that any topic table or
+ * leadership update makes the cached fragment stale. Entries that were not
+ * used for eviction_timeout are dropped.
+ */
+class metadata_response_cache {
+public:
+    struct key {
+        uint64_t topics_version;
+        uint64_t leadership_version;
+        api_version version;
+    };
+
+    metadata_response_cache();
+
+    metadata_response_cache(const metadata_response_cache&) = delete;
+    metadata_response_cache(metadata_response_cache&&) = delete;
+    metadata_response_cache& operator=(const metadata_response_cache&) = delete;
+    metadata_response_cache& operator=(metadata_response_cache&&) = delete;
+    ~metadata_response_cache();
+
+    /// Returns a shared copy of the encoded topic if it is still valid
+    std::optional<iobuf> get(model::topic_namespace_view, const key&);
+
+    void put(model::topic_namespace_view, const key&, const iobuf&);
+
+    size_t size() const { return _cache.size(); }
+
+private:
+    struct entry {
+        uint64_t topics_version{0};
+        uint64_t leadership_version{0};
+        std::array<
+          std::optional<iobuf>,
+          metadata_response::max_encoded_topics_version() + 1>
+          encoded;
+        ss::lowres_clock::time_point last_used;
+    };
+
+    void evict();
+
+    static constexpr std::chrono::seconds eviction_timeout{60};
+    absl::node_hash_map<
+      model::topic_namespace,
+      entry,
+      model::topic_namespace_hash,
+      model::topic_namespace_eq>
+      _cache;
+    ss::timer<> _eviction_timer;
+};
+
+} // namespace kafka
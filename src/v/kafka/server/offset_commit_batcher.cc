@@ -0,0 +1,176 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#include "kafka/server/offset_commit_batcher.h"
+
+#include "config/configuration.h"
+#include "model/record_batch_reader.h"
+#include "prometheus/prometheus_sanitize.h"
+#include "ssx/future-util.h"
+
+#include <seastar/core/metrics.hh>
+
+namespace kafka {
+
+offset_commit_batcher::offset_commit_batcher(
+  ss::lw_shared_ptr<cluster::partition> partition,
+  config::binding<std::chrono::milliseconds> window)
+  : _partition(std::move(partition))
+  , _window(std::move(window)) {
+    _flush_timer.set_callback([this] { flush(); });
+    setup_metrics();
+}
+
+raft::replicate_stages offset_commit_batcher::replicate(
+  model::term_id term, model::record_batch batch) {
+    if (_gate.is_closed()) {
+        return raft::replicate_stages(raft::errc::shutting_down);
+    }
+
+    if (_window() == std::chrono::milliseconds(0)) {
+        ++_appends;
+        ++_commits;
+        return _partition->raft()->replicate_in_stages(
+          term,
+          model::make_memory_record_batch_reader(std::move(batch)),
+          raft::replicate_options(raft::consistency_level::quorum_ack));
+    }
+
+    // batches are replicated with the term of the group that built them, never
+    // mix terms in a single append
+    if (!_pending.empty() && _term != term) {
+        flush();
+    }
+    _term = term;
+
+    auto& i = _pending.emplace_back(item{.batch = std::move(batch)});
+    raft::replicate_stages stages(
+      i.enqueued.get_future(), i.finished.get_future());
+
+    if (_pending.size() >= max_batched_commits) {
+        flush();
+    } else if (!_flush_timer.armed()) {
+        _flush_timer.arm(_window());
+    }
+    return stages;
+}
+
+void offset_commit_batcher::flush() {
+    _flush_timer.cancel();
+    if (_pending.empty()) {
+        return;
+    }
+    std::vector<item> items;
+    items.swap(_pending);
+    dispatch(_term, std::move(items));
+}
+
+void offset_commit_batcher::dispatch(
+  model::term_id term, std::vector<item> items) {
+    ++_appends;
+    _commits += items.size();
+
+    /*
+     * batches of a single append are assigned contiguous offsets, the last
+     * offset of each batch is the last offset of the append minus the number
+     * of records appended after it.
+     */
+    std::vector<int64_t> following(items.size());
+    int64_t records = 0;
+    for (size_t idx = items.size(); idx-- > 0;) {
+        following[idx] = records;
+        records += items[idx].batch.record_count();
+    }
+
+    model::record_batch_reader::data_t batches;
+    batches.reserve(items.size());
+    for (auto& i : items) {
+        batches.push_back(std::move(i.batch));
+    }
+
+    auto stages = _partition->raft()->replicate_in_stages(
+      term,
+      model::make_memory_record_batch_reader(std::move(batches)),
+      raft::replicate_options(raft::consistency_level::quorum_ack));
+
+    ssx::spawn_with_gate(
+      _gate,
+      [stages = std::move(stages),
+       items = std::move(items),
+       following = std::move(following)]() mutable {
+          return complete(
+            std::move(stages), std::move(items), std::move(following));
+      });
+}
+
+ss::future<> offset_commit_batcher::complete(
+  raft::replicate_stages stages,
+  std::vector<item> items,
+  std::vector<int64_t> following) {
+    try {
+        co_await std::move(stages.request_enqueued);
+        for (auto& i : items) {
+            i.enqueued.set_value();
+        }
+    } catch (...) {
+        auto e = std::current_exception();
+        for (auto& i : items) {
+            i.enqueued.set_exception(e);
+        }
+    }
+
+    try {
+        auto r = co_await std::move(stages.replicate_finished);
+        for (size_t idx = 0; idx < items.size(); ++idx) {
+            if (!r) {
+                items[idx].finished.set_value(r.error());
+                continue;
+            }
+            items[idx].finished.set_value(raft::replicate_result{
+              .last_offset = r.value().last_offset
+                             - model::offset(following[idx])});
+        }
+    } catch (...) {
+        auto e = std::current_exception();
+        for (auto& i : items) {
+            i.finished.set_exception(e);
+        }
+    }
+}
+
+ss::future<> offset_commit_batcher::stop() {
+    flush();
+    return _gate.close();
+}
+
+void offset_commit_batcher::setup_metrics() {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+
+    namespace sm = ss::metrics;
+    auto partition_label = sm::label("partition");
+    std::vector<sm::label_instance> labels{
+      partition_label(_partition->ntp().tp.partition())};
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("kafka:group_offset_commit_batcher"),
+      {sm::make_counter(
+         "appends",
+         [this] { return _appends; },
+         sm::description("Number of raft appends carrying offset commits"),
+         labels),
+       sm::make_counter(
+         "commits",
+         [this] { return _commits; },
+         sm::description("Number of offset commits replicated"),
+         labels)});
+}
+
+} // namespace kafka
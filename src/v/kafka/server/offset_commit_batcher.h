@@ -0,0 +1,83 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#pragma once
+
+#include "cluster/partition.h"
+#include "config/property.h"
+#include "model/fundamental.h"
+#include "model/record.h"
+#include "raft/types.h"
+#include "seastarx.h"
+
+#include <seastar/core/gate.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/timer.hh>
+
+#include <vector>
+
+namespace kafka {
+
+/**
+ * Coalesces the offset commit batches of all the groups coordinated by a
+ * single group metadata partition into one raft append.
+ *
+ * Batches submitted within the configured window are replicated together, each
+ * caller is completed individually with a replicate result carrying the last
+ * offset of its own batch. Batches replicated for different terms are never
+ * mixed, a term change flushes the pending batches. A zero window disables
+ * batching and replicates every commit on its own.
+ */
+class offset_commit_batcher {
+public:
+    offset_commit_batcher(
+      ss::lw_shared_ptr<cluster::partition>,
+      config::binding<std::chrono::milliseconds> window);
+
+    offset_commit_batcher(const offset_commit_batcher&) = delete;
+    offset_commit_batcher(offset_commit_batcher&&) = delete;
+    offset_commit_batcher& operator=(const offset_commit_batcher&) = delete;
+    offset_commit_batcher& operator=(offset_commit_batcher&&) = delete;
+    ~offset_commit_batcher() = default;
+
+    raft::replicate_stages replicate(model::term_id, model::record_batch);
+
+    /// Flushes pending batches and waits for the appends in flight
+    ss::future<> stop();
+
+private:
+    struct item {
+        model::record_batch batch;
+        ss::promise<> enqueued;
+        ss::promise<result<raft::replicate_result>> finished;
+    };
+
+    void flush();
+    void dispatch(model::term_id, std::vector<item>);
+    static ss::future<> complete(
+      raft::replicate_stages, std::vector<item>, std::vector<int64_t>);
+    void setup_metrics();
+
+    // upper bound on the number of commits coalesced into a single append
+    static constexpr size_t max_batched_commits = 1024;
+
+    ss::lw_shared_ptr<cluster::partition> _partition;
+    config::binding<std::chrono::milliseconds> _window;
+    model::term_id _term;
+    std::vector<item> _pending;
+    ss::timer<> _flush_timer;
+    ss::gate _gate;
+
+    uint64_t _appends{0};
+    uint64_t _commits{0};
+    ss::metrics::metric_groups _metrics;
+};
+
+} // namespace kafka
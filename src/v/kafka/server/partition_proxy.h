@@ -45,6 +45,16 @@ public:
           storage::log_reader_config,
           std::optional<model::timeout_clock::time_point>)
           = 0;
+        /**
+         * Extent reads are an optional fast path. Offsets in the config and
+         * in the returned result are kafka offsets, the offsets stored in the
+         * extent data are not translated.
+         */
+        virtual ss::future<std::optional<storage::extent_read_result>>
+          read_extent(storage::extent_read_config) {
+            return ss::make_ready_future<
+              std::optional<storage::extent_read_result>>(std::nullopt);
+        }
         virtual ss::future<std::optional<storage::timequery_result>>
           timequery(storage::timequery_config) = 0;
         virtual ss::future<std::vector<cluster::rm_stm::tx_range>>
@@ -57,6 +67,11 @@ public:
           validate_fetch_offset(model::offset, model::timeout_clock::time_point)
           = 0;
         virtual cluster::partition_probe& probe() = 0;
+        /// Leader only, true if the follower is caught up and can serve
+        /// client reads in its place
+        virtual bool is_follower_in_sync(model::node_id) const {
+            return false;
+        }
         virtual ~impl() noexcept = default;
     };
 
@@ -94,6 +109,11 @@ public:
         return _impl->make_reader(cfg, deadline);
     }
 
+    ss::future<std::optional<storage::extent_read_result>>
+    read_extent(storage::extent_read_config cfg) {
+        return _impl->read_extent(cfg);
+    }
+
     ss::future<std::optional<storage::timequery_result>>
     timequery(storage::timequery_config cfg) {
         return _impl->timequery(cfg);
@@ -113,6 +133,10 @@ public:
         return _impl->validate_fetch_offset(o, deadline);
     }
 
+    bool is_follower_in_sync(model::node_id id) const {
+        return _impl->is_follower_in_sync(id);
+    }
+
 private:
     std::unique_ptr<impl> _impl;
 };
@@ -16,6 +16,7 @@
 #include "kafka/server/connection_context.h"
 #include "kafka/server/coordinator_ntp_mapper.h"
 #include "kafka/server/group_router.h"
+#include "kafka/server/handlers/handlers.h"
 #include "kafka/server/logger.h"
 #include "kafka/server/request_context.h"
 #include "kafka/server/response.h"
@@ -45,6 +46,7 @@ namespace kafka {
 
 protocol::protocol(
   ss::smp_service_group smp,
+  ss::scheduling_group recompression_sg,
   ss::sharded<cluster::metadata_cache>& meta,
   ss::sharded<cluster::topics_frontend>& tf,
   ss::sharded<cluster::config_frontend>& cf,
@@ -64,6 +66,7 @@ protocol::protocol(
   ss::sharded<v8_engine::data_policy_table>& data_policy_table,
   std::optional<qdc_monitor::config> qdc_config) noexcept
   : _smp_group(smp)
+  , _recompression_sg(recompression_sg)
   , _topics_frontend(tf)
   , _config_frontend(cf)
   , _feature_table(ft)
@@ -92,6 +95,11 @@ protocol::protocol(
     }
     _probe.setup_metrics();
     _probe.setup_public_metrics();
+    for (int16_t key = 0; key <= max_api_key(request_types{}); ++key) {
+        if (auto handler = handler_for_key(api_key(key)); handler) {
+            _probe.setup_queue_metrics(api_key(key), (*handler)->name());
+        }
+    }
 }
 
 coordinator_ntp_mapper& protocol::coordinator_mapper() {
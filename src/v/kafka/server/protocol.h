@@ -17,6 +17,7 @@
 #include "kafka/latency_probe.h"
 #include "kafka/server/fetch_metadata_cache.hh"
 #include "kafka/server/fwd.h"
+#include "kafka/server/metadata_response_cache.h"
 #include "kafka/server/queue_depth_monitor.h"
 #include "net/server.h"
 #include "security/authorizer.h"
@@ -35,6 +36,7 @@ class protocol final : public net::server::protocol {
 public:
     protocol(
       ss::smp_service_group,
+      ss::scheduling_group,
       ss::sharded<cluster::metadata_cache>&,
       ss::sharded<cluster::topics_frontend>&,
       ss::sharded<cluster::config_frontend>&,
@@ -66,6 +68,8 @@ public:
     ss::future<> apply(net::server::resources) final;
 
     ss::smp_service_group smp_group() const { return _smp_group; }
+    // produced batches are recompressed to the topic codec in this group
+    ss::scheduling_group recompression_sg() const { return _recompression_sg; }
     cluster::topics_frontend& topics_frontend() {
         return _topics_frontend.local();
     }
@@ -135,10 +139,15 @@ public:
         return _fetch_metadata_cache;
     }
 
+    kafka::metadata_response_cache& get_metadata_response_cache() {
+        return _metadata_response_cache;
+    }
+
     latency_probe& probe() { return _probe; }
 
 private:
     ss::smp_service_group _smp_group;
+    ss::scheduling_group _recompression_sg;
     ss::sharded<cluster::topics_frontend>& _topics_frontend;
     ss::sharded<cluster::config_frontend>& _config_frontend;
     ss::sharded<cluster::feature_table>& _feature_table;
@@ -160,6 +169,7 @@ private:
     ss::sharded<v8_engine::data_policy_table>& _data_policy_table;
     std::optional<qdc_monitor> _qdc_mon;
     kafka::fetch_metadata_cache _fetch_metadata_cache;
+    kafka::metadata_response_cache _metadata_response_cache;
     security::tls::principal_mapper _mtls_principal_mapper;
 
     latency_probe _probe;
@@ -15,6 +15,7 @@
 
 #include <seastar/core/temporary_buffer.hh>
 
+#include <algorithm>
 #include <stdexcept>
 #include <vector>
 
@@ -110,23 +111,55 @@ ss::scattered_message<char> response_as_scattered(response_ptr response) {
 
     auto& buf = response->buf();
     buf.prepend(std::move(header));
+
+    // The fields of the response, and the batch headers written between the
+    // shared record payloads of fetch responses, end up in many small
+    // fragments. They are packed into a single buffer, each run of them
+    // sent as one iovec, while larger fragments are sent in place.
+    size_t packed_size = 0;
+    for (const auto& f : buf) {
+        if (f.size() < max_packed_fragment_size) {
+            packed_size += f.size();
+        }
+    }
+    ss::temporary_buffer<char> packed(packed_size);
+    size_t packed_pos = 0;
+    size_t run_start = 0;
+
     ss::scattered_message<char> msg;
-    auto in = iobuf::iterator_consumer(buf.cbegin(), buf.cend());
     int32_t chunk_no = 0;
-    in.consume(
-      buf.size_bytes(), [&msg, &chunk_no, &buf](const char* src, size_t sz) {
-          ++chunk_no;
-          vassert(
-            chunk_no <= std::numeric_limits<int16_t>::max(),
-            "Invalid construction of scattered_message. max count:{}. Usually "
-            "a bug with small append() to iobuf. {}",
-            chunk_no,
-            buf);
-          msg.append_static(src, sz);
-          return ss::stop_iteration::no;
-      });
+    auto append = [&msg, &chunk_no, &buf](const char* src, size_t sz) {
+        ++chunk_no;
+        vassert(
+          chunk_no <= std::numeric_limits<int16_t>::max(),
+          "Invalid construction of scattered_message. max count:{}. Usually "
+          "a bug with small append() to iobuf. {}",
+          chunk_no,
+          buf);
+        msg.append_static(src, sz);
+    };
+    auto flush_run = [&] {
+        if (packed_pos > run_start) {
+            append(packed.get() + run_start, packed_pos - run_start);
+            run_start = packed_pos;
+        }
+    };
+    for (const auto& f : buf) {
+        if (f.size() == 0) {
+            continue;
+        }
+        if (f.size() < max_packed_fragment_size) {
+            std::copy_n(f.get(), f.size(), packed.get_write() + packed_pos);
+            packed_pos += f.size();
+        } else {
+            flush_run();
+            append(f.get(), f.size());
+        }
+    }
+    flush_run();
     // MUST be the foreign ptr not the iobuf
-    msg.on_delete([response = std::move(response)] {});
+    msg.on_delete(
+      [response = std::move(response), packed = std::move(packed)] {});
     return msg;
 }
 
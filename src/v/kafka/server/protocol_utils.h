@@ -27,6 +27,10 @@ namespace kafka {
 // TODO: move to iobuf_parser
 ss::future<std::optional<request_header>> parse_header(ss::input_stream<char>&);
 
+/// Fragments of a response smaller than this are copied together rather than
+/// sent as iovecs of their own
+inline constexpr size_t max_packed_fragment_size = 512;
+
 ss::scattered_message<char> response_as_scattered(response_ptr response);
 
 } // namespace kafka
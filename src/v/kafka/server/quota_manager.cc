@@ -11,8 +11,12 @@
 
 #include "config/configuration.h"
 #include "kafka/server/logger.h"
+#include "ssx/future-util.h"
 #include "vlog.h"
 
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/smp.hh>
+
 #include <fmt/chrono.h>
 
 #include <chrono>
@@ -21,18 +25,42 @@ namespace kafka {
 using clock = quota_manager::clock;
 using throttle_delay = quota_manager::throttle_delay;
 
-quota_manager::~quota_manager() { _gc_timer.cancel(); }
+quota_manager::~quota_manager() {
+    _gc_timer.cancel();
+    _balancer_timer.cancel();
+}
 
 ss::future<> quota_manager::stop() {
     _gc_timer.cancel();
-    return ss::make_ready_future<>();
+    _balancer_timer.cancel();
+    return _gate.close();
 }
 
 ss::future<> quota_manager::start() {
     _gc_timer.arm_periodic(_gc_freq);
+    if (ss::this_shard_id() == balancer_shard && ss::smp::count > 1) {
+        _balancer_timer.set_callback([this] {
+            ssx::spawn_with_gate(_gate, [this] { return balance(); });
+        });
+        _balancer_timer.arm_periodic(_balancer_interval);
+    }
     return ss::make_ready_future<>();
 }
 
+std::chrono::milliseconds quota_manager::delay_for(
+  double rate, double target, clock::duration window) {
+    if (rate <= target) {
+        return std::chrono::milliseconds(0);
+    }
+    auto diff = rate - target;
+    double delay = (diff / target)
+                   * static_cast<double>(
+                     std::chrono::duration_cast<std::chrono::milliseconds>(
+                       window)
+                       .count());
+    return std::chrono::milliseconds(static_cast<uint64_t>(delay));
+}
+
 // record a new observation and return <previous delay, new delay>
 throttle_delay quota_manager::record_tp_and_throttle(
   std::optional<std::string_view> client_id,
@@ -54,6 +82,7 @@ throttle_delay quota_manager::record_tp_and_throttle(
       quota{
         now,
         clock::duration(0),
+        {static_cast<size_t>(_default_num_windows()), _default_window_width()},
         {static_cast<size_t>(_default_num_windows()),
          _default_window_width()}});
 
@@ -62,17 +91,19 @@ throttle_delay quota_manager::record_tp_and_throttle(
         it->second.last_seen = now;
     }
 
-    auto rate = it->second.tp_rate.record_and_measure(bytes, now);
-
-    std::chrono::milliseconds delay_ms(0);
-    if (rate > _target_tp_rate()) {
-        auto diff = rate - _target_tp_rate();
-        double delay = (diff / _target_tp_rate())
-                       * static_cast<double>(
-                         std::chrono::duration_cast<std::chrono::milliseconds>(
-                           it->second.tp_rate.window_size())
-                           .count());
-        delay_ms = std::chrono::milliseconds(static_cast<uint64_t>(delay));
+    auto& q = it->second;
+    auto rate = q.tp_rate.record_and_measure(bytes, now);
+    auto delay_ms = delay_for(
+      rate, _target_tp_rate() * q.share, q.tp_rate.window_size());
+
+    auto req_rate = q.req_rate.record_and_measure(1, now);
+    if (_target_request_rate()) {
+        delay_ms = std::max(
+          delay_ms,
+          delay_for(
+            req_rate,
+            *_target_request_rate() * q.share,
+            q.req_rate.window_size()));
     }
     std::chrono::milliseconds max_delay_ms(_max_delay());
     if (delay_ms > max_delay_ms) {
@@ -107,4 +138,47 @@ void quota_manager::gc(clock::duration full_window) {
       });
 }
 
+quota_manager::usage_map quota_manager::usage(clock::time_point now) {
+    usage_map usage;
+    usage.reserve(_quotas.size());
+    for (auto& [cid, q] : _quotas) {
+        usage.emplace(cid, q.tp_rate.record_and_measure(0, now));
+    }
+    return usage;
+}
+
+void quota_manager::set_shares(const usage_map& local, const usage_map& total) {
+    const auto even_share = 1.0 / static_cast<double>(ss::smp::count);
+    for (auto& [cid, q] : _quotas) {
+        auto total_it = total.find(cid);
+        if (total_it == total.end() || total_it->second <= 0) {
+            // idle on every shard, let it ramp up anywhere
+            q.share = 1.0;
+            continue;
+        }
+        auto local_it = local.find(cid);
+        auto used = local_it == local.end() ? 0. : local_it->second;
+        q.share = (1 - min_share_fraction) * (used / total_it->second)
+                  + min_share_fraction * even_share;
+    }
+}
+
+ss::future<> quota_manager::balance() {
+    const auto now = clock::now();
+    auto usages = co_await container().map(
+      [now](quota_manager& qm) { return qm.usage(now); });
+
+    usage_map total;
+    for (const auto& shard_usage : usages) {
+        for (const auto& [cid, rate] : shard_usage) {
+            total[cid] += rate;
+        }
+    }
+
+    co_await container().invoke_on_all(
+      [&usages, &total](quota_manager& qm) {
+          qm.set_shares(usages[ss::this_shard_id()], total);
+      });
+}
+
 } // namespace kafka
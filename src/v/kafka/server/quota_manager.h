@@ -15,7 +15,9 @@
 #include "seastarx.h"
 
 #include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
 #include <seastar/core/lowres_clock.hh>
+#include <seastar/core/sharded.hh>
 #include <seastar/core/sstring.hh>
 #include <seastar/core/timer.hh>
 
@@ -33,18 +35,19 @@ namespace kafka {
 //   - we will want to eventually add support for configuring the quotas and
 //   quota settings as runtime through the kafka api and other mechanisms.
 //
-//   - currently only total throughput per client_id is tracked. in the future
-//   we will want to support additional quotas and accouting granularities to be
-//   at parity with kafka. for example:
+//   - currently total throughput and request rate per client_id are tracked.
+//   in the future we will want to support additional quotas and accouting
+//   granularities to be at parity with kafka. for example:
 //
 //      - splitting out rates separately for produce and fetch
 //      - accounting per user vs per client (these are separate in kafka)
 //
-//   - it may eventually be beneficial to periodically reduce stats across
-//   shards or track stats globally to produce a more accurate per-node
-//   representation of a statistic (e.g. bandwidth).
+// the quotas are node wide. each shard enforces its share of the quotas of a
+// client, and the shares are periodically rebalanced in proportion to the
+// usage of the client on each shard so that a client spreading its
+// connections across shards doesn't get a multiple of its quota.
 //
-class quota_manager {
+class quota_manager : public ss::peering_sharded_service<quota_manager> {
 public:
     using clock = ss::lowres_clock;
 
@@ -61,7 +64,11 @@ public:
       , _target_tp_rate(config::shard_local_cfg().target_quota_byte_rate.bind())
       , _gc_freq(config::shard_local_cfg().quota_manager_gc_sec())
       , _max_delay(
-          config::shard_local_cfg().max_kafka_throttle_delay_ms.bind()) {
+          config::shard_local_cfg().max_kafka_throttle_delay_ms.bind())
+      , _target_request_rate(
+          config::shard_local_cfg().target_quota_request_rate.bind())
+      , _balancer_interval(
+          config::shard_local_cfg().quota_manager_balancer_interval_ms()) {
         _gc_timer.set_callback([this] {
             auto full_window = _default_num_windows() * _default_window_width();
             gc(full_window);
@@ -86,18 +93,42 @@ public:
       clock::time_point now = clock::now());
 
 private:
+    using usage_map = absl::flat_hash_map<ss::sstring, double>;
+
+    // the shard collecting the usage and assigning the quota shares
+    static constexpr ss::shard_id balancer_shard = 0;
+    // fraction of the quotas of a client evenly split across the shards
+    // regardless of usage, so a shard the client moves to can ramp up until
+    // the next rebalance
+    static constexpr double min_share_fraction = 0.1;
+
     // erase inactive tracked quotas. windows are considered inactive if they
     // have not received any updates in ten window's worth of time.
     void gc(clock::duration full_window);
 
+    // recompute the quota shares of the clients from their usage on each
+    // shard
+    ss::future<> balance();
+    // byte rate of each client on this shard
+    usage_map usage(clock::time_point now);
+    void set_shares(const usage_map& local, const usage_map& total);
+
+    // delay that brings the rate back to the target over the window
+    static std::chrono::milliseconds
+    delay_for(double rate, double target, clock::duration window);
+
 private:
     // last_seen: used for gc keepalive
     // delay: last calculated delay
     // tp_rate: throughput tracking
+    // req_rate: request rate tracking
+    // share: the fraction of the node wide quotas enforced by this shard
     struct quota {
         clock::time_point last_seen;
         clock::duration delay;
         rate_tracker tp_rate;
+        rate_tracker req_rate;
+        double share{1.0};
     };
 
     config::binding<int16_t> _default_num_windows;
@@ -109,6 +140,11 @@ private:
     ss::timer<> _gc_timer;
     clock::duration _gc_freq;
     config::binding<std::chrono::milliseconds> _max_delay;
+    config::binding<std::optional<uint32_t>> _target_request_rate;
+
+    ss::timer<> _balancer_timer;
+    clock::duration _balancer_interval;
+    ss::gate _gate;
 };
 
 } // namespace kafka
@@ -115,6 +115,29 @@ ss::future<storage::translating_reader> replicated_partition::make_reader(
       _translator);
 }
 
+ss::future<std::optional<storage::extent_read_result>>
+replicated_partition::read_extent(storage::extent_read_config cfg) {
+    if (_partition->is_read_replica_mode_enabled()) {
+        co_return std::nullopt;
+    }
+    auto local_kafka_start_offset = _translator->from_log_offset(
+      _partition->start_offset());
+    if (cfg.start_offset < local_kafka_start_offset) {
+        co_return std::nullopt;
+    }
+    cfg.start_offset = _translator->to_log_offset(cfg.start_offset);
+    cfg.max_offset = _translator->to_log_offset(cfg.max_offset);
+    cfg.type = model::record_batch_type::raft_data;
+
+    auto res = co_await _partition->read_extent(cfg);
+    if (res) {
+        // extent contains only data batches, the delta is constant across it
+        res->base_offset = _translator->from_log_offset(res->base_offset);
+        res->last_offset = _translator->from_log_offset(res->last_offset);
+    }
+    co_return res;
+}
+
 ss::future<std::vector<cluster::rm_stm::tx_range>>
 replicated_partition::aborted_transactions_local(
   cloud_storage::offset_range offsets,
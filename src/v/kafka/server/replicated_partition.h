@@ -107,6 +107,9 @@ public:
       storage::log_reader_config cfg,
       std::optional<model::timeout_clock::time_point>) final;
 
+    ss::future<std::optional<storage::extent_read_result>>
+      read_extent(storage::extent_read_config) final;
+
     ss::future<std::vector<cluster::rm_stm::tx_range>> aborted_transactions(
       model::offset base,
       model::offset last,
@@ -124,6 +127,12 @@ public:
     ss::future<error_code> validate_fetch_offset(
       model::offset, model::timeout_clock::time_point) final;
 
+    bool is_follower_in_sync(model::node_id id) const final {
+        auto m = _partition->raft()->get_follower_metrics(id);
+        return m && !m.value().is_learner && m.value().is_live
+               && !m.value().under_replicated;
+    }
+
 private:
     ss::future<std::vector<cluster::rm_stm::tx_range>>
       aborted_transactions_local(
@@ -22,6 +22,7 @@
 #include "kafka/server/response.h"
 #include "kafka/types.h"
 #include "seastarx.h"
+#include "utils/request_tracer.h"
 #include "vlog.h"
 
 #include <seastar/core/future.hh>
@@ -62,11 +63,13 @@ public:
       ss::lw_shared_ptr<connection_context> conn,
       request_header&& header,
       iobuf&& request,
-      ss::lowres_clock::duration throttle_delay) noexcept
+      ss::lowres_clock::duration throttle_delay,
+      trace_id trace = trace_id{}) noexcept
       : _conn(std::move(conn))
       , _header(std::move(header))
       , _reader(std::move(request))
-      , _throttle_delay(throttle_delay) {}
+      , _throttle_delay(throttle_delay)
+      , _trace(trace) {}
 
     request_context(const request_context&) = delete;
     request_context& operator=(const request_context&) = delete;
@@ -82,6 +85,10 @@ public:
 
     latency_probe& probe() { return _conn->server().probe(); }
 
+    ss::scheduling_group recompression_sg() const {
+        return _conn->server().recompression_sg();
+    }
+
     const cluster::metadata_cache& metadata_cache() const {
         return _conn->server().metadata_cache();
     }
@@ -118,6 +125,9 @@ public:
         return _conn->server().tx_gateway_frontend();
     }
 
+    /// Set if the request was sampled for tracing, see request_tracer
+    trace_id trace() const { return _trace; }
+
     int32_t throttle_delay_ms() const {
         return std::chrono::duration_cast<std::chrono::milliseconds>(
                  _throttle_delay)
@@ -144,6 +154,10 @@ public:
         return _conn->server().get_fetch_metadata_cache();
     }
 
+    metadata_response_cache& get_metadata_response_cache() {
+        return _conn->server().get_metadata_response_cache();
+    }
+
     template<typename ResponseType>
     requires requires(
       ResponseType r, response_writer& writer, api_version version) {
@@ -216,6 +230,7 @@ private:
     request_header _header;
     request_reader _reader;
     ss::lowres_clock::duration _throttle_delay;
+    trace_id _trace;
 };
 
 // Executes the API call identified by the specified request_context.
@@ -224,4 +239,8 @@ process_result_stages process_request(
 
 bool track_latency(api_key);
 
+// requests on the data path that are admitted ahead of the others when the
+// shard is low on memory
+bool is_priority_request(api_key);
+
 } // namespace kafka
@@ -9,6 +9,8 @@
 
 #include "kafka/protocol/schemata/api_versions_request.h"
 #include "kafka/protocol/schemata/fetch_request.h"
+#include "kafka/protocol/schemata/heartbeat_request.h"
+#include "kafka/protocol/schemata/offset_commit_request.h"
 #include "kafka/protocol/schemata/produce_request.h"
 #include "kafka/server/connection_context.h"
 #include "kafka/server/handlers/api_versions.h"
@@ -242,6 +244,18 @@ bool track_latency(api_key key) {
     }
 }
 
+bool is_priority_request(api_key key) {
+    switch (key) {
+    case fetch_api::key:
+    case produce_api::key:
+    case heartbeat_api::key:
+    case offset_commit_api::key:
+        return true;
+    default:
+        return false;
+    }
+}
+
 process_result_stages process_request(
   request_context&& ctx,
   ss::smp_service_group g,
@@ -14,6 +14,8 @@
 #include "kafka/protocol/errors.h"
 #include "kafka/protocol/find_coordinator.h"
 #include "kafka/protocol/join_group.h"
+#include "kafka/protocol/offset_commit.h"
+#include "kafka/protocol/offset_fetch.h"
 #include "kafka/protocol/schemata/join_group_request.h"
 #include "kafka/types.h"
 #include "model/fundamental.h"
@@ -22,11 +24,14 @@
 #include "redpanda/tests/fixture.h"
 #include "test_utils/async.h"
 
+#include <seastar/core/loop.hh>
 #include <seastar/core/smp.hh>
 #include <seastar/core/sstring.hh>
 
 #include <boost/test/tools/old/interface.hpp>
 
+#include <numeric>
+
 using namespace kafka;
 join_group_request make_join_group_request(
   ss::sstring member_id,
@@ -106,3 +111,71 @@ FIXTURE_TEST(join_empty_group_static_member, consumer_offsets_fixture) {
           });
     }).get();
 }
+
+FIXTURE_TEST(
+  concurrent_offset_commits_of_many_groups, consumer_offsets_fixture) {
+    wait_for_consumer_offsets_topic(kafka::group_instance_id("commits"));
+    model::topic_namespace tp_ns(model::kafka_namespace, model::topic("tp"));
+    add_topic(tp_ns, 4).get();
+
+    auto client = make_kafka_client().get0();
+    auto deferred = ss::defer([&client] {
+        client.stop().then([&client] { client.shutdown(); }).get();
+    });
+    client.connect().get();
+
+    // group i commits offset 100 + i for every partition, commits of groups
+    // coordinated by the same partition are batched but must complete with
+    // their own result
+    std::vector<int> groups(32);
+    std::iota(groups.begin(), groups.end(), 0);
+    auto make_commit = [&tp_ns](int i) {
+        offset_commit_request req;
+        req.data.group_id = kafka::group_id(fmt::format("group-{}", i));
+        req.data.generation_id = kafka::generation_id(-1);
+        offset_commit_request_topic topic{.name = tp_ns.tp};
+        for (int p = 0; p < 4; ++p) {
+            topic.partitions.push_back(offset_commit_request_partition{
+              .partition_index = model::partition_id(p),
+              .committed_offset = model::offset(100 + i)});
+        }
+        req.data.topics.push_back(std::move(topic));
+        return req;
+    };
+
+    tests::cooperative_spin_wait_with_timeout(30s, [&] {
+        return ss::map_reduce(
+          groups,
+          [&](int i) {
+              return client
+                .dispatch(make_commit(i), kafka::api_version(7))
+                .then([](offset_commit_response resp) {
+                    for (const auto& t : resp.data.topics) {
+                        for (const auto& p : t.partitions) {
+                            if (p.error_code != error_code::none) {
+                                return false;
+                            }
+                        }
+                    }
+                    return true;
+                });
+          },
+          true,
+          std::logical_and<>());
+    }).get();
+
+    for (auto i : groups) {
+        offset_fetch_request req;
+        req.data.group_id = kafka::group_id(fmt::format("group-{}", i));
+        req.data.topics = std::vector<offset_fetch_request_topic>{
+          {.name = tp_ns.tp, .partition_indexes = {model::partition_id(0)}}};
+        auto resp = client.dispatch(std::move(req), kafka::api_version(7))
+                      .get0();
+        BOOST_REQUIRE_EQUAL(resp.data.error_code, error_code::none);
+        BOOST_REQUIRE_EQUAL(resp.data.topics.size(), 1);
+        BOOST_REQUIRE_EQUAL(resp.data.topics[0].partitions.size(), 1);
+        BOOST_REQUIRE_EQUAL(
+          resp.data.topics[0].partitions[0].committed_offset,
+          model::offset(100 + i));
+    }
+}
@@ -221,3 +221,37 @@ FIXTURE_TEST(test_session_operations, fixture) {
         BOOST_REQUIRE(cache.size() == 0);
     }
 }
+
+FIXTURE_TEST(test_session_idle_partitions, fixture) {
+    kafka::fetch_session_cache cache(120s);
+    kafka::fetch_request req;
+    req.data.session_epoch = kafka::initial_fetch_session_epoch;
+    req.data.session_id = kafka::invalid_fetch_session_id;
+    req.data.topics = {make_fetch_request_topic(model::topic("test"), 2)};
+
+    auto ctx = cache.maybe_get_session(req);
+    auto session = ctx.session();
+    BOOST_REQUIRE(session);
+    auto& partitions = session->partitions();
+    auto p0 = model::topic_partition_view(
+      req.data.topics[0].name, model::partition_id(0));
+    auto p1 = model::topic_partition_view(
+      req.data.topics[0].name, model::partition_id(1));
+    partitions.find(p0)->second->partition.idle = true;
+    partitions.find(p1)->second->partition.idle = true;
+
+    BOOST_TEST_MESSAGE("notified partitions are no longer idle");
+    cache.mark_partition_changed(session->id(), p0);
+    BOOST_REQUIRE(!partitions.find(p0)->second->partition.idle);
+    BOOST_REQUIRE(partitions.find(p1)->second->partition.idle);
+
+    BOOST_TEST_MESSAGE("partitions fetched from a new offset are not idle");
+    req.data.session_id = session->id();
+    req.data.session_epoch = session->epoch();
+    auto& fetch_partitions = req.data.topics[0].fetch_partitions;
+    fetch_partitions.erase(fetch_partitions.begin());
+    fetch_partitions[0].fetch_offset = model::offset(100);
+    ctx = cache.maybe_get_session(req);
+    BOOST_REQUIRE_EQUAL(ctx.is_full_fetch(), false);
+    BOOST_REQUIRE(!partitions.find(p1)->second->partition.idle);
+}
@@ -11,10 +11,13 @@
 #include "kafka/server/handlers/fetch.h"
 #include "kafka/types.h"
 #include "model/fundamental.h"
+#include "model/tests/random_batch.h"
 #include "redpanda/tests/fixture.h"
 #include "resource_mgmt/io_priority.h"
+#include "storage/segment_appender_utils.h"
 #include "test_utils/async.h"
 
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/core/smp.hh>
 
 #include <fmt/ostream.h>
@@ -24,6 +27,39 @@
 
 using namespace std::chrono_literals;
 
+SEASTAR_THREAD_TEST_CASE(extent_to_kafka_wire_matches_serializer) {
+    const model::term_id term(7);
+    // simulate a log to kafka offset delta of 3
+    const model::offset delta(3);
+    auto batches = model::test::make_random_batches(
+      model::offset(10), 10, true);
+
+    storage::extent_read_result extent{.term = term};
+    kafka::kafka_batch_serializer serializer;
+    for (auto& b : batches) {
+        if (extent.headers.empty()) {
+            extent.base_offset = b.base_offset() - delta;
+        }
+        extent.last_offset = b.last_offset() - delta;
+        extent.data.append(storage::disk_header_to_iobuf(b.header()));
+        extent.data.append(b.data().copy());
+        extent.record_count += b.record_count();
+        extent.headers.push_back(b.header());
+
+        auto hdr = b.header();
+        hdr.base_offset = b.base_offset() - delta;
+        hdr.ctx.term = term;
+        serializer(model::record_batch(
+                     hdr, b.data().copy(), model::record_batch::tag_ctor_ng{}))
+          .get();
+    }
+
+    auto expected = serializer.end_of_stream();
+    auto wire = kafka::extent_to_kafka_wire(std::move(extent));
+    BOOST_REQUIRE_EQUAL(wire.size_bytes(), expected.data.size_bytes());
+    BOOST_REQUIRE(wire == expected.data);
+}
+
 SEASTAR_THREAD_TEST_CASE(partition_iterator) {
     /*
      * extract topic partitions from the request
@@ -277,6 +313,70 @@ FIXTURE_TEST(fetch_one, redpanda_thread_fixture) {
     }
 }
 
+FIXTURE_TEST(fetch_one_with_client_rack, redpanda_thread_fixture) {
+    wait_for_controller_leadership().get0();
+    config::shard_local_cfg().get("enable_follower_fetching").set_value(true);
+
+    model::topic topic("foo");
+    model::partition_id pid(0);
+    auto ntp = make_default_ntp(topic, pid);
+    auto log_config = make_default_config();
+    {
+        using namespace storage;
+        storage::disk_log_builder builder(log_config);
+        storage::ntp_config ntp_cfg(
+          ntp,
+          log_config.base_dir,
+          nullptr,
+          get_next_partition_revision_id().get());
+        builder | start(std::move(ntp_cfg)) | add_segment(model::offset(0))
+          | add_random_batch(model::offset(0), 10, maybe_compress_batches::yes)
+          | stop();
+    }
+
+    add_topic(model::topic_namespace_view(ntp)).get();
+    auto shard = app.shard_table.local().shard_for(ntp);
+
+    tests::cooperative_spin_wait_with_timeout(10s, [this, shard, ntp] {
+        return app.partition_manager.invoke_on(
+          *shard, [ntp](cluster::partition_manager& mgr) {
+              auto partition = mgr.get(ntp);
+              return partition
+                     && partition->committed_offset() >= model::offset(1);
+          });
+    }).get();
+
+    kafka::fetch_request req;
+    req.data.max_bytes = std::numeric_limits<int32_t>::max();
+    req.data.min_bytes = 1;
+    req.data.max_wait_ms = std::chrono::milliseconds(0);
+    req.data.session_id = kafka::invalid_fetch_session_id;
+    req.data.session_epoch = kafka::final_fetch_session_epoch;
+    req.data.rack_id = "rack-b";
+    req.data.topics = {{
+      .name = topic,
+      .fetch_partitions = {{
+        .partition_index = pid,
+        .fetch_offset = model::offset(0),
+      }},
+    }};
+
+    auto client = make_kafka_client().get0();
+    client.connect().get();
+    auto resp = client.dispatch(req, kafka::api_version(11)).get0();
+    client.stop().then([&client] { client.shutdown(); }).get();
+    config::shard_local_cfg().get("enable_follower_fetching").set_value(false);
+
+    // the only replica is the leader, it serves the fetch itself
+    BOOST_REQUIRE(resp.data.topics.size() == 1);
+    BOOST_REQUIRE(resp.data.topics[0].partitions.size() == 1);
+    const auto& p = resp.data.topics[0].partitions[0];
+    BOOST_REQUIRE(p.error_code == kafka::error_code::none);
+    BOOST_REQUIRE_EQUAL(p.preferred_read_replica, -1);
+    BOOST_REQUIRE(p.records);
+    BOOST_REQUIRE(p.records->size_bytes() > 0);
+}
+
 FIXTURE_TEST(fetch_response_iterator_test, redpanda_thread_fixture) {
     static auto make_partition = [](ss::sstring topic) {
         return kafka::fetch_response::partition{
@@ -501,6 +601,73 @@ FIXTURE_TEST(fetch_one_debounce, redpanda_thread_fixture) {
     BOOST_REQUIRE(resp.data.topics[0].partitions[0].records->size_bytes() > 0);
 }
 
+FIXTURE_TEST(fetch_one_wakes_on_data, redpanda_thread_fixture) {
+    model::topic topic("foo");
+    model::partition_id pid(0);
+    auto ntp = make_default_ntp(topic, pid);
+
+    wait_for_controller_leadership().get0();
+
+    add_topic(model::topic_namespace_view(ntp)).get();
+    wait_for_partition_offset(ntp, model::offset(0)).get0();
+
+    // a read retried after the debounce timeout would not make it before the
+    // request deadline
+    ss::smp::invoke_on_all([] {
+        config::shard_local_cfg()
+          .get("fetch_reads_debounce_timeout")
+          .set_value(std::chrono::milliseconds(60000));
+    }).get();
+
+    kafka::fetch_request req;
+    req.data.max_bytes = std::numeric_limits<int32_t>::max();
+    req.data.min_bytes = 1;
+    req.data.max_wait_ms = std::chrono::milliseconds(30000);
+    req.data.session_id = kafka::invalid_fetch_session_id;
+    req.data.topics = {{
+      .name = topic,
+      .fetch_partitions = {{
+        .partition_index = pid,
+        .fetch_offset = model::offset(0),
+      }},
+    }};
+
+    auto client = make_kafka_client().get0();
+    client.connect().get();
+    auto start = ss::lowres_clock::now();
+    auto fresp = client.dispatch(req, kafka::api_version(4));
+    auto shard = app.shard_table.local().shard_for(ntp);
+    app.partition_manager
+      .invoke_on(
+        *shard,
+        [ntp](cluster::partition_manager& mgr) {
+            auto partition = mgr.get(ntp);
+            auto batches = model::test::make_random_batches(
+              model::offset(0), 5);
+            auto rdr = model::make_memory_record_batch_reader(
+              std::move(batches));
+            return partition->raft()->replicate(
+              std::move(rdr),
+              raft::replicate_options(raft::consistency_level::quorum_ack));
+        })
+      .discard_result()
+      .get0();
+
+    auto resp = fresp.get0();
+    auto elapsed = ss::lowres_clock::now() - start;
+    client.stop().then([&client] { client.shutdown(); }).get();
+    ss::smp::invoke_on_all([] {
+        config::shard_local_cfg().get("fetch_reads_debounce_timeout").reset();
+    }).get();
+
+    BOOST_REQUIRE_LT(elapsed, std::chrono::milliseconds(30000));
+    BOOST_REQUIRE(resp.data.topics.size() == 1);
+    BOOST_REQUIRE(
+      resp.data.topics[0].partitions[0].error_code == kafka::error_code::none);
+    BOOST_REQUIRE(resp.data.topics[0].partitions[0].records);
+    BOOST_REQUIRE(resp.data.topics[0].partitions[0].records->size_bytes() > 0);
+}
+
 FIXTURE_TEST(fetch_multi_topics, redpanda_thread_fixture) {
     // create a topic partition with some data
     model::topic topic_1("foo");
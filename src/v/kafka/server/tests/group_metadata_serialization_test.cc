@@ -11,6 +11,7 @@
 #include "kafka/protocol/request_reader.h"
 #include "kafka/protocol/response_writer.h"
 #include "kafka/server/group_metadata.h"
+#include "kafka/server/group_metadata_snapshot.h"
 #include "kafka/server/protocol.h"
 #include "kafka/types.h"
 #include "model/adl_serde.h"
@@ -433,3 +434,76 @@ FIXTURE_TEST(test_unwrapping_tombstones_from_iobuf, fixture) {
         BOOST_REQUIRE_EQUAL(offset_key, iobuf_offset_md_kv.key);
     }
 }
+
+FIXTURE_TEST(test_group_metadata_snapshot_state_roundtrip, fixture) {
+    kafka::group_recovery_consumer_state state;
+
+    // group with members and committed offsets
+    auto& active = state.groups[kafka::group_id("active")];
+    kafka::group_metadata_value group_md;
+    group_md.protocol_type = random_named_string<kafka::protocol_type>();
+    group_md.generation = random_named_int<kafka::generation_id>();
+    group_md.protocol = random_optional<kafka::protocol_name>();
+    group_md.leader = random_optional<kafka::member_id>();
+    group_md.state_timestamp = model::timestamp::now();
+    for ([[maybe_unused]] auto i : boost::irange(0, 3)) {
+        group_md.members.push_back(random_member_state());
+    }
+    active.overwrite_metadata(group_md.copy());
+    for (auto p : boost::irange(0, 5)) {
+        kafka::offset_metadata_value offset_md;
+        offset_md.offset = random_named_int<model::offset>();
+        offset_md.leader_epoch = random_named_int<kafka::leader_epoch>();
+        offset_md.metadata = random_named_string<ss::sstring>();
+        offset_md.commit_timestamp = model::timestamp::now();
+        active.update_offset(
+          model::topic_partition(model::topic("t"), model::partition_id(p)),
+          model::offset(p * 10),
+          std::move(offset_md));
+    }
+    active.try_set_fence(model::producer_id(7), model::producer_epoch(3));
+
+    // group only known through an ongoing transaction
+    auto& tx_only = state.groups[kafka::group_id("tx")];
+    kafka::group::prepared_tx tx{
+      .pid = model::producer_identity(11, 2), .tx_seq = model::tx_seq(5)};
+    model::topic_partition tx_tp(model::topic("t"), model::partition_id(1));
+    tx.offsets[tx_tp] = kafka::group::offset_metadata{
+      .log_offset = model::offset(100),
+      .offset = model::offset(42),
+      .metadata = "tx-metadata",
+      .committed_leader_epoch = kafka::leader_epoch(4)};
+    tx_only.restore_prepared(std::move(tx));
+
+    auto decoded = kafka::decode_group_metadata_snapshot_state(
+      kafka::encode_group_metadata_snapshot_state(state));
+
+    BOOST_REQUIRE_EQUAL(decoded.groups.size(), 2);
+
+    auto& d_active = decoded.groups[kafka::group_id("active")];
+    BOOST_REQUIRE(d_active.has_data());
+    BOOST_REQUIRE_EQUAL(d_active.get_metadata(), group_md);
+    BOOST_REQUIRE_EQUAL(d_active.offsets().size(), 5);
+    for (const auto& [tp, md] : active.offsets()) {
+        auto it = d_active.offsets().find(tp);
+        BOOST_REQUIRE(it != d_active.offsets().end());
+        BOOST_REQUIRE_EQUAL(it->second.log_offset, md.log_offset);
+        BOOST_REQUIRE_EQUAL(it->second.metadata, md.metadata);
+    }
+    BOOST_REQUIRE_EQUAL(d_active.fences().size(), 1);
+    BOOST_REQUIRE_EQUAL(
+      d_active.fences().at(model::producer_id(7)), model::producer_epoch(3));
+
+    auto& d_tx = decoded.groups[kafka::group_id("tx")];
+    BOOST_REQUIRE(!d_tx.is_loaded());
+    BOOST_REQUIRE_EQUAL(d_tx.prepared_txs().size(), 1);
+    const auto& d_prepared = d_tx.prepared_txs().at(model::producer_id(11));
+    BOOST_REQUIRE_EQUAL(d_prepared.pid, model::producer_identity(11, 2));
+    BOOST_REQUIRE_EQUAL(d_prepared.tx_seq, model::tx_seq(5));
+    BOOST_REQUIRE_EQUAL(d_prepared.offsets.size(), 1);
+    const auto& d_tx_md = d_prepared.offsets.begin()->second;
+    BOOST_REQUIRE_EQUAL(d_tx_md.log_offset, model::offset(100));
+    BOOST_REQUIRE_EQUAL(d_tx_md.offset, model::offset(42));
+    BOOST_REQUIRE_EQUAL(d_tx_md.metadata, "tx-metadata");
+    BOOST_REQUIRE_EQUAL(d_tx_md.committed_leader_epoch, kafka::leader_epoch(4));
+}
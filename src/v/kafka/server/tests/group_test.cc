@@ -472,6 +472,47 @@ SEASTAR_THREAD_TEST_CASE(generate_member_id) {
     BOOST_TEST(is_uuid(uuid));
 }
 
+SEASTAR_THREAD_TEST_CASE(offset_fetch_all_partitions) {
+    auto g = get();
+    auto fetch_all = [&g] {
+        offset_fetch_request req;
+        req.data.topics = std::nullopt;
+        return g.handle_offset_fetch(std::move(req)).get().data.topics;
+    };
+    auto offset_of = [](
+                       const std::vector<offset_fetch_response_topic>& topics,
+                       const model::topic_partition& tp) {
+        for (const auto& t : topics) {
+            for (const auto& p : t.partitions) {
+                if (t.name == tp.topic && p.partition_index == tp.partition) {
+                    return p.committed_offset;
+                }
+            }
+        }
+        return model::offset{};
+    };
+
+    model::topic_partition tp0(model::topic("t"), model::partition_id(0));
+    model::topic_partition tp1(model::topic("t"), model::partition_id(1));
+    g.insert_offset(
+      tp0, {.log_offset = model::offset(1), .offset = model::offset(10)});
+    g.insert_offset(
+      tp1, {.log_offset = model::offset(2), .offset = model::offset(20)});
+
+    auto topics = fetch_all();
+    BOOST_REQUIRE_EQUAL(topics.size(), 1);
+    BOOST_REQUIRE_EQUAL(topics[0].partitions.size(), 2);
+    BOOST_REQUIRE_EQUAL(offset_of(topics, tp0), model::offset(10));
+    BOOST_REQUIRE_EQUAL(offset_of(topics, tp1), model::offset(20));
+
+    // a commit is visible to the next fetch
+    g.insert_offset(
+      tp0, {.log_offset = model::offset(3), .offset = model::offset(11)});
+    topics = fetch_all();
+    BOOST_REQUIRE_EQUAL(offset_of(topics, tp0), model::offset(11));
+    BOOST_REQUIRE_EQUAL(offset_of(topics, tp1), model::offset(20));
+}
+
 SEASTAR_THREAD_TEST_CASE(group_output) {
     auto g = get();
     auto s = fmt::format("{}", g);
@@ -245,3 +245,57 @@ FIXTURE_TEST(list_offsets_by_time, redpanda_thread_fixture) {
 
     client.stop().then([&client] { client.shutdown(); }).get();
 }
+
+FIXTURE_TEST(list_offsets_many_partitions, redpanda_thread_fixture) {
+    wait_for_controller_leadership().get();
+    model::topic topic("many_partitions");
+    add_topic(model::topic_namespace(model::kafka_namespace, topic), 6).get();
+
+    auto client = make_kafka_client().get();
+    client.connect().get();
+
+    // partitions out of order, with an unknown and a duplicated one, the
+    // response has to follow the request order whatever shard owns them
+    std::vector<int> indices{5, 0, 3, 7, 1, 4, 2, 1};
+    kafka::list_offsets_request req;
+    req.data.topics.push_back({.name = topic});
+    for (auto i : indices) {
+        req.data.topics[0].partitions.push_back({
+          .partition_index = model::partition_id(i),
+          .timestamp = kafka::list_offsets_request::latest_timestamp,
+        });
+    }
+
+    kafka::list_offsets_response resp;
+    tests::cooperative_spin_wait_with_timeout(10s, [&client, &req, &resp] {
+        return client.dispatch(req, kafka::api_version(4))
+          .then([&resp](kafka::list_offsets_response r) {
+              resp = std::move(r);
+              const auto& parts = resp.data.topics[0].partitions;
+              return std::none_of(
+                parts.begin(), parts.end(), [](const auto& p) {
+                    return p.error_code
+                           == kafka::error_code::not_leader_for_partition;
+                });
+          });
+    }).get();
+    client.stop().then([&client] { client.shutdown(); }).get();
+
+    BOOST_REQUIRE_EQUAL(resp.data.topics.size(), 1);
+    const auto& parts = resp.data.topics[0].partitions;
+    BOOST_REQUIRE_EQUAL(parts.size(), indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        BOOST_CHECK_EQUAL(
+          parts[i].partition_index, model::partition_id(indices[i]));
+        auto expected = kafka::error_code::none;
+        if (indices[i] == 7) {
+            expected = kafka::error_code::unknown_topic_or_partition;
+        } else if (indices[i] == 1) {
+            expected = kafka::error_code::invalid_request;
+        }
+        BOOST_CHECK_EQUAL(parts[i].error_code, expected);
+        if (expected == kafka::error_code::none) {
+            BOOST_CHECK_EQUAL(parts[i].offset, model::offset(0));
+        }
+    }
+}
@@ -11,9 +11,11 @@
 #include "kafka/protocol/response_writer.h"
 #include "kafka/server/group_manager.h"
 #include "kafka/server/member.h"
+#include "kafka/server/member_expiry_wheel.h"
 #include "kafka/types.h"
 #include "utils/to_string.h"
 
+#include <seastar/core/sleep.hh>
 #include <seastar/core/sstring.hh>
 #include <seastar/testing/thread_test_case.hh>
 
@@ -313,4 +315,38 @@ SEASTAR_THREAD_TEST_CASE(group_log_group_metadata_compat2) {
     // BOOST_REQUIRE(new_out.members[1].client_host == "c3");
 }
 
+SEASTAR_THREAD_TEST_CASE(member_expiry_wheel_expires_latest_deadline) {
+    auto m0 = ss::make_lw_shared<group_member>(get_member());
+    auto m1 = ss::make_lw_shared<group_member>(get_member());
+    auto m2 = ss::make_lw_shared<group_member>(get_member());
+
+    std::vector<member_ptr> expired;
+    member_expiry_wheel wheel(
+      [&expired](member_ptr m, group_member::clock_type::time_point) {
+          expired.push_back(std::move(m));
+      });
+
+    auto now = group_member::clock_type::now();
+    wheel.schedule(m0, now + std::chrono::milliseconds(10));
+    wheel.schedule(m1, now + std::chrono::milliseconds(10));
+    wheel.schedule(m2, now + std::chrono::milliseconds(10));
+
+    // rescheduled and cancelled members leave stale entries behind
+    wheel.schedule(m1, now + std::chrono::seconds(60));
+    wheel.cancel(*m2);
+    BOOST_REQUIRE_EQUAL(wheel.size(), 4);
+
+    ss::sleep(member_expiry_wheel::tick * 3).get();
+    BOOST_REQUIRE_EQUAL(expired.size(), 1);
+    BOOST_REQUIRE(expired[0] == m0);
+    BOOST_REQUIRE(!m0->expire_deadline());
+    BOOST_REQUIRE(m1->expire_deadline());
+    BOOST_REQUIRE(!m2->expire_deadline());
+    BOOST_REQUIRE_EQUAL(wheel.size(), 1);
+
+    wheel.clear();
+    BOOST_REQUIRE(!m1->expire_deadline());
+    BOOST_REQUIRE_EQUAL(wheel.size(), 0);
+}
+
 } // namespace kafka
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#include "kafka/protocol/metadata.h"
+#include "kafka/protocol/response_writer.h"
+#include "kafka/server/metadata_response_cache.h"
+#include "model/namespace.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+namespace {
+
+kafka::metadata_response make_response() {
+    kafka::metadata_response r;
+    r.data.throttle_time_ms = std::chrono::milliseconds(10);
+    r.data.brokers.push_back(kafka::metadata_response::broker{
+      .node_id = model::node_id(1), .host = "localhost", .port = 9092});
+    r.data.brokers.push_back(kafka::metadata_response::broker{
+      .node_id = model::node_id(2),
+      .host = "otherhost",
+      .port = 9093,
+      .rack = "rack-a"});
+    r.data.cluster_id = "redpanda.test";
+    r.data.controller_id = model::node_id(2);
+    for (int t = 0; t < 3; ++t) {
+        kafka::metadata_response::topic topic;
+        topic.name = model::topic(fmt::format("topic-{}", t));
+        topic.is_internal = t == 1;
+        for (int p = 0; p < 4; ++p) {
+            kafka::metadata_response::partition partition;
+            partition.partition_index = model::partition_id(p);
+            partition.leader_id = model::node_id(p % 2 + 1);
+            partition.leader_epoch = kafka::leader_epoch(p + 10);
+            partition.replica_nodes = {model::node_id(1), model::node_id(2)};
+            partition.isr_nodes = partition.replica_nodes;
+            topic.partitions.push_back(std::move(partition));
+        }
+        r.data.topics.push_back(std::move(topic));
+    }
+    return r;
+}
+
+iobuf encode(kafka::metadata_response& r, kafka::api_version version) {
+    iobuf buf;
+    kafka::response_writer writer(buf);
+    r.encode(writer, version);
+    return buf;
+}
+
+} // namespace
+
+SEASTAR_THREAD_TEST_CASE(test_encoded_topics_match_generated_encoding) {
+    constexpr auto max_version
+      = kafka::metadata_response::max_encoded_topics_version();
+    for (int16_t v = 0; v <= max_version; ++v) {
+        kafka::api_version version(v);
+        auto expected_r = make_response();
+        auto expected = encode(expected_r, version);
+
+        auto r = make_response();
+        std::vector<iobuf> encoded_topics;
+        for (auto& t : r.data.topics) {
+            iobuf buf;
+            kafka::response_writer writer(buf);
+            kafka::metadata_response::encode_topic(writer, t, version);
+            encoded_topics.push_back(std::move(buf));
+        }
+        r.data.topics.clear();
+        r.encoded_topics = std::move(encoded_topics);
+
+        BOOST_REQUIRE_EQUAL(encode(r, version), expected);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_metadata_response_cache_validation) {
+    kafka::metadata_response_cache cache;
+    model::topic_namespace tp_ns(model::kafka_namespace, model::topic("tp"));
+    kafka::metadata_response_cache::key key{
+      .topics_version = 5,
+      .leadership_version = 1,
+      .version = kafka::api_version(7)};
+
+    BOOST_REQUIRE(!cache.get(tp_ns, key));
+
+    iobuf encoded;
+    encoded.append("encoded", 7);
+    cache.put(tp_ns, key, encoded);
+
+    auto cached = cache.get(tp_ns, key);
+    BOOST_REQUIRE(cached);
+    BOOST_REQUIRE_EQUAL(*cached, encoded);
+
+    // other request versions are cached independently
+    auto v1_key = key;
+    v1_key.version = kafka::api_version(1);
+    BOOST_REQUIRE(!cache.get(tp_ns, v1_key));
+
+    // leadership change makes the entry stale
+    auto new_leadership = key;
+    new_leadership.leadership_version = 2;
+    BOOST_REQUIRE(!cache.get(tp_ns, new_leadership));
+    BOOST_REQUIRE_EQUAL(cache.size(), 0);
+
+    // so does any topic table update
+    cache.put(tp_ns, key, encoded);
+    auto new_topics = key;
+    new_topics.topics_version = 6;
+    BOOST_REQUIRE(!cache.get(tp_ns, new_topics));
+    BOOST_REQUIRE(!cache.get(tp_ns, key));
+}
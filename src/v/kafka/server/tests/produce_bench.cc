@@ -0,0 +1,245 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/partition.h"
+#include "kafka/client/transport.h"
+#include "kafka/protocol/produce.h"
+#include "model/record_utils.h"
+#include "random/generators.h"
+#include "redpanda/tests/fixture.h"
+#include "storage/record_batch_builder.h"
+#include "test_utils/async.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/testing/perf_tests.hh>
+
+using namespace std::chrono_literals;
+
+/**
+ * End to end benchmarks of the produce path.
+ *
+ * Every parameter set is measured at four stages of the path, the difference
+ * between two adjacent stages is the cost of the layer in between:
+ *
+ *   kafka     - produce request through a kafka client connection, i.e.
+ *               request decoding, kafka_batch_adapter, replicated_partition
+ *               and everything below
+ *   partition - cluster::partition::replicate_in_stages, i.e. rm_stm for
+ *               idempotent batches and the raft replicate batcher
+ *   raft      - raft::consensus::replicate, bypassing rm_stm
+ *   storage   - appending to a log that is not managed by raft, i.e. the
+ *               segment appender
+ *
+ * Each iteration produces a single batch, the fixture starts a single node
+ * cluster with one partition.
+ */
+struct produce_bench_params {
+    int records_per_batch;
+    size_t record_size;
+    model::compression compression;
+    // -1 waits for the batch to be flushed, 1 for the leader append
+    int16_t acks;
+    bool idempotent;
+};
+
+class produce_bench_fixture : public redpanda_thread_fixture {
+public:
+    produce_bench_fixture() {
+        wait_for_controller_leadership().get();
+        add_topic(model::topic_namespace_view(ntp)).get();
+        tests::cooperative_spin_wait_with_timeout(10s, [this] {
+            auto p = app.partition_manager.local().get(ntp);
+            return p && p->is_leader();
+        }).get();
+        partition = app.partition_manager.local().get(ntp);
+
+        client = std::make_unique<kafka::client::transport>(
+          make_kafka_client().get0());
+        client->connect().get();
+
+        auto& log_mgr = app.storage.local().log_mgr();
+        storage_log = log_mgr
+                        .manage(storage::ntp_config(
+                          storage_ntp, log_mgr.config().base_dir))
+                        .get0();
+    }
+
+    produce_bench_fixture(const produce_bench_fixture&) = delete;
+    produce_bench_fixture& operator=(const produce_bench_fixture&) = delete;
+    produce_bench_fixture(produce_bench_fixture&&) = delete;
+    produce_bench_fixture& operator=(produce_bench_fixture&&) = delete;
+
+    ~produce_bench_fixture() { client->stop().get(); }
+
+    ss::future<size_t> kafka_produce(produce_bench_params p) {
+        kafka::produce_request::partition part;
+        part.partition_index = ntp.tp.partition;
+        part.records.emplace(make_batch(p, &kafka_pid));
+        kafka::produce_request::topic tp;
+        tp.name = ntp.tp.topic;
+        tp.partitions.push_back(std::move(part));
+        std::vector<kafka::produce_request::topic> topics;
+        topics.push_back(std::move(tp));
+        kafka::produce_request req(std::nullopt, p.acks, std::move(topics));
+        req.data.timeout_ms = 10s;
+        req.has_idempotent = p.idempotent;
+        req.has_transactional = false;
+
+        perf_tests::start_measuring_time();
+        auto resp = co_await client->dispatch(std::move(req));
+        perf_tests::stop_measuring_time();
+
+        const auto& r = resp.data.responses.front().partitions.front();
+        vassert(
+          r.error_code == kafka::error_code::none,
+          "produce failed: {}",
+          r.error_code);
+        co_return 1;
+    }
+
+    ss::future<size_t> partition_replicate(produce_bench_params p) {
+        auto batch = make_batch(p, &partition_pid);
+        auto bid = model::batch_identity::from(batch.header());
+        auto rdr = model::make_memory_record_batch_reader(std::move(batch));
+
+        perf_tests::start_measuring_time();
+        auto stages = partition->replicate_in_stages(
+          bid, std::move(rdr), raft::replicate_options(consistency(p)));
+        co_await std::move(stages.request_enqueued);
+        auto r = co_await std::move(stages.replicate_finished);
+        perf_tests::stop_measuring_time();
+
+        vassert(r.has_value(), "replicate failed: {}", r.error().message());
+        co_return 1;
+    }
+
+    ss::future<size_t> raft_replicate(produce_bench_params p) {
+        auto rdr = model::make_memory_record_batch_reader(
+          make_batch(p, nullptr));
+
+        perf_tests::start_measuring_time();
+        auto r = co_await partition->raft()->replicate(
+          std::move(rdr), raft::replicate_options(consistency(p)));
+        perf_tests::stop_measuring_time();
+
+        vassert(r.has_value(), "replicate failed: {}", r.error().message());
+        co_return 1;
+    }
+
+    ss::future<size_t> storage_append(produce_bench_params p) {
+        auto batch = make_batch(p, nullptr);
+        batch.header().base_offset = storage_log->offsets().dirty_offset
+                                     + model::offset(1);
+        auto rdr = model::make_memory_record_batch_reader(std::move(batch));
+        const auto fsync = p.acks == -1 ? storage::log_append_config::fsync::yes
+                                        : storage::log_append_config::fsync::no;
+
+        perf_tests::start_measuring_time();
+        co_await std::move(rdr).for_each_ref(
+          storage_log->make_appender(storage::log_append_config{
+            .should_fsync = fsync,
+            .io_priority = ss::default_priority_class(),
+            .timeout = model::no_timeout}),
+          model::no_timeout);
+        if (fsync) {
+            co_await storage_log->flush();
+        }
+        perf_tests::stop_measuring_time();
+        co_return 1;
+    }
+
+private:
+    struct producer {
+        model::producer_identity pid;
+        int32_t next_seq{0};
+    };
+
+    static raft::consistency_level consistency(const produce_bench_params& p) {
+        return p.acks == -1 ? raft::consistency_level::quorum_ack
+                            : raft::consistency_level::leader_ack;
+    }
+
+    // batches are idempotent when the params ask for it and a producer is
+    // given, the producer sequence is advanced by the record count
+    model::record_batch
+    make_batch(const produce_bench_params& p, producer* prod) {
+        storage::record_batch_builder builder(
+          model::record_batch_type::raft_data, model::offset(0));
+        builder.set_compression(p.compression);
+        if (p.idempotent && prod) {
+            builder.set_producer_identity(prod->pid.id, prod->pid.epoch);
+        }
+        for (int i = 0; i < p.records_per_batch; ++i) {
+            builder.add_raw_kv(
+              std::nullopt,
+              bytes_to_iobuf(random_generators::get_bytes(p.record_size)));
+        }
+        auto batch = std::move(builder).build();
+        if (p.idempotent && prod) {
+            batch.header().base_sequence = prod->next_seq;
+            prod->next_seq += p.records_per_batch;
+            batch.header().crc = model::crc_record_batch(batch);
+            batch.header().header_crc = model::internal_header_only_crc(
+              batch.header());
+        }
+        return batch;
+    }
+
+public:
+    const model::ntp ntp{
+      model::kafka_namespace, model::topic("bench"), model::partition_id(0)};
+    const model::ntp storage_ntp{
+      model::ns("bench"), model::topic("storage"), model::partition_id(0)};
+    ss::lw_shared_ptr<cluster::partition> partition;
+    std::unique_ptr<kafka::client::transport> client;
+    std::optional<storage::log> storage_log;
+    producer kafka_pid{.pid = model::producer_identity{1000, 0}};
+    producer partition_pid{.pid = model::producer_identity{1001, 0}};
+};
+
+// defines the benchmark of every stage of the produce path for a parameter set
+#define PRODUCE_BENCH(name, ...)                                               \
+    PERF_TEST_F(produce_bench_fixture, kafka_##name) {                         \
+        return kafka_produce(produce_bench_params{__VA_ARGS__});               \
+    }                                                                          \
+    PERF_TEST_F(produce_bench_fixture, partition_##name) {                     \
+        return partition_replicate(produce_bench_params{__VA_ARGS__});         \
+    }                                                                          \
+    PERF_TEST_F(produce_bench_fixture, raft_##name) {                          \
+        return raft_replicate(produce_bench_params{__VA_ARGS__});              \
+    }                                                                          \
+    PERF_TEST_F(produce_bench_fixture, storage_##name) {                       \
+        return storage_append(produce_bench_params{__VA_ARGS__});              \
+    }
+
+// small records, the per request overhead dominates
+PRODUCE_BENCH(1x100b_none_acks_all, 1, 100, model::compression::none, -1, false)
+PRODUCE_BENCH(1x100b_none_acks_1, 1, 100, model::compression::none, 1, false)
+PRODUCE_BENCH(
+  1x100b_none_acks_all_idempotent, 1, 100, model::compression::none, -1, true)
+
+// typical client side batches
+PRODUCE_BENCH(100x1k_none_acks_all, 100, 1024, model::compression::none, -1, false)
+PRODUCE_BENCH(100x1k_none_acks_1, 100, 1024, model::compression::none, 1, false)
+PRODUCE_BENCH(100x1k_lz4_acks_all, 100, 1024, model::compression::lz4, -1, false)
+PRODUCE_BENCH(
+  100x1k_zstd_acks_all, 100, 1024, model::compression::zstd, -1, false)
+PRODUCE_BENCH(
+  100x1k_none_acks_all_idempotent,
+  100,
+  1024,
+  model::compression::none,
+  -1,
+  true)
+PRODUCE_BENCH(
+  100x1k_lz4_acks_all_idempotent, 100, 1024, model::compression::lz4, -1, true)
+
+// large batches, bandwidth bound
+PRODUCE_BENCH(16x64k_none_acks_all, 16, 64_KiB, model::compression::none, -1, false)
+PRODUCE_BENCH(16x64k_lz4_acks_all, 16, 64_KiB, model::compression::lz4, -1, false)
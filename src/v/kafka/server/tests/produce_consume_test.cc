@@ -178,3 +178,59 @@ FIXTURE_TEST(test_version_handler, prod_consume_fixture) {
         .get(),
       kafka::client::kafka_request_disconnected_exception);
 }
+
+FIXTURE_TEST(test_produce_recompressed_to_topic_codec, prod_consume_fixture) {
+    wait_for_controller_leadership().get0();
+    const model::topic topic("lz4-topic");
+    model::topic_namespace tp_ns(model::kafka_namespace, topic);
+    std::vector<cluster::topic_configuration> cfgs{
+      cluster::topic_configuration(tp_ns.ns, tp_ns.tp, 1, 1)};
+    cfgs[0].properties.compression = model::compression::lz4;
+    app.controller->get_topics_frontend()
+      .local()
+      .create_topics(
+        cluster::without_custom_assignments(std::move(cfgs)),
+        model::no_timeout)
+      .then([this](std::vector<cluster::topic_result> results) {
+          return wait_for_topics(std::move(results));
+      })
+      .get();
+    start();
+    model::ntp ntp(tp_ns.ns, tp_ns.tp, model::partition_id(0));
+    wait_for_partition_offset(ntp, model::offset(0)).get0();
+
+    std::vector<kafka::produce_request::topic> topics;
+    topics.push_back(kafka::produce_request::topic{
+      .name = topic, .partitions = small_batches(10)});
+    kafka::produce_request req(std::nullopt, -1, std::move(topics));
+    req.data.timeout_ms = std::chrono::seconds(2);
+    req.has_idempotent = false;
+    req.has_transactional = false;
+    auto presp = producer->dispatch(std::move(req)).get0();
+    BOOST_REQUIRE_EQUAL(
+      presp.data.responses.begin()->partitions.begin()->error_code,
+      kafka::error_code::none);
+
+    kafka::fetch_request freq;
+    freq.data.min_bytes = 1;
+    freq.data.max_bytes = 10_MiB;
+    freq.data.max_wait_ms = 1000ms;
+    freq.data.topics.push_back(kafka::fetch_request::topic{
+      .name = topic,
+      .fetch_partitions = {{
+        .partition_index = model::partition_id(0),
+        .fetch_offset = model::offset(0),
+        .max_bytes = 1_MiB,
+      }},
+    });
+    auto fresp = consumer->dispatch(std::move(freq), kafka::api_version(4))
+                   .get0();
+
+    auto& records = fresp.data.topics.begin()->partitions.begin()->records;
+    BOOST_REQUIRE(records && !records->empty());
+    auto adapter = records->consume_batch();
+    BOOST_REQUIRE(adapter.batch);
+    BOOST_REQUIRE_EQUAL(
+      adapter.batch->header().attrs.compression(), model::compression::lz4);
+    BOOST_REQUIRE_EQUAL(adapter.batch->record_count(), 10);
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#include "bytes/iobuf.h"
+#include "kafka/server/protocol_utils.h"
+#include "kafka/server/response.h"
+#include "random/generators.h"
+
+#include <seastar/net/packet.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+namespace {
+iobuf single_fragment(size_t size) {
+    iobuf ret;
+    auto data = random_generators::gen_alphanum_string(size);
+    ret.append(ss::temporary_buffer<char>(data.data(), data.size()));
+    return ret;
+}
+} // namespace
+
+SEASTAR_THREAD_TEST_CASE(response_as_scattered_packs_small_fragments) {
+    auto resp = std::make_unique<kafka::response>(kafka::flex_enabled::no);
+    resp->set_correlation(kafka::correlation_id(42));
+    const size_t parts = 100;
+    for (size_t i = 0; i < parts; ++i) {
+        // the fields of a partition followed by its records, shared
+        resp->buf().append_fragments(single_fragment(20));
+        resp->buf().append_fragments(
+          single_fragment(kafka::max_packed_fragment_size * 4));
+    }
+    iobuf expected;
+    kafka::response_writer writer(expected);
+    writer.write(int32_t(sizeof(int32_t) + resp->buf().size_bytes()));
+    writer.write(kafka::correlation_id(42));
+    expected.append(resp->buf().copy());
+
+    auto msg = kafka::response_as_scattered(
+      ss::make_foreign(std::move(resp)));
+    auto packet = std::move(msg).release();
+    BOOST_REQUIRE_EQUAL(packet.len(), expected.size_bytes());
+    // the response header is sent with the fields of the first partition
+    BOOST_REQUIRE_EQUAL(packet.nr_frags(), 2 * parts);
+
+    iobuf sent;
+    for (const auto& f : packet.fragments()) {
+        sent.append(f.base, f.size);
+    }
+    BOOST_REQUIRE_EQUAL(sent, expected);
+}
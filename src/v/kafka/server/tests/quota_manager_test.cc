@@ -0,0 +1,55 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "config/configuration.h"
+#include "kafka/server/quota_manager.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include <boost/test/unit_test.hpp>
+
+namespace kafka {
+
+SEASTAR_THREAD_TEST_CASE(quota_manager_request_rate) {
+    config::shard_local_cfg().target_quota_request_rate.set_value(
+      std::make_optional<uint32_t>(10));
+    quota_manager qm;
+    qm.start().get();
+
+    const auto now = quota_manager::clock::now();
+    quota_manager::throttle_delay delay{};
+    for (int i = 0; i < 1000; ++i) {
+        delay = qm.record_tp_and_throttle("busy", 1, now);
+    }
+    BOOST_REQUIRE(delay.duration > quota_manager::clock::duration(0));
+    BOOST_REQUIRE(!delay.first_violation);
+
+    // the request rate is tracked per client
+    delay = qm.record_tp_and_throttle("quiet", 1, now);
+    BOOST_REQUIRE(delay.duration == quota_manager::clock::duration(0));
+
+    qm.stop().get();
+    config::shard_local_cfg().target_quota_request_rate.reset();
+}
+
+SEASTAR_THREAD_TEST_CASE(quota_manager_no_request_rate_quota) {
+    quota_manager qm;
+    qm.start().get();
+
+    const auto now = quota_manager::clock::now();
+    quota_manager::throttle_delay delay{};
+    for (int i = 0; i < 1000; ++i) {
+        delay = qm.record_tp_and_throttle("busy", 1, now);
+    }
+    BOOST_REQUIRE(delay.duration == quota_manager::clock::duration(0));
+
+    qm.stop().get();
+}
+
+} // namespace kafka
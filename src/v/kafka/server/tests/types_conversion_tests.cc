@@ -109,3 +109,27 @@ BOOST_AUTO_TEST_CASE(test_all_additional_options) {
       model::cleanup_policy_bitflags::compaction
         | model::cleanup_policy_bitflags::deletion);
 }
+
+BOOST_AUTO_TEST_CASE(test_write_caching_option) {
+    creatable_topic write_caching = {
+      .name = model::topic_view{"test_tp"},
+      .num_partitions = 5,
+      .replication_factor = 3,
+      .configs = {{"redpanda.write.caching", "true"}}};
+
+    auto cluster_tp_config = to_cluster_type(write_caching);
+    BOOST_REQUIRE(cluster_tp_config.cfg.properties.write_caching == true);
+    BOOST_REQUIRE(cluster_tp_config.cfg.properties.has_overrides());
+    auto overrides = cluster_tp_config.cfg.properties.get_ntp_cfg_overrides();
+    BOOST_REQUIRE(overrides.write_caching == true);
+
+    auto configs = from_cluster_type(cluster_tp_config.cfg.properties);
+    BOOST_REQUIRE_EQUAL(
+      configs[topic_property_write_caching], ss::sstring("true"));
+
+    BOOST_REQUIRE(!to_cluster_type(creatable_topic{
+                     .name = model::topic_view{"test_tp"},
+                     .num_partitions = 1,
+                     .replication_factor = 1})
+                     .cfg.properties.write_caching.has_value());
+}
@@ -10,6 +10,7 @@
 #include "model/adl_serde.h"
 
 #include "model/record.h"
+#include "model/record_utils.h"
 
 #include <seastar/core/smp.hh>
 
@@ -248,12 +249,26 @@ model::record_batch adl<model::record_batch>::from(iobuf_parser& in) {
         auto io = reflection::adl<iobuf>{}.from(in);
         return model::record_batch(hdr.bhdr, std::move(io));
     }
-    auto recs = std::vector<model::record>{};
-    recs.reserve(hdr.bhdr.record_count);
+    if (hdr.bhdr.attrs.compression() != model::compression::none) {
+        auto recs = std::vector<model::record>{};
+        recs.reserve(hdr.bhdr.record_count);
+        for (int i = 0; i < hdr.bhdr.record_count; ++i) {
+            recs.push_back(adl<model::record>{}.from(in));
+        }
+        return model::record_batch(hdr.bhdr, std::move(recs));
+    }
+    /*
+     * The records are shared out of the parser and re-encoded directly into
+     * the batch buffer, sharing their large fields rather than copying them,
+     * so that replicated payloads reach storage without being copied.
+     */
+    iobuf records;
     for (int i = 0; i < hdr.bhdr.record_count; ++i) {
-        recs.push_back(adl<model::record>{}.from(in));
+        model::append_record_to_buffer(
+          records, adl<model::record>{}.from(in));
     }
-    return model::record_batch(hdr.bhdr, std::move(recs));
+    return model::record_batch(
+      hdr.bhdr, std::move(records), model::record_batch::tag_ctor_ng{});
 }
 
 void adl<model::partition_metadata>::to(
@@ -420,6 +420,48 @@ operator<<(std::ostream& o, const partition_autobalancing_mode& m) {
     }
 }
 
+/// Controls when the raft replicate batcher cuts the pending requests into an
+/// append. `fixed` cuts as soon as the batcher is free, the adaptive policies
+/// may hold the requests for a fraction of the observed append latency when
+/// more data is expected to arrive shortly.
+enum class replicate_batcher_policy {
+    fixed = 0,
+    latency_first,
+    throughput_first,
+};
+
+inline std::ostream&
+operator<<(std::ostream& o, const replicate_batcher_policy& p) {
+    switch (p) {
+    case model::replicate_batcher_policy::fixed:
+        return o << "fixed";
+    case model::replicate_batcher_policy::latency_first:
+        return o << "latency_first";
+    case model::replicate_batcher_policy::throughput_first:
+        return o << "throughput_first";
+    }
+}
+
+/// Granularity of the partition metrics series: one series per partition, or
+/// the partitions of a shard folded into a series per topic or per node.
+enum class partition_metrics_aggregation {
+    partition = 0,
+    topic,
+    node,
+};
+
+inline std::ostream&
+operator<<(std::ostream& o, const partition_metrics_aggregation& a) {
+    switch (a) {
+    case model::partition_metrics_aggregation::partition:
+        return o << "partition";
+    case model::partition_metrics_aggregation::topic:
+        return o << "topic";
+    case model::partition_metrics_aggregation::node:
+        return o << "node";
+    }
+}
+
 namespace internal {
 /*
  * Old version for use in backwards compatibility serialization /
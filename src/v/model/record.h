@@ -618,6 +618,18 @@ public:
           _header, _records.share(0, _records.size_bytes()), _compressed);
     }
 
+    /**
+     * Take the batch on a core other than the owner of its memory without
+     * copying the records, see iobuf_adopt_foreign(). The caller must have
+     * exclusive access to this batch object.
+     */
+    record_batch adopt_foreign(ss::shard_id owner) && {
+        return record_batch(
+          _header.copy(),
+          iobuf_adopt_foreign(std::move(_records), owner),
+          _compressed);
+    }
+
     /**
      * Set the batch max timestamp and recalculate checksums.
      *
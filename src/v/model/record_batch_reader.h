@@ -106,9 +106,11 @@ public:
                   return batch;
               },
               [](foreign_data_t& d) {
-                  // cannot have a move-only type from a remote core
-                  // we must make a copy. for iteration use for_each_ref
-                  return (*d.buffer)[d.index++].copy();
+                  // the reader has exclusive access to the remote batches,
+                  // adopt their records rather than copying them. the memory
+                  // is released back on the remote core
+                  return std::move((*d.buffer)[d.index++])
+                    .adopt_foreign(d.buffer.get_owner_shard());
               });
         }
         ss::future<> load_slice(timeout_clock::time_point timeout) {
@@ -180,7 +180,10 @@ static inline void append_vint_to_iobuf(iobuf& b, int64_t v) {
     b.append(vb.data(), vb.size());
 }
 
-void append_record_to_buffer(iobuf& a, const model::record& r) {
+/// Appends the encoding of the record, the key and value fields of the record
+/// and of its headers are appended with the Fields policy
+template<typename Fields, typename Record>
+static void do_append_record_to_buffer(iobuf& a, Record& r) {
     a.reserve_memory(vint::max_length * 6);
     append_vint_to_iobuf(a, r.size_bytes());
 
@@ -194,15 +197,11 @@ void append_record_to_buffer(iobuf& a, const model::record& r) {
     a.reserve_memory(r.key_size() + r.value_size());
     append_vint_to_iobuf(a, r.key_size());
     if (r.key_size() > 0) {
-        for (auto& f : r.key()) {
-            a.append(f.get(), f.size());
-        }
+        Fields::key(a, r);
     }
     append_vint_to_iobuf(a, r.value_size());
     if (r.value_size() > 0) {
-        for (auto& f : r.value()) {
-            a.append(f.get(), f.size());
-        }
+        Fields::value(a, r);
     }
 
     auto& hdrs = r.headers();
@@ -211,17 +210,56 @@ void append_record_to_buffer(iobuf& a, const model::record& r) {
         append_vint_to_iobuf(a, h.key_size());
         a.reserve_memory(h.memory_usage());
         if (h.key_size() > 0) {
-            for (auto& f : h.key()) {
-                a.append(f.get(), f.size());
-            }
+            Fields::key(a, h);
         }
         append_vint_to_iobuf(a, h.value_size());
         if (h.value_size() > 0) {
-            for (auto& f : h.value()) {
-                a.append(f.get(), f.size());
-            }
+            Fields::value(a, h);
         }
     }
 }
 
+static void append_field_copy(iobuf& a, const iobuf& field) {
+    for (auto& f : field) {
+        a.append(f.get(), f.size());
+    }
+}
+
+struct copy_fields {
+    template<typename T>
+    static void key(iobuf& a, const T& t) {
+        append_field_copy(a, t.key());
+    }
+    template<typename T>
+    static void value(iobuf& a, const T& t) {
+        append_field_copy(a, t.value());
+    }
+};
+
+struct share_fields {
+    static void append(iobuf& a, iobuf field) {
+        if (field.size_bytes() < min_shared_record_field_size) {
+            append_field_copy(a, field);
+        } else {
+            a.append(std::move(field));
+        }
+    }
+    template<typename T>
+    static void key(iobuf& a, T& t) {
+        append(a, t.release_key());
+    }
+    template<typename T>
+    static void value(iobuf& a, T& t) {
+        append(a, t.release_value());
+    }
+};
+
+void append_record_to_buffer(iobuf& a, const model::record& r) {
+    do_append_record_to_buffer<copy_fields>(a, r);
+}
+
+void append_record_to_buffer(iobuf& a, model::record&& r) {
+    do_append_record_to_buffer<share_fields>(a, r);
+}
+
 } // namespace model
@@ -34,4 +34,12 @@ model::record parse_one_record_from_buffer(iobuf_parser& parser);
 model::record parse_one_record_copy_from_buffer(iobuf_const_parser& parser);
 void append_record_to_buffer(iobuf& a, const model::record& r);
 
+/// \brief fields smaller than this are copied rather than shared, a shared
+/// fragment costs more than copying a few bytes and fragments the buffer
+inline constexpr size_t min_shared_record_field_size = 512;
+
+/// \brief like the above, but the key, value and header fields of the record
+/// that are large enough are shared into the buffer instead of copied
+void append_record_to_buffer(iobuf& a, model::record&& r);
+
 } // namespace model
@@ -10,6 +10,8 @@
 #include "model/adl_serde.h"
 #include "model/fundamental.h"
 #include "model/metadata.h"
+#include "model/record_utils.h"
+#include "model/tests/random_batch.h"
 #include "test_utils/rpc.h"
 
 #include <seastar/testing/thread_test_case.hh>
@@ -69,3 +71,17 @@ SEASTAR_THREAD_TEST_CASE(tristate_rt_test) {
     BOOST_REQUIRE_EQUAL(r_empty.has_value(), false);
     BOOST_REQUIRE_EQUAL(r_present.value(), 1024);
 }
+
+SEASTAR_THREAD_TEST_CASE(record_batch_rt_test) {
+    // mix of records whose keys are copied and shared when decoded
+    auto batch = model::test::make_random_batch(model::test::record_batch_spec{
+      .allow_compression = false,
+      .count = 3,
+      .record_sizes = std::vector<size_t>{
+        16, model::min_shared_record_field_size, 4096}});
+    auto expected = batch.copy();
+
+    auto r = serialize_roundtrip_rpc(std::move(batch));
+    BOOST_REQUIRE_EQUAL(r, expected);
+    BOOST_REQUIRE_EQUAL(model::crc_record_batch(r), r.header().crc);
+}
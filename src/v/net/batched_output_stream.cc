@@ -14,6 +14,7 @@
 #include "vassert.h"
 
 #include <seastar/core/future.hh>
+#include <seastar/core/later.hh>
 #include <seastar/core/scattered_message.hh>
 
 #include <fmt/format.h>
@@ -48,11 +49,24 @@ ss::future<> batched_output_stream::write(ss::scattered_message<char> msg) {
           const size_t vbytes = v.size();
           return _out.write(std::move(v)).then([this, vbytes] {
               _unflushed_bytes += vbytes;
-              if (
-                _write_sem->waiters() == 0 || _unflushed_bytes >= _cache_size) {
+              ++_writes;
+              ++_batch_writes;
+              if (_unflushed_bytes >= _cache_size) {
                   return do_flush();
               }
-              return ss::make_ready_future<>();
+              if (_write_sem->waiters() > 0) {
+                  // the next writer flushes
+                  return ss::make_ready_future<>();
+              }
+              if (!_cork) {
+                  return do_flush();
+              }
+              return ss::later().then([this] {
+                  if (_write_sem->waiters() > 0) {
+                      return ss::make_ready_future<>();
+                  }
+                  return do_flush();
+              });
           });
       });
 }
@@ -61,6 +75,9 @@ ss::future<> batched_output_stream::do_flush() {
         return ss::make_ready_future<>();
     }
     _unflushed_bytes = 0;
+    ++_flushes;
+    _cork = _batch_writes > 1;
+    _batch_writes = 0;
     return _out.flush();
 }
 ss::future<> batched_output_stream::flush() {
@@ -34,6 +34,12 @@ private:
 };
 
 /// \brief batch operations for zero copy interface of an output_stream<char>
+///
+/// Messages queued behind a write are sent with it in a single flush, up to
+/// the unflushed bytes budget. When writers are concurrent (the previous flush
+/// carried several messages) the stream corks: the flush of a write that has
+/// nobody queued behind it is delayed to the next scheduling point so that
+/// writers running in the meantime join the batch.
 class batched_output_stream {
 public:
     static constexpr size_t default_max_unflushed_bytes = 1024 * 1024;
@@ -48,6 +54,10 @@ public:
       , _cache_size(o._cache_size)
       , _write_sem(std::move(o._write_sem))
       , _unflushed_bytes(o._unflushed_bytes)
+      , _batch_writes(o._batch_writes)
+      , _writes(o._writes)
+      , _flushes(o._flushes)
+      , _cork(o._cork)
       , _closed(o._closed) {}
     batched_output_stream& operator=(batched_output_stream&& o) noexcept {
         if (this != &o) {
@@ -68,6 +78,11 @@ public:
 
     bool is_valid() const noexcept { return _cache_size != 0; }
 
+    /// \brief number of messages written
+    uint64_t writes() const noexcept { return _writes; }
+    /// \brief number of flushes, i.e. of batches handed to the socket
+    uint64_t flushes() const noexcept { return _flushes; }
+
 private:
     ss::future<> do_flush();
 
@@ -75,6 +90,13 @@ private:
     size_t _cache_size{0};
     std::unique_ptr<ssx::semaphore> _write_sem;
     size_t _unflushed_bytes{0};
+    // messages written since the last flush
+    size_t _batch_writes{0};
+    uint64_t _writes{0};
+    uint64_t _flushes{0};
+    // set when the last flushed batch held several messages, writers are
+    // concurrent so the flush is delayed to let them queue up
+    bool _cork{false};
     bool _closed = false;
 };
 } // namespace net
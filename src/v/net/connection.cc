@@ -95,7 +95,11 @@ ss::future<> connection::shutdown() {
 
 ss::future<> connection::write(ss::scattered_message<char> msg) {
     _probe.add_bytes_sent(msg.size());
-    return _out.write(std::move(msg));
+    _probe.message_sent();
+    return _out.write(std::move(msg)).then([this] {
+        _probe.add_output_flushes(_out.flushes() - _reported_flushes);
+        _reported_flushes = _out.flushes();
+    });
 }
 
 } // namespace net
@@ -68,6 +68,8 @@ private:
     ss::connected_socket _fd;
     ss::input_stream<char> _in;
     net::batched_output_stream _out;
+    // flushes of _out already accounted in the probe
+    uint64_t _reported_flushes{0};
     server_probe& _probe;
 };
 
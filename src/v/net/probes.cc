@@ -54,6 +54,13 @@ void server_probe::setup_metrics(
             "{}: Number of connections rejected for hitting connection limits",
             proto)))
           .aggregate(aggregate_labels),
+        sm::make_counter(
+          "connections_rebalanced",
+          [this] { return _connections_rebalanced; },
+          sm::description(ssx::sformat(
+            "{}: Number of connections closed to move load to other shards",
+            proto)))
+          .aggregate(aggregate_labels),
         sm::make_counter(
           "requests_completed",
           [this] { return _requests_completed; },
@@ -73,6 +80,19 @@ void server_probe::setup_metrics(
           sm::description(
             ssx::sformat("{}: Number of bytes sent to clients", proto)))
           .aggregate(aggregate_labels),
+        sm::make_counter(
+          "sent_messages",
+          [this] { return _messages_sent; },
+          sm::description(
+            ssx::sformat("{}: Number of messages sent to clients", proto)))
+          .aggregate(aggregate_labels),
+        sm::make_counter(
+          "output_flushes",
+          [this] { return _output_flushes; },
+          sm::description(ssx::sformat(
+            "{}: Number of flushes of batched messages to client sockets",
+            proto)))
+          .aggregate(aggregate_labels),
         sm::make_counter(
           "method_not_found_errors",
           [this] { return _method_not_found_errors; },
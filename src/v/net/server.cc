@@ -29,6 +29,8 @@
 #include <seastar/net/api.hh>
 #include <seastar/util/later.hh>
 
+#include <numeric>
+
 namespace net {
 
 server::server(server_configuration c)
@@ -73,6 +75,11 @@ void server::start() {
               connection_rate_bindings.value().config_overrides_rate());
         });
     }
+    if (cfg.connection_rebalance_interval) {
+        _rebalance_timer.set_callback([this] { sample_load(); });
+        _rebalance_timer.arm_periodic(*cfg.connection_rebalance_interval);
+    }
+
     for (const auto& endpoint : cfg.addrs) {
         ss::server_socket ss;
         try {
@@ -244,8 +251,64 @@ ss::future<> server::accept(listener& s) {
     });
 }
 
+void server::sample_load() {
+    const auto requests = _probe.requests_received();
+    const auto bytes = _probe.bytes_transferred();
+    _load = (requests - _last_requests)
+            + (bytes - _last_bytes) / load_bytes_unit;
+    _last_requests = requests;
+    _last_bytes = bytes;
+    ssx::spawn_with_gate(_conn_gate, [this] { return rebalance_connections(); });
+}
+
+ss::future<> server::rebalance_connections() {
+    auto loads = co_await container().map(
+      [](const server& s) { return s._load; });
+    if (_as.abort_requested() || _connections.size() < 2) {
+        co_return;
+    }
+
+    const auto total = std::accumulate(
+      loads.begin(), loads.end(), uint64_t(0));
+    const auto mean = double(total) / double(loads.size());
+    if (mean == 0 || double(_load) <= mean * (1 + rebalance_threshold)) {
+        co_return;
+    }
+
+    /*
+     * the load of a single connection isn't tracked, assume it is spread
+     * evenly and close enough connections to bring the shard back to the
+     * average. the clients reconnect and the accept load balancing places the
+     * new connections on the shards serving fewer connections.
+     */
+    const auto excess = (double(_load) - mean) / double(_load);
+    auto to_close = std::min(
+      max_rebalanced_connections,
+      size_t(excess * double(_connections.size())));
+    if (to_close == 0) {
+        co_return;
+    }
+
+    vlog(
+      rpc::rpclog.info,
+      "{} - Shard load {} above average {:.1f}, closing {} of {} connections",
+      _proto->name(),
+      _load,
+      mean,
+      to_close,
+      _connections.size());
+    for (auto& c : _connections) {
+        if (to_close-- == 0) {
+            break;
+        }
+        c.shutdown_input();
+        _probe.connection_rebalanced();
+    }
+}
+
 void server::shutdown_input() {
     ss::sstring proto_name = _proto ? _proto->name() : "protocol not set";
+    _rebalance_timer.cancel();
     vlog(
       rpc::rpclog.info,
       "{} - Stopping {} listeners",
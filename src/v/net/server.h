@@ -17,12 +17,14 @@
 #include "net/connection_rate.h"
 #include "net/types.h"
 #include "ssx/semaphore.h"
+#include "units.h"
 #include "utils/hdr_hist.h"
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/metrics_registration.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/timer.hh>
 #include <seastar/net/tls.hh>
 
 #include <boost/intrusive/list.hpp>
@@ -89,13 +91,19 @@ struct server_configuration {
 
     std::optional<std::reference_wrapper<ss::sharded<conn_quota>>> conn_quotas;
 
+    // when set the shards compare their load at this interval and a shard
+    // serving noticeably more than the average closes some of its connections
+    // so that the clients reconnect to the less loaded shards. requires the
+    // server to run as a sharded service.
+    std::optional<std::chrono::milliseconds> connection_rebalance_interval;
+
     explicit server_configuration(ss::sstring n)
       : name(std::move(n)) {}
 
     friend std::ostream& operator<<(std::ostream&, const server_configuration&);
 };
 
-class server {
+class server : public ss::peering_sharded_service<server> {
 public:
     // always guaranteed non-null
     class resources final {
@@ -109,6 +117,9 @@ public:
 
         server_probe& probe() { return _s->_probe; }
         ssx::semaphore& memory() { return _s->_memory; }
+        int64_t max_memory() const {
+            return _s->cfg.max_service_memory_per_core;
+        }
         hdr_hist& hist() { return _s->_hist; }
         ss::gate& conn_gate() { return _s->_conn_gate; }
         ss::abort_source& abort_source() { return _s->_as; }
@@ -173,8 +184,18 @@ private:
           , socket(std::move(socket)) {}
     };
 
+    // a shard is rebalanced when its load exceeds the average by this fraction
+    static constexpr double rebalance_threshold = 0.5;
+    // connections closed by a shard per rebalance interval at most
+    static constexpr size_t max_rebalanced_connections = 8;
+    // load accounted per request and per this many bytes of traffic, so that
+    // both many small requests and a few large fetches count
+    static constexpr uint64_t load_bytes_unit = 64_KiB;
+
     friend resources;
     ss::future<> accept(listener&);
+    void sample_load();
+    ss::future<> rebalance_connections();
     void setup_metrics();
     void setup_public_metrics();
 
@@ -191,6 +212,12 @@ private:
 
     std::optional<config_connection_rate_bindings> connection_rate_bindings;
     std::optional<connection_rate<>> _connection_rates;
+
+    // load of this shard over the last rebalance interval
+    ss::timer<ss::lowres_clock> _rebalance_timer;
+    uint64_t _load{0};
+    uint64_t _last_requests{0};
+    uint64_t _last_bytes{0};
 };
 
 } // namespace net
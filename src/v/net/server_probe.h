@@ -34,6 +34,10 @@ public:
 
     void add_bytes_sent(size_t sent) { _out_bytes += sent; }
 
+    void message_sent() { ++_messages_sent; }
+
+    void add_output_flushes(uint64_t n) { _output_flushes += n; }
+
     void add_bytes_received(size_t recv) { _in_bytes += recv; }
 
     void request_received() { ++_requests_received; }
@@ -52,6 +56,12 @@ public:
 
     void waiting_for_conection_rate() { ++_connections_wait_rate; }
 
+    void connection_rebalanced() { ++_connections_rebalanced; }
+
+    uint64_t requests_received() const { return _requests_received; }
+
+    uint64_t bytes_transferred() const { return _in_bytes + _out_bytes; }
+
     void setup_metrics(ss::metrics::metric_groups& mgs, std::string_view proto);
 
     void setup_public_metrics(
@@ -72,6 +82,9 @@ private:
     uint32_t _requests_blocked_memory = 0;
     uint32_t _declined_new_connections = 0;
     uint32_t _connections_wait_rate = 0;
+    uint64_t _connections_rebalanced = 0;
+    uint64_t _messages_sent = 0;
+    uint64_t _output_flushes = 0;
     friend std::ostream& operator<<(std::ostream& o, const server_probe& p);
 };
 
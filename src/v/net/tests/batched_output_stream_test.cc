@@ -0,0 +1,88 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "net/batched_output_stream.h"
+#include "seastarx.h"
+
+#include <seastar/core/iostream.hh>
+#include <seastar/core/later.hh>
+#include <seastar/core/scattered_message.hh>
+#include <seastar/core/when_all.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <vector>
+
+namespace {
+
+/// counts the batches handed to the socket, each one takes a scheduling
+/// point to be sent
+class counting_sink final : public ss::data_sink_impl {
+public:
+    explicit counting_sink(size_t& puts)
+      : _puts(puts) {}
+
+    ss::future<> put(ss::net::packet) final {
+        ++_puts;
+        return ss::later();
+    }
+
+    ss::future<> close() final { return ss::make_ready_future<>(); }
+
+private:
+    size_t& _puts;
+};
+
+net::batched_output_stream make_stream(size_t& puts) {
+    return net::batched_output_stream(ss::output_stream<char>(
+      ss::data_sink(std::make_unique<counting_sink>(puts)), 128 * 1024));
+}
+
+ss::scattered_message<char> make_message() {
+    ss::scattered_message<char> msg;
+    msg.append(ss::sstring("message"));
+    return msg;
+}
+
+} // namespace
+
+SEASTAR_THREAD_TEST_CASE(sequential_writes_are_flushed) {
+    size_t puts = 0;
+    auto out = make_stream(puts);
+    for (int i = 0; i < 5; ++i) {
+        out.write(make_message()).get();
+    }
+    BOOST_REQUIRE_EQUAL(out.writes(), 5);
+    BOOST_REQUIRE_EQUAL(out.flushes(), 5);
+    BOOST_REQUIRE_EQUAL(puts, 5);
+    out.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(concurrent_writes_are_batched) {
+    size_t puts = 0;
+    auto out = make_stream(puts);
+    std::vector<ss::future<>> writes;
+    for (int i = 0; i < 10; ++i) {
+        writes.push_back(out.write(make_message()));
+    }
+    ss::when_all_succeed(writes.begin(), writes.end()).get();
+    // the first write is flushed alone, the others queue behind its flush
+    // and are sent together
+    BOOST_REQUIRE_EQUAL(out.writes(), 10);
+    BOOST_REQUIRE_EQUAL(out.flushes(), 2);
+    BOOST_REQUIRE_EQUAL(puts, 2);
+
+    // corked after a batch, a lone write is still flushed and uncorks the
+    // stream
+    out.write(make_message()).get();
+    BOOST_REQUIRE_EQUAL(out.flushes(), 3);
+    out.write(make_message()).get();
+    BOOST_REQUIRE_EQUAL(out.flushes(), 4);
+    BOOST_REQUIRE_EQUAL(puts, 4);
+    out.stop().get();
+}
@@ -48,8 +48,7 @@ public:
     inline std::pair<bool, std::optional<iobuf>>
     decode_base64(std::string_view v) {
         try {
-            auto decoded = base64_to_bytes(v);
-            return {true, bytes_to_iobuf(decoded)};
+            return {true, base64_to_iobuf(v)};
         } catch (const base64_decoder_exception&) {
             return {false, std::nullopt};
         }
@@ -65,7 +64,8 @@ public:
     explicit rjson_serialize_impl(serialization_format fmt)
       : _fmt(fmt) {}
 
-    bool operator()(::json::Writer<::json::StringBuffer>& w, iobuf buf) {
+    template<typename Buffer>
+    bool operator()(::json::Writer<Buffer>& w, iobuf buf) {
         switch (_fmt) {
         case serialization_format::none:
             [[fallthrough]];
@@ -80,15 +80,19 @@ public:
         }
     }
 
-    bool encode_base64(::json::Writer<::json::StringBuffer>& w, iobuf buf) {
+    template<typename Buffer>
+    bool encode_base64(::json::Writer<Buffer>& w, iobuf buf) {
         if (buf.empty()) {
             return w.Null();
         }
-        // TODO Ben: Implement custom OutputStream to prevent this linearization
-        return w.String(iobuf_to_base64(buf));
+        // Only a single record is linearized, the document is written into
+        // the output stream of the writer, see json::chunked_buffer.
+        auto encoded = iobuf_to_base64(buf);
+        return w.String(encoded.data(), encoded.size());
     };
 
-    bool encode_json(::json::Writer<::json::StringBuffer>& w, iobuf buf) {
+    template<typename Buffer>
+    bool encode_json(::json::Writer<Buffer>& w, iobuf buf) {
         if (buf.empty()) {
             return w.Null();
         }
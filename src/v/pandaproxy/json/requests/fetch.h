@@ -13,6 +13,7 @@
 
 #include "bytes/iobuf.h"
 #include "bytes/iobuf_parser.h"
+#include "json/chunked_buffer.h"
 #include "json/stringbuffer.h"
 #include "json/writer.h"
 #include "kafka/protocol/errors.h"
@@ -26,8 +27,12 @@
 #include "pandaproxy/json/rjson_util.h"
 #include "pandaproxy/json/types.h"
 #include "seastarx.h"
+#include "units.h"
 
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/iostream.hh>
 #include <seastar/core/sstring.hh>
+#include <seastar/coroutine/maybe_yield.hh>
 
 namespace pandaproxy::json {
 
@@ -42,19 +47,19 @@ public:
       , _tpv(tpv)
       , _base_offset(base_offset) {}
 
-    void
-    operator()(::json::Writer<::json::StringBuffer>& w, model::record record) {
+    template<typename Buffer>
+    void operator()(::json::Writer<Buffer>& w, model::record record) {
         w.StartObject();
         w.Key("topic");
-        ::json::rjson_serialize(w, _tpv.topic);
+        w.String(_tpv.topic().data(), _tpv.topic().size());
         w.Key("key");
         rjson_serialize_fmt(_fmt)(w, record.release_key());
         w.Key("value");
         rjson_serialize_fmt(_fmt)(w, record.release_value());
         w.Key("partition");
-        ::json::rjson_serialize(w, _tpv.partition);
+        w.Int(_tpv.partition());
         w.Key("offset");
-        ::json::rjson_serialize(w, _base_offset() + record.offset_delta());
+        w.Int64(_base_offset() + record.offset_delta());
         w.EndObject();
     }
 
@@ -67,44 +72,93 @@ private:
 template<>
 class rjson_serialize_impl<kafka::fetch_response> {
 public:
+    // bytes serialized before they are written to the output stream
+    static constexpr size_t stream_chunk_size = 128_KiB;
+
     explicit rjson_serialize_impl(serialization_format fmt)
       : _fmt(fmt) {}
 
-    void operator()(
-      ::json::Writer<::json::StringBuffer>& w, kafka::fetch_response&& res) {
-        // Eager check for errors
+    template<typename Buffer>
+    void operator()(::json::Writer<Buffer>& w, kafka::fetch_response&& res) {
+        check_errors(res);
+
+        w.StartArray();
+        for (auto& v : res) {
+            auto r = std::move(*v.partition_response);
+            model::topic_partition_view tpv(
+              v.partition->name, r.partition_index);
+            while (r.records && !r.records->empty()) {
+                serialize_batch(_fmt, w, tpv, r.records->consume_batch());
+            }
+        }
+        w.EndArray();
+    }
+
+    /**
+     * Serializes the response into the output stream one batch at a time,
+     * so that neither the response nor the base64 encoding of its records
+     * is linearized and the reactor isn't stalled by large fetches.
+     *
+     * The errors of the response must be checked with check_errors() before
+     * anything is written to the output stream.
+     */
+    ss::future<>
+    operator()(kafka::fetch_response res, ss::output_stream<char>& os) {
+        return stream(_fmt, std::move(res), os);
+    }
+
+    static void check_errors(kafka::fetch_response& res) {
         for (auto& v : res) {
             if (v.partition_response->error_code != kafka::error_code::none) {
                 throw serialize_error(v.partition_response->error_code);
             }
         }
+    }
+
+private:
+    template<typename Buffer>
+    static void serialize_batch(
+      serialization_format fmt,
+      ::json::Writer<Buffer>& w,
+      model::topic_partition_view tpv,
+      kafka::kafka_batch_adapter adapter) {
+        if (!adapter.batch || adapter.batch->header().attrs.is_control()) {
+            return;
+        }
+
+        auto rjs = rjson_serialize_impl<model::record>(
+          fmt, tpv, adapter.batch->base_offset());
+
+        adapter.batch->for_each_record([&rjs, &w](model::record record) {
+            rjs(w, std::move(record));
+        });
+    }
+
+    static ss::future<> stream(
+      serialization_format fmt,
+      kafka::fetch_response res,
+      ss::output_stream<char>& os) {
+        ::json::chunked_buffer buf;
+        ::json::Writer<::json::chunked_buffer> w(buf);
 
         w.StartArray();
         for (auto& v : res) {
-            auto r = std::move(*v.partition_response);
+            auto& r = *v.partition_response;
             model::topic_partition_view tpv(
               v.partition->name, r.partition_index);
             while (r.records && !r.records->empty()) {
-                auto adapter = r.records->consume_batch();
-                if (
-                  !adapter.batch
-                  || adapter.batch->header().attrs.is_control()) {
-                    continue;
+                serialize_batch(fmt, w, tpv, r.records->consume_batch());
+                if (buf.size() >= stream_chunk_size) {
+                    co_await write_iobuf_to_output_stream(buf.consume(), os);
                 }
-
-                auto rjs = rjson_serialize_impl<model::record>(
-                  _fmt, tpv, adapter.batch->base_offset());
-
-                adapter.batch->for_each_record(
-                  [&rjs, &w](model::record record) {
-                      rjs(w, std::move(record));
-                  });
+                co_await ss::coroutine::maybe_yield();
             }
         }
         w.EndArray();
+        co_await write_iobuf_to_output_stream(buf.consume(), os);
+        co_await os.flush();
     }
 
-private:
     serialization_format _fmt;
 };
 
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "bytes/iobuf.h"
+#include "json/chunked_buffer.h"
 #include "json/json.h"
 #include "json/stringbuffer.h"
 #include "json/types.h"
@@ -43,7 +44,8 @@ private:
     serialization_format _fmt = serialization_format::none;
     state state = state::empty;
 
-    using json_writer = ::json::Writer<::json::StringBuffer>;
+    // json_v2 keys and values are written straight into iobuf fragments
+    using json_writer = ::json::Writer<::json::chunked_buffer>;
 
     // If we're parsing json_v2, and the field is key or value (implied by
     // _json_writer being set), then forward calls to json_writer.
@@ -56,8 +58,7 @@ private:
         auto res = std::invoke(
           mem_func, *_json_writer, std::forward<Args>(args)...);
         if (_json_writer->IsComplete()) {
-            iobuf buf;
-            buf.append(_buf.GetString(), _buf.GetSize());
+            auto buf = _buf.consume();
             switch (state) {
             case state::key:
                 result.back().key.emplace(std::move(buf));
@@ -68,7 +69,6 @@ private:
             default:
                 return tristate<bool>(false);
             }
-            _buf.Clear();
             _json_writer.reset();
             state = state::record;
         }
@@ -251,7 +251,7 @@ public:
     }
 
 private:
-    ::json::StringBuffer _buf;
+    ::json::chunked_buffer _buf;
     std::optional<json_writer> _json_writer;
 };
 
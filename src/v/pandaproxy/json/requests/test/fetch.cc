@@ -9,6 +9,8 @@
 
 #include "pandaproxy/json/requests/fetch.h"
 
+#include "bytes/iobuf_parser.h"
+#include "json/chunked_buffer.h"
 #include "json/stringbuffer.h"
 #include "json/writer.h"
 #include "kafka/client/test/utils.h"
@@ -97,3 +99,39 @@ SEASTAR_THREAD_TEST_CASE(test_produce_fetch_one) {
 
     BOOST_REQUIRE_EQUAL(str_buf.GetString(), expected);
 }
+
+SEASTAR_THREAD_TEST_CASE(test_produce_fetch_stream) {
+    std::vector<model::topic_partition> tps = {
+      {model::topic{"topic1"}, model::partition_id{1}},
+      {model::topic{"topic2"}, model::partition_id{2}},
+    };
+    auto fmt = ppj::serialization_format::binary_v2;
+
+    ::json::StringBuffer str_buf;
+    ::json::Writer<::json::StringBuffer> w(str_buf);
+    ppj::rjson_serialize_fmt(fmt)(
+      w, make_fetch_response(tps, model::offset{42}, 3));
+
+    iobuf chunked;
+    ::json::chunked_buffer chunked_buf;
+    ::json::Writer<::json::chunked_buffer> cw(chunked_buf);
+    ppj::rjson_serialize_fmt(fmt)(
+      cw, make_fetch_response(tps, model::offset{42}, 3));
+    chunked.append(chunked_buf.consume());
+
+    iobuf streamed;
+    auto os = make_iobuf_ref_output_stream(streamed);
+    auto res = make_fetch_response(tps, model::offset{42}, 3);
+    ppj::rjson_serialize_impl<kafka::fetch_response>::check_errors(res);
+    ppj::rjson_serialize_impl<kafka::fetch_response>{fmt}(std::move(res), os)
+      .get();
+    os.close().get();
+
+    auto to_string = [](iobuf buf) {
+        iobuf_parser p{std::move(buf)};
+        return p.read_string(p.bytes_left());
+    };
+    ss::sstring expected(str_buf.GetString(), str_buf.GetSize());
+    BOOST_REQUIRE_EQUAL(to_string(std::move(chunked)), expected);
+    BOOST_REQUIRE_EQUAL(to_string(std::move(streamed)), expected);
+}
@@ -96,6 +96,65 @@ SEASTAR_THREAD_TEST_CASE(test_produce_json_request) {
       value, R"({"integer":-5,"string":"str","array":["element"]})");
 }
 
+SEASTAR_THREAD_TEST_CASE(test_produce_request_iobuf) {
+    std::string_view input = R"(
+      {
+        "records": [
+          {
+            "key": "json_test",
+            "value": {"integer": -5, "array": ["element"]},
+            "partition": 1
+          }
+        ]
+      })";
+
+    // a fragment per character, tokens are split across fragments
+    auto make_buf = [input] {
+        iobuf buf;
+        for (auto c : input) {
+            iobuf frag;
+            frag.append(&c, 1);
+            buf.append_fragments(std::move(frag));
+        }
+        return buf;
+    };
+    auto frags = make_buf();
+    BOOST_REQUIRE_EQUAL(
+      static_cast<size_t>(std::distance(frags.begin(), frags.end())),
+      input.size());
+
+    auto records = ppj::rjson_parse(make_buf(), make_json_v2_handler());
+    BOOST_REQUIRE_EQUAL(records.size(), 1);
+    BOOST_REQUIRE_EQUAL(records[0].partition_id, model::partition_id(1));
+    BOOST_REQUIRE(!!records[0].key);
+    auto parser = iobuf_parser(std::move(*records[0].key));
+    BOOST_REQUIRE_EQUAL(
+      parser.read_string(parser.bytes_left()), R"("json_test")");
+    BOOST_REQUIRE(!!records[0].value);
+    parser = iobuf_parser(std::move(*records[0].value));
+    BOOST_REQUIRE_EQUAL(
+      parser.read_string(parser.bytes_left()),
+      R"({"integer":-5,"array":["element"]})");
+
+    // errors are reported at the same offset as for a contiguous body, the
+    // key is not valid base64
+    auto contiguous_error = [input]() -> std::string {
+        try {
+            ppj::rjson_parse(input.data(), make_binary_v2_handler());
+        } catch (const ppj::parse_error& e) {
+            return e.what();
+        }
+        return "";
+    }();
+    BOOST_REQUIRE(!contiguous_error.empty());
+    BOOST_CHECK_EXCEPTION(
+      ppj::rjson_parse(make_buf(), make_binary_v2_handler()),
+      ppj::parse_error,
+      [&contiguous_error](ppj::parse_error const& e) {
+          return e.what() == contiguous_error;
+      });
+}
+
 SEASTAR_THREAD_TEST_CASE(test_produce_invalid_json_request) {
     auto input = R"(
       {
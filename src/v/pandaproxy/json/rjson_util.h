@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include "bytes/iobuf.h"
+#include "json/chunked_input_stream.h"
 #include "json/json.h"
 #include "json/prettywriter.h"
 #include "json/reader.h"
@@ -48,8 +50,8 @@ struct rjson_serialize_fmt_impl {
         rjson_serialize_impl<std::remove_reference_t<T>>{fmt}(
           std::forward<T>(t));
     }
-    template<typename T>
-    void operator()(::json::Writer<::json::StringBuffer>& w, T&& t) {
+    template<typename Buffer, typename T>
+    void operator()(::json::Writer<Buffer>& w, T&& t) {
         rjson_serialize_impl<std::remove_reference_t<T>>{fmt}(
           w, std::forward<T>(t));
     }
@@ -73,6 +75,21 @@ rjson_parse(const char* const s, Handler&& handler) {
     return std::move(handler.result);
 }
 
+/// Parses a document held in iobuf fragments without linearizing it
+template<typename Handler>
+requires std::is_same_v<
+  decltype(std::declval<Handler>().result),
+  typename Handler::rjson_parse_result>
+typename Handler::rjson_parse_result
+rjson_parse(iobuf buf, Handler&& handler) {
+    ::json::Reader reader;
+    ::json::chunked_input_stream cis(std::move(buf));
+    if (!reader.Parse(cis, handler)) {
+        throw parse_error(reader.GetErrorOffset());
+    }
+    return std::move(handler.result);
+}
+
 inline ss::sstring minify(std::string_view json) {
     ::json::Reader r;
     ::json::StringStream in(json.data());
@@ -54,6 +54,13 @@ configuration::configuration()
       "consumer_instance_timeout_ms",
       "How long to wait for an idle consumer before removing it",
       {},
-      std::chrono::minutes{5}) {}
+      std::chrono::minutes{5})
+  , produce_topic_affinity(
+      *this,
+      "produce_topic_affinity",
+      "Produce the records of a topic through the client of a single core, "
+      "so that requests received on different cores are batched together",
+      {},
+      true) {}
 
 } // namespace pandaproxy::rest
@@ -33,6 +33,7 @@ struct configuration final : public config::config_store {
       advertised_pandaproxy_api;
     config::property<ss::sstring> api_doc_dir;
     config::property<std::chrono::milliseconds> consumer_instance_timeout;
+    config::property<bool> produce_topic_affinity;
 
     configuration();
     explicit configuration(const YAML::Node& cfg);
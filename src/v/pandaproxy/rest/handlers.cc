@@ -36,6 +36,8 @@
 #include "pandaproxy/reply.h"
 #include "pandaproxy/rest/configuration.h"
 #include "raft/types.h"
+#include "random/generators.h"
+#include "resource_mgmt/smp_groups_probe.h"
 #include "ssx/future-util.h"
 #include "ssx/sformat.h"
 #include "storage/record_batch_builder.h"
@@ -63,8 +65,26 @@ namespace {
 
 using server = ctx_server<proxy>;
 
-ss::shard_id consumer_shard(const kafka::group_id& g_id) {
-    auto hash = xxhash_64(g_id().data(), g_id().length());
+// Consumer instances live in the client of their home shard, spreading the
+// members of a group across shards. Every request for an instance is routed
+// there.
+ss::shard_id
+consumer_shard(const kafka::group_id& g_id, const kafka::member_id& name) {
+    incremental_xxhash64 inc;
+    inc.update(g_id);
+    inc.update(name);
+    return jump_consistent_hash(inc.digest(), ss::smp::count);
+}
+
+// Instance names are generated by the proxy rather than assigned by the
+// coordinator, the home shard must be known before the consumer is created.
+kafka::member_id make_consumer_name() {
+    return kafka::member_id{ssx::sformat(
+      "rest-consumer-{}", random_generators::gen_alphanum_string(16))};
+}
+
+ss::shard_id producer_shard(const model::topic& topic) {
+    auto hash = xxhash_64(topic().data(), topic().length());
     return jump_consistent_hash(hash, ss::smp::count);
 }
 
@@ -167,14 +187,22 @@ get_topics_records(server::request_t rq, server::reply_t rp) {
       .local()
       .fetch_partition(std::move(tp), offset, max_bytes, timeout)
       .then([res_fmt, rp = std::move(rp)](kafka::fetch_response res) mutable {
-          ::json::StringBuffer str_buf;
-          ::json::Writer<::json::StringBuffer> w(str_buf);
-
-          ppj::rjson_serialize_fmt(res_fmt)(w, std::move(res));
-
-          // TODO Ben: Prevent this linearization
-          ss::sstring json_rslt = str_buf.GetString();
-          rp.rep->write_body("json", json_rslt);
+          // Errors must be reported before the body is streamed
+          ppj::rjson_serialize_impl<kafka::fetch_response>::check_errors(res);
+
+          rp.rep->write_body(
+            "json",
+            [res_fmt, res = std::move(res)](
+              ss::output_stream<char>&& out) mutable {
+                return ss::do_with(
+                  std::move(out),
+                  std::move(res),
+                  [res_fmt](auto& out, auto& res) {
+                      return ppj::rjson_serialize_impl<kafka::fetch_response>{
+                        res_fmt}(std::move(res), out)
+                        .finally([&out] { return out.close(); });
+                  });
+            });
           rp.mime_type = res_fmt;
           return std::move(rp);
       });
@@ -197,8 +225,19 @@ post_topics_name(server::request_t rq, server::reply_t rp) {
     auto records = ppj::rjson_parse(
       rq.req->content.data(), ppj::produce_request_handler(req_fmt));
 
-    auto res = co_await rq.service().client().local().produce_records(
-      topic, std::move(records));
+    // The client batches the records per partition, across requests
+    auto shard = rq.service().config().produce_topic_affinity()
+                   ? producer_shard(topic)
+                   : ss::this_shard_id();
+    auto res = co_await measured_invoke_on(
+      rq.service().client(),
+      shard,
+      rq.context().smp_sg,
+      smp_group_kind::proxy,
+      [topic, records{std::move(records)}](
+        kafka::client::client& client) mutable {
+          return client.produce_records(topic, std::move(records));
+      });
 
     auto json_rslt = ppj::rjson_serialize(res.data.responses[0]);
     rp.rep->write_body("json", json_rslt);
@@ -244,8 +283,12 @@ create_consumer(server::request_t rq, server::reply_t rp) {
           parse::error_code::invalid_param, "auto.commit must be false");
     }
 
+    if (req_data.name == kafka::no_member) {
+        req_data.name = make_consumer_name();
+    }
+
     auto base_uri = make_consumer_uri_base(rq, group_id);
-    auto group_shard{consumer_shard(group_id)};
+    auto group_shard{consumer_shard(group_id, req_data.name)};
     auto handler =
       [_group_id{std::move(group_id)},
        _base_uri{std::move(base_uri)},
@@ -304,7 +347,7 @@ remove_consumer(server::request_t rq, server::reply_t rp) {
     auto member_id = parse::request_param<kafka::member_id>(
       *rq.req, "instance");
 
-    auto group_shard{consumer_shard(group_id)};
+    auto group_shard{consumer_shard(group_id, member_id)};
     auto handler =
       [_group_id{std::move(group_id)},
        _member_id{std::move(member_id)},
@@ -345,7 +388,7 @@ subscribe_consumer(server::request_t rq, server::reply_t rp) {
     auto req_data = ppj::rjson_parse(
       rq.req->content.data(), ppj::subscribe_consumer_request_handler());
 
-    auto group_shard{consumer_shard(group_id)};
+    auto group_shard{consumer_shard(group_id, member_id)};
     auto handler =
       [_group_id{std::move(group_id)},
        _member_id{std::move(member_id)},
@@ -390,7 +433,7 @@ consumer_fetch(server::request_t rq, server::reply_t rp) {
     auto max_bytes{
       parse::query_param<std::optional<int32_t>>(*rq.req, "max_bytes")};
 
-    auto group_shard{consumer_shard(group_id)};
+    auto group_shard{consumer_shard(group_id, name)};
     auto handler =
       [_group_id{std::move(group_id)},
        _name{std::move(name)},
@@ -444,7 +487,7 @@ get_consumer_offsets(server::request_t rq, server::reply_t rp) {
     auto req_data = ppj::partitions_request_to_offset_request(ppj::rjson_parse(
       rq.req->content.data(), ppj::partitions_request_handler()));
 
-    auto group_shard{consumer_shard(group_id)};
+    auto group_shard{consumer_shard(group_id, member_id)};
     auto handler =
       [_group_id{std::move(group_id)},
        _member_id{std::move(member_id)},
@@ -497,7 +540,7 @@ post_consumer_offsets(server::request_t rq, server::reply_t rp) {
                           rq.req->content.data(),
                           ppj::partition_offsets_request_handler()));
 
-    auto group_shard{consumer_shard(group_id)};
+    auto group_shard{consumer_shard(group_id, member_id)};
     auto handler =
       [_group_id{std::move(group_id)},
        _member_id{std::move(member_id)},
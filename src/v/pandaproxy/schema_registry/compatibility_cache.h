@@ -0,0 +1,113 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "pandaproxy/schema_registry/types.h"
+#include "seastarx.h"
+#include "units.h"
+
+#include <seastar/core/future.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <optional>
+#include <utility>
+
+namespace pandaproxy::schema_registry {
+
+///\brief Results of the compatibility checks of schemas against registered
+/// schemas.
+///
+/// A check only depends on the two definitions: the registered one is
+/// identified by its id, the checked one by its definition and references
+/// as it may not be registered. Results are kept per direction of the check
+/// so they are shared across compatibility levels, e.g. FULL reuses the
+/// results of BACKWARD and FORWARD.
+class compatibility_cache {
+public:
+    ///\brief Which schema reads the data written with the other one.
+    enum class direction {
+        // the checked schema reads the registered one
+        backward = 0,
+        // the registered schema reads the checked one
+        forward,
+    };
+
+    ss::future<> stop() { return ss::now(); }
+
+    std::optional<bool> get(
+      const canonical_schema& schema, schema_id registered, direction dir) {
+        auto it = _entries.find(fingerprint(schema.def()));
+        if (it == _entries.end() || !it->second.matches(schema)) {
+            return std::nullopt;
+        }
+        auto r_it = it->second.results.find({registered, dir});
+        if (r_it == it->second.results.end()) {
+            return std::nullopt;
+        }
+        return r_it->second;
+    }
+
+    void put(
+      const canonical_schema& schema,
+      schema_id registered,
+      direction dir,
+      bool compatible) {
+        const auto size = schema.def().raw()().size();
+        if (size > max_bytes / 4) {
+            return;
+        }
+        auto fp = fingerprint(schema.def());
+        auto it = _entries.find(fp);
+        if (it != _entries.end() && !it->second.matches(schema)) {
+            _bytes -= it->second.def.raw()().size();
+            _entries.erase(it);
+            it = _entries.end();
+        }
+        if (it == _entries.end()) {
+            if (_bytes + size > max_bytes) {
+                clear();
+            }
+            it = _entries.emplace(fp, entry{schema.def(), schema.refs(), {}})
+                   .first;
+            _bytes += size;
+        }
+        it->second.results.insert_or_assign({registered, dir}, compatible);
+    }
+
+    ///\brief Forget all the results, e.g. when schemas are deleted.
+    void clear() {
+        _entries.clear();
+        _bytes = 0;
+    }
+
+    size_t size() const { return _entries.size(); }
+
+private:
+    // bytes of checked definitions
+    static constexpr size_t max_bytes = 4_MiB;
+
+    struct entry {
+        bool matches(const canonical_schema& schema) const {
+            return def == schema.def() && refs == schema.refs();
+        }
+
+        canonical_schema_definition def;
+        canonical_schema::references refs;
+        absl::flat_hash_map<std::pair<schema_id, direction>, bool> results;
+    };
+
+    absl::flat_hash_map<schema_fingerprint, entry> _entries;
+    size_t _bytes{0};
+};
+
+} // namespace pandaproxy::schema_registry
@@ -25,9 +25,12 @@
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/loop.hh>
 #include <seastar/core/smp.hh>
 #include <seastar/core/std-coroutine.hh>
 
+#include <boost/range/irange.hpp>
+
 #include <functional>
 
 namespace pandaproxy::schema_registry {
@@ -58,13 +61,31 @@ bool check_compatible(const valid_schema& reader, const valid_schema& writer) {
 
 ss::future<> sharded_store::start(ss::smp_service_group sg) {
     _smp_opts = ss::smp_submit_to_options{sg};
-    return _store.start();
+    return _store.start().then([this] { return _compat_cache.start(); });
 }
 
-ss::future<> sharded_store::stop() { return _store.stop(); }
+ss::future<> sharded_store::stop() {
+    return _compat_cache.stop().then([this] { return _store.stop(); });
+}
 
 ss::future<canonical_schema>
 sharded_store::make_canonical_schema(unparsed_schema schema) {
+    // Producers register the same schemas over and over, don't parse them
+    // every time.
+    const auto fp = fingerprint(schema);
+    if (auto def = _store.local().get_canonical(fp, schema); def) {
+        co_return canonical_schema{
+          std::move(schema).sub(), std::move(*def), std::move(schema).refs()};
+    }
+
+    auto unparsed = schema;
+    auto canonical = co_await do_make_canonical_schema(std::move(schema));
+    _store.local().cache_canonical(fp, unparsed, canonical.def());
+    co_return canonical;
+}
+
+ss::future<canonical_schema>
+sharded_store::do_make_canonical_schema(unparsed_schema schema) {
     switch (schema.type()) {
     case schema_type::avro: {
         co_return canonical_schema{
@@ -115,6 +136,24 @@ sharded_store::make_valid_schema(canonical_schema schema) {
 
 ss::future<sharded_store::insert_result>
 sharded_store::project_ids(canonical_schema schema) {
+    auto sub_shard{shard_for(schema.sub())};
+
+    // A schema the subject already has was validated when it was registered
+    auto s_id = co_await get_schema_id(schema.def());
+    if (s_id) {
+        auto v_id = co_await _store.invoke_on(
+          sub_shard,
+          _smp_opts,
+          [sub{schema.sub()}, id{s_id.value()}](store& s) {
+              return s.project_version(sub, id);
+          });
+        if (!v_id) {
+            vlog(plog.debug, "project_ids: existing ID {}", s_id.value());
+            co_return insert_result{
+              invalid_schema_version, s_id.value(), false};
+        }
+    }
+
     // Validate the schema (may throw)
     co_await validate_schema(schema);
 
@@ -139,14 +178,6 @@ sharded_store::project_ids(canonical_schema schema) {
         }
     }
 
-    // Figure out if the definition already exists
-    auto map = [&schema](store& s) { return s.get_schema_id(schema.def()); };
-    auto reduce = [](
-                    std::optional<schema_id> acc,
-                    std::optional<schema_id> s_id) { return acc ? acc : s_id; };
-    auto s_id = co_await _store.map_reduce0(
-      map, std::optional<schema_id>{}, reduce);
-
     if (!s_id) {
         // New schema, project an ID for it.
         s_id = co_await project_schema_id();
@@ -155,7 +186,6 @@ sharded_store::project_ids(canonical_schema schema) {
         vlog(plog.debug, "project_ids: existing ID {}", s_id.value());
     }
 
-    auto sub_shard{shard_for(schema.sub())};
     auto v_id = co_await _store.invoke_on(
       sub_shard, _smp_opts, [sub{schema.sub()}, id{s_id.value()}](store& s) {
           return s.project_version(sub, id);
@@ -181,9 +211,115 @@ ss::future<bool> sharded_store::upsert(
       deleted);
 }
 
+ss::future<> sharded_store::upsert(std::vector<upsert_entry> entries) {
+    if (entries.empty()) {
+        co_return;
+    }
+
+    struct subject_upsert {
+        seq_marker marker;
+        subject sub;
+        canonical_schema::references refs;
+        schema_version version;
+        schema_id id;
+        is_deleted deleted;
+    };
+
+    // Group the updates by shard, keeping their order
+    std::vector<std::vector<std::pair<schema_id, canonical_schema_definition>>>
+      schemas(ss::smp::count);
+    std::vector<std::vector<subject_upsert>> subjects(ss::smp::count);
+    std::vector<std::pair<schema_fingerprint, schema_id>> fingerprints;
+    fingerprints.reserve(entries.size());
+    schema_id max_id{entries.front().id};
+    auto deleted = is_deleted::no;
+    for (auto& e : entries) {
+        max_id = std::max(max_id, e.id);
+        deleted = deleted || e.deleted;
+        fingerprints.emplace_back(fingerprint(e.schema.def()), e.id);
+        auto sub_shard{shard_for(e.schema.sub())};
+        subjects[sub_shard].push_back(subject_upsert{
+          .marker = e.marker,
+          .sub = std::move(e.schema).sub(),
+          .refs = std::move(e.schema).refs(),
+          .version = e.version,
+          .id = e.id,
+          .deleted = e.deleted});
+        schemas[shard_for(e.id)].emplace_back(e.id, std::move(e.schema).def());
+    }
+    entries.clear();
+
+    co_await maybe_update_max_schema_id(max_id);
+    co_await ss::parallel_for_each(
+      boost::irange<ss::shard_id>(0, ss::smp::count),
+      [this, &schemas](ss::shard_id shard) {
+          if (schemas[shard].empty()) {
+              return ss::now();
+          }
+          return _store.invoke_on(
+            shard,
+            _smp_opts,
+            [defs{std::move(schemas[shard])}](store& s) mutable {
+                for (auto& [id, def] : defs) {
+                    s.upsert_schema(id, std::move(def));
+                }
+            });
+      });
+    co_await _store.invoke_on_all(_smp_opts, [&fingerprints](store& s) {
+        for (const auto& [fp, id] : fingerprints) {
+            s.index_schema(fp, id);
+        }
+    });
+    co_await ss::parallel_for_each(
+      boost::irange<ss::shard_id>(0, ss::smp::count),
+      [this, &subjects](ss::shard_id shard) {
+          if (subjects[shard].empty()) {
+              return ss::now();
+          }
+          return _store.invoke_on(
+            shard,
+            _smp_opts,
+            [upserts{std::move(subjects[shard])}](store& s) mutable {
+                for (auto& u : upserts) {
+                    s.upsert_subject(
+                      u.marker,
+                      std::move(u.sub),
+                      std::move(u.refs),
+                      u.version,
+                      u.id,
+                      u.deleted);
+                }
+            });
+      });
+    if (deleted) {
+        co_await clear_compatibility_cache();
+    }
+}
+
 ss::future<subject_schema> sharded_store::has_schema(canonical_schema schema) {
     auto versions = co_await get_versions(schema.sub(), include_deleted::no);
 
+    // A schema that is registered was validated when it was registered
+    if (auto s_id = co_await get_schema_id(schema.def()); s_id) {
+        auto entries = co_await _store.invoke_on(
+          shard_for(schema.sub()), _smp_opts, [sub{schema.sub()}](store& s) {
+              return s.get_version_ids(sub, include_deleted::no).value();
+          });
+        for (auto& e : entries) {
+            if (e.id == s_id.value() && !e.deleted) {
+                canonical_schema found{
+                  std::move(schema).sub(),
+                  std::move(schema).def(),
+                  std::move(e.refs)};
+                co_return subject_schema{
+                  .schema = std::move(found),
+                  .version = e.version,
+                  .id = e.id,
+                  .deleted = e.deleted};
+            }
+        }
+    }
+
     try {
         co_await validate_schema(schema);
     } catch (const exception& e) {
@@ -311,10 +447,12 @@ ss::future<std::vector<schema_id>> sharded_store::referenced_by(
 ss::future<std::vector<schema_version>> sharded_store::delete_subject(
   seq_marker marker, subject sub, permanent_delete permanent) {
     auto sub_shard{shard_for(sub)};
-    co_return co_await _store.invoke_on(
+    auto versions = co_await _store.invoke_on(
       sub_shard, _smp_opts, [marker, sub{std::move(sub)}, permanent](store& s) {
           return s.delete_subject(marker, sub, permanent).value();
       });
+    co_await clear_compatibility_cache();
+    co_return versions;
 }
 
 ss::future<is_deleted> sharded_store::is_subject_deleted(subject sub) {
@@ -355,10 +493,12 @@ sharded_store::get_subject_version_written_at(subject sub, schema_version ver) {
 ss::future<bool>
 sharded_store::delete_subject_version(subject sub, schema_version ver) {
     auto sub_shard{shard_for(sub)};
-    co_return co_await _store.invoke_on(
+    auto deleted = co_await _store.invoke_on(
       sub_shard, _smp_opts, [sub{std::move(sub)}, ver](store& s) {
           return s.delete_subject_version(sub, ver).value();
       });
+    co_await clear_compatibility_cache();
+    co_return deleted;
 }
 
 ss::future<compatibility_level> sharded_store::get_compatibility() {
@@ -405,10 +545,29 @@ ss::future<bool> sharded_store::clear_compatibility(subject sub) {
 ss::future<bool>
 sharded_store::upsert_schema(schema_id id, canonical_schema_definition def) {
     co_await maybe_update_max_schema_id(id);
-    co_return co_await _store.invoke_on(
+    const auto fp = fingerprint(def);
+    auto upserted = co_await _store.invoke_on(
       shard_for(id), _smp_opts, [id, def{std::move(def)}](store& s) mutable {
           return s.upsert_schema(id, std::move(def));
       });
+    co_await _store.invoke_on_all(
+      _smp_opts, [fp, id](store& s) { s.index_schema(fp, id); });
+    co_return upserted;
+}
+
+ss::future<std::optional<schema_id>>
+sharded_store::get_schema_id(const canonical_schema_definition& def) {
+    for (auto id : _store.local().get_schema_ids(fingerprint(def))) {
+        auto matches = co_await _store.invoke_on(
+          shard_for(id), _smp_opts, [id, &def](store& s) {
+              auto stored = s.get_schema_definition(id);
+              return stored.has_value() && stored.value() == def;
+          });
+        if (matches) {
+            co_return id;
+        }
+    }
+    co_return std::nullopt;
 }
 
 ss::future<sharded_store::insert_subject_result> sharded_store::insert_subject(
@@ -431,7 +590,7 @@ ss::future<bool> sharded_store::upsert_subject(
   schema_id id,
   is_deleted deleted) {
     auto sub_shard{shard_for(sub)};
-    co_return co_await _store.invoke_on(
+    auto upserted = co_await _store.invoke_on(
       sub_shard,
       _smp_opts,
       [marker,
@@ -443,6 +602,10 @@ ss::future<bool> sharded_store::upsert_subject(
           return s.upsert_subject(
             marker, std::move(sub), std::move(refs), version, id, deleted);
       });
+    if (deleted) {
+        co_await clear_compatibility_cache();
+    }
+    co_return upserted;
 }
 
 /// \brief Get the schema ID to be used for next insert
@@ -525,7 +688,29 @@ ss::future<bool> sharded_store::is_compatible(
         ver_it = versions.begin();
     }
 
-    auto new_valid = co_await make_valid_schema(new_schema);
+    auto check_backward = false;
+    if (
+      compat == compatibility_level::backward
+      || compat == compatibility_level::backward_transitive
+      || compat == compatibility_level::full
+      || compat == compatibility_level::full_transitive) {
+        check_backward = true;
+    }
+    auto check_forward = false;
+    if (
+      compat == compatibility_level::forward
+      || compat == compatibility_level::forward_transitive
+      || compat == compatibility_level::full
+      || compat == compatibility_level::full_transitive) {
+        check_forward = true;
+    }
+
+    // The results of the checks against every version are cached, e.g. for
+    // transitive levels most of the versions are the same from one check to
+    // the next. Schemas are only parsed when a result is missing.
+    using direction = compatibility_cache::direction;
+    auto& cache = _compat_cache.local();
+    std::optional<valid_schema> new_valid;
 
     auto is_compat = true;
     for (; is_compat && ver_it != versions.end(); ++ver_it) {
@@ -533,26 +718,41 @@ ss::future<bool> sharded_store::is_compatible(
             continue;
         }
 
-        auto old_schema = co_await get_subject_schema(
-          sub, ver_it->version, include_deleted::no);
-        auto old_valid = co_await make_valid_schema(old_schema.schema);
-
-        if (
-          compat == compatibility_level::backward
-          || compat == compatibility_level::backward_transitive
-          || compat == compatibility_level::full
-          || compat == compatibility_level::full_transitive) {
-            is_compat = is_compat && check_compatible(new_valid, old_valid);
+        std::optional<bool> backward{true};
+        if (check_backward) {
+            backward = cache.get(new_schema, ver_it->id, direction::backward);
         }
-        if (
-          compat == compatibility_level::forward
-          || compat == compatibility_level::forward_transitive
-          || compat == compatibility_level::full
-          || compat == compatibility_level::full_transitive) {
-            is_compat = is_compat && check_compatible(old_valid, new_valid);
+        std::optional<bool> forward{true};
+        if (check_forward) {
+            forward = cache.get(new_schema, ver_it->id, direction::forward);
         }
+
+        if (!backward || (*backward && !forward)) {
+            if (!new_valid) {
+                new_valid.emplace(co_await make_valid_schema(new_schema));
+            }
+            auto old_schema = co_await get_subject_schema(
+              sub, ver_it->version, include_deleted::no);
+            auto old_valid = co_await make_valid_schema(old_schema.schema);
+
+            if (!backward) {
+                backward = check_compatible(*new_valid, old_valid);
+                cache.put(
+                  new_schema, ver_it->id, direction::backward, *backward);
+            }
+            if (*backward && !forward) {
+                forward = check_compatible(old_valid, *new_valid);
+                cache.put(new_schema, ver_it->id, direction::forward, *forward);
+            }
+        }
+        is_compat = *backward && *forward;
     }
     co_return is_compat;
 }
 
+ss::future<> sharded_store::clear_compatibility_cache() {
+    return _compat_cache.invoke_on_all(
+      _smp_opts, [](compatibility_cache& c) { c.clear(); });
+}
+
 } // namespace pandaproxy::schema_registry
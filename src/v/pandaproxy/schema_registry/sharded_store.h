@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "pandaproxy/schema_registry/compatibility_cache.h"
 #include "pandaproxy/schema_registry/types.h"
 
 #include <seastar/core/sharded.hh>
@@ -50,6 +51,20 @@ public:
       schema_version version,
       is_deleted deleted);
 
+    struct upsert_entry {
+        seq_marker marker;
+        canonical_schema schema;
+        schema_id id;
+        schema_version version;
+        is_deleted deleted;
+    };
+
+    ///\brief Upsert schemas in bulk, in order.
+    ///
+    /// Equivalent to upserting them one by one, with a single hop per shard
+    /// rather than per schema, e.g. to replay the schemas topic.
+    ss::future<> upsert(std::vector<upsert_entry> entries);
+
     ss::future<subject_schema> has_schema(canonical_schema schema);
 
     ///\brief Return a schema definition by id.
@@ -121,13 +136,23 @@ public:
     ///
     /// If the compatibility level is transitive, then all versions are checked,
     /// otherwise checks are against the version provided and newer.
+    ///
+    /// The results of the checks against each version are cached until a
+    /// subject or a version is deleted.
     ss::future<bool>
     is_compatible(schema_version version, canonical_schema new_schema);
 
 private:
+    ss::future<canonical_schema>
+    do_make_canonical_schema(unparsed_schema schema);
+
     ss::future<bool>
     upsert_schema(schema_id id, canonical_schema_definition def);
 
+    ///\brief Find the id of a definition through the fingerprint index.
+    ss::future<std::optional<schema_id>>
+    get_schema_id(const canonical_schema_definition& def);
+
     struct insert_subject_result {
         schema_version version;
         bool inserted;
@@ -147,8 +172,12 @@ private:
 
     ss::future<schema_id> project_schema_id();
 
+    ///\brief Clear the compatibility results, on every shard.
+    ss::future<> clear_compatibility_cache();
+
     ss::smp_submit_to_options _smp_opts;
     ss::sharded<store> _store;
+    ss::sharded<compatibility_cache> _compat_cache;
 
     ///\brief Access must occur only on shard 0.
     schema_id _next_schema_id{1};
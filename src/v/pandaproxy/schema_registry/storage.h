@@ -1113,17 +1113,126 @@ struct consume_to_store {
 
     ss::future<ss::stop_iteration> operator()(model::record_batch b) {
         if (!b.header().attrs.is_control()) {
+            // Schemas are upserted in bulk per batch, and the offset is
+            // advanced once per batch, to avoid a round of cross shard hops
+            // per record when replaying the topic.
             auto base_offset = b.base_offset();
             co_await model::for_each_record(
               b, [this, base_offset](model::record& rec) {
                   auto offset = base_offset + model::offset(rec.offset_delta());
-                  return (*this)(std::move(rec), offset);
+                  return consume(std::move(rec), offset);
               });
+            co_await flush();
+            co_await _sequencer.advance_offset(b.last_offset());
         }
         co_return ss::stop_iteration::no;
     }
 
     ss::future<> operator()(model::record record, model::offset offset) {
+        co_await consume(std::move(record), offset);
+        co_await flush();
+        co_await _sequencer.advance_offset(offset);
+    }
+
+    ss::future<> apply(
+      model::offset offset, schema_key key, std::optional<schema_value> val) {
+        co_await enqueue(offset, std::move(key), std::move(val));
+        co_await flush();
+    }
+
+    ss::future<> apply(
+      model::offset offset, config_key key, std::optional<config_value> val) {
+        // Drop out-of-sequence messages
+        //
+        // Check seq if it was provided, otherwise assume 3rdparty
+        // compatibility, which can't collide.
+        if (val && key.seq.has_value() && offset != key.seq) {
+            vlog(
+              plog.debug,
+              "Ignoring out of order {} (at offset {})",
+              key,
+              offset);
+            co_return;
+        }
+
+        if (key.magic != 0) {
+            throw exception(
+              error_code::topic_parse_error,
+              fmt::format("Unexpected magic: {}", key));
+        }
+        try {
+            vlog(plog.debug, "Applying: {}", key);
+            if (!val) {
+                co_await _store.clear_compatibility(*key.sub);
+            } else if (key.sub) {
+                co_await _store.set_compatibility(
+                  seq_marker{
+                    .seq = key.seq,
+                    .node = key.node,
+                    .version{invalid_schema_version}, // Not applicable
+                    .key_type = seq_marker_key_type::config},
+                  *key.sub,
+                  val->compat);
+            } else {
+                co_await _store.set_compatibility(val->compat);
+            }
+        } catch (const exception& e) {
+            vlog(plog.debug, "Error replaying: {}: {}", key, e);
+        }
+    }
+
+    ss::future<> apply(
+      model::offset offset,
+      delete_subject_key key,
+      std::optional<delete_subject_value> val) {
+        // Out-of-place events happen when two writers collide.  First
+        // writer wins: disregard subsequent events whose seq field
+        // doesn't match their actually offset.
+        //
+        // Check seq if it was provided, otherwise assume 3rdparty
+        // compatibility, which can't collide.
+        if (val && key.seq.has_value() && offset != key.seq) {
+            vlog(
+              plog.debug,
+              "Ignoring out of order {} (at offset {})",
+              key,
+              offset);
+            co_return;
+        }
+
+        if (!val.has_value()) {
+            // Tombstones for a delete_subject (soft deletion) aren't
+            // meaningful, and only exist to release space in the topic. The
+            // actual removal of subjects/versions happens on hard delete, i.e.
+            // the tombstone for the schema/version itself, not the tombstone
+            // for the soft deletion.
+            vlog(plog.debug, "Ignoring delete_subject tombstone at {}", offset);
+            co_return;
+        }
+
+        if (key.magic != 0) {
+            throw exception(
+              error_code::topic_parse_error,
+              fmt::format("Unexpected magic: {}", key));
+        }
+        try {
+            vlog(plog.debug, "Applying: {}", key);
+            co_await _store.delete_subject(
+              seq_marker{
+                .seq = key.seq,
+                .node = key.node,
+                .version{invalid_schema_version}, // Not applicable
+                .key_type = seq_marker_key_type::delete_subject},
+              key.sub,
+              permanent_delete::no);
+        } catch (const exception& e) {
+            vlog(plog.debug, "Error replaying: {}: {}", key, e);
+        }
+    }
+    void end_of_stream() {}
+
+private:
+    ss::future<> consume(model::record record, model::offset offset) {
         auto key = record.release_key();
         auto key_type_str = from_json_iobuf<topic_key_type_handler<>>(
           key.share(0, key.size_bytes()));
@@ -1131,7 +1240,6 @@ struct consume_to_store {
         auto key_type = from_string_view<topic_key_type>(key_type_str);
         if (!key_type.has_value()) {
             vlog(plog.error, "Ignoring keytype: {}", key_type_str);
-            co_await _sequencer.advance_offset(offset);
             co_return;
         }
 
@@ -1144,7 +1252,7 @@ struct consume_to_store {
                 val.emplace(from_json_iobuf<schema_value_handler<>>(
                   record.release_value()));
             }
-            co_await apply(
+            co_await enqueue(
               offset,
               from_json_iobuf<schema_key_handler<>>(std::move(key)),
               std::move(val));
@@ -1157,6 +1265,7 @@ struct consume_to_store {
                 val.emplace(
                   from_json_iobuf<config_value_handler<>>(std::move(value)));
             }
+            co_await flush();
             co_await apply(
               offset,
               from_json_iobuf<config_key_handler<>>(std::move(key)),
@@ -1170,17 +1279,18 @@ struct consume_to_store {
                   record.release_value()));
             }
 
+            co_await flush();
             co_await apply(
               offset,
               from_json_iobuf<delete_subject_key_handler<>>(std::move(key)),
               std::move(val));
             break;
         }
-
-        co_await _sequencer.advance_offset(offset);
     }
 
-    ss::future<> apply(
+    ///\brief Queue a schema for the next flush(), tombstones are applied
+    /// immediately after the queued schemas.
+    ss::future<> enqueue(
       model::offset offset, schema_key key, std::optional<schema_value> val) {
         if (key.magic != 0 && key.magic != 1) {
             throw exception(
@@ -1212,6 +1322,7 @@ struct consume_to_store {
               !val.has_value(),
               offset);
             if (!val) {
+                co_await flush();
                 try {
                     co_await _store.delete_subject_version(
                       key.sub, key.version);
@@ -1234,114 +1345,38 @@ struct consume_to_store {
                     }
                 }
             } else {
-                co_await _store.upsert(
-                  seq_marker{
+                _pending.push_back(sharded_store::upsert_entry{
+                  .marker = seq_marker{
                     .seq = key.seq,
                     .node = key.node,
                     .version = val->version,
                     .key_type = seq_marker_key_type::schema},
-                  std::move(val->schema),
-                  val->id,
-                  val->version,
-                  val->deleted);
+                  .schema = std::move(val->schema),
+                  .id = val->id,
+                  .version = val->version,
+                  .deleted = val->deleted});
             }
         } catch (const exception& e) {
             vlog(plog.debug, "Error replaying: {}: {}", key, e.what());
         }
     }
 
-    ss::future<> apply(
-      model::offset offset, config_key key, std::optional<config_value> val) {
-        // Drop out-of-sequence messages
-        //
-        // Check seq if it was provided, otherwise assume 3rdparty
-        // compatibility, which can't collide.
-        if (val && key.seq.has_value() && offset != key.seq) {
-            vlog(
-              plog.debug,
-              "Ignoring out of order {} (at offset {})",
-              key,
-              offset);
+    ss::future<> flush() {
+        if (_pending.empty()) {
             co_return;
         }
-
-        if (key.magic != 0) {
-            throw exception(
-              error_code::topic_parse_error,
-              fmt::format("Unexpected magic: {}", key));
-        }
+        auto pending = std::exchange(_pending, {});
+        const auto count = pending.size();
         try {
-            vlog(plog.debug, "Applying: {}", key);
-            if (!val) {
-                co_await _store.clear_compatibility(*key.sub);
-            } else if (key.sub) {
-                co_await _store.set_compatibility(
-                  seq_marker{
-                    .seq = key.seq,
-                    .node = key.node,
-                    .version{invalid_schema_version}, // Not applicable
-                    .key_type = seq_marker_key_type::config},
-                  *key.sub,
-                  val->compat);
-            } else {
-                co_await _store.set_compatibility(val->compat);
-            }
+            co_await _store.upsert(std::move(pending));
         } catch (const exception& e) {
-            vlog(plog.debug, "Error replaying: {}: {}", key, e);
+            vlog(plog.debug, "Error replaying {} schemas: {}", count, e.what());
         }
     }
 
-    ss::future<> apply(
-      model::offset offset,
-      delete_subject_key key,
-      std::optional<delete_subject_value> val) {
-        // Out-of-place events happen when two writers collide.  First
-        // writer wins: disregard subsequent events whose seq field
-        // doesn't match their actually offset.
-        //
-        // Check seq if it was provided, otherwise assume 3rdparty
-        // compatibility, which can't collide.
-        if (val && key.seq.has_value() && offset != key.seq) {
-            vlog(
-              plog.debug,
-              "Ignoring out of order {} (at offset {})",
-              key,
-              offset);
-            co_return;
-        }
-
-        if (!val.has_value()) {
-            // Tombstones for a delete_subject (soft deletion) aren't
-            // meaningful, and only exist to release space in the topic. The
-            // actual removal of subjects/versions happens on hard delete, i.e.
-            // the tombstone for the schema/version itself, not the tombstone
-            // for the soft deletion.
-            vlog(plog.debug, "Ignoring delete_subject tombstone at {}", offset);
-            co_return;
-        }
-
-        if (key.magic != 0) {
-            throw exception(
-              error_code::topic_parse_error,
-              fmt::format("Unexpected magic: {}", key));
-        }
-        try {
-            vlog(plog.debug, "Applying: {}", key);
-            co_await _store.delete_subject(
-              seq_marker{
-                .seq = key.seq,
-                .node = key.node,
-                .version{invalid_schema_version}, // Not applicable
-                .key_type = seq_marker_key_type::delete_subject},
-              key.sub,
-              permanent_delete::no);
-        } catch (const exception& e) {
-            vlog(plog.debug, "Error replaying: {}: {}", key, e);
-        }
-    }
-    void end_of_stream() {}
     sharded_store& _store;
     seq_writer& _sequencer;
+    std::vector<sharded_store::upsert_entry> _pending;
 };
 
 } // namespace pandaproxy::schema_registry
@@ -15,8 +15,10 @@
 #include "pandaproxy/schema_registry/error.h"
 #include "pandaproxy/schema_registry/errors.h"
 #include "pandaproxy/schema_registry/types.h"
+#include "units.h"
 
 #include <absl/container/btree_map.h>
+#include <absl/container/flat_hash_map.h>
 #include <absl/container/node_hash_map.h>
 
 namespace pandaproxy::schema_registry {
@@ -532,7 +534,69 @@ public:
         return !found;
     }
 
+    ///\brief Index a schema by the fingerprint of its definition.
+    ///
+    /// The index is replicated to every shard, while the schema is only
+    /// stored on the shard of its id.
+    void index_schema(schema_fingerprint fp, schema_id id) {
+        auto& ids = _fingerprints[fp];
+        if (std::find(ids.begin(), ids.end(), id) == ids.end()) {
+            ids.push_back(id);
+        }
+    }
+
+    ///\brief Return the ids of the schemas with the fingerprint.
+    ///
+    /// Fingerprints may collide, the definitions must be compared.
+    std::vector<schema_id> get_schema_ids(schema_fingerprint fp) const {
+        auto it = _fingerprints.find(fp);
+        return it == _fingerprints.end() ? std::vector<schema_id>{}
+                                         : it->second;
+    }
+
+    ///\brief Return the canonical definition of a schema made before.
+    std::optional<canonical_schema_definition>
+    get_canonical(schema_fingerprint fp, const unparsed_schema& schema) const {
+        auto it = _canonical_cache.find(fp);
+        if (
+          it == _canonical_cache.end() || it->second.def != schema.def()
+          || it->second.refs != schema.refs()) {
+            return std::nullopt;
+        }
+        return it->second.canonical;
+    }
+
+    ///\brief Cache the canonical definition of a schema.
+    void cache_canonical(
+      schema_fingerprint fp,
+      const unparsed_schema& schema,
+      const canonical_schema_definition& canonical) {
+        const auto size = schema.def().raw()().size()
+                          + canonical.raw()().size();
+        if (size > max_canonical_cache_bytes / 4) {
+            return;
+        }
+        if (_canonical_cache_bytes + size > max_canonical_cache_bytes) {
+            _canonical_cache.clear();
+            _canonical_cache_bytes = 0;
+        }
+        auto [it, inserted] = _canonical_cache.try_emplace(
+          fp, canonical_entry{schema.def(), schema.refs(), canonical});
+        if (inserted) {
+            _canonical_cache_bytes += size;
+        }
+    }
+
 private:
+    // bytes of definitions in the canonical cache
+    static constexpr size_t max_canonical_cache_bytes = 4_MiB;
+
+    struct canonical_entry {
+        unparsed_schema_definition def;
+        unparsed_schema::references refs;
+        canonical_schema_definition canonical;
+    };
+
     struct schema_entry {
         explicit schema_entry(canonical_schema_definition definition)
           : definition{std::move(definition)} {}
@@ -605,6 +669,10 @@ private:
 
     schema_map _schemas;
     subject_map _subjects;
+    absl::flat_hash_map<schema_fingerprint, std::vector<schema_id>>
+      _fingerprints;
+    absl::flat_hash_map<schema_fingerprint, canonical_entry> _canonical_cache;
+    size_t _canonical_cache_bytes{0};
     compatibility_level _compatibility{compatibility_level::backward};
 };
 
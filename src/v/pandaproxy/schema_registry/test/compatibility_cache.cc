@@ -0,0 +1,58 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "pandaproxy/schema_registry/compatibility_cache.h"
+
+#include "pandaproxy/schema_registry/types.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace pps = pandaproxy::schema_registry;
+
+using direction = pps::compatibility_cache::direction;
+
+const pps::subject sub{"sub"};
+const pps::canonical_schema string_schema{
+  sub,
+  pps::canonical_schema_definition{
+    R"({"type":"string"})", pps::schema_type::avro}};
+const pps::canonical_schema int_schema{
+  sub,
+  pps::canonical_schema_definition{
+    R"({"type":"int"})", pps::schema_type::avro}};
+
+BOOST_AUTO_TEST_CASE(test_compatibility_cache_get_put) {
+    pps::compatibility_cache cache;
+    const pps::schema_id id1{1};
+    const pps::schema_id id2{2};
+
+    BOOST_REQUIRE(!cache.get(string_schema, id1, direction::backward));
+
+    cache.put(string_schema, id1, direction::backward, true);
+    cache.put(string_schema, id1, direction::forward, false);
+    cache.put(int_schema, id1, direction::backward, false);
+    BOOST_REQUIRE_EQUAL(cache.size(), 2);
+
+    BOOST_REQUIRE(cache.get(string_schema, id1, direction::backward).value());
+    BOOST_REQUIRE(!cache.get(string_schema, id1, direction::forward).value());
+    BOOST_REQUIRE(!cache.get(int_schema, id1, direction::backward).value());
+    BOOST_REQUIRE(!cache.get(int_schema, id1, direction::forward));
+    BOOST_REQUIRE(!cache.get(string_schema, id2, direction::backward));
+
+    // The references are part of the checked schema
+    const pps::canonical_schema with_refs{
+      sub,
+      string_schema.def(),
+      {{"ref", pps::subject{"other"}, pps::schema_version{1}}}};
+    BOOST_REQUIRE(!cache.get(with_refs, id1, direction::backward));
+
+    cache.clear();
+    BOOST_REQUIRE_EQUAL(cache.size(), 0);
+    BOOST_REQUIRE(!cache.get(string_schema, id1, direction::backward));
+}
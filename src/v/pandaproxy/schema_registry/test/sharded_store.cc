@@ -64,3 +64,110 @@ SEASTAR_THREAD_TEST_CASE(test_sharded_store_referenced_by) {
     BOOST_REQUIRE_EQUAL(referenced_by.size(), 1);
     BOOST_REQUIRE_EQUAL(referenced_by[0], pps::schema_id{2});
 }
+
+SEASTAR_THREAD_TEST_CASE(test_sharded_store_fingerprint_lookup) {
+    pps::sharded_store store;
+    store.start(ss::default_smp_service_group()).get();
+    auto stop_store = ss::defer([&store]() { store.stop().get(); });
+
+    const pps::schema_version ver1{1};
+    const pps::schema_id id1{1};
+
+    auto unparsed = pps::unparsed_schema{
+      pps::subject{"sub"},
+      pps::unparsed_schema_definition{
+        R"({"type": "string"})", pps::schema_type::avro}};
+    auto schema = store.make_canonical_schema(unparsed).get();
+    // Made from the cache
+    BOOST_REQUIRE_EQUAL(store.make_canonical_schema(unparsed).get(), schema);
+
+    store
+      .upsert(
+        pps::seq_marker{
+          std::nullopt, std::nullopt, ver1, pps::seq_marker_key_type::schema},
+        schema,
+        id1,
+        ver1,
+        pps::is_deleted::no)
+      .get();
+
+    auto sub_schema = store.has_schema(schema).get();
+    BOOST_REQUIRE_EQUAL(sub_schema.id, id1);
+    BOOST_REQUIRE_EQUAL(sub_schema.version, ver1);
+
+    // Already registered in the subject
+    auto projected = store.project_ids(schema).get();
+    BOOST_REQUIRE(!projected.inserted);
+    BOOST_REQUIRE_EQUAL(projected.id, id1);
+
+    // Registered in another subject, under the same id
+    auto other = pps::canonical_schema{pps::subject{"other"}, schema.def()};
+    projected = store.project_ids(other).get();
+    BOOST_REQUIRE(projected.inserted);
+    BOOST_REQUIRE_EQUAL(projected.id, id1);
+    BOOST_REQUIRE_EQUAL(projected.version, ver1);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_sharded_store_bulk_upsert) {
+    pps::sharded_store store;
+    store.start(ss::default_smp_service_group()).get();
+    auto stop_store = ss::defer([&store]() { store.stop().get(); });
+
+    auto make_entry = [](
+                        std::string_view sub,
+                        std::string_view def,
+                        pps::schema_id id,
+                        pps::schema_version ver) {
+        return pps::sharded_store::upsert_entry{
+          .marker = pps::seq_marker{
+            std::nullopt, std::nullopt, ver, pps::seq_marker_key_type::schema},
+          .schema = pps::canonical_schema{
+            pps::subject{ss::sstring{sub}},
+            pps::canonical_schema_definition{
+              ss::sstring{def}, pps::schema_type::avro}},
+          .id = id,
+          .version = ver,
+          .deleted = pps::is_deleted::no};
+    };
+
+    const pps::schema_version ver1{1};
+    const pps::schema_version ver2{2};
+    std::vector<pps::sharded_store::upsert_entry> entries;
+    entries.push_back(make_entry(
+      "sub0", R"({"type":"string"})", pps::schema_id{1}, ver1));
+    entries.push_back(
+      make_entry("sub1", R"({"type":"int"})", pps::schema_id{2}, ver1));
+    entries.push_back(make_entry(
+      "sub0", R"({"type":"long"})", pps::schema_id{3}, ver2));
+    store.upsert(std::move(entries)).get();
+
+    auto versions = store
+                      .get_versions(
+                        pps::subject{"sub0"}, pps::include_deleted::no)
+                      .get();
+    BOOST_REQUIRE_EQUAL(versions.size(), 2);
+    auto sub_schema = store
+                        .get_subject_schema(
+                          pps::subject{"sub0"},
+                          ver2,
+                          pps::include_deleted::no)
+                        .get();
+    BOOST_REQUIRE_EQUAL(sub_schema.id, pps::schema_id{3});
+
+    // Schemas are indexed for lookups by definition
+    auto other = pps::canonical_schema{
+      pps::subject{"sub2"},
+      pps::canonical_schema_definition{
+        R"({"type":"int"})", pps::schema_type::avro}};
+    auto projected = store.project_ids(other).get();
+    BOOST_REQUIRE(projected.inserted);
+    BOOST_REQUIRE_EQUAL(projected.id, pps::schema_id{2});
+
+    // The max id is tracked for new schemas
+    auto new_schema = pps::canonical_schema{
+      pps::subject{"sub2"},
+      pps::canonical_schema_definition{
+        R"({"type":"float"})", pps::schema_type::avro}};
+    projected = store.project_ids(new_schema).get();
+    BOOST_REQUIRE_EQUAL(projected.id, pps::schema_id{4});
+}
@@ -11,12 +11,42 @@
 
 #include "types.h"
 
+#include "hashing/xx.h"
+
 #include <fmt/core.h>
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
 namespace pandaproxy::schema_registry {
 
+namespace {
+
+template<typename Tag>
+void update(
+  incremental_xxhash64& inc, const typed_schema_definition<Tag>& def) {
+    inc.update(static_cast<std::underlying_type_t<schema_type>>(def.type()));
+    inc.update(def.raw()());
+}
+
+} // namespace
+
+schema_fingerprint fingerprint(const canonical_schema_definition& def) {
+    incremental_xxhash64 inc;
+    update(inc, def);
+    return schema_fingerprint{inc.digest()};
+}
+
+schema_fingerprint fingerprint(const unparsed_schema& schema) {
+    incremental_xxhash64 inc;
+    update(inc, schema.def());
+    for (const auto& ref : schema.refs()) {
+        inc.update(ref.name);
+        inc.update(ref.sub());
+        inc.update(ref.version());
+    }
+    return schema_fingerprint{inc.digest()};
+}
+
 std::ostream& operator<<(std::ostream& os, const schema_type& v) {
     return os << to_string_view(v);
 }
@@ -332,6 +332,17 @@ private:
 using unparsed_schema = typed_schema<unparsed_schema_definition::tag>;
 using canonical_schema = typed_schema<canonical_schema_definition::tag>;
 
+///\brief A hash of a schema, to find equal schemas without comparing their
+/// definitions.
+using schema_fingerprint = named_type<uint64_t, struct schema_fingerprint_tag>;
+
+///\brief Fingerprint of the type and the definition.
+schema_fingerprint fingerprint(const canonical_schema_definition& def);
+
+///\brief Fingerprint of the type, the definition and the references, but not
+/// the subject.
+schema_fingerprint fingerprint(const unparsed_schema& schema);
+
 ///\brief Complete description of a subject and schema for a version.
 struct subject_schema {
     canonical_schema schema;
@@ -3,10 +3,12 @@
 #include "raft/consensus.h"
 #include "raft/types.h"
 #include "utils/gate_guard.h"
+#include "utils/request_tracer.h"
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/do_with.hh>
 #include <seastar/core/loop.hh>
+#include <seastar/core/when_all.hh>
 #include <seastar/util/later.hh>
 #include <seastar/util/variant_utils.hh>
 
@@ -48,6 +50,8 @@ ss::future<> append_entries_buffer::stop() {
     // wait for gate to be closed so all the pending requests will finish before
     // we invalidate pending promisses
     co_await std::move(f);
+    // replies of the requests that were appended before stopping
+    co_await std::exchange(_replied, ss::now());
     auto response_promises = std::exchange(_responses, {});
     // set errors
     for (auto& p : response_promises) {
@@ -92,6 +96,7 @@ ss::future<> append_entries_buffer::do_flush(
   request_t requests, response_t response_promises, ssx::semaphore_units u) {
     bool needs_flush = false;
     std::vector<reply_t> replies;
+    std::vector<trace_id> traces;
     auto f = ss::now();
     {
         ssx::semaphore_units op_lock_units = std::move(u);
@@ -100,6 +105,11 @@ ss::future<> append_entries_buffer::do_flush(
             if (req.flush) {
                 needs_flush = true;
             }
+            if (req.trace != trace_id{}) {
+                request_tracer::local().record(
+                  req.trace, trace_stage::follower_append_received);
+                traces.push_back(req.trace);
+            }
             try {
                 // NOTE: do_append_entries do not flush
                 auto reply = co_await _consensus.do_append_entries(
@@ -109,15 +119,38 @@ ss::future<> append_entries_buffer::do_flush(
                 replies.emplace_back(std::current_exception());
             }
         }
-        if (needs_flush) {
+        // with write caching the log is flushed in the background
+        if (needs_flush && !_consensus.write_caching_enabled()) {
             f = _consensus.flush_log();
         }
     }
 
-    // units were released before flushing log
-    co_await std::move(f);
-
-    propagate_results(std::move(replies), std::move(response_promises));
+    // units were released before flushing log, the next requests are
+    // appended while the log is flushed. replies are still completed in the
+    // order of the requests, each one carrying the offset flushed by then.
+    auto previous = std::exchange(_replied, ss::now());
+    _replied = ss::when_all(std::move(previous), std::move(f))
+                 .then([this,
+                        replies = std::move(replies),
+                        response_promises = std::move(response_promises),
+                        traces = std::move(traces)](
+                         std::tuple<ss::future<>, ss::future<>> r) mutable {
+                     std::get<0>(r).ignore_ready_future();
+                     auto& flushed = std::get<1>(r);
+                     if (flushed.failed()) {
+                         auto e = flushed.get_exception();
+                         for (auto& p : response_promises) {
+                             p.set_exception(e);
+                         }
+                         return;
+                     }
+                     for (auto t : traces) {
+                         request_tracer::local().record(
+                           t, trace_stage::follower_appended);
+                     }
+                     propagate_results(
+                       std::move(replies), std::move(response_promises));
+                 });
     _flushed.broadcast();
     co_return;
 }
@@ -117,6 +117,11 @@ class consensus;
  * entries to its local log. It can therefore update commit_index as soon as it
  * will receive the first response, still being correct and guaranteeing safety.
  *
+ * The log flush of a group of requests is pipelined with the appends of the
+ * next one: the op lock is released as soon as the requests are appended and
+ * the next group is appended while the previous flush is in progress. Replies
+ * are still completed in order, once their flush finished.
+ *
  * Note on backpressure handling:
  *
  * The backpressure is handled using condition variable. When buffer has free
@@ -147,6 +152,8 @@ private:
     ss::condition_variable _enqueued;
     ss::gate _gate;
     ss::condition_variable _flushed;
+    // completes once the replies of every appended group are set
+    ss::future<> _replied = ss::now();
     const size_t _max_buffered;
 };
 
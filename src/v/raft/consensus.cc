@@ -97,7 +97,8 @@ consensus::consensus(
   storage::api& storage,
   std::optional<std::reference_wrapper<recovery_throttle>> recovery_throttle,
   recovery_memory_quota& recovery_mem_quota,
-  raft_feature_table& ft)
+  raft_feature_table& ft,
+  timer_wheel& timers)
   : _self(nid, initial_cfg.revision_id())
   , _group(group)
   , _jit(std::move(jit))
@@ -111,6 +112,8 @@ consensus::consensus(
   , _disk_timeout(disk_timeout)
   , _client_protocol(client)
   , _leader_notification(std::move(cb))
+  , _vote_timeout(timers)
+  , _deferred_flush(timers)
   , _fstats(
       _self,
       config::shard_local_cfg()
@@ -140,6 +143,7 @@ consensus::consensus(
         maybe_step_down();
         dispatch_vote(false);
     });
+    _deferred_flush.set_callback([this] { dispatch_deferred_flush(); });
 }
 
 void consensus::setup_metrics() {
@@ -226,9 +230,33 @@ clock_type::time_point consensus::majority_heartbeat() const {
     });
 }
 
+bool consensus::has_leader_lease() const {
+    if (!is_leader() || _transferring_leadership) {
+        return false;
+    }
+    const auto lease = _jit.base_duration()
+                       - config::shard_local_cfg()
+                           .raft_lease_max_clock_drift_ms();
+    if (lease <= clock_type::duration::zero()) {
+        return false;
+    }
+    auto acked = config().quorum_match([this](vnode rni) {
+        if (rni == _self) {
+            return clock_type::now();
+        }
+        if (auto it = _fstats.find(rni); it != _fstats.end()) {
+            return it->second.lease_acked_timestamp;
+        }
+        return clock_type::time_point::min();
+    });
+    // followers acknowledged requests of the previous terms as well
+    return acked > _became_leader_at && acked + lease > clock_type::now();
+}
+
 void consensus::shutdown_input() {
     if (likely(!_as.abort_requested())) {
         _vote_timeout.cancel();
+        _deferred_flush.cancel();
         _as.request_abort();
         _commit_index_updated.broken();
         _follower_reply.broken();
@@ -490,6 +518,12 @@ void consensus::successfull_append_entries_reply(
     idx.match_index = idx.last_dirty_log_index;
     idx.next_index = model::next_offset(idx.last_dirty_log_index);
     idx.last_successful_received_seq = idx.last_received_seq;
+    if (
+      idx.lease_probe_seq
+      && idx.last_successful_received_seq >= *idx.lease_probe_seq) {
+        idx.lease_acked_timestamp = idx.lease_probe_timestamp;
+        idx.lease_probe_seq.reset();
+    }
     vlog(
       _ctxlog.trace,
       "Updated node {} match {} and next {} indices",
@@ -550,6 +584,13 @@ void consensus::dispatch_recovery(follower_index_metadata& idx) {
 
 ss::future<result<model::offset>> consensus::linearizable_barrier() {
     using ret_t = result<model::offset>;
+    if (config::shard_local_cfg().raft_enable_lease_reads()) {
+        if (has_leader_lease()) {
+            _probe.lease_read();
+            co_return ret_t(_commit_index);
+        }
+        _probe.lease_read_miss();
+    }
     ssx::semaphore_units u;
     try {
         u = co_await _op_lock.get_units();
@@ -736,7 +777,9 @@ replicate_stages consensus::do_replicate(
     }
 
     return wrap_stages_with_gate(
-      _bg, _batcher.replicate(expected_term, std::move(rdr), opts.consistency));
+      _bg,
+      _batcher.replicate(
+        expected_term, std::move(rdr), opts.consistency, opts.trace));
 }
 
 ss::future<model::record_batch_reader>
@@ -764,6 +807,14 @@ ss::future<model::record_batch_reader> consensus::make_reader(
     });
 }
 
+ss::future<std::optional<storage::extent_read_result>>
+consensus::read_extent(storage::extent_read_config config) {
+    return ss::try_with_gate(_bg, [this, config]() mutable {
+        config.max_offset = std::min(config.max_offset, last_visible_index());
+        return _log.read_extent(config);
+    });
+}
+
 bool consensus::should_skip_vote(bool ignore_heartbeat) {
     bool skip_vote = false;
 
@@ -894,7 +945,13 @@ void consensus::dispatch_vote(bool leadership_transfer) {
 
 void consensus::arm_vote_timeout() {
     if (!_bg.is_closed()) {
-        _vote_timeout.rearm(_jit());
+        auto deadline = _jit();
+        // a replica missing a part of the log the leader committed can not
+        // win the election, the replicas that have it go first
+        if (_log.offsets().dirty_offset < _leader_commit_index) {
+            deadline += _jit.jitter_duration();
+        }
+        _vote_timeout.rearm(deadline);
     }
 }
 
@@ -1677,6 +1734,7 @@ consensus::do_append_entries(append_entries_request&& r) {
         _follower_reply.broadcast();
         trigger_leadership_notification();
     }
+    _leader_commit_index = r.meta.commit_index;
 
     // raft.pdf: Reply false if log doesn’t contain an entry at
     // prevLogIndex whose term matches prevLogTerm (§5.3)
@@ -1944,7 +2002,7 @@ consensus::do_install_snapshot(install_snapshot_request&& r) {
     vlog(_ctxlog.trace, "Install snapshot request: {}", r);
 
     install_snapshot_reply reply{
-      .term = _term, .bytes_stored = r.chunk.size_bytes(), .success = false};
+      .term = _term, .bytes_stored = 0, .success = false};
     reply.target_node_id = r.node_id;
 
     if (unlikely(is_request_target_node_invalid("install_snapshot", r))) {
@@ -1973,26 +2031,57 @@ consensus::do_install_snapshot(install_snapshot_request&& r) {
     if (r.file_offset == 0) {
         // discard old chunks, previous snaphost wasn't finished
         if (_snapshot_writer) {
-            f = _snapshot_writer->close().then(
-              [this] { return _snapshot_mgr.remove_partial_snapshots(); });
+            f = _snapshot_writer->close().then([this] {
+                _snapshot_writer.reset();
+                return _snapshot_mgr.remove_partial_snapshots();
+            });
         }
-        f = f.then([this] {
+        f = f.then([this, index = r.last_included_index, term = r.term] {
             return _snapshot_mgr.start_snapshot().then(
-              [this](storage::snapshot_writer w) {
+              [this, index, term](storage::snapshot_writer w) {
                   _snapshot_writer.emplace(std::move(w));
+                  _received_snapshot_index = index;
+                  _received_snapshot_term = term;
+                  _received_snapshot_bytes = 0;
               });
         });
+    } else if (
+      !_snapshot_writer || r.last_included_index != _received_snapshot_index
+      || r.term != _received_snapshot_term
+      || r.file_offset != _received_snapshot_bytes) {
+        /**
+         * The chunk does not continue the partially received snapshot, i.e.
+         * the leader resumes an interrupted transfer and the reply to the last
+         * stored chunk was lost. Reply with the number of bytes stored so far,
+         * the leader continues the transfer from there.
+         */
+        if (
+          _snapshot_writer && r.last_included_index == _received_snapshot_index
+          && r.term == _received_snapshot_term) {
+            reply.bytes_stored = _received_snapshot_bytes;
+        }
+        vlog(
+          _ctxlog.debug,
+          "Snapshot chunk at {} does not follow {} bytes of the snapshot at "
+          "{} received so far",
+          r.file_offset,
+          _received_snapshot_bytes,
+          _received_snapshot_index);
+        return ss::make_ready_future<install_snapshot_reply>(reply);
     }
 
     // Write data into snapshot file at given offset (§7.3)
     f = f.then([this, chunk = std::move(r.chunk)]() mutable {
+        auto size = chunk.size_bytes();
         return write_iobuf_to_output_stream(
-          std::move(chunk), _snapshot_writer->output());
+                 std::move(chunk), _snapshot_writer->output())
+          .then([this, size] { _received_snapshot_bytes += size; });
     });
 
     // Reply and wait for more data chunks if done is false (§7.4)
     if (!is_done) {
-        return f.then([reply]() mutable {
+        return f.then([this, reply]() mutable {
+            reply.bytes_stored = _received_snapshot_bytes;
             reply.success = true;
             return reply;
         });
@@ -2010,6 +2099,8 @@ ss::future<install_snapshot_reply> consensus::finish_snapshot(
         return ss::make_ready_future<install_snapshot_reply>(reply);
     }
 
+    reply.bytes_stored = _received_snapshot_bytes;
+    _received_snapshot_bytes = 0;
     auto f = _snapshot_writer->close();
     // discard any existing or partial snapshot with a smaller index (§7.5)
     if (r.last_included_index < _last_snapshot_index) {
@@ -2063,7 +2154,8 @@ ss::future<> consensus::write_snapshot(write_snapshot_cfg cfg) {
                            max_offset);
 
                          return do_write_snapshot(
-                                  cfg.last_included_index, std::move(cfg.data))
+                                  cfg.last_included_index,
+                                  std::move(cfg.write_data))
                            .then([] { return true; });
                      })
                      .handle_exception_type(
@@ -2093,13 +2185,13 @@ ss::future<> consensus::write_snapshot(write_snapshot_cfg cfg) {
     _log.set_collectible_offset(last_included_index);
 }
 
-ss::future<>
-consensus::do_write_snapshot(model::offset last_included_index, iobuf&& data) {
+ss::future<> consensus::do_write_snapshot(
+  model::offset last_included_index,
+  write_snapshot_cfg::data_writer write_data) {
     vlog(
       _ctxlog.trace,
-      "Persisting snapshot with last included offset {} of size {}",
-      last_included_index,
-      data.size_bytes());
+      "Persisting snapshot with last included offset {}",
+      last_included_index);
 
     auto last_included_term = _log.get_term(last_included_index);
     vassert(
@@ -2126,7 +2218,7 @@ consensus::do_write_snapshot(model::offset last_included_index, iobuf&& data) {
     };
 
     return details::persist_snapshot(
-             _snapshot_mgr, std::move(md), std::move(data))
+             _snapshot_mgr, std::move(md), std::move(write_data))
       .then([this, last_included_index, term = *last_included_term]() mutable {
           // update consensus state
           _last_snapshot_index = last_included_index;
@@ -2134,6 +2226,52 @@ consensus::do_write_snapshot(model::offset last_included_index, iobuf&& data) {
       });
 }
 
+model::offset consensus::archived_offset() {
+    if (!_archived_offset_provider) {
+        return model::offset{};
+    }
+    return _archived_offset_provider();
+}
+
+ss::future<std::optional<iobuf>>
+consensus::make_archived_snapshot(model::offset last_included_index) {
+    auto last_included_term = _log.get_term(last_included_index);
+    auto config = _configuration_manager.get(last_included_index);
+    if (
+      !last_included_term || !config
+      || last_included_index <= _last_snapshot_index
+      || last_included_index > _commit_index) {
+        co_return std::nullopt;
+    }
+
+    snapshot_metadata md{
+      .last_included_index = last_included_index,
+      .last_included_term = last_included_term.value(),
+      .latest_configuration = std::move(*config),
+      .cluster_time = clock_type::time_point::min(),
+      .log_start_delta = offset_translator_delta(
+        _offset_translator.state()->delta(
+          model::next_offset(last_included_index))),
+    };
+
+    iobuf snapshot;
+    storage::snapshot_writer writer(
+      make_iobuf_ref_output_stream(snapshot),
+      _snapshot_mgr.snapshot_path(),
+      _snapshot_mgr.snapshot_path());
+    std::exception_ptr ep;
+    try {
+        co_await writer.write_metadata(reflection::to_iobuf(std::move(md)));
+    } catch (...) {
+        ep = std::current_exception();
+    }
+    co_await writer.close();
+    if (ep) {
+        std::rethrow_exception(ep);
+    }
+    co_return snapshot;
+}
+
 ss::future<std::error_code> consensus::replicate_configuration(
   ssx::semaphore_units u, group_configuration cfg) {
     // under the _op_sem lock
@@ -2232,6 +2370,10 @@ ss::future<> consensus::flush_log() {
     }
     _probe.log_flushed();
     _has_pending_flushes = false;
+    // appends that happen while flushing are accounted to the next flush
+    _unflushed_bytes = 0;
+    _deferred_flush.cancel();
+    _probe.write_caching_flushed();
     auto flushed_up_to = _log.offsets().dirty_offset;
     return _log.flush().then([this, flushed_up_to] {
         auto lstats = _log.offsets();
@@ -2258,10 +2400,39 @@ ss::future<> consensus::flush_log() {
     });
 }
 
+void consensus::track_unflushed_append(size_t bytes) {
+    if (_unflushed_bytes == 0) {
+        _deferred_flush.rearm(
+          clock_type::now()
+          + config::shard_local_cfg().write_caching_flush_interval_ms());
+    }
+    _unflushed_bytes += bytes;
+    _probe.write_caching_append(_unflushed_bytes);
+    if (
+      _unflushed_bytes
+      >= config::shard_local_cfg().write_caching_max_unflushed_bytes()) {
+        dispatch_deferred_flush();
+    }
+}
+
+void consensus::dispatch_deferred_flush() {
+    _deferred_flush.cancel();
+    if (_deferred_flush_dispatched || _bg.is_closed()) {
+        return;
+    }
+    _deferred_flush_dispatched = true;
+    _probe.write_caching_deferred_flush();
+    ssx::spawn_with_gate(_bg, [this] {
+        return refresh_commit_index().finally(
+          [this] { _deferred_flush_dispatched = false; });
+    });
+}
+
 ss::future<storage::append_result> consensus::disk_append(
   model::record_batch_reader&& reader,
   update_last_quorum_index should_update_last_quorum_idx) {
     using ret_t = storage::append_result;
+    _last_activity = clock_type::now();
     auto cfg = storage::log_append_config{
       // no fsync explicit on a per write, we verify at the end to
       // batch fsync
@@ -2308,6 +2479,9 @@ ss::future<storage::append_result> consensus::disk_append(
               _last_quorum_replicated_index = ret.last_offset;
           }
           _has_pending_flushes = true;
+          if (write_caching_enabled()) {
+              track_unflushed_append(ret.byte_size);
+          }
           // TODO
           // if we rolled a log segment. write current configuration
           // for speedy recovery in the background
@@ -2391,7 +2565,15 @@ void consensus::update_node_hbeat_timestamp(vnode id) {
 
 follower_req_seq consensus::next_follower_sequence(vnode id) {
     if (auto it = _fstats.find(id); it != _fstats.end()) {
-        return it->second.last_sent_seq++;
+        auto& meta = it->second;
+        auto seq = meta.last_sent_seq++;
+        // the request is created no later than it is sent, so its creation
+        // time bounds the leader lease from below
+        if (!meta.lease_probe_seq) {
+            meta.lease_probe_seq = seq;
+            meta.lease_probe_timestamp = clock_type::now();
+        }
+        return seq;
     }
 
     return follower_req_seq{};
@@ -2526,17 +2708,24 @@ consensus::do_maybe_update_leader_commit_idx(ssx::semaphore_units u) {
     // If there exists an N such that N > commitIndex, a majority
     // of matchIndex[i] ≥ N, and log[N].term == currentTerm:
     // set commitIndex = N (§5.3, §5.4).
-    auto majority_match = config().quorum_match([this](vnode id) {
-        // current node - we just return commited offset
-        if (id == _self) {
-            return _flushed_offset;
-        }
-        if (auto it = _fstats.find(id); it != _fstats.end()) {
-            return it->second.match_committed_index();
-        }
+    // with write caching a majority holding the entries in memory is enough,
+    // neither the leader nor the followers have to flush them first
+    const bool write_caching = write_caching_enabled();
+    const auto self_offset = write_caching ? lstats.dirty_offset
+                                           : _flushed_offset;
+    auto majority_match = config().quorum_match(
+      [this, write_caching, self_offset](vnode id) {
+          // current node - we just return commited offset
+          if (id == _self) {
+              return self_offset;
+          }
+          if (auto it = _fstats.find(id); it != _fstats.end()) {
+              return write_caching ? it->second.match_index
+                                   : it->second.match_committed_index();
+          }
 
-        return model::offset{};
-    });
+          return model::offset{};
+      });
     if (get_term(majority_match) == _term) {
         _confirmed_term = _term;
     }
@@ -2549,13 +2738,15 @@ consensus::do_maybe_update_leader_commit_idx(ssx::semaphore_units u) {
      * committed offset to be greater than leader flushed offset may result in
      * stale read i.e. even though the committed_index was updated on the leader
      * batcher aren't readable since some of the writes are still in flight in
-     * segment appender.
+     * segment appender. With write caching the unflushed tail is served from
+     * the batch cache, which is populated on append.
      */
-    majority_match = std::min(majority_match, _flushed_offset);
+    majority_match = std::min(majority_match, self_offset);
 
     if (majority_match > _commit_index && get_term(majority_match) == _term) {
         _confirmed_term = _term;
         _commit_index = majority_match;
+        _last_activity = clock_type::now();
         vlog(_ctxlog.trace, "Leader commit index updated {}", _commit_index);
 
         _commit_index_updated.broadcast();
@@ -2581,7 +2772,10 @@ consensus::maybe_update_follower_commit_idx(model::offset request_commit_idx) {
     // If leaderCommit > commitIndex, set commitIndex =
     // min(leaderCommit, index of last new entry)
     if (request_commit_idx > _commit_index) {
-        auto new_commit_idx = std::min(request_commit_idx, _flushed_offset);
+        auto new_commit_idx = std::min(
+          request_commit_idx,
+          write_caching_enabled() ? _log.offsets().dirty_offset
+                                  : _flushed_offset);
         if (new_commit_idx != _commit_index) {
             _commit_index = new_commit_idx;
             vlog(
@@ -3143,6 +3337,50 @@ void consensus::update_heartbeat_status(vnode id, bool success) {
     }
 }
 
+bool consensus::can_quiesce(clock_type::duration idle_timeout) const {
+    if (
+      !is_leader() || _fstats.size() == 0 || _transferring_leadership
+      || _configuration_manager.get_latest().get_state()
+           != configuration_state::simple) {
+        return false;
+    }
+    const auto idle_since = std::max(_last_activity, _became_leader_at)
+                            + idle_timeout;
+    if (idle_since > clock_type::now()) {
+        return false;
+    }
+    const auto dirty_offset = _log.offsets().dirty_offset;
+    if (_commit_index != dirty_offset) {
+        return false;
+    }
+    // replies received after the group became idle are for requests that
+    // carried the current commit index, as long as the idle timeout is
+    // longer than the request timeouts
+    return std::all_of(_fstats.begin(), _fstats.end(), [&](const auto& p) {
+        const auto& f = p.second;
+        return !f.is_recovering && f.heartbeats_failed == 0
+               && f.match_committed_index() == dirty_offset
+               && f.last_received_append_entries_reply_timestamp
+                    >= idle_since;
+    });
+}
+
+void consensus::renew_follower_lease(vnode id) {
+    if (auto it = _fstats.find(id); it != _fstats.end()) {
+        it->second.last_received_append_entries_reply_timestamp
+          = clock_type::now();
+        it->second.heartbeats_failed = 0;
+    }
+}
+
+void consensus::renew_lease(const lease_group& g) {
+    if (
+      _vstate == vote_state::follower && _term == g.term
+      && _leader_id == g.node_id && _self == g.target_node_id) {
+        _hbeat = clock_type::now();
+    }
+}
+
 bool consensus::should_reconnect_follower(vnode id) {
     if (_heartbeat_disconnect_failures == 0) {
         // Force disconnection is disabled
@@ -3223,7 +3461,8 @@ follower_metrics build_follower_metrics(
   model::node_id id,
   const storage::offset_stats& lstats,
   std::chrono::milliseconds liveness_timeout,
-  const follower_index_metadata& meta) {
+  const follower_index_metadata& meta,
+  const follower_queue* queue) {
     const auto is_live = meta.last_received_append_entries_reply_timestamp
                            + liveness_timeout
                          > clock_type::now();
@@ -3236,7 +3475,10 @@ follower_metrics build_follower_metrics(
       .last_heartbeat = meta.last_received_append_entries_reply_timestamp,
       .is_live = is_live,
       .under_replicated = (meta.is_recovering || !is_live)
-                          && meta.match_index < lstats.dirty_offset};
+                          && meta.match_index < lstats.dirty_offset,
+      .append_entries_window = queue ? queue->window() : 0,
+      .append_entries_rtt = queue ? queue->smoothed_rtt()
+                                  : clock_type::duration{0}};
 }
 
 std::vector<follower_metrics> consensus::get_follower_metrics() const {
@@ -3253,7 +3495,8 @@ std::vector<follower_metrics> consensus::get_follower_metrics() const {
           offsets,
           std::chrono::duration_cast<std::chrono::milliseconds>(
             _jit.base_duration()),
-          f.second));
+          f.second,
+          _fstats.queue(f.first)));
     }
 
     return ret;
@@ -3276,7 +3519,8 @@ consensus::get_follower_metrics(model::node_id id) const {
       _log.offsets(),
       std::chrono::duration_cast<std::chrono::milliseconds>(
         _jit.base_duration()),
-      it->second);
+      it->second,
+      _fstats.queue(it->first));
 }
 
 size_t consensus::get_follower_count() const {
@@ -31,6 +31,7 @@
 #include "raft/recovery_throttle.h"
 #include "raft/replicate_batcher.h"
 #include "raft/timeout_jitter.h"
+#include "raft/timer_wheel.h"
 #include "raft/types.h"
 #include "seastarx.h"
 #include "ssx/semaphore.h"
@@ -82,6 +83,8 @@ public:
     };
     enum class vote_state { follower, candidate, leader };
     using leader_cb_t = ss::noncopyable_function<void(leadership_status)>;
+    using archived_offset_provider_t
+      = ss::noncopyable_function<model::offset()>;
 
     consensus(
       model::node_id,
@@ -96,7 +99,8 @@ public:
       storage::api&,
       std::optional<std::reference_wrapper<recovery_throttle>>,
       recovery_memory_quota&,
-      raft_feature_table&);
+      raft_feature_table&,
+      timer_wheel&);
 
     /// Initial call. Allow for internal state recovery
     ss::future<> start();
@@ -135,6 +139,11 @@ public:
     // data loss
     ss::future<std::error_code> cancel_configuration_change(model::revision_id);
     bool is_elected_leader() const { return _vstate == vote_state::leader; }
+    /// quorum writes are acknowledged before they are flushed, the log is
+    /// flushed in the background within the write caching budget
+    bool write_caching_enabled() const {
+        return _log.config().is_write_caching_enabled();
+    }
     // The node won the elections and made sure that the records written in
     // previous term are behind committed index
     bool is_leader() const {
@@ -150,9 +159,21 @@ public:
      * to returned offsets are linearizable. (i.e. majority of followers have
      * updated their commit indices to at least reaturned offset). For more
      * details see paragraph 6.4 of Raft protocol dissertation.
+     *
+     * When `raft_enable_lease_reads` is set and the leader holds a lease (see
+     * has_leader_lease) the commit index is returned without a round trip.
      */
     ss::future<result<model::offset>> linearizable_barrier();
 
+    /**
+     * A follower does not grant votes for an election timeout after it heard
+     * from the leader. Once a majority acknowledged requests the leader sent
+     * since time T no other leader can be elected before T plus the election
+     * timeout, the leader holds a lease until then, less the clock drift
+     * bound (paragraph 6.4.1 of the dissertation).
+     */
+    bool has_leader_lease() const;
+
     vnode self() const { return _self; }
     protocol_metadata meta() const;
     raft::group_id group() const { return _group; }
@@ -174,6 +195,17 @@ public:
      */
     ss::future<> write_snapshot(write_snapshot_cfg);
 
+    /**
+     * Sets the source of the offset up to which the log is archived outside
+     * of the local log (e.g. in cloud storage) and can be read from there.
+     * The leader recovers followers that are behind the archived offset by
+     * installing a snapshot at that offset instead of reading the archived
+     * prefix from the local log.
+     */
+    void set_archived_offset_provider(archived_offset_provider_t provider) {
+        _archived_offset_provider = std::move(provider);
+    }
+
     /// Increment and returns next append_entries order tracking sequence for
     /// follower with given node id
     follower_req_seq next_follower_sequence(vnode);
@@ -219,6 +251,10 @@ public:
     ss::future<model::record_batch_reader> make_reader(
       storage::log_reader_config,
       std::optional<clock_type::time_point> = std::nullopt);
+    /// reads a single on-disk extent bounded by the last visible index, see
+    /// storage::extent_read_config
+    ss::future<std::optional<storage::extent_read_result>>
+      read_extent(storage::extent_read_config);
 
     model::offset get_latest_configuration_offset() const;
     model::offset committed_offset() const { return _commit_index; }
@@ -345,6 +381,20 @@ public:
 
     bool should_reconnect_follower(vnode);
 
+    /**
+     * Quiescence of idle groups. The leader stops sending heartbeats to a
+     * group when nothing was appended or committed for `idle_timeout` and
+     * every follower acknowledged the current log state since. The group is
+     * then kept alive with node level leases (see node_lease_table), the
+     * next append wakes it up.
+     */
+    bool can_quiesce(clock_type::duration idle_timeout) const;
+    /// Leader: a node lease reply stands in for the follower heartbeat reply
+    void renew_follower_lease(vnode);
+    /// Follower: a node lease from the current leader resets the election
+    /// timeout like a heartbeat would
+    void renew_lease(const lease_group&);
+
     std::vector<follower_metrics> get_follower_metrics() const;
     result<follower_metrics> get_follower_metrics(model::node_id) const;
     size_t get_follower_count() const;
@@ -408,7 +458,14 @@ private:
     ss::future<install_snapshot_reply>
       finish_snapshot(install_snapshot_request, install_snapshot_reply);
 
-    ss::future<> do_write_snapshot(model::offset, iobuf&&);
+    ss::future<>
+      do_write_snapshot(model::offset, write_snapshot_cfg::data_writer);
+
+    model::offset archived_offset();
+    /// Serialized snapshot without data at the given offset, used to skip the
+    /// archived prefix of the log when recovering a follower. Returns nullopt
+    /// if the offset is not available in the local log.
+    ss::future<std::optional<iobuf>> make_archived_snapshot(model::offset);
     append_entries_reply
       make_append_entries_reply(vnode, storage::append_result);
 
@@ -462,6 +519,8 @@ private:
 
     /// \brief _does not_ hold the lock.
     ss::future<> flush_log();
+    void track_unflushed_append(size_t);
+    void dispatch_deferred_flush();
 
     void maybe_step_down();
 
@@ -602,22 +661,33 @@ private:
     vnode _voted_for;
     std::optional<vnode> _leader_id;
     bool _transferring_leadership{false};
+    /// commit index last reported by the leader, followers lagging behind it
+    /// delay their elections
+    model::offset _leader_commit_index;
 
     /// useful for when we are not the leader
     clock_type::time_point _hbeat = clock_type::now();
     clock_type::time_point _became_leader_at = clock_type::now();
+    /// last append or commit index update
+    clock_type::time_point _last_activity = clock_type::now();
     clock_type::time_point _instantiated_at = clock_type::now();
 
     /// used to keep track if we are a leader, or transitioning
     vote_state _vstate = vote_state::follower;
     /// used for votes only. heartbeats are done by heartbeat_manager
-    timer_type _vote_timeout;
+    timer_wheel::timer _vote_timeout;
+    /// flushes acknowledged writes of a write caching log once they reach
+    /// `write_caching_flush_interval_ms`
+    timer_wheel::timer _deferred_flush;
 
     /// used for keepint tally on followers
     follower_stats _fstats;
 
     replicate_batcher _batcher;
     bool _has_pending_flushes{false};
+    /// bytes appended since the last flush, only tracked with write caching
+    size_t _unflushed_bytes{0};
+    bool _deferred_flush_dispatched{false};
 
     /// used to wait for background ops before shutting down
     ss::gate _bg;
@@ -642,8 +712,14 @@ private:
     raft_feature_table& _features;
     storage::simple_snapshot_manager _snapshot_mgr;
     std::optional<storage::snapshot_writer> _snapshot_writer;
+    // partially received snapshot, chunks of an interrupted transfer are
+    // appended to it when the leader resumes the transfer
+    model::offset _received_snapshot_index;
+    model::term_id _received_snapshot_term;
+    size_t _received_snapshot_bytes{0};
     model::offset _last_snapshot_index;
     model::term_id _last_snapshot_term;
+    archived_offset_provider_t _archived_offset_provider;
     configuration_manager _configuration_manager;
     model::offset _majority_replicated_index;
     model::offset _visibility_upper_bound_index;
@@ -54,6 +54,10 @@ public:
 
         virtual ss::future<> reset_backoff(model::node_id) = 0;
 
+        virtual ss::future<result<node_lease_reply>>
+        node_lease(model::node_id, node_lease_request&&, rpc::client_opts)
+          = 0;
+
         virtual ~impl() noexcept = default;
     };
 
@@ -111,6 +115,13 @@ public:
         return _impl->reset_backoff(target_node);
     }
 
+    ss::future<result<node_lease_reply>> node_lease(
+      model::node_id target_node,
+      node_lease_request&& r,
+      rpc::client_opts opts) {
+        return _impl->node_lease(target_node, std::move(r), std::move(opts));
+    }
+
 private:
     ss::shared_ptr<impl> _impl;
 };
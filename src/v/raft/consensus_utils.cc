@@ -243,19 +243,35 @@ ss::future<> persist_snapshot(
   storage::simple_snapshot_manager& snapshot_manager,
   snapshot_metadata md,
   iobuf&& data) {
+    return persist_snapshot(
+      snapshot_manager,
+      std::move(md),
+      [data = std::move(data)](ss::output_stream<char>& out) mutable {
+          return write_iobuf_to_output_stream(std::move(data), out);
+      });
+}
+
+ss::future<> persist_snapshot(
+  storage::simple_snapshot_manager& snapshot_manager,
+  snapshot_metadata md,
+  write_snapshot_cfg::data_writer write_data) {
     return snapshot_manager.start_snapshot().then(
-      [&snapshot_manager, md = std::move(md), data = std::move(data)](
+      [&snapshot_manager,
+       md = std::move(md),
+       write_data = std::move(write_data)](
         storage::snapshot_writer writer) mutable {
           return ss::do_with(
             std::move(writer),
-            [&snapshot_manager, md = std::move(md), data = std::move(data)](
+            [&snapshot_manager,
+             md = std::move(md),
+             write_data = std::move(write_data)](
               storage::snapshot_writer& writer) mutable {
                 return writer
                   .write_metadata(reflection::to_iobuf(std::move(md)))
-                  .then([&writer, data = std::move(data)]() mutable {
-                      return write_iobuf_to_output_stream(
-                        std::move(data), writer.output());
-                  })
+                  .then(
+                    [&writer, write_data = std::move(write_data)]() mutable {
+                        return write_data(writer.output());
+                    })
                   .finally([&writer] { return writer.close(); })
                   .then([&snapshot_manager, &writer] {
                       return snapshot_manager.finish_snapshot(writer);
@@ -53,6 +53,11 @@ ss::circular_buffer<model::record_batch> make_ghost_batches_in_gaps(
 /// writes snapshot with given data to disk
 ss::future<>
 persist_snapshot(storage::simple_snapshot_manager&, snapshot_metadata, iobuf&&);
+/// writes snapshot to disk, streaming its data with the given writer
+ss::future<> persist_snapshot(
+  storage::simple_snapshot_manager&,
+  snapshot_metadata,
+  write_snapshot_cfg::data_writer);
 
 /// looks up for the broker with request id in a vector of brokers
 template<typename Iterator>
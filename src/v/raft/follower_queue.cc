@@ -17,13 +17,60 @@
 
 namespace raft {
 
-follower_queue::follower_queue(uint32_t max_concurrent_append_entries)
-  : _max_concurrent_append_entries(max_concurrent_append_entries)
-  , _sem(std::make_unique<ssx::semaphore>(
-      _max_concurrent_append_entries, "raft/follow")) {}
+follower_queue::follower_queue(uint32_t initial_window)
+  : _max_window(std::max<uint32_t>(initial_window, 1) * max_window_factor)
+  , _window(std::max<uint32_t>(initial_window, 1))
+  , _units(std::max<uint32_t>(initial_window, 1))
+  , _sem(std::make_unique<ssx::semaphore>(_units, "raft/follow")) {}
 
 ss::future<ssx::semaphore_units> follower_queue::get_append_entries_unit() {
     co_return co_await ss::get_units(*_sem, 1);
 }
 
+void follower_queue::append_entries_replied(clock_type::duration latency) {
+    _min_rtt = std::min(_min_rtt, latency);
+    _srtt = _srtt == clock_type::duration{0} ? latency
+                                             : (_srtt * 7 + latency) / 8;
+    const auto threshold = std::chrono::duration_cast<clock_type::duration>(
+                             _min_rtt * congestion_rtt_factor)
+                           + min_rtt_slack;
+    if (_srtt > threshold) {
+        decrease();
+    } else {
+        increase();
+    }
+}
+
+void follower_queue::append_entries_failed() { decrease(); }
+
+void follower_queue::increase() {
+    _window = std::min<double>(_window + 1.0 / _window, _max_window);
+    resize();
+}
+
+void follower_queue::decrease() {
+    // the replies of the requests sent before the previous decrease carry no
+    // news, the window is halved at most once per round trip
+    auto now = clock_type::now();
+    if (now < _last_decrease + _srtt) {
+        return;
+    }
+    _last_decrease = now;
+    _window = std::max(_window / 2, 1.0);
+    ++_decreases;
+    resize();
+}
+
+void follower_queue::resize() {
+    const auto units = static_cast<uint32_t>(_window);
+    if (units > _units) {
+        _sem->signal(units - _units);
+    } else if (units < _units) {
+        // may leave the semaphore negative until the requests in flight
+        // return their units
+        _sem->consume(_units - units);
+    }
+    _units = units;
+}
+
 } // namespace raft
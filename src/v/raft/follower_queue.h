@@ -10,13 +10,28 @@
  */
 #pragma once
 #include "raft/group_configuration.h"
+#include "raft/types.h"
 #include "ssx/semaphore.h"
 
 namespace raft {
 
+/**
+ * Limits the number of append entries requests in flight to a follower.
+ *
+ * The window adapts to the follower in the spirit of a congestion control:
+ * it grows additively, by one request per window of replies, while the
+ * smoothed round trip stays close to the lowest one observed, and shrinks
+ * multiplicatively when requests fail or the round trip inflates, which
+ * means requests are queueing up somewhere on the way to the follower. A
+ * distant but healthy follower is given a larger window to cover its round
+ * trip, a congested one is given less requests to queue up.
+ */
 class follower_queue {
 public:
-    explicit follower_queue(uint32_t);
+    // the window grows up to this many times the initial one
+    static constexpr uint32_t max_window_factor = 4;
+
+    explicit follower_queue(uint32_t initial_window);
 
     follower_queue(follower_queue&&) noexcept = default;
     follower_queue(const follower_queue&) = delete;
@@ -28,27 +43,38 @@ public:
 
     ss::future<ssx::semaphore_units> get_append_entries_unit();
 
-    ss::future<> stop();
+    /// a request dispatched with a unit got a reply after the given latency
+    void append_entries_replied(clock_type::duration);
+    /// a request dispatched with a unit failed or timed out
+    void append_entries_failed();
+
+    uint32_t window() const { return _units; }
+    clock_type::duration smoothed_rtt() const { return _srtt; }
+    uint64_t window_decreases() const { return _decreases; }
 
     bool is_idle() const {
         return _sem->waiters() == 0
-               && _sem->available_units() == _max_concurrent_append_entries;
+               && _sem->available_units() == static_cast<ssize_t>(_units);
     }
 
 private:
-    /**
-     * TODO: consider using queue depth control to automatically adjust number
-     * of concurrent requests per follower. In general it should be fine to make
-     * this static since scaling throughput is usually achieved by increasing
-     * partition count. We may need to increase number of concurrent requests
-     * per partition to increase throughput when partition number is low and we
-     * are fine with increasing latency.
-     *
-     * Things to consider:
-     * - per shard concurrency controll
-     * - token-bucket based throughput limitter
-     */
-    uint32_t _max_concurrent_append_entries;
+    // rtt inflation, relative to the lowest rtt, treated as congestion
+    static constexpr double congestion_rtt_factor = 2.0;
+    // rtt differences below it are noise on a local network
+    static constexpr auto min_rtt_slack = std::chrono::milliseconds(1);
+
+    void increase();
+    void decrease();
+    void resize();
+
+    uint32_t _max_window;
+    double _window;
+    // units the semaphore was created or resized with
+    uint32_t _units;
+    clock_type::duration _min_rtt = clock_type::duration::max();
+    clock_type::duration _srtt{0};
+    clock_type::time_point _last_decrease;
+    uint64_t _decreases{0};
     std::unique_ptr<ssx::semaphore> _sem;
 };
 
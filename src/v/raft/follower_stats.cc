@@ -45,6 +45,15 @@ void follower_stats::update_with_configuration(const group_configuration& cfg) {
         }
         ++it;
     }
+    // queues of the removed followers with requests in flight are dropped
+    // once they return their units
+    for (auto it = _queues.begin(); it != _queues.end();) {
+        if (!_followers.contains(it->first) && it->second.is_idle()) {
+            _queues.erase(it++);
+            continue;
+        }
+        ++it;
+    }
 }
 
 ss::future<ssx::semaphore_units>
@@ -58,12 +67,27 @@ follower_stats::get_append_entries_unit(vnode id) {
 }
 
 void follower_stats::return_append_entries_units(vnode id) {
-    if (auto it = _queues.find(id);
-        it != _queues.end() && it->second.is_idle()) {
+    // the queue of a follower keeps its window, it is only dropped once the
+    // node is no longer a follower
+    if (auto it = _queues.find(id); it != _queues.end() && it->second.is_idle()
+                                    && !_followers.contains(id)) {
         _queues.erase(it);
     }
 }
 
+void follower_stats::append_entries_replied(
+  vnode id, clock_type::duration latency) {
+    if (auto it = _queues.find(id); it != _queues.end()) {
+        it->second.append_entries_replied(latency);
+    }
+}
+
+void follower_stats::append_entries_failed(vnode id) {
+    if (auto it = _queues.find(id); it != _queues.end()) {
+        it->second.append_entries_failed();
+    }
+}
+
 std::ostream& operator<<(std::ostream& o, const follower_stats& s) {
     o << "{followers:" << s._followers.size() << ", [";
     for (auto& f : s) {
@@ -74,6 +74,15 @@ public:
 
     void return_append_entries_units(vnode);
 
+    /// feed the in-flight window of the follower, see follower_queue
+    void append_entries_replied(vnode, clock_type::duration);
+    void append_entries_failed(vnode);
+    /// the follower queue, if any request was ever sent to it
+    const follower_queue* queue(vnode n) const {
+        auto it = _queues.find(n);
+        return it == _queues.end() ? nullptr : &it->second;
+    }
+
     void update_with_configuration(const group_configuration&);
 
 private:
@@ -34,8 +34,13 @@ group_manager::group_manager(
   : _self(self)
   , _disk_timeout(disk_timeout)
   , _raft_sg(raft_sg)
-  , _client(make_rpc_client_protocol(self, clients))
-  , _heartbeats(heartbeat_interval, _client, _self, heartbeat_timeout)
+  , _client(make_rpc_client_protocol(self, clients, &_raft_feature_table))
+  , _heartbeats(
+      heartbeat_interval,
+      _client,
+      _self,
+      heartbeat_timeout,
+      &_raft_feature_table)
   , _storage(storage.local())
   , _recovery_throttle(recovery_throttle.local())
   , _recovery_mem_quota(std::move(recovery_mem_cfg)) {
@@ -88,7 +93,8 @@ ss::future<ss::lw_shared_ptr<raft::consensus>> group_manager::create_group(
       _storage,
       _recovery_throttle,
       _recovery_mem_quota,
-      _raft_feature_table);
+      _raft_feature_table,
+      _timers);
 
     return ss::with_gate(_gate, [this, raft] {
         return _heartbeats.register_group(raft).then([this, raft] {
@@ -16,6 +16,7 @@
 #include "raft/heartbeat_manager.h"
 #include "raft/raft_feature_table.h"
 #include "raft/recovery_memory_quota.h"
+#include "raft/timer_wheel.h"
 #include "raft/rpc_client_protocol.h"
 #include "raft/types.h"
 #include "storage/fwd.h"
@@ -105,6 +106,8 @@ private:
     recovery_throttle& _recovery_throttle;
     recovery_memory_quota _recovery_mem_quota;
     raft_feature_table _raft_feature_table;
+    // election timers of all groups of the shard
+    timer_wheel _timers;
 };
 
 } // namespace raft
@@ -13,6 +13,7 @@
 #include "model/metadata.h"
 #include "model/timeout_clock.h"
 #include "outcome_future_utils.h"
+#include "random/generators.h"
 #include "raft/consensus_client_protocol.h"
 #include "raft/errc.h"
 #include "raft/group_configuration.h"
@@ -31,6 +32,8 @@
 #include <bits/stdint-uintn.h>
 #include <boost/range/iterator_range.hpp>
 
+#include <algorithm>
+
 namespace raft {
 ss::logger hbeatlog{"r/heartbeat"};
 using consensus_ptr = heartbeat_manager::consensus_ptr;
@@ -69,18 +72,28 @@ heartbeat_manager::follower_request_meta::~follower_request_meta() noexcept {
     }
 }
 
+template<typename LeasePredicate>
 static heartbeat_requests requests_for_range(
-  const consensus_set& c, clock_type::duration heartbeat_interval) {
-    absl::btree_map<
-      model::node_id,
-      std::vector<std::pair<
-        heartbeat_metadata,
-        heartbeat_manager::follower_request_meta>>>
-      pending_beats;
+  const consensus_set& c,
+  clock_type::duration heartbeat_interval,
+  LeasePredicate&& is_leased) {
     if (c.empty()) {
         return {};
     }
 
+    // heartbeats are appended to the request of their node directly, groups
+    // are visited in group order so every request is sorted by group
+    std::vector<heartbeat_manager::node_heartbeat> reqs;
+    absl::flat_hash_map<model::node_id, size_t> node_requests;
+    auto beats_for = [&reqs, &node_requests](model::node_id n)
+      -> heartbeat_manager::node_heartbeat& {
+        auto [it, inserted] = node_requests.try_emplace(n, reqs.size());
+        if (inserted) {
+            reqs.emplace_back(n);
+        }
+        return reqs[it->second];
+    };
+
     // Set of follower nodes whose heartbeat_failed status indicates
     // that we should tear down their TCP connection before next heartbeat
     absl::flat_hash_set<model::node_id> reconnect_nodes;
@@ -93,19 +106,30 @@ static heartbeat_requests requests_for_range(
 
         auto maybe_create_follower_request = [ptr,
                                               last_heartbeat,
-                                              &pending_beats,
-                                              &reconnect_nodes](
+                                              &beats_for,
+                                              &reconnect_nodes,
+                                              &is_leased](
                                                const vnode& rni) mutable {
             // special case self beat
             // self beat is used to make sure that the protocol will make
             // progress when there is only on node
             if (rni == ptr->self()) {
                 auto hb_metadata = ptr->meta();
-                pending_beats[rni.id()].emplace_back(
-                  heartbeat_metadata{
-                    .meta = hb_metadata, .node_id = rni, .target_node_id = rni},
-                  heartbeat_manager::follower_request_meta(
-                    ptr, follower_req_seq(0), hb_metadata.prev_log_index, rni));
+                auto& beats = beats_for(rni.id());
+                beats.request.heartbeats.push_back(heartbeat_metadata{
+                  .meta = hb_metadata, .node_id = rni, .target_node_id = rni});
+                beats.meta_map.emplace_back(
+                  ptr, follower_req_seq(0), hb_metadata.prev_log_index, rni);
+                return;
+            }
+
+            if (is_leased(ptr, rni)) {
+                vlog(
+                  hbeatlog.trace,
+                  "Heartbeat leased - target: {}, ntp: {}, group_id: {}",
+                  rni,
+                  ptr->ntp(),
+                  ptr->group());
                 return;
             }
 
@@ -134,10 +158,11 @@ static heartbeat_requests requests_for_range(
 
             auto seq_id = ptr->next_follower_sequence(rni);
             auto hb_meta = ptr->meta();
-            pending_beats[rni.id()].emplace_back(
-              heartbeat_metadata{hb_meta, ptr->self(), rni},
-              heartbeat_manager::follower_request_meta(
-                ptr, seq_id, hb_meta.prev_log_index, rni));
+            auto& beats = beats_for(rni.id());
+            beats.request.heartbeats.push_back(
+              heartbeat_metadata{hb_meta, ptr->self(), rni});
+            beats.meta_map.emplace_back(
+              ptr, seq_id, hb_meta.prev_log_index, rni);
 
             if (ptr->should_reconnect_follower(rni)) {
                 reconnect_nodes.insert(rni.id());
@@ -149,22 +174,6 @@ static heartbeat_requests requests_for_range(
         group.for_each_broker_id(maybe_create_follower_request);
     }
 
-    std::vector<heartbeat_manager::node_heartbeat> reqs;
-    reqs.reserve(pending_beats.size());
-    for (auto& p : pending_beats) {
-        std::vector<heartbeat_metadata> requests;
-        absl::
-          btree_map<raft::group_id, heartbeat_manager::follower_request_meta>
-            meta_map;
-        requests.reserve(p.second.size());
-        for (auto& [hb, follower_meta] : p.second) {
-            meta_map.emplace(hb.meta.group, std::move(follower_meta));
-            requests.push_back(std::move(hb));
-        }
-        reqs.emplace_back(
-          p.first, heartbeat_request{std::move(requests)}, std::move(meta_map));
-    }
-
     return heartbeat_requests{
       .requests{std::move(reqs)}, .reconnect_nodes{reconnect_nodes}};
 }
@@ -173,11 +182,14 @@ heartbeat_manager::heartbeat_manager(
   duration_type interval,
   consensus_client_protocol proto,
   model::node_id self,
-  duration_type heartbeat_timeout)
+  duration_type heartbeat_timeout,
+  const raft_feature_table* features)
   : _heartbeat_interval(interval)
   , _heartbeat_timeout(heartbeat_timeout)
   , _client_protocol(std::move(proto))
-  , _self(self) {
+  , _self(self)
+  , _features(features)
+  , _lease_epoch(random_generators::get_int<uint64_t>()) {
     _heartbeat_timer.set_callback([this] { dispatch_heartbeats(); });
 }
 
@@ -201,7 +213,19 @@ heartbeat_manager::send_heartbeats(std::vector<node_heartbeat> reqs) {
 }
 
 ss::future<> heartbeat_manager::do_dispatch_heartbeats() {
-    auto reqs = requests_for_range(_consensus_groups, _heartbeat_interval);
+    auto idle_timeout = quiescence_timeout();
+    if (idle_timeout) {
+        update_node_leases(*idle_timeout);
+    } else {
+        _leases.clear();
+    }
+
+    auto reqs = requests_for_range(
+      _consensus_groups,
+      _heartbeat_interval,
+      [this, &idle_timeout](const consensus_ptr& c, const vnode& target) {
+          return idle_timeout && is_leased(c, target, *idle_timeout);
+      });
 
     for (const auto& node_id : reqs.reconnect_nodes) {
         if (co_await _client_protocol.ensure_disconnect(node_id)) {
@@ -210,7 +234,184 @@ ss::future<> heartbeat_manager::do_dispatch_heartbeats() {
         };
     }
 
-    co_await send_heartbeats(std::move(reqs.requests));
+    co_await ss::when_all_succeed(
+      send_heartbeats(std::move(reqs.requests)), send_node_leases());
+}
+
+std::optional<clock_type::duration>
+heartbeat_manager::quiescence_timeout() const {
+    if (
+      _features == nullptr
+      || !_features->is_feature_active(raft_feature::node_lease)) {
+        return std::nullopt;
+    }
+    auto timeout = config::shard_local_cfg().raft_quiescence_timeout_ms();
+    if (!timeout) {
+        return std::nullopt;
+    }
+    return *timeout;
+}
+
+static bool lease_group_less(const lease_group& lhs, const lease_group& rhs) {
+    return lhs.group < rhs.group;
+}
+
+void heartbeat_manager::update_node_leases(clock_type::duration idle_timeout) {
+    // groups are visited in group order, so the lists come out sorted
+    absl::flat_hash_map<model::node_id, std::vector<lease_group>> leased;
+    for (auto& c : _consensus_groups) {
+        if (!c->can_quiesce(idle_timeout)) {
+            continue;
+        }
+        c->config().for_each_broker_id([&c, &leased](const vnode& rni) {
+            if (rni == c->self()) {
+                return;
+            }
+            leased[rni.id()].push_back(lease_group{
+              .group = c->group(),
+              .term = c->term(),
+              .node_id = c->self(),
+              .target_node_id = rni});
+        });
+    }
+
+    for (auto& [node, groups] : leased) {
+        auto& state = _leases[node];
+        if (state.groups != groups) {
+            state.groups = std::move(groups);
+            state.generation = ++_lease_generation;
+            state.acked = false;
+        }
+    }
+    // nodes without idle groups get an empty list once and are forgotten
+    // when they acknowledge it
+    for (auto it = _leases.begin(); it != _leases.end();) {
+        auto& state = it->second;
+        if (!leased.contains(it->first)) {
+            if (state.groups.empty() && state.acked) {
+                _leases.erase(it++);
+                continue;
+            }
+            if (!state.groups.empty()) {
+                state.groups.clear();
+                state.generation = ++_lease_generation;
+                state.acked = false;
+            }
+        }
+        ++it;
+    }
+}
+
+bool heartbeat_manager::is_leased(
+  const consensus_ptr& c,
+  const vnode& target,
+  clock_type::duration idle_timeout) {
+    auto it = _leases.find(target.id());
+    if (it == _leases.end() || it->second.renewed_groups.empty()) {
+        return false;
+    }
+    // the group must be in the list the node holds and still be idle, it is
+    // then in the current list as well
+    const auto& renewed = it->second.renewed_groups;
+    lease_group key{.group = c->group()};
+    auto g = std::lower_bound(
+      renewed.begin(), renewed.end(), key, lease_group_less);
+    return g != renewed.end() && g->group == c->group()
+           && g->term == c->term() && g->target_node_id == target
+           && c->can_quiesce(idle_timeout);
+}
+
+ss::future<> heartbeat_manager::send_node_leases() {
+    std::vector<ss::future<>> futures;
+    futures.reserve(_leases.size());
+    for (auto& [node, state] : _leases) {
+        node_lease_request req{
+          .node_id = _self,
+          .target_node_id = node,
+          .source_shard = ss::this_shard_id(),
+          .epoch = _lease_epoch,
+          .generation = state.generation,
+        };
+        if (!state.acked) {
+            req.groups = state.groups;
+        }
+        futures.push_back(do_node_lease(node, std::move(req)));
+    }
+    return ss::when_all_succeed(futures.begin(), futures.end());
+}
+
+ss::future<>
+heartbeat_manager::do_node_lease(model::node_id n, node_lease_request r) {
+    auto gate = _bghbeats.hold();
+    const auto generation = r.generation;
+    vlog(
+      hbeatlog.trace,
+      "Dispatching node lease generation {} to node: {}",
+      generation,
+      n);
+
+    auto f = _client_protocol
+               .node_lease(
+                 n,
+                 std::move(r),
+                 rpc::client_opts(
+                   clock_type::now() + _heartbeat_timeout,
+                   rpc::compression_type::zstd,
+                   512))
+               .then([this, n, generation, gate = std::move(gate)](
+                       result<node_lease_reply> ret) {
+                   process_lease_reply(n, generation, std::move(ret));
+               });
+    return ss::with_timeout(next_heartbeat_timeout(), std::move(f))
+      .handle_exception_type([this, n](const ss::timed_out_error&) {
+          vlog(hbeatlog.trace, "Node lease timeout, node: {}", n);
+          // a lease that didn't arrive in time stops standing in for
+          // heartbeats until the node renews again
+          if (auto it = _leases.find(n); it != _leases.end()) {
+              it->second.renewed_groups.clear();
+          }
+      })
+      .handle_exception_type([](const ss::gate_closed_exception&) {})
+      .handle_exception([n](const std::exception_ptr& e) {
+          vlog(hbeatlog.trace, "Node lease exception, node: {} - {}", n, e);
+      });
+}
+
+void heartbeat_manager::process_lease_reply(
+  model::node_id n, uint64_t generation, result<node_lease_reply> r) {
+    auto it = _leases.find(n);
+    if (it == _leases.end()) {
+        return;
+    }
+    auto& state = it->second;
+    if (!r || !r.value().renewed) {
+        vlog(
+          hbeatlog.debug,
+          "Node lease generation {} was not renewed by node {} - {}",
+          generation,
+          n,
+          r ? "missing groups" : r.error().message());
+        // resend the groups and resume their heartbeats
+        state.acked = false;
+        state.renewed_groups.clear();
+        return;
+    }
+    if (generation != state.generation) {
+        // the list changed in the meantime, the next lease carries it
+        return;
+    }
+    if (!state.acked) {
+        state.acked = true;
+        state.renewed_groups = state.groups;
+    }
+    for (const auto& g : state.groups) {
+        auto c = _consensus_groups.find(g.group);
+        if (
+          c != _consensus_groups.end() && (*c)->term() == g.term
+          && (*c)->is_elected_leader()) {
+            (*c)->renew_follower_lease(g.target_node_id);
+        }
+    }
 }
 
 ss::future<> heartbeat_manager::do_self_heartbeat(node_heartbeat&& r) {
@@ -271,7 +472,7 @@ ss::future<> heartbeat_manager::do_heartbeat(node_heartbeat&& r) {
 
 void heartbeat_manager::process_reply(
   model::node_id n,
-  absl::btree_map<raft::group_id, follower_request_meta> groups,
+  follower_request_metas groups,
   result<heartbeat_reply> r) {
     if (!r) {
         vlog(
@@ -279,7 +480,8 @@ void heartbeat_manager::process_reply(
           "Received error when sending heartbeats to node {} - {}",
           n,
           r.error().message());
-        for (auto& [g, req_meta] : groups) {
+        for (auto& req_meta : groups) {
+            auto g = req_meta.c->group();
             auto it = _consensus_groups.find(g);
             if (it == _consensus_groups.end()) {
                 vlog(
@@ -326,8 +528,15 @@ void heartbeat_manager::process_reply(
             continue;
         }
 
-        auto meta_it = groups.find(m.group);
-        if (unlikely(meta_it == groups.end())) {
+        auto meta_it = std::lower_bound(
+          groups.begin(),
+          groups.end(),
+          m.group,
+          [](const follower_request_meta& meta, raft::group_id g) {
+              return meta.c->group() < g;
+          });
+        if (unlikely(
+              meta_it == groups.end() || meta_it->c->group() != m.group)) {
             vlog(
               hbeatlog.warn,
               "Unexpected heartbeat reply for group {} from node {}, skipping: "
@@ -338,14 +547,13 @@ void heartbeat_manager::process_reply(
             continue;
         }
 
-        consensus->update_heartbeat_status(
-          meta_it->second.follower_vnode, true);
+        consensus->update_heartbeat_status(meta_it->follower_vnode, true);
 
         consensus->process_append_entries_reply(
           n,
           result<append_entries_reply>(m),
-          meta_it->second.seq,
-          meta_it->second.dirty_offset);
+          meta_it->seq,
+          meta_it->dirty_offset);
     }
 }
 
@@ -376,14 +584,33 @@ ss::future<> heartbeat_manager::deregister_group(group_id g) {
 
 ss::future<>
 heartbeat_manager::register_group(ss::lw_shared_ptr<consensus> ptr) {
-    return _lock.with([this, ptr = std::move(ptr)] {
-        auto ret = _consensus_groups.insert(ptr);
+    _pending_registrations.push_back(std::move(ptr));
+    // the first waiter to get the lock registers all the pending groups, the
+    // following ones find nothing left to do
+    return _lock.with([this] { apply_pending_registrations(); });
+}
+
+void heartbeat_manager::apply_pending_registrations() {
+    if (_pending_registrations.empty()) {
+        return;
+    }
+    auto groups = std::exchange(_pending_registrations, {});
+    std::sort(
+      groups.begin(), groups.end(), details::consensus_ptr_by_group_id{});
+    for (auto it = groups.begin(); it != groups.end(); ++it) {
+        const auto next = std::next(it);
+        const bool duplicate = _consensus_groups.find(*it)
+                                 != _consensus_groups.end()
+                               || (next != groups.end()
+                                   && (*next)->group() == (*it)->group());
         vassert(
-          ret.second,
+          !duplicate,
           "double registration of group: {}:{}",
-          ptr->ntp(),
-          ptr->group());
-    });
+          (*it)->ntp(),
+          (*it)->group());
+    }
+    _consensus_groups.insert(
+      boost::container::ordered_unique_range, groups.begin(), groups.end());
 }
 
 ss::future<> heartbeat_manager::start() {
@@ -16,13 +16,14 @@
 #include "raft/consensus.h"
 #include "raft/consensus_client_protocol.h"
 #include "raft/group_configuration.h"
+#include "raft/raft_feature_table.h"
 #include "raft/types.h"
 #include "utils/mutex.h"
 
 #include <seastar/core/sharded.hh>
 #include <seastar/util/log.hh>
 
-#include <absl/container/btree_map.h>
+#include <absl/container/flat_hash_map.h>
 #include <boost/container/flat_set.hpp>
 
 namespace raft::details {
@@ -80,6 +81,17 @@ extern ss::logger hbeatlog;
  *
  *    heartbeat({L0, L1}) -> {F0, F1}(node-b)
  *    heartbeat({L0, L1}) -> {F0, F1}(node-c)
+ *
+ * Groups that are idle (see consensus::can_quiesce) do not need a heartbeat
+ * per group. When `raft_quiescence_timeout_ms` is set the manager keeps, per
+ * follower node, the list of idle groups it leads there and sends it in a
+ * node_lease request. Once the node renewed a list, the heartbeats of its
+ * groups are skipped and every following lease renews all of them at once:
+ *
+ *    node_lease(generation: 7) -> node-b
+ *
+ * The list is sent again only when it changes (a new generation) or the
+ * node lost it. A failed lease resumes the heartbeats of its groups.
  */
 class heartbeat_manager {
 public:
@@ -103,28 +115,27 @@ public:
         model::offset dirty_offset;
         vnode follower_vnode;
     };
+    // each raft group has its own follower metadata to track a sequence per
+    // group, heartbeats are built in group order so the vector is sorted by
+    // group and looked up with a binary search
+    using follower_request_metas = std::vector<follower_request_meta>;
+
     // Heartbeats from all groups for single node
     struct node_heartbeat {
-        node_heartbeat(
-          model::node_id t,
-          heartbeat_request req,
-          absl::btree_map<raft::group_id, follower_request_meta> seqs)
-          : target(t)
-          , request(std::move(req))
-          , meta_map(std::move(seqs)) {}
+        explicit node_heartbeat(model::node_id t)
+          : target(t) {}
 
         model::node_id target;
         heartbeat_request request;
-        // each raft group has its own follower metadata hence we need map to
-        // track a sequence per group
-        absl::btree_map<raft::group_id, follower_request_meta> meta_map;
+        follower_request_metas meta_map;
     };
 
     heartbeat_manager(
       duration_type interval,
       consensus_client_protocol,
       model::node_id,
-      duration_type);
+      duration_type,
+      const raft_feature_table* features = nullptr);
 
     ss::future<> register_group(ss::lw_shared_ptr<consensus>);
     ss::future<> deregister_group(raft::group_id);
@@ -137,6 +148,10 @@ public:
 private:
     void dispatch_heartbeats();
 
+    /// \brief adds the groups waiting for registration to the set, must be
+    /// called with the lock held
+    void apply_pending_registrations();
+
     clock_type::time_point next_heartbeat_timeout();
 
     /// \brief unprotected, must be used inside the gate & semaphore
@@ -155,9 +170,32 @@ private:
     /// \param result if the node return successful heartbeats
     void process_reply(
       model::node_id n,
-      absl::btree_map<raft::group_id, follower_request_meta> groups,
+      follower_request_metas groups,
       result<heartbeat_reply> result);
 
+    // idle groups leased to a follower node
+    struct node_lease_state {
+        uint64_t generation{0};
+        // the node holds the groups of the current generation
+        bool acked{false};
+        // current generation, sorted by group
+        std::vector<lease_group> groups;
+        // groups of the last generation the node renewed, their heartbeats
+        // are skipped
+        std::vector<lease_group> renewed_groups;
+    };
+
+    std::optional<clock_type::duration> quiescence_timeout() const;
+    /// \brief recomputes the idle groups leased to every follower node
+    void update_node_leases(clock_type::duration idle_timeout);
+    /// \brief true if a node lease stands in for the heartbeat of the group
+    bool is_leased(
+      const consensus_ptr&, const vnode&, clock_type::duration idle_timeout);
+    ss::future<> send_node_leases();
+    ss::future<> do_node_lease(model::node_id, node_lease_request);
+    void process_lease_reply(
+      model::node_id, uint64_t generation, result<node_lease_reply>);
+
     // private members
 
     mutex _lock;
@@ -170,7 +208,15 @@ private:
     /// insertion/deletion happens very infrequently.
     /// this is optimized for traversal + finding
     consensus_set _consensus_groups;
+    /// groups are registered in batches, creating many partitions at once
+    /// would otherwise insert into the flat set one group at a time
+    std::vector<consensus_ptr> _pending_registrations;
     consensus_client_protocol _client_protocol;
     model::node_id _self;
+    // no quiescence without a feature table
+    const raft_feature_table* _features;
+    const uint64_t _lease_epoch;
+    uint64_t _lease_generation{0};
+    absl::flat_hash_map<model::node_id, node_lease_state> _leases;
 };
 } // namespace raft
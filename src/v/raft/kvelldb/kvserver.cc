@@ -23,6 +23,7 @@
 #include "raft/raft_feature_table.h"
 #include "raft/rpc_client_protocol.h"
 #include "raft/service.h"
+#include "raft/timer_wheel.h"
 #include "raft/types.h"
 #include "rpc/connection_cache.h"
 #include "rpc/simple_protocol.h"
@@ -160,6 +161,7 @@ private:
       model::partition_id(ss::this_shard_id())};
     ss::lw_shared_ptr<raft::consensus> _consensus;
     raft::raft_feature_table _features;
+    raft::timer_wheel _timers;
 
     ss::future<>
     init_consensus(raft::group_configuration&& cfg, storage::log log) {
@@ -191,7 +193,8 @@ private:
           _storage,
           std::nullopt,
           _recovery_memory_quota,
-          _features);
+          _features,
+          _timers);
         return _consensus->start().then(
           [this] { return _hbeats.register_group(_consensus); });
     }
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "bytes/iobuf.h"
 #include "model/fundamental.h"
 #include "model/record.h"
 #include "model/record_batch_reader.h"
@@ -19,21 +20,35 @@
 #include "raft/consensus.h"
 #include "raft/errc.h"
 #include "raft/state_machine.h"
+#include "serde/envelope.h"
+#include "serde/serde.h"
 #include "ssx/future-util.h"
+#include "ssx/semaphore.h"
+#include "storage/snapshot.h"
 #include "utils/expiring_promise.h"
+#include "utils/mutex.h"
 #include "vassert.h"
+#include "vlog.h"
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/shared_ptr.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/core/timed_out_error.hh>
 #include <seastar/util/bool_class.hh>
 #include <seastar/util/log.hh>
 
 #include <absl/container/node_hash_map.h>
 
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <filesystem>
 #include <optional>
+#include <string_view>
 #include <system_error>
+#include <type_traits>
 #include <variant>
+#include <vector>
 
 namespace raft {
 
@@ -47,6 +62,36 @@ namespace raft {
     };
 // clang-format on
 
+// A state that shares no data with the other states of the mux_stm declares
+// `static constexpr bool independent_apply = true`
+template<typename T>
+concept IndependentState = State<T> && requires {
+    requires T::independent_apply;
+};
+
+// A state that can be restored from a snapshot of the mux_stm. The snapshot
+// of the state is an opaque buffer, it is taken and restored on the shard of
+// the mux_stm
+template<typename T>
+concept SnapshotableState = State<T>
+  && requires(T s, model::offset o, iobuf buf) {
+    { s.take_snapshot(o) } -> std::same_as<ss::future<iobuf>>;
+    { s.apply_snapshot(o, std::move(buf)) } -> std::same_as<ss::future<>>;
+};
+
+struct mux_snapshot_metadata
+  : serde::envelope<
+      mux_snapshot_metadata,
+      serde::version<0>,
+      serde::compat_version<0>> {
+    // all batches up to the offset are applied to the states
+    model::offset offset;
+    // size of the state snapshots following the metadata
+    uint64_t size{0};
+
+    auto serde_fields() { return std::tie(offset, size); }
+};
+
 using persistent_last_applied
   = ss::bool_class<struct persistent_last_applied_tag>;
 
@@ -62,10 +107,20 @@ using persistent_last_applied
 // state. Thanks to this approach it is easy to implement the optimistic
 // locking concurrency control in state.
 //
+// When all the states are SnapshotableState the mux_stm can write a local
+// snapshot of the states with write_snapshot. The snapshot is loaded when the
+// mux_stm starts, the states are restored in their order and only the batches
+// following the snapshot are applied. The log is not truncated.
+//
 // IMPORTANT: is_batch_applicable results have to be mutually exclusive. i.e.
 // when batch is applicable for one state is has to be not applicable for
 // another
 //
+// Updates are applied in order of their offsets, except that the updates of
+// an IndependentState are applied concurrently with the updates of the other
+// states, so i.e. a burst of topic commands doesn't delay security commands.
+// Results are published and waiters are notified in offset order.
+//
 // +---------+               +---------+      +-------+ +---------+
 // | caller  |               | mux_stm |      | raft  | | state_1 |
 // +---------+               +---------+      +-------+ +---------+
@@ -103,8 +158,17 @@ public:
     mux_state_machine& operator=(const mux_state_machine&) = delete;
     ~mux_state_machine() final = default;
 
+    static constexpr bool snapshots_enabled = (SnapshotableState<T> && ...);
+    static constexpr std::string_view snapshot_name
+      = "mux_state_machine.snapshot";
+
     // Lifecycle management
-    ss::future<> start() final { return raft::state_machine::start(); }
+    ss::future<> start() final {
+        if constexpr (snapshots_enabled) {
+            co_await load_snapshot();
+        }
+        co_await raft::state_machine::start();
+    }
 
     ss::future<> stop() final {
         // close the gate so no new requests will be handled
@@ -128,10 +192,56 @@ public:
       ss::abort_source& as,
       std::optional<model::term_id> term = std::nullopt);
 
+    /// Called once the states are applied up to a snapshot offset and no
+    /// batch is being applied, returns false if the snapshot can't be taken.
+    using snapshot_precondition = ss::noncopyable_function<ss::future<bool>()>;
+
+    /// Writes a snapshot of the states at the last applied offset. Returns
+    /// false if no snapshot was written, i.e. nothing was applied since the
+    /// last one or the precondition failed.
+    ss::future<bool> write_snapshot(snapshot_precondition);
+
+    /// Offset of the last snapshot written or loaded
+    model::offset last_snapshot_offset() const { return _snapshot_offset; }
+
 private:
     using promise_t = expiring_promise<std::error_code>;
 
+    // updates being applied at the same time
+    static constexpr size_t max_inflight_updates = 128;
+    static constexpr auto apply_retry_backoff = std::chrono::milliseconds(100);
+
+    struct inflight_update {
+        model::offset last_offset;
+        bool applied{false};
+        // not set for batches no state applies
+        std::optional<std::error_code> result;
+    };
+
     ss::future<> apply(model::record_batch b) final;
+    bool defers_apply_notifications() const final { return true; }
+
+    // independent states have a lane each, the other states share lane 0
+    template<typename S>
+    static constexpr size_t lane() {
+        if constexpr (IndependentState<S>) {
+            constexpr std::array<bool, sizeof...(T)> matches{
+              std::is_same_v<S, T>...};
+            return 1 + std::distance(
+                     matches.begin(),
+                     std::find(matches.begin(), matches.end(), true));
+        } else {
+            return 0;
+        }
+    }
+
+    template<typename S>
+    ss::future<> apply_in_lane(S&, model::record_batch, ssx::semaphore_units);
+    void mark_applied(model::offset, std::optional<std::error_code>);
+    void publish(const inflight_update&);
+    void publish_applied(model::offset);
+
+    ss::future<> load_snapshot();
     class replicate_units {
     public:
         explicit replicate_units(mux_state_machine<T...>* stm)
@@ -168,6 +278,7 @@ private:
     replicate_units get_units() { return replicate_units(this); }
 
     consensus* _c;
+    ss::logger& _logger;
     absl::node_hash_map<model::offset, std::error_code> _results;
     model::offset _last_applied;
     int64_t _pending = 0;
@@ -176,6 +287,17 @@ private:
     // we keep states in a tuple to automatically dispatch updates to correct
     // state
     std::tuple<T&...> _state;
+    // updates are published from the front once they are applied
+    std::deque<inflight_update> _inflight;
+    ssx::semaphore _inflight_sem{max_inflight_updates, "raft/mux-apply"};
+    // tail of the updates being applied in every lane
+    std::vector<ss::future<>> _lanes;
+    // held while a batch is dispatched to a lane
+    mutex _dispatch_lock;
+    // every batch up to the offset is applied
+    model::offset _last_published;
+    model::offset _snapshot_offset;
+    storage::simple_snapshot_manager _snapshot_mgr;
 };
 
 template<typename... T>
@@ -186,8 +308,18 @@ requires(State<T>, ...) mux_state_machine<T...>::mux_state_machine(
   T&... state)
   : raft::state_machine(c, logger, ss::default_priority_class())
   , _c(c)
+  , _logger(logger)
   , _persist_last_applied(persist)
-  , _state(state...) {}
+  , _state(state...)
+  , _snapshot_mgr(
+      std::filesystem::path(c->log_config().work_directory()),
+      ss::sstring(snapshot_name),
+      ss::default_priority_class()) {
+    _lanes.reserve(sizeof...(T) + 1);
+    for (size_t i = 0; i <= sizeof...(T); ++i) {
+        _lanes.push_back(ss::now());
+    }
+}
 
 template<typename... T>
 requires(State<T>, ...)
@@ -294,52 +426,237 @@ is_batch_applicable(State& s, const model::record_batch& batch) {
 template<typename... T>
 requires(State<T>, ...) ss::future<> mux_state_machine<T...>::apply(
   model::record_batch b) {
-    return ss::with_gate(_gate, [this, b = std::move(b)]() mutable {
-        // lookup for the state to apply the update
-        auto state = std::apply(
-          [&b](T&... st) {
-              using variant_t = std::variant<T*...>;
-              std::optional<variant_t> res;
-              (void)((res = is_batch_applicable(st, b), res) || ...);
-              return res;
-          },
-          _state);
+    auto holder = _gate.hold();
+    // lookup for the state to apply the update
+    auto state = std::apply(
+      [&b](T&... st) {
+          using variant_t = std::variant<T*...>;
+          std::optional<variant_t> res;
+          (void)((res = is_batch_applicable(st, b), res) || ...);
+          return res;
+      },
+      _state);
+
+    auto last_offset = b.last_offset();
+    auto dispatch_units = co_await _dispatch_lock.get_units();
+    // applicable state not found
+    if (!state) {
+        vassert(
+          b.header().type == model::record_batch_type::checkpoint
+            || b.header().type == model::record_batch_type::raft_configuration,
+          "State handler for batch of type: {} not found",
+          b.header().type);
+        if (_inflight.empty()) {
+            publish_applied(last_offset);
+        } else {
+            _inflight.push_back(
+              inflight_update{.last_offset = last_offset, .applied = true});
+        }
+        co_return;
+    }
+
+    auto units = co_await ss::get_units(_inflight_sem, 1);
+    _inflight.push_back(inflight_update{.last_offset = last_offset});
+    // apply update after the previous updates of the lane
+    std::visit(
+      [this, &b, &units](auto* state) {
+          using state_t = std::remove_pointer_t<decltype(state)>;
+          auto& tail = _lanes[lane<state_t>()];
+          tail = std::move(tail).then([this,
+                            state,
+                            b = std::move(b),
+                            units = std::move(units)]() mutable {
+              return apply_in_lane(*state, std::move(b), std::move(units));
+          });
+      },
+      *state);
+}
+
+template<typename... T>
+requires(State<T>, ...) template<typename S>
+ss::future<> mux_state_machine<T...>::apply_in_lane(
+  S& state, model::record_batch b, ssx::semaphore_units) {
+    auto holder = _gate.hold();
+    const auto last_offset = b.last_offset();
+    // same as the state_machine, an update that failed is applied again
+    while (true) {
+        try {
+            auto ec = co_await state.apply_update(b.share());
+            mark_applied(last_offset, ec);
+            co_return;
+        } catch (...) {
+            vlog(
+              _logger.warn,
+              "Error applying batch at offset {} to the state of ntp {}: {}",
+              last_offset,
+              _c->ntp(),
+              std::current_exception());
+        }
+        if (_gate.is_closed()) {
+            co_return;
+        }
+        co_await ss::sleep(apply_retry_backoff);
+    }
+}
+
+template<typename... T>
+requires(State<T>, ...) void mux_state_machine<T...>::mark_applied(
+  model::offset last_offset, std::optional<std::error_code> ec) {
+    auto it = std::lower_bound(
+      _inflight.begin(),
+      _inflight.end(),
+      last_offset,
+      [](const inflight_update& u, model::offset o) {
+          return u.last_offset < o;
+      });
+    vassert(
+      it != _inflight.end() && it->last_offset == last_offset,
+      "applied update at offset {} is not in flight",
+      last_offset);
+    it->applied = true;
+    it->result = ec;
+
+    while (!_inflight.empty() && _inflight.front().applied) {
+        publish(_inflight.front());
+        _inflight.pop_front();
+    }
+}
 
-        // applicable state not found
-        if (!state) {
-            vassert(
-              b.header().type == model::record_batch_type::checkpoint
-                || b.header().type
-                     == model::record_batch_type::raft_configuration,
-              "State handler for batch of type: {} not found",
-              b.header().type);
-            return ss::now();
+template<typename... T>
+requires(State<T>, ...) void mux_state_machine<T...>::publish(
+  const inflight_update& update) {
+    const auto last_offset = update.last_offset;
+    if (update.result) {
+        _last_applied = last_offset;
+        if (_pending > 0) {
+            _results.emplace(last_offset, *update.result);
+            _new_result.broadcast();
+        } else {
+            _results.clear();
         }
+        if (_persist_last_applied && last_offset > _c->read_last_applied()) {
+            ssx::spawn_with_gate(_gate, [this, last_offset] {
+                return _c->write_last_applied(last_offset);
+            });
+        }
+    }
+    publish_applied(last_offset);
+}
+
+template<typename... T>
+requires(State<T>, ...) void mux_state_machine<T...>::publish_applied(
+  model::offset last_offset) {
+    _last_published = last_offset;
+    notify_applied(last_offset);
+}
 
-        auto last_offset = b.last_offset();
-        // apply update
-        auto result_f = std::visit(
-          [b = std::move(b)](auto& state) mutable {
-              return state->apply_update(std::move(b));
+template<typename... T>
+requires(State<T>, ...) ss::future<bool> mux_state_machine<T...>::
+  write_snapshot(snapshot_precondition precondition) {
+    static_assert(snapshots_enabled, "all states have to be snapshotable");
+    auto holder = _gate.hold();
+    std::vector<iobuf> states;
+    model::offset offset;
+    {
+        // stop dispatching and wait for the batches being applied
+        auto units = co_await _dispatch_lock.get_units();
+        for (auto& tail : _lanes) {
+            co_await std::exchange(tail, ss::now());
+        }
+        offset = _last_published;
+        if (
+          !_inflight.empty() || offset <= _snapshot_offset
+          || !co_await precondition()) {
+            co_return false;
+        }
+        states.reserve(sizeof...(T));
+        co_await std::apply(
+          [offset, &states](T&... st) -> ss::future<> {
+              (states.push_back(co_await st.take_snapshot(offset)), ...);
           },
-          *state);
-
-        return result_f.then([this, last_offset](std::error_code ec) {
-            _last_applied = last_offset;
-            if (_pending > 0) {
-                _results.emplace(last_offset, ec);
-                _new_result.broadcast();
-            } else {
-                _results.clear();
-            }
-            if (
-              _persist_last_applied && last_offset > _c->read_last_applied()) {
-                ssx::spawn_with_gate(_gate, [this, last_offset] {
-                    return _c->write_last_applied(last_offset);
-                });
-            }
-        });
-    });
+          _state);
+    }
+
+    auto data = serde::to_iobuf(std::move(states));
+    auto metadata = serde::to_iobuf(
+      mux_snapshot_metadata{.offset = offset, .size = data.size_bytes()});
+    auto writer = co_await _snapshot_mgr.start_snapshot();
+    std::exception_ptr ep;
+    try {
+        co_await writer.write_metadata(std::move(metadata));
+        co_await write_iobuf_to_output_stream(
+          std::move(data), writer.output());
+    } catch (...) {
+        ep = std::current_exception();
+    }
+    co_await writer.close();
+    if (ep) {
+        std::rethrow_exception(ep);
+    }
+    co_await _snapshot_mgr.finish_snapshot(writer);
+    _snapshot_offset = offset;
+    vlog(
+      _logger.info,
+      "Wrote snapshot of {} at offset {}",
+      _c->ntp(),
+      _snapshot_offset);
+    co_return true;
+}
+
+template<typename... T>
+requires(State<T>, ...) ss::future<> mux_state_machine<T...>::load_snapshot() {
+    auto reader = co_await _snapshot_mgr.open_snapshot();
+    if (!reader) {
+        co_return;
+    }
+    // a snapshot that can't be read is ignored and the whole log is applied
+    mux_snapshot_metadata metadata;
+    std::vector<iobuf> states;
+    std::exception_ptr ep;
+    try {
+        metadata = serde::from_iobuf<mux_snapshot_metadata>(
+          co_await reader->read_metadata());
+        states = serde::from_iobuf<std::vector<iobuf>>(
+          co_await read_iobuf_exactly(reader->input(), metadata.size));
+    } catch (...) {
+        ep = std::current_exception();
+    }
+    co_await reader->close();
+    co_await _snapshot_mgr.remove_partial_snapshots();
+    if (ep) {
+        vlog(
+          _logger.warn,
+          "Ignoring snapshot {}: {}",
+          _snapshot_mgr.snapshot_path(),
+          ep);
+        co_return;
+    }
+    if (states.size() != sizeof...(T)) {
+        vlog(
+          _logger.warn,
+          "Ignoring snapshot {} of {} states, expected {}",
+          _snapshot_mgr.snapshot_path(),
+          states.size(),
+          sizeof...(T));
+        co_return;
+    }
+
+    const auto offset = metadata.offset;
+    vlog(
+      _logger.info,
+      "Loading snapshot of {} at offset {}",
+      _c->ntp(),
+      offset);
+    co_await std::apply(
+      [offset, &states](T&... st) -> ss::future<> {
+          size_t i = 0;
+          (co_await st.apply_snapshot(offset, std::move(states[i++])), ...);
+      },
+      _state);
+    _snapshot_offset = offset;
+    _last_applied = offset;
+    set_next(model::next_offset(offset));
+    publish_applied(offset);
 }
 
 } // namespace raft
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/metadata.h"
+#include "raft/types.h"
+
+#include <absl/container/flat_hash_map.h>
+
+#include <utility>
+#include <vector>
+
+namespace raft {
+
+/**
+ * Node leases held by the follower groups of a shard.
+ *
+ * A leader shard stops sending heartbeats to its quiescent groups and sends
+ * one node_lease request per heartbeat interval to every follower node
+ * instead. The groups are listed only when the list changes (a new
+ * generation); every shard keeps its part of the list and renews those groups
+ * when a lease of the same generation arrives, so steady state leases carry
+ * no per group data.
+ *
+ * A lease renews a group only while the leader of the lease is the leader of
+ * the group in the same term. Once leases stop arriving the groups time out
+ * and elect a new leader as if heartbeats had stopped.
+ */
+class node_lease_table {
+public:
+    // leader node and shard
+    using source = std::pair<model::node_id, uint32_t>;
+
+    /// Replace the groups held for the source
+    void update(
+      source src,
+      uint64_t epoch,
+      uint64_t generation,
+      std::vector<lease_group> groups) {
+        _leases[src] = held_lease{
+          .epoch = epoch,
+          .generation = generation,
+          .groups = std::move(groups)};
+    }
+
+    /// Renew the groups held for the source. Returns false if the held
+    /// groups are not of the given generation and the leader has to send
+    /// them again.
+    template<typename ConsensusLookup>
+    bool renew(
+      source src,
+      uint64_t epoch,
+      uint64_t generation,
+      ConsensusLookup&& consensus_for) {
+        auto it = _leases.find(src);
+        if (
+          it == _leases.end() || it->second.epoch != epoch
+          || it->second.generation != generation) {
+            return false;
+        }
+        for (const auto& g : it->second.groups) {
+            if (auto c = consensus_for(g.group); c) {
+                c->renew_lease(g);
+            }
+        }
+        return true;
+    }
+
+    size_t size() const { return _leases.size(); }
+
+private:
+    struct held_lease {
+        uint64_t epoch;
+        uint64_t generation;
+        std::vector<lease_group> groups;
+    };
+
+    absl::flat_hash_map<source, held_lease> _leases;
+};
+
+/// Leases of the groups on this shard
+inline node_lease_table& node_leases() {
+    static thread_local node_lease_table leases;
+    return leases;
+}
+
+} // namespace raft
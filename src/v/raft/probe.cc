@@ -116,11 +116,68 @@ void probe::setup_metrics(const model::ntp& ntp) {
          sm::description("Number of failed heartbeat requests"),
          labels)
          .aggregate(aggregate_labels),
+       sm::make_counter(
+         "lease_reads",
+         [this] { return _lease_reads; },
+         sm::description(
+           "Number of linearizable barriers served by the leader lease"),
+         labels)
+         .aggregate(aggregate_labels),
+       sm::make_counter(
+         "lease_read_misses",
+         [this] { return _lease_read_misses; },
+         sm::description("Number of linearizable barriers that needed a round "
+                         "of heartbeats because the leader lease was not "
+                         "valid"),
+         labels)
+         .aggregate(aggregate_labels),
        sm::make_counter(
          "recovery_requests_errors",
          [this] { return _recovery_request_error; },
          sm::description("Number of failed recovery requests"),
          labels)
+         .aggregate(aggregate_labels),
+       sm::make_counter(
+         "replicate_batches_flushed",
+         [this] { return _replicate_batch_flushed; },
+         sm::description("Number of appends cut by the replicate batcher"),
+         labels)
+         .aggregate(aggregate_labels),
+       sm::make_counter(
+         "replicate_batcher_lingers",
+         [this] { return _replicate_batcher_lingers; },
+         sm::description("Number of times the replicate batcher held cached "
+                         "requests waiting for more data"),
+         labels)
+         .aggregate(aggregate_labels),
+       sm::make_gauge(
+         "write_caching_unflushed_bytes",
+         [this] { return _unflushed_bytes; },
+         sm::description("Bytes acknowledged to the producers that are not "
+                         "yet flushed to disk"),
+         labels)
+         .aggregate(aggregate_labels),
+       sm::make_gauge(
+         "write_caching_unflushed_age_ms",
+         [this] {
+             if (_unflushed_bytes == 0) {
+                 return int64_t(0);
+             }
+             return int64_t(
+               std::chrono::duration_cast<std::chrono::milliseconds>(
+                 ss::lowres_clock::now() - _unflushed_since)
+                 .count());
+         },
+         sm::description("Age of the oldest acknowledged write that is not "
+                         "yet flushed to disk"),
+         labels)
+         .aggregate(aggregate_labels),
+       sm::make_counter(
+         "write_caching_deferred_flushes",
+         [this] { return _deferred_flushes; },
+         sm::description("Number of background flushes triggered by the write "
+                         "caching byte or time budget"),
+         labels)
          .aggregate(aggregate_labels)});
 }
 
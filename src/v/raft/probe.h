@@ -12,6 +12,7 @@
 #pragma once
 #include "model/fundamental.h"
 
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/core/metrics.hh>
 #include <seastar/core/metrics_registration.hh>
 
@@ -33,17 +34,29 @@ public:
     void log_flushed() { ++_log_flushes; }
 
     void replicate_batch_flushed() { ++_replicate_batch_flushed; }
+    void replicate_batcher_lingered() { ++_replicate_batcher_lingers; }
     void recovery_append_request() { ++_recovery_requests; }
     void configuration_update() { ++_configuration_updates; }
 
     void leadership_changed() { ++_leadership_changes; }
 
+    void write_caching_append(size_t unflushed_bytes) {
+        if (_unflushed_bytes == 0) {
+            _unflushed_since = ss::lowres_clock::now();
+        }
+        _unflushed_bytes = unflushed_bytes;
+    }
+    void write_caching_flushed() { _unflushed_bytes = 0; }
+    void write_caching_deferred_flush() { ++_deferred_flushes; }
+
     static std::vector<ss::metrics::label_instance>
     create_metric_labels(const model::ntp& ntp);
 
     void setup_metrics(const model::ntp& ntp);
 
     void heartbeat_request_error() { ++_heartbeat_request_error; };
+    void lease_read() { ++_lease_reads; }
+    void lease_read_miss() { ++_lease_read_misses; }
     void replicate_request_error() { ++_replicate_request_error; };
     void recovery_request_error() { ++_recovery_request_error; };
 
@@ -57,6 +70,7 @@ private:
     uint64_t _replicate_requests_done = 0;
     uint64_t _log_flushes = 0;
     uint64_t _replicate_batch_flushed = 0;
+    uint64_t _replicate_batcher_lingers = 0;
     uint32_t _log_truncations = 0;
     uint32_t _configuration_updates = 0;
     uint64_t _recovery_requests = 0;
@@ -64,6 +78,12 @@ private:
     uint64_t _heartbeat_request_error = 0;
     uint64_t _replicate_request_error = 0;
     uint64_t _recovery_request_error = 0;
+    uint64_t _lease_reads = 0;
+    uint64_t _lease_read_misses = 0;
+    uint64_t _deferred_flushes = 0;
+    // acknowledged writes not yet flushed to disk, only with write caching
+    size_t _unflushed_bytes = 0;
+    ss::lowres_clock::time_point _unflushed_since;
 
     ss::metrics::metric_groups _metrics;
 };
@@ -18,6 +18,14 @@ namespace raft {
 
 enum class raft_feature {
     improved_config_change = 0,
+    // leaders may coalesce append_entries to the same node in one rpc
+    append_entries_batching = 1,
+    // leaders may renew idle groups with one node lease per node
+    node_lease = 2,
+    // candidates may coalesce vote requests to the same node in one rpc
+    vote_batching = 3,
+    // leaders may coalesce timeout_now requests to the same node in one rpc
+    timeout_now_batching = 4,
 };
 /**
  *  Simple class aggregating information about raft features, it will be used by
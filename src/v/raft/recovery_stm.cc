@@ -9,6 +9,7 @@
 
 #include "raft/recovery_stm.h"
 
+#include "config/configuration.h"
 #include "model/fundamental.h"
 #include "model/record_batch_reader.h"
 #include "outcome_future_utils.h"
@@ -17,6 +18,7 @@
 #include "raft/errc.h"
 #include "raft/logger.h"
 #include "raft/raftgen_service.h"
+#include "ssx/future-util.h"
 #include "ssx/sformat.h"
 
 #include <seastar/core/condition-variable.hh>
@@ -49,7 +51,9 @@ recovery_stm::recovery_stm(
         _node_id,
         _ptr->group(),
         _ptr->ntp()))
-  , _memory_quota(quota) {}
+  , _memory_quota(quota)
+  , _max_window(
+      config::shard_local_cfg().raft_recovery_max_inflight_requests()) {}
 
 ss::future<> recovery_stm::recover() {
     auto meta = get_follower_meta();
@@ -78,12 +82,40 @@ ss::future<> recovery_stm::do_recover(ss::io_priority_class iopc) {
         co_return;
     }
 
+    // the window is full or a request in flight failed, wait for replies
+    if (_inflight > 0 && (_inflight >= _window || _pipeline_failed)) {
+        co_await wait_for_inflight();
+        co_return;
+    }
+    _pipeline_failed = false;
+
     auto lstats = _ptr->_log.offsets();
     // follower last index was already evicted at the leader, use snapshot
     if (meta.value()->next_index <= _ptr->_last_snapshot_index) {
+        if (_inflight > 0) {
+            co_await _inflight_cv.wait([this] { return _inflight == 0; });
+            co_return;
+        }
         co_return co_await install_snapshot();
     }
 
+    // the follower is missing a prefix that is archived and can be read from
+    // outside of the local log, skip it instead of reading it from disk
+    if (config::shard_local_cfg().raft_recovery_skip_archived_prefix()) {
+        auto archived = _ptr->archived_offset();
+        if (
+          meta.value()->next_index <= archived
+          && archived > _ptr->_last_snapshot_index) {
+            if (_inflight > 0) {
+                co_await _inflight_cv.wait([this] { return _inflight == 0; });
+                co_return;
+            }
+            if (co_await install_archived_snapshot(archived)) {
+                co_return;
+            }
+        }
+    }
+
     /**
      * We have to store committed_index before doing read as we perform
      * recovery without holding consensus op_lock. Storing committed index
@@ -116,7 +148,10 @@ ss::future<> recovery_stm::do_recover(ss::io_priority_class iopc) {
      */
     _committed_offset = _ptr->committed_offset();
 
-    auto follower_next_offset = meta.value()->next_index;
+    // with requests in flight the next range follows the last one sent
+    auto follower_next_offset = _inflight > 0 ? model::next_offset(
+                                  meta.value()->last_sent_offset)
+                                              : meta.value()->next_index;
     auto follower_committed_match_index = meta.value()->match_committed_index();
     auto is_learner = meta.value()->is_learner;
 
@@ -265,6 +300,7 @@ ss::future<> recovery_stm::open_snapshot_reader() {
           if (rdr) {
               _snapshot_reader = std::make_unique<storage::snapshot_reader>(
                 std::move(*rdr));
+              _snapshot_index = _ptr->_last_snapshot_index;
               return _snapshot_reader->get_snapshot_size().then(
                 [this](size_t sz) { _snapshot_size = sz; });
           }
@@ -273,46 +309,56 @@ ss::future<> recovery_stm::open_snapshot_reader() {
 }
 
 ss::future<> recovery_stm::send_install_snapshot_request() {
-    // send 32KB at a time
-    return read_iobuf_exactly(_snapshot_reader->input(), 32_KiB)
-      .then([this](iobuf chunk) mutable {
-          auto chunk_size = chunk.size_bytes();
-          install_snapshot_request req{
-            .target_node_id = _node_id,
-            .term = _ptr->term(),
-            .group = _ptr->group(),
-            .node_id = _ptr->_self,
-            .last_included_index = _ptr->_last_snapshot_index,
-            .file_offset = _sent_snapshot_bytes,
-            .chunk = std::move(chunk),
-            .done = (_sent_snapshot_bytes + chunk_size) == _snapshot_size};
-
-          vlog(
-            _ctxlog.trace,
-            "Sending install snapshot request, last included index: {}",
-            req.last_included_index);
-          auto seq = _ptr->next_follower_sequence(_node_id);
+    // send 32KB at a time, only a single chunk of the snapshot is kept in
+    // memory
+    static constexpr size_t chunk_size = 32_KiB;
+    if (_ptr->_recovery_throttle) {
+        co_await _ptr->_recovery_throttle->get().throttle(
+          std::min(chunk_size, _snapshot_size - _sent_snapshot_bytes),
+          _ptr->_as);
+    }
+    auto chunk = co_await read_iobuf_exactly(
+      _snapshot_reader->input(), chunk_size);
+    co_await send_install_snapshot_chunk(std::move(chunk));
+}
+
+ss::future<> recovery_stm::send_install_snapshot_chunk(iobuf chunk) {
+    auto chunk_size = chunk.size_bytes();
+    install_snapshot_request req{
+      .target_node_id = _node_id,
+      .term = _ptr->term(),
+      .group = _ptr->group(),
+      .node_id = _ptr->_self,
+      .last_included_index = _snapshot_index,
+      .file_offset = _sent_snapshot_bytes,
+      .chunk = std::move(chunk),
+      .done = (_sent_snapshot_bytes + chunk_size) == _snapshot_size};
+
+    vlog(
+      _ctxlog.trace,
+      "Sending install snapshot request, last included index: {}",
+      req.last_included_index);
+    auto seq = _ptr->next_follower_sequence(_node_id);
+    _ptr->update_suppress_heartbeats(_node_id, seq, heartbeats_suppressed::yes);
+    return _ptr->_client_protocol
+      .install_snapshot(
+        _node_id.id(),
+        std::move(req),
+        rpc::client_opts(append_entries_timeout()))
+      .then([this](result<install_snapshot_reply> reply) {
+          return handle_install_snapshot_reply(
+            _ptr->validate_reply_target_node(
+              "install_snapshot", std::move(reply)));
+      })
+      .finally([this, seq] {
           _ptr->update_suppress_heartbeats(
-            _node_id, seq, heartbeats_suppressed::yes);
-          return _ptr->_client_protocol
-            .install_snapshot(
-              _node_id.id(),
-              std::move(req),
-              rpc::client_opts(append_entries_timeout()))
-            .then([this](result<install_snapshot_reply> reply) {
-                return handle_install_snapshot_reply(
-                  _ptr->validate_reply_target_node(
-                    "install_snapshot", std::move(reply)));
-            })
-            .finally([this, seq] {
-                _ptr->update_suppress_heartbeats(
-                  _node_id, seq, heartbeats_suppressed::no);
-            });
+            _node_id, seq, heartbeats_suppressed::no);
       });
 }
 
 ss::future<> recovery_stm::close_snapshot_reader() {
-    return _snapshot_reader->close().then([this] {
+    auto f = _snapshot_reader ? _snapshot_reader->close() : ss::now();
+    return f.then([this] {
         _snapshot_reader.reset();
         _snapshot_size = 0;
         _sent_snapshot_bytes = 0;
@@ -324,7 +370,15 @@ ss::future<> recovery_stm::handle_install_snapshot_reply(
     // snapshot delivery failed
     if (reply.has_error() || !reply.value().success) {
         // if snapshot delivery failed, stop recovery to update follower state
-        // and retry
+        // and retry. The next recovery resumes the transfer from the last
+        // chunk stored by the follower, if it still has it the follower
+        // reports its size in a failed reply.
+        if (auto meta = get_follower_meta(); meta) {
+            (*meta)->snapshot_resume_index = _snapshot_index;
+            (*meta)->snapshot_resume_bytes = reply.has_error()
+                                               ? _sent_snapshot_bytes
+                                               : reply.value().bytes_stored;
+        }
         _stop_requested = true;
         return close_snapshot_reader();
     }
@@ -347,26 +401,65 @@ ss::future<> recovery_stm::handle_install_snapshot_reply(
     }
 
     // snapshot received by the follower, continue with recovery
-    (*meta)->match_index = _ptr->_last_snapshot_index;
-    (*meta)->next_index = model::next_offset(_ptr->_last_snapshot_index);
-    (*meta)->last_sent_offset = _ptr->_last_snapshot_index;
+    (*meta)->snapshot_resume_bytes = 0;
+    (*meta)->match_index = _snapshot_index;
+    (*meta)->next_index = model::next_offset(_snapshot_index);
+    (*meta)->last_sent_offset = _snapshot_index;
     return close_snapshot_reader();
 }
 
+ss::future<bool>
+recovery_stm::install_archived_snapshot(model::offset archived) {
+    auto snapshot = co_await _ptr->make_archived_snapshot(archived);
+    if (!snapshot) {
+        co_return false;
+    }
+    vlog(
+      _ctxlog.info,
+      "Skipping archived log prefix, installing snapshot at offset {}",
+      archived);
+    // the snapshot carries no data and is delivered in a single chunk
+    _snapshot_index = archived;
+    _snapshot_size = snapshot->size_bytes();
+    _sent_snapshot_bytes = 0;
+    co_await send_install_snapshot_chunk(std::move(*snapshot));
+    co_return true;
+}
+
 ss::future<> recovery_stm::install_snapshot() {
     // open reader if not yet available
-    auto f = _snapshot_reader != nullptr ? ss::now() : open_snapshot_reader();
-
-    return f.then([this]() mutable {
-        // we are outside of raft operation lock if snapshot isn't yet ready we
-        // have to wait for it till next recovery loop
+    if (!_snapshot_reader) {
+        co_await open_snapshot_reader();
+        // we are outside of raft operation lock if snapshot isn't yet ready
+        // we have to wait for it till next recovery loop
         if (!_snapshot_reader) {
             _stop_requested = true;
-            return ss::now();
+            co_return;
         }
+        co_await maybe_resume_snapshot_transfer();
+    }
 
-        return send_install_snapshot_request();
-    });
+    co_await send_install_snapshot_request();
+}
+
+ss::future<> recovery_stm::maybe_resume_snapshot_transfer() {
+    auto meta = get_follower_meta();
+    if (
+      !meta || (*meta)->snapshot_resume_index != _snapshot_index
+      || (*meta)->snapshot_resume_bytes == 0
+      || (*meta)->snapshot_resume_bytes >= _snapshot_size) {
+        co_return;
+    }
+    auto resume_at = (*meta)->snapshot_resume_bytes;
+    vlog(
+      _ctxlog.info,
+      "Resuming transfer of snapshot at {} to {} from byte {} of {}",
+      _snapshot_index,
+      _node_id,
+      resume_at,
+      _snapshot_size);
+    co_await _snapshot_reader->input().skip(resume_at);
+    _sent_snapshot_bytes = resume_at;
 }
 
 ss::future<> recovery_stm::replicate(
@@ -422,56 +515,124 @@ ss::future<> recovery_stm::replicate(
     auto lstats = _ptr->_log.offsets();
     std::vector<ssx::semaphore_units> units;
     units.push_back(std::move(mem_units));
-    return dispatch_append_entries(std::move(r), std::move(units))
-      .finally([this, seq] {
-          _ptr->update_suppress_heartbeats(
-            _node_id, seq, heartbeats_suppressed::no);
-      })
-      .then([this, seq, dirty_offset = lstats.dirty_offset](auto r) {
-          if (!r) {
-              vlog(
-                _ctxlog.warn,
-                "recovery append entries error: {}",
-                r.error().message());
-              _stop_requested = true;
-              _ptr->get_probe().recovery_request_error();
-          }
-          _ptr->process_append_entries_reply(
-            _node_id.id(), r.value(), seq, dirty_offset);
-          // If follower stats aren't present we have to stop recovery as
-          // follower was removed from configuration
-          if (!_ptr->_fstats.contains(_node_id)) {
-              _stop_requested = true;
-              return;
-          }
-          // If request was reordered we have to stop recovery as follower state
-          // is not known
-          if (seq < _ptr->_fstats.get(_node_id).last_received_seq) {
-              _stop_requested = true;
-              return;
-          }
-          // move the follower next index backward if recovery were not
-          // successful
-          //
-          // Raft paper:
-          // If AppendEntries fails because of log inconsistency: decrement
-          // nextIndex and retry(§5.3)
-
-          if (r.value().result == append_entries_reply::status::failure) {
-              auto meta = get_follower_meta();
-              if (!meta) {
-                  _stop_requested = true;
-                  return;
-              }
-              meta.value()->next_index = std::max(
-                model::offset(0), model::prev_offset(_base_batch_offset));
-              meta.value()->last_sent_offset = model::offset{};
-              vlog(
-                _ctxlog.trace,
-                "Move next index {} backward",
-                meta.value()->next_index);
-          }
+
+    // the reply is handled in the background, the next range is read while
+    // the request is in flight
+    ++_inflight;
+    ssx::spawn_with_gate(
+      _inflight_gate,
+      [this,
+       r = std::move(r),
+       units = std::move(units),
+       seq,
+       dirty_offset = lstats.dirty_offset,
+       base_offset = _base_batch_offset,
+       sent_at = clock_type::now()]() mutable {
+          return dispatch_append_entries(std::move(r), std::move(units))
+            .finally([this, seq] {
+                _ptr->update_suppress_heartbeats(
+                  _node_id, seq, heartbeats_suppressed::no);
+            })
+            .then([this, seq, dirty_offset, base_offset, sent_at](
+                    result<append_entries_reply> r) {
+                update_window(
+                  r
+                    && r.value().result
+                         == append_entries_reply::status::success,
+                  clock_type::now() - sent_at);
+                handle_append_entries_reply(
+                  std::move(r), seq, dirty_offset, base_offset);
+            })
+            .handle_exception([this](const std::exception_ptr& e) {
+                vlog(_ctxlog.info, "recovery append entries failed: {}", e);
+                _stop_requested = true;
+                _pipeline_failed = true;
+            })
+            .finally([this] {
+                --_inflight;
+                _inflight_cv.broadcast();
+            });
       });
+    return ss::now();
+}
+
+void recovery_stm::handle_append_entries_reply(
+  result<append_entries_reply> r,
+  follower_req_seq seq,
+  model::offset dirty_offset,
+  model::offset base_offset) {
+    if (!r) {
+        vlog(
+          _ctxlog.warn,
+          "recovery append entries error: {}",
+          r.error().message());
+        _stop_requested = true;
+        _pipeline_failed = true;
+        _ptr->get_probe().recovery_request_error();
+        return;
+    }
+    _ptr->process_append_entries_reply(
+      _node_id.id(), r.value(), seq, dirty_offset);
+    // If follower stats aren't present we have to stop recovery as
+    // follower was removed from configuration
+    if (!_ptr->_fstats.contains(_node_id)) {
+        _stop_requested = true;
+        return;
+    }
+    // If request was reordered we have to stop recovery as follower state
+    // is not known
+    if (seq < _ptr->_fstats.get(_node_id).last_received_seq) {
+        _stop_requested = true;
+        return;
+    }
+    // move the follower next index backward if recovery were not
+    // successful
+    //
+    // Raft paper:
+    // If AppendEntries fails because of log inconsistency: decrement
+    // nextIndex and retry(§5.3)
+
+    if (r.value().result == append_entries_reply::status::failure) {
+        // the requests sent after a failed one fail as well, only the first
+        // failure moves the next index
+        if (_pipeline_failed) {
+            return;
+        }
+        _pipeline_failed = true;
+        auto meta = get_follower_meta();
+        if (!meta) {
+            _stop_requested = true;
+            return;
+        }
+        meta.value()->next_index = std::max(
+          model::offset(0), model::prev_offset(base_offset));
+        meta.value()->last_sent_offset = model::offset{};
+        vlog(
+          _ctxlog.trace,
+          "Move next index {} backward",
+          meta.value()->next_index);
+    }
+}
+
+void recovery_stm::update_window(bool success, clock_type::duration rtt) {
+    if (!success) {
+        _window = std::max<size_t>(1, _window / 2);
+        return;
+    }
+    if (!_min_rtt || rtt < *_min_rtt) {
+        _min_rtt = rtt;
+    }
+    if (rtt <= 2 * *_min_rtt) {
+        _window = std::min(_window + 1, _max_window);
+    } else {
+        _window = std::max<size_t>(1, _window - 1);
+    }
+}
+
+ss::future<> recovery_stm::wait_for_inflight() {
+    return _inflight_cv.wait([this] {
+        return _inflight == 0 || (!_pipeline_failed && _inflight < _window);
+    });
 }
 
 clock_type::time_point recovery_stm::append_entries_timeout() {
@@ -483,6 +644,8 @@ ss::future<result<append_entries_reply>> recovery_stm::dispatch_append_entries(
     _ptr->_probe.recovery_append_request();
 
     rpc::client_opts opts(append_entries_timeout());
+    // keep large recovery batches off the connection used for replication
+    opts.lane = rpc::connection_lane::bulk;
     opts.resource_units = ss::make_foreign(
       ss::make_lw_shared<std::vector<ssx::semaphore_units>>(std::move(units)));
 
@@ -525,11 +688,13 @@ ss::future<> recovery_stm::apply() {
     return ss::with_gate(
              _ptr->_bg,
              [this] {
-                 return recover().then([this] {
-                     return ss::do_until(
-                       [this] { return is_recovery_finished(); },
-                       [this] { return recover(); });
-                 });
+                 return recover()
+                   .then([this] {
+                       return ss::do_until(
+                         [this] { return is_recovery_finished(); },
+                         [this] { return recover(); });
+                   })
+                   .finally([this] { return _inflight_gate.close(); });
              })
       .finally([this] {
           vlog(_ctxlog.trace, "Finished recovery");
@@ -18,6 +18,9 @@
 #include "storage/snapshot.h"
 #include "utils/prefix_logger.h"
 
+#include <seastar/core/condition-variable.hh>
+#include <seastar/core/gate.hh>
+
 #include <vector>
 
 namespace raft {
@@ -39,11 +42,21 @@ private:
       ssx::semaphore_units);
     ss::future<result<append_entries_reply>> dispatch_append_entries(
       append_entries_request&&, std::vector<ssx::semaphore_units>);
+    void handle_append_entries_reply(
+      result<append_entries_reply>,
+      follower_req_seq,
+      model::offset dirty_offset,
+      model::offset base_offset);
+    void update_window(bool success, clock_type::duration rtt);
+    ss::future<> wait_for_inflight();
     std::optional<follower_index_metadata*> get_follower_meta();
     clock_type::time_point append_entries_timeout();
 
     ss::future<> install_snapshot();
+    ss::future<> maybe_resume_snapshot_transfer();
     ss::future<> send_install_snapshot_request();
+    ss::future<> send_install_snapshot_chunk(iobuf);
+    ss::future<bool> install_archived_snapshot(model::offset);
     ss::future<> handle_install_snapshot_reply(result<install_snapshot_reply>);
     ss::future<> open_snapshot_reader();
     ss::future<> close_snapshot_reader();
@@ -61,11 +74,30 @@ private:
     prefix_logger _ctxlog;
     // tracking follower snapshot delivery
     std::unique_ptr<storage::snapshot_reader> _snapshot_reader;
+    // last offset included in the snapshot being delivered
+    model::offset _snapshot_index;
     size_t _sent_snapshot_bytes = 0;
     size_t _snapshot_size = 0;
     // needed to early exit. (node down)
     bool _stop_requested = false;
     recovery_memory_quota& _memory_quota;
+
+    /*
+     * append entries requests are pipelined: up to `_window` requests are in
+     * flight while the next range is read. the window grows by one request
+     * per reply while the round trip time stays close to the smallest one
+     * observed and shrinks when it grows (the follower or the network is
+     * queueing) or a request fails. after a failed request no new requests
+     * are sent until all replies are received, as the follower next index
+     * is not known.
+     */
+    const size_t _max_window;
+    size_t _window = 1;
+    size_t _inflight = 0;
+    bool _pipeline_failed = false;
+    std::optional<clock_type::duration> _min_rtt;
+    ss::condition_variable _inflight_cv;
+    ss::gate _inflight_gate;
 };
 
 } // namespace raft
@@ -9,6 +9,7 @@
 
 #include "raft/replicate_batcher.h"
 
+#include "config/configuration.h"
 #include "model/fundamental.h"
 #include "model/record.h"
 #include "model/record_batch_reader.h"
@@ -33,21 +34,70 @@
 
 namespace raft {
 using namespace std::chrono_literals; // NOLINT
+
+void replicate_cut_policy::append_completed(
+  std::chrono::microseconds latency, size_t arrived) {
+    auto ewma = [](double avg, double sample) {
+        return avg == 0 ? sample : avg + ewma_alpha * (sample - avg);
+    };
+    _append_latency_us = ewma(
+      _append_latency_us, static_cast<double>(latency.count()));
+    _arrived_bytes = ewma(_arrived_bytes, static_cast<double>(arrived));
+}
+
+size_t replicate_cut_policy::target_bytes() const {
+    return std::clamp<size_t>(
+      static_cast<size_t>(_arrived_bytes), 1, _max_batch_bytes);
+}
+
+std::chrono::microseconds replicate_cut_policy::linger(
+  model::replicate_batcher_policy policy,
+  std::chrono::microseconds max_linger,
+  size_t pending) const {
+    if (
+      policy == model::replicate_batcher_policy::fixed
+      || _append_latency_us == 0) {
+        return 0us;
+    }
+    const auto target = target_bytes();
+    if (pending >= target) {
+        return 0us;
+    }
+    const double fraction
+      = policy == model::replicate_batcher_policy::latency_first ? 0.25 : 1.0;
+    const double budget = std::min(
+      _append_latency_us * fraction, static_cast<double>(max_linger.count()));
+    // time it takes to fill up the batch at the observed arrival rate, by
+    // definition the target size arrives within one append latency
+    const double fill_time = static_cast<double>(target - pending)
+                             / static_cast<double>(target)
+                             * _append_latency_us;
+    if (fill_time > budget) {
+        return 0us;
+    }
+    return std::chrono::microseconds(static_cast<int64_t>(budget));
+}
+
 replicate_batcher::replicate_batcher(consensus* ptr, size_t cache_size)
   : _ptr(ptr)
   , _max_batch_size_sem(cache_size, "raft/repl-batch")
-  , _max_batch_size(cache_size) {}
+  , _max_batch_size(cache_size)
+  , _policy(config::shard_local_cfg().raft_replicate_batcher_policy.bind())
+  , _max_linger(
+      config::shard_local_cfg().raft_replicate_batcher_max_linger_ms.bind())
+  , _cut_policy(cache_size) {}
 
 replicate_stages replicate_batcher::replicate(
   std::optional<model::term_id> expected_term,
   model::record_batch_reader&& r,
-  consistency_level consistency_lvl) {
+  consistency_level consistency_lvl,
+  trace_id trace) {
     ss::promise<> enqueued;
     auto enqueued_f = enqueued.get_future();
     try {
         gate_guard guard(_bg);
         auto f
-          = do_cache(expected_term, std::move(r), consistency_lvl)
+          = do_cache(expected_term, std::move(r), consistency_lvl, trace)
               .then_wrapped(
                 [this,
                  enqueued = std::move(enqueued),
@@ -89,6 +139,7 @@ replicate_stages replicate_batcher::replicate(
 }
 
 ss::future<> replicate_batcher::stop() {
+    _pending_cv.broken();
     return _bg.close().then([this] {
         // we keep a lock here to make sure that all inflight requests have
         // finished already
@@ -104,9 +155,10 @@ ss::future<> replicate_batcher::stop() {
 ss::future<replicate_batcher::item_ptr> replicate_batcher::do_cache(
   std::optional<model::term_id> expected_term,
   model::record_batch_reader&& r,
-  consistency_level consistency_lvl) {
+  consistency_level consistency_lvl,
+  trace_id trace) {
     return model::consume_reader_to_memory(std::move(r), model::no_timeout)
-      .then([this, expected_term, consistency_lvl](
+      .then([this, expected_term, consistency_lvl, trace](
               ss::circular_buffer<model::record_batch> batches) {
           ss::circular_buffer<model::record_batch> data;
           size_t bytes = std::accumulate(
@@ -117,7 +169,11 @@ ss::future<replicate_batcher::item_ptr> replicate_batcher::do_cache(
                 return sum + b.size_bytes();
             });
           return do_cache_with_backpressure(
-            expected_term, std::move(batches), bytes, consistency_lvl);
+            expected_term,
+            std::move(batches),
+            bytes,
+            consistency_lvl,
+            trace);
       });
 }
 
@@ -126,7 +182,8 @@ replicate_batcher::do_cache_with_backpressure(
   std::optional<model::term_id> expected_term,
   ss::circular_buffer<model::record_batch> batches,
   size_t bytes,
-  consistency_level consistency_lvl) {
+  consistency_level consistency_lvl,
+  trace_id trace) {
     /**
      * Produce a message larger than the internal raft batch accumulator
      * (default 1Mb) the semaphore can't be acquired. Closing
@@ -142,8 +199,12 @@ replicate_batcher::do_cache_with_backpressure(
 
     return ss::get_units(_max_batch_size_sem, std::min(bytes, _max_batch_size))
       .then(
-        [this, expected_term, batches = std::move(batches), consistency_lvl](
-          ssx::semaphore_units u) mutable {
+        [this,
+         expected_term,
+         batches = std::move(batches),
+         bytes,
+         consistency_lvl,
+         trace](ssx::semaphore_units u) mutable {
             size_t record_count = 0;
             auto i = ss::make_lw_shared<item>();
             for (auto& b : batches) {
@@ -158,17 +219,70 @@ replicate_batcher::do_cache_with_backpressure(
             i->record_count = record_count;
             i->units = std::move(u);
             i->consistency_lvl = consistency_lvl;
+            i->trace = trace;
+            request_tracer::local().record(
+              trace, trace_stage::batcher_enqueued);
 
             _item_cache.emplace_back(i);
+            _pending_bytes += bytes;
+            _cached_bytes += bytes;
+            _tracked.update(_pending_bytes);
+            if (_pending_bytes >= _cut_policy.target_bytes()) {
+                _pending_cv.signal();
+            }
             return i;
         });
 }
 
+ss::future<> replicate_batcher::maybe_linger() {
+    auto linger = _cut_policy.linger(
+      _policy(),
+      std::chrono::duration_cast<std::chrono::microseconds>(_max_linger()),
+      _pending_bytes);
+    if (linger == 0us || _item_cache.empty()) {
+        co_return;
+    }
+    _ptr->_probe.replicate_batcher_lingered();
+    try {
+        co_await _pending_cv.wait(linger, [this] {
+            return _pending_bytes >= _cut_policy.target_bytes();
+        });
+    } catch (const ss::condition_variable_timed_out&) {
+    } catch (const ss::broken_condition_variable&) {
+    }
+}
+
+/// The trace carried by the append entries request, if any of its items is
+/// traced the first one is.
+static trace_id
+first_trace(const std::vector<replicate_batcher::item_ptr>& notifications) {
+    for (const auto& n : notifications) {
+        if (n->trace != trace_id{}) {
+            return n->trace;
+        }
+    }
+    return trace_id{};
+}
+
+/// Records the stage for all the traced items of the append
+static void record_stage(
+  const std::vector<replicate_batcher::item_ptr>& notifications,
+  trace_stage stage) {
+    for (const auto& n : notifications) {
+        request_tracer::local().record(n->trace, stage);
+    }
+}
+
 ss::future<> replicate_batcher::flush(
   ssx::semaphore_units batcher_units, bool const transfer_flush) {
     auto holder = _bg.hold();
 
+    if (!transfer_flush) {
+        co_await maybe_linger();
+    }
     auto item_cache = std::exchange(_item_cache, {});
+    _pending_bytes = 0;
+    _tracked.update(0);
     if (item_cache.empty()) {
         co_return;
     }
@@ -234,6 +348,7 @@ ss::future<> replicate_batcher::flush(
           meta,
           model::make_memory_record_batch_reader(std::move(data)),
           needs_flush);
+        req.trace = first_trace(notifications);
 
         std::vector<ssx::semaphore_units> units;
         units.reserve(2);
@@ -297,7 +412,16 @@ ss::future<> replicate_batcher::do_flush(
       _ptr, std::move(req), std::move(seqs));
     try {
         auto holder = _bg.hold();
+        const auto append_start = std::chrono::steady_clock::now();
+        const auto cached_before = _cached_bytes;
         auto leader_result = co_await stm->apply(std::move(u));
+        _cut_policy.append_completed(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - append_start),
+          _cached_bytes - cached_before);
+        if (leader_result) {
+            record_stage(notifications, trace_stage::leader_appended);
+        }
 
         /**
          * First phase, if leader result has error just propagate error
@@ -321,6 +445,10 @@ ss::future<> replicate_batcher::do_flush(
               .then([holder = std::move(holder),
                      notifications = std::move(notifications)](
                       result<replicate_result> quorum_result) mutable {
+                  if (quorum_result) {
+                      record_stage(
+                        notifications, trace_stage::quorum_replicated);
+                  }
                   propagate_result(
                     quorum_result, notifications, [](const item_ptr& item) {
                         return item->consistency_lvl
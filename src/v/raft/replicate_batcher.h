@@ -11,19 +11,67 @@
 
 #pragma once
 
+#include "config/property.h"
+#include "model/metadata.h"
 #include "model/record_batch_reader.h"
 #include "outcome.h"
 #include "raft/types.h"
 #include "ssx/semaphore.h"
 #include "units.h"
+#include "utils/memory_accounting.h"
 #include "utils/mutex.h"
 
+#include <seastar/core/condition-variable.hh>
 #include <seastar/core/gate.hh>
 
 #include <absl/container/flat_hash_map.h>
+
+#include <chrono>
+
 namespace raft {
 class consensus;
 
+/**
+ * Decides how long the replicate batcher may hold cached requests before
+ * cutting them into a single append.
+ *
+ * The policy tracks the leader append latency and the number of bytes cached
+ * while an append is in progress, i.e. the size a batch naturally reaches at
+ * the current load. When the pending requests are smaller than that and the
+ * observed arrival rate would fill the batch within the linger budget of the
+ * policy (a quarter of the append latency for latency_first, all of it for
+ * throughput_first, never more than the configured maximum) the batcher waits
+ * for more data. Under light load the target size collapses and requests are
+ * cut immediately, under a burst the batches grow instead of issuing one
+ * append per request.
+ */
+class replicate_cut_policy {
+public:
+    explicit replicate_cut_policy(size_t max_batch_bytes)
+      : _max_batch_bytes(max_batch_bytes) {}
+
+    /// accounts for a leader append that took `latency` while `arrived` bytes
+    /// were cached by the batcher
+    void append_completed(std::chrono::microseconds latency, size_t arrived);
+
+    /// how long a cut of `pending` bytes may wait for more data, zero means
+    /// that the requests should be cut immediately
+    std::chrono::microseconds linger(
+      model::replicate_batcher_policy,
+      std::chrono::microseconds max_linger,
+      size_t pending) const;
+
+    /// size at which a lingering cut is released early
+    size_t target_bytes() const;
+
+private:
+    static constexpr double ewma_alpha = 0.2;
+
+    size_t _max_batch_bytes;
+    double _append_latency_us{0};
+    double _arrived_bytes{0};
+};
+
 class replicate_batcher {
 public:
     struct item {
@@ -34,6 +82,8 @@ public:
         // consistency level is stored to distinguish when an item promise
         // should be signaled with replication result
         consistency_level consistency_lvl;
+        // set if the request is sampled for tracing
+        trace_id trace;
         /**
          * Item keeps semaphore units until replicate batcher is done with
          * processing the request.
@@ -52,13 +102,16 @@ public:
     replicate_stages replicate(
       std::optional<model::term_id>,
       model::record_batch_reader&&,
-      consistency_level);
+      consistency_level,
+      trace_id = trace_id{});
 
     ss::future<> flush(ssx::semaphore_units u, bool const transfer_flush);
 
     ss::future<> stop();
 
 private:
+    ss::future<> maybe_linger();
+
     ss::future<> do_flush(
       std::vector<item_ptr>,
       append_entries_request,
@@ -68,12 +121,14 @@ private:
     ss::future<item_ptr> do_cache(
       std::optional<model::term_id>,
       model::record_batch_reader&&,
-      consistency_level);
+      consistency_level,
+      trace_id);
     ss::future<replicate_batcher::item_ptr> do_cache_with_backpressure(
       std::optional<model::term_id>,
       ss::circular_buffer<model::record_batch>,
       size_t,
-      consistency_level);
+      consistency_level,
+      trace_id);
 
     consensus* _ptr;
     ssx::semaphore _max_batch_size_sem;
@@ -81,6 +136,15 @@ private:
     std::vector<item_ptr> _item_cache;
     mutex _lock;
     ss::gate _bg;
+
+    config::binding<model::replicate_batcher_policy> _policy;
+    config::binding<std::chrono::milliseconds> _max_linger;
+    replicate_cut_policy _cut_policy;
+    // bytes cached since the last cut and since the batcher was created
+    size_t _pending_bytes{0};
+    uint64_t _cached_bytes{0};
+    tracked_memory _tracked{memory_subsystem::raft_inflight};
+    ss::condition_variable _pending_cv;
 };
 
 } // namespace raft
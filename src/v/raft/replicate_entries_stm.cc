@@ -50,12 +50,14 @@ ss::future<append_entries_request> replicate_entries_stm::share_request() {
 ss::future<result<append_entries_reply>> replicate_entries_stm::flush_log() {
     using ret_t = result<append_entries_reply>;
     auto flush_f = ss::now();
-    if (_req->flush) {
+    // with write caching the log is flushed in the background
+    const bool deferred = _req->flush && _ptr->write_caching_enabled();
+    if (_req->flush && !deferred) {
         flush_f = _ptr->flush_log();
     }
 
     auto f = flush_f
-               .then([this]() {
+               .then([this, deferred]() {
                    /**
                     * Replicate STM _dirty_offset is set to the dirty offset of
                     * a log after successfull self append. After flush we are
@@ -73,7 +75,8 @@ ss::future<result<append_entries_reply>> replicate_entries_stm::flush_log() {
                    reply.term = _ptr->term();
                    // we just flushed offsets are the same
                    reply.last_dirty_log_index = new_committed_offset;
-                   reply.last_flushed_log_index = new_committed_offset;
+                   reply.last_flushed_log_index
+                     = deferred ? _ptr->_flushed_offset : new_committed_offset;
                    reply.result = append_entries_reply::status::success;
                    return ret_t(reply);
                })
@@ -118,7 +121,14 @@ replicate_entries_stm::send_append_entries_request(
 
           return _ptr->_client_protocol
             .append_entries(n.id(), std::move(req), std::move(opts))
-            .then([this](result<append_entries_reply> reply) {
+            .then([this, n, sent = clock_type::now()](
+                    result<append_entries_reply> reply) {
+                if (reply) {
+                    _ptr->_fstats.append_entries_replied(
+                      n, clock_type::now() - sent);
+                } else {
+                    _ptr->_fstats.append_entries_failed(n);
+                }
                 return _ptr->validate_reply_target_node(
                   "append_entries_replicate", std::move(reply));
             })
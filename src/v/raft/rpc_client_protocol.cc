@@ -9,18 +9,114 @@
 
 #include "raft/rpc_client_protocol.h"
 
+#include "config/configuration.h"
 #include "outcome_future_utils.h"
 #include "raft/raftgen_service.h"
 #include "rpc/connection_cache.h"
 #include "rpc/exceptions.h"
 #include "rpc/transport.h"
 #include "rpc/types.h"
+#include "ssx/future-util.h"
 
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/later.hh>
 
 namespace raft {
 
 ss::future<result<vote_reply>> rpc_client_protocol::vote(
+  model::node_id n, vote_request&& r, rpc::client_opts opts) {
+    const auto max_requests
+      = config::shard_local_cfg().raft_multi_vote_max_requests();
+    if (
+      _features == nullptr || max_requests == 0
+      || !_features->is_feature_active(raft_feature::vote_batching)) {
+        return send_vote(n, std::move(r), std::move(opts));
+    }
+
+    auto& pending = _pending_votes[n];
+    pending.push_back(pending_vote{
+      .request = std::move(r), .opts = std::move(opts), .reply = {}});
+    auto f = pending.back().reply.get_future();
+    if (pending.size() >= max_requests) {
+        dispatch_pending_votes(n);
+    } else if (pending.size() == 1) {
+        // the groups led by a failed node time out together, collect their
+        // votes before the next scheduling point
+        ssx::background = ss::later().then([self = shared_from_this(), n] {
+            self->dispatch_pending_votes(n);
+        });
+    }
+    return f;
+}
+
+void rpc_client_protocol::dispatch_pending_votes(model::node_id n) {
+    auto it = _pending_votes.find(n);
+    if (it == _pending_votes.end()) {
+        return;
+    }
+    auto pending = std::move(it->second);
+    _pending_votes.erase(it);
+
+    if (pending.size() == 1) {
+        auto& p = pending.front();
+        send_vote(n, std::move(p.request), std::move(p.opts))
+          .forward_to(std::move(p.reply));
+        return;
+    }
+    ssx::background = send_multi_vote(n, std::move(pending))
+                        .finally([self = shared_from_this()] {});
+}
+
+ss::future<> rpc_client_protocol::send_multi_vote(
+  model::node_id n, pending_votes_t pending) {
+    auto timeout = pending.front().opts.timeout;
+    std::vector<vote_request> requests;
+    requests.reserve(pending.size());
+    for (auto& p : pending) {
+        timeout = std::max(timeout, p.opts.timeout);
+        requests.push_back(std::move(p.request));
+    }
+
+    try {
+        auto r = co_await _connection_cache.local()
+                   .with_node_client<raftgen_client_protocol>(
+                     _self,
+                     ss::this_shard_id(),
+                     n,
+                     timeout,
+                     [req = multi_vote_request(std::move(requests)),
+                      timeout](raftgen_client_protocol client) mutable {
+                         return client
+                           .multi_vote(
+                             std::move(req), rpc::client_opts(timeout))
+                           .then(&rpc::get_ctx_data<multi_vote_reply>);
+                     },
+                     rpc::connection_lane::control);
+        if (r.has_error()) {
+            for (auto& p : pending) {
+                p.reply.set_value(result<vote_reply>(r.error()));
+            }
+            co_return;
+        }
+        auto& replies = r.value().replies;
+        for (size_t i = 0; i < pending.size(); ++i) {
+            if (i < replies.size()) {
+                pending[i].reply.set_value(
+                  result<vote_reply>(std::move(replies[i])));
+            } else {
+                pending[i].reply.set_value(
+                  result<vote_reply>(errc::vote_dispatch_error));
+            }
+        }
+    } catch (...) {
+        auto e = std::current_exception();
+        for (auto& p : pending) {
+            p.reply.set_exception(e);
+        }
+    }
+}
+
+ss::future<result<vote_reply>> rpc_client_protocol::send_vote(
   model::node_id n, vote_request&& r, rpc::client_opts opts) {
     return _connection_cache.local().with_node_client<raftgen_client_protocol>(
       _self,
@@ -31,11 +127,108 @@ ss::future<result<vote_reply>> rpc_client_protocol::vote(
        opts = std::move(opts)](raftgen_client_protocol client) mutable {
           return client.vote(std::move(r), std::move(opts))
             .then(&rpc::get_ctx_data<vote_reply>);
-      });
+      },
+      rpc::connection_lane::control);
 }
 
 ss::future<result<append_entries_reply>> rpc_client_protocol::append_entries(
   model::node_id n, append_entries_request&& r, rpc::client_opts opts) {
+    const auto max_requests
+      = config::shard_local_cfg().raft_multi_append_max_requests();
+    if (
+      _features == nullptr || max_requests == 0
+      || opts.lane != rpc::connection_lane::data
+      || !_features->is_feature_active(
+        raft_feature::append_entries_batching)) {
+        return send_append_entries(n, std::move(r), std::move(opts));
+    }
+
+    auto& pending = _pending_appends[n];
+    pending.push_back(pending_append{
+      .request = std::move(r), .opts = std::move(opts), .reply = {}});
+    auto f = pending.back().reply.get_future();
+    if (pending.size() >= max_requests) {
+        dispatch_pending_appends(n);
+    } else if (pending.size() == 1) {
+        // collect whatever other groups send to this node before the next
+        // scheduling point
+        ssx::background = ss::later().then([self = shared_from_this(), n] {
+            self->dispatch_pending_appends(n);
+        });
+    }
+    return f;
+}
+
+void rpc_client_protocol::dispatch_pending_appends(model::node_id n) {
+    auto it = _pending_appends.find(n);
+    if (it == _pending_appends.end()) {
+        return;
+    }
+    auto pending = std::move(it->second);
+    _pending_appends.erase(it);
+
+    if (pending.size() == 1) {
+        auto& p = pending.front();
+        send_append_entries(n, std::move(p.request), std::move(p.opts))
+          .forward_to(std::move(p.reply));
+        return;
+    }
+    ssx::background = send_multi_append(n, std::move(pending))
+                        .finally([self = shared_from_this()] {});
+}
+
+ss::future<> rpc_client_protocol::send_multi_append(
+  model::node_id n, pending_appends_t pending) {
+    auto timeout = pending.front().opts.timeout;
+    std::vector<append_entries_request> requests;
+    requests.reserve(pending.size());
+    for (auto& p : pending) {
+        timeout = std::max(timeout, p.opts.timeout);
+        requests.push_back(std::move(p.request));
+    }
+
+    try {
+        auto r = co_await _connection_cache.local()
+                   .with_node_client<raftgen_client_protocol>(
+                     _self,
+                     ss::this_shard_id(),
+                     n,
+                     timeout,
+                     [req = multi_append_request(std::move(requests)),
+                      timeout](raftgen_client_protocol client) mutable {
+                         return client
+                           .multi_append(
+                             std::move(req), rpc::client_opts(timeout))
+                           .then(&rpc::get_ctx_data<multi_append_reply>);
+                     });
+        if (r.has_error()) {
+            for (auto& p : pending) {
+                p.reply.set_value(result<append_entries_reply>(r.error()));
+            }
+            co_return;
+        }
+        auto& replies = r.value().replies;
+        for (size_t i = 0; i < pending.size(); ++i) {
+            if (i < replies.size()) {
+                pending[i].reply.set_value(
+                  result<append_entries_reply>(std::move(replies[i])));
+            } else {
+                pending[i].reply.set_value(result<append_entries_reply>(
+                  errc::append_entries_dispatch_error));
+            }
+        }
+    } catch (...) {
+        auto e = std::current_exception();
+        for (auto& p : pending) {
+            p.reply.set_exception(e);
+        }
+    }
+}
+
+ss::future<result<append_entries_reply>>
+rpc_client_protocol::send_append_entries(
+  model::node_id n, append_entries_request&& r, rpc::client_opts opts) {
+    const auto lane = opts.lane;
     return _connection_cache.local().with_node_client<raftgen_client_protocol>(
       _self,
       ss::this_shard_id(),
@@ -45,7 +238,8 @@ ss::future<result<append_entries_reply>> rpc_client_protocol::append_entries(
        opts = std::move(opts)](raftgen_client_protocol client) mutable {
           return client.append_entries(std::move(r), std::move(opts))
             .then(&rpc::get_ctx_data<append_entries_reply>);
-      });
+      },
+      lane);
 }
 
 ss::future<result<heartbeat_reply>> rpc_client_protocol::heartbeat(
@@ -59,7 +253,23 @@ ss::future<result<heartbeat_reply>> rpc_client_protocol::heartbeat(
        opts = std::move(opts)](raftgen_client_protocol client) mutable {
           return client.heartbeat(std::move(r), std::move(opts))
             .then(&rpc::get_ctx_data<heartbeat_reply>);
-      });
+      },
+      rpc::connection_lane::control);
+}
+
+ss::future<result<node_lease_reply>> rpc_client_protocol::node_lease(
+  model::node_id n, node_lease_request&& r, rpc::client_opts opts) {
+    return _connection_cache.local().with_node_client<raftgen_client_protocol>(
+      _self,
+      ss::this_shard_id(),
+      n,
+      opts.timeout,
+      [r = std::move(r),
+       opts = std::move(opts)](raftgen_client_protocol client) mutable {
+          return client.node_lease(std::move(r), std::move(opts))
+            .then(&rpc::get_ctx_data<node_lease_reply>);
+      },
+      rpc::connection_lane::control);
 }
 
 ss::future<result<install_snapshot_reply>>
@@ -74,10 +284,104 @@ rpc_client_protocol::install_snapshot(
        opts = std::move(opts)](raftgen_client_protocol client) mutable {
           return client.install_snapshot(std::move(r), std::move(opts))
             .then(&rpc::get_ctx_data<install_snapshot_reply>);
-      });
+      },
+      rpc::connection_lane::bulk);
 }
 
 ss::future<result<timeout_now_reply>> rpc_client_protocol::timeout_now(
+  model::node_id n, timeout_now_request&& r, rpc::client_opts opts) {
+    // bounded by the same limit as votes, both start elections on the peer
+    const auto max_requests
+      = config::shard_local_cfg().raft_multi_vote_max_requests();
+    if (
+      _features == nullptr || max_requests == 0
+      || !_features->is_feature_active(raft_feature::timeout_now_batching)) {
+        return send_timeout_now(n, std::move(r), std::move(opts));
+    }
+
+    auto& pending = _pending_timeout_nows[n];
+    pending.push_back(pending_timeout_now{
+      .request = std::move(r), .opts = std::move(opts), .reply = {}});
+    auto f = pending.back().reply.get_future();
+    if (pending.size() >= max_requests) {
+        dispatch_pending_timeout_nows(n);
+    } else if (pending.size() == 1) {
+        // bulk leadership transfers hand over many groups to the same node
+        ssx::background = ss::later().then([self = shared_from_this(), n] {
+            self->dispatch_pending_timeout_nows(n);
+        });
+    }
+    return f;
+}
+
+void rpc_client_protocol::dispatch_pending_timeout_nows(model::node_id n) {
+    auto it = _pending_timeout_nows.find(n);
+    if (it == _pending_timeout_nows.end()) {
+        return;
+    }
+    auto pending = std::move(it->second);
+    _pending_timeout_nows.erase(it);
+
+    if (pending.size() == 1) {
+        auto& p = pending.front();
+        send_timeout_now(n, std::move(p.request), std::move(p.opts))
+          .forward_to(std::move(p.reply));
+        return;
+    }
+    ssx::background = send_multi_timeout_now(n, std::move(pending))
+                        .finally([self = shared_from_this()] {});
+}
+
+ss::future<> rpc_client_protocol::send_multi_timeout_now(
+  model::node_id n, pending_timeout_nows_t pending) {
+    auto timeout = pending.front().opts.timeout;
+    std::vector<timeout_now_request> requests;
+    requests.reserve(pending.size());
+    for (auto& p : pending) {
+        timeout = std::max(timeout, p.opts.timeout);
+        requests.push_back(std::move(p.request));
+    }
+
+    try {
+        auto r = co_await _connection_cache.local()
+                   .with_node_client<raftgen_client_protocol>(
+                     _self,
+                     ss::this_shard_id(),
+                     n,
+                     timeout,
+                     [req = multi_timeout_now_request(std::move(requests)),
+                      timeout](raftgen_client_protocol client) mutable {
+                         return client
+                           .multi_timeout_now(
+                             std::move(req), rpc::client_opts(timeout))
+                           .then(&rpc::get_ctx_data<multi_timeout_now_reply>);
+                     },
+                     rpc::connection_lane::control);
+        if (r.has_error()) {
+            for (auto& p : pending) {
+                p.reply.set_value(result<timeout_now_reply>(r.error()));
+            }
+            co_return;
+        }
+        auto& replies = r.value().replies;
+        for (size_t i = 0; i < pending.size(); ++i) {
+            if (i < replies.size()) {
+                pending[i].reply.set_value(
+                  result<timeout_now_reply>(std::move(replies[i])));
+            } else {
+                pending[i].reply.set_value(
+                  result<timeout_now_reply>(errc::timeout));
+            }
+        }
+    } catch (...) {
+        auto e = std::current_exception();
+        for (auto& p : pending) {
+            p.reply.set_exception(e);
+        }
+    }
+}
+
+ss::future<result<timeout_now_reply>> rpc_client_protocol::send_timeout_now(
   model::node_id n, timeout_now_request&& r, rpc::client_opts opts) {
     return _connection_cache.local().with_node_client<raftgen_client_protocol>(
       _self,
@@ -88,7 +392,8 @@ ss::future<result<timeout_now_reply>> rpc_client_protocol::timeout_now(
        opts = std::move(opts)](raftgen_client_protocol client) mutable {
           return client.timeout_now(std::move(r), std::move(opts))
             .then(&rpc::get_ctx_data<timeout_now_reply>);
-      });
+      },
+      rpc::connection_lane::control);
 }
 
 ss::future<> rpc_client_protocol::reset_backoff(model::node_id n) {
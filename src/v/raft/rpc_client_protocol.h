@@ -15,21 +15,36 @@
 #include "outcome_future_utils.h"
 #include "raft/consensus_client_protocol.h"
 #include "raft/errc.h"
+#include "raft/raft_feature_table.h"
 #include "raft/raftgen_service.h"
 #include "rpc/fwd.h"
 #include "rpc/transport.h"
 
+#include <seastar/core/shared_ptr.hh>
+
+#include <absl/container/flat_hash_map.h>
+
 #include <system_error>
 
 namespace raft {
 
 /// Raft client protocol implementation underlied by RPC connections cache
-class rpc_client_protocol final : public consensus_client_protocol::impl {
+///
+/// Once every node supports it, append_entries requests issued to the same
+/// node by different groups within one scheduling pass are coalesced and sent
+/// in a single multi_append rpc. Vote and timeout_now requests are coalesced
+/// the same way into multi_vote and multi_timeout_now rpcs.
+class rpc_client_protocol final
+  : public consensus_client_protocol::impl
+  , public ss::enable_shared_from_this<rpc_client_protocol> {
 public:
-    explicit rpc_client_protocol(
-      model::node_id self, ss::sharded<rpc::connection_cache>& cache)
+    rpc_client_protocol(
+      model::node_id self,
+      ss::sharded<rpc::connection_cache>& cache,
+      const raft_feature_table* features = nullptr)
       : _self(self)
-      , _connection_cache(cache) {}
+      , _connection_cache(cache)
+      , _features(features) {}
 
     ss::future<result<vote_reply>>
     vote(model::node_id, vote_request&&, rpc::client_opts) final;
@@ -53,15 +68,63 @@ public:
 
     ss::future<> reset_backoff(model::node_id n);
 
+    ss::future<result<node_lease_reply>>
+    node_lease(model::node_id, node_lease_request&&, rpc::client_opts) final;
+
 private:
+    struct pending_append {
+        append_entries_request request;
+        // kept until the reply arrives, it may hold resource units
+        rpc::client_opts opts;
+        ss::promise<result<append_entries_reply>> reply;
+    };
+    using pending_appends_t = std::vector<pending_append>;
+
+    struct pending_vote {
+        vote_request request;
+        rpc::client_opts opts;
+        ss::promise<result<vote_reply>> reply;
+    };
+    using pending_votes_t = std::vector<pending_vote>;
+
+    struct pending_timeout_now {
+        timeout_now_request request;
+        rpc::client_opts opts;
+        ss::promise<result<timeout_now_reply>> reply;
+    };
+    using pending_timeout_nows_t = std::vector<pending_timeout_now>;
+
+    ss::future<result<append_entries_reply>> send_append_entries(
+      model::node_id, append_entries_request&&, rpc::client_opts);
+    void dispatch_pending_appends(model::node_id);
+    ss::future<> send_multi_append(model::node_id, pending_appends_t);
+
+    ss::future<result<vote_reply>>
+    send_vote(model::node_id, vote_request&&, rpc::client_opts);
+    void dispatch_pending_votes(model::node_id);
+    ss::future<> send_multi_vote(model::node_id, pending_votes_t);
+
+    ss::future<result<timeout_now_reply>>
+    send_timeout_now(model::node_id, timeout_now_request&&, rpc::client_opts);
+    void dispatch_pending_timeout_nows(model::node_id);
+    ss::future<> send_multi_timeout_now(model::node_id, pending_timeout_nows_t);
+
     model::node_id _self;
     ss::sharded<rpc::connection_cache>& _connection_cache;
+    // no coalescing without a feature table
+    const raft_feature_table* _features;
+    absl::flat_hash_map<model::node_id, pending_appends_t> _pending_appends;
+    absl::flat_hash_map<model::node_id, pending_votes_t> _pending_votes;
+    absl::flat_hash_map<model::node_id, pending_timeout_nows_t>
+      _pending_timeout_nows;
 };
 
 inline consensus_client_protocol make_rpc_client_protocol(
-  model::node_id self, ss::sharded<rpc::connection_cache>& clients) {
+  model::node_id self,
+  ss::sharded<rpc::connection_cache>& clients,
+  const raft_feature_table* features = nullptr) {
     return raft::make_consensus_client_protocol<raft::rpc_client_protocol>(
-      self, clients);
+      self, clients, features);
 }
 
 } // namespace raft
@@ -13,11 +13,13 @@
 
 #include "likely.h"
 #include "raft/consensus.h"
+#include "raft/node_lease_table.h"
 #include "raft/raftgen_service.h"
 #include "raft/types.h"
 #include "seastarx.h"
 #include "utils/copy_range.h"
 
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/sharded.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/timed_out_error.hh>
@@ -25,6 +27,8 @@
 
 #include <absl/container/flat_hash_map.h>
 
+#include <functional>
+
 namespace raft {
 // clang-format off
 template<typename ConsensusManager>
@@ -66,21 +70,8 @@ public:
     [[gnu::always_inline]] ss::future<heartbeat_reply>
     heartbeat(heartbeat_request&& r, rpc::streaming_context&) final {
         using ret_t = std::vector<append_entries_reply>;
-        std::vector<append_entries_request> reqs;
-        reqs.reserve(r.heartbeats.size());
-        for (auto& m : r.heartbeats) {
-            append_entries_request append_req(
-              m.node_id,
-              m.target_node_id,
-              m.meta,
-              model::make_memory_record_batch_reader(
-                ss::circular_buffer<model::record_batch>{}),
-              append_entries_request::flush_after_append::no);
-            reqs.push_back(std::move(append_req));
-        };
-
-        auto req_size = reqs.size();
-        auto groupped = group_hbeats_by_shard(std::move(reqs));
+        auto req_size = r.heartbeats.size();
+        auto groupped = group_hbeats_by_shard(std::move(r.heartbeats));
 
         std::vector<ss::future<std::vector<append_entries_reply>>> futures;
         futures.reserve(groupped.shard_requests.size());
@@ -95,9 +86,9 @@ public:
           std::begin(groupped.group_missing_requests),
           std::end(groupped.group_missing_requests),
           std::back_inserter(group_missing_replies),
-          [](append_entries_request& r) {
+          [](const heartbeat_metadata& hb) {
               return append_entries_reply{
-                .group = r.meta.group,
+                .group = hb.meta.group,
                 .result = append_entries_reply::status::group_unavailable};
           });
 
@@ -181,13 +172,63 @@ public:
           });
     }
 
+    [[gnu::always_inline]] ss::future<multi_append_reply>
+    multi_append(multi_append_request&& r, rpc::streaming_context&) final {
+        return _probe.multi_append().then([this, r = std::move(r)]() mutable {
+            return dispatch_multi_append(std::move(r.requests));
+        });
+    }
+
+    [[gnu::always_inline]] ss::future<node_lease_reply>
+    node_lease(node_lease_request&& r, rpc::streaming_context&) final {
+        return _probe.node_lease().then([this, r = std::move(r)]() mutable {
+            return dispatch_node_lease(std::move(r));
+        });
+    }
+
+    [[gnu::always_inline]] ss::future<multi_vote_reply>
+    multi_vote(multi_vote_request&& r, rpc::streaming_context&) final {
+        return _probe.multi_vote().then([this, r = std::move(r)]() mutable {
+            return dispatch_multi<vote_request, vote_reply>(
+                     std::move(r.requests),
+                     &service::make_failed_vote_reply,
+                     [](vote_request&& r, consensus_ptr c) {
+                         return c->vote(std::move(r));
+                     })
+              .then([](std::vector<vote_reply> replies) {
+                  return multi_vote_reply(std::move(replies));
+              });
+        });
+    }
+
+    [[gnu::always_inline]] ss::future<multi_timeout_now_reply>
+    multi_timeout_now(
+      multi_timeout_now_request&& r, rpc::streaming_context&) final {
+        return _probe.multi_timeout_now().then(
+          [this, r = std::move(r)]() mutable {
+              return dispatch_multi<timeout_now_request, timeout_now_reply>(
+                       std::move(r.requests),
+                       &service::make_failed_timeout_now_reply,
+                       [](timeout_now_request&& r, consensus_ptr c) {
+                           return c->timeout_now(std::move(r));
+                       })
+                .then([](std::vector<timeout_now_reply> replies) {
+                    return multi_timeout_now_reply(std::move(replies));
+                });
+          });
+    }
+
 private:
     using consensus_ptr = seastar::lw_shared_ptr<consensus>;
     using hbeats_t = std::vector<append_entries_request>;
     using hbeats_ptr = ss::foreign_ptr<std::unique_ptr<hbeats_t>>;
+    // heartbeats stay in their decoded form until they reach their shard,
+    // the append_entries requests are only built there
+    using hbeat_metas_t = std::vector<heartbeat_metadata>;
+    using hbeat_metas_ptr = ss::foreign_ptr<std::unique_ptr<hbeat_metas_t>>;
     struct shard_groupped_hbeat_requests {
-        absl::flat_hash_map<ss::shard_id, hbeats_ptr> shard_requests;
-        std::vector<append_entries_request> group_missing_requests;
+        absl::flat_hash_map<ss::shard_id, hbeat_metas_ptr> shard_requests;
+        std::vector<heartbeat_metadata> group_missing_requests;
     };
 
     static ss::future<vote_reply> make_failed_vote_reply() {
@@ -250,7 +291,7 @@ private:
     }
 
     ss::future<std::vector<append_entries_reply>>
-    dispatch_hbeats_to_core(ss::shard_id shard, hbeats_ptr requests) {
+    dispatch_hbeats_to_core(ss::shard_id shard, hbeat_metas_ptr requests) {
         return with_scheduling_group(
           get_scheduling_group(),
           [this, shard, r = std::move(requests)]() mutable {
@@ -264,7 +305,7 @@ private:
     }
 
     ss::future<std::vector<append_entries_reply>>
-    dispatch_hbeats_to_groups(ConsensusManager& m, hbeats_ptr reqs) {
+    dispatch_hbeats_to_groups(ConsensusManager& m, hbeat_metas_ptr reqs) {
         std::vector<ss::future<append_entries_reply>> futures;
         futures.reserve(reqs->size());
         // dispatch requests in parallel
@@ -273,9 +314,17 @@ private:
           reqs->begin(),
           reqs->end(),
           std::back_inserter(futures),
-          [this, &m, timeout](append_entries_request& req) mutable {
-              auto group = req.target_group();
-              auto f = dispatch_append_entries(m, std::move(req));
+          [this, &m, timeout](const heartbeat_metadata& hb) mutable {
+              auto group = hb.meta.group;
+              auto f = dispatch_append_entries(
+                m,
+                append_entries_request(
+                  hb.node_id,
+                  hb.target_node_id,
+                  hb.meta,
+                  model::make_memory_record_batch_reader(
+                    ss::circular_buffer<model::record_batch>{}),
+                  append_entries_request::flush_after_append::no));
               return ss::with_timeout(timeout, std::move(f))
                 .handle_exception_type([group](const ss::timed_out_error&) {
                     return append_entries_reply{
@@ -287,27 +336,209 @@ private:
         return ss::when_all_succeed(futures.begin(), futures.end());
     }
 
-    shard_groupped_hbeat_requests group_hbeats_by_shard(hbeats_t reqs) {
+    shard_groupped_hbeat_requests group_hbeats_by_shard(hbeat_metas_t reqs) {
         shard_groupped_hbeat_requests ret;
 
         for (auto& r : reqs) {
             if (unlikely(!_shard_table.contains(r.meta.group))) {
-                ret.group_missing_requests.push_back(std::move(r));
+                ret.group_missing_requests.push_back(r);
                 continue;
             }
 
             auto shard = _shard_table.shard_for(r.meta.group);
-            if (!ret.shard_requests.contains(shard)) {
-                auto hbeats = ss::make_foreign(
-                  std::make_unique<std::vector<append_entries_request>>());
-                hbeats->push_back(std::move(r));
-                ret.shard_requests.emplace(shard, std::move(hbeats));
+            auto [it, inserted] = ret.shard_requests.try_emplace(shard);
+            if (inserted) {
+                it->second = ss::make_foreign(std::make_unique<hbeat_metas_t>());
+            }
+            it->second->push_back(r);
+        }
+        return ret;
+    }
+
+    /*
+     * requests are fanned out to their shards in parallel. replies are
+     * returned in request order since a batch may contain more than one
+     * request for the same group.
+     */
+    ss::future<multi_append_reply> dispatch_multi_append(hbeats_t reqs) {
+        struct shard_requests {
+            hbeats_ptr requests = ss::make_foreign(std::make_unique<hbeats_t>());
+            std::vector<size_t> positions;
+        };
+
+        std::vector<append_entries_reply> replies(reqs.size());
+        absl::flat_hash_map<ss::shard_id, shard_requests> shards;
+        for (size_t i = 0; i < reqs.size(); ++i) {
+            auto group = reqs[i].target_group();
+            if (unlikely(!_shard_table.contains(group))) {
+                replies[i] = append_entries_reply{
+                  .group = group,
+                  .result = append_entries_reply::status::group_unavailable};
                 continue;
             }
+            auto& sr = shards[_shard_table.shard_for(group)];
+            sr.requests->push_back(
+              append_entries_request::make_foreign(std::move(reqs[i])));
+            sr.positions.push_back(i);
+        }
 
-            ret.shard_requests.find(shard)->second->push_back(std::move(r));
+        std::vector<ss::future<>> futures;
+        futures.reserve(shards.size());
+        for (auto& [shard, sr] : shards) {
+            futures.push_back(
+              dispatch_appends_to_core(shard, std::move(sr.requests))
+                .then([&replies, positions = std::move(sr.positions)](
+                        std::vector<append_entries_reply> part) {
+                    for (size_t i = 0; i < part.size(); ++i) {
+                        replies[positions[i]] = std::move(part[i]);
+                    }
+                }));
         }
-        return ret;
+        co_await ss::when_all_succeed(futures.begin(), futures.end());
+        co_return multi_append_reply{std::move(replies)};
+    }
+
+    /*
+     * like multi_append, the requests of a batch are sent to their shards in
+     * one message per shard and replies are returned in request order. the
+     * error factory makes the replies for groups that are not on this node
+     */
+    template<typename Req, typename Reply, typename ErrorFactory, typename Func>
+    ss::future<std::vector<Reply>>
+    dispatch_multi(std::vector<Req> reqs, ErrorFactory ef, Func f) {
+        using reqs_ptr = ss::foreign_ptr<std::unique_ptr<std::vector<Req>>>;
+        struct shard_requests {
+            reqs_ptr requests = ss::make_foreign(
+              std::make_unique<std::vector<Req>>());
+            std::vector<size_t> positions;
+        };
+
+        std::vector<Reply> replies(reqs.size());
+        absl::flat_hash_map<ss::shard_id, shard_requests> shards;
+        for (size_t i = 0; i < reqs.size(); ++i) {
+            auto group = reqs[i].target_group();
+            if (unlikely(!_shard_table.contains(group))) {
+                replies[i] = co_await ef();
+                continue;
+            }
+            auto& sr = shards[_shard_table.shard_for(group)];
+            sr.requests->push_back(std::move(reqs[i]));
+            sr.positions.push_back(i);
+        }
+
+        std::vector<ss::future<>> futures;
+        futures.reserve(shards.size());
+        for (auto& [shard, sr] : shards) {
+            futures.push_back(
+              dispatch_multi_to_core<Req, Reply>(
+                shard, std::move(sr.requests), ef, f)
+                .then([&replies, positions = std::move(sr.positions)](
+                        std::vector<Reply> part) {
+                    for (size_t i = 0; i < part.size(); ++i) {
+                        replies[positions[i]] = std::move(part[i]);
+                    }
+                }));
+        }
+        co_await ss::when_all_succeed(futures.begin(), futures.end());
+        co_return replies;
+    }
+
+    template<typename Req, typename Reply, typename ErrorFactory, typename Func>
+    ss::future<std::vector<Reply>> dispatch_multi_to_core(
+      ss::shard_id shard,
+      ss::foreign_ptr<std::unique_ptr<std::vector<Req>>> requests,
+      ErrorFactory ef,
+      Func f) {
+        return with_scheduling_group(
+          get_scheduling_group(),
+          [this, shard, r = std::move(requests), ef, f]() mutable {
+              return _group_manager.invoke_on(
+                shard,
+                get_smp_service_group(),
+                [r = std::move(r), ef, f](ConsensusManager& m) mutable {
+                    std::vector<ss::future<Reply>> futures;
+                    futures.reserve(r->size());
+                    for (auto& req : *r) {
+                        auto c = m.consensus_for(req.target_group());
+                        if (unlikely(!c)) {
+                            futures.push_back(ef());
+                            continue;
+                        }
+                        futures.push_back(f(std::move(req), c));
+                    }
+                    return ss::when_all_succeed(
+                      futures.begin(), futures.end());
+                });
+          });
+    }
+
+    /*
+     * the groups of a new lease generation are split by shard and kept on
+     * their shards, then every shard renews the groups it holds for the lease
+     */
+    ss::future<node_lease_reply> dispatch_node_lease(node_lease_request r) {
+        const node_lease_table::source src{r.node_id, r.source_shard};
+        const auto epoch = r.epoch;
+        const auto generation = r.generation;
+        if (r.groups) {
+            std::vector<std::vector<lease_group>> shard_groups(ss::smp::count);
+            for (auto& g : *r.groups) {
+                if (_shard_table.contains(g.group)) {
+                    shard_groups[_shard_table.shard_for(g.group)].push_back(g);
+                }
+            }
+            co_await with_scheduling_group(
+              get_scheduling_group(),
+              [this, &shard_groups, src, epoch, generation] {
+                  return _group_manager.invoke_on_all(
+                    get_smp_service_group(),
+                    [&shard_groups, src, epoch, generation](ConsensusManager&) {
+                        // copied to the shard that holds them
+                        node_leases().update(
+                          src,
+                          epoch,
+                          generation,
+                          shard_groups[ss::this_shard_id()]);
+                    });
+              });
+        }
+
+        auto renewed = co_await with_scheduling_group(
+          get_scheduling_group(), [this, src, epoch, generation] {
+              return _group_manager.map_reduce0(
+                [src, epoch, generation](ConsensusManager& m) {
+                    return node_leases().renew(
+                      src, epoch, generation, [&m](group_id g) {
+                          return m.consensus_for(g);
+                      });
+                },
+                true,
+                std::logical_and<>());
+          });
+        co_return node_lease_reply{.renewed = renewed};
+    }
+
+    ss::future<std::vector<append_entries_reply>>
+    dispatch_appends_to_core(ss::shard_id shard, hbeats_ptr requests) {
+        return with_scheduling_group(
+          get_scheduling_group(),
+          [this, shard, r = std::move(requests)]() mutable {
+              return _group_manager.invoke_on(
+                shard,
+                get_smp_service_group(),
+                [this, r = std::move(r)](ConsensusManager& m) mutable {
+                    std::vector<ss::future<append_entries_reply>> futures;
+                    futures.reserve(r->size());
+                    // dispatched in order so that requests for the same group
+                    // are enqueued in the order the leader sent them
+                    for (auto& req : *r) {
+                        futures.push_back(
+                          dispatch_append_entries(m, std::move(req)));
+                    }
+                    return ss::when_all_succeed(
+                      futures.begin(), futures.end());
+                });
+          });
     }
 
     ss::future<append_entries_reply>
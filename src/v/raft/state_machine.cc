@@ -36,6 +36,10 @@ ss::future<> state_machine::start() {
 
 void state_machine::set_next(model::offset offset) { _next = offset; }
 
+void state_machine::notify_applied(model::offset offset) {
+    _waiters.notify(offset);
+}
+
 ss::future<> state_machine::handle_eviction() {
     vlog(
       _log.warn,
@@ -51,9 +55,11 @@ ss::future<> state_machine::stop() {
 }
 
 ss::future<> state_machine::wait(
-  model::offset offset, model::timeout_clock::time_point timeout) {
-    return ss::with_gate(_gate, [this, timeout, offset] {
-        return _waiters.wait(offset, timeout, std::nullopt);
+  model::offset offset,
+  model::timeout_clock::time_point timeout,
+  std::optional<std::reference_wrapper<ss::abort_source>> as) {
+    return ss::with_gate(_gate, [this, timeout, offset, as] {
+        return _waiters.wait(offset, timeout, as);
     });
 }
 
@@ -74,7 +80,9 @@ state_machine::batch_applicator::operator()(model::record_batch batch) {
     auto last_offset = batch.last_offset();
     return _machine->apply(std::move(batch)).then([this, last_offset] {
         _last_applied = last_offset;
-        _machine->_waiters.notify(_last_applied);
+        if (!_machine->defers_apply_notifications()) {
+            _machine->_waiters.notify(_last_applied);
+        }
         return ss::stop_iteration::no;
     });
 }
@@ -69,7 +69,10 @@ public:
     virtual ss::future<> stop();
 
     // wait until at least offset is applied to state machine
-    ss::future<> wait(model::offset, model::timeout_clock::time_point);
+    ss::future<> wait(
+      model::offset,
+      model::timeout_clock::time_point,
+      std::optional<std::reference_wrapper<ss::abort_source>> = std::nullopt);
 
     /**
      * This must be implemented by the state machine. The state machine should
@@ -106,6 +109,14 @@ protected:
     void set_next(model::offset offset);
     virtual ss::future<> handle_eviction();
 
+    /**
+     * A state machine that returns from apply() before the batch is applied,
+     * e.g. to apply batches of independent states concurrently, returns true
+     * and notifies the waiters itself, in offset order, with notify_applied.
+     */
+    virtual bool defers_apply_notifications() const { return false; }
+    void notify_applied(model::offset);
+
     consensus* _raft;
     ss::gate _gate;
 
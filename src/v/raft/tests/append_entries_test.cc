@@ -24,6 +24,9 @@
 #include "storage/record_batch_builder.h"
 #include "storage/tests/utils/disk_log_builder.h"
 #include "test_utils/async.h"
+#include "units.h"
+
+#include <seastar/core/coroutine.hh>
 
 #include <system_error>
 
@@ -614,6 +617,58 @@ FIXTURE_TEST(test_snapshot_recovery, raft_test_fixture) {
     validate_offset_translation(gr);
 };
 
+FIXTURE_TEST(test_streamed_snapshot_recovery, raft_test_fixture) {
+    raft_group gr = raft_group(raft::group_id(0), 3);
+    gr.enable_all();
+    auto leader_id = wait_for_group_leader(gr);
+    model::node_id disabled_id;
+    for (auto& [id, _] : gr.get_members()) {
+        // disable one of the non leader nodes
+        if (leader_id != id) {
+            disabled_id = id;
+            gr.disable_node(id);
+            break;
+        }
+    }
+    bool success = replicate_random_batches(gr, 5).get0();
+    BOOST_REQUIRE(success);
+    validate_logs_replication(gr);
+
+    tests::cooperative_spin_wait_with_timeout(2s, [&gr] {
+        auto offset
+          = gr.get_members().begin()->second.consensus->committed_offset();
+        if (offset <= model::offset(0)) {
+            return false;
+        }
+        return are_all_commit_indexes_the_same(gr);
+    }).get0();
+
+    // store a snapshot spanning many install snapshot chunks, its content is
+    // streamed to the snapshot file
+    for (auto& [_, member] : gr.get_members()) {
+        member.consensus
+          ->write_snapshot(raft::write_snapshot_cfg(
+            get_leader_raft(gr)->committed_offset(),
+            [](ss::output_stream<char>& out) -> ss::future<> {
+                for (int i = 0; i < 16; ++i) {
+                    co_await out.write(ss::sstring(64_KiB, 'x'));
+                }
+            }))
+          .get0();
+    }
+    gr.enable_node(disabled_id);
+    success = replicate_random_batches(gr, 5).get0();
+    BOOST_REQUIRE(success);
+
+    wait_for(
+      10s,
+      [&gr] { return are_all_commit_indexes_the_same(gr); },
+      "After recovery state is consistent");
+
+    validate_logs_replication(gr);
+    validate_offset_translation(gr);
+};
+
 FIXTURE_TEST(test_snapshot_recovery_last_config, raft_test_fixture) {
     raft_group gr = raft_group(raft::group_id(0), 3);
     gr.enable_all();
@@ -774,6 +829,38 @@ FIXTURE_TEST(test_linarizable_barrier_single_node, raft_test_fixture) {
     }
 };
 
+FIXTURE_TEST(test_linarizable_barrier_with_leader_lease, raft_test_fixture) {
+    config::shard_local_cfg().get("raft_enable_lease_reads").set_value(true);
+    raft_group gr = raft_group(raft::group_id(0), 3);
+    gr.enable_all();
+    auto leader_id = wait_for_group_leader(gr);
+
+    bool success = replicate_random_batches(gr, 5).get0();
+    BOOST_REQUIRE(success);
+
+    leader_id = wait_for_group_leader(gr);
+    auto leader_raft = gr.get_member(leader_id).consensus;
+    // heartbeats acknowledged by the followers grant the lease
+    wait_for(
+      10s,
+      [leader_raft] { return leader_raft->has_leader_lease(); },
+      "Leader holds a lease");
+
+    auto r = leader_raft->linearizable_barrier().get();
+    if (r) {
+        BOOST_REQUIRE_EQUAL(r.value(), leader_raft->committed_offset());
+        auto logs = gr.read_all_logs();
+        std::vector<size_t> sizes;
+        for (auto& l : logs) {
+            sizes.push_back(l.second.size());
+        }
+        std::sort(sizes.begin(), sizes.end());
+        // at least 2 out of 3 nodes MUST have all entries replicated
+        BOOST_REQUIRE_EQUAL(sizes[2], sizes[1]);
+    }
+    config::shard_local_cfg().get("raft_enable_lease_reads").set_value(false);
+};
+
 FIXTURE_TEST(test_big_batches_replication, raft_test_fixture) {
     raft_group gr = raft_group(raft::group_id(0), 1);
     gr.enable_all();
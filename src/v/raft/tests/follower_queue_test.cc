@@ -0,0 +1,80 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "raft/follower_queue.h"
+
+#include <seastar/core/sleep.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <vector>
+
+using namespace std::chrono_literals; // NOLINT
+
+SEASTAR_THREAD_TEST_CASE(follower_queue_window_grows_with_stable_rtt) {
+    raft::follower_queue q(4);
+    BOOST_REQUIRE_EQUAL(q.window(), 4);
+    // about a window worth of replies grows the window by one
+    for (int i = 0; i < 5; ++i) {
+        q.append_entries_replied(10ms);
+    }
+    BOOST_REQUIRE_EQUAL(q.window(), 5);
+    for (int i = 0; i < 1000; ++i) {
+        q.append_entries_replied(10ms);
+    }
+    BOOST_REQUIRE_EQUAL(
+      q.window(), 4 * raft::follower_queue::max_window_factor);
+    BOOST_REQUIRE(q.is_idle());
+}
+
+SEASTAR_THREAD_TEST_CASE(follower_queue_window_shrinks_on_failures) {
+    raft::follower_queue q(16);
+    q.append_entries_failed();
+    BOOST_REQUIRE_EQUAL(q.window(), 8);
+    BOOST_REQUIRE_EQUAL(q.window_decreases(), 1);
+    for (int i = 0; i < 10; ++i) {
+        q.append_entries_failed();
+        // at most one decrease per round trip
+        ss::sleep(1ms).get();
+    }
+    BOOST_REQUIRE_EQUAL(q.window(), 1);
+    BOOST_REQUIRE(q.is_idle());
+}
+
+SEASTAR_THREAD_TEST_CASE(follower_queue_window_shrinks_on_rtt_inflation) {
+    raft::follower_queue q(16);
+    for (int i = 0; i < 16; ++i) {
+        q.append_entries_replied(5ms);
+    }
+    auto window = q.window();
+    for (int i = 0; i < 16; ++i) {
+        q.append_entries_replied(100ms);
+    }
+    BOOST_REQUIRE_LT(q.window(), window);
+    BOOST_REQUIRE_GE(q.window_decreases(), 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(follower_queue_shrinking_waits_for_inflight) {
+    raft::follower_queue q(2);
+    std::vector<ssx::semaphore_units> units;
+    units.push_back(q.get_append_entries_unit().get());
+    units.push_back(q.get_append_entries_unit().get());
+    q.append_entries_failed();
+    BOOST_REQUIRE_EQUAL(q.window(), 1);
+    units.pop_back();
+    // one request still in flight fills the shrunk window
+    auto f = q.get_append_entries_unit();
+    BOOST_REQUIRE(!f.available());
+    units.pop_back();
+    units.push_back(std::move(f).get());
+    units.clear();
+    BOOST_REQUIRE(q.is_idle());
+}
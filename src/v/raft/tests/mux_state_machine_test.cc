@@ -22,6 +22,7 @@
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/sleep.hh>
 #include <seastar/util/defer.hh>
 #include <seastar/util/log.hh>
@@ -164,6 +165,27 @@ struct simple_kv {
     }
 };
 
+// state applied concurrently with the other states
+template<int8_t bt>
+struct independent_kv : simple_kv<bt> {
+    static constexpr bool independent_apply = true;
+};
+
+// state that holds its updates until they are released
+template<int8_t bt>
+struct gated_kv : simple_kv<bt> {
+    ss::shared_promise<> released;
+    int applying = 0;
+
+    ss::future<std::error_code> apply_update(model::record_batch&& b) {
+        ++applying;
+        return released.get_shared_future().then(
+          [this, b = std::move(b)]() mutable {
+              return simple_kv<bt>::apply_update(std::move(b));
+          });
+    }
+};
+
 ss::logger kvlog{"kv-test"};
 
 template<typename T>
@@ -447,3 +469,43 @@ FIXTURE_TEST(timeout_test, mux_state_machine_fixture) {
     state_1.as.request_abort();
     BOOST_REQUIRE_EQUAL(res, raft::errc::timeout);
 }
+
+FIXTURE_TEST(test_independent_states, mux_state_machine_fixture) {
+    start_raft();
+    gated_kv<batch_type_1> state_1;
+    independent_kv<batch_type_2> state_2;
+    raft::mux_state_machine stm(
+      kvlog, _raft.get(), raft::persistent_last_applied::yes, state_1, state_2);
+    stm.start().get0();
+    auto stop = ss::defer([&stm] { stm.stop().get0(); });
+    wait_for_becoming_leader();
+    ss::abort_source as;
+
+    auto f_1 = stm.replicate_and_wait(
+      serialize_cmd(set_cmd{"test", 10}, batch_type_1),
+      model::timeout_clock::now() + 10s,
+      as);
+    tests::cooperative_spin_wait_with_timeout(
+      2s, [&state_1] { return state_1.applying == 1; })
+      .get0();
+
+    // state 2 is applied while state 1 is blocked
+    auto f_2 = stm.replicate_and_wait(
+      serialize_cmd(set_cmd{"test", 11}, batch_type_2),
+      model::timeout_clock::now() + 10s,
+      as);
+    tests::cooperative_spin_wait_with_timeout(
+      2s, [&state_2] { return state_2.kv_map.contains("test"); })
+      .get0();
+    BOOST_REQUIRE(state_1.kv_map.empty());
+
+    // results are published in offset order
+    ss::sleep(100ms).get0();
+    BOOST_REQUIRE(!f_2.available());
+
+    state_1.released.set_value();
+    BOOST_REQUIRE_EQUAL(f_1.get0(), errc::success);
+    BOOST_REQUIRE_EQUAL(f_2.get0(), errc::success);
+    BOOST_REQUIRE_EQUAL(state_1.kv_map.find("test")->second, 10);
+    BOOST_REQUIRE_EQUAL(state_2.kv_map.find("test")->second, 11);
+}
@@ -14,12 +14,14 @@
 #include "storage/fwd.h"
 #include "storage/kvstore.h"
 #include "storage/log_manager.h"
+#include "storage/offset_translator_state.h"
 #include "storage/record_batch_builder.h"
 #include "test_utils/fixture.h"
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/testing/thread_test_case.hh>
 
 #include <boost/test/tools/old/interface.hpp>
 
@@ -662,3 +664,54 @@ FIXTURE_TEST(test_moving_persistent_state, base_fixture) {
     BOOST_REQUIRE_EQUAL(map.has_value(), false);
     BOOST_REQUIRE_EQUAL(highest_known_offset.has_value(), false);
 }
+
+/**
+ * Translation of offsets covered by the frozen blocks of the state matches
+ * the translation of offsets covered by the recent batches, also after the
+ * state is truncated inside the frozen blocks
+ */
+SEASTAR_THREAD_TEST_CASE(test_frozen_offset_translator_state) {
+    model::ntp ntp(
+      model::ns("test"), model::topic("tp"), model::partition_id(0));
+    storage::offset_translator_state state(ntp, model::offset{-1}, 0);
+
+    // log offset -> kafka offset of every data batch
+    std::map<model::offset, model::offset> kafka_offsets;
+    model::offset next{0};
+    int64_t delta = 0;
+    for (int i = 0; i < 4000; ++i) {
+        if (random_generators::get_int(0, 1) == 0) {
+            auto length = random_generators::get_int(1, 3);
+            state.add_gap(next, next + model::offset(length - 1));
+            next += model::offset(length);
+            delta += length;
+        } else {
+            kafka_offsets.emplace(next, next - model::offset(delta));
+            next = model::next_offset(next);
+        }
+    }
+    BOOST_REQUIRE_LT(state.resident_size(), state.size());
+
+    auto validate = [&kafka_offsets](
+                      const storage::offset_translator_state& st) {
+        for (const auto& [log_offset, kafka_offset] : kafka_offsets) {
+            BOOST_REQUIRE_EQUAL(st.from_log_offset(log_offset), kafka_offset);
+            BOOST_REQUIRE_EQUAL(st.to_log_offset(kafka_offset), log_offset);
+        }
+    };
+    validate(state);
+    validate(storage::offset_translator_state::from_serialized_map(
+      ntp, state.serialize_map()));
+
+    auto start = std::next(kafka_offsets.begin(), kafka_offsets.size() / 4);
+    BOOST_REQUIRE(state.prefix_truncate(model::prev_offset(start->first)));
+    kafka_offsets.erase(kafka_offsets.begin(), start);
+    validate(state);
+
+    auto end = std::next(kafka_offsets.begin(), kafka_offsets.size() / 2);
+    BOOST_REQUIRE(state.truncate(end->first));
+    kafka_offsets.erase(end, kafka_offsets.end());
+    validate(state);
+    validate(storage::offset_translator_state::from_serialized_map(
+      ntp, state.serialize_map()));
+}
@@ -26,6 +26,7 @@
 #include "raft/raft_feature_table.h"
 #include "raft/rpc_client_protocol.h"
 #include "raft/service.h"
+#include "raft/timer_wheel.h"
 #include "random/generators.h"
 #include "rpc/backoff_policy.h"
 #include "rpc/connection_cache.h"
@@ -167,7 +168,8 @@ struct raft_node {
           storage.local(),
           recovery_throttle.local(),
           recovery_mem_quota,
-          _features);
+          _features,
+          _timers);
 
         // create connections to initial nodes
         consensus->config().for_each_broker(
@@ -352,6 +354,7 @@ struct raft_node {
     consensus_ptr consensus;
     std::unique_ptr<raft::log_eviction_stm> _nop_stm;
     raft::raft_feature_table _features;
+    raft::timer_wheel _timers;
     ss::abort_source _as;
 };
 
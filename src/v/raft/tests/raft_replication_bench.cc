@@ -0,0 +1,594 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "config/configuration.h"
+#include "config/mock_property.h"
+#include "model/metadata.h"
+#include "model/namespace.h"
+#include "model/record_batch_reader.h"
+#include "raft/consensus.h"
+#include "raft/consensus_client_protocol.h"
+#include "raft/heartbeat_manager.h"
+#include "raft/raft_feature_table.h"
+#include "raft/service.h"
+#include "raft/timer_wheel.h"
+#include "random/generators.h"
+#include "ssx/semaphore.h"
+#include "ssx/sformat.h"
+#include "storage/api.h"
+#include "storage/log_manager.h"
+#include "storage/ntp_config.h"
+#include "storage/record_batch_builder.h"
+#include "units.h"
+#include "utils/hdr_hist.h"
+#include "vassert.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/testing/perf_tests.hh>
+
+#include <absl/container/flat_hash_map.h>
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace std::chrono_literals;
+
+/**
+ * Benchmark of the raft replication path.
+ *
+ * A number of raft groups are replicated across three simulated nodes that
+ * live in the same process. The nodes talk through an in-process network
+ * that delivers every request and reply to the raft service of the target
+ * node after a configured one way latency. The disk latency is added by the
+ * network to the append entries requests that ask the follower to flush, it
+ * stands for the time a follower spends in fsync.
+ *
+ * Every iteration replicates a batch to each group with acks=all and waits
+ * for all of them to be committed. Once it completes a test reports the
+ * replication throughput, the commit latency percentiles and the CPU time
+ * spent by the idle groups, which is the cost of the heartbeats.
+ */
+struct replication_bench_params {
+    // number of raft groups, each replicated to the three nodes
+    size_t groups;
+    // size of the value of the single record of a replicated batch
+    size_t batch_size;
+    // one way latency of the simulated network
+    std::chrono::milliseconds network_latency{0};
+    // latency added to the follower appends that have to be flushed
+    std::chrono::milliseconds disk_latency{0};
+};
+
+namespace {
+
+static constexpr auto heartbeat_interval = 150ms;
+static constexpr size_t node_count = 3;
+
+class simulated_network;
+
+using groups_t
+  = absl::flat_hash_map<raft::group_id, ss::lw_shared_ptr<raft::consensus>>;
+
+struct bench_group_manager {
+    ss::lw_shared_ptr<raft::consensus> consensus_for(raft::group_id g) {
+        auto it = groups->find(g);
+        return it == groups->end() ? nullptr : it->second;
+    }
+
+    groups_t* groups = nullptr;
+};
+
+// all the groups of a simulated node live on the shard running the bench
+struct bench_shard_table {
+    ss::shard_id shard_for(raft::group_id) { return ss::this_shard_id(); }
+    bool contains(raft::group_id g) { return groups->contains(g); }
+
+    groups_t* groups = nullptr;
+};
+
+/// requests are delivered in process, there is no wire format to parse
+class local_streaming_context final : public rpc::streaming_context {
+public:
+    ss::future<ssx::semaphore_units> reserve_memory(size_t) final {
+        return ss::get_units(_memory, 0);
+    }
+    const rpc::header& get_header() const final { return _header; }
+    void signal_body_parse() final {}
+    void body_parse_exception(std::exception_ptr) final {}
+
+private:
+    ssx::semaphore _memory{0, "raft/bench"};
+    rpc::header _header;
+};
+
+using bench_service = raft::service<bench_group_manager, bench_shard_table>;
+
+class bench_node {
+public:
+    bench_node(
+      model::node_id id, simulated_network& net, ss::sstring directory)
+      : _id(id)
+      , _network(net)
+      , _directory(std::move(directory))
+      , _recovery_mem_quota([] {
+          return raft::recovery_memory_quota::configuration{
+            .max_recovery_memory = config::mock_binding<std::optional<size_t>>(
+              std::nullopt),
+            .default_read_buffer_size = config::mock_binding(512_KiB),
+          };
+      }) {
+        _features.set_feature_active(
+          raft::raft_feature::improved_config_change);
+    }
+
+    ss::future<> start();
+    ss::future<> stop();
+
+    ss::future<>
+    create_group(raft::group_id, const std::vector<model::broker>&);
+
+    ss::lw_shared_ptr<raft::consensus> consensus_for(raft::group_id g) {
+        auto it = _groups.find(g);
+        return it == _groups.end() ? nullptr : it->second;
+    }
+
+    bench_service& service() { return *_service; }
+    model::node_id id() const { return _id; }
+
+private:
+    model::node_id _id;
+    simulated_network& _network;
+    ss::sstring _directory;
+    ss::sharded<storage::api> _storage;
+    ss::sharded<raft::recovery_throttle> _recovery_throttle;
+    ss::sharded<bench_group_manager> _group_manager;
+    raft::recovery_memory_quota _recovery_mem_quota;
+    raft::raft_feature_table _features;
+    raft::timer_wheel _timers;
+    bench_shard_table _shard_table;
+    std::unique_ptr<bench_service> _service;
+    std::unique_ptr<raft::heartbeat_manager> _heartbeats;
+    groups_t _groups;
+};
+
+/**
+ * Delivers the requests of a node to the service of the target node, the
+ * request and the reply are each delayed by the network latency.
+ */
+class simulated_network {
+public:
+    explicit simulated_network(replication_bench_params p)
+      : _params(p) {}
+
+    void add(bench_node& n) { _nodes.emplace(n.id(), &n); }
+    ss::future<> stop() { return _gate.close(); }
+
+    raft::consensus_client_protocol protocol(model::node_id self);
+
+    template<typename Reply, typename Request, typename Func>
+    ss::future<result<Reply>>
+    deliver(model::node_id target, Request r, Func f) {
+        auto holder = _gate.hold();
+        ++_requests;
+        co_await ss::sleep(_params.network_latency);
+        auto it = _nodes.find(target);
+        if (it == _nodes.end()) {
+            co_return result<Reply>(rpc::errc::disconnected_endpoint);
+        }
+        local_streaming_context ctx;
+        auto reply = co_await f(it->second->service(), std::move(r), ctx);
+        co_await ss::sleep(_params.network_latency);
+        co_return result<Reply>(std::move(reply));
+    }
+
+    std::chrono::milliseconds disk_latency() const {
+        return _params.disk_latency;
+    }
+
+    uint64_t requests() const { return _requests; }
+    void heartbeats_sent(size_t groups) {
+        ++_heartbeat_requests;
+        _group_heartbeats += groups;
+    }
+    uint64_t heartbeat_requests() const { return _heartbeat_requests; }
+    uint64_t group_heartbeats() const { return _group_heartbeats; }
+
+private:
+    replication_bench_params _params;
+    absl::flat_hash_map<model::node_id, bench_node*> _nodes;
+    ss::gate _gate;
+    uint64_t _requests{0};
+    uint64_t _heartbeat_requests{0};
+    uint64_t _group_heartbeats{0};
+};
+
+class simulated_protocol final : public raft::consensus_client_protocol::impl {
+public:
+    simulated_protocol(simulated_network& net)
+      : _net(net) {}
+
+    ss::future<result<raft::vote_reply>>
+    vote(model::node_id n, raft::vote_request&& r, rpc::client_opts) final {
+        return _net.deliver<raft::vote_reply>(
+          n, std::move(r), [](auto& s, auto r, auto& ctx) {
+              return s.vote(std::move(r), ctx);
+          });
+    }
+
+    ss::future<result<raft::append_entries_reply>> append_entries(
+      model::node_id n,
+      raft::append_entries_request&& r,
+      rpc::client_opts) final {
+        auto disk_latency = r.flush ? _net.disk_latency() : 0ms;
+        return _net.deliver<raft::append_entries_reply>(
+          n, std::move(r), [disk_latency](auto& s, auto r, auto& ctx) {
+              return s.append_entries(std::move(r), ctx)
+                .then([disk_latency](raft::append_entries_reply reply) {
+                    return ss::sleep(disk_latency).then([reply] {
+                        return reply;
+                    });
+                });
+          });
+    }
+
+    ss::future<result<raft::heartbeat_reply>> heartbeat(
+      model::node_id n, raft::heartbeat_request&& r, rpc::client_opts) final {
+        _net.heartbeats_sent(r.heartbeats.size());
+        return _net.deliver<raft::heartbeat_reply>(
+          n, std::move(r), [](auto& s, auto r, auto& ctx) {
+              return s.heartbeat(std::move(r), ctx);
+          });
+    }
+
+    ss::future<result<raft::install_snapshot_reply>> install_snapshot(
+      model::node_id n,
+      raft::install_snapshot_request&& r,
+      rpc::client_opts) final {
+        return _net.deliver<raft::install_snapshot_reply>(
+          n, std::move(r), [](auto& s, auto r, auto& ctx) {
+              return s.install_snapshot(std::move(r), ctx);
+          });
+    }
+
+    ss::future<result<raft::timeout_now_reply>> timeout_now(
+      model::node_id n,
+      raft::timeout_now_request&& r,
+      rpc::client_opts) final {
+        return _net.deliver<raft::timeout_now_reply>(
+          n, std::move(r), [](auto& s, auto r, auto& ctx) {
+              return s.timeout_now(std::move(r), ctx);
+          });
+    }
+
+    ss::future<bool> ensure_disconnect(model::node_id) final {
+        return ss::make_ready_future<bool>(true);
+    }
+
+    ss::future<result<raft::transfer_leadership_reply>> transfer_leadership(
+      model::node_id n,
+      raft::transfer_leadership_request&& r,
+      rpc::client_opts) final {
+        return _net.deliver<raft::transfer_leadership_reply>(
+          n, std::move(r), [](auto& s, auto r, auto& ctx) {
+              return s.transfer_leadership(std::move(r), ctx);
+          });
+    }
+
+    ss::future<> reset_backoff(model::node_id) final { return ss::now(); }
+
+    ss::future<result<raft::node_lease_reply>> node_lease(
+      model::node_id n, raft::node_lease_request&& r, rpc::client_opts) final {
+        return _net.deliver<raft::node_lease_reply>(
+          n, std::move(r), [](auto& s, auto r, auto& ctx) {
+              return s.node_lease(std::move(r), ctx);
+          });
+    }
+
+private:
+    simulated_network& _net;
+};
+
+raft::consensus_client_protocol simulated_network::protocol(model::node_id) {
+    return raft::make_consensus_client_protocol<simulated_protocol>(*this);
+}
+
+ss::future<> bench_node::start() {
+    co_await _storage.start(
+      [this]() {
+          return storage::kvstore_config(
+            1_MiB,
+            config::mock_binding(10ms),
+            _directory,
+            storage::debug_sanitize_files::no);
+      },
+      [this]() {
+          return storage::log_config(
+            storage::log_config::storage_type::disk,
+            _directory,
+            100_MiB,
+            storage::debug_sanitize_files::no);
+      });
+    co_await _storage.invoke_on_all(&storage::api::start);
+    co_await _recovery_throttle.start(ss::sharded_parameter([] {
+        return config::shard_local_cfg().raft_learner_recovery_rate.bind();
+    }));
+    co_await _group_manager.start();
+    co_await _group_manager.invoke_on_all(
+      [this](bench_group_manager& m) { m.groups = &_groups; });
+    _shard_table.groups = &_groups;
+    _service = std::make_unique<bench_service>(
+      ss::default_scheduling_group(),
+      ss::default_smp_service_group(),
+      _group_manager,
+      _shard_table,
+      heartbeat_interval);
+    _heartbeats = std::make_unique<raft::heartbeat_manager>(
+      heartbeat_interval,
+      _network.protocol(_id),
+      _id,
+      heartbeat_interval * 20,
+      &_features);
+    co_await _heartbeats->start();
+}
+
+ss::future<> bench_node::create_group(
+  raft::group_id g, const std::vector<model::broker>& brokers) {
+    storage::ntp_config ntp_cfg(
+      model::ntp(
+        model::kafka_namespace,
+        model::topic(ssx::sformat("group_{}", g())),
+        model::partition_id(0)),
+      _storage.local().log_mgr().config().base_dir);
+    auto log = co_await _storage.local().log_mgr().manage(std::move(ntp_cfg));
+    auto c = ss::make_lw_shared<raft::consensus>(
+      _id,
+      g,
+      raft::group_configuration(brokers, model::revision_id(0)),
+      raft::timeout_jitter(heartbeat_interval * 10),
+      log,
+      raft::scheduling_config(
+        ss::default_scheduling_group(), ss::default_priority_class()),
+      std::chrono::seconds(10),
+      _network.protocol(_id),
+      [](raft::leadership_status) {},
+      _storage.local(),
+      _recovery_throttle.local(),
+      _recovery_mem_quota,
+      _features,
+      _timers);
+    _groups.emplace(g, c);
+    co_await _heartbeats->register_group(c);
+    co_await c->start();
+}
+
+ss::future<> bench_node::stop() {
+    for (auto& [g, _] : _groups) {
+        co_await _heartbeats->deregister_group(g);
+    }
+    co_await _heartbeats->stop();
+    for (auto& [_, c] : _groups) {
+        co_await c->stop();
+    }
+    _groups.clear();
+    _service.reset();
+    co_await _group_manager.stop();
+    co_await _recovery_throttle.stop();
+    co_await _storage.stop();
+}
+
+model::record_batch make_batch(size_t size) {
+    storage::record_batch_builder builder(
+      model::record_batch_type::raft_data, model::offset(0));
+    iobuf value;
+    value.append(random_generators::gen_alphanum_string(size).data(), size);
+    builder.add_raw_kv(std::nullopt, std::move(value));
+    return std::move(builder).build();
+}
+
+} // namespace
+
+class replication_bench_fixture {
+public:
+    explicit replication_bench_fixture(replication_bench_params p)
+      : _params(p)
+      , _network(p)
+      , _directory(
+          "raft_bench." + random_generators::gen_alphanum_string(6)) {
+        std::vector<model::broker> brokers;
+        for (size_t i = 0; i < node_count; ++i) {
+            auto id = model::node_id(static_cast<int>(i));
+            brokers.emplace_back(
+              id,
+              net::unresolved_address("localhost", 9092),
+              net::unresolved_address("localhost", 11000 + id),
+              std::nullopt,
+              model::broker_properties{.cores = 1});
+            _nodes.push_back(std::make_unique<bench_node>(
+              id, _network, ssx::sformat("{}/{}", _directory, id)));
+            _network.add(*_nodes.back());
+        }
+        for (auto& n : _nodes) {
+            n->start().get();
+        }
+        for (size_t g = 0; g < _params.groups; ++g) {
+            for (auto& n : _nodes) {
+                n->create_group(raft::group_id(g), brokers).get();
+            }
+        }
+        wait_for_leaders();
+        measure_idle_cost();
+    }
+
+    replication_bench_fixture(const replication_bench_fixture&) = delete;
+    replication_bench_fixture& operator=(const replication_bench_fixture&)
+      = delete;
+    replication_bench_fixture(replication_bench_fixture&&) = delete;
+    replication_bench_fixture& operator=(replication_bench_fixture&&)
+      = delete;
+
+    ~replication_bench_fixture() {
+        report();
+        _network.stop().get();
+        for (auto& n : _nodes) {
+            n->stop().get();
+        }
+    }
+
+    ss::future<size_t> run() {
+        std::vector<ss::lw_shared_ptr<raft::consensus>> leaders;
+        leaders.reserve(_params.groups);
+        for (size_t g = 0; g < _params.groups; ++g) {
+            leaders.push_back(leader_of(raft::group_id(g)));
+        }
+        perf_tests::start_measuring_time();
+        auto start = raft::clock_type::now();
+        co_await ss::parallel_for_each(
+          leaders, [this](ss::lw_shared_ptr<raft::consensus>& c) {
+              return replicate(*c);
+          });
+        _elapsed += raft::clock_type::now() - start;
+        perf_tests::stop_measuring_time();
+        co_return leaders.size();
+    }
+
+private:
+    ss::future<> replicate(raft::consensus& c) {
+        auto start = raft::clock_type::now();
+        auto batch = make_batch(_params.batch_size);
+        auto r = co_await c.replicate(
+          model::make_memory_record_batch_reader(std::move(batch)),
+          raft::replicate_options(raft::consistency_level::quorum_ack));
+        vassert(r.has_value(), "replication failed: {}", r.error().message());
+        _commit_latency.record(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+            raft::clock_type::now() - start)
+            .count());
+        _bytes += _params.batch_size;
+    }
+
+    ss::lw_shared_ptr<raft::consensus> leader_of(raft::group_id g) {
+        for (auto& n : _nodes) {
+            auto c = n->consensus_for(g);
+            if (c && c->is_elected_leader()) {
+                return c;
+            }
+        }
+        wait_for_leaders();
+        return leader_of(g);
+    }
+
+    void wait_for_leaders() {
+        for (size_t g = 0; g < _params.groups; ++g) {
+            while (true) {
+                bool found = false;
+                for (auto& n : _nodes) {
+                    auto c = n->consensus_for(raft::group_id(g));
+                    found = found || c->is_elected_leader();
+                }
+                if (found) {
+                    break;
+                }
+                ss::sleep(10ms).get();
+            }
+        }
+    }
+
+    // the groups are idle, the reactor is kept busy by the heartbeats only
+    void measure_idle_cost() {
+        static constexpr auto idle_period = 2s;
+        auto busy = ss::engine().total_busy_time();
+        auto group_heartbeats = _network.group_heartbeats();
+        ss::sleep(idle_period).get();
+        _idle_busy = ss::engine().total_busy_time() - busy;
+        _idle_group_heartbeats = _network.group_heartbeats()
+                                 - group_heartbeats;
+        _idle_period = idle_period;
+    }
+
+    void report() {
+        auto seconds = std::chrono::duration<double>(_elapsed).count();
+        auto idle_seconds = std::chrono::duration<double>(_idle_period).count();
+        auto busy_us = std::chrono::duration<double, std::micro>(_idle_busy)
+                         .count();
+        fmt::print(
+          std::cout,
+          "{} groups, {} byte batches, {} network, {} disk - {:.2f} MiB/s, "
+          "commit latency p50: {}us, p99: {}us, p999: {}us, idle cpu: "
+          "{:.2f}%, {:.2f}us per group heartbeat\n",
+          _params.groups,
+          _params.batch_size,
+          _params.network_latency,
+          _params.disk_latency,
+          seconds > 0 ? _bytes / seconds / (1024 * 1024) : 0.0,
+          _commit_latency.get_value_at(50.0),
+          _commit_latency.get_value_at(99.0),
+          _commit_latency.get_value_at(99.9),
+          busy_us / (idle_seconds * 1'000'000) * 100,
+          _idle_group_heartbeats > 0 ? busy_us / _idle_group_heartbeats
+                                     : 0.0);
+    }
+
+    replication_bench_params _params;
+    simulated_network _network;
+    ss::sstring _directory;
+    std::vector<std::unique_ptr<bench_node>> _nodes;
+
+    hdr_hist _commit_latency{hdr_hist::us_per_hour, 1, 3};
+    size_t _bytes{0};
+    raft::clock_type::duration _elapsed{0};
+    std::chrono::nanoseconds _idle_busy{0};
+    raft::clock_type::duration _idle_period{0};
+    uint64_t _idle_group_heartbeats{0};
+};
+
+// a single group, the replication path itself is the bottleneck
+struct single_group : replication_bench_fixture {
+    single_group()
+      : replication_bench_fixture({.groups = 1, .batch_size = 16_KiB}) {}
+};
+
+// many small groups on an ideal network and disk
+struct many_groups : replication_bench_fixture {
+    many_groups()
+      : replication_bench_fixture({.groups = 1000, .batch_size = 1_KiB}) {}
+};
+
+// nodes in the same availability zone
+struct same_zone : replication_bench_fixture {
+    same_zone()
+      : replication_bench_fixture({
+        .groups = 100,
+        .batch_size = 16_KiB,
+        .network_latency = 1ms,
+        .disk_latency = 1ms,
+      }) {}
+};
+
+// followers in other availability zones
+struct cross_zone : replication_bench_fixture {
+    cross_zone()
+      : replication_bench_fixture({
+        .groups = 100,
+        .batch_size = 16_KiB,
+        .network_latency = 5ms,
+        .disk_latency = 1ms,
+      }) {}
+};
+
+PERF_TEST_F(single_group, replicate) { return run(); }
+PERF_TEST_F(many_groups, replicate) { return run(); }
+PERF_TEST_F(same_zone, replicate) { return run(); }
+PERF_TEST_F(cross_zone, replicate) { return run(); }
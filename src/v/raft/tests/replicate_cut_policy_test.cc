@@ -0,0 +1,66 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "raft/replicate_batcher.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+
+using namespace std::chrono_literals; // NOLINT
+using policy = model::replicate_batcher_policy;
+
+SEASTAR_THREAD_TEST_CASE(fixed_policy_never_lingers) {
+    raft::replicate_cut_policy p(1_MiB);
+    p.append_completed(1000us, 512_KiB);
+    BOOST_REQUIRE_EQUAL(p.linger(policy::fixed, 10ms, 1).count(), 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(no_linger_without_observations) {
+    raft::replicate_cut_policy p(1_MiB);
+    BOOST_REQUIRE_EQUAL(p.linger(policy::throughput_first, 10ms, 1).count(), 0);
+    BOOST_REQUIRE_EQUAL(p.linger(policy::latency_first, 10ms, 1).count(), 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(light_load_cuts_immediately) {
+    raft::replicate_cut_policy p(1_MiB);
+    // nothing arrives while appending, target collapses to a single byte
+    for (int i = 0; i < 10; ++i) {
+        p.append_completed(1000us, 0);
+    }
+    BOOST_REQUIRE_EQUAL(p.target_bytes(), 1);
+    BOOST_REQUIRE_EQUAL(p.linger(policy::throughput_first, 10ms, 1).count(), 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(burst_lingers_according_to_policy) {
+    raft::replicate_cut_policy p(1_MiB);
+    p.append_completed(1000us, 100_KiB);
+    BOOST_REQUIRE_EQUAL(p.target_bytes(), 100_KiB);
+
+    // throughput first waits up to a full append latency
+    BOOST_REQUIRE_EQUAL(
+      p.linger(policy::throughput_first, 10ms, 10_KiB).count(), 1000);
+    // capped by the configured maximum
+    BOOST_REQUIRE_EQUAL(
+      p.linger(policy::throughput_first, 500us, 10_KiB).count(), 0);
+    BOOST_REQUIRE_EQUAL(
+      p.linger(policy::throughput_first, 500us, 60_KiB).count(), 500);
+
+    // latency first only waits when the batch is almost full
+    BOOST_REQUIRE_EQUAL(
+      p.linger(policy::latency_first, 10ms, 10_KiB).count(), 0);
+    BOOST_REQUIRE_EQUAL(
+      p.linger(policy::latency_first, 10ms, 90_KiB).count(), 250);
+
+    // full batches are cut immediately
+    BOOST_REQUIRE_EQUAL(
+      p.linger(policy::throughput_first, 10ms, 100_KiB).count(), 0);
+}
@@ -0,0 +1,97 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "raft/timer_wheel.h"
+
+#include <seastar/core/sleep.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace std::chrono_literals; // NOLINT
+
+// a short tick, so that the deadlines below reach every level of the wheel
+static constexpr auto tick = std::chrono::microseconds(1);
+
+SEASTAR_THREAD_TEST_CASE(timer_wheel_fires_in_deadline_order) {
+    raft::timer_wheel wheel(tick);
+    std::vector<std::chrono::milliseconds> timeouts{300ms, 5ms, 50ms, 1ms};
+    std::vector<std::unique_ptr<raft::timer_wheel::timer>> timers;
+    std::vector<size_t> fired;
+    auto start = raft::clock_type::now();
+    for (size_t i = 0; i < timeouts.size(); ++i) {
+        auto& t = timers.emplace_back(
+          std::make_unique<raft::timer_wheel::timer>(wheel));
+        auto deadline = start + timeouts[i];
+        t->set_callback([&fired, i, deadline] {
+            BOOST_REQUIRE(raft::clock_type::now() >= deadline);
+            fired.push_back(i);
+        });
+        t->arm(deadline);
+    }
+    BOOST_REQUIRE_EQUAL(wheel.armed(), timeouts.size());
+
+    ss::sleep(400ms).get();
+    BOOST_REQUIRE_EQUAL(wheel.armed(), 0);
+    BOOST_REQUIRE(fired == std::vector<size_t>({3, 1, 2, 0}));
+}
+
+SEASTAR_THREAD_TEST_CASE(timer_wheel_cancel_and_rearm) {
+    raft::timer_wheel wheel(tick);
+    int fired = 0;
+    raft::timer_wheel::timer cancelled(wheel);
+    cancelled.set_callback([&fired] { ++fired; });
+    cancelled.arm(raft::clock_type::now() + 10ms);
+    BOOST_REQUIRE(cancelled.armed());
+    BOOST_REQUIRE(cancelled.cancel());
+    BOOST_REQUIRE(!cancelled.armed());
+    BOOST_REQUIRE(!cancelled.cancel());
+
+    raft::timer_wheel::timer moved(wheel);
+    moved.set_callback([&fired] { fired += 10; });
+    moved.arm(raft::clock_type::now() + 10ms);
+    moved.rearm(raft::clock_type::now() + 1s);
+    BOOST_REQUIRE_EQUAL(wheel.armed(), 1);
+
+    ss::sleep(50ms).get();
+    BOOST_REQUIRE_EQUAL(fired, 0);
+    BOOST_REQUIRE(moved.cancel());
+    BOOST_REQUIRE_EQUAL(wheel.armed(), 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(timer_wheel_rearm_from_callback) {
+    raft::timer_wheel wheel(raft::timer_wheel::default_tick);
+    int fired = 0;
+    raft::timer_wheel::timer t(wheel);
+    t.set_callback([&fired, &t] {
+        if (++fired < 3) {
+            t.arm(raft::clock_type::now() + 10ms);
+        }
+    });
+    t.arm(raft::clock_type::now());
+
+    ss::sleep(200ms).get();
+    BOOST_REQUIRE_EQUAL(fired, 3);
+    BOOST_REQUIRE(!t.armed());
+}
+
+SEASTAR_THREAD_TEST_CASE(timer_wheel_destroyed_timer_is_disarmed) {
+    raft::timer_wheel wheel(tick);
+    {
+        raft::timer_wheel::timer t(wheel);
+        t.set_callback([] { BOOST_FAIL("destroyed timer fired"); });
+        t.arm(raft::clock_type::now() + 5ms);
+    }
+    BOOST_REQUIRE_EQUAL(wheel.armed(), 0);
+    ss::sleep(20ms).get();
+}
@@ -19,6 +19,7 @@
 #include "raft/types.h"
 #include "random/generators.h"
 #include "reflection/adl.h"
+#include "serde/serde.h"
 #include "storage/record_batch_builder.h"
 #include "test_utils/randoms.h"
 #include "test_utils/rpc.h"
@@ -104,6 +105,160 @@ SEASTAR_THREAD_TEST_CASE(append_entries_requests) {
       .get0();
 }
 
+SEASTAR_THREAD_TEST_CASE(multi_append_roundtrip) {
+    std::vector<raft::append_entries_request> requests;
+    std::vector<ss::circular_buffer<model::record_batch>> expected;
+    for (int i = 0; i < 5; ++i) {
+        auto batches = model::test::make_random_batches(
+          model::offset(1), 3, false);
+        auto rdr = model::make_memory_record_batch_reader(std::move(batches));
+        auto readers = raft::details::share_n(std::move(rdr), 2).get0();
+        requests.emplace_back(
+          raft::vnode(model::node_id(1), model::revision_id(10)),
+          raft::vnode(model::node_id(2), model::revision_id(20)),
+          raft::protocol_metadata{
+            .group = raft::group_id(i),
+            .commit_index = model::offset(100),
+            .term = model::term_id(10),
+            .prev_log_index = model::offset(99),
+            .prev_log_term = model::term_id(9),
+            .last_visible_index = model::offset(200),
+          },
+          std::move(readers.back()),
+          raft::append_entries_request::flush_after_append(i % 2 == 0));
+        expected.push_back(model::consume_reader_to_memory(
+                             std::move(readers.front()), model::no_timeout)
+                             .get0());
+    }
+
+    iobuf buf;
+    serde::write_async(buf, raft::multi_append_request(std::move(requests)))
+      .get();
+    iobuf_parser parser(std::move(buf));
+    auto d = serde::read_async<raft::multi_append_request>(parser).get0();
+
+    BOOST_REQUIRE_EQUAL(d.requests.size(), expected.size());
+    for (size_t i = 0; i < d.requests.size(); ++i) {
+        auto& r = d.requests[i];
+        BOOST_REQUIRE_EQUAL(r.meta.group, raft::group_id(i));
+        BOOST_REQUIRE_EQUAL(r.meta.prev_log_term, model::term_id(9));
+        BOOST_REQUIRE_EQUAL(
+          r.target_node_id,
+          raft::vnode(model::node_id(2), model::revision_id(20)));
+        BOOST_REQUIRE_EQUAL(bool(r.flush), i % 2 == 0);
+        r.batches()
+          .consume(
+            checking_consumer(std::move(expected[i])), model::no_timeout)
+          .get0();
+    }
+
+    std::vector<raft::append_entries_reply> replies;
+    for (int i = 0; i < 5; ++i) {
+        replies.push_back(raft::append_entries_reply{
+          .group = raft::group_id(i),
+          .term = model::term_id(10),
+          .last_flushed_log_index = model::offset(i),
+          .result = raft::append_entries_reply::status::success});
+    }
+    raft::multi_append_reply reply(replies);
+    auto reply_d = serde::from_iobuf<raft::multi_append_reply>(
+      serde::to_iobuf(std::move(reply)));
+    BOOST_REQUIRE(reply_d == raft::multi_append_reply(std::move(replies)));
+}
+
+SEASTAR_THREAD_TEST_CASE(multi_vote_roundtrip) {
+    std::vector<raft::vote_request> requests;
+    std::vector<raft::vote_reply> replies;
+    for (int i = 0; i < 5; ++i) {
+        requests.push_back(raft::vote_request{
+          .node_id = raft::vnode(model::node_id(1), model::revision_id(i)),
+          .target_node_id = raft::vnode(
+            model::node_id(2), model::revision_id(i)),
+          .group = raft::group_id(i),
+          .term = model::term_id(i + 10),
+          .prev_log_index = model::offset(i * 100),
+          .prev_log_term = model::term_id(i + 9),
+          .leadership_transfer = i % 2 == 0});
+        replies.push_back(raft::vote_reply{
+          .target_node_id = raft::vnode(
+            model::node_id(1), model::revision_id(i)),
+          .term = model::term_id(i + 10),
+          .granted = i % 2 == 0,
+          .log_ok = true});
+    }
+
+    raft::multi_vote_request req(requests);
+    auto req_d = serde::from_iobuf<raft::multi_vote_request>(
+      serde::to_iobuf(std::move(req)));
+    BOOST_REQUIRE(req_d == raft::multi_vote_request(std::move(requests)));
+
+    raft::multi_vote_reply reply(replies);
+    auto reply_d = serde::from_iobuf<raft::multi_vote_reply>(
+      serde::to_iobuf(std::move(reply)));
+    BOOST_REQUIRE(reply_d == raft::multi_vote_reply(std::move(replies)));
+}
+
+SEASTAR_THREAD_TEST_CASE(multi_timeout_now_roundtrip) {
+    std::vector<raft::timeout_now_request> requests;
+    std::vector<raft::timeout_now_reply> replies;
+    for (int i = 0; i < 5; ++i) {
+        requests.push_back(raft::timeout_now_request{
+          .target_node_id = raft::vnode(
+            model::node_id(2), model::revision_id(i)),
+          .node_id = raft::vnode(model::node_id(1), model::revision_id(i)),
+          .group = raft::group_id(i),
+          .term = model::term_id(i + 10)});
+        replies.push_back(raft::timeout_now_reply{
+          .target_node_id = raft::vnode(
+            model::node_id(1), model::revision_id(i)),
+          .term = model::term_id(i + 10),
+          .result = raft::timeout_now_reply::status::success});
+    }
+
+    raft::multi_timeout_now_request req(requests);
+    auto req_d = serde::from_iobuf<raft::multi_timeout_now_request>(
+      serde::to_iobuf(std::move(req)));
+    BOOST_REQUIRE(
+      req_d == raft::multi_timeout_now_request(std::move(requests)));
+
+    raft::multi_timeout_now_reply reply(replies);
+    auto reply_d = serde::from_iobuf<raft::multi_timeout_now_reply>(
+      serde::to_iobuf(std::move(reply)));
+    BOOST_REQUIRE(
+      reply_d == raft::multi_timeout_now_reply(std::move(replies)));
+}
+
+SEASTAR_THREAD_TEST_CASE(node_lease_roundtrip) {
+    std::vector<raft::lease_group> groups;
+    for (int i = 0; i < 5; ++i) {
+        groups.push_back(raft::lease_group{
+          .group = raft::group_id(i),
+          .term = model::term_id(i + 10),
+          .node_id = raft::vnode(model::node_id(1), model::revision_id(i)),
+          .target_node_id = raft::vnode(
+            model::node_id(2), model::revision_id(i))});
+    }
+    raft::node_lease_request req{
+      .node_id = model::node_id(1),
+      .target_node_id = model::node_id(2),
+      .source_shard = 3,
+      .epoch = 123456,
+      .generation = 7,
+      .groups = groups};
+    auto d = serde::from_iobuf<raft::node_lease_request>(serde::to_iobuf(req));
+    BOOST_REQUIRE(d == req);
+
+    // steady state leases carry no groups
+    req.groups = std::nullopt;
+    d = serde::from_iobuf<raft::node_lease_request>(serde::to_iobuf(req));
+    BOOST_REQUIRE(d == req);
+    BOOST_REQUIRE(!d.groups.has_value());
+
+    auto reply_d = serde::from_iobuf<raft::node_lease_reply>(
+      serde::to_iobuf(raft::node_lease_reply{.renewed = true}));
+    BOOST_REQUIRE(reply_d.renewed);
+}
+
 model::broker create_test_broker() {
     return model::broker(
       model::node_id(random_generators::get_int(1000)), // id
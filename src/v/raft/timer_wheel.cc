@@ -0,0 +1,146 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "raft/timer_wheel.h"
+
+#include "vassert.h"
+
+#include <algorithm>
+
+namespace raft {
+
+void timer_wheel::timer::arm(clock_type::time_point deadline) {
+    vassert(!armed(), "timer is already armed");
+    _deadline = deadline;
+    _wheel.add(*this);
+}
+
+void timer_wheel::timer::rearm(clock_type::time_point deadline) {
+    cancel();
+    arm(deadline);
+}
+
+bool timer_wheel::timer::cancel() {
+    if (!_hook.is_linked()) {
+        return false;
+    }
+    _hook.unlink();
+    --_wheel._armed;
+    return true;
+}
+
+timer_wheel::timer_wheel(clock_type::duration tick)
+  : _tick(tick)
+  , _epoch(clock_type::now()) {
+    _ticker.set_callback([this] { on_tick(); });
+}
+
+timer_wheel::~timer_wheel() {
+    // timers that outlive the wheel must find themselves disarmed
+    for (auto& level : _levels) {
+        for (auto& slot : level) {
+            slot.clear();
+        }
+    }
+}
+
+uint64_t timer_wheel::tick_of(clock_type::time_point tp) const {
+    if (tp <= _epoch) {
+        return 0;
+    }
+    return static_cast<uint64_t>((tp - _epoch) / _tick);
+}
+
+clock_type::time_point timer_wheel::time_of(uint64_t tick) const {
+    return _epoch + _tick * static_cast<clock_type::rep>(tick);
+}
+
+void timer_wheel::add(timer& t) {
+    if (_armed == 0) {
+        // an empty wheel does not follow the clock, nothing to cascade
+        _current_tick = std::max(_current_tick, tick_of(clock_type::now()));
+    }
+    // rounded up, a timer never fires before its deadline
+    auto expiry = tick_of(t._deadline);
+    if (time_of(expiry) < t._deadline) {
+        ++expiry;
+    }
+    t._expiry_tick = std::max(expiry, _current_tick + 1);
+    place(t);
+    ++_armed;
+    if (!_ticker.armed()) {
+        _ticker.arm(time_of(_current_tick + 1));
+    }
+}
+
+void timer_wheel::place(timer& t) {
+    auto at = std::min(t._expiry_tick, _current_tick + span - 1);
+    auto delta = at - _current_tick;
+    size_t level = 0;
+    while (level < levels - 1
+           && delta >= (uint64_t(1) << (slot_bits * (level + 1)))) {
+        ++level;
+    }
+    auto slot = (at >> (slot_bits * level)) & (slots - 1);
+    _levels[level][slot].push_back(t);
+}
+
+void timer_wheel::on_tick() {
+    auto now = tick_of(clock_type::now());
+    // more than one tick to process after a reactor stall
+    while (_current_tick < now && _armed > 0) {
+        advance();
+    }
+    if (_armed == 0) {
+        _ticker.cancel();
+        return;
+    }
+    _ticker.rearm(time_of(_current_tick + 1));
+}
+
+void timer_wheel::advance() {
+    ++_current_tick;
+    // the wheel entered new slots of the upper levels, their timers are
+    // moved down top first, so that they reach the level they belong to
+    size_t top = 0;
+    while (top < levels - 1) {
+        auto mask = (uint64_t(1) << (slot_bits * (top + 1))) - 1;
+        if ((_current_tick & mask) != 0) {
+            break;
+        }
+        ++top;
+    }
+    for (size_t level = top; level > 0; --level) {
+        cascade(level);
+    }
+
+    timer_list expired;
+    expired.splice(expired.end(), _levels[0][_current_tick & (slots - 1)]);
+    while (!expired.empty()) {
+        auto& t = expired.front();
+        expired.pop_front();
+        --_armed;
+        // may re-arm this timer or cancel the ones left in the list
+        t._callback();
+    }
+}
+
+void timer_wheel::cascade(size_t level) {
+    timer_list moved;
+    moved.splice(
+      moved.end(),
+      _levels[level][(_current_tick >> (slot_bits * level)) & (slots - 1)]);
+    while (!moved.empty()) {
+        auto& t = moved.front();
+        moved.pop_front();
+        place(t);
+    }
+}
+
+} // namespace raft
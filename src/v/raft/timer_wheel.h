@@ -0,0 +1,112 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "raft/types.h"
+#include "seastarx.h"
+#include "utils/intrusive_list_helpers.h"
+
+#include <seastar/util/noncopyable_function.hh>
+
+#include <array>
+#include <chrono>
+
+namespace raft {
+
+/**
+ * Hierarchical timer wheel shared by the raft groups of a shard.
+ *
+ * Every raft group keeps an election timer that is re-armed on every
+ * heartbeat, with tens of thousands of groups per shard the seastar timer
+ * heap becomes a measurable share of the reactor time. Timers of the wheel
+ * are kept in intrusive lists, arming and cancelling one is constant time,
+ * and the wheel is driven by a single seastar timer that only ticks while
+ * some of its timers are armed.
+ *
+ * Deadlines are rounded up to the tick, a timer never fires early but may
+ * fire up to one tick late.
+ */
+class timer_wheel {
+public:
+    static constexpr auto default_tick = std::chrono::milliseconds(10);
+
+    class timer {
+    public:
+        using callback_t = ss::noncopyable_function<void()>;
+
+        explicit timer(timer_wheel& w)
+          : _wheel(w) {}
+        timer(const timer&) = delete;
+        timer& operator=(const timer&) = delete;
+        timer(timer&&) = delete;
+        timer& operator=(timer&&) = delete;
+        ~timer() { cancel(); }
+
+        void set_callback(callback_t cb) { _callback = std::move(cb); }
+
+        /// Arm the timer, it must not be armed already
+        void arm(clock_type::time_point deadline);
+        /// Arm the timer, cancelling the previous deadline if any
+        void rearm(clock_type::time_point deadline);
+        /// Returns true if the timer was armed
+        bool cancel();
+
+        bool armed() const { return _hook.is_linked(); }
+        clock_type::time_point get_timeout() const { return _deadline; }
+
+    private:
+        friend class timer_wheel;
+
+        timer_wheel& _wheel;
+        callback_t _callback;
+        clock_type::time_point _deadline;
+        uint64_t _expiry_tick{0};
+        // unlinks itself when the timer is destroyed
+        intrusive_list_hook _hook;
+    };
+
+    explicit timer_wheel(clock_type::duration tick = default_tick);
+    timer_wheel(const timer_wheel&) = delete;
+    timer_wheel& operator=(const timer_wheel&) = delete;
+    ~timer_wheel();
+
+    /// Number of armed timers
+    size_t armed() const { return _armed; }
+
+private:
+    static constexpr size_t slot_bits = 6;
+    static constexpr size_t slots = size_t(1) << slot_bits;
+    static constexpr size_t levels = 4;
+    // ticks covered by the wheel, farther deadlines are placed at its end
+    // and placed again once the wheel gets there
+    static constexpr uint64_t span = uint64_t(1) << (slot_bits * levels);
+
+    using timer_list = intrusive_list<timer, &timer::_hook>;
+    using level_t = std::array<timer_list, slots>;
+
+    void add(timer&);
+    void place(timer&);
+    void on_tick();
+    void advance();
+    void cascade(size_t level);
+    uint64_t tick_of(clock_type::time_point) const;
+    clock_type::time_point time_of(uint64_t tick) const;
+
+    clock_type::duration _tick;
+    clock_type::time_point _epoch;
+    uint64_t _current_tick{0};
+    size_t _armed{0};
+    std::array<level_t, levels> _levels;
+    timer_type _ticker;
+};
+
+} // namespace raft
@@ -110,6 +110,22 @@ void encode_one_delta_array(iobuf& o, const std::vector<T>& v) {
         encode_varint_delta(o, v[i - 1], v[i]);
     }
 }
+/// Same encoding as encode_one_delta_array for a column projected out of
+/// the rows, without copying the column first
+template<typename T, typename Rows, typename Projection>
+void encode_one_delta_column(iobuf& o, const Rows& rows, Projection&& proj) {
+    if (rows.empty()) {
+        return;
+    }
+    T prev = proj(rows.front());
+    encode_one_vint(o, prev);
+    for (auto it = std::next(rows.begin()); it != rows.end(); ++it) {
+        T current = proj(*it);
+        encode_varint_delta(o, prev, current);
+        prev = current;
+    }
+}
+
 template<typename T>
 T read_one_varint_delta(iobuf_parser& in, const T& prev) {
     auto dst = varlong_reader<T>(in);
@@ -178,6 +194,69 @@ std::ostream& operator<<(std::ostream& o, const heartbeat_reply& r) {
     return o << "]}";
 }
 
+std::ostream& operator<<(std::ostream& o, const multi_append_request& r) {
+    o << "{requests:(" << r.requests.size() << ") [";
+    for (auto& req : r.requests) {
+        o << "{group: " << req.meta.group << ", target_node_id: "
+          << req.target_node_id << "},";
+    }
+    return o << "]}";
+}
+
+std::ostream& operator<<(std::ostream& o, const multi_append_reply& r) {
+    o << "{replies:[";
+    for (auto& m : r.replies) {
+        o << m << ",";
+    }
+    return o << "]}";
+}
+
+std::ostream& operator<<(std::ostream& o, const multi_vote_request& r) {
+    o << "{requests:(" << r.requests.size() << ") [";
+    for (auto& req : r.requests) {
+        o << "{group: " << req.group << ", term: " << req.term << "},";
+    }
+    return o << "]}";
+}
+
+std::ostream& operator<<(std::ostream& o, const multi_vote_reply& r) {
+    o << "{replies:[";
+    for (auto& m : r.replies) {
+        o << m << ",";
+    }
+    return o << "]}";
+}
+
+std::ostream& operator<<(std::ostream& o, const lease_group& g) {
+    fmt::print(
+      o,
+      "{{group: {}, term: {}, node_id: {}, target_node_id: {}}}",
+      g.group,
+      g.term,
+      g.node_id,
+      g.target_node_id);
+    return o;
+}
+
+std::ostream& operator<<(std::ostream& o, const node_lease_request& r) {
+    fmt::print(
+      o,
+      "{{node_id: {}, target_node_id: {}, source_shard: {}, epoch: {}, "
+      "generation: {}, groups: {}}}",
+      r.node_id,
+      r.target_node_id,
+      r.source_shard,
+      r.epoch,
+      r.generation,
+      r.groups ? fmt::format("{}", r.groups->size()) : "-");
+    return o;
+}
+
+std::ostream& operator<<(std::ostream& o, const node_lease_reply& r) {
+    fmt::print(o, "{{renewed: {}}}", r.renewed);
+    return o;
+}
+
 std::ostream& operator<<(std::ostream& o, const consistency_level& l) {
     switch (l) {
     case consistency_level::quorum_ack:
@@ -271,56 +350,57 @@ ss::future<> heartbeat_request::serde_async_write(iobuf& dst) {
 
     co_await ss::coroutine::maybe_yield();
 
-    internal::hbeat_soa encodee(request.heartbeats.size());
     // target physical node id is always the same it differs only by
     // revision
-
-    const size_t size = request.heartbeats.size();
-    for (size_t i = 0; i < size; ++i) {
-        const auto& m = request.heartbeats[i].meta;
-        const raft::vnode node = request.heartbeats[i].node_id;
-        const raft::vnode target_node = request.heartbeats[i].target_node_id;
-        vassert(m.group() >= 0, "Negative raft group detected. {}", m.group);
-        encodee.groups[i] = m.group;
-        encodee.commit_indices[i] = std::max(model::offset(-1), m.commit_index);
-        encodee.terms[i] = std::max(model::term_id(-1), m.term);
-        encodee.prev_log_indices[i] = std::max(
-          model::offset(-1), m.prev_log_index);
-        encodee.prev_log_terms[i] = std::max(
-          model::term_id(-1), m.prev_log_term);
-        encodee.last_visible_indices[i] = std::max(
-          model::offset(-1), m.last_visible_index);
-        encodee.revisions[i] = std::max(
-          model::revision_id(-1), node.revision());
-        encodee.target_revisions[i] = std::max(
-          model::revision_id(-1), target_node.revision());
-
-        co_await ss::coroutine::maybe_yield();
-    }
-    // important to release this memory after this function
-    // request.meta = {}; // release memory
+    const auto& hbs = request.heartbeats;
 
     using serde::write;
 
     // physical node ids are the same for all requests
-    write(out, request.heartbeats.front().node_id.id());
-    write(out, request.heartbeats.front().target_node_id.id());
-    write(out, static_cast<uint32_t>(size));
-
-    internal::encode_one_delta_array<raft::group_id>(out, encodee.groups);
-    internal::encode_one_delta_array<model::offset>(
-      out, encodee.commit_indices);
-    internal::encode_one_delta_array<model::term_id>(out, encodee.terms);
-    internal::encode_one_delta_array<model::offset>(
-      out, encodee.prev_log_indices);
-    internal::encode_one_delta_array<model::term_id>(
-      out, encodee.prev_log_terms);
-    internal::encode_one_delta_array<model::offset>(
-      out, encodee.last_visible_indices);
-    internal::encode_one_delta_array<model::revision_id>(
-      out, encodee.revisions);
-    internal::encode_one_delta_array<model::revision_id>(
-      out, encodee.target_revisions);
+    write(out, hbs.front().node_id.id());
+    write(out, hbs.front().target_node_id.id());
+    write(out, static_cast<uint32_t>(hbs.size()));
+
+    // every column is encoded straight from the heartbeats
+    internal::encode_one_delta_column<raft::group_id>(
+      out, hbs, [](const heartbeat_metadata& hb) {
+          vassert(
+            hb.meta.group() >= 0,
+            "Negative raft group detected. {}",
+            hb.meta.group);
+          return hb.meta.group;
+      });
+    internal::encode_one_delta_column<model::offset>(
+      out, hbs, [](const heartbeat_metadata& hb) {
+          return std::max(model::offset(-1), hb.meta.commit_index);
+      });
+    internal::encode_one_delta_column<model::term_id>(
+      out, hbs, [](const heartbeat_metadata& hb) {
+          return std::max(model::term_id(-1), hb.meta.term);
+      });
+    co_await ss::coroutine::maybe_yield();
+    internal::encode_one_delta_column<model::offset>(
+      out, hbs, [](const heartbeat_metadata& hb) {
+          return std::max(model::offset(-1), hb.meta.prev_log_index);
+      });
+    internal::encode_one_delta_column<model::term_id>(
+      out, hbs, [](const heartbeat_metadata& hb) {
+          return std::max(model::term_id(-1), hb.meta.prev_log_term);
+      });
+    internal::encode_one_delta_column<model::offset>(
+      out, hbs, [](const heartbeat_metadata& hb) {
+          return std::max(model::offset(-1), hb.meta.last_visible_index);
+      });
+    co_await ss::coroutine::maybe_yield();
+    internal::encode_one_delta_column<model::revision_id>(
+      out, hbs, [](const heartbeat_metadata& hb) {
+          return std::max(model::revision_id(-1), hb.node_id.revision());
+      });
+    internal::encode_one_delta_column<model::revision_id>(
+      out, hbs, [](const heartbeat_metadata& hb) {
+          return std::max(
+            model::revision_id(-1), hb.target_node_id.revision());
+      });
 
     write(dst, std::move(out));
 }
@@ -573,6 +653,7 @@ ss::future<> append_entries_request::serde_async_write(iobuf& dst) {
     write(out, target_node_id);
     write(out, meta);
     write(out, flush);
+    write(out, trace);
 
     write(dst, std::move(out));
 }
@@ -597,6 +678,28 @@ ss::future<> append_entries_request::serde_async_read(
     meta = read_nested<raft::protocol_metadata>(in, 0U);
     flush = read_nested<raft::append_entries_request::flush_after_append>(
       in, 0U);
+    if (hdr._version >= 1) {
+        trace = read_nested<trace_id>(in, 0U);
+    }
+}
+
+ss::future<> multi_append_request::serde_async_write(iobuf& out) {
+    serde::write(out, static_cast<serde::serde_size_t>(requests.size()));
+    for (auto& r : requests) {
+        co_await serde::write_async(out, std::move(r));
+    }
+}
+
+ss::future<> multi_append_request::serde_async_read(
+  iobuf_parser& in, const serde::header& hdr) {
+    const auto count = serde::read_nested<serde::serde_size_t>(
+      in, hdr._bytes_left_limit);
+    requests.reserve(count);
+    for (serde::serde_size_t i = 0; i < count; ++i) {
+        requests.push_back(
+          co_await serde::read_async_nested<append_entries_request>(
+            in, hdr._bytes_left_limit));
+    }
 }
 
 } // namespace raft
@@ -22,13 +22,17 @@
 #include "raft/fwd.h"
 #include "raft/group_configuration.h"
 #include "reflection/async_adl.h"
+#include "serde/serde.h"
 #include "utils/named_type.h"
+#include "utils/request_tracer.h"
 
 #include <seastar/core/condition-variable.hh>
 #include <seastar/core/io_priority_class.hh>
+#include <seastar/core/iostream.hh>
 #include <seastar/core/scheduling.hh>
 #include <seastar/net/socket_defs.hh>
 #include <seastar/util/bool_class.hh>
+#include <seastar/util/noncopyable_function.hh>
 
 #include <boost/range/irange.hpp>
 #include <boost/range/join.hpp>
@@ -59,18 +63,11 @@ struct protocol_metadata
 
     friend bool operator==(const protocol_metadata&, const protocol_metadata&)
       = default;
-
-    auto serde_fields() {
-        return std::tie(
-          group,
-          commit_index,
-          term,
-          prev_log_index,
-          prev_log_term,
-          last_visible_index);
-    }
 };
 
+// encoded with a single copy, keep the fields free of padding
+static_assert(serde::is_fixed_layout_envelope_v<protocol_metadata>);
+
 // The sequence used to track the order of follower append entries request
 using follower_req_seq = named_type<uint64_t, struct follower_req_seq_tag>;
 using heartbeats_suppressed = ss::bool_class<struct enable_suppression_tag>;
@@ -151,8 +148,19 @@ struct follower_index_metadata {
     follower_req_seq last_received_seq{0};
     // sequence number of last received successfull append entries request
     follower_req_seq last_successful_received_seq{0};
+    // leader lease: the oldest request whose acknowledgement is awaited and
+    // the time it was created at, and the creation time of the latest
+    // request the follower acknowledged
+    std::optional<follower_req_seq> lease_probe_seq;
+    clock_type::time_point lease_probe_timestamp;
+    clock_type::time_point lease_acked_timestamp
+      = clock_type::time_point::min();
     bool is_learner = true;
     bool is_recovering = false;
+    // snapshot transfer interrupted by a failure, the next recovery resumes
+    // it from the last chunk the follower stored
+    model::offset snapshot_resume_index;
+    size_t snapshot_resume_bytes = 0;
 
     /*
      * When is_recovering is true a fiber may wait for recovery to be signaled
@@ -190,10 +198,16 @@ struct follower_metrics {
     clock_type::time_point last_heartbeat;
     bool is_live;
     bool under_replicated;
+    // adaptive window of append entries requests in flight to the follower
+    uint32_t append_entries_window{0};
+    clock_type::duration append_entries_rtt{0};
 };
 
 struct append_entries_request
-  : serde::envelope<append_entries_request, serde::version<0>> {
+  : serde::envelope<
+      append_entries_request,
+      serde::version<1>,
+      serde::compat_version<0>> {
     using flush_after_append = ss::bool_class<struct flush_after_append_tag>;
 
     /*
@@ -251,13 +265,18 @@ struct append_entries_request
         return _batches.value();
     }
     flush_after_append flush;
+    // trace of a sampled request replicated by this append, only carried by
+    // serde (version 1)
+    trace_id trace;
     static append_entries_request make_foreign(append_entries_request&& req) {
-        return append_entries_request(
+        append_entries_request ret(
           req.node_id,
           req.target_node_id,
           std::move(req.meta),
           model::make_foreign_record_batch_reader(std::move(req.batches())),
           req.flush);
+        ret.trace = req.trace;
+        return ret;
     }
 
     friend std::ostream&
@@ -385,6 +404,110 @@ struct heartbeat_reply : serde::envelope<heartbeat_reply, serde::version<0>> {
     void serde_read(iobuf_parser&, const serde::header&);
 };
 
+/// \brief append_entries requests for many raft groups that are headed to
+/// the same node, sent in a single rpc. The receiver dispatches them to the
+/// right groups and replies with one append_entries_reply per request, in
+/// request order. Only sent once every node supports it.
+struct multi_append_request
+  : serde::envelope<multi_append_request, serde::version<0>> {
+    using rpc_adl_exempt = std::true_type;
+
+    std::vector<append_entries_request> requests;
+
+    multi_append_request() noexcept = default;
+    explicit multi_append_request(std::vector<append_entries_request> requests)
+      : requests(std::move(requests)) {}
+
+    friend std::ostream&
+    operator<<(std::ostream& o, const multi_append_request& r);
+
+    ss::future<> serde_async_write(iobuf& out);
+    ss::future<> serde_async_read(iobuf_parser&, const serde::header&);
+};
+
+struct multi_append_reply
+  : serde::envelope<multi_append_reply, serde::version<0>> {
+    using rpc_adl_exempt = std::true_type;
+
+    std::vector<append_entries_reply> replies;
+
+    multi_append_reply() noexcept = default;
+    explicit multi_append_reply(std::vector<append_entries_reply> replies)
+      : replies(std::move(replies)) {}
+
+    friend std::ostream&
+    operator<<(std::ostream& o, const multi_append_reply& r);
+
+    friend bool operator==(const multi_append_reply&, const multi_append_reply&)
+      = default;
+
+    auto serde_fields() { return std::tie(replies); }
+};
+
+/// \brief an idle raft group that the leader keeps alive with a node lease
+/// instead of sending it heartbeats
+struct lease_group : serde::envelope<lease_group, serde::version<0>> {
+    using rpc_adl_exempt = std::true_type;
+
+    group_id group;
+    model::term_id term;
+    vnode node_id;
+    vnode target_node_id;
+
+    friend std::ostream& operator<<(std::ostream& o, const lease_group& g);
+
+    friend bool operator==(const lease_group&, const lease_group&) = default;
+
+    auto serde_fields() {
+        return std::tie(group, term, node_id, target_node_id);
+    }
+};
+
+/// \brief node level heartbeat of a leader shard, it stands in for the
+/// heartbeats of all the quiescent groups it leads on the target node. The
+/// receiver keeps the list of groups of the latest generation, it is only
+/// sent when it changes or the receiver doesn't hold it.
+struct node_lease_request
+  : serde::envelope<node_lease_request, serde::version<0>> {
+    using rpc_adl_exempt = std::true_type;
+
+    model::node_id node_id;
+    model::node_id target_node_id;
+    uint32_t source_shard{0};
+    // changes every time the leader shard starts
+    uint64_t epoch{0};
+    // changes every time the list of groups changes
+    uint64_t generation{0};
+    std::optional<std::vector<lease_group>> groups;
+
+    friend std::ostream&
+    operator<<(std::ostream& o, const node_lease_request& r);
+
+    friend bool operator==(const node_lease_request&, const node_lease_request&)
+      = default;
+
+    auto serde_fields() {
+        return std::tie(
+          node_id, target_node_id, source_shard, epoch, generation, groups);
+    }
+};
+
+struct node_lease_reply
+  : serde::envelope<node_lease_reply, serde::version<0>> {
+    using rpc_adl_exempt = std::true_type;
+
+    // set if the groups of the request generation were renewed, the leader
+    // resends the groups otherwise
+    bool renewed{false};
+
+    friend std::ostream& operator<<(std::ostream& o, const node_lease_reply& r);
+
+    friend bool operator==(const node_lease_reply&, const node_lease_reply&)
+      = default;
+
+    auto serde_fields() { return std::tie(renewed); }
+};
+
 struct vote_request : serde::envelope<vote_request, serde::version<0>> {
     vnode node_id;
     // node id to validate on receiver
@@ -441,6 +564,46 @@ struct vote_reply : serde::envelope<vote_reply, serde::version<0>> {
     }
 };
 
+/// \brief vote requests of many raft groups headed to the same node, sent in
+/// a single rpc. Elections of the groups led by a failed node start at about
+/// the same time, bundling them avoids one rpc per group and peer. Replies
+/// come back in request order. Only sent once every node supports it.
+struct multi_vote_request
+  : serde::envelope<multi_vote_request, serde::version<0>> {
+    using rpc_adl_exempt = std::true_type;
+
+    std::vector<vote_request> requests;
+
+    multi_vote_request() noexcept = default;
+    explicit multi_vote_request(std::vector<vote_request> requests)
+      : requests(std::move(requests)) {}
+
+    friend std::ostream&
+    operator<<(std::ostream& o, const multi_vote_request& r);
+
+    friend bool operator==(const multi_vote_request&, const multi_vote_request&)
+      = default;
+
+    auto serde_fields() { return std::tie(requests); }
+};
+
+struct multi_vote_reply : serde::envelope<multi_vote_reply, serde::version<0>> {
+    using rpc_adl_exempt = std::true_type;
+
+    std::vector<vote_reply> replies;
+
+    multi_vote_reply() noexcept = default;
+    explicit multi_vote_reply(std::vector<vote_reply> replies)
+      : replies(std::move(replies)) {}
+
+    friend std::ostream& operator<<(std::ostream& o, const multi_vote_reply& r);
+
+    friend bool operator==(const multi_vote_reply&, const multi_vote_reply&)
+      = default;
+
+    auto serde_fields() { return std::tie(replies); }
+};
+
 /// This structure is used by consensus to notify other systems about group
 /// leadership changes.
 struct leadership_status {
@@ -475,6 +638,8 @@ struct replicate_options {
       : consistency(l) {}
 
     consistency_level consistency;
+    // set if the request is sampled for tracing, see request_tracer
+    trace_id trace;
 };
 
 using offset_translator_delta = named_type<int64_t, struct ot_delta_tag>;
@@ -605,14 +770,26 @@ struct install_snapshot_reply
  * Configuration describing snapshot that is going to be taken at current node.
  */
 struct write_snapshot_cfg {
+    // streams the snapshot content to the snapshot file, large snapshots are
+    // never materialized in memory
+    using data_writer
+      = ss::noncopyable_function<ss::future<>(ss::output_stream<char>&)>;
+
     write_snapshot_cfg(model::offset last_included_index, iobuf data)
       : last_included_index(last_included_index)
-      , data(std::move(data)) {}
+      , write_data(
+          [data = std::move(data)](ss::output_stream<char>& out) mutable {
+              return write_iobuf_to_output_stream(std::move(data), out);
+          }) {}
+
+    write_snapshot_cfg(model::offset last_included_index, data_writer w)
+      : last_included_index(last_included_index)
+      , write_data(std::move(w)) {}
 
     // last applied offset
     model::offset last_included_index;
     // snapshot content
-    iobuf data;
+    data_writer write_data;
 };
 
 struct timeout_now_request
@@ -675,6 +852,56 @@ struct timeout_now_reply
     }
 };
 
+/// \brief timeout_now requests of many raft groups headed to the same node,
+/// sent in a single rpc when leadership is moved away from a node in bulk.
+/// Replies come back in request order.
+struct multi_timeout_now_request
+  : serde::envelope<multi_timeout_now_request, serde::version<0>> {
+    using rpc_adl_exempt = std::true_type;
+
+    std::vector<timeout_now_request> requests;
+
+    multi_timeout_now_request() noexcept = default;
+    explicit multi_timeout_now_request(
+      std::vector<timeout_now_request> requests)
+      : requests(std::move(requests)) {}
+
+    friend bool operator==(
+      const multi_timeout_now_request&, const multi_timeout_now_request&)
+      = default;
+
+    auto serde_fields() { return std::tie(requests); }
+
+    friend std::ostream&
+    operator<<(std::ostream& o, const multi_timeout_now_request& r) {
+        fmt::print(o, "{{requests: {}}}", r.requests.size());
+        return o;
+    }
+};
+
+struct multi_timeout_now_reply
+  : serde::envelope<multi_timeout_now_reply, serde::version<0>> {
+    using rpc_adl_exempt = std::true_type;
+
+    std::vector<timeout_now_reply> replies;
+
+    multi_timeout_now_reply() noexcept = default;
+    explicit multi_timeout_now_reply(std::vector<timeout_now_reply> replies)
+      : replies(std::move(replies)) {}
+
+    friend bool
+    operator==(const multi_timeout_now_reply&, const multi_timeout_now_reply&)
+      = default;
+
+    auto serde_fields() { return std::tie(replies); }
+
+    friend std::ostream&
+    operator<<(std::ostream& o, const multi_timeout_now_reply& r) {
+        fmt::print(o, "{{replies: {}}}", r.replies.size());
+        return o;
+    }
+};
+
 // if not target is specified then the most up-to-date node will be selected
 struct transfer_leadership_request
   : serde::envelope<transfer_leadership_request, serde::version<0>> {
@@ -35,6 +35,8 @@
 #include "cluster/tx_gateway_frontend.h"
 #include "cluster/types.h"
 #include "cluster_config_schema_util.h"
+#include "compression/compression.h"
+#include "compression/zstd_dictionary.h"
 #include "config/configuration.h"
 #include "config/endpoint_tls_config.h"
 #include "finjector/hbadger.h"
@@ -48,6 +50,7 @@
 #include "model/metadata.h"
 #include "model/namespace.h"
 #include "model/record.h"
+#include "model/record_batch_reader.h"
 #include "model/timeout_clock.h"
 #include "net/dns.h"
 #include "raft/types.h"
@@ -65,10 +68,20 @@
 #include "redpanda/admin/api-doc/status.json.h"
 #include "redpanda/admin/api-doc/transaction.json.h"
 #include "redpanda/request_auth.h"
+#include "resource_mgmt/io_priority.h"
+#include "resource_mgmt/memory_groups.h"
 #include "rpc/errc.h"
+#include "storage/disk_log_impl.h"
+#include "storage/parser_utils.h"
 #include "security/scram_algorithm.h"
 #include "security/scram_authenticator.h"
 #include "ssx/metrics.h"
+#include "units.h"
+#include "utils/base64.h"
+#include "utils/request_tracer.h"
+#include "utils/cpu_profiler.h"
+#include "utils/memory_accounting.h"
+#include "utils/stall_tracker.h"
 #include "vlog.h"
 
 #include <seastar/core/coroutine.hh>
@@ -86,8 +99,11 @@
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/lexical_cast/bad_lexical_cast.hpp>
+#include <boost/range/irange.hpp>
 #include <fmt/core.h>
 
+#include <algorithm>
+#include <iterator>
 #include <limits>
 #include <stdexcept>
 #include <system_error>
@@ -1622,6 +1638,33 @@ void admin_server::register_status_routes() {
             {"status", _ready ? "ready" : "booting"}};
           return ss::make_ready_future<ss::json::json_return_type>(status_map);
       });
+
+    register_route_raw<publik>(
+      ss::httpd::status_json::startup,
+      [this](ss::const_req, ss::reply& reply) {
+          json::StringBuffer buf;
+          json::Writer<json::StringBuffer> writer(buf);
+          writer.StartObject();
+          writer.Key("status");
+          writer.String(_ready ? "ready" : "booting");
+          writer.Key("phases");
+          writer.StartArray();
+          for (const auto& p : _startup_phases) {
+              writer.StartObject();
+              writer.Key("name");
+              writer.String(p.name.data(), p.name.size());
+              writer.Key("started_ms");
+              writer.Int64(p.started.count());
+              writer.Key("duration_ms");
+              writer.Int64(p.duration.count());
+              writer.EndObject();
+          }
+          writer.EndArray();
+          writer.EndObject();
+
+          reply.set_status(ss::httpd::reply::status_type::ok, buf.GetString());
+          return "";
+      });
 }
 
 static json::validator make_feature_put_validator() {
@@ -1992,6 +2035,9 @@ void admin_server::register_broker_routes() {
               if (status->failed.has_value()) {
                   res.failed = status->failed.value();
               }
+              res.transferred = co_await _controller->get_drain_manager()
+                                  .local()
+                                  .transferred();
           }
           co_return res;
       });
@@ -2025,54 +2071,150 @@ model::ntp parse_ntp_from_request(ss::httpd::parameters& param) {
     return model::ntp(std::move(ns), std::move(topic), partition);
 }
 
+size_t parse_size_query_param(
+  const ss::httpd::request& req, const ss::sstring& name, size_t def) {
+    auto value = req.get_query_param(name);
+    if (value.empty()) {
+        return def;
+    }
+    try {
+        return boost::lexical_cast<size_t>(value);
+    } catch (const boost::bad_lexical_cast&) {
+        throw ss::httpd::bad_param_exception(
+          fmt::format("Invalid {}: {}", name, value));
+    }
+}
+
+/// Filter and page of a partition listing
+struct partition_listing {
+    ss::sstring ns;
+    ss::sstring topic;
+    size_t offset;
+    size_t limit;
+
+    bool matches(const model::ntp& ntp) const {
+        return (ns.empty() || ntp.ns() == ns)
+               && (topic.empty() || ntp.tp.topic() == topic);
+    }
+};
+
+partition_listing parse_partition_listing(const ss::httpd::request& req) {
+    return partition_listing{
+      .ns = req.get_query_param("namespace"),
+      .topic = req.get_query_param("topic"),
+      .offset = parse_size_query_param(req, "offset", 0),
+      .limit = parse_size_query_param(
+        req, "limit", std::numeric_limits<size_t>::max()),
+    };
+}
+
+struct partition_summary_page {
+    // partitions of the shard that match the filter, including the skipped
+    // ones
+    size_t matching{0};
+    std::vector<ss::httpd::partition_json::partition_summary> summaries;
+};
+
+/*
+ * Only the requested page of the shard is materialized, so that a listing
+ * does not copy the summaries of all the partitions to the shard serving the
+ * request. Partitions are ordered by ntp within a shard to keep the pages
+ * stable across requests.
+ */
+template<typename PartitionManager, typename GetLeader>
+partition_summary_page collect_partition_summaries(
+  const PartitionManager& pm,
+  const partition_listing& listing,
+  size_t skip,
+  size_t limit,
+  bool materialized,
+  GetLeader get_leader) {
+    using entry = typename PartitionManager::ntp_table_container::value_type;
+    std::vector<const entry*> matching;
+    for (const auto& e : pm.partitions()) {
+        if (listing.matches(e.first)) {
+            matching.push_back(&e);
+        }
+    }
+    partition_summary_page page{.matching = matching.size()};
+    if (skip >= matching.size() || limit == 0) {
+        return page;
+    }
+    const auto first = matching.begin() + static_cast<std::ptrdiff_t>(skip);
+    const auto last = first
+                      + static_cast<std::ptrdiff_t>(
+                        std::min(limit, matching.size() - skip));
+    auto by_ntp = [](const entry* a, const entry* b) {
+        return a->first < b->first;
+    };
+    std::nth_element(matching.begin(), first, matching.end(), by_ntp);
+    std::partial_sort(first, last, matching.end(), by_ntp);
+
+    page.summaries.reserve(std::distance(first, last));
+    for (auto it = first; it != last; ++it) {
+        const auto& [ntp, partition] = **it;
+        ss::httpd::partition_json::partition_summary p;
+        p.ns = ntp.ns;
+        p.topic = ntp.tp.topic;
+        p.partition_id = ntp.tp.partition;
+        p.core = ss::this_shard_id();
+        p.materialized = materialized;
+        p.leader = get_leader(partition);
+        page.summaries.push_back(std::move(p));
+    }
+    return page;
+}
+
 } // namespace
 
 void admin_server::register_partition_routes() {
     /*
-     * Get a list of partition summaries.
+     * Get a list of partition summaries, optionally filtered by namespace and
+     * topic and paged with offset and limit. Partitions are listed by core,
+     * materialized partitions last. The response is streamed so that large
+     * listings are not rendered in a single task.
      */
     register_route<user>(
       ss::httpd::partition_json::get_partitions,
-      [this](std::unique_ptr<ss::httpd::request>) {
+      [this](std::unique_ptr<ss::httpd::request> req)
+        -> ss::future<ss::json::json_return_type> {
           using summary = ss::httpd::partition_json::partition_summary;
-          auto get_summaries =
-            [](auto& partition_manager, bool materialized, auto get_leader) {
-                return partition_manager.map_reduce0(
-                  [materialized, get_leader](auto& pm) {
-                      std::vector<summary> partitions;
-                      partitions.reserve(pm.partitions().size());
-                      for (const auto& it : pm.partitions()) {
-                          summary p;
-                          p.ns = it.first.ns;
-                          p.topic = it.first.tp.topic;
-                          p.partition_id = it.first.tp.partition;
-                          p.core = ss::this_shard_id();
-                          p.materialized = materialized;
-                          p.leader = get_leader(it.second);
-                          partitions.push_back(std::move(p));
-                      }
-                      return partitions;
-                  },
-                  std::vector<summary>{},
-                  [](std::vector<summary> acc, std::vector<summary> update) {
-                      acc.insert(acc.end(), update.begin(), update.end());
-                      return acc;
-                  });
-            };
-          auto f1 = get_summaries(_partition_manager, false, [](const auto& p) {
-              return p->get_leader_id().value_or(model::node_id(-1))();
-          });
-          auto f2 = get_summaries(
-            _cp_partition_manager, true, [](const auto&) { return -1; });
-          return ss::when_all_succeed(std::move(f1), std::move(f2))
-            .then([](auto summaries) {
-                auto& [partitions, s2] = summaries;
-                for (auto& s : s2) {
-                    partitions.push_back(std::move(s));
-                }
-                return ss::make_ready_future<ss::json::json_return_type>(
-                  std::move(partitions));
-            });
+          const auto listing = parse_partition_listing(*req);
+
+          std::vector<summary> partitions;
+          size_t skip = listing.offset;
+          size_t remaining = listing.limit;
+          auto append = [&](partition_summary_page page) {
+              skip -= std::min(skip, page.matching);
+              remaining -= page.summaries.size();
+              std::move(
+                page.summaries.begin(),
+                page.summaries.end(),
+                std::back_inserter(partitions));
+          };
+
+          for (auto shard : boost::irange<ss::shard_id>(0, ss::smp::count)) {
+              append(co_await _partition_manager.invoke_on(
+                shard, [&listing, skip, remaining](auto& pm) {
+                    return collect_partition_summaries(
+                      pm, listing, skip, remaining, false, [](const auto& p) {
+                          return p->get_leader_id().value_or(
+                            model::node_id(-1))();
+                      });
+                }));
+          }
+          for (auto shard : boost::irange<ss::shard_id>(0, ss::smp::count)) {
+              append(co_await _cp_partition_manager.invoke_on(
+                shard, [&listing, skip, remaining](auto& pm) {
+                    return collect_partition_summaries(
+                      pm, listing, skip, remaining, true, [](const auto&) {
+                          return -1;
+                      });
+                }));
+          }
+
+          co_return ss::json::json_return_type(ss::json::stream_range_as_array(
+            std::move(partitions), [](const summary& s) { return s; }));
       });
 
     /*
@@ -2328,6 +2470,61 @@ void admin_server::register_partition_routes() {
                 co_return ss::json::json_return_type(ss::json::json_void());
             });
       });
+    register_route<user>(
+      ss::httpd::partition_json::get_partition_key,
+      [this](std::unique_ptr<ss::httpd::request> req)
+        -> ss::future<ss::json::json_return_type> {
+          auto ntp = parse_ntp_from_request(req->param);
+          bytes key;
+          try {
+              key = base64_to_bytes(req->get_query_param("key"));
+          } catch (const base64_decoder_exception&) {
+              throw ss::httpd::bad_param_exception(
+                "Key must be base64 encoded");
+          }
+
+          if (need_redirect_to_leader(ntp, _metadata_cache)) {
+              throw co_await redirect_to_leader(*req, ntp);
+          }
+
+          auto shard = _shard_table.local().shard_for(ntp);
+          if (!shard) {
+              throw ss::httpd::not_found_exception(
+                fmt::format("Partition {} not found", ntp));
+          }
+
+          co_return co_await _partition_manager.invoke_on(
+            *shard,
+            [ntp = std::move(ntp), key = std::move(key)](
+              cluster::partition_manager& pm) mutable
+            -> ss::future<ss::json::json_return_type> {
+                auto partition = pm.get(ntp);
+                if (!partition) {
+                    throw ss::httpd::not_found_exception(
+                      fmt::format("Partition {} not found", ntp));
+                }
+                // the log of other topics keeps every record of a key, the
+                // lookup would be a scan of the whole partition
+                if (!partition->get_ntp_config().is_compacted()) {
+                    throw ss::httpd::bad_request_exception(fmt::format(
+                      "Key lookup requires a compacted topic, {} is not",
+                      ntp.tp.topic));
+                }
+                auto res = co_await partition->key_lookup(
+                  std::move(key), kafka_read_priority());
+                if (!res) {
+                    throw ss::httpd::not_found_exception(
+                      fmt::format("Key not found in partition {}", ntp));
+                }
+                ss::httpd::partition_json::partition_key_record ret;
+                ret.offset = res->offset();
+                ret.tombstone = !res->value.has_value();
+                if (res->value) {
+                    ret.value = iobuf_to_base64(*res->value);
+                }
+                co_return ss::json::json_return_type(std::move(ret));
+            });
+      });
     register_route<superuser>(
       ss::httpd::partition_json::cancel_partition_reconfiguration,
       [this](std::unique_ptr<ss::httpd::request> req)
@@ -2782,6 +2979,183 @@ void admin_server::register_transaction_routes() {
       });
 }
 
+namespace {
+struct hot_partition {
+    model::ntp ntp;
+    int64_t append_p99_us{0};
+    int64_t flush_p99_us{0};
+    int64_t read_p99_us{0};
+    uint64_t bytes_rate{0};
+    uint64_t requests_rate{0};
+
+    int64_t max_p99_us() const {
+        return std::max({append_p99_us, flush_p99_us, read_p99_us});
+    }
+};
+
+struct hot_partitions_report {
+    ss::shard_id shard;
+    std::vector<hot_partition> by_latency;
+    std::vector<hot_partition> by_bytes;
+    std::vector<hot_partition> by_requests;
+};
+
+template<typename Key>
+std::vector<hot_partition>
+top_partitions(std::vector<hot_partition> all, size_t limit, Key key) {
+    const auto n = std::min(limit, all.size());
+    std::partial_sort(
+      all.begin(),
+      all.begin() + static_cast<std::ptrdiff_t>(n),
+      all.end(),
+      [&key](const hot_partition& a, const hot_partition& b) {
+          return key(a) > key(b);
+      });
+    all.resize(n);
+    return all;
+}
+
+hot_partitions_report
+collect_hot_partitions(cluster::partition_manager& pm, size_t limit) {
+    std::vector<hot_partition> all;
+    all.reserve(pm.partitions().size());
+    for (const auto& [ntp, p] : pm.partitions()) {
+        hot_partition hp{.ntp = ntp};
+        auto log = p->raft()->log();
+        if (auto dlog = dynamic_cast<storage::disk_log_impl*>(log.get_impl())) {
+            auto& probe = dlog->get_probe();
+            hp.append_p99_us = probe.append_latency().get_value_at(99.0);
+            hp.flush_p99_us = probe.flush_latency().get_value_at(99.0);
+            hp.read_p99_us = probe.read_latency().get_value_at(99.0);
+        }
+        hp.bytes_rate = p->probe().load().bytes_rate();
+        hp.requests_rate = p->probe().load().requests_rate();
+        all.push_back(std::move(hp));
+    }
+    return hot_partitions_report{
+      .shard = ss::this_shard_id(),
+      .by_latency = top_partitions(
+        all, limit, [](const hot_partition& hp) { return hp.max_p99_us(); }),
+      .by_bytes = top_partitions(
+        all, limit, [](const hot_partition& hp) { return hp.bytes_rate; }),
+      .by_requests = top_partitions(
+        all,
+        limit,
+        [](const hot_partition& hp) { return hp.requests_rate; }),
+    };
+}
+
+ss::httpd::debug_json::hot_partition
+to_json(const hot_partition& hp) {
+    ss::httpd::debug_json::hot_partition ret;
+    ret.ns = hp.ntp.ns();
+    ret.topic = hp.ntp.tp.topic();
+    ret.partition_id = hp.ntp.tp.partition();
+    ret.append_p99_us = hp.append_p99_us;
+    ret.flush_p99_us = hp.flush_p99_us;
+    ret.read_p99_us = hp.read_p99_us;
+    ret.bytes_rate = hp.bytes_rate;
+    ret.requests_rate = hp.requests_rate;
+    return ret;
+}
+
+struct shard_trace_event {
+    ss::shard_id shard;
+    request_tracer::event event;
+};
+
+/// Slow traces sampled on all the shards of the node
+ss::future<std::vector<request_tracer::slow_trace>> collect_slow_traces() {
+    std::vector<request_tracer::slow_trace> ret;
+    for (auto shard : boost::irange<ss::shard_id>(0, ss::smp::count)) {
+        auto slow = co_await ss::smp::submit_to(shard, [] {
+            const auto& s = request_tracer::local().slow_traces();
+            return std::vector<request_tracer::slow_trace>(s.begin(), s.end());
+        });
+        std::move(slow.begin(), slow.end(), std::back_inserter(ret));
+    }
+    co_return ret;
+}
+
+/// Events of the traces recorded by any shard of the node, ordered by time
+ss::future<std::vector<shard_trace_event>>
+collect_trace_events(std::vector<trace_id> ids) {
+    std::vector<shard_trace_event> ret;
+    for (auto shard : boost::irange<ss::shard_id>(0, ss::smp::count)) {
+        auto events = co_await ss::smp::submit_to(shard, [&ids] {
+            std::vector<shard_trace_event> events;
+            for (auto id : ids) {
+                for (const auto& e : request_tracer::local().events(id)) {
+                    events.push_back(shard_trace_event{
+                      .shard = ss::this_shard_id(), .event = e});
+                }
+            }
+            return events;
+        });
+        std::move(events.begin(), events.end(), std::back_inserter(ret));
+    }
+    std::sort(
+      ret.begin(),
+      ret.end(),
+      [](const shard_trace_event& a, const shard_trace_event& b) {
+          return a.event.at < b.event.at;
+      });
+    co_return ret;
+}
+
+ss::httpd::debug_json::request_trace to_json(
+  const request_tracer::slow_trace& trace,
+  const std::vector<shard_trace_event>& events) {
+    using namespace std::chrono;
+    ss::httpd::debug_json::request_trace ret;
+    ret.trace_id = trace.id();
+    ret.events._set = true;
+    std::optional<request_tracer::clock_type::time_point> start;
+    std::optional<request_tracer::clock_type::time_point> end;
+    for (const auto& e : events) {
+        if (e.event.id != trace.id) {
+            continue;
+        }
+        if (!start) {
+            start = e.event.at;
+        }
+        end = e.event.at;
+        ss::httpd::debug_json::request_trace_event ev;
+        ev.stage = ss::sstring(to_string_view(e.event.stage));
+        ev.shard = e.shard;
+        ev.offset_us = duration_cast<microseconds>(e.event.at - *start)
+                         .count();
+        ret.events.push(ev);
+    }
+    // traces looked up by id have no recorded duration
+    auto duration = trace.duration;
+    if (duration == request_tracer::clock_type::duration{} && start) {
+        duration = *end - *start;
+    }
+    ret.duration_us = duration_cast<microseconds>(duration).count();
+    return ret;
+}
+
+struct shard_stall_site {
+    ss::shard_id shard;
+    stall_tracker::site_stats stats;
+};
+
+ss::httpd::debug_json::stall_site to_json(const shard_stall_site& s) {
+    using namespace std::chrono;
+    ss::httpd::debug_json::stall_site ret;
+    ret.shard = s.shard;
+    ret.subsystem = ss::sstring(s.stats.site.subsystem);
+    ret.scheduling_group = s.stats.scheduling_group;
+    ret.file = ss::sstring(s.stats.site.file);
+    ret.line = s.stats.site.line;
+    ret.violations = s.stats.violations;
+    ret.total_us = duration_cast<microseconds>(s.stats.total).count();
+    ret.max_us = duration_cast<microseconds>(s.stats.max).count();
+    return ret;
+}
+} // namespace
+
 void admin_server::register_debug_routes() {
     register_route<user>(
       ss::httpd::debug_json::reset_leaders_info,
@@ -2824,6 +3198,333 @@ void admin_server::register_debug_routes() {
 
           co_return ss::json::json_return_type(ans);
       });
+
+    register_route<user>(
+      ss::httpd::debug_json::get_hot_partitions,
+      [this](std::unique_ptr<ss::httpd::request> req)
+        -> ss::future<ss::json::json_return_type> {
+          size_t limit = 10;
+          if (auto l = req->get_query_param("limit"); !l.empty()) {
+              try {
+                  limit = boost::lexical_cast<size_t>(l);
+              } catch (const boost::bad_lexical_cast&) {
+                  throw ss::httpd::bad_param_exception(
+                    fmt::format("Invalid limit: {}", l));
+              }
+          }
+
+          auto reports = co_await _partition_manager.map(
+            [limit](cluster::partition_manager& pm) {
+                return collect_hot_partitions(pm, limit);
+            });
+
+          std::vector<ss::httpd::debug_json::hot_partitions_shard> ans;
+          ans.reserve(reports.size());
+          for (const auto& report : reports) {
+              ss::httpd::debug_json::hot_partitions_shard shard;
+              shard.shard = report.shard;
+              shard.by_latency._set = true;
+              shard.by_bytes._set = true;
+              shard.by_requests._set = true;
+              for (const auto& hp : report.by_latency) {
+                  shard.by_latency.push(to_json(hp));
+              }
+              for (const auto& hp : report.by_bytes) {
+                  shard.by_bytes.push(to_json(hp));
+              }
+              for (const auto& hp : report.by_requests) {
+                  shard.by_requests.push(to_json(hp));
+              }
+              ans.push_back(std::move(shard));
+          }
+
+          co_return ss::json::json_return_type(ans);
+      });
+
+    register_route<user>(
+      ss::httpd::debug_json::get_request_traces,
+      [](std::unique_ptr<ss::httpd::request> req)
+        -> ss::future<ss::json::json_return_type> {
+          std::vector<request_tracer::slow_trace> traces;
+          if (auto id = req->get_query_param("trace_id"); !id.empty()) {
+              try {
+                  traces.push_back(request_tracer::slow_trace{
+                    .id = trace_id(boost::lexical_cast<uint64_t>(id))});
+              } catch (const boost::bad_lexical_cast&) {
+                  throw ss::httpd::bad_param_exception(
+                    fmt::format("Invalid trace_id: {}", id));
+              }
+          } else {
+              traces = co_await collect_slow_traces();
+          }
+
+          std::vector<trace_id> ids;
+          ids.reserve(traces.size());
+          for (const auto& t : traces) {
+              ids.push_back(t.id);
+          }
+          auto events = co_await collect_trace_events(std::move(ids));
+
+          std::vector<ss::httpd::debug_json::request_trace> ans;
+          ans.reserve(traces.size());
+          for (const auto& t : traces) {
+              ans.push_back(to_json(t, events));
+          }
+          co_return ss::json::json_return_type(ans);
+      });
+
+    register_route<user>(
+      ss::httpd::debug_json::get_stalls,
+      [](std::unique_ptr<ss::httpd::request> req)
+        -> ss::future<ss::json::json_return_type> {
+          size_t limit = 10;
+          if (auto l = req->get_query_param("limit"); !l.empty()) {
+              try {
+                  limit = boost::lexical_cast<size_t>(l);
+              } catch (const boost::bad_lexical_cast&) {
+                  throw ss::httpd::bad_param_exception(
+                    fmt::format("Invalid limit: {}", l));
+              }
+          }
+
+          std::vector<shard_stall_site> sites;
+          for (auto shard : boost::irange<ss::shard_id>(0, ss::smp::count)) {
+              auto top = co_await ss::smp::submit_to(shard, [limit] {
+                  return stall_tracker::local().top_sites(limit);
+              });
+              for (auto& stats : top) {
+                  sites.push_back(shard_stall_site{
+                    .shard = shard, .stats = std::move(stats)});
+              }
+          }
+          const auto n = std::min(limit, sites.size());
+          std::partial_sort(
+            sites.begin(),
+            sites.begin() + static_cast<std::ptrdiff_t>(n),
+            sites.end(),
+            [](const shard_stall_site& a, const shard_stall_site& b) {
+                return a.stats.total > b.stats.total;
+            });
+          sites.resize(n);
+
+          std::vector<ss::httpd::debug_json::stall_site> ans;
+          ans.reserve(sites.size());
+          for (const auto& s : sites) {
+              ans.push_back(to_json(s));
+          }
+          co_return ss::json::json_return_type(ans);
+      });
+
+    register_route<user>(
+      ss::httpd::debug_json::get_memory,
+      [](std::unique_ptr<ss::httpd::request>)
+        -> ss::future<ss::json::json_return_type> {
+          using ss::httpd::debug_json::memory_usage;
+          using ss::httpd::debug_json::shard_memory;
+          auto usage = [](std::string_view name, size_t bytes) {
+              memory_usage u;
+              u.name = ss::sstring(name);
+              u.bytes = bytes;
+              return u;
+          };
+
+          std::vector<shard_memory> ans;
+          ans.reserve(ss::smp::count);
+          for (auto shard : boost::irange<ss::shard_id>(0, ss::smp::count)) {
+              ans.push_back(co_await ss::smp::submit_to(shard, [&usage] {
+                  const auto stats = ss::memory::stats();
+                  shard_memory ret;
+                  ret.shard = ss::this_shard_id();
+                  ret.total_memory = stats.total_memory();
+                  ret.allocated_memory = stats.allocated_memory();
+                  ret.free_memory = stats.free_memory();
+                  const auto& accounting = memory_accounting::local();
+                  for (size_t i = 0; i < memory_subsystem_count; ++i) {
+                      auto s = static_cast<memory_subsystem>(i);
+                      ret.subsystems.push(
+                        usage(to_string_view(s), accounting.used(s)));
+                  }
+                  ret.budgets.push(
+                    usage("kafka", memory_groups::kafka_total_memory()));
+                  ret.budgets.push(
+                    usage("rpc", memory_groups::rpc_total_memory()));
+                  ret.budgets.push(usage(
+                    "chunk_cache", memory_groups::chunk_cache_max_memory()));
+                  ret.budgets.push(
+                    usage("recovery", memory_groups::recovery_max_memory()));
+                  return ret;
+              }));
+          }
+          co_return ss::json::json_return_type(ans);
+      });
+
+    register_route<superuser>(
+      ss::httpd::debug_json::start_cpu_profile,
+      [](std::unique_ptr<ss::httpd::request> req)
+        -> ss::future<ss::json::json_return_type> {
+          auto period = cpu_profiler::default_period;
+          size_t capacity = cpu_profiler::default_capacity;
+          try {
+              if (auto p = req->get_query_param("period_ms"); !p.empty()) {
+                  period = std::chrono::milliseconds(
+                    boost::lexical_cast<uint64_t>(p));
+              }
+              if (auto c = req->get_query_param("capacity"); !c.empty()) {
+                  capacity = boost::lexical_cast<size_t>(c);
+              }
+          } catch (const boost::bad_lexical_cast&) {
+              throw ss::httpd::bad_param_exception(
+                "Invalid period_ms or capacity");
+          }
+          if (period < cpu_profiler::min_period || capacity == 0) {
+              throw ss::httpd::bad_param_exception(fmt::format(
+                "period_ms must be at least {} and capacity positive",
+                cpu_profiler::min_period.count()));
+          }
+
+          vlog(
+            logger.info,
+            "Starting the cpu profiler, period: {}ms, capacity: {}",
+            period.count(),
+            capacity);
+          co_await ss::smp::invoke_on_all([period, capacity] {
+              cpu_profiler::local().start(period, capacity);
+          });
+          co_return ss::json::json_void();
+      });
+
+    register_route<superuser>(
+      ss::httpd::debug_json::stop_cpu_profile,
+      [](std::unique_ptr<ss::httpd::request>)
+        -> ss::future<ss::json::json_return_type> {
+          vlog(logger.info, "Stopping the cpu profiler");
+          co_await ss::smp::invoke_on_all(
+            [] { cpu_profiler::local().stop(); });
+          co_return ss::json::json_void();
+      });
+
+    register_route<user>(
+      ss::httpd::debug_json::get_cpu_profile,
+      [](std::unique_ptr<ss::httpd::request> req)
+        -> ss::future<ss::json::json_return_type> {
+          std::optional<ss::shard_id> shard_filter;
+          if (auto s = req->get_query_param("shard"); !s.empty()) {
+              try {
+                  shard_filter = boost::lexical_cast<ss::shard_id>(s);
+              } catch (const boost::bad_lexical_cast&) {
+                  throw ss::httpd::bad_param_exception(
+                    fmt::format("Invalid shard: {}", s));
+              }
+              if (*shard_filter >= ss::smp::count) {
+                  throw ss::httpd::bad_param_exception(
+                    fmt::format("Invalid shard: {}", s));
+              }
+          }
+
+          std::vector<ss::httpd::debug_json::cpu_profile_stack> ans;
+          for (auto shard : boost::irange<ss::shard_id>(0, ss::smp::count)) {
+              if (shard_filter && *shard_filter != shard) {
+                  continue;
+              }
+              auto stacks = co_await ss::smp::submit_to(
+                shard, [] { return cpu_profiler::local().results(); });
+              for (auto& stack : stacks) {
+                  ss::httpd::debug_json::cpu_profile_stack s;
+                  s.shard = shard;
+                  s.scheduling_group = std::move(stack.scheduling_group);
+                  s.stack = std::move(stack.stack);
+                  s.samples = stack.samples;
+                  ans.push_back(std::move(s));
+              }
+          }
+          co_return ss::json::json_return_type(ans);
+      });
+
+    register_route<user>(
+      ss::httpd::debug_json::get_compression_dictionary_estimate,
+      [this](std::unique_ptr<ss::httpd::request> req)
+        -> ss::future<ss::json::json_return_type> {
+          auto ntp = parse_ntp_from_request(req->param);
+          auto records = parse_size_query_param(*req, "records", 10000);
+          auto max_bytes = std::min(
+            parse_size_query_param(*req, "max_bytes", 1_MiB), 16_MiB);
+
+          auto shard = _shard_table.local().shard_for(ntp);
+          if (!shard) {
+              throw ss::httpd::not_found_exception(
+                fmt::format("Partition {} not found", ntp));
+          }
+          co_return co_await _partition_manager.invoke_on(
+            *shard,
+            [ntp = std::move(ntp), records, max_bytes](
+              cluster::partition_manager& pm)
+              -> ss::future<ss::json::json_return_type> {
+                auto partition = pm.get(ntp);
+                if (!partition) {
+                    throw ss::httpd::not_found_exception(
+                      fmt::format("Partition {} not found", ntp));
+                }
+                // the tail of the partition, as it is the most representative
+                // of what is produced now
+                auto end = partition->dirty_offset();
+                auto start = partition->start_offset();
+                if (end() - start() > static_cast<int64_t>(records)) {
+                    start = end - model::offset(records);
+                }
+                auto reader = co_await partition->make_reader(
+                  storage::log_reader_config(
+                    start,
+                    end,
+                    0,
+                    max_bytes,
+                    kafka_read_priority(),
+                    model::record_batch_type::raft_data,
+                    std::nullopt,
+                    std::nullopt));
+                auto batches = co_await model::consume_reader_to_memory(
+                  std::move(reader), model::no_timeout);
+
+                // half of the batches train the dictionary, it is evaluated
+                // on the other half
+                std::vector<iobuf> train;
+                std::vector<iobuf> evaluate;
+                for (auto& b : batches) {
+                    auto u = co_await storage::internal::decompress_batch(
+                      std::move(b));
+                    auto& to = train.size() > evaluate.size() ? evaluate
+                                                              : train;
+                    to.push_back(std::move(u).release_data());
+                }
+
+                size_t uncompressed_bytes = 0;
+                size_t zstd_bytes = 0;
+                for (const auto& b : evaluate) {
+                    uncompressed_bytes += b.size_bytes();
+                    zstd_bytes += compression::compressor::compress(
+                                    b, model::compression::zstd)
+                                    .size_bytes();
+                    co_await ss::coroutine::maybe_yield();
+                }
+                auto dict = compression::zstd_dictionary::train(train);
+                if (!dict) {
+                    throw ss::httpd::bad_request_exception(fmt::format(
+                      "Not enough data in {} to train a dictionary", ntp));
+                }
+                size_t zstd_dictionary_bytes = 0;
+                for (const auto& b : evaluate) {
+                    zstd_dictionary_bytes += dict->compress(b).size_bytes();
+                    co_await ss::coroutine::maybe_yield();
+                }
+
+                ss::httpd::debug_json::compression_dictionary_estimate ret;
+                ret.batches = evaluate.size();
+                ret.uncompressed_bytes = uncompressed_bytes;
+                ret.zstd_bytes = zstd_bytes;
+                ret.zstd_dictionary_bytes = zstd_dictionary_bytes;
+                ret.dictionary_bytes = dict->data().size();
+                co_return ss::json::json_return_type(std::move(ret));
+            });
+      });
 }
 
 void admin_server::register_cluster_routes() {
@@ -2849,6 +3550,7 @@ void admin_server::register_cluster_routes() {
           for (auto& ntp : health_overview.leaderless_partitions) {
               ret.leaderless_partitions.push(fmt::format(
                 "{}/{}/{}", ntp.ns(), ntp.tp.topic(), ntp.tp.partition));
+              co_await ss::coroutine::maybe_yield();
           }
           if (health_overview.controller_id) {
               ret.controller_id = health_overview.controller_id.value();
@@ -2856,7 +3558,10 @@ void admin_server::register_cluster_routes() {
               ret.controller_id = -1;
           }
 
-          co_return ss::json::json_return_type(ret);
+          // during an outage every partition can be leaderless, stream the
+          // body rather than rendering it at once
+          co_return ss::json::json_return_type(
+            ss::json::stream_object(std::move(ret)));
       });
 
     register_route<publik>(
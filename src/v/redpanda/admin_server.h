@@ -15,6 +15,7 @@
 #include "config/endpoint_tls_config.h"
 #include "coproc/partition_manager.h"
 #include "model/metadata.h"
+#include "redpanda/startup_phases.h"
 #include "request_auth.h"
 #include "rpc/connection_cache.h"
 #include "seastarx.h"
@@ -59,6 +60,10 @@ public:
 
     void set_ready() { _ready = true; }
 
+    void add_startup_phase(startup_phases::phase p) {
+        _startup_phases.push_back(std::move(p));
+    }
+
 private:
     enum class auth_level {
         // Unauthenticated endpoint (not a typo, 'public' is a keyword)
@@ -237,5 +242,6 @@ private:
     ss::sharded<rpc::connection_cache>& _connection_cache;
     request_authenticator _auth;
     bool _ready{false};
+    std::vector<startup_phases::phase> _startup_phases;
     ss::sharded<archival::scheduler_service>& _archival_service;
 };
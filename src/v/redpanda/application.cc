@@ -23,6 +23,7 @@
 #include "cluster/metadata_dissemination_service.h"
 #include "cluster/node/local_monitor.h"
 #include "cluster/partition_balancer_rpc_handler.h"
+#include "cluster/partition_leaders_table.h"
 #include "cluster/partition_manager.h"
 #include "cluster/rm_partition_frontend.h"
 #include "cluster/security_frontend.h"
@@ -36,6 +37,7 @@
 #include "config/seed_server.h"
 #include "coproc/api.h"
 #include "coproc/partition_manager.h"
+#include "kafka/client/client.h"
 #include "kafka/client/configuration.h"
 #include "kafka/server/coordinator_ntp_mapper.h"
 #include "kafka/server/group_manager.h"
@@ -57,14 +59,18 @@
 #include "raft/service.h"
 #include "redpanda/admin_server.h"
 #include "resource_mgmt/io_priority.h"
+#include "resource_mgmt/smp_groups_probe.h"
 #include "rpc/simple_protocol.h"
 #include "storage/backlog_controller.h"
 #include "storage/chunk_cache.h"
 #include "storage/compaction_controller.h"
+#include "storage/compaction_throttle.h"
 #include "storage/directories.h"
 #include "syschecks/syschecks.h"
 #include "utils/file_io.h"
 #include "utils/human.h"
+#include "utils/memory_accounting.h"
+#include "utils/stall_tracker.h"
 #include "v8_engine/data_policy_table.h"
 #include "version.h"
 #include "vlog.h"
@@ -75,6 +81,7 @@
 #include <seastar/core/sharded.hh>
 #include <seastar/core/smp.hh>
 #include <seastar/core/thread.hh>
+#include <seastar/core/when_all.hh>
 #include <seastar/json/json_elements.hh>
 #include <seastar/net/tls.hh>
 #include <seastar/util/conversions.hh>
@@ -406,6 +413,29 @@ void application::setup_internal_metrics() {
           sm::description("Redpanda build information"),
           build_labels),
       });
+
+    ss::smp::invoke_on_all([] { stall_tracker::local().setup_metrics(); })
+      .get();
+    _deferred.emplace_back([] {
+        ss::smp::invoke_on_all([] { stall_tracker::local().clear_metrics(); })
+          .get();
+    });
+
+    ss::smp::invoke_on_all([] { memory_accounting::local().setup_metrics(); })
+      .get();
+    _deferred.emplace_back([] {
+        ss::smp::invoke_on_all(
+          [] { memory_accounting::local().clear_metrics(); })
+          .get();
+    });
+
+    ss::smp::invoke_on_all([] { smp_groups_probe::local().setup_metrics(); })
+      .get();
+    _deferred.emplace_back([] {
+        ss::smp::invoke_on_all(
+          [] { smp_groups_probe::local().clear_metrics(); })
+          .get();
+    });
 }
 
 void application::validate_arguments(const po::variables_map& cfg) {
@@ -472,6 +502,7 @@ void application::hydrate_config(const po::variables_map& cfg) {
             _proxy_client_config.emplace(config["pandaproxy_client"]);
         } else {
             set_local_kafka_client_config(_proxy_client_config, config::node());
+            _proxy_client_is_local = true;
         }
         // override pandaparoxy_client.consumer_session_timeout_ms with
         // pandaproxy.consumer_instance_timeout_ms
@@ -491,6 +522,10 @@ void application::hydrate_config(const po::variables_map& cfg) {
         config_printer("schema_registry", *_schema_reg_config);
         config_printer("schema_registry_client", *_schema_reg_client_config);
     }
+    if (cfg.count("io-properties-file")) {
+        _io_properties_file = std::filesystem::path(
+          cfg["io-properties-file"].as<ss::sstring>());
+    }
 }
 
 void application::check_environment() {
@@ -569,6 +604,9 @@ manager_config_from_global_config(scheduling_groups& sgs) {
         .max_size = config::shard_local_cfg().reclaim_max_size(),
         .min_free_memory
         = config::shard_local_cfg().reclaim_batch_cache_min_free(),
+        .policy = config::shard_local_cfg().batch_cache_segmented_lru()
+                    ? storage::batch_cache_policy::segmented_lru
+                    : storage::batch_cache_policy::lru,
       },
       config::shard_local_cfg().readers_cache_eviction_timeout_ms(),
       sgs.compaction_sg());
@@ -653,6 +691,43 @@ make_upload_controller_config(ss::scheduling_group sg) {
       config::shard_local_cfg().cloud_storage_upload_ctrl_max_shares()};
 }
 
+/*
+ * The proxy client talks to this cluster, so it follows the leadership
+ * changes of the partition leaders table instead of learning about them from
+ * failed requests and refreshing its metadata.
+ */
+void application::follow_proxy_client_leaders() {
+    _proxy_client_leader_notifications.resize(ss::smp::count);
+    _proxy_client
+      .invoke_on_all([this](kafka::client::client& client) {
+          _proxy_client_leader_notifications[ss::this_shard_id()]
+            = controller->get_partition_leaders()
+                .local()
+                .register_leadership_changes_notification(
+                  [&client](const cluster::partition_leaders_table::
+                              leadership_changes_t& changes) {
+                      for (const auto& change : changes) {
+                          if (change.ntp.ns == model::kafka_namespace) {
+                              client.update_leader(
+                                change.ntp.tp, change.leader);
+                          }
+                      }
+                  });
+      })
+      .get();
+    // runs before the client is stopped
+    _deferred.emplace_back([this] {
+        _proxy_client
+          .invoke_on_all([this](kafka::client::client&) {
+              controller->get_partition_leaders()
+                .local()
+                .unregister_leadership_changes_notification(
+                  _proxy_client_leader_notifications[ss::this_shard_id()]);
+          })
+          .get();
+    });
+}
+
 // add additional services in here
 void application::wire_up_services() {
     wire_up_redpanda_services();
@@ -661,6 +736,9 @@ void application::wire_up_services() {
           _proxy_client,
           to_yaml(*_proxy_client_config, config::redact_secrets::no))
           .get();
+        if (_proxy_client_is_local) {
+            follow_proxy_client_leaders();
+        }
         construct_service(
           _proxy,
           to_yaml(*_proxy_config, config::redact_secrets::no),
@@ -1131,6 +1209,15 @@ void application::wire_up_redpanda_services() {
 
               c.stream_recv_buf
                 = config::shard_local_cfg().kafka_rpc_server_stream_recv_buf;
+              if (config::shard_local_cfg().kafka_connection_port_placement()) {
+                  // lets clients choose the shard serving their connection
+                  c.load_balancing_algo
+                    = ss::server_socket::load_balancing_algorithm::port;
+              } else {
+                  c.connection_rebalance_interval
+                    = config::shard_local_cfg()
+                        .kafka_connection_rebalance_interval_ms();
+              }
               auto& tls_config = config::node().kafka_api_tls.value();
               for (const auto& ep : config::node().kafka_api()) {
                   ss::shared_ptr<ss::tls::server_credentials> credentails;
@@ -1222,6 +1309,17 @@ application::set_proxy_client_config(ss::sstring name, std::any val) {
       });
 }
 
+ss::future<> application::complete_startup_phase(const ss::sstring& name) {
+    auto phase = _startup_phases.complete(name);
+    vlog(
+      _log.info,
+      "Startup phase {} completed in {}ms",
+      phase.name,
+      phase.duration.count());
+    return _admin.invoke_on_all(
+      [phase](admin_server& admin) { admin.add_startup_phase(phase); });
+}
+
 void application::start(::stop_signal& app_signal) {
     start_redpanda(app_signal);
 
@@ -1250,6 +1348,7 @@ void application::start(::stop_signal& app_signal) {
 }
 
 void application::start_redpanda(::stop_signal& app_signal) {
+    _startup_phases.begin("storage");
     syschecks::systemd_message("Staring storage services").get();
 
     // single instance
@@ -1283,6 +1382,22 @@ void application::start_redpanda(::stop_signal& app_signal) {
       })
       .get();
 
+    if (_io_properties_file) {
+        auto bandwidth = storage::read_iotune_write_bandwidth(
+          *_io_properties_file, config::node().data_directory().path);
+        vlog(
+          _log.info,
+          "Disk write bandwidth from iotune profile {}: {} bytes/s",
+          *_io_properties_file,
+          bandwidth.value_or(0));
+        storage
+          .invoke_on_all([bandwidth](storage::api& sa) {
+              sa.resources().get_compaction_throttle().set_detected_bandwidth(
+                bandwidth);
+          })
+          .get();
+    }
+
     storage.invoke_on_all(&storage::api::start).get();
 
     syschecks::systemd_message("Starting the partition manager").get();
@@ -1298,8 +1413,12 @@ void application::start_redpanda(::stop_signal& app_signal) {
     _group_manager.invoke_on_all(&kafka::group_manager::start).get();
     _co_group_manager.invoke_on_all(&kafka::group_manager::start).get();
 
+    complete_startup_phase("storage").get();
+
+    _startup_phases.begin("controller");
     syschecks::systemd_message("Starting controller").get();
     controller->start().get0();
+    complete_startup_phase("controller").get();
     /**
      * We schedule shutting down controller input and aborting its operation
      * as a first shutdown step. (other services are stopeed in
@@ -1323,6 +1442,7 @@ void application::start_redpanda(::stop_signal& app_signal) {
       .invoke_on_all(&cluster::metadata_dissemination_service::start)
       .get();
 
+    _startup_phases.begin("rpc");
     syschecks::systemd_message("Starting RPC").get();
     _rpc
       .invoke_on_all([this](net::server& s) {
@@ -1365,7 +1485,8 @@ void application::start_redpanda(::stop_signal& app_signal) {
           proto->register_service<cluster::metadata_dissemination_handler>(
             _scheduling_groups.cluster_sg(),
             smp_service_groups.cluster_smp_sg(),
-            std::ref(controller->get_partition_leaders()));
+            std::ref(controller->get_partition_leaders()),
+            std::ref(md_dissemination_service));
 
           proto->register_service<cluster::partition_balancer_rpc_handler>(
             _scheduling_groups.cluster_sg(),
@@ -1387,9 +1508,12 @@ void application::start_redpanda(::stop_signal& app_signal) {
       _log.info,
       "Started RPC server listening at {}",
       config::node().rpc_server());
+    complete_startup_phase("rpc").get();
 
     // After we have started internal RPC listener, we may join
-    // the cluster (if we aren't already a member)
+    // the cluster (if we aren't already a member). Joining happens in the
+    // background, the services below do not need the node to be a member.
+    _startup_phases.begin("cluster_join");
     controller->get_members_manager()
       .invoke_on(
         cluster::members_manager::shard,
@@ -1450,6 +1574,7 @@ void application::start_kafka(::stop_signal& app_signal) {
       .invoke_on_all([this, qdc_config](net::server& s) {
           auto proto = std::make_unique<kafka::protocol>(
             smp_service_groups.kafka_smp_sg(),
+            _scheduling_groups.kafka_recompression_sg(),
             metadata_cache,
             controller->get_topics_frontend(),
             controller->get_config_frontend(),
@@ -1476,7 +1601,23 @@ void application::start_kafka(::stop_signal& app_signal) {
       .local()
       .await_membership(config::node().node_id(), app_signal.abort_source())
       .get();
-    _kafka_server.invoke_on_all(&net::server::start).get();
+    complete_startup_phase("cluster_join").get();
+
+    // The controller log of a node that just joined may still be catching up
+    // with the leader. The Kafka API is started meanwhile: the cluster
+    // configuration was already applied from the join reply and metadata is
+    // served from what the controller has applied so far.
+    _startup_phases.begin("controller_catch_up");
+    auto caught_up = controller->wait_for_catch_up(app_signal.abort_source())
+                       .then([this] {
+                           return complete_startup_phase("controller_catch_up");
+                       });
+    _startup_phases.begin("kafka_api");
+    auto kafka_started = _kafka_server.invoke_on_all(&net::server::start)
+                           .then([this] {
+                               return complete_startup_phase("kafka_api");
+                           });
+    ss::when_all_succeed(std::move(caught_up), std::move(kafka_started)).get();
     // shutdown Kafka server input
     _deferred.emplace_back([this] {
         _kafka_server.invoke_on_all(&net::server::shutdown_input).get();
@@ -29,6 +29,7 @@
 #include "platform/stop_signal.h"
 #include "raft/fwd.h"
 #include "redpanda/admin_server.h"
+#include "redpanda/startup_phases.h"
 #include "resource_mgmt/cpu_scheduling.h"
 #include "resource_mgmt/memory_groups.h"
 #include "resource_mgmt/scheduling_groups_probe.h"
@@ -63,6 +64,7 @@ public:
     void check_environment();
     void configure_admin_server();
     void wire_up_services();
+    void follow_proxy_client_leaders();
     void wire_up_redpanda_services();
     void start(::stop_signal&);
     void start_redpanda(::stop_signal&);
@@ -125,6 +127,9 @@ private:
 
     bool archival_storage_enabled();
 
+    // records the phase and publishes it to the admin API
+    ss::future<> complete_startup_phase(const ss::sstring&);
+
     template<typename Service, typename... Args>
     ss::future<> construct_service(ss::sharded<Service>& s, Args&&... args) {
         auto f = s.start(std::forward<Args>(args)...);
@@ -155,10 +160,13 @@ private:
     std::unique_ptr<ss::app_template> _app;
     cluster::config_manager::preload_result _config_preload;
     std::optional<pandaproxy::rest::configuration> _proxy_config;
+    // seastar --io-properties-file, the iotune profile of the data disk
+    std::optional<std::filesystem::path> _io_properties_file;
     std::optional<kafka::client::configuration> _proxy_client_config;
     std::optional<pandaproxy::schema_registry::configuration>
       _schema_reg_config;
     std::optional<kafka::client::configuration> _schema_reg_client_config;
+    startup_phases _startup_phases;
     scheduling_groups _scheduling_groups;
     scheduling_groups_probe _scheduling_groups_probe;
     ss::logger _log;
@@ -172,6 +180,10 @@ private:
     ss::sharded<net::conn_quota> _kafka_conn_quotas;
     ss::sharded<net::server> _kafka_server;
     ss::sharded<kafka::client::client> _proxy_client;
+    // the proxy client connects to the kafka listeners of this node
+    bool _proxy_client_is_local{false};
+    std::vector<cluster::notification_id_type>
+      _proxy_client_leader_notifications;
     ss::sharded<pandaproxy::rest::proxy> _proxy;
     std::unique_ptr<pandaproxy::schema_registry::api> _schema_registry;
     ss::sharded<storage::compaction_controller> _compaction_controller;
@@ -109,12 +109,7 @@ request_auth_result request_authenticator::do_authenticate(
               "Unauthorized", ss::httpd::reply::status_type::unauthorized);
         } else {
             const auto& cred = cred_opt.value();
-            bool is_valid = (
-              security::scram_sha256::validate_password(
-                password, cred.stored_key(), cred.salt(), cred.iterations())
-              || security::scram_sha512::validate_password(
-                password, cred.stored_key(), cred.salt(), cred.iterations()));
-            if (!is_valid) {
+            if (!validate_password(username, cred, password)) {
                 // User found, password doesn't match
                 vlog(
                   logger.warn,
@@ -149,6 +144,24 @@ request_auth_result request_authenticator::do_authenticate(
     }
 }
 
+bool request_authenticator::validate_password(
+  const security::credential_user& username,
+  const security::scram_credential& cred,
+  const ss::sstring& password) {
+    if (_verified.contains(username, cred, password)) {
+        return true;
+    }
+    bool is_valid = (
+      security::scram_sha256::validate_password(
+        password, cred.stored_key(), cred.salt(), cred.iterations())
+      || security::scram_sha512::validate_password(
+        password, cred.stored_key(), cred.salt(), cred.iterations()));
+    if (is_valid) {
+        _verified.insert(username, cred, password);
+    }
+    return is_valid;
+}
+
 void request_auth_result::require_superuser() {
     _checked = true;
     if (!_superuser) {
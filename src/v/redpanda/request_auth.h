@@ -17,6 +17,7 @@
 #include <seastar/http/request.hh>
 
 #include <security/credential_store.h>
+#include <security/verified_credential_cache.h>
 
 /**
  * Helper for HTTP request handlers that would like to enforce
@@ -94,6 +95,16 @@ private:
       security::credential_store const& cred_store,
       bool require_auth);
 
+    bool validate_password(
+      const security::credential_user&,
+      const security::scram_credential&,
+      const ss::sstring& password);
+
     cluster::controller* _controller{nullptr};
     config::binding<bool> _require_auth;
+
+    // avoids a PBKDF2 derivation for every request of a client
+    static constexpr auto verified_ttl = std::chrono::seconds(60);
+    static constexpr size_t max_verified = 1000;
+    security::verified_credential_cache _verified{verified_ttl, max_verified};
 };
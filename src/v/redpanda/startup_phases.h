@@ -0,0 +1,71 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/sstring.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <chrono>
+#include <vector>
+
+/**
+ * Timings of the phases of the node startup, reported by the admin API to
+ * tell where a node joining the cluster spends its time before it is ready
+ * to serve clients. Phases may overlap, e.g. the controller catches up while
+ * the Kafka API starts.
+ */
+class startup_phases {
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    struct phase {
+        ss::sstring name;
+        // since the startup began
+        std::chrono::milliseconds started;
+        std::chrono::milliseconds duration;
+    };
+
+    startup_phases()
+      : _start(clock_type::now()) {}
+
+    void begin(const ss::sstring& name) {
+        _pending.insert_or_assign(name, clock_type::now());
+    }
+
+    /// Completes a phase, returns its timings
+    phase complete(const ss::sstring& name) {
+        const auto now = clock_type::now();
+        auto started = _start;
+        if (auto it = _pending.find(name); it != _pending.end()) {
+            started = it->second;
+            _pending.erase(it);
+        }
+        return _completed.emplace_back(phase{
+          .name = name,
+          .started = to_ms(started - _start),
+          .duration = to_ms(now - started),
+        });
+    }
+
+    const std::vector<phase>& completed() const { return _completed; }
+
+private:
+    static std::chrono::milliseconds to_ms(clock_type::duration d) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(d);
+    }
+
+    clock_type::time_point _start;
+    absl::flat_hash_map<ss::sstring, clock_type::time_point> _pending;
+    std::vector<phase> _completed;
+};
@@ -88,6 +88,7 @@ public:
         // used by request context builder
         proto = std::make_unique<kafka::protocol>(
           app.smp_service_groups.kafka_smp_sg(),
+          ss::default_scheduling_group(),
           app.metadata_cache,
           app.controller->get_topics_frontend(),
           app.controller->get_config_frontend(),
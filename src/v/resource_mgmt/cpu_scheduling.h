@@ -36,6 +36,8 @@ public:
           "raft_learner_recovery", 50);
         _archival_upload = co_await ss::create_scheduling_group(
           "archival_upload", 100);
+        _kafka_recompression = co_await ss::create_scheduling_group(
+          "kafka_recompression", 100);
     }
 
     ss::future<> destroy_groups() {
@@ -48,6 +50,7 @@ public:
         co_await destroy_scheduling_group(_compaction);
         co_await destroy_scheduling_group(_raft_learner_recovery);
         co_await destroy_scheduling_group(_archival_upload);
+        co_await destroy_scheduling_group(_kafka_recompression);
         co_return;
     }
 
@@ -64,6 +67,9 @@ public:
         return _raft_learner_recovery;
     }
     ss::scheduling_group archival_upload() { return _archival_upload; }
+    ss::scheduling_group kafka_recompression_sg() {
+        return _kafka_recompression;
+    }
 
     std::vector<std::reference_wrapper<const ss::scheduling_group>>
     all_scheduling_groups() const {
@@ -77,7 +83,8 @@ public:
           std::cref(_cache_background_reclaim),
           std::cref(_compaction),
           std::cref(_raft_learner_recovery),
-          std::cref(_archival_upload)};
+          std::cref(_archival_upload),
+          std::cref(_kafka_recompression)};
     }
 
 private:
@@ -92,4 +99,5 @@ private:
     ss::scheduling_group _compaction;
     ss::scheduling_group _raft_learner_recovery;
     ss::scheduling_group _archival_upload;
+    ss::scheduling_group _kafka_recompression;
 };
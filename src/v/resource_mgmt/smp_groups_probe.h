@@ -0,0 +1,169 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "config/configuration.h"
+#include "prometheus/prometheus_sanitize.h"
+#include "seastarx.h"
+#include "utils/hdr_hist.h"
+
+#include <seastar/core/metrics.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/smp.hh>
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string_view>
+
+// the smp service groups created by smp_groups
+enum class smp_group_kind : uint8_t {
+    raft = 0,
+    kafka,
+    cluster,
+    coproc,
+    proxy,
+};
+
+inline constexpr size_t smp_group_kind_count = 5;
+
+inline std::string_view to_string_view(smp_group_kind k) {
+    switch (k) {
+    case smp_group_kind::raft:
+        return "raft";
+    case smp_group_kind::kafka:
+        return "kafka";
+    case smp_group_kind::cluster:
+        return "cluster";
+    case smp_group_kind::coproc:
+        return "coproc";
+    case smp_group_kind::proxy:
+        return "proxy";
+    }
+    return "unknown";
+}
+
+/**
+ * Cross shard requests sent from a shard, per smp service group.
+ *
+ * The wait of a request is the time between its submission and the start of
+ * its execution on the target shard: the time spent blocked on the
+ * max_nonlocal_requests units of its group, in the smp queue and until the
+ * target reactor polled it. None of it shows in the latency of the work the
+ * request carries, so it is accounted separately.
+ */
+class smp_groups_probe {
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    static smp_groups_probe& local() {
+        static thread_local smp_groups_probe probe;
+        return probe;
+    }
+
+    void setup_metrics() {
+        namespace sm = ss::metrics;
+        if (config::shard_local_cfg().disable_metrics()) {
+            return;
+        }
+        std::vector<sm::metric_definition> defs;
+        for (size_t i = 0; i < smp_group_kind_count; ++i) {
+            auto& g = _groups[i];
+            std::vector<sm::label_instance> labels{sm::label("group")(
+              ss::sstring(to_string_view(static_cast<smp_group_kind>(i))))};
+            defs.push_back(sm::make_counter(
+              "requests",
+              [&g] { return g.requests; },
+              sm::description("Cross shard requests sent by the shard"),
+              labels));
+            defs.push_back(sm::make_gauge(
+              "requests_inflight",
+              [&g] { return g.inflight; },
+              sm::description(
+                "Cross shard requests sent by the shard and not completed"),
+              labels));
+            defs.push_back(sm::make_histogram(
+              "wait_us",
+              sm::description(
+                "Time cross shard requests waited before running on the "
+                "target shard"),
+              labels,
+              [&g] { return g.wait.seastar_histogram_logform(); }));
+        }
+        _metrics.add_group(
+          prometheus_sanitize::metrics_name("smp_groups"), defs);
+    }
+
+    void clear_metrics() { _metrics.clear(); }
+
+    void request_started(smp_group_kind k) {
+        auto& g = group(k);
+        ++g.requests;
+        ++g.inflight;
+    }
+
+    void request_finished(smp_group_kind k, clock_type::duration wait) {
+        auto& g = group(k);
+        --g.inflight;
+        g.wait.record(
+          std::chrono::duration_cast<std::chrono::microseconds>(wait).count());
+    }
+
+private:
+    struct group_stats {
+        uint64_t requests{0};
+        uint64_t inflight{0};
+        hdr_hist wait;
+    };
+
+    group_stats& group(smp_group_kind k) {
+        return _groups[static_cast<size_t>(k)];
+    }
+
+    std::array<group_stats, smp_group_kind_count> _groups;
+    ss::metrics::metric_groups _metrics;
+};
+
+/**
+ * sharded::invoke_on accounting the request in the smp_groups_probe of the
+ * source shard when it crosses shards.
+ */
+template<typename Service, typename Func>
+auto measured_invoke_on(
+  ss::sharded<Service>& service,
+  ss::shard_id shard,
+  ss::smp_service_group ssg,
+  smp_group_kind group,
+  Func&& func) {
+    using clock_type = smp_groups_probe::clock_type;
+    if (shard == ss::this_shard_id()) {
+        return service.invoke_on(shard, ssg, std::forward<Func>(func));
+    }
+    // written on the target shard, read back once the request completed
+    auto wait = std::make_unique<clock_type::duration>(0);
+    auto* wait_ptr = wait.get();
+    smp_groups_probe::local().request_started(group);
+    return service
+      .invoke_on(
+        shard,
+        ssg,
+        [func = std::forward<Func>(func),
+         submitted = clock_type::now(),
+         wait_ptr](Service& s) mutable {
+            *wait_ptr = clock_type::now() - submitted;
+            return std::invoke(func, s);
+        })
+      .finally([group, wait = std::move(wait)] {
+          smp_groups_probe::local().request_finished(group, *wait);
+      });
+}
@@ -30,37 +30,64 @@ ss::future<> connection_cache::emplace(
         if (_cache.find(n) != _cache.end()) {
             return;
         }
-        _cache.emplace(
-          n,
-          ss::make_lw_shared<rpc::reconnect_transport>(
-            std::move(c), std::move(backoff_policy)));
+        node_transports transports{.config = c};
+        transports.lanes[0] = ss::make_lw_shared<rpc::reconnect_transport>(
+          std::move(c), std::move(backoff_policy));
+        _cache.emplace(n, std::move(transports));
     });
 }
+
+connection_cache::transport_ptr
+connection_cache::get(model::node_id n, connection_lane lane) {
+    auto& transports = _cache.find(n)->second;
+    auto& t = transports.lanes[static_cast<size_t>(lane)];
+    if (!t) {
+        // labelled by lane, metrics of the data lane keep their labels
+        t = ss::make_lw_shared<rpc::reconnect_transport>(
+          transports.config,
+          make_exponential_backoff_policy<clock_type>(
+            std::chrono::seconds(1), std::chrono::seconds(15)),
+          fmt::format("{}", lane));
+    }
+    return t;
+}
+
 ss::future<> connection_cache::remove(model::node_id n) {
     return _mutex
-      .with([this, n]() -> transport_ptr {
+      .with([this, n]() -> std::optional<node_transports> {
           auto it = _cache.find(n);
           if (it == _cache.end()) {
-              return nullptr;
+              return std::nullopt;
           }
-          auto ptr = it->second;
+          auto transports = std::move(it->second);
           _cache.erase(it);
-          return ptr;
+          return transports;
       })
-      .then([](transport_ptr ptr) {
-          if (!ptr) {
+      .then([](std::optional<node_transports> transports) {
+          if (!transports) {
               return ss::now();
           }
-          return ptr->stop().finally([ptr] {});
+          return stop_lanes(transports->lanes)
+            .finally([transports = std::move(transports)] {});
       });
 }
 
+ss::future<> connection_cache::stop_lanes(
+  std::array<transport_ptr, connection_lanes> lanes) {
+    return ss::parallel_for_each(lanes, [](transport_ptr& t) {
+        if (!t) {
+            return ss::now();
+        }
+        return t->stop().finally([t] {});
+    });
+}
+
 /// \brief closes all client connections
 ss::future<> connection_cache::stop() {
     return _mutex.with([this]() {
         return parallel_for_each(_cache, [](auto& it) {
-            auto& [_, cli] = it;
-            return cli->stop();
+            auto& [_, transports] = it;
+            return stop_lanes(transports.lanes);
         });
         _cache.clear();
         // mark mutex as broken to prevent new connections from being created
@@ -23,6 +23,7 @@
 #include <seastar/core/sharded.hh>
 #include <seastar/core/shared_ptr.hh>
 
+#include <array>
 #include <chrono>
 #include <unordered_map>
 
@@ -31,7 +32,14 @@ class connection_cache final
   : public ss::peering_sharded_service<connection_cache> {
 public:
     using transport_ptr = ss::lw_shared_ptr<rpc::reconnect_transport>;
-    using underlying = std::unordered_map<model::node_id, transport_ptr>;
+
+    /// Transports of a peer, one per connection lane. The data lane is
+    /// created with the peer, the others on their first use.
+    struct node_transports {
+        transport_configuration config;
+        std::array<transport_ptr, connection_lanes> lanes;
+    };
+    using underlying = std::unordered_map<model::node_id, node_transports>;
     using iterator = typename underlying::iterator;
 
     static inline ss::shard_id shard_for(
@@ -44,7 +52,13 @@ public:
     bool contains(model::node_id n) const {
         return _cache.find(n) != _cache.end();
     }
-    transport_ptr get(model::node_id n) const { return _cache.find(n)->second; }
+    /// \brief transport of the data lane of the node
+    transport_ptr get(model::node_id n) const {
+        return _cache.find(n)->second.lanes[0];
+    }
+
+    /// \brief transport of the given lane of the node, created if needed
+    transport_ptr get(model::node_id n, connection_lane);
 
     /// \brief needs to be a future, because mutations may come from different
     /// fibers and they need to be synchronized
@@ -64,20 +78,21 @@ public:
       ss::shard_id src_shard,
       model::node_id node_id,
       clock_type::time_point connection_timeout,
-      Func&& f) {
+      Func&& f,
+      connection_lane lane = connection_lane::data) {
         using ret_t = result_wrap_t<std::invoke_result_t<Func, Protocol>>;
         auto shard = rpc::connection_cache::shard_for(self, src_shard, node_id);
 
         return container().invoke_on(
           shard,
-          [node_id, f = std::forward<Func>(f), connection_timeout](
+          [node_id, f = std::forward<Func>(f), connection_timeout, lane](
             rpc::connection_cache& cache) mutable {
               if (!cache.contains(node_id)) {
                   // No client available
                   return ss::futurize<ret_t>::convert(
                     rpc::make_error_code(errc::missing_node_rpc_client));
               }
-              return cache.get(node_id)
+              return cache.get(node_id, lane)
                 ->get_connected(connection_timeout)
                 .then([f = std::forward<Func>(f)](
                         result<rpc::transport*> transport) mutable {
@@ -98,13 +113,15 @@ public:
       ss::shard_id src_shard,
       model::node_id node_id,
       clock_type::duration connection_timeout,
-      Func&& f) {
+      Func&& f,
+      connection_lane lane = connection_lane::data) {
         return with_node_client<Protocol, Func>(
           self,
           src_shard,
           node_id,
           connection_timeout + clock_type::now(),
-          std::forward<Func>(f));
+          std::forward<Func>(f),
+          lane);
     }
 
     /// If a reconnect_transport is in a backed-off state, reset
@@ -121,12 +138,18 @@ public:
                   // No client available
                   return;
               }
-              auto recon_transport = cache.get(node_id);
-              recon_transport->reset_backoff();
+              for (auto& t : cache._cache.find(node_id)->second.lanes) {
+                  if (t) {
+                      t->reset_backoff();
+                  }
+              }
           });
     }
 
 private:
+    static ss::future<>
+      stop_lanes(std::array<transport_ptr, connection_lanes>);
+
     mutex _mutex; // to add/remove nodes
     underlying _cache;
 };
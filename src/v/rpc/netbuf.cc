@@ -35,7 +35,8 @@ ss::scattered_message<char> netbuf::as_scattered() && {
     if (
       _out.size_bytes() >= _min_compression_bytes
       && rpc::compression_type::zstd == _hdr.compression) {
-        compression::stream_zstd fn;
+        // one compression context per shard, shared by all connections
+        static thread_local compression::stream_zstd fn;
         _out = fn.compress(std::move(_out));
     } else {
         // didn't meet min requirements
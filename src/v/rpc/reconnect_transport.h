@@ -27,8 +27,10 @@ namespace rpc {
 class reconnect_transport {
 public:
     explicit reconnect_transport(
-      rpc::transport_configuration c, backoff_policy backoff_policy)
-      : _transport(std::move(c))
+      rpc::transport_configuration c,
+      backoff_policy backoff_policy,
+      std::optional<ss::sstring> service_name = std::nullopt)
+      : _transport(std::move(c), std::move(service_name))
       , _backoff_policy(std::move(backoff_policy)) {}
 
     bool is_valid() const { return _transport.is_valid(); }
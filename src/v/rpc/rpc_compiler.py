@@ -47,6 +47,7 @@ RPC_TEMPLATE = """
 #include <seastar/core/sleep.hh>
 #include <seastar/core/scheduling.hh>
 
+#include <array>
 #include <functional>
 #include <chrono>
 #include <tuple>
@@ -63,6 +64,13 @@ public:
     static constexpr uint32_t {{method.name}}_method_id = {{method.id}};
     {%- endfor %}
 
+    /// ids of all the methods, used to build the server dispatch table
+    static constexpr std::array<uint32_t, {{methods|length}}> method_ids{
+      {%- for method in methods %}
+      {{method.name}}_method_id{{ "," if not loop.last }}
+      {%- endfor %}
+    };
+
     {{service_name}}_service_base(ss::scheduling_group sc, ss::smp_service_group ssg)
        : _sc(sc), _ssg(ssg) {}
 
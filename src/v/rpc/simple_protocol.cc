@@ -141,13 +141,8 @@ simple_protocol::dispatch_method_once(header h, net::server::resources rs) {
                   return send_reply_skip_payload(ctx, std::move(reply_buf))
                     .then([ctx] { ctx->signal_body_parse(); });
               }
-              auto it = std::find_if(
-                _services.begin(),
-                _services.end(),
-                [method_id](std::unique_ptr<service>& srvc) {
-                    return srvc->method_from_id(method_id) != nullptr;
-                });
-              if (unlikely(it == _services.end())) {
+              auto it = _methods.find(method_id);
+              if (unlikely(it == _methods.end())) {
                   vlog(
                     rpclog.debug,
                     "Received a request for an unknown method {} from {}",
@@ -161,7 +156,7 @@ simple_protocol::dispatch_method_once(header h, net::server::resources rs) {
                     .then([ctx] { ctx->signal_body_parse(); });
               }
 
-              method* m = it->get()->method_from_id(method_id);
+              method* m = it->second;
 
               return m->handle(ctx->res.conn->input(), *ctx)
                 .then_wrapped([ctx, m, l = ctx->res.hist().auto_measure(), rs](
@@ -12,6 +12,9 @@
 #pragma once
 #include "net/server.h"
 #include "rpc/service.h"
+#include "vassert.h"
+
+#include <absl/container/flat_hash_map.h>
 
 #include <concepts>
 
@@ -20,7 +23,14 @@ class simple_protocol final : public net::server::protocol {
 public:
     template<std::derived_from<service> T, typename... Args>
     void register_service(Args&&... args) {
-        _services.push_back(std::make_unique<T>(std::forward<Args>(args)...));
+        auto s = std::make_unique<T>(std::forward<Args>(args)...);
+        for (auto id : T::method_ids) {
+            auto m = s->method_from_id(id);
+            vassert(m != nullptr, "service does not provide method {}", id);
+            // methods of services registered earlier take precedence
+            _methods.emplace(id, m);
+        }
+        _services.push_back(std::move(s));
     }
 
     const char* name() const final {
@@ -38,6 +48,9 @@ private:
     ss::future<> dispatch_method_once(header, net::server::resources);
 
     std::vector<std::unique_ptr<service>> _services;
+    // method id to method of the registered services, looked up once per
+    // request instead of asking every service in turn
+    absl::flat_hash_map<uint32_t, method*> _methods;
 };
 
 } // namespace rpc
@@ -0,0 +1,262 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "random/generators.h"
+#include "rpc/connection_cache.h"
+#include "rpc/test/replication_bench_service.h"
+#include "rpc/test/rpc_integration_fixture.h"
+#include "rpc/types.h"
+#include "units.h"
+#include "utils/hdr_hist.h"
+#include "vassert.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/testing/perf_tests.hh>
+
+#include <boost/range/irange.hpp>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace std::chrono_literals;
+
+/**
+ * Benchmarks of internal RPC under replication-like traffic.
+ *
+ * Every shard acts as a raft leader replicating to a single peer: it keeps a
+ * number of append entries sized requests in flight through the connection
+ * cache, the way raft sends to followers. The server runs on all the shards
+ * too. Each iteration is one round of concurrent requests from every shard.
+ *
+ * On top of the perf_tests per-iteration figures each test reports the
+ * request throughput and the p50/p99/p999 latencies of single requests once
+ * it completes. The churn variants drop and recreate the peer connections
+ * before every round, so that connection setup through the connection cache
+ * and reconnect_transport is part of the measured round.
+ */
+struct replication_bench_params {
+    size_t payload_size;
+    // requests in flight per shard
+    size_t concurrency;
+    rpc::compression_type compression;
+    // reconnect the peer before every round
+    bool churn;
+};
+
+namespace {
+
+struct replication_bench_impl final
+  : replication_bench::replication_bench_service {
+    replication_bench_impl(ss::scheduling_group& sc, ss::smp_service_group& ssg)
+      : replication_bench::replication_bench_service(sc, ssg) {}
+
+    ss::future<replication_bench::append_resp> append_entries(
+      replication_bench::append_req&& r, rpc::streaming_context&) final {
+        return ss::make_ready_future<replication_bench::append_resp>(
+          replication_bench::append_resp{
+            .group = r.group,
+            .last_log_index = r.prev_log_index + 1,
+          });
+    }
+};
+
+/// per shard client state
+struct bench_shard {
+    hdr_hist latency{hdr_hist::us_per_hour, 1, 3};
+    size_t requests{0};
+    size_t bytes{0};
+    int64_t next_index{0};
+    iobuf payload;
+
+    ss::future<> stop() { return ss::now(); }
+
+    const iobuf& get_payload(size_t size) {
+        if (payload.size_bytes() != size) {
+            // compressible, like most of the produced data
+            payload.clear();
+            auto data = random_generators::gen_alphanum_string(size);
+            payload.append(data.data(), data.size());
+        }
+        return payload;
+    }
+};
+
+} // namespace
+
+class replication_bench_fixture : public rpc_sharded_integration_fixture {
+public:
+    static constexpr uint16_t port = 32149;
+    static constexpr size_t min_compression_bytes = 1024;
+    const model::node_id self{0};
+    const model::node_id peer{1};
+
+    replication_bench_fixture()
+      : rpc_sharded_integration_fixture(port) {
+        configure_server();
+        register_service<replication_bench_impl>();
+        start_server();
+        _shards.start().get();
+        _cache.start().get();
+        connect().get();
+    }
+
+    replication_bench_fixture(const replication_bench_fixture&) = delete;
+    replication_bench_fixture& operator=(const replication_bench_fixture&)
+      = delete;
+    replication_bench_fixture(replication_bench_fixture&&) = delete;
+    replication_bench_fixture& operator=(replication_bench_fixture&&) = delete;
+
+    ~replication_bench_fixture() {
+        report();
+        _cache.stop().get();
+        _shards.stop().get();
+        stop_server();
+    }
+
+    ss::future<size_t> run(replication_bench_params p) {
+        _params = p;
+        if (p.churn) {
+            co_await _cache.invoke_on_all(
+              [peer = peer](rpc::connection_cache& c) {
+                  return c.remove(peer);
+              });
+            co_await connect();
+        }
+
+        perf_tests::start_measuring_time();
+        auto start = std::chrono::steady_clock::now();
+        auto n = co_await _shards.map_reduce0(
+          [this, p](bench_shard& s) { return send_round(s, p); },
+          size_t(0),
+          std::plus<>());
+        _elapsed += std::chrono::steady_clock::now() - start;
+        perf_tests::stop_measuring_time();
+        co_return n;
+    }
+
+private:
+    ss::future<> connect() {
+        return _cache.invoke_on_all(
+          [cfg = client_config(), peer = peer](rpc::connection_cache& c) {
+              return c.emplace(
+                peer,
+                cfg,
+                rpc::make_exponential_backoff_policy<rpc::clock_type>(
+                  1ms, 10ms));
+          });
+    }
+
+    ss::future<size_t>
+    send_round(bench_shard& s, replication_bench_params p) {
+        co_await ss::parallel_for_each(
+          boost::irange<size_t>(0, p.concurrency),
+          [this, &s, p](size_t) { return send_one(s, p); });
+        co_return p.concurrency;
+    }
+
+    ss::future<> send_one(bench_shard& s, replication_bench_params p) {
+        replication_bench::append_req req;
+        req.group = ss::this_shard_id();
+        req.term = 1;
+        req.prev_log_index = s.next_index++;
+        req.payload = s.get_payload(p.payload_size).copy();
+
+        auto m = s.latency.auto_measure();
+        auto r = co_await _cache.local()
+                   .with_node_client<
+                     replication_bench::replication_bench_client_protocol>(
+                     self,
+                     ss::this_shard_id(),
+                     peer,
+                     5s,
+                     [req = std::move(req), p](
+                       replication_bench::replication_bench_client_protocol
+                         c) mutable {
+                         return c
+                           .append_entries(
+                             std::move(req),
+                             rpc::client_opts(
+                               rpc::clock_type::now() + 5s,
+                               p.compression,
+                               min_compression_bytes))
+                           .then(&rpc::get_ctx_data<
+                                 replication_bench::append_resp>);
+                     });
+        vassert(
+          r.has_value(), "append entries failed: {}", r.error().message());
+        s.requests += 1;
+        s.bytes += p.payload_size;
+    }
+
+    void report() {
+        if (!_params) {
+            return;
+        }
+        hdr_hist latency{hdr_hist::us_per_hour, 1, 3};
+        size_t requests = 0;
+        size_t bytes = 0;
+        for (auto shard : boost::irange<ss::shard_id>(0, ss::smp::count)) {
+            // the other shards are idle, their histograms can be read here
+            auto* s = _shards
+                        .invoke_on(shard, [](bench_shard& s) { return &s; })
+                        .get0();
+            latency += s->latency;
+            requests += s->requests;
+            bytes += s->bytes;
+        }
+        auto seconds = std::chrono::duration<double>(_elapsed).count();
+        fmt::print(
+          std::cout,
+          "payload: {}b, in flight per shard: {}, compression: {}, churn: {}, "
+          "shards: {} - {:.0f} req/s, {:.2f} MiB/s, latency p50: {}us, p99: "
+          "{}us, p999: {}us\n",
+          _params->payload_size,
+          _params->concurrency,
+          _params->compression == rpc::compression_type::zstd ? "zstd"
+                                                              : "none",
+          _params->churn,
+          ss::smp::count,
+          requests / seconds,
+          bytes / seconds / (1024 * 1024),
+          latency.get_value_at(50.0),
+          latency.get_value_at(99.0),
+          latency.get_value_at(99.9));
+    }
+
+    ss::sharded<bench_shard> _shards;
+    ss::sharded<rpc::connection_cache> _cache;
+    std::optional<replication_bench_params> _params;
+    std::chrono::steady_clock::duration _elapsed{0};
+};
+
+#define REPLICATION_BENCH(name, ...)                                           \
+    PERF_TEST_F(replication_bench_fixture, name) {                             \
+        return run(replication_bench_params{__VA_ARGS__});                     \
+    }
+
+// heartbeat-like, the per request overhead dominates
+REPLICATION_BENCH(128b_x1, 128, 1, rpc::compression_type::none, false)
+REPLICATION_BENCH(128b_x64, 128, 64, rpc::compression_type::none, false)
+
+// typical append entries with a few produced batches
+REPLICATION_BENCH(16k_x1, 16_KiB, 1, rpc::compression_type::none, false)
+REPLICATION_BENCH(16k_x16, 16_KiB, 16, rpc::compression_type::none, false)
+REPLICATION_BENCH(16k_x16_zstd, 16_KiB, 16, rpc::compression_type::zstd, false)
+
+// recovery sized requests, bandwidth bound
+REPLICATION_BENCH(512k_x4, 512_KiB, 4, rpc::compression_type::none, false)
+REPLICATION_BENCH(
+  512k_x4_zstd, 512_KiB, 4, rpc::compression_type::zstd, false)
+
+// connection churn, every round starts with reconnecting
+REPLICATION_BENCH(128b_x64_churn, 128, 64, rpc::compression_type::none, true)
+REPLICATION_BENCH(16k_x16_churn, 16_KiB, 16, rpc::compression_type::none, true)
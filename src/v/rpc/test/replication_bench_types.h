@@ -0,0 +1,46 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "bytes/iobuf.h"
+#include "rpc/parse_utils.h"
+#include "seastarx.h"
+#include "serde/envelope.h"
+#include "serde/serde.h"
+
+#include <cstdint>
+
+namespace replication_bench {
+
+/// stands in for raft::append_entries_request, a small header followed by
+/// the records of the replicated batches
+struct append_req : serde::envelope<append_req, serde::version<0>> {
+    using rpc_adl_exempt = std::true_type;
+    int64_t group{0};
+    int64_t term{0};
+    int64_t prev_log_index{0};
+    iobuf payload;
+
+    auto serde_fields() {
+        return std::tie(group, term, prev_log_index, payload);
+    }
+};
+
+struct append_resp : serde::envelope<append_resp, serde::version<0>> {
+    using rpc_adl_exempt = std::true_type;
+    int64_t group{0};
+    int64_t last_log_index{0};
+
+    auto serde_fields() { return std::tie(group, last_log_index); }
+};
+
+} // namespace replication_bench
@@ -9,6 +9,7 @@
 
 #include "model/timeout_clock.h"
 #include "random/generators.h"
+#include "rpc/connection_cache.h"
 #include "rpc/exceptions.h"
 #include "rpc/parse_utils.h"
 #include "rpc/test/cycling_service.h"
@@ -347,6 +348,57 @@ FIXTURE_TEST(client_muxing, rpc_integration_fixture) {
     BOOST_REQUIRE_EQUAL(echo_resp.value().data.str, "testing..._suffix");
 }
 
+FIXTURE_TEST(connection_cache_lanes, rpc_integration_fixture) {
+    configure_server();
+    register_services();
+    start_server();
+
+    const auto self = model::node_id(0);
+    const auto peer = model::node_id(1);
+    ss::sharded<rpc::connection_cache> cache;
+    cache.start().get();
+    auto stop = ss::defer([&cache] { cache.stop().get(); });
+    cache.local()
+      .emplace(
+        peer,
+        client_config(),
+        rpc::make_exponential_backoff_policy<rpc::clock_type>(
+          std::chrono::seconds(1), std::chrono::seconds(15)))
+      .get();
+
+    for (auto lane :
+         {rpc::connection_lane::data,
+          rpc::connection_lane::control,
+          rpc::connection_lane::bulk}) {
+        auto ret = cache.local()
+                     .with_node_client<echo::echo_client_protocol>(
+                       self,
+                       ss::this_shard_id(),
+                       peer,
+                       rpc::no_timeout,
+                       [lane](echo::echo_client_protocol c) {
+                           return c
+                             .echo(
+                               echo::echo_req{.str = ssx::sformat("{}", lane)},
+                               rpc::client_opts(rpc::no_timeout))
+                             .then(&rpc::get_ctx_data<echo::echo_resp>);
+                       },
+                       lane)
+                     .get0();
+        BOOST_REQUIRE(ret.has_value());
+        BOOST_REQUIRE_EQUAL(ret.value().str, ssx::sformat("{}", lane));
+    }
+
+    // every lane is its own connection, the data lane is the default one
+    auto data = cache.local().get(peer, rpc::connection_lane::data);
+    auto control = cache.local().get(peer, rpc::connection_lane::control);
+    auto bulk = cache.local().get(peer, rpc::connection_lane::bulk);
+    BOOST_REQUIRE(data == cache.local().get(peer));
+    BOOST_REQUIRE(data != control);
+    BOOST_REQUIRE(control != bulk);
+    BOOST_REQUIRE(data != bulk);
+}
+
 FIXTURE_TEST(timeout_test, rpc_integration_fixture) {
     configure_server();
     register_services();
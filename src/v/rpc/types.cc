@@ -74,4 +74,16 @@ std::ostream& operator<<(std::ostream& o, transport_version v) {
     return o;
 }
 
+std::ostream& operator<<(std::ostream& o, connection_lane l) {
+    switch (l) {
+    case connection_lane::data:
+        return o << "data";
+    case connection_lane::control:
+        return o << "control";
+    case connection_lane::bulk:
+        return o << "bulk";
+    }
+    return o << "unknown";
+}
+
 } // namespace rpc
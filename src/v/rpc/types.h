@@ -56,6 +56,20 @@ enum class compression_type : uint8_t {
     max = zstd,
 };
 
+/// Connections to a peer are split in lanes, each lane being its own
+/// connection, so that small latency sensitive requests do not queue behind
+/// large ones on the same stream
+enum class connection_lane : uint8_t {
+    /// default lane, used by requests that do not pick one
+    data = 0,
+    /// heartbeats, votes and other small latency sensitive requests
+    control,
+    /// recovery and snapshots
+    bulk,
+};
+
+inline constexpr size_t connection_lanes = 3;
+
 struct negotiation_frame {
     int8_t version = 0;
     /// \brief 0 - no compression
@@ -161,6 +175,9 @@ struct client_opts {
     clock_type::time_point timeout;
     compression_type compression;
     size_t min_compression_bytes;
+    /// connection lane of the peer the request is sent on, used by the
+    /// callers that go through the connection cache
+    connection_lane lane{connection_lane::data};
     /**
      * Resource protecting semaphore units, those units will be relased after
      * data are sent over the wire and send buffer is released. May be helpful
@@ -304,4 +321,5 @@ struct transport_configuration {
 
 std::ostream& operator<<(std::ostream&, const status&);
 std::ostream& operator<<(std::ostream&, transport_version);
+std::ostream& operator<<(std::ostream&, connection_lane);
 } // namespace rpc
@@ -36,6 +36,7 @@
 #include <seastar/net/dns.hh>
 #include <seastar/net/inet_address.hh>
 #include <seastar/net/tls.hh>
+#include <seastar/util/defer.hh>
 #include <seastar/util/log.hh>
 
 #include <boost/beast/core/error.hpp>
@@ -68,6 +69,8 @@ struct aws_header_values {
     static constexpr boost::beast::string_view user_agent
       = "redpanda.vectorized.io";
     static constexpr boost::beast::string_view text_plain = "text/plain";
+    static constexpr boost::beast::string_view application_xml
+      = "application/xml";
 };
 
 // configuration //
@@ -167,7 +170,10 @@ request_creator::request_creator(
   , _apply_credentials{std::move(apply_credentials)} {}
 
 result<http::client::request_header> request_creator::make_get_object_request(
-  bucket_name const& name, object_key const& key) {
+  bucket_name const& name,
+  object_key const& key,
+  std::optional<byte_range> range,
+  std::optional<ss::sstring> if_none_match) {
     http::client::request_header header{};
     // GET /{object-id} HTTP/1.1
     // Host: {bucket-name}.s3.amazonaws.com
@@ -182,6 +188,17 @@ result<http::client::request_header> request_creator::make_get_object_request(
       boost::beast::http::field::user_agent, aws_header_values::user_agent);
     header.insert(boost::beast::http::field::host, host);
     header.insert(boost::beast::http::field::content_length, "0");
+    if (range) {
+        // Range: bytes={first}-{last}
+        header.insert(
+          boost::beast::http::field::range,
+          fmt::format("bytes={}-{}", range->first, range->last));
+    }
+    if (if_none_match) {
+        // If-None-Match: {etag}
+        header.insert(
+          boost::beast::http::field::if_none_match, *if_none_match);
+    }
     auto ec = _apply_credentials->add_auth(header);
     if (ec) {
         return ec;
@@ -256,6 +273,132 @@ request_creator::make_unsigned_put_object_request(
     return header;
 }
 
+result<http::client::request_header>
+request_creator::make_create_multipart_upload_request(
+  bucket_name const& name,
+  object_key const& key,
+  const std::vector<object_tag>& tags) {
+    // POST /{object-id}?uploads HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    // x-amz-date:{req-datetime}
+    // Authorization:{signature}
+    // x-amz-tagging: {tags}
+    http::client::request_header header{};
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format("/{}?uploads", key().string());
+    header.method(boost::beast::http::verb::post);
+    header.target(target);
+    header.insert(
+      boost::beast::http::field::user_agent, aws_header_values::user_agent);
+    header.insert(boost::beast::http::field::host, host);
+    header.insert(
+      boost::beast::http::field::content_type, aws_header_values::text_plain);
+    header.insert(boost::beast::http::field::content_length, "0");
+
+    if (!tags.empty()) {
+        std::stringstream tstr;
+        for (const auto& [key, val] : tags) {
+            tstr << fmt::format("&{}={}", key, val);
+        }
+        header.insert(aws_header_names::x_amz_tagging, tstr.str().substr(1));
+    }
+
+    auto ec = _apply_credentials->add_auth(header);
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
+result<http::client::request_header>
+request_creator::make_unsigned_upload_part_request(
+  bucket_name const& name,
+  object_key const& key,
+  const ss::sstring& upload_id,
+  int part_number,
+  size_t payload_size_bytes) {
+    // PUT /{object-id}?partNumber={part}&uploadId={upload-id} HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    // x-amz-date:{req-datetime}
+    // Authorization:{signature}
+    // Content-Length: {payload-size}
+    http::client::request_header header{};
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format(
+      "/{}?partNumber={}&uploadId={}", key().string(), part_number, upload_id);
+    header.method(boost::beast::http::verb::put);
+    header.target(target);
+    header.insert(
+      boost::beast::http::field::user_agent, aws_header_values::user_agent);
+    header.insert(boost::beast::http::field::host, host);
+    header.insert(
+      boost::beast::http::field::content_length,
+      std::to_string(payload_size_bytes));
+    auto ec = _apply_credentials->add_auth(header);
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
+result<http::client::request_header>
+request_creator::make_complete_multipart_upload_request(
+  bucket_name const& name,
+  object_key const& key,
+  const ss::sstring& upload_id,
+  size_t payload_size_bytes) {
+    // POST /{object-id}?uploadId={upload-id} HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    // x-amz-date:{req-datetime}
+    // Authorization:{signature}
+    // Content-Length: {payload-size}
+    // <CompleteMultipartUpload>...</CompleteMultipartUpload>
+    http::client::request_header header{};
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format("/{}?uploadId={}", key().string(), upload_id);
+    header.method(boost::beast::http::verb::post);
+    header.target(target);
+    header.insert(
+      boost::beast::http::field::user_agent, aws_header_values::user_agent);
+    header.insert(boost::beast::http::field::host, host);
+    header.insert(
+      boost::beast::http::field::content_type,
+      aws_header_values::application_xml);
+    header.insert(
+      boost::beast::http::field::content_length,
+      std::to_string(payload_size_bytes));
+    auto ec = _apply_credentials->add_auth(header);
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
+result<http::client::request_header>
+request_creator::make_abort_multipart_upload_request(
+  bucket_name const& name,
+  object_key const& key,
+  const ss::sstring& upload_id) {
+    // DELETE /{object-id}?uploadId={upload-id} HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    // x-amz-date:{req-datetime}
+    // Authorization:{signature}
+    http::client::request_header header{};
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format("/{}?uploadId={}", key().string(), upload_id);
+    header.method(boost::beast::http::verb::delete_);
+    header.target(target);
+    header.insert(
+      boost::beast::http::field::user_agent, aws_header_values::user_agent);
+    header.insert(boost::beast::http::field::host, host);
+    header.insert(boost::beast::http::field::content_length, "0");
+    auto ec = _apply_credentials->add_auth(header);
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
 result<http::client::request_header>
 request_creator::make_list_objects_v2_request(
   const bucket_name& name,
@@ -486,22 +629,42 @@ ss::future<> client::shutdown() {
 ss::future<http::client::response_stream_ref> client::get_object(
   bucket_name const& name,
   object_key const& key,
-  const ss::lowres_clock::duration& timeout) {
-    auto header = _requestor.make_get_object_request(name, key);
+  const ss::lowres_clock::duration& timeout,
+  std::optional<byte_range> range,
+  std::optional<ss::sstring> if_none_match) {
+    bool conditional = if_none_match.has_value();
+    auto header = _requestor.make_get_object_request(
+      name, key, range, std::move(if_none_match));
     if (!header) {
         return ss::make_exception_future<http::client::response_stream_ref>(
           std::system_error(header.error()));
     }
     vlog(s3_log.trace, "send https request:\n{}", header.value());
+    auto start = std::chrono::steady_clock::now();
     return _client.request(std::move(header.value()), timeout)
-      .then([](http::client::response_stream_ref&& ref) {
+      .then([this, range, conditional, start](
+              http::client::response_stream_ref&& ref) {
           // here we didn't receive any bytes from the socket and
           // ref->is_header_done() is 'false', we need to prefetch
           // the header first
-          return ref->prefetch_headers().then([ref = std::move(ref)]() mutable {
+          return ref->prefetch_headers().then([this,
+                                               range,
+                                               conditional,
+                                               start,
+                                               ref = std::move(ref)]() mutable {
               vassert(ref->is_header_done(), "Header is not received");
+              _probe->register_get_latency(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - start));
+              const auto expected_status
+                = range ? boost::beast::http::status::partial_content
+                        : boost::beast::http::status::ok;
+              const auto status = ref->get_headers().result();
               if (
-                ref->get_headers().result() != boost::beast::http::status::ok) {
+                status != expected_status
+                && !(
+                  conditional
+                  && status == boost::beast::http::status::not_modified)) {
                   // Got error response, consume the response body and produce
                   // rest api error
                   vlog(
@@ -605,6 +768,131 @@ ss::future<> client::put_object(
       });
 }
 
+ss::future<ss::sstring> client::create_multipart_upload(
+  bucket_name const& name,
+  object_key const& key,
+  const std::vector<object_tag>& tags,
+  const ss::lowres_clock::duration& timeout) {
+    auto header = _requestor.make_create_multipart_upload_request(
+      name, key, tags);
+    if (!header) {
+        throw std::system_error(header.error());
+    }
+    vlog(s3_log.trace, "send https request:\n{}", header.value());
+    auto ref = co_await _client.request(std::move(header.value()), timeout);
+    auto res = co_await drain_response_stream(ref);
+    if (ref->get_headers().result() != boost::beast::http::status::ok) {
+        vlog(s3_log.warn, "S3 replied with error: {}", ref->get_headers());
+        co_return co_await parse_rest_error_response<ss::sstring>(
+          std::move(res));
+    }
+    auto root = iobuf_to_ptree(std::move(res));
+    co_return root.get<ss::sstring>("InitiateMultipartUploadResult.UploadId");
+}
+
+ss::future<ss::sstring> client::upload_part(
+  bucket_name const& name,
+  object_key const& key,
+  const ss::sstring& upload_id,
+  int part_number,
+  size_t payload_size,
+  ss::input_stream<char>&& body,
+  const ss::lowres_clock::duration& timeout) {
+    auto header = _requestor.make_unsigned_upload_part_request(
+      name, key, upload_id, part_number, payload_size);
+    if (!header) {
+        co_await body.close();
+        throw std::system_error(header.error());
+    }
+    vlog(s3_log.trace, "send https request:\n{}", header.value());
+    auto stream = std::move(body);
+    std::exception_ptr err;
+    ss::sstring etag;
+    try {
+        auto ref = co_await _client.request(
+          std::move(header.value()), stream, timeout);
+        auto res = co_await drain_response_stream(ref);
+        if (ref->get_headers().result() != boost::beast::http::status::ok) {
+            vlog(s3_log.warn, "S3 replied with error: {}", ref->get_headers());
+            co_await parse_rest_error_response<>(std::move(res));
+        }
+        auto tag = ref->get_headers().at(boost::beast::http::field::etag);
+        etag = ss::sstring(tag.data(), tag.size());
+    } catch (const rest_error_response& e) {
+        _probe->register_failure(e.code());
+        err = std::current_exception();
+    } catch (...) {
+        err = std::current_exception();
+    }
+    co_await stream.close();
+    if (err) {
+        std::rethrow_exception(err);
+    }
+    co_return etag;
+}
+
+ss::future<> client::complete_multipart_upload(
+  bucket_name const& name,
+  object_key const& key,
+  const ss::sstring& upload_id,
+  const std::vector<completed_part>& parts,
+  const ss::lowres_clock::duration& timeout) {
+    iobuf payload;
+    payload.append(std::string_view("<CompleteMultipartUpload>"));
+    for (const auto& p : parts) {
+        payload.append(ssx::sformat(
+          "<Part><PartNumber>{}</PartNumber><ETag>{}</ETag></Part>",
+          p.part_number,
+          p.etag));
+    }
+    payload.append(std::string_view("</CompleteMultipartUpload>"));
+
+    auto header = _requestor.make_complete_multipart_upload_request(
+      name, key, upload_id, payload.size_bytes());
+    if (!header) {
+        throw std::system_error(header.error());
+    }
+    vlog(s3_log.trace, "send https request:\n{}", header.value());
+    auto body = make_iobuf_input_stream(std::move(payload));
+    auto ref = co_await _client
+                 .request(std::move(header.value()), body, timeout)
+                 .finally([&body] { return body.close(); });
+    auto res = co_await drain_response_stream(ref);
+    if (ref->get_headers().result() != boost::beast::http::status::ok) {
+        vlog(s3_log.warn, "S3 replied with error: {}", ref->get_headers());
+        co_return co_await parse_rest_error_response<>(std::move(res));
+    }
+    // The request can fail after the 200 OK response was sent, in this case
+    // the body contains an error instead of the result.
+    auto root = iobuf_to_ptree(res.copy());
+    if (root.count("Error") != 0) {
+        vlog(s3_log.warn, "S3 failed to complete multipart upload {}", key);
+        co_return co_await parse_rest_error_response<>(std::move(res));
+    }
+}
+
+ss::future<> client::abort_multipart_upload(
+  bucket_name const& name,
+  object_key const& key,
+  const ss::sstring& upload_id,
+  const ss::lowres_clock::duration& timeout) {
+    auto header = _requestor.make_abort_multipart_upload_request(
+      name, key, upload_id);
+    if (!header) {
+        throw std::system_error(header.error());
+    }
+    vlog(s3_log.trace, "send https request:\n{}", header.value());
+    auto ref = co_await _client.request(std::move(header.value()), timeout);
+    auto res = co_await drain_response_stream(ref);
+    auto status = ref->get_headers().result();
+    if (
+      status != boost::beast::http::status::ok
+      && status != boost::beast::http::status::no_content) { // expect 204
+        vlog(s3_log.warn, "S3 replied with error: {}", ref->get_headers());
+        co_return co_await parse_rest_error_response<>(std::move(res));
+    }
+}
+
 ss::future<client::list_bucket_result> client::list_objects_v2(
   const bucket_name& name,
   std::optional<object_key> prefix,
@@ -681,10 +969,14 @@ ss::future<> client::delete_object(
 }
 
 client_pool::client_pool(
-  size_t size, configuration conf, client_pool_overdraft_policy policy)
+  size_t size,
+  configuration conf,
+  client_pool_overdraft_policy policy,
+  client_pool_autoscale autoscale)
   : _max_size(size)
   , _config(std::move(conf))
-  , _policy(policy) {}
+  , _policy(policy)
+  , _autoscale(autoscale) {}
 
 ss::future<> client_pool::stop() {
     _as.request_abort();
@@ -712,15 +1004,19 @@ ss::future<client_pool::client_lease> client_pool::acquire() {
             co_await wait_for_credentials();
         }
 
+        auto start = std::chrono::steady_clock::now();
         while (_pool.empty() && !_gate.is_closed()) {
             if (_policy == client_pool_overdraft_policy::wait_if_empty) {
-                co_await _cvar.wait();
+                co_await wait_for_client();
             } else {
                 auto cl = ss::make_shared<client>(
                   _config, _as, _apply_credentials);
                 _pool.emplace_back(std::move(cl));
             }
         }
+        _config._probe->register_lease_wait(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start));
     } catch (const ss::broken_condition_variable&) {
     }
     if (_gate.is_closed() || _as.abort_requested()) {
@@ -750,8 +1046,40 @@ void client_pool::populate_client_pool() {
     }
 }
 
+ss::future<> client_pool::wait_for_client() {
+    _waiters++;
+    auto decrement = ss::defer([this] { _waiters--; });
+    if (_overdraft >= _autoscale.max_overdraft) {
+        co_await _cvar.wait();
+        co_return;
+    }
+    try {
+        co_await _cvar.wait(_autoscale.wait_threshold);
+    } catch (const ss::condition_variable_timed_out&) {
+        if (_pool.empty() && _overdraft < _autoscale.max_overdraft) {
+            _overdraft++;
+            vlog(
+              s3_log.debug,
+              "Lease wait exceeded {}ms, opening connection on top of the "
+              "pool size, overdraft: {}",
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                _autoscale.wait_threshold)
+                .count(),
+              _overdraft);
+            _config._probe->register_pool_scale_up();
+            _pool.emplace_back(
+              ss::make_shared<client>(_config, _as, _apply_credentials));
+        }
+    }
+}
+
 void client_pool::release(ss::shared_ptr<client> leased) {
-    if (_pool.size() == _max_size) {
+    if (_overdraft > 0 && _waiters == 0) {
+        // Nobody waits for a connection, scale the pool back down
+        _overdraft--;
+        return;
+    }
+    if (_pool.size() >= _max_size + _overdraft) {
         return;
     }
     _pool.emplace_back(std::move(leased));
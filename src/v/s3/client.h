@@ -44,6 +44,12 @@ struct object_tag {
     ss::sstring value;
 };
 
+/// Inclusive range of bytes of an object
+struct byte_range {
+    uint64_t first;
+    uint64_t last;
+};
+
 /// List of default overrides that can be used to workaround issues
 /// that can arise when we want to deal with different S3 API implementations
 /// and different OS issues (like different truststore locations on different
@@ -118,13 +124,68 @@ public:
       size_t payload_size_bytes,
       const std::vector<object_tag>& tags);
 
+    /// \brief Create a 'CreateMultipartUpload' request header
+    ///
+    /// \param name is a bucket that should be used to store new object
+    /// \param key is an object name
+    /// \return initialized and signed http header or error
+    result<http::client::request_header> make_create_multipart_upload_request(
+      bucket_name const& name,
+      object_key const& key,
+      const std::vector<object_tag>& tags);
+
+    /// \brief Create unsigned 'UploadPart' request header
+    ///
+    /// \param name is a bucket that has the upload
+    /// \param key is an object name
+    /// \param upload_id is an id returned by CreateMultipartUpload
+    /// \param part_number is a number of the part, starting from 1
+    /// \param payload_size_bytes is a size of the part in bytes
+    /// \return initialized and signed http header or error
+    result<http::client::request_header> make_unsigned_upload_part_request(
+      bucket_name const& name,
+      object_key const& key,
+      const ss::sstring& upload_id,
+      int part_number,
+      size_t payload_size_bytes);
+
+    /// \brief Create a 'CompleteMultipartUpload' request header
+    ///
+    /// \param name is a bucket that has the upload
+    /// \param key is an object name
+    /// \param upload_id is an id returned by CreateMultipartUpload
+    /// \param payload_size_bytes is a size of the xml body in bytes
+    /// \return initialized and signed http header or error
+    result<http::client::request_header> make_complete_multipart_upload_request(
+      bucket_name const& name,
+      object_key const& key,
+      const ss::sstring& upload_id,
+      size_t payload_size_bytes);
+
+    /// \brief Create an 'AbortMultipartUpload' request header
+    ///
+    /// \param name is a bucket that has the upload
+    /// \param key is an object name
+    /// \param upload_id is an id returned by CreateMultipartUpload
+    /// \return initialized and signed http header or error
+    result<http::client::request_header> make_abort_multipart_upload_request(
+      bucket_name const& name,
+      object_key const& key,
+      const ss::sstring& upload_id);
+
     /// \brief Create a 'GetObject' request header
     ///
     /// \param name is a bucket that has the object
     /// \param key is an object name
+    /// \param range is a range of bytes to read, whole object if not set
+    /// \param if_none_match is the ETag of a version of the object the
+    ///        caller already has, the object is only sent if it changed
     /// \return initialized and signed http header or error
-    result<http::client::request_header>
-    make_get_object_request(bucket_name const& name, object_key const& key);
+    result<http::client::request_header> make_get_object_request(
+      bucket_name const& name,
+      object_key const& key,
+      std::optional<byte_range> range = std::nullopt,
+      std::optional<ss::sstring> if_none_match = std::nullopt);
 
     /// \brief Create a 'HeadObject' request header
     ///
@@ -185,11 +246,17 @@ public:
     ///
     /// \param name is a bucket name
     /// \param key is an object key
+    /// \param range is a range of bytes to download, whole object if not set
+    /// \param if_none_match is the ETag of a version of the object the
+    ///        caller already has. If the object didn't change the response
+    ///        has the 304 Not Modified status and no body.
     /// \return future that gets ready after request was sent
     ss::future<http::client::response_stream_ref> get_object(
       bucket_name const& name,
       object_key const& key,
-      const ss::lowres_clock::duration& timeout);
+      const ss::lowres_clock::duration& timeout,
+      std::optional<byte_range> range = std::nullopt,
+      std::optional<ss::sstring> if_none_match = std::nullopt);
 
     struct head_object_result {
         uint64_t object_size;
@@ -219,6 +286,55 @@ public:
       const std::vector<object_tag>& tags,
       const ss::lowres_clock::duration& timeout);
 
+    /// CreateMultipartUpload request.
+    /// \param name is a bucket name
+    /// \param key is an id of the object
+    /// \return future that returns the id of the new upload
+    ss::future<ss::sstring> create_multipart_upload(
+      bucket_name const& name,
+      object_key const& key,
+      const std::vector<object_tag>& tags,
+      const ss::lowres_clock::duration& timeout);
+
+    /// UploadPart request.
+    /// \param name is a bucket name
+    /// \param key is an id of the object
+    /// \param upload_id is an id returned by create_multipart_upload
+    /// \param part_number is a number of the part, starting from 1
+    /// \param payload_size is a size of the part in bytes
+    /// \param body is an input_stream that can be used to read the part
+    /// \return future that returns the ETag of the uploaded part
+    ss::future<ss::sstring> upload_part(
+      bucket_name const& name,
+      object_key const& key,
+      const ss::sstring& upload_id,
+      int part_number,
+      size_t payload_size,
+      ss::input_stream<char>&& body,
+      const ss::lowres_clock::duration& timeout);
+
+    struct completed_part {
+        int part_number;
+        ss::sstring etag;
+    };
+
+    /// CompleteMultipartUpload request.
+    /// \param parts is a list of all uploaded parts ordered by part number
+    /// \return future that becomes ready when the object is assembled
+    ss::future<> complete_multipart_upload(
+      bucket_name const& name,
+      object_key const& key,
+      const ss::sstring& upload_id,
+      const std::vector<completed_part>& parts,
+      const ss::lowres_clock::duration& timeout);
+
+    /// AbortMultipartUpload request, discards all uploaded parts.
+    ss::future<> abort_multipart_upload(
+      bucket_name const& name,
+      object_key const& key,
+      const ss::sstring& upload_id,
+      const ss::lowres_clock::duration& timeout);
+
     struct list_bucket_item {
         ss::sstring key;
         std::chrono::system_clock::time_point last_modified;
@@ -260,8 +376,22 @@ enum class client_pool_overdraft_policy {
     create_new_if_empty
 };
 
+/// Connection pool scaling parameters, only used with the
+/// client_pool_overdraft_policy::wait_if_empty policy
+struct client_pool_autoscale {
+    /// Max number of connections the pool can open on top of its size
+    size_t max_overdraft{0};
+    /// The pool opens an extra connection when a lease request waits for
+    /// longer than this
+    ss::lowres_clock::duration wait_threshold{0};
+};
+
 /// Connection pool implementation
 /// All connections share the same configuration
+///
+/// With autoscaling enabled the pool grows when lease requests have to wait
+/// for a connection for too long, and shrinks back to its size when a
+/// connection is returned and nobody waits for one.
 class client_pool : public ss::weakly_referencable<client_pool> {
 public:
     using http_client_ptr = ss::shared_ptr<client>;
@@ -274,7 +404,8 @@ public:
       size_t size,
       configuration conf,
       client_pool_overdraft_policy policy
-      = client_pool_overdraft_policy::wait_if_empty);
+      = client_pool_overdraft_policy::wait_if_empty,
+      client_pool_autoscale autoscale = {});
 
     ss::future<> stop();
 
@@ -297,10 +428,17 @@ public:
 
     size_t max_size() const noexcept;
 
+    /// \brief Get number of connections opened on top of max_size
+    size_t overdraft() const noexcept { return _overdraft; }
+
 private:
     void populate_client_pool();
     void release(ss::shared_ptr<client> leased);
 
+    /// Wait until a connection is returned to the pool, or open a new one
+    /// if the wait is longer than the autoscale threshold.
+    ss::future<> wait_for_client();
+
     ///  Wait for credentials to be acquired. Once credentials are acquired,
     ///  based on the policy, optionally wait for client pool to initialize.
     ss::future<> wait_for_credentials();
@@ -308,6 +446,9 @@ private:
     const size_t _max_size;
     configuration _config;
     client_pool_overdraft_policy _policy;
+    client_pool_autoscale _autoscale;
+    size_t _overdraft{0};
+    size_t _waiters{0};
     std::vector<http_client_ptr> _pool;
     ss::condition_variable _cvar;
     ss::abort_source _as;
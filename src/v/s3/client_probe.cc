@@ -106,6 +106,34 @@ client_probe::client_probe(
             "Total number of NoSuchKey errors received from cloud "
             "storage provider"),
           labels),
+        sm::make_counter(
+          "num_pool_scale_ups",
+          [this] { return _total_pool_scale_ups; },
+          sm::description("Total number of connections opened on top of the "
+                          "connection pool size because of long lease waits"),
+          labels),
+        sm::make_counter(
+          "num_hedged_gets",
+          [this] { return _total_hedged_gets; },
+          sm::description("Total number of GET requests duplicated because "
+                          "the original request was slow"),
+          labels),
+        sm::make_counter(
+          "num_hedged_get_wins",
+          [this] { return _total_hedged_get_wins; },
+          sm::description("Total number of duplicated GET requests that "
+                          "replied before the original request"),
+          labels),
+        sm::make_histogram(
+          "lease_wait_us",
+          [this] { return _lease_wait.seastar_histogram_logform(); },
+          sm::description("Time spent waiting for a connection from the pool"),
+          labels),
+        sm::make_histogram(
+          "get_latency_us",
+          [this] { return _get_latency.seastar_histogram_logform(); },
+          sm::description("Time to the response headers of GET requests"),
+          labels),
       });
 }
 
@@ -14,9 +14,11 @@
 #include "model/fundamental.h"
 #include "net/types.h"
 #include "s3/error.h"
+#include "utils/hdr_hist.h"
 
 #include <seastar/core/metrics_registration.hh>
 
+#include <chrono>
 #include <cstdint>
 
 namespace s3 {
@@ -47,6 +49,35 @@ public:
     /// Register S3 rpc error
     void register_failure(s3_error_code err);
 
+    /// Register time spent waiting for a connection from the pool
+    void register_lease_wait(std::chrono::microseconds wait) {
+        _lease_wait.record(wait.count());
+    }
+
+    /// Register time to the response headers of a GET request
+    void register_get_latency(std::chrono::microseconds latency) {
+        _get_latency.record(latency.count());
+        _get_latency_samples++;
+    }
+
+    /// Number of GET requests in the latency histogram
+    uint64_t get_latency_samples() const { return _get_latency_samples; }
+
+    /// GET latency at the percentile
+    std::chrono::microseconds get_latency_at(double percentile) const {
+        return std::chrono::microseconds(
+          _get_latency.get_value_at(percentile));
+    }
+
+    /// Register connection opened by the pool on top of its size
+    void register_pool_scale_up() { _total_pool_scale_ups++; }
+
+    /// Register GET request duplicated because the original was slow
+    void register_hedged_get() { _total_hedged_gets++; }
+
+    /// Register hedged GET request that replied before the original
+    void register_hedged_get_win() { _total_hedged_get_wins++; }
+
 private:
     /// Total number of rpc errors
     uint64_t _total_rpc_errors;
@@ -54,6 +85,17 @@ private:
     uint64_t _total_slowdowns;
     /// Total number of NoSuchKey responses
     uint64_t _total_nosuchkeys;
+    /// Total number of connections opened on top of the pool size
+    uint64_t _total_pool_scale_ups{0};
+    /// Total number of hedged GET requests
+    uint64_t _total_hedged_gets{0};
+    /// Total number of hedged GET requests that won
+    uint64_t _total_hedged_get_wins{0};
+    /// Time spent waiting for a connection from the pool
+    hdr_hist _lease_wait;
+    /// Time to the response headers of GET requests
+    hdr_hist _get_latency;
+    uint64_t _get_latency_samples{0};
     ss::metrics::metric_groups _metrics;
 };
 
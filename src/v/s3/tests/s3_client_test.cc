@@ -526,3 +526,41 @@ SEASTAR_TEST_CASE(test_client_pool_reconnect) {
         server->stop().get();
     });
 }
+
+SEASTAR_TEST_CASE(test_client_pool_autoscale) {
+    return ss::async([] {
+        using namespace std::chrono_literals;
+        auto conf = transport_configuration();
+        auto pool = ss::make_shared<s3::client_pool>(
+          1,
+          conf,
+          s3::client_pool_overdraft_policy::wait_if_empty,
+          s3::client_pool_autoscale{.max_overdraft = 1, .wait_threshold = 10ms});
+        pool->load_credentials(cloud_roles::aws_credentials{
+          conf.access_key.value(),
+          conf.secret_key.value(),
+          std::nullopt,
+          conf.region});
+
+        auto first = pool->acquire().get0();
+        // the pool is empty, the lease opens a connection after the wait
+        auto second = pool->acquire().get0();
+        BOOST_REQUIRE_EQUAL(pool->overdraft(), 1);
+
+        // the overdraft is used up, the lease has to wait for a release
+        auto third = pool->acquire();
+        ss::sleep(50ms).get();
+        BOOST_REQUIRE(!third.available());
+        first.deleter = ss::deleter();
+        auto third_lease = third.get0();
+        BOOST_REQUIRE_EQUAL(pool->overdraft(), 1);
+
+        // nobody waits, the pool shrinks back to its size
+        second.deleter = ss::deleter();
+        BOOST_REQUIRE_EQUAL(pool->overdraft(), 0);
+        BOOST_REQUIRE_EQUAL(pool->size(), 0);
+        third_lease.deleter = ss::deleter();
+        BOOST_REQUIRE_EQUAL(pool->size(), 1);
+        pool->stop().get();
+    });
+}
@@ -100,21 +100,16 @@ acl_store::find(resource_type resource, const ss::sstring& name) const {
         literals = it->second;
     }
 
-    /*
-     * the acls are sorted within (resource-type, pattern-type) bounds by name
-     * in reverse order so longer names (prefixes) appear first.
-     */
     std::vector<acl_matches::entry_set_ref> prefixes;
-    {
-        auto it = _acls.lower_bound(
-          resource_pattern(resource, name, pattern_type::prefixed));
-
-        auto end = _acls.upper_bound(resource_pattern(
-          resource, name.substr(0, 1), pattern_type::prefixed));
-
-        for (; it != end; ++it) {
-            if (std::string_view(name).starts_with(it->first.name())) {
-                prefixes.emplace_back(it->second);
+    if (auto lengths = _prefix_lengths.find(resource);
+        lengths != _prefix_lengths.end()) {
+        // an empty prefix only matches an empty name
+        auto it = lengths->second.lower_bound(name.empty() ? 0 : 1);
+        for (; it != lengths->second.end() && *it <= name.size(); ++it) {
+            const auto match = _acls.find(resource_pattern(
+              resource, name.substr(0, *it), pattern_type::prefixed));
+            if (match != _acls.end()) {
+                prefixes.emplace_back(match->second);
             }
         }
     }
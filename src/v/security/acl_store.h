@@ -12,6 +12,8 @@
 #include "security/acl.h"
 
 #include <absl/container/btree_map.h>
+#include <absl/container/btree_set.h>
+#include <absl/container/flat_hash_map.h>
 #include <absl/container/flat_hash_set.h>
 
 namespace security {
@@ -117,9 +119,15 @@ public:
 
     void add_bindings(const std::vector<acl_binding>& bindings) {
         for (auto& binding : bindings) {
-            auto& entries = _acls[binding.pattern()];
-            entries.insert(binding.entry());
-            entries.rehash();
+            auto [it, inserted] = _acls.try_emplace(binding.pattern());
+            if (
+              inserted
+              && binding.pattern().pattern() == pattern_type::prefixed) {
+                _prefix_lengths[binding.pattern().resource()].insert(
+                  binding.pattern().name().size());
+            }
+            it->second.insert(binding.entry());
+            it->second.rehash();
         }
     }
 
@@ -155,6 +163,15 @@ private:
 
     absl::btree_map<resource_pattern, acl_entry_set, resource_pattern_compare>
       _acls;
+
+    /*
+     * the distinct name lengths of the prefixed patterns of each resource
+     * type. a name is matched against the prefixed patterns by looking up its
+     * own prefixes of these lengths rather than by scanning all the prefixed
+     * patterns sharing its first character.
+     */
+    absl::flat_hash_map<resource_type, absl::btree_set<size_t>>
+      _prefix_lengths;
 };
 
 } // namespace security
@@ -21,6 +21,7 @@
 #include <seastar/core/sstring.hh>
 #include <seastar/util/bool_class.hh>
 
+#include <absl/container/flat_hash_map.h>
 #include <absl/container/flat_hash_set.h>
 #include <fmt/core.h>
 
@@ -36,12 +37,21 @@ namespace security {
  * perform any operation. When authorization occurs if the assocaited principal
  * is found in the set of superusers then its request will be permitted. If the
  * principal is not a superuser then normal ACL authorization applies.
+ *
+ * decision cache
+ * ==============
+ *
+ * The outcome of ACL authorization is cached by principal, host, operation and
+ * resource. The cache is invalidated whenever the ACL bindings change and is
+ * reset when it grows beyond `max_cached_decisions`.
  */
 class authorizer final {
 public:
     // allow operation when no ACL match is found
     using allow_empty_matches = ss::bool_class<struct allow_empty_matches_type>;
 
+    static constexpr size_t max_cached_decisions = 10000;
+
     explicit authorizer(
       std::function<config::binding<std::vector<ss::sstring>>()> superusers_cb)
       : authorizer(allow_empty_matches::no, superusers_cb) {}
@@ -67,6 +77,7 @@ public:
             }
         }
         _store.add_bindings(bindings);
+        _decisions.clear();
     }
 
     /*
@@ -74,6 +85,9 @@ public:
      */
     std::vector<std::vector<acl_binding>> remove_bindings(
       const std::vector<acl_binding_filter>& filters, bool dry_run = false) {
+        if (!dry_run) {
+            _decisions.clear();
+        }
         return _store.remove_bindings(filters, dry_run);
     }
 
@@ -94,24 +108,72 @@ public:
       acl_operation operation,
       const acl_principal& principal,
       const acl_host& host) const {
-        auto type = get_resource_type<T>();
-        auto acls = _store.find(type, resource_name());
-
         if (_superusers.contains(principal)) {
             return true;
         }
 
+        decision_key key{
+          .principal = principal,
+          .host = host,
+          .operation = operation,
+          .resource = get_resource_type<T>(),
+          .name = resource_name(),
+        };
+        if (auto it = _decisions.find(key); it != _decisions.end()) {
+            return it->second;
+        }
+
+        auto allowed = check_acls(key);
+        if (_decisions.size() >= max_cached_decisions) {
+            _decisions.clear();
+        }
+        _decisions.emplace(std::move(key), allowed);
+        return allowed;
+    }
+
+    /// Number of cached authorization decisions, for testing
+    size_t cached_decisions() const { return _decisions.size(); }
+
+private:
+    struct decision_key {
+        acl_principal principal;
+        acl_host host;
+        acl_operation operation;
+        resource_type resource;
+        ss::sstring name;
+
+        friend bool operator==(const decision_key&, const decision_key&)
+          = default;
+
+        template<typename H>
+        friend H AbslHashValue(H h, const decision_key& k) {
+            return H::combine(
+              std::move(h),
+              k.principal,
+              k.host,
+              k.operation,
+              k.resource,
+              k.name);
+        }
+    };
+
+    bool check_acls(const decision_key& key) const {
+        const auto& principal = key.principal;
+        const auto& host = key.host;
+        auto acls = _store.find(key.resource, key.name);
+
         if (acls.empty()) {
             return bool(_allow_empty_matches);
         }
 
         // check for deny
-        if (acls.contains(operation, principal, host, acl_permission::deny)) {
+        if (acls.contains(
+              key.operation, principal, host, acl_permission::deny)) {
             return false;
         }
 
         // check for allow
-        auto ops = acl_implied_ops(operation);
+        auto ops = acl_implied_ops(key.operation);
         return std::any_of(
           ops.cbegin(),
           ops.cend(),
@@ -121,8 +183,8 @@ public:
           });
     }
 
-private:
     acl_store _store;
+    mutable absl::flat_hash_map<decision_key, bool> _decisions;
 
     // The list of superusers is stored twice: once as a vector in the
     // configuration subsystem, then again has a set here for fast lookups.
@@ -172,13 +172,39 @@ std::ostream& operator<<(std::ostream& os, const principal_mapper& p) {
 }
 
 principal_mapper::principal_mapper(
-  config::binding<std::optional<std::vector<ss::sstring>>> cb)
+  config::binding<std::optional<std::vector<ss::sstring>>> cb,
+  size_t cache_size)
   : _binding(std::move(cb))
-  , _rules{detail::parse_rules(_binding())} {
-    _binding.watch([this]() { _rules = detail::parse_rules(_binding()); });
+  , _rules{detail::parse_rules(_binding())}
+  , _cache_size(cache_size) {
+    _binding.watch([this]() {
+        _rules = detail::parse_rules(_binding());
+        _cache.clear();
+        _lru.clear();
+    });
 }
 
 std::optional<ss::sstring> principal_mapper::apply(std::string_view sv) const {
+    ss::sstring dn{sv};
+    if (auto it = _cache.find(dn); it != _cache.end()) {
+        _lru.splice(_lru.begin(), _lru, it->second);
+        return it->second->second;
+    }
+    auto principal = apply_rules(sv);
+    if (_cache_size == 0) {
+        return principal;
+    }
+    if (_cache.size() >= _cache_size) {
+        _cache.erase(_lru.back().first);
+        _lru.pop_back();
+    }
+    _lru.emplace_front(dn, principal);
+    _cache.emplace(std::move(dn), _lru.begin());
+    return principal;
+}
+
+std::optional<ss::sstring>
+principal_mapper::apply_rules(std::string_view sv) const {
     for (const auto& r : _rules) {
         if (auto p = r.apply(sv); p.has_value()) {
             return {std::move(p).value()};
@@ -17,8 +17,10 @@
 #include <seastar/core/sstring.hh>
 #include <seastar/util/bool_class.hh>
 
+#include <absl/container/flat_hash_map.h>
 #include <fmt/core.h>
 
+#include <list>
 #include <optional>
 #include <regex>
 #include <string_view>
@@ -53,20 +55,42 @@ private:
     make_upper _to_upper{false};
 };
 
+/*
+ * Maps the subject DN of a client certificate to a principal with the first
+ * matching rule.
+ *
+ * Clients that reconnect often present the same certificates over and over,
+ * so the results of the rules are kept in an LRU cache keyed by the subject
+ * DN. The cache is cleared when the rules change.
+ */
 class principal_mapper {
 public:
+    static constexpr size_t default_cache_size = 1024;
+
     explicit principal_mapper(
-      config::binding<std::optional<std::vector<ss::sstring>>> cb);
+      config::binding<std::optional<std::vector<ss::sstring>>> cb,
+      size_t cache_size = default_cache_size);
     std::optional<ss::sstring> apply(std::string_view sv) const;
 
+    size_t cached_entries() const { return _cache.size(); }
+
 private:
     friend struct fmt::formatter<principal_mapper>;
 
     friend std::ostream&
     operator<<(std::ostream& os, const principal_mapper& p);
 
+    using lru_list
+      = std::list<std::pair<ss::sstring, std::optional<ss::sstring>>>;
+
+    std::optional<ss::sstring> apply_rules(std::string_view sv) const;
+
     config::binding<std::optional<std::vector<ss::sstring>>> _binding;
     std::vector<rule> _rules;
+    size_t _cache_size;
+    // most recently used first
+    mutable lru_list _lru;
+    mutable absl::flat_hash_map<ss::sstring, lru_list::iterator> _cache;
 };
 
 class mtls_state {
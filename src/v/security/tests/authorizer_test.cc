@@ -898,4 +898,71 @@ BOOST_AUTO_TEST_CASE(topic_group_same_name) {
       kafka::group_id("topic-foo-xxx"), acl_operation::read, user, host));
 }
 
+BOOST_AUTO_TEST_CASE(prefix_lengths) {
+    acl_principal user(principal_type::user, "alice");
+    acl_host host("192.168.3.1");
+
+    auto auth = make_test_instance();
+
+    std::vector<acl_binding> bindings;
+    for (int i = 0; i < 100; ++i) {
+        bindings.emplace_back(
+          resource_pattern(
+            resource_type::topic,
+            fmt::format("tenant-{}-", i),
+            pattern_type::prefixed),
+          allow_read_acl);
+    }
+    bindings.emplace_back(
+      resource_pattern(
+        resource_type::group, "tenant-1", pattern_type::prefixed),
+      allow_read_acl);
+    auth.add_bindings(bindings);
+
+    BOOST_REQUIRE(auth.authorized(
+      model::topic("tenant-42-orders"), acl_operation::read, user, host));
+    BOOST_REQUIRE(auth.authorized(
+      model::topic("tenant-1-"), acl_operation::read, user, host));
+    BOOST_REQUIRE(!auth.authorized(
+      model::topic("tenant-1"), acl_operation::read, user, host));
+    BOOST_REQUIRE(!auth.authorized(
+      model::topic("tenant-100-orders"), acl_operation::read, user, host));
+    BOOST_REQUIRE(!auth.authorized(
+      model::topic("tenant-"), acl_operation::read, user, host));
+}
+
+BOOST_AUTO_TEST_CASE(decision_cache_invalidation) {
+    acl_principal user(principal_type::user, "alice");
+    acl_host host("192.168.3.1");
+
+    auto auth = make_test_instance();
+
+    BOOST_REQUIRE(
+      !auth.authorized(default_topic, acl_operation::read, user, host));
+    BOOST_REQUIRE_EQUAL(auth.cached_decisions(), 1);
+
+    std::vector<acl_binding> bindings;
+    bindings.emplace_back(
+      resource_pattern(
+        resource_type::topic, default_topic(), pattern_type::literal),
+      allow_read_acl);
+    auth.add_bindings(bindings);
+    BOOST_REQUIRE_EQUAL(auth.cached_decisions(), 0);
+
+    BOOST_REQUIRE(
+      auth.authorized(default_topic, acl_operation::read, user, host));
+    BOOST_REQUIRE(
+      auth.authorized(default_topic, acl_operation::read, user, host));
+    BOOST_REQUIRE_EQUAL(auth.cached_decisions(), 1);
+
+    // a dry run keeps the cached decisions
+    std::vector<acl_binding_filter> filters{acl_binding_filter::any()};
+    auth.remove_bindings(filters, true);
+    BOOST_REQUIRE_EQUAL(auth.cached_decisions(), 1);
+
+    auth.remove_bindings(filters);
+    BOOST_REQUIRE(
+      !auth.authorized(default_topic, acl_operation::read, user, host));
+}
+
 } // namespace security
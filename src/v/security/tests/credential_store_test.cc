@@ -8,6 +8,7 @@
 // by the Apache License, Version 2.0
 #include "random/generators.h"
 #include "security/credential_store.h"
+#include "security/verified_credential_cache.h"
 #include "utils/base64.h"
 
 #include <seastar/testing/thread_test_case.hh>
@@ -63,4 +64,35 @@ BOOST_AUTO_TEST_CASE(credential_store_test) {
     BOOST_REQUIRE_EQUAL(*store.get<scram_credential>(copied), cred1);
 }
 
+BOOST_AUTO_TEST_CASE(verified_credential_cache_test) {
+    const scram_credential cred0(
+      bytes("salty"),
+      bytes("i'm a server key"),
+      bytes("i'm the stored key"),
+      4096);
+
+    const scram_credential cred1(
+      bytes("salty2"),
+      bytes("i'm a server key2"),
+      bytes("i'm the stored key2"),
+      4096);
+
+    const credential_user user("user");
+    verified_credential_cache cache(std::chrono::seconds(60), 2);
+
+    BOOST_REQUIRE(!cache.contains(user, cred0, "password"));
+    cache.insert(user, cred0, "password");
+    BOOST_REQUIRE(cache.contains(user, cred0, "password"));
+
+    // wrong password or changed credential
+    BOOST_REQUIRE(!cache.contains(user, cred0, "passw0rd"));
+    BOOST_REQUIRE(!cache.contains(user, cred1, "password"));
+    BOOST_REQUIRE(!cache.contains(credential_user("other"), cred0, "password"));
+
+    // the cache is bounded
+    cache.insert(credential_user("a"), cred0, "password");
+    cache.insert(credential_user("b"), cred0, "password");
+    BOOST_REQUIRE_LE(cache.size(), 2);
+}
+
 } // namespace security
@@ -6,6 +6,7 @@
 // As of the Change Date specified in that file, in accordance with
 // the Business Source License, use of this software will be governed
 // by the Apache License, Version 2.0
+#include "config/mock_property.h"
 #include "config/property.h"
 #include "random/generators.h"
 #include "security/mtls.h"
@@ -166,4 +167,26 @@ BOOST_AUTO_TEST_CASE(test_mtls_parsing_with_newline) {
         .value_or(""));
 }
 
+BOOST_AUTO_TEST_CASE(test_mtls_principal_mapper_cache) {
+    config::mock_property<std::optional<std::vector<ss::sstring>>> rules(
+      std::vector<ss::sstring>{"RULE:^CN=(.*)/$1/"});
+    principal_mapper mapper(rules.bind(), 2);
+
+    BOOST_CHECK_EQUAL(mapper.apply("CN=a").value_or(""), "a");
+    BOOST_CHECK_EQUAL(mapper.apply("CN=a").value_or(""), "a");
+    BOOST_CHECK(!mapper.apply("OU=b").has_value());
+    BOOST_CHECK(!mapper.apply("OU=b").has_value());
+    BOOST_CHECK_EQUAL(mapper.cached_entries(), 2);
+
+    // the least recently used entry is evicted
+    BOOST_CHECK_EQUAL(mapper.apply("CN=c").value_or(""), "c");
+    BOOST_CHECK_EQUAL(mapper.cached_entries(), 2);
+    BOOST_CHECK_EQUAL(mapper.apply("CN=a").value_or(""), "a");
+
+    // changing the rules drops the cached principals
+    rules.update(std::vector<ss::sstring>{"RULE:^CN=(.*)/$1/U"});
+    BOOST_CHECK_EQUAL(mapper.cached_entries(), 0);
+    BOOST_CHECK_EQUAL(mapper.apply("CN=a").value_or(""), "A");
+}
+
 } // namespace security::tls
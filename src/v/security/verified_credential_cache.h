@@ -0,0 +1,123 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#pragma once
+#include "bytes/bytes.h"
+#include "hashing/secure.h"
+#include "random/generators.h"
+#include "seastarx.h"
+#include "security/credential_store.h"
+#include "security/scram_credential.h"
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/sstring.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+namespace security {
+
+/*
+ * Short-lived cache of passwords recently verified against stored SCRAM
+ * credentials.
+ *
+ * Validating a plain password (e.g. HTTP basic auth) requires deriving the
+ * salted password with PBKDF2, which is deliberately expensive and runs for
+ * every request of a client. A successful verification is remembered as a
+ * keyed digest of the password so that the following requests of the same
+ * client only pay for a single HMAC. The password itself is never stored and
+ * the digest key is private to the process.
+ *
+ * An entry is only valid for the credential it was verified against, so
+ * changing or deleting a user's credential invalidates it.
+ */
+class verified_credential_cache {
+public:
+    using clock_type = ss::lowres_clock;
+
+    static constexpr size_t digest_key_size = 32;
+
+    verified_credential_cache(clock_type::duration ttl, size_t max_entries)
+      : _ttl(ttl)
+      , _max_entries(max_entries)
+      , _digest_key(random_generators::get_bytes(digest_key_size)) {}
+
+    /*
+     * Returns true if the password was recently verified against the
+     * credential.
+     */
+    bool contains(
+      const credential_user& user,
+      const scram_credential& credential,
+      const ss::sstring& password) {
+        auto it = _entries.find(user);
+        if (it == _entries.end()) {
+            return false;
+        }
+        if (it->second.expires < clock_type::now()) {
+            _entries.erase(it);
+            return false;
+        }
+        return it->second.stored_key == credential.stored_key()
+               && it->second.digest == digest(credential, password);
+    }
+
+    /*
+     * Record the successful verification of the password.
+     */
+    void insert(
+      const credential_user& user,
+      const scram_credential& credential,
+      const ss::sstring& password) {
+        if (_entries.size() >= _max_entries && !_entries.contains(user)) {
+            evict_expired();
+            if (_entries.size() >= _max_entries) {
+                _entries.clear();
+            }
+        }
+        _entries.insert_or_assign(
+          user,
+          entry{
+            .stored_key = credential.stored_key(),
+            .digest = digest(credential, password),
+            .expires = clock_type::now() + _ttl,
+          });
+    }
+
+    size_t size() const { return _entries.size(); }
+
+private:
+    struct entry {
+        bytes stored_key;
+        bytes digest;
+        clock_type::time_point expires;
+    };
+
+    bytes
+    digest(const scram_credential& credential, const ss::sstring& password) {
+        hmac_sha256 mac(_digest_key);
+        mac.update(credential.salt());
+        mac.update(password);
+        auto result = mac.reset();
+        return bytes(result.begin(), result.end());
+    }
+
+    void evict_expired() {
+        const auto now = clock_type::now();
+        absl::erase_if(
+          _entries, [now](const auto& e) { return e.second.expires < now; });
+    }
+
+    clock_type::duration _ttl;
+    size_t _max_entries;
+    bytes _digest_key;
+    absl::flat_hash_map<credential_user, entry> _entries;
+};
+
+} // namespace security
@@ -33,6 +33,8 @@
 #include <absl/container/node_hash_map.h>
 #include <absl/container/node_hash_set.h>
 
+#include <array>
+#include <bit>
 #include <chrono>
 #include <iosfwd>
 #include <numeric>
@@ -182,6 +184,61 @@ inline constexpr auto const is_serde_compatible_v
     || is_std_unordered_map<T>
     || is_fragmented_vector<T> || reflection::is_tristate<T> || std::is_same_v<T, ss::net::inet_address>;
 
+namespace detail {
+
+template<typename T>
+constexpr bool is_fixed_layout_field() {
+    if constexpr (reflection::is_rp_named_type<T>) {
+        return sizeof(T) == sizeof(typename T::type)
+               && std::is_trivially_copyable_v<T>
+               && is_fixed_layout_field<typename T::type>();
+    } else {
+        return std::is_integral_v<T> && !std::is_same_v<T, bool>;
+    }
+}
+
+template<typename Fields>
+struct fixed_layout_fields;
+
+template<typename... Fs>
+struct fixed_layout_fields<std::tuple<Fs...>> {
+    static constexpr bool value
+      = (is_fixed_layout_field<std::decay_t<Fs>>() && ...);
+    static constexpr size_t size = (sizeof(std::decay_t<Fs>) + ... + 0);
+};
+
+template<typename T>
+constexpr bool is_fixed_layout_envelope() {
+    if constexpr (
+      std::endian::native != std::endian::little || !is_envelope<T>
+      || is_checksum_envelope<T> || has_serde_read<T> || has_serde_write<T>
+      || has_serde_async_read<T> || has_serde_async_write<T>
+      || has_serde_direct_read<T> || has_serde_async_direct_read<T>
+      || has_serde_fields<T> || !std::is_trivially_copyable_v<T>) {
+        return false;
+    } else {
+        using fields = fixed_layout_fields<decltype(envelope_to_tuple(
+          std::declval<T&>()))>;
+        return fields::value && fields::size == sizeof(T);
+    }
+}
+
+} // namespace detail
+
+/**
+ * An envelope whose fields are all integers (or named types of integers)
+ * laid out without padding. Its serialized fields are byte for byte its
+ * in-memory representation on a little endian host, so it is written and read
+ * with a single copy instead of field by field.
+ */
+template<typename T>
+inline constexpr bool is_fixed_layout_envelope_v
+  = detail::is_fixed_layout_envelope<T>();
+
+/// version + compat_version + size
+inline constexpr size_t envelope_header_size = 2 * sizeof(version_t)
+                                               + sizeof(serde_size_t);
+
 template<typename T>
 inline constexpr auto const are_bytes_and_string_different = !(
   std::is_same_v<T, ss::sstring> && std::is_same_v<T, bytes>);
@@ -250,7 +307,16 @@ void write(iobuf& out, T t) {
     static_assert(are_bytes_and_string_different<Type>);
     static_assert(has_serde_write<Type> || is_serde_compatible_v<Type>);
 
-    if constexpr (is_envelope<Type>) {
+    if constexpr (is_fixed_layout_envelope_v<Type>) {
+        std::array<char, envelope_header_size + sizeof(Type)> buf;
+        buf[0] = static_cast<char>(Type::redpanda_serde_version);
+        buf[1] = static_cast<char>(Type::redpanda_serde_compat_version);
+        auto const size = ss::cpu_to_le(
+          static_cast<serde_size_t>(sizeof(Type)));
+        std::memcpy(buf.data() + 2 * sizeof(version_t), &size, sizeof(size));
+        std::memcpy(buf.data() + envelope_header_size, &t, sizeof(Type));
+        out.append(buf.data(), buf.size());
+    } else if constexpr (is_envelope<Type>) {
         write(out, Type::redpanda_serde_version);
         write(out, Type::redpanda_serde_compat_version);
 
@@ -332,6 +398,11 @@ void write(iobuf& out, T t) {
               t.size()));
         }
         write(out, static_cast<serde_size_t>(t.size()));
+        if constexpr (is_fixed_layout_envelope_v<typename Type::value_type>) {
+            out.reserve_memory(
+              t.size()
+              * (envelope_header_size + sizeof(typename Type::value_type)));
+        }
         for (auto& el : t) {
             write(out, std::move(el));
         }
@@ -557,6 +628,14 @@ void read_nested(iobuf_parser& in, T& t, std::size_t const bytes_left_limit) {
         if constexpr (has_serde_read<Type>) {
             t.serde_read(in, h);
         } else {
+            if constexpr (is_fixed_layout_envelope_v<Type>) {
+                // same version layout, otherwise fields are read one by one
+                if (likely(
+                      in.bytes_left() - h._bytes_left_limit == sizeof(Type))) {
+                    in.consume_to(sizeof(Type), reinterpret_cast<char*>(&t));
+                    return;
+                }
+            }
             envelope_for_each_field(t, [&](auto& f) {
                 using FieldType = std::decay_t<decltype(f)>;
                 if (h._bytes_left_limit == in.bytes_left()) {
@@ -679,8 +758,29 @@ void read_nested(iobuf_parser& in, T& t, std::size_t const bytes_left_limit) {
     } else if constexpr (is_fragmented_vector<Type>) {
         using value_type = typename Type::value_type;
         const auto size = read_nested<serde_size_t>(in, bytes_left_limit);
-        for (auto i = 0U; i < size; ++i) {
-            t.push_back(read_nested<value_type>(in, bytes_left_limit));
+        if constexpr (
+          std::is_integral_v<value_type>
+          && std::endian::native == std::endian::little) {
+            // the little endian encoding of the elements is their memory
+            // layout, copy them a fragment at a time
+            const size_t bytes = size_t{size} * sizeof(value_type);
+            if (unlikely(in.bytes_left() < bytes)) {
+                throw serde_exception(fmt_with_ctx(
+                  ssx::sformat,
+                  "reading {} elements of type {}: {} bytes left",
+                  size,
+                  type_str<value_type>(),
+                  in.bytes_left()));
+            }
+            t.append_with(size, [&in](value_type* dst, size_t n) {
+                in.consume_to(
+                  n * sizeof(value_type),
+                  reinterpret_cast<char*>(dst)); // NOLINT
+            });
+        } else {
+            for (auto i = 0U; i < size; ++i) {
+                t.push_back(read_nested<value_type>(in, bytes_left_limit));
+            }
         }
         t.shrink_to_fit();
     } else if constexpr (is_chrono_duration<Type>) {
@@ -673,6 +673,85 @@ SEASTAR_THREAD_TEST_CASE(serde_fields_test_struct_test) {
       == serde_fields_test_struct{123});
 }
 
+struct fixed_layout
+  : serde::
+      envelope<fixed_layout, serde::version<1>, serde::compat_version<0>> {
+    bool operator==(const fixed_layout&) const = default;
+    model::offset offset;
+    model::term_id term;
+    int32_t a;
+    uint16_t b;
+    int8_t c, d;
+};
+
+struct fixed_layout_by_field
+  : serde::envelope<
+      fixed_layout_by_field,
+      serde::version<1>,
+      serde::compat_version<0>> {
+    bool operator==(const fixed_layout_by_field&) const = default;
+    auto serde_fields() { return std::tie(offset, term, a, b, c, d); }
+    model::offset offset;
+    model::term_id term;
+    int32_t a;
+    uint16_t b;
+    int8_t c, d;
+};
+
+struct not_fixed_layout_bool
+  : serde::envelope<
+      not_fixed_layout_bool,
+      serde::version<0>,
+      serde::compat_version<0>> {
+    int32_t a;
+    bool b, c, d, e;
+};
+
+struct not_fixed_layout_checksum
+  : serde::checksum_envelope<
+      not_fixed_layout_checksum,
+      serde::version<0>,
+      serde::compat_version<0>> {
+    int32_t a, b;
+};
+
+static_assert(serde::is_fixed_layout_envelope_v<fixed_layout>);
+static_assert(serde::is_fixed_layout_envelope_v<small>);
+static_assert(!serde::is_fixed_layout_envelope_v<fixed_layout_by_field>);
+static_assert(!serde::is_fixed_layout_envelope_v<not_fixed_layout_bool>);
+static_assert(!serde::is_fixed_layout_envelope_v<test_msg1>);
+static_assert(!serde::is_fixed_layout_envelope_v<not_fixed_layout_checksum>);
+
+SEASTAR_THREAD_TEST_CASE(fixed_layout_envelope_test) {
+    auto const fixed = fixed_layout{
+      .offset = model::offset(123),
+      .term = model::term_id(-7),
+      .a = 0x12345678,
+      .b = 0xfedc,
+      .c = -1,
+      .d = 42};
+    auto const by_field = fixed_layout_by_field{
+      .offset = fixed.offset,
+      .term = fixed.term,
+      .a = fixed.a,
+      .b = fixed.b,
+      .c = fixed.c,
+      .d = fixed.d};
+
+    // same encoding as field by field
+    BOOST_CHECK(serde::to_iobuf(fixed) == serde::to_iobuf(by_field));
+    BOOST_CHECK(
+      serde::from_iobuf<fixed_layout>(serde::to_iobuf(by_field)) == fixed);
+    BOOST_CHECK(
+      serde::from_iobuf<fixed_layout_by_field>(serde::to_iobuf(fixed))
+      == by_field);
+
+    auto const vec = std::vector<fixed_layout>(10, fixed);
+    BOOST_CHECK(
+      serde::from_iobuf<std::vector<fixed_layout>>(serde::to_iobuf(vec))
+      == vec);
+}
+
 SEASTAR_THREAD_TEST_CASE(fragmented_vector_test) {
     std::vector<int> sizes(100);
     std::iota(sizes.begin(), sizes.end(), 0);
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "resource_mgmt/io_priority.h"
 #include "seastarx.h"
 #include "storage/kvstore.h"
 #include "storage/log_manager.h"
@@ -57,10 +58,20 @@ public:
       , _log_conf_cb(std::move(log_conf_cb)) {}
 
     ss::future<> start() {
+        _resources.get_flush_coordinator().setup_metrics();
+        _resources.setup_chunk_cache_metrics();
+        auto& io_ctrl = _resources.get_io_share_controller();
+        io_ctrl.add_background_class(
+          "raft-learner-recovery", raft_learner_recovery_priority());
+        io_ctrl.setup_metrics();
+        io_ctrl.start();
         _kvstore = std::make_unique<kvstore>(_kv_conf_cb(), _resources);
         return _kvstore->start().then([this] {
             _log_mgr = std::make_unique<log_manager>(
               _log_conf_cb(), kvs(), _resources);
+            _log_mgr->setup_metrics();
+            return _resources.get_segment_pool().start(
+              std::filesystem::path(_log_mgr->config().base_dir));
         });
     }
 
@@ -70,9 +81,13 @@ public:
             f = _log_mgr->stop();
         }
         if (_kvstore) {
-            return f.then([this] { return _kvstore->stop(); });
+            f = f.then([this] { return _kvstore->stop(); });
         }
-        return f;
+        return f
+          .then([this] { return _resources.get_segment_pool().stop(); })
+          .then([this] { return _resources.get_flush_coordinator().stop(); })
+          .then(
+            [this] { return _resources.get_io_share_controller().stop(); });
     }
 
     kvstore& kvs() { return *_kvstore; }
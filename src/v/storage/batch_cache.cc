@@ -34,6 +34,9 @@ batch_cache::range::range(
   batch_cache_index& index, const model::record_batch& batch)
   : _index(index) {
     add(batch);
+    // the range only ever holds this batch, fold the header fragment into
+    // right-sized memory rather than retaining its partly used allocation
+    _arena = iobuf_compact(std::move(_arena));
 }
 
 model::record_batch batch_cache::range::batch(size_t o) {
@@ -135,6 +138,8 @@ batch_cache::put(batch_cache_index& index, const model::record_batch& input) {
         auto r = new range(index, input);
         _lru.push_back(*r);
         _size_bytes += r->memory_size();
+        _tracked.update(_size_bytes);
+        index.account(r->memory_size());
         return entry(0, r->weak_from_this());
     }
 
@@ -144,6 +149,8 @@ batch_cache::put(batch_cache_index& index, const model::record_batch& input) {
         auto r = new range(index);
         _lru.push_back(*r);
         _size_bytes += r->memory_size();
+        _tracked.update(_size_bytes);
+        index.account(r->memory_size());
         index._small_batches_range = r->weak_from_this();
     }
 
@@ -153,6 +160,12 @@ batch_cache::put(batch_cache_index& index, const model::record_batch& input) {
     int64_t diff = (int64_t)index._small_batches_range->memory_size()
                    - initial_sz;
     _size_bytes += diff;
+    _tracked.update(_size_bytes);
+    index.account(diff);
+    if (index._small_batches_range->_protected) {
+        _protected_bytes += diff;
+        maybe_demote_protected();
+    }
     _background_reclaimer.notify();
     return entry(offset, index._small_batches_range->weak_from_this());
 }
@@ -160,7 +173,7 @@ batch_cache::put(batch_cache_index& index, const model::record_batch& input) {
 batch_cache::~batch_cache() noexcept {
     clear();
     vassert(
-      _size_bytes == 0 && _lru.empty(),
+      _size_bytes == 0 && _protected_bytes == 0 && empty(),
       "Detected incorrect batch_cache accounting. {}",
       *this);
 }
@@ -172,8 +185,77 @@ void batch_cache::evict(range_ptr&& e) {
         // r-value reference `e` wouldn't do that.
         auto p = std::exchange(e, {});
         _size_bytes -= p->memory_size();
-        _lru.erase_and_dispose(
-          _lru.iterator_to(*p), [](range* e) { delete e; });
+        _tracked.update(_size_bytes);
+        p->_index.account(-static_cast<int64_t>(p->memory_size()));
+        if (p->_protected) {
+            _protected_bytes -= p->memory_size();
+        }
+        auto& list = list_of(*p);
+        list.erase_and_dispose(
+          list.iterator_to(*p), [](range* e) { delete e; });
+    }
+}
+
+void batch_cache::maybe_demote_protected() {
+    const auto max_protected = static_cast<size_t>(
+      static_cast<double>(_size_bytes) * protected_share);
+    while (_protected_bytes > max_protected && !_protected.empty()) {
+        auto& r = _protected.front();
+        _protected.pop_front();
+        r._protected = false;
+        _protected_bytes -= r.memory_size();
+        // demoted ranges get another chance as the most recently used
+        // probationary range
+        _lru.push_back(r);
+    }
+}
+
+void batch_cache::setup_metrics() {
+    _probe.setup_metrics(fmt::format("{}", _reclaim_opts.policy));
+}
+
+void batch_cache::reclaim_from(
+  range_list& list,
+  batch_cache_priority max_priority,
+  size_t target,
+  size_t& reclaimed,
+  range_list& removed) {
+    for (auto it = list.begin(); it != list.end();) {
+        if (reclaimed >= target) {
+            break;
+        }
+
+        // skip any range that has a live reference or a higher priority.
+        if (unlikely(it->pinned() || it->_index.priority() > max_priority)) {
+            ++it;
+            continue;
+        }
+        // if entry is empty it will be disposed by other reclaim caller
+        if (unlikely(it->empty())) {
+            continue;
+        }
+        // reclaim the batch's record data
+        reclaimed += it->memory_size();
+        it->_index.account(-static_cast<int64_t>(it->memory_size()));
+        if (it->_protected) {
+            _protected_bytes -= it->memory_size();
+        }
+        it->_arena.clear();
+
+        /*
+         * if the owning index is locked invalidate the range but leave it on
+         * the lru list for deferred deletion so as to not invalidate any open
+         * iterators on the index.
+         */
+        if (unlikely(it->_index.locked())) {
+            it->invalidate();
+            ++it;
+            continue;
+        }
+
+        // collect the entries that will be fully removed
+        it = list.erase_and_dispose(
+          it, [&removed](range* e) { removed.push_back(*e); });
     }
 }
 
@@ -210,41 +292,20 @@ size_t batch_cache::reclaim(size_t size) {
      * index still exists even though the batch data was removed.
      */
     size_t reclaimed = 0;
-    intrusive_list<range, &range::_hook> reclaimed_ranges;
-
-    for (auto it = _lru.begin(); it != _lru.end();) {
-        if (reclaimed >= _reclaim_size) {
-            break;
-        }
-
-        // skip any range that has a live reference.
-        if (unlikely(it->pinned())) {
-            ++it;
-            continue;
-        }
-        // if entry is empty it will be disposed by other reclaim caller
-        if (unlikely(it->empty())) {
-            continue;
-        }
-        // reclaim the batch's record data
-        reclaimed += it->memory_size();
-        it->_arena.clear();
+    range_list reclaimed_ranges;
 
-        /*
-         * if the owning index is locked invalidate the range but leave it on
-         * the lru list for deferred deletion so as to not invalidate any open
-         * iterators on the index.
-         */
-        if (unlikely(it->_index.locked())) {
-            it->invalidate();
-            ++it;
-            continue;
-        }
-
-        // collect the entries that will be fully removed
-        it = _lru.erase_and_dispose(it, [&reclaimed_ranges](range* e) {
-            reclaimed_ranges.push_back(*e);
-        });
+    /*
+     * the protected segment of segmented_lru is only reclaimed once the
+     * probationary segment is exhausted. with the lru policy the protected
+     * list is always empty. the ranges of high priority indices are only
+     * reclaimed once both segments are exhausted of regular ranges.
+     */
+    for (auto priority :
+         {batch_cache_priority::regular, batch_cache_priority::high}) {
+        reclaim_from(
+          _lru, priority, _reclaim_size, reclaimed, reclaimed_ranges);
+        reclaim_from(
+          _protected, priority, _reclaim_size, reclaimed, reclaimed_ranges);
     }
 
     /*
@@ -273,6 +334,7 @@ size_t batch_cache::reclaim(size_t size) {
 
     _last_reclaim = ss::lowres_clock::now();
     _size_bytes -= reclaimed;
+    _tracked.update(_size_bytes);
     return reclaimed;
 }
 
@@ -280,10 +342,12 @@ std::optional<model::record_batch>
 batch_cache_index::get(model::offset offset) {
     lock_guard lk(*this);
     if (auto it = find_first_contains(offset); it != _index.end()) {
+        _cache->_probe.hit();
         batch_cache::range::lock_guard g(*it->second.range());
         _cache->touch(it->second.range());
         return it->second.batch();
     }
+    _cache->_probe.miss();
     return std::nullopt;
 }
 
@@ -300,7 +364,13 @@ batch_cache_index::read_result batch_cache_index::read(
     if (unlikely(offset > max_offset)) {
         return ret;
     }
-    for (auto it = find_first_contains(offset); it != _index.end();) {
+    auto it = find_first_contains(offset);
+    if (it == _index.end()) {
+        _cache->_probe.miss();
+    } else {
+        _cache->_probe.hit();
+    }
+    while (it != _index.end()) {
         auto batch = it->second.batch();
 
         auto take = !type_filter || type_filter == batch.header().type;
@@ -408,19 +478,30 @@ std::ostream&
 operator<<(std::ostream& os, const batch_cache::reclaim_options& opts) {
     fmt::print(
       os,
-      "growth window {} stable window {} min_size {} max_size {}",
+      "growth window {} stable window {} min_size {} max_size {} policy {}",
       opts.growth_window,
       opts.stable_window,
       opts.min_size,
-      opts.max_size);
+      opts.max_size,
+      opts.policy);
     return os;
 }
 
+std::ostream& operator<<(std::ostream& o, batch_cache_policy p) {
+    switch (p) {
+    case batch_cache_policy::lru:
+        return o << "lru";
+    case batch_cache_policy::segmented_lru:
+        return o << "segmented_lru";
+    }
+}
+
 std::ostream& operator<<(std::ostream& o, const batch_cache& b) {
     // NOTE: intrusive list have a O(N) for size.
     // Do _not_ print size of _lru
     return o << "{is_reclaiming:" << b.is_memory_reclaiming()
              << ", size_bytes: " << b._size_bytes
+             << ", protected_bytes: " << b._protected_bytes
              << ", lru_empty:" << b._lru.empty() << "}";
 }
 std::ostream&
@@ -12,8 +12,11 @@
 #pragma once
 #include "model/record.h"
 #include "ssx/semaphore.h"
+#include "storage/probe.h"
+#include "storage/types.h"
 #include "units.h"
 #include "utils/intrusive_list_helpers.h"
+#include "utils/memory_accounting.h"
 #include "vassert.h"
 
 #include <seastar/core/circular_buffer.hh>
@@ -22,6 +25,7 @@
 #include <seastar/core/lowres_clock.hh>
 #include <seastar/core/memory.hh>
 #include <seastar/core/scheduling.hh>
+#include <seastar/core/shared_ptr.hh>
 #include <seastar/core/weak_ptr.hh>
 
 #include <absl/container/btree_map.h>
@@ -35,6 +39,23 @@ namespace storage {
 
 class batch_cache_index;
 
+/**
+ * Eviction policy of the batch cache.
+ *
+ * lru - a single lru list, every insertion and hit moves a range to the most
+ *       recently used position.
+ *
+ * segmented_lru - newly inserted ranges enter a probationary segment and are
+ *       promoted to a protected segment on their first hit. Reclaim drains the
+ *       probationary segment first, so a single reader scanning historical
+ *       data only churns the probationary segment instead of evicting the hot
+ *       tail batches. The protected segment is capped at a share of the cache
+ *       and demotes its least recently used ranges back to probation.
+ */
+enum class batch_cache_policy { lru, segmented_lru };
+
+std::ostream& operator<<(std::ostream&, batch_cache_policy);
+
 /**
  * The batch cache system consists of two components. The `batch_cache` is a
  * global (per-shard) LRU cache of batches stored in memory. The second
@@ -93,8 +114,6 @@ class batch_cache_index;
  * the future, consider other solutions like blocking the reclaimer or only
  * allowing asynchronous reclaims while executing within the batch catch.
  *
- * TODO:
- *  - add probes to track statistics
  */
 
 class batch_cache {
@@ -114,8 +133,12 @@ public:
         // background reclaimer settings
         ss::scheduling_group background_reclaimer_sg;
         size_t min_free_memory = 64_MiB;
+        batch_cache_policy policy = batch_cache_policy::lru;
     };
 
+    /// Share of the cache the protected segment of segmented_lru may use
+    static constexpr double protected_share = 0.8;
+
     /*
      * An range manages the lifetime of a multiple cached record batches.
      */
@@ -189,6 +212,8 @@ public:
         std::vector<model::offset> _offsets;
 
         bool _pinned{false};
+        // range is linked into the protected segment of segmented_lru
+        bool _protected{false};
         size_t _size = 0;
         intrusive_list_hook _hook;
         batch_cache_index& _index;
@@ -254,7 +279,11 @@ public:
     ss::future<> stop() { return _background_reclaimer.stop(); }
 
     /// Returns true if the cache is empty, and false otherwise.
-    bool empty() const { return _lru.empty(); }
+    bool empty() const { return _lru.empty() && _protected.empty(); }
+
+    batch_cache_policy policy() const { return _reclaim_opts.policy; }
+
+    void setup_metrics();
 
     /// Removes all entries from the cache.
     void clear() { reclaim(std::numeric_limits<size_t>::max()); }
@@ -287,11 +316,21 @@ public:
      * Notify the cache that the specified range was recently used.
      */
     void touch(range_ptr& e) {
-        if (e) {
-            auto p = e.get();
-            p->_hook.unlink();
+        if (!e) {
+            return;
+        }
+        auto p = e.get();
+        p->_hook.unlink();
+        if (_reclaim_opts.policy == batch_cache_policy::lru) {
             _lru.push_back(*p);
+            return;
+        }
+        if (!p->_protected) {
+            p->_protected = true;
+            _protected_bytes += p->memory_size();
         }
+        _protected.push_back(*p);
+        maybe_demote_protected();
     }
 
     /**
@@ -360,6 +399,24 @@ private:
      * fiber. A more advanced usage that is allowed to invoke reclaim
      * synchronously with memory allocation is also possible.
      */
+    using range_list = intrusive_list<range, &range::_hook>;
+
+    range_list& list_of(const range& r) {
+        return r._protected ? _protected : _lru;
+    }
+
+    // keeps the protected segment within its share of the cache
+    void maybe_demote_protected();
+
+    // first reclaim pass over one segment for the ranges of indices up to the
+    // given priority, see reclaim(size_t)
+    void reclaim_from(
+      range_list&,
+      batch_cache_priority,
+      size_t target,
+      size_t& reclaimed,
+      range_list& removed);
+
     ss::memory::reclaiming_result reclaim(reclaimer::request r) {
         const size_t lower_bound = std::max(
           r.bytes_to_reclaim, min_reclaim_size);
@@ -370,16 +427,23 @@ private:
                               : reclaim_result::reclaimed_nothing;
     }
 
-    intrusive_list<range, &range::_hook> _lru;
+    // the only list of the lru policy, the probationary segment of
+    // segmented_lru
+    range_list _lru;
+    range_list _protected;
     reclaimer _reclaimer;
     bool _is_reclaiming{false};
     size_t _size_bytes{0};
+    size_t _protected_bytes{0};
+    tracked_memory _tracked{memory_subsystem::batch_cache};
+    batch_cache_probe _probe;
 
     reclaim_options _reclaim_opts;
     ss::lowres_clock::time_point _last_reclaim;
     size_t _reclaim_size;
     background_reclaimer _background_reclaimer;
 
+    friend batch_cache_index;
     friend std::ostream& operator<<(std::ostream&, const reclaim_options&);
     friend std::ostream& operator<<(std::ostream&, const batch_cache&);
 };
@@ -397,8 +461,10 @@ public:
         friend std::ostream& operator<<(std::ostream&, const read_result&);
     };
 
-    explicit batch_cache_index(batch_cache& cache)
-      : _cache(&cache) {}
+    explicit batch_cache_index(
+      batch_cache& cache, ss::lw_shared_ptr<batch_cache_owner> owner = nullptr)
+      : _cache(&cache)
+      , _owner(std::move(owner)) {}
     ~batch_cache_index() {
         lock_guard lk(*this);
         std::for_each(
@@ -506,6 +572,16 @@ private:
 
     bool locked() const { return _locked; }
 
+    batch_cache_priority priority() const {
+        return _owner ? _owner->priority : batch_cache_priority::regular;
+    }
+
+    void account(int64_t diff) {
+        if (_owner) {
+            _owner->bytes += diff;
+        }
+    }
+
     void lock() {
         vassert(!_locked, "batch cache index double lock");
         _locked = true;
@@ -558,6 +634,7 @@ private:
 
     bool _locked{false};
     batch_cache* _cache;
+    ss::lw_shared_ptr<batch_cache_owner> _owner;
     index_type _index;
     batch_cache::range_ptr _small_batches_range = nullptr;
 
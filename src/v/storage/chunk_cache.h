@@ -14,6 +14,8 @@
 
 #include <boost/iterator/counting_iterator.hpp>
 
+#include <algorithm>
+
 namespace storage::internal {
 
 class chunk_cache {
@@ -30,8 +32,15 @@ public:
      */
     static constexpr const size_t alignment = 4_KiB;
 
+    /// Free chunks kept in the cache for every partition on the shard
+    static constexpr const size_t target_chunks_per_partition = 4;
+
+    /// Chunks in flight that an appender may always hold
+    static constexpr const size_t min_fair_share = 2;
+
     chunk_cache() noexcept
       : _size_target(memory_groups::chunk_cache_min_memory())
+      , _size_target_max(_size_target)
       , _size_limit(memory_groups::chunk_cache_max_memory())
       , _chunk_size(config::shard_local_cfg().append_chunk_size()) {}
 
@@ -42,8 +51,7 @@ public:
     ~chunk_cache() noexcept = default;
 
     ss::future<> start() {
-        const auto num_chunks = memory_groups::chunk_cache_min_memory()
-                                / _chunk_size;
+        const auto num_chunks = _size_target / _chunk_size;
         return ss::do_for_each(
           boost::counting_iterator<size_t>(0),
           boost::counting_iterator<size_t>(num_chunks),
@@ -66,15 +74,64 @@ public:
         }
     }
 
-    ss::future<chunk_ptr> get() {
+    /**
+     * Get a chunk for an appender that has 'in_flight' chunks being written.
+     *
+     * Appenders with at least their fair share of chunks in flight don't
+     * allocate new chunks, they wait for chunks returned to the cache, e.g.
+     * their own chunks once the writes complete. This keeps a few busy
+     * partitions from taking all of the memory from the rest.
+     */
+    ss::future<chunk_ptr> get(size_t in_flight = 0) {
+        const bool over_share = in_flight >= fair_share() && _chunks.empty();
         // don't steal if there are waiters
-        if (!_sem.waiters()) {
+        if (!_sem.waiters() && !over_share) {
             return do_get();
         }
+        ++_waits;
+        if (over_share) {
+            ++_throttled;
+        }
         return ss::get_units(_sem, 1).then(
           [this](ssx::semaphore_units) { return do_get(); });
     }
 
+    /**
+     * Size the cache for the number of partitions on the shard. Free chunks
+     * are kept for 'target_chunks_per_partition' chunks per partition up to
+     * the initial target, the rest is released. The limit on the outstanding
+     * memory doesn't change, it is split into fair shares instead.
+     */
+    void set_partition_count(size_t partitions) {
+        _partition_count = partitions;
+        _size_target = std::clamp(
+          partitions * target_chunks_per_partition * _chunk_size,
+          _chunk_size,
+          _size_target_max);
+        while (_size_available > _size_target && !_chunks.empty()) {
+            _chunks.pop_front();
+            _size_available -= _chunk_size;
+            _size_total -= _chunk_size;
+        }
+    }
+
+    /// Number of chunks in flight an appender may hold before it has to
+    /// wait for returned chunks
+    size_t fair_share() const {
+        const auto max_chunks = _size_limit / _chunk_size;
+        if (_partition_count == 0) {
+            return max_chunks;
+        }
+        return std::max(min_fair_share, max_chunks / _partition_count);
+    }
+
+    size_t size_total() const { return _size_total; }
+    size_t size_available() const { return _size_available; }
+    size_t size_target() const { return _size_target; }
+    size_t waiters() const { return _sem.waiters(); }
+    uint64_t waits() const { return _waits; }
+    uint64_t throttled() const { return _throttled; }
+
 private:
     ss::future<chunk_ptr> do_get() {
         if (auto c = pop_or_allocate(); c) {
@@ -108,8 +165,12 @@ private:
     ssx::semaphore _sem{0, "s/chunk-cache"};
     size_t _size_available{0};
     size_t _size_total{0};
-    const size_t _size_target;
+    size_t _size_target;
+    const size_t _size_target_max;
     const size_t _size_limit;
+    size_t _partition_count{0};
+    uint64_t _waits{0};
+    uint64_t _throttled{0};
 
     const size_t _chunk_size{0};
 };
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "storage/compaction_filter.h"
+
+#include "storage/segment.h"
+
+#include <seastar/core/coroutine.hh>
+
+#include <algorithm>
+
+namespace storage::internal {
+
+namespace {
+template<typename Span>
+bool find_in_spans(const std::vector<Span>& spans, model::offset o) {
+    // first span which ends at or after 'o'
+    auto it = std::lower_bound(
+      spans.begin(), spans.end(), o, [](const Span& s, model::offset o) {
+          return s.last < o;
+      });
+    return it != spans.end() && it->first <= o;
+}
+} // namespace
+
+compaction_filter::compaction_filter(
+  model::offset base_offset, std::vector<aborted_tx_range> aborted)
+  : _removed(base_offset, Roaring{}) {
+    std::sort(
+      aborted.begin(),
+      aborted.end(),
+      [](const aborted_tx_range& a, const aborted_tx_range& b) {
+          return a.first < b.first;
+      });
+    for (const auto& r : aborted) {
+        // spans of a single producer never overlap, ranges of different
+        // producers are merged
+        _aborted[r.pid].push_back(span{.first = r.first, .last = r.last});
+        if (!_spans.empty() && r.first <= _spans.back().last) {
+            _spans.back().last = std::max(_spans.back().last, r.last);
+        } else {
+            _spans.push_back(span{.first = r.first, .last = r.last});
+        }
+    }
+}
+
+ss::future<compaction_filter>
+compaction_filter::make(const segment& s, const compaction_config& cfg) {
+    const auto offsets = s.offsets();
+    std::vector<aborted_tx_range> aborted;
+    if (cfg.stms) {
+        aborted = co_await cfg.stms->aborted_tx_ranges(
+          offsets.base_offset, offsets.dirty_offset);
+    }
+    co_return compaction_filter(offsets.base_offset, std::move(aborted));
+}
+
+bool compaction_filter::in_aborted_span(model::offset o) const {
+    return find_in_spans(_spans, o);
+}
+
+bool compaction_filter::is_aborted(
+  const model::record_batch_header& hdr) const {
+    if (
+      _aborted.empty() || !hdr.attrs.is_transactional()
+      || hdr.attrs.is_control()) {
+        return false;
+    }
+    auto it = _aborted.find(
+      model::producer_identity(hdr.producer_id, hdr.producer_epoch));
+    return it != _aborted.end() && find_in_spans(it->second, hdr.base_offset);
+}
+
+bool compaction_filter::is_expired_tombstone(
+  const model::record_batch_header& hdr, const model::record& r) const {
+    if (!_tombstone_eviction_time || r.has_value()) {
+        return false;
+    }
+    const auto ts = model::timestamp(
+      hdr.first_timestamp.value() + r.timestamp_delta());
+    return ts < *_tombstone_eviction_time;
+}
+
+} // namespace storage::internal
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "model/record.h"
+#include "model/timestamp.h"
+#include "storage/compacted_offset_list.h"
+#include "storage/types.h"
+
+#include <absl/container/flat_hash_map.h>
+
+#include <optional>
+#include <vector>
+
+namespace storage::internal {
+
+/**
+ * Records removed from a segment while its data is copied, in addition to
+ * the ones superseded by a newer record of the same key: data batches of
+ * aborted transactions and expired tombstones.
+ *
+ * The aborted transactions of the segment are fetched once, when the filter
+ * is made, and answer every batch of the segment from memory. A record in
+ * the offset span of an aborted transaction may belong to it, its key must
+ * not supersede older records, otherwise the committed value would be lost
+ * together with the aborted one. Records removed by the filter are tracked
+ * so that their compaction index entries can be dropped as well.
+ */
+class compaction_filter {
+public:
+    compaction_filter(
+      model::offset base_offset, std::vector<aborted_tx_range> aborted);
+
+    /// Fetch the transactions aborted in the segment offset range
+    static ss::future<compaction_filter>
+    make(const segment& s, const compaction_config& cfg);
+
+    /// Remove tombstones written before 't'
+    void set_tombstone_eviction_time(model::timestamp t) {
+        _tombstone_eviction_time = t;
+    }
+
+    bool has_aborted_transactions() const { return !_spans.empty(); }
+
+    /// True if the offset is in the span of an aborted transaction
+    bool in_aborted_span(model::offset) const;
+
+    /// True if the batch holds the data of an aborted transaction
+    bool is_aborted(const model::record_batch_header&) const;
+
+    /// True if the record is a tombstone older than the eviction time
+    bool is_expired_tombstone(
+      const model::record_batch_header&, const model::record&) const;
+
+    /// Track a record removed by the filter
+    void record_removed(model::offset o) {
+        _removed.add(o);
+        ++_removed_count;
+    }
+
+    /// Records removed by the filter
+    const compacted_offset_list& removed() const { return _removed; }
+    size_t removed_count() const { return _removed_count; }
+
+private:
+    struct span {
+        model::offset first;
+        model::offset last;
+    };
+
+    /// Disjoint offset spans of all aborted transactions sorted by offset
+    std::vector<span> _spans;
+    /// Aborted transactions of every producer sorted by offset
+    absl::flat_hash_map<model::producer_identity, std::vector<span>> _aborted;
+    std::optional<model::timestamp> _tombstone_eviction_time;
+    compacted_offset_list _removed;
+    size_t _removed_count{0};
+};
+
+} // namespace storage::internal
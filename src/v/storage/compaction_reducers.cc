@@ -19,6 +19,7 @@
 #include "storage/parser_utils.h"
 #include "storage/segment_appender_utils.h"
 #include "storage/segment_utils.h"
+#include "utils/stall_tracker.h"
 #include "vlog.h"
 
 #include <seastar/core/future.hh>
@@ -37,6 +38,13 @@ compaction_key_reducer::operator()(compacted_index::entry&& e) {
     using stop_t = ss::stop_iteration;
     const model::offset o = e.offset + model::offset(e.delta);
 
+    // the record may be aborted, keep the entry without superseding others
+    if (_filter && _filter->in_aborted_span(o)) {
+        _inverted.add(_natural_index);
+        ++_natural_index;
+        return ss::make_ready_future<stop_t>(stop_t::no);
+    }
+
     auto it = _indices.find(e.key);
     if (it != _indices.end()) {
         if (o > it->second.offset) {
@@ -74,6 +82,7 @@ compaction_key_reducer::operator()(compacted_index::entry&& e) {
     return ss::make_ready_future<stop_t>(stop_t::no);
 }
 Roaring compaction_key_reducer::end_of_stream() {
+    stall_tracker_section("compaction");
     // TODO: optimization - detect if the index does not need compaction
     // by linear scan of natural_index from 0-N with no gaps.
     for (auto& e : _indices) {
@@ -105,6 +114,19 @@ index_filtered_copy_reducer::operator()(compacted_index::entry&& e) {
     return ss::make_ready_future<stop_t>(stop_t::no);
 }
 
+ss::future<ss::stop_iteration>
+index_removed_filter_copy_reducer::operator()(compacted_index::entry&& e) {
+    using stop_t = ss::stop_iteration;
+    const model::offset o = e.offset + model::offset(e.delta);
+    if (_filter->removed().contains(o)) {
+        return ss::make_ready_future<stop_t>(stop_t::no);
+    }
+    return _writer->index(e.key, e.offset, e.delta)
+      .then([k = std::move(e.key)] {
+          return ss::make_ready_future<stop_t>(stop_t::no);
+      });
+}
+
 ss::future<ss::stop_iteration>
 compacted_offset_list_reducer::operator()(compacted_index::entry&& e) {
     using stop_t = ss::stop_iteration;
@@ -113,6 +135,56 @@ compacted_offset_list_reducer::operator()(compacted_index::entry&& e) {
     return ss::make_ready_future<stop_t>(stop_t::no);
 }
 
+bool key_offset_map::put(bytes_view key, model::offset o) {
+    auto fp = fingerprint(key);
+    if (auto it = _offsets.find(fp); it != _offsets.end()) {
+        it->second = std::max(it->second, o);
+        return true;
+    }
+    if (_offsets.size() >= _max_keys) {
+        return false;
+    }
+    _offsets.emplace(fp, o);
+    return true;
+}
+
+std::optional<model::offset> key_offset_map::get(bytes_view key) const {
+    if (auto it = _offsets.find(fingerprint(key)); it != _offsets.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+ss::future<ss::stop_iteration>
+key_offset_map_builder_reducer::operator()(compacted_index::entry&& e) {
+    using stop_t = ss::stop_iteration;
+    const model::offset o = e.offset + model::offset(e.delta);
+    // the record may be aborted, it must not supersede older records
+    if (_filter && _filter->in_aborted_span(o)) {
+        return ss::make_ready_future<stop_t>(stop_t::no);
+    }
+    if (!_map->put(e.key, o)) {
+        _full = true;
+        return ss::make_ready_future<stop_t>(stop_t::yes);
+    }
+    return ss::make_ready_future<stop_t>(stop_t::no);
+}
+
+ss::future<ss::stop_iteration>
+key_offset_map_filter_reducer::operator()(compacted_index::entry&& e) {
+    using stop_t = ss::stop_iteration;
+    const model::offset o = e.offset + model::offset(e.delta);
+    auto latest = _map->get(e.key);
+    if (!latest || *latest <= o) {
+        _entries.add(_natural_index);
+        _offsets.add(o);
+    } else {
+        ++_removed;
+    }
+    ++_natural_index;
+    return ss::make_ready_future<stop_t>(stop_t::no);
+}
+
 std::optional<model::record_batch>
 copy_data_segment_reducer::filter(model::record_batch&& batch) {
     // do not compact raft configuration and archival metadata as they shift
@@ -123,13 +195,23 @@ copy_data_segment_reducer::filter(model::record_batch&& batch) {
 
     // 1. compute which records to keep
     const auto base = batch.base_offset();
+    const auto& hdr = batch.header();
+    const bool aborted = _filter && _filter->is_aborted(hdr);
     std::vector<int32_t> offset_deltas;
     offset_deltas.reserve(batch.record_count());
-    batch.for_each_record([this, base, &offset_deltas](const model::record& r) {
-        if (should_keep(base, r.offset_delta())) {
-            offset_deltas.push_back(r.offset_delta());
-        }
-    });
+    batch.for_each_record(
+      [this, base, &hdr, aborted, &offset_deltas](const model::record& r) {
+          if (!should_keep(base, r.offset_delta())) {
+              return;
+          }
+          if (
+            _filter
+            && (aborted || _filter->is_expired_tombstone(hdr, r))) {
+              _filter->record_removed(base + model::offset(r.offset_delta()));
+              return;
+          }
+          offset_deltas.push_back(r.offset_delta());
+      });
 
     // 2. no record to keep
     if (offset_deltas.empty()) {
@@ -238,17 +320,14 @@ ss::future<ss::stop_iteration> copy_data_segment_reducer::do_compaction(
           return ss::do_with(std::move(b), [this](model::record_batch& batch) {
               auto const start_offset = _appender->file_byte_offset();
               auto const header_size = batch.header().size_bytes;
-              _acc += header_size;
-              if (_idx.maybe_index(
-                    _acc,
-                    32_KiB,
-                    start_offset,
-                    batch.base_offset(),
-                    batch.last_offset(),
-                    batch.header().first_timestamp,
-                    batch.header().max_timestamp)) {
-                  _acc = 0;
-              }
+              _idx.maybe_index(
+                _density,
+                header_size,
+                start_offset,
+                batch.base_offset(),
+                batch.last_offset(),
+                batch.header().first_timestamp,
+                batch.header().max_timestamp);
               return storage::write(*_appender, batch)
                 .then([this, start_offset, header_size] {
                     vassert(
@@ -265,6 +344,16 @@ ss::future<ss::stop_iteration> copy_data_segment_reducer::do_compaction(
 
 ss::future<ss::stop_iteration>
 copy_data_segment_reducer::operator()(model::record_batch&& b) {
+    if (!_throttle) {
+        return do_copy(std::move(b));
+    }
+    auto f = _throttle->throttle(b.size_bytes());
+    return f.then(
+      [this, b = std::move(b)]() mutable { return do_copy(std::move(b)); });
+}
+
+ss::future<ss::stop_iteration>
+copy_data_segment_reducer::do_copy(model::record_batch&& b) {
     const auto comp = b.header().attrs.compression();
     if (!b.compressed()) {
         return do_compaction(comp, std::move(b));
@@ -278,16 +367,18 @@ copy_data_segment_reducer::operator()(model::record_batch&& b) {
 ss::future<ss::stop_iteration>
 index_rebuilder_reducer::operator()(model::record_batch&& b) {
     using stop_t = ss::stop_iteration;
-    auto f = ss::now();
-    if (!b.compressed()) {
-        f = do_index(std::move(b));
-    } else {
-        f = internal::decompress_batch(std::move(b))
-              .then([this](model::record_batch&& b) {
-                  return do_index(std::move(b));
-              });
-    }
-    return f.then([] { return ss::make_ready_future<stop_t>(stop_t::no); });
+    auto f = _throttle ? _throttle->throttle(b.size_bytes()) : ss::now();
+    return f
+      .then([this, b = std::move(b)]() mutable {
+          if (!b.compressed()) {
+              return do_index(std::move(b));
+          }
+          return internal::decompress_batch(std::move(b))
+            .then([this](model::record_batch&& b) {
+                return do_index(std::move(b));
+            });
+      })
+      .then([] { return ss::make_ready_future<stop_t>(stop_t::no); });
 }
 
 ss::future<> index_rebuilder_reducer::do_index(model::record_batch&& b) {
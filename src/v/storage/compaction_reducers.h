@@ -17,12 +17,15 @@
 #include "storage/compacted_index.h"
 #include "storage/compacted_index_writer.h"
 #include "storage/compacted_offset_list.h"
+#include "storage/compaction_filter.h"
+#include "storage/compaction_throttle.h"
 #include "storage/index_state.h"
 #include "storage/logger.h"
 #include "storage/segment_appender.h"
 #include "units.h"
 
 #include <absl/container/btree_map.h>
+#include <absl/container/flat_hash_map.h>
 #include <absl/container/node_hash_map.h>
 #include <fmt/core.h>
 #include <roaring/roaring.hh>
@@ -47,8 +50,11 @@ public:
       bytes_hasher<uint64_t, xxhash_64>,
       bytes_type_eq>;
 
-    explicit compaction_key_reducer(size_t max_mem = default_max_memory_usage)
-      : _max_mem(max_mem) {}
+    explicit compaction_key_reducer(
+      size_t max_mem = default_max_memory_usage,
+      const compaction_filter* filter = nullptr)
+      : _max_mem(max_mem)
+      , _filter(filter) {}
 
     ss::future<ss::stop_iteration> operator()(compacted_index::entry&&);
     Roaring end_of_stream();
@@ -63,6 +69,7 @@ private:
     underlying_t _indices;
     size_t _keys_mem_usage{0};
     size_t _max_mem{0};
+    const compaction_filter* _filter;
     uint32_t _natural_index{0};
 };
 
@@ -83,6 +90,23 @@ private:
     compacted_index_writer* _writer;
 };
 
+/// Copies the input reader into the writer except the entries of the records
+/// removed by the compaction_filter
+class index_removed_filter_copy_reducer : public compaction_reducer {
+public:
+    index_removed_filter_copy_reducer(
+      const compaction_filter& f, compacted_index_writer& w)
+      : _filter(&f)
+      , _writer(&w) {}
+
+    ss::future<ss::stop_iteration> operator()(compacted_index::entry&&);
+    void end_of_stream() {}
+
+private:
+    const compaction_filter* _filter;
+    compacted_index_writer* _writer;
+};
+
 class index_copy_reducer : public compaction_reducer {
 public:
     explicit index_copy_reducer(compacted_index_writer& w)
@@ -109,14 +133,21 @@ private:
 
 class copy_data_segment_reducer : public compaction_reducer {
 public:
-    copy_data_segment_reducer(compacted_offset_list l, segment_appender* a)
+    copy_data_segment_reducer(
+      compacted_offset_list l,
+      segment_appender* a,
+      compaction_throttle* throttle = nullptr,
+      compaction_filter* filter = nullptr)
       : _list(std::move(l))
-      , _appender(a) {}
+      , _appender(a)
+      , _throttle(throttle)
+      , _filter(filter) {}
 
     ss::future<ss::stop_iteration> operator()(model::record_batch&&);
     storage::index_state end_of_stream() { return std::move(_idx); }
 
 private:
+    ss::future<ss::stop_iteration> do_copy(model::record_batch&&);
     ss::future<ss::stop_iteration>
     do_compaction(model::compression, model::record_batch&&);
 
@@ -128,14 +159,101 @@ private:
 
     compacted_offset_list _list;
     segment_appender* _appender;
+    compaction_throttle* _throttle;
+    compaction_filter* _filter;
     index_state _idx;
-    size_t _acc{0};
+    index_density _density{32_KiB};
+};
+
+/// Latest offset of every key in a window of segments
+///
+/// The keys are stored as 64-bit fingerprints to bound the memory usage by
+/// the number of keys rather than their size. A fingerprint collision makes
+/// the older of the two records look superseded, with 64-bit hashes the
+/// probability is negligible for the number of keys that fit into memory.
+class key_offset_map {
+public:
+    /// Estimated memory used by a single key of the map
+    static constexpr size_t entry_memory_usage = 32;
+
+    explicit key_offset_map(size_t max_keys)
+      : _max_keys(max_keys) {}
+
+    /// Record offset of the key, keeps the largest offset. Returns false if
+    /// the key is new and the map is full.
+    bool put(bytes_view key, model::offset o);
+
+    /// Latest offset of the key
+    std::optional<model::offset> get(bytes_view key) const;
+
+    size_t size() const { return _offsets.size(); }
+
+private:
+    static uint64_t fingerprint(bytes_view key) {
+        return xxhash_64(key.data(), key.size());
+    }
+
+    absl::flat_hash_map<uint64_t, model::offset> _offsets;
+    size_t _max_keys;
+};
+
+/// Adds the entries of the compaction index to the key_offset_map, stops
+/// when the map is full. Returns true if all entries were added.
+class key_offset_map_builder_reducer : public compaction_reducer {
+public:
+    explicit key_offset_map_builder_reducer(
+      key_offset_map& m, const compaction_filter* filter = nullptr)
+      : _map(&m)
+      , _filter(filter) {}
+
+    ss::future<ss::stop_iteration> operator()(compacted_index::entry&&);
+    bool end_of_stream() const { return !_full; }
+
+private:
+    key_offset_map* _map;
+    const compaction_filter* _filter;
+    bool _full{false};
+};
+
+/// Selects the entries of the compaction index that are not superseded by a
+/// newer offset of the same key in the key_offset_map
+class key_offset_map_filter_reducer : public compaction_reducer {
+public:
+    struct result {
+        /// Natural indices of the index entries to keep
+        Roaring entries;
+        /// Offsets of the records to keep
+        compacted_offset_list offsets;
+        size_t removed;
+    };
+
+    key_offset_map_filter_reducer(const key_offset_map& m, model::offset base)
+      : _map(&m)
+      , _offsets(base, Roaring{}) {}
+
+    ss::future<ss::stop_iteration> operator()(compacted_index::entry&&);
+    result end_of_stream() {
+        return result{
+          .entries = std::move(_entries),
+          .offsets = std::move(_offsets),
+          .removed = _removed};
+    }
+
+private:
+    const key_offset_map* _map;
+    Roaring _entries;
+    compacted_offset_list _offsets;
+    uint32_t _natural_index{0};
+    size_t _removed{0};
 };
 
 class index_rebuilder_reducer : public compaction_reducer {
 public:
-    explicit index_rebuilder_reducer(compacted_index_writer* w) noexcept
-      : _w(w) {}
+    explicit index_rebuilder_reducer(
+      compacted_index_writer* w,
+      compaction_throttle* throttle = nullptr) noexcept
+      : _w(w)
+      , _throttle(throttle) {}
     ss::future<ss::stop_iteration> operator()(model::record_batch&&);
     void end_of_stream() {}
 
@@ -143,6 +261,7 @@ private:
     ss::future<> do_index(model::record_batch&&);
 
     compacted_index_writer* _w;
+    compaction_throttle* _throttle;
 };
 
 } // namespace storage::internal
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "storage/compaction_throttle.h"
+
+#include "storage/logger.h"
+#include "vlog.h"
+
+#include <seastar/core/sleep.hh>
+#include <seastar/core/smp.hh>
+
+#include <yaml-cpp/yaml.h>
+
+#include <algorithm>
+
+namespace storage {
+
+namespace {
+// flushes slower than this are recorded as the maximum
+constexpr auto max_recorded_latency = std::chrono::seconds(10);
+// tokens accumulated while compaction is idle
+constexpr auto max_burst = std::chrono::milliseconds(100);
+
+hdr_hist make_latency_hist() {
+    return hdr_hist(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        max_recorded_latency),
+      std::chrono::microseconds(1));
+}
+} // namespace
+
+compaction_throttle::compaction_throttle(
+  config::binding<std::optional<size_t>> device_bandwidth,
+  config::binding<std::chrono::milliseconds> latency_target,
+  config::binding<std::chrono::milliseconds> update_interval)
+  : _device_bandwidth(std::move(device_bandwidth))
+  , _latency_target(std::move(latency_target))
+  , _update_interval(std::move(update_interval))
+  , _foreground_latency(make_latency_hist()) {}
+
+std::optional<size_t> compaction_throttle::shard_budget() const {
+    auto bandwidth = _device_bandwidth() ? _device_bandwidth()
+                                         : _detected_bandwidth;
+    if (!bandwidth || *bandwidth == 0) {
+        return std::nullopt;
+    }
+    return std::max<size_t>(*bandwidth / ss::smp::count, 1);
+}
+
+std::optional<size_t> compaction_throttle::rate() const {
+    if (!shard_budget()) {
+        return std::nullopt;
+    }
+    return _rate;
+}
+
+void compaction_throttle::set_detected_bandwidth(std::optional<size_t> bw) {
+    _detected_bandwidth = bw;
+}
+
+void compaction_throttle::record_foreground_latency(
+  std::chrono::microseconds latency) {
+    _foreground_latency.record(std::min<uint64_t>(
+      latency.count(),
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        max_recorded_latency)
+        .count()));
+}
+
+void compaction_throttle::maybe_update_rate(clock_type::time_point now) {
+    auto budget = shard_budget();
+    if (!budget) {
+        _rate = 0;
+        return;
+    }
+    // first use or the budget was lowered
+    if (_rate == 0 || _rate > *budget) {
+        _rate = *budget;
+        _last_update = now;
+    }
+    if (now - _last_update < _update_interval()) {
+        return;
+    }
+    _last_update = now;
+
+    auto p99 = std::chrono::microseconds(
+      _foreground_latency.get_value_at(99.0));
+    _foreground_latency = make_latency_hist();
+    const auto prev_rate = _rate;
+    if (p99 > _latency_target()) {
+        // foreground I/O is suffering, back off quickly
+        _rate = std::max<size_t>(_rate / 2, std::max<size_t>(*budget / 16, 1));
+    } else {
+        _rate = std::min(_rate + std::max<size_t>(*budget / 10, 1), *budget);
+    }
+    if (_rate != prev_rate) {
+        vlog(
+          gclog.debug,
+          "compaction rate {} -> {} bytes/s, flush latency p99: {}us, budget: "
+          "{} bytes/s",
+          prev_rate,
+          _rate,
+          p99.count(),
+          *budget);
+    }
+}
+
+void compaction_throttle::refill(clock_type::time_point now) {
+    const auto elapsed = std::chrono::duration<double>(now - _last_refill);
+    _last_refill = now;
+    const double max_tokens = static_cast<double>(_rate)
+                              * std::chrono::duration<double>(max_burst).count();
+    _tokens = std::min(
+      _tokens + elapsed.count() * static_cast<double>(_rate), max_tokens);
+}
+
+ss::future<> compaction_throttle::throttle(size_t bytes) {
+    const auto now = clock_type::now();
+    maybe_update_rate(now);
+    if (_rate == 0) {
+        return ss::now();
+    }
+    refill(now);
+    _tokens -= static_cast<double>(bytes);
+    if (_tokens >= 0) {
+        return ss::now();
+    }
+    // the debt is paid by sleeping, later callers wait for it as well
+    const auto delay = std::chrono::duration<double>(
+      -_tokens / static_cast<double>(_rate));
+    return ss::sleep(
+      std::chrono::duration_cast<std::chrono::microseconds>(delay));
+}
+
+std::optional<size_t> read_iotune_write_bandwidth(
+  const std::filesystem::path& io_properties,
+  const std::filesystem::path& data_dir) {
+    try {
+        auto root = YAML::LoadFile(io_properties.string());
+        auto disks = root["disks"];
+        if (!disks || !disks.IsSequence()) {
+            return std::nullopt;
+        }
+        // the disk with the longest mountpoint that contains data_dir
+        std::optional<size_t> bandwidth;
+        size_t mountpoint_len = 0;
+        for (const auto& disk : disks) {
+            if (!disk["mountpoint"] || !disk["write_bandwidth"]) {
+                continue;
+            }
+            auto mountpoint = std::filesystem::path(
+                                disk["mountpoint"].as<std::string>())
+                                .lexically_normal();
+            if (!mountpoint.has_filename()) {
+                mountpoint = mountpoint.parent_path();
+            }
+            auto [end, _] = std::mismatch(
+              mountpoint.begin(),
+              mountpoint.end(),
+              data_dir.begin(),
+              data_dir.end());
+            if (end != mountpoint.end()) {
+                continue;
+            }
+            auto len = mountpoint.string().size();
+            if (!bandwidth || len > mountpoint_len) {
+                bandwidth = disk["write_bandwidth"].as<uint64_t>();
+                mountpoint_len = len;
+            }
+        }
+        return bandwidth;
+    } catch (const std::exception& e) {
+        vlog(
+          stlog.warn,
+          "Unable to read iotune profile {}: {}",
+          io_properties,
+          e.what());
+        return std::nullopt;
+    }
+}
+
+} // namespace storage
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "config/property.h"
+#include "seastarx.h"
+#include "utils/hdr_hist.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/lowres_clock.hh>
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+
+namespace storage {
+
+/**
+ * Paces the I/O of compaction on a shard.
+ *
+ * Bytes read and written by compaction are charged against a token bucket
+ * refilled at the current compaction rate. The rate is bounded by the shard
+ * share of the device bandwidth, which is either configured or taken from
+ * the iotune profile of the data directory. Compaction is not throttled when
+ * the bandwidth is unknown.
+ *
+ * The rate adapts to the foreground I/O latency with AIMD: every update
+ * interval the rate is halved if p99 of the log flush latency is above the
+ * target, and grows by a tenth of the budget otherwise.
+ */
+class compaction_throttle {
+public:
+    using clock_type = ss::lowres_clock;
+
+    compaction_throttle(
+      config::binding<std::optional<size_t>> device_bandwidth,
+      config::binding<std::chrono::milliseconds> latency_target,
+      config::binding<std::chrono::milliseconds> update_interval);
+    compaction_throttle(const compaction_throttle&) = delete;
+    compaction_throttle& operator=(const compaction_throttle&) = delete;
+
+    /// Waits until compaction is allowed to transfer 'bytes'
+    ss::future<> throttle(size_t bytes);
+
+    /// Latency of a foreground log flush
+    void record_foreground_latency(std::chrono::microseconds);
+
+    /// Device bandwidth in bytes per second for the whole node, used when
+    /// the bandwidth is not configured
+    void set_detected_bandwidth(std::optional<size_t>);
+
+    /// Current compaction rate of the shard in bytes per second, nullopt if
+    /// compaction is not throttled
+    std::optional<size_t> rate() const;
+
+private:
+    std::optional<size_t> shard_budget() const;
+    void maybe_update_rate(clock_type::time_point now);
+    void refill(clock_type::time_point now);
+
+    config::binding<std::optional<size_t>> _device_bandwidth;
+    config::binding<std::chrono::milliseconds> _latency_target;
+    config::binding<std::chrono::milliseconds> _update_interval;
+    std::optional<size_t> _detected_bandwidth;
+
+    size_t _rate{0};
+    double _tokens{0};
+    clock_type::time_point _last_refill{clock_type::now()};
+    clock_type::time_point _last_update{clock_type::now()};
+    hdr_hist _foreground_latency;
+};
+
+/// Write bandwidth of the disk that holds 'data_dir' according to the iotune
+/// profile (the --io-properties-file of seastar), nullopt if the profile
+/// can't be read or doesn't describe the disk.
+std::optional<size_t> read_iotune_write_bandwidth(
+  const std::filesystem::path& io_properties,
+  const std::filesystem::path& data_dir);
+
+} // namespace storage
@@ -115,23 +115,26 @@ disk_log_appender::append_batch_to_segment(const model::record_batch& batch) {
         return ss::make_ready_future<ss::stop_iteration>(
           ss::stop_iteration::no);
     }
-    return _seg->append(batch).then([this](append_result r) {
-        _idx = r.last_offset + model::offset(1); // next base offset
-        _byte_size += r.byte_size;
-        // do not track base_offset, only the last one
-        _last_offset = r.last_offset;
-        auto& p = _log.get_probe();
-        p.add_bytes_written(r.byte_size);
-        p.batch_written();
+    auto m = _log.get_probe().append_latency().maybe_measure();
+    return _seg->append(batch).then(
+      [this, m = std::move(m)](append_result r) {
+          _idx = r.last_offset + model::offset(1); // next base offset
+          _byte_size += r.byte_size;
+          // do not track base_offset, only the last one
+          _last_offset = r.last_offset;
+          auto& p = _log.get_probe();
+          p.add_bytes_written(r.byte_size);
+          p.batch_written();
 
-        // Register increase in dirty bytes since last STM snapshot
-        _log.wrote_stm_bytes(r.byte_size);
+          // Register increase in dirty bytes since last STM snapshot
+          _log.wrote_stm_bytes(r.byte_size);
 
-        // substract the bytes from the append
-        // take the min because _bytes_left_in_segment is optimistic
-        _bytes_left_in_segment -= std::min(_bytes_left_in_segment, r.byte_size);
-        return ss::stop_iteration::no;
-    });
+          // substract the bytes from the append
+          // take the min because _bytes_left_in_segment is optimistic
+          _bytes_left_in_segment -= std::min(
+            _bytes_left_in_segment, r.byte_size);
+          return ss::stop_iteration::no;
+      });
 }
 
 ss::future<append_result> disk_log_appender::end_of_stream() {
@@ -16,6 +16,7 @@
 #include "model/timeout_clock.h"
 #include "model/timestamp.h"
 #include "reflection/adl.h"
+#include "storage/compaction_reducers.h"
 #include "storage/disk_log_appender.h"
 #include "storage/fwd.h"
 #include "storage/kvstore.h"
@@ -23,12 +24,15 @@
 #include "storage/logger.h"
 #include "storage/offset_assignment.h"
 #include "storage/offset_to_filepos_consumer.h"
+#include "storage/parser.h"
+#include "storage/parser_utils.h"
 #include "storage/readers_cache.h"
 #include "storage/segment.h"
 #include "storage/segment_set.h"
 #include "storage/segment_utils.h"
 #include "storage/types.h"
 #include "storage/version.h"
+#include "units.h"
 #include "utils/gate_guard.h"
 #include "vassert.h"
 #include "vlog.h"
@@ -73,6 +77,8 @@ disk_log_impl::disk_log_impl(
         }
     }
     _probe.initial_segments_count(_segs.size());
+    _probe.set_batch_cache_owner(_manager.cache_owner(config().ntp()));
+    _probe.set_topic_disk_usage(_manager.topic_usage(config().ntp()));
     _probe.setup_metrics(this->config().ntp());
 }
 disk_log_impl::~disk_log_impl() {
@@ -89,6 +95,7 @@ ss::future<> disk_log_impl::remove() {
     _closed = true;
     // wait for compaction to finish
     co_await _compaction_gate.close();
+    _probe.clear_topic_disk_usage();
     // gets all the futures started in the background
     std::vector<ss::future<>> permanent_delete;
     permanent_delete.reserve(_segs.size());
@@ -132,6 +139,7 @@ ss::future<std::optional<ss::sstring>> disk_log_impl::close() {
     // wait for compaction to finish
     vlog(stlog.trace, "waiting for {} compaction to finish", config().ntp());
     co_await _compaction_gate.close();
+    _probe.clear_topic_disk_usage();
     vlog(stlog.trace, "stopping {} readers cache", config().ntp());
 
     // close() on the segments is not expected to fail, but it might
@@ -334,6 +342,13 @@ ss::future<> disk_log_impl::do_compact(compaction_config cfg) {
       "[{}] applying 'compaction' log cleanup policy with config: {}",
       config().ntp(),
       cfg);
+    cfg.stms = stm_manager();
+    if (auto retention = config::shard_local_cfg()
+                           .storage_compaction_tombstone_retention_ms();
+        retention) {
+        cfg.tombstone_eviction_time = model::timestamp(
+          model::timestamp::now().value() - retention->count());
+    }
     // find first not compacted segment
 
     // loop until we compact segment or reached end of segments set
@@ -350,6 +365,8 @@ ss::future<> disk_log_impl::do_compact(compaction_config cfg) {
         }
 
         auto segment = *seg_it;
+        // the compacted copy is written next to the segment
+        auto reservation = resources().reserve_space(segment->size_bytes());
         auto result = co_await storage::internal::self_compact_segment(
           segment, cfg, _probe, *_readers_cache, _manager.resources());
 
@@ -365,6 +382,34 @@ ss::future<> disk_log_impl::do_compact(compaction_config cfg) {
         }
     }
 
+    if (auto window = find_compaction_window(); !window.empty()) {
+        const auto max_keys
+          = config::shard_local_cfg().storage_compaction_key_map_memory()
+            / internal::key_offset_map::entry_memory_usage;
+        _last_compaction_window_offset = window.back()->offsets().dirty_offset;
+        // segments of the window are rewritten one at a time
+        size_t largest = 0;
+        for (const auto& s : window) {
+            largest = std::max(largest, s->size_bytes());
+        }
+        auto reservation = resources().reserve_space(largest);
+        auto r = co_await storage::internal::compact_segment_window(
+          std::move(window),
+          cfg,
+          _probe,
+          *_readers_cache,
+          _manager.resources(),
+          max_keys);
+        vlog(
+          gclog.debug,
+          "[{}] segment window compaction result: {}",
+          config().ntp(),
+          r);
+        if (r.did_compact()) {
+            _compaction_ratio.update(r.compaction_ratio());
+        }
+    }
+
     if (auto range = find_compaction_range(); range) {
         auto r = co_await compact_adjacent_segments(std::move(*range), cfg);
         vlog(
@@ -445,6 +490,35 @@ disk_log_impl::find_compaction_range() {
     return range;
 }
 
+std::vector<ss::lw_shared_ptr<segment>>
+disk_log_impl::find_compaction_window() {
+    /*
+     * window compaction removes keys superseded by newer segments from all
+     * self compacted segments at once, the segments it shrinks are merged
+     * later on by the adjacent segment compaction. it runs again only when
+     * new segments were self compacted since the last window.
+     */
+    std::vector<ss::lw_shared_ptr<segment>> window;
+    if (config::shard_local_cfg().storage_compaction_key_map_memory() == 0) {
+        return window;
+    }
+    for (auto& s : _segs) {
+        if (
+          s->has_appender() || !s->is_compacted_segment()
+          || !s->finished_self_compaction()) {
+            break;
+        }
+        window.push_back(s);
+    }
+    if (
+      window.size() < 2
+      || window.back()->offsets().dirty_offset
+           <= _last_compaction_window_offset) {
+        window.clear();
+    }
+    return window;
+}
+
 ss::future<compaction_result> disk_log_impl::compact_adjacent_segments(
   std::pair<segment_set::iterator, segment_set::iterator> range,
   storage::compaction_config cfg) {
@@ -454,6 +528,13 @@ ss::future<compaction_result> disk_log_impl::compact_adjacent_segments(
     std::vector<ss::lw_shared_ptr<segment>> segments;
     std::copy(range.first, range.second, std::back_inserter(segments));
 
+    // the segments are concatenated into a staging copy
+    size_t range_size = 0;
+    for (const auto& s : segments) {
+        range_size += s->size_bytes();
+    }
+    auto reservation = resources().reserve_space(range_size);
+
     if (gclog.is_enabled(ss::log_level::debug)) {
         std::stringstream segments_str;
         for (size_t i = 0; i < segments.size(); i++) {
@@ -585,6 +666,23 @@ disk_log_impl::apply_overrides(compaction_config defaults) const {
         ret.eviction_time = model::timestamp(
           model::timestamp::now().value() - retention_time.value().count());
     }
+    /**
+     * Data uploaded to cloud storage can be read from there, so the local
+     * copy is capped by the local targets. Segments that are not uploaded yet
+     * are kept by the collectible offset.
+     */
+    if (config().is_archival_enabled()) {
+        const auto& cfg = config::shard_local_cfg();
+        if (auto target = cfg.retention_local_target_bytes(); target) {
+            ret.max_bytes = std::min(ret.max_bytes.value_or(*target), *target);
+        }
+        if (auto target = cfg.retention_local_target_ms(); target) {
+            ret.eviction_time = std::max(
+              ret.eviction_time,
+              model::timestamp(
+                model::timestamp::now().value() - target->count()));
+        }
+    }
     return ret;
 }
 
@@ -617,16 +715,7 @@ ss::future<> disk_log_impl::compact(compaction_config cfg) {
     });
 }
 
-ss::future<> disk_log_impl::gc(compaction_config cfg) {
-    vassert(!_closed, "gc on closed log - {}", *this);
-    vlog(
-      gclog.trace,
-      "[{}] applying 'deletion' log cleanup policy with config: {}",
-      config().ntp(),
-      cfg);
-    if (unlikely(cfg.asrc->abort_requested())) {
-        return ss::make_ready_future<>();
-    }
+bool disk_log_impl::is_gc_exempt() const {
     // TODO: this a workaround until we have raft-snapshotting in the the
     // controller so that we can still evict older data. At the moment we keep
     // the full history.
@@ -637,7 +726,90 @@ ss::future<> disk_log_impl::gc(compaction_config cfg) {
                                == model::kafka_internal_namespace
                              && config().ntp().tp.topic
                                   == model::tx_manager_topic;
-    if (!is_tx_manager_ntp && is_internal_namespace) {
+    return !is_tx_manager_ntp && is_internal_namespace;
+}
+
+std::optional<model::timestamp>
+disk_log_impl::reclaimable_segment_timestamp() const {
+    /*
+     * only data that retention could remove as well is reclaimed: logs of
+     * the delete cleanup policy, up to the collectible offset which protects
+     * e.g. the data not uploaded to the cloud yet. the active segment is
+     * never removed.
+     */
+    if (
+      _closed || is_gc_exempt() || !config().is_collectable()
+      || (config().has_overrides()
+          && config().get_overrides().cleanup_policy_bitflags
+               == model::cleanup_policy_bitflags::none)) {
+        return std::nullopt;
+    }
+    if (
+      _segs.size() <= 1
+      || _segs.front()->offsets().committed_offset > _max_collectible_offset) {
+        return std::nullopt;
+    }
+    return _segs.front()->index().max_timestamp();
+}
+
+ss::future<size_t>
+disk_log_impl::reclaim_oldest_segment(ss::abort_source& as) {
+    return ss::try_with_gate(_compaction_gate, [this, &as] {
+        if (!reclaimable_segment_timestamp()) {
+            return ss::make_ready_future<size_t>(0);
+        }
+        auto front = _segs.front();
+        const auto size = front->size_bytes();
+        return garbage_collect_segments(
+                 front->offsets().committed_offset, &as, "gc[disk_space]")
+          .then([this, front, size] {
+              // still there if e.g. the removal was aborted
+              return is_front_segment(front) ? size_t{0} : size;
+          });
+    });
+}
+
+bool disk_log_impl::needs_housekeeping(const compaction_config& cfg) const {
+    if (_segs.empty()) {
+        return false;
+    }
+    if (config().is_compacted()) {
+        // compaction keeps track of the segments it already compacted
+        return true;
+    }
+    if (
+      !config().is_collectable()
+      || (config().has_overrides()
+          && config().get_overrides().cleanup_policy_bitflags
+               == model::cleanup_policy_bitflags::none)) {
+        return false;
+    }
+    auto effective = apply_overrides(cfg);
+    if (
+      effective.max_bytes
+      && _probe.partition_size() > effective.max_bytes.value()) {
+        return true;
+    }
+    /*
+     * time based retention removes segments from the front of the log, so the
+     * next removal is due once the front segment falls behind the eviction
+     * time. the active segment is never removed.
+     */
+    return _segs.size() > 1
+           && _segs.front()->index().max_timestamp() <= effective.eviction_time;
+}
+
+ss::future<> disk_log_impl::gc(compaction_config cfg) {
+    vassert(!_closed, "gc on closed log - {}", *this);
+    vlog(
+      gclog.trace,
+      "[{}] applying 'deletion' log cleanup policy with config: {}",
+      config().ntp(),
+      cfg);
+    if (unlikely(cfg.asrc->abort_requested())) {
+        return ss::make_ready_future<>();
+    }
+    if (is_gc_exempt()) {
         vlog(
           gclog.trace,
           "[{}] skipped log deletion, internal topic",
@@ -797,7 +969,18 @@ ss::future<> disk_log_impl::flush() {
     if (_segs.empty()) {
         return ss::make_ready_future<>();
     }
-    return _segs.back()->flush();
+    // foreground flush latency paces compaction and recovery I/O
+    auto m = _probe.flush_latency().maybe_measure();
+    return _segs.back()->flush().then(
+      [this, start = std::chrono::steady_clock::now(), m = std::move(m)] {
+          auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+          auto& resources = _manager.resources();
+          resources.get_compaction_throttle().record_foreground_latency(
+            latency);
+          resources.get_io_share_controller().record_latency(
+            io_share_controller::latency_class::produce, latency);
+      });
 }
 
 size_t disk_log_impl::max_segment_size() const {
@@ -910,32 +1093,191 @@ disk_log_impl::make_reader(log_reader_config config) {
         return ss::make_ready_future<model::record_batch_reader>(
           std::move(empty));
     }
+    if (!config.skip_batch_cache && is_catch_up_read(config.start_offset)) {
+        // the reader still uses cached batches, but does not insert or
+        // promote them, so a backfill can not evict the hot tail of the log
+        config.skip_batch_cache = true;
+    }
     return make_cached_reader(config);
 }
 
+bool disk_log_impl::is_catch_up_read(model::offset o) const {
+    const auto max_lag
+      = config::shard_local_cfg().batch_cache_max_read_lag_bytes();
+    if (!max_lag) {
+        return false;
+    }
+    // only the segments following the one containing the offset are
+    // accounted, which is precise enough given the segment sizes
+    size_t behind = 0;
+    for (auto i = _segs.size(); i > 0; --i) {
+        const auto& seg = _segs[i - 1];
+        if (seg->offsets().base_offset <= o) {
+            return false;
+        }
+        behind += seg->size_bytes();
+        if (behind > *max_lag) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Appends whole buffers read from the stream to `buf` until it holds at least
+ * `n` bytes. Returns false if the stream ends before.
+ */
+static ss::future<bool>
+read_at_least(ss::input_stream<char>& in, iobuf& buf, size_t n) {
+    while (buf.size_bytes() < n) {
+        auto tmp = co_await in.read();
+        if (tmp.empty()) {
+            co_return false;
+        }
+        buf.append(std::move(tmp));
+    }
+    co_return true;
+}
+
+ss::future<std::optional<extent_read_result>>
+disk_log_impl::read_extent(extent_read_config cfg) {
+    vassert(!_closed, "read_extent on closed log - {}", *this);
+    using ret_t = std::optional<extent_read_result>;
+    if (
+      config().is_compacted() || cfg.start_offset < _start_offset
+      || cfg.start_offset > cfg.max_offset) {
+        co_return ret_t{};
+    }
+
+    log_reader_config reader_cfg(cfg.start_offset, cfg.max_offset, cfg.prio);
+    auto lease = co_await _lock_mngr.range_lock(reader_cfg);
+    if (lease->range.empty()) {
+        co_return ret_t{};
+    }
+    auto seg = lease->range.front();
+    /*
+     * only the flushed prefix of a segment is visible to on-disk reads, the
+     * unflushed tail is served by the regular reader from the batch cache.
+     * compacted segments may contain gaps, which would break the constant
+     * offset delta guarantee given to callers.
+     */
+    const auto stable = seg->offsets().stable_offset;
+    if (
+      seg->is_compacted_segment() || cfg.start_offset > stable
+      || cfg.start_offset < seg->offsets().base_offset) {
+        co_return ret_t{};
+    }
+    const auto max_offset = std::min(cfg.max_offset, stable);
+
+    extent_read_result res{.term = seg->offsets().term};
+    auto handle = co_await seg->offset_data_stream(cfg.start_offset, cfg.prio);
+    std::exception_ptr e;
+    try {
+        auto& in = handle.stream();
+        /*
+         * batches are parsed in place in the buffers read from the stream and
+         * the extent is shared out of them at once, rather than reading an
+         * iobuf for every header and body. `buf` starts at the first batch of
+         * the extent, of which `extent_size` bytes were accepted.
+         */
+        iobuf buf;
+        size_t extent_size = 0;
+        while (true) {
+            if (!co_await read_at_least(
+                  in,
+                  buf,
+                  extent_size + model::packed_record_batch_header_size)) {
+                break;
+            }
+            auto hdr = header_from_iobuf(
+              buf.share(extent_size, model::packed_record_batch_header_size));
+            if (unlikely(
+                  hdr.header_crc != model::internal_header_only_crc(hdr))) {
+                // let the regular reader deal with corruption
+                res = extent_read_result{};
+                extent_size = 0;
+                break;
+            }
+            if (hdr.base_offset > max_offset || hdr.last_offset() > stable) {
+                break;
+            }
+            const size_t batch_size = hdr.size_bytes;
+            if (hdr.last_offset() < cfg.start_offset) {
+                // batches are only skipped before the extent starts
+                if (buf.size_bytes() >= batch_size) {
+                    buf.trim_front(batch_size);
+                } else {
+                    const auto left = batch_size - buf.size_bytes();
+                    buf.clear();
+                    co_await in.skip(left);
+                }
+                continue;
+            }
+            if (hdr.type != cfg.type) {
+                break;
+            }
+            const auto over_budget = extent_size + batch_size > cfg.max_bytes;
+            if (
+              over_budget
+              && (!res.headers.empty() || cfg.strict_max_bytes)) {
+                break;
+            }
+            if (!co_await read_at_least(in, buf, extent_size + batch_size)) {
+                break;
+            }
+            if (res.headers.empty()) {
+                res.base_offset = hdr.base_offset;
+            }
+            res.last_offset = hdr.last_offset();
+            res.record_count += hdr.record_count;
+            res.headers.push_back(hdr);
+            extent_size += batch_size;
+            if (extent_size >= cfg.max_bytes) {
+                break;
+            }
+        }
+        res.data = buf.share(0, extent_size);
+    } catch (...) {
+        e = std::current_exception();
+    }
+    co_await handle.close();
+    if (e) {
+        std::rethrow_exception(e);
+    }
+    if (res.headers.empty()) {
+        co_return ret_t{};
+    }
+    _probe.add_bytes_read(res.data.size_bytes());
+    co_return res;
+}
+
 ss::future<model::record_batch_reader>
 disk_log_impl::make_reader(timequery_config config) {
     vassert(!_closed, "make_reader on closed log - {}", *this);
-    return _lock_mngr.range_lock(config).then(
-      [this, cfg = config](std::unique_ptr<lock_manager::lease> lease) {
-          auto start_offset = _start_offset;
-          if (!lease->range.empty()) {
-              // adjust for partial visibility of segment prefix
-              start_offset = std::max(
-                start_offset, (*lease->range.begin())->offsets().base_offset);
-          }
-          log_reader_config config(
-            start_offset,
-            cfg.max_offset,
-            0,
-            2048, // We just need one record batch
-            cfg.prio,
-            cfg.type_filter,
-            cfg.time,
-            cfg.abort_source);
-          return model::make_record_batch_reader<log_reader>(
-            std::move(lease), config, _probe);
-      });
+    auto lease = co_await _lock_mngr.range_lock(config);
+    auto start_offset = _start_offset;
+    if (!lease->range.empty()) {
+        // skip the batches of the first segment that the time index places
+        // before the timestamp rather than scanning it from the start
+        auto& first = *lease->range.begin();
+        start_offset = std::max(start_offset, first->offsets().base_offset);
+        auto nearest = co_await first->index().find_nearest_async(
+          config.time);
+        if (nearest) {
+            start_offset = std::max(start_offset, nearest->offset);
+        }
+    }
+    log_reader_config reader_cfg(
+      start_offset,
+      config.max_offset,
+      0,
+      2048, // We just need one record batch
+      config.prio,
+      config.type_filter,
+      config.time,
+      config.abort_source);
+    co_return model::make_record_batch_reader<log_reader>(
+      std::move(lease), reader_cfg, _probe);
 }
 
 std::optional<model::term_id> disk_log_impl::get_term(model::offset o) const {
@@ -992,6 +1334,199 @@ disk_log_impl::timequery(timequery_config cfg) {
       });
 }
 
+namespace {
+/// Keeps the latest record of a key among the batches of a range
+class key_lookup_consumer {
+public:
+    key_lookup_consumer(
+      const iobuf& key, model::offset start, model::offset max) noexcept
+      : _key(key)
+      , _start(start)
+      , _max(max) {}
+
+    ss::future<ss::stop_iteration> operator()(model::record_batch b) {
+        if (!b.compressed()) {
+            consume_records(b);
+            return ss::make_ready_future<ss::stop_iteration>(
+              ss::stop_iteration::no);
+        }
+        return internal::decompress_batch(std::move(b))
+          .then([this](model::record_batch b) {
+              consume_records(b);
+              return ss::stop_iteration::no;
+          });
+    }
+
+    std::optional<key_lookup_result> end_of_stream() {
+        return std::move(_result);
+    }
+
+private:
+    void consume_records(const model::record_batch& b) {
+        b.for_each_record([this, &b](model::record r) {
+            const auto o = b.base_offset() + model::offset(r.offset_delta());
+            if (
+              o < _start || o > _max || r.key_size() < 0 || r.key() != _key) {
+                return;
+            }
+            std::optional<iobuf> value;
+            if (r.has_value()) {
+                value = r.release_value();
+            }
+            _result = key_lookup_result{.offset = o, .value = std::move(value)};
+        });
+    }
+
+    const iobuf& _key;
+    model::offset _start;
+    model::offset _max;
+    std::optional<key_lookup_result> _result;
+};
+
+/// Offset of the latest entry of a key in a compaction index
+class index_lookup_consumer {
+public:
+    index_lookup_consumer(
+      compaction_key key, model::offset start, model::offset max) noexcept
+      : _key(std::move(key))
+      , _start(start)
+      , _max(max) {}
+
+    ss::future<ss::stop_iteration> operator()(compacted_index::entry&& e) {
+        if (e.type == compacted_index::entry_type::key && e.key == _key) {
+            const auto o = e.offset + model::offset(e.delta);
+            if (o >= _start && o <= _max) {
+                _offset = std::max(_offset.value_or(o), o);
+            }
+        }
+        return ss::make_ready_future<ss::stop_iteration>(
+          ss::stop_iteration::no);
+    }
+
+    std::optional<model::offset> end_of_stream() { return _offset; }
+
+private:
+    compaction_key _key;
+    model::offset _start;
+    model::offset _max;
+    std::optional<model::offset> _offset;
+};
+} // namespace
+
+ss::future<std::optional<key_lookup_result>> disk_log_impl::key_lookup_range(
+  const iobuf& key,
+  model::offset start,
+  model::offset max,
+  const key_lookup_config& cfg,
+  bool skip_batch_cache) {
+    log_reader_config reader_cfg(
+      start,
+      max,
+      0,
+      std::numeric_limits<size_t>::max(),
+      cfg.prio,
+      model::record_batch_type::raft_data,
+      std::nullopt,
+      cfg.abort_source);
+    reader_cfg.skip_batch_cache = skip_batch_cache;
+    auto reader = co_await make_reader(reader_cfg);
+    co_return co_await std::move(reader).consume(
+      key_lookup_consumer(key, start, max), model::no_timeout);
+}
+
+ss::future<std::optional<std::optional<model::offset>>>
+disk_log_impl::key_lookup_index(
+  ss::lw_shared_ptr<segment> seg,
+  const key_lookup_config& cfg,
+  model::offset start,
+  model::offset max) {
+    using ret_t = std::optional<std::optional<model::offset>>;
+    // compaction rewrites the index under the write lock of the segment
+    auto holder = co_await seg->read_lock();
+    if (seg->is_closed() || seg->has_appender()) {
+        co_return ret_t{};
+    }
+    auto path = compacted_index_path(seg->reader().filename());
+    if (!co_await ss::file_exists(path.string())) {
+        co_return ret_t{};
+    }
+    auto f = co_await make_reader_handle(
+      path, _manager.config().sanitize_fileops);
+    auto reader = make_file_backed_compacted_reader(
+      path.string(), std::move(f), cfg.prio, 64_KiB);
+    ret_t ret;
+    try {
+        auto footer = co_await reader.load_footer();
+        // keys of older indices are not prefixed with the batch type
+        if (
+          footer.version
+          >= compacted_index::footer::key_prefixed_with_batch_type) {
+            reader.reset();
+            ret = co_await reader.consume(
+              index_lookup_consumer(
+                prefix_with_batch_type(
+                  model::record_batch_type::raft_data, cfg.key),
+                start,
+                max),
+              model::no_timeout);
+        }
+    } catch (...) {
+        vlog(
+          stlog.debug,
+          "{} - cannot use compaction index {} for key lookup: {}",
+          config().ntp(),
+          path,
+          std::current_exception());
+    }
+    co_await reader.close();
+    co_return ret;
+}
+
+ss::future<std::optional<key_lookup_result>>
+disk_log_impl::key_lookup(key_lookup_config cfg) {
+    vassert(!_closed, "key_lookup on closed log - {}", *this);
+    const auto key = bytes_to_iobuf(cfg.key);
+    // newest segments first, the first one holding the key has its latest
+    // record
+    std::vector<ss::lw_shared_ptr<segment>> segs(_segs.rbegin(), _segs.rend());
+    for (auto& seg : segs) {
+        if (cfg.abort_source) {
+            cfg.abort_source->get().check();
+        }
+        const auto offsets = seg->offsets();
+        if (offsets.dirty_offset < _start_offset) {
+            break;
+        }
+        const auto start = std::max(offsets.base_offset, _start_offset);
+        const auto max = std::min(offsets.dirty_offset, cfg.max_offset);
+        if (start > max) {
+            continue;
+        }
+        // the index only keeps the latest offset of every key, it can not
+        // tell about the older records of a key below max_offset
+        if (!seg->has_appender() && max == offsets.dirty_offset) {
+            auto indexed = co_await key_lookup_index(seg, cfg, start, max);
+            if (indexed) {
+                if (!*indexed) {
+                    continue;
+                }
+                auto o = **indexed;
+                auto res = co_await key_lookup_range(key, o, o, cfg, false);
+                if (res) {
+                    co_return res;
+                }
+                // the index is ahead of the data, e.g. the segment was
+                // truncated, fall back to scanning it
+            }
+        }
+        auto res = co_await key_lookup_range(key, start, max, cfg, true);
+        if (res) {
+            co_return res;
+        }
+    }
+    co_return std::nullopt;
+}
+
 ss::future<> disk_log_impl::remove_segment_permanently(
   ss::lw_shared_ptr<segment> s, std::string_view ctx) {
     vlog(stlog.info, "{} - tombstone & delete segment: {}", ctx, s);
@@ -1124,6 +1659,10 @@ ss::future<> disk_log_impl::do_truncate(truncate_config cfg) {
     }
 
     cfg.base_offset = std::max(cfg.base_offset, _start_offset);
+    // segments written after the truncation have to be picked up by the
+    // window compaction even if their offsets were compacted before
+    _last_compaction_window_offset = std::min(
+      _last_compaction_window_offset, model::prev_offset(cfg.base_offset));
     // Note different from the stats variable above because
     // we want to delete even empty segments.
     if (
@@ -1151,7 +1690,7 @@ ss::future<> disk_log_impl::do_truncate(truncate_config cfg) {
     // offset
     model::offset start = last->offsets().base_offset;
 
-    auto pidx = last->index().find_nearest(
+    auto pidx = co_await last->index().find_nearest_async(
       std::max(start, model::prev_offset(cfg.base_offset)));
     size_t initial_size = 0;
     if (pidx) {
@@ -72,11 +72,15 @@ public:
 
     ss::future<model::record_batch_reader> make_reader(log_reader_config) final;
     ss::future<model::record_batch_reader> make_reader(timequery_config);
+    ss::future<std::optional<extent_read_result>>
+      read_extent(extent_read_config) final;
     // External synchronization: only one append can be performed at a time.
     log_appender make_appender(log_append_config cfg) final;
     /// timequery
     ss::future<std::optional<timequery_result>>
     timequery(timequery_config cfg) final;
+    ss::future<std::optional<key_lookup_result>>
+      key_lookup(key_lookup_config) final;
     size_t segment_count() const final { return _segs.size(); }
     offset_stats offsets() const final;
     std::optional<model::term_id> get_term(model::offset) const final;
@@ -102,6 +106,15 @@ public:
 
     int64_t compaction_backlog() const final;
 
+    bool needs_housekeeping(const compaction_config&) const final;
+
+    /// Max timestamp of the oldest segment that may be removed to reclaim
+    /// disk space, std::nullopt if none may be
+    std::optional<model::timestamp> reclaimable_segment_timestamp() const;
+    /// Removes the oldest segment to reclaim disk space beyond the retention
+    /// settings, returns the bytes removed
+    ss::future<size_t> reclaim_oldest_segment(ss::abort_source&);
+
 private:
     friend class disk_log_appender; // for multi-term appends
     friend class disk_log_builder;  // for tests
@@ -113,6 +126,25 @@ private:
     ss::future<model::record_batch_reader>
       make_cached_reader(log_reader_config);
 
+    // true when a read starting at the offset is far enough behind the end
+    // of the log to not be worth populating the batch cache
+    bool is_catch_up_read(model::offset) const;
+
+    // latest record of the key in [start, max]
+    ss::future<std::optional<key_lookup_result>> key_lookup_range(
+      const iobuf& key,
+      model::offset start,
+      model::offset max,
+      const key_lookup_config&,
+      bool skip_batch_cache);
+    // offset of the latest record of the key in [start, max] according to the
+    // compaction index of the segment, std::nullopt if it can not be used
+    ss::future<std::optional<std::optional<model::offset>>> key_lookup_index(
+      ss::lw_shared_ptr<segment>,
+      const key_lookup_config&,
+      model::offset start,
+      model::offset max);
+
     model::offset read_start_offset() const;
 
     // Postcondition: _start_offset is at least o and stays >= o in the future.
@@ -125,6 +157,7 @@ private:
       storage::compaction_config cfg);
     std::optional<std::pair<segment_set::iterator, segment_set::iterator>>
     find_compaction_range();
+    std::vector<ss::lw_shared_ptr<segment>> find_compaction_window();
     ss::future<> gc(compaction_config);
 
     ss::future<> remove_empty_segments();
@@ -162,6 +195,8 @@ private:
     void wrote_stm_bytes(size_t);
 
 private:
+    // internal logs keep their full history, see gc()
+    bool is_gc_exempt() const;
     size_t max_segment_size() const;
     // Computes the segment size based on the latest max_segment_size
     // configuration. This takes into consideration any segment size
@@ -190,6 +225,8 @@ private:
     std::unique_ptr<readers_cache> _readers_cache;
     // average ratio of segment sizes after segment size before compaction
     moving_average<double, 5> _compaction_ratio{1.0};
+    // last offset of the newest segment compacted by the window compaction
+    model::offset _last_compaction_window_offset;
 
     // Bytes written since last time we requested stm snapshot
     ssx::semaphore_units _stm_dirty_bytes_units;
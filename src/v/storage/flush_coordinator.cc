@@ -0,0 +1,80 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "storage/flush_coordinator.h"
+
+#include "ssx/future-util.h"
+#include "storage/logger.h"
+#include "vlog.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/future-util.hh>
+#include <seastar/core/later.hh>
+
+namespace storage {
+
+flush_coordinator::flush_coordinator(config::binding<bool> enabled)
+  : _enabled(std::move(enabled)) {}
+
+ss::future<> flush_coordinator::flush(const void* owner, ss::file f) {
+    if (_gate.is_closed()) {
+        return f.flush();
+    }
+    auto& pending = _next[owner];
+    if (pending.requests == 0) {
+        pending.file = std::move(f);
+    }
+    ++pending.requests;
+    auto fut = pending.done.get_shared_future();
+    if (!_running) {
+        _running = true;
+        ssx::spawn_with_gate(_gate, [this] { return run_rounds(); });
+    }
+    return fut;
+}
+
+ss::future<> flush_coordinator::run_rounds() {
+    // let all the flushes requested in the current scheduling pass join the
+    // first round
+    co_await ss::later();
+    while (!_next.empty()) {
+        auto round = std::exchange(_next, {});
+        co_await flush_round(round);
+    }
+    _running = false;
+}
+
+ss::future<> flush_coordinator::flush_round(round_t& round) {
+    size_t requests = 0;
+    for (auto& [_, pending] : round) {
+        requests += pending.requests;
+    }
+    auto m = _probe.round_started(round.size(), requests);
+    co_await ss::parallel_for_each(round, [](round_t::value_type& e) {
+        return e.second.file.flush().then_wrapped(
+          [&pending = e.second](ss::future<> f) {
+              if (f.failed()) {
+                  pending.done.set_exception(f.get_exception());
+              } else {
+                  pending.done.set_value();
+              }
+          });
+    });
+    vlog(
+      stlog.trace,
+      "flush round completed, files: {}, requests: {}",
+      round.size(),
+      requests);
+}
+
+ss::future<> flush_coordinator::stop() { return _gate.close(); }
+
+} // namespace storage
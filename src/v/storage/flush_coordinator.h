@@ -0,0 +1,76 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "config/property.h"
+#include "seastarx.h"
+#include "storage/probe.h"
+
+#include <seastar/core/file.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/shared_future.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+namespace storage {
+
+/**
+ * Shard wide group commit of segment flushes.
+ *
+ * Every partition flushes its active segment independently, so with many
+ * partitions on a shard the device sees a stream of small, uncoordinated
+ * fdatasync calls. When enabled, the coordinator collects flush requests into
+ * rounds: the first request starts a round at the end of the current
+ * scheduling pass, and requests arriving while a round is in progress join
+ * the next one. Within a round all files are flushed concurrently and repeated
+ * requests for the same file share a single flush, so the number of physical
+ * flushes adapts to the device latency without adding a fixed delay.
+ *
+ * A request is only ever merged into a round that has not started yet, hence
+ * every flush issued by the round covers all the writes that completed before
+ * the request was made.
+ */
+class flush_coordinator {
+public:
+    explicit flush_coordinator(config::binding<bool> enabled);
+    flush_coordinator(const flush_coordinator&) = delete;
+    flush_coordinator& operator=(const flush_coordinator&) = delete;
+
+    bool enabled() const { return _enabled(); }
+
+    /// \brief flushes `f` in the next round. `owner` identifies the writer of
+    /// the file, requests from the same owner are merged.
+    ss::future<> flush(const void* owner, ss::file f);
+
+    void setup_metrics() { _probe.setup_metrics(); }
+
+    ss::future<> stop();
+
+private:
+    struct pending_flush {
+        ss::file file;
+        ss::shared_promise<> done;
+        size_t requests{0};
+    };
+    using round_t = absl::flat_hash_map<const void*, pending_flush>;
+
+    ss::future<> run_rounds();
+    ss::future<> flush_round(round_t&);
+
+    config::binding<bool> _enabled;
+    round_t _next;
+    bool _running{false};
+    ss::gate _gate;
+    flush_coordinator_probe _probe;
+};
+
+} // namespace storage
@@ -29,8 +29,8 @@
 namespace storage {
 
 bool index_state::maybe_index(
-  size_t accumulator,
-  size_t step,
+  index_density& density,
+  size_t batch_size,
   size_t starting_position_in_file,
   model::offset batch_base_offset,
   model::offset batch_max_offset,
@@ -45,6 +45,7 @@ bool index_state::maybe_index(
       *this);
 
     bool retval = false;
+    const bool due = density.track(batch_size);
     // index_state
     if (empty()) {
         base_timestamp = first_timestamp;
@@ -60,18 +61,51 @@ bool index_state::maybe_index(
     last_timestamp = std::max(first_timestamp, last_timestamp);
     max_timestamp = std::max(max_timestamp, last_timestamp);
     // always saving the first batch simplifies a lot of book keeping
-    if (accumulator >= step || retval) {
+    if (due || retval) {
         // We know that a segment cannot be > 4GB
         add_entry(
           batch_base_offset() - base_offset(),
           std::max(last_timestamp() - base_timestamp(), int64_t{0}),
           starting_position_in_file);
-
+        density.reset();
         retval = true;
     }
     return retval;
 }
 
+index_file_layout index_file_layout::for_entries(size_t entries) {
+    // envelope header: version, compat_version and size
+    constexpr size_t envelope_header_size = 2 * sizeof(serde::version_t)
+                                            + sizeof(serde::serde_size_t);
+    // fields are wrapped in a size prefixed iobuf so they can be checksummed
+    constexpr size_t blob_header_size = sizeof(serde::serde_size_t);
+    constexpr size_t scalars_size = sizeof(uint32_t)
+                                    + 2 * sizeof(model::offset::type)
+                                    + 2 * sizeof(model::timestamp::type);
+    // each fragmented_vector is prefixed with its element count
+    constexpr size_t vector_header_size = sizeof(serde::serde_size_t);
+
+    const size_t offsets_pos = envelope_header_size + blob_header_size
+                               + scalars_size + vector_header_size;
+    const size_t times_pos = offsets_pos + entries * sizeof(uint32_t)
+                             + vector_header_size;
+    const size_t positions_pos = times_pos + entries * sizeof(uint32_t)
+                                 + vector_header_size;
+    return index_file_layout{
+      .entries = static_cast<uint32_t>(entries),
+      .relative_offset_pos = static_cast<uint32_t>(offsets_pos),
+      .relative_time_pos = static_cast<uint32_t>(times_pos),
+      .position_pos = static_cast<uint32_t>(positions_pos),
+    };
+}
+
+std::ostream& operator<<(std::ostream& o, const index_file_layout& l) {
+    return o << "{entries:" << l.entries
+             << ", relative_offset_pos:" << l.relative_offset_pos
+             << ", relative_time_pos:" << l.relative_time_pos
+             << ", position_pos:" << l.position_pos << "}";
+}
+
 std::ostream& operator<<(std::ostream& o, const index_state& s) {
     return o << "{header_bitflags:" << s.bitflags
              << ", base_offset:" << s.base_offset
@@ -80,7 +114,8 @@ std::ostream& operator<<(std::ostream& o, const index_state& s) {
              << ", max_timestamp:" << s.max_timestamp << ", index("
              << s.relative_offset_index.size() << ","
              << s.relative_time_index.size() << "," << s.position_index.size()
-             << ")}";
+             << "), checkpoint_offset:" << s.checkpoint_offset
+             << ", checkpoint_file_pos:" << s.checkpoint_file_pos << "}";
 }
 
 void index_state::serde_write(iobuf& out) const {
@@ -103,6 +138,17 @@ void index_state::serde_write(iobuf& out) const {
     // data blob + crc
     write(out, std::move(tmp));
     write(out, tmp_crc);
+
+    // v5: where the arrays above live within the envelope
+    const auto layout = index_file_layout::for_entries(size());
+    write(out, layout.entries);
+    write(out, layout.relative_offset_pos);
+    write(out, layout.relative_time_pos);
+    write(out, layout.position_pos);
+
+    // v6: recovery checkpoint
+    write(out, checkpoint_offset);
+    write(out, checkpoint_file_pos);
 }
 
 void read_nested(
@@ -166,6 +212,28 @@ void read_nested(
     read_nested(p, st.relative_offset_index, 0U);
     read_nested(p, st.relative_time_index, 0U);
     read_nested(p, st.position_index, 0U);
+
+    if (hdr._version >= 5) {
+        index_file_layout layout;
+        read_nested(in, layout.entries, hdr._bytes_left_limit);
+        read_nested(in, layout.relative_offset_pos, hdr._bytes_left_limit);
+        read_nested(in, layout.relative_time_pos, hdr._bytes_left_limit);
+        read_nested(in, layout.position_pos, hdr._bytes_left_limit);
+
+        const auto expected = index_file_layout::for_entries(st.size());
+        if (layout != expected) {
+            throw serde::serde_exception(fmt_with_ctx(
+              fmt::format,
+              "Mismatched index layout {} expected {}",
+              layout,
+              expected));
+        }
+    }
+
+    if (hdr._version >= 6) {
+        read_nested(in, st.checkpoint_offset, hdr._bytes_left_limit);
+        read_nested(in, st.checkpoint_file_pos, hdr._bytes_left_limit);
+    }
 }
 
 } // namespace storage
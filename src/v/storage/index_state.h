@@ -34,9 +34,68 @@ namespace storage {
    [] relative_offset_index
    [] relative_time_index
    [] position_index
+
+   Since version 5 the serde encoding is followed by an index_file_layout
+   describing where in the file each of the three arrays starts. The arrays
+   are stored as fixed width little endian integers sorted by relative offset,
+   so a lookup can binary search a persisted index in place without decoding
+   it. Version 4 readers reject version 5 files and rebuild the index.
+
+   Version 6 appends the recovery checkpoint of the active segment after the
+   layout, see segment_index::make_checkpoint.
  */
+
+/// Byte positions of the index arrays in a persisted index_state. Every
+/// position is relative to the start of the serialized envelope, which is the
+/// start of the file for segment indices.
+struct index_file_layout {
+    uint32_t entries{0};
+    uint32_t relative_offset_pos{0};
+    uint32_t relative_time_pos{0};
+    uint32_t position_pos{0};
+
+    /// \brief layout of a serialized index_state holding `entries` entries
+    static index_file_layout for_entries(size_t entries);
+
+    friend bool operator==(const index_file_layout&, const index_file_layout&)
+      = default;
+    friend std::ostream& operator<<(std::ostream&, const index_file_layout&);
+};
+
+/// Spacing of the entries of an index. An entry is added every `step` bytes
+/// of batches, and at least every max_batches batches: with tiny batches a
+/// byte step alone leaves hundreds of batch headers to parse on every lookup.
+/// Large batches get an entry each, as before.
+struct index_density {
+    // bounds the batches a lookup scans past its entry, while still spacing
+    // entries of minimal batches (61 byte headers) ~8KiB apart
+    static constexpr size_t default_max_batches = 128;
+
+    explicit index_density(
+      size_t step, size_t max_batches = default_max_batches) noexcept
+      : step(step)
+      , max_batches(max_batches) {}
+
+    /// accounts a batch, true if it is due for an entry
+    bool track(size_t batch_size) {
+        bytes += batch_size;
+        ++batches;
+        return bytes >= step || batches >= max_batches;
+    }
+    void reset() {
+        bytes = 0;
+        batches = 0;
+    }
+
+    size_t step;
+    size_t max_batches;
+    // since the last entry
+    size_t bytes{0};
+    size_t batches{0};
+};
+
 struct index_state
-  : serde::envelope<index_state, serde::version<4>, serde::compat_version<4>> {
+  : serde::envelope<index_state, serde::version<6>, serde::compat_version<4>> {
     index_state() = default;
     index_state(index_state&&) noexcept = default;
     index_state& operator=(index_state&&) noexcept = default;
@@ -61,7 +120,22 @@ struct index_state
     fragmented_vector<uint32_t> relative_time_index;
     fragmented_vector<uint64_t> position_index;
 
+    /// recovery checkpoint: the segment data up to checkpoint_file_pos was
+    /// durable when the index was written and ends with the batch whose last
+    /// offset is checkpoint_offset. a zero position means no checkpoint.
+    model::offset checkpoint_offset{};
+    uint64_t checkpoint_file_pos{0};
+
+    bool has_checkpoint() const { return checkpoint_file_pos > 0; }
+
     bool empty() const { return relative_offset_index.empty(); }
+    size_t size() const { return relative_offset_index.size(); }
+    /// bytes allocated for the entries
+    size_t memory_size() const {
+        return relative_offset_index.memory_size()
+               + relative_time_index.memory_size()
+               + position_index.memory_size();
+    }
 
     void
     add_entry(uint32_t relative_offset, uint32_t relative_time, uint64_t pos) {
@@ -79,9 +153,11 @@ struct index_state
           relative_offset_index[i], relative_time_index[i], position_index[i]};
     }
 
+    /// \brief tracks a batch, adding an entry for it if the density calls
+    /// for one. returns true if an entry was added.
     bool maybe_index(
-      size_t accumulator,
-      size_t step,
+      index_density& density,
+      size_t batch_size,
       size_t starting_position_in_file,
       model::offset base_offset,
       model::offset batch_max_offset,
@@ -104,7 +180,9 @@ private:
       , max_timestamp(o.max_timestamp)
       , relative_offset_index(o.relative_offset_index.copy())
       , relative_time_index(o.relative_time_index.copy())
-      , position_index(o.position_index.copy()) {}
+      , position_index(o.position_index.copy())
+      , checkpoint_offset(o.checkpoint_offset)
+      , checkpoint_file_pos(o.checkpoint_file_pos) {}
 };
 
 } // namespace storage
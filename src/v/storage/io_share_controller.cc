@@ -0,0 +1,183 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "storage/io_share_controller.h"
+
+#include "config/configuration.h"
+#include "prometheus/prometheus_sanitize.h"
+#include "ssx/future-util.h"
+#include "storage/logger.h"
+#include "vlog.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/metrics.hh>
+
+#include <algorithm>
+
+namespace storage {
+
+namespace {
+// I/O slower than this is recorded as the maximum
+constexpr auto max_recorded_latency = std::chrono::seconds(10);
+
+hdr_hist make_latency_hist() {
+    return hdr_hist(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        max_recorded_latency),
+      std::chrono::microseconds(1));
+}
+
+uint32_t min_shares(uint32_t max_shares) {
+    return std::max<uint32_t>(max_shares / 16, 1);
+}
+} // namespace
+
+io_share_controller::io_share_controller(
+  config::binding<bool> enabled,
+  config::binding<std::chrono::milliseconds> produce_target,
+  config::binding<std::chrono::milliseconds> fetch_target,
+  config::binding<std::chrono::milliseconds> update_interval)
+  : _enabled(std::move(enabled))
+  , _produce_target(std::move(produce_target))
+  , _fetch_target(std::move(fetch_target))
+  , _update_interval(std::move(update_interval))
+  , _latency{make_latency_hist(), make_latency_hist()} {}
+
+void io_share_controller::record_latency(
+  latency_class c, std::chrono::microseconds latency) {
+    _latency[static_cast<size_t>(c)].record(std::min<uint64_t>(
+      latency.count(),
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        max_recorded_latency)
+        .count()));
+}
+
+void io_share_controller::add_background_class(
+  ss::sstring name, ss::io_priority_class priority) {
+    const auto shares = std::max<uint32_t>(priority.get_shares(), 1);
+    _classes.push_back(background_class{
+      .name = std::move(name),
+      .priority = priority,
+      .max_shares = shares,
+      .shares = shares,
+    });
+}
+
+std::optional<uint32_t>
+io_share_controller::shares(std::string_view name) const {
+    auto it = std::find_if(
+      _classes.begin(), _classes.end(), [name](const background_class& c) {
+          return c.name == name;
+      });
+    if (it == _classes.end()) {
+        return std::nullopt;
+    }
+    return it->shares;
+}
+
+void io_share_controller::start() {
+    _timer.set_callback([this] {
+        ssx::spawn_with_gate(_gate, [this] {
+            return update().then([this] {
+                if (!_gate.is_closed()) {
+                    _timer.arm(_update_interval());
+                }
+            });
+        });
+    });
+    _timer.arm(_update_interval());
+}
+
+ss::future<> io_share_controller::stop() {
+    _timer.cancel();
+    return _gate.close();
+}
+
+ss::future<> io_share_controller::set_shares(
+  background_class& c, uint32_t shares) {
+    if (shares == c.shares) {
+        co_return;
+    }
+    if (shares < c.shares) {
+        ++c.decreases;
+    } else {
+        ++c.increases;
+    }
+    vlog(stlog.debug, "{} I/O shares {} -> {}", c.name, c.shares, shares);
+    c.shares = shares;
+    co_await c.priority.update_shares(shares);
+}
+
+ss::future<> io_share_controller::update() {
+    const auto produce_p99 = std::chrono::microseconds(
+      _latency[static_cast<size_t>(latency_class::produce)].get_value_at(
+        99.0));
+    const auto fetch_p99 = std::chrono::microseconds(
+      _latency[static_cast<size_t>(latency_class::fetch)].get_value_at(99.0));
+    for (auto& h : _latency) {
+        h = make_latency_hist();
+    }
+
+    const bool over_target = produce_p99 > _produce_target()
+                             || fetch_p99 > _fetch_target();
+    if (over_target && _enabled()) {
+        vlog(
+          stlog.trace,
+          "foreground I/O over target, produce p99: {}us, fetch p99: {}us",
+          produce_p99.count(),
+          fetch_p99.count());
+    }
+    for (auto& c : _classes) {
+        uint32_t shares = c.max_shares;
+        if (_enabled()) {
+            shares = over_target
+                       ? std::max(c.shares / 2, min_shares(c.max_shares))
+                       : std::min(
+                         c.shares + std::max<uint32_t>(c.max_shares / 10, 1),
+                         c.max_shares);
+        }
+        co_await set_shares(c, shares);
+    }
+}
+
+void io_share_controller::setup_metrics() {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    namespace sm = ss::metrics;
+    auto class_label = sm::label("class");
+    for (size_t i = 0; i < _classes.size(); ++i) {
+        const std::vector<sm::label_instance> labels = {
+          class_label(_classes[i].name)};
+        _metrics.add_group(
+          prometheus_sanitize::metrics_name("storage:io_share_controller"),
+          {
+            sm::make_gauge(
+              "shares",
+              [this, i] { return _classes[i].shares; },
+              sm::description("Current I/O shares of the priority class"),
+              labels),
+            sm::make_counter(
+              "share_decreases",
+              [this, i] { return _classes[i].decreases; },
+              sm::description("Number of times the I/O shares were lowered "
+                              "because of the foreground latency"),
+              labels),
+            sm::make_counter(
+              "share_increases",
+              [this, i] { return _classes[i].increases; },
+              sm::description("Number of times the I/O shares were raised"),
+              labels),
+          });
+    }
+}
+
+} // namespace storage
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "config/property.h"
+#include "seastarx.h"
+#include "utils/hdr_hist.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/io_priority_class.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/core/timer.hh>
+
+#include <array>
+#include <chrono>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace storage {
+
+/**
+ * Adapts the I/O shares of background priority classes of a shard, e.g.
+ * partition recovery, to the latency of the foreground I/O.
+ *
+ * Latency of produce (log flushes) and of fetch (disk reads of fetch
+ * requests) is sampled. Every update interval, if the p99 of either is above
+ * its target the shares of the background classes are halved, down to a
+ * sixteenth of the shares they were registered with, and grow back by a tenth
+ * of them otherwise. With the controller disabled the classes keep their
+ * registered shares.
+ */
+class io_share_controller {
+public:
+    enum class latency_class : uint8_t { produce = 0, fetch = 1 };
+
+    io_share_controller(
+      config::binding<bool> enabled,
+      config::binding<std::chrono::milliseconds> produce_target,
+      config::binding<std::chrono::milliseconds> fetch_target,
+      config::binding<std::chrono::milliseconds> update_interval);
+    io_share_controller(const io_share_controller&) = delete;
+    io_share_controller& operator=(const io_share_controller&) = delete;
+
+    /// Latency of a foreground I/O
+    void record_latency(latency_class, std::chrono::microseconds);
+
+    /// Puts a background class under control, must be called before start()
+    void add_background_class(ss::sstring name, ss::io_priority_class);
+
+    void start();
+    ss::future<> stop();
+
+    void setup_metrics();
+
+    /// One control step, runs every update interval once started
+    ss::future<> update();
+
+    /// Current shares of the background class, nullopt if not controlled
+    std::optional<uint32_t> shares(std::string_view name) const;
+
+private:
+    struct background_class {
+        ss::sstring name;
+        ss::io_priority_class priority;
+        // shares the class was registered with
+        uint32_t max_shares;
+        uint32_t shares;
+        uint64_t decreases{0};
+        uint64_t increases{0};
+    };
+
+    ss::future<> set_shares(background_class&, uint32_t);
+
+    config::binding<bool> _enabled;
+    config::binding<std::chrono::milliseconds> _produce_target;
+    config::binding<std::chrono::milliseconds> _fetch_target;
+    config::binding<std::chrono::milliseconds> _update_interval;
+
+    // indexed by latency_class
+    std::array<hdr_hist, 2> _latency;
+    std::vector<background_class> _classes;
+    ss::timer<> _timer;
+    ss::gate _gate;
+    ss::metrics::metric_groups _metrics;
+};
+
+} // namespace storage
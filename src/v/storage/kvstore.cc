@@ -15,65 +15,43 @@
 #include "prometheus/prometheus_sanitize.h"
 #include "raft/types.h"
 #include "reflection/adl.h"
+#include "ssx/sformat.h"
 #include "storage/parser.h"
 #include "storage/record_batch_builder.h"
 #include "storage/segment_set.h"
 #include "storage/types.h"
 #include "vlog.h"
 
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
 #include <seastar/core/metrics.hh>
 #include <seastar/core/thread.hh>
 #include <seastar/util/defer.hh>
 #include <seastar/util/log.hh>
 
+#include <algorithm>
+#include <array>
+
 static ss::logger lg("kvstore");
 
 namespace storage {
 
-kvstore::kvstore(kvstore_config kv_conf, storage_resources& resources)
+kvstore::partition::partition(
+  const kvstore_config& kv_conf,
+  storage_resources& resources,
+  model::ntp ntp)
   : _conf(kv_conf)
   , _resources(resources)
-  , _ntpc(model::kvstore_ntp(ss::this_shard_id()), _conf.base_dir)
+  , _ntpc(std::move(ntp), _conf.base_dir)
   , _snap(
       std::filesystem::path(_ntpc.work_directory()),
       simple_snapshot_manager::default_snapshot_filename,
       ss::default_priority_class())
   , _timer([this] { _sem.signal(); }) {}
 
-ss::future<> kvstore::start() {
+ss::future<> kvstore::partition::start() {
     vlog(lg.debug, "Starting kvstore: dir {}", _ntpc.work_directory());
 
-    if (!config::shard_local_cfg().disable_metrics()) {
-        _probe.metrics.add_group(
-          prometheus_sanitize::metrics_name("storage:kvstore"),
-          {
-            ss::metrics::make_total_operations(
-              "segments_rolled",
-              [this] { return _probe.segments_rolled; },
-              ss::metrics::description("Number of segments rolled")),
-            ss::metrics::make_total_operations(
-              "entries_fetched",
-              [this] { return _probe.entries_fetched; },
-              ss::metrics::description("Number of entries fetched")),
-            ss::metrics::make_total_operations(
-              "entries_written",
-              [this] { return _probe.entries_written; },
-              ss::metrics::description("Number of entries written")),
-            ss::metrics::make_total_operations(
-              "entries_removed",
-              [this] { return _probe.entries_removed; },
-              ss::metrics::description("Number of entries removaled")),
-            ss::metrics::make_current_bytes(
-              "cached_bytes",
-              [this] { return _probe.cached_bytes; },
-              ss::metrics::description("Size of the database in memory")),
-            ss::metrics::make_counter(
-              "key_count",
-              [this] { return _db.size(); },
-              ss::metrics::description("Number of keys in the database")),
-          });
-    }
-
     return recover()
       .then([this] {
           _started = true;
@@ -102,7 +80,7 @@ ss::future<> kvstore::start() {
       });
 }
 
-ss::future<> kvstore::stop() {
+ss::future<> kvstore::partition::stop() {
     vlog(lg.info, "Stopping kvstore: dir {}", _ntpc.work_directory());
 
     _as.request_abort();
@@ -145,32 +123,220 @@ static inline bytes make_spaced_key(kvstore::key_space ks, bytes_view key) {
     return spaced_key;
 }
 
-std::optional<iobuf> kvstore::get(key_space ks, bytes_view key) {
-    _probe.entry_fetched();
+/*
+ * Return the key-space of a prefixed key
+ */
+static inline kvstore::key_space key_space_of(bytes_view spaced_key) {
+    std::underlying_type<kvstore::key_space>::type ks_le;
+    vassert(
+      spaced_key.size() >= sizeof(ks_le),
+      "Key of size {} has no key-space",
+      spaced_key.size());
+    std::copy_n(
+      spaced_key.begin(), sizeof(ks_le), reinterpret_cast<char*>(&ks_le));
+    return static_cast<kvstore::key_space>(ss::le_to_cpu(ks_le));
+}
+
+/*
+ * The shared partition uses the ntp of the single log store of older
+ * versions, the other partitions are stored in topics of their own.
+ */
+static model::ntp partition_ntp(std::string_view name) {
+    if (name.empty()) {
+        return model::kvstore_ntp(ss::this_shard_id());
+    }
+    return {
+      model::redpanda_ns,
+      model::topic(ssx::sformat("{}_{}", model::kvstore_topic(), name)),
+      model::partition_id(ss::this_shard_id())};
+}
+
+kvstore::kvstore(kvstore_config kv_conf, storage_resources& resources) {
+    // indexed by partition_id
+    constexpr std::array<std::string_view, partition_count> names{
+      "", "consensus", "offset_translator"};
+    _partitions.reserve(partition_count);
+    for (auto name : names) {
+        _partitions.push_back(std::make_unique<partition>(
+          kv_conf, resources, partition_ntp(name)));
+    }
+}
+
+kvstore::partition_id kvstore::partition_of(key_space ks) {
+    switch (ks) {
+    case key_space::consensus:
+        return partition_id::consensus;
+    case key_space::offset_translator:
+        return partition_id::offset_translator;
+    case key_space::testing:
+    case key_space::storage:
+    case key_space::controller:
+        return partition_id::shared;
+    }
+    return partition_id::shared;
+}
+
+kvstore::partition& kvstore::get_partition(key_space ks) {
+    return *_partitions[static_cast<size_t>(partition_of(ks))];
+}
+
+ss::future<> kvstore::start() {
+    setup_metrics();
+    co_await ss::parallel_for_each(
+      _partitions, [](std::unique_ptr<partition>& p) { return p->start(); });
+    _started = true;
+    co_await migrate_key_spaces();
+}
+
+ss::future<> kvstore::stop() {
+    _metrics.clear();
+    return ss::parallel_for_each(
+      _partitions, [](std::unique_ptr<partition>& p) { return p->stop(); });
+}
+
+bool kvstore::empty() const {
     vassert(_started, "kvstore has not been started");
+    return std::all_of(
+      _partitions.begin(),
+      _partitions.end(),
+      [](const std::unique_ptr<partition>& p) { return p->size() == 0; });
+}
 
+std::optional<iobuf> kvstore::get(key_space ks, bytes_view key) {
     // do not re-assign to string_view -> temporary
     auto kkey = make_spaced_key(ks, key);
-    if (auto it = _db.find(kkey); it != _db.end()) {
-        return it->second.copy();
-    }
-    return std::nullopt;
+    return get_partition(ks).get(kkey);
 }
 
 ss::future<> kvstore::put(key_space ks, bytes key, iobuf value) {
-    _probe.entry_written();
-    return put(ks, std::move(key), std::make_optional<iobuf>(std::move(value)));
+    auto kkey = make_spaced_key(ks, key);
+    return get_partition(ks).put(
+      std::move(kkey), std::make_optional<iobuf>(std::move(value)));
 }
 
 ss::future<> kvstore::remove(key_space ks, bytes key) {
-    _probe.entry_removed();
-    return put(ks, std::move(key), std::nullopt);
+    auto kkey = make_spaced_key(ks, key);
+    return get_partition(ks).put(std::move(kkey), std::nullopt);
+}
+
+ss::future<> kvstore::migrate_key_spaces() {
+    auto& shared = *_partitions[static_cast<size_t>(partition_id::shared)];
+
+    /*
+     * keys are copied to their partition first and removed from the shared
+     * partition once the copies are durable. if the migration is interrupted
+     * the keys that already have a copy are only removed on the next start,
+     * the copy may be newer than the key in the shared partition.
+     */
+    std::vector<bytes> moved;
+    std::vector<ss::future<>> copies;
+    for (const auto& [key, value] : shared.entries()) {
+        auto& target = get_partition(key_space_of(key));
+        if (&target == &shared) {
+            continue;
+        }
+        moved.push_back(key);
+        if (!target.contains(key)) {
+            copies.push_back(target.put(key, value.copy()));
+        }
+    }
+    if (moved.empty()) {
+        co_return;
+    }
+
+    vlog(lg.info, "Moving {} keys to their key-space partitions", moved.size());
+    co_await ss::when_all_succeed(copies.begin(), copies.end());
+
+    std::vector<ss::future<>> removals;
+    removals.reserve(moved.size());
+    for (auto& key : moved) {
+        removals.push_back(shared.put(std::move(key), std::nullopt));
+    }
+    co_await ss::when_all_succeed(removals.begin(), removals.end());
+}
+
+void kvstore::setup_metrics() {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("storage:kvstore"),
+      {
+        ss::metrics::make_total_operations(
+          "segments_rolled",
+          [this] {
+              return sum_probes(
+                [](const partition::probe& p) { return p.segments_rolled; });
+          },
+          ss::metrics::description("Number of segments rolled")),
+        ss::metrics::make_total_operations(
+          "entries_fetched",
+          [this] {
+              return sum_probes(
+                [](const partition::probe& p) { return p.entries_fetched; });
+          },
+          ss::metrics::description("Number of entries fetched")),
+        ss::metrics::make_total_operations(
+          "entries_written",
+          [this] {
+              return sum_probes(
+                [](const partition::probe& p) { return p.entries_written; });
+          },
+          ss::metrics::description("Number of entries written")),
+        ss::metrics::make_total_operations(
+          "entries_removed",
+          [this] {
+              return sum_probes(
+                [](const partition::probe& p) { return p.entries_removed; });
+          },
+          ss::metrics::description("Number of entries removaled")),
+        ss::metrics::make_total_operations(
+          "entries_coalesced",
+          [this] {
+              return sum_probes(
+                [](const partition::probe& p) { return p.entries_coalesced; });
+          },
+          ss::metrics::description(
+            "Number of entries superseded by a later write of the same "
+            "key before they were flushed")),
+        ss::metrics::make_current_bytes(
+          "cached_bytes",
+          [this] {
+              return sum_probes(
+                [](const partition::probe& p) { return p.cached_bytes; });
+          },
+          ss::metrics::description("Size of the database in memory")),
+        ss::metrics::make_counter(
+          "key_count",
+          [this] {
+              uint64_t res = 0;
+              for (const auto& p : _partitions) {
+                  res += p->size();
+              }
+              return res;
+          },
+          ss::metrics::description("Number of keys in the database")),
+      });
+}
+
+std::optional<iobuf> kvstore::partition::get(const bytes& key) {
+    _probe.entry_fetched();
+    vassert(_started, "kvstore has not been started");
+
+    if (auto it = _db.find(key); it != _db.end()) {
+        return it->second.copy();
+    }
+    return std::nullopt;
 }
 
-ss::future<> kvstore::put(key_space ks, bytes key, std::optional<iobuf> value) {
+ss::future<> kvstore::partition::put(bytes key, std::optional<iobuf> value) {
     vassert(_started, "kvstore has not been started");
 
-    key = make_spaced_key(ks, key);
+    if (value) {
+        _probe.entry_written();
+    } else {
+        _probe.entry_removed();
+    }
     return ss::with_gate(
       _gate, [this, key = std::move(key), value = std::move(value)]() mutable {
           auto& w = _ops.emplace_back(std::move(key), std::move(value));
@@ -181,7 +347,7 @@ ss::future<> kvstore::put(key_space ks, bytes key, std::optional<iobuf> value) {
       });
 }
 
-void kvstore::apply_op(bytes key, std::optional<iobuf> value) {
+void kvstore::partition::apply_op(bytes key, std::optional<iobuf> value) {
     auto it = _db.find(key);
     bool found = it != _db.end();
     if (value) {
@@ -210,7 +376,7 @@ void kvstore::apply_op(bytes key, std::optional<iobuf> value) {
     }
 }
 
-ss::future<> kvstore::flush_and_apply_ops() {
+ss::future<> kvstore::partition::flush_and_apply_ops() {
     if (_ops.empty()) {
         return ss::now();
     }
@@ -218,10 +384,32 @@ ss::future<> kvstore::flush_and_apply_ops() {
     // flush and apply whatever happens to be queued up
     auto ops = std::exchange(_ops, {});
 
+    // last writer wins: an op followed by another op on the same key in this
+    // flush window is neither written nor applied, it completes together with
+    // the rest of the window
+    std::vector<bool> superseded(ops.size(), false);
+    {
+        absl::flat_hash_map<bytes_view, size_t, bytes_type_hash, std::equal_to<>>
+          latest;
+        latest.reserve(ops.size());
+        for (size_t i = 0; i < ops.size(); ++i) {
+            auto [it, inserted] = latest.emplace(bytes_view(ops[i].key), i);
+            if (!inserted) {
+                superseded[it->second] = true;
+                it->second = i;
+                _probe.entry_coalesced();
+            }
+        }
+    }
+
     // build the operation batch to be logged
     storage::record_batch_builder builder(
       model::record_batch_type::kvstore, _next_offset);
-    for (auto& op : ops) {
+    for (size_t i = 0; i < ops.size(); ++i) {
+        if (superseded[i]) {
+            continue;
+        }
+        auto& op = ops[i];
         std::optional<iobuf> value;
         if (op.value) {
             value = op.value->share(0, op.value->size_bytes());
@@ -240,16 +428,21 @@ ss::future<> kvstore::flush_and_apply_ops() {
      */
     return _segment->append(std::move(batch))
       .then([this](append_result) { return _segment->flush(); })
-      .then([this, last_offset, ops = std::move(ops)]() mutable {
-          for (auto& op : ops) {
-              apply_op(std::move(op.key), std::move(op.value));
-              op.done.set_value();
+      .then([this,
+             last_offset,
+             ops = std::move(ops),
+             superseded = std::move(superseded)]() mutable {
+          for (size_t i = 0; i < ops.size(); ++i) {
+              if (!superseded[i]) {
+                  apply_op(std::move(ops[i].key), std::move(ops[i].value));
+              }
+              ops[i].done.set_value();
           }
           _next_offset = last_offset + model::offset(1);
       });
 }
 
-ss::future<> kvstore::roll() {
+ss::future<> kvstore::partition::roll() {
     if (!_segment) {
         return make_segment(
                  _ntpc,
@@ -281,16 +474,12 @@ ss::future<> kvstore::roll() {
         // that stop() doesn't try to flush and close a closed and partially
         // cleaned-up segment.
         auto seg = std::exchange(_segment, nullptr);
+        const auto seg_size = seg->appender().file_byte_offset();
         return seg->close()
-          .then([this] { return save_snapshot(); })
-          .then([seg] {
-              vlog(
-                lg.debug,
-                "Removing old segment with base offset {}",
-                seg->offsets().base_offset);
-              return ss::remove_file(seg->reader().filename()).then([seg] {
-                  return ss::remove_file(seg->index().filename());
-              });
+          .then([this, seg, seg_size] {
+              _rolled_segments.push_back(seg);
+              _rolled_bytes += seg_size;
+              return maybe_save_snapshot();
           })
           .then([this] {
               return make_segment(
@@ -313,7 +502,39 @@ ss::future<> kvstore::roll() {
     return ss::now();
 }
 
-ss::future<> kvstore::save_snapshot() {
+ss::future<> kvstore::partition::maybe_save_snapshot() {
+    /*
+     * a snapshot rewrites the whole database. it is saved once the rolled
+     * segments hold at least as many bytes as the database, so the bytes
+     * written by snapshots are bounded by the bytes written to the log
+     * rather than growing with the size of the database times the number of
+     * rolls. the rolled segments are replayed on recovery until then.
+     */
+    if (_rolled_bytes < std::max(_probe.cached_bytes, _conf.max_segment_size)) {
+        return ss::now();
+    }
+    return save_snapshot().then([this] {
+        auto segs = std::exchange(_rolled_segments, {});
+        _rolled_bytes = 0;
+        return ss::do_with(
+          std::move(segs),
+          [](std::vector<ss::lw_shared_ptr<segment>>& segs) {
+              return ss::do_for_each(
+                segs, [](ss::lw_shared_ptr<segment>& seg) {
+                    vlog(
+                      lg.debug,
+                      "Removing old segment with base offset {}",
+                      seg->offsets().base_offset);
+                    return ss::remove_file(seg->reader().filename())
+                      .then([seg] {
+                          return ss::remove_file(seg->index().filename());
+                      });
+                });
+          });
+    });
+}
+
+ss::future<> kvstore::partition::save_snapshot() {
     vassert(
       _next_offset >= model::offset(0),
       "Unexpected next offset {}",
@@ -371,7 +592,7 @@ ss::future<> kvstore::save_snapshot() {
       });
 }
 
-ss::future<> kvstore::recover() {
+ss::future<> kvstore::partition::recover() {
     return ss::async([this] {
         /*
          * after loading _next_offset will be set to either zero if no snapshot
@@ -397,7 +618,7 @@ ss::future<> kvstore::recover() {
     });
 }
 
-void kvstore::load_snapshot_in_thread() {
+void kvstore::partition::load_snapshot_in_thread() {
     _gate.check(); // early out on shutdown
 
     // open snapshot reader, if a snapshot exists
@@ -469,7 +690,7 @@ void kvstore::load_snapshot_in_thread() {
     _next_offset = last_offset + model::offset(1);
 }
 
-void kvstore::replay_segments_in_thread(segment_set segs) {
+void kvstore::partition::replay_segments_in_thread(segment_set segs) {
     vlog(
       lg.debug,
       "Replaying {} segments from offset {}",
@@ -551,7 +772,7 @@ void kvstore::replay_segments_in_thread(segment_set segs) {
     save_snapshot().get();
 }
 
-batch_consumer::consume_result kvstore::replay_consumer::accept_batch_start(
+batch_consumer::consume_result kvstore::partition::replay_consumer::accept_batch_start(
   const model::record_batch_header&) const {
     if (_store->_gate.is_closed()) {
         // early out on shutdown
@@ -560,12 +781,12 @@ batch_consumer::consume_result kvstore::replay_consumer::accept_batch_start(
     return batch_consumer::consume_result::accept_batch;
 }
 
-void kvstore::replay_consumer::skip_batch_start(
+void kvstore::partition::replay_consumer::skip_batch_start(
   model::record_batch_header h, size_t, size_t) {
     vassert(false, "kvstore should never skip batches, header: {}", h);
 }
 
-void kvstore::replay_consumer::consume_batch_start(
+void kvstore::partition::replay_consumer::consume_batch_start(
   model::record_batch_header header, size_t, size_t) {
     vassert(header.record_count > 0, "Unexpected empty batch");
     vassert(
@@ -576,14 +797,14 @@ void kvstore::replay_consumer::consume_batch_start(
     _header = header;
 }
 
-void kvstore::replay_consumer::consume_records(iobuf&& records) {
+void kvstore::partition::replay_consumer::consume_records(iobuf&& records) {
     vassert(
       _header.attrs.compression() == model::compression::none,
       "Key-value store does not support compressed records");
     _records = std::move(records);
 }
 
-batch_consumer::stop_parser kvstore::replay_consumer::consume_batch_end() {
+batch_consumer::stop_parser kvstore::partition::replay_consumer::consume_batch_end() {
     /*
      * build the batch and then apply all its records to the store
      */
@@ -607,7 +828,7 @@ batch_consumer::stop_parser kvstore::replay_consumer::consume_batch_end() {
     return stop_parser::no;
 }
 
-void kvstore::replay_consumer::print(std::ostream& os) const {
+void kvstore::partition::replay_consumer::print(std::ostream& os) const {
     os << "storage::kvstore";
 }
 
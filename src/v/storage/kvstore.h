@@ -27,6 +27,9 @@
 
 #include <absl/container/flat_hash_map.h>
 
+#include <memory>
+#include <vector>
+
 namespace storage {
 
 /**
@@ -49,6 +52,13 @@ namespace storage {
  * flushed to disk. Once the flush is complete the operations are applied to the
  * in-memory cache, and the associated promise is resolved.
  *
+ * Partitions
+ * ==========
+ *
+ * The key spaces with heavy or latency sensitive traffic (consensus and
+ * offset_translator) are stored in logs of their own, every log is flushed
+ * independently. The rest of the key spaces share a single log.
+ *
  * Concurrency
  * ===========
  *
@@ -108,110 +118,179 @@ public:
     ss::future<> put(key_space ks, bytes key, iobuf value);
     ss::future<> remove(key_space ks, bytes key);
 
-    bool empty() const {
-        vassert(_started, "kvstore has not been started");
-        return _db.empty();
-    }
+    bool empty() const;
 
 private:
-    kvstore_config _conf;
-    storage_resources& _resources;
-    ntp_config _ntpc;
-    ss::gate _gate;
-    ss::abort_source _as;
-    simple_snapshot_manager _snap;
-    bool _started{false};
-
     /**
-     * Database operation. A std::nullopt value is a deletion.
+     * An independent log of a subset of the key spaces.
+     *
+     * Every partition has its own write-ahead log, snapshot, pending
+     * operations and flushing fiber, so a slow flush in one of them (e.g.
+     * large offset translator state) doesn't delay writes to the others
+     * (e.g. raft voted_for). The keys are stored prefixed by their key space
+     * in every partition.
      */
-    struct op {
-        bytes key;
-        std::optional<iobuf> value;
-        ss::promise<> done;
-
-        op(bytes&& key, std::optional<iobuf>&& value)
-          : key(std::move(key))
-          , value(std::move(value)) {}
-    };
+    class partition {
+    public:
+        using map_t
+          = absl::flat_hash_map<bytes, iobuf, bytes_type_hash, bytes_type_eq>;
 
-    /*
-     * database operations are cached in `ops` and periodically flushed to the
-     * current `segment` at position `next_offset` and then applied to `db`.
-     * when the segment reaches a threshold size a snapshot is saved a new
-     * segment is created.
-     */
-    std::vector<op> _ops;
-    ss::timer<> _timer;
-    ssx::semaphore _sem{0, "s/kvstore"};
-    ss::lw_shared_ptr<segment> _segment;
-    model::offset _next_offset;
-    absl::flat_hash_map<bytes, iobuf, bytes_type_hash, bytes_type_eq> _db;
-
-    ss::future<> put(key_space ks, bytes key, std::optional<iobuf> value);
-    void apply_op(bytes key, std::optional<iobuf> value);
-    ss::future<> flush_and_apply_ops();
-    ss::future<> roll();
-    ss::future<> save_snapshot();
+        partition(const kvstore_config&, storage_resources&, model::ntp);
 
-    /*
-     * Recovery
-     *
-     * 1. load snapshot if found
-     * 2. then recover from segments
-     */
-    ss::future<> recover();
-    void load_snapshot_in_thread();
-    void replay_segments_in_thread(segment_set);
+        ss::future<> start();
+        ss::future<> stop();
 
-    /**
-     * Replay batches against the key-value store.
-     *
-     * Used in recovery:
-     *    segment -> parser -> replay_consumer -> db
-     */
-    class replay_consumer final : public batch_consumer {
-    public:
-        explicit replay_consumer(kvstore* store)
-          : _store(store) {}
-
-        consume_result
-        accept_batch_start(const model::record_batch_header&) const override;
-        void consume_batch_start(
-          model::record_batch_header header, size_t, size_t) override;
-        void skip_batch_start(
-          model::record_batch_header header, size_t, size_t) override;
-        void consume_records(iobuf&&) override;
-        stop_parser consume_batch_end() override;
-        void print(std::ostream&) const override;
+        std::optional<iobuf> get(const bytes& key);
+        ss::future<> put(bytes key, std::optional<iobuf> value);
+        bool contains(const bytes& key) const { return _db.contains(key); }
+        size_t size() const { return _db.size(); }
+
+        const map_t& entries() const {
+            vassert(_started, "kvstore has not been started");
+            return _db;
+        }
+
+        struct probe {
+            void roll_segment() { ++segments_rolled; }
+            void entry_fetched() { ++entries_fetched; }
+            void entry_written() { ++entries_written; }
+            void entry_removed() { ++entries_removed; }
+            void entry_coalesced() { ++entries_coalesced; }
+            void add_cached_bytes(size_t count) { cached_bytes += count; }
+            void dec_cached_bytes(size_t count) { cached_bytes -= count; }
+
+            uint64_t segments_rolled{0};
+            uint64_t entries_fetched{0};
+            uint64_t entries_written{0};
+            uint64_t entries_removed{0};
+            uint64_t entries_coalesced{0};
+            size_t cached_bytes{0};
+        };
+
+        const probe& get_probe() const { return _probe; }
 
     private:
-        kvstore* _store;
-        model::offset _last_offset;
-        model::record_batch_header _header;
-        iobuf _records;
-    };
+        kvstore_config _conf;
+        storage_resources& _resources;
+        ntp_config _ntpc;
+        ss::gate _gate;
+        ss::abort_source _as;
+        simple_snapshot_manager _snap;
+        bool _started{false};
+
+        /**
+         * Database operation. A std::nullopt value is a deletion.
+         */
+        struct op {
+            bytes key;
+            std::optional<iobuf> value;
+            ss::promise<> done;
+
+            op(bytes&& key, std::optional<iobuf>&& value)
+              : key(std::move(key))
+              , value(std::move(value)) {}
+        };
+
+        /*
+         * database operations are cached in `ops` and periodically flushed to
+         * the current `segment` at position `next_offset` and then applied to
+         * `db`. when the segment reaches a threshold size a new segment is
+         * created. the rolled segments are kept until they hold as many bytes
+         * as `db`, then a snapshot is saved and they are removed.
+         */
+        std::vector<op> _ops;
+        ss::timer<> _timer;
+        ssx::semaphore _sem{0, "s/kvstore"};
+        ss::lw_shared_ptr<segment> _segment;
+        model::offset _next_offset;
+        map_t _db;
+        std::vector<ss::lw_shared_ptr<segment>> _rolled_segments;
+        size_t _rolled_bytes{0};
+
+        void apply_op(bytes key, std::optional<iobuf> value);
+        ss::future<> flush_and_apply_ops();
+        ss::future<> roll();
+        ss::future<> maybe_save_snapshot();
+        ss::future<> save_snapshot();
 
-    friend replay_consumer;
+        /*
+         * Recovery
+         *
+         * 1. load snapshot if found
+         * 2. then recover from segments
+         */
+        ss::future<> recover();
+        void load_snapshot_in_thread();
+        void replay_segments_in_thread(segment_set);
 
-    struct probe {
-        void roll_segment() { ++segments_rolled; }
-        void entry_fetched() { ++entries_fetched; }
-        void entry_written() { ++entries_written; }
-        void entry_removed() { ++entries_removed; }
-        void add_cached_bytes(size_t count) { cached_bytes += count; }
-        void dec_cached_bytes(size_t count) { cached_bytes -= count; }
+        /**
+         * Replay batches against the key-value store.
+         *
+         * Used in recovery:
+         *    segment -> parser -> replay_consumer -> db
+         */
+        class replay_consumer final : public batch_consumer {
+        public:
+            explicit replay_consumer(partition* store)
+              : _store(store) {}
 
-        uint64_t segments_rolled{0};
-        uint64_t entries_fetched{0};
-        uint64_t entries_written{0};
-        uint64_t entries_removed{0};
-        size_t cached_bytes{0};
+            consume_result
+            accept_batch_start(const model::record_batch_header&) const override;
+            void consume_batch_start(
+              model::record_batch_header header, size_t, size_t) override;
+            void skip_batch_start(
+              model::record_batch_header header, size_t, size_t) override;
+            void consume_records(iobuf&&) override;
+            stop_parser consume_batch_end() override;
+            void print(std::ostream&) const override;
 
-        ss::metrics::metric_groups metrics;
+        private:
+            partition* _store;
+            model::offset _last_offset;
+            model::record_batch_header _header;
+            iobuf _records;
+        };
+
+        friend replay_consumer;
+
+        probe _probe;
     };
 
-    probe _probe;
+    /*
+     * Partitions of the store. The first one holds the key spaces that
+     * don't have a partition of their own and uses the directory of the
+     * single log store of older versions.
+     */
+    enum class partition_id : int8_t {
+        shared = 0,
+        consensus = 1,
+        offset_translator = 2,
+    };
+    static constexpr size_t partition_count = 3;
+
+    static partition_id partition_of(key_space ks);
+    partition& get_partition(key_space ks);
+
+    /*
+     * Move the keys written by older versions to the shared partition into
+     * the partitions of their key spaces.
+     */
+    ss::future<> migrate_key_spaces();
+
+    void setup_metrics();
+
+    template<typename Func>
+    uint64_t sum_probes(Func f) const {
+        uint64_t res = 0;
+        for (const auto& p : _partitions) {
+            res += f(p->get_probe());
+        }
+        return res;
+    }
+
+    bool _started{false};
+    std::vector<std::unique_ptr<partition>> _partitions;
+    ss::metrics::metric_groups _metrics;
 };
 
 } // namespace storage
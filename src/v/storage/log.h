@@ -49,11 +49,18 @@ public:
         // it shouldn't block for a long time as it will block other logs
         // eviction
         virtual ss::future<> compact(compaction_config) = 0;
+        // cheap check telling if compact() may have anything to do, used to
+        // skip idle logs in housekeeping
+        virtual bool needs_housekeeping(const compaction_config&) const = 0;
         virtual ss::future<> truncate(truncate_config) = 0;
         virtual ss::future<> truncate_prefix(truncate_prefix_config) = 0;
 
         virtual ss::future<model::record_batch_reader>
           make_reader(log_reader_config) = 0;
+        // returns std::nullopt when the range can not be served as a single
+        // on-disk extent, callers should fall back to make_reader
+        virtual ss::future<std::optional<extent_read_result>>
+          read_extent(extent_read_config) = 0;
         virtual log_appender make_appender(log_append_config) = 0;
 
         // final operation. Invalid filesystem state after
@@ -65,6 +72,9 @@ public:
 
         virtual ss::future<std::optional<timequery_result>>
           timequery(timequery_config) = 0;
+        // std::nullopt when the key is not in the log
+        virtual ss::future<std::optional<key_lookup_result>>
+          key_lookup(key_lookup_config) = 0;
 
         const ntp_config& config() const { return _config; }
 
@@ -139,6 +149,11 @@ public:
         return _impl->make_reader(cfg);
     }
 
+    ss::future<std::optional<extent_read_result>>
+    read_extent(extent_read_config cfg) {
+        return _impl->read_extent(cfg);
+    }
+
     log_appender make_appender(log_append_config cfg) {
         return _impl->make_appender(cfg);
     }
@@ -163,6 +178,18 @@ public:
         return _impl->timequery(cfg);
     }
 
+    /**
+     * \brief Returns the offset and value of the latest record of a key
+     *
+     * Meant for compacted logs, where the compaction index of the sealed
+     * segments makes this a read of the segments that contain the key rather
+     * than a scan of the log.
+     */
+    ss::future<std::optional<key_lookup_result>>
+    key_lookup(key_lookup_config cfg) {
+        return _impl->key_lookup(std::move(cfg));
+    }
+
     ss::future<> compact(compaction_config cfg) { return _impl->compact(cfg); }
 
     /**
@@ -194,6 +221,10 @@ public:
 
     int64_t compaction_backlog() const { return _impl->compaction_backlog(); }
 
+    bool needs_housekeeping(const compaction_config& cfg) const {
+        return _impl->needs_housekeeping(cfg);
+    }
+
     std::ostream& print(std::ostream& o) const { return _impl->print(o); }
 
     size_t size_bytes() const { return _impl->size_bytes(); }
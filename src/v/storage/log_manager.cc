@@ -12,12 +12,14 @@
 #include "config/configuration.h"
 #include "likely.h"
 #include "model/fundamental.h"
+#include "model/namespace.h"
 #include "model/timestamp.h"
 #include "resource_mgmt/io_priority.h"
 #include "ssx/async-clear.h"
 #include "ssx/future-util.h"
 #include "storage/batch_cache.h"
 #include "storage/compacted_index_writer.h"
+#include "storage/disk_log_impl.h"
 #include "storage/fs_utils.h"
 #include "storage/kvstore.h"
 #include "storage/log.h"
@@ -48,6 +50,7 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <chrono>
 #include <exception>
 #include <filesystem>
@@ -71,6 +74,12 @@ log_manager::log_manager(
           _config.compaction_interval()};
     });
 }
+void log_manager::setup_metrics() {
+    if (_config.cache == with_cache::yes) {
+        _batch_cache.setup_metrics();
+    }
+}
+
 void log_manager::trigger_housekeeping() {
     ssx::background = ssx::spawn_with_gate_then(_open_gate, [this] {
                           auto next_housekeeping = _jitter();
@@ -142,12 +151,18 @@ log_manager::housekeeping_scan(model::timestamp collection_threshold) {
         _logs_list.push_back(current_log);
 
         current_log.flags |= bflags::compacted;
-        current_log.last_compaction = ss::lowres_clock::now();
-        co_await current_log.handle.compact(compaction_config(
+        auto cfg = compaction_config(
           collection_threshold,
           _config.retention_bytes(),
           _config.compaction_priority,
-          _abort_source));
+          _abort_source);
+        if (current_log.handle.needs_housekeeping(cfg)) {
+            current_log.last_compaction = ss::lowres_clock::now();
+            co_await current_log.handle.compact(cfg);
+        } else {
+            // idle logs are only checked, yield now and then on large nodes
+            co_await ss::coroutine::maybe_yield();
+        }
 
         if (_logs_list.empty()) {
             co_return;
@@ -168,10 +183,83 @@ ss::future<> log_manager::housekeeping() {
 
     return ss::with_scheduling_group(
       _config.compaction_sg, [this, collection_threshold] {
-          return housekeeping_scan(collection_threshold);
+          return housekeeping_scan(collection_threshold).then([this] {
+              return maybe_reclaim_space();
+          });
       });
 }
 
+ss::future<> log_manager::maybe_reclaim_space() {
+    if (!config::shard_local_cfg().storage_space_reclaim_enabled()) {
+        co_return;
+    }
+    const auto goal = _resources.reclaim_goal();
+    if (goal == 0) {
+        co_return;
+    }
+    vlog(
+      gclog.info,
+      "Free disk space under target, reclaiming {} bytes (reserved: {})",
+      goal,
+      _resources.reserved_space());
+    auto reclaimed = co_await reclaim_space(goal);
+    vlog(gclog.info, "Reclaimed {} of {} bytes", reclaimed, goal);
+}
+
+ss::future<size_t> log_manager::reclaim_space(size_t goal) {
+    struct candidate {
+        model::timestamp max_timestamp;
+        model::ntp ntp;
+    };
+    size_t reclaimed = 0;
+    // every pass removes at most one segment of every log, oldest first
+    while (reclaimed < goal && !_abort_source.abort_requested()) {
+        std::vector<candidate> candidates;
+        for (auto& [ntp, meta] : _logs) {
+            auto dlog = dynamic_cast<disk_log_impl*>(meta->handle.get_impl());
+            if (!dlog) {
+                continue;
+            }
+            if (auto ts = dlog->reclaimable_segment_timestamp(); ts) {
+                candidates.push_back({*ts, ntp});
+            }
+        }
+        if (candidates.empty()) {
+            break;
+        }
+        std::sort(
+          candidates.begin(),
+          candidates.end(),
+          [](const candidate& a, const candidate& b) {
+              return a.max_timestamp < b.max_timestamp;
+          });
+
+        const auto pass_start = reclaimed;
+        for (const auto& c : candidates) {
+            if (reclaimed >= goal || _abort_source.abort_requested()) {
+                break;
+            }
+            // the log may have been removed while removing other segments
+            auto it = _logs.find(c.ntp);
+            if (it == _logs.end()) {
+                continue;
+            }
+            auto handle = it->second->handle;
+            auto dlog = dynamic_cast<disk_log_impl*>(handle.get_impl());
+            try {
+                reclaimed += co_await dlog->reclaim_oldest_segment(
+                  _abort_source);
+            } catch (const ss::gate_closed_exception&) {
+                // log is closing
+            }
+        }
+        if (reclaimed == pass_start) {
+            break;
+        }
+    }
+    co_return reclaimed;
+}
+
 /**
  *
  * @param read_buf_size size of underlying ss::input_stream's buffer
@@ -187,35 +275,99 @@ ss::future<ss::lw_shared_ptr<segment>> log_manager::make_log_segment(
     return ss::with_gate(
       _open_gate,
       [this, &ntp, base_offset, term, pc, version, read_buf_size, read_ahead] {
-          return make_segment(
-            ntp,
-            base_offset,
-            term,
-            pc,
-            version,
-            read_buf_size,
-            read_ahead,
-            _config.sanitize_fileops,
-            create_cache(ntp.cache_enabled()),
-            _resources);
+          // reuse a pre-allocated data file of a removed segment if any
+          auto path = segment_path::make_segment_path(
+            ntp, base_offset, term, version);
+          return _resources.get_segment_pool().take(path).then(
+            [this,
+             &ntp,
+             base_offset,
+             term,
+             pc,
+             version,
+             read_buf_size,
+             read_ahead](std::optional<size_t> preallocated) {
+                return make_segment(
+                  ntp,
+                  base_offset,
+                  term,
+                  pc,
+                  version,
+                  read_buf_size,
+                  read_ahead,
+                  _config.sanitize_fileops,
+                  create_cache(ntp),
+                  _resources,
+                  preallocated.value_or(0));
+            });
       });
 }
 
 std::optional<batch_cache_index>
-log_manager::create_cache(with_cache ntp_cache_enabled) {
+log_manager::create_cache(const ntp_config& cfg) {
     if (unlikely(
           _config.cache == with_cache::no
-          || ntp_cache_enabled == with_cache::no)) {
+          || cfg.cache_enabled() == with_cache::no)) {
         return std::nullopt;
     }
 
-    return batch_cache_index(_batch_cache);
+    return batch_cache_index(_batch_cache, cache_owner(cfg.ntp()));
+}
+
+ss::lw_shared_ptr<batch_cache_owner>
+log_manager::cache_owner(const model::ntp& ntp) {
+    auto it = _batch_cache_owners.find(ntp);
+    if (it == _batch_cache_owners.end()) {
+        // internal topics are read by redpanda itself, e.g. on every consumer
+        // group commit or transaction, keep them cached over client data
+        const bool internal = ntp.ns != model::kafka_namespace
+                              || ntp.tp.topic
+                                   == model::kafka_consumer_offsets_topic;
+        it = _batch_cache_owners
+               .emplace(
+                 ntp,
+                 ss::make_lw_shared<batch_cache_owner>(batch_cache_owner{
+                   .priority = internal ? batch_cache_priority::high
+                                        : batch_cache_priority::regular}))
+               .first;
+    }
+    return it->second;
+}
+
+ss::lw_shared_ptr<topic_disk_usage>
+log_manager::topic_usage(const model::ntp& ntp) {
+    auto it = _topic_usage.find(model::topic_namespace_view(ntp));
+    if (it == _topic_usage.end()) {
+        it = _topic_usage
+               .emplace(
+                 model::topic_namespace(ntp.ns, ntp.tp.topic),
+                 ss::make_lw_shared<topic_disk_usage>())
+               .first;
+    }
+    return it->second;
+}
+
+topic_disk_usage
+log_manager::topic_usage(model::topic_namespace_view tp_ns) const {
+    auto it = _topic_usage.find(tp_ns);
+    if (it == _topic_usage.end()) {
+        return topic_disk_usage{};
+    }
+    return *it->second;
+}
+
+void log_manager::release_topic_usage(const model::ntp& ntp) {
+    auto it = _topic_usage.find(model::topic_namespace_view(ntp));
+    if (it != _topic_usage.end() && it->second->partitions == 0) {
+        _topic_usage.erase(it);
+    }
 }
 
-ss::future<log> log_manager::manage(ntp_config cfg) {
+ss::future<log>
+log_manager::manage(ntp_config cfg, recovery_priority prio) {
     auto gate = _open_gate.hold();
 
-    auto units = co_await _resources.get_recovery_units();
+    auto units = co_await _resources.get_recovery_units(prio);
     co_return co_await do_manage(std::move(cfg));
 }
 
@@ -270,12 +422,11 @@ ss::future<log> log_manager::do_manage(ntp_config cfg) {
     co_await recover_log_state(cfg);
 
     ss::sstring path = cfg.work_directory();
-    with_cache cache_enabled = cfg.cache_enabled();
     auto segments = co_await recover_segments(
       std::filesystem::path(path),
       _config.sanitize_fileops,
       cfg.is_compacted(),
-      [this, cache_enabled] { return create_cache(cache_enabled); },
+      [this, &cfg] { return create_cache(cfg); },
       _abort_source,
       config::shard_local_cfg().storage_read_buffer_size(),
       config::shard_local_cfg().storage_read_readahead_count(),
@@ -296,16 +447,19 @@ ss::future<> log_manager::shutdown(model::ntp ntp) {
     vlog(stlog.debug, "Asked to shutdown: {}", ntp);
     auto gate = _open_gate.hold();
     auto handle = _logs.extract(ntp);
+    _batch_cache_owners.erase(ntp);
     if (handle.empty()) {
         co_return;
     }
     co_await clean_close(handle.mapped()->handle);
+    release_topic_usage(ntp);
 }
 
 ss::future<> log_manager::remove(model::ntp ntp) {
     vlog(stlog.info, "Asked to remove: {}", ntp);
     return ss::with_gate(_open_gate, [this, ntp = std::move(ntp)] {
         auto handle = _logs.extract(ntp);
+        _batch_cache_owners.erase(ntp);
         _resources.update_partition_count(_logs.size());
         if (handle.empty()) {
             return ss::make_ready_future<>();
@@ -321,6 +475,7 @@ ss::future<> log_manager::remove(model::ntp ntp) {
         auto ntp_dir = lg.config().work_directory();
         ss::sstring topic_dir = lg.config().topic_directory().string();
         return lg.remove()
+          .then([this, ntp = lg.config().ntp()] { release_topic_usage(ntp); })
           .then([dir = std::move(ntp_dir)] { return ss::remove_file(dir); })
           .then([this, dir = std::move(topic_dir)]() mutable {
               // We always dispatch topic directory deletion to core 0 as
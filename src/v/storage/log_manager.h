@@ -13,6 +13,7 @@
 
 #include "config/property.h"
 #include "model/fundamental.h"
+#include "model/metadata.h"
 #include "random/simple_time_jitter.h"
 #include "seastarx.h"
 #include "storage/batch_cache.h"
@@ -185,7 +186,8 @@ public:
     explicit log_manager(
       log_config, kvstore& kvstore, storage_resources&) noexcept;
 
-    ss::future<log> manage(ntp_config);
+    ss::future<log>
+      manage(ntp_config, recovery_priority = recovery_priority::normal);
 
     ss::future<> shutdown(model::ntp);
 
@@ -202,6 +204,10 @@ public:
 
     ss::future<> stop();
 
+    /// registers the shard wide metrics of the manager, at most one manager
+    /// per shard may do so
+    void setup_metrics();
+
     ss::future<ss::lw_shared_ptr<segment>> make_log_segment(
       const ntp_config&,
       model::offset,
@@ -231,6 +237,33 @@ public:
 
     storage_resources& resources() { return _resources; }
 
+    /**
+     * Removes the oldest segments of the logs of this shard, oldest data
+     * first, until `goal` bytes are reclaimed or no more data can be removed.
+     * Only data that retention could remove is considered, see
+     * disk_log_impl::reclaimable_segment_timestamp. Returns the bytes
+     * reclaimed.
+     */
+    ss::future<size_t> reclaim_space(size_t goal);
+
+    /**
+     * Returns the batch cache accounting of the log of the ntp, shared by
+     * the cache indices of its segments. Logs of internal topics get a high
+     * cache priority so their batches are reclaimed last.
+     */
+    ss::lw_shared_ptr<batch_cache_owner> cache_owner(const model::ntp&);
+
+    /**
+     * Returns the disk usage accounting of the topic of the ntp, shared by
+     * the logs of the topic that are open on this shard.
+     */
+    ss::lw_shared_ptr<topic_disk_usage> topic_usage(const model::ntp&);
+
+    /**
+     * Disk usage of the open logs of a topic on this shard, constant time.
+     */
+    topic_disk_usage topic_usage(model::topic_namespace_view) const;
+
 private:
     using logs_type
       = absl::flat_hash_map<model::ntp, std::unique_ptr<log_housekeeping_meta>>;
@@ -247,13 +280,15 @@ private:
     void trigger_housekeeping();
     ss::future<> housekeeping();
 
-    std::optional<batch_cache_index> create_cache(with_cache);
+    std::optional<batch_cache_index> create_cache(const ntp_config&);
 
     ss::future<> dispatch_topic_dir_deletion(ss::sstring dir);
     ss::future<> recover_log_state(const ntp_config&);
     ss::future<> async_clear_logs();
+    void release_topic_usage(const model::ntp&);
 
     ss::future<> housekeeping_scan(model::timestamp);
+    ss::future<> maybe_reclaim_space();
 
     log_config _config;
     kvstore& _kvstore;
@@ -263,6 +298,14 @@ private:
     logs_type _logs;
     compaction_list_type _logs_list;
     batch_cache _batch_cache;
+    absl::flat_hash_map<model::ntp, ss::lw_shared_ptr<batch_cache_owner>>
+      _batch_cache_owners;
+    absl::flat_hash_map<
+      model::topic_namespace,
+      ss::lw_shared_ptr<topic_disk_usage>,
+      model::topic_namespace_hash,
+      model::topic_namespace_eq>
+      _topic_usage;
     ss::gate _open_gate;
     ss::abort_source _abort_source;
 
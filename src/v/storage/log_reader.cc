@@ -11,7 +11,10 @@
 
 #include "bytes/iobuf.h"
 #include "model/record.h"
+#include "resource_mgmt/io_priority.h"
 #include "storage/logger.h"
+#include "storage/segment.h"
+#include "storage/storage_resources.h"
 #include "vassert.h"
 #include "vlog.h"
 
@@ -202,11 +205,20 @@ log_segment_batch_reader::read_some(model::timeout_clock::time_point timeout) {
         _iterator = co_await initialize(timeout, cache_read.next_cached_batch);
     }
     auto ptr = _iterator.get();
+    auto m = _probe.read_latency().maybe_measure();
     co_return co_await ptr->consume().then(
-      [this](result<size_t> bytes_consumed) -> result<records_t> {
+      [this, start = std::chrono::steady_clock::now(), m = std::move(m)](
+        result<size_t> bytes_consumed) -> result<records_t> {
           if (!bytes_consumed) {
               return bytes_consumed.error();
           }
+          // disk reads of fetches pace recovery I/O
+          if (_config.prio.id() == kafka_read_priority().id()) {
+              _seg.resources().get_io_share_controller().record_latency(
+                io_share_controller::latency_class::fetch,
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - start));
+          }
           auto tmp = std::exchange(_state, {});
           return result<records_t>(std::move(tmp.buffer));
       });
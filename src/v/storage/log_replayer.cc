@@ -16,6 +16,7 @@
 #include "storage/logger.h"
 #include "storage/parser.h"
 #include "storage/segment.h"
+#include "units.h"
 #include "utils/vint.h"
 #include "vlog.h"
 
@@ -23,13 +24,31 @@
 #include <type_traits>
 
 namespace storage {
+/**
+ * Validates batch checksums in groups, so that the crc computation of several
+ * batches can be interleaved (see crc::crc32c_extend_multi). Batches are only
+ * tracked in the checkpoint and the index once their whole group has been
+ * verified, in order, stopping at the first invalid batch.
+ */
 class checksumming_consumer final : public batch_consumer {
 public:
-    checksumming_consumer(segment* s, log_replayer::checkpoint& c)
+    static constexpr size_t max_pending_batches = 6;
+    static constexpr size_t max_pending_bytes = 512_KiB;
+
+    /**
+     * Parsing starts at start_pos, the index must already track every batch
+     * before it.
+     */
+    checksumming_consumer(
+      segment* s, log_replayer::checkpoint& c, size_t start_pos)
       : _seg(s)
-      , _cfg(c) {
-        // we'll reconstruct the state manually
-        _seg->index().reset();
+      , _cfg(c)
+      , _start_pos(start_pos) {
+        if (_start_pos == 0) {
+            // we'll reconstruct the state manually
+            _seg->index().reset();
+        }
+        _pending.reserve(max_pending_batches);
     }
     checksumming_consumer(const checksumming_consumer&) = delete;
     checksumming_consumer& operator=(const checksumming_consumer&) = delete;
@@ -48,33 +67,61 @@ public:
       model::record_batch_header header,
       size_t physical_base_offset,
       size_t size_on_disk) override {
-        _header = header;
-        _file_pos_to_end_of_batch = size_on_disk + physical_base_offset;
-        _crc = crc::crc32c();
-        model::crc_record_batch_header(_crc, header);
+        auto& p = _pending.emplace_back(pending_batch{
+          .header = header,
+          .file_pos_to_end_of_batch = _start_pos + size_on_disk
+                                      + physical_base_offset,
+        });
+        model::crc_record_batch_header(p.crc, header);
     }
 
     void consume_records(iobuf&& records) override {
-        crc_extend_iobuf(_crc, records);
+        _pending_bytes += records.size_bytes();
+        _pending.back().records = std::move(records);
     }
 
     stop_parser consume_batch_end() override {
-        if (is_valid_batch_crc()) {
-            _cfg.last_offset = _header.last_offset();
-            _cfg.truncate_file_pos = _file_pos_to_end_of_batch;
-            const auto physical_base_offset = _file_pos_to_end_of_batch
-                                              - _header.size_bytes;
-            _seg->index().maybe_track(_header, physical_base_offset);
-            _header = {};
+        if (
+          _pending.size() < max_pending_batches
+          && _pending_bytes < max_pending_bytes) {
             return stop_parser::no;
         }
-        return stop_parser::yes;
+        return stop_parser(!flush());
     }
 
-    bool is_valid_batch_crc() const {
-        // crc is calculated as a uint32_t but because of kafka we carry around
-        // a signed type in the batch structure
-        return (uint32_t)_header.crc == _crc.value();
+    /**
+     * Verifies all pending batches, returns false if an invalid batch was
+     * found. Must be called once parsing has finished.
+     */
+    bool flush() {
+        std::vector<crc::crc32c> crcs;
+        std::vector<const iobuf*> records;
+        crcs.reserve(_pending.size());
+        records.reserve(_pending.size());
+        for (auto& p : _pending) {
+            crcs.push_back(p.crc);
+            records.push_back(&p.records);
+        }
+        crc_extend_iobufs(crcs, records);
+
+        bool valid = true;
+        for (size_t i = 0; i < _pending.size(); ++i) {
+            const auto& hdr = _pending[i].header;
+            // crc is calculated as a uint32_t but because of kafka we carry
+            // around a signed type in the batch structure
+            if ((uint32_t)hdr.crc != crcs[i].value()) {
+                valid = false;
+                break;
+            }
+            _cfg.last_offset = hdr.last_offset();
+            _cfg.truncate_file_pos = _pending[i].file_pos_to_end_of_batch;
+            const auto physical_base_offset
+              = _pending[i].file_pos_to_end_of_batch - hdr.size_bytes;
+            _seg->index().maybe_track(hdr, physical_base_offset);
+        }
+        _pending.clear();
+        _pending_bytes = 0;
+        return valid;
     }
 
     void print(std::ostream& os) const override {
@@ -82,25 +129,55 @@ public:
     }
 
 private:
-    model::record_batch_header _header;
+    struct pending_batch {
+        model::record_batch_header header;
+        iobuf records;
+        size_t file_pos_to_end_of_batch{0};
+        crc::crc32c crc;
+    };
+
     segment* _seg;
     log_replayer::checkpoint& _cfg;
-    crc::crc32c _crc;
-    size_t _file_pos_to_end_of_batch{0};
+    size_t _start_pos;
+    std::vector<pending_batch> _pending;
+    size_t _pending_bytes{0};
 };
 
 // Called in the context of a ss::thread
 log_replayer::checkpoint
 log_replayer::recover_in_thread(const ss::io_priority_class& prio) {
     vlog(stlog.debug, "Recovering segment {}", *_seg);
-    // explicitly not using the index to recover the full file
-    auto data_stream = _seg->reader().data_stream(0, prio).get();
-    auto consumer = std::make_unique<checksumming_consumer>(_seg, _ckpt);
+    // the index is only trusted when it is a checkpoint, the data before it
+    // was durable when it was written. otherwise the full file is recovered
+    size_t start_pos = 0;
+    auto& idx = _seg->index();
+    if (idx.has_checkpoint()) {
+        const auto file_size = _seg->reader().stat().get0().st_size;
+        if (idx.checkpoint_file_pos() <= static_cast<size_t>(file_size)) {
+            start_pos = idx.checkpoint_file_pos();
+            _ckpt.last_offset = idx.checkpoint_offset();
+            _ckpt.truncate_file_pos = start_pos;
+            vlog(
+              stlog.debug,
+              "Recovering segment {} from checkpoint {}",
+              *_seg,
+              _ckpt);
+        }
+        idx.clear_checkpoint();
+    }
+    auto data_stream = _seg->reader().data_stream(start_pos, prio).get();
+    auto consumer = std::make_unique<checksumming_consumer>(
+      _seg, _ckpt, start_pos);
+    auto& checksummer = *consumer;
     auto parser = continuous_batch_parser(
       std::move(consumer), std::move(data_stream), true);
+    // batches parsed before the end of the stream (or a parse error) are
+    // still waiting for verification when the parser returns
     try {
         parser.consume().get();
+        checksummer.flush();
     } catch (...) {
+        checksummer.flush();
         vlog(
           stlog.warn,
           "{} partial recovery to {}, with: {}",
@@ -16,11 +16,13 @@
 #include "seastarx.h"
 #include "storage/log.h"
 #include "storage/logger.h"
+#include "storage/parser_utils.h"
 #include "storage/types.h"
 #include "vlog.h"
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/circular_buffer.hh>
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/future-util.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/lowres_clock.hh>
@@ -162,6 +164,9 @@ struct mem_log_impl final : log::impl {
     ss::future<> compact(compaction_config cfg) final {
         return gc(cfg.eviction_time, cfg.max_bytes);
     }
+    bool needs_housekeeping(const compaction_config&) const final {
+        return true;
+    }
     std::ostream& print(std::ostream& o) const final {
         fmt::print(o, "{{mem_log_impl:{}}}", offsets());
         return o;
@@ -183,6 +188,49 @@ struct mem_log_impl final : log::impl {
         }
         return ss::make_ready_future<ret_t>();
     }
+    ss::future<std::optional<key_lookup_result>>
+    key_lookup(key_lookup_config cfg) final {
+        const auto key = bytes_to_iobuf(cfg.key);
+        // there is no index, the batches are scanned newest first
+        std::vector<model::record_batch> batches;
+        for (auto& b : _data) {
+            if (b.base_offset() > cfg.max_offset) {
+                break;
+            }
+            if (
+              b.header().type == model::record_batch_type::raft_data
+              && b.last_offset() >= _start_offset) {
+                batches.push_back(b.share());
+            }
+        }
+        for (auto it = batches.rbegin(); it != batches.rend(); ++it) {
+            auto b = co_await internal::decompress_batch(std::move(*it));
+            std::optional<key_lookup_result> ret;
+            b.for_each_record([&](model::record r) {
+                auto o = b.base_offset() + model::offset(r.offset_delta());
+                if (
+                  o < _start_offset || o > cfg.max_offset || r.key_size() < 0
+                  || r.key() != key) {
+                    return;
+                }
+                std::optional<iobuf> value;
+                if (r.has_value()) {
+                    value = r.release_value();
+                }
+                ret = key_lookup_result{.offset = o, .value = std::move(value)};
+            });
+            if (ret) {
+                co_return ret;
+            }
+        }
+        co_return std::nullopt;
+    }
+    ss::future<std::optional<extent_read_result>>
+    read_extent(extent_read_config) final {
+        // there are no on-disk extents in the in-memory log
+        return ss::make_ready_future<std::optional<extent_read_result>>(
+          std::nullopt);
+    }
     ss::future<> truncate_prefix(truncate_prefix_config cfg) final {
         stlog.debug("PREFIX Truncating {} log at {}", config().ntp(), cfg);
         if (cfg.start_offset <= _start_offset) {
@@ -49,6 +49,10 @@ public:
 
         std::optional<bool> read_replica;
 
+        // if set, quorum writes are acknowledged before they are flushed and
+        // the log is flushed in the background
+        std::optional<bool> write_caching;
+
         friend std::ostream&
         operator<<(std::ostream&, const default_overrides&);
     };
@@ -157,6 +161,11 @@ public:
                && _overrides->read_replica.value();
     }
 
+    bool is_write_caching_enabled() const {
+        return _overrides != nullptr && _overrides->write_caching
+               && _overrides->write_caching.value();
+    }
+
 private:
     model::ntp _ntp;
     /// \brief currently this is the basedir. In the future
@@ -11,33 +11,118 @@
 
 #include "storage/offset_translator_state.h"
 
+#include "utils/delta_for.h"
 #include "vassert.h"
 
+#include <algorithm>
+
 namespace storage {
 
+model::offset offset_translator_state::first_offset() const {
+    if (!_frozen.empty()) {
+        return _frozen.front().first_offset;
+    }
+    return _last_offset2batch.begin()->first;
+}
+
+std::optional<int64_t>
+offset_translator_state::delta_before(model::offset o) const {
+    if (!_frozen.empty() && o <= _frozen.back().last_offset) {
+        auto block = std::lower_bound(
+          _frozen.begin(),
+          _frozen.end(),
+          o,
+          [](const frozen_block& b, model::offset offset) {
+              return b.last_offset < offset;
+          });
+        if (o <= block->first_offset) {
+            if (block == _frozen.begin()) {
+                return std::nullopt;
+            }
+            return std::prev(block)->last_delta;
+        }
+        auto entries = decode_block(*block);
+        auto it = std::lower_bound(
+          entries.begin(),
+          entries.end(),
+          o,
+          [](const entry& e, model::offset offset) {
+              return e.last_offset < offset;
+          });
+        return std::prev(it)->batch.next_delta;
+    }
+
+    auto it = _last_offset2batch.lower_bound(o);
+    if (it != _last_offset2batch.begin()) {
+        return std::prev(it)->second.next_delta;
+    }
+    if (!_frozen.empty()) {
+        return _frozen.back().last_delta;
+    }
+    return std::nullopt;
+}
+
+template<typename Func>
+void offset_translator_state::visit_from(model::offset o, Func f) const {
+    if (!_frozen.empty() && o <= _frozen.back().last_offset) {
+        auto block = std::lower_bound(
+          _frozen.begin(),
+          _frozen.end(),
+          o,
+          [](const frozen_block& b, model::offset offset) {
+              return b.last_offset < offset;
+          });
+        for (; block != _frozen.end(); ++block) {
+            for (const auto& e : decode_block(*block)) {
+                if (e.last_offset >= o && f(e)) {
+                    return;
+                }
+            }
+        }
+    }
+
+    for (auto it = _last_offset2batch.lower_bound(o);
+         it != _last_offset2batch.end();
+         ++it) {
+        if (f(entry{.last_offset = it->first, .batch = it->second})) {
+            return;
+        }
+    }
+}
+
+size_t offset_translator_state::size() const {
+    size_t frozen = 0;
+    for (const auto& b : _frozen) {
+        frozen += b.size;
+    }
+    return frozen + _last_offset2batch.size();
+}
+
 int64_t offset_translator_state::delta(model::offset o) const {
     if (_last_offset2batch.empty()) {
         return 0;
     }
 
-    auto it = _last_offset2batch.lower_bound(o);
-    if (it == _last_offset2batch.begin()) {
+    auto prev_delta = delta_before(o);
+    if (!prev_delta) {
         throw std::runtime_error{fmt::format(
           "ntp {}: log offset {} is outside the translation range (starting at "
           "{})",
           _ntp,
           o,
-          model::next_offset(_last_offset2batch.begin()->first))};
+          model::next_offset(first_offset()))};
     }
 
-    auto delta = std::prev(it)->second.next_delta;
-    if (it == _last_offset2batch.end() || o < it->second.base_offset) {
-        return delta;
-    } else {
-        // The offset is inside the non-data batch, so the data offset stops
-        // increasing at the base offset.
-        return delta + (o - it->second.base_offset);
-    }
+    auto delta = *prev_delta;
+    visit_from(o, [o, &delta](const entry& e) {
+        if (o >= e.batch.base_offset) {
+            // The offset is inside the non-data batch, so the data offset
+            // stops increasing at the base offset.
+            delta += (o - e.batch.base_offset)();
+        }
+        return true;
+    });
+    return delta;
 }
 
 model::offset offset_translator_state::from_log_offset(model::offset o) const {
@@ -55,12 +140,10 @@ model::offset offset_translator_state::to_log_offset(
         return data_offset;
     }
 
-    model::offset min_log_offset = model::next_offset(
-      _last_offset2batch.begin()->first);
+    model::offset min_log_offset = model::next_offset(first_offset());
 
     model::offset min_data_offset
-      = min_log_offset
-        - model::offset(_last_offset2batch.begin()->second.next_delta);
+      = min_log_offset - model::offset(*delta_before(min_log_offset));
     if (data_offset < min_data_offset) {
         throw std::runtime_error{fmt::format(
           "ntp {}: data offset {} is outside the translation range (starting "
@@ -78,24 +161,23 @@ model::offset offset_translator_state::to_log_offset(
     // log offset equal to `data_offset` (because log offset is at least as
     // big as data offset) and stopping when we find the interval where
     // given data offset is achievable.
-    auto interval_end_it = _last_offset2batch.lower_bound(search_start);
+    auto prev_delta = delta_before(search_start);
     vassert(
-      interval_end_it != _last_offset2batch.begin(),
+      prev_delta.has_value(),
       "ntp {}: log offset search start too small: {}",
+      _ntp,
       search_start);
-    auto delta = std::prev(interval_end_it)->second.next_delta;
+    auto delta = *prev_delta;
 
-    while (interval_end_it != _last_offset2batch.end()) {
+    visit_from(search_start, [data_offset, &delta](const entry& e) {
         model::offset max_do_this_interval
-          = model::prev_offset(interval_end_it->second.base_offset)
-            - model::offset{delta};
+          = model::prev_offset(e.batch.base_offset) - model::offset{delta};
         if (max_do_this_interval >= data_offset) {
-            break;
+            return true;
         }
-
-        delta = interval_end_it->second.next_delta;
-        ++interval_end_it;
-    }
+        delta = e.batch.next_delta;
+        return false;
+    });
 
     return data_offset + model::offset(delta);
 }
@@ -139,6 +221,7 @@ void offset_translator_state::add_gap(
     _last_offset2batch.emplace(
       last_offset,
       batch_info{.base_offset = base_offset, .next_delta = next_delta});
+    freeze();
 }
 
 bool offset_translator_state::add_absolute_delta(
@@ -178,6 +261,7 @@ bool offset_translator_state::add_absolute_delta(
             _last_offset2batch.emplace(
               prev,
               batch_info{.base_offset = base_offset, .next_delta = delta});
+            freeze();
             return true;
         } else {
             return false;
@@ -191,16 +275,27 @@ bool offset_translator_state::truncate(model::offset offset) {
       "ntp {}: offsets map shouldn't be empty",
       _ntp);
 
-    auto it = _last_offset2batch.lower_bound(offset);
-    if (it == _last_offset2batch.begin()) {
+    if (offset <= first_offset()) {
         throw std::runtime_error{fmt::format(
           "ntp {}: trying to truncate offset_translator at offset {} which is "
           "<= base translation offset {}",
           _ntp,
           offset,
-          _last_offset2batch.begin()->first)};
+          first_offset())};
     }
 
+    if (!_frozen.empty() && offset <= _frozen.back().last_offset) {
+        auto block = std::lower_bound(
+          _frozen.begin(),
+          _frozen.end(),
+          offset,
+          [](const frozen_block& b, model::offset offset) {
+              return b.last_offset < offset;
+          });
+        thaw(std::distance(_frozen.begin(), block));
+    }
+
+    auto it = _last_offset2batch.lower_bound(offset);
     if (it != _last_offset2batch.end()) {
         if (offset > it->second.base_offset) {
             throw std::runtime_error{fmt::format(
@@ -213,6 +308,9 @@ bool offset_translator_state::truncate(model::offset offset) {
         }
 
         _last_offset2batch.erase(it, _last_offset2batch.end());
+        if (_last_offset2batch.empty()) {
+            thaw(_frozen.size() - 1);
+        }
         return true;
     }
 
@@ -225,6 +323,61 @@ bool offset_translator_state::prefix_truncate(model::offset offset) {
       "ntp {}: offsets map shouldn't be empty",
       _ntp);
 
+    auto block = std::upper_bound(
+      _frozen.begin(),
+      _frozen.end(),
+      offset,
+      [](model::offset o, const frozen_block& b) { return o < b.last_offset; });
+
+    if (block != _frozen.end()) {
+        // The offset is inside the frozen blocks. Blocks preceding the one
+        // that contains the first batch after the offset are removed, the
+        // block is encoded again starting with the new base batch.
+        auto entries = decode_block(*block);
+        auto next = std::upper_bound(
+          entries.begin(),
+          entries.end(),
+          offset,
+          [](model::offset o, const entry& e) { return o < e.last_offset; });
+        if (offset >= next->batch.base_offset) {
+            throw std::runtime_error{fmt::format(
+              "ntp {}: trying to prefix truncate offset translator at offset "
+              "{} which is in the middle of the batch {}-{}",
+              _ntp,
+              offset,
+              next->batch.base_offset,
+              next->last_offset)};
+        }
+
+        int64_t base_delta = 0;
+        if (next != entries.begin()) {
+            auto prev = std::prev(next);
+            if (
+              block == _frozen.begin() && prev == entries.begin()
+              && prev->last_offset == offset) {
+                return false;
+            }
+            base_delta = prev->batch.next_delta;
+        } else if (block != _frozen.begin()) {
+            base_delta = std::prev(block)->last_delta;
+        } else {
+            return false;
+        }
+
+        std::vector<entry> truncated;
+        truncated.reserve(std::distance(next, entries.end()) + 1);
+        truncated.push_back(entry{
+          .last_offset = offset,
+          .batch = batch_info{.base_offset = offset, .next_delta = base_delta},
+        });
+        truncated.insert(truncated.end(), next, entries.end());
+
+        _frozen.erase(_frozen.begin(), std::next(block));
+        auto blocks = encode_blocks(truncated);
+        _frozen.insert(_frozen.begin(), blocks.begin(), blocks.end());
+        return true;
+    }
+
     auto it = _last_offset2batch.upper_bound(offset);
     if (it != _last_offset2batch.end() && offset >= it->second.base_offset) {
         throw std::runtime_error{fmt::format(
@@ -236,22 +389,124 @@ bool offset_translator_state::prefix_truncate(model::offset offset) {
           it->first)};
     }
 
-    if (it == _last_offset2batch.begin()) {
-        return false;
-    }
-
-    auto prev_it = std::prev(it);
-    if (prev_it == _last_offset2batch.begin() && prev_it->first == offset) {
+    batch_info base_batch;
+    if (it != _last_offset2batch.begin()) {
+        auto prev_it = std::prev(it);
+        if (
+          _frozen.empty() && prev_it == _last_offset2batch.begin()
+          && prev_it->first == offset) {
+            return false;
+        }
+        base_batch = prev_it->second;
+    } else if (!_frozen.empty()) {
+        // the last frozen batch is the new base batch
+        if (
+          _frozen.size() == 1 && _frozen.front().size == 1
+          && _frozen.front().last_offset == offset) {
+            return false;
+        }
+        base_batch.next_delta = _frozen.back().last_delta;
+    } else {
         return false;
     }
 
-    auto base_batch = prev_it->second;
     base_batch.base_offset = offset;
+    _frozen.clear();
     _last_offset2batch.erase(_last_offset2batch.begin(), it);
     _last_offset2batch.emplace(offset, base_batch);
     return true;
 }
 
+void offset_translator_state::freeze() {
+    while (_last_offset2batch.size() >= resident_batches + block_size) {
+        std::array<entry, block_size> entries;
+        auto it = _last_offset2batch.begin();
+        for (auto& e : entries) {
+            e = entry{.last_offset = it->first, .batch = it->second};
+            ++it;
+        }
+        _frozen.push_back(encode_block(entries.data(), entries.size()));
+        _last_offset2batch.erase(_last_offset2batch.begin(), it);
+    }
+}
+
+void offset_translator_state::thaw(size_t from) {
+    for (auto it = std::next(_frozen.begin(), from); it != _frozen.end();
+         ++it) {
+        for (const auto& e : decode_block(*it)) {
+            _last_offset2batch.emplace(e.last_offset, e.batch);
+        }
+    }
+    _frozen.erase(std::next(_frozen.begin(), from), _frozen.end());
+}
+
+offset_translator_state::frozen_block
+offset_translator_state::encode_block(const entry* entries, size_t size) {
+    vassert(
+      size > 0 && size <= block_size, "invalid frozen block size {}", size);
+    using row_t = deltafor_encoder<int64_t>::row_t;
+    const auto& first = entries[0];
+    const auto& last = entries[size - 1];
+    row_t offsets{};
+    row_t lengths{};
+    row_t deltas{};
+    // the rows are padded with the last batch
+    for (size_t i = 0; i < block_size; ++i) {
+        const auto& e = entries[std::min(i, size - 1)];
+        offsets[i] = e.last_offset() - first.last_offset();
+        lengths[i] = e.last_offset() - e.batch.base_offset();
+        deltas[i] = e.batch.next_delta - first.batch.next_delta;
+    }
+    deltafor_encoder<int64_t> encoder(0);
+    encoder.add(offsets);
+    encoder.add(lengths);
+    encoder.add(deltas);
+    return frozen_block{
+      .first_offset = first.last_offset,
+      .last_offset = last.last_offset,
+      .first_delta = first.batch.next_delta,
+      .last_delta = last.batch.next_delta,
+      .size = static_cast<uint8_t>(size),
+      .data = iobuf_to_bytes(encoder.copy()),
+    };
+}
+
+std::vector<offset_translator_state::entry>
+offset_translator_state::decode_block(const frozen_block& block) {
+    using row_t = deltafor_decoder<int64_t>::row_t;
+    row_t offsets{};
+    row_t lengths{};
+    row_t deltas{};
+    deltafor_decoder<int64_t> decoder(0, 3, bytes_to_iobuf(block.data));
+    decoder.read(offsets);
+    decoder.read(lengths);
+    decoder.read(deltas);
+
+    std::vector<entry> entries;
+    entries.reserve(block.size);
+    for (size_t i = 0; i < block.size; ++i) {
+        auto last_offset = block.first_offset + model::offset(offsets[i]);
+        entries.push_back(entry{
+          .last_offset = last_offset,
+          .batch = batch_info{
+            .base_offset = last_offset - model::offset(lengths[i]),
+            .next_delta = block.first_delta + deltas[i],
+          }});
+    }
+    return entries;
+}
+
+std::vector<offset_translator_state::frozen_block>
+offset_translator_state::encode_blocks(const std::vector<entry>& entries) {
+    std::vector<frozen_block> blocks;
+    blocks.reserve((entries.size() + block_size - 1) / block_size);
+    for (size_t i = 0; i < entries.size(); i += block_size) {
+        blocks.push_back(encode_block(
+          entries.data() + i, std::min(block_size, entries.size() - i)));
+    }
+    return blocks;
+}
+
 namespace {
 
 struct persisted_batch {
@@ -288,15 +543,20 @@ iobuf offset_translator_state::serialize_map() const {
       _ntp);
 
     std::vector<persisted_batch> batches;
-    batches.reserve(_last_offset2batch.size());
-    for (const auto& [o, b] : _last_offset2batch) {
-        int32_t length = int32_t(o - b.base_offset) + 1;
-        batches.push_back(
-          persisted_batch{.base_offset = b.base_offset, .length = length});
-    }
+    batches.reserve(size());
+    int64_t start_delta = 0;
+    visit_from(first_offset(), [&batches, &start_delta](const entry& e) {
+        if (batches.empty()) {
+            start_delta = e.batch.next_delta;
+        }
+        int32_t length = int32_t(e.last_offset - e.batch.base_offset) + 1;
+        batches.push_back(persisted_batch{
+          .base_offset = e.batch.base_offset, .length = length});
+        return false;
+    });
 
     persisted_batches_map persisted{
-      .start_delta = _last_offset2batch.begin()->second.next_delta,
+      .start_delta = start_delta,
       .batches = std::move(batches),
     };
 
@@ -338,6 +598,7 @@ offset_translator_state::from_serialized_map(model::ntp ntp, iobuf buf) {
 
     offset_translator_state state(std::move(ntp));
     state._last_offset2batch = std::move(last_offset2batch);
+    state.freeze();
     return state;
 }
 
@@ -348,6 +609,7 @@ offset_translator_state offset_translator_state::from_bootstrap_state(
         state._last_offset2batch.emplace(
           o, batch_info{.base_offset = o, .next_delta = d});
     }
+    state.freeze();
     return state;
 }
 
@@ -359,8 +621,11 @@ operator<<(std::ostream& os, const offset_translator_state& state) {
         return os << "{empty}";
     }
 
-    return os << "{base offset/delta: " << map.begin()->first << "/"
-              << map.begin()->second.next_delta << ", map size: " << map.size()
+    auto base_offset = state.first_offset();
+    return os << "{base offset/delta: " << base_offset << "/"
+              << *state.delta_before(model::next_offset(base_offset))
+              << ", map size: " << state.size()
+              << ", frozen blocks: " << state._frozen.size()
               << ", last delta: " << map.rbegin()->second.next_delta << "}";
 }
 
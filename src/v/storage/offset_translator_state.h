@@ -11,11 +11,15 @@
 
 #pragma once
 
+#include "bytes/bytes.h"
 #include "model/fundamental.h"
 #include "serde/serde.h"
 
 #include <absl/container/btree_map.h>
 
+#include <deque>
+#include <optional>
+
 namespace storage {
 
 /// Provides offset translation between raw log offsets and offsets not counting
@@ -28,8 +32,18 @@ namespace storage {
 /// It works by maintaining an in-memory map of all filtered batch offsets.
 /// This map allows us to quickly find a delta between the raw log offset and
 /// corresponding translated offset.
+///
+/// Only the most recent batches are kept in the map. Older batches are frozen
+/// in blocks of delta-FOR encoded rows, a lookup of an old offset decodes a
+/// single block.
 class offset_translator_state {
+    // number of batches in a frozen block
+    static constexpr size_t block_size = 16;
+
 public:
+    // number of most recent batches that are never frozen
+    static constexpr size_t resident_batches = 256;
+
     /// Create an empty translator - the delta between log and kafka offsets is
     /// always 0
     offset_translator_state(model::ntp ntp)
@@ -54,6 +68,12 @@ public:
 
     bool empty() const { return _last_offset2batch.empty(); }
 
+    /// Number of filtered batches tracked by the translator
+    size_t size() const;
+
+    /// Number of filtered batches kept in the map, the rest is frozen
+    size_t resident_size() const { return _last_offset2batch.size(); }
+
     /// Difference between the log offset and the kafka offset.
     int64_t delta(model::offset) const;
 
@@ -111,8 +131,45 @@ private:
     // the log) - this way we can calculate delta for any offset in the log.
     using batches_map_t = absl::btree_map<model::offset, batch_info>;
 
+    struct entry {
+        model::offset last_offset;
+        batch_info batch;
+    };
+
+    // Batches preceding the batches of the map. Rows of the last offsets,
+    // lengths and deltas (relative to the first batch of the block) are
+    // encoded with the deltafor_encoder.
+    struct frozen_block {
+        model::offset first_offset;
+        model::offset last_offset;
+        int64_t first_delta;
+        int64_t last_delta;
+        uint8_t size;
+        bytes data;
+    };
+
+    static frozen_block encode_block(const entry*, size_t);
+    static std::vector<entry> decode_block(const frozen_block&);
+    static std::vector<frozen_block> encode_blocks(const std::vector<entry>&);
+
+    model::offset first_offset() const;
+    // delta of the last batch ending before the offset
+    std::optional<int64_t> delta_before(model::offset) const;
+    // calls the function for every batch ending at or after the offset until
+    // it returns true
+    template<typename Func>
+    void visit_from(model::offset, Func) const;
+
+    // moves the oldest batches of the map to the frozen blocks
+    void freeze();
+    // moves the batches of the frozen blocks starting at the index back to the
+    // map
+    void thaw(size_t);
+
 private:
     model::ntp _ntp;
+    // invariant: the map is not empty if there are frozen blocks
+    std::deque<frozen_block> _frozen;
     batches_map_t _last_offset2batch;
 };
 
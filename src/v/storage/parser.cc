@@ -36,7 +36,7 @@
 namespace storage {
 using stop_parser = batch_consumer::stop_parser;
 
-static model::record_batch_header header_from_iobuf(iobuf b) {
+model::record_batch_header header_from_iobuf(iobuf b) {
     iobuf_parser parser(std::move(b));
     auto header_crc = reflection::adl<uint32_t>{}.from(parser);
     auto sz = reflection::adl<int32_t>{}.from(parser);
@@ -30,6 +30,10 @@
 
 namespace storage {
 
+/// \brief decodes a batch header stored in the on-disk format, header crc is
+/// not verified
+model::record_batch_header header_from_iobuf(iobuf);
+
 class batch_consumer {
 public:
     /// \brief  stopping the parser, may or may not be an error condition
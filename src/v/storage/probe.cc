@@ -11,6 +11,7 @@
 
 #include "config/configuration.h"
 #include "prometheus/prometheus_sanitize.h"
+#include "storage/chunk_cache.h"
 #include "storage/readers_cache_probe.h"
 #include "storage/segment.h"
 
@@ -165,6 +166,14 @@ void probe::setup_metrics(const model::ntp& ntp) {
          sm::description("Current size of partition in bytes"),
          labels)
          .aggregate(aggregate_labels),
+       sm::make_gauge(
+         "batch_cache_bytes",
+         [this] {
+             return _batch_cache_owner ? _batch_cache_owner->bytes : 0;
+         },
+         sm::description("Bytes of the partition held by the batch cache"),
+         labels)
+         .aggregate(aggregate_labels),
        sm::make_total_bytes(
          "compaction_ratio",
          [this] { return _compaction_ratio; },
@@ -174,10 +183,26 @@ void probe::setup_metrics(const model::ntp& ntp) {
 }
 
 void probe::add_initial_segment(const segment& s) {
-    _partition_bytes += s.file_size();
+    add_partition_bytes(s.file_size());
 }
 void probe::delete_segment(const segment& s) {
-    _partition_bytes -= s.file_size();
+    remove_partition_bytes(s.file_size());
+}
+
+void probe::set_topic_disk_usage(ss::lw_shared_ptr<topic_disk_usage> usage) {
+    clear_topic_disk_usage();
+    _topic_disk_usage = std::move(usage);
+    _topic_disk_usage->bytes += _partition_bytes;
+    ++_topic_disk_usage->partitions;
+}
+
+void probe::clear_topic_disk_usage() {
+    if (!_topic_disk_usage) {
+        return;
+    }
+    _topic_disk_usage->bytes -= _partition_bytes;
+    --_topic_disk_usage->partitions;
+    _topic_disk_usage = nullptr;
 }
 
 void readers_cache_probe::setup_metrics(const model::ntp& ntp) {
@@ -226,6 +251,114 @@ void readers_cache_probe::setup_metrics(const model::ntp& ntp) {
           sm::description("Reader cache misses"),
           labels)
           .aggregate(aggregate_labels),
+        sm::make_counter(
+          "cache_skip_hits",
+          [this] { return _cache_skip_hits; },
+          sm::description(
+            "Reader cache hits on a reader positioned below the requested "
+            "offset"),
+          labels)
+          .aggregate(aggregate_labels),
+      });
+}
+
+void batch_cache_probe::setup_metrics(std::string_view policy) {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    namespace sm = ss::metrics;
+    const std::vector<sm::label_instance> labels = {
+      sm::label("policy")(ss::sstring(policy)),
+    };
+
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("storage:batch_cache"),
+      {
+        sm::make_counter(
+          "hits",
+          [this] { return _hits; },
+          sm::description("Number of reads served by the batch cache"),
+          labels),
+        sm::make_counter(
+          "misses",
+          [this] { return _misses; },
+          sm::description("Number of reads that missed the batch cache"),
+          labels),
+      });
+}
+
+void flush_coordinator_probe::setup_metrics() {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    namespace sm = ss::metrics;
+
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("storage:flush_coordinator"),
+      {
+        sm::make_counter(
+          "rounds",
+          [this] { return _rounds; },
+          sm::description("Number of group commit flush rounds")),
+        sm::make_counter(
+          "flushes",
+          [this] { return _flushes; },
+          sm::description("Number of file flushes issued by all rounds")),
+        sm::make_counter(
+          "requests",
+          [this] { return _requests; },
+          sm::description("Number of flush requests served by all rounds")),
+        sm::make_gauge(
+          "requests_per_flush",
+          [this] {
+              return _flushes == 0 ? 0.0
+                                   : static_cast<double>(_requests)
+                                       / static_cast<double>(_flushes);
+          },
+          sm::description("Average number of flush requests merged into a "
+                          "single file flush")),
+        sm::make_histogram(
+          "round_latency_us",
+          [this] { return _round_latency.seastar_histogram_logform(); },
+          sm::description("Latency of group commit flush rounds")),
       });
 }
 } // namespace storage
+
+void chunk_cache_probe::setup_metrics() {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    namespace sm = ss::metrics;
+
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("storage:chunk_cache"),
+      {
+        sm::make_gauge(
+          "total_bytes",
+          [] { return internal::chunks().size_total(); },
+          sm::description("Memory held by the chunks of segment appenders")),
+        sm::make_gauge(
+          "available_bytes",
+          [] { return internal::chunks().size_available(); },
+          sm::description("Memory of the free chunks in the cache")),
+        sm::make_gauge(
+          "target_bytes",
+          [] { return internal::chunks().size_target(); },
+          sm::description("Memory of the free chunks the cache keeps for "
+                          "the partitions on the shard")),
+        sm::make_gauge(
+          "waiters",
+          [] { return internal::chunks().waiters(); },
+          sm::description("Number of appenders waiting for a chunk")),
+        sm::make_counter(
+          "waits",
+          [] { return internal::chunks().waits(); },
+          sm::description("Number of chunk requests that had to wait")),
+        sm::make_counter(
+          "throttled",
+          [] { return internal::chunks().throttled(); },
+          sm::description("Number of chunk requests that waited because the "
+                          "appender had its fair share of chunks in flight")),
+      });
+}
@@ -15,11 +15,14 @@
 #include "storage/fwd.h"
 #include "storage/logger.h"
 #include "storage/types.h"
+#include "utils/hdr_hist.h"
 
 #include <seastar/core/metrics_registration.hh>
 #include <seastar/core/shared_ptr.hh>
 
+#include <chrono>
 #include <cstdint>
+#include <memory>
 
 namespace storage {
 struct disk_metrics {
@@ -43,11 +46,44 @@ private:
       ssx::metrics::public_metrics_handle};
 };
 
+/**
+ * Sampled latency distribution of an operation of a partition. Only one in
+ * `sample_rate` operations is measured to keep clock reads and histogram
+ * updates off the common path, and the histogram is only allocated with the
+ * first sample so that idle partitions cost nothing.
+ */
+class sampled_latency {
+public:
+    static constexpr uint32_t sample_rate = 16;
+
+    /// measurement of the operation if it is sampled, its latency is
+    /// recorded when the measurement goes out of scope
+    std::unique_ptr<hdr_hist::measurement> maybe_measure() {
+        if (_operations++ % sample_rate != 0) {
+            return nullptr;
+        }
+        if (!_hist) {
+            _hist = std::make_unique<hdr_hist>(
+              std::chrono::seconds(10), std::chrono::microseconds(1));
+        }
+        return _hist->auto_measure();
+    }
+
+    /// latency in microseconds at the percentile, 0 without samples
+    int64_t get_value_at(double percentile) const {
+        return _hist ? _hist->get_value_at(percentile) : 0;
+    }
+
+private:
+    uint64_t _operations{0};
+    std::unique_ptr<hdr_hist> _hist;
+};
+
 // Per-NTP probe.
 class probe {
 public:
     void add_bytes_written(uint64_t written) {
-        _partition_bytes += written;
+        add_partition_bytes(written);
         _bytes_written += written;
     }
 
@@ -90,10 +126,36 @@ public:
 
     size_t partition_size() const { return _partition_bytes; }
     void add_initial_segment(const segment&);
-    void remove_partition_bytes(size_t remove) { _partition_bytes -= remove; }
+    void remove_partition_bytes(size_t remove) {
+        _partition_bytes -= remove;
+        if (_topic_disk_usage) {
+            _topic_disk_usage->bytes -= remove;
+        }
+    }
     void set_compaction_ratio(double r) { _compaction_ratio = r; }
 
+    sampled_latency& append_latency() { return _append_latency; }
+    sampled_latency& flush_latency() { return _flush_latency; }
+    sampled_latency& read_latency() { return _read_latency; }
+
+    /// the partition size is also accounted in the usage of its topic
+    void set_topic_disk_usage(ss::lw_shared_ptr<topic_disk_usage>);
+    /// removes the partition from the usage of its topic, once it is closed
+    void clear_topic_disk_usage();
+
+    /// accounting of the batches of the log held by the batch cache
+    void set_batch_cache_owner(ss::lw_shared_ptr<batch_cache_owner> owner) {
+        _batch_cache_owner = std::move(owner);
+    }
+
 private:
+    void add_partition_bytes(size_t add) {
+        _partition_bytes += add;
+        if (_topic_disk_usage) {
+            _topic_disk_usage->bytes += add;
+        }
+    }
+
     uint64_t _partition_bytes = 0;
     uint64_t _bytes_written = 0;
     uint64_t _bytes_read = 0;
@@ -111,6 +173,58 @@ private:
     uint32_t _batch_parse_errors = 0;
     uint32_t _batch_write_errors = 0;
     double _compaction_ratio = 1.0;
+    ss::lw_shared_ptr<batch_cache_owner> _batch_cache_owner;
+    ss::lw_shared_ptr<topic_disk_usage> _topic_disk_usage;
+    sampled_latency _append_latency;
+    sampled_latency _flush_latency;
+    sampled_latency _read_latency;
+    ss::metrics::metric_groups _metrics;
+};
+
+// Per-shard probe of the batch cache.
+class batch_cache_probe {
+public:
+    void hit() { ++_hits; }
+    void miss() { ++_misses; }
+
+    void setup_metrics(std::string_view policy);
+
+private:
+    uint64_t _hits = 0;
+    uint64_t _misses = 0;
+    ss::metrics::metric_groups _metrics;
+};
+
+// Per-shard probe of the chunk cache shared by the segment appenders.
+class chunk_cache_probe {
+public:
+    void setup_metrics();
+
+private:
+    ss::metrics::metric_groups _metrics;
+};
+
+// Per-shard probe of the segment flush_coordinator.
+class flush_coordinator_probe {
+public:
+    /// \brief accounts for a round flushing `files` files on behalf of
+    /// `requests` flush requests, the round latency is recorded when the
+    /// returned measurement goes out of scope
+    std::unique_ptr<hdr_hist::measurement>
+    round_started(size_t files, size_t requests) {
+        ++_rounds;
+        _flushes += files;
+        _requests += requests;
+        return _round_latency.auto_measure();
+    }
+
+    void setup_metrics();
+
+private:
+    uint64_t _rounds = 0;
+    uint64_t _flushes = 0;
+    uint64_t _requests = 0;
+    hdr_hist _round_latency;
     ss::metrics::metric_groups _metrics;
 };
 } // namespace storage
@@ -27,9 +27,12 @@
 namespace storage {
 
 readers_cache::readers_cache(
-  model::ntp ntp, std::chrono::milliseconds eviction_timeout)
+  model::ntp ntp,
+  std::chrono::milliseconds eviction_timeout,
+  size_t max_readers)
   : _ntp(std::move(ntp))
-  , _eviction_timeout(eviction_timeout) {
+  , _eviction_timeout(eviction_timeout)
+  , _max_readers(max_readers) {
     _probe.setup_metrics(_ntp);
     // setup eviction timer
     _eviction_timer.set_callback([this] {
@@ -67,6 +70,18 @@ readers_cache::put(std::unique_ptr<log_reader> reader) {
         return model::record_batch_reader(std::move(reader));
     }
 
+    if (!reserve_slot()) {
+        vlog(
+          stlog.trace,
+          "{} - all {} cached readers in use, not adding reader with lease "
+          "[{},{}]",
+          _ntp,
+          _max_readers,
+          reader->lease_range_base_offset(),
+          reader->lease_range_end_offset());
+        return model::record_batch_reader(std::move(reader));
+    }
+
     vlog(
       stlog.trace,
       "{} - adding reader [{},{}]",
@@ -80,6 +95,23 @@ readers_cache::put(std::unique_ptr<log_reader> reader) {
     return ptr->make_cached_reader(this);
 }
 
+bool readers_cache::reserve_slot() {
+    // the lists are bounded by _max_readers, walking them is cheap
+    if (_readers.size() + _in_use.size() < _max_readers) {
+        return true;
+    }
+    if (_readers.empty()) {
+        return false;
+    }
+    // idle readers are returned to the back of the list, the front one is the
+    // least recently used
+    auto& e = _readers.front();
+    e.valid = false;
+    e._hook.unlink();
+    dispose_in_background(&e);
+    return true;
+}
+
 bool readers_cache::intersects_with_locked_range(
   model::offset reader_base_offset, model::offset reader_end_offset) const {
     auto lock_it = std::find_if(
@@ -102,37 +134,60 @@ readers_cache::get_reader(const log_reader_config& cfg) {
     intrusive_list<entry, &entry::_hook> to_evict;
     /**
      * We use linear search since _readers intrusive list is small.
+     *
+     * A reader positioned below the requested offset skips the batches in
+     * between when it is reset, so the closest reader positioned at or below
+     * the requested offset is picked, as long as the offset is still within
+     * its lease.
      */
+    auto best = _readers.end();
     auto it = _readers.begin();
     while (it != _readers.end()) {
         const auto is_valid = it->reader->is_reusable() && it->valid;
-        // TODO: think about relaxing this equality condition
-        const auto offset_matches = it->reader->next_read_lower_bound()
-                                    == cfg.start_offset;
         // if invalid we will dispose this entry in background
         if (!is_valid) {
             it = _readers.erase_and_dispose(
               it, [&to_evict](entry* e) { to_evict.push_back(*e); });
             continue;
         }
-        if (offset_matches && is_valid) {
-            // found matching reader
+        const auto lower_bound = it->reader->next_read_lower_bound();
+        if (lower_bound == cfg.start_offset) {
+            // found exactly matching reader
+            best = it;
             break;
         }
+        const auto can_skip
+          = lower_bound < cfg.start_offset
+            && cfg.start_offset - lower_bound <= model::offset(max_skip_offsets)
+            && cfg.start_offset <= it->reader->lease_range_end_offset();
+        if (
+          can_skip
+          && (best == _readers.end()
+              || best->reader->next_read_lower_bound() < lower_bound)) {
+            best = it;
+        }
         ++it;
     }
     /**
      * dispose unused readers in background
      */
     dispose_in_background(std::move(to_evict));
-    if (it == _readers.end()) {
+    if (best == _readers.end()) {
         _probe.cache_miss();
         vlog(stlog.trace, "{} - reader cache miss for: {}", _ntp, cfg);
         return std::nullopt;
     }
-    auto& e = *it;
-    vlog(stlog.trace, "{} - reader cache hit for: {}", _ntp, cfg);
-    it->reader->reset_config(cfg);
+    auto& e = *best;
+    vlog(
+      stlog.trace,
+      "{} - reader cache hit for: {}, reader lower bound: {}",
+      _ntp,
+      cfg,
+      e.reader->next_read_lower_bound());
+    if (e.reader->next_read_lower_bound() != cfg.start_offset) {
+        _probe.cache_skip_hit();
+    }
+    e.reader->reset_config(cfg);
     _probe.cache_hit();
 
     // we use cached_reader wrapper to track reader usage, when cached_reader is
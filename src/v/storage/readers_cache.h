@@ -26,7 +26,10 @@ namespace storage {
 /**
  * The cache holds reader instances and allows user to query for reader using
  * reader configuration. If any of the readers kept in a cache matches given
- * query its configuration is reset and it is returned to the caller. Caller is
+ * query its configuration is reset and it is returned to the caller. A reader
+ * matches when it is positioned at the requested offset or a little below it,
+ * in which case it skips forward over the batches in between, which is
+ * cheaper than creating a new reader for small reads. Caller is
  * responsible for adding readers to the cache using `put()` method. Since
  * readers keep read lock to underlying segments `readers_cache` exposes
  * interface to force readers eviction in face of truncation and segments
@@ -36,6 +39,13 @@ namespace storage {
 class readers_cache {
 public:
     using offset_range = std::pair<model::offset, model::offset>;
+
+    /// readers positioned at most this many offsets below the requested
+    /// offset may be reused
+    static constexpr model::offset::type max_skip_offsets = 1000;
+    /// cached readers of the partition, idle or in use
+    static constexpr size_t default_max_readers = 32;
+
     class range_lock_holder {
     public:
         range_lock_holder(offset_range rng, readers_cache* c)
@@ -68,7 +78,10 @@ public:
         std::optional<offset_range> _range;
         readers_cache* _cache;
     };
-    explicit readers_cache(model::ntp, std::chrono::milliseconds);
+    explicit readers_cache(
+      model::ntp,
+      std::chrono::milliseconds,
+      size_t max_readers = default_max_readers);
     std::optional<model::record_batch_reader>
     get_reader(const log_reader_config&);
 
@@ -134,6 +147,7 @@ private:
              * requested to be evicted
              */
             if (_e->reader->is_reusable() && _e->valid) {
+                _e->last_used = ss::lowres_clock::now();
                 _cache->_readers.push_back(*_e);
             } else {
                 _cache->dispose_in_background(_e);
@@ -177,8 +191,12 @@ private:
 
     bool intersects_with_locked_range(model::offset, model::offset) const;
 
+    /// Makes room for a new reader, false if all readers are in use
+    bool reserve_slot();
+
     model::ntp _ntp;
     std::chrono::milliseconds _eviction_timeout;
+    size_t _max_readers{default_max_readers};
     ss::gate _gate;
     ss::timer<> _eviction_timer;
     readers_cache_probe _probe;
@@ -13,6 +13,7 @@ public:
     void reader_added() { _readers_added++; }
     void reader_evicted() { _readers_evicted++; }
     void cache_hit() { _cache_hits++; }
+    void cache_skip_hit() { _cache_skip_hits++; }
     void cache_miss() { _cache_misses++; }
     void clear() { _metrics.clear(); }
 
@@ -23,6 +24,7 @@ private:
     uint64_t _readers_evicted{0};
     uint64_t _cache_misses{0};
     uint64_t _cache_hits{0};
+    uint64_t _cache_skip_hits{0};
 
     ss::metrics::metric_groups _metrics;
 };
@@ -99,16 +99,31 @@ ss::future<> segment::close() {
 ss::future<> segment::remove_persistent_state() {
     vassert(is_closed(), "Cannot clear state from unclosed segment");
 
+    // the data file is handed over to the segment pool if it has room
+    std::filesystem::path data_path(reader().filename().c_str());
+    auto recycled = co_await _resources.get_segment_pool()
+                      .recycle(data_path)
+                      .handle_exception([data_path](std::exception_ptr e) {
+                          vlog(
+                            stlog.info,
+                            "error recycling {}: {}",
+                            data_path,
+                            e);
+                          return false;
+                      });
+
     std::vector<std::filesystem::path> rm;
     rm.reserve(3);
-    rm.emplace_back(reader().filename().c_str());
+    if (!recycled) {
+        rm.push_back(std::move(data_path));
+    }
     rm.emplace_back(index().filename().c_str());
     if (is_compacted_segment()) {
         rm.push_back(
           internal::compacted_index_path(reader().filename().c_str()));
     }
     vlog(stlog.info, "removing: {}", rm);
-    return ss::do_with(
+    co_await ss::do_with(
       std::move(rm), [](const std::vector<std::filesystem::path>& to_remove) {
           return ss::do_for_each(
             to_remove, [](const std::filesystem::path& name) {
@@ -161,6 +176,12 @@ ss::future<> segment::do_release_appender(
         std::optional<compacted_index_writer>& compacted_index) {
           return appender->close()
             .then([this] { return _idx.flush(); })
+            .then([this] {
+                if (config::shard_local_cfg()
+                      .release_index_on_segment_roll()) {
+                    _idx.release_resident_state();
+                }
+            })
             .then([&compacted_index] {
                 if (compacted_index) {
                     return compacted_index->close();
@@ -173,44 +194,26 @@ ss::future<> segment::do_release_appender(
 ss::future<> segment::release_appender(readers_cache* readers_cache) {
     vassert(_appender, "cannot release a null appender");
     /*
-     * If we are able to get the write lock then proceed with the normal
-     * appender release process.  Otherwise, schedule the destructive operations
-     * that require the write lock to be run in the background in order to avoid
-     * blocking segment rolling.
-     *
-     * An exception safe variant of try write lock is simulated since seastar
-     * does not have such primitives available on the semaphore. The fast path
-     * of try_write_lock is combined with immediately releasing the lock (which
-     * will not also not signal any waiters--there cannot be any!) to guarantee
-     * that the blocking get_units version will find the lock uncontested.
-     *
-     * TODO: we should upstream get_units try-variants for semaphore and rwlock.
+     * Only the data is flushed before the segment is rolled, so that the
+     * offsets of the log stay committed. Closing the appender and flushing
+     * the indices require the write lock and are run in the background, the
+     * next segment takes appends in the meantime. Operations that need the
+     * finalized indices wait for wait_for_appender_release().
      */
-    if (_destructive_ops.try_write_lock()) {
-        _destructive_ops.write_unlock();
-        return write_lock().then([this](ss::rwlock::holder h) {
-            return do_flush()
-              .then([this] {
-                  auto a = std::exchange(_appender, nullptr);
-                  auto c
-                    = config::shard_local_cfg().release_cache_on_segment_roll()
-                        ? std::exchange(_cache, std::nullopt)
-                        : std::nullopt;
-                  auto i = std::exchange(_compaction_index, std::nullopt);
-                  return do_release_appender(
-                    std::move(a), std::move(c), std::move(i));
-              })
-              .finally([h = std::move(h)] {});
-        });
-    } else {
-        return read_lock().then([this, readers_cache](ss::rwlock::holder h) {
-            return do_flush()
-              .then([this, readers_cache] {
-                  release_appender_in_background(readers_cache);
-              })
-              .finally([h = std::move(h)] {});
-        });
+    return read_lock().then([this, readers_cache](ss::rwlock::holder h) {
+        return do_flush()
+          .then([this, readers_cache] {
+              release_appender_in_background(readers_cache);
+          })
+          .finally([h = std::move(h)] {});
+    });
+}
+
+ss::future<> segment::wait_for_appender_release() {
+    if (!_appender_release) {
+        return ss::now();
     }
+    return _appender_release->get_shared_future();
 }
 
 void segment::release_appender_in_background(readers_cache* readers_cache) {
@@ -219,6 +222,7 @@ void segment::release_appender_in_background(readers_cache* readers_cache) {
                ? std::exchange(_cache, std::nullopt)
                : std::nullopt;
     auto i = std::exchange(_compaction_index, std::nullopt);
+    _appender_release.emplace();
     ssx::spawn_with_gate(
       _gate,
       [this,
@@ -237,7 +241,12 @@ void segment::release_appender_in_background(readers_cache* readers_cache) {
                                std::move(a), std::move(c), std::move(i))
                         .finally([h = std::move(h)] {});
                   });
-            });
+            })
+            .handle_exception([this](std::exception_ptr e) {
+                vlog(
+                  stlog.warn, "error releasing appender of {}: {}", *this, e);
+            })
+            .finally([this] { _appender_release->set_value(); });
       });
 }
 
@@ -254,14 +263,50 @@ ss::future<> segment::do_flush() {
     }
     auto o = _tracker.dirty_offset;
     auto fsize = _appender->file_byte_offset();
-    return _appender->flush().then([this, o, fsize] {
-        // never move committed offset backward, there may be multiple
-        // outstanding flushes once the one executed later in terms of offset
-        // finishes we guarantee that all previous flushes finished.
-        _tracker.committed_offset = std::max(o, _tracker.committed_offset);
-        _tracker.stable_offset = _tracker.committed_offset;
-        _reader.set_file_size(std::max(fsize, _reader.file_size()));
-    });
+    auto checkpoint = maybe_make_checkpoint();
+    return _appender->flush().then(
+      [this, o, fsize, checkpoint = std::move(checkpoint)]() mutable {
+          // never move committed offset backward, there may be multiple
+          // outstanding flushes once the one executed later in terms of
+          // offset finishes we guarantee that all previous flushes finished.
+          _tracker.committed_offset = std::max(o, _tracker.committed_offset);
+          _tracker.stable_offset = _tracker.committed_offset;
+          _reader.set_file_size(std::max(fsize, _reader.file_size()));
+          if (!checkpoint) {
+              return ss::now();
+          }
+          return write_checkpoint(std::move(*checkpoint));
+      });
+}
+
+std::optional<index_state> segment::maybe_make_checkpoint() {
+    const size_t interval
+      = config::shard_local_cfg().segment_recovery_checkpoint_bytes();
+    if (
+      interval == 0 || _checkpoint_in_progress
+      || _appender->file_byte_offset() < _checkpoint_file_pos + interval) {
+        return std::nullopt;
+    }
+    // the appender flush that follows makes everything tracked by the index
+    // so far durable
+    auto checkpoint = _idx.make_checkpoint();
+    if (!checkpoint.has_checkpoint()) {
+        // nothing tracked since the index was truncated
+        return std::nullopt;
+    }
+    _checkpoint_in_progress = true;
+    return checkpoint;
+}
+
+ss::future<> segment::write_checkpoint(index_state checkpoint) {
+    auto pos = checkpoint.checkpoint_file_pos;
+    return _idx.write_checkpoint(std::move(checkpoint))
+      .then([this, pos] { _checkpoint_file_pos = pos; })
+      .handle_exception([this](const std::exception_ptr& e) {
+          // a missing checkpoint only costs a longer recovery
+          vlog(stlog.warn, "failed to checkpoint segment {}: {}", *this, e);
+      })
+      .finally([this] { _checkpoint_in_progress = false; });
 }
 
 ss::future<> remove_compacted_index(const ss::sstring& reader_path) {
@@ -296,6 +341,7 @@ segment::do_truncate(model::offset prev_last_offset, size_t physical) {
     _tracker.stable_offset = prev_last_offset;
     _tracker.dirty_offset = prev_last_offset;
     _reader.set_file_size(physical);
+    _checkpoint_file_pos = std::min(_checkpoint_file_pos, physical);
     vlog(
       stlog.trace,
       "truncating segment {} at {}",
@@ -479,17 +525,19 @@ ss::future<append_result> segment::append(model::record_batch&& b) {
 ss::future<segment_reader_handle>
 segment::offset_data_stream(model::offset o, ss::io_priority_class iopc) {
     check_segment_not_closed("offset_data_stream()");
-    auto nearest = _idx.find_nearest(o);
-    size_t position = 0;
-    if (nearest) {
-        position = nearest->filepos;
-    }
+    return _idx.find_nearest_async(o).then(
+      [this, iopc](std::optional<segment_index::entry> nearest) {
+          size_t position = 0;
+          if (nearest) {
+              position = nearest->filepos;
+          }
 
-    // This could be a corruption (bad index) or a runtime defect (bad file
-    // size) (https://github.com/redpanda-data/redpanda/issues/2101)
-    vassert(position < size_bytes(), "Index points beyond file size");
+          // This could be a corruption (bad index) or a runtime defect (bad
+          // file size) (https://github.com/redpanda-data/redpanda/issues/2101)
+          vassert(position < size_bytes(), "Index points beyond file size");
 
-    return _reader.data_stream(position, iopc);
+          return _reader.data_stream(position, iopc);
+      });
 }
 
 void segment::advance_stable_offset(size_t offset) {
@@ -619,7 +667,8 @@ ss::future<ss::lw_shared_ptr<segment>> make_segment(
   unsigned read_ahead,
   debug_sanitize_files sanitize_fileops,
   std::optional<batch_cache_index> batch_cache,
-  storage_resources& resources) {
+  storage_resources& resources,
+  size_t preallocated) {
     auto path = segment_path::make_segment_path(
       ntpc, base_offset, term, version);
     vlog(stlog.info, "Creating new segment {}", path.string());
@@ -630,11 +679,11 @@ ss::future<ss::lw_shared_ptr<segment>> make_segment(
              buf_size,
              read_ahead,
              resources)
-      .then([path, &ntpc, sanitize_fileops, pc, &resources](
+      .then([path, &ntpc, sanitize_fileops, pc, &resources, preallocated](
               ss::lw_shared_ptr<segment> seg) {
           return with_segment(
             std::move(seg),
-            [path, &ntpc, sanitize_fileops, pc, &resources](
+            [path, &ntpc, sanitize_fileops, pc, &resources, preallocated](
               const ss::lw_shared_ptr<segment>& seg) {
                 return internal::make_segment_appender(
                          path,
@@ -642,7 +691,8 @@ ss::future<ss::lw_shared_ptr<segment>> make_segment(
                          internal::number_of_chunks_from_config(ntpc),
                          internal::segment_size_from_config(ntpc),
                          pc,
-                         resources)
+                         resources,
+                         preallocated)
                   .then([seg, &resources](segment_appender_ptr a) {
                       return ss::make_ready_future<ss::lw_shared_ptr<segment>>(
                         ss::make_lw_shared<segment>(
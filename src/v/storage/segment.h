@@ -24,6 +24,7 @@
 #include <seastar/core/file.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/rwlock.hh>
+#include <seastar/core/shared_future.hh>
 
 #include <exception>
 #include <optional>
@@ -84,6 +85,9 @@ public:
     ss::future<> close();
     ss::future<> flush();
     ss::future<> release_appender(readers_cache*);
+    /// Resolves once the appender released by release_appender() is closed
+    /// and the indices of the segment are flushed
+    ss::future<> wait_for_appender_release();
     ss::future<> truncate(model::offset, size_t physical);
 
     /// main write interface
@@ -153,6 +157,8 @@ public:
     generation_id get_generation_id() const { return _generation_id; }
     void advance_generation() { _generation_id++; }
 
+    storage_resources& resources() { return _resources; }
+
 private:
     void set_close();
     void cache_truncate(model::offset offset);
@@ -160,6 +166,8 @@ private:
     ss::future<> do_truncate(model::offset prev_last_offset, size_t physical);
     ss::future<> do_close();
     ss::future<> do_flush();
+    std::optional<index_state> maybe_make_checkpoint();
+    ss::future<> write_checkpoint(index_state);
     ss::future<> do_release_appender(
       segment_appender_ptr,
       std::optional<batch_cache_index>,
@@ -207,9 +215,15 @@ private:
     std::optional<batch_cache_index> _cache;
     ss::rwlock _destructive_ops;
     ss::gate _gate;
+    std::optional<ss::shared_promise<>> _appender_release;
 
     absl::btree_map<size_t, model::offset> _inflight;
 
+    // recovery checkpoints of the active segment, see
+    // segment_recovery_checkpoint_bytes
+    size_t _checkpoint_file_pos{0};
+    bool _checkpoint_in_progress{false};
+
     friend std::ostream& operator<<(std::ostream&, const segment&);
 };
 
@@ -246,7 +260,8 @@ ss::future<ss::lw_shared_ptr<segment>> make_segment(
   unsigned read_ahead,
   debug_sanitize_files sanitize_fileops,
   std::optional<batch_cache_index> batch_cache,
-  storage_resources&);
+  storage_resources&,
+  size_t preallocated = 0);
 
 // bitflags operators
 [[gnu::always_inline]] inline segment::bitflags
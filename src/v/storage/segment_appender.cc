@@ -55,6 +55,7 @@ static constexpr auto head_sem_name = "s/appender-head";
 segment_appender::segment_appender(ss::file f, options opts)
   : _out(std::move(f))
   , _opts(opts)
+  , _fallocation_offset(opts.preallocated)
   , _concurrent_flushes(ss::semaphore::max_counter(), "s/append-flush")
   , _prev_head_write(ss::make_lw_shared<ssx::semaphore>(1, head_sem_name))
   , _inactive_timer([this] { handle_inactive_timer(); })
@@ -102,6 +103,7 @@ segment_appender::segment_appender(segment_appender&& o) noexcept
   , _flushed_offset(o._flushed_offset)
   , _stable_offset(o._stable_offset)
   , _inflight(std::move(o._inflight))
+  , _chunks_in_flight(std::exchange(o._chunks_in_flight, 0))
   , _callbacks(std::exchange(o._callbacks, nullptr))
   , _inactive_timer([this] { handle_inactive_timer(); })
   , _chunk_size(o._chunk_size) {
@@ -175,7 +177,7 @@ ss::future<> segment_appender::do_append(const char* buf, const size_t n) {
       .then([this, next_buf = buf + written, next_sz = n - written](
               ssx::semaphore_units) {
           // do not hold the units!
-          return internal::chunks().get().then(
+          return internal::chunks().get(_chunks_in_flight).then(
             [this, next_buf, next_sz](ss::lw_shared_ptr<chunk> chunk) {
                 vassert(!_head, "cannot overwrite existing chunk");
                 _head = std::move(chunk);
@@ -412,7 +414,7 @@ ss::future<> segment_appender::process_flush_ops(size_t committed) {
 
     _flush_ops.erase(flushable, _flush_ops.end());
 
-    return _out.flush().then([this, committed, ops = std::move(ops)]() mutable {
+    return flush_file().then([this, committed, ops = std::move(ops)]() mutable {
         _flushed_offset = committed;
         /*
          * TODO: as an optimization, add a little house keeping to determine if
@@ -458,6 +460,9 @@ void segment_appender::dispatch_background_head_write() {
      */
     const auto full = _head->is_full();
     auto h = full ? std::exchange(_head, nullptr) : _head;
+    if (full) {
+        ++_chunks_in_flight;
+    }
 
     /*
      * make sure that when the write is dispatched that is sequenced in-order on
@@ -492,6 +497,7 @@ void segment_appender::dispatch_background_head_write() {
                       if (full) {
                           h->reset();
                           internal::chunks().add(h);
+                          --_chunks_in_flight;
                       }
                       if (unlikely(expected != got)) {
                           return size_missmatch_error(
@@ -547,11 +553,19 @@ ss::future<> segment_appender::flush() {
       _stable_offset,
       *this);
 
-    return _out.flush().handle_exception([this](std::exception_ptr e) {
+    return flush_file().handle_exception([this](std::exception_ptr e) {
         vassert(false, "Could not flush: {} - {}", e, *this);
     });
 }
 
+ss::future<> segment_appender::flush_file() {
+    auto& coordinator = _opts.resources.get_flush_coordinator();
+    if (coordinator.enabled()) {
+        return coordinator.flush(this, _out);
+    }
+    return _out.flush();
+}
+
 ss::future<> segment_appender::hard_flush() {
     _inactive_timer.cancel();
     if (_head && _head->bytes_pending()) {
@@ -58,6 +58,9 @@ public:
         // more space than a segment would ever need.
         std::optional<uint64_t> segment_size;
         storage_resources& resources;
+        // Bytes already allocated for the file, e.g. a recycled file. The
+        // appender doesn't fallocate until it writes past them.
+        size_t preallocated{0};
     };
 
     segment_appender(ss::file f, options opts);
@@ -146,6 +149,9 @@ private:
     // still heavy weight operations compared to regular flush()
     ss::future<> hard_flush();
 
+    // flushes the file, through the shard's flush_coordinator when enabled
+    ss::future<> flush_file();
+
     struct inflight_write {
         bool done;
         size_t offset;
@@ -156,6 +162,9 @@ private:
     };
 
     ss::chunked_fifo<ss::lw_shared_ptr<inflight_write>> _inflight;
+    // full chunks being written, they return to the chunk cache once the
+    // write completes
+    size_t _chunks_in_flight{0};
     callbacks* _callbacks = nullptr;
     ss::future<>
     maybe_advance_stable_offset(const ss::lw_shared_ptr<inflight_write>&);
@@ -16,6 +16,7 @@
 #include "storage/segment_utils.h"
 #include "vassert.h"
 
+#include <seastar/core/byteorder.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/fstream.hh>
 #include <seastar/core/iostream.hh>
@@ -25,6 +26,7 @@
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <limits>
 
 namespace storage {
 
@@ -44,7 +46,7 @@ segment_index::segment_index(
   size_t step,
   debug_sanitize_files sanitize)
   : _name(std::move(filename))
-  , _step(step)
+  , _density(step)
   , _sanitize(sanitize) {
     _state.base_offset = base;
 }
@@ -52,7 +54,7 @@ segment_index::segment_index(
 segment_index::segment_index(
   ss::sstring filename, ss::file mock_file, model::offset base, size_t step)
   : _name(std::move(filename))
-  , _step(step)
+  , _density(step)
   , _mock_file(mock_file) {
     _state.base_offset = base;
 }
@@ -74,63 +76,139 @@ void segment_index::reset() {
     auto base = _state.base_offset;
     _state = {};
     _state.base_offset = base;
-    _acc = 0;
+    _density.reset();
+    _tracked_file_pos = 0;
+    _cold.reset();
+    _file_is_searchable = false;
+    ++_file_generation;
+    update_tracked_memory();
 }
 
 void segment_index::swap_index_state(index_state&& o) {
     _needs_persistence = true;
-    _acc = 0;
+    _density.reset();
+    _cold.reset();
+    _file_is_searchable = false;
     std::swap(_state, o);
+    update_tracked_memory();
+}
+
+bool segment_index::release_resident_state() {
+    if (_cold) {
+        return true;
+    }
+    if (_needs_persistence || !_file_is_searchable || _state.empty()) {
+        return false;
+    }
+    cold_state cold{.layout = index_file_layout::for_entries(_state.size())};
+    for (size_t i = 0; i < _state.size(); i += cold_fence_stride) {
+        cold.fence.push_back(_state.relative_offset_index[i]);
+    }
+    _state.relative_offset_index = {};
+    _state.relative_time_index = {};
+    _state.position_index = {};
+    _cold = std::move(cold);
+    update_tracked_memory();
+    return true;
+}
+
+ss::future<> segment_index::ensure_resident() {
+    if (!_cold) {
+        co_return;
+    }
+    if (!co_await materialize_index()) {
+        throw std::runtime_error(fmt::format(
+          "Unable to reload released index {} from disk", _name));
+    }
 }
 
 void segment_index::maybe_track(
   const model::record_batch_header& hdr, size_t filepos) {
-    _acc += hdr.size_bytes;
+    vassert(!_cold, "cannot track batches in a released index {}", _name);
     if (_state.maybe_index(
-          _acc,
-          _step,
+          _density,
+          hdr.size_bytes,
           filepos,
           hdr.base_offset,
           hdr.last_offset(),
           hdr.first_timestamp,
           hdr.max_timestamp)) {
-        _acc = 0;
+        update_tracked_memory();
+    }
+    _tracked_file_pos = filepos + hdr.size_bytes;
+    _needs_persistence = true;
+}
+
+void segment_index::update_tracked_memory() {
+    _tracked.update(
+      _state.memory_size() + (_cold ? _cold->fence.memory_size() : 0));
+}
+
+index_state segment_index::make_checkpoint() const {
+    vassert(!_cold, "cannot checkpoint a released index {}", _name);
+    auto st = _state.copy();
+    st.checkpoint_offset = _state.max_offset;
+    st.checkpoint_file_pos = _tracked_file_pos;
+    return st;
+}
+
+ss::future<> segment_index::write_checkpoint(index_state st) {
+    // the file no longer matches the in-memory index
+    _file_is_searchable = false;
+    ++_file_generation;
+    co_await write_state(st);
+}
+
+void segment_index::clear_checkpoint() {
+    if (!_state.has_checkpoint()) {
+        return;
     }
+    _state.checkpoint_offset = {};
+    _state.checkpoint_file_pos = 0;
     _needs_persistence = true;
 }
 
 std::optional<segment_index::entry>
 segment_index::find_nearest(model::timestamp t) {
-    if (t < _state.base_timestamp) {
-        return std::nullopt;
-    }
+    vassert(!_cold, "timestamp lookup in a released index {}", _name);
     if (_state.empty()) {
         return std::nullopt;
     }
-    const uint32_t i = t() - _state.base_timestamp();
-    auto it = std::lower_bound(
-      std::begin(_state.relative_time_index),
-      std::end(_state.relative_time_index),
-      i,
-      std::less<uint32_t>{});
-    if (it == _state.relative_offset_index.end()) {
-        return std::nullopt;
+    if (t <= _state.base_timestamp) {
+        return translate_index_entry(_state, _state.get_entry(0));
+    }
+    // timestamps of the batches are not guaranteed to be monotonic, the
+    // first entry at or after 't' is found with a linear scan. the batches
+    // between it and the previous entry are not indexed and may be the first
+    // ones at or after 't', so the scan of the data starts at the previous
+    // entry
+    const auto needle = static_cast<uint32_t>(std::min<int64_t>(
+      t() - _state.base_timestamp(), std::numeric_limits<uint32_t>::max()));
+    auto it = std::find_if(
+      _state.relative_time_index.begin(),
+      _state.relative_time_index.end(),
+      [needle](uint32_t relative_time) { return relative_time >= needle; });
+    auto dist = std::distance(_state.relative_time_index.begin(), it);
+    if (dist > 0) {
+        --dist;
     }
-    auto dist = std::distance(_state.relative_offset_index.begin(), it);
     return translate_index_entry(_state, _state.get_entry(dist));
 }
 
+ss::future<std::optional<segment_index::entry>>
+segment_index::find_nearest_async(model::timestamp t) {
+    co_await ensure_resident();
+    co_return find_nearest(t);
+}
+
 std::optional<segment_index::entry>
 segment_index::find_nearest(model::offset o) {
+    vassert(!_cold, "offset lookup in a released index {}", _name);
     if (o < _state.base_offset || _state.empty()) {
         return std::nullopt;
     }
     const uint32_t needle = o() - _state.base_offset();
-    auto it = std::lower_bound(
-      std::begin(_state.relative_offset_index),
-      std::end(_state.relative_offset_index),
-      needle,
-      std::less<uint32_t>{});
+    auto it = _state.relative_offset_index.lower_bound(needle);
     if (it == _state.relative_offset_index.end()) {
         it = std::prev(it);
     }
@@ -145,10 +223,98 @@ segment_index::find_nearest(model::offset o) {
     return std::nullopt;
 }
 
+ss::future<std::optional<segment_index::entry>>
+segment_index::find_nearest_async(model::offset o) {
+    if (!_cold) {
+        return ss::make_ready_future<std::optional<entry>>(find_nearest(o));
+    }
+    return find_nearest_in_file(o);
+}
+
+ss::future<std::optional<segment_index::entry>>
+segment_index::find_nearest_in_file(model::offset o) {
+    if (o < _state.base_offset) {
+        co_return std::nullopt;
+    }
+    const uint32_t needle = o() - _state.base_offset();
+    const auto generation = _file_generation;
+    const auto layout = _cold->layout;
+
+    // the fence narrows the search down to a single page of offsets
+    auto& fence = _cold->fence;
+    auto fit = std::upper_bound(fence.begin(), fence.end(), needle);
+    if (fit == fence.begin()) {
+        co_return std::nullopt;
+    }
+    const size_t first = (std::distance(fence.begin(), fit) - 1)
+                         * cold_fence_stride;
+    const size_t count = std::min<size_t>(
+      cold_fence_stride, layout.entries - first);
+
+    auto f = co_await open();
+    std::exception_ptr ex;
+    std::optional<entry> result;
+    try {
+        auto offsets = co_await f.dma_read_bulk<char>(
+          layout.relative_offset_pos + first * sizeof(uint32_t),
+          count * sizeof(uint32_t));
+        if (offsets.size() != count * sizeof(uint32_t)) {
+            throw std::runtime_error(fmt::format(
+              "Short read of index {}, layout {}", _name, layout));
+        }
+        auto relative_offset = [&offsets](size_t i) {
+            return ss::read_le<uint32_t>(offsets.get() + i * sizeof(uint32_t));
+        };
+        // last entry <= needle, the first one is guaranteed by the fence
+        size_t lo = 0;
+        size_t hi = count;
+        while (hi - lo > 1) {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (relative_offset(mid) <= needle) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        const size_t i = first + lo;
+        auto time = co_await f.dma_read_bulk<char>(
+          layout.relative_time_pos + i * sizeof(uint32_t), sizeof(uint32_t));
+        auto pos = co_await f.dma_read_bulk<char>(
+          layout.position_pos + i * sizeof(uint64_t), sizeof(uint64_t));
+        if (
+          time.size() != sizeof(uint32_t) || pos.size() != sizeof(uint64_t)) {
+            throw std::runtime_error(fmt::format(
+              "Short read of index {}, layout {}", _name, layout));
+        }
+        result = translate_index_entry(
+          _state,
+          std::make_tuple(
+            relative_offset(lo),
+            ss::read_le<uint32_t>(time.get()),
+            ss::read_le<uint64_t>(pos.get())));
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await f.close();
+
+    if (generation != _file_generation) {
+        // the file was rewritten under us, whatever we read is stale
+        co_return co_await find_nearest_async(o);
+    }
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_return result;
+}
+
 ss::future<> segment_index::truncate(model::offset o) {
     if (o < _state.base_offset) {
         co_return;
     }
+    co_await ensure_resident();
+    // the end of the last batch kept is unknown here, no checkpoint can be
+    // taken until the next batch is tracked
+    _tracked_file_pos = 0;
     const uint32_t i = o() - _state.base_offset();
     auto it = std::lower_bound(
       std::begin(_state.relative_offset_index),
@@ -163,6 +329,7 @@ ss::future<> segment_index::truncate(model::offset o) {
         while (remove_back_elems-- > 0) {
             _state.pop_back();
         }
+        update_tracked_memory();
     }
 
     if (o < _state.max_offset) {
@@ -192,10 +359,16 @@ ss::future<bool> segment_index::materialize_index() {
         if (buf.empty()) {
             co_return false;
         }
+        // the deprecated pre-serde format is not laid out for in place lookups
+        const auto searchable = static_cast<serde::version_t>(buf[0])
+                                >= index_state::redpanda_serde_compat_version;
         iobuf b;
         b.append(std::move(buf));
         try {
             _state = serde::from_iobuf<index_state>(std::move(b));
+            _cold.reset();
+            update_tracked_memory();
+            _file_is_searchable = searchable && !_needs_persistence;
             co_return true;
         } catch (const serde::serde_exception& ex) {
             vlog(
@@ -217,22 +390,34 @@ ss::future<> segment_index::flush() {
         return ss::now();
     }
     _needs_persistence = false;
-    return with_file(open(), [this](ss::file backing_file) -> ss::future<> {
-        co_await backing_file.truncate(0);
-        auto out = co_await ss::make_file_output_stream(
-          std::move(backing_file));
-
-        auto b = serde::to_iobuf(_state.copy());
-        for (const auto& f : b) {
-            co_await out.write(f.get(), f.size());
-        }
-        co_await out.flush();
-    });
+    _file_is_searchable = false;
+    ++_file_generation;
+    return write_state(_state).then(
+      [this] { _file_is_searchable = !_needs_persistence; });
+}
+
+ss::future<> segment_index::write_state(const index_state& st) {
+    // serialized before the first suspension point, the state may change
+    // while the file is written
+    auto b = serde::to_iobuf(st.copy());
+    return with_file(
+      open(), [b = std::move(b)](ss::file backing_file) -> ss::future<> {
+          co_await backing_file.truncate(0);
+          auto out = co_await ss::make_file_output_stream(
+            std::move(backing_file));
+          for (const auto& f : b) {
+              co_await out.write(f.get(), f.size());
+          }
+          co_await out.flush();
+      });
 }
 
 std::ostream& operator<<(std::ostream& o, const segment_index& i) {
     return o << "{file:" << i.filename() << ", offsets:" << i.base_offset()
-             << ", index:" << i._state << ", step:" << i._step
+             << ", index:" << i._state
+             << ", resident:" << i.is_resident()
+             << ", step:" << i._density.step
+             << ", max_batches:" << i._density.max_batches
              << ", needs_persistence:" << i._needs_persistence << "}";
 }
 std::ostream& operator<<(std::ostream& o, const segment_index_ptr& i) {
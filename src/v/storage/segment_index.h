@@ -15,6 +15,9 @@
 #include "model/timestamp.h"
 #include "storage/index_state.h"
 #include "storage/types.h"
+#include "utils/fragmented_vector.h"
+#include "utils/memory_accounting.h"
+#include "vassert.h"
 
 #include <seastar/core/file.hh>
 #include <seastar/core/unaligned.hh>
@@ -62,8 +65,17 @@ public:
     segment_index& operator=(const segment_index&) = delete;
 
     void maybe_track(const model::record_batch_header&, size_t filepos);
+    /// \brief lookups against the in-memory index, the index must be resident
     std::optional<entry> find_nearest(model::offset);
+    /// \brief entry from which a scan finds the first batch with a timestamp
+    /// at or after the given one
     std::optional<entry> find_nearest(model::timestamp);
+    /// \brief same as find_nearest(model::offset) but if the index is not
+    /// resident the lookup binary searches the index file in place.
+    ss::future<std::optional<entry>> find_nearest_async(model::offset);
+    /// \brief same as find_nearest(model::timestamp), a released index is
+    /// reloaded first
+    ss::future<std::optional<entry>> find_nearest_async(model::timestamp);
 
     model::offset base_offset() const { return _state.base_offset; }
     model::offset max_offset() const { return _state.max_offset; }
@@ -87,14 +99,62 @@ public:
     void reset();
     void swap_index_state(index_state&&);
     bool needs_persistence() const { return _needs_persistence; }
-    index_state release_index_state() && { return std::move(_state); }
+    index_state release_index_state() && {
+        vassert(!_cold, "index {} must be resident to be released", _name);
+        return std::move(_state);
+    }
+
+    /// \brief drops the in-memory index entries, keeping only the header
+    /// fields and a sparse fence of offsets. subsequent offset lookups read
+    /// the index file. returns false, keeping the entries, if they are not
+    /// yet persisted.
+    bool release_resident_state();
+    /// \brief reloads the entries dropped by release_resident_state
+    ss::future<> ensure_resident();
+    bool is_resident() const { return !_cold; }
+
+    /// \brief a copy of the index covering the batches tracked so far,
+    /// checkpointed at the end of the last of them. the index must be
+    /// resident.
+    index_state make_checkpoint() const;
+    /// \brief writes a checkpoint taken by make_checkpoint once the data it
+    /// covers is durable. the in-memory index is left untouched and still
+    /// needs to be flushed.
+    ss::future<> write_checkpoint(index_state);
+    /// \brief true if the materialized index file was a checkpoint
+    bool has_checkpoint() const { return _state.has_checkpoint(); }
+    model::offset checkpoint_offset() const { return _state.checkpoint_offset; }
+    size_t checkpoint_file_pos() const { return _state.checkpoint_file_pos; }
+    /// \brief drops the checkpoint of a recovered index, the next flush
+    /// persists the complete index
+    void clear_checkpoint();
 
 private:
+    // one 4KiB page worth of relative offsets per fence entry
+    static constexpr size_t cold_fence_stride = 1024;
+
+    struct cold_state {
+        index_file_layout layout;
+        // relative offset of every cold_fence_stride-th entry
+        fragmented_vector<uint32_t> fence;
+    };
+
+    ss::future<std::optional<entry>> find_nearest_in_file(model::offset);
+    ss::future<> write_state(const index_state&);
+    void update_tracked_memory();
+
     ss::sstring _name;
-    size_t _step;
-    size_t _acc{0};
+    index_density _density;
+    // end of the last tracked batch in the segment file
+    size_t _tracked_file_pos{0};
     bool _needs_persistence{false};
+    // the index file holds exactly _state in a binary-searchable layout
+    bool _file_is_searchable{false};
+    // bumped every time the index file is rewritten
+    uint64_t _file_generation{0};
     index_state _state;
+    std::optional<cold_state> _cold;
+    tracked_memory _tracked{memory_subsystem::index_state};
     debug_sanitize_files _sanitize;
 
     /** Constructor with mock file content for unit testing */
@@ -0,0 +1,197 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "storage/segment_pool.h"
+
+#include "storage/logger.h"
+#include "units.h"
+#include "utils/directory_walker.h"
+#include "vlog.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/file.hh>
+#include <seastar/core/seastar.hh>
+
+#include <algorithm>
+#include <charconv>
+
+namespace storage {
+
+static constexpr size_t allocation_alignment = 4_KiB;
+
+/// Truncate the file and allocate 'size' bytes past its end, so the
+/// blocks are reserved but reads still see an empty file
+static ss::future<size_t> preallocate(std::filesystem::path path, size_t size) {
+    size = (size + allocation_alignment - 1) / allocation_alignment
+           * allocation_alignment;
+    auto f = co_await ss::open_file_dma(path.string(), ss::open_flags::rw);
+    std::exception_ptr ep;
+    try {
+        co_await f.truncate(0);
+        co_await f.allocate(0, size);
+        co_await f.flush();
+    } catch (...) {
+        ep = std::current_exception();
+    }
+    co_await f.close();
+    if (ep) {
+        std::rethrow_exception(ep);
+    }
+    co_return size;
+}
+
+static ss::future<> remove_quietly(std::filesystem::path path) {
+    return ss::remove_file(path.string())
+      .handle_exception([path](std::exception_ptr e) {
+          vlog(stlog.info, "error removing {}: {}", path, e);
+      });
+}
+
+segment_pool::segment_pool(config::binding<size_t> capacity)
+  : _capacity(std::move(capacity)) {}
+
+ss::future<> segment_pool::start(std::filesystem::path data_dir) {
+    if (_capacity() == 0) {
+        co_return;
+    }
+    auto dir = data_dir / ".segment_pool"
+               / fmt::format("{}", ss::this_shard_id());
+    co_await ss::recursive_touch_directory(dir.string());
+
+    std::vector<std::filesystem::path> found;
+    co_await directory_walker::walk(
+      dir.string(), [&dir, &found](ss::directory_entry de) {
+          if (de.type && *de.type == ss::directory_entry_type::regular) {
+              found.push_back(dir / de.name.c_str());
+          }
+          return ss::now();
+      });
+    _dir = std::move(dir);
+    for (auto& path : found) {
+        co_await load_file(std::move(path));
+    }
+    vlog(stlog.info, "Segment pool {} holds {} files", *_dir, _files.size());
+}
+
+ss::future<> segment_pool::load_file(std::filesystem::path path) {
+    // files are named by their id, new files are numbered past them
+    const auto stem = path.stem().string();
+    uint64_t id = 0;
+    auto [ptr, ec] = std::from_chars(
+      stem.data(), stem.data() + stem.size(), id);
+    const bool numbered = ec == std::errc{} && ptr == stem.data() + stem.size();
+    if (numbered) {
+        _next_id = std::max(_next_id, id + 1);
+    }
+
+    // a file that was fully pre-allocated is empty and has blocks past its
+    // end, anything else was interrupted while recycling
+    auto st = co_await ss::file_stat(path.string());
+    if (
+      numbered && path.extension() == ".log" && has_room()
+      && st.size == 0 && st.allocated_size > 0) {
+        _files.push_back(
+          pooled_file{.path = std::move(path), .allocated = st.allocated_size});
+    } else {
+        co_await remove_quietly(std::move(path));
+    }
+}
+
+ss::future<> segment_pool::stop() { return _gate.close(); }
+
+bool segment_pool::has_room() const {
+    return _files.size() + _pending < _capacity();
+}
+
+std::filesystem::path segment_pool::next_path() {
+    return *_dir / fmt::format("{}.log", _next_id++);
+}
+
+ss::future<bool> segment_pool::recycle(const std::filesystem::path& file) {
+    if (!_dir || _gate.is_closed() || !has_room()) {
+        co_return false;
+    }
+    auto holder = _gate.hold();
+
+    size_t size = 0;
+    try {
+        size = co_await ss::file_size(file.string());
+    } catch (...) {
+        // e.g. the data file was already moved over another segment
+        co_return false;
+    }
+    if (size == 0) {
+        co_return false;
+    }
+
+    ++_pending;
+    auto target = next_path();
+    bool renamed = false;
+    std::optional<size_t> allocated;
+    try {
+        co_await ss::rename_file(file.string(), target.string());
+        renamed = true;
+        allocated = co_await preallocate(target, size);
+    } catch (...) {
+        vlog(
+          stlog.warn,
+          "Failed to recycle segment file {}: {}",
+          file,
+          std::current_exception());
+    }
+    --_pending;
+
+    if (!allocated) {
+        if (renamed) {
+            co_await remove_quietly(target);
+        }
+        co_return renamed;
+    }
+    vlog(
+      stlog.debug,
+      "Recycled segment file {} as {} with {} bytes allocated",
+      file,
+      target,
+      *allocated);
+    _files.push_back(
+      pooled_file{.path = std::move(target), .allocated = *allocated});
+    co_return true;
+}
+
+ss::future<std::optional<size_t>>
+segment_pool::take(const std::filesystem::path& path) {
+    if (_files.empty() || _gate.is_closed()) {
+        co_return std::nullopt;
+    }
+    auto holder = _gate.hold();
+
+    auto f = std::move(_files.front());
+    _files.pop_front();
+    bool taken = true;
+    try {
+        co_await ss::rename_file(f.path.string(), path.string());
+    } catch (...) {
+        vlog(
+          stlog.warn,
+          "Failed to take pooled segment file {} as {}: {}",
+          f.path,
+          path,
+          std::current_exception());
+        taken = false;
+    }
+    if (!taken) {
+        co_await remove_quietly(f.path);
+        co_return std::nullopt;
+    }
+    co_return f.allocated;
+}
+
+} // namespace storage
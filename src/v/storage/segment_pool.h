@@ -0,0 +1,80 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "config/property.h"
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+
+#include <deque>
+#include <filesystem>
+#include <optional>
+
+namespace storage {
+
+/**
+ * Pool of pre-allocated segment data files on a shard.
+ *
+ * Data files of removed segments are moved into the pool directory instead
+ * of being unlinked, truncated and fallocated again to their previous size
+ * off the hot path. A new segment takes a file from the pool with a single
+ * rename, and its appender doesn't fallocate until it writes past the
+ * pre-allocated size. Rolling a segment under load avoids creating the file
+ * and growing it in fallocation steps, which can stall writes on XFS.
+ *
+ * The pool lives in '<data dir>/.segment_pool/<shard>'. Files left there by
+ * a previous run are reused if their pre-allocation completed and removed
+ * otherwise. The pool is disabled when its capacity is zero.
+ */
+class segment_pool {
+public:
+    explicit segment_pool(config::binding<size_t> capacity);
+    segment_pool(const segment_pool&) = delete;
+    segment_pool& operator=(const segment_pool&) = delete;
+
+    ss::future<> start(std::filesystem::path data_dir);
+    ss::future<> stop();
+
+    /// Take over the data file of a removed segment. Returns false if the
+    /// file was not recycled, in which case the caller removes it.
+    ss::future<bool> recycle(const std::filesystem::path& file);
+
+    /// Move a pooled file to 'path'. Returns the number of bytes allocated
+    /// for the file, or nullopt if the pool is empty and the caller has to
+    /// create the file.
+    ss::future<std::optional<size_t>> take(const std::filesystem::path& path);
+
+    /// Number of files ready to be taken
+    size_t size() const { return _files.size(); }
+
+private:
+    struct pooled_file {
+        std::filesystem::path path;
+        size_t allocated;
+    };
+
+    bool has_room() const;
+    std::filesystem::path next_path();
+    ss::future<> load_file(std::filesystem::path);
+
+    config::binding<size_t> _capacity;
+    std::optional<std::filesystem::path> _dir;
+    ss::gate _gate;
+    std::deque<pooled_file> _files;
+    // files being pre-allocated, they count against the capacity
+    size_t _pending{0};
+    uint64_t _next_id{0};
+};
+
+} // namespace storage
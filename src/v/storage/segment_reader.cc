@@ -9,6 +9,7 @@
 
 #include "storage/segment_reader.h"
 
+#include "config/configuration.h"
 #include "ssx/future-util.h"
 #include "storage/logger.h"
 #include "storage/segment_utils.h"
@@ -23,6 +24,56 @@
 
 namespace storage {
 
+/**
+ * Per-shard LRU of the segment files that are open while no handle uses
+ * them. Keeping them open avoids reopening the segments that are read
+ * repeatedly, while the bound keeps cold segments from holding file
+ * descriptors: they are only open while being read.
+ */
+class idle_files {
+public:
+    /// Parks the open file of the reader, returns the files to close
+    std::vector<ss::file> add(segment_reader& r) {
+        std::vector<ss::file> to_close;
+        const auto capacity
+          = config::shard_local_cfg().storage_idle_open_segment_files();
+        if (capacity == 0) {
+            to_close.push_back(evict(r));
+            return to_close;
+        }
+        _lru.push_back(r);
+        ++_size;
+        while (_size > capacity) {
+            to_close.push_back(evict(_lru.front()));
+        }
+        return to_close;
+    }
+
+    void remove(segment_reader& r) {
+        if (r._idle_hook.is_linked()) {
+            r._idle_hook.unlink();
+            --_size;
+        }
+    }
+
+    size_t size() const { return _size; }
+
+private:
+    ss::file evict(segment_reader& r) {
+        remove(r);
+        vlog(stlog.debug, "Closing segment file {}", r._filename);
+        return std::exchange(r._data_file, ss::file{});
+    }
+
+    intrusive_list<segment_reader, &segment_reader::_idle_hook> _lru;
+    // intrusive_list::size() walks the list
+    size_t _size{0};
+};
+
+static thread_local idle_files idle_files_lru; // NOLINT
+
+size_t segment_reader::idle_open_files() { return idle_files_lru.size(); }
+
 segment_reader::segment_reader(
   ss::sstring filename,
   size_t buffer_size,
@@ -41,6 +92,8 @@ segment_reader::~segment_reader() noexcept {
           _filename);
     }
 
+    idle_files_lru.remove(*this);
+
     for (auto& i : _streams) {
         i.detach();
     }
@@ -61,6 +114,7 @@ segment_reader::segment_reader(segment_reader&& rhs) noexcept
         i._hook.unlink();
         _streams.push_back(i);
     }
+    _idle_hook.swap_nodes(rhs._idle_hook);
 }
 
 ss::future<> segment_reader::load_size() {
@@ -112,6 +166,9 @@ ss::future<segment_reader_handle> segment_reader::get() {
           std::filesystem::path(_filename), _sanitize);
     }
 
+    // reusing a file kept open since its last handle was closed
+    idle_files_lru.remove(*this);
+
     _data_file_refcount++;
     auto handle = segment_reader_handle(this);
     co_return handle;
@@ -134,12 +191,16 @@ ss::future<> segment_reader::put() {
     vassert(_data_file_refcount > 0, "bad put() on {}", _filename);
     _data_file_refcount--;
     if (_data_file && _data_file_refcount == 0) {
-        vlog(stlog.debug, "Closing segment file {}", _filename);
-        // Note: a get() can now come in and open a fresh file handle: this
-        // means we strictly-speaking can consume >1 file descriptors from one
-        // segment_reader, but it's a rare+transient state.
-        auto data_file = std::exchange(_data_file, ss::file{});
-        co_await data_file.close();
+        // The file is kept open for the next get() unless it is, or makes
+        // other files, the least recently used of the idle ones.
+        // Note: a get() can now come in and open a fresh file handle if this
+        // file is closed: this means we strictly-speaking can consume >1 file
+        // descriptors from one segment_reader, but it's a rare+transient
+        // state.
+        auto to_close = idle_files_lru.add(*this);
+        for (auto& f : to_close) {
+            co_await f.close();
+        }
     }
 }
 
@@ -186,8 +247,10 @@ ss::future<> segment_reader::truncate(size_t n) {
 }
 
 ss::future<> segment_reader::close() {
+    idle_files_lru.remove(*this);
     if (_data_file) {
-        return _data_file.close();
+        auto f = std::exchange(_data_file, ss::file{});
+        return f.close().finally([f] {});
     } else {
         return ss::now();
     }
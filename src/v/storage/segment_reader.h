@@ -143,6 +143,9 @@ public:
     ss::future<segment_reader_handle>
     data_stream(size_t pos_begin, size_t pos_end, const ss::io_priority_class);
 
+    /// number of segment files kept open without handles on this shard
+    static size_t idle_open_files();
+
 private:
     ss::sstring _filename;
 
@@ -158,6 +161,11 @@ private:
     intrusive_list<segment_reader_handle, &segment_reader_handle::_hook>
       _streams;
 
+    // Linked in the per-shard LRU of idle files while _data_file is open
+    // and _data_file_refcount is zero. The least recently used files are
+    // closed when the LRU grows over storage_idle_open_segment_files.
+    intrusive_list_hook _idle_hook;
+
     size_t _file_size{0};
     size_t _buffer_size{0};
     unsigned _read_ahead{0};
@@ -170,6 +178,7 @@ private:
     ss::future<> put();
 
     friend class segment_reader_handle;
+    friend class idle_files;
     friend std::ostream& operator<<(std::ostream&, const segment_reader&);
 };
 
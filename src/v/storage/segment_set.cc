@@ -9,6 +9,7 @@
 
 #include "storage/segment_set.h"
 
+#include "config/configuration.h"
 #include "storage/fs_utils.h"
 #include "storage/log_replayer.h"
 #include "storage/logger.h"
@@ -22,6 +23,7 @@
 #include <seastar/core/thread.hh>
 
 #include <absl/container/btree_set.h>
+#include <boost/range/irange.hpp>
 #include <fmt/format.h>
 
 #include <exception>
@@ -38,18 +40,29 @@ struct segment_ordering {
     bool operator()(const type& seg, model::timestamp value) const {
         return seg->index().max_timestamp() < value;
     }
-
-    bool operator()(const type& seg, model::term_id value) const {
-        return seg->offsets().term < value;
-    }
-    bool operator()(model::term_id value, const type& seg) const {
-        return value < seg->offsets().term;
-    }
 };
 
 segment_set::segment_set(segment_set::underlying_t segs)
   : _handles(std::move(segs)) {
     std::sort(_handles.begin(), _handles.end(), segment_ordering{});
+    rebuild_term_index();
+}
+
+void segment_set::index_term(size_t position) {
+    auto term = _handles[position - _front_position]->offsets().term;
+    if (_terms.empty() || _terms.back().term != term) {
+        _terms.push_back(term_entry{.term = term, .last = position});
+    } else {
+        _terms.back().last = position;
+    }
+}
+
+void segment_set::rebuild_term_index() {
+    _terms.clear();
+    _front_position = 0;
+    for (size_t i = 0; i < _handles.size(); ++i) {
+        index_term(i);
+    }
 }
 
 void segment_set::add(ss::lw_shared_ptr<segment> h) {
@@ -64,12 +77,32 @@ void segment_set::add(ss::lw_shared_ptr<segment> h) {
           *this);
     }
     _handles.emplace_back(std::move(h));
+    index_term(_front_position + _handles.size() - 1);
+}
+
+void segment_set::pop_back() {
+    _handles.pop_back();
+    if (
+      _handles.empty()
+      || _handles.back()->offsets().term != _terms.back().term) {
+        _terms.pop_back();
+    } else {
+        --_terms.back().last;
+    }
+}
+
+void segment_set::pop_front() {
+    _handles.pop_front();
+    ++_front_position;
+    if (_terms.front().last < _front_position) {
+        _terms.pop_front();
+    }
 }
 
-void segment_set::pop_back() { _handles.pop_back(); }
-void segment_set::pop_front() { _handles.pop_front(); }
 void segment_set::erase(iterator begin, iterator end) {
     _handles.erase(begin, end);
+    // only used when merging adjacent segments, renumbering is cheap enough
+    rebuild_term_index();
 }
 
 template<typename Iterator>
@@ -149,15 +182,29 @@ segment_set::lower_bound(model::timestamp needle) const {
       std::cbegin(_handles), std::cend(_handles), needle);
 }
 
+/// Index of the segment following the last segment of the greatest term that
+/// is not greater than the needle
+size_t segment_set::term_upper_bound(model::term_id term) const {
+    auto it = std::upper_bound(
+      _terms.cbegin(),
+      _terms.cend(),
+      term,
+      [](model::term_id t, const term_entry& e) { return t < e.term; });
+    if (it == _terms.cbegin()) {
+        return 0;
+    }
+    return std::prev(it)->last - _front_position + 1;
+}
+
 segment_set::iterator segment_set::upper_bound(model::term_id term) {
-    return std::upper_bound(
-      _handles.begin(), _handles.end(), term, segment_ordering{});
+    return std::next(
+      _handles.begin(), static_cast<std::ptrdiff_t>(term_upper_bound(term)));
 }
 
 segment_set::const_iterator
 segment_set::upper_bound(model::term_id term) const {
-    return std::upper_bound(
-      _handles.cbegin(), _handles.cend(), term, segment_ordering{});
+    return std::next(
+      _handles.cbegin(), static_cast<std::ptrdiff_t>(term_upper_bound(term)));
 }
 
 std::ostream& operator<<(std::ostream& o, const segment_set& s) {
@@ -171,6 +218,10 @@ std::ostream& operator<<(std::ostream& o, const segment_set& s) {
 // Recover the last segment. Whenever we close a segment, we will likely
 // open a new one to which we will direct new writes. That new segment
 // might be empty. To optimize log replay, implement #140.
+// upper bound on concurrent index reads while recovering a single log, the
+// number of concurrently recovered logs is bounded by storage_resources
+static constexpr size_t max_concurrent_index_materializations = 4;
+
 static ss::future<segment_set> unsafe_do_recover(
   segment_set&& segments,
   std::optional<ss::sstring> last_clean_segment,
@@ -182,6 +233,28 @@ static ss::future<segment_set> unsafe_do_recover(
             return std::move(segments);
         }
         segment_set::underlying_t good = std::move(segments).release();
+        /*
+         * index materialization is independent for every segment, overlap the
+         * reads. segments are checked against each other below, once all of
+         * the indices are loaded.
+         */
+        std::vector<bool> materialized(good.size(), false);
+        std::vector<std::exception_ptr> materialize_errors(good.size());
+        ss::max_concurrent_for_each(
+          boost::irange<size_t>(0, good.size()),
+          max_concurrent_index_materializations,
+          [&good, &materialized, &materialize_errors](size_t i) {
+              return good[i]->materialize_index().then_wrapped(
+                [&materialized, &materialize_errors, i](ss::future<bool> f) {
+                    try {
+                        materialized[i] = f.get();
+                    } catch (...) {
+                        materialize_errors[i] = std::current_exception();
+                    }
+                });
+          })
+          .get();
+
         absl::btree_set<segment*> to_recover_set;
         for (size_t i = 0; i < good.size(); ++i) {
             auto& s = *good[i];
@@ -201,26 +274,28 @@ static ss::future<segment_set> unsafe_do_recover(
                 }
             }
 
-            try {
-                // use the segment materialize instead of going through
-                // the index directly to hydrate the max_offset state
-                if (s.materialize_index().get()) {
-                    vassert(
-                      s.offsets().dirty_offset == s.index().max_offset(),
-                      "dirty_offset and index max_offset must be equal for "
-                      "segment {}",
-                      s);
-                } else {
-                    to_recover_set.insert(&s);
-                }
-            } catch (...) {
+            // use the segment materialize instead of going through
+            // the index directly to hydrate the max_offset state
+            if (materialize_errors[i]) {
                 vlog(
                   stlog.info,
                   "Error materializing index:{}. Recovering parent "
                   "segment:{}. Details:{}",
                   s.index().filename(),
                   s.filename(),
-                  std::current_exception());
+                  materialize_errors[i]);
+                to_recover_set.insert(&s);
+            } else if (materialized[i] && s.index().has_checkpoint()) {
+                // the segment was not closed cleanly, the data written after
+                // the checkpoint is validated by the recovery
+                to_recover_set.insert(&s);
+            } else if (materialized[i]) {
+                vassert(
+                  s.offsets().dirty_offset == s.index().max_offset(),
+                  "dirty_offset and index max_offset must be equal for "
+                  "segment {}",
+                  s);
+            } else {
                 to_recover_set.insert(&s);
             }
         }
@@ -240,6 +315,13 @@ static ss::future<segment_set> unsafe_do_recover(
           good_end,
           good.end()); // remove all the ones we copied into recover
 
+        // recovered segments are never appended to again
+        if (config::shard_local_cfg().release_index_on_segment_roll()) {
+            for (auto& seg : good) {
+                seg->index().release_resident_state();
+            }
+        }
+
         // remove empty segments
         auto non_empty_end = std::stable_partition(
           to_recover.begin(),
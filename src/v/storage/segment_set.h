@@ -84,7 +84,23 @@ public:
     const_iterator end() const { return _handles.end(); }
 
 private:
+    /// Position of the last segment of a term, the positions keep counting
+    /// up when segments are removed from the front
+    struct term_entry {
+        model::term_id term;
+        size_t last;
+    };
+
+    void index_term(size_t position);
+    void rebuild_term_index();
+    size_t term_upper_bound(model::term_id) const;
+
     underlying_t _handles;
+    // one entry per term in the set, so that term lookups, e.g. for
+    // OffsetForLeaderEpoch, are a search over contiguous memory instead of
+    // dereferencing segments
+    ss::circular_buffer<term_entry> _terms;
+    size_t _front_position{0};
 
     friend std::ostream& operator<<(std::ostream&, const segment_set&);
 };
@@ -156,19 +156,24 @@ ss::future<segment_appender_ptr> make_segment_appender(
   size_t number_of_chunks,
   std::optional<uint64_t> segment_size,
   ss::io_priority_class iopc,
-  storage_resources& resources) {
+  storage_resources& resources,
+  size_t preallocated) {
     return internal::make_writer_handle(path, debug)
-      .then([number_of_chunks, iopc, path, segment_size, &resources](
-              ss::file writer) {
+      .then([number_of_chunks,
+             iopc,
+             path,
+             segment_size,
+             &resources,
+             preallocated](ss::file writer) {
           try {
               // NOTE: This try-catch is needed to not uncover the real
               // exception during an OOM condition, since the appender allocates
               // 1MB of memory aligned buffers
+              segment_appender::options opts(
+                iopc, number_of_chunks, segment_size, resources);
+              opts.preallocated = preallocated;
               return ss::make_ready_future<segment_appender_ptr>(
-                std::make_unique<segment_appender>(
-                  writer,
-                  segment_appender::options(
-                    iopc, number_of_chunks, segment_size, resources)));
+                std::make_unique<segment_appender>(writer, opts));
           } catch (...) {
               auto e = std::current_exception();
               vlog(stlog.error, "could not allocate appender: {}", e);
@@ -207,10 +212,13 @@ uint64_t segment_size_from_config(const ntp_config& ntpc) {
     }
 }
 
-ss::future<Roaring>
-natural_index_of_entries_to_keep(compacted_index_reader reader) {
+ss::future<Roaring> natural_index_of_entries_to_keep(
+  compacted_index_reader reader, const compaction_filter* filter) {
     reader.reset();
-    return reader.consume(compaction_key_reducer(), model::no_timeout);
+    return reader.consume(
+      compaction_key_reducer(
+        compaction_key_reducer::default_max_memory_usage, filter),
+      model::no_timeout);
 }
 
 ss::future<> copy_filtered_entries(
@@ -238,10 +246,11 @@ ss::future<> copy_filtered_entries(
 static ss::future<> do_write_clean_compacted_index(
   compacted_index_reader reader,
   compaction_config cfg,
-  storage_resources& resources) {
+  storage_resources& resources,
+  const compaction_filter* filter) {
     const auto tmpname = std::filesystem::path(
       fmt::format("{}.staging", reader.filename()));
-    return natural_index_of_entries_to_keep(reader)
+    return natural_index_of_entries_to_keep(reader, filter)
       .then([reader, cfg, tmpname, &resources](Roaring bitmap) -> ss::future<> {
           auto truncating_writer = make_file_backed_compacted_index(
             tmpname.string(), cfg.iopc, cfg.sanitize, true, resources);
@@ -261,9 +270,10 @@ static ss::future<> do_write_clean_compacted_index(
 ss::future<> write_clean_compacted_index(
   compacted_index_reader reader,
   compaction_config cfg,
-  storage_resources& resources) {
+  storage_resources& resources,
+  const compaction_filter* filter) {
     // integrity verified in `do_detect_compaction_index_state`
-    return do_write_clean_compacted_index(reader, cfg, resources)
+    return do_write_clean_compacted_index(reader, cfg, resources, filter)
       .finally([reader]() mutable {
           return reader.close().then_wrapped(
             [reader](ss::future<>) { /*ignore*/ });
@@ -326,23 +336,72 @@ generate_compacted_list(model::offset o, compacted_index_reader reader) {
 ss::future<> do_compact_segment_index(
   ss::lw_shared_ptr<segment> s,
   compaction_config cfg,
-  storage_resources& resources) {
+  storage_resources& resources,
+  const compaction_filter* filter) {
     auto compacted_path = std::filesystem::path(s->reader().filename());
     compacted_path.replace_extension(".compaction_index");
     vlog(gclog.trace, "compacting segment compaction index:{}", compacted_path);
     return make_reader_handle(compacted_path, cfg.sanitize)
-      .then([cfg, compacted_path, s, &resources](ss::file f) {
+      .then([cfg, compacted_path, s, &resources, filter](ss::file f) {
           auto reader = make_file_backed_compacted_reader(
             compacted_path.string(), std::move(f), cfg.iopc, 64_KiB);
-          return write_clean_compacted_index(reader, cfg, resources);
+          return write_clean_compacted_index(reader, cfg, resources, filter);
       });
 }
 ss::future<storage::index_state> do_copy_segment_data(
   ss::lw_shared_ptr<segment> s,
+  compacted_offset_list list,
   compaction_config cfg,
   storage::probe& pb,
   ss::rwlock::holder h,
-  storage_resources& resources) {
+  storage_resources& resources,
+  compaction_filter* filter) {
+    const auto tmpname = data_segment_staging_name(s);
+    return make_segment_appender(
+             tmpname,
+             cfg.sanitize,
+             segment_appender::write_behind_memory
+               / config::shard_local_cfg().append_chunk_size(),
+             std::nullopt,
+             cfg.iopc,
+             resources)
+      .then([l = std::move(list),
+             &pb,
+             h = std::move(h),
+             cfg,
+             s,
+             tmpname,
+             &resources,
+             filter](segment_appender_ptr w) mutable {
+          auto raw = w.get();
+          auto red = copy_data_segment_reducer(
+            std::move(l), raw, &resources.get_compaction_throttle(), filter);
+          auto r = create_segment_full_reader(s, cfg, pb, std::move(h));
+          vlog(
+            gclog.trace,
+            "copying compacted segment data from {} to {}",
+            s->reader().filename(),
+            tmpname);
+          return std::move(r)
+            .consume(std::move(red), model::no_timeout)
+            .finally([raw, w = std::move(w)]() mutable {
+                return raw->close()
+                  .handle_exception([](std::exception_ptr e) {
+                      vlog(
+                        gclog.error, "Error copying index to new segment:{}", e);
+                  })
+                  .finally([w = std::move(w)] {});
+            });
+      });
+}
+
+ss::future<storage::index_state> do_copy_segment_data(
+  ss::lw_shared_ptr<segment> s,
+  compaction_config cfg,
+  storage::probe& pb,
+  ss::rwlock::holder h,
+  storage_resources& resources,
+  compaction_filter* filter) {
     auto idx_path = std::filesystem::path(s->reader().filename());
     idx_path.replace_extension(".compaction_index");
     return make_reader_handle(idx_path, cfg.sanitize)
@@ -354,40 +413,10 @@ ss::future<storage::index_state> do_copy_segment_data(
                 return reader.close().then_wrapped([](ss::future<>) {});
             });
       })
-      .then([cfg, s, &pb, h = std::move(h), &resources](
+      .then([cfg, s, &pb, h = std::move(h), &resources, filter](
               compacted_offset_list list) mutable {
-          const auto tmpname = data_segment_staging_name(s);
-          return make_segment_appender(
-                   tmpname,
-                   cfg.sanitize,
-                   segment_appender::write_behind_memory
-                     / config::shard_local_cfg().append_chunk_size(),
-                   std::nullopt,
-                   cfg.iopc,
-                   resources)
-            .then([l = std::move(list), &pb, h = std::move(h), cfg, s, tmpname](
-                    segment_appender_ptr w) mutable {
-                auto raw = w.get();
-                auto red = copy_data_segment_reducer(std::move(l), raw);
-                auto r = create_segment_full_reader(s, cfg, pb, std::move(h));
-                vlog(
-                  gclog.trace,
-                  "copying compacted segment data from {} to {}",
-                  s->reader().filename(),
-                  tmpname);
-                return std::move(r)
-                  .consume(std::move(red), model::no_timeout)
-                  .finally([raw, w = std::move(w)]() mutable {
-                      return raw->close()
-                        .handle_exception([](std::exception_ptr e) {
-                            vlog(
-                              gclog.error,
-                              "Error copying index to new segment:{}",
-                              e);
-                        })
-                        .finally([w = std::move(w)] {});
-                  });
-            });
+          return do_copy_segment_data(
+            s, std::move(list), cfg, pb, std::move(h), resources, filter);
       });
 }
 
@@ -439,29 +468,17 @@ ss::future<> do_swap_data_file_handles(
 }
 
 /**
- * Executes segment compaction, returns size of compacted segment or an empty
- * optional if segment wasn't compacted
+ * Replaces data of the segment with the compacted data written to the staging
+ * file, returns size of compacted segment or an empty optional if the segment
+ * changed since the compaction started
  */
-ss::future<std::optional<size_t>> do_self_compact_segment(
+static ss::future<std::optional<size_t>> do_swap_compacted_segment(
   ss::lw_shared_ptr<segment> s,
+  storage::index_state idx,
+  segment::generation_id segment_generation,
   compaction_config cfg,
   storage::probe& pb,
-  storage::readers_cache& readers_cache,
-  storage_resources& resources) {
-    vlog(gclog.trace, "self compacting segment {}", s->reader().filename());
-    auto read_holder = co_await s->read_lock();
-    auto segment_generation = s->get_generation_id();
-
-    if (s->is_closed()) {
-        throw segment_closed_exception();
-    }
-
-    co_await do_compact_segment_index(s, cfg, resources);
-    // copy the bytes after segment is good - note that we
-    // need to do it with the READ-lock, not the write lock
-    auto idx = co_await do_copy_segment_data(
-      s, cfg, pb, std::move(read_holder), resources);
-
+  storage::readers_cache& readers_cache) {
     auto rdr_holder = co_await readers_cache.evict_segment_readers(s);
 
     auto write_lock_holder = co_await s->write_lock();
@@ -492,17 +509,288 @@ ss::future<std::optional<size_t>> do_self_compact_segment(
     co_return s->size_bytes();
 }
 
+/**
+ * Drops the compaction index entries of the records removed by the filter,
+ * once the data is gone the keys of aborted records must not supersede
+ * others even if the transaction is no longer known
+ */
+static ss::future<> remove_filtered_index_entries(
+  ss::lw_shared_ptr<segment> s,
+  const compaction_filter& filter,
+  compaction_config cfg,
+  storage_resources& resources) {
+    if (filter.removed_count() == 0) {
+        co_return;
+    }
+    vlog(
+      gclog.trace,
+      "removing {} aborted and tombstone records from segment {}",
+      filter.removed_count(),
+      s->reader().filename());
+    auto idx_path = compacted_index_path(s->reader().filename());
+    auto f = co_await make_reader_handle(idx_path, cfg.sanitize);
+    auto reader = make_file_backed_compacted_reader(
+      idx_path.string(), std::move(f), cfg.iopc, 64_KiB);
+    const auto tmpname = fmt::format("{}.staging", idx_path.string());
+    auto writer = make_file_backed_compacted_index(
+      tmpname, cfg.iopc, cfg.sanitize, true, resources);
+    std::exception_ptr ex;
+    try {
+        reader.reset();
+        co_await reader.consume(
+          index_removed_filter_copy_reducer(filter, writer),
+          model::no_timeout);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    writer.set_flag(compacted_index::footer_flags::self_compaction);
+    co_await writer.close().handle_exception([&ex](std::exception_ptr e) {
+        if (!ex) {
+            ex = e;
+        }
+    });
+    co_await reader.close().then_wrapped([](ss::future<>) {});
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_await ss::rename_file(tmpname, idx_path.string());
+}
+
+/**
+ * Executes segment compaction, returns size of compacted segment or an empty
+ * optional if segment wasn't compacted
+ */
+ss::future<std::optional<size_t>> do_self_compact_segment(
+  ss::lw_shared_ptr<segment> s,
+  compaction_config cfg,
+  storage::probe& pb,
+  storage::readers_cache& readers_cache,
+  storage_resources& resources) {
+    vlog(gclog.trace, "self compacting segment {}", s->reader().filename());
+    auto read_holder = co_await s->read_lock();
+    auto segment_generation = s->get_generation_id();
+
+    if (s->is_closed()) {
+        throw segment_closed_exception();
+    }
+
+    // tombstones are kept, older values of their keys may be in the
+    // segments before this one
+    auto filter = co_await compaction_filter::make(*s, cfg);
+    co_await do_compact_segment_index(s, cfg, resources, &filter);
+    // copy the bytes after segment is good - note that we
+    // need to do it with the READ-lock, not the write lock
+    auto idx = co_await do_copy_segment_data(
+      s, cfg, pb, std::move(read_holder), resources, &filter);
+    if (idx.empty()) {
+        // every record belongs to an aborted transaction, the segment is
+        // kept as it is rather than leaving an empty segment in the log
+        co_return s->size_bytes();
+    }
+    co_await remove_filtered_index_entries(s, filter, cfg, resources);
+
+    co_return co_await do_swap_compacted_segment(
+      s, std::move(idx), segment_generation, cfg, pb, readers_cache);
+}
+
+/// Segments without superseded records are left as they are, so are the
+/// segments in which every record is superseded, those are removed when the
+/// adjacent segment compaction merges them with their neighbour. Keeping them
+/// avoids empty segments in the middle of the log.
+static bool should_rewrite(const key_offset_map_filter_reducer::result& r) {
+    return r.removed > 0 && !r.entries.isEmpty();
+}
+
+/**
+ * Removes records superseded by a newer offset in the key map from the
+ * segment, returns size of compacted segment or an empty optional if segment
+ * wasn't compacted
+ */
+static ss::future<std::optional<size_t>> do_compact_segment_with_key_map(
+  ss::lw_shared_ptr<segment> s,
+  const key_offset_map& map,
+  compaction_filter& filter,
+  compaction_config cfg,
+  storage::probe& pb,
+  storage::readers_cache& readers_cache,
+  storage_resources& resources) {
+    auto read_holder = co_await s->read_lock();
+    auto segment_generation = s->get_generation_id();
+
+    if (s->is_closed()) {
+        throw segment_closed_exception();
+    }
+
+    auto idx_path = compacted_index_path(s->reader().filename());
+    auto f = co_await make_reader_handle(idx_path, cfg.sanitize);
+    auto reader = make_file_backed_compacted_reader(
+      idx_path.string(), std::move(f), cfg.iopc, 64_KiB);
+    const auto tmpname = fmt::format("{}.staging", idx_path.string());
+
+    std::optional<key_offset_map_filter_reducer::result> filtered;
+    std::exception_ptr ex;
+    try {
+        reader.reset();
+        filtered = co_await reader.consume(
+          key_offset_map_filter_reducer(map, s->offsets().base_offset),
+          model::no_timeout);
+        if (should_rewrite(*filtered)) {
+            auto writer = make_file_backed_compacted_index(
+              tmpname, cfg.iopc, cfg.sanitize, true, resources);
+            co_await copy_filtered_entries(
+              reader, std::move(filtered->entries), std::move(writer));
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await reader.close().then_wrapped([](ss::future<>) {});
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    if (!should_rewrite(*filtered)) {
+        co_return std::nullopt;
+    }
+
+    vlog(
+      gclog.trace,
+      "removing {} superseded keys from segment {}",
+      filtered->removed,
+      s->reader().filename());
+    co_await ss::rename_file(tmpname, idx_path.string());
+    auto idx = co_await do_copy_segment_data(
+      s,
+      std::move(filtered->offsets),
+      cfg,
+      pb,
+      std::move(read_holder),
+      resources,
+      &filter);
+    if (idx.empty()) {
+        // every record was aborted or an expired tombstone, the segment is
+        // kept until the adjacent segment compaction merges it
+        co_return std::nullopt;
+    }
+    co_await remove_filtered_index_entries(s, filter, cfg, resources);
+
+    co_return co_await do_swap_compacted_segment(
+      s, std::move(idx), segment_generation, cfg, pb, readers_cache);
+}
+
+/// Adds keys of the segment compaction index to the map, returns false if
+/// the map filled up before all keys were added
+static ss::future<bool> index_segment_keys(
+  ss::lw_shared_ptr<segment> s,
+  key_offset_map& map,
+  const compaction_filter& filter,
+  compaction_config cfg) {
+    auto read_holder = co_await s->read_lock();
+    if (s->is_closed()) {
+        throw segment_closed_exception();
+    }
+    auto idx_path = compacted_index_path(s->reader().filename());
+    auto f = co_await make_reader_handle(idx_path, cfg.sanitize);
+    auto reader = make_file_backed_compacted_reader(
+      idx_path.string(), std::move(f), cfg.iopc, 64_KiB);
+    bool complete = false;
+    std::exception_ptr ex;
+    try {
+        reader.reset();
+        complete = co_await reader.consume(
+          key_offset_map_builder_reducer(map, &filter), model::no_timeout);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await reader.close().then_wrapped([](ss::future<>) {});
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_return complete;
+}
+
+ss::future<compaction_result> compact_segment_window(
+  std::vector<ss::lw_shared_ptr<segment>> segments,
+  compaction_config cfg,
+  storage::probe& pb,
+  storage::readers_cache& readers_cache,
+  storage_resources& resources,
+  size_t max_keys) {
+    // the newest segments are indexed first, when the map fills up the keys
+    // of the older segments are not tracked and their records are kept, the
+    // map stays correct for the records it tracks
+    // aborted transactions of every segment are fetched once and shared by
+    // the indexing and the copying
+    std::vector<compaction_filter> filters;
+    filters.reserve(segments.size());
+    for (auto& s : segments) {
+        filters.push_back(co_await compaction_filter::make(*s, cfg));
+    }
+
+    key_offset_map map(max_keys);
+    size_t indexed = 0;
+    bool complete = true;
+    for (size_t i = segments.size(); i > 0; --i) {
+        ++indexed;
+        if (!co_await index_segment_keys(
+              segments[i - 1], map, filters[i - 1], cfg)) {
+            complete = false;
+            break;
+        }
+    }
+    // the window starts at the beginning of the log, with every key in the
+    // map the values a tombstone deletes are removed in this pass as well
+    if (complete && cfg.tombstone_eviction_time) {
+        for (auto& f : filters) {
+            f.set_tombstone_eviction_time(*cfg.tombstone_eviction_time);
+        }
+    }
+    vlog(
+      gclog.debug,
+      "compacting window of {} segments, {} keys indexed from {} segments",
+      segments.size(),
+      map.size(),
+      indexed);
+
+    size_t size_before = 0;
+    size_t size_after = 0;
+    bool compacted = false;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        auto& s = segments[i];
+        auto sz_before = s->size_bytes();
+        size_before += sz_before;
+        if (cfg.asrc && cfg.asrc->abort_requested()) {
+            size_after += sz_before;
+            continue;
+        }
+        auto sz_after = co_await do_compact_segment_with_key_map(
+          s, map, filters[i], cfg, pb, readers_cache, resources);
+        if (sz_after) {
+            compacted = true;
+            pb.segment_compacted();
+            size_after += *sz_after;
+        } else {
+            size_after += sz_before;
+        }
+    }
+    if (!compacted) {
+        co_return compaction_result(size_before);
+    }
+    co_return compaction_result(size_before, size_after);
+}
+
 ss::future<> rebuild_compaction_index(
   model::record_batch_reader rdr,
   std::filesystem::path p,
   compaction_config cfg,
   storage_resources& resources) {
     return make_compacted_index_writer(p, cfg.sanitize, cfg.iopc, resources)
-      .then([r = std::move(rdr)](compacted_index_writer w) mutable {
+      .then([r = std::move(rdr), &resources](compacted_index_writer w) mutable {
           auto u = std::make_unique<compacted_index_writer>(std::move(w));
           auto ptr = u.get();
           return std::move(r)
-            .consume(index_rebuilder_reducer(ptr), model::no_timeout)
+            .consume(
+              index_rebuilder_reducer(
+                ptr, &resources.get_compaction_throttle()),
+              model::no_timeout)
             .then_wrapped([x = std::move(u)](ss::future<> fut) mutable {
                 return x->close()
                   .handle_exception([](std::exception_ptr e) {
@@ -525,6 +813,8 @@ ss::future<compaction_result> self_compact_segment(
         throw std::runtime_error(fmt::format(
           "Cannot compact an active segment. cfg:{} - segment:{}", cfg, s));
     }
+    // the compaction index of a rolled segment is closed in the background
+    co_await s->wait_for_appender_release();
 
     if (s->finished_self_compaction()) {
         co_return compaction_result{s->size_bytes()};
@@ -618,10 +908,19 @@ make_concatenated_segment(
     }
     auto writer = co_await make_writer_handle(path, cfg.sanitize);
     auto output = co_await ss::make_file_output_stream(std::move(writer));
+    auto& throttle = resources.get_compaction_throttle();
     for (auto& segment : segments) {
         auto reader_handle = co_await segment->reader().data_stream(
           0, cfg.iopc);
-        co_await ss::copy(reader_handle.stream(), output);
+        auto& input = reader_handle.stream();
+        while (true) {
+            auto buf = co_await input.read();
+            if (buf.empty()) {
+                break;
+            }
+            co_await throttle.throttle(buf.size());
+            co_await output.write(std::move(buf));
+        }
         co_await reader_handle.close();
     }
     co_await output.close();
@@ -15,6 +15,7 @@
 #include "storage/compacted_index_reader.h"
 #include "storage/compacted_index_writer.h"
 #include "storage/compacted_offset_list.h"
+#include "storage/compaction_filter.h"
 #include "storage/probe.h"
 #include "storage/readers_cache.h"
 #include "storage/segment.h"
@@ -38,6 +39,22 @@ ss::future<compaction_result> self_compact_segment(
   storage::readers_cache&,
   storage::storage_resources&);
 
+/// \brief compacts a window of segments with a shared key_offset_map
+///
+/// The latest offset of every key is collected from the compaction indices of
+/// the segments, newest segment first, until 'max_keys' keys are tracked.
+/// Every segment is then rewritten without the records that are superseded
+/// by a newer record in the window. The segments must be closed and self
+/// compacted, ordered from the oldest to the newest. Acquires its own locks
+/// on the segments.
+ss::future<compaction_result> compact_segment_window(
+  std::vector<ss::lw_shared_ptr<storage::segment>>,
+  storage::compaction_config,
+  storage::probe&,
+  storage::readers_cache&,
+  storage::storage_resources&,
+  size_t max_keys);
+
 /*
  * Concatentate segments into a minimal new segment.
  *
@@ -114,7 +131,8 @@ ss::future<segment_appender_ptr> make_segment_appender(
   size_t number_of_chunks,
   std::optional<uint64_t> segment_size,
   ss::io_priority_class iopc,
-  storage_resources& resources);
+  storage_resources& resources,
+  size_t preallocated = 0);
 
 size_t number_of_chunks_from_config(const storage::ntp_config&);
 uint64_t segment_size_from_config(const storage::ntp_config&);
@@ -128,8 +146,10 @@ uint64_t segment_size_from_config(const storage::ntp_config&);
 
 /// \brief this is a 0-based index (i.e.: i++) of the entries we need to
 /// save starting at 0 on a *new* `.compacted_index` file this represents
-/// the fully dedupped entries, clean of truncations, etc
-ss::future<Roaring> natural_index_of_entries_to_keep(compacted_index_reader);
+/// the fully dedupped entries, clean of truncations, etc. Entries in the
+/// span of an aborted transaction of the filter are always kept
+ss::future<Roaring> natural_index_of_entries_to_keep(
+  compacted_index_reader, const compaction_filter* = nullptr);
 
 ss::future<> copy_filtered_entries(
   storage::compacted_index_reader input,
@@ -141,7 +161,8 @@ ss::future<> copy_filtered_entries(
 ss::future<> write_clean_compacted_index(
   storage::compacted_index_reader,
   storage::compaction_config,
-  storage_resources& resources);
+  storage_resources& resources,
+  const compaction_filter* = nullptr);
 
 ss::future<compacted_offset_list>
   generate_compacted_list(model::offset, storage::compacted_index_reader);
@@ -157,12 +178,22 @@ model::record_batch_reader create_segment_full_reader(
   storage::probe&,
   ss::rwlock::holder);
 
+ss::future<storage::index_state> do_copy_segment_data(
+  ss::lw_shared_ptr<storage::segment>,
+  compacted_offset_list,
+  storage::compaction_config,
+  storage::probe&,
+  ss::rwlock::holder,
+  storage_resources&,
+  compaction_filter* = nullptr);
+
 ss::future<storage::index_state> do_copy_segment_data(
   ss::lw_shared_ptr<storage::segment>,
   storage::compaction_config,
   storage::probe&,
   ss::rwlock::holder,
-  storage_resources&);
+  storage_resources&,
+  compaction_filter* = nullptr);
 
 ss::future<> do_swap_data_file_handles(
   std::filesystem::path compacted,
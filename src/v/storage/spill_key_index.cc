@@ -10,6 +10,7 @@
 #include "storage/spill_key_index.h"
 
 #include "bytes/bytes.h"
+#include "likely.h"
 #include "random/generators.h"
 #include "reflection/adl.h"
 #include "storage/compacted_index.h"
@@ -69,23 +70,79 @@ spill_key_index::~spill_key_index() {
       _midx.size());
 }
 
+bytes_view spill_key_index::key_arena::append(bytes_view key) {
+    uint8_t* dst = nullptr;
+    if (key.size() > chunk_size / 4) {
+        // large keys get a chunk of their own, the current chunk stays in use
+        auto chunk = std::make_unique<uint8_t[]>(key.size());
+        dst = chunk.get();
+        if (_chunks.empty()) {
+            _chunks.push_back(std::move(chunk));
+        } else {
+            _chunks.insert(std::prev(_chunks.end()), std::move(chunk));
+        }
+    } else {
+        if (_chunk_used + key.size() > chunk_size) {
+            _chunks.push_back(std::make_unique<uint8_t[]>(chunk_size));
+            _chunk_used = 0;
+        }
+        dst = _chunks.back().get() + _chunk_used;
+        _chunk_used += key.size();
+    }
+    std::copy_n(key.begin(), key.size(), dst);
+    return {dst, key.size()};
+}
+
+void spill_key_index::key_arena::clear() {
+    _chunks.clear();
+    _chunk_used = chunk_size;
+}
+
 ss::future<> spill_key_index::index(
   const compaction_key& v, model::offset base_offset, int32_t delta) {
-    if (auto it = _midx.find(v); it != _midx.end()) {
-        auto& pair = it->second;
-        if (base_offset > pair.base_offset) {
-            pair.base_offset = base_offset;
-            pair.delta = delta;
+    return index_key(v, value_type{base_offset, delta});
+}
+
+ss::future<> spill_key_index::index_key(bytes_view key, value_type v) {
+    const auto fp = fingerprint(key);
+    auto f = ss::now();
+    if (auto it = _midx.find(fp); it != _midx.end()) {
+        auto& e = it->second;
+        if (likely(e.key() == key)) {
+            // must use both base+delta, since we only want to keep the latest
+            // which might be inserted into the batch multiple times by client
+            const auto record = v.base_offset + model::offset(v.delta);
+            const auto current = e.value.base_offset
+                                 + model::offset(e.value.delta);
+            if (record > current) {
+                e.value = v;
+            }
+            return ss::now();
         }
-        return ss::now();
+        // fingerprint collision, the index may contain a key multiple times
+        // so the entry in the table is spilled to make room for the new key
+        auto collided = _midx.extract(it);
+        release_entry_memory(collided.mapped().key());
+        f = spill(
+          compacted_index::entry_type::key,
+          collided.mapped().key(),
+          collided.mapped().value);
+    }
+
+    if (!reserve_entry_memory(entry_mem_usage(key))) {
+        insert_key(key, fp, v);
+        return f;
     }
-    // not found
-    return add_key(v, value_type{base_offset, delta});
+    // the key has to outlive the drain, which releases the arena
+    return ss::do_with(
+      bytes(key), [this, fp, v, f = std::move(f)](const bytes& k) mutable {
+          return std::move(f)
+            .then([this] { return drain_all_keys(); })
+            .then([this, &k, fp, v] { insert_key(k, fp, v); });
+      });
 }
 
-ss::future<> spill_key_index::add_key(compaction_key b, value_type v) {
-    auto f = ss::now();
-    auto const entry_size = entry_mem_usage(b);
+bool spill_key_index::reserve_entry_memory(size_t entry_size) {
     auto const expected_size = idx_mem_usage() + _keys_mem_usage + entry_size;
 
     auto take_result = _resources.compaction_index_take_bytes(entry_size);
@@ -100,50 +157,21 @@ ss::future<> spill_key_index::add_key(compaction_key b, value_type v) {
     // would end up spilling on every key.
     const size_t min_index_size = std::min(32_KiB, _max_mem);
 
-    if (
-      (take_result.checkpoint_hint && expected_size > min_index_size)
-      || expected_size >= _max_mem) {
-        f = ss::do_until(
-          [this, entry_size, min_index_size] {
-              size_t total_mem = idx_mem_usage() + _keys_mem_usage + entry_size;
-
-              // Instance-local capacity check
-              bool local_ok = total_mem < _max_mem;
-
-              // Shard-wide capacity check
-              bool global_ok = _resources.compaction_index_bytes_available()
-                               || total_mem < min_index_size;
-
-              // Stop condition: none of our size thresholds must be violated
-              return _midx.empty() || (local_ok && global_ok);
-          },
-          [this] {
-              /**
-               * Evict first entry, we use hash function that guarante good
-               * randomness so evicting first entry is actually evicting a
-               * pseudo random elemnent
-               */
-              auto node = _midx.extract(_midx.begin());
-
-              return ss::do_with(
-                node.key(),
-                node.mapped(),
-                [this](const bytes& k, value_type o) {
-                    release_entry_memory(k);
-                    return spill(compacted_index::entry_type::key, k, o);
-                });
-          });
-    }
-
-    return f.then([this, entry_size, b = std::move(b), v]() mutable {
-        // convert iobuf to key
-        _keys_mem_usage += entry_size;
-
-        // No update to _mem_units here: we already took units at top
-        // of add_key before starting the write.
+    return (take_result.checkpoint_hint && expected_size > min_index_size)
+           || expected_size >= _max_mem;
+}
 
-        _midx.insert({std::move(b), v});
-    });
+void spill_key_index::insert_key(
+  bytes_view key, uint64_t fp, value_type v) {
+    // No update to _mem_units here: the units were taken by
+    // reserve_entry_memory before any spill.
+    _keys_mem_usage += key.size();
+    _midx.emplace(
+      fp,
+      entry{
+        .value = v,
+        .key_data = _arena.append(key).data(),
+        .key_size = static_cast<uint32_t>(key.size())});
 }
 
 ss::future<> spill_key_index::index(
@@ -152,20 +180,7 @@ ss::future<> spill_key_index::index(
   model::offset base_offset,
   int32_t delta) {
     auto key = prefix_with_batch_type(batch_type, b);
-    if (auto it = _midx.find(key); it != _midx.end()) {
-        auto& pair = it->second;
-        // must use both base+delta, since we only want to keep the latest
-        // which might be inserted into the batch multiple times by client
-        const auto record = base_offset + model::offset(delta);
-        const auto current = pair.base_offset + model::offset(pair.delta);
-        if (record > current) {
-            pair.base_offset = base_offset;
-            pair.delta = delta;
-        }
-        return ss::now();
-    }
-    // not found
-    return add_key(std::move(key), value_type{base_offset, delta});
+    return index_key(key, value_type{base_offset, delta});
 }
 ss::future<> spill_key_index::index(
   model::record_batch_type batch_type,
@@ -233,19 +248,16 @@ ss::future<> spill_key_index::append(compacted_index::entry e) {
 }
 
 ss::future<> spill_key_index::drain_all_keys() {
-    return ss::do_until(
-      [this] {
-          // stop condition
-          return _midx.empty();
-      },
-      [this] {
-          auto node = _midx.extract(_midx.begin());
-          release_entry_memory(node.key());
-          return ss::do_with(
-            node.key(), node.mapped(), [this](const bytes& k, value_type o) {
-                return spill(compacted_index::entry_type::key, k, o);
-            });
-      });
+    // the table and the arena are moved out, so the drain can't be affected
+    // by the keys added while spilling
+    auto midx = std::exchange(_midx, underlying_t{});
+    auto arena = std::exchange(_arena, key_arena{});
+    for (auto& [_, e] : midx) {
+        release_entry_memory(e.key());
+    }
+    for (auto& [_, e] : midx) {
+        co_await spill(compacted_index::entry_type::key, e.key(), e.value);
+    }
 }
 
 void spill_key_index::set_flag(compacted_index::footer_flags f) {
@@ -26,8 +26,12 @@
 #include <seastar/core/file.hh>
 #include <seastar/core/future.hh>
 
-#include <absl/container/node_hash_map.h>
+#include <absl/container/flat_hash_map.h>
 #include <absl/hash/hash.h>
+
+#include <memory>
+#include <vector>
+
 namespace storage::internal {
 using namespace storage; // NOLINT
 class spill_key_index final : public compacted_index_writer::impl {
@@ -39,11 +43,36 @@ public:
     static constexpr auto value_sz = sizeof(value_type);
     static constexpr size_t max_key_size = compacted_index::max_entry_size
                                            - (2 * vint::max_length);
-    using underlying_t = absl::node_hash_map<
-      compaction_key,
-      value_type,
-      bytes_hasher<uint64_t, xxhash_64>,
-      bytes_type_eq>;
+
+    /// Keys are stored contiguously in chunks that are released all at once
+    /// when the index is drained, this avoids an allocation per key
+    class key_arena {
+    public:
+        static constexpr size_t chunk_size = 32_KiB;
+
+        /// Copy the key into the arena, the returned view is valid until
+        /// the arena is cleared
+        bytes_view append(bytes_view key);
+        void clear();
+
+    private:
+        std::vector<std::unique_ptr<uint8_t[]>> _chunks;
+        size_t _chunk_used{chunk_size};
+    };
+
+    struct entry {
+        value_type value;
+        const uint8_t* key_data;
+        uint32_t key_size;
+
+        bytes_view key() const { return {key_data, key_size}; }
+    };
+
+    /// Open addressing table indexed by the 64-bit fingerprint of the key.
+    /// Key bytes are compared only when fingerprints match, a collision
+    /// spills the entry already in the table.
+    using underlying_t = absl::flat_hash_map<uint64_t, entry>;
+    static constexpr auto slot_sz = sizeof(underlying_t::value_type);
 
     spill_key_index(
       ss::sstring filename,
@@ -92,17 +121,18 @@ private:
         return debug::AllocatedByteSize(_midx);
     }
 
-    size_t entry_mem_usage(const bytes& k) const {
-        // One entry in a node hash map: key and value
-        // are allocated together, and the key is a basic_sstring with
-        // internal buffer that may be spilled if key was longer.
-        auto is_external = k.size() > bytes_inline_size;
-        return (is_external ? sizeof(k) + k.size() : sizeof(k)) + value_sz;
+    static uint64_t fingerprint(bytes_view k) {
+        return xxhash_64(k.data(), k.size());
+    }
+
+    size_t entry_mem_usage(bytes_view k) const {
+        // the slot of the table and the key bytes in the arena
+        return slot_sz + k.size();
     }
 
-    void release_entry_memory(const bytes& k) {
+    void release_entry_memory(bytes_view k) {
         auto entry_memory = entry_mem_usage(k);
-        _keys_mem_usage -= entry_memory;
+        _keys_mem_usage -= k.size();
 
         // Handle the case of a double-release, in case this comes up
         // during retries/exception handling.
@@ -111,7 +141,12 @@ private:
     }
 
     ss::future<> drain_all_keys();
-    ss::future<> add_key(compaction_key, value_type);
+    /// The key is only used before the first suspension point
+    ss::future<> index_key(bytes_view, value_type);
+    /// Take memory units for a new entry, returns true if the index has to
+    /// be spilled before the entry is added
+    bool reserve_entry_memory(size_t entry_size);
+    void insert_key(bytes_view, uint64_t fingerprint, value_type);
     ss::future<> spill(compacted_index::entry_type, bytes_view, value_type);
 
     storage::debug_sanitize_files _debug;
@@ -120,6 +155,7 @@ private:
     bool _truncate;
     std::optional<segment_appender> _appender;
     underlying_t _midx;
+    key_arena _arena;
 
     // Max memory we'll use for _midx, although we may spill earlier
     // if hinted to by storage_resources
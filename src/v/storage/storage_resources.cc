@@ -12,9 +12,12 @@
 #include "storage_resources.h"
 
 #include "config/configuration.h"
+#include "storage/chunk_cache.h"
 #include "storage/logger.h"
 #include "vlog.h"
 
+#include <seastar/core/coroutine.hh>
+
 namespace storage {
 
 storage_resources::storage_resources(
@@ -34,7 +37,19 @@ storage_resources::storage_resources(
   , _inflight_recovery(
       std::max(_max_concurrent_replay() / ss::smp::count, uint64_t{1}))
   , _inflight_close_flush(
-      std::max(_max_concurrent_replay() / ss::smp::count, uint64_t{1})) {
+      std::max(_max_concurrent_replay() / ss::smp::count, uint64_t{1}))
+  , _flush_coordinator(
+      config::shard_local_cfg().storage_flush_coalescing.bind())
+  , _compaction_throttle(
+      config::shard_local_cfg().compaction_ctrl_io_bandwidth.bind(),
+      config::shard_local_cfg().compaction_ctrl_flush_latency_target_ms.bind(),
+      config::shard_local_cfg().compaction_ctrl_update_interval_ms.bind())
+  , _io_share_controller(
+      config::shard_local_cfg().io_share_ctrl_enabled.bind(),
+      config::shard_local_cfg().io_share_ctrl_produce_latency_target_ms.bind(),
+      config::shard_local_cfg().io_share_ctrl_fetch_latency_target_ms.bind(),
+      config::shard_local_cfg().io_share_ctrl_update_interval_ms.bind())
+  , _segment_pool(config::shard_local_cfg().segment_recycle_pool_size.bind()) {
     // Register notifications on configuration changes
     _target_replay_bytes.watch([this]() {
         auto v = _target_replay_bytes() / ss::smp::count;
@@ -87,13 +102,48 @@ void storage_resources::update_allowance(uint64_t total, uint64_t free) {
 
     _space_allowance = total;
     _space_allowance_free = std::min(free, total);
+    _has_disk_stats = true;
 
     _falloc_step = calc_falloc_step();
 }
 
+uint64_t storage_resources::reclaim_goal() const {
+    if (!_has_disk_stats) {
+        return 0;
+    }
+    const auto& cfg = config::shard_local_cfg();
+    const uint64_t target = std::max(
+      _space_allowance * cfg.storage_space_alert_free_threshold_percent() / 100,
+      uint64_t(cfg.storage_space_alert_free_threshold_bytes()));
+
+    // Same pessimistic per shard split of the disk as calc_falloc_step
+    const uint64_t shard_target = target / ss::smp::count
+                                  + _partition_count * min_falloc_step
+                                  + _space_reserved;
+    const uint64_t shard_free = _space_allowance_free / ss::smp::count;
+    return shard_target > shard_free ? shard_target - shard_free : 0;
+}
+
+ss::future<ssx::semaphore_units>
+storage_resources::get_recovery_units(recovery_priority prio) {
+    if (prio == recovery_priority::high) {
+        ++_high_priority_recovery_waiters;
+        auto units = co_await _inflight_recovery.get_units(1).finally([this] {
+            if (--_high_priority_recovery_waiters == 0) {
+                _high_priority_recovery_drained.broadcast();
+            }
+        });
+        co_return units;
+    }
+    co_await _high_priority_recovery_drained.wait(
+      [this] { return _high_priority_recovery_waiters == 0; });
+    co_return co_await _inflight_recovery.get_units(1);
+}
+
 void storage_resources::update_partition_count(size_t partition_count) {
     _partition_count = partition_count;
     _falloc_step_dirty = true;
+    internal::chunks().set_partition_count(partition_count);
 }
 
 size_t storage_resources::calc_falloc_step() {
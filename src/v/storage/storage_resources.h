@@ -13,8 +13,16 @@
 
 #include "config/property.h"
 #include "ssx/semaphore.h"
+#include "storage/compaction_throttle.h"
+#include "storage/flush_coordinator.h"
+#include "storage/io_share_controller.h"
+#include "storage/probe.h"
+#include "storage/segment_pool.h"
+#include "storage/types.h"
 #include "units.h"
 
+#include <seastar/core/condition-variable.hh>
+
 #include <cstdint>
 
 namespace storage {
@@ -104,6 +112,46 @@ private:
  */
 class storage_resources {
 public:
+    /**
+     * Disk space reserved ahead of a write that is about to happen, e.g. the
+     * output of a compaction, released on destruction.
+     */
+    class space_reservation {
+    public:
+        space_reservation() noexcept = default;
+        space_reservation(uint64_t& reserved, uint64_t bytes) noexcept
+          : _reserved(&reserved)
+          , _bytes(bytes) {
+            *_reserved += _bytes;
+        }
+        space_reservation(space_reservation&& o) noexcept
+          : _reserved(std::exchange(o._reserved, nullptr))
+          , _bytes(std::exchange(o._bytes, 0)) {}
+        space_reservation& operator=(space_reservation&& o) noexcept {
+            if (this != &o) {
+                release();
+                _reserved = std::exchange(o._reserved, nullptr);
+                _bytes = std::exchange(o._bytes, 0);
+            }
+            return *this;
+        }
+        space_reservation(const space_reservation&) = delete;
+        space_reservation& operator=(const space_reservation&) = delete;
+        ~space_reservation() noexcept { release(); }
+
+        void release() noexcept {
+            if (_reserved) {
+                *_reserved -= _bytes;
+                _reserved = nullptr;
+                _bytes = 0;
+            }
+        }
+
+    private:
+        uint64_t* _reserved{nullptr};
+        uint64_t _bytes{0};
+    };
+
     // If we don't have this much disk space available per partition,
     // don't both falloc'ing at all.
     static constexpr size_t min_falloc_step = 128_KiB;
@@ -129,6 +177,23 @@ public:
 
     uint64_t get_space_allowance() { return _space_allowance; }
 
+    /**
+     * Reserved bytes count as used when checking the free space target, so
+     * that space is reclaimed before it is written rather than after.
+     */
+    space_reservation reserve_space(uint64_t bytes) {
+        return {_space_reserved, bytes};
+    }
+    uint64_t reserved_space() const { return _space_reserved; }
+
+    /**
+     * Bytes this shard should reclaim to keep the free disk space over the
+     * storage space alert threshold, with room for every partition of the
+     * shard to roll a segment and for the reserved space. 0 until the disk
+     * stats are known.
+     */
+    uint64_t reclaim_goal() const;
+
     size_t get_falloc_step(std::optional<uint64_t>);
     size_t calc_falloc_step();
 
@@ -145,17 +210,36 @@ public:
         return _compaction_index_bytes.current() > 0;
     }
 
-    ss::future<ssx::semaphore_units> get_recovery_units() {
-        return _inflight_recovery.get_units(1);
-    }
+    /**
+     * High priority recoveries never wait behind normal priority ones that
+     * did not start waiting for units yet.
+     */
+    ss::future<ssx::semaphore_units>
+      get_recovery_units(recovery_priority = recovery_priority::normal);
 
     ss::future<ssx::semaphore_units> get_close_flush_units() {
         return _inflight_close_flush.get_units(1);
     }
 
+    flush_coordinator& get_flush_coordinator() { return _flush_coordinator; }
+
+    compaction_throttle& get_compaction_throttle() {
+        return _compaction_throttle;
+    }
+
+    io_share_controller& get_io_share_controller() {
+        return _io_share_controller;
+    }
+
+    segment_pool& get_segment_pool() { return _segment_pool; }
+
+    void setup_chunk_cache_metrics() { _chunk_cache_probe.setup_metrics(); }
+
 private:
     uint64_t _space_allowance{9};
     uint64_t _space_allowance_free{0};
+    bool _has_disk_stats{false};
+    uint64_t _space_reserved{0};
 
     size_t _partition_count{9};
     config::binding<size_t> _segment_fallocation_step;
@@ -191,10 +275,26 @@ private:
     // How many logs may be recovered (via log_manager::manage)
     // concurrently?
     adjustable_allowance _inflight_recovery{0};
+    size_t _high_priority_recovery_waiters{0};
+    ss::condition_variable _high_priority_recovery_drained;
 
     // How many logs may be flushed during segment close concurrently?
     // (e.g. when we shut down and ask everyone to flush)
     adjustable_allowance _inflight_close_flush{0};
+
+    // Merges segment flushes issued concurrently by the logs on this shard
+    flush_coordinator _flush_coordinator;
+
+    // Paces compaction I/O of the logs on this shard
+    compaction_throttle _compaction_throttle;
+
+    // Adapts the I/O shares of recovery to the produce and fetch latency
+    io_share_controller _io_share_controller;
+
+    // Data files of removed segments, reused by new segments
+    segment_pool _segment_pool;
+
+    chunk_cache_probe _chunk_cache_probe;
 };
 
 } // namespace storage
\ No newline at end of file
@@ -0,0 +1,283 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "config/configuration.h"
+#include "model/namespace.h"
+#include "model/record_batch_reader.h"
+#include "random/generators.h"
+#include "storage/api.h"
+#include "storage/log_manager.h"
+#include "storage/ntp_config.h"
+#include "storage/record_batch_builder.h"
+#include "units.h"
+#include "utils/hdr_hist.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/testing/perf_tests.hh>
+
+#include <boost/range/irange.hpp>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+
+using namespace std::chrono_literals;
+
+/**
+ * Benchmark of the write path of the log.
+ *
+ * A number of partitions are managed by the log manager of the shard running
+ * the bench, every iteration appends a batch to each of them concurrently
+ * and, depending on the flush policy, flushes them. Segment files, their
+ * indices and the flushes are the real ones, on the disk of the directory
+ * the bench runs in.
+ *
+ * The time reported by the tests is per append. Once it completes a test
+ * reports the append throughput, the flush latency percentiles and the write
+ * amplification: the bytes the process sent to the block layer, as counted
+ * by the kernel, over the bytes of the appended batches.
+ */
+struct append_bench_params {
+    // number of partitions a batch is appended to every iteration
+    size_t partitions;
+    // size of the value of the single record of a batch
+    size_t batch_size;
+    // the partitions are flushed every so many iterations, never if 0
+    size_t flush_every{1};
+    size_t segment_size{128_MiB};
+    size_t fallocation_step{32_MiB};
+    // concurrent flushes are coalesced by the flush coordinator
+    bool flush_coalescing{false};
+};
+
+namespace {
+
+model::record_batch make_batch(size_t size) {
+    storage::record_batch_builder builder(
+      model::record_batch_type::raft_data, model::offset(0));
+    iobuf value;
+    value.append(random_generators::gen_alphanum_string(size).data(), size);
+    builder.add_raw_kv(std::nullopt, std::move(value));
+    return std::move(builder).build();
+}
+
+/// Bytes the process caused to be sent to the block layer, std::nullopt if
+/// the kernel doesn't account them
+std::optional<uint64_t> process_write_bytes() {
+    std::ifstream io("/proc/self/io");
+    std::string key;
+    uint64_t value = 0;
+    while (io >> key >> value) {
+        if (key == "write_bytes:") {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+class append_bench_fixture {
+public:
+    explicit append_bench_fixture(append_bench_params p)
+      : _params(p)
+      , _directory(
+          "storage_bench." + random_generators::gen_alphanum_string(6))
+      , _storage(
+          [this]() {
+              return storage::kvstore_config(
+                1_MiB,
+                config::mock_binding(10ms),
+                _directory,
+                storage::debug_sanitize_files::no);
+          },
+          [this]() {
+              return storage::log_config(
+                storage::log_config::storage_type::disk,
+                _directory,
+                _params.segment_size,
+                storage::debug_sanitize_files::no);
+          })
+      , _batch(make_batch(p.batch_size)) {
+        config::shard_local_cfg()
+          .get("segment_fallocation_step")
+          .set_value(_params.fallocation_step);
+        config::shard_local_cfg()
+          .get("storage_flush_coalescing")
+          .set_value(_params.flush_coalescing);
+        _storage.start().get();
+        _logs.reserve(_params.partitions);
+        for (size_t i = 0; i < _params.partitions; ++i) {
+            model::ntp ntp(
+              model::kafka_namespace,
+              model::topic("bench"),
+              model::partition_id(static_cast<int32_t>(i)));
+            _logs.push_back(_storage.log_mgr()
+                              .manage(storage::ntp_config(ntp, _directory))
+                              .get());
+        }
+        _start_write_bytes = process_write_bytes();
+    }
+
+    append_bench_fixture(const append_bench_fixture&) = delete;
+    append_bench_fixture& operator=(const append_bench_fixture&) = delete;
+    append_bench_fixture(append_bench_fixture&&) = delete;
+    append_bench_fixture& operator=(append_bench_fixture&&) = delete;
+
+    ~append_bench_fixture() {
+        // what was appended but not flushed yet is written too
+        for (auto& log : _logs) {
+            log.flush().get();
+        }
+        report();
+        _logs.clear();
+        _storage.stop().get();
+    }
+
+    ss::future<size_t> run() {
+        const bool flush = _params.flush_every > 0
+                           && ++_iterations % _params.flush_every == 0;
+        std::vector<model::record_batch> batches;
+        batches.reserve(_logs.size());
+        for (size_t i = 0; i < _logs.size(); ++i) {
+            batches.push_back(_batch.copy());
+        }
+
+        perf_tests::start_measuring_time();
+        auto start = std::chrono::steady_clock::now();
+        co_await ss::parallel_for_each(
+          boost::irange<size_t>(0, _logs.size()),
+          [this, flush, &batches](size_t i) {
+              return append(_logs[i], std::move(batches[i]), flush);
+          });
+        _elapsed += std::chrono::steady_clock::now() - start;
+        perf_tests::stop_measuring_time();
+        co_return _logs.size();
+    }
+
+private:
+    ss::future<> append(storage::log log, model::record_batch b, bool flush) {
+        const auto size = b.size_bytes();
+        auto reader = model::make_memory_record_batch_reader(std::move(b));
+        co_await std::move(reader).for_each_ref(
+          log.make_appender(storage::log_append_config{
+            .should_fsync = storage::log_append_config::fsync::no,
+            .io_priority = ss::default_priority_class(),
+            .timeout = model::no_timeout}),
+          model::no_timeout);
+        _bytes += size;
+        ++_appends;
+        if (flush) {
+            auto start = std::chrono::steady_clock::now();
+            co_await log.flush();
+            _flush_latency.record(
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count());
+        }
+    }
+
+    void report() {
+        auto seconds = std::chrono::duration<double>(_elapsed).count();
+        auto end_write_bytes = process_write_bytes();
+        std::string amplification = "n/a";
+        if (_start_write_bytes && end_write_bytes && _bytes > 0) {
+            amplification = fmt::format(
+              "{:.2f}",
+              static_cast<double>(*end_write_bytes - *_start_write_bytes)
+                / _bytes);
+        }
+        fmt::print(
+          std::cout,
+          "{} partitions, {} byte batches, flush every {} iterations, {} "
+          "byte fallocation step, flush coalescing: {} - {:.2f} MiB/s, "
+          "{:.0f} appends/s, flush latency p50: {}us, p99: {}us, p999: "
+          "{}us, write amplification: {}\n",
+          _params.partitions,
+          _params.batch_size,
+          _params.flush_every,
+          _params.fallocation_step,
+          _params.flush_coalescing,
+          seconds > 0 ? _bytes / seconds / (1024 * 1024) : 0.0,
+          seconds > 0 ? _appends / seconds : 0.0,
+          _flush_latency.get_value_at(50.0),
+          _flush_latency.get_value_at(99.0),
+          _flush_latency.get_value_at(99.9),
+          amplification);
+    }
+
+    append_bench_params _params;
+    ss::sstring _directory;
+    storage::api _storage;
+    std::vector<storage::log> _logs;
+    model::record_batch _batch;
+
+    hdr_hist _flush_latency{hdr_hist::us_per_hour, 1, 3};
+    size_t _iterations{0};
+    size_t _appends{0};
+    size_t _bytes{0};
+    std::chrono::steady_clock::duration _elapsed{0};
+    std::optional<uint64_t> _start_write_bytes;
+};
+
+// many partitions with small batches, every append is flushed (acks=all)
+struct many_small : append_bench_fixture {
+    many_small()
+      : append_bench_fixture({.partitions = 1000, .batch_size = 1_KiB}) {}
+};
+
+// same with the flushes of the partitions coalesced
+struct many_small_coalesced : append_bench_fixture {
+    many_small_coalesced()
+      : append_bench_fixture({
+        .partitions = 1000,
+        .batch_size = 1_KiB,
+        .flush_coalescing = true,
+      }) {}
+};
+
+// few partitions with large batches, the disk bandwidth is the bottleneck
+struct few_large : append_bench_fixture {
+    few_large()
+      : append_bench_fixture({.partitions = 10, .batch_size = 128_KiB}) {}
+};
+
+// appends are left to the write behind of the appender (acks=1)
+struct no_flush : append_bench_fixture {
+    no_flush()
+      : append_bench_fixture({
+        .partitions = 100,
+        .batch_size = 16_KiB,
+        .flush_every = 0,
+      }) {}
+};
+
+// small segments and fallocation steps, segments are rolled and extended
+// all the time
+struct small_segments : append_bench_fixture {
+    small_segments()
+      : append_bench_fixture({
+        .partitions = 100,
+        .batch_size = 16_KiB,
+        .flush_every = 10,
+        .segment_size = 4_MiB,
+        .fallocation_step = 64_KiB,
+      }) {}
+};
+
+PERF_TEST_F(many_small, append) { return run(); }
+PERF_TEST_F(many_small_coalesced, append) { return run(); }
+PERF_TEST_F(few_large, append) { return run(); }
+PERF_TEST_F(no_flush, append) { return run(); }
+PERF_TEST_F(small_segments, append) { return run(); }
@@ -8,6 +8,7 @@
 // by the Apache License, Version 2.0
 
 #include "random/generators.h"
+#include "storage/chunk_cache.h"
 #include "storage/segment_appender.h"
 
 #include <seastar/testing/thread_test_case.hh>
@@ -62,3 +63,48 @@ SEASTAR_THREAD_TEST_CASE(chunk_manipulation) {
         BOOST_REQUIRE_EQUAL(c.dma_size(), 0);
     }
 }
+
+SEASTAR_THREAD_TEST_CASE(chunk_cache_sizing) {
+    const auto chunk_size = config::shard_local_cfg().append_chunk_size();
+    storage::internal::chunk_cache cache;
+    const auto max_chunks = cache.fair_share();
+
+    std::vector<ss::lw_shared_ptr<chunk>> chunks;
+    for (int i = 0; i < 16; ++i) {
+        chunks.push_back(cache.get().get());
+    }
+    for (auto& c : chunks) {
+        cache.add(c);
+    }
+    chunks.clear();
+    BOOST_REQUIRE_EQUAL(cache.size_available(), 16 * chunk_size);
+
+    // a single partition keeps only a few free chunks
+    cache.set_partition_count(1);
+    BOOST_REQUIRE_EQUAL(
+      cache.size_target(),
+      storage::internal::chunk_cache::target_chunks_per_partition * chunk_size);
+    BOOST_REQUIRE_EQUAL(cache.size_available(), cache.size_target());
+    BOOST_REQUIRE_EQUAL(cache.size_total(), cache.size_target());
+    BOOST_REQUIRE_EQUAL(cache.fair_share(), max_chunks);
+
+    // with many partitions an appender over its share waits for returned
+    // chunks instead of allocating
+    cache.set_partition_count(max_chunks);
+    BOOST_REQUIRE_EQUAL(
+      cache.fair_share(), storage::internal::chunk_cache::min_fair_share);
+    while (cache.size_available() > 0) {
+        chunks.push_back(cache.get().get());
+    }
+    auto f = cache.get(cache.fair_share());
+    BOOST_REQUIRE(!f.available());
+    BOOST_REQUIRE_EQUAL(cache.throttled(), 1);
+
+    // a returned chunk goes to the waiting appender
+    cache.add(chunks.back());
+    chunks.pop_back();
+    chunks.push_back(f.get());
+    for (auto& c : chunks) {
+        cache.add(c);
+    }
+}
@@ -164,6 +164,81 @@ SEASTAR_THREAD_TEST_CASE(touch) {
     }
 }
 
+SEASTAR_THREAD_TEST_CASE(segmented_lru_is_scan_resistant) {
+    static storage::batch_cache::reclaim_options opts = {
+      .growth_window = std::chrono::milliseconds(3000),
+      .stable_window = std::chrono::milliseconds(10000),
+      .min_size = 1,
+      .max_size = 1,
+      .policy = storage::batch_cache_policy::segmented_lru,
+    };
+
+    storage::batch_cache cache(opts);
+    std::vector<std::unique_ptr<storage::batch_cache_index>> indices;
+    std::vector<storage::batch_cache::entry> entries;
+    for (int i = 0; i < 8; ++i) {
+        indices.push_back(std::make_unique<storage::batch_cache_index>(cache));
+        entries.push_back(cache.put(*indices.back(), make_batch(10)));
+        if (i == 3) {
+            // a hit promotes the oldest range to the protected segment
+            cache.touch(entries[0].range());
+        }
+    }
+
+    // ranges inserted after the hit, or never hit, are reclaimed first even
+    // though they are more recent than the protected one
+    for (size_t i = 1; i < entries.size(); ++i) {
+        cache.reclaim(1);
+        BOOST_CHECK(!entries[i].range());
+        BOOST_CHECK(entries[0].range());
+    }
+    cache.reclaim(1);
+    BOOST_CHECK(!entries[0].range());
+    BOOST_CHECK(cache.empty());
+    cache.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(high_priority_reclaimed_last) {
+    static storage::batch_cache::reclaim_options opts = {
+      .growth_window = std::chrono::milliseconds(3000),
+      .stable_window = std::chrono::milliseconds(10000),
+      .min_size = 1,
+      .max_size = 1,
+    };
+
+    auto high = ss::make_lw_shared<storage::batch_cache_owner>(
+      storage::batch_cache_owner{
+        .priority = storage::batch_cache_priority::high});
+    auto regular = ss::make_lw_shared<storage::batch_cache_owner>();
+
+    storage::batch_cache cache(opts);
+    auto index_1 = std::make_unique<storage::batch_cache_index>(cache, high);
+    auto index_2 = std::make_unique<storage::batch_cache_index>(
+      cache, regular);
+
+    auto b0 = cache.put(*index_1, make_batch(10));
+    auto b1 = cache.put(*index_2, make_batch(10));
+    BOOST_CHECK_GT(high->bytes, 0);
+    BOOST_CHECK_GT(regular->bytes, 0);
+
+    // the regular range goes first even though it is the most recent one
+    cache.reclaim(1);
+    BOOST_CHECK(b0.range());
+    BOOST_CHECK(!b1.range());
+    BOOST_CHECK_EQUAL(regular->bytes, 0);
+
+    auto b2 = cache.put(*index_2, make_batch(10));
+    BOOST_CHECK_GT(regular->bytes, 0);
+    cache.evict(std::move(b2.range()));
+    BOOST_CHECK_EQUAL(regular->bytes, 0);
+
+    cache.reclaim(1);
+    BOOST_CHECK(!b0.range());
+    BOOST_CHECK_EQUAL(high->bytes, 0);
+    BOOST_CHECK(cache.empty());
+    cache.stop().get();
+}
+
 FIXTURE_TEST(index_get_empty, batch_cache_test_fixture) {
     storage::batch_cache_index index(cache);
 
@@ -0,0 +1,246 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "model/fundamental.h"
+#include "random/generators.h"
+#include "storage/compacted_index_reader.h"
+#include "storage/compacted_index_writer.h"
+#include "storage/compaction_reducers.h"
+#include "storage/readers_cache.h"
+#include "storage/record_batch_builder.h"
+#include "storage/segment_utils.h"
+#include "storage/spill_key_index.h"
+#include "storage/tests/utils/disk_log_builder.h"
+#include "utils/tmpbuf_file.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/testing/perf_tests.hh>
+
+/**
+ * Benchmarks of the compaction engine.
+ *
+ * Every fixture writes a keyed log with a given key cardinality and value
+ * size. The reducers are measured in isolation, indices and copied data are
+ * kept in memory, and the self_compact_segment pipeline is measured end to
+ * end on disk:
+ *
+ *   index_rebuild - index_rebuilder_reducer reading the segment data
+ *   key_reduce    - compaction_key_reducer over the segment index
+ *   copy_data     - copy_data_segment_reducer writing the latest records
+ *   self_compact  - self compaction of a freshly written segment
+ *
+ * Every test returns the number of KiB it processed (segment data or index
+ * size), the reported time and allocations are per KiB; 1e6 / (ns per KiB)
+ * is the throughput in MB/s.
+ */
+template<size_t Keys, size_t ValueSize>
+class compaction_bench {
+public:
+    static constexpr size_t segment_size = 1_MiB;
+    static constexpr int records_per_batch = 10;
+
+    compaction_bench() {
+        storage::ntp_config::default_overrides overrides;
+        overrides.cleanup_policy_bitflags
+          = model::cleanup_policy_bitflags::compaction;
+        _builder
+          .start(storage::ntp_config(
+            storage::log_builder_ntp(),
+            _builder.get_log_config().base_dir,
+            std::make_unique<storage::ntp_config::default_overrides>(
+              overrides)))
+          .get();
+        _segment = write_segment().get();
+        _index = build_index(_segment).get();
+    }
+
+    compaction_bench(const compaction_bench&) = delete;
+    compaction_bench& operator=(const compaction_bench&) = delete;
+    compaction_bench(compaction_bench&&) = delete;
+    compaction_bench& operator=(compaction_bench&&) = delete;
+
+    ~compaction_bench() { _builder.stop().get(); }
+
+    ss::future<size_t> index_rebuild() {
+        tmpbuf_file::store_t index_data;
+        auto writer = make_in_memory_index(index_data);
+        auto h = co_await _segment->read_lock();
+        auto rdr = storage::internal::create_segment_full_reader(
+          _segment, compaction_cfg(), _probe, std::move(h));
+
+        perf_tests::start_measuring_time();
+        co_await std::move(rdr).consume(
+          storage::internal::index_rebuilder_reducer(&writer),
+          model::no_timeout);
+        co_await writer.close();
+        perf_tests::stop_measuring_time();
+        co_return _segment->size_bytes() / 1_KiB;
+    }
+
+    ss::future<size_t> key_reduce() {
+        auto rdr = make_index_reader();
+
+        perf_tests::start_measuring_time();
+        auto bitmap = co_await rdr.consume(
+          storage::internal::compaction_key_reducer(), model::no_timeout);
+        perf_tests::stop_measuring_time();
+
+        co_await rdr.close();
+        perf_tests::do_not_optimize(bitmap);
+        co_return _index.size / 1_KiB;
+    }
+
+    ss::future<size_t> copy_data() {
+        auto offsets = co_await latest_offsets();
+        tmpbuf_file::store_t data;
+        storage::segment_appender appender(
+          ss::file(ss::make_shared(tmpbuf_file(data))),
+          storage::segment_appender::options(
+            ss::default_priority_class(), 1, std::nullopt, _resources));
+        auto h = co_await _segment->read_lock();
+        auto rdr = storage::internal::create_segment_full_reader(
+          _segment, compaction_cfg(), _probe, std::move(h));
+
+        perf_tests::start_measuring_time();
+        auto idx = co_await std::move(rdr).consume(
+          storage::internal::copy_data_segment_reducer(
+            std::move(offsets), &appender),
+          model::no_timeout);
+        co_await appender.close();
+        perf_tests::stop_measuring_time();
+
+        perf_tests::do_not_optimize(idx);
+        co_return _segment->size_bytes() / 1_KiB;
+    }
+
+    ss::future<size_t> self_compact() {
+        // every iteration needs a segment that wasn't compacted yet
+        auto segment = co_await write_segment();
+
+        perf_tests::start_measuring_time();
+        auto result = co_await storage::internal::self_compact_segment(
+          segment, compaction_cfg(), _probe, _readers_cache, _resources);
+        perf_tests::stop_measuring_time();
+
+        co_return result.size_before / 1_KiB;
+    }
+
+private:
+    storage::compaction_config compaction_cfg() {
+        return storage::compaction_config(
+          model::timestamp::min(),
+          std::nullopt,
+          ss::default_priority_class(),
+          _as);
+    }
+
+    /// Appends a segment worth of keyed records and rolls the log, returns
+    /// the closed segment
+    ss::future<ss::lw_shared_ptr<storage::segment>> write_segment() {
+        auto& log = _builder.get_disk_log_impl();
+        const size_t records = std::max<size_t>(
+          segment_size / ValueSize, records_per_batch);
+        for (size_t i = 0; i < records; i += records_per_batch) {
+            storage::record_batch_builder builder(
+              model::record_batch_type::raft_data, model::offset(0));
+            for (int r = 0; r < records_per_batch; ++r) {
+                auto k = ssx::sformat(
+                  "key-{}", random_generators::get_int<size_t>(Keys - 1));
+                iobuf key;
+                key.append(k.data(), k.size());
+                builder.add_raw_kv(
+                  std::move(key),
+                  bytes_to_iobuf(random_generators::get_bytes(ValueSize)));
+            }
+            auto reader = model::make_memory_record_batch_reader(
+              std::move(builder).build());
+            co_await std::move(reader).for_each_ref(
+              log.make_appender(storage::append_config()), model::no_timeout);
+        }
+        co_await log.flush();
+        co_await log.force_roll(ss::default_priority_class());
+        auto& segs = _builder.get_log_segments();
+        co_return *std::prev(segs.end(), 2);
+    }
+
+    ss::future<tmpbuf_file::store_t>
+    build_index(ss::lw_shared_ptr<storage::segment> s) {
+        tmpbuf_file::store_t index_data;
+        auto writer = make_in_memory_index(index_data);
+        auto h = co_await s->read_lock();
+        co_await storage::internal::create_segment_full_reader(
+          s, compaction_cfg(), _probe, std::move(h))
+          .consume(
+            storage::internal::index_rebuilder_reducer(&writer),
+            model::no_timeout);
+        co_await writer.close();
+        co_return index_data;
+    }
+
+    storage::compacted_index_writer
+    make_in_memory_index(tmpbuf_file::store_t& data) {
+        return storage::compacted_index_writer(
+          std::make_unique<storage::internal::spill_key_index>(
+            "bench index",
+            ss::file(ss::make_shared(tmpbuf_file(data))),
+            512_KiB,
+            _resources));
+    }
+
+    storage::compacted_index_reader make_index_reader() {
+        return storage::make_file_backed_compacted_reader(
+          "bench index",
+          ss::file(ss::make_shared(tmpbuf_file(_index))),
+          ss::default_priority_class(),
+          64_KiB);
+    }
+
+    /// Offsets of the latest record of every key in the segment
+    ss::future<storage::compacted_offset_list> latest_offsets() {
+        storage::internal::key_offset_map map(Keys);
+        auto rdr = make_index_reader();
+        co_await rdr.consume(
+          storage::internal::key_offset_map_builder_reducer(map),
+          model::no_timeout);
+        rdr.reset();
+        auto result = co_await rdr.consume(
+          storage::internal::key_offset_map_filter_reducer(
+            map, _segment->offsets().base_offset),
+          model::no_timeout);
+        co_await rdr.close();
+        co_return std::move(result.offsets);
+    }
+
+    storage::disk_log_builder _builder;
+    storage::storage_resources _resources;
+    storage::probe _probe;
+    storage::readers_cache _readers_cache;
+    ss::abort_source _as;
+    ss::lw_shared_ptr<storage::segment> _segment;
+    tmpbuf_file::store_t _index;
+};
+
+// defines the benchmarks of the compaction engine for a fixture
+#define COMPACTION_BENCH(fixture)                                              \
+    PERF_TEST_F(fixture, index_rebuild) { return index_rebuild(); }            \
+    PERF_TEST_F(fixture, key_reduce) { return key_reduce(); }                  \
+    PERF_TEST_F(fixture, copy_data) { return copy_data(); }                    \
+    PERF_TEST_F(fixture, self_compact) { return self_compact(); }
+
+// few keys, most records are removed
+using compaction_100_keys_100b = compaction_bench<100, 100>;
+using compaction_100_keys_10k = compaction_bench<100, 10_KiB>;
+// mostly unique keys, most records are kept
+using compaction_100k_keys_100b = compaction_bench<100'000, 100>;
+using compaction_100k_keys_10k = compaction_bench<100'000, 10_KiB>;
+
+COMPACTION_BENCH(compaction_100_keys_100b)
+COMPACTION_BENCH(compaction_100_keys_10k)
+COMPACTION_BENCH(compaction_100k_keys_100b)
+COMPACTION_BENCH(compaction_100k_keys_10k)
@@ -376,3 +376,127 @@ FIXTURE_TEST(index_filtered_copy_tests, compacted_topic_fixture) {
         }
     }
 }
+
+FIXTURE_TEST(key_offset_map_window_tests, compacted_topic_fixture) {
+    auto bt = model::record_batch_type::raft_data;
+    std::vector<bytes> keys;
+    for (auto i = 0; i < 10; ++i) {
+        keys.push_back(random_generators::get_bytes(16));
+    }
+    auto make_index = [&](tmpbuf_file::store_t& data, int keys, int64_t base) {
+        auto idx = make_dummy_compacted_index(data, 1_KiB, resources);
+        for (auto i = 0; i < keys; ++i) {
+            idx.index(bt, bytes(keys[i]), model::offset(base + i), 0).get();
+        }
+        idx.close().get();
+        return storage::make_file_backed_compacted_reader(
+          "dummy name",
+          ss::file(ss::make_shared(tmpbuf_file(data))),
+          ss::default_priority_class(),
+          32_KiB);
+    };
+    // older segment with keys 0-9, newer one with keys 0-4
+    tmpbuf_file::store_t older_data;
+    tmpbuf_file::store_t newer_data;
+    auto older = make_index(older_data, 10, 0);
+    auto newer = make_index(newer_data, 5, 10);
+
+    storage::internal::key_offset_map map(100);
+    for (auto* rdr : {&newer, &older}) {
+        rdr->reset();
+        auto complete = rdr
+                          ->consume(
+                            storage::internal::key_offset_map_builder_reducer(
+                              map),
+                            model::no_timeout)
+                          .get0();
+        BOOST_REQUIRE(complete);
+    }
+    BOOST_REQUIRE_EQUAL(map.size(), 10);
+    BOOST_REQUIRE_EQUAL(
+      map.get(storage::prefix_with_batch_type(bt, keys[0])),
+      model::offset(10));
+    BOOST_REQUIRE_EQUAL(
+      map.get(storage::prefix_with_batch_type(bt, keys[9])),
+      model::offset(9));
+
+    older.reset();
+    auto older_result = older
+                          .consume(
+                            storage::internal::key_offset_map_filter_reducer(
+                              map, model::offset(0)),
+                            model::no_timeout)
+                          .get0();
+    BOOST_REQUIRE_EQUAL(older_result.removed, 5);
+    BOOST_REQUIRE_EQUAL(older_result.entries.cardinality(), 5);
+    for (auto i = 0; i < 10; ++i) {
+        BOOST_REQUIRE_EQUAL(
+          older_result.offsets.contains(model::offset(i)), i >= 5);
+    }
+
+    newer.reset();
+    auto newer_result = newer
+                          .consume(
+                            storage::internal::key_offset_map_filter_reducer(
+                              map, model::offset(10)),
+                            model::no_timeout)
+                          .get0();
+    BOOST_REQUIRE_EQUAL(newer_result.removed, 0);
+    BOOST_REQUIRE_EQUAL(newer_result.entries.cardinality(), 5);
+
+    // a full map stops the indexing and keeps the keys it already tracks
+    storage::internal::key_offset_map small_map(3);
+    older.reset();
+    auto complete = older
+                      .consume(
+                        storage::internal::key_offset_map_builder_reducer(
+                          small_map),
+                        model::no_timeout)
+                      .get0();
+    BOOST_REQUIRE(!complete);
+    BOOST_REQUIRE_EQUAL(small_map.size(), 3);
+    older.close().get();
+    newer.close().get();
+}
+
+FIXTURE_TEST(spill_key_index_small_keys, compacted_topic_fixture) {
+    tmpbuf_file::store_t index_data;
+    // small budget to spill the keys a few times
+    auto idx = make_dummy_compacted_index(index_data, 4_KiB, resources);
+    auto bt = model::record_batch_type::raft_data;
+
+    std::vector<bytes> keys;
+    for (auto i = 0; i < 500; ++i) {
+        keys.push_back(random_generators::get_bytes(8));
+    }
+    using offsets_t = absl::flat_hash_map<
+      bytes,
+      model::offset,
+      bytes_hasher<uint64_t, xxhash_64>,
+      bytes_type_eq>;
+    offsets_t expected;
+    for (auto i = 0; i < 5000; ++i) {
+        auto& k = keys[random_generators::get_int<size_t>(keys.size() - 1)];
+        idx.index(bt, bytes(k), model::offset(i), 0).get();
+        expected[k] = model::offset(i);
+    }
+    idx.close().get();
+    info("{}", idx);
+
+    auto rdr = storage::make_file_backed_compacted_reader(
+      "dummy name",
+      ss::file(ss::make_shared(tmpbuf_file(index_data))),
+      ss::default_priority_class(),
+      32_KiB);
+    rdr.verify_integrity().get();
+    auto vec = compaction_index_reader_to_memory(rdr).get0();
+    // keys are spilled more than once but the latest offset is always there
+    BOOST_REQUIRE_GT(vec.size(), expected.size());
+    offsets_t latest;
+    for (auto& e : vec) {
+        auto k = extract_record_key(e.key);
+        auto& o = latest[k];
+        o = std::max(o, e.offset);
+    }
+    BOOST_REQUIRE(latest == expected);
+}
@@ -0,0 +1,115 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/iobuf.h"
+#include "config/property.h"
+#include "random/generators.h"
+#include "storage/compaction_throttle.h"
+#include "ssx/sformat.h"
+#include "units.h"
+#include "utils/file_io.h"
+
+#include <seastar/core/seastar.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <boost/test/tools/old/interface.hpp>
+
+using namespace std::chrono_literals; // NOLINT
+
+static storage::compaction_throttle make_throttle(
+  std::optional<size_t> bandwidth, std::chrono::milliseconds interval) {
+    return storage::compaction_throttle(
+      config::mock_binding<std::optional<size_t>>(std::move(bandwidth)),
+      config::mock_binding<std::chrono::milliseconds>(10ms),
+      config::mock_binding<std::chrono::milliseconds>(std::move(interval)));
+}
+
+SEASTAR_THREAD_TEST_CASE(throttle_disabled_without_bandwidth) {
+    auto throttle = make_throttle(std::nullopt, 0ms);
+    auto f = throttle.throttle(1_GiB);
+    BOOST_REQUIRE(f.available());
+    f.get();
+    BOOST_REQUIRE(!throttle.rate().has_value());
+
+    // detected bandwidth is used when nothing is configured
+    throttle.set_detected_bandwidth(100_MiB * ss::smp::count);
+    throttle.throttle(0).get();
+    BOOST_REQUIRE_EQUAL(throttle.rate().value(), 100_MiB);
+}
+
+SEASTAR_THREAD_TEST_CASE(throttle_reacts_to_foreground_latency) {
+    const size_t budget = 100_MiB;
+    auto throttle = make_throttle(budget * ss::smp::count, 0ms);
+    throttle.throttle(0).get();
+    BOOST_REQUIRE_EQUAL(throttle.rate().value(), budget);
+
+    // slow flushes halve the rate down to the floor
+    throttle.record_foreground_latency(100ms);
+    throttle.throttle(0).get();
+    BOOST_REQUIRE_EQUAL(throttle.rate().value(), budget / 2);
+    for (int i = 0; i < 10; ++i) {
+        throttle.record_foreground_latency(100ms);
+        throttle.throttle(0).get();
+    }
+    BOOST_REQUIRE_EQUAL(throttle.rate().value(), budget / 16);
+
+    // fast flushes let the rate grow back to the budget
+    throttle.record_foreground_latency(1ms);
+    throttle.throttle(0).get();
+    BOOST_REQUIRE_EQUAL(throttle.rate().value(), budget / 16 + budget / 10);
+    for (int i = 0; i < 20; ++i) {
+        throttle.throttle(0).get();
+    }
+    BOOST_REQUIRE_EQUAL(throttle.rate().value(), budget);
+}
+
+SEASTAR_THREAD_TEST_CASE(throttle_paces_transfers) {
+    const size_t budget = 10_MiB;
+    auto throttle = make_throttle(budget * ss::smp::count, 1h);
+    auto start = std::chrono::steady_clock::now();
+    // 2 MiB at 10 MiB/s, the burst allowance is 100ms worth of transfer
+    for (int i = 0; i < 8; ++i) {
+        throttle.throttle(256_KiB).get();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    BOOST_REQUIRE_GE(elapsed, 150ms);
+}
+
+SEASTAR_THREAD_TEST_CASE(read_iotune_profile) {
+    auto dir = std::filesystem::path(
+      ssx::sformat("iotune_test_{}", random_generators::gen_alphanum_string(8)));
+    ss::recursive_touch_directory(dir.string()).get();
+    auto profile = dir / "io-config.yaml";
+    const std::string_view profile_yaml = R"(disks:
+  - mountpoint: /
+    read_iops: 1000
+    read_bandwidth: 100000000
+    write_iops: 1000
+    write_bandwidth: 50000000
+  - mountpoint: /var/lib/redpanda/
+    read_iops: 100000
+    read_bandwidth: 2000000000
+    write_iops: 100000
+    write_bandwidth: 1000000000
+)";
+    iobuf yaml;
+    yaml.append(profile_yaml.data(), profile_yaml.size());
+    write_fully(profile, std::move(yaml)).get();
+
+    BOOST_REQUIRE_EQUAL(
+      storage::read_iotune_write_bandwidth(profile, "/var/lib/redpanda/data")
+        .value(),
+      1000000000);
+    BOOST_REQUIRE_EQUAL(
+      storage::read_iotune_write_bandwidth(profile, "/mnt/data").value(),
+      50000000);
+    BOOST_REQUIRE(!storage::read_iotune_write_bandwidth(
+                     dir / "missing.yaml", "/var/lib/redpanda/data")
+                     .has_value());
+}
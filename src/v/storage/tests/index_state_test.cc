@@ -4,6 +4,9 @@
 #include "serde/serde.h"
 #include "storage/index_state.h"
 #include "storage/index_state_serde_compat.h"
+#include "units.h"
+
+#include <seastar/core/byteorder.hh>
 
 #include <boost/test/unit_test.hpp>
 
@@ -159,3 +162,65 @@ BOOST_AUTO_TEST_CASE(serde_deprecated_crc) {
           return is_crc || is_out_of_bounds;
       });
 }
+
+// the arrays can be read in place at the positions given by the layout
+BOOST_AUTO_TEST_CASE(serde_file_layout) {
+    auto input = make_random_index_state();
+    const auto input_copy = input.copy();
+    const auto layout = storage::index_file_layout::for_entries(input.size());
+    const auto buf = iobuf_to_bytes(serde::to_iobuf(std::move(input)));
+
+    auto read_u32 = [&buf](size_t pos) {
+        return ss::read_le<uint32_t>(
+          reinterpret_cast<const char*>(buf.data() + pos));
+    };
+    auto read_u64 = [&buf](size_t pos) {
+        return ss::read_le<uint64_t>(
+          reinterpret_cast<const char*>(buf.data() + pos));
+    };
+
+    BOOST_REQUIRE_EQUAL(layout.entries, input_copy.size());
+    BOOST_REQUIRE_LE(
+      layout.position_pos + layout.entries * sizeof(uint64_t), buf.size());
+    for (size_t i = 0; i < input_copy.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(
+          read_u32(layout.relative_offset_pos + i * sizeof(uint32_t)),
+          input_copy.relative_offset_index[i]);
+        BOOST_REQUIRE_EQUAL(
+          read_u32(layout.relative_time_pos + i * sizeof(uint32_t)),
+          input_copy.relative_time_index[i]);
+        BOOST_REQUIRE_EQUAL(
+          read_u64(layout.position_pos + i * sizeof(uint64_t)),
+          input_copy.position_index[i]);
+    }
+}
+
+// the recovery checkpoint survives a round trip and is absent in v5 files
+BOOST_AUTO_TEST_CASE(serde_checkpoint) {
+    auto input = make_random_index_state();
+    input.checkpoint_offset = model::offset(
+      random_generators::get_int<int64_t>());
+    input.checkpoint_file_pos = random_generators::get_int<uint64_t>(1, 1_GiB);
+    const auto input_copy = input.copy();
+    auto buf = serde::to_iobuf(std::move(input));
+    auto output = serde::from_iobuf<storage::index_state>(buf.copy());
+    BOOST_REQUIRE_EQUAL(output, input_copy);
+    BOOST_REQUIRE(output.has_checkpoint());
+
+    // a v5 file is the same encoding without the trailing checkpoint
+    auto v5 = make_random_index_state();
+    const auto v5_copy = v5.copy();
+    auto bytes = iobuf_to_bytes(serde::to_iobuf(std::move(v5)));
+    constexpr size_t checkpoint_size = sizeof(model::offset::type)
+                                       + sizeof(uint64_t);
+    bytes.resize(bytes.size() - checkpoint_size);
+    bytes[0] = 5;
+    auto size = ss::read_le<serde::serde_size_t>(
+      reinterpret_cast<const char*>(bytes.data() + 2));
+    ss::write_le<serde::serde_size_t>(
+      reinterpret_cast<char*>(bytes.data() + 2), size - checkpoint_size);
+    auto decoded = serde::from_iobuf<storage::index_state>(
+      bytes_to_iobuf(bytes));
+    BOOST_REQUIRE_EQUAL(decoded, v5_copy);
+    BOOST_REQUIRE(!decoded.has_checkpoint());
+}
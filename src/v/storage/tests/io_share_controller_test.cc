@@ -0,0 +1,68 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "config/property.h"
+#include "storage/io_share_controller.h"
+
+#include <seastar/core/io_priority_class.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+using namespace std::chrono_literals; // NOLINT
+
+using latency_class = storage::io_share_controller::latency_class;
+
+static storage::io_share_controller make_controller(bool enabled) {
+    return storage::io_share_controller(
+      config::mock_binding<bool>(std::move(enabled)),
+      config::mock_binding<std::chrono::milliseconds>(10ms),
+      config::mock_binding<std::chrono::milliseconds>(20ms),
+      config::mock_binding<std::chrono::milliseconds>(1h));
+}
+
+SEASTAR_THREAD_TEST_CASE(shares_follow_foreground_latency) {
+    auto ctrl = make_controller(true);
+    ctrl.add_background_class(
+      "recovery", ss::io_priority_class::register_one("test-recovery", 160));
+    BOOST_REQUIRE_EQUAL(ctrl.shares("recovery").value(), 160);
+    BOOST_REQUIRE(!ctrl.shares("missing").has_value());
+
+    // slow produce halves the shares down to the floor
+    ctrl.record_latency(latency_class::produce, 100ms);
+    ctrl.update().get();
+    BOOST_REQUIRE_EQUAL(ctrl.shares("recovery").value(), 80);
+    for (int i = 0; i < 10; ++i) {
+        ctrl.record_latency(latency_class::produce, 100ms);
+        ctrl.update().get();
+    }
+    BOOST_REQUIRE_EQUAL(ctrl.shares("recovery").value(), 10);
+
+    // fetches have their own target
+    ctrl.record_latency(latency_class::fetch, 15ms);
+    ctrl.update().get();
+    BOOST_REQUIRE_EQUAL(ctrl.shares("recovery").value(), 26);
+    ctrl.record_latency(latency_class::fetch, 30ms);
+    ctrl.update().get();
+    BOOST_REQUIRE_EQUAL(ctrl.shares("recovery").value(), 13);
+
+    // without pressure the shares grow back to the registered ones
+    for (int i = 0; i < 20; ++i) {
+        ctrl.update().get();
+    }
+    BOOST_REQUIRE_EQUAL(ctrl.shares("recovery").value(), 160);
+}
+
+SEASTAR_THREAD_TEST_CASE(disabled_controller_keeps_shares) {
+    auto ctrl = make_controller(false);
+    ctrl.add_background_class(
+      "recovery",
+      ss::io_priority_class::register_one("test-recovery-disabled", 100));
+    ctrl.record_latency(latency_class::produce, 1s);
+    ctrl.update().get();
+    BOOST_REQUIRE_EQUAL(ctrl.shares("recovery").value(), 100);
+}
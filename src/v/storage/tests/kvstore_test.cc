@@ -90,6 +90,10 @@ SEASTAR_THREAD_TEST_CASE(key_space) {
 
     kvs->stop().get();
 
+    // consensus keys are stored in a log of their own
+    BOOST_REQUIRE(ss::file_exists(dir + "/redpanda/kvstore").get());
+    BOOST_REQUIRE(ss::file_exists(dir + "/redpanda/kvstore_consensus").get());
+
     // still all true after recovery
     kvs = std::make_unique<storage::kvstore>(conf, resources);
     kvs->start().get();
@@ -233,3 +237,55 @@ SEASTAR_THREAD_TEST_CASE(kvstore) {
 
     cleanup_store(dir).get();
 }
+
+SEASTAR_THREAD_TEST_CASE(kvstore_coalesced_writes) {
+    set_configuration("disable_metrics", true);
+
+    auto dir = ssx::sformat(
+      "kvstore_test_{}", random_generators::get_int(4000));
+
+    auto conf = prepare_store(dir).get();
+
+    storage::storage_resources resources;
+    auto kvs = std::make_unique<storage::kvstore>(conf, resources);
+    kvs->start().get();
+
+    // writes queued within a single flush window, every key is written many
+    // times and some of them end with a removal
+    std::unordered_map<bytes, std::optional<iobuf>> truth;
+    std::vector<ss::future<>> writes;
+    for (int i = 0; i < 200; i++) {
+        auto key = bytes(1, static_cast<uint8_t>(i % 7));
+        if (i % 11 == 0) {
+            truth[key] = std::nullopt;
+            writes.push_back(
+              kvs->remove(storage::kvstore::key_space::testing, key));
+        } else {
+            auto value = bytes_to_iobuf(random_generators::get_bytes(100));
+            truth[key] = value.copy();
+            writes.push_back(kvs->put(
+              storage::kvstore::key_space::testing, key, std::move(value)));
+        }
+    }
+    ss::when_all_succeed(writes.begin(), writes.end()).get();
+
+    auto verify = [&truth](storage::kvstore& kvs) {
+        for (auto& [key, value] : truth) {
+            auto v = kvs.get(storage::kvstore::key_space::testing, key);
+            BOOST_REQUIRE_EQUAL(v.has_value(), value.has_value());
+            if (value) {
+                BOOST_REQUIRE(*v == *value);
+            }
+        }
+    };
+    verify(*kvs);
+    kvs->stop().get();
+
+    // the latest write of every key survives a restart
+    kvs = std::make_unique<storage::kvstore>(conf, resources);
+    kvs->start().get();
+    verify(*kvs);
+    kvs->stop().get();
+
+    cleanup_store(dir).get();
+}
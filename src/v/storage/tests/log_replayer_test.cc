@@ -201,3 +201,41 @@ SEASTAR_THREAD_TEST_CASE(test_reset_index) {
     storage::stlog.info("Recovered segment:{}", ctx._seg);
     BOOST_CHECK(ctx._seg->index().needs_persistence());
 }
+
+SEASTAR_THREAD_TEST_CASE(test_recover_from_checkpoint) {
+    log_replayer_fixture ctx;
+    auto batches = model::test::make_random_batches(model::offset(1), 10);
+    auto last_offset = batches.back().last_offset();
+    // corrupted before the checkpoint, the recovery never reads it again
+    batches.front().header().crc = 10;
+    ctx.initialize(batches.begin()->base_offset());
+    auto append = [&ctx](model::record_batch& b) {
+        b.header().header_crc = model::internal_header_only_crc(b.header());
+        b.header().ctx.owner_shard = ss::this_shard_id();
+        ctx._seg->append(b).get();
+    };
+    for (size_t i = 0; i < 5; ++i) {
+        append(batches[i]);
+    }
+    ctx._seg->flush().get();
+    auto checkpoint = ctx._seg->index().make_checkpoint();
+    BOOST_REQUIRE(checkpoint.has_checkpoint());
+    BOOST_REQUIRE_EQUAL(checkpoint.checkpoint_offset, batches[4].last_offset());
+    ctx._seg->index().write_checkpoint(std::move(checkpoint)).get();
+    for (size_t i = 5; i < batches.size(); ++i) {
+        append(batches[i]);
+    }
+    ctx._seg->flush().get();
+    ctx._seg->reader().set_file_size(ctx._seg->appender().file_byte_offset());
+
+    // as after a restart, the index is loaded from the checkpoint
+    BOOST_REQUIRE(ctx._seg->index().materialize_index().get0());
+    BOOST_REQUIRE(ctx._seg->index().has_checkpoint());
+    auto recovered = ctx.replayer().recover_in_thread(
+      ss::default_priority_class());
+    BOOST_CHECK(bool(recovered));
+    BOOST_CHECK_EQUAL(recovered.last_offset.value(), last_offset);
+    BOOST_CHECK_EQUAL(ctx._seg->index().max_offset(), last_offset);
+    BOOST_CHECK(!ctx._seg->index().has_checkpoint());
+    BOOST_CHECK(ctx._seg->index().needs_persistence());
+}
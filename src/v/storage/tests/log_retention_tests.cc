@@ -7,10 +7,13 @@
 // the Business Source License, use of this software will be governed
 // by the Apache License, Version 2.0
 
+#include "config/configuration.h"
 #include "storage/tests/utils/disk_log_builder.h"
 // fixture
 #include "test_utils/fixture.h"
 
+#include <seastar/util/defer.hh>
+
 #include <optional>
 
 struct gc_fixture {
@@ -80,6 +83,67 @@ FIXTURE_TEST(retention_test_size, gc_fixture) {
     BOOST_CHECK_EQUAL(builder.get_log().segment_count(), 1);
 }
 
+FIXTURE_TEST(housekeeping_skips_logs_within_retention, gc_fixture) {
+    builder | storage::start() | storage::add_segment(0)
+      | storage::add_random_batch(0, 100, storage::maybe_compress_batches::yes)
+      | storage::add_segment(100) | storage::add_random_batches(100, 3);
+    ss::abort_source as;
+    auto cfg = [&as](model::timestamp t, std::optional<size_t> max_bytes) {
+        return storage::compaction_config(
+          t, max_bytes, ss::default_priority_class(), as);
+    };
+    auto& log = builder.get_log();
+    const auto size = builder.get_disk_log_impl().get_probe().partition_size();
+
+    BOOST_TEST_MESSAGE("Nothing to collect within time and size retention");
+    BOOST_CHECK(
+      !log.needs_housekeeping(cfg(model::timestamp(1), std::nullopt)));
+    BOOST_CHECK(!log.needs_housekeeping(cfg(model::timestamp(1), size)));
+
+    BOOST_TEST_MESSAGE("Size retention exceeded");
+    BOOST_CHECK(log.needs_housekeeping(cfg(model::timestamp(1), size - 1)));
+
+    BOOST_TEST_MESSAGE("Front segment behind time retention");
+    BOOST_CHECK(
+      log.needs_housekeeping(cfg(model::timestamp::now(), std::nullopt)));
+
+    builder | storage::stop();
+}
+
+FIXTURE_TEST(retention_local_target_of_archived_log, gc_fixture) {
+    storage::ntp_config::default_overrides overrides;
+    overrides.shadow_indexing_mode = model::shadow_indexing_mode::archival;
+    builder
+      | storage::start(storage::ntp_config(
+        storage::log_builder_ntp(),
+        builder.get_log_config().base_dir,
+        std::make_unique<storage::ntp_config::default_overrides>(overrides)))
+      | storage::add_segment(0)
+      | storage::add_random_batch(0, 100, storage::maybe_compress_batches::yes)
+      | storage::add_segment(100)
+      | storage::add_random_batch(100, 2, storage::maybe_compress_batches::yes)
+      | storage::add_segment(102) | storage::add_random_batches(102, 3);
+    auto& log = builder.get_log();
+    auto& target = config::shard_local_cfg().get(
+      "retention_local_target_bytes");
+    target.set_value(std::make_optional<size_t>(0));
+    auto reset = ss::defer([&target] { target.reset(); });
+
+    BOOST_TEST_MESSAGE("Segments that are not uploaded are kept");
+    builder | storage::garbage_collect(model::timestamp(1), std::nullopt);
+    BOOST_CHECK_EQUAL(log.segment_count(), 3);
+
+    BOOST_TEST_MESSAGE("Uploaded segments are removed down to the target");
+    log.set_collectible_offset(model::offset(99));
+    builder | storage::garbage_collect(model::timestamp(1), std::nullopt);
+    BOOST_CHECK_EQUAL(log.segment_count(), 2);
+
+    log.set_collectible_offset(log.offsets().dirty_offset);
+    builder | storage::garbage_collect(model::timestamp(1), std::nullopt)
+      | storage::stop();
+    BOOST_CHECK_EQUAL(log.segment_count(), 1);
+}
+
 FIXTURE_TEST(retention_test_after_truncation, gc_fixture) {
     BOOST_TEST_MESSAGE("Should be safe to garbage collect after truncation");
     builder | storage::start() | storage::add_segment(0)
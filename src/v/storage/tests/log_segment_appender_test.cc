@@ -8,6 +8,7 @@
 // by the Apache License, Version 2.0
 
 #include "bytes/iobuf.h"
+#include "config/configuration.h"
 #include "random/generators.h"
 #include "seastarx.h"
 #include "storage/segment_appender.h"
@@ -284,3 +285,43 @@ SEASTAR_THREAD_TEST_CASE(test_fallocate_size) {
         run_test_fallocate_size(fallocate_size);
     }
 }
+
+SEASTAR_THREAD_TEST_CASE(test_coalesced_flushes) {
+    config::shard_local_cfg().get("storage_flush_coalescing").set_value(true);
+    storage::storage_resources resources(
+      config::mock_binding<size_t>(16_KiB));
+    std::vector<ss::file> files;
+    std::vector<segment_appender> appenders;
+    std::vector<iobuf> expected(4);
+    appenders.reserve(expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        files.push_back(
+          open_file(fmt::format("test_coalesced_flushes_{}.log", i)));
+        appenders.push_back(make_segment_appender(files.back(), resources));
+    }
+
+    for (size_t round = 0; round < 10; ++round) {
+        std::vector<ss::future<>> flushes;
+        for (size_t i = 0; i < appenders.size(); ++i) {
+            auto data = make_random_data(
+              random_generators::get_int<size_t>(1, 8_KiB));
+            expected[i].append(data.share(0, data.size_bytes()));
+            appenders[i].append(data).get();
+            // two flushes of the same appender in one round share the
+            // physical flush
+            flushes.push_back(appenders[i].flush());
+            flushes.push_back(appenders[i].flush());
+        }
+        ss::when_all_succeed(flushes.begin(), flushes.end()).get();
+    }
+
+    for (size_t i = 0; i < appenders.size(); ++i) {
+        auto in = make_file_input_stream(files[i], 0);
+        iobuf result = read_iobuf_exactly(in, expected[i].size_bytes()).get0();
+        BOOST_REQUIRE_EQUAL(result, expected[i]);
+        in.close().get();
+        appenders[i].close().get();
+    }
+    resources.get_flush_coordinator().stop().get();
+    config::shard_local_cfg().get("storage_flush_coalescing").set_value(false);
+}
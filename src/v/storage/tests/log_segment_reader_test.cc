@@ -7,6 +7,7 @@
 // the Business Source License, use of this software will be governed
 // by the Apache License, Version 2.0
 
+#include "config/configuration.h"
 #include "model/record.h"
 #include "model/record_batch_reader.h"
 #include "model/record_utils.h"
@@ -23,6 +24,7 @@
 #include "utils/file_sanitizer.h"
 
 #include <seastar/core/thread.hh>
+#include <seastar/util/defer.hh>
 #include <seastar/testing/thread_test_case.hh>
 
 using namespace storage; // NOLINT
@@ -291,3 +293,51 @@ SEASTAR_THREAD_TEST_CASE(test_does_not_read_past_max_offset) {
     b | stop();
     check_batches(res, batches);
 }
+
+SEASTAR_THREAD_TEST_CASE(test_idle_segment_files_are_bounded) {
+    config::shard_local_cfg()
+      .get("storage_idle_open_segment_files")
+      .set_value(size_t(1));
+    auto reset_cfg = ss::defer([] {
+        config::shard_local_cfg()
+          .get("storage_idle_open_segment_files")
+          .reset();
+    });
+
+    disk_log_builder b;
+    b | start() | add_segment(0) | add_random_batch(0, 1) | add_segment(1)
+      | add_random_batch(1, 1);
+    auto& first = b.get_log_segments().front()->reader();
+    auto& second = b.get_log_segments().back()->reader();
+
+    auto first_h = first.data_stream(0, ss::default_priority_class()).get();
+    auto second_h = second.data_stream(0, ss::default_priority_class()).get();
+    // files in use are not idle
+    BOOST_REQUIRE_EQUAL(segment_reader::idle_open_files(), 0);
+
+    // the file stays open after its last handle is closed
+    first_h.close().get();
+    BOOST_REQUIRE_EQUAL(segment_reader::idle_open_files(), 1);
+
+    // and is closed to make room for a more recently used one
+    second_h.close().get();
+    BOOST_REQUIRE_EQUAL(segment_reader::idle_open_files(), 1);
+
+    // a closed file is reopened on the next read
+    auto h = first.data_stream(0, ss::default_priority_class()).get();
+    auto buf = h.stream().read().get();
+    BOOST_REQUIRE(!buf.empty());
+    h.close().get();
+    BOOST_REQUIRE_EQUAL(segment_reader::idle_open_files(), 1);
+
+    config::shard_local_cfg()
+      .get("storage_idle_open_segment_files")
+      .set_value(size_t(0));
+    h = second.data_stream(0, ss::default_priority_class()).get();
+    BOOST_REQUIRE_EQUAL(segment_reader::idle_open_files(), 1);
+    h.close().get();
+    BOOST_REQUIRE_EQUAL(segment_reader::idle_open_files(), 1);
+
+    b | stop();
+    BOOST_REQUIRE_EQUAL(segment_reader::idle_open_files(), 0);
+}
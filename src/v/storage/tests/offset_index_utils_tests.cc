@@ -131,3 +131,96 @@ FIXTURE_TEST(bucket_truncate, offset_index_utils_fixture) {
         BOOST_REQUIRE_EQUAL(p->filepos, 458048);
     }
 }
+
+FIXTURE_TEST(released_index_lookup, offset_index_utils_fixture) {
+    // enough entries to span several pages of the on-disk offset array
+    for (uint32_t i = 0; i < 3000; ++i) {
+        model::offset o = _base_offset + model::offset(i * 2);
+        _idx->maybe_track(
+          modify_get(o, storage::segment_index::default_data_buffer_step),
+          i * 100);
+    }
+    // entries that are not persisted cannot be released
+    BOOST_REQUIRE(!_idx->release_resident_state());
+    _idx->flush().get();
+
+    std::vector<std::optional<storage::segment_index::entry>> expected;
+    for (uint32_t i = 0; i < 6002; ++i) {
+        expected.push_back(_idx->find_nearest(model::offset(i)));
+    }
+
+    BOOST_REQUIRE(_idx->release_resident_state());
+    BOOST_REQUIRE(!_idx->is_resident());
+    BOOST_REQUIRE_EQUAL(_idx->max_offset(), model::offset(5998));
+    for (uint32_t i = 0; i < expected.size(); ++i) {
+        auto e = _idx->find_nearest_async(model::offset(i)).get();
+        BOOST_REQUIRE(e && expected[i]);
+        BOOST_REQUIRE_EQUAL(e->offset, expected[i]->offset);
+        BOOST_REQUIRE_EQUAL(e->timestamp, expected[i]->timestamp);
+        BOOST_REQUIRE_EQUAL(e->filepos, expected[i]->filepos);
+    }
+
+    // truncation reloads the entries
+    _idx->truncate(model::offset(3000)).get();
+    BOOST_REQUIRE(_idx->is_resident());
+    index_entry_expect(2998, 149900);
+    {
+        auto p = _idx->find_nearest(model::offset(3001));
+        BOOST_REQUIRE(bool(p));
+        BOOST_REQUIRE_EQUAL(p->offset, model::offset(2998));
+    }
+}
+
+FIXTURE_TEST(timestamp_lookup, offset_index_utils_fixture) {
+    // batches of one record, one millisecond apart except for the third
+    // batch whose timestamp is ahead of the following ones
+    const std::vector<int64_t> timestamps = {1000, 1001, 1010, 1003, 1004};
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        auto hdr = modify_get(
+          model::offset(i), storage::segment_index::default_data_buffer_step);
+        hdr.first_timestamp = model::timestamp(timestamps[i]);
+        hdr.max_timestamp = model::timestamp(timestamps[i]);
+        _idx->maybe_track(hdr, i * 100);
+    }
+    auto expect = [this](int64_t ts, int64_t offset) {
+        auto e = _idx->find_nearest(model::timestamp(ts));
+        BOOST_REQUIRE(e.has_value());
+        BOOST_REQUIRE_EQUAL(e->offset, model::offset(offset));
+    };
+    // before the first batch
+    expect(10, 0);
+    expect(1000, 0);
+    // the scan starts at the batch before the first one at or after the
+    // timestamp
+    expect(1001, 0);
+    expect(1002, 1);
+    expect(1005, 1);
+    // after every batch the scan starts at the last one
+    expect(2000, 4);
+}
+
+FIXTURE_TEST(tiny_batches_density, offset_index_utils_fixture) {
+    // far below the byte step, entries are spaced by the batch count
+    const size_t batch_size = 100;
+    const auto max_batches = storage::index_density::default_max_batches;
+    const uint32_t batches = 10 * max_batches;
+    for (uint32_t i = 0; i < batches; ++i) {
+        _idx->maybe_track(
+          modify_get(model::offset(i), batch_size), i * batch_size);
+    }
+    _idx->flush().get();
+    auto data = _data.share_iobuf();
+    auto raw_idx = serde::from_iobuf<storage::index_state>(
+      data.share(0, data.size_bytes()));
+    BOOST_REQUIRE_EQUAL(raw_idx.size(), batches / max_batches);
+
+    // a lookup lands less than max_batches batches before its offset
+    for (uint32_t i = 0; i < batches; ++i) {
+        auto e = _idx->find_nearest(model::offset(i));
+        BOOST_REQUIRE(e);
+        BOOST_REQUIRE_LE(e->offset, model::offset(i));
+        auto scanned = static_cast<size_t>(i - e->offset());
+        BOOST_REQUIRE_LT(scanned, max_batches);
+        BOOST_REQUIRE_EQUAL(e->filepos, (i - scanned) * batch_size);
+    }
+}
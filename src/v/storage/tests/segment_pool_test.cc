@@ -0,0 +1,93 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "config/property.h"
+#include "random/generators.h"
+#include "ssx/sformat.h"
+#include "storage/segment_pool.h"
+#include "units.h"
+
+#include <seastar/core/file.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/util/file.hh>
+
+static std::filesystem::path make_test_dir() {
+    auto dir = std::filesystem::path(ssx::sformat(
+      "segment_pool_test_{}", random_generators::gen_alphanum_string(8)));
+    ss::recursive_touch_directory(dir.string()).get();
+    return dir;
+}
+
+/// Create a file of the given size
+static std::filesystem::path
+make_file(const std::filesystem::path& dir, std::string_view name, size_t size) {
+    auto path = dir / name;
+    auto f = ss::open_file_dma(
+               path.string(), ss::open_flags::rw | ss::open_flags::create)
+               .get();
+    f.truncate(size).get();
+    f.close().get();
+    return path;
+}
+
+SEASTAR_THREAD_TEST_CASE(segment_pool_disabled) {
+    auto dir = make_test_dir();
+    storage::segment_pool pool(config::mock_binding<size_t>(0));
+    pool.start(dir).get();
+
+    auto file = make_file(dir, "0-1-v1.log", 64_KiB);
+    BOOST_REQUIRE(!pool.recycle(file).get());
+    BOOST_REQUIRE(ss::file_exists(file.string()).get());
+    BOOST_REQUIRE(!pool.take(dir / "1-1-v1.log").get().has_value());
+    BOOST_REQUIRE(!ss::file_exists((dir / ".segment_pool").string()).get());
+
+    pool.stop().get();
+    ss::recursive_remove_directory(dir).get();
+}
+
+SEASTAR_THREAD_TEST_CASE(segment_pool_recycles_files) {
+    auto dir = make_test_dir();
+    storage::segment_pool pool(config::mock_binding<size_t>(2));
+    pool.start(dir).get();
+
+    // the pool takes files up to its capacity
+    auto a = make_file(dir, "0-1-v1.log", 64_KiB);
+    auto b = make_file(dir, "10-1-v1.log", 64_KiB);
+    auto c = make_file(dir, "20-1-v1.log", 64_KiB);
+    BOOST_REQUIRE(pool.recycle(a).get());
+    BOOST_REQUIRE(pool.recycle(b).get());
+    BOOST_REQUIRE(!pool.recycle(c).get());
+    BOOST_REQUIRE(!ss::file_exists(a.string()).get());
+    BOOST_REQUIRE(!ss::file_exists(b.string()).get());
+    BOOST_REQUIRE(ss::file_exists(c.string()).get());
+    BOOST_REQUIRE_EQUAL(pool.size(), 2);
+
+    // taken files are empty and keep their allocation
+    auto d = dir / "30-1-v1.log";
+    auto allocated = pool.take(d).get();
+    BOOST_REQUIRE(allocated.has_value());
+    BOOST_REQUIRE_GE(allocated.value(), 64_KiB);
+    BOOST_REQUIRE_EQUAL(ss::file_size(d.string()).get(), 0);
+    BOOST_REQUIRE_EQUAL(pool.size(), 1);
+    pool.stop().get();
+
+    // pooled files survive a restart
+    storage::segment_pool restarted(config::mock_binding<size_t>(2));
+    restarted.start(dir).get();
+    BOOST_REQUIRE_EQUAL(restarted.size(), 1);
+    BOOST_REQUIRE(restarted.recycle(c).get());
+    BOOST_REQUIRE_EQUAL(restarted.size(), 2);
+    BOOST_REQUIRE(restarted.take(dir / "40-1-v1.log").get().has_value());
+    BOOST_REQUIRE(restarted.take(dir / "50-1-v1.log").get().has_value());
+    BOOST_REQUIRE(!restarted.take(dir / "60-1-v1.log").get().has_value());
+    restarted.stop().get();
+
+    ss::recursive_remove_directory(dir).get();
+}
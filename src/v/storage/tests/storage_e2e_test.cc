@@ -8,6 +8,7 @@
 // by the Apache License, Version 2.0
 
 #include "bytes/bytes.h"
+#include "bytes/iobuf_parser.h"
 #include "config/mock_property.h"
 #include "model/fundamental.h"
 #include "model/record.h"
@@ -19,6 +20,7 @@
 #include "reflection/adl.h"
 #include "storage/batch_cache.h"
 #include "storage/log_manager.h"
+#include "storage/parser.h"
 #include "storage/record_batch_builder.h"
 #include "storage/segment_utils.h"
 #include "storage/tests/storage_test_fixture.h"
@@ -1154,6 +1156,43 @@ FIXTURE_TEST(check_max_segment_size, storage_test_fixture) {
     BOOST_REQUIRE_EQUAL(size3 - size2, 2);
 }
 
+FIXTURE_TEST(segment_roll_does_not_wait_for_readers, storage_test_fixture) {
+    auto cfg = default_log_config(test_dir);
+    cfg.stype = storage::log_config::storage_type::disk;
+    storage::log_manager mgr = make_log_manager(cfg);
+    auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get0(); });
+    auto ntp = model::ntp("default", "test", 0);
+    auto log
+      = mgr.manage(storage::ntp_config(ntp, mgr.config().base_dir)).get0();
+    auto disk_log = get_disk_log(log);
+    append_exactly(log, 10, 128).get0();
+    log.flush().get();
+    auto rolled = disk_log->segments().back();
+
+    // the reader holds the read lock of the segment
+    auto reader = log
+                    .make_reader(storage::log_reader_config(
+                      model::offset(0),
+                      model::offset(9),
+                      ss::default_priority_class()))
+                    .get0();
+    disk_log->force_roll(ss::default_priority_class()).get();
+    BOOST_REQUIRE(!rolled->has_appender());
+    auto released = rolled->wait_for_appender_release();
+    BOOST_REQUIRE(!released.available());
+
+    BOOST_TEST_MESSAGE("Appends go to the next segment meanwhile");
+    append_exactly(log, 10, 128).get0();
+    log.flush().get();
+    BOOST_REQUIRE_EQUAL(disk_log->segment_count(), 2);
+    BOOST_REQUIRE_EQUAL(log.offsets().committed_offset, model::offset(19));
+
+    BOOST_TEST_MESSAGE("The appender is released once the reader is done");
+    model::consume_reader_to_memory(std::move(reader), model::no_timeout)
+      .get();
+    released.get();
+}
+
 FIXTURE_TEST(partition_size_while_cleanup, storage_test_fixture) {
     auto cfg = default_log_config(test_dir);
     // make sure segments are small
@@ -1596,6 +1635,147 @@ FIXTURE_TEST(reader_reusability_test_parser_header, storage_test_fixture) {
     }
 }
 
+FIXTURE_TEST(reader_reusability_skip_forward, storage_test_fixture) {
+    auto cfg = default_log_config(test_dir);
+    cfg.stype = storage::log_config::storage_type::disk;
+    cfg.cache = storage::with_cache::no;
+    cfg.max_segment_size = config::mock_binding<size_t>(10_MiB);
+    storage::ntp_config::default_overrides overrides;
+    storage::log_manager mgr = make_log_manager(cfg);
+    auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get0(); });
+    auto ntp = model::ntp("default", "test", 0);
+    auto log = mgr
+                 .manage(storage::ntp_config(
+                   ntp,
+                   mgr.config().base_dir,
+                   std::make_unique<storage::ntp_config::default_overrides>(
+                     overrides)))
+                 .get0();
+    append_exactly(log, 50, 1_KiB).get0();
+    log.flush().get();
+
+    storage::log_reader_config reader_cfg(
+      model::offset(0),
+      model::model_limits<model::offset>::max(),
+      0,
+      4_KiB,
+      ss::default_priority_class(),
+      std::nullopt,
+      std::nullopt,
+      std::nullopt);
+
+    // leaves a reader positioned after the first few batches in the cache
+    model::offset next_to_read;
+    {
+        auto reader = log.make_reader(reader_cfg).get();
+        auto rec = model::consume_reader_to_memory(
+                     std::move(reader), model::no_timeout)
+                     .get();
+        BOOST_REQUIRE(!rec.empty());
+        next_to_read = rec.back().last_offset() + model::offset(1);
+    }
+
+    // a read a few batches ahead reuses it, skipping the batches in between
+    for (auto skip : {5, 10}) {
+        reader_cfg.start_offset = next_to_read + model::offset(skip);
+        auto reader = log.make_reader(reader_cfg).get();
+        auto rec = model::consume_reader_to_memory(
+                     std::move(reader), model::no_timeout)
+                     .get();
+        BOOST_REQUIRE(!rec.empty());
+        BOOST_REQUIRE_LE(rec.front().base_offset(), reader_cfg.start_offset);
+        BOOST_REQUIRE_GE(rec.front().last_offset(), reader_cfg.start_offset);
+        next_to_read = rec.back().last_offset() + model::offset(1);
+    }
+}
+
+FIXTURE_TEST(read_extent_indexes_batches, storage_test_fixture) {
+    auto cfg = default_log_config(test_dir);
+    cfg.stype = storage::log_config::storage_type::disk;
+    cfg.cache = storage::with_cache::no;
+    cfg.max_segment_size = config::mock_binding<size_t>(10_MiB);
+    storage::ntp_config::default_overrides overrides;
+    storage::log_manager mgr = make_log_manager(cfg);
+    auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get0(); });
+    auto ntp = model::ntp("default", "test", 0);
+    auto log = mgr
+                 .manage(storage::ntp_config(
+                   ntp,
+                   mgr.config().base_dir,
+                   std::make_unique<storage::ntp_config::default_overrides>(
+                     overrides)))
+                 .get0();
+    append_exactly(log, 100, 512).get0();
+    log.flush().get();
+
+    auto extent = log
+                    .read_extent(storage::extent_read_config{
+                      .start_offset = model::offset(10),
+                      .max_offset = model::offset(59),
+                      .max_bytes = 1_MiB,
+                      .prio = ss::default_priority_class(),
+                    })
+                    .get();
+    BOOST_REQUIRE(extent);
+    BOOST_REQUIRE_EQUAL(extent->base_offset, model::offset(10));
+    BOOST_REQUIRE_EQUAL(extent->last_offset, model::offset(59));
+    BOOST_REQUIRE_EQUAL(extent->headers.size(), 50);
+    BOOST_REQUIRE_EQUAL(extent->data.size_bytes(), 50 * 512);
+
+    // the index matches the headers found in the extent
+    iobuf_parser parser(std::move(extent->data));
+    for (const auto& hdr : extent->headers) {
+        auto parsed = storage::header_from_iobuf(
+          parser.share(model::packed_record_batch_header_size));
+        BOOST_REQUIRE_EQUAL(parsed.base_offset, hdr.base_offset);
+        BOOST_REQUIRE_EQUAL(parsed.size_bytes, hdr.size_bytes);
+        parser.skip(hdr.size_bytes - model::packed_record_batch_header_size);
+    }
+    BOOST_REQUIRE_EQUAL(parser.bytes_left(), 0);
+}
+
+FIXTURE_TEST(reclaim_space_removes_oldest_segments, storage_test_fixture) {
+    auto cfg = default_log_config(test_dir);
+    cfg.stype = storage::log_config::storage_type::disk;
+    cfg.max_segment_size = config::mock_binding<size_t>(1_KiB);
+    storage::log_manager mgr = make_log_manager(cfg);
+    auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get0(); });
+
+    auto manage = [&mgr](int partition) {
+        auto ntp = model::ntp("default", "test", partition);
+        return mgr.manage(storage::ntp_config(ntp, mgr.config().base_dir))
+          .get0();
+    };
+    auto older = manage(0);
+    append_exactly(older, 20, 512).get0();
+    older.flush().get();
+    // batches of the other log have later timestamps
+    ss::sleep(10ms).get();
+    auto newer = manage(1);
+    append_exactly(newer, 20, 512).get0();
+    newer.flush().get();
+    auto older_segments = older.segment_count();
+    auto newer_segments = newer.segment_count();
+    BOOST_REQUIRE_GT(older_segments, 2);
+    BOOST_REQUIRE_GT(newer_segments, 2);
+
+    BOOST_TEST_MESSAGE("Nothing is removed above the collectible offset");
+    BOOST_REQUIRE_EQUAL(mgr.reclaim_space(1).get0(), 0);
+    BOOST_REQUIRE_EQUAL(older.segment_count(), older_segments);
+
+    BOOST_TEST_MESSAGE("Oldest data is removed first");
+    older.set_collectible_offset(older.offsets().dirty_offset);
+    newer.set_collectible_offset(newer.offsets().dirty_offset);
+    BOOST_REQUIRE_GT(mgr.reclaim_space(1).get0(), 0);
+    BOOST_REQUIRE_EQUAL(older.segment_count(), older_segments - 1);
+    BOOST_REQUIRE_EQUAL(newer.segment_count(), newer_segments);
+
+    BOOST_TEST_MESSAGE("Active segments are kept");
+    mgr.reclaim_space(std::numeric_limits<size_t>::max()).get0();
+    BOOST_REQUIRE_EQUAL(older.segment_count(), 1);
+    BOOST_REQUIRE_EQUAL(newer.segment_count(), 1);
+}
+
 FIXTURE_TEST(compaction_backlog_calculation, storage_test_fixture) {
     auto cfg = default_log_config(test_dir);
     cfg.max_compacted_segment_size = config::mock_binding<size_t>(100_MiB);
@@ -2083,6 +2263,65 @@ FIXTURE_TEST(test_querying_term_last_offset, storage_test_fixture) {
     BOOST_REQUIRE(!log.get_term_last_offset(model::term_id(0)).has_value());
 }
 
+FIXTURE_TEST(test_term_last_offset_after_truncation, storage_test_fixture) {
+    auto cfg = default_log_config(test_dir);
+    storage::ntp_config::default_overrides overrides;
+    storage::log_manager mgr = make_log_manager(cfg);
+
+    auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get0(); });
+    auto ntp = model::ntp("default", "test", 0);
+    auto log = mgr
+                 .manage(storage::ntp_config(
+                   ntp,
+                   mgr.config().base_dir,
+                   std::make_unique<storage::ntp_config::default_overrides>(
+                     overrides)))
+                 .get0();
+    auto disk_log = get_disk_log(log);
+    // two segments for each of the terms 1 and 2, then term 4
+    std::vector<model::offset> segment_ends;
+    for (auto t : {1, 1, 2, 2, 4}) {
+        if (!segment_ends.empty()) {
+            disk_log->force_roll(ss::default_priority_class()).get();
+        }
+        append_random_batches(log, 5, model::term_id(t));
+        segment_ends.push_back(log.offsets().dirty_offset);
+    }
+    BOOST_REQUIRE_EQUAL(
+      log.get_term_last_offset(model::term_id(1)).value(), segment_ends[1]);
+    BOOST_REQUIRE_EQUAL(
+      log.get_term_last_offset(model::term_id(2)).value(), segment_ends[3]);
+    BOOST_REQUIRE(!log.get_term_last_offset(model::term_id(3)).has_value());
+    BOOST_REQUIRE_EQUAL(
+      log.get_term_last_offset(model::term_id(4)).value(), segment_ends[4]);
+
+    // dropping the last segment of term 2 keeps the rest of it
+    log
+      .truncate(storage::truncate_config(
+        segment_ends[2] + model::offset(1), ss::default_priority_class()))
+      .get();
+    BOOST_REQUIRE(!log.get_term_last_offset(model::term_id(4)).has_value());
+    BOOST_REQUIRE_EQUAL(
+      log.get_term_last_offset(model::term_id(2)).value(), segment_ends[2]);
+    BOOST_REQUIRE_EQUAL(
+      log.get_term_last_offset(model::term_id(1)).value(), segment_ends[1]);
+
+    append_random_batches(log, 5, model::term_id(5));
+    BOOST_REQUIRE_EQUAL(
+      log.get_term_last_offset(model::term_id(5)).value(),
+      log.offsets().dirty_offset);
+    BOOST_REQUIRE_EQUAL(
+      log.get_term_last_offset(model::term_id(2)).value(), segment_ends[2]);
+
+    log
+      .truncate_prefix(storage::truncate_prefix_config(
+        segment_ends[1] + model::offset(1), ss::default_priority_class()))
+      .get();
+    BOOST_REQUIRE(!log.get_term_last_offset(model::term_id(1)).has_value());
+    BOOST_REQUIRE_EQUAL(
+      log.get_term_last_offset(model::term_id(2)).value(), segment_ends[2]);
+}
+
 void write_batch(
   storage::log log,
   ss::sstring key,
@@ -2188,6 +2427,263 @@ FIXTURE_TEST(test_compacting_batches_of_different_types, storage_test_fixture) {
     BOOST_REQUIRE(before_compaction == after_compaction);
 }
 
+FIXTURE_TEST(segment_window_compaction, storage_test_fixture) {
+    auto cfg = default_log_config(test_dir);
+    // do not merge adjacent segments, only the window compaction removes
+    // keys across segments
+    cfg.max_compacted_segment_size = config::mock_binding<size_t>(1);
+    cfg.stype = storage::log_config::storage_type::disk;
+    cfg.cache = storage::with_cache::no;
+    storage::ntp_config::default_overrides overrides;
+    overrides.cleanup_policy_bitflags
+      = model::cleanup_policy_bitflags::compaction;
+
+    ss::abort_source as;
+    storage::log_manager mgr = make_log_manager(cfg);
+    auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get0(); });
+    auto ntp = model::ntp("default", "test", 0);
+    auto log = mgr
+                 .manage(storage::ntp_config(
+                   ntp,
+                   mgr.config().base_dir,
+                   std::make_unique<storage::ntp_config::default_overrides>(
+                     overrides)))
+                 .get0();
+
+    auto disk_log = get_disk_log(log);
+    // segments with keys 0-9, 0-4 and 0-2, followed by an active segment
+    int value = 0;
+    for (int keys : {10, 5, 3}) {
+        for (int i = 0; i < keys; ++i) {
+            write_batch(
+              log,
+              ssx::sformat("key_{}", i),
+              value++,
+              model::record_batch_type::raft_data);
+        }
+        disk_log->force_roll(ss::default_priority_class()).get();
+    }
+    write_batch(log, "other", value++, model::record_batch_type::raft_data);
+    log.flush().get0();
+    BOOST_REQUIRE_EQUAL(disk_log->segment_count(), 4);
+
+    auto count_records = [&log] {
+        auto rdr = log
+                     .make_reader(storage::log_reader_config(
+                       model::offset(0),
+                       model::offset::max(),
+                       ss::default_priority_class()))
+                     .get();
+        auto batches = model::consume_reader_to_memory(
+                         std::move(rdr), model::no_timeout)
+                         .get();
+        size_t cnt = 0;
+        for (auto& b : batches) {
+            cnt += b.record_count();
+        }
+        return cnt;
+    };
+    BOOST_REQUIRE_EQUAL(count_records(), 19);
+    auto before_compaction = compact_in_memory(log);
+
+    storage::compaction_config c_cfg(
+      model::timestamp::min(), std::nullopt, ss::default_priority_class(), as);
+    // self compaction of the closed segments, one segment at a time
+    for (int i = 0; i < 3; ++i) {
+        log.compact(c_cfg).get0();
+    }
+    BOOST_REQUIRE_EQUAL(count_records(), 19);
+
+    // every key is now stored once
+    log.compact(c_cfg).get0();
+    BOOST_REQUIRE_EQUAL(disk_log->segment_count(), 4);
+    BOOST_REQUIRE_EQUAL(count_records(), 11);
+    BOOST_REQUIRE(before_compaction == compact_in_memory(log));
+
+    // nothing changed since the last window
+    log.compact(c_cfg).get0();
+    BOOST_REQUIRE_EQUAL(count_records(), 11);
+}
+
+namespace {
+struct aborted_tx_stm : storage::snapshotable_stm {
+    ss::future<> ensure_snapshot_exists(model::offset) final {
+        return ss::now();
+    }
+    void make_snapshot_in_background() final {}
+    model::offset max_collectible_offset() final {
+        return model::offset::max();
+    }
+    ss::future<std::vector<storage::aborted_tx_range>>
+    aborted_tx_ranges(model::offset, model::offset) final {
+        return ss::make_ready_future<std::vector<storage::aborted_tx_range>>(
+          aborted);
+    }
+
+    std::vector<storage::aborted_tx_range> aborted;
+};
+
+void write_kv(
+  storage::log log,
+  ss::sstring key,
+  std::optional<int> value,
+  std::optional<model::producer_identity> pid = std::nullopt) {
+    storage::record_batch_builder builder(
+      model::record_batch_type::raft_data, model::offset(0));
+    if (pid) {
+        builder.set_producer_identity(pid->id, pid->epoch);
+        builder.set_transactional_type();
+    }
+    std::optional<iobuf> v;
+    if (value) {
+        v = serde::to_iobuf(*value);
+    }
+    builder.add_raw_kv(serde::to_iobuf(std::move(key)), std::move(v));
+    auto batch = std::move(builder).build();
+    batch.set_term(model::term_id(0));
+    auto reader = model::make_memory_record_batch_reader({std::move(batch)});
+    storage::log_append_config cfg{
+      .should_fsync = storage::log_append_config::fsync::no,
+      .io_priority = ss::default_priority_class(),
+      .timeout = model::no_timeout,
+    };
+    std::move(reader).for_each_ref(log.make_appender(cfg), cfg.timeout).get0();
+}
+
+/// All records of the log in offset order, nullopt value for tombstones
+std::vector<std::pair<ss::sstring, std::optional<int>>>
+read_kvs(storage::log log) {
+    auto rdr = log
+                 .make_reader(storage::log_reader_config(
+                   model::offset(0),
+                   model::offset::max(),
+                   ss::default_priority_class()))
+                 .get();
+    auto batches = model::consume_reader_to_memory(
+                     std::move(rdr), model::no_timeout)
+                     .get();
+    std::vector<std::pair<ss::sstring, std::optional<int>>> ret;
+    for (auto& b : batches) {
+        b.for_each_record([&ret](model::record r) {
+            std::optional<int> v;
+            if (r.has_value()) {
+                v = serde::from_iobuf<int>(r.value().copy());
+            }
+            ret.emplace_back(
+              serde::from_iobuf<ss::sstring>(r.key().copy()), v);
+        });
+    }
+    return ret;
+}
+} // namespace
+
+FIXTURE_TEST(compaction_removes_aborted_transactions, storage_test_fixture) {
+    auto cfg = default_log_config(test_dir);
+    cfg.max_compacted_segment_size = config::mock_binding<size_t>(1);
+    cfg.stype = storage::log_config::storage_type::disk;
+    cfg.cache = storage::with_cache::no;
+    storage::ntp_config::default_overrides overrides;
+    overrides.cleanup_policy_bitflags
+      = model::cleanup_policy_bitflags::compaction;
+
+    ss::abort_source as;
+    storage::log_manager mgr = make_log_manager(cfg);
+    auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get0(); });
+    auto ntp = model::ntp("default", "test", 0);
+    auto log = mgr
+                 .manage(storage::ntp_config(
+                   ntp,
+                   mgr.config().base_dir,
+                   std::make_unique<storage::ntp_config::default_overrides>(
+                     overrides)))
+                 .get0();
+    auto stm = ss::make_shared<aborted_tx_stm>();
+    log.stm_manager()->add_stm(stm);
+
+    auto disk_log = get_disk_log(log);
+    const model::producer_identity aborted_pid(1, 0);
+    const model::producer_identity committed_pid(2, 0);
+    write_kv(log, "key_1", 1);
+    // the aborted transaction spans offsets 1-3, the records of the other
+    // producer in between are committed
+    write_kv(log, "key_1", 2, aborted_pid);
+    write_kv(log, "key_2", 3, committed_pid);
+    write_kv(log, "key_3", 4, aborted_pid);
+    write_kv(log, "key_2", 5);
+    disk_log->force_roll(ss::default_priority_class()).get();
+    write_kv(log, "other", 6);
+    log.flush().get0();
+    stm->aborted.push_back(storage::aborted_tx_range{
+      .pid = aborted_pid, .first = model::offset(1), .last = model::offset(3)});
+
+    storage::compaction_config c_cfg(
+      model::timestamp::min(), std::nullopt, ss::default_priority_class(), as);
+    log.compact(c_cfg).get0();
+
+    // the aborted value of key_1 doesn't supersede the committed one, the
+    // committed record in the span of the transaction is kept
+    using kvs_t = std::vector<std::pair<ss::sstring, std::optional<int>>>;
+    BOOST_REQUIRE(
+      read_kvs(log)
+      == kvs_t(
+        {{"key_1", 1}, {"key_2", 3}, {"key_2", 5}, {"other", 6}}));
+}
+
+FIXTURE_TEST(window_compaction_removes_tombstones, storage_test_fixture) {
+    auto cfg = default_log_config(test_dir);
+    cfg.max_compacted_segment_size = config::mock_binding<size_t>(1);
+    cfg.stype = storage::log_config::storage_type::disk;
+    cfg.cache = storage::with_cache::no;
+    storage::ntp_config::default_overrides overrides;
+    overrides.cleanup_policy_bitflags
+      = model::cleanup_policy_bitflags::compaction;
+
+    ss::abort_source as;
+    storage::log_manager mgr = make_log_manager(cfg);
+    auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get0(); });
+    auto ntp = model::ntp("default", "test", 0);
+    auto log = mgr
+                 .manage(storage::ntp_config(
+                   ntp,
+                   mgr.config().base_dir,
+                   std::make_unique<storage::ntp_config::default_overrides>(
+                     overrides)))
+                 .get0();
+
+    auto disk_log = get_disk_log(log);
+    write_kv(log, "key_1", 1);
+    write_kv(log, "key_2", std::nullopt);
+    write_kv(log, "key_3", 2);
+    disk_log->force_roll(ss::default_priority_class()).get();
+    write_kv(log, "key_1", 3);
+    write_kv(log, "key_4", std::nullopt);
+    disk_log->force_roll(ss::default_priority_class()).get();
+    write_kv(log, "other", 4);
+    log.flush().get0();
+
+    storage::compaction_config c_cfg(
+      model::timestamp::min(), std::nullopt, ss::default_priority_class(), as);
+    c_cfg.tombstone_eviction_time = model::timestamp(
+      model::timestamp::now().value() + 1000);
+    // self compaction keeps the tombstones
+    for (int i = 0; i < 2; ++i) {
+        log.compact(c_cfg).get0();
+    }
+    BOOST_REQUIRE_EQUAL(read_kvs(log).size(), 6);
+
+    // the first segment is rewritten without the superseded key_1 and the
+    // tombstone, the second one has nothing superseded and is kept
+    log.compact(c_cfg).get0();
+    using kvs_t = std::vector<std::pair<ss::sstring, std::optional<int>>>;
+    BOOST_REQUIRE(
+      read_kvs(log)
+      == kvs_t(
+        {{"key_3", 2},
+         {"key_1", 3},
+         {"key_4", std::nullopt},
+         {"other", 4}}));
+}
+
 FIXTURE_TEST(read_write_truncate, storage_test_fixture) {
     /**
      * Test validating concurrent reads, writes and truncations
@@ -2552,3 +3048,170 @@ FIXTURE_TEST(compaction_truncation_corner_cases, storage_test_fixture) {
         BOOST_REQUIRE_EQUAL(log.offsets().dirty_offset, model::offset(10));
     }
 }
+
+FIXTURE_TEST(topic_disk_usage_accounting, storage_test_fixture) {
+    auto cfg = default_log_config(test_dir);
+    cfg.max_segment_size = config::mock_binding<size_t>(10_KiB);
+    storage::log_manager mgr = make_log_manager(std::move(cfg));
+    auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get(); });
+    model::topic_namespace tp_ns(model::ns("default"), model::topic("test"));
+
+    std::vector<storage::log> logs;
+    for (auto p = 0; p < 3; ++p) {
+        model::ntp ntp(tp_ns.ns, tp_ns.tp, model::partition_id(p));
+        logs.push_back(
+          mgr.manage(storage::ntp_config(ntp, mgr.config().base_dir)).get());
+    }
+    auto expected_bytes = [&logs] {
+        return std::accumulate(
+          logs.begin(), logs.end(), size_t(0), [](size_t acc, auto& l) {
+              return acc + l.size_bytes();
+          });
+    };
+
+    auto usage = mgr.topic_usage(tp_ns);
+    BOOST_REQUIRE_EQUAL(usage.partitions, 3);
+    BOOST_REQUIRE_EQUAL(usage.bytes, 0);
+
+    // appends that roll segments
+    for (auto& l : logs) {
+        append_random_batches(l, 20);
+        l.flush().get();
+    }
+    usage = mgr.topic_usage(tp_ns);
+    BOOST_REQUIRE_GT(usage.bytes, 0);
+    BOOST_REQUIRE_EQUAL(usage.bytes, expected_bytes());
+
+    // suffix truncation
+    logs[0]
+      .truncate(storage::truncate_config(
+        model::offset(logs[0].offsets().dirty_offset() / 2),
+        ss::default_priority_class()))
+      .get();
+    BOOST_REQUIRE_EQUAL(mgr.topic_usage(tp_ns).bytes, expected_bytes());
+
+    // removing a partition drops its bytes
+    auto removed = logs.back().config().ntp();
+    logs.pop_back();
+    mgr.remove(removed).get();
+    usage = mgr.topic_usage(tp_ns);
+    BOOST_REQUIRE_EQUAL(usage.partitions, 2);
+    BOOST_REQUIRE_EQUAL(usage.bytes, expected_bytes());
+
+    // the topic is forgotten once none of its logs is open
+    for (auto& l : logs) {
+        auto ntp = l.config().ntp();
+        mgr.shutdown(ntp).get();
+    }
+    logs.clear();
+    usage = mgr.topic_usage(tp_ns);
+    BOOST_REQUIRE_EQUAL(usage.partitions, 0);
+    BOOST_REQUIRE_EQUAL(usage.bytes, 0);
+}
+
+namespace {
+void append_kv(
+  storage::log& log,
+  std::string_view key,
+  std::optional<std::string_view> value) {
+    storage::record_batch_builder builder(
+      model::record_batch_type::raft_data, model::offset(0));
+    std::optional<iobuf> v;
+    if (value) {
+        v = bytes_to_iobuf(bytes(value->begin(), value->end()));
+    }
+    builder.add_raw_kv(
+      bytes_to_iobuf(bytes(key.begin(), key.end())), std::move(v));
+    auto rdr = model::make_memory_record_batch_reader(
+      std::move(builder).build());
+    storage::log_append_config cfg{
+      .should_fsync = storage::log_append_config::fsync::no,
+      .io_priority = ss::default_priority_class(),
+      .timeout = model::no_timeout};
+    std::move(rdr).for_each_ref(log.make_appender(cfg), cfg.timeout).get();
+}
+
+std::optional<storage::key_lookup_result> lookup(
+  storage::log& log,
+  std::string_view key,
+  model::offset max_offset = model::offset::max()) {
+    return log
+      .key_lookup(storage::key_lookup_config{
+        .key = bytes(key.begin(), key.end()),
+        .max_offset = max_offset,
+        .prio = ss::default_priority_class()})
+      .get0();
+}
+} // namespace
+
+FIXTURE_TEST(test_key_lookup, storage_test_fixture) {
+    auto cfg = default_log_config(test_dir);
+    cfg.stype = storage::log_config::storage_type::disk;
+    storage::log_manager mgr = make_log_manager(cfg);
+    auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get0(); });
+    auto ntp = model::ntp("default", "test", 0);
+    using overrides_t = storage::ntp_config::default_overrides;
+    overrides_t ov;
+    ov.cleanup_policy_bitflags = model::cleanup_policy_bitflags::compaction;
+    storage::ntp_config ntp_cfg(
+      ntp, mgr.config().base_dir, std::make_unique<overrides_t>(ov));
+    auto log = mgr.manage(std::move(ntp_cfg)).get0();
+    auto disk_log = get_disk_log(log);
+
+    // {segment #1: [0,a:1][1,b:1][2,a:2]}
+    append_kv(log, "a", "1");
+    append_kv(log, "b", "1");
+    append_kv(log, "a", "2");
+    disk_log->force_roll(ss::default_priority_class()).get0();
+    // {segment #2: [3,c:1][4,b:tombstone]}
+    append_kv(log, "c", "1");
+    append_kv(log, "b", std::nullopt);
+    disk_log->force_roll(ss::default_priority_class()).get0();
+    // {segment #3 (active): [5,c:2]}
+    append_kv(log, "c", "2");
+
+    // served by the compaction index of the first segment
+    auto res = lookup(log, "a");
+    BOOST_REQUIRE(res);
+    BOOST_REQUIRE_EQUAL(res->offset, model::offset(2));
+    BOOST_REQUIRE(res->value == bytes_to_iobuf(bytes("2")));
+
+    // the latest record of a key is a tombstone
+    res = lookup(log, "b");
+    BOOST_REQUIRE(res);
+    BOOST_REQUIRE_EQUAL(res->offset, model::offset(4));
+    BOOST_REQUIRE(!res->value);
+
+    // served by the active segment
+    res = lookup(log, "c");
+    BOOST_REQUIRE(res);
+    BOOST_REQUIRE_EQUAL(res->offset, model::offset(5));
+    BOOST_REQUIRE(res->value == bytes_to_iobuf(bytes("2")));
+
+    // records above the max offset are not visible
+    res = lookup(log, "c", model::offset(4));
+    BOOST_REQUIRE(res);
+    BOOST_REQUIRE_EQUAL(res->offset, model::offset(3));
+    res = lookup(log, "a", model::offset(1));
+    BOOST_REQUIRE(res);
+    BOOST_REQUIRE_EQUAL(res->offset, model::offset(0));
+
+    BOOST_REQUIRE(!lookup(log, "d"));
+
+    // the result is the same once the sealed segments are compacted
+    ss::abort_source as;
+    log
+      .compact(storage::compaction_config(
+        model::timestamp::min(),
+        std::nullopt,
+        ss::default_priority_class(),
+        as))
+      .get0();
+    res = lookup(log, "a");
+    BOOST_REQUIRE(res);
+    BOOST_REQUIRE_EQUAL(res->offset, model::offset(2));
+    BOOST_REQUIRE(res->value == bytes_to_iobuf(bytes("2")));
+    res = lookup(log, "c");
+    BOOST_REQUIRE(res);
+    BOOST_REQUIRE_EQUAL(res->offset, model::offset(5));
+}
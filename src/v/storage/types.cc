@@ -62,6 +62,37 @@ std::ostream& operator<<(std::ostream& o, const log_reader_config& cfg) {
     return o << "}";
 }
 
+std::ostream& operator<<(std::ostream& o, const extent_read_config& cfg) {
+    return o << "{start_offset:" << cfg.start_offset
+             << ", max_offset:" << cfg.max_offset
+             << ", max_bytes:" << cfg.max_bytes
+             << ", strict_max_bytes:" << cfg.strict_max_bytes
+             << ", type:" << cfg.type << "}";
+}
+
+std::ostream& operator<<(std::ostream& o, const extent_read_result& r) {
+    return o << "{term:" << r.term << ", base_offset:" << r.base_offset
+             << ", last_offset:" << r.last_offset
+             << ", batch_count:" << r.headers.size()
+             << ", record_count:" << r.record_count
+             << ", size_bytes:" << r.data.size_bytes() << "}";
+}
+
+std::ostream& operator<<(std::ostream& o, const key_lookup_config& cfg) {
+    return o << "{key_size:" << cfg.key.size()
+             << ", max_offset:" << cfg.max_offset << "}";
+}
+
+std::ostream& operator<<(std::ostream& o, const key_lookup_result& r) {
+    o << "{offset:" << r.offset << ", value_size:";
+    if (r.value) {
+        o << r.value->size_bytes();
+    } else {
+        o << "tombstone";
+    }
+    return o << "}";
+}
+
 std::ostream& operator<<(std::ostream& o, const append_result& a) {
     return o << "{append_time:"
              << std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -91,13 +122,15 @@ operator<<(std::ostream& o, const ntp_config::default_overrides& v) {
     fmt::print(
       o,
       "{{compaction_strategy: {}, cleanup_policy_bitflags: {}, segment_size: "
-      "{}, retention_bytes: {}, retention_time_ms: {}, recovery_enabled: {}}}",
+      "{}, retention_bytes: {}, retention_time_ms: {}, recovery_enabled: {}, "
+      "write_caching: {}}}",
       v.compaction_strategy,
       v.cleanup_policy_bitflags,
       v.segment_size,
       v.retention_bytes,
       v.retention_time,
-      v.recovery_enabled);
+      v.recovery_enabled,
+      v.write_caching);
 
     return o;
 }
@@ -153,10 +186,12 @@ std::ostream& operator<<(std::ostream& o, const offset_stats& s) {
 std::ostream& operator<<(std::ostream& o, const compaction_config& c) {
     fmt::print(
       o,
-      "{{evicition_time:{}, max_bytes:{}, should_sanitize:{}}}",
+      "{{evicition_time:{}, max_bytes:{}, should_sanitize:{}, "
+      "tombstone_eviction_time:{}}}",
       c.eviction_time,
       c.max_bytes.value_or(-1),
-      c.sanitize);
+      c.sanitize,
+      c.tombstone_eviction_time);
     return o;
 }
 
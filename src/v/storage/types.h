@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "bytes/bytes.h"
 #include "model/fundamental.h"
 #include "model/limits.h"
 #include "model/record.h"
@@ -20,6 +21,7 @@
 #include "tristate.h"
 
 #include <seastar/core/abort_source.hh>
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/file.hh> //io_priority
 #include <seastar/core/rwlock.hh>
 #include <seastar/util/bool_class.hh>
@@ -31,6 +33,39 @@ namespace storage {
 using log_clock = ss::lowres_clock;
 using debug_sanitize_files = ss::bool_class<struct debug_sanitize_files_tag>;
 
+/**
+ * Priority of a log recovery at startup. Logs whose raft group is likely to
+ * become leader are recovered first so that the node can serve traffic for
+ * them as soon as possible.
+ */
+enum class recovery_priority : int8_t { normal = 0, high = 1 };
+
+/**
+ * Reclaim priority of the cached batches of a log. Under memory pressure the
+ * batches of high priority logs, e.g. the controller or the consumer offsets,
+ * are only reclaimed once the batches of the regular logs are exhausted.
+ */
+enum class batch_cache_priority : int8_t { regular = 0, high = 1 };
+
+/**
+ * Owner of the batch cache indices of the segments of a log. Memory of the
+ * cached batches is accounted per owner.
+ */
+struct batch_cache_owner {
+    batch_cache_priority priority{batch_cache_priority::regular};
+    size_t bytes{0};
+};
+
+/**
+ * Disk usage of the logs of a topic on a shard. It is kept up to date by the
+ * probes of the logs as they are appended to, rolled, truncated, compacted
+ * and removed, so that reading it does not involve walking the segments.
+ */
+struct topic_disk_usage {
+    size_t bytes{0};
+    size_t partitions{0};
+};
+
 enum class disk_space_alert { ok = 0, low_space = 1, degraded = 2 };
 
 inline disk_space_alert max_severity(disk_space_alert a, disk_space_alert b) {
@@ -52,6 +87,15 @@ struct disk : serde::envelope<disk, serde::version<0>> {
 
 std::ostream& operator<<(std::ostream& o, const storage::disk_space_alert d);
 
+/// Log offsets of an aborted transaction
+struct aborted_tx_range {
+    model::producer_identity pid;
+    model::offset first;
+    model::offset last;
+
+    auto operator<=>(const aborted_tx_range&) const = default;
+};
+
 class snapshotable_stm {
 public:
     virtual ~snapshotable_stm() = default;
@@ -64,6 +108,12 @@ public:
     // lets the stm control snapshotting and log eviction by limiting
     // log eviction attempts to offsets not greater than this.
     virtual model::offset max_collectible_offset() = 0;
+    // transactions aborted in the log which intersect [first, last], lets
+    // compaction remove their data
+    virtual ss::future<std::vector<aborted_tx_range>>
+    aborted_tx_ranges(model::offset, model::offset) {
+        return ss::make_ready_future<std::vector<aborted_tx_range>>();
+    }
 };
 
 /**
@@ -119,6 +169,16 @@ public:
         return result;
     }
 
+    ss::future<std::vector<aborted_tx_range>>
+    aborted_tx_ranges(model::offset first, model::offset last) {
+        std::vector<aborted_tx_range> result;
+        for (auto stm : _stms) {
+            auto ranges = co_await stm->aborted_tx_ranges(first, last);
+            result.insert(result.end(), ranges.begin(), ranges.end());
+        }
+        co_return result;
+    }
+
 private:
     std::vector<ss::shared_ptr<snapshotable_stm>> _stms;
 };
@@ -304,6 +364,67 @@ struct log_reader_config {
     friend std::ostream& operator<<(std::ostream& o, const log_reader_config&);
 };
 
+/**
+ * Extent reads return whole record batches exactly as they are laid out in a
+ * segment file, without materializing them as model::record_batch and without
+ * going through the batch cache. The extent never spans more than a single
+ * segment and stops at the first batch whose type is different than `type`,
+ * so callers translating offsets may assume a constant offset delta across the
+ * whole extent.
+ *
+ * Start and max offset are inclusive.
+ */
+struct extent_read_config {
+    model::offset start_offset;
+    model::offset max_offset;
+    size_t max_bytes;
+    // do not return the first batch if it is larger than max_bytes
+    bool strict_max_bytes{false};
+    model::record_batch_type type{model::record_batch_type::raft_data};
+    ss::io_priority_class prio;
+
+    friend std::ostream& operator<<(std::ostream& o, const extent_read_config&);
+};
+
+struct extent_read_result {
+    // batches in the on-disk format, header included
+    iobuf data;
+    // term of the segment the extent was read from
+    model::term_id term;
+    model::offset base_offset;
+    model::offset last_offset;
+    size_t record_count{0};
+    // headers of the batches in data, in order. every batch takes
+    // header.size_bytes, so they index the extent without parsing it again
+    std::vector<model::record_batch_header> headers;
+
+    friend std::ostream& operator<<(std::ostream& o, const extent_read_result&);
+};
+
+/**
+ * Lookup of the latest record of a key in a compacted log, at or below
+ * max_offset. Sealed segments are looked up through their on-disk compaction
+ * index, which maps every key of the segment to the offset of its latest
+ * record, so only the segments that contain the key are read. The active
+ * segment and segments without a usable index are scanned.
+ */
+struct key_lookup_config {
+    bytes key;
+    model::offset max_offset;
+    ss::io_priority_class prio;
+    opt_abort_source_t abort_source;
+
+    friend std::ostream& operator<<(std::ostream& o, const key_lookup_config&);
+};
+
+struct key_lookup_result {
+    model::offset offset;
+    // std::nullopt when the latest record of the key is a tombstone
+    std::optional<iobuf> value;
+
+    friend std::ostream& operator<<(std::ostream& o, const key_lookup_result&);
+};
+
 struct compaction_config {
     explicit compaction_config(
       model::timestamp upper,
@@ -327,6 +448,10 @@ struct compaction_config {
     debug_sanitize_files sanitize;
     // abort source for compaction task
     ss::abort_source* asrc;
+    // state machines of the log, source of the aborted transactions
+    ss::lw_shared_ptr<stm_manager> stms;
+    // remove tombstones older than this if the whole log is compacted
+    std::optional<model::timestamp> tombstone_eviction_time;
 
     friend std::ostream& operator<<(std::ostream&, const compaction_config&);
 };
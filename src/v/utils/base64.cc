@@ -110,3 +110,25 @@ ss::sstring iobuf_to_base64(const iobuf& input) {
     output.resize(written);
     return output;
 }
+
+iobuf base64_to_iobuf(std::string_view input) {
+    // decoded straight into the fragment, rather than through bytes
+    ss::temporary_buffer<char> output(input.size());
+    size_t output_len; // NOLINT
+    int ret = base64_decode(
+      input.data(), input.size(), output.get_write(), &output_len, 0);
+    if (unlikely(!ret)) {
+        throw base64_decoder_exception();
+    }
+    vassert(
+      output_len <= input.size(),
+      "base64 decode overflow: {} > {}",
+      output_len,
+      input.size());
+    output.trim(output_len);
+    iobuf buf;
+    if (output_len > 0) {
+        buf.append(std::move(output));
+    }
+    return buf;
+}
@@ -31,3 +31,4 @@ ss::sstring base64_to_string(std::string_view);
 
 // base64 <-> iobuf
 ss::sstring iobuf_to_base64(const iobuf&);
+iobuf base64_to_iobuf(std::string_view);
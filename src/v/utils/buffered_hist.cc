@@ -0,0 +1,57 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "utils/buffered_hist.h"
+
+namespace buffered_hist_detail {
+
+handle shard_registry::acquire(
+  int64_t max_value, int64_t min, int32_t significant_figures) {
+    uint32_t idx = 0;
+    if (_free.empty()) {
+        idx = _slots.size();
+        _slots.emplace_back();
+    } else {
+        idx = _free.back();
+        _free.pop_back();
+    }
+    auto& s = _slots[idx];
+    s.hist = std::make_unique<hdr_hist>(max_value, min, significant_figures);
+    return handle{.slot = idx, .generation = s.generation};
+}
+
+void shard_registry::release(handle h) {
+    auto& s = _slots[h.slot];
+    s.hist.reset();
+    // pending values of the released histogram no longer match
+    if (++s.generation == 0) {
+        s.generation = 1;
+    }
+    _free.push_back(h.slot);
+}
+
+hdr_hist& shard_registry::get(handle h) {
+    flush();
+    return *_slots[h.slot].hist;
+}
+
+void shard_registry::flush() {
+    for (size_t i = 0; i < _size; ++i) {
+        const auto& p = _pending[i];
+        auto& s = _slots[p.h.slot];
+        if (s.generation == p.h.generation) {
+            s.hist->record(p.value);
+        }
+    }
+    _size = 0;
+}
+
+} // namespace buffered_hist_detail
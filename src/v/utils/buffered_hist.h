@@ -0,0 +1,201 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+#include "utils/hdr_hist.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/smp.hh>
+
+#include <boost/range/irange.hpp>
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace buffered_hist_detail {
+
+struct handle {
+    uint32_t slot{0};
+    // 0 for a handle that does not refer to a histogram
+    uint32_t generation{0};
+};
+
+/**
+ * Owns the histograms of the shard and the values recorded into them that
+ * are not inserted yet. A slot is reused once its histogram is released, the
+ * generation tells the values of the previous histogram apart.
+ */
+class shard_registry {
+public:
+    static constexpr size_t max_pending = 256;
+
+    static shard_registry& local() {
+        static thread_local shard_registry registry;
+        return registry;
+    }
+
+    handle acquire(int64_t max_value, int64_t min, int32_t significant_figures);
+    void release(handle);
+
+    void record(handle h, uint64_t value) {
+        _pending[_size++] = pending{.h = h, .value = value};
+        if (_size == _pending.size()) {
+            flush();
+        }
+    }
+
+    /// Inserts the pending values and returns the histogram
+    hdr_hist& get(handle);
+
+    void flush();
+
+private:
+    struct pending {
+        handle h;
+        uint64_t value;
+    };
+    struct slot {
+        std::unique_ptr<hdr_hist> hist;
+        uint32_t generation{1};
+    };
+
+    // stable addresses, histograms are handed out by reference
+    std::deque<slot> _slots;
+    std::vector<uint32_t> _free;
+    std::array<pending, max_pending> _pending;
+    size_t _size{0};
+};
+
+} // namespace buffered_hist_detail
+
+/**
+ * Latency histogram for always-on tracking on hot paths.
+ *
+ * Unlike hdr_hist::auto_measure(), a measurement is not allocated nor linked
+ * into the histogram. Recorded values are appended to a buffer of the shard
+ * and inserted into their histograms in batches, when the buffer is full or
+ * before any histogram of the shard is read. The histogram itself is owned by
+ * the shard, a measurement that outlives its buffered_hist is dropped on
+ * insertion instead of being detached.
+ *
+ * A buffered_hist and its measurements are only used on the shard that
+ * created them.
+ */
+class buffered_hist {
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    class measurement {
+    public:
+        explicit measurement(const buffered_hist& h) noexcept
+          : _h(h._h)
+          , _begin(clock_type::now()) {}
+        measurement(const measurement&) = delete;
+        measurement& operator=(const measurement&) = delete;
+        measurement(measurement&& o) noexcept
+          : _h(std::exchange(o._h, {}))
+          , _begin(o._begin)
+          , _trace(o._trace) {}
+        measurement& operator=(measurement&& o) noexcept {
+            if (this != &o) {
+                this->~measurement();
+                new (this) measurement(std::move(o));
+            }
+            return *this;
+        }
+        ~measurement() noexcept {
+            if (_h.generation != 0 && _trace) {
+                buffered_hist_detail::shard_registry::local().record(
+                  _h,
+                  std::chrono::duration_cast<std::chrono::microseconds>(
+                    clock_type::now() - _begin)
+                    .count());
+            }
+        }
+
+        void set_trace(bool b) { _trace = b; }
+
+    private:
+        buffered_hist_detail::handle _h;
+        clock_type::time_point _begin;
+        bool _trace{true};
+    };
+
+    explicit buffered_hist(
+      int64_t max_value = hdr_hist::us_per_hour,
+      int64_t min = 1,
+      int32_t significant_figures = 1)
+      : _h(buffered_hist_detail::shard_registry::local().acquire(
+        max_value, min, significant_figures)) {}
+    buffered_hist(buffered_hist&& o) noexcept
+      : _h(std::exchange(o._h, {})) {}
+    buffered_hist& operator=(buffered_hist&& o) noexcept {
+        if (this != &o) {
+            this->~buffered_hist();
+            new (this) buffered_hist(std::move(o));
+        }
+        return *this;
+    }
+    buffered_hist(const buffered_hist&) = delete;
+    buffered_hist& operator=(const buffered_hist&) = delete;
+    ~buffered_hist() noexcept {
+        if (_h.generation != 0) {
+            buffered_hist_detail::shard_registry::local().release(_h);
+        }
+    }
+
+    void record(uint64_t value) {
+        buffered_hist_detail::shard_registry::local().record(_h, value);
+    }
+
+    measurement auto_measure() const { return measurement(*this); }
+
+    /// The histogram with all the values recorded so far
+    const hdr_hist& hist() const {
+        return buffered_hist_detail::shard_registry::local().get(_h);
+    }
+
+    ss::metrics::histogram seastar_histogram_logform() const {
+        return hist().seastar_histogram_logform();
+    }
+
+private:
+    buffered_hist_detail::handle _h;
+};
+
+/**
+ * Merges the histograms of a sharded service into a histogram of the calling
+ * shard, e.g. for the node wide percentiles of a per shard probe. Each shard
+ * copies its histogram, so the merge does not read memory that another shard
+ * is writing to.
+ */
+template<typename Service, typename Func>
+ss::future<hdr_hist>
+merge_shard_histograms(ss::sharded<Service>& service, Func get_hist) {
+    hdr_hist merged;
+    for (auto shard : boost::irange<ss::shard_id>(0, ss::smp::count)) {
+        auto copy = co_await service.invoke_on(
+          shard, [&get_hist](Service& s) {
+              auto copy = std::make_unique<hdr_hist>();
+              *copy += get_hist(s);
+              return ss::make_foreign(std::move(copy));
+          });
+        merged += *copy;
+    }
+    co_return merged;
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "utils/cpu_profiler.h"
+
+#include "ssx/sformat.h"
+#include "vassert.h"
+
+#include <seastar/core/print.hh>
+
+#include <absl/container/flat_hash_map.h>
+#include <fmt/ostream.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <csignal>
+#include <mutex>
+#include <system_error>
+
+namespace {
+// seastar uses the first real time signals for its timers and stall detector
+int profiler_signal() { return SIGRTMIN + 5; }
+
+void install_signal_handler(void (*handler)(int, siginfo_t*, void*)) {
+    static std::once_flag installed;
+    std::call_once(installed, [handler] {
+        struct sigaction sa {};
+        sa.sa_sigaction = handler;
+        sa.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&sa.sa_mask);
+        auto r = ::sigaction(profiler_signal(), &sa, nullptr);
+        vassert(r == 0, "cannot install the cpu profiler signal handler");
+    });
+}
+} // namespace
+
+cpu_profiler::~cpu_profiler() { stop(); }
+
+void cpu_profiler::start(std::chrono::milliseconds period, size_t capacity) {
+    stop();
+    period = std::max(period, min_period);
+    _samples.assign(std::max<size_t>(capacity, 1), sample{});
+    _head.store(0, std::memory_order_relaxed);
+    install_signal_handler(&cpu_profiler::signal_handler);
+
+    // the reactor threads block the signals they do not handle
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, profiler_signal());
+    ::pthread_sigmask(SIG_UNBLOCK, &mask, nullptr);
+
+    // only the reactor thread of the shard is sampled, on its own CPU time
+    struct sigevent sev {};
+    sev.sigev_notify = SIGEV_THREAD_ID;
+    sev.sigev_signo = profiler_signal();
+    sev._sigev_un._tid = static_cast<pid_t>(::syscall(SYS_gettid));
+    if (::timer_create(CLOCK_THREAD_CPUTIME_ID, &sev, &_timer) != 0) {
+        throw std::system_error(
+          errno, std::system_category(), "cpu profiler timer_create");
+    }
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(period);
+    struct itimerspec spec {};
+    spec.it_interval.tv_sec = static_cast<time_t>(ns.count() / 1'000'000'000);
+    spec.it_interval.tv_nsec = static_cast<long>(ns.count() % 1'000'000'000);
+    spec.it_value = spec.it_interval;
+    _running = true;
+    if (::timer_settime(_timer, 0, &spec, nullptr) != 0) {
+        auto err = errno;
+        stop();
+        throw std::system_error(
+          err, std::system_category(), "cpu profiler timer_settime");
+    }
+}
+
+void cpu_profiler::stop() {
+    if (!_running) {
+        return;
+    }
+    ::timer_delete(_timer);
+    _running = false;
+}
+
+void cpu_profiler::signal_handler(int, siginfo_t*, void*) {
+    // the timer only targets the threads that started their profiler
+    local().on_signal();
+}
+
+void cpu_profiler::on_signal() {
+    if (
+      !_running || _samples.empty()
+      || _reading.load(std::memory_order_relaxed)) {
+        return;
+    }
+    auto idx = _head.load(std::memory_order_relaxed) % _samples.size();
+    auto& s = _samples[idx];
+    s.sg = ss::current_scheduling_group();
+    s.frames = 0;
+    ss::backtrace([&s](ss::frame f) {
+        if (s.frames < max_frames) {
+            s.stack[s.frames++] = f;
+        }
+    });
+    std::atomic_signal_fence(std::memory_order_release);
+    _head.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<cpu_profiler::folded_stack> cpu_profiler::results() const {
+    _reading.store(true, std::memory_order_relaxed);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    const auto count = std::min<uint64_t>(
+      _head.load(std::memory_order_relaxed), _samples.size());
+
+    absl::flat_hash_map<ss::sstring, folded_stack> folded;
+    for (size_t i = 0; i < count; ++i) {
+        const auto& s = _samples[i];
+        fmt::memory_buffer buf;
+        // the frame of the handler itself is not of interest
+        for (size_t f = s.frames; f > 1; --f) {
+            fmt::format_to(
+              std::back_inserter(buf),
+              "{}{}",
+              s.stack[f - 1],
+              f > 2 ? ";" : "");
+        }
+        auto stack = ss::sstring(buf.data(), buf.size());
+        const auto& sg = s.sg.name();
+        auto key = ssx::sformat("{};{}", sg, stack);
+        auto [it, _] = folded.try_emplace(
+          std::move(key),
+          folded_stack{.scheduling_group = sg, .stack = std::move(stack)});
+        ++it->second.samples;
+    }
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    _reading.store(false, std::memory_order_relaxed);
+
+    std::vector<folded_stack> ret;
+    ret.reserve(folded.size());
+    for (auto& [_, s] : folded) {
+        ret.push_back(std::move(s));
+    }
+    std::sort(
+      ret.begin(), ret.end(), [](const folded_stack& a, const folded_stack& b) {
+          return a.samples > b.samples;
+      });
+    return ret;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/util/backtrace.hh>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <vector>
+
+/**
+ * Sampling CPU profiler of a shard.
+ *
+ * While running, a timer of the CPU time of the reactor thread delivers a
+ * signal at the sampling frequency and the signal handler records the
+ * backtrace of the interrupted code, with the scheduling group it ran in, in
+ * a ring buffer allocated when the profiler is started. The handler does not
+ * allocate nor take locks, once the buffer is full the oldest samples are
+ * overwritten, so the profiler can be left running under load.
+ *
+ * Samples are reported as folded stacks, the format consumed by flame graph
+ * tools, with the addresses of the frames left to be symbolized offline with
+ * seastar-addr2line like the backtraces of the stall detector.
+ */
+class cpu_profiler {
+public:
+    static constexpr size_t default_capacity = 4096;
+    static constexpr size_t max_frames = 32;
+    static constexpr auto default_period = std::chrono::milliseconds(10);
+    static constexpr auto min_period = std::chrono::milliseconds(1);
+
+    struct folded_stack {
+        ss::sstring scheduling_group;
+        // frames separated by ';', outermost first
+        ss::sstring stack;
+        uint64_t samples{0};
+    };
+
+    static cpu_profiler& local() {
+        static thread_local cpu_profiler profiler;
+        return profiler;
+    }
+
+    cpu_profiler() = default;
+    cpu_profiler(const cpu_profiler&) = delete;
+    cpu_profiler& operator=(const cpu_profiler&) = delete;
+    ~cpu_profiler();
+
+    /// Starts sampling, the samples of a previous run are dropped
+    void start(
+      std::chrono::milliseconds period = default_period,
+      size_t capacity = default_capacity);
+    /// Stops sampling, the samples are kept until the next start
+    void stop();
+
+    bool running() const { return _running; }
+    /// Samples taken since the profiler was started, including overwritten
+    uint64_t samples_taken() const {
+        return _head.load(std::memory_order_relaxed);
+    }
+
+    /// Folded stacks of the samples in the buffer, most sampled first
+    std::vector<folded_stack> results() const;
+
+private:
+    struct sample {
+        ss::scheduling_group sg;
+        uint8_t frames{0};
+        std::array<ss::frame, max_frames> stack;
+    };
+
+    static void signal_handler(int, siginfo_t*, void*);
+    void on_signal();
+
+    std::vector<sample> _samples;
+    std::atomic<uint64_t> _head{0};
+    // set while the buffer is read, the samples taken meanwhile are dropped
+    mutable std::atomic<bool> _reading{false};
+    bool _running{false};
+    timer_t _timer{};
+};
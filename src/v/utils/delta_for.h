@@ -227,6 +227,9 @@ public:
     /// Return number of rows stored in the underlying iobuf instance
     uint32_t get_row_count() const noexcept { return _cnt; }
 
+    /// Return size of the encoded data in bytes
+    size_t size_bytes() const noexcept { return _data.size_bytes(); }
+
     /// Get initial value used to create the encoder
     TVal get_initial_value() const noexcept { return _initial; }
 
@@ -12,7 +12,10 @@
 
 #include "vassert.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <functional>
+#include <type_traits>
 #include <vector>
 
 /**
@@ -65,6 +68,37 @@ public:
         ++_size;
     }
 
+    /// Append the elements of [first, last)
+    template<typename Iterator>
+    void append(Iterator first, Iterator last) {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    /// Append n elements written by fill(T* dst, size_t count), called once
+    /// per fragment with its free space, e.g. to copy a serialized array in
+    /// bulk rather than one element at a time
+    template<typename Fill>
+    requires std::is_trivially_copyable_v<T>
+    void append_with(size_t n, Fill fill) {
+        while (n > 0) {
+            if (_size == _capacity) {
+                std::vector<T> frag;
+                frag.reserve(elems_per_frag);
+                _frags.push_back(std::move(frag));
+                _capacity += elems_per_frag;
+            }
+            auto& frag = _frags.back();
+            const auto used = frag.size();
+            const auto count = std::min(n, elems_per_frag - used);
+            frag.resize(used + count);
+            fill(frag.data() + used, count);
+            _size += count;
+            n -= count;
+        }
+    }
+
     void pop_back() {
         vassert(_size > 0, "Cannot pop from empty container");
         _frags.back().pop_back();
@@ -91,6 +125,15 @@ public:
         }
     }
 
+    /// Bytes allocated for the elements
+    size_t memory_size() const noexcept {
+        size_t bytes = 0;
+        for (const auto& frag : _frags) {
+            bytes += frag.capacity() * sizeof(T);
+        }
+        return bytes;
+    }
+
     bool operator==(const fragmented_vector& o) const noexcept {
         return o._frags == _frags;
     }
@@ -103,7 +146,11 @@ public:
         using pointer = const T*;
         using reference = const T&;
 
-        reference operator*() const { return _vec->operator[](_index); }
+        // unchecked, like the iterators of std::vector
+        reference operator*() const {
+            return _vec->_frags[_index / elems_per_frag]
+                               [_index % elems_per_frag];
+        }
 
         const_iterator& operator+=(ssize_t n) {
             _index += n;
@@ -142,6 +189,25 @@ public:
     const_iterator begin() const { return const_iterator(this, 0); }
     const_iterator end() const { return const_iterator(this, _size); }
 
+    /// Same result as std::lower_bound over the vector. The fragment is found
+    /// from the last element of each fragment first, then the search
+    /// continues in that fragment only, which is contiguous.
+    template<typename Compare = std::less<>>
+    const_iterator lower_bound(const T& value, Compare comp = {}) const {
+        auto frag = std::partition_point(
+          _frags.begin(), _frags.end(), [&value, &comp](const auto& f) {
+              return comp(f.back(), value);
+          });
+        if (frag == _frags.end()) {
+            return end();
+        }
+        auto it = std::lower_bound(frag->begin(), frag->end(), value, comp);
+        return const_iterator(
+          this,
+          std::distance(_frags.begin(), frag) * elems_per_frag
+            + std::distance(frag->begin(), it));
+    }
+
 private:
     fragmented_vector(const fragmented_vector&) noexcept = default;
 
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "utils/memory_accounting.h"
+
+#include "prometheus/prometheus_sanitize.h"
+
+#include <seastar/core/metrics.hh>
+
+#include <ostream>
+
+std::string_view to_string_view(memory_subsystem s) {
+    switch (s) {
+    case memory_subsystem::batch_cache:
+        return "batch_cache";
+    case memory_subsystem::raft_inflight:
+        return "raft_inflight";
+    case memory_subsystem::stm_state:
+        return "stm_state";
+    case memory_subsystem::index_state:
+        return "index_state";
+    case memory_subsystem::manifests:
+        return "manifests";
+    }
+    return "unknown";
+}
+
+std::ostream& operator<<(std::ostream& o, memory_subsystem s) {
+    return o << to_string_view(s);
+}
+
+void memory_accounting::setup_metrics() {
+    namespace sm = ss::metrics;
+    std::vector<sm::metric_definition> defs;
+    defs.reserve(memory_subsystem_count);
+    for (size_t i = 0; i < memory_subsystem_count; ++i) {
+        auto s = static_cast<memory_subsystem>(i);
+        defs.push_back(sm::make_gauge(
+          "tracked_bytes",
+          [this, s] { return used(s); },
+          sm::description("Memory accounted by a subsystem of the shard"),
+          {sm::label("subsystem")(ss::sstring(to_string_view(s)))}));
+    }
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("memory_accounting"), defs);
+}
+
+void memory_accounting::clear_metrics() { _metrics.clear(); }
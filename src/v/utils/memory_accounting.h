@@ -0,0 +1,116 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/metrics_registration.hh>
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+#include <utility>
+
+/**
+ * Subsystems whose memory usage grows with the number of partitions of a
+ * shard, and is therefore the first suspect when a node runs out of memory.
+ */
+enum class memory_subsystem : uint8_t {
+    // batches held by the batch cache
+    batch_cache = 0,
+    // replicate requests cached by the raft batchers until they are appended
+    raft_inflight,
+    // in memory state of the state machines, e.g. the producers of rm_stm
+    stm_state,
+    // offset and time indices of the log segments
+    index_state,
+    // cloud storage manifests of the partitions
+    manifests,
+};
+
+inline constexpr size_t memory_subsystem_count = 5;
+
+std::string_view to_string_view(memory_subsystem);
+std::ostream& operator<<(std::ostream&, memory_subsystem);
+
+/**
+ * Accounting of the memory used by the subsystems of a shard.
+ *
+ * Subsystems account their memory through tracked_memory handles, owned by
+ * the objects whose memory they describe. The numbers are the bytes the
+ * subsystems know they hold, not what the allocator handed out for them, so
+ * they are a lower bound of the actual usage.
+ */
+class memory_accounting {
+public:
+    static memory_accounting& local() {
+        static thread_local memory_accounting accounting;
+        return accounting;
+    }
+
+    size_t used(memory_subsystem s) const {
+        return _used[static_cast<size_t>(s)];
+    }
+
+    void add(memory_subsystem s, size_t bytes) {
+        _used[static_cast<size_t>(s)] += bytes;
+    }
+    void remove(memory_subsystem s, size_t bytes) {
+        _used[static_cast<size_t>(s)] -= bytes;
+    }
+
+    void setup_metrics();
+    void clear_metrics();
+
+private:
+    std::array<size_t, memory_subsystem_count> _used{};
+    ss::metrics::metric_groups _metrics;
+};
+
+/**
+ * Bytes of a subsystem held by an object, released when the object is
+ * destroyed. It must be destroyed on the shard it was updated on.
+ */
+class tracked_memory {
+public:
+    explicit tracked_memory(memory_subsystem s) noexcept
+      : _subsystem(s) {}
+    tracked_memory(const tracked_memory&) = delete;
+    tracked_memory& operator=(const tracked_memory&) = delete;
+    tracked_memory(tracked_memory&& o) noexcept
+      : _subsystem(o._subsystem)
+      , _bytes(std::exchange(o._bytes, 0)) {}
+    tracked_memory& operator=(tracked_memory&& o) noexcept {
+        if (this != &o) {
+            update(0);
+            _subsystem = o._subsystem;
+            _bytes = std::exchange(o._bytes, 0);
+        }
+        return *this;
+    }
+    ~tracked_memory() noexcept { update(0); }
+
+    /// Sets the bytes held by the owner
+    void update(size_t bytes) noexcept {
+        auto& accounting = memory_accounting::local();
+        accounting.remove(_subsystem, _bytes);
+        accounting.add(_subsystem, bytes);
+        _bytes = bytes;
+    }
+
+    size_t bytes() const { return _bytes; }
+
+private:
+    memory_subsystem _subsystem;
+    size_t _bytes{0};
+};
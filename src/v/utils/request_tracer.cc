@@ -0,0 +1,88 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "utils/request_tracer.h"
+
+#include "random/generators.h"
+
+#include <limits>
+#include <ostream>
+
+std::string_view to_string_view(trace_stage s) {
+    switch (s) {
+    case trace_stage::kafka_request_received:
+        return "kafka_request_received";
+    case trace_stage::produce_replicate:
+        return "produce_replicate";
+    case trace_stage::rm_stm_replicate:
+        return "rm_stm_replicate";
+    case trace_stage::batcher_enqueued:
+        return "batcher_enqueued";
+    case trace_stage::leader_appended:
+        return "leader_appended";
+    case trace_stage::follower_append_received:
+        return "follower_append_received";
+    case trace_stage::follower_appended:
+        return "follower_appended";
+    case trace_stage::quorum_replicated:
+        return "quorum_replicated";
+    case trace_stage::kafka_response_ready:
+        return "kafka_response_ready";
+    }
+    return "unknown";
+}
+
+std::ostream& operator<<(std::ostream& o, trace_stage s) {
+    return o << to_string_view(s);
+}
+
+trace_id request_tracer::maybe_start(uint32_t sample_rate) {
+    if (sample_rate == 0 || _requests++ % sample_rate != 0) {
+        return trace_id{};
+    }
+    // random ids are unique enough across the shards and the nodes, they are
+    // kept in the signed range so that they can be rendered as json longs
+    return trace_id(random_generators::get_int<uint64_t>(
+      1, std::numeric_limits<int64_t>::max()));
+}
+
+void request_tracer::do_record(trace_id id, trace_stage stage) {
+    event e{.id = id, .stage = stage, .at = clock_type::now()};
+    if (_events.size() < max_events) {
+        _events.push_back(e);
+        return;
+    }
+    _events[_next] = e;
+    _next = (_next + 1) % max_events;
+}
+
+void request_tracer::finish(
+  trace_id id, clock_type::duration elapsed, clock_type::duration threshold) {
+    if (id == trace_id{} || elapsed < threshold) {
+        return;
+    }
+    if (_slow.size() == max_slow_traces) {
+        _slow.pop_front();
+    }
+    _slow.push_back(slow_trace{.id = id, .duration = elapsed});
+}
+
+std::vector<request_tracer::event> request_tracer::events(trace_id id) const {
+    std::vector<event> ret;
+    // once full, the oldest event is the next one to be overwritten
+    for (size_t i = 0; i < _events.size(); ++i) {
+        const auto& e = _events[(_next + i) % _events.size()];
+        if (e.id == id) {
+            ret.push_back(e);
+        }
+    }
+    return ret;
+}
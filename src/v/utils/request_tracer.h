@@ -0,0 +1,117 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+#include "utils/named_type.h"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <string_view>
+#include <vector>
+
+/// Identifies a sampled request across shards and nodes, the default value
+/// marks requests that are not traced.
+using trace_id = named_type<uint64_t, struct trace_id_tag>;
+
+/// Stages of a produce request, in the order they are reached
+enum class trace_stage : uint8_t {
+    // kafka connection read the request
+    kafka_request_received = 0,
+    // produce handler hands the batch to the partition
+    produce_replicate,
+    // rm_stm accepted the batch
+    rm_stm_replicate,
+    // raft replicate batcher cached the batch
+    batcher_enqueued,
+    // the batch was appended to the leader log
+    leader_appended,
+    // a follower received the append entries request
+    follower_append_received,
+    // the follower appended, and flushed if requested, the entries
+    follower_appended,
+    // a majority of the replicas has the batch
+    quorum_replicated,
+    // the kafka response is ready to be sent
+    kafka_response_ready,
+};
+
+std::string_view to_string_view(trace_stage);
+std::ostream& operator<<(std::ostream&, trace_stage);
+
+/**
+ * Sampled tracing of requests across the layers of a node.
+ *
+ * A request is sampled where it enters the node and its trace id is carried
+ * with it, including to the other nodes over the raft RPC. Every layer
+ * records the time its stage is reached into the ring buffer of the shard it
+ * runs on, so recording is a couple of stores and a trace is only assembled
+ * when it is looked up. The shard that sampled the request keeps the recent
+ * traces that took longer than the slow threshold.
+ *
+ * Timestamps come from the steady clock, comparable across the shards of a
+ * node but not across nodes.
+ */
+class request_tracer {
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    struct event {
+        trace_id id;
+        trace_stage stage;
+        clock_type::time_point at;
+    };
+
+    struct slow_trace {
+        trace_id id;
+        clock_type::duration duration;
+    };
+
+    static constexpr size_t max_events = 4096;
+    static constexpr size_t max_slow_traces = 64;
+
+    static request_tracer& local() {
+        static thread_local request_tracer tracer;
+        return tracer;
+    }
+
+    /// Returns a new trace id for one in `sample_rate` requests, none if the
+    /// rate is 0
+    trace_id maybe_start(uint32_t sample_rate);
+
+    void record(trace_id id, trace_stage stage) {
+        if (id == trace_id{}) {
+            return;
+        }
+        do_record(id, stage);
+    }
+
+    /// Completes a trace sampled on this shard, keeps it if it is slow
+    void finish(
+      trace_id, clock_type::duration elapsed, clock_type::duration threshold);
+
+    /// Events of the trace still in the ring buffer, oldest first
+    std::vector<event> events(trace_id) const;
+
+    /// Recent slow traces sampled on this shard, oldest first
+    const std::deque<slow_trace>& slow_traces() const { return _slow; }
+
+private:
+    void do_record(trace_id, trace_stage);
+
+    uint64_t _requests{0};
+    std::vector<event> _events;
+    size_t _next{0};
+    std::deque<slow_trace> _slow;
+};
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "utils/stall_tracker.h"
+
+#include "prometheus/prometheus_sanitize.h"
+
+#include <seastar/core/metrics.hh>
+#include <seastar/core/scheduling.hh>
+
+#include <algorithm>
+
+namespace {
+// violations longer than this are recorded as the maximum
+constexpr auto max_recorded_duration = std::chrono::seconds(10);
+} // namespace
+
+void stall_tracker::do_record(
+  const call_site& site, clock_type::duration elapsed) {
+    const auto& sg = ss::current_scheduling_group().name();
+    auto it = std::find_if(
+      _sites.begin(), _sites.end(), [&site, &sg](const site_stats& s) {
+          return s.site.line == site.line && s.site.file == site.file
+                 && s.site.subsystem == site.subsystem
+                 && s.scheduling_group == sg;
+      });
+    if (it == _sites.end()) {
+        _sites.push_back(site_stats{.site = site, .scheduling_group = sg});
+        it = std::prev(_sites.end());
+    }
+    ++it->violations;
+    it->total += elapsed;
+    it->max = std::max(it->max, elapsed);
+
+    auto& group = get_group(site.subsystem, sg);
+    ++group.violations;
+    group.duration.record(std::min<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(),
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        max_recorded_duration)
+        .count()));
+}
+
+stall_tracker::group_stats&
+stall_tracker::get_group(std::string_view subsystem, const ss::sstring& sg) {
+    auto it = std::find_if(
+      _groups.begin(),
+      _groups.end(),
+      [subsystem, &sg](const std::unique_ptr<group_stats>& g) {
+          return g->subsystem == subsystem && g->scheduling_group == sg;
+      });
+    if (it != _groups.end()) {
+        return **it;
+    }
+    _groups.push_back(std::make_unique<group_stats>(group_stats{
+      .subsystem = subsystem,
+      .scheduling_group = sg,
+      .duration = hdr_hist(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+          max_recorded_duration),
+        std::chrono::microseconds(1)),
+    }));
+    auto& group = *_groups.back();
+    if (_metrics_enabled) {
+        register_group_metrics(group);
+    }
+    return group;
+}
+
+void stall_tracker::setup_metrics() {
+    _metrics_enabled = true;
+    for (const auto& g : _groups) {
+        register_group_metrics(*g);
+    }
+}
+
+void stall_tracker::clear_metrics() {
+    _metrics_enabled = false;
+    _metrics.clear();
+}
+
+void stall_tracker::register_group_metrics(const group_stats& group) {
+    namespace sm = ss::metrics;
+    const std::vector<sm::label_instance> labels = {
+      sm::label("subsystem")(ss::sstring(group.subsystem)),
+      sm::label("scheduling_group")(group.scheduling_group),
+    };
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("stall_tracker"),
+      {
+        sm::make_counter(
+          "task_quota_violations",
+          [&group] { return group.violations; },
+          sm::description("Number of synchronous sections that ran longer "
+                          "than the task quota"),
+          labels),
+        sm::make_histogram(
+          "task_quota_violation_duration",
+          [&group] { return group.duration.seastar_histogram_logform(); },
+          sm::description("Duration in microseconds of the synchronous "
+                          "sections that ran longer than the task quota"),
+          labels),
+      });
+}
+
+std::vector<stall_tracker::site_stats>
+stall_tracker::top_sites(size_t limit) const {
+    auto ret = _sites;
+    const auto n = std::min(limit, ret.size());
+    std::partial_sort(
+      ret.begin(),
+      ret.begin() + static_cast<std::ptrdiff_t>(n),
+      ret.end(),
+      [](const site_stats& a, const site_stats& b) {
+          return a.total > b.total;
+      });
+    ret.resize(n);
+    return ret;
+}
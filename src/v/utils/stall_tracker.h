@@ -0,0 +1,134 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+#include "utils/hdr_hist.h"
+#include "vlog.h"
+
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/sstring.hh>
+
+#include <chrono>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * Accounts for the task quota violations of the synchronous sections of
+ * subsystems that are known to run long, e.g. loops over all the partitions
+ * of a shard.
+ *
+ * A section is measured from its construction to its destruction and must not
+ * span a scheduling point. When it runs for longer than the threshold, the
+ * reactor task quota by default, the violation is accounted to its call site,
+ * its subsystem and the scheduling group it ran in. The reactor stall
+ * detector logs backtraces of the stalls, the tracker tells which subsystem
+ * they came from without having to parse the logs.
+ */
+class stall_tracker {
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    // matches the task quota of the application
+    static constexpr auto default_threshold = std::chrono::microseconds(500);
+
+    struct call_site {
+        std::string_view subsystem;
+        std::string_view file;
+        int line;
+    };
+
+    struct site_stats {
+        call_site site;
+        ss::sstring scheduling_group;
+        uint64_t violations{0};
+        clock_type::duration total{0};
+        clock_type::duration max{0};
+    };
+
+    class section {
+    public:
+        explicit section(call_site site) noexcept
+          : _site(site)
+          , _start(clock_type::now()) {}
+        section(const section&) = delete;
+        section& operator=(const section&) = delete;
+        section(section&&) = delete;
+        section& operator=(section&&) = delete;
+        ~section() noexcept {
+            stall_tracker::local().record(_site, clock_type::now() - _start);
+        }
+
+    private:
+        call_site _site;
+        clock_type::time_point _start;
+    };
+
+    static stall_tracker& local() {
+        static thread_local stall_tracker tracker;
+        return tracker;
+    }
+
+    void record(const call_site& site, clock_type::duration elapsed) {
+        if (elapsed < _threshold) {
+            return;
+        }
+        do_record(site, elapsed);
+    }
+
+    void set_threshold(clock_type::duration threshold) {
+        _threshold = threshold;
+    }
+
+    /// Violations are exported by subsystem and scheduling group from now on
+    void setup_metrics();
+    void clear_metrics();
+
+    /// Call sites of this shard with the most time spent over the threshold
+    std::vector<site_stats> top_sites(size_t limit) const;
+
+private:
+    struct group_stats {
+        std::string_view subsystem;
+        ss::sstring scheduling_group;
+        uint64_t violations{0};
+        hdr_hist duration;
+    };
+
+    void do_record(const call_site&, clock_type::duration);
+    group_stats& get_group(std::string_view subsystem, const ss::sstring& sg);
+    void register_group_metrics(const group_stats&);
+
+    clock_type::duration _threshold{default_threshold};
+    std::vector<site_stats> _sites;
+    // stable addresses, metrics refer to the entries
+    std::vector<std::unique_ptr<group_stats>> _groups;
+    bool _metrics_enabled{false};
+    ss::metrics::metric_groups _metrics;
+};
+
+// NOLINTNEXTLINE
+#define stall_tracker_concat_impl(a, b) a##b
+// NOLINTNEXTLINE
+#define stall_tracker_concat(a, b) stall_tracker_concat_impl(a, b)
+
+/// Tracks the rest of the enclosing scope as a synchronous section of the
+/// subsystem, e.g. stall_tracker_section("health_report");
+// NOLINTNEXTLINE
+#define stall_tracker_section(subsystem)                                       \
+    stall_tracker::section stall_tracker_concat(_stall_section_, __LINE__)(    \
+      stall_tracker::call_site{                                                \
+        .subsystem = (subsystem),                                              \
+        .file = (const char*)&__FILE__[vlog_internal::log_basename_start<      \
+          vlog_internal::basename_index(__FILE__)>::value],                    \
+        .line = __LINE__})
@@ -31,6 +31,9 @@ BOOST_AUTO_TEST_CASE(iobuf_type) {
         BOOST_REQUIRE_EQUAL(encoded, expected);
         auto decoded = base64_to_bytes(encoded);
         BOOST_REQUIRE_EQUAL(decoded, iobuf_to_bytes(input));
+        auto decoded_buf = base64_to_iobuf(encoded);
+        BOOST_REQUIRE_EQUAL(
+          iobuf_to_bytes(decoded_buf), iobuf_to_bytes(input));
     };
 
     encdec(bytes_to_iobuf(""), "");
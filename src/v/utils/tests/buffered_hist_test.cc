@@ -0,0 +1,77 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "utils/buffered_hist.h"
+
+#include <seastar/core/sharded.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <optional>
+
+SEASTAR_THREAD_TEST_CASE(test_values_are_visible_on_read) {
+    buffered_hist h;
+    for (uint64_t v = 1; v <= 1000; ++v) {
+        h.record(v);
+    }
+    const auto& hist = h.hist();
+    BOOST_REQUIRE_EQUAL(hist.seastar_histogram_logform().sample_count, 1000);
+    BOOST_REQUIRE_LE(hist.get_value_at(100.0), 1023);
+    BOOST_REQUIRE_GE(hist.get_value_at(100.0), 1000);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_measurement_records_once) {
+    buffered_hist h;
+    {
+        auto m = h.auto_measure();
+        auto moved = std::move(m);
+        auto skipped = h.auto_measure();
+        skipped.set_trace(false);
+    }
+    BOOST_REQUIRE_EQUAL(h.seastar_histogram_logform().sample_count, 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_measurement_outliving_histogram) {
+    std::optional<buffered_hist::measurement> m;
+    {
+        buffered_hist h;
+        m.emplace(h.auto_measure());
+    }
+    // the slot is reused, the late measurement must not land in it
+    buffered_hist reused;
+    m.reset();
+    BOOST_REQUIRE_EQUAL(reused.seastar_histogram_logform().sample_count, 0);
+}
+
+namespace {
+struct probe {
+    buffered_hist latency;
+};
+} // namespace
+
+SEASTAR_THREAD_TEST_CASE(test_merge_shard_histograms) {
+    ss::sharded<probe> probes;
+    probes.start().get();
+    probes
+      .invoke_on_all([](probe& p) {
+          for (uint64_t v = 1; v <= 100; ++v) {
+              p.latency.record(v * (ss::this_shard_id() + 1));
+          }
+      })
+      .get();
+
+    auto merged = merge_shard_histograms(
+                    probes,
+                    [](const probe& p) -> const hdr_hist& {
+                        return p.latency.hist();
+                    })
+                    .get0();
+    BOOST_REQUIRE_EQUAL(
+      merged.seastar_histogram_logform().sample_count, 100 * ss::smp::count);
+    probes.stop().get();
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "utils/cpu_profiler.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <numeric>
+
+using namespace std::chrono_literals;
+
+namespace {
+// burns CPU time of the reactor thread, which is what the timer counts
+void busy_loop(std::chrono::milliseconds duration) {
+    volatile uint64_t sink = 0;
+    auto deadline = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < deadline) {
+        sink = sink + 1;
+    }
+}
+} // namespace
+
+SEASTAR_THREAD_TEST_CASE(test_cpu_profiler_samples) {
+    auto& profiler = cpu_profiler::local();
+    profiler.start(1ms);
+    BOOST_REQUIRE(profiler.running());
+    busy_loop(200ms);
+    profiler.stop();
+    BOOST_REQUIRE(!profiler.running());
+
+    BOOST_REQUIRE_GT(profiler.samples_taken(), 0);
+    auto stacks = profiler.results();
+    BOOST_REQUIRE(!stacks.empty());
+    auto samples = std::accumulate(
+      stacks.begin(),
+      stacks.end(),
+      uint64_t(0),
+      [](uint64_t acc, const cpu_profiler::folded_stack& s) {
+          return acc + s.samples;
+      });
+    BOOST_REQUIRE_EQUAL(samples, profiler.samples_taken());
+    for (size_t i = 1; i < stacks.size(); ++i) {
+        BOOST_REQUIRE_GE(stacks[i - 1].samples, stacks[i].samples);
+    }
+    BOOST_REQUIRE_EQUAL(
+      stacks[0].scheduling_group, ss::current_scheduling_group().name());
+    BOOST_REQUIRE(!stacks[0].stack.empty());
+
+    // stopped, the results are kept and no more samples are taken
+    auto taken = profiler.samples_taken();
+    busy_loop(20ms);
+    BOOST_REQUIRE_EQUAL(profiler.samples_taken(), taken);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_cpu_profiler_ring_buffer) {
+    auto& profiler = cpu_profiler::local();
+    const size_t capacity = 8;
+    profiler.start(1ms, capacity);
+    busy_loop(100ms);
+    profiler.stop();
+
+    // the oldest samples were overwritten
+    BOOST_REQUIRE_GT(profiler.samples_taken(), capacity);
+    auto stacks = profiler.results();
+    auto samples = std::accumulate(
+      stacks.begin(),
+      stacks.end(),
+      uint64_t(0),
+      [](uint64_t acc, const cpu_profiler::folded_stack& s) {
+          return acc + s.samples;
+      });
+    BOOST_REQUIRE_EQUAL(samples, capacity);
+
+    // a new run drops the samples of the previous one
+    profiler.start(1s);
+    BOOST_REQUIRE_EQUAL(profiler.samples_taken(), 0);
+    BOOST_REQUIRE(profiler.results().empty());
+    profiler.stop();
+}
@@ -115,3 +115,53 @@ BOOST_AUTO_TEST_CASE(fragmented_vector_test) {
           std::distance(it, truth.end()), std::distance(it2, other.end()));
     }
 }
+
+BOOST_AUTO_TEST_CASE(fragmented_vector_bulk_append_test) {
+    std::vector<uint32_t> truth;
+    fragmented_vector<uint32_t, 1024> other;
+
+    uint32_t next = 0;
+    for (size_t n : {0, 1, 255, 256, 257, 1000, 3}) {
+        std::vector<uint32_t> values;
+        for (size_t i = 0; i < n; ++i) {
+            values.push_back(next);
+            next += random_generators::get_int<uint32_t>(0, 3);
+        }
+        truth.insert(truth.end(), values.begin(), values.end());
+        auto src = values.begin();
+        other.append_with(n, [&src](uint32_t* dst, size_t count) {
+            std::copy_n(src, count, dst);
+            src += static_cast<std::ptrdiff_t>(count);
+        });
+        BOOST_REQUIRE_EQUAL(truth.size(), other.size());
+        BOOST_REQUIRE_EQUAL_COLLECTIONS(
+          truth.begin(), truth.end(), other.begin(), other.end());
+    }
+
+    const std::vector<uint32_t> tail(truth.begin(), truth.begin() + 10);
+    other.append(tail.begin(), tail.end());
+    truth.insert(truth.end(), tail.begin(), tail.end());
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(
+      truth.begin(), truth.end(), other.begin(), other.end());
+
+    other = serde::from_iobuf<decltype(other)>(
+      serde::to_iobuf(std::move(other)));
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(
+      truth.begin(), truth.end(), other.begin(), other.end());
+}
+
+BOOST_AUTO_TEST_CASE(fragmented_vector_lower_bound_test) {
+    std::vector<uint32_t> truth;
+    fragmented_vector<uint32_t, 1024> other;
+    for (uint32_t i = 0; i < 2000; ++i) {
+        truth.push_back(i * 2);
+        other.push_back(i * 2);
+    }
+
+    for (uint32_t val = 0; val < 4010; ++val) {
+        auto it = std::lower_bound(truth.begin(), truth.end(), val);
+        auto it2 = other.lower_bound(val);
+        BOOST_REQUIRE_EQUAL(
+          std::distance(truth.begin(), it), std::distance(other.begin(), it2));
+    }
+}
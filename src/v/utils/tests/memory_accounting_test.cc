@@ -0,0 +1,67 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "utils/memory_accounting.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <optional>
+
+SEASTAR_THREAD_TEST_CASE(test_tracked_memory_update) {
+    auto& accounting = memory_accounting::local();
+    const auto initial = accounting.used(memory_subsystem::index_state);
+    {
+        tracked_memory a(memory_subsystem::index_state);
+        tracked_memory b(memory_subsystem::index_state);
+        a.update(100);
+        b.update(50);
+        BOOST_REQUIRE_EQUAL(
+          accounting.used(memory_subsystem::index_state), initial + 150);
+        a.update(20);
+        BOOST_REQUIRE_EQUAL(a.bytes(), 20);
+        BOOST_REQUIRE_EQUAL(
+          accounting.used(memory_subsystem::index_state), initial + 70);
+        // other subsystems are not affected
+        BOOST_REQUIRE_EQUAL(accounting.used(memory_subsystem::manifests), 0);
+    }
+    BOOST_REQUIRE_EQUAL(
+      accounting.used(memory_subsystem::index_state), initial);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_tracked_memory_move) {
+    auto& accounting = memory_accounting::local();
+    const auto initial = accounting.used(memory_subsystem::stm_state);
+    std::optional<tracked_memory> moved;
+    {
+        tracked_memory a(memory_subsystem::stm_state);
+        a.update(10);
+        moved.emplace(std::move(a));
+        BOOST_REQUIRE_EQUAL(moved->bytes(), 10);
+    }
+    // the moved from handle released nothing
+    BOOST_REQUIRE_EQUAL(
+      accounting.used(memory_subsystem::stm_state), initial + 10);
+
+    tracked_memory other(memory_subsystem::stm_state);
+    other.update(5);
+    other = std::move(*moved);
+    BOOST_REQUIRE_EQUAL(other.bytes(), 10);
+    BOOST_REQUIRE_EQUAL(
+      accounting.used(memory_subsystem::stm_state), initial + 10);
+    moved.reset();
+    BOOST_REQUIRE_EQUAL(
+      accounting.used(memory_subsystem::stm_state), initial + 10);
+    other.update(0);
+    BOOST_REQUIRE_EQUAL(accounting.used(memory_subsystem::stm_state), initial);
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "utils/request_tracer.h"
+
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_CASE(test_request_tracer_sampling) {
+    request_tracer tracer;
+    BOOST_REQUIRE_EQUAL(tracer.maybe_start(0), trace_id{});
+
+    int sampled = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (tracer.maybe_start(10) != trace_id{}) {
+            ++sampled;
+        }
+    }
+    BOOST_REQUIRE_EQUAL(sampled, 10);
+}
+
+BOOST_AUTO_TEST_CASE(test_request_tracer_events) {
+    request_tracer tracer;
+    auto id = tracer.maybe_start(1);
+    BOOST_REQUIRE_NE(id, trace_id{});
+
+    tracer.record(trace_id{}, trace_stage::produce_replicate);
+    tracer.record(id, trace_stage::kafka_request_received);
+    tracer.record(trace_id(id() + 1), trace_stage::kafka_request_received);
+    tracer.record(id, trace_stage::kafka_response_ready);
+
+    auto events = tracer.events(id);
+    BOOST_REQUIRE_EQUAL(events.size(), 2);
+    BOOST_REQUIRE_EQUAL(events[0].stage, trace_stage::kafka_request_received);
+    BOOST_REQUIRE_EQUAL(events[1].stage, trace_stage::kafka_response_ready);
+    BOOST_REQUIRE(events[0].at <= events[1].at);
+    BOOST_REQUIRE(tracer.events(trace_id{}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_request_tracer_ring_wraps) {
+    request_tracer tracer;
+    trace_id first(1);
+    trace_id other(2);
+    tracer.record(first, trace_stage::kafka_request_received);
+    for (size_t i = 0; i < request_tracer::max_events; ++i) {
+        tracer.record(other, trace_stage::produce_replicate);
+    }
+    BOOST_REQUIRE(tracer.events(first).empty());
+
+    tracer.record(first, trace_stage::kafka_response_ready);
+    auto events = tracer.events(first);
+    BOOST_REQUIRE_EQUAL(events.size(), 1);
+    BOOST_REQUIRE_EQUAL(events[0].stage, trace_stage::kafka_response_ready);
+    BOOST_REQUIRE_EQUAL(
+      tracer.events(other).size(), request_tracer::max_events - 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_request_tracer_slow_traces) {
+    request_tracer tracer;
+    tracer.finish(trace_id(1), 10ms, 100ms);
+    tracer.finish(trace_id{}, 1s, 100ms);
+    BOOST_REQUIRE(tracer.slow_traces().empty());
+
+    for (uint64_t i = 1; i <= request_tracer::max_slow_traces + 1; ++i) {
+        tracer.finish(trace_id(i), 200ms, 100ms);
+    }
+    BOOST_REQUIRE_EQUAL(
+      tracer.slow_traces().size(), request_tracer::max_slow_traces);
+    BOOST_REQUIRE_EQUAL(tracer.slow_traces().front().id, trace_id(2));
+    BOOST_REQUIRE(tracer.slow_traces().back().duration == 200ms);
+}
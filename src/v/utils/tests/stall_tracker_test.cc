@@ -0,0 +1,71 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "utils/stall_tracker.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace std::chrono_literals;
+
+SEASTAR_THREAD_TEST_CASE(test_stall_tracker_threshold) {
+    auto& tracker = stall_tracker::local();
+    const stall_tracker::call_site fast{
+      .subsystem = "threshold_test", .file = "a.cc", .line = 1};
+    tracker.record(fast, stall_tracker::default_threshold / 2);
+    for (const auto& s : tracker.top_sites(100)) {
+        BOOST_REQUIRE_NE(s.site.subsystem, "threshold_test");
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_stall_tracker_top_sites) {
+    auto& tracker = stall_tracker::local();
+    const stall_tracker::call_site a{
+      .subsystem = "top_test", .file = "a.cc", .line = 1};
+    const stall_tracker::call_site b{
+      .subsystem = "top_test", .file = "b.cc", .line = 2};
+    tracker.record(a, 1ms);
+    tracker.record(a, 3ms);
+    tracker.record(b, 10ms);
+
+    auto top = tracker.top_sites(2);
+    BOOST_REQUIRE_EQUAL(top.size(), 2);
+    BOOST_REQUIRE_EQUAL(top[0].site.file, "b.cc");
+    BOOST_REQUIRE_EQUAL(top[0].violations, 1);
+    BOOST_REQUIRE_EQUAL(top[1].site.file, "a.cc");
+    BOOST_REQUIRE_EQUAL(top[1].violations, 2);
+    BOOST_REQUIRE(top[1].total == 4ms);
+    BOOST_REQUIRE(top[1].max == 3ms);
+    BOOST_REQUIRE_EQUAL(
+      top[1].scheduling_group, ss::current_scheduling_group().name());
+
+    BOOST_REQUIRE_EQUAL(tracker.top_sites(1).size(), 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_stall_tracker_section) {
+    auto& tracker = stall_tracker::local();
+    tracker.set_threshold(0ms);
+    {
+        stall_tracker_section("section_test");
+    }
+    tracker.set_threshold(stall_tracker::default_threshold);
+
+    auto top = tracker.top_sites(100);
+    auto it = std::find_if(
+      top.begin(), top.end(), [](const stall_tracker::site_stats& s) {
+          return s.site.subsystem == "section_test";
+      });
+    BOOST_REQUIRE(it != top.end());
+    BOOST_REQUIRE_EQUAL(it->site.file, "stall_tracker_test.cc");
+    BOOST_REQUIRE_EQUAL(it->violations, 1);
+}
@@ -0,0 +1,76 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/iobuf.h"
+#include "random/generators.h"
+#include "utils/base64.h"
+#include "utils/utf8.h"
+
+#include <seastar/core/reactor.hh>
+#include <seastar/testing/perf_tests.hh>
+
+// the size of a typical REST proxy record
+static constexpr size_t record_bytes = 1024;
+
+PERF_TEST(utf8, validate_ascii) {
+    auto text = random_generators::gen_alphanum_string(record_bytes);
+    perf_tests::start_measuring_time();
+    auto o = is_valid_utf8(std::string_view(text));
+    perf_tests::do_not_optimize(o);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(utf8, validate_multibyte) {
+    // two, three and four byte sequences
+    const std::string_view cps = "\xc3\xa9\xe2\x82\xac\xf0\x9f\x90\xbc";
+    ss::sstring text;
+    while (text.size() + cps.size() <= record_bytes) {
+        text.append(cps.data(), cps.size());
+    }
+    perf_tests::start_measuring_time();
+    auto o = is_valid_utf8(std::string_view(text));
+    perf_tests::do_not_optimize(o);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(utf8, validate_iobuf) {
+    auto text = random_generators::gen_alphanum_string(record_bytes * 64);
+    iobuf buf;
+    buf.append(text.data(), text.size());
+    perf_tests::start_measuring_time();
+    auto o = is_valid_utf8(buf);
+    perf_tests::do_not_optimize(o);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(base64, encode_iobuf) {
+    auto data = random_generators::get_bytes(record_bytes);
+    iobuf buf;
+    buf.append(data.data(), data.size());
+    perf_tests::start_measuring_time();
+    auto o = iobuf_to_base64(buf);
+    perf_tests::do_not_optimize(o);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(base64, decode_bytes) {
+    auto encoded = bytes_to_base64(random_generators::get_bytes(record_bytes));
+    perf_tests::start_measuring_time();
+    auto o = base64_to_bytes(encoded);
+    perf_tests::do_not_optimize(o);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(base64, decode_iobuf) {
+    auto encoded = bytes_to_base64(random_generators::get_bytes(record_bytes));
+    perf_tests::start_measuring_time();
+    auto o = base64_to_iobuf(encoded);
+    perf_tests::do_not_optimize(o);
+    perf_tests::stop_measuring_time();
+}
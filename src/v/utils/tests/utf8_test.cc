@@ -0,0 +1,78 @@
+// Copyright 2022 Redpanda Data, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/iobuf.h"
+#include "utils/utf8.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <string_view>
+
+using namespace std::string_view_literals;
+
+BOOST_AUTO_TEST_CASE(utf8_valid) {
+    BOOST_CHECK(is_valid_utf8(""sv));
+    BOOST_CHECK(is_valid_utf8("plain ascii, longer than a word"sv));
+    BOOST_CHECK(is_valid_utf8("\0"sv));
+    BOOST_CHECK(is_valid_utf8("\xc2\x80"sv));         // U+0080
+    BOOST_CHECK(is_valid_utf8("\xdf\xbf"sv));         // U+07FF
+    BOOST_CHECK(is_valid_utf8("\xe0\xa0\x80"sv));     // U+0800
+    BOOST_CHECK(is_valid_utf8("\xed\x9f\xbf"sv));     // U+D7FF
+    BOOST_CHECK(is_valid_utf8("\xee\x80\x80"sv));     // U+E000
+    BOOST_CHECK(is_valid_utf8("\xf0\x90\x80\x80"sv)); // U+10000
+    BOOST_CHECK(is_valid_utf8("\xf4\x8f\xbf\xbf"sv)); // U+10FFFF
+    BOOST_CHECK(is_valid_utf8("caf\xc3\xa9 na\xc3\xafve \xf0\x9f\x90\xbc"sv));
+}
+
+BOOST_AUTO_TEST_CASE(utf8_invalid) {
+    BOOST_CHECK(!is_valid_utf8("\x80"sv));             // lone continuation
+    BOOST_CHECK(!is_valid_utf8("\xc0\x80"sv));         // overlong
+    BOOST_CHECK(!is_valid_utf8("\xc1\xbf"sv));         // overlong
+    BOOST_CHECK(!is_valid_utf8("\xe0\x9f\xbf"sv));     // overlong
+    BOOST_CHECK(!is_valid_utf8("\xf0\x8f\xbf\xbf"sv)); // overlong
+    BOOST_CHECK(!is_valid_utf8("\xed\xa0\x80"sv));     // surrogate
+    BOOST_CHECK(!is_valid_utf8("\xf4\x90\x80\x80"sv)); // past U+10FFFF
+    BOOST_CHECK(!is_valid_utf8("\xf5\x80\x80\x80"sv));
+    BOOST_CHECK(!is_valid_utf8("\xff"sv));
+    BOOST_CHECK(!is_valid_utf8("\xc3"sv));           // truncated
+    BOOST_CHECK(!is_valid_utf8("\xe2\x82 ascii"sv)); // truncated
+    // invalid byte after a run of ascii longer than a word
+    BOOST_CHECK(!is_valid_utf8("0123456789abcdef\xff"sv));
+    BOOST_CHECK_THROW(validate_utf8("\xc3\x28"sv), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(utf8_iobuf_fragments) {
+    // a code point split across every possible fragment boundary
+    const std::string text = "ascii \xf0\x9f\x90\xbc caf\xc3\xa9";
+    for (size_t split = 0; split <= text.size(); ++split) {
+        iobuf buf;
+        for (auto part : {text.substr(0, split), text.substr(split)}) {
+            iobuf frag;
+            frag.append(part.data(), part.size());
+            buf.append_fragments(std::move(frag));
+        }
+        BOOST_CHECK(is_valid_utf8(buf));
+    }
+
+    // a sequence truncated at the end of the last fragment
+    iobuf truncated;
+    truncated.append("ascii \xf0\x9f", 8);
+    BOOST_CHECK(!is_valid_utf8(truncated));
+
+    utf8_validator v;
+    BOOST_CHECK(v.feed("\xe2\x82"sv));
+    BOOST_CHECK(!v.complete());
+    BOOST_CHECK(v.feed("\xac"sv));
+    BOOST_CHECK(v.complete());
+    BOOST_CHECK(!v.feed("\xac"sv));
+    // errors are sticky
+    BOOST_CHECK(!v.feed("ascii"sv));
+    BOOST_CHECK(!v.complete());
+}
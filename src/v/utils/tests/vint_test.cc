@@ -8,6 +8,7 @@
 // by the Apache License, Version 2.0
 
 #include "bytes/bytes.h"
+#include "bytes/iobuf_parser.h"
 #include "random/generators.h"
 #include "utils/vint.h"
 
@@ -18,7 +19,9 @@
 #include <array>
 #include <cstdint>
 #include <iostream>
+#include <limits>
 #include <random>
+#include <vector>
 
 namespace {
 
@@ -63,3 +66,68 @@ SEASTAR_THREAD_TEST_CASE(test_unsigned_stream_deserializer) {
       = unsigned_vint::stream_deserialize(istream).get();
     BOOST_CHECK_EQUAL(result, test_number);
 }
+
+SEASTAR_THREAD_TEST_CASE(test_word_deserializer_matches_bytewise) {
+    std::vector<int64_t> values{
+      0,
+      1,
+      -1,
+      63,
+      -64,
+      64,
+      std::numeric_limits<int32_t>::max(),
+      std::numeric_limits<int32_t>::min(),
+      int64_t(1) << 48,
+      std::numeric_limits<int64_t>::max(),
+      std::numeric_limits<int64_t>::min()};
+    for (int i = 0; i < 1000; ++i) {
+        auto shift = random_generators::get_int(0, 62);
+        values.push_back(
+          random_generators::get_int<int64_t>(
+            -(int64_t(1) << shift), int64_t(1) << shift));
+    }
+    for (auto v : values) {
+        auto b = vint::to_bytes(v);
+        // padding so that a word can always be loaded
+        b.resize(b.size() + sizeof(uint64_t), uint8_t(0xff));
+        auto [expected, expected_size] = unsigned_vint::detail::deserialize(
+          bytes_view(b), (vint::max_length - 1) * 7);
+        auto [val, size] = unsigned_vint::detail::deserialize_word(
+          reinterpret_cast<const char*>(b.data()), vint::max_length);
+        if (size == 0) {
+            // only varints longer than a word take the slow path
+            BOOST_REQUIRE_GT(expected_size, sizeof(uint64_t));
+            continue;
+        }
+        BOOST_REQUIRE_EQUAL(size, expected_size);
+        BOOST_REQUIRE_EQUAL(val, expected);
+        BOOST_REQUIRE_EQUAL(vint::decode_zigzag(val), v);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_parser_varints_across_fragments) {
+    std::vector<int64_t> values;
+    iobuf buf;
+    for (int i = 0; i < 2000; ++i) {
+        auto v = random_generators::get_int<int64_t>(
+          -(int64_t(1) << random_generators::get_int(0, 62)),
+          int64_t(1) << 40);
+        values.push_back(v);
+        auto b = vint::to_bytes(v);
+        if (i < 1000) {
+            // packed into growing fragments, mostly decoded from a word and
+            // sometimes straddling a fragment boundary
+            buf.append(b.data(), b.size());
+        } else {
+            // a fragment per varint, always decoded byte-wise
+            buf.append_fragments(bytes_to_iobuf(b));
+        }
+    }
+    iobuf_parser parser(std::move(buf));
+    for (auto expected : values) {
+        auto [v, size] = parser.read_varlong();
+        BOOST_REQUIRE_EQUAL(v, expected);
+        BOOST_REQUIRE_EQUAL(size, vint::vint_size(expected));
+    }
+    BOOST_REQUIRE_EQUAL(parser.bytes_left(), 0);
+}
@@ -11,8 +11,11 @@
 
 #pragma once
 
-#include <boost/locale/encoding_utf.hpp>
+#include "bytes/iobuf.h"
 
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
 #include <string_view>
 
 template<typename T>
@@ -28,13 +31,121 @@ struct default_thrower {
 };
 } // namespace
 
+/**
+ * Incremental UTF-8 validation, for text split in fragments: a code point
+ * may span fragments, the validator carries the sequence in progress over.
+ *
+ * Sequences are checked against the well-formed byte sequences of the
+ * Unicode standard (table 3-7), so overlong encodings, surrogates and code
+ * points past U+10FFFF are rejected. Runs of ASCII, the common case of
+ * client ids and SCRAM messages, are checked a word at a time.
+ */
+class utf8_validator {
+public:
+    /// Validates the next fragment, false from the first invalid byte on
+    bool feed(std::string_view s) {
+        if (_error) {
+            return false;
+        }
+        const auto* p = reinterpret_cast<const uint8_t*>(s.data());
+        const auto* end = p + s.size();
+        while (p != end) {
+            if (_need == 0) {
+                p = skip_ascii(p, end);
+                if (p == end) {
+                    break;
+                }
+            }
+            if (!step(*p++)) {
+                _error = true;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// True if the text fed so far is valid and ends on a whole code point
+    bool complete() const { return !_error && _need == 0; }
+
+private:
+    static const uint8_t* skip_ascii(const uint8_t* p, const uint8_t* end) {
+        constexpr uint64_t high_bits = 0x8080808080808080ULL;
+        while (end - p >= 8) {
+            uint64_t word; // NOLINT
+            std::memcpy(&word, p, sizeof(word));
+            if (word & high_bits) {
+                break;
+            }
+            p += 8;
+        }
+        while (p != end && *p < 0x80) {
+            ++p;
+        }
+        return p;
+    }
+
+    bool step(uint8_t c) {
+        if (_need > 0) {
+            if (c < _lo || c > _hi) {
+                return false;
+            }
+            _lo = 0x80;
+            _hi = 0xbf;
+            --_need;
+            return true;
+        }
+        if (c < 0x80) {
+            return true;
+        } else if (c >= 0xc2 && c <= 0xdf) {
+            _need = 1;
+        } else if (c >= 0xe0 && c <= 0xef) {
+            _need = 2;
+            if (c == 0xe0) {
+                _lo = 0xa0; // overlong
+            } else if (c == 0xed) {
+                _hi = 0x9f; // surrogates
+            }
+        } else if (c >= 0xf0 && c <= 0xf4) {
+            _need = 3;
+            if (c == 0xf0) {
+                _lo = 0x90; // overlong
+            } else if (c == 0xf4) {
+                _hi = 0x8f; // past U+10FFFF
+            }
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    // continuation bytes expected by the sequence in progress
+    uint8_t _need{0};
+    // range of the next continuation byte
+    uint8_t _lo{0x80};
+    uint8_t _hi{0xbf};
+    bool _error{false};
+};
+
+inline bool is_valid_utf8(std::string_view s) {
+    utf8_validator v;
+    return v.feed(s) && v.complete();
+}
+
+/// Validates the text of an iobuf fragment by fragment, without linearizing
+inline bool is_valid_utf8(const iobuf& buf) {
+    utf8_validator v;
+    for (const auto& frag : buf) {
+        if (!v.feed({frag.get(), frag.size()})) {
+            return false;
+        }
+    }
+    return v.complete();
+}
+
 template<typename Thrower>
 requires ExceptionThrower<Thrower>
 inline void validate_utf8(std::string_view s, Thrower&& thrower) {
-    try {
-        boost::locale::conv::utf_to_utf<char>(
-          s.begin(), s.end(), boost::locale::conv::stop);
-    } catch (const boost::locale::conv::conversion_error& ex) {
+    if (!is_valid_utf8(s)) {
         thrower.conversion_error();
     }
 }
@@ -12,9 +12,11 @@
 #pragma once
 #include "bytes/bytes.h"
 
+#include <seastar/core/byteorder.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/iostream.hh>
 
+#include <bit>
 #include <cstdint>
 
 namespace unsigned_vint {
@@ -66,6 +68,38 @@ deserialize(Range&& r, uint8_t limit) noexcept {
     return std::make_pair(decoder.result, decoder.bytes_read);
 }
 
+/**
+ * @brief Decode a varint from a contiguous buffer a word at a time.
+ *
+ * Loads 8 bytes at once, finds the terminating byte from the continuation
+ * bits and gathers the 7 bit groups with a few shifts and masks instead of a
+ * loop over the bytes. The caller must guarantee that 8 bytes are readable
+ * from src. Returns zero bytes read if the varint is longer than max_bytes
+ * (or 8), in which case the caller falls back to the byte-wise decoder.
+ */
+inline std::pair<uint64_t, size_t>
+deserialize_word(const char* src, size_t max_bytes) noexcept {
+    constexpr uint64_t continuation_bits = 0x8080808080808080;
+    const auto word = ss::read_le<uint64_t>(src);
+    const uint64_t stop_bits = ~word & continuation_bits;
+    if (stop_bits == 0) {
+        return {0, 0};
+    }
+    const size_t n = (std::countr_zero(stop_bits) + 1) / 8;
+    if (n > max_bytes) {
+        return {0, 0};
+    }
+    uint64_t v = word & ~continuation_bits;
+    if (n < sizeof(word)) {
+        v &= (uint64_t(1) << (8 * n)) - 1;
+    }
+    // pack 8x7 bits into 4x14, 2x28 and finally 56 bits
+    v = ((v & 0x7f007f007f007f00) >> 1) | (v & 0x007f007f007f007f);
+    v = ((v & 0x3fff00003fff0000) >> 2) | (v & 0x00003fff00003fff);
+    v = ((v & 0x0fffffff00000000) >> 4) | (v & 0x000000000fffffff);
+    return {v, n};
+}
+
 } // namespace detail
 
 inline size_t serialize(uint64_t value, uint8_t* out) noexcept {
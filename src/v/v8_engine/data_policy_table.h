@@ -21,6 +21,7 @@ class data_policy_table {
 public:
     using container_type
       = absl::node_hash_map<model::topic_namespace, v8_engine::data_policy>;
+    using const_iterator = container_type::const_iterator;
 
     bool insert(model::topic_namespace, v8_engine::data_policy);
 
@@ -31,6 +32,9 @@ public:
 
     size_t size() const { return _dps.size(); }
 
+    const_iterator begin() const { return _dps.cbegin(); }
+    const_iterator end() const { return _dps.cend(); }
+
 private:
     container_type _dps;
 };
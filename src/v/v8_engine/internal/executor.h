@@ -21,6 +21,7 @@
 #include <seastar/core/internal/pollable_fd.hh>
 #include <seastar/core/lowres_clock.hh>
 #include <seastar/core/smp.hh>
+#include <seastar/util/defer.hh>
 #include <seastar/util/later.hh>
 
 #include <boost/lockfree/spsc_queue.hpp>
@@ -169,6 +170,9 @@ public:
 
     bool is_stopping() const;
 
+    /// Number of tasks submitted and not completed yet
+    size_t pending() const { return _pending; }
+
     /// Submit new task in executor.
     ///
     /// \param start_func is used for set watchdog
@@ -184,6 +188,8 @@ public:
       WrapperFuncForExecutor&& func_for_executor,
       std::chrono::milliseconds timeout) {
         gate_guard guard{_gate};
+        ++_pending;
+        auto decrement = ss::defer([this] { --_pending; });
 
         auto new_task
           = std::make_unique<internal::task<WrapperFuncForExecutor>>(
@@ -215,6 +221,7 @@ private:
 
     ss::gate _gate;
     internal::spsc_queue _tasks;
+    size_t _pending{0};
 
     ss::timer<ss::lowres_clock> _watchdog;
 
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/redpanda-data/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "v8_engine/internal/executor_pool.h"
+
+#include "vassert.h"
+
+#include <seastar/core/loop.hh>
+
+#include <algorithm>
+
+namespace v8_engine {
+
+executor_pool::executor_pool(
+  ss::alien::instance& instance,
+  const std::vector<uint8_t>& cpu_ids,
+  size_t queue_size) {
+    vassert(!cpu_ids.empty(), "Executor pool needs at least one executor");
+    _executors.reserve(cpu_ids.size());
+    for (auto cpu_id : cpu_ids) {
+        _executors.push_back(
+          std::make_unique<executor>(instance, cpu_id, queue_size));
+    }
+}
+
+ss::future<> executor_pool::stop() {
+    return ss::parallel_for_each(
+      _executors, [](std::unique_ptr<executor>& e) { return e->stop(); });
+}
+
+executor& executor_pool::least_loaded() {
+    return **std::min_element(
+      _executors.begin(),
+      _executors.end(),
+      [](const std::unique_ptr<executor>& a,
+         const std::unique_ptr<executor>& b) {
+          return a->pending() < b->pending();
+      });
+}
+
+} // namespace v8_engine
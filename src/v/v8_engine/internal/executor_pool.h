@@ -0,0 +1,66 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/redpanda-data/redpanda/blob/master/licenses/rcl.md
+ */
+
+#pragma once
+
+#include "seastarx.h"
+#include "v8_engine/internal/executor.h"
+
+#include <seastar/core/alien.hh>
+#include <seastar/core/future.hh>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace v8_engine {
+
+// This class implement pool of executors (one std::thread per executor). It
+// can be used instead of single executor for running v8 scripts, so one slow
+// script doesn't block all other scripts.
+// Every task is submitted to the executor with the fewest pending tasks.
+// Scripts enter their isolate with v8::Locker, so a script can run on any
+// executor of the pool.
+// Like executor, the pool must be used from one core only.
+class executor_pool {
+public:
+    executor_pool(
+      ss::alien::instance& instance,
+      const std::vector<uint8_t>& cpu_ids,
+      size_t queue_size);
+
+    executor_pool(const executor_pool& other) = delete;
+    executor_pool& operator=(const executor_pool& other) = delete;
+    executor_pool(executor_pool&& other) = delete;
+    executor_pool& operator=(executor_pool&& other) = delete;
+
+    ~executor_pool() = default;
+
+    // Stop all executors
+    ss::future<> stop();
+
+    size_t size() const { return _executors.size(); }
+
+    /// Submit new task in the least loaded executor.
+    template<typename WrapperFuncForExecutor>
+    ss::future<> submit(
+      WrapperFuncForExecutor&& func_for_executor,
+      std::chrono::milliseconds timeout) {
+        return least_loaded().submit(
+          std::forward<WrapperFuncForExecutor>(func_for_executor), timeout);
+    }
+
+private:
+    executor& least_loaded();
+
+    std::vector<std::unique_ptr<executor>> _executors;
+};
+
+} // namespace v8_engine
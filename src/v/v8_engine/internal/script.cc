@@ -131,6 +131,18 @@ void script::run_internal(ss::temporary_buffer<char> data) {
     }
 }
 
+void script::setup_metrics(const ss::sstring& policy_name) {
+    namespace sm = ss::metrics;
+    _metrics.clear();
+    _metrics.add_group(
+      "v8_engine:script",
+      {sm::make_histogram(
+        "run_latency_us",
+        sm::description("Latency of data policy script runs"),
+        {sm::label("policy")(policy_name)},
+        [this] { return _run_latency.seastar_histogram_logform(); })});
+}
+
 void script::throw_exception_from_v8(std::string_view msg) {
     throw script_exception(fmt::format("{}", msg));
 }
@@ -12,16 +12,19 @@
 
 #include "seastarx.h"
 #include "units.h"
+#include "utils/hdr_hist.h"
 #include "v8_engine/internal/environment.h"
 
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
+#include <seastar/core/metrics.hh>
 #include <seastar/core/sstring.hh>
 #include <seastar/core/temporary_buffer.hh>
 #include <seastar/core/timer.hh>
 
 #include <chrono>
 #include <v8.h>
+#include <vector>
 
 namespace v8_engine {
 
@@ -86,10 +89,37 @@ public:
     template<typename Executor>
     ss::future<> run(ss::temporary_buffer<char> data, Executor& executor) {
         run_task task(*this, std::move(data));
+        auto m = _run_latency.auto_measure();
         return add_future_handlers(
-          executor.submit(std::move(task), _timeout_ms));
+                 executor.submit(std::move(task), _timeout_ms))
+          .finally([m = std::move(m)] {});
     }
 
+    /// Run function from js script for every buffer, in one executor task
+    /// to pay the hop to the executor thread once. Runs stop at the first
+    /// failure. The timeout is the script timeout for every buffer.
+    ///
+    /// \param data for js script
+    /// \param executor for run script
+    template<typename Executor>
+    ss::future<> run_batch(
+      std::vector<ss::temporary_buffer<char>> data, Executor& executor) {
+        if (data.empty()) {
+            return ss::now();
+        }
+        auto timeout = _timeout_ms * data.size();
+        run_batch_task task(*this, std::move(data));
+        auto m = _run_latency.auto_measure();
+        return add_future_handlers(executor.submit(std::move(task), timeout))
+          .finally([m = std::move(m)] {});
+    }
+
+    /// Export the latency of the runs, labeled by the name of the data
+    /// policy the script is used for.
+    void setup_metrics(const ss::sstring& policy_name);
+
+    const hdr_hist& run_latency() const { return _run_latency; }
+
 private:
     // Must be running in executor, because it runs js code
     // in first time for init global vars and e.t.c.
@@ -139,6 +169,9 @@ private:
     // Script timeout
     std::chrono::milliseconds _timeout_ms;
 
+    hdr_hist _run_latency;
+    ss::metrics::metric_groups _metrics;
+
     // This class implement task for executor. We need to add operator(),
     // cancel(), on_timeout()
 
@@ -176,6 +209,28 @@ private:
 
         void operator()() override { _script.run_internal(std::move(_data)); }
     };
+
+    class run_batch_task {
+    public:
+        run_batch_task(
+          script& script, std::vector<ss::temporary_buffer<char>> data)
+          : _script(script)
+          , _data(std::move(data)) {}
+
+        void operator()() {
+            for (auto& buf : _data) {
+                _script.run_internal(std::move(buf));
+            }
+        }
+
+        void cancel() { _script.stop_execution(); }
+
+        void on_timeout() { _script.cancel_terminate_execution_for_isolate(); }
+
+    private:
+        script& _script;
+        std::vector<ss::temporary_buffer<char>> _data;
+    };
 };
 
 } // namespace v8_engine
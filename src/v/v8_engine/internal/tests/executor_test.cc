@@ -10,9 +10,11 @@
 
 #include "seastarx.h"
 #include "v8_engine/internal/executor.h"
+#include "v8_engine/internal/executor_pool.h"
 
 #include <seastar/core/app-template.hh>
 #include <seastar/core/gate.hh>
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/core/reactor.hh>
 #include <seastar/core/sleep.hh>
 #include <seastar/core/smp.hh>
@@ -21,6 +23,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <thread>
 #include <unordered_map>
 
 class test_exception final : public std::exception {
@@ -194,3 +197,36 @@ SEASTAR_THREAD_TEST_CASE(stop_executor_with_finish_item_test) {
         }
     }
 }
+
+SEASTAR_THREAD_TEST_CASE(executor_pool_slow_task_test) {
+    struct task_for_test {
+        explicit task_for_test(std::chrono::milliseconds duration)
+          : _duration(duration) {}
+
+        void operator()() { std::this_thread::sleep_for(_duration); }
+
+        void cancel() {}
+
+        void on_timeout() {}
+
+        std::chrono::milliseconds _duration;
+    };
+
+    v8_engine::executor_pool pool(ss::engine().alien(), {1, 1}, ss::smp::count);
+    BOOST_REQUIRE_EQUAL(pool.size(), 2);
+
+    // The slow task occupies one executor, the fast one goes to the other
+    auto slow = pool.submit(
+      task_for_test(std::chrono::milliseconds(2000)),
+      std::chrono::milliseconds(5000));
+    auto start = ss::lowres_clock::now();
+    pool
+      .submit(
+        task_for_test(std::chrono::milliseconds(0)),
+        std::chrono::milliseconds(5000))
+      .get();
+    BOOST_REQUIRE(ss::lowres_clock::now() - start < std::chrono::seconds(1));
+
+    slow.get();
+    pool.stop().get();
+}
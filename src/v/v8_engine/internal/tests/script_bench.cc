@@ -0,0 +1,164 @@
+/*
+ * Copyright 2022 Redpanda Data, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/redpanda-data/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "random/generators.h"
+#include "seastarx.h"
+#include "units.h"
+#include "utils/file_io.h"
+#include "utils/hdr_hist.h"
+#include "v8_engine/internal/environment.h"
+#include "v8_engine/internal/executor_pool.h"
+#include "v8_engine/internal/script.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/testing/perf_tests.hh>
+
+#include <boost/range/irange.hpp>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+/**
+ * Benchmarks of data policy script evaluation.
+ *
+ * Every iteration runs a batch of records through each of the scripts, all
+ * the scripts concurrently on an executor pool, the way data policies are
+ * evaluated for the partitions of a node. Batches are submitted with
+ * script::run_batch, one executor task per batch.
+ *
+ * On top of the perf_tests per-iteration figures each test reports the record
+ * throughput and the p50/p99 latencies of the batches once it completes.
+ */
+struct script_bench_params {
+    size_t n_scripts;
+    // records per executor task
+    size_t batch_size;
+    size_t record_size;
+};
+
+v8_engine::enviroment env;
+
+class script_bench_fixture {
+public:
+    static constexpr size_t max_heap_size = 100;
+    static constexpr size_t timeout_ms = 1000;
+
+    script_bench_fixture()
+      : _pool(ss::engine().alien(), executor_cpus(), ss::smp::count)
+      , _js_code(read_fully_tmpbuf("to_upper.js").get0()) {}
+
+    script_bench_fixture(const script_bench_fixture&) = delete;
+    script_bench_fixture& operator=(const script_bench_fixture&) = delete;
+    script_bench_fixture(script_bench_fixture&&) = delete;
+    script_bench_fixture& operator=(script_bench_fixture&&) = delete;
+
+    ~script_bench_fixture() {
+        report();
+        _pool.stop().get();
+    }
+
+    ss::future<size_t> run(script_bench_params p) {
+        _params = p;
+        while (_scripts.size() < p.n_scripts) {
+            auto s = std::make_unique<v8_engine::script>(
+              max_heap_size, timeout_ms);
+            co_await s->init("to_upper", _js_code.share(), _pool);
+            _scripts.push_back(std::move(s));
+        }
+        if (_payload.size() != p.record_size) {
+            _payload = random_generators::gen_alphanum_string(p.record_size);
+        }
+
+        perf_tests::start_measuring_time();
+        auto start = std::chrono::steady_clock::now();
+        co_await ss::parallel_for_each(
+          boost::irange<size_t>(0, p.n_scripts),
+          [this, p](size_t i) { return run_one(*_scripts[i], p); });
+        _elapsed += std::chrono::steady_clock::now() - start;
+        perf_tests::stop_measuring_time();
+        co_return p.n_scripts * p.batch_size;
+    }
+
+private:
+    // executor threads are pinned to the cores after the reactor's one
+    static std::vector<uint8_t> executor_cpus() {
+        const auto cpus = std::max(std::thread::hardware_concurrency(), 2U);
+        std::vector<uint8_t> ids;
+        for (unsigned id = 1; id < std::min(cpus, 3U); ++id) {
+            ids.push_back(id);
+        }
+        return ids;
+    }
+
+    ss::future<> run_one(v8_engine::script& s, script_bench_params p) {
+        std::vector<ss::temporary_buffer<char>> batch;
+        batch.reserve(p.batch_size);
+        for (size_t i = 0; i < p.batch_size; ++i) {
+            batch.emplace_back(_payload.data(), _payload.size());
+        }
+        auto m = _latency.auto_measure();
+        co_await s.run_batch(std::move(batch), _pool);
+        _records += p.batch_size;
+        _bytes += p.batch_size * p.record_size;
+    }
+
+    void report() {
+        if (!_params) {
+            return;
+        }
+        auto seconds = std::chrono::duration<double>(_elapsed).count();
+        fmt::print(
+          std::cout,
+          "scripts: {}, batch: {}, record: {}b, executors: {} - {:.0f} "
+          "records/s, {:.2f} MiB/s, batch latency p50: {}us, p99: {}us\n",
+          _params->n_scripts,
+          _params->batch_size,
+          _params->record_size,
+          _pool.size(),
+          _records / seconds,
+          _bytes / seconds / (1024 * 1024),
+          _latency.get_value_at(50.0),
+          _latency.get_value_at(99.0));
+    }
+
+    v8_engine::executor_pool _pool;
+    ss::temporary_buffer<char> _js_code;
+    std::vector<std::unique_ptr<v8_engine::script>> _scripts;
+    ss::sstring _payload;
+
+    std::optional<script_bench_params> _params;
+    hdr_hist _latency;
+    size_t _records{0};
+    size_t _bytes{0};
+    std::chrono::steady_clock::duration _elapsed{0};
+};
+
+#define SCRIPT_BENCH(name, ...)                                                \
+    PERF_TEST_F(script_bench_fixture, name) {                                  \
+        return run(script_bench_params{__VA_ARGS__});                          \
+    }
+
+// one record per task, the thread hop dominates
+SCRIPT_BENCH(1_script_x1_128b, 1, 1, 128)
+SCRIPT_BENCH(1_script_x100_128b, 1, 100, 128)
+
+// large records, the script dominates
+SCRIPT_BENCH(1_script_x10_64k, 1, 10, 64_KiB)
+
+// many policies sharing the executors
+SCRIPT_BENCH(16_scripts_x1_128b, 16, 1, 128)
+SCRIPT_BENCH(16_scripts_x100_128b, 16, 100, 128)
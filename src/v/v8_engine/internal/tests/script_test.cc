@@ -152,3 +152,29 @@ SEASTAR_THREAD_TEST_CASE(run_timeout_test) {
           return "Sript timeout" == std::string(e.what());
       });
 }
+
+SEASTAR_THREAD_TEST_CASE(run_batch_test) {
+    executor_wrapper_for_test executor_wrapper;
+
+    v8_engine::script script(100, TIMEOUT_FOR_TEST_MS);
+
+    ss::temporary_buffer<char> js_code = read_fully_tmpbuf("to_upper.js").get();
+    script.init("to_upper", std::move(js_code), executor_wrapper.get_executor())
+      .get();
+
+    std::vector<ss::sstring> raw_data{"qwerty", "asdf", "zxcv"};
+    std::vector<ss::temporary_buffer<char>> data;
+    std::vector<ss::temporary_buffer<char>> batch;
+    for (const auto& raw : raw_data) {
+        data.emplace_back(raw.data(), raw.size());
+        batch.push_back(data.back().share());
+    }
+    script.run_batch(std::move(batch), executor_wrapper.get_executor()).get();
+
+    for (size_t i = 0; i < raw_data.size(); ++i) {
+        auto expected = raw_data[i];
+        boost::to_upper(expected);
+        BOOST_REQUIRE_EQUAL(
+          expected, std::string(data[i].get_write(), data[i].size()));
+    }
+}
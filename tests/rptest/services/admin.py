@@ -517,6 +517,30 @@ class Admin:
             path = f"{path}/{namespace}/{topic}/{partition}"
         return self._request('get', path, node=node).json()
 
+    def list_partitions(self,
+                        *,
+                        namespace=None,
+                        topic=None,
+                        offset=None,
+                        limit=None,
+                        node=None):
+        """
+        Return a page of the partition summaries of a node, optionally
+        filtered by namespace and topic.
+        """
+        params = {
+            "namespace": namespace,
+            "topic": topic,
+            "offset": offset,
+            "limit": limit
+        }
+        params = "&".join(
+            f"{k}={v}" for k, v in params.items() if v is not None)
+        path = "partitions"
+        if params:
+            path = f"{path}?{params}"
+        return self._request('get', path, node=node).json()
+
     def get_transactions(self, topic, partition, namespace, node=None):
         """
         Get transaction for current partition
@@ -734,6 +758,36 @@ class Admin:
         url = "debug/partition_leaders_table"
         return self._request("get", url, node=node).json()
 
+    def get_hot_partitions(self, node, limit=None):
+        """
+        Get the partitions of each shard of the node ranked by latency, byte
+        rate and request rate
+        """
+        url = "debug/hot_partitions"
+        if limit is not None:
+            url += f"?limit={limit}"
+        return self._request("get", url, node=node).json()
+
+    def get_request_traces(self, node, trace_id=None):
+        """
+        Get the recent slow traced requests of the node, or the events the
+        node recorded for the given trace
+        """
+        url = "debug/request_traces"
+        if trace_id is not None:
+            url += f"?trace_id={trace_id}"
+        return self._request("get", url, node=node).json()
+
+    def get_stalls(self, node, limit=None):
+        """
+        Get the call sites of the node that spent the most time running over
+        the task quota, by subsystem and scheduling group
+        """
+        url = "debug/stalls"
+        if limit is not None:
+            url += f"?limit={limit}"
+        return self._request("get", url, node=node).json()
+
     def si_sync_local_state(self, topic, partition, node=None):
         """
         Check data in the S3 bucket and fix local index if needed
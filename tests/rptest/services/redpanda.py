@@ -789,7 +789,10 @@ class RedpandaService(Service):
         storage = self.storage()
         for node in storage.nodes:
             if not set(node.ns) == {"redpanda"} or not set(
-                    node.ns["redpanda"].topics) == {"controller", "kvstore"}:
+                    node.ns["redpanda"].topics) <= {
+                        "controller", "kvstore", "kvstore_consensus",
+                        "kvstore_offset_translator"
+                    }:
                 self.logger.error(
                     f"Unexpected files: ns={node.ns} redpanda topics={node.ns['redpanda'].topics}"
                 )
@@ -1753,7 +1756,7 @@ class RedpandaService(Service):
 
         store = NodeStorage(node.name, RedpandaService.DATA_DIR)
         for ns in listdir(store.data_dir, True):
-            if ns == '.coprocessor_offset_checkpoints':
+            if ns in ('.coprocessor_offset_checkpoints', '.segment_pool'):
                 continue
             ns = store.add_namespace(ns, os.path.join(store.data_dir, ns))
             for topic in listdir(ns.path):